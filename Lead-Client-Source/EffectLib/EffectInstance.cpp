@@ -129,6 +129,26 @@ void CEffectInstance::SetGlobalMatrix(const D3DXMATRIX & c_rmatGlobal)
 	m_matGlobal = c_rmatGlobal;
 }
 
+void CEffectInstance::SetPriority(UINT uPriority)
+{
+	m_uPriority = uPriority;
+}
+
+UINT CEffectInstance::GetPriority() const
+{
+	return m_uPriority;
+}
+
+void CEffectInstance::SetCulled(bool isCulled)
+{
+	m_isCulled = isCulled;
+}
+
+bool CEffectInstance::IsCulled() const
+{
+	return m_isCulled;
+}
+
 BOOL CEffectInstance::isAlive()
 {
 	return m_isAlive;
@@ -273,6 +293,9 @@ void CEffectInstance::__Initialize()
 
 	m_pkEftData=NULL;
 
+	m_uPriority = 0;
+	m_isCulled = false;
+
 	D3DXMatrixIdentity(&m_matGlobal);
 }
 
@@ -47,6 +47,10 @@ class CEffectInstance : public CGraphicObjectInstance
 		void SetActive();
 		void SetDeactive();
 		void SetGlobalMatrix(const D3DXMATRIX & c_rmatGlobal);
+		void SetPriority(UINT uPriority);
+		UINT GetPriority() const;
+		void SetCulled(bool isCulled);
+		bool IsCulled() const;
 		void UpdateSound();
 		void OnUpdate();
 		void OnRender();
@@ -84,6 +88,9 @@ class CEffectInstance : public CGraphicObjectInstance
 
 		float m_fLastTime;
 
+		UINT m_uPriority;
+		bool m_isCulled;
+
 	public:
 		static CDynamicPool<CEffectInstance>	ms_kPool;
 		static int ms_iRenderingEffectCount;
@@ -1,17 +1,27 @@
 #include "StdAfx.h"
 #include "../eterBase/Random.h"
 #include "../eterlib/StateManager.h"
+#include "../eterlib/Camera.h"
 #include "EffectManager.h"
 
+float CEffectManager::ms_fCullDistance = 5000.0f;
+UINT CEffectManager::ms_uRenderBudget = 256;
+
+void CEffectManager::SetCulling(float fCullDistance, UINT uRenderBudget)
+{
+	ms_fCullDistance = fCullDistance;
+	ms_uRenderBudget = uRenderBudget;
+}
 
 
 void CEffectManager::GetInfo(std::string* pstInfo)
 {
 	char szInfo[256];
 	
-	sprintf(szInfo, "Effect: Inst - ED %d, EI %d Pool - PSI %d, MI %d, LI %d, PI %d, EI %d, ED %d, PSD %d, EM %d, LD %d", 		
+	sprintf(szInfo, "Effect: Inst - ED %d, EI %d, Culled %d Pool - PSI %d, MI %d, LI %d, PI %d, EI %d, ED %d, PSD %d, EM %d, LD %d", 		
 		m_kEftDataMap.size(),
 		m_kEftInstMap.size(),		
+		m_iCulledCount,
 		CParticleSystemInstance::ms_kPool.GetCapacity(),
 		CEffectMeshInstance::ms_kPool.GetCapacity(),
 		CLightInstance::ms_kPool.GetCapacity(),		
@@ -63,23 +73,81 @@ void CEffectManager::Update()
 	}
 	*/
 
+	CCamera * pCurrentCamera = CCameraManager::Instance().GetCurrentCamera();
+	D3DXVECTOR3 v3Eye = pCurrentCamera ? pCurrentCamera->GetEye() : D3DXVECTOR3(0.0f, 0.0f, 0.0f);
+
+	++m_dwUpdateFrame;
+	m_iCulledCount = 0;
+	m_kVct_kEftRank.clear();
+
 	for (TEffectInstanceMap::iterator itor = m_kEftInstMap.begin(); itor != m_kEftInstMap.end();)
 	{
 		CEffectInstance * pEffectInstance = itor->second;
 
-		pEffectInstance->Update(/*fElapsedTime*/);
+		bool isCulled = false;
+		float fDistanceSq = 0.0f;
+
+		if (CEffectManager::EFFECT_PRIORITY_SYSTEM != pEffectInstance->GetPriority())
+		{
+			D3DXVECTOR3 v3Center;
+			float fRadius;
+			pEffectInstance->GetBoundingSphere(v3Center, fRadius);
+
+			D3DXVECTOR3 v3Delta = v3Center - v3Eye;
+			fDistanceSq = D3DXVec3LengthSq(&v3Delta);
+
+			float fCullDistance = ms_fCullDistance + fRadius;
+
+			if (!pEffectInstance->isShow())
+				isCulled = true;
+			else if (ms_fCullDistance > 0.0f && fDistanceSq > fCullDistance * fCullDistance)
+				isCulled = true;
+		}
+
+		//   ʴ Ʈ  ؼ   
+		if (!isCulled || !pEffectInstance->IsCulled() || 0 == (m_dwUpdateFrame + itor->first) % EFFECT_CULLED_UPDATE_INTERVAL)
+			pEffectInstance->Update(/*fElapsedTime*/);
+
+		pEffectInstance->SetCulled(isCulled);
 
 		if (!pEffectInstance->isAlive())
 		{
 			itor = m_kEftInstMap.erase(itor);
 			
 			CEffectInstance::Delete(pEffectInstance);			
+			continue;
 		}
-		else
+
+		if (isCulled)
 		{
-			++itor;
+			++m_iCulledCount;
+		}
+		else if (CEffectManager::EFFECT_PRIORITY_SYSTEM != pEffectInstance->GetPriority())
+		{
+			TEffectRank kRank;
+			kRank.pkEftInst = pEffectInstance;
+			kRank.fDistanceSq = fDistanceSq;
+			m_kVct_kEftRank.push_back(kRank);
 		}
+
+		++itor;
 	}
+
+	__ApplyRenderBudget();
+}
+
+void CEffectManager::__ApplyRenderBudget()
+{
+	if (0 == ms_uRenderBudget || m_kVct_kEftRank.size() <= ms_uRenderBudget)
+		return;
+
+	// ڱ ĳ > Ƽ > ٸ ĳ,    ͺ ׸
+	std::nth_element(m_kVct_kEftRank.begin(), m_kVct_kEftRank.begin() + ms_uRenderBudget, m_kVct_kEftRank.end(), FLessEffectRank());
+
+	for (size_t i = ms_uRenderBudget; i < m_kVct_kEftRank.size(); ++i)
+		m_kVct_kEftRank[i].pkEftInst->SetCulled(true);
+
+	m_iCulledCount += m_kVct_kEftRank.size() - ms_uRenderBudget;
 }
 
 
@@ -109,7 +177,10 @@ void CEffectManager::Render()
 		for (TEffectInstanceMap::iterator itor = m_kEftInstMap.begin(); itor != m_kEftInstMap.end();)
 		{
 			CEffectInstance * pEffectInstance = itor->second;
-			pEffectInstance->Render();
+
+			if (!pEffectInstance->IsCulled())
+				pEffectInstance->Render();
+
 			++itor;
 		}
 	}
@@ -121,7 +192,8 @@ void CEffectManager::Render()
 		TEffectInstanceMap& rkMap_pkEftInstSrc=m_kEftInstMap;
 		TEffectInstanceMap::iterator i;
 		for (i=rkMap_pkEftInstSrc.begin(); i!=rkMap_pkEftInstSrc.end(); ++i)
-			s_kVct_pkEftInstSort.push_back(i->second);
+			if (!i->second->IsCulled())
+				s_kVct_pkEftInstSort.push_back(i->second);
 
 		std::sort(s_kVct_pkEftInstSort.begin(), s_kVct_pkEftInstSort.end(), CEffectManager_LessEffectInstancePtrRenderOrder());
 		std::for_each(s_kVct_pkEftInstSort.begin(), s_kVct_pkEftInstSort.end(), CEffectManager_FEffectInstanceRender());
@@ -167,6 +239,7 @@ BOOL CEffectManager::RegisterEffect(const char * c_szFileName,bool isExistDelete
 		{
 			CEffectInstance* pkNewEftInst=CEffectInstance::New();
 			pkNewEftInst->SetEffectDataPointer(pkEftData);
+			pkNewEftInst->SetPriority(EFFECT_PRIORITY_SYSTEM);
 			m_kEftCacheMap.insert(TEffectInstanceMap::value_type(dwCRC, pkNewEftInst));
 		}
 	}
@@ -191,11 +264,11 @@ int CEffectManager::CreateEffect(const char * c_szFileName, const D3DXVECTOR3 &
 	return CreateEffect(dwID, c_rv3Position, c_rv3Rotation);
 }
 
-int CEffectManager::CreateEffect(DWORD dwID, const D3DXVECTOR3 & c_rv3Position, const D3DXVECTOR3 & c_rv3Rotation)
+int CEffectManager::CreateEffect(DWORD dwID, const D3DXVECTOR3 & c_rv3Position, const D3DXVECTOR3 & c_rv3Rotation, UINT uPriority)
 {
 	int iInstanceIndex = GetEmptyIndex();
 
-	CreateEffectInstance(iInstanceIndex, dwID);
+	CreateEffectInstance(iInstanceIndex, dwID, uPriority);
 	SelectEffectInstance(iInstanceIndex);
 	D3DXMATRIX mat;
 	D3DXMatrixRotationYawPitchRoll(&mat,D3DXToRadian(c_rv3Rotation.x),D3DXToRadian(c_rv3Rotation.y),D3DXToRadian(c_rv3Rotation.z));
@@ -207,7 +280,7 @@ int CEffectManager::CreateEffect(DWORD dwID, const D3DXVECTOR3 & c_rv3Position,
 	return iInstanceIndex;
 }
 
-void CEffectManager::CreateEffectInstance(DWORD dwInstanceIndex, DWORD dwID)
+void CEffectManager::CreateEffectInstance(DWORD dwInstanceIndex, DWORD dwID, UINT uPriority)
 {
 	if (!dwID)
 		return;
@@ -221,6 +294,7 @@ void CEffectManager::CreateEffectInstance(DWORD dwInstanceIndex, DWORD dwID)
 
 	CEffectInstance * pEffectInstance = CEffectInstance::New();	
 	pEffectInstance->SetEffectDataPointer(pEffect);
+	pEffectInstance->SetPriority(uPriority);
 
 	m_kEftInstMap.insert(TEffectInstanceMap::value_type(dwInstanceIndex, pEffectInstance));
 }
@@ -263,6 +337,7 @@ void CEffectManager::CreateUnsafeEffectInstance(DWORD dwEffectDataID, CEffectIns
 
 	CEffectInstance* pkEftInstNew=CEffectInstance::New();
 	pkEftInstNew->SetEffectDataPointer(pEffect);
+	pkEftInstNew->SetPriority(EFFECT_PRIORITY_SYSTEM);
 
 	*ppEffectInstance = pkEftInstNew;	
 }
@@ -452,6 +527,10 @@ void CEffectManager::__Initialize()
 {
 	m_pSelectedEffectInstance = NULL;
 	m_isDisableSortRendering = false;
+
+	m_kVct_kEftRank.clear();
+	m_dwUpdateFrame = 0;
+	m_iCulledCount = 0;
 }
 
 CEffectManager::CEffectManager()
@@ -16,6 +16,19 @@ class CEffectManager : public CScreen, public CSingleton<CEffectManager>
 			EFFECT_TYPE_MAX_NUM				= 4,
 		};
 
+		enum EEffectPriority
+		{
+			EFFECT_PRIORITY_OTHER,			// ٸ ĳ
+			EFFECT_PRIORITY_PARTY,			// Ƽ
+			EFFECT_PRIORITY_OWN,			// ڱ ĳ
+			EFFECT_PRIORITY_SYSTEM,			// , UI ó ĳͿ   Ʈ. Ÿ ʴ´
+		};
+
+		enum
+		{
+			EFFECT_CULLED_UPDATE_INTERVAL = 8,	// ɷ Ʈ  Ӹ   Ѵ
+		};
+
 		typedef std::map<DWORD, CEffectData*> TEffectDataMap;
 		typedef std::map<DWORD, CEffectInstance*> TEffectInstanceMap;
 
@@ -40,10 +53,10 @@ class CEffectManager : public CScreen, public CSingleton<CEffectManager>
 		void DeleteAllInstances();
 
 		// Usage
-		int CreateEffect(DWORD dwID, const D3DXVECTOR3 & c_rv3Position, const D3DXVECTOR3 & c_rv3Rotation);
+		int CreateEffect(DWORD dwID, const D3DXVECTOR3 & c_rv3Position, const D3DXVECTOR3 & c_rv3Rotation, UINT uPriority = EFFECT_PRIORITY_SYSTEM);
 		int CreateEffect(const char * c_szFileName, const D3DXVECTOR3 & c_rv3Position, const D3DXVECTOR3 & c_rv3Rotation);
 
-		void CreateEffectInstance(DWORD dwInstanceIndex, DWORD dwID);
+		void CreateEffectInstance(DWORD dwInstanceIndex, DWORD dwID, UINT uPriority = EFFECT_PRIORITY_SYSTEM);
 		BOOL SelectEffectInstance(DWORD dwInstanceIndex);
 		bool DestroyEffectInstance(DWORD dwInstanceIndex);
 		void DeactiveEffectInstance(DWORD dwInstanceIndex);
@@ -69,8 +82,29 @@ class CEffectManager : public CScreen, public CSingleton<CEffectManager>
 
 		int GetRenderingEffectCount();
 
+		static void SetCulling(float fCullDistance, UINT uRenderBudget);
+
+	protected:
+		typedef struct SEffectRank
+		{
+			CEffectInstance *	pkEftInst;
+			float				fDistanceSq;
+		} TEffectRank;
+
+		struct FLessEffectRank
+		{
+			bool operator () (const TEffectRank & c_rkLeft, const TEffectRank & c_rkRight) const
+			{
+				if (c_rkLeft.pkEftInst->GetPriority() != c_rkRight.pkEftInst->GetPriority())
+					return c_rkLeft.pkEftInst->GetPriority() > c_rkRight.pkEftInst->GetPriority();
+
+				return c_rkLeft.fDistanceSq < c_rkRight.fDistanceSq;
+			}
+		};
+
 	protected:
 		void __Initialize();
+		void __ApplyRenderBudget();
 
 		void __DestroyEffectInstanceMap();
 		void __DestroyEffectCacheMap();
@@ -83,4 +117,11 @@ class CEffectManager : public CScreen, public CSingleton<CEffectManager>
 		TEffectInstanceMap				m_kEftCacheMap;
 
 		CEffectInstance *				m_pSelectedEffectInstance;
+
+		std::vector<TEffectRank>		m_kVct_kEftRank;
+		DWORD							m_dwUpdateFrame;
+		int								m_iCulledCount;
+
+		static float					ms_fCullDistance;
+		static UINT						ms_uRenderBudget;
 };
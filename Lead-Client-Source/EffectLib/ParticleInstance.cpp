@@ -121,16 +121,9 @@ BOOL CParticleInstance::Update(float fElapsedTime, float fAngle)
 	return TRUE;
 }
 
+// NOTE :  TEXTUREFACTOR  GetColor()  ؽ diffuse  ־ ѹ ׸.
 void CParticleInstance::Transform(const D3DXMATRIX * c_matLocal)
 {
-#ifdef WORLD_EDITOR
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, m_Color);
-#else
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, m_dcColor);
-#endif
-
-	/////
-
 	D3DXVECTOR3 v3Up;
 	D3DXVECTOR3 v3Cross;
 
@@ -280,14 +273,6 @@ void CParticleInstance::Transform(const D3DXMATRIX * c_matLocal)
 
 void CParticleInstance::Transform(const D3DXMATRIX * c_matLocal, const float c_fZRotation)
 {
-#ifdef WORLD_EDITOR
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, m_Color);
-#else
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, (DWORD)m_dcColor);
-#endif
-
-	/////
-
 	D3DXVECTOR3 v3Up;
 	D3DXVECTOR3 v3Cross;
 
@@ -506,6 +491,15 @@ TPTVertex * CParticleInstance::GetParticleMeshPointer()
 	return m_ParticleMesh;
 }
 
+DWORD CParticleInstance::GetColor() const
+{
+#ifdef WORLD_EDITOR
+	return (DWORD) m_Color;
+#else
+	return m_dcColor.m_dwColor;
+#endif
+}
+
 /*TPTVertex * CRayParticleInstance::GetParticleMeshPointer()
 {
 	return m_ParticleMesh;
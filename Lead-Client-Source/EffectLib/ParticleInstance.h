@@ -77,6 +77,7 @@ class CParticleInstance
 		void Transform(const D3DXMATRIX * c_matLocal, const float c_fZRotation);
 
 		TPTVertex * GetParticleMeshPointer();
+		DWORD		GetColor() const;
 		
 		void DeleteThis();
 
@@ -5,7 +5,9 @@
 #include "ParticleSystemInstance.h"
 #include "ParticleInstance.h"
 
-CDynamicPool<CParticleSystemInstance>	CParticleSystemInstance::ms_kPool;
+CChunkPool<CParticleSystemInstance>	CParticleSystemInstance::ms_kPool;
+
+std::vector<TPDTVertex>	CParticleSystemInstance::ms_kVct_kBatchVertex;
 
 using namespace NEffectUpdateDecorator;
 
@@ -13,6 +15,8 @@ void CParticleSystemInstance::DestroySystem()
 {
 	ms_kPool.Destroy();
 
+	std::vector<TPDTVertex>().swap(ms_kVct_kBatchVertex);
+
 	CParticleInstance::DestroySystem();
 	//CRayParticleInstance::DestroySystem();
 }
@@ -30,6 +34,42 @@ void CParticleSystemInstance::Delete(CParticleSystemInstance* pkPSInst)
 
 
 
+void CParticleSystemInstance::AppendBatchQuad(CParticleInstance * pInstance)
+{
+	const TPTVertex * c_pMesh = pInstance->GetParticleMeshPointer();
+	DWORD dwColor = pInstance->GetColor();
+
+	for (int i = 0; i < 4; ++i)
+	{
+		TPDTVertex kVertex;
+		kVertex.position = c_pMesh[i].position;
+		kVertex.diffuse = dwColor;
+		kVertex.texCoord = c_pMesh[i].texCoord;
+		ms_kVct_kBatchVertex.push_back(kVertex);
+	}
+}
+
+void CParticleSystemInstance::__FlushBatch()
+{
+	if (ms_kVct_kBatchVertex.empty())
+		return;
+
+	// 簢 Ʈ(0,1,2,3) ﰢ Ʈ ٲ ⺻ ε ۿ   ۷ ׸.
+	CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_QUAD);
+
+	UINT uQuadCount = ms_kVct_kBatchVertex.size() / 4;
+
+	for (UINT uBase = 0; uBase < uQuadCount; uBase += CGraphicBase::FILL_QUAD_MAX_NUM)
+	{
+		UINT uCount = MIN(uQuadCount - uBase, (UINT) CGraphicBase::FILL_QUAD_MAX_NUM);
+
+		if (CGraphicBase::SetDynamicStream(&ms_kVct_kBatchVertex[uBase * 4], uCount * 4, sizeof(TPDTVertex)))
+			STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, uCount * 4, 0, uCount * 2);
+	}
+
+	ms_kVct_kBatchVertex.clear();
+}
+
 DWORD CParticleSystemInstance::GetEmissionCount()
 {
 	return m_dwCurrentEmissionCount;
@@ -316,37 +356,39 @@ bool CParticleSystemInstance::OnUpdate(float fElapsedTime)
 
 	for (dwFrameIndex = 0; dwFrameIndex < dwFrameCount; dwFrameIndex++)
 	{
-		TParticleInstanceList::iterator itor = m_ParticleInstanceListVector[dwFrameIndex].begin();
-		for (; itor != m_ParticleInstanceListVector[dwFrameIndex].end();)
+		// Ƴ ƼŬ   ´.  ״ ȴ.
+		TParticleInstanceList & rkLst_pkParticleInst = m_ParticleInstanceListVector[dwFrameIndex];
+		DWORD dwAliveCount = 0;
+
+		for (DWORD i = 0; i < rkLst_pkParticleInst.size(); ++i)
 		{
-			CParticleInstance * pInstance = *itor;
+			CParticleInstance * pInstance = rkLst_pkParticleInst[i];
 
 			if (!pInstance->Update(fElapsedTime,fAngularVelocity))
 			{
 				pInstance->DeleteThis();
-
-				itor = m_ParticleInstanceListVector[dwFrameIndex].erase(itor);
 				m_dwCurrentEmissionCount--;
 			}
+			else if (pInstance->m_byFrameIndex != dwFrameIndex)
+			{
+				m_ParticleInstanceListVector[dwFrameCount+pInstance->m_byFrameIndex].push_back(pInstance);
+			}
 			else
 			{
-				if (pInstance->m_byFrameIndex != dwFrameIndex)
-				{
-					m_ParticleInstanceListVector[dwFrameCount+pInstance->m_byFrameIndex].push_back(*itor);
-					itor = m_ParticleInstanceListVector[dwFrameIndex].erase(itor);
-				}
-				else
-					++itor;
+				rkLst_pkParticleInst[dwAliveCount++] = pInstance;
 			}
 		}
+
+		rkLst_pkParticleInst.resize(dwAliveCount);
 	}
 	if (isActive() && bMakeParticle)
 		CreateParticles(fElapsedTime);
 
 	for (dwFrameIndex = 0; dwFrameIndex < dwFrameCount; ++dwFrameIndex)
 	{
-		m_ParticleInstanceListVector[dwFrameIndex].splice(m_ParticleInstanceListVector[dwFrameIndex].end(),m_ParticleInstanceListVector[dwFrameIndex+dwFrameCount]);
-		m_ParticleInstanceListVector[dwFrameIndex+dwFrameCount].clear();
+		TParticleInstanceList & rkLst_pkMoved = m_ParticleInstanceListVector[dwFrameIndex+dwFrameCount];
+		m_ParticleInstanceListVector[dwFrameIndex].insert(m_ParticleInstanceListVector[dwFrameIndex].end(), rkLst_pkMoved.begin(), rkLst_pkMoved.end());
+		rkLst_pkMoved.clear();
 	}
 
 	return true;
@@ -365,10 +407,10 @@ namespace NParticleRenderer
 		inline void operator () (CParticleInstance * pInstance)
 		{
 			pInstance->Transform(pmat,D3DXToRadian(-30.0f));
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 
 			pInstance->Transform(pmat,D3DXToRadian(+30.0f));
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 		}
 	};
 	
@@ -383,11 +425,11 @@ namespace NParticleRenderer
 		inline void operator () (CParticleInstance * pInstance)
 		{
 			pInstance->Transform(pmat);
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 			pInstance->Transform(pmat,D3DXToRadian(-60.0f));
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 			pInstance->Transform(pmat,D3DXToRadian(+60.0f));
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 		}
 	};
 	
@@ -396,7 +438,7 @@ namespace NParticleRenderer
 		inline void operator () (CParticleInstance * pInstance)
 		{
 			pInstance->Transform();
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 		}
 	};
 	struct AttachRenderer
@@ -410,7 +452,7 @@ namespace NParticleRenderer
 		inline void operator () (CParticleInstance * pInstance)
 		{
 			pInstance->Transform(pmat);
-			STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, pInstance->GetParticleMeshPointer(), sizeof(TPTVertex));
+			CParticleSystemInstance::AppendBatchQuad(pInstance);
 		}
 	};
 }
@@ -421,6 +463,10 @@ void CParticleSystemInstance::OnRender()
 	STATEMANAGER.SetRenderState(D3DRS_SRCBLEND, m_pParticleProperty->m_bySrcBlendType);
 	STATEMANAGER.SetRenderState(D3DRS_DESTBLEND, m_pParticleProperty->m_byDestBlendType);
 	STATEMANAGER.SetTextureStageState(0,D3DTSS_COLOROP,m_pParticleProperty->m_byColorOperationType);
+	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLORARG1, D3DTA_DIFFUSE);
+	STATEMANAGER.SaveTextureStageState(0, D3DTSS_ALPHAARG1, D3DTA_DIFFUSE);
+	STATEMANAGER.SaveFVF(D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1);
+
 	if (m_pParticleProperty->m_byBillboardType < BILLBOARD_TYPE_2FACE)
 	{
 		if (!m_pParticleProperty->m_bAttachFlag)
@@ -460,6 +506,10 @@ void CParticleSystemInstance::OnRender()
 			ForEachParticleRendering(func);
 		}
 	}
+
+	STATEMANAGER.RestoreTextureStageState(0, D3DTSS_COLORARG1);
+	STATEMANAGER.RestoreTextureStageState(0, D3DTSS_ALPHAARG1);
+	STATEMANAGER.RestoreFVF();
 }
 
 void CParticleSystemInstance::OnSetDataPointer(CEffectElementBase * pElement)
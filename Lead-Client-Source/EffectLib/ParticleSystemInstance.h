@@ -9,6 +9,8 @@
 #include "../eterLib/GrpImageInstance.h"
 #include "EmitterProperty.h"
 
+#include "../../Lead-Shared-Source/common/chunk_pool.h"
+
 class CParticleSystemInstance : public CEffectElementBaseInstance
 {
 	public:
@@ -17,7 +19,10 @@ class CParticleSystemInstance : public CEffectElementBaseInstance
 		static CParticleSystemInstance* New();
 		static void Delete(CParticleSystemInstance* pkData);
 
-		static CDynamicPool<CParticleSystemInstance>	ms_kPool;
+		static CChunkPool<CParticleSystemInstance>	ms_kPool;
+
+		// ƼŬ DrawPrimitiveUP  ʰ ؽ Ӻ Ƽ ѹ ׸.
+		static void AppendBatchQuad(CParticleInstance * pInstance);
 
 	public:
 		template <typename T>
@@ -26,14 +31,23 @@ class CParticleSystemInstance : public CEffectElementBaseInstance
 			DWORD dwFrameIndex;
 			for(dwFrameIndex=0; dwFrameIndex<m_kVct_pkImgInst.size(); dwFrameIndex++)
 			{
+				TParticleInstanceList & rkLst_pkParticleInst = m_ParticleInstanceListVector[dwFrameIndex];
+				if (rkLst_pkParticleInst.empty())
+					continue;
+
 				STATEMANAGER.SetTexture(0, m_kVct_pkImgInst[dwFrameIndex]->GetTextureReference().GetD3DTexture());
-				TParticleInstanceList::iterator itor = m_ParticleInstanceListVector[dwFrameIndex].begin();
-				for (; itor != m_ParticleInstanceListVector[dwFrameIndex].end(); ++itor)
+				TParticleInstanceList::iterator itor = rkLst_pkParticleInst.begin();
+				for (; itor != rkLst_pkParticleInst.end(); ++itor)
 				{
 					if (!InFrustum(*itor))
+					{
+						__FlushBatch();
 						return;
+					}
 					FunObj(*itor);
 				}
+
+				__FlushBatch();
 			}
 		}
 
@@ -65,13 +79,15 @@ class CParticleSystemInstance : public CEffectElementBaseInstance
 		bool OnUpdate(float fElapsedTime);
 		void OnRender();
 
+		static void __FlushBatch();
+
 	protected:
 		float m_fEmissionResidue;
 		
 		DWORD m_dwCurrentEmissionCount;
 		int	m_iLoopCount;
 
-		typedef std::list<CParticleInstance*> TParticleInstanceList;
+		typedef std::vector<CParticleInstance*> TParticleInstanceList;
 		typedef std::vector<TParticleInstanceList> TParticleInstanceListVector;
 		TParticleInstanceListVector m_ParticleInstanceListVector;
 
@@ -82,4 +98,6 @@ class CParticleSystemInstance : public CEffectElementBaseInstance
 
 		CParticleProperty * m_pParticleProperty;
 		CEmitterProperty * m_pEmitterProperty;
+
+		static std::vector<TPDTVertex>	ms_kVct_kBatchVertex;
 };
@@ -54,10 +54,62 @@ static unsigned long CRCTable[256] =
 #define DO8(buf, i)     DO4(buf, i); DO4(buf, i + 4);
 #define DO16(buf, i)    DO8(buf, i); DO8(buf, i + 8);
 
+#ifndef UPPER
+#define UPPER(c)        (((c)>='a'  && (c) <= 'z') ? ((c)+('A'-'a')) : (c))
+#endif
+
+//   8Ʈ óϴ slice-by-8 ̺. s_aadwCRCTable8[0]  CRCTable  .
+// SSE4.2  crc32  ٸ ׽(CRC-32C)̶  ޶Ƿ  ʴ´.
+static DWORD s_aadwCRCTable8[8][256];
+static BYTE s_abUpper[256];
+static bool s_isCRCTable8Ready = false;
+
+// ٸ  ü ڿ ҷ ̺    Ʈ óѴ.
+static struct SCRCTable8Initializer
+{
+	SCRCTable8Initializer()
+	{
+		for (int i = 0; i < 256; ++i)
+		{
+			s_aadwCRCTable8[0][i] = CRCTable[i];
+			s_abUpper[i] = (BYTE) UPPER(i);
+		}
+
+		for (int k = 1; k < 8; ++k)
+			for (int i = 0; i < 256; ++i)
+				s_aadwCRCTable8[k][i] = (s_aadwCRCTable8[k - 1][i] >> 8) ^ s_aadwCRCTable8[0][s_aadwCRCTable8[k - 1][i] & 0xff];
+
+		s_isCRCTable8Ready = true;
+	}
+} s_kCRCTable8Initializer;
+
+#define SLICE8(b0, b1, b2, b3, b4, b5, b6, b7) \
+	{ \
+		DWORD lo = crc ^ ((DWORD) (b0) | ((DWORD) (b1) << 8) | ((DWORD) (b2) << 16) | ((DWORD) (b3) << 24)); \
+		crc = s_aadwCRCTable8[7][lo & 0xff] ^ s_aadwCRCTable8[6][(lo >> 8) & 0xff] ^ \
+			s_aadwCRCTable8[5][(lo >> 16) & 0xff] ^ s_aadwCRCTable8[4][lo >> 24] ^ \
+			s_aadwCRCTable8[3][(BYTE) (b4)] ^ s_aadwCRCTable8[2][(BYTE) (b5)] ^ \
+			s_aadwCRCTable8[1][(BYTE) (b6)] ^ s_aadwCRCTable8[0][(BYTE) (b7)]; \
+	}
+
 DWORD GetCRC32(const char * buf, size_t len)
 {
     DWORD crc = 0xffffffff;
 
+    if (s_isCRCTable8Ready)
+    {
+        const BYTE * p = (const BYTE *) buf;
+
+        while (len >= 8)
+        {
+            SLICE8(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+            p += 8;
+            len -= 8;
+        }
+
+        buf = (const char *) p;
+    }
+
     if (len >= 16)
     {
         do
@@ -83,10 +135,6 @@ DWORD GetCRC32(const char * buf, size_t len)
 	return crc;
 }
 
-#ifndef UPPER
-#define UPPER(c)        (((c)>='a'  && (c) <= 'z') ? ((c)+('A'-'a')) : (c))
-#endif
-
 #define DO1CI(buf, i)   crc = CRCTable[(crc ^ UPPER(buf[i])) & 0xff] ^ (crc >> 8)
 #define DO2CI(buf, i)   DO1CI(buf, i); DO1CI(buf, i + 1);
 #define DO4CI(buf, i)   DO2CI(buf, i); DO2CI(buf, i + 2);
@@ -97,6 +145,21 @@ DWORD GetCaseCRC32(const char * buf, size_t len)
 {
     DWORD crc = 0xffffffff;
 
+    if (s_isCRCTable8Ready)
+    {
+        const BYTE * p = (const BYTE *) buf;
+        const BYTE * u = s_abUpper;
+
+        while (len >= 8)
+        {
+            SLICE8(u[p[0]], u[p[1]], u[p[2]], u[p[3]], u[p[4]], u[p[5]], u[p[6]], u[p[7]]);
+            p += 8;
+            len -= 8;
+        }
+
+        buf = (const char *) p;
+    }
+
     if (16 <= len)
     {
         do
@@ -8,6 +8,7 @@
 
 #define dbg_printf
 
+//  δ   Ƿ  ϸ ٴ.
 static class LZOFreeMemoryMgr
 {
 public:
@@ -16,6 +17,10 @@ public:
 		REUSING_CAPACITY = 64*1024,
 	};
 public:
+	LZOFreeMemoryMgr()
+	{
+		InitializeCriticalSection(&m_cs);
+	}
 	~LZOFreeMemoryMgr()
 	{
 		std::vector<BYTE*>::iterator i;
@@ -23,20 +28,27 @@ public:
 			delete *i;
 
 		m_freeVector.clear();
+		DeleteCriticalSection(&m_cs);
 	}
 	BYTE* Alloc(unsigned capacity)
 	{
 		assert(capacity > 0);
 		if (capacity < REUSING_CAPACITY)
 		{
+			EnterCriticalSection(&m_cs);
+
 			if (!m_freeVector.empty())
 			{
 				BYTE* freeMem = m_freeVector.back();
 				m_freeVector.pop_back();
+				LeaveCriticalSection(&m_cs);
 
 				dbg_printf("lzo.reuse_alloc\t%p(%d) free\n", freeMem, capacity);
 				return freeMem;
 			}
+
+			LeaveCriticalSection(&m_cs);
+
 			BYTE* newMem = new BYTE[REUSING_CAPACITY];
 			dbg_printf("lzo.reuse_alloc\t%p(%d) real\n", newMem, capacity);
 			return newMem;
@@ -52,7 +64,9 @@ public:
 		if (capacity < REUSING_CAPACITY)
 		{
 			dbg_printf("lzo.reuse_free\t%p(%d)\n", ptr, capacity);
+			EnterCriticalSection(&m_cs);
 			m_freeVector.push_back(ptr);
+			LeaveCriticalSection(&m_cs);
 			return;
 		}
 
@@ -61,6 +75,7 @@ public:
 	}
 private:
 	std::vector<BYTE*> m_freeVector;
+	CRITICAL_SECTION m_cs;
 } gs_freeMemMgr;
 
 
@@ -155,19 +170,22 @@ void CLZObject::BeginCompressInBuffer(const void * pvIn, UINT uiInLen, void * /*
 	m_bInBuffer = true;
 }
 
-bool CLZObject::Compress()
+bool CLZObject::Compress(BYTE * pbWorkMem)
 {
     UINT	iOutLen;
     BYTE *	pbBuffer;
+
+	if (!pbWorkMem)
+		pbWorkMem = CLZO::Instance().GetWorkMemory();
 	
     pbBuffer = m_pbBuffer + sizeof(THeader);
     *(DWORD *) pbBuffer = ms_dwFourCC;
     pbBuffer += sizeof(DWORD);
 
 #if defined( LZO1X_999_MEM_COMPRESS )
-    int r = lzo1x_999_compress((BYTE *) m_pbIn, m_pHeader->dwRealSize, pbBuffer, (lzo_uint*) &iOutLen, CLZO::Instance().GetWorkMemory());
+    int r = lzo1x_999_compress((BYTE *) m_pbIn, m_pHeader->dwRealSize, pbBuffer, (lzo_uint*) &iOutLen, pbWorkMem);
 #else
-    int r = lzo1x_1_compress((BYTE *) m_pbIn, m_pHeader->dwRealSize, pbBuffer, (lzo_uint*) &iOutLen, CLZO::Instance().GetWorkMemory());
+    int r = lzo1x_1_compress((BYTE *) m_pbIn, m_pHeader->dwRealSize, pbBuffer, (lzo_uint*) &iOutLen, pbWorkMem);
 #endif
 	
     if (LZO_E_OK != r)
@@ -349,11 +367,7 @@ CLZO::CLZO() : m_pWorkMem(NULL)
 		return;
     }
 
-#if defined( LZO1X_999_MEM_COMPRESS )
-    m_pWorkMem = (BYTE *) malloc(LZO1X_999_MEM_COMPRESS);
-#else
-    m_pWorkMem = (BYTE *) malloc(LZO1X_1_MEM_COMPRESS);
-#endif
+    m_pWorkMem = (BYTE *) malloc(GetWorkMemorySize());
 
     if (NULL == m_pWorkMem)
     {
@@ -371,17 +385,26 @@ CLZO::~CLZO()
     }
 }
 
-bool CLZO::CompressMemory(CLZObject & rObj, const void * pIn, UINT uiInLen)
+UINT CLZO::GetWorkMemorySize()
+{
+#if defined( LZO1X_999_MEM_COMPRESS )
+    return LZO1X_999_MEM_COMPRESS;
+#else
+    return LZO1X_1_MEM_COMPRESS;
+#endif
+}
+
+bool CLZO::CompressMemory(CLZObject & rObj, const void * pIn, UINT uiInLen, BYTE * pbWorkMem)
 {
     rObj.BeginCompress(pIn, uiInLen);
-    return rObj.Compress();
+    return rObj.Compress(pbWorkMem);
 }
 
-bool CLZO::CompressEncryptedMemory(CLZObject & rObj, const void * pIn, UINT uiInLen, DWORD * pdwKey)
+bool CLZO::CompressEncryptedMemory(CLZObject & rObj, const void * pIn, UINT uiInLen, DWORD * pdwKey, BYTE * pbWorkMem)
 {
     rObj.BeginCompress(pIn, uiInLen);
 	
-    if (rObj.Compress())
+    if (rObj.Compress(pbWorkMem))
     {
 		if (rObj.Encrypt(pdwKey))
 			return true;
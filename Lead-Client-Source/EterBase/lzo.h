@@ -25,7 +25,7 @@ class CLZObject
 		
 		void			BeginCompress(const void * pvIn, UINT uiInLen);
 		void			BeginCompressInBuffer(const void * pvIn, UINT uiInLen, void * pvOut);
-		bool			Compress();
+		bool			Compress(BYTE * pbWorkMem = NULL);
 		
 		bool			BeginDecompress(const void * pvIn);
 		bool			Decompress(DWORD * pdwKey = NULL);
@@ -62,10 +62,14 @@ class CLZO : public CSingleton<CLZO>
 		CLZO();
 		virtual ~CLZO();
 		
-		bool	CompressMemory(CLZObject & rObj, const void * pIn, UINT uiInLen);
-		bool	CompressEncryptedMemory(CLZObject & rObj, const void * pIn, UINT uiInLen, DWORD * pdwKey);
+		//  ۾ ޸𸮴 ϳ̹Ƿ  忡 Ϸ 帶
+		// GetWorkMemorySize ŭ  pbWorkMem  ѱ. NULL ̸  ޸𸮸 .
+		bool	CompressMemory(CLZObject & rObj, const void * pIn, UINT uiInLen, BYTE * pbWorkMem = NULL);
+		bool	CompressEncryptedMemory(CLZObject & rObj, const void * pIn, UINT uiInLen, DWORD * pdwKey, BYTE * pbWorkMem = NULL);
 		bool	Decompress(CLZObject & rObj, const BYTE * pbBuf, DWORD * pdwKey = NULL);
 		BYTE *	GetWorkMemory();
+
+		static UINT	GetWorkMemorySize();
 		
 	private:
 		BYTE *	m_pWorkMem;
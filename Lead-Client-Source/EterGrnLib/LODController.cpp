@@ -180,6 +180,7 @@ void CGrannyLODController::SetSpecularInfo(const char* c_szMtrlName, BOOL bEnabl
 
 CGrannyLODController::CGrannyLODController() : 
 	m_pCurrentModelInstance(NULL),
+	m_pDeformedModelInstance(NULL),
 	m_bLODLevel(0),
 	m_pAttachedParentModel(NULL),
 	m_fLODDistance(0.0f),
@@ -204,6 +205,7 @@ void CGrannyLODController::Clear()
 	}
 
 	m_pCurrentModelInstance = NULL;
+	m_pDeformedModelInstance = NULL;
 	m_pAttachedParentModel = NULL;
 
 	std::for_each(m_que_pkModelInst.begin(), m_que_pkModelInst.end(), CGrannyModelInstance::Delete);
@@ -290,6 +292,7 @@ void CGrannyLODController::AddModel(CGraphicThing * pThing, int iSrcModel, CGran
 	pThing->Release();
 
 	m_que_pkModelInst.push_front(pModelInstance);	
+	m_pDeformedModelInstance = NULL;
 }
 
 
@@ -589,6 +592,8 @@ void CGrannyLODController::DeformAll(const D3DXMATRIX * c_pWorldMatrix)
 		CGrannyModelInstance* pkModelInst=(*i);
 		pkModelInst->Deform(c_pWorldMatrix);		
 	}	
+
+	m_pDeformedModelInstance = NULL;
 }
 
 void CGrannyLODController::DeformNoSkin(const D3DXMATRIX * c_pWorldMatrix)
@@ -600,7 +605,25 @@ void CGrannyLODController::DeformNoSkin(const D3DXMATRIX * c_pWorldMatrix)
 void CGrannyLODController::Deform(const D3DXMATRIX * c_pWorldMatrix)
 {
 	if (m_pCurrentModelInstance)
+	{
 		m_pCurrentModelInstance->Deform(c_pWorldMatrix);
+		m_pDeformedModelInstance = m_pCurrentModelInstance;
+	}
+}
+
+void CGrannyLODController::UpdateWorldMatrices(const D3DXMATRIX * c_pWorldMatrix)
+{
+	if (!m_pCurrentModelInstance)
+		return;
+
+	// LOD  ٲų   ɾ    Ƿ ̹ ŰѴ.
+	if (m_pDeformedModelInstance != m_pCurrentModelInstance)
+	{
+		Deform(c_pWorldMatrix);
+		return;
+	}
+
+	m_pCurrentModelInstance->UpdateWorldMatrices(c_pWorldMatrix);
 }
 
 void CGrannyLODController::RenderToShadowMap()
@@ -650,12 +673,14 @@ void CGrannyLODController::SetMotionPointer(const CGrannyMotion * c_pMotion, flo
 {
 	assert(m_pCurrentModelInstance != NULL);
 	m_pCurrentModelInstance->SetMotionPointer(c_pMotion, fBlendTime, iLoopCount, speedRatio);
+	m_pDeformedModelInstance = NULL;
 }
 
 void CGrannyLODController::ChangeMotionPointer(const CGrannyMotion * c_pMotion, int iLoopCount, float speedRatio)
 {
 	assert(m_pCurrentModelInstance != NULL);
 	m_pCurrentModelInstance->ChangeMotionPointer(c_pMotion, iLoopCount, speedRatio);
+	m_pDeformedModelInstance = NULL;
 }
 
 void CGrannyLODController::SetMotionAtEnd()
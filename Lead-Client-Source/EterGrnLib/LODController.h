@@ -108,6 +108,16 @@ class CGrannyLODController : public CGraphicBase
 					pController->Deform(mc_pWorldMatrix);
 			}
 		};
+		struct FUpdateWorldMatrices
+		{
+			const D3DXMATRIX * mc_pWorldMatrix;
+			
+			void operator() (CGrannyLODController * pController)
+			{
+				if (pController->isModelInstance())
+					pController->UpdateWorldMatrices(mc_pWorldMatrix);
+			}
+		};
 		struct FDeformNoSkin
 		{
 			const D3DXMATRIX * mc_pWorldMatrix;
@@ -252,6 +262,7 @@ class CGrannyLODController : public CGraphicBase
 		void	Deform(const D3DXMATRIX * c_pWorldMatrix);
 		void	DeformNoSkin(const D3DXMATRIX * c_pWorldMatrix);
 		void	DeformAll(const D3DXMATRIX * c_pWorldMatrix);
+		void	UpdateWorldMatrices(const D3DXMATRIX * c_pWorldMatrix);	// Ű ǳʶٰ   ״ ű
 		
 		void	RenderToShadowMap();
 		void	RenderShadow();
@@ -295,6 +306,7 @@ class CGrannyLODController : public CGraphicBase
 
 		BYTE								m_bLODLevel;
 		CGrannyModelInstance *				m_pCurrentModelInstance;		
+		CGrannyModelInstance *				m_pDeformedModelInstance;		//  ؽ ۿ  Ű νϽ
 
 		// WORK
 		std::deque<CGrannyModelInstance *>	m_que_pkModelInst;
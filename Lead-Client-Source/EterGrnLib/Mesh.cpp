@@ -1,4 +1,6 @@
 #include "StdAfx.h"
+#include <emmintrin.h>
+
 #include "Mesh.h"
 #include "Model.h"
 #include "Material.h"
@@ -12,6 +14,18 @@ granny_data_type_definition GrannyPNT3322VertexType[5] =
 	{GrannyEndMember}
 };
 
+enum
+{
+	SKIN_BONE_MAX_NUM = 256,		// granny_pwnt3432_vertex   ε BYTE
+};
+
+bool CGrannyMesh::ms_isSIMDSkinning = IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE) ? true : false;
+
+void CGrannyMesh::SetSIMDSkinning(bool isEnable)
+{
+	ms_isSIMDSkinning = isEnable && IsProcessorFeaturePresent(PF_XMMI64_INSTRUCTIONS_AVAILABLE);
+}
+
 void CGrannyMesh::LoadIndices(void * dstBaseIndices)
 {
 	const granny_mesh * pgrnMesh = GetGrannyMeshPointer();
@@ -59,6 +73,13 @@ void CGrannyMesh::DeformPNTVertices(void * dstBaseVertices, D3DXMATRIX * boneMat
 	const granny_int32x* boneIndices = GrannyGetMeshBindingToBoneIndices(pgrnMeshBinding);
 	// END_OF_WORK
 
+	// PNT2 (UV  )  Granny ʿ ñ.
+	if (ms_isSIMDSkinning && m_pgrnSkinVertices && m_pgrnMeshType == GrannyPNT332VertexType)
+	{
+		__DeformPNTVertices_SSE2(dstVertices, boneMatrices, boneIndices, vtxCount);
+		return;
+	}
+
 	GrannyDeformVertices(
 		m_pgrnMeshDeformer, 
 		boneIndices, 
@@ -68,6 +89,68 @@ void CGrannyMesh::DeformPNTVertices(void * dstBaseVertices, D3DXMATRIX * boneMat
 		dstVertices);
 }
 
+// ؽ 4    ġ   ġ    ȯѴ.
+// D3DX     Ծ: p' = x * r0 + y * r1 + z * r2 + r3
+void CGrannyMesh::__DeformPNTVertices_SSE2(TPNTVertex * dstVertices, const D3DXMATRIX * boneMatrices, const granny_int32x * boneIndices, int vtxCount) const
+{
+	const int boneCount = m_pgrnMesh->BoneBindingCount;
+
+	// ޽ð   ĸ 4྿  д.
+	__m128 akBoneRow[SKIN_BONE_MAX_NUM * 4];
+
+	for (int b = 0; b < boneCount; ++b)
+	{
+		const float * c_pfMatrix = (const float *) &boneMatrices[boneIndices[b]];
+
+		akBoneRow[b * 4 + 0] = _mm_loadu_ps(c_pfMatrix + 0);
+		akBoneRow[b * 4 + 1] = _mm_loadu_ps(c_pfMatrix + 4);
+		akBoneRow[b * 4 + 2] = _mm_loadu_ps(c_pfMatrix + 8);
+		akBoneRow[b * 4 + 3] = _mm_loadu_ps(c_pfMatrix + 12);
+	}
+
+	const float c_fWeightScale = 1.0f / 255.0f;
+
+	for (int v = 0; v < vtxCount; ++v)
+	{
+		const granny_pwnt3432_vertex & c_rkSrc = m_pgrnSkinVertices[v];
+		TPNTVertex & rkDst = dstVertices[v];
+
+		// ġ ū ͺ ĵǾ ְ ù ° ׻ 0  ƴϴ.
+		const __m128 * c_pkRow = akBoneRow + c_rkSrc.BoneIndices[0] * 4;
+		__m128 w = _mm_set1_ps(c_rkSrc.BoneWeights[0] * c_fWeightScale);
+
+		__m128 r0 = _mm_mul_ps(c_pkRow[0], w);
+		__m128 r1 = _mm_mul_ps(c_pkRow[1], w);
+		__m128 r2 = _mm_mul_ps(c_pkRow[2], w);
+		__m128 r3 = _mm_mul_ps(c_pkRow[3], w);
+
+		for (int i = 1; i < 4 && c_rkSrc.BoneWeights[i]; ++i)
+		{
+			c_pkRow = akBoneRow + c_rkSrc.BoneIndices[i] * 4;
+			w = _mm_set1_ps(c_rkSrc.BoneWeights[i] * c_fWeightScale);
+
+			r0 = _mm_add_ps(r0, _mm_mul_ps(c_pkRow[0], w));
+			r1 = _mm_add_ps(r1, _mm_mul_ps(c_pkRow[1], w));
+			r2 = _mm_add_ps(r2, _mm_mul_ps(c_pkRow[2], w));
+			r3 = _mm_add_ps(r3, _mm_mul_ps(c_pkRow[3], w));
+		}
+
+		__m128 p = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(c_rkSrc.Position[0]), r0), _mm_mul_ps(_mm_set1_ps(c_rkSrc.Position[1]), r1)),
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(c_rkSrc.Position[2]), r2), r3));
+
+		__m128 n = _mm_add_ps(
+			_mm_add_ps(_mm_mul_ps(_mm_set1_ps(c_rkSrc.Normal[0]), r0), _mm_mul_ps(_mm_set1_ps(c_rkSrc.Normal[1]), r1)),
+			_mm_mul_ps(_mm_set1_ps(c_rkSrc.Normal[2]), r2));
+
+		// 4  ģ  ĭ   鼭 ´.
+		_mm_storeu_ps((float *) &rkDst.position, p);
+		_mm_storeu_ps((float *) &rkDst.normal, n);
+		rkDst.texCoord.x = c_rkSrc.UV[0];
+		rkDst.texCoord.y = c_rkSrc.UV[1];
+	}
+}
+
 bool CGrannyMesh::CanDeformPNTVertices() const
 {
 	return m_canDeformPNTVertex;
@@ -138,6 +221,14 @@ bool CGrannyMesh::CreateFromGrannyMeshPointer(granny_skeleton * pgrnSkeleton, gr
 
 		m_pgrnMeshDeformer = GrannyNewMeshDeformer(pgrnInputType, pgrnOutputType, GrannyDeformPositionNormal, GrannyAllowUncopiedTail);
 		assert(m_pgrnMeshDeformer != NULL && "Cannot create mesh deformer");
+
+		if (m_pgrnMesh->BoneBindingCount <= SKIN_BONE_MAX_NUM)
+		{
+			int vtxCount = GrannyGetMeshVertexCount(m_pgrnMesh);
+
+			m_pgrnSkinVertices = new granny_pwnt3432_vertex[vtxCount];
+			GrannyConvertVertexLayouts(vtxCount, pgrnInputType, GrannyGetMeshVertices(m_pgrnMesh), GrannyPWNT3432VertexType, m_pgrnSkinVertices);
+		}
 	}
 
 	// Two Side Mesh
@@ -274,6 +365,9 @@ void CGrannyMesh::Destroy()
 
     if (m_pgrnMeshDeformer)
 		GrannyFreeMeshDeformer(m_pgrnMeshDeformer); 	
+
+	if (m_pgrnSkinVertices)
+		delete [] m_pgrnSkinVertices;
 	
 	Initialize();
 }
@@ -289,6 +383,7 @@ void CGrannyMesh::Initialize()
 	m_pgrnMeshBindingTemp = NULL;
 	// END_OF_WORK
 	m_pgrnMeshDeformer = NULL;
+	m_pgrnSkinVertices = NULL;
 
 	m_triGroupNodes = NULL;	
 	
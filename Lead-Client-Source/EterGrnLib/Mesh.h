@@ -44,6 +44,9 @@ class CGrannyMesh
 		void					SetPNT2Mesh();
 
 		void					DeformPNTVertices(void* dstBaseVertices, D3DXMATRIX* boneMatrices, granny_mesh_binding* pgrnMeshBinding) const;
+
+		// SSE2  Ǵ CPU  Granny    ŰѴ. (  )
+		static void				SetSIMDSkinning(bool isEnable);
 		bool					CanDeformPNTVertices() const;
 		bool					IsTwoSide() const;
 
@@ -68,6 +71,8 @@ class CGrannyMesh
 		bool					LoadMaterials(CGrannyMaterialPalette& rkMtrlPal);
 		bool					LoadTriGroupNodeList(CGrannyMaterialPalette& rkMtrlPal);
 
+		void					__DeformPNTVertices_SSE2(TPNTVertex* dstVertices, const D3DXMATRIX* boneMatrices, const granny_int32x* boneIndices, int vtxCount) const;
+
 	protected:
 		// Granny Mesh Data
 		granny_data_type_definition *	m_pgrnMeshType;
@@ -78,6 +83,9 @@ class CGrannyMesh
 		// END_OF_WORK
 
 		granny_mesh_deformer *	m_pgrnMeshDeformer;
+		granny_pwnt3432_vertex *	m_pgrnSkinVertices;		// SSE2 Ű׿ ̸ ٲ   ؽ
+
+		static bool				ms_isSIMDSkinning;
 
 		// Granny Material Data
 		std::vector<DWORD>		m_mtrlIndexVector;
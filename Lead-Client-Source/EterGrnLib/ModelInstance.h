@@ -52,6 +52,7 @@ class CGrannyModelInstance : public CGraphicCollisionObject
 		void	UpdateTransform(D3DXMATRIX * pMatrix, float fSecondsElapsed);
 
 		void	UpdateSkeleton(const D3DXMATRIX * c_pWorldMatrix, float fLocalTime);
+		void	UpdateWorldMatrices(const D3DXMATRIX * c_pWorldMatrix);
 		void	DeformNoSkin(const D3DXMATRIX * c_pWorldMatrix);
 		void	Deform(const D3DXMATRIX * c_pWorldMatrix);
 
@@ -146,7 +147,6 @@ class CGrannyModelInstance : public CGraphicCollisionObject
 
 		// Update & Render
 		void	UpdateWorldPose();
-		void	UpdateWorldMatrices(const D3DXMATRIX * c_pWorldMatrix);
 		void	DeformPNTVertices(void * pvDest);
 
 		void	RenderMeshNodeListWithOneTexture(CGrannyMesh::EType eMeshType, CGrannyMaterial::EType eMtrlType);
@@ -5,6 +5,7 @@
 
 CGraphicThing::CGraphicThing(const char* c_szFileName) : CResource(c_szFileName)
 {
+	m_isMotionOnly = false;
 	Initialize();	
 }
 
@@ -22,12 +23,33 @@ void CGraphicThing::Initialize()
 
 	m_models = NULL;
 	m_motions = NULL;
+
+	m_iModelCount = 0;
+	m_iMotionCount = 0;
+}
+
+void CGraphicThing::SetMotionOnly(bool isMotionOnly)
+{
+	m_isMotionOnly = isMotionOnly;
 }
 
 void CGraphicThing::OnClear()
 {
 	if (m_motions)
+	{
+		// ִϸ̼ Ǯ  ּҿ ٸ ִϸ̼   Ƿ ε ĳø 
+		for (int m = 0; m < m_iMotionCount; ++m)
+		{
+			granny_animation * pgrnAni = m_motions[m].GetGrannyAnimationPointer();
+
+			if (pgrnAni)
+				GrannyFlushAllBindingsForAnimation(pgrnAni);
+		}
+
 		delete [] m_motions;
+	}
+
+	DestroyCompactMotions();
 
 	if (m_models)
 		delete [] m_models;
@@ -38,6 +60,11 @@ void CGraphicThing::OnClear()
 	Initialize();
 }
 
+int CGraphicThing::GetCacheGroup() const
+{
+	return GetMotionCount() > 0 ? CACHE_GROUP_MOTION : CACHE_GROUP_MODEL;
+}
+
 CGraphicThing::TType CGraphicThing::Type()
 {
 	static TType s_type = StringToType("CGraphicThing");
@@ -59,10 +86,10 @@ bool CGraphicThing::OnIsType(TType type)
 
 bool CGraphicThing::CreateDeviceObjects()
 {
-	if (!m_pgrnFileInfo)
+	if (!m_models)
 		return true;
 	
-	for (int m = 0; m < m_pgrnFileInfo->ModelCount; ++m)
+	for (int m = 0; m < m_iModelCount; ++m)
 	{
 		CGrannyModel & rModel = m_models[m];
 		rModel.CreateDeviceObjects();
@@ -73,10 +100,10 @@ bool CGraphicThing::CreateDeviceObjects()
 
 void CGraphicThing::DestroyDeviceObjects()
 {
-	if (!m_pgrnFileInfo)
+	if (!m_models)
 		return;
 
-	for (int m = 0; m < m_pgrnFileInfo->ModelCount; ++m)
+	for (int m = 0; m < m_iModelCount; ++m)
 	{
 		CGrannyModel & rModel = m_models[m];
 		rModel.DestroyDeviceObjects();
@@ -96,7 +123,7 @@ bool CGraphicThing::CheckModelIndex(int iModel) const
 	if (iModel < 0)
 		return false;
 
-	if (iModel >= m_pgrnFileInfo->ModelCount)
+	if (iModel >= m_iModelCount)
 		return false;
 
 	return true;
@@ -105,16 +132,14 @@ bool CGraphicThing::CheckModelIndex(int iModel) const
 bool CGraphicThing::CheckMotionIndex(int iMotion) const
 {
 	// Temporary
-	if (!m_pgrnFileInfo)
+	if (!m_motions)
 		return false;
 	// Temporary
 
-	assert(m_pgrnFileInfo != NULL);
-
 	if (iMotion < 0)
 		return false;
 	
-	if (iMotion >= m_pgrnFileInfo->AnimationCount)
+	if (iMotion >= m_iMotionCount)
 		return false;
 
 	return true;
@@ -131,7 +156,7 @@ CGrannyMotion * CGraphicThing::GetMotionPointer(int iMotion)
 {
 	assert(CheckMotionIndex(iMotion));
 
-	if (iMotion >= m_pgrnFileInfo->AnimationCount)
+	if (iMotion >= m_iMotionCount)
 		return NULL;
 
 	assert(m_motions != NULL);
@@ -140,18 +165,12 @@ CGrannyMotion * CGraphicThing::GetMotionPointer(int iMotion)
 
 int CGraphicThing::GetModelCount() const
 {
-	if (!m_pgrnFileInfo)
-		return 0;
-
-	return (m_pgrnFileInfo->ModelCount);
+	return m_iModelCount;
 }
 
 int CGraphicThing::GetMotionCount() const
 {
-	if (!m_pgrnFileInfo)
-		return 0;
-
-	return (m_pgrnFileInfo->AnimationCount);
+	return m_iMotionCount;
 }
 
 bool CGraphicThing::OnLoad(int iSize, const void * c_pvBuf)
@@ -169,6 +188,20 @@ bool CGraphicThing::OnLoad(int iSize, const void * c_pvBuf)
 	if (!m_pgrnFileInfo)
 		return false;
 
+	if (m_isMotionOnly && m_pgrnFileInfo->AnimationCount > 0)
+	{
+		//    ü GR2  Ƿ ⼭  ʴ´
+		if (LoadCompactMotions())
+		{
+			GrannyFreeAllFileSections(m_pgrnFile);
+			m_pgrnFileInfo = NULL;
+			return true;
+		}
+
+		TraceError("CGraphicThing::OnLoad(%s) - cannot compact motions, keep original", GetFileName());
+		DestroyCompactMotions();
+	}
+
 	LoadModels();
 	LoadMotions();
 	return true;
@@ -205,6 +238,7 @@ bool CGraphicThing::LoadModels()
 	int modelCount = m_pgrnFileInfo->ModelCount;
 
 	m_models = new CGrannyModel[modelCount];
+	m_iModelCount = modelCount;
 
 	for (int m = 0; m < modelCount; ++m)
 	{
@@ -233,6 +267,7 @@ bool CGraphicThing::LoadMotions()
 	int motionCount = m_pgrnFileInfo->AnimationCount;
 
 	m_motions = new CGrannyMotion[motionCount];
+	m_iMotionCount = motionCount;
 	
 	for (int m = 0; m < motionCount; ++m)
 		if (!m_motions[m].BindGrannyAnimation(m_pgrnFileInfo->Animations[m]))
@@ -240,3 +275,175 @@ bool CGraphicThing::LoadMotions()
 
 	return true;
 }
+
+static const granny_real32 c_afIdentityOrientation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+static const granny_real32 c_afIdentityPosition[3] = { 0.0f, 0.0f, 0.0f };
+
+// float Ű Ŀ(DaK32fC32f) 16Ʈ ȭ Ŀ ٽ . ٲ   Ŀ NULL
+static granny_curve2 * QuantizeCurve(const granny_curve2 * c_pgrnSrcCurve, granny_data_type_definition * pgrnType, int iDimension, const granny_real32 * c_pfIdentity)
+{
+	if (!GrannyCurveIsTypeDaK32fC32f(c_pgrnSrcCurve))
+		return NULL;
+
+	if (GrannyCurveGetDimension(c_pgrnSrcCurve) != iDimension)
+		return NULL;
+
+	int iKnotCount = GrannyCurveGetKnotCount(c_pgrnSrcCurve);
+
+	// Ű ϳ  Ŀ ȭ   ũ
+	if (iKnotCount <= 1)
+		return NULL;
+
+	std::vector<granny_real32> kVct_fKnot(iKnotCount);
+	std::vector<granny_real32> kVct_fControl(iKnotCount * iDimension);
+	GrannyCurveExtractKnotValues(c_pgrnSrcCurve, 0, iKnotCount, &kVct_fKnot[0], &kVct_fControl[0], c_pfIdentity);
+
+	granny_curve_builder * pgrnBuilder = GrannyBeginCurve(pgrnType, GrannyCurveGetDegree(c_pgrnSrcCurve), iDimension, iKnotCount);
+
+	if (!pgrnBuilder)
+		return NULL;
+
+	GrannyPushCurveKnotArray(pgrnBuilder, &kVct_fKnot[0]);
+	GrannyPushCurveControlArray(pgrnBuilder, &kVct_fControl[0]);
+	return GrannyEndCurve(pgrnBuilder);
+}
+
+const char * CGraphicThing::AddCompactString(const char * c_szString)
+{
+	m_kLst_stCompactString.push_back(c_szString ? c_szString : "");
+	return m_kLst_stCompactString.back().c_str();
+}
+
+granny_track_group * CGraphicThing::BuildCompactTrackGroup(const granny_track_group * c_pgrnSrcTrackGroup)
+{
+	//  Ʈ  Ƿ   ״ 
+	if (c_pgrnSrcTrackGroup->VectorTrackCount > 0)
+		return NULL;
+
+	granny_track_group_builder * pgrnBuilder = GrannyBeginTrackGroup(AddCompactString(c_pgrnSrcTrackGroup->Name),
+																	 0,
+																	 c_pgrnSrcTrackGroup->TransformTrackCount,
+																	 c_pgrnSrcTrackGroup->TextTrackCount,
+																	 false);
+
+	if (!pgrnBuilder)
+		return NULL;
+
+	//  Ŀ긦    ȭ Ŀ긦  ִ´
+	std::vector<granny_curve2 *> kVct_pgrnCurve;
+	kVct_pgrnCurve.reserve(c_pgrnSrcTrackGroup->TransformTrackCount * 2);
+
+	for (int t = 0; t < c_pgrnSrcTrackGroup->TransformTrackCount; ++t)
+	{
+		const granny_transform_track & c_rgrnTrack = c_pgrnSrcTrackGroup->TransformTracks[t];
+
+		GrannyBeginTransformTrack(pgrnBuilder, AddCompactString(c_rgrnTrack.Name), c_rgrnTrack.Flags);
+
+		granny_curve2 * pgrnOrientation = QuantizeCurve(&c_rgrnTrack.OrientationCurve, GrannyCurveDataD4nK16uC15uType, 4, c_afIdentityOrientation);
+		granny_curve2 * pgrnPosition = QuantizeCurve(&c_rgrnTrack.PositionCurve, GrannyCurveDataD3K16uC16uType, 3, c_afIdentityPosition);
+
+		GrannySetTransformTrackOrientationCurve(pgrnBuilder, pgrnOrientation ? pgrnOrientation : &c_rgrnTrack.OrientationCurve);
+		GrannySetTransformTrackPositionCurve(pgrnBuilder, pgrnPosition ? pgrnPosition : &c_rgrnTrack.PositionCurve);
+		GrannySetTransformTrackScaleShearCurve(pgrnBuilder, &c_rgrnTrack.ScaleShearCurve);
+		GrannyEndTransformTrack(pgrnBuilder);
+
+		if (pgrnOrientation)
+			kVct_pgrnCurve.push_back(pgrnOrientation);
+
+		if (pgrnPosition)
+			kVct_pgrnCurve.push_back(pgrnPosition);
+	}
+
+	for (int t = 0; t < c_pgrnSrcTrackGroup->TextTrackCount; ++t)
+	{
+		const granny_text_track & c_rgrnTrack = c_pgrnSrcTrackGroup->TextTracks[t];
+
+		GrannyBeginTextTrack(pgrnBuilder, AddCompactString(c_rgrnTrack.Name));
+
+		for (int e = 0; e < c_rgrnTrack.EntryCount; ++e)
+			GrannyAddTextEntry(pgrnBuilder, c_rgrnTrack.Entries[e].TimeStamp, AddCompactString(c_rgrnTrack.Entries[e].Text));
+
+		GrannyEndTextTrack(pgrnBuilder);
+	}
+
+	granny_track_group * pgrnTrackGroup = GrannyEndTrackGroup(pgrnBuilder);
+
+	for (size_t i = 0; i < kVct_pgrnCurve.size(); ++i)
+		GrannyFreeCurve(kVct_pgrnCurve[i]);
+
+	if (!pgrnTrackGroup)
+		return NULL;
+
+	pgrnTrackGroup->InitialPlacement = c_pgrnSrcTrackGroup->InitialPlacement;
+	pgrnTrackGroup->Flags = c_pgrnSrcTrackGroup->Flags;
+	memcpy(pgrnTrackGroup->LoopTranslation, c_pgrnSrcTrackGroup->LoopTranslation, sizeof(pgrnTrackGroup->LoopTranslation));
+	pgrnTrackGroup->PeriodicLoop = NULL;
+
+	GrannyResortTrackGroup(pgrnTrackGroup);
+	return pgrnTrackGroup;
+}
+
+bool CGraphicThing::LoadCompactMotions()
+{
+	assert(m_pgrnFile != NULL);
+	assert(m_motions == NULL);
+	assert(m_kVct_pgrnCompactAni.empty());
+
+	int motionCount = m_pgrnFileInfo->AnimationCount;
+
+	m_kVct_pgrnCompactAni.reserve(motionCount);
+
+	for (int m = 0; m < motionCount; ++m)
+	{
+		const granny_animation * c_pgrnSrcAni = m_pgrnFileInfo->Animations[m];
+
+		granny_animation * pgrnAni = new granny_animation;
+		memset(pgrnAni, 0, sizeof(granny_animation));
+		m_kVct_pgrnCompactAni.push_back(pgrnAni);
+
+		pgrnAni->Name = AddCompactString(c_pgrnSrcAni->Name);
+		pgrnAni->Duration = c_pgrnSrcAni->Duration;
+		pgrnAni->TimeStep = c_pgrnSrcAni->TimeStep;
+		pgrnAni->Oversampling = c_pgrnSrcAni->Oversampling;
+		pgrnAni->DefaultLoopCount = c_pgrnSrcAni->DefaultLoopCount;
+		pgrnAni->Flags = c_pgrnSrcAni->Flags;
+
+		pgrnAni->TrackGroups = new granny_track_group * [c_pgrnSrcAni->TrackGroupCount];
+		memset(pgrnAni->TrackGroups, 0, sizeof(granny_track_group *) * c_pgrnSrcAni->TrackGroupCount);
+		pgrnAni->TrackGroupCount = c_pgrnSrcAni->TrackGroupCount;
+
+		for (int g = 0; g < c_pgrnSrcAni->TrackGroupCount; ++g)
+		{
+			pgrnAni->TrackGroups[g] = BuildCompactTrackGroup(c_pgrnSrcAni->TrackGroups[g]);
+
+			if (!pgrnAni->TrackGroups[g])
+				return false;
+		}
+	}
+
+	m_motions = new CGrannyMotion[motionCount];
+
+	for (int m = 0; m < motionCount; ++m)
+		m_motions[m].BindGrannyAnimation(m_kVct_pgrnCompactAni[m]);
+
+	m_iMotionCount = motionCount;
+	return true;
+}
+
+void CGraphicThing::DestroyCompactMotions()
+{
+	for (size_t i = 0; i < m_kVct_pgrnCompactAni.size(); ++i)
+	{
+		granny_animation * pgrnAni = m_kVct_pgrnCompactAni[i];
+
+		for (int g = 0; g < pgrnAni->TrackGroupCount; ++g)
+			if (pgrnAni->TrackGroups[g])
+				GrannyFreeBuilderResult(pgrnAni->TrackGroups[g]);
+
+		delete [] pgrnAni->TrackGroups;
+		delete pgrnAni;
+	}
+
+	m_kVct_pgrnCompactAni.clear();
+	m_kLst_stCompactString.clear();
+}
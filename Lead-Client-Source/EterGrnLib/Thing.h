@@ -26,11 +26,20 @@ class CGraphicThing : public CResource
 		CGrannyMotion *			GetMotionPointer(int iMotion);
 		int						GetMotionCount() const;
 
+		virtual int				GetCacheGroup() const;
+
+		void					SetMotionOnly(bool isMotionOnly);
+
 	protected:
 		void					Initialize();
 
 		bool					LoadModels();
 		bool					LoadMotions();
+		bool					LoadCompactMotions();
+		void					DestroyCompactMotions();
+
+		granny_track_group *	BuildCompactTrackGroup(const granny_track_group * c_pgrnSrcTrackGroup);
+		const char *			AddCompactString(const char * c_szString);
 
 	protected:
 		bool					OnLoad(int iSize, const void* c_pvBuf);
@@ -46,4 +55,12 @@ class CGraphicThing : public CResource
 
 		CGrannyModel *			m_models;
 		CGrannyMotion *			m_motions;
+
+		int						m_iModelCount;
+		int						m_iMotionCount;
+
+		// θ ̴ GR2     ȭ 纻  ִ´
+		bool					m_isMotionOnly;
+		std::vector<granny_animation *>	m_kVct_pgrnCompactAni;
+		std::list<std::string>	m_kLst_stCompactString;
 };
@@ -2,12 +2,24 @@
 #include "../eterbase/Debug.h"
 #include "../eterlib/Camera.h"
 #include "../eterBase/Timer.h"
+#include "../eterlib/GrpTextureStreamer.h"
 #include "ThingInstance.h"
 #include "Thing.h"
 #include "ModelInstance.h"
 
 CDynamicPool<CGraphicThingInstance>		CGraphicThingInstance::ms_kPool;
 
+float CGraphicThingInstance::ms_fAniLODHalfRateDistance		= 3000.0f;
+float CGraphicThingInstance::ms_fAniLODQuarterRateDistance	= 5000.0f;
+float CGraphicThingInstance::ms_fAniLODFreezeDistance		= 10000.0f;
+
+void CGraphicThingInstance::SetAnimationLODDistance(float fHalfRateDistance, float fQuarterRateDistance, float fFreezeDistance)
+{
+	ms_fAniLODHalfRateDistance		= fHalfRateDistance;
+	ms_fAniLODQuarterRateDistance	= fQuarterRateDistance;
+	ms_fAniLODFreezeDistance		= fFreezeDistance;
+}
+
 CGraphicThing* CGraphicThingInstance::GetBaseThingPtr()
 {
 	if (m_modelThingSetVector.empty())
@@ -703,10 +715,37 @@ void CGraphicThingInstance::DeformNoSkin()
 	}
 }
 
+// 0 ̸  ߰, N ̸ N ӿ ѹ ŰѴ.
+DWORD CGraphicThingInstance::__GetDeformStep() const
+{
+	if (ms_fAniLODFreezeDistance > 0.0f && m_fDistanceFromCamera >= ms_fAniLODFreezeDistance)
+		return 0;
+
+	if (ms_fAniLODQuarterRateDistance > 0.0f && m_fDistanceFromCamera >= ms_fAniLODQuarterRateDistance)
+		return 4;
+
+	if (ms_fAniLODHalfRateDistance > 0.0f && m_fDistanceFromCamera >= ms_fAniLODHalfRateDistance)
+		return 2;
+
+	return 1;
+}
+
 void CGraphicThingInstance::OnDeform()
 {
 	m_bUpdated = true;
 
+	//  νϽ LOD Ʈѷ(, Ӹ, )  ӿ  ǳʶپ 
+	// ̷ ϴ   ߳ ʴ´.
+	DWORD dwStep = __GetDeformStep();
+
+	if (1 != dwStep && (0 == dwStep || (++m_dwDeformCount % dwStep) != 0))
+	{
+		CGrannyLODController::FUpdateWorldMatrices update;
+		update.mc_pWorldMatrix = &m_worldMatrix;
+		std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), update);
+		return;
+	}
+
 	CGrannyLODController::FDeform deform;
 	deform.mc_pWorldMatrix = &m_worldMatrix;
 	std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), deform);
@@ -743,6 +782,8 @@ void CGraphicThingInstance::UpdateLODLevel()
 									   (c_rv3CameraPosition.y - c_v3Position.y) * (c_rv3CameraPosition.y - c_v3Position.y) +
 									   (c_rv3CameraPosition.z - c_v3Position.z) * (c_rv3CameraPosition.z - c_v3Position.z));
 
+	m_fDistanceFromCamera = update.fDistanceFromCamera;
+
 	std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), update);
 }
 
@@ -798,8 +839,12 @@ void CGraphicThingInstance::RenderWithOneTexture()
 	if (!m_bUpdated)
 		return;
 
+	CGraphicTextureStreamer::SetDrawDistance(m_fDistanceFromCamera);
+
 	CGrannyLODController::FRenderWithOneTexture render;
 	std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), render);
+
+	CGraphicTextureStreamer::SetDrawDistance(0.0f);
 }
 
 void CGraphicThingInstance::BlendRenderWithOneTexture()
@@ -808,8 +853,12 @@ void CGraphicThingInstance::BlendRenderWithOneTexture()
 	if (!m_bUpdated)
 		return;
 
+	CGraphicTextureStreamer::SetDrawDistance(m_fDistanceFromCamera);
+
 	CGrannyLODController::FBlendRenderWithOneTexture blendRender;
 	std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), blendRender);
+
+	CGraphicTextureStreamer::SetDrawDistance(0.0f);
 }
 
 void CGraphicThingInstance::RenderWithTwoTexture()
@@ -818,8 +867,12 @@ void CGraphicThingInstance::RenderWithTwoTexture()
 	if (!m_bUpdated)
 		return;
 
+	CGraphicTextureStreamer::SetDrawDistance(m_fDistanceFromCamera);
+
 	CGrannyLODController::FRenderWithTwoTexture render;
 	std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), render);
+
+	CGraphicTextureStreamer::SetDrawDistance(0.0f);
 }
 
 void CGraphicThingInstance::BlendRenderWithTwoTexture()
@@ -828,8 +881,12 @@ void CGraphicThingInstance::BlendRenderWithTwoTexture()
 	if (!m_bUpdated)
 		return;
 
+	CGraphicTextureStreamer::SetDrawDistance(m_fDistanceFromCamera);
+
 	CGrannyLODController::FRenderWithTwoTexture blendRender;
 	std::for_each(m_LODControllerVector.begin(), m_LODControllerVector.end(), blendRender);
+
+	CGraphicTextureStreamer::SetDrawDistance(0.0f);
 }
 
 void CGraphicThingInstance::OnRenderToShadowMap()
@@ -925,6 +982,7 @@ void CGraphicThingInstance::OnInitialize()
 	m_fDelay = 0.0;
 	m_fSecondElapsed = 0.0f;
 	m_fAverageSecondElapsed = 0.03f;
+	m_fDistanceFromCamera = 0.0f;
 	m_fRadius = -1.0f;
 	m_v3Center = D3DXVECTOR3(0.0f, 0.0f, 0.0f);
 
@@ -933,6 +991,10 @@ void CGraphicThingInstance::OnInitialize()
 
 CGraphicThingInstance::CGraphicThingInstance()
 {
+	// ָ ִ νϽ  ӿ  Ű ʵ  ġ  ´.
+	static DWORD s_dwDeformSeed = 0;
+	m_dwDeformCount = s_dwDeformSeed++;
+
 	Initialize();
 }
 
@@ -35,6 +35,10 @@ class CGraphicThingInstance : public CGraphicObjectInstance
 		void		UpdateLODLevel();
 		void		UpdateTime();
 		void		DeformAll(); //  LOD 
+
+		// ī޶󿡼  Ÿ ָ ̷ Ű 2 , 4 Ӹ ϰ 
+		//  Ÿ   . 0 ̸  ܰ  ʴ´.
+		static void	SetAnimationLODDistance(float fHalfRateDistance, float fQuarterRateDistance, float fFreezeDistance);
 		
 		bool		LessRenderOrder(CGraphicThingInstance* pkThingInst);
 
@@ -115,6 +119,9 @@ class CGraphicThingInstance : public CGraphicObjectInstance
 		virtual bool	GetBoundingSphere(D3DXVECTOR3 & v3Center, float & fRadius);
 		virtual bool	GetBoundingAABB(D3DXVECTOR3 & v3Min, D3DXVECTOR3 & v3Max);
 
+	protected:
+		DWORD		__GetDeformStep() const;
+
 	protected:
 		void		OnClear();
 		void		OnDeform();
@@ -132,6 +139,8 @@ class CGraphicThingInstance : public CGraphicObjectInstance
 		float									m_fDelay;
 		float									m_fSecondElapsed;
 		float									m_fAverageSecondElapsed;
+		float									m_fDistanceFromCamera;
+		DWORD									m_dwDeformCount;
 		float									m_fRadius;
 		D3DXVECTOR3								m_v3Center;
 		D3DXVECTOR3								m_v3Min, m_v3Max;
@@ -154,5 +163,9 @@ class CGraphicThingInstance : public CGraphicObjectInstance
 
 		static CDynamicPool<CGraphicThingInstance>		ms_kPool;
 
+		static float	ms_fAniLODHalfRateDistance;
+		static float	ms_fAniLODQuarterRateDistance;
+		static float	ms_fAniLODFreezeDistance;
+
 		bool	HaveBlendThing();
 };
@@ -1,6 +1,7 @@
 #include "StdAfx.h"
 #include "CullingManager.h"
 #include "GrpObjectInstance.h"
+#include "Camera.h"
 
 //#define COUNT_SHOWING_SPHERE
 
@@ -56,6 +57,7 @@ void CCullingManager::VisibilityCallback(const Frustum &/*f*/,SpherePack *sphere
 
 #endif
 		pInstance->Hide();
+		__RemoveVisible(pInstance);
 	}
 	else
 	{
@@ -68,9 +70,92 @@ void CCullingManager::VisibilityCallback(const Frustum &/*f*/,SpherePack *sphere
 		}
 #endif
 		pInstance->Show();
+		__AppendVisible(pInstance);
 	}
 }
 
+void CCullingManager::__AppendVisible(CGraphicObjectInstance * pInstance)
+{
+	if (pInstance->m_iCullingVisibleIndex >= 0)
+		return;
+
+	pInstance->m_iCullingVisibleIndex = m_kVct_pkVisible.size();
+	m_kVct_pkVisible.push_back(pInstance);
+}
+
+void CCullingManager::__RemoveVisible(CGraphicObjectInstance * pInstance)
+{
+	int iIndex = pInstance->m_iCullingVisibleIndex;
+
+	if (iIndex < 0)
+		return;
+
+	CGraphicObjectInstance * pLastInstance = m_kVct_pkVisible.back();
+	m_kVct_pkVisible[iIndex] = pLastInstance;
+	pLastInstance->m_iCullingVisibleIndex = iIndex;
+	m_kVct_pkVisible.pop_back();
+
+	pInstance->m_iCullingVisibleIndex = -1;
+	pInstance->SetOccluded(false);
+}
+
+// ̴ νϽ Ӹ  ŭ ư ˻Ѵ.
+// νϽ     OCCLUSION_TEST_PER_FRAME   ʴ´.
+void CCullingManager::__ProcessOcclusion()
+{
+	if (m_kVct_pkVisible.empty())
+		return;
+
+	const D3DXVECTOR3 & c_rv3Eye = CCameraManager::Instance().GetCurrentCamera()->GetEye();
+
+	DWORD dwCount = min((DWORD) m_kVct_pkVisible.size(), (DWORD) OCCLUSION_TEST_PER_FRAME);
+
+	for (DWORD i = 0; i < dwCount; ++i)
+	{
+		if (m_dwOcclusionCursor >= m_kVct_pkVisible.size())
+			m_dwOcclusionCursor = 0;
+
+		CGraphicObjectInstance * pInstance = m_kVct_pkVisible[m_dwOcclusionCursor++];
+
+		D3DXVECTOR3 v3Center;
+		float fRadius;
+
+		if (!pInstance->GetBoundingSphere(v3Center, fRadius))
+		{
+			pInstance->SetOccluded(false);
+			continue;
+		}
+
+		pInstance->SetOccluded(m_pkOccluder->IsOccluded(c_rv3Eye, v3Center, fRadius));
+	}
+}
+
+void CCullingManager::__ClearOcclusion()
+{
+	for (DWORD i = 0; i < m_kVct_pkVisible.size(); ++i)
+		m_kVct_pkVisible[i]->SetOccluded(false);
+}
+
+void CCullingManager::SetOccluder(ICullingOccluder * pkOccluder)
+{
+	if (m_pkOccluder == pkOccluder)
+		return;
+
+	m_pkOccluder = pkOccluder;
+	__ClearOcclusion();
+}
+
+void CCullingManager::EnableOcclusionCulling(bool isEnable)
+{
+	if (m_isOcclusionCulling == isEnable)
+		return;
+
+	m_isOcclusionCulling = isEnable;
+
+	if (!m_isOcclusionCulling)
+		__ClearOcclusion();
+}
+
 void CCullingManager::RangeTestCallback(const Vector3d &/*p*/,float /*distance*/,SpherePack *sphere,ViewState state)
 {
 #ifdef SPHERELIB_STRICT
@@ -110,6 +195,9 @@ void CCullingManager::Process()
 	UpdateProjMatrix();
 	BuildViewFrustum();
 	m_Factory->FrustumTest(GetFrustum(), this);
+
+	if (m_isOcclusionCulling && m_pkOccluder)
+		__ProcessOcclusion();
 	//Tracef("cull process : %3d  ",ELTimer_GetMSec()-time);
 }
 
@@ -137,10 +225,11 @@ void CCullingManager::Unregister(CullingHandle h)
 		Tracef("show size : %5d\n",showingcount);
 	}
 #endif
+	__RemoveVisible((CGraphicObjectInstance *) h->GetUserData());
 	m_Factory->Remove(h);
 }
 
-CCullingManager::CCullingManager()
+CCullingManager::CCullingManager() : m_dwOcclusionCursor(0), m_pkOccluder(NULL), m_isOcclusionCulling(false)
 {
 	m_Factory = new SpherePackFactory(
 		10000,	// maximum count
@@ -6,6 +6,15 @@
 #include "../SphereLib/spherepack.h"
 
 class CGraphicObjectInstance;
+
+// ó ū ü   ؼ CCullingManager  Ѵ.
+class ICullingOccluder
+{
+	public:
+		virtual ~ICullingOccluder() {}
+		virtual bool IsOccluded(const D3DXVECTOR3 & c_rv3Eye, const D3DXVECTOR3 & c_rv3Center, float fRadius) = 0;
+};
+
 template <class T>
 struct RangeTester : public SpherePackCallback
 {
@@ -68,6 +77,11 @@ public:
 	typedef SpherePack * CullingHandle;
 	typedef std::vector<CGraphicObjectInstance *> TRangeList;
 
+	enum
+	{
+		OCCLUSION_TEST_PER_FRAME = 256,
+	};
+
 	CCullingManager();
 	virtual ~CCullingManager();
 
@@ -137,12 +151,31 @@ public:
 	CullingHandle Register(CGraphicObjectInstance * ob);
 	void Unregister(CullingHandle h);
 
+	// Occlusion
+	void SetOccluder(ICullingOccluder * pkOccluder);
+	void EnableOcclusionCulling(bool isEnable);
+	bool IsOcclusionCullingEnable() { return m_isOcclusionCulling; }
+	DWORD GetVisibleCount() { return m_kVct_pkVisible.size(); }
+
 	TRangeList::iterator begin() { return m_list.begin(); }
 	TRangeList::iterator end() { return m_list.end(); }
 
+protected:
+	void __AppendVisible(CGraphicObjectInstance * pInstance);
+	void __RemoveVisible(CGraphicObjectInstance * pInstance);
+	void __ProcessOcclusion();
+	void __ClearOcclusion();
+
 protected:
 	TRangeList m_list;
 
+	// ü ȿ ִ νϽ.    ϸ .
+	TRangeList m_kVct_pkVisible;
+	DWORD m_dwOcclusionCursor;
+
+	ICullingOccluder * m_pkOccluder;
+	bool m_isOcclusionCulling;
+
 	float m_RayFarDistance;
 
 	SpherePackFactory * m_Factory;
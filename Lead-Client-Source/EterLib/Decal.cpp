@@ -228,16 +228,16 @@ void CDecal::Render()
 	STATEMANAGER.SetTransform(D3DTS_WORLD, &matWorld);
 	
 	STATEMANAGER.SetFVF(D3DFVF_XYZ | D3DFVF_DIFFUSE | D3DFVF_TEX1);
-	
+
+	// Every fan indexes consecutive vertices, so upload them once to the shared
+	// dynamic buffer and draw each fan straight from its first vertex.
+	if (!CGraphicBase::SetDynamicStream(m_Vertices, m_dwVertexCount, sizeof(TPDTVertex)))
+		return;
+
 	for (DWORD dwi = 0; dwi < m_TriangleFanStructVector.size(); ++dwi)
-		STATEMANAGER.DrawIndexedPrimitiveUP(D3DPT_TRIANGLEFAN,
+		STATEMANAGER.DrawPrimitive(D3DPT_TRIANGLEFAN,
 		m_TriangleFanStructVector[dwi].m_wMinIndex,
-		m_TriangleFanStructVector[dwi].m_dwVertexCount,
-		m_TriangleFanStructVector[dwi].m_dwPrimitiveCount,
-		m_Indices + m_TriangleFanStructVector[dwi].m_wMinIndex,
-		D3DFMT_INDEX16,
-		m_Vertices,
-		sizeof(TPDTVertex));
+		m_TriangleFanStructVector[dwi].m_dwPrimitiveCount);
 }
 
 /*
@@ -1,42 +1,57 @@
 #include "StdAfx.h"
+#include <algorithm>
+#include <malloc.h>
 #include "../EterPack/EterPackManager.h"
 #include "FileLoaderThread.h"
 #include "ResourceManager.h"
 
-CFileLoaderThread::CFileLoaderThread() : m_bShutdowned(false), m_pArg(NULL), m_hThread(NULL), m_uThreadID(0)
+CFileLoaderThread::CFileLoaderThread() : m_dwRequestSequence(0), m_pCompleteList(NULL), m_hSemaphore(NULL), m_bShutdowned(false)
 {
 }
 
 CFileLoaderThread::~CFileLoaderThread()
 {
-	Destroy();
+	Shutdown();
 }
 
-int CFileLoaderThread::Create(void * arg)
+int CFileLoaderThread::Create(int iThreadCount)
 {
-	Arg(arg);
-	m_hThread = (HANDLE) _beginthreadex(NULL, 0, EntryPoint, this, 0, &m_uThreadID);
-
-	if (!m_hThread)
+	if (!Setup())
 		return false;
 
-	SetThreadPriority(m_hThread, THREAD_PRIORITY_NORMAL);
-	return true;
-}
+	if (iThreadCount <= 0)
+	{
+		//    ϳ .
+		SYSTEM_INFO kSystemInfo;
+		GetSystemInfo(&kSystemInfo);
+		iThreadCount = (int) kSystemInfo.dwNumberOfProcessors - 1;
+	}
 
-UINT CFileLoaderThread::Run(void * arg)
-{
-	if (!Setup())
-		return 0;
+	iThreadCount = max(1, min(iThreadCount, (int) MAX_THREAD_COUNT));
+
+	for (int i = 0; i < iThreadCount; ++i)
+	{
+		unsigned uThreadID;
+		HANDLE hThread = (HANDLE) _beginthreadex(NULL, 0, EntryPoint, this, 0, &uThreadID);
+
+		if (!hThread)
+		{
+			TraceError("CFileLoaderThread::Create: cannot create thread %d/%d", i, iThreadCount);
+			break;
+		}
 
-	return (Execute(arg));
+		SetThreadPriority(hThread, THREAD_PRIORITY_BELOW_NORMAL);
+		m_vec_hThread.push_back(hThread);
+	}
+
+	return !m_vec_hThread.empty();
 }
 
 /* Static */
 UINT CALLBACK CFileLoaderThread::EntryPoint(void * pThis)
 {
 	CFileLoaderThread * pThread = (CFileLoaderThread *) pThis;
-	return pThread->Run(pThread->Arg());
+	return pThread->Execute();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -48,19 +63,45 @@ void CFileLoaderThread::Destroy()
 		m_hSemaphore = NULL;
 	}
 
-	stl_wipe(m_pRequestDeque);
+	stl_wipe(m_pRequestHeap);
 	stl_wipe(m_pCompleteDeque);
+
+	if (m_pCompleteList)
+	{
+		PSLIST_ENTRY pEntry = InterlockedFlushSList(m_pCompleteList);
+
+		while (pEntry)
+		{
+			TData * pData = (TData *) pEntry;
+			pEntry = pEntry->Next;
+
+			delete [] ((char *) pData->pvBuf);
+			delete pData;
+		}
+
+		_aligned_free(m_pCompleteList);
+		m_pCompleteList = NULL;
+	}
+
+	m_map_pkPending.clear();
 }
 
 UINT CFileLoaderThread::Setup()
 {
 	m_hSemaphore = CreateSemaphore(NULL,		// no security attributes
 								   0,			// initial count
-								   65535,		// maximum count
+								   LONG_MAX,	// maximum count
 								   NULL);		// unnamed semaphore
 	if (!m_hSemaphore)
 		return 0;
 
+	// SLIST_HEADER  MEMORY_ALLOCATION_ALIGNMENT  ¾ƾ Ѵ.
+	m_pCompleteList = (SLIST_HEADER *) _aligned_malloc(sizeof(SLIST_HEADER), MEMORY_ALLOCATION_ALIGNMENT);
+
+	if (!m_pCompleteList)
+		return 0;
+
+	InitializeSListHead(m_pCompleteList);
 	return 1;
 }
 
@@ -69,20 +110,23 @@ void CFileLoaderThread::Shutdown()
 	if (!m_hSemaphore)
 		return;
 
-	BOOL bRet;
-	
 	m_bShutdowned = true;
 
-	do
+	if (!m_vec_hThread.empty())
 	{
-		bRet = ReleaseSemaphore(m_hSemaphore, 1, NULL);
+		ReleaseSemaphore(m_hSemaphore, (LONG) m_vec_hThread.size(), NULL);
+		WaitForMultipleObjects((DWORD) m_vec_hThread.size(), &m_vec_hThread[0], TRUE, 10000);	// 尡  Ǳ⸦ 10 ٸ
+
+		for (size_t i = 0; i < m_vec_hThread.size(); ++i)
+			CloseHandle(m_vec_hThread[i]);
+
+		m_vec_hThread.clear();
 	}
-	while (!bRet);
 
-	WaitForSingleObject(m_hThread, 10000);	// 尡  Ǳ⸦ 10 ٸ
+	Destroy();
 }
 
-UINT CFileLoaderThread::Execute(void * /*pvArg*/)
+UINT CFileLoaderThread::Execute()
 {
 	while (!m_bShutdowned)
 	{
@@ -97,7 +141,8 @@ UINT CFileLoaderThread::Execute(void * /*pvArg*/)
 		{ 
 			case WAIT_OBJECT_0:
 				{
-					Process();
+					if (Process())
+						Sleep(g_iLoadingDelayTime);
 				}
 				break;
 
@@ -107,74 +152,116 @@ UINT CFileLoaderThread::Execute(void * /*pvArg*/)
 		}
 	}
 
-	Destroy();
 	return 1;
 }
 
-void CFileLoaderThread::Request(std::string & c_rstFileName)	// called in main thread
+void CFileLoaderThread::Request(std::string & c_rstFileName, DWORD dwPriority)	// called in main thread
 {
+	if (!m_hSemaphore)
+		return;
+
+	// ̹ ûǾ    ̸ ٽ ø ʴ´.
+	std::map<std::string, TData *>::iterator it = m_map_pkPending.find(c_rstFileName);
+
+	if (m_map_pkPending.end() != it)
+	{
+		InterlockedExchange(&it->second->lCanceled, 0);
+		return;
+	}
+
 	TData * pData = new TData;
 
 	pData->dwSize = 0;
 	pData->pvBuf = NULL;
 	pData->stFileName = c_rstFileName;
+	pData->dwPriority = dwPriority;
+	pData->dwSequence = m_dwRequestSequence++;
+	pData->lCanceled = 0;
+
+	m_map_pkPending.insert(std::make_pair(c_rstFileName, pData));
 
 	m_RequestMutex.Lock();
-	m_pRequestDeque.push_back(pData);
+	m_pRequestHeap.push_back(pData);
+	std::push_heap(m_pRequestHeap.begin(), m_pRequestHeap.end(), FRequestLess());
 	m_RequestMutex.Unlock();
 
-	++m_iRestSemCount;
-
-	if (!ReleaseSemaphore(m_hSemaphore, m_iRestSemCount, NULL))
+	if (!ReleaseSemaphore(m_hSemaphore, 1, NULL))
 		TraceError("CFileLoaderThread::Request: ReleaseSemaphore error");
+}
+
+void CFileLoaderThread::Cancel(const std::string & c_rstFileName)	// called in main thread
+{
+	std::map<std::string, TData *>::iterator it = m_map_pkPending.find(c_rstFileName);
 
-	--m_iRestSemCount;
+	if (m_map_pkPending.end() == it)
+		return;
+
+	// ̹ д ̸ ״  д´. û ü Fetch  ƿ´.
+	InterlockedExchange(&it->second->lCanceled, 1);
 }
 
 bool CFileLoaderThread::Fetch(TData ** ppData)	// called in main thread
 {
-	m_CompleteMutex.Lock();
-
 	if (m_pCompleteDeque.empty())
 	{
-		m_CompleteMutex.Unlock();
-		return false;
+		if (!m_pCompleteList)
+			return false;
+
+		PSLIST_ENTRY pEntry = InterlockedFlushSList(m_pCompleteList);
+
+		//   ߿   տ Ƿ  Ϸ  Ų.
+		while (pEntry)
+		{
+			m_pCompleteDeque.push_front((TData *) pEntry);
+			pEntry = pEntry->Next;
+		}
+
+		if (m_pCompleteDeque.empty())
+			return false;
 	}
 
 	*ppData = m_pCompleteDeque.front();
 	m_pCompleteDeque.pop_front();
 
-	m_CompleteMutex.Unlock();
+	m_map_pkPending.erase((*ppData)->stFileName);
 	return true;
 }
 
-void CFileLoaderThread::Process()	// called in loader thread
+bool CFileLoaderThread::Process()	// called in loader threads
 {
 	m_RequestMutex.Lock();
 
-	if (m_pRequestDeque.empty())
+	if (m_pRequestHeap.empty())
 	{
 		m_RequestMutex.Unlock();
-		return;
+		return false;
 	}
 
-	TData * pData = m_pRequestDeque.front();
-	m_pRequestDeque.pop_front();
+	std::pop_heap(m_pRequestHeap.begin(), m_pRequestHeap.end(), FRequestLess());
+	TData * pData = m_pRequestHeap.back();
+	m_pRequestHeap.pop_back();
 
 	m_RequestMutex.Unlock();
 
-	LPCVOID pvBuf;
+	bool bLoaded = false;
 
-	if (CEterPackManager::Instance().Get(pData->File, pData->stFileName.c_str(), &pvBuf))
+	//  б  Ǯ 帶  .
+	if (!pData->lCanceled)
 	{
-		pData->dwSize	= pData->File.Size();
-		pData->pvBuf	= new char [pData->dwSize];
-		memcpy(pData->pvBuf, pvBuf, pData->dwSize);
-	}
+		LPCVOID pvBuf;
 
-	m_CompleteMutex.Lock();
-	m_pCompleteDeque.push_back(pData);
-	m_CompleteMutex.Unlock();
+		if (CEterPackManager::Instance().Get(pData->File, pData->stFileName.c_str(), &pvBuf))
+		{
+			pData->dwSize	= pData->File.Size();
+			pData->pvBuf	= new char [pData->dwSize];
+			memcpy(pData->pvBuf, pvBuf, pData->dwSize);
+		}
+
+		//   ٷ ݴ´.
+		pData->File.Destroy();
+		bLoaded = true;
+	}
 
-	Sleep(g_iLoadingDelayTime);
+	InterlockedPushEntrySList(m_pCompleteList, &pData->kEntry);
+	return bLoaded;
 }
@@ -1,17 +1,37 @@
 #ifndef __INC_YMIR_ETERLIB_FILELOADERTHREAD_H__
 #define __INC_YMIR_ETERLIB_FILELOADERTHREAD_H__
 
+#include <map>
 #include <deque>
-#include "Thread.h"
+#include <vector>
 #include "Mutex.h"
 #include "../eterBase/MappedFile.h"
 
+//  尡 켱  ѿ  о( Ǯ ) ش.
+// Request, Cancel, Fetch   忡 θ.
 class CFileLoaderThread 
 {
 	public:
+		enum
+		{
+			MAX_THREAD_COUNT = 8,
+		};
+
+		enum EPriority
+		{
+			PRIORITY_MODEL,		//   д´
+			PRIORITY_TEXTURE,
+			PRIORITY_ETC,
+		};
+
 		typedef struct SData
 		{
+			SLIST_ENTRY	kEntry;			// Ϸ Ͽ. ݵ ó д.
+
 			std::string	stFileName;
+			DWORD		dwPriority;
+			DWORD		dwSequence;		//  켱 û 
+			volatile LONG	lCanceled;
 
 			CMappedFile	File;
 			LPVOID		pvBuf;
@@ -22,42 +42,48 @@ class CFileLoaderThread
 		CFileLoaderThread();
 		~CFileLoaderThread();
 
-		int Create(void * arg);
+		int Create(int iThreadCount);	// 0 ̸ ھ  
 	
 	public:
-		void	Request(std::string & c_rstFileName);
+		void	Request(std::string & c_rstFileName, DWORD dwPriority = PRIORITY_ETC);
+		void	Cancel(const std::string & c_rstFileName);	//   о ǳʶڴ. Fetch δ  ä ´.
 		bool	Fetch(TData ** ppData);
 		void	Shutdown();
 
 	protected:
 		static UINT CALLBACK	EntryPoint(void * pThis);
-		UINT					Run(void * arg);
-
-		void *					Arg() const		{ return m_pArg; }
-		void					Arg(void * arg) { m_pArg = arg; }
-		
-		HANDLE					m_hThread;
-
-	private:
-		void *					m_pArg;
-		unsigned				m_uThreadID;
 
 	protected:
 		UINT					Setup();
-		UINT					Execute(void * pvArg);
+		UINT					Execute();
 		void					Destroy();
-		void					Process();
+		bool					Process();
 
 	private:
-		std::deque<TData *>		m_pRequestDeque;
+		struct FRequestLess
+		{
+			bool operator () (const TData * lhs, const TData * rhs) const
+			{
+				// priority heap   "ū"  Ƿ ݴ Ѵ.
+				if (lhs->dwPriority != rhs->dwPriority)
+					return lhs->dwPriority > rhs->dwPriority;
+
+				return lhs->dwSequence > rhs->dwSequence;
+			}
+		};
+
+		std::vector<TData *>	m_pRequestHeap;		// 켱 .  ȸ ٴ.
 		Mutex					m_RequestMutex;
+		DWORD					m_dwRequestSequence;
+
+		SLIST_HEADER *			m_pCompleteList;	//    ִ´.
+		std::deque<TData *>		m_pCompleteDeque;	//  尡  ͵
 
-		std::deque<TData *>		m_pCompleteDeque;
-		Mutex					m_CompleteMutex;
+		std::map<std::string, TData *>	m_map_pkPending;	//   . Cancel 
 
+		std::vector<HANDLE>		m_vec_hThread;
 		HANDLE					m_hSemaphore;
-		int						m_iRestSemCount;
-		bool					m_bShutdowned;
+		volatile bool			m_bShutdowned;
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,464 @@
+#include "StdAfx.h"
+#include "../eterBase/Stl.h"
+#include "FrameProfiler.h"
+
+enum
+{
+	GPU_WAIT,
+	GPU_DONE,
+	GPU_FAIL,
+};
+
+static const char * sc_aszPhaseName[CFrameProfiler::PHASE_NUM] =
+{
+	"network",
+	"update",
+	"terrain",
+	"tree",
+	"object",
+	"actor",
+	"effect",
+	"texttail",
+	"ui",
+	"present",
+};
+
+const char * CFrameProfiler::GetPhaseName(UINT ePhase)
+{
+	if (ePhase >= PHASE_NUM)
+		return "?";
+
+	return sc_aszPhaseName[ePhase];
+}
+
+CFrameProfiler::CFrameProfiler()
+{
+	m_isRunning = false;
+	m_isQueryFailed = false;
+	m_fpCapture = NULL;
+	m_dwFrameNum = 0;
+	QueryPerformanceFrequency(&m_liFrequency);
+
+	memset(m_akFrame, 0, sizeof(m_akFrame));
+	m_isQuery = false;
+
+	__Initialize();
+}
+
+CFrameProfiler::~CFrameProfiler()
+{
+	StopCapture();
+	__DestroyQueries();
+}
+
+void CFrameProfiler::__Initialize()
+{
+	m_isFrameOpen = false;
+	m_uCurFrame = 0;
+	m_uStackCount = 0;
+
+	for (UINT i = 0; i < FRAME_LATENCY_NUM; ++i)
+	{
+		m_akFrame[i].isPending = false;
+		m_akFrame[i].uTimestampCount = 0;
+	}
+
+	memset(&m_kLastResult, 0, sizeof(m_kLastResult));
+}
+
+DWORD CFrameProfiler::__GetUSec(const LARGE_INTEGER & c_rliBegin, const LARGE_INTEGER & c_rliEnd)
+{
+	if (!m_liFrequency.QuadPart)
+		return 0;
+
+	return (DWORD) ((c_rliEnd.QuadPart - c_rliBegin.QuadPart) * 1000000 / m_liFrequency.QuadPart);
+}
+
+void CFrameProfiler::Start()
+{
+	if (m_isRunning)
+		return;
+
+	__Initialize();
+	m_isRunning = true;
+}
+
+void CFrameProfiler::Stop()
+{
+	if (!m_isRunning)
+		return;
+
+	StopCapture();
+
+	m_isRunning = false;
+	m_isFrameOpen = false;
+	m_uStackCount = 0;
+}
+
+bool CFrameProfiler::StartCapture(const char * c_szFileName)
+{
+	StopCapture();
+
+	m_fpCapture = fopen(c_szFileName, "w");
+
+	if (!m_fpCapture)
+	{
+		TraceError("CFrameProfiler::StartCapture - cannot open %s", c_szFileName);
+		return false;
+	}
+
+	fprintf(m_fpCapture, "frame,frame_us");
+
+	for (UINT i = 0; i < PHASE_NUM; ++i)
+		fprintf(m_fpCapture, ",%s_cpu_us,%s_gpu_us", sc_aszPhaseName[i], sc_aszPhaseName[i]);
+
+	fprintf(m_fpCapture, "\n");
+
+	Start();
+	return true;
+}
+
+void CFrameProfiler::StopCapture()
+{
+	if (!m_fpCapture)
+		return;
+
+	//  GPU  ٸ ӵ CPU  
+	__ResolveFrames(true);
+
+	fclose(m_fpCapture);
+	m_fpCapture = NULL;
+}
+
+bool CFrameProfiler::__CreateQueries()
+{
+	if (!ms_lpd3dDevice)
+		return false;
+
+	// NULL  ѱ  ʰ  θ ˷ ش
+	if (FAILED(ms_lpd3dDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMP, NULL)) ||
+		FAILED(ms_lpd3dDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMPDISJOINT, NULL)) ||
+		FAILED(ms_lpd3dDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMPFREQ, NULL)))
+		return false;
+
+	for (UINT i = 0; i < FRAME_LATENCY_NUM; ++i)
+	{
+		TFrame & rkFrame = m_akFrame[i];
+
+		if (FAILED(ms_lpd3dDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMPDISJOINT, &rkFrame.lpDisjointQuery)) ||
+			FAILED(ms_lpd3dDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMPFREQ, &rkFrame.lpFreqQuery)))
+		{
+			__DestroyQueries();
+			return false;
+		}
+
+		for (UINT j = 0; j < TIMESTAMP_MAX_NUM; ++j)
+		{
+			if (FAILED(ms_lpd3dDevice->CreateQuery(D3DQUERYTYPE_TIMESTAMP, &rkFrame.alpTimestampQuery[j])))
+			{
+				__DestroyQueries();
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void CFrameProfiler::__DestroyQueries()
+{
+	for (UINT i = 0; i < FRAME_LATENCY_NUM; ++i)
+	{
+		TFrame & rkFrame = m_akFrame[i];
+
+		safe_release(rkFrame.lpDisjointQuery);
+		safe_release(rkFrame.lpFreqQuery);
+
+		for (UINT j = 0; j < TIMESTAMP_MAX_NUM; ++j)
+			safe_release(rkFrame.alpTimestampQuery[j]);
+
+		rkFrame.uTimestampCount = 0;
+	}
+
+	m_isQuery = false;
+}
+
+void CFrameProfiler::ReleaseDevice()
+{
+	__ResolveFrames(true);
+	__DestroyQueries();
+}
+
+void CFrameProfiler::BeginFrame()
+{
+	if (!m_isRunning)
+		return;
+
+	if (m_isFrameOpen)
+		__EndFrame();
+
+	__ResolveFrames(false);
+
+	if (!m_isQuery && !m_isQueryFailed && ms_lpd3dDevice)
+	{
+		m_isQuery = __CreateQueries();
+
+		if (!m_isQuery)
+		{
+			m_isQueryFailed = true;
+			TraceError("CFrameProfiler::BeginFrame - timestamp query is not supported, measuring CPU only");
+		}
+	}
+
+	// FRAME_LATENCY_NUM   GPU      CPU  
+	TFrame & rkFrame = m_akFrame[m_uCurFrame];
+
+	if (rkFrame.isPending)
+		__ResolveFrame(rkFrame, true);
+
+	rkFrame.dwFrameNum = ++m_dwFrameNum;
+	rkFrame.dwFrameUSec = 0;
+	rkFrame.uTimestampCount = 0;
+	memset(rkFrame.adwCPUUSec, 0, sizeof(rkFrame.adwCPUUSec));
+
+	QueryPerformanceCounter(&m_liFrameBegin);
+	m_liSegmentBegin = m_liFrameBegin;
+	m_uStackCount = 0;
+	m_isFrameOpen = true;
+
+	if (m_isQuery)
+		rkFrame.lpDisjointQuery->Issue(D3DISSUE_BEGIN);
+
+	__IssueTimestamp(PHASE_NUM);
+}
+
+void CFrameProfiler::__EndFrame()
+{
+	TFrame & rkFrame = m_akFrame[m_uCurFrame];
+
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	if (m_uStackCount)
+		__AddCPUSegment(liNow);
+
+	rkFrame.dwFrameUSec = __GetUSec(m_liFrameBegin, liNow);
+
+	__IssueTimestamp(PHASE_NUM);
+
+	if (m_isQuery)
+	{
+		rkFrame.lpDisjointQuery->Issue(D3DISSUE_END);
+		rkFrame.lpFreqQuery->Issue(D3DISSUE_END);
+	}
+
+	rkFrame.isPending = true;
+
+	m_uCurFrame = (m_uCurFrame + 1) % FRAME_LATENCY_NUM;
+	m_uStackCount = 0;
+	m_isFrameOpen = false;
+}
+
+void CFrameProfiler::__ResolveFrames(bool isForce)
+{
+	//   ĭ   ̴. CSV  ڼ ʰ  ͺ Ǭ.
+	for (UINT i = 0; i < FRAME_LATENCY_NUM; ++i)
+	{
+		TFrame & rkFrame = m_akFrame[(m_uCurFrame + i) % FRAME_LATENCY_NUM];
+
+		if (!rkFrame.isPending)
+			continue;
+
+		if (!__ResolveFrame(rkFrame, isForce))
+			return;
+	}
+}
+
+bool CFrameProfiler::__ResolveFrame(TFrame & rkFrame, bool isForce)
+{
+	TResult kResult;
+	memset(&kResult, 0, sizeof(kResult));
+
+	int iGPU = __ResolveGPU(rkFrame, kResult.adwGPUUSec);
+
+	if (GPU_WAIT == iGPU && !isForce)
+		return false;
+
+	kResult.dwFrameNum = rkFrame.dwFrameNum;
+	kResult.dwFrameUSec = rkFrame.dwFrameUSec;
+	kResult.isGPU = (GPU_DONE == iGPU);
+	memcpy(kResult.adwCPUUSec, rkFrame.adwCPUUSec, sizeof(kResult.adwCPUUSec));
+
+	if (!kResult.isGPU)
+		memset(kResult.adwGPUUSec, 0, sizeof(kResult.adwGPUUSec));
+
+	rkFrame.isPending = false;
+	__OnResult(kResult);
+	return true;
+}
+
+// ٸ ʰ . ̸ GPU_WAIT,    (Ŭ ȭ, ġ н) GPU_FAIL
+int CFrameProfiler::__ResolveGPU(TFrame & rkFrame, DWORD * adwGPUUSec)
+{
+	if (!m_isQuery || rkFrame.uTimestampCount < 2)
+		return GPU_FAIL;
+
+	HRESULT hr;
+
+	BOOL isDisjoint;
+	if (S_OK != (hr = rkFrame.lpDisjointQuery->GetData(&isDisjoint, sizeof(isDisjoint), 0)))
+		return FAILED(hr) ? GPU_FAIL : GPU_WAIT;
+
+	if (isDisjoint)
+		return GPU_FAIL;
+
+	UINT64 u64Frequency;
+	if (S_OK != (hr = rkFrame.lpFreqQuery->GetData(&u64Frequency, sizeof(u64Frequency), 0)))
+		return FAILED(hr) ? GPU_FAIL : GPU_WAIT;
+
+	if (!u64Frequency)
+		return GPU_FAIL;
+
+	UINT64 au64Timestamp[TIMESTAMP_MAX_NUM];
+
+	for (UINT i = 0; i < rkFrame.uTimestampCount; ++i)
+	{
+		if (S_OK != (hr = rkFrame.alpTimestampQuery[i]->GetData(&au64Timestamp[i], sizeof(UINT64), 0)))
+			return FAILED(hr) ? GPU_FAIL : GPU_WAIT;
+	}
+
+	for (UINT i = 0; i + 1 < rkFrame.uTimestampCount; ++i)
+	{
+		UINT ePhase = rkFrame.abTimestampPhase[i];
+
+		if (ePhase >= PHASE_NUM)
+			continue;
+
+		adwGPUUSec[ePhase] += (DWORD) ((au64Timestamp[i + 1] - au64Timestamp[i]) * 1000000 / u64Frequency);
+	}
+
+	return GPU_DONE;
+}
+
+void CFrameProfiler::__OnResult(const TResult & c_rkResult)
+{
+	m_kLastResult = c_rkResult;
+
+	if (!m_fpCapture)
+		return;
+
+	fprintf(m_fpCapture, "%u,%u", c_rkResult.dwFrameNum, c_rkResult.dwFrameUSec);
+
+	for (UINT i = 0; i < PHASE_NUM; ++i)
+	{
+		if (c_rkResult.isGPU)
+			fprintf(m_fpCapture, ",%u,%u", c_rkResult.adwCPUUSec[i], c_rkResult.adwGPUUSec[i]);
+		else
+			fprintf(m_fpCapture, ",%u,-1", c_rkResult.adwCPUUSec[i]);
+	}
+
+	fprintf(m_fpCapture, "\n");
+}
+
+void CFrameProfiler::__AddCPUSegment(const LARGE_INTEGER & c_rliNow)
+{
+	UINT ePhase = m_auStack[m_uStackCount - 1];
+	m_akFrame[m_uCurFrame].adwCPUUSec[ePhase] += __GetUSec(m_liSegmentBegin, c_rliNow);
+}
+
+void CFrameProfiler::__IssueTimestamp(UINT ePhase)
+{
+	if (!m_isQuery || !m_isFrameOpen)
+		return;
+
+	TFrame & rkFrame = m_akFrame[m_uCurFrame];
+
+	//  ĭ   ǥÿ  д. ģ   ܰ迡 ٴ´.
+	if (rkFrame.uTimestampCount + 1 >= TIMESTAMP_MAX_NUM && PHASE_NUM != ePhase)
+		return;
+
+	if (rkFrame.uTimestampCount >= TIMESTAMP_MAX_NUM)
+		return;
+
+	rkFrame.alpTimestampQuery[rkFrame.uTimestampCount]->Issue(D3DISSUE_END);
+	rkFrame.abTimestampPhase[rkFrame.uTimestampCount] = (BYTE) ePhase;
+	++rkFrame.uTimestampCount;
+}
+
+void CFrameProfiler::BeginPhase(UINT ePhase)
+{
+	if (!m_isRunning || !m_isFrameOpen || ePhase >= PHASE_NUM)
+		return;
+
+	// ģ ŭ ⸸ ϰ  ʴ´
+	if (m_uStackCount >= STACK_MAX_NUM)
+	{
+		++m_uStackCount;
+		return;
+	}
+
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	if (m_uStackCount)
+		__AddCPUSegment(liNow);
+
+	m_liSegmentBegin = liNow;
+	m_auStack[m_uStackCount++] = ePhase;
+
+	__IssueTimestamp(ePhase);
+}
+
+void CFrameProfiler::EndPhase(UINT ePhase)
+{
+	if (!m_isRunning || !m_isFrameOpen || !m_uStackCount)
+		return;
+
+	if (m_uStackCount > STACK_MAX_NUM)
+	{
+		--m_uStackCount;
+		return;
+	}
+
+	if (m_auStack[m_uStackCount - 1] != ePhase)
+	{
+		TraceError("CFrameProfiler::EndPhase(%s) - not matched with BeginPhase(%s)", GetPhaseName(ePhase), GetPhaseName(m_auStack[m_uStackCount - 1]));
+		return;
+	}
+
+	LARGE_INTEGER liNow;
+	QueryPerformanceCounter(&liNow);
+
+	__AddCPUSegment(liNow);
+	m_liSegmentBegin = liNow;
+	--m_uStackCount;
+
+	__IssueTimestamp(m_uStackCount ? m_auStack[m_uStackCount - 1] : PHASE_NUM);
+}
+
+//  ֱٿ GPU    ܰ躰 CPU/GPU ms  ش
+void CFrameProfiler::GetInfo(std::string * pstInfo)
+{
+	char szInfo[128];
+
+	if (!m_isRunning)
+	{
+		pstInfo->append("Frame: profiler off");
+		return;
+	}
+
+	const TResult & c_rkResult = m_kLastResult;
+
+	_snprintf(szInfo, sizeof(szInfo), "Frame %u: %.1fms%s", c_rkResult.dwFrameNum, c_rkResult.dwFrameUSec / 1000.0f, m_fpCapture ? " (capture)" : "");
+	pstInfo->append(szInfo);
+
+	for (UINT i = 0; i < PHASE_NUM; ++i)
+	{
+		if (c_rkResult.isGPU)
+			_snprintf(szInfo, sizeof(szInfo), ", %s %.1f/%.1f", sc_aszPhaseName[i], c_rkResult.adwCPUUSec[i] / 1000.0f, c_rkResult.adwGPUUSec[i] / 1000.0f);
+		else
+			_snprintf(szInfo, sizeof(szInfo), ", %s %.1f/-", sc_aszPhaseName[i], c_rkResult.adwCPUUSec[i] / 1000.0f);
+
+		pstInfo->append(szInfo);
+	}
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "../eterBase/Singleton.h"
+
+#include "GrpBase.h"
+
+//    ܰ  ܰ踶 CPU ð GPU ð(D3D timestamp ) .
+// ܰ  ҷ Ǹ,  ܰ谡   ٱ ܰ ߹Ƿ ܰ踶 ڱ  ´.
+// GPU    ʰ Ƿ  FRAME_LATENCY_NUM ġ    ٸ ʴ´.
+class CFrameProfiler : public CGraphicBase, public CSingleton<CFrameProfiler>
+{
+	public:
+		enum EPhase
+		{
+			PHASE_NETWORK,
+			PHASE_UPDATE,
+			PHASE_TERRAIN,
+			PHASE_TREE,
+			PHASE_OBJECT,
+			PHASE_ACTOR,
+			PHASE_EFFECT,
+			PHASE_TEXTTAIL,
+			PHASE_UI,
+			PHASE_PRESENT,
+			PHASE_NUM,
+		};
+
+		enum
+		{
+			FRAME_LATENCY_NUM = 4,
+			TIMESTAMP_MAX_NUM = 64,		//  ӿ ܰ谡 ٲ Ƚ
+			STACK_MAX_NUM = 16,
+		};
+
+		typedef struct SResult
+		{
+			DWORD	dwFrameNum;
+			DWORD	dwFrameUSec;
+			DWORD	adwCPUUSec[PHASE_NUM];
+			DWORD	adwGPUUSec[PHASE_NUM];
+			bool	isGPU;
+		} TResult;
+
+	public:
+		CFrameProfiler();
+		virtual ~CFrameProfiler();
+
+		void	Start();
+		void	Stop();
+		bool	IsRunning() const	{ return m_isRunning; }
+
+		// Ӹ  پ CSV  . GPU    ĭ -1 ̴.
+		bool	StartCapture(const char * c_szFileName);
+		void	StopCapture();
+		bool	IsCapturing() const	{ return NULL != m_fpCapture; }
+
+		//   ݰ   .   տ   θ.
+		void	BeginFrame();
+
+		void	BeginPhase(UINT ePhase);
+		void	EndPhase(UINT ePhase);
+
+		// ̽ Reset  ҷ  ´.  ӿ ٽ .
+		void	ReleaseDevice();
+
+		void	GetInfo(std::string * pstInfo);
+
+		static const char *	GetPhaseName(UINT ePhase);
+
+	protected:
+		typedef struct SFrame
+		{
+			bool				isPending;
+			DWORD				dwFrameNum;
+			DWORD				dwFrameUSec;
+			DWORD				adwCPUUSec[PHASE_NUM];
+
+			LPDIRECT3DQUERY9	lpDisjointQuery;
+			LPDIRECT3DQUERY9	lpFreqQuery;
+			LPDIRECT3DQUERY9	alpTimestampQuery[TIMESTAMP_MAX_NUM];
+			BYTE				abTimestampPhase[TIMESTAMP_MAX_NUM];	//  ð  ܰ. PHASE_NUM ̸ ܰ 
+			UINT				uTimestampCount;
+		} TFrame;
+
+	protected:
+		void	__Initialize();
+
+		bool	__CreateQueries();
+		void	__DestroyQueries();
+
+		void	__EndFrame();
+		void	__ResolveFrames(bool isForce);
+		bool	__ResolveFrame(TFrame & rkFrame, bool isForce);
+		int		__ResolveGPU(TFrame & rkFrame, DWORD * adwGPUUSec);
+		void	__OnResult(const TResult & c_rkResult);
+
+		void	__AddCPUSegment(const LARGE_INTEGER & c_rliNow);
+		void	__IssueTimestamp(UINT ePhase);
+
+		DWORD	__GetUSec(const LARGE_INTEGER & c_rliBegin, const LARGE_INTEGER & c_rliEnd);
+
+	protected:
+		bool			m_isRunning;
+		bool			m_isFrameOpen;
+		bool			m_isQuery;
+		bool			m_isQueryFailed;		// Ÿӽ    ġ CPU  
+
+		LARGE_INTEGER	m_liFrequency;
+		LARGE_INTEGER	m_liFrameBegin;
+		LARGE_INTEGER	m_liSegmentBegin;
+
+		DWORD			m_dwFrameNum;
+		UINT			m_uCurFrame;
+		TFrame			m_akFrame[FRAME_LATENCY_NUM];
+
+		UINT			m_auStack[STACK_MAX_NUM];
+		UINT			m_uStackCount;
+
+		TResult			m_kLastResult;
+		FILE *			m_fpCapture;
+};
+
+// ڿ BeginPhase, Ҹڿ EndPhase  θ. Ϸ  ƹ͵  Ѵ.
+class CFrameProfilerScope
+{
+	public:
+		CFrameProfilerScope(UINT ePhase) : m_ePhase(ePhase)
+		{
+			if (CFrameProfiler::InstancePtr())
+				CFrameProfiler::Instance().BeginPhase(m_ePhase);
+		}
+
+		~CFrameProfilerScope()
+		{
+			if (CFrameProfiler::InstancePtr())
+				CFrameProfiler::Instance().EndPhase(m_ePhase);
+		}
+
+	protected:
+		UINT	m_ePhase;
+};
@@ -4,6 +4,7 @@
 #include "GrpBase.h"
 #include "Camera.h"
 #include "StateManager.h"
+#include "GrpVertexBufferDynamic.h"
 
 void PixelPositionToD3DXVECTOR3(const D3DXVECTOR3& c_rkPPosSrc, D3DXVECTOR3* pv3Dst)
 {
@@ -96,7 +97,7 @@ std::vector<TIndex>		CGraphicBase::ms_fillCubeIdxVector;
 LPD3DXMESH				CGraphicBase::ms_lpSphereMesh = NULL;
 LPD3DXMESH				CGraphicBase::ms_lpCylinderMesh = NULL;
 
-LPDIRECT3DVERTEXBUFFER9	CGraphicBase::ms_alpd3dPDTVB[PDT_VERTEXBUFFER_NUM];
+CDynamicVertexBuffer*	CGraphicBase::ms_pkDynamicVB = NULL;
 
 LPDIRECT3DINDEXBUFFER9	CGraphicBase::ms_alpd3dDefIB[DEFAULT_IB_NUM];
 
@@ -149,41 +150,34 @@ bool CGraphicBase::SetPDTStream(SPDTVertex* pVertices, UINT uVtxCount)
 }
 
 bool CGraphicBase::SetPDTStream(SPDTVertexRaw* pSrcVertices, UINT uVtxCount)
+{
+	return SetDynamicStream(pSrcVertices, uVtxCount, sizeof(TPDTVertex));
+}
+
+//   ڿ NOOVERWRITE  ̾ ̰ Ʈ  Ǵ.   DISCARD ϰ ó .
+bool CGraphicBase::SetDynamicStream(const void* c_pVertices, UINT uVtxCount, UINT uStride, UINT uStreamNumber)
 {
 	if (!uVtxCount)
 		return false;
 
-	static DWORD s_dwVBPos=0;
+	UINT uOffset;
 
-	if (s_dwVBPos>=PDT_VERTEXBUFFER_NUM)
-		s_dwVBPos=0;
-
-	IDirect3DVertexBuffer9* plpd3dFillRectVB=ms_alpd3dPDTVB[s_dwVBPos];
-	++s_dwVBPos;
-
-	assert(PDT_VERTEX_NUM>=uVtxCount);
-	if (uVtxCount >= PDT_VERTEX_NUM)
-		return false;
-
-	TPDTVertex* pDstVertices;
-	if (FAILED(
-		plpd3dFillRectVB->Lock(0, sizeof(TPDTVertex)*uVtxCount, (void**)&pDstVertices, D3DLOCK_DISCARD)
-	)) 
+	if (!ms_pkDynamicVB || !ms_pkDynamicVB->Append(c_pVertices, uVtxCount, uStride, &uOffset))
 	{
-		STATEMANAGER.SetStreamSource(0, NULL, 0);
+		STATEMANAGER.SetStreamSource(uStreamNumber, NULL, 0);
 		return false;
 	}
-	
-	
-	memcpy(pDstVertices, pSrcVertices, sizeof(TPDTVertex)*uVtxCount);
-
-	plpd3dFillRectVB->Unlock();
-
-	STATEMANAGER.SetStreamSource(0, plpd3dFillRectVB, sizeof(TPDTVertex));	
 
+	STATEMANAGER.SetStreamSource(uStreamNumber, ms_pkDynamicVB->GetD3DVertexBuffer(), uStride, uOffset);
 	return true;
 }
 
+void CGraphicBase::DiscardDynamicStream()
+{
+	if (ms_pkDynamicVB)
+		ms_pkDynamicVB->Discard();
+}
+
 DWORD CGraphicBase::GetAvailableTextureMemory()
 {
 	assert(ms_lpd3dDevice!=NULL && "CGraphicBase::GetAvailableTextureMemory - D3DDevice is EMPTY");
@@ -206,11 +200,26 @@ const D3DXMATRIX& CGraphicBase::GetViewMatrix()
 	return ms_matView;
 }
 
+const D3DXMATRIX& CGraphicBase::GetProjectionMatrix()
+{
+	return ms_matProj;
+}
+
+const D3DVIEWPORT9& CGraphicBase::GetViewport()
+{
+	return ms_Viewport;
+}
+
 const D3DXMATRIX & CGraphicBase::GetIdentityMatrix()
 {
 	return ms_matIdentity;
 }
 
+const CRay & CGraphicBase::GetPickingRay()
+{
+	return ms_Ray;
+}
+
 void CGraphicBase::SetEyeCamera(float xEye, float yEye, float zEye,
 								float xCenter, float yCenter, float zCenter,
 								float xUp, float yUp, float zUp)
@@ -8,6 +8,7 @@ void PixelPositionToD3DXVECTOR3(const D3DXVECTOR3& c_rkPPosSrc, D3DXVECTOR3* pv3
 void D3DXVECTOR3ToPixelPosition(const D3DXVECTOR3& c_rv3Src, D3DXVECTOR3* pv3Dst);
 
 class CGraphicTexture;
+class CDynamicVertexBuffer;
 
 typedef WORD TIndex;
 
@@ -133,7 +134,10 @@ class CGraphicBase
 	public:
 		static DWORD GetAvailableTextureMemory();
 		static const D3DXMATRIX& GetViewMatrix();
+		static const D3DXMATRIX& GetProjectionMatrix();
+		static const D3DVIEWPORT9& GetViewport();
 		static const D3DXMATRIX & GetIdentityMatrix();
+		static const CRay & GetPickingRay();
 
 		enum
 		{			
@@ -144,9 +148,15 @@ class CGraphicBase
 			DEFAULT_IB_FILL_TRI,
 			DEFAULT_IB_FILL_RECT,
 			DEFAULT_IB_FILL_CUBE,
+			DEFAULT_IB_FILL_QUAD,		// 簢 Ʈ (0, 1, 2, 2, 1, 3) x FILL_QUAD_MAX_NUM
 			DEFAULT_IB_NUM,
 		};
 
+		enum
+		{
+			FILL_QUAD_MAX_NUM = 4096,
+		};
+
 	public:
 		CGraphicBase();
 		virtual	~CGraphicBase();
@@ -213,6 +223,8 @@ class CGraphicBase
 		static void SetDefaultIndexBuffer(UINT eDefIB);
 		static bool SetPDTStream(SPDTVertexRaw* pVertices, UINT uVtxCount);
 		static bool SetPDTStream(SPDTVertex* pVertices, UINT uVtxCount);
+		static bool SetDynamicStream(const void* c_pVertices, UINT uVtxCount, UINT uStride, UINT uStreamNumber = 0);
+		static void DiscardDynamicStream();
 		
 	protected:
 		static D3DXMATRIX				ms_matIdentity;
@@ -302,11 +314,9 @@ class CGraphicBase
 
 		enum
 		{
-			PDT_VERTEX_NUM = 16,
-			PDT_VERTEXBUFFER_NUM = 100,				
+			DYNAMIC_VB_SIZE = 2 * 1024 * 1024,	// Ʈ, ؽƮ, UI   ӿ     ũ
 		};
-		
-		
-		static LPDIRECT3DVERTEXBUFFER9	ms_alpd3dPDTVB[PDT_VERTEXBUFFER_NUM];
+
+		static CDynamicVertexBuffer*	ms_pkDynamicVB;
 		static LPDIRECT3DINDEXBUFFER9	ms_alpd3dDefIB[DEFAULT_IB_NUM];
 };
@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "GrpDevice.h"
+#include "GrpVertexBufferDynamic.h"
 #include "../eterBase/Stl.h"
 #include "../eterBase/Debug.h"
 
@@ -40,7 +41,7 @@ void CGraphicDevice::__Initialize()
 	m_pStateManager		= NULL;
 
 	__InitializeDefaultIndexBufferList();
-	__InitializePDTVertexBufferList();
+	__InitializeDynamicVertexBuffer();
 }
 
 void CGraphicDevice::RegisterWarningString(UINT uiMsg, const char * c_szString)
@@ -80,6 +81,8 @@ void CGraphicDevice::EnableWebBrowserMode(const RECT& c_rcWebPage)
 	rkD3DPP.BackBufferCount = 1;
 	rkD3DPP.PresentationInterval = D3DPRESENT_INTERVAL_IMMEDIATE;
 	
+	m_kFrameProfiler.ReleaseDevice();
+
 	IDirect3DDevice9& rkD3DDev=*ms_lpd3dDevice;
 	HRESULT hr=rkD3DDev.Reset(&rkD3DPP);
 	if (FAILED(hr))
@@ -99,6 +102,8 @@ void CGraphicDevice::DisableWebBrowserMode()
 
 	rkD3DPP=g_kD3DPP;
 
+	m_kFrameProfiler.ReleaseDevice();
+
 	IDirect3DDevice9& rkD3DDev=*ms_lpd3dDevice;
 	HRESULT hr=rkD3DDev.Reset(&rkD3DPP);
 	if (FAILED(hr))
@@ -120,6 +125,8 @@ bool CGraphicDevice::ResizeBackBuffer(UINT uWidth, UINT uHeight)
 			rkD3DPP.BackBufferWidth=uWidth;
 			rkD3DPP.BackBufferHeight=uHeight;
 
+			m_kFrameProfiler.ReleaseDevice();
+
 			IDirect3DDevice9& rkD3DDev=*ms_lpd3dDevice;
 
 			HRESULT hr=rkD3DDev.Reset(&rkD3DPP);
@@ -256,6 +263,8 @@ bool CGraphicDevice::Reset()
 {
 	HRESULT hr;
 
+	m_kFrameProfiler.ReleaseDevice();
+
 	if (FAILED(hr = ms_lpd3dDevice->Reset(&ms_d3dPresentParameter)))
 		return false;
 
@@ -566,7 +575,7 @@ RETRY:
 	if (!__CreateDefaultIndexBufferList())
 		return false;
 
-	if (!__CreatePDTVertexBufferList())
+	if (!__CreateDynamicVertexBuffer())
 		return false;
 	
 	DWORD dwTexMemSize = GetAvailableTextureMemory();
@@ -581,6 +590,9 @@ RETRY:
 	else
 		ms_isHighTextureMemory = false;
 
+	//  ؽ簡  ޸   ʵ ū  
+	CGraphicTextureStreamer::SetDefaultBudget(dwTexMemSize / 2);
+
 	if (ms_d3dCaps.TextureAddressCaps & D3DPTADDRESSCAPS_BORDER)
 		GRAPHICS_CAPS_CAN_NOT_TEXTURE_ADDRESS_BORDER=false;
 	else
@@ -604,38 +616,32 @@ RETRY:
 	return (iRet);
 }
 
-void CGraphicDevice::__InitializePDTVertexBufferList()
+void CGraphicDevice::__InitializeDynamicVertexBuffer()
 {
-	for (UINT i=0; i<PDT_VERTEXBUFFER_NUM; ++i)
-		ms_alpd3dPDTVB[i]=NULL;	
+	ms_pkDynamicVB=NULL;
 }
 		
-void CGraphicDevice::__DestroyPDTVertexBufferList()
+void CGraphicDevice::__DestroyDynamicVertexBuffer()
 {
-	for (UINT i=0; i<PDT_VERTEXBUFFER_NUM; ++i)
+	if (ms_pkDynamicVB)
 	{
-		if (ms_alpd3dPDTVB[i])
-		{
-			ms_alpd3dPDTVB[i]->Release();
-			ms_alpd3dPDTVB[i]=NULL;
-		}
+		delete ms_pkDynamicVB;
+		ms_pkDynamicVB=NULL;
 	}
 }
 
-bool CGraphicDevice::__CreatePDTVertexBufferList()
+bool CGraphicDevice::__CreateDynamicVertexBuffer()
 {
-	for (UINT i=0; i<PDT_VERTEXBUFFER_NUM; ++i)
+	assert(ms_pkDynamicVB==NULL);
+
+	ms_pkDynamicVB=new CDynamicVertexBuffer;
+
+	if (!ms_pkDynamicVB->CreateRing(DYNAMIC_VB_SIZE))
 	{
-		if (FAILED(
-			ms_lpd3dDevice->CreateVertexBuffer(
-			sizeof(TPDTVertex)*PDT_VERTEX_NUM, 
-			D3DUSAGE_DYNAMIC|D3DUSAGE_WRITEONLY, 
-			D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1, 
-			D3DPOOL_SYSTEMMEM, 
-			&ms_alpd3dPDTVB[i], NULL)
-		))
+		TraceError("CGraphicDevice::__CreateDynamicVertexBuffer - CreateRing(%d) FAILED", DYNAMIC_VB_SIZE);
 		return false;
 	}
+
 	return true;
 }
 
@@ -692,6 +698,7 @@ bool CGraphicDevice::__CreateDefaultIndexBufferList()
 	};
 	static const WORD c_awFillTriIndices[3]= { 0, 1, 2, };
 	static const WORD c_awFillRectIndices[6] = { 0, 2, 1, 2, 3, 1, };
+	static WORD s_awFillQuadIndices[FILL_QUAD_MAX_NUM*6];
 	static const WORD c_awFillCubeIndices[36] = { 
 		0, 1, 2, 1, 3, 2,
 		2, 0, 6, 0, 4, 6,
@@ -715,6 +722,20 @@ bool CGraphicDevice::__CreateDefaultIndexBufferList()
 		return false;
 	if (!__CreateDefaultIndexBuffer(DEFAULT_IB_FILL_CUBE, 36, c_awFillCubeIndices))
 		return false;
+
+	for (WORD i=0; i<FILL_QUAD_MAX_NUM; ++i)
+	{
+		WORD wBase=i*4;
+		s_awFillQuadIndices[i*6+0]=wBase+0;
+		s_awFillQuadIndices[i*6+1]=wBase+1;
+		s_awFillQuadIndices[i*6+2]=wBase+2;
+		s_awFillQuadIndices[i*6+3]=wBase+2;
+		s_awFillQuadIndices[i*6+4]=wBase+1;
+		s_awFillQuadIndices[i*6+5]=wBase+3;
+	}
+
+	if (!__CreateDefaultIndexBuffer(DEFAULT_IB_FILL_QUAD, FILL_QUAD_MAX_NUM*6, s_awFillQuadIndices))
+		return false;
 	
 	return true;
 }
@@ -726,7 +747,7 @@ void CGraphicDevice::InitBackBufferCount(UINT uBackBufferCount)
 
 void CGraphicDevice::Destroy()
 {
-	__DestroyPDTVertexBufferList();
+	__DestroyDynamicVertexBuffer();
 	__DestroyDefaultIndexBufferList();
 
 	if (ms_hDC)
@@ -756,6 +777,9 @@ void CGraphicDevice::Destroy()
 	safe_release(ms_lpSphereMesh);
 	safe_release(ms_lpCylinderMesh);
 
+	m_kTextureStreamer.Destroy();
+	m_kFrameProfiler.ReleaseDevice();
+
 	safe_release(ms_lpd3dMatStack);
 	safe_release(ms_lpd3dDevice);
 	safe_release(ms_lpd3d);	
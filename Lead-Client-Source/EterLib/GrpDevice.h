@@ -3,6 +3,8 @@
 #include "GrpBase.h"
 #include "GrpDetector.h"
 #include "StateManager.h"
+#include "GrpTextureStreamer.h"
+#include "FrameProfiler.h"
 
 class CGraphicDevice : public CGraphicBase
 {
@@ -58,9 +60,9 @@ protected:
 	bool __CreateDefaultIndexBufferList();
 	bool __CreateDefaultIndexBuffer(UINT eDefIB, UINT uIdxCount, const WORD* c_awIndices);
 
-	void __InitializePDTVertexBufferList();
-	void __DestroyPDTVertexBufferList();
-	bool __CreatePDTVertexBufferList();
+	void __InitializeDynamicVertexBuffer();
+	void __DestroyDynamicVertexBuffer();
+	bool __CreateDynamicVertexBuffer();
 
 	LPDIRECT3DVERTEXDECLARATION9 CreatePTStreamVertexShader();
 	LPDIRECT3DVERTEXDECLARATION9 CreatePNTStreamVertexShader();
@@ -71,4 +73,6 @@ protected:
 	DWORD						m_uBackBufferCount;
 	std::map<UINT, std::string>	m_kMap_strWarningMessage;
 	CStateManager*				m_pStateManager;
+	CGraphicTextureStreamer		m_kTextureStreamer;
+	CFrameProfiler				m_kFrameProfiler;
 };
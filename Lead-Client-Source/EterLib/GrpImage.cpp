@@ -46,6 +46,17 @@ int CGraphicImage::GetHeight() const
 	return m_rect.bottom - m_rect.top;
 }
 
+int CGraphicImage::GetCacheGroup() const
+{
+	return CACHE_GROUP_TEXTURE;
+}
+
+DWORD CGraphicImage::GetMemorySize() const
+{
+	//  ؽ絵  32Ʈ Ѵ. (DumpFileListToTextFile   )
+	return GetWidth() * GetHeight() * 4;
+}
+
 const CGraphicTexture& CGraphicImage::GetTextureReference() const
 {
 	return m_imageTexture;
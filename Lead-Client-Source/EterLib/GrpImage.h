@@ -23,6 +23,9 @@ class CGraphicImage : public CResource
 		int GetWidth() const;
 		int GetHeight() const;
 
+		virtual int GetCacheGroup() const;
+		virtual DWORD GetMemorySize() const;
+
 		const RECT & GetRectReference() const;
 
 		const CGraphicTexture & GetTextureReference() const;
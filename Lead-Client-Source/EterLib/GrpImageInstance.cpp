@@ -31,6 +31,125 @@ void CGraphicImageInstance::Delete(CGraphicImageInstance* pkImgInst)
 	ms_kPool.Free(pkImgInst);
 }
 
+// ġ ߿  ؽĳ  Ҵٰ EndBatch  ѹ ׸.
+// ׸  Ű   ġ ĥ   ̿ 
+// ٸ ؽ ġ ġ   ģ.
+struct SImageBatch
+{
+	LPDIRECT3DBASETEXTURE9		lpd3dTexture;
+	float						left, top, right, bottom;
+	std::vector<TPDTVertex>		kVct_kVertex;
+};
+
+enum
+{
+	IMAGE_BATCH_SEARCH_NUM = 32,
+};
+
+static std::vector<SImageBatch>	gs_kVct_kImageBatch;
+static UINT						gs_uImageBatchCount = 0;
+static bool						gs_isImageBatchRendering = false;
+
+static void __AppendImageBatch(LPDIRECT3DBASETEXTURE9 lpd3dTexture, const TPDTVertex * c_akVertex)
+{
+	float left = c_akVertex[0].position.x;
+	float top = c_akVertex[0].position.y;
+	float right = c_akVertex[3].position.x;
+	float bottom = c_akVertex[3].position.y;
+
+	SImageBatch * pkBatch = NULL;
+
+	UINT uSearchEnd = gs_uImageBatchCount > IMAGE_BATCH_SEARCH_NUM ? gs_uImageBatchCount - IMAGE_BATCH_SEARCH_NUM : 0;
+
+	for (UINT i = gs_uImageBatchCount; i > uSearchEnd; --i)
+	{
+		SImageBatch & rkBatch = gs_kVct_kImageBatch[i - 1];
+
+		if (rkBatch.lpd3dTexture == lpd3dTexture)
+		{
+			pkBatch = &rkBatch;
+			break;
+		}
+
+		// ڿ ׷ ٸ ؽĿ ġ    .
+		if (left < rkBatch.right && rkBatch.left < right && top < rkBatch.bottom && rkBatch.top < bottom)
+			break;
+	}
+
+	if (!pkBatch)
+	{
+		if (gs_uImageBatchCount == gs_kVct_kImageBatch.size())
+			gs_kVct_kImageBatch.push_back(SImageBatch());
+
+		pkBatch = &gs_kVct_kImageBatch[gs_uImageBatchCount++];
+		pkBatch->lpd3dTexture = lpd3dTexture;
+		pkBatch->left = left;
+		pkBatch->top = top;
+		pkBatch->right = right;
+		pkBatch->bottom = bottom;
+		pkBatch->kVct_kVertex.clear();
+	}
+	else
+	{
+		pkBatch->left = min(pkBatch->left, left);
+		pkBatch->top = min(pkBatch->top, top);
+		pkBatch->right = max(pkBatch->right, right);
+		pkBatch->bottom = max(pkBatch->bottom, bottom);
+	}
+
+	pkBatch->kVct_kVertex.insert(pkBatch->kVct_kVertex.end(), c_akVertex, c_akVertex + 4);
+}
+
+static void __FlushImageBatch()
+{
+	if (!gs_uImageBatchCount)
+		return;
+
+	CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_QUAD);
+	STATEMANAGER.SetTexture(1, NULL);
+	STATEMANAGER.SetFVF(D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1);
+
+	for (UINT i = 0; i < gs_uImageBatchCount; ++i)
+	{
+		SImageBatch & rkBatch = gs_kVct_kImageBatch[i];
+
+		STATEMANAGER.SetTexture(0, rkBatch.lpd3dTexture);
+
+		UINT uQuadCount = rkBatch.kVct_kVertex.size() / 4;
+
+		for (UINT uBase = 0; uBase < uQuadCount; uBase += CGraphicBase::FILL_QUAD_MAX_NUM)
+		{
+			UINT uCount = min(uQuadCount - uBase, (UINT) CGraphicBase::FILL_QUAD_MAX_NUM);
+
+			if (CGraphicBase::SetDynamicStream(&rkBatch.kVct_kVertex[uBase * 4], uCount * 4, sizeof(TPDTVertex)))
+				STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, uCount * 4, 0, uCount * 2);
+		}
+
+		rkBatch.kVct_kVertex.clear();
+	}
+
+	gs_uImageBatchCount = 0;
+}
+
+void CGraphicImageInstance::BeginBatch()
+{
+	gs_isImageBatchRendering = true;
+}
+
+void CGraphicImageInstance::EndBatch()
+{
+	if (!gs_isImageBatchRendering)
+		return;
+
+	gs_isImageBatchRendering = false;
+	__FlushImageBatch();
+}
+
+bool CGraphicImageInstance::IsBatchRendering()
+{
+	return gs_isImageBatchRendering;
+}
+
 void CGraphicImageInstance::Render()
 {
 	if (IsEmpty())
@@ -41,10 +160,11 @@ void CGraphicImageInstance::Render()
 	OnRender();
 }
 
-void CGraphicImageInstance::OnRender()
+void CGraphicImageInstance::__UpdateVertices(CGraphicImage * pImage, CGraphicTexture * pTexture)
 {
-	CGraphicImage * pImage = m_roImage.GetPointer();
-	CGraphicTexture * pTexture = pImage->GetTexturePointer();
+	m_isVertexDirty = false;
+	m_iVertexTextureWidth = pTexture->GetWidth();
+	m_iVertexTextureHeight = pTexture->GetHeight();
 
 	float fimgWidth = pImage->GetWidth();
 	float fimgHeight = pImage->GetHeight();
@@ -57,8 +177,7 @@ void CGraphicImageInstance::OnRender()
 	float eu = (c_rRect.left + (c_rRect.right-c_rRect.left)) * texReverseWidth;
 	float ev = (c_rRect.top + (c_rRect.bottom-c_rRect.top)) * texReverseHeight;
 	
-	
-	TPDTVertex vertices[4];	
+	TPDTVertex * vertices = m_akVertex;
 	vertices[0].position.x	= m_v2Position.x-0.5f;
 	vertices[0].position.y	= m_v2Position.y-0.5f;
 	vertices[0].position.z	= 0.0f;
@@ -82,9 +201,25 @@ void CGraphicImageInstance::OnRender()
 	vertices[3].position.z	= 0.0f;
 	vertices[3].texCoord	= TTextureCoordinate(eu, ev);	
 	vertices[3].diffuse		= m_DiffuseColor;
+}
+
+void CGraphicImageInstance::OnRender()
+{
+	CGraphicImage * pImage = m_roImage.GetPointer();
+	CGraphicTexture * pTexture = pImage->GetTexturePointer();
+
+	// ٸ νϽ ε ؽ ũⰡ ٲ  ִ.
+	if (m_isVertexDirty || m_iVertexTextureWidth != pTexture->GetWidth() || m_iVertexTextureHeight != pTexture->GetHeight())
+		__UpdateVertices(pImage, pTexture);
+
+	if (gs_isImageBatchRendering)
+	{
+		__AppendImageBatch(pTexture->GetD3DTexture(), m_akVertex);
+		return;
+	}
 
 	// 2004.11.18.myevan.ctrl+alt+del ݺ  ƨ  
-	if (CGraphicBase::SetPDTStream(vertices, 4))
+	if (CGraphicBase::SetPDTStream(m_akVertex, 4))
 	{
 		CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_RECT);
 
@@ -135,16 +270,22 @@ void CGraphicImageInstance::SetDiffuseColor(float fr, float fg, float fb, float
 	m_DiffuseColor.g = fg;
 	m_DiffuseColor.b = fb;
 	m_DiffuseColor.a = fa;
+	m_isVertexDirty = true;
 }
 void CGraphicImageInstance::SetPosition(float fx, float fy)
 {
+	if (m_v2Position.x == fx && m_v2Position.y == fy)
+		return;
+
 	m_v2Position.x = fx;
 	m_v2Position.y = fy;
+	m_isVertexDirty = true;
 }
 
 void CGraphicImageInstance::SetImagePointer(CGraphicImage * pImage)
 {
 	m_roImage.SetPointer(pImage);
+	m_isVertexDirty = true;
 
 	OnSetImagePointer();
 }
@@ -161,6 +302,8 @@ void CGraphicImageInstance::ReloadImagePointer(CGraphicImage * pImage)
 
 	if (pkImage)
 		pkImage->Reload();
+
+	m_isVertexDirty = true;
 }
 
 bool CGraphicImageInstance::IsEmpty() const
@@ -203,6 +346,8 @@ void CGraphicImageInstance::Initialize()
 {
 	m_DiffuseColor.r = m_DiffuseColor.g = m_DiffuseColor.b = m_DiffuseColor.a = 1.0f;
 	m_v2Position.x = m_v2Position.y = 0.0f;
+	m_isVertexDirty = true;
+	m_iVertexTextureWidth = m_iVertexTextureHeight = 0;
 }
 
 void CGraphicImageInstance::Destroy()
@@ -43,11 +43,19 @@ class CGraphicImageInstance
 
 		virtual BOOL OnIsType(DWORD dwType);
 
+		void __UpdateVertices(CGraphicImage * pImage, CGraphicTexture * pTexture);
+
 	protected:
 		D3DXCOLOR m_DiffuseColor;
 		D3DXVECTOR2 m_v2Position;
 
 		CGraphicImage::TRef m_roImage;
+
+		// ġ, , ̹ ٲ  ٽ  簢
+		TPDTVertex m_akVertex[4];
+		bool m_isVertexDirty;
+		int m_iVertexTextureWidth;
+		int m_iVertexTextureHeight;
 		
 	public:
 		static void CreateSystem(UINT uCapacity);
@@ -56,5 +64,10 @@ class CGraphicImageInstance
 		static CGraphicImageInstance* New();
 		static void Delete(CGraphicImageInstance* pkImgInst);
 
+		// Begin ~ End  Render  ؽĺ  ξٰ ѹ ׸.
+		static void BeginBatch();
+		static void EndBatch();
+		static bool IsBatchRendering();
+
 		static CDynamicPool<CGraphicImageInstance>		ms_kPool;
 };
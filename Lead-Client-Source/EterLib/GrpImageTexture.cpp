@@ -2,6 +2,7 @@
 #include "../eterBase/MappedFile.h"
 #include "../eterPack/EterPackManager.h"
 #include "GrpImageTexture.h"
+#include "GrpTextureStreamer.h"
 
 bool CGraphicImageTexture::Lock(int* pRetPitch, void** ppRetPixels, int level)
 {
@@ -28,10 +29,32 @@ void CGraphicImageTexture::Initialize()
 
 	m_d3dFmt=D3DFMT_UNKNOWN;
 	m_dwFilter=0;
+
+	m_isStreaming=false;
+}
+
+void CGraphicImageTexture::__UnregisterStreaming()
+{
+	if (!m_isStreaming)
+		return;
+
+	if (CGraphicTextureStreamer::InstancePtr())
+		CGraphicTextureStreamer::Instance().Unregister(m_lpd3dTexture);
+
+	m_isStreaming = false;
+}
+
+void CGraphicImageTexture::DestroyDeviceObjects()
+{
+	__UnregisterStreaming();
+
+	CGraphicTexture::DestroyDeviceObjects();
 }
 
 void CGraphicImageTexture::Destroy()
 {
+	__UnregisterStreaming();
+
 	CGraphicTexture::Destroy();
 
 	Initialize();
@@ -198,6 +221,22 @@ bool CGraphicImageTexture::CreateDDSTexture(CDXTCImage & image, const BYTE * /*c
 	m_height = image.m_nHeight;
 	m_bEmpty = false;
 
+	//  ִ DDS   Ӻ ø  ƮӰ ȭ ũ⿡  ø
+	if (mipmapCount > 1 && CGraphicTextureStreamer::InstancePtr())
+	{
+		UINT uBlockBytes;
+
+		if (!ms_bSupportDXT)
+			uBlockBytes = 2;
+		else if (format == D3DFMT_DXT1)
+			uBlockBytes = 8;
+		else
+			uBlockBytes = 16;
+
+		CGraphicTextureStreamer::Instance().Register(m_lpd3dTexture, m_width, m_height, mipmapCount, uBlockBytes);
+		m_isStreaming = true;
+	}
+
 	return true;
 }
 
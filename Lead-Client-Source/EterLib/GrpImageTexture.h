@@ -10,6 +10,7 @@ class CGraphicImageTexture : public CGraphicTexture
 		virtual ~CGraphicImageTexture();
 
 		void		Destroy();
+		void		DestroyDeviceObjects();
 
 		bool		Create(UINT width, UINT height, D3DFORMAT d3dFmt, DWORD dwFilter = D3DX_FILTER_LINEAR);
 		bool		CreateDeviceObjects();
@@ -26,9 +27,12 @@ class CGraphicImageTexture : public CGraphicTexture
 
 	protected:
 		void		Initialize();
+		void		__UnregisterStreaming();
 		
 		D3DFORMAT	m_d3dFmt;
 		DWORD		m_dwFilter;
 
 		std::string m_stFileName;
+
+		bool		m_isStreaming;
 };
@@ -18,6 +18,7 @@ void CGraphicObjectInstance::Clear()
 	ClearHeightInstance();
 
 	m_isVisible = TRUE;
+	m_isOccluded = false;
 
 	m_v3Position.x = m_v3Position.y = m_v3Position.z = 0.0f;
 	m_v3Scale.x = m_v3Scale.y = m_v3Scale.z = 0.0f;
@@ -61,7 +62,8 @@ void CGraphicObjectInstance::BlendRender()
 
 void CGraphicObjectInstance::RenderToShadowMap()
 {
-	if (!isShow())
+	//   ׸ڴ ̴    ִ.
+	if (!m_isVisible)
 		return;
 
 	OnRenderToShadowMap();
@@ -202,7 +204,7 @@ void CGraphicObjectInstance::Hide()
 }
 bool CGraphicObjectInstance::isShow()
 {
-	return m_isVisible;
+	return m_isVisible && !m_isOccluded;
 }
 
 // 
@@ -262,6 +264,7 @@ bool CGraphicObjectInstance::isIntersect(const CRay & c_rRay, float * pu, float
 CGraphicObjectInstance::CGraphicObjectInstance()
 {
 	m_CullingHandle = 0;
+	m_iCullingVisibleIndex = -1;
 	Initialize();
 }
 
@@ -274,6 +277,7 @@ void CGraphicObjectInstance::Initialize()
 	m_pHeightAttributeInstance = NULL;
 	
 	m_isVisible = TRUE;	
+	m_isOccluded = false;
 
 	m_BlockCamera = false;
 	
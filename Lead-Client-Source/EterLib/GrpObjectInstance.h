@@ -57,6 +57,10 @@ class CGraphicObjectInstance : public CGraphicCollisionObject
 		void					Hide();
 		bool					isShow();
 
+		// Occlusion Culling
+		void					SetOccluded(bool isOccluded) { m_isOccluded = isOccluded; }
+		bool					isOccluded() { return m_isOccluded; }
+
 		// Camera Block
 		void					BlockCamera(bool bBlock) {m_BlockCamera = bBlock;}
 		bool					BlockCamera() { return m_BlockCamera; }
@@ -124,6 +128,10 @@ class CGraphicObjectInstance : public CGraphicCollisionObject
 
 		// Culling
 		CCullingManager::CullingHandle	m_CullingHandle;
+		bool					m_isOccluded;
+		int						m_iCullingVisibleIndex;	// CCullingManager  ̴   ġ,  -1
+
+		friend class CCullingManager;
 
 	// Static Collision Data
 	public:
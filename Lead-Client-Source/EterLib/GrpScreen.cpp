@@ -700,6 +700,8 @@ bool CScreen::Begin()
 		return false;
 	}
 
+	DiscardDynamicStream();
+
 	return true;
 }
 
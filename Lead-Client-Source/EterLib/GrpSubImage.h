@@ -25,6 +25,9 @@ class CGraphicSubImage : public CGraphicImage
 
 		static void SetSearchPath(const char * c_szFileName);
 
+		// ؽ  ̹ ʿ .
+		DWORD GetMemorySize() const	{ return CResource::GetMemorySize(); }
+
 	protected:
 		void SetImagePointer(CGraphicImage* pImage);
 
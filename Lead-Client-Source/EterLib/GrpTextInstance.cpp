@@ -472,23 +472,152 @@ void CGraphicTextInstance::Update()
 	pFontTexture->UpdateTexture();
 
 	m_isUpdate = true;
+	m_isQuadDirty = true;
 }
 
-void CGraphicTextInstance::Render(RECT * pClipRect)
+// ؽƮ   Ƽ ׸  . Ʈ ؽ  ϳ д.
+struct STextBatch
 {
-	if (!m_isUpdate)
-		return;	
+	CGraphicFontTexture *	pFontTexture;
+	short					index;
+	std::vector<TPDTVertex>	kVct_kVertex;
+};
 
-	CGraphicText* pkText=m_roText.GetPointer();
-	if (!pkText)
-		return;
+static std::vector<STextBatch>	gs_kVct_kTextBatch;
+static bool						gs_isTextBatchRendering = false;
 
-	CGraphicFontTexture* pFontTexture = pkText->GetFontTexturePointer();
-	if (!pFontTexture)
-		return;
+static void __PushTextQuad(std::vector<CGraphicTextInstance::TTextQuad> & rkVct_kQuad, const CGraphicFontTexture::TCharacterInfomation * c_pCharInfo, float sx, float sy, float ex, float ey, DWORD dwColor)
+{
+	CGraphicTextInstance::TTextQuad kQuad;
+	kQuad.index = c_pCharInfo->index;
+
+	kQuad.akVertex[0].position = TPosition(sx, sy, 0.0f);
+	kQuad.akVertex[0].texCoord = TTextureCoordinate(c_pCharInfo->left, c_pCharInfo->top);
+	kQuad.akVertex[1].position = TPosition(sx, ey, 0.0f);
+	kQuad.akVertex[1].texCoord = TTextureCoordinate(c_pCharInfo->left, c_pCharInfo->bottom);
+	kQuad.akVertex[2].position = TPosition(ex, sy, 0.0f);
+	kQuad.akVertex[2].texCoord = TTextureCoordinate(c_pCharInfo->right, c_pCharInfo->top);
+	kQuad.akVertex[3].position = TPosition(ex, ey, 0.0f);
+	kQuad.akVertex[3].texCoord = TTextureCoordinate(c_pCharInfo->right, c_pCharInfo->bottom);
+
+	kQuad.akVertex[0].diffuse = kQuad.akVertex[1].diffuse = kQuad.akVertex[2].diffuse = kQuad.akVertex[3].diffuse = dwColor;
+
+	rkVct_kQuad.push_back(kQuad);
+}
+
+static void __BeginTextRenderState()
+{
+	STATEMANAGER.SaveRenderState(D3DRS_SRCBLEND, D3DBLEND_SRCALPHA);
+	STATEMANAGER.SaveRenderState(D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA);
+	STATEMANAGER.SaveRenderState(D3DRS_FOGENABLE, FALSE);
+	STATEMANAGER.SaveRenderState(D3DRS_LIGHTING, FALSE);
+
+	STATEMANAGER.SetFVF(D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLORARG1,	D3DTA_TEXTURE);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLORARG2,	D3DTA_DIFFUSE);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLOROP,	D3DTOP_MODULATE);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_ALPHAARG1,	D3DTA_TEXTURE);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_ALPHAARG2,	D3DTA_DIFFUSE);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_ALPHAOP,	D3DTOP_MODULATE);
+}
+
+static void __EndTextRenderState()
+{
+	STATEMANAGER.RestoreRenderState(D3DRS_SRCBLEND);
+	STATEMANAGER.RestoreRenderState(D3DRS_DESTBLEND);
+	STATEMANAGER.RestoreRenderState(D3DRS_FOGENABLE);
+	STATEMANAGER.RestoreRenderState(D3DRS_LIGHTING);
+}
+
+//  ڵ ؽ  ѹ ׸.
+static void __FlushTextBatch()
+{
+	CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_QUAD);
+
+	for (DWORD i = 0; i < gs_kVct_kTextBatch.size(); ++i)
+	{
+		STextBatch & rkBatch = gs_kVct_kTextBatch[i];
+		if (rkBatch.kVct_kVertex.empty())
+			continue;
+
+		rkBatch.pFontTexture->SelectTexture(rkBatch.index);
+		STATEMANAGER.SetTexture(0, rkBatch.pFontTexture->GetD3DTexture());
+
+		UINT uQuadCount = rkBatch.kVct_kVertex.size() / 4;
+
+		for (UINT uBase = 0; uBase < uQuadCount; uBase += CGraphicBase::FILL_QUAD_MAX_NUM)
+		{
+			UINT uCount = min(uQuadCount - uBase, (UINT) CGraphicBase::FILL_QUAD_MAX_NUM);
+
+			if (CGraphicBase::SetDynamicStream(&rkBatch.kVct_kVertex[uBase * 4], uCount * 4, sizeof(TPDTVertex)))
+				STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, uCount * 4, 0, uCount * 2);
+		}
+
+		rkBatch.kVct_kVertex.clear();
+	}
+}
+
+void CGraphicTextInstance::BeginBatch()
+{
+	gs_isTextBatchRendering = true;
+}
 
-	float fStanX = m_v3Position.x;
-	float fStanY = m_v3Position.y + 1.0f;
+void CGraphicTextInstance::EndBatch()
+{
+	gs_isTextBatchRendering = false;
+
+	__BeginTextRenderState();
+	__FlushTextBatch();
+	__EndTextRenderState();
+}
+
+void CGraphicTextInstance::__SubmitQuads(CGraphicFontTexture * pFontTexture)
+{
+	STextBatch * pkBatch = NULL;
+
+	for (DWORD i = 0; i < m_kVct_kQuad.size(); ++i)
+	{
+		const TTextQuad & c_rkQuad = m_kVct_kQuad[i];
+
+		if (!pkBatch || pkBatch->index != c_rkQuad.index)
+		{
+			pkBatch = NULL;
+
+			for (DWORD j = 0; j < gs_kVct_kTextBatch.size(); ++j)
+			{
+				if (gs_kVct_kTextBatch[j].pFontTexture == pFontTexture && gs_kVct_kTextBatch[j].index == c_rkQuad.index)
+				{
+					pkBatch = &gs_kVct_kTextBatch[j];
+					break;
+				}
+			}
+
+			if (!pkBatch)
+			{
+				gs_kVct_kTextBatch.push_back(STextBatch());
+				pkBatch = &gs_kVct_kTextBatch.back();
+				pkBatch->pFontTexture = pFontTexture;
+				pkBatch->index = c_rkQuad.index;
+			}
+		}
+
+		for (int v = 0; v < 4; ++v)
+		{
+			TPDTVertex kVertex = c_rkQuad.akVertex[v];
+			kVertex.position += m_v3Position;
+			pkBatch->kVct_kVertex.push_back(kVertex);
+		}
+	}
+}
+
+//  簢 m_v3Position  ǥ  д. ڳ ,  ٲ  ٽ .
+void CGraphicTextInstance::__BuildQuads(RECT * pClipRect)
+{
+	m_kVct_kQuad.clear();
+	m_isQuadDirty = false;
+
+	float fStanX = 0.0f;
+	float fStanY = 1.0f;
 
 	UINT defCodePage = GetDefaultCodePage();
 
@@ -530,176 +659,42 @@ void CGraphicTextInstance::Render(RECT * pClipRect)
 			break;
 	}
 
-	//WORD FillRectIndices[6] = { 0, 2, 1, 2, 3, 1 };
-
-	STATEMANAGER.SaveRenderState(D3DRS_SRCBLEND, D3DBLEND_SRCALPHA);
-	STATEMANAGER.SaveRenderState(D3DRS_DESTBLEND, D3DBLEND_INVSRCALPHA);
-	DWORD dwFogEnable = STATEMANAGER.GetRenderState(D3DRS_FOGENABLE);
-	DWORD dwLighting = STATEMANAGER.GetRenderState(D3DRS_LIGHTING);
-	STATEMANAGER.SetRenderState(D3DRS_FOGENABLE, FALSE);
-	STATEMANAGER.SetRenderState(D3DRS_LIGHTING, FALSE);
-
-	STATEMANAGER.SetFVF(D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1);
-	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLORARG1,	D3DTA_TEXTURE);
-	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLORARG2,	D3DTA_DIFFUSE);
-	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLOROP,	D3DTOP_MODULATE);
-	STATEMANAGER.SetTextureStageState(0, D3DTSS_ALPHAARG1,	D3DTA_TEXTURE);
-	STATEMANAGER.SetTextureStageState(0, D3DTSS_ALPHAARG2,	D3DTA_DIFFUSE);
-	STATEMANAGER.SetTextureStageState(0, D3DTSS_ALPHAOP,	D3DTOP_MODULATE);
-
-	{
-		const float fFontHalfWeight=1.0f;
-
-		float fCurX;
-		float fCurY;
-
-		float fFontSx;
-		float fFontSy;
-		float fFontEx;
-		float fFontEy;
-		float fFontWidth;
-		float fFontHeight;
-		float fFontMaxHeight;
-		float fFontAdvance;
-
-		SVertex akVertex[4];
-		akVertex[0].z=m_v3Position.z;
-		akVertex[1].z=m_v3Position.z;
-		akVertex[2].z=m_v3Position.z;
-		akVertex[3].z=m_v3Position.z;
-
-		CGraphicFontTexture::TCharacterInfomation* pCurCharInfo;		
-
-		// ׵θ
-		if (m_isOutline)
-		{
-			fCurX=fStanX;
-			fCurY=fStanY;
-			fFontMaxHeight=0.0f;
-
-			CGraphicFontTexture::TPCharacterInfomationVector::iterator i;
-			for (i=m_pCharInfoVector.begin(); i!=m_pCharInfoVector.end(); ++i)
-			{
-				pCurCharInfo = *i;
-
-				fFontWidth=float(pCurCharInfo->width);
-				fFontHeight=float(pCurCharInfo->height);
-				fFontAdvance=float(pCurCharInfo->advance);
-
-				// NOTE : Ʈ ¿ Width  Ӵϴ. - [levites]
-				if ((fCurX+fFontWidth)-m_v3Position.x > m_fLimitWidth)
-				{
-					if (m_isMultiLine)
-					{
-						fCurX=fStanX;
-						fCurY+=fFontMaxHeight;
-					}
-					else
-					{
-						break;
-					}
-				}
-
-				if (pClipRect)
-				{
-					if (fCurY <= pClipRect->top)
-					{
-						fCurX += fFontAdvance;
-						continue;
-					}
-				}
-
-				fFontSx = fCurX - 0.5f;
-				fFontSy = fCurY - 0.5f;
-				fFontEx = fFontSx + fFontWidth;
-				fFontEy = fFontSy + fFontHeight;
-
-				pFontTexture->SelectTexture(pCurCharInfo->index);
-				STATEMANAGER.SetTexture(0, pFontTexture->GetD3DTexture());
-
-				akVertex[0].u=pCurCharInfo->left;
-				akVertex[0].v=pCurCharInfo->top;
-				akVertex[1].u=pCurCharInfo->left;
-				akVertex[1].v=pCurCharInfo->bottom;
-				akVertex[2].u=pCurCharInfo->right;
-				akVertex[2].v=pCurCharInfo->top;
-				akVertex[3].u=pCurCharInfo->right;
-				akVertex[3].v=pCurCharInfo->bottom;
+	const float fFontHalfWeight=1.0f;
 
-				akVertex[3].color = akVertex[2].color = akVertex[1].color = akVertex[0].color = m_dwOutLineColor;
+	float fCurX;
+	float fCurY;
 
-				
-				float feather = 0.0f; // m_fFontFeather
-				
-				akVertex[0].y=fFontSy-feather;
-				akVertex[1].y=fFontEy+feather;
-				akVertex[2].y=fFontSy-feather;
-				akVertex[3].y=fFontEy+feather;
-
-				// 
-				akVertex[0].x=fFontSx-fFontHalfWeight-feather;
-				akVertex[1].x=fFontSx-fFontHalfWeight-feather;
-				akVertex[2].x=fFontEx-fFontHalfWeight+feather;
-				akVertex[3].x=fFontEx-fFontHalfWeight+feather;
-				
-				if (CGraphicBase::SetPDTStream((SPDTVertex*)akVertex, 4))
-					STATEMANAGER.DrawPrimitive(D3DPT_TRIANGLESTRIP, 0, 2);
-				
+	float fFontSx;
+	float fFontSy;
+	float fFontEx;
+	float fFontEy;
+	float fFontWidth;
+	float fFontHeight;
+	float fFontMaxHeight;
+	float fFontAdvance;
 
-				// 
-				akVertex[0].x=fFontSx+fFontHalfWeight-feather;
-				akVertex[1].x=fFontSx+fFontHalfWeight-feather;
-				akVertex[2].x=fFontEx+fFontHalfWeight+feather;
-				akVertex[3].x=fFontEx+fFontHalfWeight+feather;
+	CGraphicFontTexture::TCharacterInfomation* pCurCharInfo;		
 
-				if (CGraphicBase::SetPDTStream((SPDTVertex*)akVertex, 4))
-					STATEMANAGER.DrawPrimitive(D3DPT_TRIANGLESTRIP, 0, 2);
-				
-				akVertex[0].x=fFontSx-feather;
-				akVertex[1].x=fFontSx-feather;
-				akVertex[2].x=fFontEx+feather;
-				akVertex[3].x=fFontEx+feather;
-				
-				// 
-				akVertex[0].y=fFontSy-fFontHalfWeight-feather;
-				akVertex[1].y=fFontEy-fFontHalfWeight+feather;
-				akVertex[2].y=fFontSy-fFontHalfWeight-feather;
-				akVertex[3].y=fFontEy-fFontHalfWeight+feather;
-
-				// 20041216.myevan.DrawPrimitiveUP
-				if (CGraphicBase::SetPDTStream((SPDTVertex*)akVertex, 4))
-					STATEMANAGER.DrawPrimitive(D3DPT_TRIANGLESTRIP, 0, 2);
-				
-				// Ʒ
-				akVertex[0].y=fFontSy+fFontHalfWeight-feather;
-				akVertex[1].y=fFontEy+fFontHalfWeight+feather;
-				akVertex[2].y=fFontSy+fFontHalfWeight-feather;
-				akVertex[3].y=fFontEy+fFontHalfWeight+feather;
-
-				// 20041216.myevan.DrawPrimitiveUP
-				if (CGraphicBase::SetPDTStream((SPDTVertex*)akVertex, 4))
-					STATEMANAGER.DrawPrimitive(D3DPT_TRIANGLESTRIP, 0, 2);
-				
-				fCurX += fFontAdvance;
-			}
-		}
+	m_kVct_kQuad.reserve(m_pCharInfoVector.size() * (m_isOutline ? 5 : 1));
 
-		//  Ʈ
+	// ׵θ
+	if (m_isOutline)
+	{
 		fCurX=fStanX;
 		fCurY=fStanY;
 		fFontMaxHeight=0.0f;
 
-		for (int i = 0; i < m_pCharInfoVector.size(); ++i)
+		CGraphicFontTexture::TPCharacterInfomationVector::iterator i;
+		for (i=m_pCharInfoVector.begin(); i!=m_pCharInfoVector.end(); ++i)
 		{
-			pCurCharInfo = m_pCharInfoVector[i];
+			pCurCharInfo = *i;
 
 			fFontWidth=float(pCurCharInfo->width);
 			fFontHeight=float(pCurCharInfo->height);
-			fFontMaxHeight=max(fFontHeight, pCurCharInfo->height);
 			fFontAdvance=float(pCurCharInfo->advance);
 
 			// NOTE : Ʈ ¿ Width  Ӵϴ. - [levites]
-			if ((fCurX+fFontWidth)-m_v3Position.x > m_fLimitWidth)
+			if ((fCurX+fFontWidth) > m_fLimitWidth)
 			{
 				if (m_isMultiLine)
 				{
@@ -714,156 +709,205 @@ void CGraphicTextInstance::Render(RECT * pClipRect)
 
 			if (pClipRect)
 			{
-				if (fCurY <= pClipRect->top)
+				if (fCurY + m_v3Position.y <= pClipRect->top)
 				{
 					fCurX += fFontAdvance;
 					continue;
 				}
 			}
 
-			fFontSx = fCurX-0.5f;
-			fFontSy = fCurY-0.5f;
+			fFontSx = fCurX - 0.5f;
+			fFontSy = fCurY - 0.5f;
 			fFontEx = fFontSx + fFontWidth;
 			fFontEy = fFontSy + fFontHeight;
 
-			pFontTexture->SelectTexture(pCurCharInfo->index);
-			STATEMANAGER.SetTexture(0, pFontTexture->GetD3DTexture());
-
-			akVertex[0].x=fFontSx;
-			akVertex[0].y=fFontSy;
-			akVertex[0].u=pCurCharInfo->left;
-			akVertex[0].v=pCurCharInfo->top;
-
-			akVertex[1].x=fFontSx;
-			akVertex[1].y=fFontEy;
-			akVertex[1].u=pCurCharInfo->left;
-			akVertex[1].v=pCurCharInfo->bottom;
-
-			akVertex[2].x=fFontEx;
-			akVertex[2].y=fFontSy;
-			akVertex[2].u=pCurCharInfo->right;
-			akVertex[2].v=pCurCharInfo->top;
-
-			akVertex[3].x=fFontEx;
-			akVertex[3].y=fFontEy;
-			akVertex[3].u=pCurCharInfo->right;
-			akVertex[3].v=pCurCharInfo->bottom;
-
-			//m_dwColorInfoVector[i];
-			//m_dwTextColor;
-			akVertex[0].color = akVertex[1].color = akVertex[2].color = akVertex[3].color = m_dwColorInfoVector[i];
-
-			// 20041216.myevan.DrawPrimitiveUP
-			if (CGraphicBase::SetPDTStream((SPDTVertex*)akVertex, 4))
-				STATEMANAGER.DrawPrimitive(D3DPT_TRIANGLESTRIP, 0, 2);
-			//STATEMANAGER.DrawPrimitiveUP(D3DPT_TRIANGLESTRIP, 2, akVertex, sizeof(SVertex));
+			// , , , Ʒ
+			__PushTextQuad(m_kVct_kQuad, pCurCharInfo, fFontSx-fFontHalfWeight, fFontSy, fFontEx-fFontHalfWeight, fFontEy, m_dwOutLineColor);
+			__PushTextQuad(m_kVct_kQuad, pCurCharInfo, fFontSx+fFontHalfWeight, fFontSy, fFontEx+fFontHalfWeight, fFontEy, m_dwOutLineColor);
+			__PushTextQuad(m_kVct_kQuad, pCurCharInfo, fFontSx, fFontSy-fFontHalfWeight, fFontEx, fFontEy-fFontHalfWeight, m_dwOutLineColor);
+			__PushTextQuad(m_kVct_kQuad, pCurCharInfo, fFontSx, fFontSy+fFontHalfWeight, fFontEx, fFontEy+fFontHalfWeight, m_dwOutLineColor);
 
 			fCurX += fFontAdvance;
 		}
 	}
 
-	if (m_isCursor)
-	{
-		// Draw Cursor
-		float sx, sy, ex, ey;
-		TDiffuse diffuse;
+	//  Ʈ
+	fCurX=fStanX;
+	fCurY=fStanY;
+	fFontMaxHeight=0.0f;
 
-		int curpos = CIME::GetCurPos();
-		int compend = curpos + CIME::GetCompLen();
+	for (int i = 0; i < m_pCharInfoVector.size(); ++i)
+	{
+		pCurCharInfo = m_pCharInfoVector[i];
 
-		__GetTextPos(curpos, &sx, &sy);
+		fFontWidth=float(pCurCharInfo->width);
+		fFontHeight=float(pCurCharInfo->height);
+		fFontMaxHeight=max(fFontHeight, pCurCharInfo->height);
+		fFontAdvance=float(pCurCharInfo->advance);
 
-		// If Composition
-		if(curpos<compend)
-		{
-			diffuse = 0x7fffffff;
-			__GetTextPos(compend, &ex, &sy);
-		}
-		else
+		// NOTE : Ʈ ¿ Width  Ӵϴ. - [levites]
+		if ((fCurX+fFontWidth) > m_fLimitWidth)
 		{
-			diffuse = 0xffffffff;
-			ex = sx + 2;
+			if (m_isMultiLine)
+			{
+				fCurX=fStanX;
+				fCurY+=fFontMaxHeight;
+			}
+			else
+			{
+				break;
+			}
 		}
 
-		// FOR_ARABIC_ALIGN
-		if (defCodePage == CP_ARABIC)
+		if (pClipRect)
 		{
-			sx += m_v3Position.x - m_textWidth;
-			ex += m_v3Position.x - m_textWidth;
-			sy += m_v3Position.y;			
-			ey = sy + m_textHeight;
-		}
-		else
-		{
-			sx += m_v3Position.x;
-			sy += m_v3Position.y;
-			ex += m_v3Position.x;
-			ey = sy + m_textHeight;
+			if (fCurY + m_v3Position.y <= pClipRect->top)
+			{
+				fCurX += fFontAdvance;
+				continue;
+			}
 		}
 
-		switch (m_vAlign)
-		{
-			case VERTICAL_ALIGN_BOTTOM:
-				sy -= m_textHeight;
-				break;
+		fFontSx = fCurX-0.5f;
+		fFontSy = fCurY-0.5f;
+		fFontEx = fFontSx + fFontWidth;
+		fFontEy = fFontSy + fFontHeight;
 
-			case VERTICAL_ALIGN_CENTER:
-				sy -= float(m_textHeight) / 2.0f;
-				break;
-		}		
-		// ȭ 
-		// ؽĸ Ѵٸ... STRIP ϰ, ؽİ ǰų  DrawPrimitive ȣ
-		// ִ ڸ ̵!
+		__PushTextQuad(m_kVct_kQuad, pCurCharInfo, fFontSx, fFontSy, fFontEx, fFontEy, m_dwColorInfoVector[i]);
+
+		fCurX += fFontAdvance;
+	}
+}
+
+void CGraphicTextInstance::Render(RECT * pClipRect)
+{
+	if (!m_isUpdate)
+		return;	
+
+	CGraphicText* pkText=m_roText.GetPointer();
+	if (!pkText)
+		return;
+
+	CGraphicFontTexture* pFontTexture = pkText->GetFontTexturePointer();
+	if (!pFontTexture)
+		return;
 
-		TPDTVertex vertices[4];
-		vertices[0].diffuse = diffuse;
-		vertices[1].diffuse = diffuse;
-		vertices[2].diffuse = diffuse;
-		vertices[3].diffuse = diffuse;
-		vertices[0].position = TPosition(sx, sy, 0.0f);
-		vertices[1].position = TPosition(ex, sy, 0.0f);
-		vertices[2].position = TPosition(sx, ey, 0.0f);
-		vertices[3].position = TPosition(ex, ey, 0.0f);
+	UINT defCodePage = GetDefaultCodePage();
 
-		STATEMANAGER.SetTexture(0, NULL);
+	// ߶ ׸  ġ   ޶Ƿ ĳ ʴ´.
+	if (m_isQuadDirty || pClipRect)
+		__BuildQuads(pClipRect);
 
+	__SubmitQuads(pFontTexture);
 
-		// 2004.11.18.myevan.DrawIndexPrimitiveUP -> DynamicVertexBuffer
-		CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_RECT);
-		if (CGraphicBase::SetPDTStream(vertices, 4))
-			STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, 4, 0, 2);
+	if (pClipRect)
+		m_isQuadDirty = true;
 
-		int ulbegin = CIME::GetULBegin();
-		int ulend = CIME::GetULEnd();
+	// ġ ̸ EndBatch  ѹ ׸. Ŀ ٷ ׷ ϹǷ ׶    ׸.
+	if (!gs_isTextBatchRendering || m_isCursor)
+	{
+		__BeginTextRenderState();
+		__FlushTextBatch();
 
-		if(ulbegin < ulend)
+		if (m_isCursor)
 		{
-			__GetTextPos(curpos+ulbegin, &sx, &sy);
-			__GetTextPos(curpos+ulend, &ex, &sy);
-
-			sx += m_v3Position.x;
-			sy += m_v3Position.y + m_textHeight;
-			ex += m_v3Position.x;
-			ey = sy + 2;
-
-			vertices[0].diffuse = 0xFFFF0000;
-			vertices[1].diffuse = 0xFFFF0000;
-			vertices[2].diffuse = 0xFFFF0000;
-			vertices[3].diffuse = 0xFFFF0000;
+			// Draw Cursor
+			float sx, sy, ex, ey;
+			TDiffuse diffuse;
+
+			int curpos = CIME::GetCurPos();
+			int compend = curpos + CIME::GetCompLen();
+
+			__GetTextPos(curpos, &sx, &sy);
+
+			// If Composition
+			if(curpos<compend)
+			{
+				diffuse = 0x7fffffff;
+				__GetTextPos(compend, &ex, &sy);
+			}
+			else
+			{
+				diffuse = 0xffffffff;
+				ex = sx + 2;
+			}
+
+			// FOR_ARABIC_ALIGN
+			if (defCodePage == CP_ARABIC)
+			{
+				sx += m_v3Position.x - m_textWidth;
+				ex += m_v3Position.x - m_textWidth;
+				sy += m_v3Position.y;			
+				ey = sy + m_textHeight;
+			}
+			else
+			{
+				sx += m_v3Position.x;
+				sy += m_v3Position.y;
+				ex += m_v3Position.x;
+				ey = sy + m_textHeight;
+			}
+
+			switch (m_vAlign)
+			{
+				case VERTICAL_ALIGN_BOTTOM:
+					sy -= m_textHeight;
+					break;
+
+				case VERTICAL_ALIGN_CENTER:
+					sy -= float(m_textHeight) / 2.0f;
+					break;
+			}		
+			// ȭ 
+			// ؽĸ Ѵٸ... STRIP ϰ, ؽİ ǰų  DrawPrimitive ȣ
+			// ִ ڸ ̵!
+
+			TPDTVertex vertices[4];
+			vertices[0].diffuse = diffuse;
+			vertices[1].diffuse = diffuse;
+			vertices[2].diffuse = diffuse;
+			vertices[3].diffuse = diffuse;
 			vertices[0].position = TPosition(sx, sy, 0.0f);
 			vertices[1].position = TPosition(ex, sy, 0.0f);
 			vertices[2].position = TPosition(sx, ey, 0.0f);
 			vertices[3].position = TPosition(ex, ey, 0.0f);
 
-			STATEMANAGER.DrawIndexedPrimitiveUP(D3DPT_TRIANGLELIST, 0, 4, 2, c_FillRectIndices, D3DFMT_INDEX16, vertices, sizeof(TPDTVertex));
-		}		
-	}
+			STATEMANAGER.SetTexture(0, NULL);
 
-	STATEMANAGER.RestoreRenderState(D3DRS_SRCBLEND);
-	STATEMANAGER.RestoreRenderState(D3DRS_DESTBLEND);
 
-	STATEMANAGER.SetRenderState(D3DRS_FOGENABLE, dwFogEnable);
-	STATEMANAGER.SetRenderState(D3DRS_LIGHTING, dwLighting);
+			// 2004.11.18.myevan.DrawIndexPrimitiveUP -> DynamicVertexBuffer
+			CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_RECT);
+			if (CGraphicBase::SetPDTStream(vertices, 4))
+				STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, 4, 0, 2);
+
+			int ulbegin = CIME::GetULBegin();
+			int ulend = CIME::GetULEnd();
+
+			if(ulbegin < ulend)
+			{
+				__GetTextPos(curpos+ulbegin, &sx, &sy);
+				__GetTextPos(curpos+ulend, &ex, &sy);
+
+				sx += m_v3Position.x;
+				sy += m_v3Position.y + m_textHeight;
+				ex += m_v3Position.x;
+				ey = sy + 2;
+
+				vertices[0].diffuse = 0xFFFF0000;
+				vertices[1].diffuse = 0xFFFF0000;
+				vertices[2].diffuse = 0xFFFF0000;
+				vertices[3].diffuse = 0xFFFF0000;
+				vertices[0].position = TPosition(sx, sy, 0.0f);
+				vertices[1].position = TPosition(ex, sy, 0.0f);
+				vertices[2].position = TPosition(sx, ey, 0.0f);
+				vertices[3].position = TPosition(ex, ey, 0.0f);
+
+				STATEMANAGER.DrawIndexedPrimitiveUP(D3DPT_TRIANGLELIST, 0, 4, 2, c_FillRectIndices, D3DFMT_INDEX16, vertices, sizeof(TPDTVertex));
+			}		
+		}
+
+		__EndTextRenderState();
+	}
 
 	//ݰ ũ ִ κ.
 	if (m_hyperlinkVector.size() != 0)
@@ -906,6 +950,8 @@ void CGraphicTextInstance::CreateSystem(UINT uCapacity)
 void CGraphicTextInstance::DestroySystem()
 {
 	ms_kPool.Destroy();
+
+	gs_kVct_kTextBatch.clear();
 }
 
 CGraphicTextInstance* CGraphicTextInstance::New()
@@ -932,11 +978,13 @@ void CGraphicTextInstance::HideCursor()
 void CGraphicTextInstance::ShowOutLine()
 {
 	m_isOutline = true;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::HideOutLine()
 {
 	m_isOutline = false;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetColor(DWORD color)
@@ -948,6 +996,7 @@ void CGraphicTextInstance::SetColor(DWORD color)
 				m_dwColorInfoVector[i] = color;
 
 		m_dwTextColor = color;
+		m_isQuadDirty = true;
 	}
 }
 
@@ -959,11 +1008,13 @@ void CGraphicTextInstance::SetColor(float r, float g, float b, float a)
 void CGraphicTextInstance::SetOutLineColor(DWORD color)
 {
 	m_dwOutLineColor=color;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetOutLineColor(float r, float g, float b, float a)
 {
 	m_dwOutLineColor=D3DXCOLOR(r, g, b, a);
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetSecret(bool Value)
@@ -974,6 +1025,7 @@ void CGraphicTextInstance::SetSecret(bool Value)
 void CGraphicTextInstance::SetOutline(bool Value)
 {
 	m_isOutline = Value;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetFeather(bool Value)
@@ -991,16 +1043,19 @@ void CGraphicTextInstance::SetFeather(bool Value)
 void CGraphicTextInstance::SetMultiLine(bool Value)
 {
 	m_isMultiLine = Value;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetHorizonalAlign(int hAlign)
 {
 	m_hAlign = hAlign;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetVerticalAlign(int vAlign)
 {
 	m_vAlign = vAlign;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetMax(int iMax)
@@ -1011,6 +1066,7 @@ void CGraphicTextInstance::SetMax(int iMax)
 void CGraphicTextInstance::SetLimitWidth(float fWidth)
 {
 	m_fLimitWidth = fWidth;
+	m_isQuadDirty = true;
 }
 
 void CGraphicTextInstance::SetValueString(const std::string& c_stValue)
@@ -1041,6 +1097,7 @@ void CGraphicTextInstance::SetPosition(float fx, float fy, float fz)
 void CGraphicTextInstance::SetTextPointer(CGraphicText* pText)
 {
 	m_roText = pText;
+	m_isQuadDirty = true;
 }
 
 const std::string & CGraphicTextInstance::GetValueStringReference()
@@ -1120,6 +1177,7 @@ void CGraphicTextInstance::__Initialize()
 	m_fFontFeather = c_fFontFeather;
 
 	m_isUpdate = false;
+	m_isQuadDirty = true;
 
 	m_textWidth = 0;
 	m_textHeight = 0;
@@ -1135,6 +1193,7 @@ void CGraphicTextInstance::Destroy()
 	m_pCharInfoVector.clear();
 	m_dwColorInfoVector.clear();
 	m_hyperlinkVector.clear();
+	m_kVct_kQuad.clear();
 
 	__Initialize();
 }
@@ -27,6 +27,17 @@ class CGraphicTextInstance
 		static void Hyperlink_UpdateMousePos(int x, int y);
 		static int  Hyperlink_GetText(char* buf, int len);
 
+		// BeginBatch ~ EndBatch  Render   ξٰ EndBatch  ؽ  ѹ ׸.
+		static void BeginBatch();
+		static void EndBatch();
+
+	public:
+		typedef struct STextQuad
+		{
+			short		index;
+			TPDTVertex	akVertex[4];
+		} TTextQuad;
+
 	public:
 		CGraphicTextInstance();
 		virtual ~CGraphicTextInstance();
@@ -73,6 +84,8 @@ class CGraphicTextInstance
 		int  __DrawCharacter(CGraphicFontTexture * pFontTexture, WORD codePage, wchar_t text, DWORD dwColor);
 		void __GetTextPos(DWORD index, float* x, float* y);
 		int __GetTextTag(const wchar_t * src, int maxLen, int & tagLen, std::wstring & extraInfo);
+		void __BuildQuads(RECT * pClipRect);
+		void __SubmitQuads(CGraphicFontTexture * pFontTexture);
 
 	protected:
 		struct SHyperlink
@@ -112,11 +125,13 @@ class CGraphicTextInstance
 	private:
 		bool m_isUpdate;
 		bool m_isUpdateFontTexture;
+		bool m_isQuadDirty;
 		
 		CGraphicText::TRef m_roText;
 		CGraphicFontTexture::TPCharacterInfomationVector m_pCharInfoVector;
 		std::vector<DWORD> m_dwColorInfoVector;
 		std::vector<SHyperlink> m_hyperlinkVector;
+		std::vector<TTextQuad> m_kVct_kQuad;		// m_v3Position   簢
 
 	public:
 		static void CreateSystem(UINT uCapacity);
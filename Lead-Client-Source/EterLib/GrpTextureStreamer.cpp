@@ -0,0 +1,257 @@
+#include "StdAfx.h"
+#include "../eterBase/Stl.h"
+#include "GrpTextureStreamer.h"
+
+//  Ÿ ȿ  ū  , Ÿ  谡    ܰ辿 
+static const float c_fFullDetailDistance = 1500.0f;
+
+float CGraphicTextureStreamer::ms_fDrawDistance = 0.0f;
+DWORD CGraphicTextureStreamer::ms_dwBudgetBytes = 0;
+DWORD CGraphicTextureStreamer::ms_dwDefaultBudgetBytes = 0;
+
+void CGraphicTextureStreamer::SetDrawDistance(float fDistance)
+{
+	ms_fDrawDistance = fDistance;
+}
+
+void CGraphicTextureStreamer::SetBudget(DWORD dwBudgetBytes)
+{
+	ms_dwBudgetBytes = dwBudgetBytes;
+}
+
+void CGraphicTextureStreamer::SetDefaultBudget(DWORD dwBudgetBytes)
+{
+	ms_dwDefaultBudgetBytes = dwBudgetBytes;
+}
+
+DWORD CGraphicTextureStreamer::__GetBudgetBytes() const
+{
+	if (ms_dwBudgetBytes)
+		return ms_dwBudgetBytes;
+
+	return ms_dwDefaultBudgetBytes;
+}
+
+DWORD CGraphicTextureStreamer::__GetDistanceLOD(float fDistance) const
+{
+	DWORD dwLOD = 0;
+	float fLevelDistance = c_fFullDetailDistance * 2.0f;
+
+	while (fDistance >= fLevelDistance && dwLOD < MAX_LEVEL_NUM - 1)
+	{
+		++dwLOD;
+		fLevelDistance *= 2.0f;
+	}
+
+	return dwLOD;
+}
+
+void CGraphicTextureStreamer::Register(LPDIRECT3DTEXTURE9 lpd3dTexture, UINT uWidth, UINT uHeight, UINT uLevelCount, UINT uBlockBytes)
+{
+	if (!lpd3dTexture || uLevelCount <= 1)
+		return;
+
+	if (uLevelCount > MAX_LEVEL_NUM)
+		uLevelCount = MAX_LEVEL_NUM;
+
+	TTexture kTexture;
+	kTexture.lpd3dTexture = lpd3dTexture;
+	kTexture.dwLevelCount = uLevelCount;
+	kTexture.dwLowestLOD = uLevelCount - 1;
+	kTexture.dwRequestLOD = 0xffffffff;
+	kTexture.dwLastUseFrame = m_dwFrame;
+
+	// DXT  4x4  , ƴϸ uBlockBytes  ȼ ϳ ũ
+	bool isBlock = uBlockBytes >= 8;
+	DWORD adwLevelBytes[MAX_LEVEL_NUM];
+
+	for (UINT i = 0; i < uLevelCount; ++i)
+	{
+		UINT uLevelWidth = max(1U, uWidth >> i);
+		UINT uLevelHeight = max(1U, uHeight >> i);
+
+		if (isBlock)
+			adwLevelBytes[i] = max(1U, uLevelWidth / 4) * max(1U, uLevelHeight / 4) * uBlockBytes;
+		else
+			adwLevelBytes[i] = uLevelWidth * uLevelHeight * uBlockBytes;
+
+		if (i < kTexture.dwLowestLOD && max(uLevelWidth, uLevelHeight) <= MIN_RESIDENT_SIZE)
+			kTexture.dwLowestLOD = i;
+	}
+
+	DWORD dwBytes = 0;
+
+	for (int i = uLevelCount - 1; i >= 0; --i)
+	{
+		dwBytes += adwLevelBytes[i];
+		kTexture.adwResidentBytes[i] = dwBytes;
+	}
+
+	// ó  Ӹ ÷ ٷ ̰ ϰ, ū  Update  ʿ ŭ ø
+	kTexture.dwLOD = kTexture.dwLowestLOD;
+
+	if (!m_kMap_kTexture.insert(TTextureMap::value_type(lpd3dTexture, kTexture)).second)
+		return;
+
+	lpd3dTexture->SetLOD(kTexture.dwLOD);
+	m_dwResidentBytes += kTexture.adwResidentBytes[kTexture.dwLOD];
+}
+
+void CGraphicTextureStreamer::Unregister(LPDIRECT3DTEXTURE9 lpd3dTexture)
+{
+	TTextureMap::iterator f = m_kMap_kTexture.find(lpd3dTexture);
+
+	if (m_kMap_kTexture.end() == f)
+		return;
+
+	m_dwResidentBytes -= f->second.adwResidentBytes[f->second.dwLOD];
+	m_kMap_kTexture.erase(f);
+
+	if (m_lpd3dLastUseTexture == lpd3dTexture)
+		m_lpd3dLastUseTexture = NULL;
+}
+
+void CGraphicTextureStreamer::NotifyUse(LPDIRECT3DBASETEXTURE9 lpd3dTexture)
+{
+	if (!lpd3dTexture || m_kMap_kTexture.empty())
+		return;
+
+	DWORD dwLOD = __GetDistanceLOD(ms_fDrawDistance);
+
+	//  ؽ縦  Ÿ ޾  찡 κ̴
+	if (m_lpd3dLastUseTexture == lpd3dTexture && m_dwLastUseLOD == dwLOD)
+		return;
+
+	m_lpd3dLastUseTexture = lpd3dTexture;
+	m_dwLastUseLOD = dwLOD;
+
+	TTextureMap::iterator f = m_kMap_kTexture.find(lpd3dTexture);
+
+	if (m_kMap_kTexture.end() == f)
+		return;
+
+	TTexture & rkTexture = f->second;
+	rkTexture.dwLastUseFrame = m_dwFrame;
+
+	if (dwLOD < rkTexture.dwRequestLOD)
+		rkTexture.dwRequestLOD = dwLOD;
+}
+
+void CGraphicTextureStreamer::__SetLOD(TTexture & rkTexture, DWORD dwLOD)
+{
+	if (dwLOD > rkTexture.dwLowestLOD)
+		dwLOD = rkTexture.dwLowestLOD;
+
+	if (rkTexture.dwLOD == dwLOD)
+		return;
+
+	m_dwResidentBytes -= rkTexture.adwResidentBytes[rkTexture.dwLOD];
+	m_dwResidentBytes += rkTexture.adwResidentBytes[dwLOD];
+
+	rkTexture.lpd3dTexture->SetLOD(dwLOD);
+	rkTexture.dwLOD = dwLOD;
+}
+
+void CGraphicTextureStreamer::__Reclaim(DWORD dwNeedBytes)
+{
+	DWORD dwBudgetBytes = __GetBudgetBytes();
+
+	m_kVct_pkReclaim.clear();
+
+	for (TTextureMap::iterator i = m_kMap_kTexture.begin(); i != m_kMap_kTexture.end(); ++i)
+	{
+		TTexture & rkTexture = i->second;
+
+		// ̹ ӿ  ؽ ǵ帮 ʴ´
+		if (rkTexture.dwLastUseFrame != m_dwFrame && rkTexture.dwLOD < rkTexture.dwLowestLOD)
+			m_kVct_pkReclaim.push_back(&rkTexture);
+	}
+
+	std::sort(m_kVct_pkReclaim.begin(), m_kVct_pkReclaim.end(), FCompareLastUse());
+
+	//     ؽ ū  
+	for (size_t i = 0; i < m_kVct_pkReclaim.size() && m_dwResidentBytes + dwNeedBytes > dwBudgetBytes; ++i)
+		__SetLOD(*m_kVct_pkReclaim[i], m_kVct_pkReclaim[i]->dwLowestLOD);
+
+	m_kVct_pkReclaim.clear();
+}
+
+void CGraphicTextureStreamer::Update()
+{
+	DWORD dwBudgetBytes = __GetBudgetBytes();
+	DWORD dwUploadBytes = 0;
+	DWORD dwBlockedBytes = 0;
+
+	for (TTextureMap::iterator i = m_kMap_kTexture.begin(); i != m_kMap_kTexture.end(); ++i)
+	{
+		TTexture & rkTexture = i->second;
+		DWORD dwWantLOD = rkTexture.dwLOD;
+
+		if (m_dwFrame - rkTexture.dwLastUseFrame > EVICT_FRAME)
+			dwWantLOD = rkTexture.dwLowestLOD;
+		else if (0xffffffff != rkTexture.dwRequestLOD)
+			dwWantLOD = min(rkTexture.dwRequestLOD, rkTexture.dwLowestLOD);
+
+		rkTexture.dwRequestLOD = 0xffffffff;
+
+		if (dwWantLOD >= rkTexture.dwLOD)
+		{
+			__SetLOD(rkTexture, dwWantLOD);
+			continue;
+		}
+
+		DWORD dwBytes = rkTexture.adwResidentBytes[dwWantLOD] - rkTexture.adwResidentBytes[rkTexture.dwLOD];
+
+		// ø  Ӹ ,     ̷
+		if (dwUploadBytes > 0 && dwUploadBytes + dwBytes > UPLOAD_BYTES_PER_FRAME)
+			continue;
+
+		if (dwBudgetBytes && m_dwResidentBytes + dwBytes > dwBudgetBytes)
+		{
+			dwBlockedBytes += dwBytes;
+			continue;
+		}
+
+		dwUploadBytes += dwBytes;
+		__SetLOD(rkTexture, dwWantLOD);
+	}
+
+	if (dwBudgetBytes && (dwBlockedBytes > 0 || m_dwResidentBytes > dwBudgetBytes))
+		__Reclaim(min(dwBlockedBytes, UPLOAD_BYTES_PER_FRAME));
+
+	m_lpd3dLastUseTexture = NULL;
+	++m_dwFrame;
+}
+
+DWORD CGraphicTextureStreamer::GetResidentBytes() const
+{
+	return m_dwResidentBytes;
+}
+
+DWORD CGraphicTextureStreamer::GetTextureCount() const
+{
+	return m_kMap_kTexture.size();
+}
+
+void CGraphicTextureStreamer::Destroy()
+{
+	m_kMap_kTexture.clear();
+	m_kVct_pkReclaim.clear();
+
+	m_dwResidentBytes = 0;
+	m_lpd3dLastUseTexture = NULL;
+	m_dwLastUseLOD = 0;
+}
+
+CGraphicTextureStreamer::CGraphicTextureStreamer()
+{
+	m_dwFrame = 0;
+	m_dwResidentBytes = 0;
+	m_lpd3dLastUseTexture = NULL;
+	m_dwLastUseLOD = 0;
+}
+
+CGraphicTextureStreamer::~CGraphicTextureStreamer()
+{
+	Destroy();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../eterBase/Singleton.h"
+
+#include "GrpBase.h"
+
+// Ӹ ִ DDS ؽ縦  Ӻ ÷ ΰ, ȭ鿡 ʿ ŭ ū 
+//  ޸𸮿 ø.  Ǯ(D3DPOOL_MANAGED) ؽ SetLOD  .
+class CGraphicTextureStreamer : public CSingleton<CGraphicTextureStreamer>
+{
+	public:
+		enum
+		{
+			MAX_LEVEL_NUM = 16,
+			MIN_RESIDENT_SIZE = 64,							// ó øų о   δ  ũ
+			EVICT_FRAME = 300,								// ̸ŭ   ؽ ū  
+			UPLOAD_BYTES_PER_FRAME = 4 * 1024 * 1024,		//  ӿ  ø 
+		};
+
+	public:
+		CGraphicTextureStreamer();
+		virtual ~CGraphicTextureStreamer();
+
+		void	Destroy();
+
+		void	Register(LPDIRECT3DTEXTURE9 lpd3dTexture, UINT uWidth, UINT uHeight, UINT uLevelCount, UINT uBlockBytes);
+		void	Unregister(LPDIRECT3DTEXTURE9 lpd3dTexture);
+
+		void	NotifyUse(LPDIRECT3DBASETEXTURE9 lpd3dTexture);
+		void	Update();
+
+		DWORD	GetResidentBytes() const;
+		DWORD	GetTextureCount() const;
+
+		static void	SetDrawDistance(float fDistance);
+		static void	SetBudget(DWORD dwBudgetBytes);
+		static void	SetDefaultBudget(DWORD dwBudgetBytes);
+
+	protected:
+		typedef struct STexture
+		{
+			LPDIRECT3DTEXTURE9	lpd3dTexture;
+			DWORD				dwLevelCount;
+			DWORD				dwLowestLOD;
+			DWORD				dwLOD;
+			DWORD				dwRequestLOD;
+			DWORD				dwLastUseFrame;
+			DWORD				adwResidentBytes[MAX_LEVEL_NUM];	// ش    ӱ ũ
+		} TTexture;
+
+		typedef std::map<LPDIRECT3DBASETEXTURE9, TTexture> TTextureMap;
+
+		struct FCompareLastUse
+		{
+			bool operator () (const TTexture * c_pkLeft, const TTexture * c_pkRight) const
+			{
+				return c_pkLeft->dwLastUseFrame < c_pkRight->dwLastUseFrame;
+			}
+		};
+
+	protected:
+		DWORD	__GetDistanceLOD(float fDistance) const;
+		DWORD	__GetBudgetBytes() const;
+		void	__SetLOD(TTexture & rkTexture, DWORD dwLOD);
+		void	__Reclaim(DWORD dwNeedBytes);
+
+	protected:
+		TTextureMap				m_kMap_kTexture;
+		std::vector<TTexture *>	m_kVct_pkReclaim;
+
+		DWORD					m_dwFrame;
+		DWORD					m_dwResidentBytes;
+
+		LPDIRECT3DBASETEXTURE9	m_lpd3dLastUseTexture;
+		DWORD					m_dwLastUseLOD;
+
+		static float			ms_fDrawDistance;
+		static DWORD			ms_dwBudgetBytes;
+		static DWORD			ms_dwDefaultBudgetBytes;
+};
@@ -18,10 +18,72 @@ bool CDynamicVertexBuffer::Create(int vtxCount, int fvf)
 	return CGraphicVertexBuffer::Create(m_vtxCount, m_fvf, D3DUSAGE_DYNAMIC, D3DPOOL_SYSTEMMEM);
 }
 
+bool CDynamicVertexBuffer::CreateRing(UINT uBufferSize)
+{
+	assert(ms_lpd3dDevice != NULL);
+	assert(uBufferSize > 0);
+
+	Destroy();
+
+	//   ٸ Ʈ  Ƿ FVF  Ʈ  .
+	CGraphicVertexBuffer::m_vtxCount = 0;
+	m_dwBufferSize = uBufferSize;
+	m_d3dPool = D3DPOOL_SYSTEMMEM;
+	m_dwUsage = D3DUSAGE_DYNAMIC|D3DUSAGE_WRITEONLY;
+	m_dwFVF = 0;
+	m_dwLockFlag = 0;
+
+	m_uRingPos = 0;
+
+	return CreateDeviceObjects();
+}
+
+void CDynamicVertexBuffer::Discard()
+{
+	//  Append  DISCARD  ó  Ѵ.
+	m_uRingPos = m_dwBufferSize;
+}
+
+bool CDynamicVertexBuffer::Append(const void * c_pVertices, UINT uVtxCount, UINT uStride, UINT * puOffset)
+{
+	if (!m_lpd3dVB || !uVtxCount || !uStride)
+		return false;
+
+	UINT uSize = uVtxCount * uStride;
+
+	if (uSize > m_dwBufferSize)
+		return false;
+
+	// Ʈ  stride  .
+	UINT uPos = (m_uRingPos + uStride - 1) / uStride * uStride;
+	DWORD dwLockFlag = D3DLOCK_NOOVERWRITE;
+
+	// Ʈ   ġ Ź ó .
+	if (!(ms_d3dCaps.DevCaps2 & D3DDEVCAPS2_STREAMOFFSET) || uPos + uSize > m_dwBufferSize)
+	{
+		uPos = 0;
+		dwLockFlag = D3DLOCK_DISCARD;
+	}
+
+	void * pDstVertices;
+
+	if (FAILED(m_lpd3dVB->Lock(uPos, uSize, &pDstVertices, dwLockFlag)))
+		return false;
+
+	memcpy(pDstVertices, c_pVertices, uSize);
+
+	m_lpd3dVB->Unlock();
+
+	m_uRingPos = uPos + uSize;
+	*puOffset = uPos;
+	return true;
+}
+
 CDynamicVertexBuffer::CDynamicVertexBuffer()
 {
 	m_vtxCount = 0;
 	m_fvf = 0;
+	m_uRingPos = 0;
 }
 
 CDynamicVertexBuffer::~CDynamicVertexBuffer()
@@ -10,10 +10,14 @@ class CDynamicVertexBuffer : public CGraphicVertexBuffer
 
 		bool Create(int vtxCount, int fvf);
 
-
+		//   - ϳ ū  ڿ NOOVERWRITE  ̾ ̰,   DISCARD ϰ ó .
+		bool CreateRing(UINT uBufferSize);
+		bool Append(const void * c_pVertices, UINT uVtxCount, UINT uStride, UINT * puOffset);
+		void Discard();
 
 	protected:
 		int m_vtxCount;
 		int m_fvf;
-};
 
+		UINT m_uRingPos;
+};
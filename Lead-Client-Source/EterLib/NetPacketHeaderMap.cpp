@@ -3,22 +3,31 @@
 
 void CNetworkPacketHeaderMap::Set(int header, const TPacketType& rPacketType)
 {
-	m_headerMap[header] = rPacketType;
+	if (header < 0 || header >= HEADER_NUM)
+	{
+		TraceError("CNetworkPacketHeaderMap::Set - header %d out of range", header);
+		return;
+	}
+
+	m_aPacketType[header] = rPacketType;
+	m_abRegistered[header] = true;
 }
 bool CNetworkPacketHeaderMap::Get(int header, TPacketType* pPacketType)
 {
-	std::map<int, TPacketType>::iterator f=m_headerMap.find(header);
+	if (header < 0 || header >= HEADER_NUM)
+		return false;
 	
-	if (m_headerMap.end()==f)
+	if (!m_abRegistered[header])
 		return false;
 	
-	*pPacketType = f->second;
+	*pPacketType = m_aPacketType[header];
 
 	return true;
 }
 
 CNetworkPacketHeaderMap::CNetworkPacketHeaderMap()
 {
+	memset(m_abRegistered, 0, sizeof(m_abRegistered));
 }
 
 CNetworkPacketHeaderMap::~CNetworkPacketHeaderMap()
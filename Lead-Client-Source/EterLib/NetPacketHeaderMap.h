@@ -1,7 +1,5 @@
 #pragma once
 
-#include <map>
-
 class CNetworkPacketHeaderMap
 {
 	public:
@@ -17,6 +15,11 @@ class CNetworkPacketHeaderMap
 			bool isDynamicSizePacket;
 		} TPacketType;
 
+		enum
+		{
+			HEADER_NUM = 256,	// TPacketHeader  BYTE
+		};
+
 	public:
 		CNetworkPacketHeaderMap();
 		virtual ~CNetworkPacketHeaderMap();
@@ -25,5 +28,7 @@ class CNetworkPacketHeaderMap
 		bool Get(int header, TPacketType * pPacketType);
 
 	protected:
-		std::map<int, TPacketType> m_headerMap;
+		// Ŷ ãǷ map   ٷ εѴ
+		TPacketType	m_aPacketType[HEADER_NUM];
+		bool		m_abRegistered[HEADER_NUM];
 };
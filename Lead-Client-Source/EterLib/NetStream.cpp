@@ -83,7 +83,7 @@ bool CNetworkStream::__RecvInternalBuffer()
  
 		if (restSize > 0)
 		{
-			int recvSize = recv(m_sock, m_recvTEABuf + m_recvTEABufInputPos, restSize, 0);	
+			int recvSize = __RecvSocket(m_recvTEABuf + m_recvTEABufInputPos, restSize);	
 			//Tracenf("RECV %d %d(%d, %d)", recvSize, restSize, m_recvTEABufSize - m_recvTEABufInputPos, m_recvBufSize - m_recvBufInputPos);
 
 			if (recvSize < 0)
@@ -137,7 +137,7 @@ bool CNetworkStream::__RecvInternalBuffer()
 		int restSize = m_recvBufSize - m_recvBufInputPos;
 		if (restSize>0)
 		{		
-			int recvSize = recv(m_sock, m_recvBuf + m_recvBufInputPos, m_recvBufSize - m_recvBufInputPos, 0);	
+			int recvSize = __RecvSocket(m_recvBuf + m_recvBufInputPos, m_recvBufSize - m_recvBufInputPos);	
 			//Tracenf("RECV %d %d(%d, %d)", recvSize, restSize, m_recvTEABufSize - m_recvTEABufInputPos, m_recvBufSize - m_recvBufInputPos);
 
 			if (recvSize < 0)
@@ -163,6 +163,169 @@ bool CNetworkStream::__RecvInternalBuffer()
 	return true;
 }
 
+//  尡    ۿ, ƴϸ Ͽ  д´. ȯ recv  .
+int CNetworkStream::__RecvSocket(char* pDestBuf, int size)
+{
+	if (!m_hRecvThread)
+		return recv(m_sock, pDestBuf, size, 0);
+
+	m_recvRingMutex.Lock();
+
+	int copySize = min(size, m_recvRingDataSize);
+	int firstSize = min(copySize, m_recvRingBufSize - m_recvRingOutputPos);
+
+	memcpy(pDestBuf, m_recvRingBuf + m_recvRingOutputPos, firstSize);
+
+	if (copySize > firstSize)
+		memcpy(pDestBuf + firstSize, m_recvRingBuf, copySize - firstSize);
+
+	m_recvRingOutputPos = (m_recvRingOutputPos + copySize) % m_recvRingBufSize;
+	m_recvRingDataSize -= copySize;
+
+	bool isEnd = m_isRecvThreadEnd;
+	int error = m_recvThreadError;
+
+	m_recvRingMutex.Unlock();
+
+	if (copySize > 0)
+		return copySize;
+
+	//  ۸   ڿ  ˸.    recv  ó   ش
+	if (isEnd)
+	{
+		if (!error)
+			return 0;
+
+		WSASetLastError(error);
+		return SOCKET_ERROR;
+	}
+
+	WSASetLastError(WSAEWOULDBLOCK);
+	return SOCKET_ERROR;
+}
+
+void CNetworkStream::SetRecvThreadMode(bool isOn)
+{
+	m_isRecvThreadMode = isOn;
+}
+
+bool CNetworkStream::__StartRecvThread()
+{
+	if (m_hRecvThread)
+		return true;
+
+	if (!m_recvRingBuf)
+	{
+		m_recvRingBufSize = max(m_recvBufSize, RECV_RING_BUFFER_MIN_SIZE);
+		m_recvRingBuf = new char[m_recvRingBufSize];
+	}
+
+	m_recvRingOutputPos = 0;
+	m_recvRingDataSize = 0;
+	m_isRecvThreadEnd = false;
+	m_recvThreadError = 0;
+	m_isRecvThreadShutdown = false;
+
+	unsigned threadID;
+	m_hRecvThread = (HANDLE) _beginthreadex(NULL, 0, __RecvThreadEntryPoint, this, 0, &threadID);
+
+	if (!m_hRecvThread)
+	{
+		// 带   ó Process   ޴´
+		TraceError("CNetworkStream::__StartRecvThread - _beginthreadex failed, errno %d", errno);
+		return false;
+	}
+
+	return true;
+}
+
+void CNetworkStream::__StopRecvThread()
+{
+	if (!m_hRecvThread)
+		return;
+
+	m_isRecvThreadShutdown = true;
+
+	// select  ð ªǷ  ɸ ʴ´
+	WaitForSingleObject(m_hRecvThread, INFINITE);
+	CloseHandle(m_hRecvThread);
+	m_hRecvThread = NULL;
+
+	m_recvRingOutputPos = 0;
+	m_recvRingDataSize = 0;
+	m_isRecvThreadEnd = false;
+	m_recvThreadError = 0;
+}
+
+UINT CALLBACK CNetworkStream::__RecvThreadEntryPoint(void* pvThis)
+{
+	return ((CNetworkStream*) pvThis)->__RecvThreadProcess();
+}
+
+UINT CNetworkStream::__RecvThreadProcess()
+{
+	int error = 0;
+
+	while (!m_isRecvThreadShutdown)
+	{
+		m_recvRingMutex.Lock();
+		int inputPos = (m_recvRingOutputPos + m_recvRingDataSize) % m_recvRingBufSize;
+		int restSize = m_recvRingBufSize - m_recvRingDataSize;
+		m_recvRingMutex.Unlock();
+
+		//  ۰    尡   ٸ
+		if (restSize <= 0)
+		{
+			Sleep(1);
+			continue;
+		}
+
+		fd_set fdsRecv;
+		FD_ZERO(&fdsRecv);
+		FD_SET(m_sock, &fdsRecv);
+
+		TIMEVAL delay;
+		delay.tv_sec = 0;
+		delay.tv_usec = RECV_THREAD_SELECT_USEC;
+
+		int ret = select(0, &fdsRecv, NULL, NULL, &delay);
+
+		if (ret == SOCKET_ERROR)
+		{
+			error = WSAGetLastError();
+			break;
+		}
+
+		if (ret == 0)
+			continue;
+
+		//   Ͱ ִ  Ƿ    ʰ ޴´
+		int recvSize = recv(m_sock, m_recvRingBuf + inputPos, min(restSize, m_recvRingBufSize - inputPos), 0);
+
+		if (recvSize < 0)
+		{
+			if (WSAGetLastError() == WSAEWOULDBLOCK)
+				continue;
+
+			error = WSAGetLastError();
+			break;
+		}
+		else if (recvSize == 0)
+		{
+			break;
+		}
+
+		m_recvRingMutex.Lock();
+		m_recvRingDataSize += recvSize;
+		m_recvRingMutex.Unlock();
+	}
+
+	m_recvRingMutex.Lock();
+	m_isRecvThreadEnd = true;
+	m_recvThreadError = error;
+	m_recvRingMutex.Unlock();
+	return 0;
+}
 
 bool CNetworkStream::__SendInternalBuffer()
 {
@@ -255,6 +418,10 @@ void CNetworkStream::Process()
 		if (FD_ISSET(m_sock, &fdsSend))
 		{
 			m_isOnline = true;
+
+			if (m_isRecvThreadMode)
+				__StartRecvThread();
+
 			OnConnectSuccess();
 		}
 		else if (time(NULL) > m_connectLimitTime)
@@ -281,7 +448,8 @@ void CNetworkStream::Process()
 		}
 	}
 
-	if (FD_ISSET(m_sock, &fdsRecv))
+	//  尡   ¿   ۿ   ´
+	if (m_hRecvThread || FD_ISSET(m_sock, &fdsRecv))
 	{
 		if (!__RecvInternalBuffer())
 		{
@@ -314,6 +482,9 @@ void CNetworkStream::Clear()
 	if (m_sock == INVALID_SOCKET)
 		return;
 
+	//  ݱ    
+	__StopRecvThread();
+
 	closesocket(m_sock);
 	m_sock = INVALID_SOCKET;
 
@@ -444,6 +615,42 @@ bool CNetworkStream::Recv(int size, char * pDestBuf)
 	return true;
 }
 
+bool CNetworkStream::__PushRecvBuffer(int size, const void * c_pvData)
+{
+	if (size <= 0)
+		return false;
+
+	if (m_recvBufOutputPos >= size)
+	{
+		m_recvBufOutputPos -= size;
+		memcpy(m_recvBuf + m_recvBufOutputPos, c_pvData, size);
+		return true;
+	}
+
+	int restSize = GetRecvBufferSize();
+	int newSize = size + restSize;
+
+	if (newSize > m_recvBufSize)
+	{
+		// The TEA buffer keeps its size, __RecvInternalBuffer only reads what fits in both.
+		char * newBuf = new char[newSize];
+		memcpy(newBuf + size, m_recvBuf + m_recvBufOutputPos, restSize);
+
+		delete [] m_recvBuf;
+		m_recvBuf = newBuf;
+		m_recvBufSize = newSize;
+	}
+	else
+	{
+		memmove(m_recvBuf + size, m_recvBuf + m_recvBufOutputPos, restSize);
+	}
+
+	memcpy(m_recvBuf, c_pvData, size);
+	m_recvBufOutputPos = 0;
+	m_recvBufInputPos = newSize;
+	return true;
+}
+
 int CNetworkStream::__GetSendBufferSize()
 {
 	return m_sendBufInputPos-m_sendBufOutputPos;
@@ -2659,6 +2866,17 @@ CNetworkStream::CNetworkStream()
 	m_bUseSequence = false;
 	m_kVec_bSequenceTable.resize(SEQUENCE_TABLE_SIZE);
 	memcpy(&m_kVec_bSequenceTable[0], s_bSequenceTable, sizeof(BYTE) * SEQUENCE_TABLE_SIZE);
+
+	m_isRecvThreadMode = false;
+	m_hRecvThread = NULL;
+	m_isRecvThreadShutdown = false;
+	m_isRecvThreadEnd = false;
+	m_recvThreadError = 0;
+
+	m_recvRingBuf = NULL;
+	m_recvRingBufSize = 0;
+	m_recvRingOutputPos = 0;
+	m_recvRingDataSize = 0;
 }
 
 CNetworkStream::~CNetworkStream()
@@ -2688,5 +2906,11 @@ CNetworkStream::~CNetworkStream()
 		delete [] m_sendBuf;
 		m_sendBuf=NULL;
 	}
+
+	if (m_recvRingBuf)
+	{
+		delete [] m_recvRingBuf;
+		m_recvRingBuf=NULL;
+	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include "../eterBase/tea.h"
 #include "NetAddress.h"
+#include "Mutex.h"
 
 class CNetworkStream
 {
@@ -44,6 +45,9 @@ class CNetworkStream
 		void SetPacketSequenceMode(bool isOn);
 		bool SendSequence();
 
+		//  Ǹ  尡 Ӱ      ۿ ״´
+		void SetRecvThreadMode(bool isOn);
+
 	protected:			
 		virtual void OnConnectSuccess();				
 		virtual void OnConnectFailure();
@@ -53,11 +57,20 @@ class CNetworkStream
 
 		bool __SendInternalBuffer();
 		bool __RecvInternalBuffer();
+		bool __PushRecvBuffer(int len, const void* c_pvData);	// puts data in front of the unread recv data
 
 		void __PopSendBuffer();
 
 		int __GetSendBufferSize();
 
+		int __RecvSocket(char* pDestBuf, int size);
+
+		bool __StartRecvThread();
+		void __StopRecvThread();
+		UINT __RecvThreadProcess();
+
+		static UINT CALLBACK __RecvThreadEntryPoint(void* pvThis);
+
 	private:
 		time_t	m_connectLimitTime;
 
@@ -94,4 +107,23 @@ class CNetworkStream
 		DWORD					m_iSequence;
 		bool					m_bUseSequence;
 		std::vector<BYTE>		m_kVec_bSequenceTable;
+
+		// Recv Thread
+		enum
+		{
+			RECV_RING_BUFFER_MIN_SIZE = 256 * 1024,
+			RECV_THREAD_SELECT_USEC = 50 * 1000,
+		};
+
+		bool					m_isRecvThreadMode;
+		HANDLE					m_hRecvThread;
+		volatile bool			m_isRecvThreadShutdown;
+		bool					m_isRecvThreadEnd;		//  ᳪ    尡 
+		int						m_recvThreadError;		//     WSA ,   0
+
+		Mutex					m_recvRingMutex;
+		char*					m_recvRingBuf;
+		int						m_recvRingBufSize;
+		int						m_recvRingOutputPos;
+		int						m_recvRingDataSize;
 };
@@ -8,7 +8,7 @@
 
 bool CResource::ms_bDeleteImmediately = false;
 
-CResource::CResource(const char* c_szFileName) : me_state(STATE_EMPTY)
+CResource::CResource(const char* c_szFileName) : m_dwLoadCostMiliiSecond(0), m_dwLoadSize(0), me_state(STATE_EMPTY)
 {
 	SetFileName(c_szFileName);
 }
@@ -24,6 +24,8 @@ void CResource::SetDeleteImmediately(bool isSet)
 
 void CResource::OnConstruct()
 {
+	//   ̴ ҽ Ͱ  Ƿ Load  ƹ͵  Ѵ.
+	CResourceManager::Instance().RestoreDeletingResource(this);
 	Load();
 }
 
@@ -51,6 +53,7 @@ void CResource::Load()
 	if (CEterPackManager::Instance().Get(file, c_szFileName, &fileData))
 	{
 		m_dwLoadCostMiliiSecond = ELTimer_GetMSec() - dwStart;
+		m_dwLoadSize = file.Size();
 		//Tracef("CResource::Load %s (%d bytes) in %d ms\n", c_szFileName, file.Size(), m_dwLoadCostMiliiSecond);
 
 		if (OnLoad(file.Size(), fileData))
@@ -86,6 +89,8 @@ void CResource::Reload()
 
 	if (CEterPackManager::Instance().Get(file, GetFileName(), &fileData))
 	{
+		m_dwLoadSize = file.Size();
+
 		if (OnLoad(file.Size(), fileData))
 		{
 			me_state = STATE_EXIST;
@@ -142,6 +147,16 @@ void CResource::Clear()
 	me_state = STATE_EMPTY;
 }
 
+int CResource::GetCacheGroup() const
+{
+	return CACHE_GROUP_ETC;
+}
+
+DWORD CResource::GetMemorySize() const
+{
+	return m_dwLoadSize;
+}
+
 bool CResource::IsType(TType type)
 {
 	return OnIsType(type);
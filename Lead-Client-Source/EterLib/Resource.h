@@ -17,6 +17,16 @@ class CResource : public CReferenceObject
 			STATE_FREE
 		};
 
+		//   ҽ CResourceManager      ִ´.
+		enum ECacheGroup
+		{
+			CACHE_GROUP_TEXTURE,
+			CACHE_GROUP_MODEL,
+			CACHE_GROUP_MOTION,
+			CACHE_GROUP_ETC,
+			CACHE_GROUP_NUM
+		};
+
 	public:
 		void			Clear();
 
@@ -48,6 +58,9 @@ class CResource : public CReferenceObject
 
 		virtual bool	OnLoad(int iSize, const void * c_pvBuf) = 0;
 
+		virtual int		GetCacheGroup() const;
+		virtual DWORD	GetMemorySize() const;		// ⺻   ũ
+
 	protected:
 		void			SetFileName(const char* c_szFileName);
 
@@ -62,6 +75,7 @@ class CResource : public CReferenceObject
 		std::string		m_stFileName;
 		//char *			m_pszFileName;
 		DWORD			m_dwLoadCostMiliiSecond;
+		DWORD			m_dwLoadSize;
 		EState			me_state;
 
 	protected:
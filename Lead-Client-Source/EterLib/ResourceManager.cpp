@@ -10,12 +10,30 @@
 
 int g_iLoadingDelayTime = 20;
 
-const long c_Deleting_Wait_Time = 30000;			//   ð (30)
 const long c_DeletingCountPerFrame = 30;			// Ӵ üũ ҽ 
 const long c_Reference_Decrease_Wait_Time = 30000;	// ε ҽ   ð (30)
 
 CFileLoaderThread CResourceManager::ms_loadingThread;
 
+// ĳͰ ٷ ̵ / , ؽ縦  д´.
+static DWORD GetBackgroundLoadingPriority(const std::string & c_rstFileName)
+{
+	std::string::size_type pos = c_rstFileName.rfind('.');
+
+	if (std::string::npos == pos)
+		return CFileLoaderThread::PRIORITY_ETC;
+
+	const char * c_szExt = c_rstFileName.c_str() + pos + 1;
+
+	if (0 == _stricmp(c_szExt, "gr2"))
+		return CFileLoaderThread::PRIORITY_MODEL;
+
+	if (0 == _stricmp(c_szExt, "dds") || 0 == _stricmp(c_szExt, "tga") || 0 == _stricmp(c_szExt, "jpg") || 0 == _stricmp(c_szExt, "png") || 0 == _stricmp(c_szExt, "bmp"))
+		return CFileLoaderThread::PRIORITY_TEXTURE;
+
+	return CFileLoaderThread::PRIORITY_ETC;
+}
+
 void CResourceManager::LoadStaticCache(const char* c_szFileName)
 {
 	CResource* pkRes=GetResourcePointer(c_szFileName);
@@ -53,7 +71,7 @@ void CResourceManager::ProcessBackgroundLoading()
 		}
 
 		//printf("REQ %s\n", stFileName.c_str());
-		ms_loadingThread.Request(stFileName);
+		ms_loadingThread.Request(stFileName, GetBackgroundLoadingPriority(stFileName));
 		m_WaitingMap.insert(TResourceRequestMap::value_type(dwFileCRC, stFileName));
 		itor = m_RequestMap.erase(itor);
 		//break; // NOTE: ⼭ break ϸ õõ ε ȴ.
@@ -65,7 +83,8 @@ void CResourceManager::ProcessBackgroundLoading()
 	while (ms_loadingThread.Fetch(&pData))
 	{
 		//printf("LOD %s\n", pData->stFileName.c_str());
-		CResource * pResource = GetResourcePointer(pData->stFileName.c_str());
+		// ҵǾų    ߿    д´.
+		CResource * pResource = pData->pvBuf ? GetResourcePointer(pData->stFileName.c_str()) : NULL;
 
 		if (pResource)
 		{
@@ -110,6 +129,21 @@ void CResourceManager::ProcessBackgroundLoading()
 
 void CResourceManager::PushBackgroundLoadingSet(std::set<std::string> & LoadingSet)
 {
+	//  Ͽ   û  ʿ Ƿ Ѵ.
+	for (TResourceRequestMap::iterator itWait = m_WaitingMap.begin(); itWait != m_WaitingMap.end(); ++itWait)
+	{
+		if (LoadingSet.end() == LoadingSet.find(itWait->second))
+			ms_loadingThread.Cancel(itWait->second);
+	}
+
+	for (TResourceRequestMap::iterator itReq = m_RequestMap.begin(); itReq != m_RequestMap.end();)
+	{
+		if (LoadingSet.end() == LoadingSet.find(itReq->second))
+			itReq = m_RequestMap.erase(itReq);
+		else
+			++itReq;
+	}
+
 	std::set<std::string>::iterator itor = LoadingSet.begin();
 
 	while (itor != LoadingSet.end())
@@ -127,6 +161,16 @@ void CResourceManager::PushBackgroundLoadingSet(std::set<std::string> & LoadingS
 	}
 }
 
+void CResourceManager::RequestBackgroundLoading(const char * c_szFileName)
+{
+	DWORD dwFileCRC = __GetFileCRC(c_szFileName);
+
+	if (isResourcePointerData(dwFileCRC))
+		return;
+
+	m_RequestMap.insert(TResourceRequestMap::value_type(dwFileCRC, c_szFileName));
+}
+
 void CResourceManager::__DestroyCacheMap()
 {
 	TResourcePointerMap::iterator i;
@@ -146,6 +190,12 @@ void CResourceManager::__DestroyDeletingResourceMap()
 		(i->first)->Clear();
 
 	m_ResourceDeletingMap.clear();
+
+	for (int i = 0; i < CResource::CACHE_GROUP_NUM; ++i)
+	{
+		m_akCacheGroup[i].kLRUList.clear();
+		m_akCacheGroup[i].dwUsedSize = 0;
+	}
 }
 
 void CResourceManager::__DestroyResourceMap()
@@ -477,31 +527,34 @@ bool CResourceManager::IsFileExist(const char * c_szFileName)
 
 void CResourceManager::Update()
 {
-	DWORD CurrentTime = ELTimer_GetMSec();
-	CResource * pResource;
 	int Count = 0;
 
-	TResourceDeletingMap::iterator itor = m_ResourceDeletingMap.begin();
-
-	while (itor != m_ResourceDeletingMap.end())
+	//        ͺ Ǭ.
+	for (int i = 0; i < CResource::CACHE_GROUP_NUM && Count < c_DeletingCountPerFrame; ++i)
 	{
-		pResource = itor->first;
+		TCacheGroup & rkGroup = m_akCacheGroup[i];
 
-		if (CurrentTime >= itor->second)
+		while (rkGroup.dwUsedSize > rkGroup.dwBudget && !rkGroup.kLRUList.empty())
 		{
+			CResource * pResource = rkGroup.kLRUList.back();
+			TResourceDeletingMap::iterator itor = m_ResourceDeletingMap.find(pResource);
+
+			assert(m_ResourceDeletingMap.end() != itor);
+			rkGroup.dwUsedSize -= itor->second.dwSize;
+			rkGroup.kLRUList.pop_back();
+			m_ResourceDeletingMap.erase(itor);
+
+			// ε  ö  Ͽ .
 			if (pResource->canDestroy())
 			{
 				//Tracef("Resource Clear %s\n", pResource->GetFileName());
 				pResource->Clear();
+				++rkGroup.dwEvictCount;
 			}
 
-			itor = m_ResourceDeletingMap.erase(itor);
-
 			if (++Count >= c_DeletingCountPerFrame)
 				break;
 		}
-		else
-			++itor;
 	}
 
 	ProcessBackgroundLoading();
@@ -509,17 +562,101 @@ void CResourceManager::Update()
 
 void CResourceManager::ReserveDeletingResource(CResource * pResource)
 {
-	DWORD dwCurrentTime = ELTimer_GetMSec();
-	m_ResourceDeletingMap.insert(TResourceDeletingMap::value_type(pResource, dwCurrentTime + c_Deleting_Wait_Time));
+	TResourceDeletingMap::iterator itor = m_ResourceDeletingMap.find(pResource);
+
+	if (m_ResourceDeletingMap.end() != itor)
+	{
+		TCacheGroup & rkGroup = m_akCacheGroup[itor->second.iGroup];
+		rkGroup.kLRUList.splice(rkGroup.kLRUList.begin(), rkGroup.kLRUList, itor->second.itLRU);
+		return;
+	}
+
+	int iGroup = pResource->GetCacheGroup();
+
+	if (iGroup < 0 || iGroup >= CResource::CACHE_GROUP_NUM)
+		iGroup = CResource::CACHE_GROUP_ETC;
+
+	TCacheGroup & rkGroup = m_akCacheGroup[iGroup];
+
+	TDeletingInfo kInfo;
+	kInfo.iGroup = iGroup;
+	kInfo.dwSize = pResource->GetMemorySize();
+	kInfo.itLRU = rkGroup.kLRUList.insert(rkGroup.kLRUList.begin(), pResource);
+
+	rkGroup.dwUsedSize += kInfo.dwSize;
+	m_ResourceDeletingMap.insert(TResourceDeletingMap::value_type(pResource, kInfo));
+}
+
+void CResourceManager::RestoreDeletingResource(CResource * pResource)
+{
+	TResourceDeletingMap::iterator itor = m_ResourceDeletingMap.find(pResource);
+
+	if (m_ResourceDeletingMap.end() == itor)
+		return;
+
+	TCacheGroup & rkGroup = m_akCacheGroup[itor->second.iGroup];
+
+	rkGroup.dwUsedSize -= itor->second.dwSize;
+	rkGroup.kLRUList.erase(itor->second.itLRU);
+
+	if (pResource->IsData())
+		++rkGroup.dwHitCount;
+
+	m_ResourceDeletingMap.erase(itor);
+}
+
+void CResourceManager::SetCacheBudget(int iGroup, DWORD dwBytes)
+{
+	if (iGroup < 0 || iGroup >= CResource::CACHE_GROUP_NUM)
+		return;
+
+	m_akCacheGroup[iGroup].dwBudget = dwBytes;
+}
+
+void CResourceManager::GetInfo(std::string * pstInfo)
+{
+	static const char * c_aszGroupName[CResource::CACHE_GROUP_NUM] = { "Tex", "Model", "Motion", "Etc" };
+
+	char szInfo[128];
+
+	pstInfo->append("Resource:");
+
+	for (int i = 0; i < CResource::CACHE_GROUP_NUM; ++i)
+	{
+		const TCacheGroup & c_rkGroup = m_akCacheGroup[i];
+
+		_snprintf(szInfo, sizeof(szInfo), " %s %.1f/%uMB (%u, hit %u, evict %u)",
+				c_aszGroupName[i],
+				c_rkGroup.dwUsedSize / (1024.0f * 1024.0f),
+				c_rkGroup.dwBudget / (1024 * 1024),
+				c_rkGroup.kLRUList.size(),
+				c_rkGroup.dwHitCount,
+				c_rkGroup.dwEvictCount);
+		szInfo[sizeof(szInfo) - 1] = '\0';
+
+		pstInfo->append(szInfo);
+	}
 }
 
 CResourceManager::CResourceManager()
 {
-	//ms_loadingThread.Create(0);
+	// 32Ʈ Ŭ̾Ʈ ּ   ⺻. ̽ app.SetResourceCacheBudget  ٲ۴.
+	static const DWORD c_adwDefaultBudgetMB[CResource::CACHE_GROUP_NUM] = { 96, 48, 32, 16 };
+
+	for (int i = 0; i < CResource::CACHE_GROUP_NUM; ++i)
+	{
+		m_akCacheGroup[i].dwUsedSize = 0;
+		m_akCacheGroup[i].dwBudget = c_adwDefaultBudgetMB[i] * 1024 * 1024;
+		m_akCacheGroup[i].dwHitCount = 0;
+		m_akCacheGroup[i].dwEvictCount = 0;
+	}
+
+	//  бⰡ 峢  ʰ Ǿ ٽ Ҵ. 0 ̸ ھ ŭ.
+	ms_loadingThread.Create(0);
 }
 
 CResourceManager::~CResourceManager()
 {
+	ms_loadingThread.Shutdown();
 	Destroy();
-	//ms_loadingThread.Shutdown();
 }
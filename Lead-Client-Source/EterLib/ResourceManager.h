@@ -5,6 +5,7 @@
 
 #include <set>
 #include <map>
+#include <list>
 #include <string>
 
 class CResourceManager : public CSingleton<CResourceManager>
@@ -37,10 +38,16 @@ class CResourceManager : public CSingleton<CResourceManager>
 
 		void		Update();
 		void		ReserveDeletingResource(CResource * pResource);
+		void		RestoreDeletingResource(CResource * pResource);
+
+		//   ҽ   ũ  ִٰ  ͺ Ǭ.
+		void		SetCacheBudget(int iGroup, DWORD dwBytes);
+		void		GetInfo(std::string * pstInfo);
 
 	public:
 		void		ProcessBackgroundLoading();
 		void		PushBackgroundLoadingSet(std::set<std::string> & LoadingSet);
+		void		RequestBackgroundLoading(const char * c_szFileName);	//   ״ ΰ ϳ Ѵ
 
 	protected:
 		void		__DestroyDeletingResourceMap();
@@ -53,7 +60,25 @@ class CResourceManager : public CSingleton<CResourceManager>
 		typedef std::map<DWORD,	CResource *>									TResourcePointerMap;
 		typedef std::map<std::string, CResource* (*)(const char*)>				TResourceNewFunctionPointerMap;
 		typedef std::map<int, CResource* (*)(const char*)>						TResourceNewFunctionByTypePointerMap;
-		typedef std::map<CResource *, DWORD>									TResourceDeletingMap;
+		typedef std::list<CResource *>											TResourceLRUList;
+
+		typedef struct SDeletingInfo
+		{
+			int							iGroup;
+			DWORD						dwSize;
+			TResourceLRUList::iterator	itLRU;
+		} TDeletingInfo;
+
+		typedef std::map<CResource *, TDeletingInfo>							TResourceDeletingMap;
+
+		typedef struct SCacheGroup
+		{
+			TResourceLRUList	kLRUList;		//  ֱٿ  
+			DWORD				dwUsedSize;
+			DWORD				dwBudget;
+			DWORD				dwHitCount;
+			DWORD				dwEvictCount;
+		} TCacheGroup;
 		typedef std::map<DWORD, std::string>									TResourceRequestMap;
 		typedef std::map<long, CResource*>										TResourceRefDecreaseWaitingMap;
 
@@ -66,6 +91,7 @@ class CResourceManager : public CSingleton<CResourceManager>
 		TResourceRequestMap						m_RequestMap;	//  ε û Ʈ
 		TResourceRequestMap						m_WaitingMap;
 		TResourceRefDecreaseWaitingMap			m_pResRefDecreaseWaitingMap;
+		TCacheGroup								m_akCacheGroup[CResource::CACHE_GROUP_NUM];
 
 		static CFileLoaderThread				ms_loadingThread;
 };
@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "StateManager.h"
+#include "GrpTextureStreamer.h"
 
 //#define StateManager_Assert(a) if (!(a)) puts("assert"#a)
 #define StateManager_Assert(a) assert(a)
@@ -482,6 +483,10 @@ void CStateManager::RestoreTexture(DWORD dwStage)
 
 void CStateManager::SetTexture(DWORD dwStage, LPDIRECT3DBASETEXTURE9 pTexture)
 {
+	//  ؽ ׸ Ÿ ٸ  Ƿ ɷ  ˸
+	if (CGraphicTextureStreamer::InstancePtr())
+		CGraphicTextureStreamer::Instance().NotifyUse(pTexture);
+
 	if (pTexture == m_CurrentState.m_Textures[dwStage])
 		return;
 
@@ -803,19 +808,25 @@ void CStateManager::RestoreStreamSource(UINT StreamNumber)
 {
 	SetStreamSource(StreamNumber,
 					m_CopyState.m_StreamData[StreamNumber].m_lpStreamData,
-					m_CopyState.m_StreamData[StreamNumber].m_Stride);
+					m_CopyState.m_StreamData[StreamNumber].m_Stride,
+					m_CopyState.m_StreamData[StreamNumber].m_OffsetInBytes);
 }
 
-void CStateManager::SetStreamSource(UINT StreamNumber, LPDIRECT3DVERTEXBUFFER9 pStreamData, UINT Stride)
+void CStateManager::SetStreamSource(UINT StreamNumber, LPDIRECT3DVERTEXBUFFER9 pStreamData, UINT Stride, UINT OffsetInBytes)
 {
-	CStreamData kStreamData(pStreamData, Stride);
+	CStreamData kStreamData(pStreamData, Stride, OffsetInBytes);
 	if (m_CurrentState.m_StreamData[StreamNumber] == kStreamData)
 		return;
 
-	m_lpD3DDev->SetStreamSource(StreamNumber, pStreamData, 0, Stride);
+	m_lpD3DDev->SetStreamSource(StreamNumber, pStreamData, OffsetInBytes, Stride);
 	m_CurrentState.m_StreamData[StreamNumber] = kStreamData;
 }
 
+void CStateManager::SetStreamSourceFreq(UINT StreamNumber, UINT Setting)
+{
+	m_lpD3DDev->SetStreamSourceFreq(StreamNumber, Setting);
+}
+
 void CStateManager::SaveIndices(LPDIRECT3DINDEXBUFFER9 pIndexData, UINT BaseVertexIndex)
 {
 	m_CopyState.m_IndexData = m_CurrentState.m_IndexData;
@@ -67,17 +67,18 @@ static const DWORD STATEMANAGER_MAX_STREAMS = 16;
 class CStreamData
 {
 	public:
-		CStreamData(LPDIRECT3DVERTEXBUFFER9 pStreamData = NULL, UINT Stride = 0) : m_lpStreamData(pStreamData), m_Stride(Stride)
+		CStreamData(LPDIRECT3DVERTEXBUFFER9 pStreamData = NULL, UINT Stride = 0, UINT OffsetInBytes = 0) : m_lpStreamData(pStreamData), m_Stride(Stride), m_OffsetInBytes(OffsetInBytes)
 		{
 		}
 
 		bool operator == (const CStreamData& rhs) const
 		{
-			return ((m_lpStreamData == rhs.m_lpStreamData) && (m_Stride == rhs.m_Stride));
+			return ((m_lpStreamData == rhs.m_lpStreamData) && (m_Stride == rhs.m_Stride) && (m_OffsetInBytes == rhs.m_OffsetInBytes));
 		}
 
 		LPDIRECT3DVERTEXBUFFER9	m_lpStreamData;
 		UINT					m_Stride;
+		UINT					m_OffsetInBytes;
 };
 
 class CIndexData
@@ -330,7 +331,8 @@ class CStateManager : public CSingleton<CStateManager>
 
 		void SaveStreamSource(UINT StreamNumber, LPDIRECT3DVERTEXBUFFER9 pStreamData, UINT Stride);
 		void RestoreStreamSource(UINT StreamNumber);
-		void SetStreamSource(UINT StreamNumber, LPDIRECT3DVERTEXBUFFER9 pStreamData, UINT Stride);
+		void SetStreamSource(UINT StreamNumber, LPDIRECT3DVERTEXBUFFER9 pStreamData, UINT Stride, UINT OffsetInBytes = 0);
+		void SetStreamSourceFreq(UINT StreamNumber, UINT Setting);
 
 		void SaveIndices(LPDIRECT3DINDEXBUFFER9 pIndexData, UINT BaseVertexIndex);
 		void RestoreIndices();
@@ -197,7 +197,7 @@ void CMakePackLog::FlushError()
 FILE * CEterPack::ms_PackLogFile = NULL;
 #endif
 ///////////////////////////////////////////////////////////////////////////////
-CEterPack::CEterPack() : m_indexCount(0), m_indexData(NULL), m_FragmentSize(0), m_bEncrypted(false), m_bReadOnly(false), m_bDecrypedIV(false)
+CEterPack::CEterPack() : m_indexCount(0), m_indexData(NULL), m_FragmentSize(0), m_bEncrypted(false), m_bReadOnly(false), m_bDecrypedIV(false), m_bIndexLoaded(false), m_bOverwrite(false)
 {
 	m_pCSHybridCryptPolicy = new EterPackPolicy_CSHybridCrypt;
 	
@@ -215,6 +215,8 @@ void CEterPack::Destroy()
 {
 	m_bReadOnly = false;
 	m_bEncrypted = false;
+	m_bIndexLoaded = false;
+	m_bOverwrite = false;
 	m_indexCount = 0;
 	m_DataPositionMap.clear();
 
@@ -235,6 +237,27 @@ const std::string& CEterPack::GetPathName()
 }
 
 bool CEterPack::Create(CEterFileDict& rkFileDict, const char * dbname, const char* pathName, bool bReadOnly, const BYTE* iv)
+{
+	if (!Open(dbname, pathName, bReadOnly, iv))
+		return false;
+
+	RegisterIndex(rkFileDict);
+
+	if (m_bReadOnly)
+	{
+		//m_bIsDataLoaded = true;		
+		//if (!m_file.Create(m_stDataFileName.c_str(), (const void**)&m_file_data, 0, 0))
+		//	return false;
+	}
+	else
+	{
+		DecryptIndexFile();
+	}
+
+	return true;
+}
+
+bool CEterPack::Open(const char * dbname, const char* pathName, bool bReadOnly, const BYTE* iv)
 {
 	if (iv)
 	{
@@ -261,21 +284,31 @@ bool CEterPack::Create(CEterFileDict& rkFileDict, const char * dbname, const cha
 	if (!CreateDataFile())
 		return false;
 
-	bool bOverwrite = (iv != NULL);
-	__BuildIndex(rkFileDict, bOverwrite);
+	//   ŷ  ߿  ֻ ؾѴ
+	m_bOverwrite = (iv != NULL);
 
-	if (m_bReadOnly)
-	{
-		//m_bIsDataLoaded = true;		
-		//if (!m_file.Create(m_stDataFileName.c_str(), (const void**)&m_file_data, 0, 0))
-		//	return false;
-	}
-	else
+	// ε  ־ ó  ü   ģ.  ƹ͵  ʴ´.
+	m_bIndexLoaded = __LoadIndex();
+	return true;
+}
+
+void CEterPack::RegisterIndex(CEterFileDict& rkFileDict)
+{
+	if (!m_bIndexLoaded)
+		return;
+
+	TEterPackIndex * index = m_indexData;
+
+	for (int i = 0; i < m_indexCount; ++i, ++index)
 	{
-		DecryptIndexFile();
-	}
+		if (!index->filename_crc)
+			continue;
 
-	return true;
+		if (m_bOverwrite)
+			rkFileDict.UpdateItem(this, index);
+		else
+			rkFileDict.InsertItem(this, index);
+	}
 }
 
 bool CEterPack::DecryptIV(DWORD dwPanamaKey)
@@ -386,7 +419,7 @@ bool CEterPack::EncryptIndexFile()
 	return true;
 }
 
-bool CEterPack::__BuildIndex(CEterFileDict& rkFileDict, bool bOverwrite)
+bool CEterPack::__LoadIndex()
 {
 	//DWORD dwBeginTime = ELTimer_GetMSec();
 	CMappedFile file;
@@ -473,11 +506,6 @@ bool CEterPack::__BuildIndex(CEterFileDict& rkFileDict, bool bOverwrite)
 				m_FragmentSize += index->real_data_size - index->data_size;
 
 			m_DataPositionMap.insert(TDataPositionMap::value_type(index->filename_crc, index));
-
-			if (bOverwrite) //   ŷ  ߿  ֻ ؾѴ
-				rkFileDict.UpdateItem(this, index);
-			else
-				rkFileDict.InsertItem(this, index);
 		}
 	}
 
@@ -910,45 +938,34 @@ void CEterPack::GenerateMD5Hash( BYTE* pData, int nLength, IN OUT MD5_CTX& mdCon
 #endif
 bool CEterPack::Put(const char * filename, LPCVOID data, long len, BYTE packType)
 {
-	if (m_bEncrypted)
-	{
-		TraceError("EterPack::Put : Cannot put to encrypted pack (filename: %s, DB: %s)", filename, m_dbName);
-		return false;
-	}
-
-	CFileBase fileIndex;
-
-	if (!fileIndex.Create(m_indexFileName, CFileBase::FILEMODE_WRITE))
-	{
-		return false;
-	}
-
-	CFileBase fileData;
+	CLZObject zObj;
 
-	if (!fileData.Create(m_stDataFileName.c_str(), CFileBase::FILEMODE_WRITE))
-	{
+	if (!Encode(filename, data, len, packType, zObj, &data, &len))
 		return false;
-	}
 
-	TEterPackIndex * pIndex;
-	pIndex = FindIndex(filename);
+	return PutEncoded(filename, data, len, packType);
+}
 
-	CLZObject zObj;
-	std::string encryptStr;
+bool CEterPack::IsParallelEncodable(BYTE packType)
+{
+	return packType != COMPRESSED_TYPE_HYBRIDCRYPT && packType != COMPRESSED_TYPE_HYBRIDCRYPT_WITHSDB;
+}
 
+bool CEterPack::Encode(const char * filename, LPCVOID data, long len, BYTE packType, CLZObject & zObj, LPCVOID * ppvOut, long * plOut, BYTE * pbWorkMem)
+{
 	if (packType == COMPRESSED_TYPE_SECURITY || 
 		packType == COMPRESSED_TYPE_COMPRESS)
 	{
 		if (packType == COMPRESSED_TYPE_SECURITY)
 		{
-			if (!CLZO::Instance().CompressEncryptedMemory(zObj, data, len, s_adwEterPackSecurityKey))
+			if (!CLZO::Instance().CompressEncryptedMemory(zObj, data, len, s_adwEterPackSecurityKey, pbWorkMem))
 			{
 				return false;
 			}
 		}
 		else
 		{
-			if (!CLZO::Instance().CompressMemory(zObj, data, len))
+			if (!CLZO::Instance().CompressMemory(zObj, data, len, pbWorkMem))
 			{
 				return false;
 			}
@@ -979,6 +996,48 @@ bool CEterPack::Put(const char * filename, LPCVOID data, long len, BYTE packType
 		len = zObj.GetBufferSize();
 	}
 
+	*ppvOut = data;
+	*plOut = len;
+	return true;
+}
+
+bool CEterPack::Keep(const char * filename)
+{
+	TEterPackIndex * pIndex = FindIndex(filename);
+
+	if (!pIndex)
+		return false;
+
+	++m_map_indexRefCount[pIndex->id];
+
+	CMakePackLog::GetSingleton().Writef("Keep[type:%u] %s\n", pIndex->compressed_type, pIndex->filename);
+	return true;
+}
+
+bool CEterPack::PutEncoded(const char * filename, LPCVOID data, long len, BYTE packType)
+{
+	if (m_bEncrypted)
+	{
+		TraceError("EterPack::Put : Cannot put to encrypted pack (filename: %s, DB: %s)", filename, m_dbName);
+		return false;
+	}
+
+	CFileBase fileIndex;
+
+	if (!fileIndex.Create(m_indexFileName, CFileBase::FILEMODE_WRITE))
+	{
+		return false;
+	}
+
+	CFileBase fileData;
+
+	if (!fileData.Create(m_stDataFileName.c_str(), CFileBase::FILEMODE_WRITE))
+	{
+		return false;
+	}
+
+	TEterPackIndex * pIndex;
+	pIndex = FindIndex(filename);
 
 #ifdef CHECKSUM_CHECK_MD5
 	MD5_CTX context;
@@ -1197,8 +1256,10 @@ TEterPackIndex* CEterPack::NewIndex(CFileBase& file, const char* filename, long
 
 TEterPackIndex* CEterPack::FindIndex(const char * filename)
 {
-	static char tmpFilename[MAX_PATH + 1];
+	//  δ 尡  θǷ ȯ ۴ ÿ д.
+	char tmpFilename[MAX_PATH + 1];
 	strncpy(tmpFilename, filename, MAX_PATH);
+	tmpFilename[MAX_PATH] = '\0';
 	inlineConvertPackFilename(tmpFilename);
 
 	DWORD filename_crc = GetCRC32(tmpFilename, strlen(tmpFilename));
@@ -1339,10 +1400,11 @@ void CEterPack::__CreateFileNameKey_Panama(const char * filename, BYTE * key, un
 	CryptoPP::HashTransformation* hm1 = NULL;
 	CryptoPP::HashTransformation* hm2 = NULL;
 
-	static CryptoPP::Tiger tiger;
-	static CryptoPP::SHA1 sha1;
-	static CryptoPP::RIPEMD128 ripemd128;
-	static CryptoPP::Whirlpool whirlpool;
+	// ؽ ü ¸ Ƿ 帶  .
+	CryptoPP::Tiger tiger;
+	CryptoPP::SHA1 sha1;
+	CryptoPP::RIPEMD128 ripemd128;
+	CryptoPP::Whirlpool whirlpool;
 
 	switch (idx & 3)
 	{
@@ -1551,6 +1613,11 @@ void CEterFileDict::UpdateItem(CEterPack* pkPack, TEterPackIndex* pkInfo)
 	}
 }
 
+void CEterFileDict::Reserve(size_t uCount)
+{
+	m_dict.rehash((size_t) ((m_dict.size() + uCount) / m_dict.max_load_factor()) + 1);
+}
+
 CEterFileDict::Item* CEterFileDict::GetItem(DWORD dwFileNameHash, const char * c_pszFileName)
 {
 	std::pair<TDict::iterator, TDict::iterator> iter_pair = m_dict.equal_range(dwFileNameHash);
@@ -90,6 +90,9 @@ public:
 	void InsertItem(CEterPack* pkPack, TEterPackIndex* pkInfo);
 	void UpdateItem(CEterPack* pkPack, TEterPackIndex* pkInfo);
 
+	//   ̸ ˸ Ŷ      rehash  Ѵ.
+	void Reserve(size_t uCount);
+
 	Item* GetItem(DWORD dwFileNameHash, const char* c_pszFileName);
 
 	const TDict& GetDict() const
@@ -111,6 +114,12 @@ class CEterPack
 		
 		void				Destroy();
 		bool				Create(CEterFileDict& rkFileDict, const char * dbname, const char * pathName, bool bReadOnly = true, const BYTE* iv = NULL);
+
+		// Create  ѷ  . Open   Ѹ ǵ帮Ƿ  忡 ÿ ҷ ǰ,
+		// RegisterIndex  ϴ  Ƿ  忡   θ.
+		bool				Open(const char * dbname, const char * pathName, bool bReadOnly = true, const BYTE* iv = NULL);
+		void				RegisterIndex(CEterFileDict& rkFileDict);
+		long				GetIndexCount() const { return m_indexCount; }
 		bool				DecryptIV(DWORD dwPanamaKey);
 
 		const std::string&	GetPathName();
@@ -122,6 +131,17 @@ class CEterPack
 		bool				Put(const char * filename, const char * sourceFilename, BYTE packType, const std::string& strRelateMapName);
 		bool				Put(const char * filename, LPCVOID data, long len, BYTE packType);
 
+		// Put  ѷ  . Encode   ǵ帮 Ƿ  忡 ÿ ҷ ǰ
+		// (IsParallelEncodable  ŸԸ), PutEncoded  ε  Ͽ Ƿ  忡 ʴ θ.
+		bool				Encode(const char * filename, LPCVOID data, long len, BYTE packType, CLZObject & zObj, LPCVOID * ppvOut, long * plOut, BYTE * pbWorkMem = NULL);
+		bool				PutEncoded(const char * filename, LPCVOID data, long len, BYTE packType);
+
+		// ̹ ѿ ִ ׸ ٽ  ʰ ̹   ģ. ׸  false
+		bool				Keep(const char * filename);
+
+		// ̺긮 ȣ ϸ Ű å ü Ƿ  忡 
+		static bool			IsParallelEncodable(BYTE packType);
+
 		bool				Delete(const char * filename);
 
 		bool				Extract();
@@ -142,7 +162,7 @@ class CEterPack
 		EterPackPolicy_CSHybridCrypt* GetPackPolicy_HybridCrypt() const;
 
 	private:
-		bool				__BuildIndex(CEterFileDict& rkFileDict, bool bOverwirte=false);
+		bool				__LoadIndex();
 
 		bool				CreateIndexFile();
 		TEterPackIndex *	FindIndex(const char * filename);
@@ -175,6 +195,8 @@ class CEterPack
 		long					m_FragmentSize;
 		bool					m_bReadOnly;
 		bool					m_bDecrypedIV;
+		bool					m_bIndexLoaded;
+		bool					m_bOverwrite;
 
 		boost::unordered_map<DWORD, DWORD> m_map_indexRefCount;
 		TDataPositionMap		m_DataPositionMap;
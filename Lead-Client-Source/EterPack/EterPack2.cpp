@@ -0,0 +1,576 @@
+#include "StdAfx.h"
+
+#include <algorithm>
+
+#include <lz4.h>
+#include <lz4hc.h>
+#include <zstd.h>
+#include <zdict.h>
+
+#include "EterPack2.h"
+
+#include "../eterBase/Debug.h"
+#include "../eterBase/CRC32.h"
+#include "../eterBase/lzo.h"
+
+// zstd  ؽƮ 帶 ϳ   . (尡  Ǯ )
+static __declspec(thread) ZSTD_DCtx * s_pZstdDCtx = NULL;
+
+static ZSTD_DCtx * GetThreadZstdDCtx()
+{
+	if (!s_pZstdDCtx)
+		s_pZstdDCtx = ZSTD_createDCtx();
+
+	return s_pZstdDCtx;
+}
+
+CEterPack2::CEterPack2() : m_pbBase(NULL), m_dwFileSize(0), m_pHeader(NULL), m_pEntries(NULL), m_pDict(NULL)
+{
+}
+
+CEterPack2::~CEterPack2()
+{
+	Destroy();
+}
+
+void CEterPack2::Destroy()
+{
+	if (m_pDict)
+	{
+		ZSTD_freeDDict(m_pDict);
+		m_pDict = NULL;
+	}
+
+	m_file.Destroy();
+
+	m_pbBase = NULL;
+	m_dwFileSize = 0;
+	m_pHeader = NULL;
+	m_pEntries = NULL;
+}
+
+bool CEterPack2::Create(const char * c_szFileName)
+{
+	Destroy();
+
+	if (!m_file.Create(c_szFileName, (const void **) &m_pbBase, 0, 0))
+		return false;
+
+	DWORD dwFileSize = m_file.Size();
+
+	if (dwFileSize < sizeof(TEterPack2Header))
+	{
+		TraceError("CEterPack2::Create: %s is too small", c_szFileName);
+		Destroy();
+		return false;
+	}
+
+	const TEterPack2Header * c_pHeader = (const TEterPack2Header *) m_pbBase;
+
+	if (c_pHeader->dwFourCC != eterpack2::c_FourCC || c_pHeader->dwVersion != eterpack2::c_Version)
+	{
+		TraceError("CEterPack2::Create: %s is not a version %u pack", c_szFileName, eterpack2::c_Version);
+		Destroy();
+		return false;
+	}
+
+	if (c_pHeader->dwIndexOffset > dwFileSize ||
+		c_pHeader->dwEntryCount > (dwFileSize - c_pHeader->dwIndexOffset) / sizeof(TEterPack2Entry) ||
+		c_pHeader->dwDictOffset > dwFileSize ||
+		c_pHeader->dwDictSize > dwFileSize - c_pHeader->dwDictOffset ||
+		0 == c_pHeader->dwBlockSize)
+	{
+		TraceError("CEterPack2::Create: %s has a broken header", c_szFileName);
+		Destroy();
+		return false;
+	}
+
+	if (c_pHeader->dwDictSize)
+	{
+		m_pDict = ZSTD_createDDict(m_pbBase + c_pHeader->dwDictOffset, c_pHeader->dwDictSize);
+
+		if (!m_pDict)
+		{
+			TraceError("CEterPack2::Create: %s has a broken dictionary", c_szFileName);
+			Destroy();
+			return false;
+		}
+	}
+
+	m_dwFileSize = dwFileSize;
+	m_pHeader = c_pHeader;
+	m_pEntries = (const TEterPack2Entry *) (m_pbBase + c_pHeader->dwIndexOffset);
+	m_stFileName = c_szFileName;
+	return true;
+}
+
+/* Static */
+UINT64 CEterPack2::GetNameHash(const char * c_szFileName)
+{
+	// FNV-1a 64
+	UINT64 qwHash = 14695981039346656037ULL;
+
+	for (const BYTE * p = (const BYTE *) c_szFileName; *p; ++p)
+	{
+		qwHash ^= *p;
+		qwHash *= 1099511628211ULL;
+	}
+
+	return qwHash;
+}
+
+struct FEterPack2EntryHashLess
+{
+	bool operator () (const TEterPack2Entry & c_rEntry, UINT64 qwNameHash) const
+	{
+		return c_rEntry.qwNameHash < qwNameHash;
+	}
+};
+
+const TEterPack2Entry * CEterPack2::FindEntry(UINT64 qwNameHash) const
+{
+	if (!m_pHeader)
+		return NULL;
+
+	const TEterPack2Entry * c_pEnd = m_pEntries + m_pHeader->dwEntryCount;
+	const TEterPack2Entry * c_pFound = std::lower_bound(m_pEntries, c_pEnd, qwNameHash, FEterPack2EntryHashLess());
+
+	if (c_pFound == c_pEnd || c_pFound->qwNameHash != qwNameHash)
+		return NULL;
+
+	return c_pFound;
+}
+
+bool CEterPack2::__Decode(BYTE bCodec, const BYTE * c_pbSrc, DWORD dwSrcSize, BYTE * pbDest, DWORD dwDestSize) const
+{
+	switch (bCodec)
+	{
+		case PACK2_CODEC_NONE:
+			if (dwSrcSize != dwDestSize)
+				return false;
+
+			memcpy(pbDest, c_pbSrc, dwDestSize);
+			return true;
+
+		case PACK2_CODEC_LZ4:
+			return LZ4_decompress_safe((const char *) c_pbSrc, (char *) pbDest, dwSrcSize, dwDestSize) == (int) dwDestSize;
+
+		case PACK2_CODEC_ZSTD:
+			{
+				ZSTD_DCtx * pDCtx = GetThreadZstdDCtx();
+
+				if (!pDCtx)
+					return false;
+
+				size_t r = ZSTD_decompressDCtx(pDCtx, pbDest, dwDestSize, c_pbSrc, dwSrcSize);
+				return !ZSTD_isError(r) && r == dwDestSize;
+			}
+
+		case PACK2_CODEC_ZSTD_DICT:
+			{
+				ZSTD_DCtx * pDCtx = GetThreadZstdDCtx();
+
+				if (!pDCtx || !m_pDict)
+					return false;
+
+				size_t r = ZSTD_decompress_usingDDict(pDCtx, pbDest, dwDestSize, c_pbSrc, dwSrcSize, m_pDict);
+				return !ZSTD_isError(r) && r == dwDestSize;
+			}
+	}
+
+	return false;
+}
+
+bool CEterPack2::__ReadBlocks(const TEterPack2Entry * c_pEntry, DWORD dwOffset, DWORD dwSize, BYTE * pbDest) const
+{
+	if (0 == dwSize)
+		return true;
+
+	const DWORD dwBlockSize = m_pHeader->dwBlockSize;
+	const DWORD dwBlockCount = (c_pEntry->dwRealSize + dwBlockSize - 1) / dwBlockSize;
+
+	if (c_pEntry->dwStoredSize < dwBlockCount * sizeof(DWORD))
+		return false;
+
+	const DWORD * c_adwBlockEnd = (const DWORD *) (m_pbBase + c_pEntry->dwDataOffset);
+	const BYTE * c_pbBlocks = (const BYTE *) (c_adwBlockEnd + dwBlockCount);
+	const DWORD dwBlocksSize = c_pEntry->dwStoredSize - dwBlockCount * sizeof(DWORD);
+
+	const DWORD dwFirst = dwOffset / dwBlockSize;
+	const DWORD dwLast = (dwOffset + dwSize - 1) / dwBlockSize;
+
+	std::vector<BYTE> vecBlock;
+
+	for (DWORD i = dwFirst; i <= dwLast; ++i)
+	{
+		DWORD dwBegin = i ? c_adwBlockEnd[i - 1] : 0;
+		DWORD dwEnd = c_adwBlockEnd[i];
+
+		if (dwBegin > dwEnd || dwEnd > dwBlocksSize)
+			return false;
+
+		DWORD dwBlockStart = i * dwBlockSize;
+		DWORD dwRealLen = min(dwBlockSize, c_pEntry->dwRealSize - dwBlockStart);
+		DWORD dwStoredLen = dwEnd - dwBegin;
+		BYTE bCodec = dwStoredLen == dwRealLen ? (BYTE) PACK2_CODEC_NONE : c_pEntry->bCodec;
+
+		//   ʿ 
+		DWORD dwFrom = i == dwFirst ? dwOffset - dwBlockStart : 0;
+		DWORD dwTo = i == dwLast ? dwOffset + dwSize - dwBlockStart : dwRealLen;
+		BYTE * pbOut = pbDest + (dwBlockStart + dwFrom - dwOffset);
+
+		if (0 == dwFrom && dwTo == dwRealLen)
+		{
+			if (!__Decode(bCodec, c_pbBlocks + dwBegin, dwStoredLen, pbOut, dwRealLen))
+				return false;
+		}
+		else
+		{
+			vecBlock.resize(dwRealLen);
+
+			if (!__Decode(bCodec, c_pbBlocks + dwBegin, dwStoredLen, &vecBlock[0], dwRealLen))
+				return false;
+
+			memcpy(pbOut, &vecBlock[dwFrom], dwTo - dwFrom);
+		}
+	}
+
+	return true;
+}
+
+bool CEterPack2::Get(CMappedFile & rMappedFile, const TEterPack2Entry * c_pEntry, LPCVOID * pData) const
+{
+	if (!c_pEntry || c_pEntry->dwDataOffset > m_dwFileSize || c_pEntry->dwStoredSize > m_dwFileSize - c_pEntry->dwDataOffset)
+		return false;
+
+	const BYTE * c_pbData = m_pbBase + c_pEntry->dwDataOffset;
+
+	//     ״ ѱ.
+	if (!(c_pEntry->bFlags & PACK2_FLAG_BLOCKED) && c_pEntry->dwStoredSize == c_pEntry->dwRealSize)
+	{
+		rMappedFile.Link(c_pEntry->dwRealSize, c_pbData);
+		*pData = c_pbData;
+		return true;
+	}
+
+	if (0 == c_pEntry->dwRealSize)
+		return false;
+
+	CLZObject * zObj = new CLZObject;
+	zObj->AllocBuffer(c_pEntry->dwRealSize);
+
+	bool bRet;
+
+	if (c_pEntry->bFlags & PACK2_FLAG_BLOCKED)
+		bRet = __ReadBlocks(c_pEntry, 0, c_pEntry->dwRealSize, zObj->GetBuffer());
+	else
+		bRet = __Decode(c_pEntry->bCodec, c_pbData, c_pEntry->dwStoredSize, zObj->GetBuffer(), c_pEntry->dwRealSize);
+
+#ifdef _DEBUG
+	if (bRet && GetCRC32((const char *) zObj->GetBuffer(), c_pEntry->dwRealSize) != c_pEntry->dwDataCRC)
+		bRet = false;
+#endif
+
+	if (!bRet)
+	{
+		TraceError("CEterPack2::Get: cannot decode %016I64x in %s", c_pEntry->qwNameHash, m_stFileName.c_str());
+		delete zObj;
+		return false;
+	}
+
+	rMappedFile.BindLZObjectWithBufferedSize(zObj);
+	*pData = zObj->GetBuffer();
+	return true;
+}
+
+bool CEterPack2::Read(const TEterPack2Entry * c_pEntry, DWORD dwOffset, DWORD dwSize, void * pvDest) const
+{
+	if (!c_pEntry || dwOffset > c_pEntry->dwRealSize || dwSize > c_pEntry->dwRealSize - dwOffset)
+		return false;
+
+	if (c_pEntry->dwDataOffset > m_dwFileSize || c_pEntry->dwStoredSize > m_dwFileSize - c_pEntry->dwDataOffset)
+		return false;
+
+	const BYTE * c_pbData = m_pbBase + c_pEntry->dwDataOffset;
+
+	if (c_pEntry->bFlags & PACK2_FLAG_BLOCKED)
+		return __ReadBlocks(c_pEntry, dwOffset, dwSize, (BYTE *) pvDest);
+
+	if (c_pEntry->dwStoredSize == c_pEntry->dwRealSize)
+	{
+		memcpy(pvDest, c_pbData + dwOffset, dwSize);
+		return true;
+	}
+
+	//  ƴ   ° Ǯ ڸ.
+	std::vector<BYTE> vecData(c_pEntry->dwRealSize);
+
+	if (!__Decode(c_pEntry->bCodec, c_pbData, c_pEntry->dwStoredSize, &vecData[0], c_pEntry->dwRealSize))
+		return false;
+
+	memcpy(pvDest, &vecData[dwOffset], dwSize);
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////
+// CEterPack2Builder
+
+CEterPack2Builder::CEterPack2Builder()
+{
+}
+
+CEterPack2Builder::~CEterPack2Builder()
+{
+	for (size_t i = 0; i < m_vec_kFile.size(); ++i)
+		delete m_vec_kFile[i];
+}
+
+bool CEterPack2Builder::Add(const char * c_szFileName, const void * c_pvData, DWORD dwSize)
+{
+	SFile * pFile = new SFile;
+
+	pFile->qwNameHash = CEterPack2::GetNameHash(c_szFileName);
+	pFile->stFileName = c_szFileName;
+	pFile->vecData.assign((const BYTE *) c_pvData, (const BYTE *) c_pvData + dwSize);
+
+	m_vec_kFile.push_back(pFile);
+	return true;
+}
+
+bool CEterPack2Builder::__TrainDictionary(std::vector<BYTE> & rvecDict) const
+{
+	std::vector<BYTE> vecSamples;
+	std::vector<size_t> vecSampleSizes;
+
+	for (size_t i = 0; i < m_vec_kFile.size(); ++i)
+	{
+		const std::vector<BYTE> & c_rvecData = m_vec_kFile[i]->vecData;
+
+		if (c_rvecData.empty() || c_rvecData.size() >= eterpack2::c_DictFileSize)
+			continue;
+
+		vecSamples.insert(vecSamples.end(), c_rvecData.begin(), c_rvecData.end());
+		vecSampleSizes.push_back(c_rvecData.size());
+	}
+
+	//      ũ.
+	if (vecSampleSizes.size() < 64 || vecSamples.size() < eterpack2::c_DictMaxSize * 4)
+		return false;
+
+	rvecDict.resize(eterpack2::c_DictMaxSize);
+
+	size_t r = ZDICT_trainFromBuffer(&rvecDict[0], rvecDict.size(), &vecSamples[0], &vecSampleSizes[0], (unsigned) vecSampleSizes.size());
+
+	if (ZDICT_isError(r))
+	{
+		TraceError("CEterPack2Builder: dictionary training failed: %s", ZDICT_getErrorName(r));
+		rvecDict.clear();
+		return false;
+	}
+
+	rvecDict.resize(r);
+	return true;
+}
+
+bool CEterPack2Builder::__Encode(BYTE bCodec, const BYTE * c_pbSrc, DWORD dwSrcSize, std::vector<BYTE> & rvecOut, int iZstdLevel, void * pvCDict) const
+{
+	size_t r = 0;
+
+	switch (bCodec)
+	{
+		case PACK2_CODEC_LZ4:
+			{
+				rvecOut.resize(LZ4_compressBound(dwSrcSize));
+				int n = LZ4_compress_HC((const char *) c_pbSrc, (char *) &rvecOut[0], dwSrcSize, (int) rvecOut.size(), LZ4HC_CLEVEL_MAX);
+
+				if (n <= 0)
+					return false;
+
+				r = n;
+			}
+			break;
+
+		case PACK2_CODEC_ZSTD:
+			rvecOut.resize(ZSTD_compressBound(dwSrcSize));
+			r = ZSTD_compress(&rvecOut[0], rvecOut.size(), c_pbSrc, dwSrcSize, iZstdLevel);
+
+			if (ZSTD_isError(r))
+				return false;
+			break;
+
+		case PACK2_CODEC_ZSTD_DICT:
+			{
+				ZSTD_CCtx * pCCtx = ZSTD_createCCtx();
+
+				if (!pCCtx)
+					return false;
+
+				rvecOut.resize(ZSTD_compressBound(dwSrcSize));
+				r = ZSTD_compress_usingCDict(pCCtx, &rvecOut[0], rvecOut.size(), c_pbSrc, dwSrcSize, (const ZSTD_CDict *) pvCDict);
+				ZSTD_freeCCtx(pCCtx);
+
+				if (ZSTD_isError(r))
+					return false;
+			}
+			break;
+
+		default:
+			return false;
+	}
+
+	rvecOut.resize(r);
+	return true;
+}
+
+struct FEterPack2FileHashLess
+{
+	template <typename T>
+	bool operator () (const T * lhs, const T * rhs) const
+	{
+		return lhs->qwNameHash < rhs->qwNameHash;
+	}
+};
+
+bool CEterPack2Builder::Write(const char * c_szFileName, int iZstdLevel)
+{
+	std::sort(m_vec_kFile.begin(), m_vec_kFile.end(), FEterPack2FileHashLess());
+
+	for (size_t i = 1; i < m_vec_kFile.size(); ++i)
+	{
+		if (m_vec_kFile[i - 1]->qwNameHash == m_vec_kFile[i]->qwNameHash)
+		{
+			TraceError("CEterPack2Builder: name hash collision (or duplicate) %s, %s",
+					m_vec_kFile[i - 1]->stFileName.c_str(), m_vec_kFile[i]->stFileName.c_str());
+			return false;
+		}
+	}
+
+	std::vector<BYTE> vecDict;
+	ZSTD_CDict * pCDict = NULL;
+
+	if (__TrainDictionary(vecDict))
+		pCDict = ZSTD_createCDict(&vecDict[0], vecDict.size(), iZstdLevel);
+
+	FILE * fp;
+
+	if (0 != fopen_s(&fp, c_szFileName, "wb"))
+	{
+		TraceError("CEterPack2Builder: cannot open %s", c_szFileName);
+
+		if (pCDict)
+			ZSTD_freeCDict(pCDict);
+
+		return false;
+	}
+
+	TEterPack2Header kHeader;
+	memset(&kHeader, 0, sizeof(kHeader));
+	fwrite(&kHeader, sizeof(kHeader), 1, fp);
+
+	UINT64 qwPos = sizeof(kHeader);
+	std::vector<TEterPack2Entry> vecEntry(m_vec_kFile.size());
+	std::vector<BYTE> vecOut;
+	bool bRet = true;
+
+	for (size_t i = 0; i < m_vec_kFile.size() && bRet; ++i)
+	{
+		const SFile * c_pFile = m_vec_kFile[i];
+		const BYTE * c_pbSrc = c_pFile->vecData.empty() ? NULL : &c_pFile->vecData[0];
+		DWORD dwRealSize = (DWORD) c_pFile->vecData.size();
+
+		TEterPack2Entry & rEntry = vecEntry[i];
+		memset(&rEntry, 0, sizeof(rEntry));
+
+		rEntry.qwNameHash = c_pFile->qwNameHash;
+		rEntry.dwDataOffset = (DWORD) qwPos;
+		rEntry.dwRealSize = dwRealSize;
+		rEntry.dwDataCRC = GetCRC32((const char *) c_pbSrc, dwRealSize);
+		rEntry.bCodec = PACK2_CODEC_NONE;
+
+		std::vector<BYTE> vecStored;
+
+		if (dwRealSize > eterpack2::c_BlockThreshold)
+		{
+			// ū   Ǯ LZ4   Ϻθ   ְ Ѵ.
+			DWORD dwBlockCount = (dwRealSize + eterpack2::c_BlockSize - 1) / eterpack2::c_BlockSize;
+			std::vector<DWORD> vecBlockEnd(dwBlockCount);
+			std::vector<BYTE> vecBlocks;
+
+			for (DWORD b = 0; b < dwBlockCount; ++b)
+			{
+				const BYTE * c_pbBlock = c_pbSrc + b * eterpack2::c_BlockSize;
+				DWORD dwLen = min(eterpack2::c_BlockSize, dwRealSize - b * eterpack2::c_BlockSize);
+
+				if (__Encode(PACK2_CODEC_LZ4, c_pbBlock, dwLen, vecOut, iZstdLevel, NULL) && vecOut.size() < dwLen)
+					vecBlocks.insert(vecBlocks.end(), vecOut.begin(), vecOut.end());
+				else
+					vecBlocks.insert(vecBlocks.end(), c_pbBlock, c_pbBlock + dwLen);
+
+				vecBlockEnd[b] = (DWORD) vecBlocks.size();
+			}
+
+			vecStored.assign((const BYTE *) &vecBlockEnd[0], (const BYTE *) (&vecBlockEnd[0] + dwBlockCount));
+			vecStored.insert(vecStored.end(), vecBlocks.begin(), vecBlocks.end());
+
+			rEntry.bCodec = PACK2_CODEC_LZ4;
+			rEntry.bFlags = PACK2_FLAG_BLOCKED;
+		}
+		else if (dwRealSize > 0)
+		{
+			BYTE bCodec = (pCDict && dwRealSize < eterpack2::c_DictFileSize) ? (BYTE) PACK2_CODEC_ZSTD_DICT : (BYTE) PACK2_CODEC_ZSTD;
+
+			// ص   ٸ(̹  ̹, Ҹ ) ״ д.
+			if (__Encode(bCodec, c_pbSrc, dwRealSize, vecOut, iZstdLevel, pCDict) && vecOut.size() < dwRealSize - dwRealSize / 16)
+			{
+				vecStored.swap(vecOut);
+				rEntry.bCodec = bCodec;
+			}
+			else
+				vecStored.assign(c_pbSrc, c_pbSrc + dwRealSize);
+		}
+
+		rEntry.dwStoredSize = (DWORD) vecStored.size();
+
+		if (!vecStored.empty() && 1 != fwrite(&vecStored[0], vecStored.size(), 1, fp))
+			bRet = false;
+
+		qwPos += vecStored.size();
+
+		if (qwPos > 0xffffffffULL)
+		{
+			TraceError("CEterPack2Builder: %s is larger than 4GB", c_szFileName);
+			bRet = false;
+		}
+	}
+
+	if (bRet)
+	{
+		kHeader.dwFourCC = eterpack2::c_FourCC;
+		kHeader.dwVersion = eterpack2::c_Version;
+		kHeader.dwEntryCount = (DWORD) vecEntry.size();
+		kHeader.dwBlockSize = eterpack2::c_BlockSize;
+
+		kHeader.dwDictOffset = (DWORD) qwPos;
+		kHeader.dwDictSize = pCDict ? (DWORD) vecDict.size() : 0;
+
+		if (kHeader.dwDictSize)
+			fwrite(&vecDict[0], vecDict.size(), 1, fp);
+
+		kHeader.dwIndexOffset = kHeader.dwDictOffset + kHeader.dwDictSize;
+
+		if (!vecEntry.empty())
+			fwrite(&vecEntry[0], sizeof(TEterPack2Entry), vecEntry.size(), fp);
+
+		fseek(fp, 0, SEEK_SET);
+		fwrite(&kHeader, sizeof(kHeader), 1, fp);
+
+		bRet = !ferror(fp);
+	}
+
+	fclose(fp);
+
+	if (pCDict)
+		ZSTD_freeCDict(pCDict);
+
+	return bRet;
+}
@@ -0,0 +1,132 @@
+#ifndef __INC_ETERPACKLIB_ETERPACK2_H__
+#define __INC_ETERPACKLIB_ETERPACK2_H__
+
+#include <vector>
+#include <string>
+
+#include "../EterBase/MappedFile.h"
+
+// EPK2 .  ϳ(.epk2) , zstd , ĵ ε  ְ
+// ° ޸ ؼ ε ״ ̺ ŽѴ.  ̸  64Ʈ ؽø д.
+//
+//   [SEterPack2Header] [ ...] [zstd ] [SEterPack2Entry x dwEntryCount (qwNameHash )]
+//
+//  (PACK2_FLAG_BLOCKED)  ʹ   ġ ǥ(DWORD x  ,
+// ǥ ں ) dwBlockSize    ̴.  ũⰡ  ũ
+//  (Ǵ )   ̴.
+// ȣȭ Ƿ  Ÿ   ѿ .
+namespace eterpack2
+{
+	const DWORD	c_FourCC = MAKEFOURCC('E', 'P', 'K', '2');
+	const DWORD	c_Version = 1;
+
+	const DWORD	c_BlockSize = 256 * 1024;			//   
+	const DWORD	c_BlockThreshold = 1024 * 1024;		// ̺ ū   
+	const DWORD	c_DictFileSize = 16 * 1024;			// ̺     
+	const DWORD	c_DictMaxSize = 112 * 1024;
+};
+
+enum EEterPack2Codec
+{
+	PACK2_CODEC_NONE,
+	PACK2_CODEC_LZ4,
+	PACK2_CODEC_ZSTD,
+	PACK2_CODEC_ZSTD_DICT,
+};
+
+enum EEterPack2Flag
+{
+	PACK2_FLAG_BLOCKED = (1 << 0),
+};
+
+#pragma pack(push, 4)
+typedef struct SEterPack2Header
+{
+	DWORD	dwFourCC;
+	DWORD	dwVersion;
+	DWORD	dwEntryCount;
+	DWORD	dwIndexOffset;
+	DWORD	dwDictOffset;
+	DWORD	dwDictSize;
+	DWORD	dwBlockSize;
+	DWORD	dwReserved;
+} TEterPack2Header;
+
+typedef struct SEterPack2Entry
+{
+	UINT64	qwNameHash;
+	DWORD	dwDataOffset;
+	DWORD	dwStoredSize;
+	DWORD	dwRealSize;
+	DWORD	dwDataCRC;		//   CRC32
+	BYTE	bCodec;
+	BYTE	bFlags;
+	WORD	wReserved;
+} TEterPack2Entry;
+#pragma pack(pop)
+
+struct ZSTD_DDict_s;
+
+class CEterPack2
+{
+	public:
+		CEterPack2();
+		virtual ~CEterPack2();
+
+		bool					Create(const char * c_szFileName);
+		void					Destroy();
+
+		// c_szFileName  CEterPackManager::ConvertFileName  ģ ̸ (ҹ, '/')
+		static UINT64			GetNameHash(const char * c_szFileName);
+
+		const TEterPack2Entry *	FindEntry(UINT64 qwNameHash) const;
+
+		bool					Get(CMappedFile & rMappedFile, const TEterPack2Entry * c_pEntry, LPCVOID * pData) const;
+		//    ʿ  Ǭ.
+		bool					Read(const TEterPack2Entry * c_pEntry, DWORD dwOffset, DWORD dwSize, void * pvDest) const;
+
+		const std::string &		GetFileName() const		{ return m_stFileName; }
+		DWORD					GetEntryCount() const	{ return m_pHeader ? m_pHeader->dwEntryCount : 0; }
+
+	private:
+		bool					__Decode(BYTE bCodec, const BYTE * c_pbSrc, DWORD dwSrcSize, BYTE * pbDest, DWORD dwDestSize) const;
+		bool					__ReadBlocks(const TEterPack2Entry * c_pEntry, DWORD dwOffset, DWORD dwSize, BYTE * pbDest) const;
+
+	private:
+		CMappedFile					m_file;
+		const BYTE *				m_pbBase;
+		DWORD						m_dwFileSize;
+		const TEterPack2Header *	m_pHeader;
+		const TEterPack2Entry *		m_pEntries;
+		ZSTD_DDict_s *				m_pDict;		// б ̶   
+		std::string					m_stFileName;
+};
+
+// Metin2PackMaker  .
+class CEterPack2Builder
+{
+	public:
+		CEterPack2Builder();
+		~CEterPack2Builder();
+
+		// c_szFileName  ѿ ã   ̸
+		bool	Add(const char * c_szFileName, const void * c_pvData, DWORD dwSize);
+		bool	Write(const char * c_szFileName, int iZstdLevel = 19);
+
+		size_t	GetCount() const	{ return m_vec_kFile.size(); }
+
+	private:
+		struct SFile
+		{
+			UINT64				qwNameHash;
+			std::string			stFileName;
+			std::vector<BYTE>	vecData;
+		};
+
+		bool	__TrainDictionary(std::vector<BYTE> & rvecDict) const;
+		bool	__Encode(BYTE bCodec, const BYTE * c_pbSrc, DWORD dwSrcSize, std::vector<BYTE> & rvecOut, int iZstdLevel, void * pvCDict) const;
+
+		std::vector<SFile *>	m_vec_kFile;
+};
+
+#endif
@@ -2,6 +2,7 @@
 
 #include <io.h>
 #include <assert.h>
+#include <process.h>
 
 #include "EterPackManager.h"
 #include "EterPackPolicy_CSHybridCrypt.h"
@@ -12,6 +13,21 @@
 #define PATH_ABSOLUTE_YMIRWORK1	"d:/ymir work/"
 #define PATH_ABSOLUTE_YMIRWORK2	"d:\\ymir work\\"
 
+struct FinderLock
+{
+	FinderLock(CRITICAL_SECTION& cs) : p_cs(&cs)
+	{
+		EnterCriticalSection(p_cs);
+	}
+
+	~FinderLock()
+	{
+		LeaveCriticalSection(p_cs);
+	}
+
+	CRITICAL_SECTION* p_cs;
+};
+
 CEterPack* CEterPackManager::FindPack(const char* c_szPathName)
 {
 	std::string strFileName;
@@ -70,6 +86,31 @@ int CEterPackManager::ConvertFileName(const char * c_szFileName, std::string & r
 	return iCount;
 }
 
+int CEterPackManager::ConvertFileName(const char * c_szFileName, char * szFileName, size_t uBufSize)
+{
+	int iCount = 0;
+	size_t i = 0;
+
+	for (; c_szFileName[i]; ++i)
+	{
+		if (i + 1 >= uBufSize)
+			return -1;
+
+		char c = korean_tolower(c_szFileName[i]);
+
+		if (c == '\\')
+			c = '/';
+
+		if (c == '/')
+			++iCount;
+
+		szFileName[i] = c;
+	}
+
+	szFileName[i] = '\0';
+	return iCount;
+}
+
 bool CEterPackManager::CompareName(const char * c_szDirectoryName, DWORD /*dwLength*/, const char * c_szFileName)
 {
 	const char * c_pszSrc = c_szDirectoryName;
@@ -100,10 +141,14 @@ void CEterPackManager::LoadStaticCache(const char* c_szFileName)
 	
 	DWORD dwFileNameHash = GetCRC32(strFileName.c_str(), strFileName.length());
 
-	boost::unordered_map<DWORD, SCache>::iterator f = m_kMap_dwNameKey_kCache.find(dwFileNameHash);
-	if (m_kMap_dwNameKey_kCache.end() != f)
-		return;	
+	{
+		FinderLock lock(m_csCache);
+
+		if (__FindCache(dwFileNameHash))
+			return;
+	}
 	
+	// д   ʴ´.   ٸ 尡  ־ .
 	CMappedFile kMapFile;
 	const void* c_pvData;
 	if (!Get(kMapFile, c_szFileName, &c_pvData))
@@ -113,7 +158,11 @@ void CEterPackManager::LoadStaticCache(const char* c_szFileName)
 	kNewCache.m_dwBufSize = kMapFile.Size();
 	kNewCache.m_abBufData = new BYTE[kNewCache.m_dwBufSize];
 	memcpy(kNewCache.m_abBufData, c_pvData, kNewCache.m_dwBufSize);
-	m_kMap_dwNameKey_kCache.insert(boost::unordered_map<DWORD, SCache>::value_type(dwFileNameHash, kNewCache));
+
+	FinderLock lock(m_csCache);
+
+	if (!m_kMap_dwNameKey_kCache.insert(boost::unordered_map<DWORD, SCache>::value_type(dwFileNameHash, kNewCache)).second)
+		delete [] kNewCache.m_abBufData;
 }
 
 CEterPackManager::SCache* CEterPackManager::__FindCache(DWORD dwFileNameHash)
@@ -173,59 +222,109 @@ bool CEterPackManager::Get(CMappedFile & rMappedFile, const char * c_szFileName,
 	return GetFromFile(rMappedFile, c_szFileName, pData);
 }
 
-struct FinderLock
+bool CEterPackManager::GetFromPack(CMappedFile & rMappedFile, const char * c_szFileName, LPCVOID * pData)
 {
-	FinderLock(CRITICAL_SECTION& cs) : p_cs(&cs)
-	{
-		EnterCriticalSection(p_cs);
-	}
+	// δ   尡  θ. ̸ ۴ ȣ⸶  ,
+	//   m_FileDict   ε  ʰ д´. ״  ĳû̴.
+	char szFileName[MAX_PATH + 1];
+	int iSlashCount = ConvertFileName(c_szFileName, szFileName, sizeof(szFileName));
 
-	~FinderLock()
+	if (iSlashCount < 0)
 	{
-		LeaveCriticalSection(p_cs);
+		TraceError("CEterPackManager::GetFromPack: too long file name [%s]", c_szFileName);
+		return false;
 	}
-
-	CRITICAL_SECTION* p_cs;
-};
-
-bool CEterPackManager::GetFromPack(CMappedFile & rMappedFile, const char * c_szFileName, LPCVOID * pData)
-{
-	FinderLock lock(m_csFinder);
-
-	static std::string strFileName;
 	
-	if (0 == ConvertFileName(c_szFileName, strFileName))
+	if (0 == iSlashCount)
 	{
-		return m_RootPack.Get(rMappedFile, strFileName.c_str(), pData);
+		return m_RootPack.Get(rMappedFile, szFileName, pData);
 	}
 	else
 	{
-		DWORD dwFileNameHash = GetCRC32(strFileName.c_str(), strFileName.length());
-		SCache* pkCache = __FindCache(dwFileNameHash);
+		DWORD dwFileNameHash = GetCRC32(szFileName, strlen(szFileName));
 
-		if (pkCache)
+		if (m_isCacheMode)
 		{
-			rMappedFile.Link(pkCache->m_dwBufSize, pkCache->m_abBufData);
-			return true;
+			FinderLock lock(m_csCache);
+			SCache* pkCache = __FindCache(dwFileNameHash);
+
+			if (pkCache)
+			{
+				rMappedFile.Link(pkCache->m_dwBufSize, pkCache->m_abBufData);
+				return true;
+			}
 		}
 
-		CEterFileDict::Item* pkFileItem = m_FileDict.GetItem(dwFileNameHash, strFileName.c_str());
+		CEterPack2 * pPack2;
+		const TEterPack2Entry * c_pEntry2 = __FindPack2Entry(szFileName, &pPack2);
+
+		if (c_pEntry2)
+			return pPack2->Get(rMappedFile, c_pEntry2, pData);
+
+		CEterFileDict::Item* pkFileItem = m_FileDict.GetItem(dwFileNameHash, szFileName);
 
 		if (pkFileItem)
 			if (pkFileItem->pkPack)
 			{
-				bool r = pkFileItem->pkPack->Get2(rMappedFile, strFileName.c_str(), pkFileItem->pkInfo, pData);	
+				bool r = pkFileItem->pkPack->Get2(rMappedFile, szFileName, pkFileItem->pkInfo, pData);	
 				//pkFileItem->pkPack->ClearDataMemoryMap();
 				return r;
 			}
 	}
 #ifdef _DEBUG
-	TraceError("CANNOT_FIND_PACK_FILE [%s]", strFileName.c_str());
+	TraceError("CANNOT_FIND_PACK_FILE [%s]", szFileName);
 #endif
 
 	return false;
 }
 
+const TEterPack2Entry * CEterPackManager::__FindPack2Entry(const char * c_szConvertedFileName, CEterPack2 ** ppPack)
+{
+	if (m_Pack2Vector.empty())
+		return NULL;
+
+	UINT64 qwNameHash = CEterPack2::GetNameHash(c_szConvertedFileName);
+
+	for (TEterPack2Vector::reverse_iterator itor = m_Pack2Vector.rbegin(); itor != m_Pack2Vector.rend(); ++itor)
+	{
+		const TEterPack2Entry * c_pEntry = (*itor)->FindEntry(qwNameHash);
+
+		if (c_pEntry)
+		{
+			*ppPack = *itor;
+			return c_pEntry;
+		}
+	}
+
+	return NULL;
+}
+
+bool CEterPackManager::ReadPackRange(const char * c_szFileName, DWORD dwOffset, DWORD dwSize, void * pvDest)
+{
+	char szFileName[MAX_PATH + 1];
+
+	if (ConvertFileName(c_szFileName, szFileName, sizeof(szFileName)) < 0)
+		return false;
+
+	CEterPack2 * pPack2;
+	const TEterPack2Entry * c_pEntry2 = __FindPack2Entry(szFileName, &pPack2);
+
+	if (c_pEntry2)
+		return pPack2->Read(c_pEntry2, dwOffset, dwSize, pvDest);
+
+	CMappedFile kMappedFile;
+	LPCVOID pvData;
+
+	if (!Get(kMappedFile, c_szFileName, &pvData))
+		return false;
+
+	if (dwOffset > kMappedFile.Size() || dwSize > kMappedFile.Size() - dwOffset)
+		return false;
+
+	memcpy(pvDest, (const BYTE *) pvData + dwOffset, dwSize);
+	return true;
+}
+
 const time_t g_tCachingInterval = 10; // 10
 void CEterPackManager::ArrangeMemoryMappedPack()
 {
@@ -281,6 +380,11 @@ bool CEterPackManager::isExistInPack(const char * c_szFileName)
 	}
 	else
 	{
+		CEterPack2 * pPack2;
+
+		if (__FindPack2Entry(strFileName.c_str(), &pPack2))
+			return true;
+
 		DWORD dwFileNameHash = GetCRC32(strFileName.c_str(), strFileName.length());
 		CEterFileDict::Item* pkFileItem = m_FileDict.GetItem(dwFileNameHash, strFileName.c_str());
 
@@ -351,8 +455,35 @@ bool CEterPackManager::RegisterPackWhenPackMaking(const char * c_szName, const c
 }
 
 
+bool CEterPackManager::__RegisterPack2(const char * c_szName)
+{
+	if (m_Pack2Map.end() != m_Pack2Map.find(c_szName))
+		return true;
+
+	std::string stFileName(c_szName);
+	stFileName += ".epk2";
+
+	if (_access(stFileName.c_str(), 0) != 0)
+		return false;
+
+	CEterPack2 * pPack2 = new CEterPack2;
+
+	if (!pPack2->Create(stFileName.c_str()))
+	{
+		delete pPack2;
+		return false;
+	}
+
+	m_Pack2Map.insert(TEterPack2Map::value_type(c_szName, pPack2));
+	m_Pack2Vector.push_back(pPack2);
+	return true;
+}
+
 bool CEterPackManager::RegisterPack(const char * c_szName, const char * c_szDirectory, const BYTE* c_pbIV)
 {
+	//  ̸ .epk2    ã, ű  ( Ÿ )   ѿ ã´.
+	bool bPack2 = __RegisterPack2(c_szName);
+
 	CEterPack * pEterPack = NULL;
 	{
 		TEterPackMap::iterator itor = m_PackMap.find(c_szName);
@@ -373,7 +504,7 @@ bool CEterPackManager::RegisterPack(const char * c_szName, const char * c_szDire
 #endif
 				delete pEterPack;
 				pEterPack = NULL;
-				return false;
+				return bPack2;
 			}
 		}
 		else
@@ -382,6 +513,12 @@ bool CEterPackManager::RegisterPack(const char * c_szName, const char * c_szDire
 		}		
 	}
 
+	__AttachPackDirectory(pEterPack, c_szDirectory);
+	return true;
+}
+
+void CEterPackManager::__AttachPackDirectory(CEterPack * pEterPack, const char * c_szDirectory)
+{
 	if (c_szDirectory && c_szDirectory[0] != '*')
 	{
 		TEterPackMap::iterator itor = m_DirPackMap.find(c_szDirectory);
@@ -391,8 +528,142 @@ bool CEterPackManager::RegisterPack(const char * c_szName, const char * c_szDire
 			m_DirPackMap.insert(TEterPackMap::value_type(c_szDirectory, pEterPack));
 		}		
 	}	
+}
 
-	return true;
+struct SPackOpenJob
+{
+	struct SItem
+	{
+		CEterPack *		pkPack;		// NULL ̸ ̹ ϵưų  ʿ  ̸ ִ
+		const char *	c_szName;
+		const char *	c_szDirectory;
+		bool			isOpened;
+	};
+
+	std::vector<SItem>	kVct_kItem;
+	volatile LONG		lNext;
+};
+
+static unsigned __stdcall PackOpenThread(void * pvArg)
+{
+	SPackOpenJob * pkJob = (SPackOpenJob *) pvArg;
+
+	while (true)
+	{
+		LONG lIndex = InterlockedIncrement(&pkJob->lNext) - 1;
+
+		if (lIndex >= (LONG) pkJob->kVct_kItem.size())
+			break;
+
+		SPackOpenJob::SItem & rkItem = pkJob->kVct_kItem[lIndex];
+
+		if (rkItem.pkPack)
+			rkItem.isOpened = rkItem.pkPack->Open(rkItem.c_szName, rkItem.c_szDirectory, true);
+	}
+
+	return 0;
+}
+
+void CEterPackManager::RegisterPacks(const TPackNameVector & c_rkVct_kPackName)
+{
+	SPackOpenJob kJob;
+	kJob.kVct_kItem.resize(c_rkVct_kPackName.size());
+	kJob.lNext = 0;
+
+	boost::unordered_map<std::string, bool, stringhash> kMap_stNewName;
+	size_t uOpenCount = 0;
+
+	for (size_t i = 0; i < c_rkVct_kPackName.size(); ++i)
+	{
+		const SPackName & c_rkPackName = c_rkVct_kPackName[i];
+		SPackOpenJob::SItem & rkItem = kJob.kVct_kItem[i];
+
+		// EPK2     ã  ⼭  Ѵ.
+		__RegisterPack2(c_rkPackName.stName.c_str());
+
+		rkItem.pkPack = NULL;
+		rkItem.c_szName = c_rkPackName.stName.c_str();
+		rkItem.c_szDirectory = c_rkPackName.stDirectory.c_str();
+		rkItem.isOpened = false;
+
+		if (m_PackMap.end() != m_PackMap.find(c_rkPackName.stName))
+			continue;
+
+		if (!kMap_stNewName.insert(std::make_pair(c_rkPackName.stName, true)).second)
+			continue;
+
+		rkItem.pkPack = new CEterPack;
+		++uOpenCount;
+	}
+
+	SYSTEM_INFO kSystemInfo;
+	GetSystemInfo(&kSystemInfo);
+
+	DWORD dwThreadCount = min(kSystemInfo.dwNumberOfProcessors, (DWORD) PACK_OPEN_THREAD_MAX_NUM);
+	dwThreadCount = min(dwThreadCount, (DWORD) uOpenCount);
+
+	std::vector<HANDLE> kVct_hThread;
+
+	for (DWORD i = 1; i < dwThreadCount; ++i)
+	{
+		HANDLE hThread = (HANDLE) _beginthreadex(NULL, 0, PackOpenThread, &kJob, 0, NULL);
+
+		if (hThread)
+			kVct_hThread.push_back(hThread);
+	}
+
+	//  嵵  . 带   ȥ  .
+	PackOpenThread(&kJob);
+
+	if (!kVct_hThread.empty())
+	{
+		WaitForMultipleObjects(kVct_hThread.size(), &kVct_hThread[0], TRUE, INFINITE);
+
+		for (size_t i = 0; i < kVct_hThread.size(); ++i)
+			CloseHandle(kVct_hThread[i]);
+	}
+
+	size_t uIndexCount = 0;
+
+	for (size_t i = 0; i < kJob.kVct_kItem.size(); ++i)
+	{
+		if (kJob.kVct_kItem[i].isOpened)
+			uIndexCount += kJob.kVct_kItem[i].pkPack->GetIndexCount();
+	}
+
+	m_FileDict.Reserve(uIndexCount);
+
+	for (size_t i = 0; i < kJob.kVct_kItem.size(); ++i)
+	{
+		SPackOpenJob::SItem & rkItem = kJob.kVct_kItem[i];
+		CEterPack * pEterPack = rkItem.pkPack;
+
+		if (pEterPack)
+		{
+			if (!rkItem.isOpened)
+			{
+#ifdef _DEBUG
+				Tracef("The eterpack doesn't exist [%s]\n", rkItem.c_szName);
+#endif
+				delete pEterPack;
+				continue;
+			}
+
+			pEterPack->RegisterIndex(m_FileDict);
+			m_PackMap.insert(TEterPackMap::value_type(rkItem.c_szName, pEterPack));
+		}
+		else
+		{
+			TEterPackMap::iterator itor = m_PackMap.find(rkItem.c_szName);
+
+			if (m_PackMap.end() == itor)
+				continue;
+
+			pEterPack = itor->second;
+		}
+
+		__AttachPackDirectory(pEterPack, rkItem.c_szDirectory);
+	}
 }
 
 void CEterPackManager::SetSearchMode(bool bPackFirst)
@@ -407,7 +678,7 @@ int CEterPackManager::GetSearchMode()
 
 CEterPackManager::CEterPackManager() : m_bTryRelativePath(false), m_iSearchMode(SEARCH_FILE_FIRST), m_isCacheMode(false)
 {
-	InitializeCriticalSection(&m_csFinder);
+	InitializeCriticalSection(&m_csCache);
 }
 
 CEterPackManager::~CEterPackManager()
@@ -421,7 +692,11 @@ CEterPackManager::~CEterPackManager()
 		delete i->second;
 		i++;
 	}	
-	DeleteCriticalSection(&m_csFinder);
+
+	for (size_t j = 0; j < m_Pack2Vector.size(); ++j)
+		delete m_Pack2Vector[j];
+
+	DeleteCriticalSection(&m_csCache);
 }
 
 void CEterPackManager::RetrieveHybridCryptPackKeys(const BYTE *pStream)
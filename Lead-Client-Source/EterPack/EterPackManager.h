@@ -6,6 +6,7 @@
 #include "../eterBase/Stl.h"
 
 #include "EterPack.h"
+#include "EterPack2.h"
 
 class CEterPackManager : public CSingleton<CEterPackManager>
 {
@@ -24,6 +25,21 @@ class CEterPackManager : public CSingleton<CEterPackManager>
 
 		typedef std::list<CEterPack*> TEterPackList;
 		typedef boost::unordered_map<std::string, CEterPack*, stringhash> TEterPackMap;
+		typedef std::vector<CEterPack2*> TEterPack2Vector;
+		typedef boost::unordered_map<std::string, CEterPack2*, stringhash> TEterPack2Map;
+
+		struct SPackName
+		{
+			std::string stName;
+			std::string stDirectory;
+		};
+
+		typedef std::vector<SPackName> TPackNameVector;
+
+		enum
+		{
+			PACK_OPEN_THREAD_MAX_NUM = 4,	// ε б ũ ŸǷ ھ ŭ ÷ ҿ 
+		};
 
 	public:
 		CEterPackManager();
@@ -41,10 +57,16 @@ class CEterPackManager : public CSingleton<CEterPackManager>
 		bool GetFromPack(CMappedFile & rMappedFile, const char * c_szFileName, LPCVOID * pData);
 		bool GetFromFile(CMappedFile & rMappedFile, const char * c_szFileName, LPCVOID * pData);
 
+		// EPK2 ѿ   ū  ʿ κи Ǯ д´.  ѿ  ° о ڸ.
+		bool ReadPackRange(const char * c_szFileName, DWORD dwOffset, DWORD dwSize, void * pvDest);
+
 		bool isExist(const char * c_szFileName);
 		bool isExistInPack(const char * c_szFileName);
 
 		bool RegisterPack(const char * c_szName, const char * c_szDirectory, const BYTE* c_pbIV = NULL);		
+		// ε б ȣȭ  忡 ÿ ϰ,     Ѵ.
+		//  RegisterPack    θ Ͱ .
+		void RegisterPacks(const TPackNameVector & c_rkVct_kPackName);
 		void RegisterRootPack(const char * c_szName);
 		bool RegisterPackWhenPackMaking(const char * c_szName, const char * c_szDirectory, CEterPack* pPack);		
 
@@ -65,11 +87,16 @@ class CEterPackManager : public CSingleton<CEterPackManager>
 
 	protected:
 		int ConvertFileName(const char * c_szFileName, std::string & rstrFileName); // StringPath std::string 
+		int ConvertFileName(const char * c_szFileName, char * szFileName, size_t uBufSize); // ȣϴ   . ġ -1
 		bool CompareName(const char * c_szDirectoryName, DWORD iLength, const char * c_szFileName);
 
 		CEterPack* FindPack(const char* c_szPathName);
 
 		SCache* __FindCache(DWORD dwFileNameHash);
+
+		bool	__RegisterPack2(const char * c_szName);
+		void	__AttachPackDirectory(CEterPack * pEterPack, const char * c_szDirectory);
+		const TEterPack2Entry * __FindPack2Entry(const char * c_szConvertedFileName, CEterPack2 ** ppPack);
 		void	__ClearCacheMap();
 
 	protected:
@@ -77,13 +104,17 @@ class CEterPackManager : public CSingleton<CEterPackManager>
 		bool					m_isCacheMode;
 		int						m_iSearchMode;
 
+		//    ڿ ٲ Ƿ δ   ʰ д´.
 		CEterFileDict			m_FileDict;
 		CEterPack				m_RootPack;
 		TEterPackList			m_PackList;
 		TEterPackMap			m_PackMap;
 		TEterPackMap			m_DirPackMap;		
 
+		TEterPack2Vector		m_Pack2Vector;		//  . ߿  ͺ ã´
+		TEterPack2Map			m_Pack2Map;
+
 		boost::unordered_map<DWORD, SCache> m_kMap_dwNameKey_kCache;
 
-		CRITICAL_SECTION		m_csFinder;
+		CRITICAL_SECTION		m_csCache;			// m_kMap_dwNameKey_kCache  ȣѴ.
 };
@@ -193,6 +193,16 @@ PyObject* grpCulling(PyObject* poSelf, PyObject* poArgs)
 	return Py_BuildNone();
 }
 
+PyObject* grpEnableOcclusionCulling(PyObject* poSelf, PyObject* poArgs)
+{
+	int iEnable;
+	if (!PyTuple_GetInteger(poArgs, 0, &iEnable))
+		return Py_BuildException();
+
+	CCullingManager::Instance().EnableOcclusionCulling(iEnable ? true : false);
+	return Py_BuildNone();
+}
+
 PyObject* grpInitScreenEffect(PyObject* poSelf, PyObject* poArgs)
 {
 	CPythonGraphic::Instance().InitScreenEffect();
@@ -949,6 +959,7 @@ void initgrp()
 	{
 		{ "InitScreenEffect",			grpInitScreenEffect,			METH_VARARGS },
 		{ "Culling",					grpCulling,						METH_VARARGS },
+		{ "EnableOcclusionCulling",		grpEnableOcclusionCulling,		METH_VARARGS },
 		{ "ClearDepthBuffer",			grpClearDepthBuffer,			METH_VARARGS },
 		{ "Identity",					grpIdentity,					METH_VARARGS },
 		{ "GenerateColor",				grpGenerateColor,				METH_VARARGS },
@@ -18,7 +18,8 @@ namespace UI
 		m_bShow(false),
 		m_pParent(NULL),
 		m_dwFlag(0),
-		m_isUpdatingChildren(FALSE)
+		m_isUpdatingChildren(FALSE),
+		m_isUpdateDeferred(FALSE)
 	{			
 #ifdef _DEBUG
 		static DWORD DEBUG_dwGlobalCounter=0;
@@ -145,10 +146,17 @@ namespace UI
 		if (!IsShow())
 			return;
 
+		//  ׸   â     ̹  ׷  Ų.
+		if (CanBatchRender())
+			CGraphicImageInstance::BeginBatch();
+		else
+			CGraphicImageInstance::EndBatch();
+
 		OnRender();
 
 		if (g_bOutlineBoxEnable)
 		{
+			CGraphicImageInstance::EndBatch();
 			CPythonGraphic::Instance().SetDiffuseColor(1.0f, 1.0f, 1.0f);
 			CPythonGraphic::Instance().RenderBox2d(m_rect.left, m_rect.top, m_rect.right, m_rect.bottom);
 		}
@@ -166,9 +174,37 @@ namespace UI
 
 		static PyObject* poFuncName_OnUpdate = PyString_InternFromString("OnUpdate");
 
-		//PyCallClassMemberFunc(m_poHandler, "OnUpdate", BuildEmptyTuple());
+		CWindowManager & rkWndMgr = CWindowManager::Instance();
+
+		if (!rkWndMgr.GetUpdateBudget())
+		{
+			//PyCallClassMemberFunc(m_poHandler, "OnUpdate", BuildEmptyTuple());
+			PyCallClassMemberFunc_ByPyString(m_poHandler, poFuncName_OnUpdate, BuildEmptyTuple());
+			return;
+		}
+
+		// ̹  ð     â   ̷.
+		// ޾ ̷ Ƿ   ӿ ѹ Ҹ.
+		if (rkWndMgr.IsUpdateBudgetExceeded() && !m_isUpdateDeferred && !rkWndMgr.IsUpdateCriticalWindow(this))
+		{
+			m_isUpdateDeferred = TRUE;
+			rkWndMgr.NotifyDeferUpdate();
+			return;
+		}
+
+		m_isUpdateDeferred = FALSE;
+
+		LARGE_INTEGER liBegin, liEnd, liFrequency;
+		QueryPerformanceCounter(&liBegin);
+
 		PyCallClassMemberFunc_ByPyString(m_poHandler, poFuncName_OnUpdate, BuildEmptyTuple());
-		
+
+		QueryPerformanceCounter(&liEnd);
+		QueryPerformanceFrequency(&liFrequency);
+
+		if (liFrequency.QuadPart)
+			rkWndMgr.AddUpdateTime((DWORD) ((liEnd.QuadPart - liBegin.QuadPart) * 1000000 / liFrequency.QuadPart));
+
 	}
 
 	void CWindow::OnRender()
@@ -179,8 +215,28 @@ namespace UI
 		if (!IsShow())
 			return;
 
-		//PyCallClassMemberFunc(m_poHandler, "OnRender", BuildEmptyTuple());
-		PyCallClassMemberFunc(m_poHandler, "OnRender", BuildEmptyTuple());
+		__RunRenderEvent();
+	}
+
+	void CWindow::__RunRenderEvent()
+	{
+		if (!m_poHandler)
+			return;
+
+		static PyObject* poFuncName_OnRender = PyString_InternFromString("OnRender");
+
+		PyObject * poFunc = PyObject_GetAttr(m_poHandler, poFuncName_OnRender);	// New Reference
+
+		if (!poFunc)
+		{
+			PyErr_Clear();
+			return;
+		}
+
+		// ̽㿡  ׸  Ƿ   ̹  ׸.
+		CGraphicImageInstance::EndBatch();
+
+		PyCallClassMemberFunc(m_poHandler, poFunc, BuildEmptyTuple());
 	}
 
 	void CWindow::SetName(const char * c_szName)
@@ -1762,7 +1818,7 @@ namespace UI
 			m_pcurVisual->Render();
 		}
 
-		PyCallClassMemberFunc(m_poHandler, "OnRender", BuildEmptyTuple());
+		__RunRenderEvent();
 	}
 	void CButton::OnChangePosition()
 	{
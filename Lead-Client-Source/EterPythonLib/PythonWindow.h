@@ -159,8 +159,14 @@ namespace UI
 			/////////////////////////////////////
 
 			virtual BOOL	IsWindow() { return TRUE; }
+
+			// ⺻ UI  CGraphicImageInstance θ ׸ â ؽĺ  ׸.
+			virtual BOOL	CanBatchRender() { return FALSE; }
 			/////////////////////////////////////
 
+		protected:
+			void			__RunRenderEvent();
+
 		protected:
 			std::string			m_strName;
 
@@ -183,6 +189,8 @@ namespace UI
 
 			BOOL				m_isUpdatingChildren;
 			TWindowContainer	m_pReserveChildList;
+
+			BOOL				m_isUpdateDeferred;
 		
 #ifdef _DEBUG
 		public:
@@ -313,6 +321,8 @@ namespace UI
 			void SetHorizontalAlign(int iType);
 			void SetNumber(const char * c_szNumber);
 
+			BOOL CanBatchRender() { return TRUE; }
+
 		protected:
 			void ClearNumber();
 			void OnRender();
@@ -340,6 +350,8 @@ namespace UI
 			int GetWidth();
 			int GetHeight();
 
+			BOOL CanBatchRender() { return TRUE; }
+
 		protected:
 			virtual void OnCreateInstance();
 			virtual void OnDestroyInstance();
@@ -387,6 +399,8 @@ namespace UI
 			void SetRenderingRect(float fLeft, float fTop, float fRight, float fBottom);
 			void SetRenderingMode(int iMode);
 
+			BOOL CanBatchRender() { return FALSE; }
+
 		protected:
 			void OnCreateInstance();
 			void OnDestroyInstance();
@@ -455,6 +469,8 @@ namespace UI
 			BOOL IsDisable();
 			BOOL IsPressed();
 
+			BOOL CanBatchRender() { return TRUE; }
+
 		protected:
 			void OnUpdate();
 			void OnRender();
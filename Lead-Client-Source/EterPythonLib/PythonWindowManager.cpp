@@ -33,7 +33,12 @@ namespace UI
 		m_poMouseHandler(NULL),
 		m_iHres(0),
 		m_iVres(0),
-		m_bOnceIgnoreMouseLeftButtonUpEventFlag(FALSE)
+		m_bOnceIgnoreMouseLeftButtonUpEventFlag(FALSE),
+		m_dwUpdateBudgetUSec(0),
+		m_dwUpdateUSec(0),
+		m_dwDeferUpdateCount(0),
+		m_dwLastUpdateUSec(0),
+		m_dwLastDeferUpdateCount(0)
 	{		
 		m_pRootWindow = new CWindow(NULL);
 		m_pRootWindow->SetName("root");
@@ -624,13 +629,40 @@ namespace UI
 	void CWindowManager::Update()
 	{
 		__ClearReserveDeleteWindowList();
+
+		m_dwLastUpdateUSec = m_dwUpdateUSec;
+		m_dwLastDeferUpdateCount = m_dwDeferUpdateCount;
+		m_dwUpdateUSec = 0;
+		m_dwDeferUpdateCount = 0;
 		
 		m_pRootWindow->Update();
 	}
 
+	// Է ް ִ â ð ڶ ̷ ʴ´.
+	bool CWindowManager::IsUpdateCriticalWindow(CWindow * pWin)
+	{
+		if (pWin == m_pActiveWindow || pWin == m_pLockWindow || pWin == m_pPointWindow)
+			return true;
+
+		if (pWin == m_pLeftCaptureWindow || pWin == m_pRightCaptureWindow || pWin == m_pMiddleCaptureWindow)
+			return true;
+
+		return false;
+	}
+
+	void CWindowManager::GetInfo(std::string * pstInfo)
+	{
+		char szInfo[128];
+		_snprintf(szInfo, sizeof(szInfo), "UI: update %uus, deferred %u (budget %uus)",
+				m_dwLastUpdateUSec, m_dwLastDeferUpdateCount, m_dwUpdateBudgetUSec);
+		pstInfo->append(szInfo);
+	}
+
 	void CWindowManager::Render()
 	{
 		m_pRootWindow->Render();
+
+		CGraphicImageInstance::EndBatch();
 	}
 
 	CWindow * CWindowManager::__PickWindow(long x, long y)
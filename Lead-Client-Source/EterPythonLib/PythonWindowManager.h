@@ -110,6 +110,15 @@ namespace UI
 			void		Update();
 			void		Render();
 
+			// â OnUpdate ̽ ȣ⿡  Ӵ ð (0 ̸  )
+			void		SetUpdateBudget(DWORD dwUSec)	{ m_dwUpdateBudgetUSec = dwUSec; }
+			DWORD		GetUpdateBudget()				{ return m_dwUpdateBudgetUSec; }
+			bool		IsUpdateBudgetExceeded()		{ return m_dwUpdateBudgetUSec && m_dwUpdateUSec > m_dwUpdateBudgetUSec; }
+			bool		IsUpdateCriticalWindow(CWindow * pWin);
+			void		AddUpdateTime(DWORD dwUSec)		{ m_dwUpdateUSec += dwUSec; }
+			void		NotifyDeferUpdate()				{ ++m_dwDeferUpdateCount; }
+			void		GetInfo(std::string * pstInfo);
+
 			void		RunMouseMove(long x, long y);
 			void		RunMouseLeftButtonDown(long x, long y);
 			void		RunMouseLeftButtonUp(long x, long y);
@@ -181,6 +190,12 @@ namespace UI
 			CWindow *				m_pRootWindow;
 			TWindowContainer		m_LayerWindowList;
 			TLayerContainer			m_LayerWindowMap;
+
+			DWORD					m_dwUpdateBudgetUSec;
+			DWORD					m_dwUpdateUSec;
+			DWORD					m_dwDeferUpdateCount;
+			DWORD					m_dwLastUpdateUSec;
+			DWORD					m_dwLastDeferUpdateCount;
 	};
 
 	PyObject * BuildEmptyTuple();
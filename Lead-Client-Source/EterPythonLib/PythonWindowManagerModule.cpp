@@ -26,6 +26,16 @@ PyObject * wndMgrOnceIgnoreMouseLeftButtonUpEvent(PyObject * poSelf, PyObject *
 	return Py_BuildNone();
 }
 
+PyObject * wndMgrSetUpdateBudget(PyObject * poSelf, PyObject * poArgs)
+{
+	int iUSec;
+	if (!PyTuple_GetInteger(poArgs, 0, &iUSec))
+		return Py_BuildException();
+
+	UI::CWindowManager::Instance().SetUpdateBudget(max(0, iUSec));
+	return Py_BuildNone();
+}
+
 PyObject * wndMgrSetMouseHandler(PyObject * poSelf, PyObject * poArgs)
 {
 	PyObject * poHandler;
@@ -2311,6 +2321,7 @@ void initwndMgr()
 		{ "GetAspect",					wndMgrGetAspect,					METH_VARARGS },
 		{ "GetHyperlink",				wndMgrGetHyperlink,					METH_VARARGS },
 		{ "OnceIgnoreMouseLeftButtonUpEvent",	wndMgrOnceIgnoreMouseLeftButtonUpEvent,		METH_VARARGS },
+		{ "SetUpdateBudget",			wndMgrSetUpdateBudget,				METH_VARARGS },
 
 		// Window
 		{ "Register",					wndMgrRegister,						METH_VARARGS },
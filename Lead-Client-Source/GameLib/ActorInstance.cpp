@@ -2,6 +2,7 @@
 #include "ActorInstance.h"
 #include "AreaTerrain.h"
 #include "RaceData.h"
+#include "../EffectLib/EffectManager.h"
 #include "../SpeedTreeLib/SpeedTreeForestDirectX8.h"
 #include "../SpeedTreeLib/SpeedTreeWrapper.h"
 
@@ -67,6 +68,22 @@ void CActorInstance::SetMainInstance()
 	m_isMain=true;
 }
 
+void CActorInstance::SetPartyMember(bool isPartyMember)
+{
+	m_isPartyMember=isPartyMember;
+}
+
+UINT CActorInstance::__GetEffectPriority() const
+{
+	if (m_isMain)
+		return CEffectManager::EFFECT_PRIORITY_OWN;
+
+	if (m_isPartyMember)
+		return CEffectManager::EFFECT_PRIORITY_PARTY;
+
+	return CEffectManager::EFFECT_PRIORITY_OTHER;
+}
+
 void CActorInstance::SetParalysis(bool isParalysis)
 {
 	m_isParalysis=isParalysis;
@@ -486,6 +503,7 @@ void CActorInstance::Revive()
 	m_isStun = FALSE;
 	m_isWalking = FALSE;
 	m_isMain = FALSE;
+	m_isPartyMember = FALSE;
 	m_isResistFallen = FALSE;
 
 	__InitializeCollisionData();
@@ -830,6 +848,7 @@ void CActorInstance::__InitializeStateData()
 	m_isRealDead = FALSE;
 	m_isWalking = FALSE;
 	m_isMain = FALSE;
+	m_isPartyMember = FALSE;
 	m_isStun = FALSE;
 	m_isHiding = FALSE;
 	m_isResistFallen = FALSE;
@@ -227,6 +227,7 @@ class CActorInstance : public IActorInstance, public IFlyTargetableObject
 		void Stop(float fBlendingTime=0.15f);
 
 		void SetMainInstance();
+		void SetPartyMember(bool isPartyMember);
 
 		void SetParalysis(bool isParalysis);
 		void SetFaint(bool isFaint);
@@ -594,6 +595,7 @@ class CActorInstance : public IActorInstance, public IFlyTargetableObject
 		void __ClearAttachingEffect();
 
 		float __GetOwnerTime();
+		UINT __GetEffectPriority() const;
 		DWORD __GetOwnerVID();
 		bool __CanPushDestActor(CActorInstance& rkActorDst);
 
@@ -745,6 +747,7 @@ class CActorInstance : public IActorInstance, public IFlyTargetableObject
 		BOOL						m_isRealDead;
 		BOOL						m_isWalking;
 		BOOL						m_isMain;
+		BOOL						m_isPartyMember;
 
 		// Effect
 		DWORD						m_dwBattleHitEffectID;
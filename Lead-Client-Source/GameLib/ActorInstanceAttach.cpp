@@ -187,7 +187,7 @@ DWORD CActorInstance::AttachEffectByID(DWORD dwParentPartIndex, const char * c_p
 		D3DXMatrixIdentity(&ae.matTranslation);
 	}
 	CEffectManager& rkEftMgr=CEffectManager::Instance();
-	rkEftMgr.CreateEffectInstance(ae.dwEffectIndex, dwEffectID);
+	rkEftMgr.CreateEffectInstance(ae.dwEffectIndex, dwEffectID, __GetEffectPriority());
 
 	if (c_pszBoneName)
 	{
@@ -375,7 +375,7 @@ void CActorInstance::RefreshActorInstance()
 						ae.dwModelIndex = j;
 						ae.dwEffectIndex = CEffectManager::Instance().GetEmptyIndex();
 						ae.isAttaching = TRUE;
-						CEffectManager::Instance().CreateEffectInstance(ae.dwEffectIndex, dwCRC);
+						CEffectManager::Instance().CreateEffectInstance(ae.dwEffectIndex, dwCRC, __GetEffectPriority());
 
 						int iBoneIndex;
 						if (!FindBoneIndex(j,c_pAttachingData->strAttachingBoneName.c_str(), &iBoneIndex))
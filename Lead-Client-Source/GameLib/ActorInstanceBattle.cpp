@@ -661,13 +661,14 @@ void CActorInstance::__ProcessDataAttackSuccess(const NRaceData::TAttackData & c
 
 		CEffectManager& rkEftMgr=CEffectManager::Instance();
 		if (m_dwBattleHitEffectID)
-			rkEftMgr.CreateEffect(m_dwBattleHitEffectID, v3Pos+vec3Delta, D3DXVECTOR3(0.0f, 0.0f, 0.0f));
+			rkEftMgr.CreateEffect(m_dwBattleHitEffectID, v3Pos+vec3Delta, D3DXVECTOR3(0.0f, 0.0f, 0.0f), __GetEffectPriority());
 	}
 	else
 	{
+		//  ´ Ÿ Ʈ ڱ ĳ  
 		CEffectManager& rkEftMgr=CEffectManager::Instance();
 		if (m_dwBattleHitEffectID)
-			rkEftMgr.CreateEffect(m_dwBattleHitEffectID, vec3Effect, D3DXVECTOR3(0.0f, 0.0f, fHeight));
+			rkEftMgr.CreateEffect(m_dwBattleHitEffectID, vec3Effect, D3DXVECTOR3(0.0f, 0.0f, fHeight), max(__GetEffectPriority(), rVictim.__GetEffectPriority()));
 		if (m_dwBattleAttachEffectID)
 			rVictim.AttachEffectByID(0, NULL, m_dwBattleAttachEffectID);
 	}
@@ -109,7 +109,7 @@ void CActorInstance::ProcessMotionEventEffectEvent(const CRaceMotionData::TMotio
 
 	if (c_pEffectData->isIndependent)
 	{
-		int iIndex = CEffectManager::Instance().CreateEffect(c_pEffectData->dwEffectIndex, D3DXVECTOR3(0.0f, 0.0f, 0.0f), D3DXVECTOR3(0.0f, 0.0f, 0.0f));
+		int iIndex = CEffectManager::Instance().CreateEffect(c_pEffectData->dwEffectIndex, D3DXVECTOR3(0.0f, 0.0f, 0.0f), D3DXVECTOR3(0.0f, 0.0f, 0.0f), __GetEffectPriority());
 
 		D3DXMATRIX matLocalPosition;
 		D3DXMatrixTranslation(&matLocalPosition, c_pEffectData->v3EffectPosition.x, c_pEffectData->v3EffectPosition.y, c_pEffectData->v3EffectPosition.z);
@@ -153,7 +153,8 @@ void CActorInstance::ProcessMotionEventEffectEvent(const CRaceMotionData::TMotio
 
 				int iIndex = CEffectManager::Instance().CreateEffect(c_pEffectData->dwEffectIndex,
 														c_pEffectData->v3EffectPosition,
-														D3DXVECTOR3(0.0f, 0.0f, 0.0f));
+														D3DXVECTOR3(0.0f, 0.0f, 0.0f),
+														__GetEffectPriority());
 				CEffectManager::Instance().SelectEffectInstance(iIndex);
 				CEffectManager::Instance().SetEffectInstanceGlobalMatrix(matWorld);
 			}
@@ -181,7 +182,7 @@ void CActorInstance::ProcessMotionEventEffectToTargetEvent(const CRaceMotionData
  			rkEftMgr.DeactiveEffectInstance(m_iFishingEffectID);
 		}
 
-		m_iFishingEffectID = rkEftMgr.CreateEffect(c_pEffectToTargetData->dwEffectIndex, m_v3FishingPosition, D3DXVECTOR3(0.0f, 0.0f, 0.0f));
+		m_iFishingEffectID = rkEftMgr.CreateEffect(c_pEffectToTargetData->dwEffectIndex, m_v3FishingPosition, D3DXVECTOR3(0.0f, 0.0f, 0.0f), __GetEffectPriority());
 	}
 	else
 	{
@@ -202,7 +203,7 @@ void CActorInstance::ProcessMotionEventEffectToTargetEvent(const CRaceMotionData
 			D3DXVECTOR3 v3Position(	c_rv3FlyTarget.x + c_pEffectToTargetData->v3EffectPosition.x,
 									c_rv3FlyTarget.y + c_pEffectToTargetData->v3EffectPosition.y,
 									c_rv3FlyTarget.z + c_pEffectToTargetData->v3EffectPosition.z);
-			CEffectManager::Instance().CreateEffect(c_pEffectToTargetData->dwEffectIndex, v3Position, D3DXVECTOR3(0.0f, 0.0f, 0.0f));
+			CEffectManager::Instance().CreateEffect(c_pEffectToTargetData->dwEffectIndex, v3Position, D3DXVECTOR3(0.0f, 0.0f, 0.0f), __GetEffectPriority());
 		}
 	}
 }
@@ -9,6 +9,7 @@
 #include "MapOutdoor.h"
 
 CDynamicPool<CTerrain>		CTerrain::ms_kPool;
+bool						CTerrain::ms_bPackSplatAlpha = false;
 
 void CTerrain::DestroySystem()
 {
@@ -30,6 +31,8 @@ CTerrain::CTerrain()
 {
 	memset(&m_lpAlphaTexture, 0, sizeof(m_lpAlphaTexture));
 	memset(&m_lpMarkedTexture, 0, sizeof(m_lpMarkedTexture));
+	memset(&m_lpPackedSplatAlphaTexture, 0, sizeof(m_lpPackedSplatAlphaTexture));
+	memset(&m_awPackedSplatAlphaIndex, 0xff, sizeof(m_awPackedSplatAlphaIndex));
 	Initialize();
 }
 
@@ -557,6 +560,8 @@ void CTerrain::RAW_DeallocateSplats(bool bBGLoading)
 		rSplat.pd3dTexture = m_lpAlphaTexture[i] = NULL;
  	}
 
+	RAW_DeallocatePackedSplatAlpha();
+
 	memset(&m_TerrainSplatPatch, 0, sizeof(m_TerrainSplatPatch));
 }
 
@@ -755,6 +760,124 @@ void CTerrain::RAW_GenerateSplat(bool bBGLoading)
 			}
 		}
 	}
+
+	if (ms_bPackSplatAlpha)
+		RAW_GeneratePackedSplatAlpha();
+}
+
+LPDIRECT3DTEXTURE9 CTerrain::GetPackedSplatAlphaTexture(DWORD dwTextureNum, BYTE * pbyChannel)
+{
+	if (dwTextureNum >= MAXTERRAINTEXTURES || 0xFFFF == m_awPackedSplatAlphaIndex[dwTextureNum])
+		return NULL;
+
+	*pbyChannel = m_awPackedSplatAlphaIndex[dwTextureNum] & 3;
+	return m_lpPackedSplatAlphaTexture[m_awPackedSplatAlphaIndex[dwTextureNum] >> 2];
+}
+
+void CTerrain::RAW_DeallocatePackedSplatAlpha()
+{
+	for (DWORD i = 0; i < MAXTERRAINTEXTURES / 4; ++i)
+	{
+		if (m_lpPackedSplatAlphaTexture[i])
+		{
+			m_lpPackedSplatAlphaTexture[i]->Release();
+			m_lpPackedSplatAlphaTexture[i] = NULL;
+		}
+	}
+
+	memset(&m_awPackedSplatAlphaIndex, 0xff, sizeof(m_awPackedSplatAlphaIndex));
+}
+
+// ̹  ÷  ؽ    о A8R8G8B8  R, G, B, A äο ʷ ִ´.
+//  UV   Ƿ  ο  徿 ׸ Ͱ  .
+void CTerrain::RAW_GeneratePackedSplatAlpha()
+{
+	RAW_DeallocatePackedSplatAlpha();
+
+	// ä 0~3 = R, G, B, A  DWORD  Ʈ ġ
+	static const BYTE s_abyChannelOffset[4] = { 2, 1, 0, 3 };
+
+	std::vector<DWORD> kVct_dwTextureNum;
+
+	for (DWORD i = 1; i < GetTextureSet()->GetTextureCount(); ++i)
+	{
+		if (m_TerrainSplatPatch.Splats[i].Active && m_lpAlphaTexture[i])
+			kVct_dwTextureNum.push_back(i);
+	}
+
+	for (DWORD dwPackedNum = 0; dwPackedNum * 4 < kVct_dwTextureNum.size(); ++dwPackedNum)
+	{
+		DWORD dwLayerCount = min((DWORD) kVct_dwTextureNum.size() - dwPackedNum * 4, (DWORD) 4);
+		DWORD dwLevelCount = m_lpAlphaTexture[kVct_dwTextureNum[dwPackedNum * 4]]->GetLevelCount();
+
+		LPDIRECT3DTEXTURE9 lpPackedTexture = NULL;
+
+		if (FAILED(ms_lpd3dDevice->CreateTexture(256, 256, dwLevelCount, 0, D3DFMT_A8R8G8B8, D3DPOOL_MANAGED, &lpPackedTexture, NULL)))
+		{
+			TraceError("CTerrain::RAW_GeneratePackedSplatAlpha - CreateTexture Error");
+			RAW_DeallocatePackedSplatAlpha();
+			return;
+		}
+
+		for (DWORD dwLevel = 0; dwLevel < dwLevelCount; ++dwLevel)
+		{
+			D3DLOCKED_RECT kDstRect;
+
+			if (FAILED(lpPackedTexture->LockRect(dwLevel, &kDstRect, NULL, 0)))
+				continue;
+
+			D3DSURFACE_DESC kDstDesc;
+			lpPackedTexture->GetLevelDesc(dwLevel, &kDstDesc);
+
+			for (UINT y = 0; y < kDstDesc.Height; ++y)
+				memset((BYTE *) kDstRect.pBits + y * kDstRect.Pitch, 0, kDstDesc.Width * 4);
+
+			for (DWORD dwChannel = 0; dwChannel < dwLayerCount; ++dwChannel)
+			{
+				LPDIRECT3DTEXTURE9 lpAlphaTexture = m_lpAlphaTexture[kVct_dwTextureNum[dwPackedNum * 4 + dwChannel]];
+
+				if (dwLevel >= lpAlphaTexture->GetLevelCount())
+					continue;
+
+				D3DSURFACE_DESC kSrcDesc;
+				lpAlphaTexture->GetLevelDesc(dwLevel, &kSrcDesc);
+
+				if (kSrcDesc.Width != kDstDesc.Width || kSrcDesc.Height != kDstDesc.Height)
+					continue;
+
+				D3DLOCKED_RECT kSrcRect;
+
+				if (FAILED(lpAlphaTexture->LockRect(dwLevel, &kSrcRect, NULL, D3DLOCK_READONLY)))
+					continue;
+
+				for (UINT y = 0; y < kDstDesc.Height; ++y)
+				{
+					BYTE * pbySrc = (BYTE *) kSrcRect.pBits + y * kSrcRect.Pitch;
+					BYTE * pbyDst = (BYTE *) kDstRect.pBits + y * kDstRect.Pitch + s_abyChannelOffset[dwChannel];
+
+					if (D3DFMT_A8R8G8B8 == kSrcDesc.Format)
+					{
+						for (UINT x = 0; x < kDstDesc.Width; ++x, pbySrc += 4, pbyDst += 4)
+							*pbyDst = pbySrc[3];
+					}
+					else
+					{
+						for (UINT x = 0; x < kDstDesc.Width; ++x, pbySrc += 2, pbyDst += 4)
+							*pbyDst = (BYTE) ((*((WORD *) pbySrc) >> 12) * 17);
+					}
+				}
+
+				lpAlphaTexture->UnlockRect(dwLevel);
+			}
+
+			lpPackedTexture->UnlockRect(dwLevel);
+		}
+
+		m_lpPackedSplatAlphaTexture[dwPackedNum] = lpPackedTexture;
+
+		for (DWORD dwChannel = 0; dwChannel < dwLayerCount; ++dwChannel)
+			m_awPackedSplatAlphaIndex[kVct_dwTextureNum[dwPackedNum * 4 + dwChannel]] = (WORD) ((dwPackedNum << 2) | dwChannel);
+	}
 }
 
 LPDIRECT3DTEXTURE9 CTerrain::AddTexture32(BYTE byImageNum, BYTE * pbyImage, long lTextureWidth, long lTextureHeight)
@@ -101,6 +101,10 @@ class CTerrain : public CTerrainImpl, public CGraphicBase
 		CMapOutdoor *	GetOwner() { return m_pOwnerOutdoorMap; }
 		void			RAW_GenerateSplat(bool bBGLoading = false);
 
+		// Packed Splat Alpha
+		LPDIRECT3DTEXTURE9	GetPackedSplatAlphaTexture(DWORD dwTextureNum, BYTE * pbyChannel);
+		static void			SetPackSplatAlpha(bool bPack) { ms_bPackSplatAlpha = bPack; }
+
 	protected:
 		bool	Initialize();
 		void	RAW_AllocateSplats(bool bBGLoading = false);
@@ -111,6 +115,9 @@ class CTerrain : public CTerrainImpl, public CGraphicBase
 		void PutImage32(BYTE * pbySrc, BYTE * pbyDst, long src_pitch, long dst_pitch, long lTextureWidth, long lTextureHeight, bool bResize = false);
 		void PutImage16(BYTE * pbySrc, BYTE * pbyDst, long src_pitch, long dst_pitch, long lTextureWidth, long lTextureHeight, bool bResize = false);
 
+		void RAW_GeneratePackedSplatAlpha();
+		void RAW_DeallocatePackedSplatAlpha();
+
 	protected:
 		void CalculateNormal(long x, long y);
 
@@ -144,6 +151,10 @@ class CTerrain : public CTerrainImpl, public CGraphicBase
 		TTerrainSplatPatch		m_MarkedSplatPatch;
 		LPDIRECT3DTEXTURE9		m_lpMarkedTexture;
 
+		// ̴ ÷ÿ. Ȱ ÷  4 ARGB  忡 äκ ִ´.
+		LPDIRECT3DTEXTURE9		m_lpPackedSplatAlphaTexture[MAXTERRAINTEXTURES / 4];
+		WORD					m_awPackedSplatAlphaIndex[MAXTERRAINTEXTURES];	// (ؽ ȣ << 2) | ä,  0xFFFF
+
 	public:
 		CTerrainPatch *	GetTerrainPatchPtr(BYTE byPatchNumX, BYTE byPatchNumY);
 
@@ -157,4 +168,5 @@ class CTerrain : public CTerrainImpl, public CGraphicBase
 		static void Delete(CTerrain* pkTerrain);
 
 		static CDynamicPool<CTerrain>		ms_kPool;
+		static bool							ms_bPackSplatAlpha;
 };
@@ -79,11 +79,19 @@ CMapOutdoor::CMapOutdoor()
 
 	__SoftwareTransformPatch_Initialize();
 	__SoftwareTransformPatch_Create();
+
+	__SplatShader_Initialize();
+	__SplatShader_Create();
+
+	CCullingManager::Instance().SetOccluder(this);
 }
 
 CMapOutdoor::~CMapOutdoor()
 {
 	__SoftwareTransformPatch_Destroy();
+	__SplatShader_Destroy();
+
+	CCullingManager::Instance().SetOccluder(NULL);
 
 	// 2004.10.14.myevan.TEMP_CAreaLoaderThread
 	//ms_AreaLoaderThread.Shutdown();
@@ -191,6 +199,8 @@ bool CMapOutdoor::Initialize()
 	m_bEnablePortal = FALSE;
 
 	m_wShadowMapSize = 512;
+
+	__Prefetch_Init();
 	return true;
 }
 
@@ -967,6 +977,76 @@ float CMapOutdoor::GetTerrainHeight(float fx, float fy)
 	return pTerrain->GetHeight(lx, ly);
 }
 
+//////////////////////////////////////////////////////////////////////////
+// Occlusion
+
+//  豸   (, , )         .
+//  ʸ Ʈ ĳ͸ ɷ  ģ ̶   ˻ ʴ´.
+bool CMapOutdoor::IsOccluded(const D3DXVECTOR3 & c_rv3Eye, const D3DXVECTOR3 & c_rv3Center, float fRadius)
+{
+	const float c_fMinOcclusionDistance = 2000.0f;
+
+	D3DXVECTOR3 v3Dir = c_rv3Center - c_rv3Eye;
+	v3Dir.z = 0.0f;
+
+	float fDistance = D3DXVec3Length(&v3Dir);
+	if (fDistance < fRadius + c_fMinOcclusionDistance)
+		return false;
+
+	//    ˻ؼ Ʈ  ִ ڸ   ʰ Ѵ.
+	float fEndRatio = 1.0f - fRadius / fDistance;
+
+	D3DXVECTOR3 v3Top = c_rv3Center;
+	v3Top.z += fRadius;
+
+	if (!__Occlusion_IsSegmentUnderTerrain(c_rv3Eye, v3Top, fEndRatio))
+		return false;
+
+	D3DXVECTOR3 v3Side(-v3Dir.y, v3Dir.x, 0.0f);
+	v3Side *= fRadius / fDistance;
+
+	if (!__Occlusion_IsSegmentUnderTerrain(c_rv3Eye, v3Top + v3Side, fEndRatio))
+		return false;
+
+	if (!__Occlusion_IsSegmentUnderTerrain(c_rv3Eye, v3Top - v3Side, fEndRatio))
+		return false;
+
+	return true;
+}
+
+bool CMapOutdoor::__Occlusion_IsSegmentUnderTerrain(const D3DXVECTOR3 & c_rv3Eye, const D3DXVECTOR3 & c_rv3Target, float fEndRatio)
+{
+	const int c_iSampleCount = 12;
+	const float c_fHeightMargin = 100.0f;
+
+	for (int i = 1; i <= c_iSampleCount; ++i)
+	{
+		D3DXVECTOR3 v3Pos;
+		D3DXVec3Lerp(&v3Pos, &c_rv3Eye, &c_rv3Target, fEndRatio * i / (c_iSampleCount + 1));
+
+		long lx, ly;
+		PR_FLOAT_TO_INT(v3Pos.x, lx);
+		PR_FLOAT_TO_INT(fabs(v3Pos.y), ly);
+
+		if (lx < 0)
+			return false;
+
+		// ҷ    ʴ  .
+		BYTE byTerrainNum;
+		if (!GetTerrainNumFromCoord((WORD) (lx / CTerrainImpl::TERRAIN_XSIZE), (WORD) (ly / CTerrainImpl::TERRAIN_YSIZE), &byTerrainNum))
+			return false;
+
+		CTerrain * pTerrain;
+		if (!GetTerrainPointer(byTerrainNum, &pTerrain))
+			return false;
+
+		if (pTerrain->GetHeight(lx, ly) > v3Pos.z + c_fHeightMargin)
+			return true;
+	}
+
+	return false;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // For Grass
 float CMapOutdoor::GetHeight(float * pPos)
@@ -3,6 +3,7 @@
 #include "../eterLib/SkyBox.h"
 #include "../eterLib/LensFlare.h"
 #include "../eterLib/ScreenFilter.h"
+#include "../eterLib/CullingManager.h"
 
 #include "../PRTerrainLib/TerrainType.h"
 #include "../PRTerrainLib/TextureSet.h"
@@ -36,7 +37,7 @@ typedef std::map<const std::string, TOutdoorMapCoordinate> TOutdoorMapCoordinate
 class CTerrainPatchProxy;
 class CTerrainQuadtreeNode;
 
-class CMapOutdoor : public CMapBase
+class CMapOutdoor : public CMapBase, public ICullingOccluder
 {
 	public:
 		enum
@@ -250,6 +251,9 @@ class CMapOutdoor : public CMapBase
 		bool			GetWaterHeight(int iX, int iY, long * plWaterHeight);
 		bool			GetNormal(int ix, int iy, D3DXVECTOR3 * pv3Normal);
 
+		// ICullingOccluder
+		virtual bool	IsOccluded(const D3DXVECTOR3 & c_rv3Eye, const D3DXVECTOR3 & c_rv3Center, float fRadius);
+
 		void			RenderTerrain();
 
 		const long		GetViewRadius()			{ return m_lViewRadius;		}
@@ -576,6 +580,8 @@ class CMapOutdoor : public CMapBase
 
 		void __RenderTerrain_AppendPatch(const D3DXVECTOR3& c_rv3Center, float fDistance, long lPatchNum);
 
+		bool __Occlusion_IsSegmentUnderTerrain(const D3DXVECTOR3 & c_rv3Eye, const D3DXVECTOR3 & c_rv3Target, float fEndRatio);
+
 		void __RenderTerrain_RenderSoftwareTransformPatch();
 		void __RenderTerrain_RenderHardwareTransformPatch();
 
@@ -583,6 +589,24 @@ class CMapOutdoor : public CMapBase
 		void __HardwareTransformPatch_RenderPatchSplat(long patchnum, WORD wPrimitiveCount, D3DPRIMITIVETYPE ePrimitiveType);
 		void __HardwareTransformPatch_RenderPatchNone(long patchnum, WORD wPrimitiveCount, D3DPRIMITIVETYPE ePrimitiveType);
 
+	protected:
+		// ̴  3 ī忡 ġ ÷ ̾     ο ´.
+		enum
+		{
+			SPLAT_SHADER_MAX_LAYERS = 7,
+		};
+
+		void __SplatShader_Initialize();
+		bool __SplatShader_Create();
+		void __SplatShader_Destroy();
+		void __SplatShader_BeginRender();
+		void __SplatShader_EndRender();
+		bool __SplatShader_RenderPatch(CTerrain * pTerrain, long sPatchNum, WORD wPrimitiveCount, D3DPRIMITIVETYPE ePrimitiveType);
+		LPDIRECT3DPIXELSHADER9 __SplatShader_GetPixelShader(DWORD dwLayerCount, DWORD dwAlphaSamplerBits);
+
+		LPDIRECT3DVERTEXSHADER9					m_lpSplatVertexShader;
+		std::map<DWORD, LPDIRECT3DPIXELSHADER9>	m_kMap_lpSplatPixelShader;
+
 
 	protected:
 		struct SoftwareTransformPatch_SData
@@ -766,6 +790,28 @@ class CMapOutdoor : public CMapBase
 		void __HeightCache_Init();
 		void __HeightCache_Update();
 
+	//   ͷ/ 迡    ӿ ϳ ̸ д´.
+	private:
+		enum
+		{
+			PREFETCH_QUEUE_MAX = LOAD_SIZE_WIDTH * 4 + 1,	// 밢     
+		};
+
+		struct SPrefetch
+		{
+			D3DXVECTOR2			m_v2LastPos;
+			D3DXVECTOR2			m_v2Velocity;		// ʴ ̵ Ÿ
+			DWORD				m_dwLastTime;
+			bool				m_isStarted;
+
+			std::deque<DWORD>	m_kDeq_dwCoord;		// (x << 16) | y
+		} m_kPrefetch;
+
+		void __Prefetch_Init();
+		void __Prefetch_Update(float fX, float fY);
+		void __Prefetch_Request(WORD wCoordX, WORD wCoordY);
+		void __Prefetch_Process();
+
 	public:
 		void SetEnvironmentDataName(const std::string& strEnvironmentDataName);
 		std::string& GetEnvironmentDataName();
@@ -6,6 +6,7 @@
 
 #include "../eterlib/Camera.h"
 #include "../eterlib/StateManager.h"
+#include "../eterlib/FrameProfiler.h"
 
 
 #define MAX_RENDER_SPALT 150
@@ -264,11 +265,23 @@ void CMapOutdoor::OnRender()
 	SetInverseViewAndDynamicShaodwMatrices();
 
 	SetBlendOperation();
-	RenderArea();
-	RenderTree();
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_OBJECT);
+		RenderArea();
+	}
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_TREE);
+		RenderTree();
+	}
 	if (!m_bEnableTerrainOnlyForHeight)
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_TERRAIN);
 		RenderTerrain();
-	RenderBlendArea();
+	}
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_OBJECT);
+		RenderBlendArea();
+	}
 }
 
 struct FAreaRenderShadow
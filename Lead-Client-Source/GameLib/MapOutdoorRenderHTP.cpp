@@ -90,6 +90,10 @@ void CMapOutdoor::__RenderTerrain_RenderHardwareTransformPatch()
 
 	STATEMANAGER.SetFVF(D3DFVF_XYZ | D3DFVF_NORMAL);
 
+#ifndef WORLD_EDITOR
+	__SplatShader_BeginRender();
+#endif
+
 	m_iRenderedSplatNumSqSum = 0;
 	m_iRenderedPatchNum = 0;
 	m_iRenderedSplatNum = 0;
@@ -226,6 +230,10 @@ void CMapOutdoor::__RenderTerrain_RenderHardwareTransformPatch()
 	STATEMANAGER.SetRenderState(D3DRS_FOGENABLE, dwFogEnable);
 	STATEMANAGER.SetRenderState(D3DRS_LIGHTING, TRUE);
 
+#ifndef WORLD_EDITOR
+	__SplatShader_EndRender();
+#endif
+
 	std::sort(m_RenderedTextureNumVector.begin(),m_RenderedTextureNumVector.end());
 
 	//////////////////////////////////////////////////////////////////////////
@@ -541,8 +549,11 @@ void CMapOutdoor::__HardwareTransformPatch_RenderPatchSplat(long patchnum, WORD
 	}
 
 #else
+	// ̴ ׷ Ʒ ̾  ǳʶڴ.
+	DWORD dwFirstTextureNum = __SplatShader_RenderPatch(pTerrain, sPatchNum, wPrimitiveCount, ePrimitiveType) ? pTerrain->GetNumTextures() : 1;
+
 	bool isFirst=true;
-	for (DWORD j = 1; j < pTerrain->GetNumTextures(); ++j)
+	for (DWORD j = dwFirstTextureNum; j < pTerrain->GetNumTextures(); ++j)
 	{
 		TTerainSplat & rSplat = rTerrainSplatPatch.Splats[j];
 
@@ -691,3 +702,454 @@ void CMapOutdoor::__HardwareTransformPatch_RenderPatchNone(long patchnum, WORD w
 	STATEMANAGER.SetStreamSource(0, pkVB->GetD3DVertexBuffer(), m_iPatchTerrainVertexSize);
 	STATEMANAGER.DrawIndexedPrimitive(ePrimitiveType, 0, m_iPatchTerrainVertexCount, 0, wPrimitiveCount);
 }
+
+//////////////////////////////////////////////////////////////////////////
+// Splat Shader
+//
+//   ̾ ϳ   ׸ ̴  3 ī忡
+// CTerrain  äκ   ÷ ĸ Ἥ ̾     ´.
+// ̾ SRCALPHA/INVSRCALPHA  ׸   ̴ ȿ
+// Ƽö̵  ϰ ONE/INVSRCALPHA  Ѵ.
+
+static const char c_szSplatVertexProgram[] =
+{
+	"vs_3_0\n"
+
+	"def		c95,		1.0,		0.0,		0.0,		0.0\n"
+
+	"dcl_position	v0\n"
+
+	"dcl_position	o0\n"
+	"dcl_texcoord0	o1\n"										// ̾ 0, 1 uv
+	"dcl_texcoord1	o2\n"										// ̾ 2, 3 uv
+	"dcl_texcoord2	o3\n"										// ̾ 4, 5 uv
+	"dcl_texcoord3	o4\n"										// ̾ 6 uv
+	"dcl_texcoord4	o5.xyz\n"									// xy = ÷  uv, z = 
+
+	"mov		r0.xyz,		v0\n"
+	"mov		r0.w,		c95.x\n"
+	"m4x4		o0,			r0,			c0\n"
+
+	"dp4		o5.x,		r0,			c8\n"
+	"dp4		o5.y,		r0,			c9\n"
+
+	"dp4		o1.x,		r0,			c10\n"
+	"dp4		o1.y,		r0,			c11\n"
+	"dp4		o1.z,		r0,			c12\n"
+	"dp4		o1.w,		r0,			c13\n"
+	"dp4		o2.x,		r0,			c14\n"
+	"dp4		o2.y,		r0,			c15\n"
+	"dp4		o2.z,		r0,			c16\n"
+	"dp4		o2.w,		r0,			c17\n"
+	"dp4		o3.x,		r0,			c18\n"
+	"dp4		o3.y,		r0,			c19\n"
+	"dp4		o3.z,		r0,			c20\n"
+	"dp4		o3.w,		r0,			c21\n"
+	"dp4		o4.x,		r0,			c22\n"
+	"dp4		o4.y,		r0,			c23\n"
+	"mov		o4.zw,		c95.y\n"
+
+	"dp4		r1.x,		r0,			c4\n"					// ī޶   (D3DRS_RANGEFOGENABLE   ִ)
+	"sub		r2.x,		c5.x,		r1.x\n"					// linear
+	"mul_sat	r2.x,		r2.x,		c5.y\n"
+	"mul		r2.y,		r1.x,		c5.z\n"					// exp (density  log2(e)   )
+	"exp		r2.y,		-r2.y\n"
+	"lrp		r2.z,		c6.y,		r2.y,		r2.x\n"
+	"lrp		o5.z,		c6.x,		r2.z,		c95.x\n"
+};
+
+static LPD3DXBUFFER __SplatShader_Assemble(const char * c_szProgram, UINT uLength)
+{
+	LPD3DXBUFFER pCode = NULL;
+	LPD3DXBUFFER pError = NULL;
+
+	if (FAILED(D3DXAssembleShader(c_szProgram, uLength, NULL, NULL, 0, &pCode, &pError)))
+	{
+		TraceError("CMapOutdoor::__SplatShader_Assemble - %s", pError ? (const char *) pError->GetBufferPointer() : "unknown");
+
+		if (pError)
+			pError->Release();
+
+		return NULL;
+	}
+
+	if (pError)
+		pError->Release();
+
+	return pCode;
+}
+
+void CMapOutdoor::__SplatShader_Initialize()
+{
+	m_lpSplatVertexShader = NULL;
+	m_kMap_lpSplatPixelShader.clear();
+}
+
+bool CMapOutdoor::__SplatShader_Create()
+{
+	CTerrain::SetPackSplatAlpha(false);
+
+	if (CTerrainPatch::SOFTWARE_TRANSFORM_PATCH_ENABLE)
+		return false;
+
+	if (ms_d3dCaps.VertexShaderVersion < D3DVS_VERSION(3, 0) || ms_d3dCaps.PixelShaderVersion < D3DPS_VERSION(3, 0))
+	{
+		Tracenf("Terrain splat shader disabled: shader model 3 not supported");
+		return false;
+	}
+
+	LPD3DXBUFFER pCode = __SplatShader_Assemble(c_szSplatVertexProgram, sizeof(c_szSplatVertexProgram) - 1);
+
+	if (!pCode)
+		return false;
+
+	if (FAILED(ms_lpd3dDevice->CreateVertexShader((const DWORD *) pCode->GetBufferPointer(), &m_lpSplatVertexShader)))
+	{
+		TraceError("CMapOutdoor::__SplatShader_Create - CreateVertexShader Error");
+		m_lpSplatVertexShader = NULL;
+	}
+
+	pCode->Release();
+
+	if (!m_lpSplatVertexShader)
+		return false;
+
+	CTerrain::SetPackSplatAlpha(true);
+	return true;
+}
+
+void CMapOutdoor::__SplatShader_Destroy()
+{
+	if (m_lpSplatVertexShader)
+		m_lpSplatVertexShader->Release();
+
+	std::map<DWORD, LPDIRECT3DPIXELSHADER9>::iterator i;
+	for (i = m_kMap_lpSplatPixelShader.begin(); i != m_kMap_lpSplatPixelShader.end(); ++i)
+	{
+		if (i->second)
+			i->second->Release();
+	}
+
+	CTerrain::SetPackSplatAlpha(false);
+	__SplatShader_Initialize();
+}
+
+// dwAlphaSamplerBits  ̾ 3 Ʈ,  °   ؽĸ д ´.
+// ä  (c1~c7) ѱǷ      ̴  .
+LPDIRECT3DPIXELSHADER9 CMapOutdoor::__SplatShader_GetPixelShader(DWORD dwLayerCount, DWORD dwAlphaSamplerBits)
+{
+	DWORD dwKey = dwLayerCount | (dwAlphaSamplerBits << 3);
+
+	std::map<DWORD, LPDIRECT3DPIXELSHADER9>::iterator f = m_kMap_lpSplatPixelShader.find(dwKey);
+	if (m_kMap_lpSplatPixelShader.end() != f)
+		return f->second;
+
+	DWORD dwAlphaCount = 0;
+
+	for (DWORD i = 0; i < dwLayerCount; ++i)
+		dwAlphaCount = max(dwAlphaCount, ((dwAlphaSamplerBits >> (i * 3)) & 7) + 1);
+
+	std::string stProgram;
+	char szLine[128];
+
+	stProgram += "ps_3_0\n";
+	stProgram += "def c10, 0.0, 1.0, 0.0, 0.0\n";
+	stProgram += "dcl_texcoord0 v0\n";
+	stProgram += "dcl_texcoord1 v1\n";
+	stProgram += "dcl_texcoord2 v2\n";
+	stProgram += "dcl_texcoord3 v3\n";
+	stProgram += "dcl_texcoord4 v4.xyz\n";
+
+	for (DWORD i = 0; i < dwLayerCount + dwAlphaCount; ++i)
+	{
+		_snprintf(szLine, sizeof(szLine), "dcl_2d s%u\n", i);
+		stProgram += szLine;
+	}
+
+	stProgram += "mov r0, c10.x\n";
+	stProgram += "mov r9, v4.xyzz\n";
+
+	//   ؽĴ r11 
+	for (DWORD i = 0; i < dwAlphaCount; ++i)
+	{
+		_snprintf(szLine, sizeof(szLine), "texld r%u, r9, s%u\n", 11 + i, dwLayerCount + i);
+		stProgram += szLine;
+	}
+
+	for (DWORD i = 0; i < dwLayerCount; ++i)
+	{
+		_snprintf(szLine, sizeof(szLine), "mov r2, v%u.%s\n", i / 2, (i & 1) ? "zwzw" : "xyxy");
+		stProgram += szLine;
+		_snprintf(szLine, sizeof(szLine), "texld r1, r2, s%u\n", i);
+		stProgram += szLine;
+		_snprintf(szLine, sizeof(szLine), "dp4 r2.w, r%u, c%u\n", 11 + ((dwAlphaSamplerBits >> (i * 3)) & 7), 1 + i);
+		stProgram += szLine;
+
+		// ġ ù ̾  ó  ؽ ĸ . (c0.w = 1)
+		if (0 == i)
+			stProgram += "lrp r2.w, c0.w, r1.w, r2.w\n";
+
+		stProgram += "mov r1.w, c10.y\n";
+		stProgram += "lrp r0, r2.w, r1, r0\n";
+	}
+
+	// ̾ ؽ ׸    ׻  ĸ  ´.
+	stProgram += "mul r3.xyz, c0, r0.w\n";
+	stProgram += "lrp r0.xyz, v4.z, r0, r3\n";
+	stProgram += "mov oC0, r0\n";
+
+	LPDIRECT3DPIXELSHADER9 lpPixelShader = NULL;
+	LPD3DXBUFFER pCode = __SplatShader_Assemble(stProgram.c_str(), stProgram.length());
+
+	if (pCode)
+	{
+		if (FAILED(ms_lpd3dDevice->CreatePixelShader((const DWORD *) pCode->GetBufferPointer(), &lpPixelShader)))
+		{
+			TraceError("CMapOutdoor::__SplatShader_GetPixelShader - CreatePixelShader Error (layer %d)", dwLayerCount);
+			lpPixelShader = NULL;
+		}
+
+		pCode->Release();
+	}
+
+	//  յ NULL   ΰ   ׸.
+	m_kMap_lpSplatPixelShader.insert(std::map<DWORD, LPDIRECT3DPIXELSHADER9>::value_type(dwKey, lpPixelShader));
+	return lpPixelShader;
+}
+
+void CMapOutdoor::__SplatShader_BeginRender()
+{
+	if (!m_lpSplatVertexShader)
+		return;
+
+	// STATEMANAGER  ϴ  .
+	for (DWORD dwStage = 2; dwStage < STATEMANAGER_MAX_STAGES; ++dwStage)
+	{
+		DWORD dwMinFilter, dwMagFilter, dwMipFilter;
+		STATEMANAGER.GetSamplerState(dwStage, D3DSAMP_MINFILTER, &dwMinFilter);
+		STATEMANAGER.GetSamplerState(dwStage, D3DSAMP_MAGFILTER, &dwMagFilter);
+		STATEMANAGER.GetSamplerState(dwStage, D3DSAMP_MIPFILTER, &dwMipFilter);
+
+		STATEMANAGER.SaveSamplerState(dwStage, D3DSAMP_ADDRESSU, D3DTADDRESS_WRAP);
+		STATEMANAGER.SaveSamplerState(dwStage, D3DSAMP_ADDRESSV, D3DTADDRESS_WRAP);
+		STATEMANAGER.SaveSamplerState(dwStage, D3DSAMP_MINFILTER, dwMinFilter);
+		STATEMANAGER.SaveSamplerState(dwStage, D3DSAMP_MAGFILTER, dwMagFilter);
+		STATEMANAGER.SaveSamplerState(dwStage, D3DSAMP_MIPFILTER, dwMipFilter);
+		STATEMANAGER.SetBestFiltering(dwStage);
+	}
+
+	//   ̹Ƿ  * Ǹ ѱ.
+	D3DXMATRIX matView, matProj, matViewProj;
+	STATEMANAGER.GetTransform(D3DTS_VIEW, &matView);
+	STATEMANAGER.GetTransform(D3DTS_PROJECTION, &matProj);
+	D3DXMatrixMultiply(&matViewProj, &matView, &matProj);
+	D3DXMatrixTranspose(&matViewProj, &matViewProj);
+
+	float afViewZ[4] = { matView._13, matView._23, matView._33, matView._43 };
+
+	STATEMANAGER.SetVertexShaderConstant(0, &matViewProj, 4);
+	STATEMANAGER.SetVertexShaderConstant(4, afViewZ, 1);
+}
+
+void CMapOutdoor::__SplatShader_EndRender()
+{
+	if (!m_lpSplatVertexShader)
+		return;
+
+	for (DWORD dwStage = 2; dwStage < STATEMANAGER_MAX_STAGES; ++dwStage)
+	{
+		STATEMANAGER.SetTexture(dwStage, NULL);
+
+		STATEMANAGER.RestoreSamplerState(dwStage, D3DSAMP_ADDRESSU);
+		STATEMANAGER.RestoreSamplerState(dwStage, D3DSAMP_ADDRESSV);
+		STATEMANAGER.RestoreSamplerState(dwStage, D3DSAMP_MINFILTER);
+		STATEMANAGER.RestoreSamplerState(dwStage, D3DSAMP_MAGFILTER);
+		STATEMANAGER.RestoreSamplerState(dwStage, D3DSAMP_MIPFILTER);
+	}
+}
+
+//   ο  ̾ 
+struct SSplatShaderChunk
+{
+	DWORD					dwFirstLayer;
+	DWORD					dwLayerCount;
+	DWORD					dwAlphaCount;
+	LPDIRECT3DTEXTURE9		alpAlphaTexture[STATEMANAGER_MAX_STAGES];
+	LPDIRECT3DPIXELSHADER9	lpPixelShader;
+};
+
+// ׸ ϴ Ȳ(̴ , ̺/EXP2 ,  İ  ̾)̸
+// false  ְ ȣ    ̾ ׸.
+bool CMapOutdoor::__SplatShader_RenderPatch(CTerrain * pTerrain, long sPatchNum, WORD wPrimitiveCount, D3DPRIMITIVETYPE ePrimitiveType)
+{
+	if (!m_lpSplatVertexShader)
+		return false;
+
+	DWORD dwFogEnable = STATEMANAGER.GetRenderState(D3DRS_FOGENABLE);
+	DWORD dwFogMode = STATEMANAGER.GetRenderState(D3DRS_FOGVERTEXMODE);
+
+	if (dwFogEnable && (STATEMANAGER.GetRenderState(D3DRS_FOGTABLEMODE) != D3DFOG_NONE || (dwFogMode != D3DFOG_LINEAR && dwFogMode != D3DFOG_EXP && dwFogMode != D3DFOG_NONE)))
+		return false;
+
+	TTerrainSplatPatch & rTerrainSplatPatch = pTerrain->GetTerrainSplatPatch();
+
+	static std::vector<DWORD> s_kVct_dwTextureNum;
+	static std::vector<BYTE> s_kVct_byChannel;
+	static std::vector<SSplatShaderChunk> s_kVct_kChunk;
+
+	s_kVct_dwTextureNum.clear();
+	s_kVct_byChannel.clear();
+	s_kVct_kChunk.clear();
+
+	for (DWORD j = 1; j < pTerrain->GetNumTextures(); ++j)
+	{
+		if (!rTerrainSplatPatch.Splats[j].Active)
+			continue;
+
+		if (rTerrainSplatPatch.PatchTileCount[sPatchNum][j] == 0)
+			continue;
+
+		BYTE byChannel;
+		if (!pTerrain->GetPackedSplatAlphaTexture(j, &byChannel))
+			return false;
+
+		s_kVct_dwTextureNum.push_back(j);
+		s_kVct_byChannel.push_back(byChannel);
+
+		//  ΰ   ̾ ׸.
+		if (m_iRenderedSplatNum + (int) s_kVct_dwTextureNum.size() >= m_iSplatLimit)
+			break;
+	}
+
+	// ÷ s0~s(n-1)   ؽ, s(n)~   ̾    ؽ.
+	DWORD dwLayer = 0;
+	while (dwLayer < s_kVct_dwTextureNum.size())
+	{
+		SSplatShaderChunk kChunk;
+		kChunk.dwFirstLayer = dwLayer;
+		kChunk.dwLayerCount = 0;
+		kChunk.dwAlphaCount = 0;
+
+		DWORD dwAlphaSamplerBits = 0;
+
+		while (dwLayer < s_kVct_dwTextureNum.size() && kChunk.dwLayerCount < SPLAT_SHADER_MAX_LAYERS)
+		{
+			BYTE byChannel;
+			LPDIRECT3DTEXTURE9 lpAlphaTexture = pTerrain->GetPackedSplatAlphaTexture(s_kVct_dwTextureNum[dwLayer], &byChannel);
+
+			DWORD dwAlphaIndex = 0;
+			while (dwAlphaIndex < kChunk.dwAlphaCount && kChunk.alpAlphaTexture[dwAlphaIndex] != lpAlphaTexture)
+				++dwAlphaIndex;
+
+			DWORD dwNewAlphaCount = max(kChunk.dwAlphaCount, dwAlphaIndex + 1);
+
+			if (kChunk.dwLayerCount + 1 + dwNewAlphaCount > STATEMANAGER_MAX_STAGES)
+				break;
+
+			kChunk.alpAlphaTexture[dwAlphaIndex] = lpAlphaTexture;
+			kChunk.dwAlphaCount = dwNewAlphaCount;
+
+			dwAlphaSamplerBits |= dwAlphaIndex << (kChunk.dwLayerCount * 3);
+			++kChunk.dwLayerCount;
+			++dwLayer;
+		}
+
+		kChunk.lpPixelShader = __SplatShader_GetPixelShader(kChunk.dwLayerCount, dwAlphaSamplerBits);
+
+		if (!kChunk.lpPixelShader)
+			return false;
+
+		s_kVct_kChunk.push_back(kChunk);
+	}
+
+	DWORD dwFogStart = STATEMANAGER.GetRenderState(D3DRS_FOGSTART);
+	DWORD dwFogEnd = STATEMANAGER.GetRenderState(D3DRS_FOGEND);
+	DWORD dwFogDensity = STATEMANAGER.GetRenderState(D3DRS_FOGDENSITY);
+	DWORD dwFogColor = STATEMANAGER.GetRenderState(D3DRS_FOGCOLOR);
+
+	float fFogStart = *((float *) &dwFogStart);
+	float fFogEnd = *((float *) &dwFogEnd);
+	float fFogDensity = *((float *) &dwFogDensity);
+
+	float afFog[4] = { fFogEnd, fFogEnd > fFogStart ? 1.0f / (fFogEnd - fFogStart) : 0.0f, fFogDensity * 1.442695f, 0.0f };
+	float afFogMode[4] = { (dwFogEnable && dwFogMode != D3DFOG_NONE) ? 1.0f : 0.0f, dwFogMode == D3DFOG_EXP ? 1.0f : 0.0f, 0.0f, 0.0f };
+
+	D3DXMATRIX matSplatAlpha;
+	D3DXMatrixMultiply(&matSplatAlpha, &m_matWorldForCommonUse, &m_matSplatAlpha);
+
+	float afSplatAlphaUV[8] =
+	{
+		matSplatAlpha._11, matSplatAlpha._21, matSplatAlpha._31, matSplatAlpha._41,
+		matSplatAlpha._12, matSplatAlpha._22, matSplatAlpha._32, matSplatAlpha._42,
+	};
+
+	STATEMANAGER.SetVertexShaderConstant(5, afFog, 1);
+	STATEMANAGER.SetVertexShaderConstant(6, afFogMode, 1);
+	STATEMANAGER.SetVertexShaderConstant(8, afSplatAlphaUV, 2);
+
+	STATEMANAGER.SetVertexShader(m_lpSplatVertexShader);
+	STATEMANAGER.SetRenderState(D3DRS_SRCBLEND, D3DBLEND_ONE);
+
+	for (DWORD c = 0; c < s_kVct_kChunk.size(); ++c)
+	{
+		const SSplatShaderChunk & c_rkChunk = s_kVct_kChunk[c];
+
+		float afFogColor[4] =
+		{
+			((dwFogColor >> 16) & 0xff) / 255.0f,
+			((dwFogColor >> 8) & 0xff) / 255.0f,
+			(dwFogColor & 0xff) / 255.0f,
+			0 == c ? 1.0f : 0.0f,
+		};
+		STATEMANAGER.SetPixelShaderConstant(0, afFogColor, 1);
+
+		for (DWORD i = 0; i < c_rkChunk.dwLayerCount; ++i)
+		{
+			DWORD dwTextureNum = s_kVct_dwTextureNum[c_rkChunk.dwFirstLayer + i];
+			const TTerrainTexture & rTexture = m_TextureSet.GetTexture(dwTextureNum);
+
+			float afLayerUV[8] =
+			{
+				rTexture.m_matTransform._11, rTexture.m_matTransform._21, rTexture.m_matTransform._31, rTexture.m_matTransform._41,
+				rTexture.m_matTransform._12, rTexture.m_matTransform._22, rTexture.m_matTransform._32, rTexture.m_matTransform._42,
+			};
+			STATEMANAGER.SetVertexShaderConstant(10 + i * 2, afLayerUV, 2);
+
+			// ä 0~3 = ø  x, y, z, w
+			float afChannelMask[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+			afChannelMask[s_kVct_byChannel[c_rkChunk.dwFirstLayer + i]] = 1.0f;
+			STATEMANAGER.SetPixelShaderConstant(1 + i, afChannelMask, 1);
+
+			STATEMANAGER.SetTexture(i, rTexture.pd3dTexture);
+			STATEMANAGER.SetSamplerState(i, D3DSAMP_ADDRESSU, D3DTADDRESS_WRAP);
+			STATEMANAGER.SetSamplerState(i, D3DSAMP_ADDRESSV, D3DTADDRESS_WRAP);
+
+			std::vector<int>::iterator aIterator = std::find(m_RenderedTextureNumVector.begin(), m_RenderedTextureNumVector.end(), (int)dwTextureNum);
+			if (aIterator == m_RenderedTextureNumVector.end())
+				m_RenderedTextureNumVector.push_back(dwTextureNum);
+			++m_iRenderedSplatNum;
+		}
+
+		for (DWORD i = 0; i < c_rkChunk.dwAlphaCount; ++i)
+		{
+			DWORD dwStage = c_rkChunk.dwLayerCount + i;
+
+			STATEMANAGER.SetTexture(dwStage, c_rkChunk.alpAlphaTexture[i]);
+			STATEMANAGER.SetSamplerState(dwStage, D3DSAMP_ADDRESSU, D3DTADDRESS_CLAMP);
+			STATEMANAGER.SetSamplerState(dwStage, D3DSAMP_ADDRESSV, D3DTADDRESS_CLAMP);
+		}
+
+		STATEMANAGER.SetPixelShader(c_rkChunk.lpPixelShader);
+		STATEMANAGER.DrawIndexedPrimitive(ePrimitiveType, 0, m_iPatchTerrainVertexCount, 0, wPrimitiveCount);
+	}
+
+	STATEMANAGER.SetVertexShader(NULL);
+	STATEMANAGER.SetPixelShader(NULL);
+	STATEMANAGER.SetRenderState(D3DRS_SRCBLEND, D3DBLEND_SRCALPHA);
+
+	STATEMANAGER.SetSamplerState(0, D3DSAMP_ADDRESSU, D3DTADDRESS_WRAP);
+	STATEMANAGER.SetSamplerState(0, D3DSAMP_ADDRESSV, D3DTADDRESS_WRAP);
+	STATEMANAGER.SetSamplerState(1, D3DSAMP_ADDRESSU, D3DTADDRESS_CLAMP);
+	STATEMANAGER.SetSamplerState(1, D3DSAMP_ADDRESSV, D3DTADDRESS_CLAMP);
+	return true;
+}
@@ -7,6 +7,7 @@
 #include "AreaTerrain.h"
 #include "TerrainQuadtree.h"
 #include "ActorInstance.h"
+#include "../eterLib/ResourceManager.h"
 
 // 2004.08.17.myevan.std::vector    ޸ ٿ ɷ  ϵ 
 class PCBlocker_CDynamicSphereInstanceVector
@@ -110,6 +111,10 @@ bool CMapOutdoor::Update(float fX, float fY, float fZ)
 
 	__UpdateGarvage();
 
+#ifndef WORLD_EDITOR
+	__Prefetch_Update(fX, fY);
+#endif
+
 	UpdateTerrain(fX, fY);
 
 	__UpdateArea(v3Player);
@@ -121,6 +126,145 @@ bool CMapOutdoor::Update(float fX, float fY, float fZ)
 	return true;
 }
 
+void CMapOutdoor::__Prefetch_Init()
+{
+	m_kPrefetch.m_v2LastPos = D3DXVECTOR2(0.0f, 0.0f);
+	m_kPrefetch.m_v2Velocity = D3DXVECTOR2(0.0f, 0.0f);
+	m_kPrefetch.m_dwLastTime = 0;
+	m_kPrefetch.m_isStarted = false;
+	m_kPrefetch.m_kDeq_dwCoord.clear();
+}
+
+void CMapOutdoor::__Prefetch_Update(float fX, float fY)
+{
+	const float c_fLookAheadSec = 3.0f;
+	const float c_fMinSpeed = 100.0f;				// ʴ. ̺    
+	const DWORD c_dwMaxInterval = 1000;
+
+	if (fY < 0)
+		fY = -fY;
+
+	D3DXVECTOR2 v2Pos(fX, fY);
+	DWORD dwCurTime = ELTimer_GetMSec();
+	DWORD dwElapsed = dwCurTime - m_kPrefetch.m_dwLastTime;
+	D3DXVECTOR2 v2Delta = v2Pos - m_kPrefetch.m_v2LastPos;
+
+	//    ڿ ӵ ٽ .
+	if (!m_kPrefetch.m_isStarted || dwElapsed > c_dwMaxInterval || D3DXVec2Length(&v2Delta) > (float) CTerrainImpl::TERRAIN_XSIZE)
+	{
+		m_kPrefetch.m_v2LastPos = v2Pos;
+		m_kPrefetch.m_v2Velocity = D3DXVECTOR2(0.0f, 0.0f);
+		m_kPrefetch.m_dwLastTime = dwCurTime;
+		m_kPrefetch.m_isStarted = true;
+		m_kPrefetch.m_kDeq_dwCoord.clear();
+		return;
+	}
+
+	if (dwElapsed > 0)
+	{
+		D3DXVECTOR2 v2Velocity = v2Delta * (1000.0f / dwElapsed);
+		m_kPrefetch.m_v2Velocity = m_kPrefetch.m_v2Velocity * 0.8f + v2Velocity * 0.2f;
+		m_kPrefetch.m_v2LastPos = v2Pos;
+		m_kPrefetch.m_dwLastTime = dwCurTime;
+	}
+
+	float fSpeed = D3DXVec2Length(&m_kPrefetch.m_v2Velocity);
+
+	if (fSpeed >= c_fMinSpeed)
+	{
+		//  ͷκ ָ  ʴ´. ׷ ̸   UpdateAreaList   ʴ ʿ .
+		float fLookAhead = min(fSpeed * c_fLookAheadSec, CTerrainImpl::TERRAIN_XSIZE * 0.5f);
+		D3DXVECTOR2 v2Predict = v2Pos + m_kPrefetch.m_v2Velocity * (fLookAhead / fSpeed);
+
+		short sPredictX = MINMAX(0, (int) v2Predict.x / CTerrainImpl::TERRAIN_XSIZE, m_sTerrainCountX - 1);
+		short sPredictY = MINMAX(0, (int) max(0.0f, v2Predict.y) / CTerrainImpl::TERRAIN_YSIZE, m_sTerrainCountY - 1);
+
+		if (sPredictX != m_CurCoordinate.m_sTerrainCoordX || sPredictY != m_CurCoordinate.m_sTerrainCoordY)
+		{
+			for (short sY = sPredictY - LOAD_SIZE_WIDTH; sY <= sPredictY + LOAD_SIZE_WIDTH; ++sY)
+			{
+				for (short sX = sPredictX - LOAD_SIZE_WIDTH; sX <= sPredictX + LOAD_SIZE_WIDTH; ++sX)
+				{
+					if (sX < 0 || sY < 0 || sX >= m_sTerrainCountX || sY >= m_sTerrainCountY)
+						continue;
+
+					//  3x3  ̹  ִ.
+					if (abs(sX - m_CurCoordinate.m_sTerrainCoordX) <= LOAD_SIZE_WIDTH &&
+						abs(sY - m_CurCoordinate.m_sTerrainCoordY) <= LOAD_SIZE_WIDTH)
+						continue;
+
+					__Prefetch_Request(sX, sY);
+				}
+			}
+		}
+	}
+
+	__Prefetch_Process();
+}
+
+void CMapOutdoor::__Prefetch_Request(WORD wCoordX, WORD wCoordY)
+{
+	if (isTerrainLoaded(wCoordX, wCoordY) && isAreaLoaded(wCoordX, wCoordY))
+		return;
+
+	DWORD dwCoord = (wCoordX << 16) | wCoordY;
+
+	if (m_kPrefetch.m_kDeq_dwCoord.end() != std::find(m_kPrefetch.m_kDeq_dwCoord.begin(), m_kPrefetch.m_kDeq_dwCoord.end(), dwCoord))
+		return;
+
+	if (m_kPrefetch.m_kDeq_dwCoord.size() >= PREFETCH_QUEUE_MAX)
+		return;
+
+	m_kPrefetch.m_kDeq_dwCoord.push_back(dwCoord);
+
+	// ؽ ʰ   ε 忡  о д.
+	unsigned long ulID = (unsigned long) (wCoordX) * 1000L + (unsigned long) (wCoordY);
+	char szFileName[64+1];
+
+	_snprintf(szFileName, sizeof(szFileName), "%s\\%06u\\shadowmap.dds", GetMapDataDirectory().c_str(), ulID);
+	CResourceManager::Instance().RequestBackgroundLoading(szFileName);
+
+	_snprintf(szFileName, sizeof(szFileName), "%s\\%06u\\minimap.dds", GetMapDataDirectory().c_str(), ulID);
+	CResourceManager::Instance().RequestBackgroundLoading(szFileName);
+}
+
+void CMapOutdoor::__Prefetch_Process()
+{
+	while (!m_kPrefetch.m_kDeq_dwCoord.empty())
+	{
+		DWORD dwCoord = m_kPrefetch.m_kDeq_dwCoord.front();
+		WORD wCoordX = (WORD) (dwCoord >> 16);
+		WORD wCoordY = (WORD) (dwCoord & 0xffff);
+
+		//  ٲ㼭  ʿ  
+		if (abs(wCoordX - m_CurCoordinate.m_sTerrainCoordX) > LOAD_SIZE_WIDTH + 1 ||
+			abs(wCoordY - m_CurCoordinate.m_sTerrainCoordY) > LOAD_SIZE_WIDTH + 1)
+		{
+			m_kPrefetch.m_kDeq_dwCoord.pop_front();
+			continue;
+		}
+
+		//  ӿ ͷ̳  ϳ
+		if (!isTerrainLoaded(wCoordX, wCoordY))
+		{
+			DWORD dwStartTime = ELTimer_GetMSec();
+			LoadTerrain(wCoordX, wCoordY, 0, 0);
+			Tracenf("CMapOutdoor::Prefetch terrain (%d, %d) %d ms", wCoordX, wCoordY, ELTimer_GetMSec() - dwStartTime);
+			return;
+		}
+
+		m_kPrefetch.m_kDeq_dwCoord.pop_front();
+
+		if (!isAreaLoaded(wCoordX, wCoordY))
+		{
+			DWORD dwStartTime = ELTimer_GetMSec();
+			LoadArea(wCoordX, wCoordY, 0, 0);
+			Tracenf("CMapOutdoor::Prefetch area (%d, %d) %d ms", wCoordX, wCoordY, ELTimer_GetMSec() - dwStartTime);
+			return;
+		}
+	}
+}
+
 void CMapOutdoor::UpdateSky()
 {
 	m_SkyBox.Update();
@@ -292,9 +292,20 @@ void CRaceData::RegisterMotionMode(WORD wMotionModeIndex)
 	m_pMotionModeDataMap.insert(TMotionModeDataMap::value_type(wMotionModeIndex, pMotionModeData));
 }
 
+CGraphicThing * CRaceData::__GetMotionThing(const char * c_szFileName)
+{
+	CGraphicThing * pMotionThing = (CGraphicThing *)CResourceManager::Instance().GetResourcePointer(c_szFileName);
+
+	// ü  ϴ GR2  ƴϸ Ǹ ȭؼ  ְ Ѵ
+	if (pMotionThing && 0 != _stricmp(c_szFileName, m_strBaseModelFileName.c_str()))
+		pMotionThing->SetMotionOnly(true);
+
+	return pMotionThing;
+}
+
 CGraphicThing* CRaceData::NEW_RegisterMotion(CRaceMotionData* pkMotionData, WORD wMotionModeIndex, WORD wMotionIndex, const char * c_szFileName, BYTE byPercentage)
 {	
-	CGraphicThing * pMotionThing = (CGraphicThing *)CResourceManager::Instance().GetResourcePointer(c_szFileName);
+	CGraphicThing * pMotionThing = __GetMotionThing(c_szFileName);
 
 	TMotionModeData * pMotionModeData;
 	if (!GetMotionModeDataPointer(wMotionModeIndex, &pMotionModeData))
@@ -345,7 +356,7 @@ CGraphicThing* CRaceData::RegisterMotionData(WORD wMotionMode, WORD wMotionIndex
 
 void CRaceData::OLD_RegisterMotion(WORD wMotionModeIndex, WORD wMotionIndex, const char * c_szFileName, BYTE byPercentage)
 {
-	CGraphicThing * pThing = (CGraphicThing *)CResourceManager::Instance().GetResourcePointer(c_szFileName);
+	CGraphicThing * pThing = __GetMotionThing(c_szFileName);
 
 	TMotion	Motion;
 	Motion.byPercentage	= byPercentage;
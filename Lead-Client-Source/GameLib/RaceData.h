@@ -205,6 +205,7 @@ class CRaceData
 		void __Initialize();
 
 		void __OLD_RegisterMotion(WORD wMotionMode, WORD wMotionIndex, const TMotion & rMotion);
+		CGraphicThing * __GetMotionThing(const char * c_szFileName);
 
 		BOOL GetMotionVectorPointer(WORD wMotionMode, WORD wMotionIndex, TMotionVector ** ppMotionVector);
 
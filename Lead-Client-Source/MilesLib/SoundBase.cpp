@@ -1,4 +1,5 @@
 #include "Stdafx.h"
+#include <algorithm>
 #include "SoundBase.h"
 
 HDIGDRIVER				CSoundBase::ms_DIGDriver = NULL;
@@ -7,6 +8,9 @@ TProvider *				CSoundBase::ms_pProviderDefault = NULL;
 std::vector<TProvider>	CSoundBase::ms_ProviderVector;
 bool					CSoundBase::ms_bInitialized = false;
 int						CSoundBase::ms_iRefCount = 0;
+CFileLoaderThread		CSoundBase::ms_loadingThread;
+bool					CSoundBase::ms_isLoadingThread = false;
+DWORD					CSoundBase::ms_dwDataBudget = CSoundBase::DATA_BUDGET_DEFAULT;
 
 CSoundBase::CSoundBase()
 {
@@ -26,6 +30,13 @@ void CSoundBase::Destroy()
 
 	ms_iRefCount = 0;
 
+	// д  尡   带  .
+	if (ms_isLoadingThread)
+	{
+		ms_loadingThread.Shutdown();
+		ms_isLoadingThread = false;
+	}
+
 	if (!ms_dataMap.empty())
 	{
 		TSoundDataMap::iterator i;
@@ -53,7 +64,9 @@ void CSoundBase::Initialize()
 
 	ms_ProviderVector.clear();
 	ms_dataMap.clear();
-	
+
+	// ȿ ϳ дµ   ʿ .
+	ms_isLoadingThread = ms_loadingThread.Create(1) ? true : false;
 }
 
 DWORD CSoundBase::GetFileCRC(const char * filename)
@@ -68,3 +81,100 @@ CSoundData * CSoundBase::AddFile(DWORD dwFileCRC, const char* filename)
 	ms_dataMap.insert(TSoundDataMap::value_type(dwFileCRC, pSoundData));
 	return pSoundData;
 }
+
+bool CSoundBase::PrepareFile(const char * c_szFileName)
+{
+	DWORD dwFileCRC = GetFileCRC(c_szFileName);
+	TSoundDataMap::iterator itor = ms_dataMap.find(dwFileCRC);
+
+	CSoundData * pkSoundData;
+
+	if (itor == ms_dataMap.end())
+		pkSoundData = AddFile(dwFileCRC, c_szFileName);
+	else
+		pkSoundData = itor->second;
+
+	if (pkSoundData->IsData() || pkSoundData->IsLoadFailed() || !ms_isLoadingThread)
+		return true;
+
+	if (!pkSoundData->IsLoading())
+	{
+		std::string stFileName = pkSoundData->GetFileName();
+
+		pkSoundData->SetLoading(true);
+		ms_loadingThread.Request(stFileName);
+	}
+
+	return false;
+}
+
+void CSoundBase::ProcessLoading()
+{
+	if (!ms_isLoadingThread)
+		return;
+
+	//  Ǯ  忡 ϹǷ Ӵ  Ѵ.
+	CFileLoaderThread::TData * pData;
+	int iDecodeCount = 0;
+
+	while (iDecodeCount < DECODE_MAX_NUM_PER_FRAME && ms_loadingThread.Fetch(&pData))
+	{
+		TSoundDataMap::iterator itor = ms_dataMap.find(GetFileCRC(pData->stFileName.c_str()));
+
+		if (itor != ms_dataMap.end())
+		{
+			CSoundData * pkSoundData = itor->second;
+			pkSoundData->SetLoading(false);
+
+			if (!pkSoundData->IsData())
+			{
+				if (!pData->pvBuf || !pkSoundData->LoadFromMemory(pData->pvBuf, pData->dwSize))
+					pkSoundData->SetLoadFailed();
+
+				++iDecodeCount;
+			}
+		}
+
+		delete [] ((char *) pData->pvBuf);
+		delete pData;
+	}
+}
+
+void CSoundBase::SetDataBudget(DWORD dwBytes)
+{
+	ms_dwDataBudget = dwBytes;
+}
+
+bool CSoundBase::IsDataOverBudget()
+{
+	return CSoundData::GetTotalDataSize() > ms_dwDataBudget;
+}
+
+struct FSoundDataAccessTimeLess
+{
+	bool operator () (CSoundData * lhs, CSoundData * rhs) const
+	{
+		return lhs->GetAccessTime() < rhs->GetAccessTime();
+	}
+};
+
+void CSoundBase::CollectData()
+{
+	if (!IsDataOverBudget())
+		return;
+
+	std::vector<CSoundData *> kVct_pkData;
+
+	for (TSoundDataMap::iterator i = ms_dataMap.begin(); i != ms_dataMap.end(); ++i)
+	{
+		CSoundData * pkSoundData = i->second;
+
+		if (pkSoundData->IsData() && 0 == pkSoundData->GetRefCount())
+			kVct_pkData.push_back(pkSoundData);
+	}
+
+	std::sort(kVct_pkData.begin(), kVct_pkData.end(), FSoundDataAccessTimeLess());
+
+	for (size_t j = 0; j < kVct_pkData.size() && IsDataOverBudget(); ++j)
+		kVct_pkData[j]->Unload();
+}
@@ -4,6 +4,7 @@
 #include <map>
 #include <vector>
 #include "SoundData.h"
+#include "../EterLib/FileLoaderThread.h"
 
 typedef struct SProvider
 {
@@ -15,6 +16,13 @@ typedef std::map<DWORD, CSoundData*> TSoundDataMap;
 
 class CSoundBase
 {
+	public:
+		enum
+		{
+			DATA_BUDGET_DEFAULT = 32 * 1024 * 1024,
+			DECODE_MAX_NUM_PER_FRAME = 4,
+		};
+
 	public:
 		CSoundBase();
 		virtual ~CSoundBase();
@@ -22,8 +30,18 @@ class CSoundBase
 		void					Initialize();
 		void					Destroy();
 
-		CSoundData *			AddFile(DWORD dwFileCRC, const char* filename);
-		DWORD					GetFileCRC(const char* filename);
+		static CSoundData *		AddFile(DWORD dwFileCRC, const char* filename);
+		static DWORD			GetFileCRC(const char* filename);
+
+		//    true, ƴϸ ׶ ε ûϰ false  ش.
+		// ׶    true   ó ٷ а Ѵ.
+		static bool				PrepareFile(const char * c_szFileName);
+		static void				ProcessLoading();
+
+		// ƹ  ʴ  ͸  ͺ Ǯ   .
+		static void				SetDataBudget(DWORD dwBytes);
+		static bool				IsDataOverBudget();
+		static void				CollectData();
 
 	protected:
 		static int								ms_iRefCount;
@@ -32,6 +50,10 @@ class CSoundBase
 		static std::vector<TProvider>			ms_ProviderVector;
 		static TSoundDataMap					ms_dataMap;
 		static bool								ms_bInitialized;
+
+		static CFileLoaderThread				ms_loadingThread;
+		static bool								ms_isLoadingThread;
+		static DWORD							ms_dwDataBudget;
 };
 
 #endif
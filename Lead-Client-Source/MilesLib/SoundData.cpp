@@ -6,6 +6,7 @@
 
 bool CSoundData::ms_isSoundFile[SOUND_FILE_MAX_NUM];
 CMappedFile CSoundData::ms_SoundFile[SOUND_FILE_MAX_NUM];
+DWORD CSoundData::ms_dwTotalDataSize = 0;
 
 const char * CSoundData::GetFileName()
 {
@@ -61,18 +62,80 @@ DWORD CSoundData::GetAccessTime()
 	return m_dwAccessTime;
 }
 
-bool CSoundData::ReadFromDisk()
+bool CSoundData::IsData()
+{
+	return m_data ? true : false;
+}
+
+bool CSoundData::IsLoading()
+{
+	return m_isLoading;
+}
+
+bool CSoundData::IsLoadFailed()
+{
+	return m_isLoadFailed;
+}
+
+void CSoundData::SetLoading(bool isLoading)
+{
+	m_isLoading = isLoading;
+}
+
+void CSoundData::SetLoadFailed()
+{
+	m_isLoadFailed = true;
+}
+
+int CSoundData::GetRefCount()
+{
+	return m_iRefCount;
+}
+
+void CSoundData::Unload()
+{
+	assert(m_iRefCount == 0);
+	Destroy();
+}
+
+DWORD CSoundData::GetTotalDataSize()
+{
+	return ms_dwTotalDataSize;
+}
+
+bool CSoundData::LoadFromMemory(const void * c_pvData, DWORD dwSize)
 {
 	assert(m_assigned == true);
 
-	LARGE_INTEGER start;
-	QueryPerformanceCounter(&start);
+	if (m_data)
+		return true;
+
+	// AIL_file_read(FILE_READ_WITH_SIZE)   տ ũ⸦ δ.
+	U32 * s = (U32 *) AIL_mem_alloc_lock(dwSize + sizeof(U32));
+
+	if (s == NULL)
+		return false;
+
+	s[0] = dwSize;
+	memcpy(s + 1, c_pvData, dwSize);
+
+	return __Decode(s);
+}
+
+bool CSoundData::ReadFromDisk()
+{
+	assert(m_assigned == true);
 
 	U32* s = (U32 *) AIL_file_read(m_filename, FILE_READ_WITH_SIZE);
 
 	if (s == NULL)
 		return false;
 
+	return __Decode(s);
+}
+
+bool CSoundData::__Decode(U32 * s)
+{
 	S32 type = AIL_file_type(s + 1, s[0]);
 	AILSOUNDINFO info;
 	
@@ -107,6 +170,14 @@ bool CSoundData::ReadFromDisk()
 			return false;
 	}
 
+	if (!m_data)
+	{
+		m_size = 0;
+		return false;
+	}
+
+	m_isLoadFailed = false;
+	ms_dwTotalDataSize += m_size;
 	return true;
 }
 
@@ -192,7 +263,12 @@ void CSoundData::Destroy()
 	{
 		AIL_mem_free_lock(m_data);
 		m_data = NULL;
+
+		ms_dwTotalDataSize -= m_size;
 	}
+
+	m_size = 0;
+	m_flag = 0;
 }
 
 CSoundData::CSoundData() : 
@@ -202,7 +278,9 @@ m_dwPlayTime(0),
 m_dwAccessTime(ELTimer_GetMSec()),
 m_size(0),
 m_data(NULL),
-m_flag(0)
+m_flag(0),
+m_isLoading(false),
+m_isLoadFailed(false)
 {
 }
 
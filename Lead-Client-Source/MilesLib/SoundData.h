@@ -29,8 +29,23 @@ class CSoundData
 		void			SetPlayTime(DWORD dwPlayTime);
 		DWORD			GetPlayTime();
 
+		// ׶ ε
+		bool			IsData();
+		bool			IsLoading();
+		bool			IsLoadFailed();
+		void			SetLoading(bool isLoading);
+		void			SetLoadFailed();
+		bool			LoadFromMemory(const void * c_pvData, DWORD dwSize);
+
+		// ƹ    Ǯ  Get  ٽ д´.
+		int				GetRefCount();
+		void			Unload();
+
+		static DWORD	GetTotalDataSize();
+
 	protected:
 		bool			ReadFromDisk();
+		bool			__Decode(U32 * s);
 		void			Destroy();
 		
 	protected:
@@ -42,6 +57,10 @@ class CSoundData
 		LPVOID			m_data;
 		long			m_flag;
 		bool			m_assigned;
+		bool			m_isLoading;
+		bool			m_isLoadFailed;
+
+		static DWORD	ms_dwTotalDataSize;
 
 	private:
 		static U32 AILCALLBACK		open_callback(char const * filename, U32 *file_handle);
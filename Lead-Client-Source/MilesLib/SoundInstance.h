@@ -48,6 +48,8 @@ public: // from interface
 						   float x_normal, float y_normal, float z_normal) const;
 	void	SetVelocity(float fx, float fy, float fz, float fMagnitude) const;
 
+	void	ReleaseDoneSound();
+
 private:
 	HSAMPLE			m_sample;
 	CSoundData*		m_pSoundData;
@@ -79,6 +81,9 @@ class CSoundInstance3D : public ISoundInstance
 
 		void	UpdatePosition(float fElapsedTime);
 
+		//     ۷  CollectData  Ǯ  ְ Ѵ.
+		void	ReleaseDoneSound();
+
 	private:
 		H3DSAMPLE		m_sample;
 		CSoundData *		m_pSoundData;
@@ -21,6 +21,14 @@ void CSoundInstance2D::Destroy()
 	}
 }
 
+void CSoundInstance2D::ReleaseDoneSound()
+{
+	if (!m_pSoundData || !IsDone())
+		return;
+
+	SAFE_RELEASE(m_pSoundData);
+}
+
 bool CSoundInstance2D::Initialize()
 {
 	if (m_sample)
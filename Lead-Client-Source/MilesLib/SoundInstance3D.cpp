@@ -22,6 +22,14 @@ void CSoundInstance3D::Destroy()
 	}
 }
 
+void CSoundInstance3D::ReleaseDoneSound()
+{
+	if (!m_pSoundData || !IsDone())
+		return;
+
+	SAFE_RELEASE(m_pSoundData);
+}
+
 bool CSoundInstance3D::Initialize()
 {
 	if (m_sample)
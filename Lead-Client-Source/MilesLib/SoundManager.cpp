@@ -85,6 +85,16 @@ void CSoundManager::Update()
 	// Update Information about 3D Sound
 	ms_SoundManager3D.SetListenerPosition(0.0f, 0.0f, 0.0f);
 
+	CSoundBase::ProcessLoading();
+	__UpdatePendingSound();
+
+	if (CSoundBase::IsDataOverBudget())
+	{
+		ms_SoundManager2D.ReleaseDoneInstances();
+		ms_SoundManager3D.ReleaseDoneInstances();
+		CSoundBase::CollectData();
+	}
+
 	for (int i = 0; i < CSoundManagerStream::MUSIC_INSTANCE_MAX_NUM; ++i)
 	{
 		TMusicInstance & rMusicInstance = m_MusicInstances[i];
@@ -304,9 +314,9 @@ BOOL CSoundManager::GetSoundInstance2D(const char * c_szSoundFileName, ISoundIns
 	return TRUE;
 }
 
-BOOL CSoundManager::GetSoundInstance3D(const char * c_szFileName, ISoundInstance ** ppInstance)
+BOOL CSoundManager::GetSoundInstance3D(const char * c_szFileName, float fDistanceSquare, int iPriority, ISoundInstance ** ppInstance)
 {
-	int iIndex = ms_SoundManager3D.SetInstance(c_szFileName);
+	int iIndex = ms_SoundManager3D.SetInstance(c_szFileName, fDistanceSquare, iPriority);
 
 	if (-1 == iIndex)
 		return FALSE;
@@ -319,11 +329,83 @@ BOOL CSoundManager::GetSoundInstance3D(const char * c_szFileName, ISoundInstance
 	return TRUE;
 }
 
+float CSoundManager::__GetDistanceSquare(float fx, float fy, float fz)
+{
+	float fdx = fx - m_fxPosition;
+	float fdy = fy - m_fyPosition;
+	float fdz = fz - m_fzPosition;
+	return fdx * fdx + fdy * fdy + fdz * fdz;
+}
+
+bool CSoundManager::__PrepareSound(int iType, float fx, float fy, float fz, const char * c_szFileName, int iPlayCount)
+{
+	if (CSoundBase::PrepareFile(c_szFileName))
+		return true;
+
+	if (m_PendingSoundList.size() >= PENDING_SOUND_MAX_NUM)
+		m_PendingSoundList.pop_front();
+
+	TPendingSound kPendingSound;
+	kPendingSound.iType = iType;
+	kPendingSound.fx = fx;
+	kPendingSound.fy = fy;
+	kPendingSound.fz = fz;
+	kPendingSound.iPlayCount = iPlayCount;
+	kPendingSound.dwRequestTime = ELTimer_GetMSec();
+	kPendingSound.strFileName = c_szFileName;
+	m_PendingSoundList.push_back(kPendingSound);
+	return false;
+}
+
+void CSoundManager::__UpdatePendingSound()
+{
+	DWORD dwCurTime = ELTimer_GetMSec();
+
+	std::list<TPendingSound>::iterator itor = m_PendingSoundList.begin();
+
+	while (itor != m_PendingSoundList.end())
+	{
+		// ʹ ʰ  Ҹ Ʋ ʴ´.
+		if (dwCurTime - itor->dwRequestTime > PENDING_SOUND_WAIT_TIME)
+		{
+			itor = m_PendingSoundList.erase(itor);
+			continue;
+		}
+
+		if (!CSoundBase::PrepareFile(itor->strFileName.c_str()))
+		{
+			++itor;
+			continue;
+		}
+
+		TPendingSound kPendingSound = *itor;
+		itor = m_PendingSoundList.erase(itor);
+
+		switch (kPendingSound.iType)
+		{
+			case PENDING_SOUND_2D:
+				PlaySound2D(kPendingSound.strFileName.c_str());
+				break;
+
+			case PENDING_SOUND_3D:
+				PlaySound3D(kPendingSound.fx, kPendingSound.fy, kPendingSound.fz, kPendingSound.strFileName.c_str(), kPendingSound.iPlayCount);
+				break;
+
+			case PENDING_SOUND_CHARACTER_3D:
+				PlayCharacterSound3D(kPendingSound.fx, kPendingSound.fy, kPendingSound.fz, kPendingSound.strFileName.c_str(), FALSE);
+				break;
+		}
+	}
+}
+
 void CSoundManager::PlaySound2D(const char * c_szFileName)
 {
 	if (0.0f == GetSoundVolume())
 		return;
 
+	if (!__PrepareSound(PENDING_SOUND_2D, 0.0f, 0.0f, 0.0f, c_szFileName, 1))
+		return;
+
 	ISoundInstance * pInstance;
 	if (!GetSoundInstance2D(c_szFileName, &pInstance))
 		return;
@@ -337,7 +419,10 @@ void CSoundManager::PlaySound3D(float fx, float fy, float fz, const char * c_szF
 	if (0.0f == GetSoundVolume())
 		return;
 
-	int iIndex = ms_SoundManager3D.SetInstance(c_szFileName);
+	if (!__PrepareSound(PENDING_SOUND_3D, fx, fy, fz, c_szFileName, iPlayCount))
+		return;
+
+	int iIndex = ms_SoundManager3D.SetInstance(c_szFileName, __GetDistanceSquare(fx, fy, fz), CSoundManager3D::PRIORITY_EFFECT);
 	if (-1 == iIndex)
 		return;
 
@@ -358,7 +443,8 @@ int CSoundManager::PlayAmbienceSound3D(float fx, float fy, float fz, const char
 	if (0.0f == GetSoundVolume())
 		return -1;
 
-	int iIndex = ms_SoundManager3D.SetInstance(c_szFileName);
+	//  ε ߿ Ƿ ȯ ٷ д´.
+	int iIndex = ms_SoundManager3D.SetInstance(c_szFileName, __GetDistanceSquare(fx, fy, fz), CSoundManager3D::PRIORITY_AMBIENCE);
 	if (-1 == iIndex)
 		return -1;
 
@@ -406,9 +492,12 @@ void CSoundManager::PlayCharacterSound3D(float fx, float fy, float fz, const cha
 		m_PlaySoundHistoryMap.insert(std::map<std::string, float>::value_type(c_szFileName, CTimer::Instance().GetCurrentSecond()));
 	}
 
+	if (!__PrepareSound(PENDING_SOUND_CHARACTER_3D, fx, fy, fz, c_szFileName, 1))
+		return;
+
 	ISoundInstance * pInstance;
 
-	if (!GetSoundInstance3D(c_szFileName, &pInstance))
+	if (!GetSoundInstance3D(c_szFileName, __GetDistanceSquare(fx, fy, fz), CSoundManager3D::PRIORITY_CHARACTER, &pInstance))
 		return;
 
 	pInstance->SetPosition((fx - m_fxPosition) / m_fSoundScale,
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <list>
+
 #include "../eterBase/Singleton.h"
 
 #include "SoundManagerStream.h"
@@ -84,7 +86,34 @@ protected:
 	float __ConvertRatioVolumeToApplyVolume(float fVolumeRatio);
 	void __SetMusicVolume(float fVolume);
 	BOOL GetSoundInstance2D(const char * c_szSoundFileName, ISoundInstance ** ppInstance);
-	BOOL GetSoundInstance3D(const char * c_szFileName, ISoundInstance ** ppInstance);
+	BOOL GetSoundInstance3D(const char * c_szFileName, float fDistanceSquare, int iPriority, ISoundInstance ** ppInstance);
+	float __GetDistanceSquare(float fx, float fy, float fz);
+
+	// ó  Ҹ ׶ д  ٷȴٰ Update  ư.
+	enum
+	{
+		PENDING_SOUND_2D,
+		PENDING_SOUND_3D,
+		PENDING_SOUND_CHARACTER_3D,
+	};
+
+	enum
+	{
+		PENDING_SOUND_MAX_NUM = 32,
+		PENDING_SOUND_WAIT_TIME = 1000,
+	};
+
+	typedef struct SPendingSound
+	{
+		int			iType;
+		float		fx, fy, fz;
+		int			iPlayCount;
+		DWORD		dwRequestTime;
+		std::string	strFileName;
+	} TPendingSound;
+
+	bool __PrepareSound(int iType, float fx, float fy, float fz, const char * c_szFileName, int iPlayCount);
+	void __UpdatePendingSound();
 
 protected:
 	BOOL							m_bInitialized;
@@ -104,6 +133,7 @@ protected:
 
 	TMusicInstance					m_MusicInstances[CSoundManagerStream::MUSIC_INSTANCE_MAX_NUM];
 	std::map<std::string, float>	m_PlaySoundHistoryMap;
+	std::list<TPendingSound>		m_PendingSoundList;
 
 	static CSoundManager2D			ms_SoundManager2D;
 	static CSoundManager3D			ms_SoundManager3D;
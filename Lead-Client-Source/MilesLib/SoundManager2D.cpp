@@ -77,3 +77,9 @@ ISoundInstance * CSoundManager2D::GetInstance(const char * c_pszFileName)
 
 	return NULL;
 }
+
+void CSoundManager2D::ReleaseDoneInstances()
+{
+	for (int i = 0; i < INSTANCE_MAX_COUNT; ++i)
+		ms_Instances[i].ReleaseDoneSound();
+}
@@ -19,6 +19,7 @@ class CSoundManager2D : public CSoundBase
 		void				Destroy();
 
 		ISoundInstance *	GetInstance(const char* filename);
+		void				ReleaseDoneInstances();
 
 	protected:
 		CSoundInstance2D	ms_Instances[INSTANCE_MAX_COUNT];
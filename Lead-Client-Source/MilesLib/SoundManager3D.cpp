@@ -68,6 +68,8 @@ bool CSoundManager3D::Initialize()
 	{
 		m_Instances[i].Initialize();
 		m_bLockingFlag[i] = false;
+		m_afDistanceSquare[i] = 0.0f;
+		m_aiPriority[i] = PRIORITY_EFFECT;
 	}
 
 	m_bInit = true;
@@ -122,7 +124,41 @@ void CSoundManager3D::SetListenerVelocity(float fDistanceX, float fDistanceY, fl
 	AIL_set_3D_velocity(m_pListener, fDistanceX, fDistanceY, -fDistanceZ, fNagnitude);
 }
 
-int CSoundManager3D::SetInstance(const char * c_pszFileName)
+int CSoundManager3D::__GetStealInstanceIndex(float fDistanceSquare, int iPriority)
+{
+	int iStealIndex = -1;
+
+	for (int i = 0; i < INSTANCE_MAX_COUNT; ++i)
+	{
+		if (m_bLockingFlag[i])
+			continue;
+
+		// ȯ ε  ִٰ Ƿ  ʴ´.
+		if (PRIORITY_AMBIENCE == m_aiPriority[i])
+			continue;
+
+		if (m_aiPriority[i] > iPriority)
+			continue;
+
+		if (m_aiPriority[i] == iPriority && m_afDistanceSquare[i] <= fDistanceSquare)
+			continue;
+
+		if (-1 != iStealIndex)
+		{
+			if (m_aiPriority[i] > m_aiPriority[iStealIndex])
+				continue;
+
+			if (m_aiPriority[i] == m_aiPriority[iStealIndex] && m_afDistanceSquare[i] <= m_afDistanceSquare[iStealIndex])
+				continue;
+		}
+
+		iStealIndex = i;
+	}
+
+	return iStealIndex;
+}
+
+int CSoundManager3D::SetInstance(const char * c_pszFileName, float fDistanceSquare, int iPriority)
 {
 	DWORD dwFileCRC = GetFileCRC(c_pszFileName);
 	TSoundDataMap::iterator itor = ms_dataMap.find(dwFileCRC);
@@ -154,6 +190,8 @@ int CSoundManager3D::SetInstance(const char * c_pszFileName)
 				return -1;
 			}
 
+			m_afDistanceSquare[start % INSTANCE_MAX_COUNT] = fDistanceSquare;
+			m_aiPriority[start % INSTANCE_MAX_COUNT] = iPriority;
 			return (start % INSTANCE_MAX_COUNT);
 		}
 
@@ -167,7 +205,30 @@ int CSoundManager3D::SetInstance(const char * c_pszFileName)
 		}
 	}
 
-	return -1;
+	// ̽     ߿ Ҹ   ڸ ִ´.
+	int iStealIndex = __GetStealInstanceIndex(fDistanceSquare, iPriority);
+
+	if (-1 == iStealIndex)
+		return -1;
+
+	CSoundInstance3D * pkStealInst = &m_Instances[iStealIndex];
+	pkStealInst->Stop();
+
+	if (!pkStealInst->SetSound(pkSoundData))
+	{
+		TraceError("CSoundManager3D::GetInstance (filename: %s)", c_pszFileName);
+		return -1;
+	}
+
+	m_afDistanceSquare[iStealIndex] = fDistanceSquare;
+	m_aiPriority[iStealIndex] = iPriority;
+	return iStealIndex;
+}
+
+void CSoundManager3D::ReleaseDoneInstances()
+{
+	for (int i = 0; i < INSTANCE_MAX_COUNT; ++i)
+		m_Instances[i].ReleaseDoneSound();
 }
 
 ISoundInstance * CSoundManager3D::GetInstance(DWORD dwIndex)
@@ -13,6 +13,14 @@ class CSoundManager3D : public CSoundBase
 			MAX_PROVIDERS = 32,
 		};
 
+		//  ̽  켱 ų  켱   Ҹ ´.
+		enum EPriority
+		{
+			PRIORITY_CHARACTER,
+			PRIORITY_EFFECT,
+			PRIORITY_AMBIENCE,
+		};
+
 	public:
 		CSoundManager3D();
 		virtual ~CSoundManager3D();
@@ -21,8 +29,9 @@ class CSoundManager3D : public CSoundBase
 		void				Destroy();
 
 		int					GetEmptyInstanceIndex();
-		int					SetInstance(const char * c_szFileName);
+		int					SetInstance(const char * c_szFileName, float fDistanceSquare = 0.0f, int iPriority = PRIORITY_EFFECT);
 		ISoundInstance *	GetInstance(DWORD dwIndex);
+		void				ReleaseDoneInstances();
 
 		void				SetListenerDirection(float fxDir, float fyDir, float fzDir, float fxUp, float fyUp, float fzUp);
 		void				SetListenerPosition(float x, float y, float z);
@@ -33,10 +42,13 @@ class CSoundManager3D : public CSoundBase
 
 	protected:
 		bool				IsValidInstanceIndex(int iIndex);
+		int					__GetStealInstanceIndex(float fDistanceSquare, int iPriority);
 
 	protected:
 		bool				m_bLockingFlag[INSTANCE_MAX_COUNT];
 		CSoundInstance3D	m_Instances[INSTANCE_MAX_COUNT];
+		float				m_afDistanceSquare[INSTANCE_MAX_COUNT];	// ÷̸   ʿ Ÿ
+		int					m_aiPriority[INSTANCE_MAX_COUNT];
 		H3DPOBJECT			m_pListener;
 
 		bool m_bInit;
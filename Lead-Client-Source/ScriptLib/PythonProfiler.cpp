@@ -0,0 +1,292 @@
+#include "StdAfx.h"
+#include "PythonProfiler.h"
+
+static const char * __GetPythonClassName(PyObject * poClass)
+{
+	if (!poClass)
+		return "?";
+
+	if (PyInstance_Check(poClass))
+		return PyString_AsString(((PyInstanceObject *) poClass)->in_class->cl_name);
+
+	if (PyModule_Check(poClass))
+		return PyModule_GetName(poClass);
+
+	return poClass->ob_type->tp_name;
+}
+
+static const char * __GetPythonFuncName(PyObject * poFunc)
+{
+	if (PyMethod_Check(poFunc))
+		poFunc = PyMethod_GET_FUNCTION(poFunc);
+
+	if (PyFunction_Check(poFunc))
+		return PyString_AsString(((PyFunctionObject *) poFunc)->func_name);
+
+	return poFunc->ob_type->tp_name;
+}
+
+CPythonProfiler::CPythonProfiler()
+{
+	m_isRunning = false;
+	m_iCallDepth = 0;
+	QueryPerformanceFrequency(&m_liFrequency);
+
+	Reset();
+}
+
+CPythonProfiler::~CPythonProfiler()
+{
+}
+
+void CPythonProfiler::Start()
+{
+	m_isRunning = true;
+}
+
+void CPythonProfiler::Stop()
+{
+	m_isRunning = false;
+	m_kVct_kScope.clear();
+}
+
+void CPythonProfiler::Reset()
+{
+	m_kMap_kCallStat.clear();
+	m_kVct_kScope.clear();
+
+	m_dwFrameNum = 0;
+	m_dwFrameUSec = 0;
+	m_dwLastFrameUSec = 0;
+	m_dwPeakFrameUSec = 0;
+}
+
+DWORD CPythonProfiler::__GetUSec(const LARGE_INTEGER & c_rliBegin, const LARGE_INTEGER & c_rliEnd)
+{
+	if (!m_liFrequency.QuadPart)
+		return 0;
+
+	return (DWORD) ((c_rliEnd.QuadPart - c_rliBegin.QuadPart) * 1000000 / m_liFrequency.QuadPart);
+}
+
+//  ۸ ҷ    Ѱ д.
+void CPythonProfiler::BeginFrame()
+{
+	if (!m_isRunning)
+		return;
+
+	for (TCallStatMap::iterator it = m_kMap_kCallStat.begin(); it != m_kMap_kCallStat.end(); ++it)
+	{
+		TCallStat & rkStat = it->second;
+
+		if (rkStat.dwFrameUSec > rkStat.dwPeakFrameUSec)
+			rkStat.dwPeakFrameUSec = rkStat.dwFrameUSec;
+
+		rkStat.dwLastFrameCount = rkStat.dwFrameCount;
+		rkStat.dwLastFrameUSec = rkStat.dwFrameUSec;
+		rkStat.dwFrameCount = 0;
+		rkStat.dwFrameUSec = 0;
+	}
+
+	if (m_dwFrameUSec > m_dwPeakFrameUSec)
+		m_dwPeakFrameUSec = m_dwFrameUSec;
+
+	m_dwLastFrameUSec = m_dwFrameUSec;
+	m_dwFrameUSec = 0;
+	++m_dwFrameNum;
+}
+
+void CPythonProfiler::__AddStat(const char * c_szClassName, const char * c_szFuncName, const LARGE_INTEGER & c_rliBegin, const LARGE_INTEGER & c_rliEnd)
+{
+	DWORD dwUSec = __GetUSec(c_rliBegin, c_rliEnd);
+
+	m_stKey.assign(c_szClassName ? c_szClassName : "?");
+	m_stKey.append(".");
+	m_stKey.append(c_szFuncName ? c_szFuncName : "?");
+
+	TCallStatMap::iterator it = m_kMap_kCallStat.find(m_stKey);
+
+	if (m_kMap_kCallStat.end() == it)
+	{
+		TCallStat kStat;
+		memset(&kStat, 0, sizeof(kStat));
+
+		it = m_kMap_kCallStat.insert(TCallStatMap::value_type(m_stKey, kStat)).first;
+	}
+
+	TCallStat & rkStat = it->second;
+	++rkStat.dwCount;
+	rkStat.i64TotalUSec += dwUSec;
+	++rkStat.dwFrameCount;
+	rkStat.dwFrameUSec += dwUSec;
+
+	if (dwUSec > rkStat.dwMaxUSec)
+		rkStat.dwMaxUSec = dwUSec;
+
+	//  ȣ ٱ ȣ ð ̹  Ƿ  հ迡  ٱ ͸ Ѵ.
+	if (!m_iCallDepth)
+		m_dwFrameUSec += dwUSec;
+}
+
+void CPythonProfiler::BeginCall(LARGE_INTEGER * pliBegin)
+{
+	++m_iCallDepth;
+	QueryPerformanceCounter(pliBegin);
+}
+
+void CPythonProfiler::AddCall(PyObject * poClass, const char * c_szFuncName, const LARGE_INTEGER & c_rliBegin)
+{
+	LARGE_INTEGER liEnd;
+	QueryPerformanceCounter(&liEnd);
+
+	if (m_iCallDepth > 0)
+		--m_iCallDepth;
+
+	__AddStat(__GetPythonClassName(poClass), c_szFuncName, c_rliBegin, liEnd);
+}
+
+void CPythonProfiler::AddCall(PyObject * poClass, PyObject * poFunc, const LARGE_INTEGER & c_rliBegin)
+{
+	LARGE_INTEGER liEnd;
+	QueryPerformanceCounter(&liEnd);
+
+	if (m_iCallDepth > 0)
+		--m_iCallDepth;
+
+	__AddStat(__GetPythonClassName(poClass), __GetPythonFuncName(poFunc), c_rliBegin, liEnd);
+}
+
+void CPythonProfiler::PushScope(const char * c_szName)
+{
+	if (!m_isRunning)
+		return;
+
+	if (m_kVct_kScope.size() >= SCOPE_STACK_MAX_NUM)
+	{
+		TraceError("CPythonProfiler::PushScope(%s) - stack overflow", c_szName);
+		return;
+	}
+
+	m_kVct_kScope.push_back(TScope());
+
+	TScope & rkScope = m_kVct_kScope.back();
+	rkScope.stName = c_szName;
+	QueryPerformanceCounter(&rkScope.liBegin);
+}
+
+void CPythonProfiler::PopScope(const char * c_szName)
+{
+	if (!m_isRunning)
+		return;
+
+	if (m_kVct_kScope.empty() || m_kVct_kScope.back().stName != c_szName)
+	{
+		TraceError("CPythonProfiler::PopScope(%s) - not matched with Push", c_szName);
+		return;
+	}
+
+	LARGE_INTEGER liEnd;
+	QueryPerformanceCounter(&liEnd);
+
+	TScope kScope = m_kVct_kScope.back();
+	m_kVct_kScope.pop_back();
+
+	__AddStat("scope", kScope.stName.c_str(), kScope.liBegin, liEnd);
+}
+
+struct FCompareCallStatTotal
+{
+	bool operator () (const CPythonProfiler::TCallStatMap::const_iterator & lhs, const CPythonProfiler::TCallStatMap::const_iterator & rhs) const
+	{
+		return lhs->second.i64TotalUSec > rhs->second.i64TotalUSec;
+	}
+};
+
+bool CPythonProfiler::Dump(const char * c_szFileName)
+{
+	FILE * fp = fopen(c_szFileName, "w");
+
+	if (!fp)
+	{
+		TraceError("CPythonProfiler::Dump - cannot open %s", c_szFileName);
+		return false;
+	}
+
+	std::vector<TCallStatMap::const_iterator> kVct_itStat;
+	kVct_itStat.reserve(m_kMap_kCallStat.size());
+
+	for (TCallStatMap::const_iterator it = m_kMap_kCallStat.begin(); it != m_kMap_kCallStat.end(); ++it)
+		kVct_itStat.push_back(it);
+
+	std::sort(kVct_itStat.begin(), kVct_itStat.end(), FCompareCallStatTotal());
+
+	fprintf(fp, "frames %u, peak frame %uus\n", m_dwFrameNum, m_dwPeakFrameUSec);
+	fprintf(fp, "name\tcount\ttotal_us\tavg_us\tmax_us\tper_frame_us\tpeak_frame_us\n");
+
+	for (DWORD i = 0; i < kVct_itStat.size(); ++i)
+	{
+		const TCallStat & c_rkStat = kVct_itStat[i]->second;
+
+		fprintf(fp, "%s\t%u\t%I64d\t%I64d\t%u\t%I64d\t%u\n",
+				kVct_itStat[i]->first.c_str(),
+				c_rkStat.dwCount,
+				c_rkStat.i64TotalUSec,
+				c_rkStat.i64TotalUSec / max(1, c_rkStat.dwCount),
+				c_rkStat.dwMaxUSec,
+				c_rkStat.i64TotalUSec / max(1, m_dwFrameNum),
+				c_rkStat.dwPeakFrameUSec);
+	}
+
+	fclose(fp);
+	return true;
+}
+
+//  ӿ  ɸ    ش
+void CPythonProfiler::GetInfo(std::string * pstInfo)
+{
+	char szInfo[128];
+
+	if (!m_isRunning)
+	{
+		pstInfo->append("Python: profiler off");
+		return;
+	}
+
+	TCallStatMap::const_iterator aitTop[INFO_TOP_NUM];
+	int iTopCount = 0;
+
+	for (TCallStatMap::const_iterator it = m_kMap_kCallStat.begin(); it != m_kMap_kCallStat.end(); ++it)
+	{
+		if (!it->second.dwLastFrameCount)
+			continue;
+
+		int iPos = iTopCount;
+
+		while (iPos > 0 && aitTop[iPos - 1]->second.dwLastFrameUSec < it->second.dwLastFrameUSec)
+		{
+			if (iPos < INFO_TOP_NUM)
+				aitTop[iPos] = aitTop[iPos - 1];
+
+			--iPos;
+		}
+
+		if (iPos < INFO_TOP_NUM)
+		{
+			aitTop[iPos] = it;
+
+			if (iTopCount < INFO_TOP_NUM)
+				++iTopCount;
+		}
+	}
+
+	_snprintf(szInfo, sizeof(szInfo), "Python: frame %uus (peak %uus)", m_dwLastFrameUSec, m_dwPeakFrameUSec);
+	pstInfo->append(szInfo);
+
+	for (int i = 0; i < iTopCount; ++i)
+	{
+		const TCallStat & c_rkStat = aitTop[i]->second;
+
+		_snprintf(szInfo, sizeof(szInfo), ", %s %u x %uus", aitTop[i]->first.c_str(), c_rkStat.dwLastFrameCount, c_rkStat.dwLastFrameUSec);
+		pstInfo->append(szInfo);
+	}
+}
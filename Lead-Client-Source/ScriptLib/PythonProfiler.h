@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../eterBase/Singleton.h"
+
+// C++  θ ̽ Լ ȣ  ɸ ð( ȣ ) .
+class CPythonProfiler : public CSingleton<CPythonProfiler>
+{
+	public:
+		enum
+		{
+			INFO_TOP_NUM = 5,
+			SCOPE_STACK_MAX_NUM = 32,
+		};
+
+		typedef struct SCallStat
+		{
+			DWORD	dwCount;
+			DWORD	dwMaxUSec;
+			__int64	i64TotalUSec;
+
+			DWORD	dwFrameCount;		//   
+			DWORD	dwFrameUSec;
+			DWORD	dwLastFrameCount;	// ٷ  
+			DWORD	dwLastFrameUSec;
+			DWORD	dwPeakFrameUSec;	//  ӿ   ɸ ð
+		} TCallStat;
+
+		typedef std::map<std::string, TCallStat> TCallStatMap;
+
+		typedef struct SScope
+		{
+			std::string		stName;
+			LARGE_INTEGER	liBegin;
+		} TScope;
+
+	public:
+		CPythonProfiler();
+		virtual ~CPythonProfiler();
+
+		void Start();
+		void Stop();
+		void Reset();
+		bool IsRunning() const	{ return m_isRunning; }
+
+		void BeginFrame();
+
+		void BeginCall(LARGE_INTEGER * pliBegin);
+		void AddCall(PyObject * poClass, const char * c_szFuncName, const LARGE_INTEGER & c_rliBegin);
+		void AddCall(PyObject * poClass, PyObject * poFunc, const LARGE_INTEGER & c_rliBegin);
+
+		// ũƮ profiler.Push / Pop   
+		void PushScope(const char * c_szName);
+		void PopScope(const char * c_szName);
+
+		bool Dump(const char * c_szFileName);
+		void GetInfo(std::string * pstInfo);
+
+	protected:
+		void __AddStat(const char * c_szClassName, const char * c_szFuncName, const LARGE_INTEGER & c_rliBegin, const LARGE_INTEGER & c_rliEnd);
+		DWORD __GetUSec(const LARGE_INTEGER & c_rliBegin, const LARGE_INTEGER & c_rliEnd);
+
+	protected:
+		bool			m_isRunning;
+		LARGE_INTEGER	m_liFrequency;
+		int				m_iCallDepth;
+
+		TCallStatMap	m_kMap_kCallStat;
+		std::string		m_stKey;
+
+		DWORD			m_dwFrameNum;
+		DWORD			m_dwFrameUSec;
+		DWORD			m_dwLastFrameUSec;
+		DWORD			m_dwPeakFrameUSec;
+
+		std::vector<TScope>	m_kVct_kScope;
+};
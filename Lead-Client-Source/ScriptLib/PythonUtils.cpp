@@ -7,6 +7,27 @@ bool __PyCallClassMemberFunc_ByCString(PyObject* poClass, const char* c_szFunc,
 bool __PyCallClassMemberFunc_ByPyString(PyObject* poClass, PyObject* poFuncName, PyObject* poArgs, PyObject** poRet);
 bool __PyCallClassMemberFunc(PyObject* poClass, PyObject* poFunc, PyObject* poArgs, PyObject** poRet);
 
+// Ϸ   Լ ɸ ð .
+static PyObject * __PyCallObject(PyObject * poClass, const char * c_szFunc, PyObject * poFunc, PyObject * poArgs)
+{
+	CPythonProfiler * pkProfiler = CPythonProfiler::InstancePtr();
+
+	if (!pkProfiler || !pkProfiler->IsRunning())
+		return PyObject_CallObject(poFunc, poArgs);
+
+	LARGE_INTEGER liBegin;
+	pkProfiler->BeginCall(&liBegin);
+
+	PyObject * poRet = PyObject_CallObject(poFunc, poArgs);	// New Reference
+
+	if (c_szFunc)
+		pkProfiler->AddCall(poClass, c_szFunc, liBegin);
+	else
+		pkProfiler->AddCall(poClass, poFunc, liBegin);
+
+	return poRet;
+}
+
 PyObject * Py_BadArgument()
 {
 	PyErr_BadArgument();
@@ -313,7 +334,7 @@ bool __PyCallClassMemberFunc_ByCString(PyObject* poClass, const char* c_szFunc,
 		return false;
 	}
 
-	PyObject * poRet = PyObject_CallObject(poFunc, poArgs);	// New Reference
+	PyObject * poRet = __PyCallObject(poClass, c_szFunc, poFunc, poArgs);	// New Reference
 
 	if (!poRet)
 	{
@@ -361,7 +382,7 @@ bool __PyCallClassMemberFunc_ByPyString(PyObject* poClass, PyObject* poFuncName,
 		return false;
 	}
 
-	PyObject * poRet = PyObject_CallObject(poFunc, poArgs);	// New Reference
+	PyObject * poRet = __PyCallObject(poClass, PyString_AsString(poFuncName), poFunc, poArgs);	// New Reference
 
 	if (!poRet)
 	{
@@ -407,7 +428,7 @@ bool __PyCallClassMemberFunc(PyObject* poClass, PyObject * poFunc, PyObject* poA
 		return false;
 	}
 
-	PyObject * poRet = PyObject_CallObject(poFunc, poArgs);	// New Reference
+	PyObject * poRet = __PyCallObject(poClass, NULL, poFunc, poArgs);	// New Reference
 
 	if (!poRet)
 	{
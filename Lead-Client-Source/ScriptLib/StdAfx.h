@@ -15,6 +15,7 @@
 #include "PythonUtils.h"
 #include "PythonLauncher.h"
 #include "PythonMarshal.h"
+#include "PythonProfiler.h"
 #include "Resource.h"
 
 void initdbg();
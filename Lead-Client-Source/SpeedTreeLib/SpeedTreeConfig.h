@@ -41,6 +41,13 @@ const int c_nVertexShader_CompoundMatrix = 0;
 const int c_nVertexShader_WindMatrices = 54;
 const int c_nVertexShader_LeafTables = 4;
 const int c_nVertexShader_Fog = 85;
+const int c_nVertexShader_InstanceEye = 86;
+const int c_nVertexShader_InstanceFog = 87;
+const int c_nVertexShader_InstanceFogMode = 88;
+
+// pixel shader constant locations
+const int c_nPixelShader_InstanceShadow = 0;
+const int c_nPixelShader_InstanceFogColor = 1;
 
 // lighting
 const float c_afLightPosition[4] = { -0.707f, 0.0f, 0.707f, 0.0f };
@@ -108,6 +115,13 @@ const float	c_afLightGlobalAmbient[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
 // use fog
 #define WRAPPER_USE_FOG
 
+// hardware instancing for branches and fronds (needs vs_3_0/ps_3_0, otherwise falls back to one draw per tree)
+#define WRAPPER_USE_HARDWARE_INSTANCING
+
+#if defined WRAPPER_USE_HARDWARE_INSTANCING && (!defined WRAPPER_USE_NO_WIND || !defined WRAPPER_USE_STATIC_LIGHTING || !defined WRAPPER_RENDER_SELF_SHADOWS)
+	#error Hardware instancing supports only static lighting, no wind and self-shadows
+#endif
+
 // derived constants
 #ifdef WRAPPER_USE_GPU_WIND
 	#define BRANCHES_USE_SHADERS
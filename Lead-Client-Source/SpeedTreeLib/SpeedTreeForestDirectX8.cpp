@@ -46,6 +46,9 @@
 //	CSpeedTreeForestDirectX8::CSpeedTreeForestDirectX8
 
 CSpeedTreeForestDirectX8::CSpeedTreeForestDirectX8()  : m_dwBranchVertexShader(0), m_dwLeafVertexShader(0)
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+, m_dwBranchInstanceVertexShader(0), m_pBranchInstanceVS(NULL), m_pBranchInstancePS(NULL)
+#endif
 {
 }
 
@@ -80,6 +83,116 @@ bool CSpeedTreeForestDirectX8::InitVertexShaders(void)
 	return false;
 }
 
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeForestDirectX8::InitInstanceShaders
+//	vs_3_0/ps_3_0    ī忡 ̴  ʰ ó νϽ ׸.
+
+void CSpeedTreeForestDirectX8::InitInstanceShaders()
+{
+	if (m_pBranchInstanceVS)
+		return;
+
+	if (ms_d3dCaps.VertexShaderVersion < D3DVS_VERSION(3, 0) || ms_d3dCaps.PixelShaderVersion < D3DPS_VERSION(3, 0))
+	{
+		Tracenf("SpeedTree hardware instancing disabled: shader model 3 not supported");
+		return;
+	}
+
+	if (!m_dwBranchInstanceVertexShader)
+		m_dwBranchInstanceVertexShader = LoadBranchInstanceShader(m_pDx);
+
+	LPDIRECT3DVERTEXSHADER9 pVS = m_dwBranchInstanceVertexShader ? LoadBranchInstanceVertexProgram(m_pDx) : NULL;
+	LPDIRECT3DPIXELSHADER9 pPS = pVS ? LoadBranchInstancePixelProgram(m_pDx) : NULL;
+
+	if (!pPS)
+	{
+		SAFE_RELEASE(pVS);
+		Tracenf("SpeedTree hardware instancing disabled: failed to create shaders");
+		return;
+	}
+
+	m_pBranchInstanceVS = pVS;
+	m_pBranchInstancePS = pPS;
+}
+
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeForestDirectX8::BeginInstancing
+//	̴    ؽ װ  Ƿ   ¸  ѱ.
+
+bool CSpeedTreeForestDirectX8::BeginInstancing()
+{
+	if (!m_pBranchInstanceVS)
+		return false;
+
+	DWORD dwFogEnable = STATEMANAGER.GetRenderState(D3DRS_FOGENABLE);
+	DWORD dwFogMode = STATEMANAGER.GetRenderState(D3DRS_FOGVERTEXMODE);
+
+	// ̺ ׳ EXP2  ̴ 䳻 ʴ´.
+	if (dwFogEnable && (STATEMANAGER.GetRenderState(D3DRS_FOGTABLEMODE) != D3DFOG_NONE || (dwFogMode != D3DFOG_LINEAR && dwFogMode != D3DFOG_EXP && dwFogMode != D3DFOG_NONE)))
+		return false;
+
+	DWORD dwFogStart = STATEMANAGER.GetRenderState(D3DRS_FOGSTART);
+	DWORD dwFogEnd = STATEMANAGER.GetRenderState(D3DRS_FOGEND);
+	DWORD dwFogDensity = STATEMANAGER.GetRenderState(D3DRS_FOGDENSITY);
+	DWORD dwFogColor = STATEMANAGER.GetRenderState(D3DRS_FOGCOLOR);
+
+	float fFogStart = *((float *) &dwFogStart);
+	float fFogEnd = *((float *) &dwFogEnd);
+	float fFogDensity = *((float *) &dwFogDensity);
+
+	const D3DXVECTOR3 & c_rv3Eye = CCameraManager::Instance().GetCurrentCamera()->GetEye();
+
+	float afEye[4] = { c_rv3Eye.x, c_rv3Eye.y, c_rv3Eye.z, 1.0f };
+	float afFog[4] = { fFogEnd, fFogEnd > fFogStart ? 1.0f / (fFogEnd - fFogStart) : 0.0f, fFogDensity * 1.442695f, 0.0f };
+	float afFogMode[4] = { (dwFogEnable && dwFogMode != D3DFOG_NONE) ? 1.0f : 0.0f, dwFogMode == D3DFOG_EXP ? 1.0f : 0.0f, 0.0f, 0.0f };
+	float afFogColor[4] =
+	{
+		((dwFogColor >> 16) & 0xff) / 255.0f,
+		((dwFogColor >> 8) & 0xff) / 255.0f,
+		(dwFogColor & 0xff) / 255.0f,
+		1.0f
+	};
+
+	STATEMANAGER.SetVertexShaderConstant(c_nVertexShader_InstanceEye, afEye, 1);
+	STATEMANAGER.SetVertexShaderConstant(c_nVertexShader_InstanceFog, afFog, 1);
+	STATEMANAGER.SetVertexShaderConstant(c_nVertexShader_InstanceFogMode, afFogMode, 1);
+	STATEMANAGER.SetPixelShaderConstant(c_nPixelShader_InstanceFogColor, afFogColor, 1);
+
+	STATEMANAGER.SetVertexDeclaration(m_dwBranchInstanceVertexShader);
+	STATEMANAGER.SetVertexShader(m_pBranchInstanceVS);
+	STATEMANAGER.SetPixelShader(m_pBranchInstancePS);
+
+	//  ׽Ʈ νϽ  ޶ ȼ ̴ texkill  Ѵ.
+	STATEMANAGER.SetRenderState(D3DRS_ALPHAREF, 0);
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeForestDirectX8::EndInstancing
+
+void CSpeedTreeForestDirectX8::EndInstancing()
+{
+	STATEMANAGER.SetVertexShader(NULL);
+	STATEMANAGER.SetPixelShader(NULL);
+	STATEMANAGER.SetStreamSource(1, NULL, 0);
+	STATEMANAGER.SetVertexDeclaration(m_dwBranchVertexShader);
+}
+
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeForestDirectX8::SetInstanceShadowConstant
+//	Setup*ForTreeType   ؽĸ  ٿ  ó ׸  ׸.
+
+void CSpeedTreeForestDirectX8::SetInstanceShadowConstant()
+{
+	LPDIRECT3DBASETEXTURE9 lpd3dTexture = NULL;
+	STATEMANAGER.GetTexture(1, &lpd3dTexture);
+
+	float afShadow[4] = { lpd3dTexture ? 1.0f : 0.0f, 0.0f, 0.0f, 0.0f };
+	STATEMANAGER.SetPixelShaderConstant(c_nPixelShader_InstanceShadow, afShadow, 1);
+}
+#endif
+
 bool CSpeedTreeForestDirectX8::SetRenderingDevice(LPDIRECT3DDEVICE9 lpDevice)
 {
 	m_pDx = lpDevice;
@@ -87,6 +200,10 @@ bool CSpeedTreeForestDirectX8::SetRenderingDevice(LPDIRECT3DDEVICE9 lpDevice)
 	if (!InitVertexShaders())
 		return false;
 
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+	InitInstanceShaders();
+#endif
+
 	const float c_afLightPosition[4] = { -0.707f, -0.300f, 0.707f, 0.0f };
 	const float	c_afLightAmbient[4] = { 0.5f, 0.5f, 0.5f, 1.0f };
 	const float	c_afLightDiffuse[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
@@ -221,6 +338,14 @@ void CSpeedTreeForestDirectX8::Render(unsigned long ulRenderBitVector)
 	// choose fixed function pipeline or custom shader for fronds and branches
 	STATEMANAGER.SetVertexDeclaration(m_dwBranchVertexShader);
 
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+	// ׸ڸ, ̴ϸ ٸ ī޶ ؽ  Ƿ   ׸.
+	bool isInstancing = false;
+
+	if (!(ulRenderBitVector & Forest_RenderToShadow) && !(ulRenderBitVector & Forest_RenderToMiniMap))
+		isInstancing = BeginInstancing();
+#endif
+
 	// render branches
 	if (ulRenderBitVector & Forest_RenderBranches)
 	{
@@ -233,6 +358,15 @@ void CSpeedTreeForestDirectX8::Render(unsigned long ulRenderBitVector)
 			
 			pMainTree->SetupBranchForTreeType();
 
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+			if (isInstancing)
+			{
+				SetInstanceShadowConstant();
+				pMainTree->RenderInstancedBranches();
+				continue;
+			}
+#endif
+
 			for (UINT i = 0; i < uiCount; ++i)
 				if (ppInstances[i]->isShow())
 					ppInstances[i]->RenderBranches();
@@ -254,11 +388,25 @@ void CSpeedTreeForestDirectX8::Render(unsigned long ulRenderBitVector)
 
 			pMainTree->SetupFrondForTreeType();
 
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+			if (isInstancing)
+			{
+				SetInstanceShadowConstant();
+				pMainTree->RenderInstancedFronds();
+				continue;
+			}
+#endif
+
 			for (UINT i = 0; i < uiCount; ++i)
 				if (ppInstances[i]->isShow())
 					ppInstances[i]->RenderFronds();
 		}
 	}
+
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+	if (isInstancing)
+		EndInstancing();
+#endif
 	
 	// render leaves
 	if (ulRenderBitVector & Forest_RenderLeaves)
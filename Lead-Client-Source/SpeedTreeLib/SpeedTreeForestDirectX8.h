@@ -36,6 +36,7 @@
 //#include <map>
 #define SPEEDTREE_DATA_FORMAT_DIRECTX
 
+#include "SpeedTreeConfig.h"
 #include "SpeedTreeForest.h"
 #include "SpeedTreeMaterial.h"
 
@@ -55,10 +56,23 @@ class CSpeedTreeForestDirectX8 : public CSpeedTreeForest, public CGraphicBase, p
 		
 	private:
 		bool			InitVertexShaders();
+
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+		void			InitInstanceShaders();
+		bool			BeginInstancing();
+		void			EndInstancing();
+		void			SetInstanceShadowConstant();
+#endif
 		
 	private:
 		LPDIRECT3DDEVICE9		m_pDx;							// the rendering context
 
 		LPDIRECT3DVERTEXDECLARATION9 m_dwBranchVertexShader;			// branch/frond vertex shaders		
 		LPDIRECT3DVERTEXDECLARATION9 m_dwLeafVertexShader;			// leaf vertex shader
+
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+		LPDIRECT3DVERTEXDECLARATION9 m_dwBranchInstanceVertexShader;	// branch/frond + instance stream declaration
+		LPDIRECT3DVERTEXSHADER9	m_pBranchInstanceVS;			// NULL if the card can't do vs_3_0/ps_3_0
+		LPDIRECT3DPIXELSHADER9	m_pBranchInstancePS;
+#endif
 };
@@ -984,6 +984,110 @@ void CSpeedTreeWrapper::RenderFronds(void) const
 }
 
 
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeWrapper::RenderInstancedBranches
+
+void CSpeedTreeWrapper::RenderInstancedBranches(void) const
+{
+	RenderInstancedGeometry(SpeedTree_BranchGeometry);
+}
+
+
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeWrapper::RenderInstancedFronds
+
+void CSpeedTreeWrapper::RenderInstancedFronds(void) const
+{
+	RenderInstancedGeometry(SpeedTree_FrondGeometry);
+}
+
+
+///////////////////////////////////////////////////////////////////////  
+//	CSpeedTreeWrapper::RenderInstancedGeometry
+//
+//	 Ʈ Setup*ForTreeType  Ҹ. ̴ νϽ LOD  
+//	ġ  ׽Ʈ  νϽ Ʈ(stream 1) ְ LOD    ׸.
+
+void CSpeedTreeWrapper::RenderInstancedGeometry(int nGeometry) const
+{
+	const bool c_isBranch = (nGeometry == SpeedTree_BranchGeometry);
+	const unsigned short * c_pIndexCounts = c_isBranch ? m_pBranchIndexCounts : m_pFrondIndexCounts;
+	const UINT c_uVertexCount = c_isBranch ? m_unBranchVertexCount : m_unFrondVertexCount;
+	const int c_nNumLods = c_isBranch ? m_pSpeedTree->GetNumBranchLodLevels() : m_pSpeedTree->GetNumFrondLodLevels();
+
+	if (!c_pIndexCounts || c_uVertexCount == 0 || c_nNumLods <= 0)
+		return;
+
+	static std::vector<std::vector<SInstanceVertex> > s_kVct_kInstanceByLod;
+
+	if (s_kVct_kInstanceByLod.size() < (size_t) c_nNumLods)
+		s_kVct_kInstanceByLod.resize(c_nNumLods);
+
+	for (int i = 0; i < c_nNumLods; ++i)
+		s_kVct_kInstanceByLod[i].clear();
+
+	for (std::vector<CSpeedTreeWrapper *>::const_iterator itor = m_vInstances.begin(); itor != m_vInstances.end(); ++itor)
+	{
+		CSpeedTreeWrapper * pInstance = *itor;
+
+		if (!pInstance->isShow())
+			continue;
+
+		pInstance->m_pSpeedTree->GetGeometry(*pInstance->m_pGeometryCache, nGeometry);
+
+		float fAlphaTestValue;
+		int nLod;
+
+		if (c_isBranch)
+		{
+			fAlphaTestValue = pInstance->m_pGeometryCache->m_fBranchAlphaTestValue;
+			nLod = pInstance->m_pGeometryCache->m_sBranches.m_nDiscreteLodLevel;
+		}
+		else
+		{
+			fAlphaTestValue = pInstance->m_pGeometryCache->m_fFrondAlphaTestValue;
+			nLod = pInstance->m_pGeometryCache->m_sFronds.m_nDiscreteLodLevel;
+		}
+
+		if (fAlphaTestValue <= 0.0f || nLod < 0 || nLod >= c_nNumLods || c_pIndexCounts[nLod] <= 2)
+			continue;
+
+		const float * c_pfPosition = pInstance->m_pSpeedTree->GetTreePosition();
+
+		SInstanceVertex kInstance;
+		kInstance.m_afPosition[0] = c_pfPosition[0];
+		kInstance.m_afPosition[1] = c_pfPosition[1];
+		kInstance.m_afPosition[2] = c_pfPosition[2];
+		// D3DCMP_GREATER      ܰ ÷ texkill Ѵ.
+		kInstance.m_fAlphaRef = (DWORD(fAlphaTestValue) + 0.5f) / 255.0f;
+
+		s_kVct_kInstanceByLod[nLod].push_back(kInstance);
+	}
+
+	for (int nLod = 0; nLod < c_nNumLods; ++nLod)
+	{
+		const std::vector<SInstanceVertex> & c_rkVct_kInstance = s_kVct_kInstanceByLod[nLod];
+
+		if (c_rkVct_kInstance.empty())
+			continue;
+
+		if (!SetDynamicStream(&c_rkVct_kInstance[0], c_rkVct_kInstance.size(), sizeof(SInstanceVertex), 1))
+			continue;
+
+		STATEMANAGER.SetStreamSourceFreq(0, D3DSTREAMSOURCE_INDEXEDDATA | c_rkVct_kInstance.size());
+		STATEMANAGER.SetStreamSourceFreq(1, D3DSTREAMSOURCE_INSTANCEDATA | 1);
+
+		ms_faceCount += (c_pIndexCounts[nLod] - 2) * c_rkVct_kInstance.size();
+		STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLESTRIP, 0, c_uVertexCount, 0, c_pIndexCounts[nLod] - 2);
+	}
+
+	STATEMANAGER.SetStreamSourceFreq(0, 1);
+	STATEMANAGER.SetStreamSourceFreq(1, 1);
+}
+#endif
+
+
 ///////////////////////////////////////////////////////////////////////  
 //	CSpeedTreeWrapper::SetupLeafForTreeType
 
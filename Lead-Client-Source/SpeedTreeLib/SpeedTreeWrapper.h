@@ -34,6 +34,7 @@
 ///////////////////////////////////////////////////////////////////////  
 //	Include files
 
+#include "SpeedTreeConfig.h"
 #include "SpeedTreeMaterial.h"
 #include <speedtree/SpeedTreeRT.h>
 
@@ -122,6 +123,11 @@ public:
 	void                        RenderFronds(void) const;
 	void						RenderLeaves(void) const;
 	void						RenderBillboards(void) const;
+
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+	void						RenderInstancedBranches(void) const;
+	void						RenderInstancedFronds(void) const;
+#endif
 	
 	// instancing
 	CSpeedTreeWrapper **		GetInstances(unsigned int& nCount);
@@ -150,6 +156,9 @@ private:
 	void						SetupFrondBuffers(void);
 	void						SetupLeafBuffers(void);
 	void						PositionTree(void) const;
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+	void						RenderInstancedGeometry(int nGeometry) const;
+#endif
 	static bool					LoadTexture(const char* pFilename, CGraphicImageInstance & rImage);
 	void						SetShaderConstants(const float* pMaterial) const;
 	
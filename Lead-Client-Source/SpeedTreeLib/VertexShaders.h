@@ -268,3 +268,172 @@ static LPDIRECT3DVERTEXDECLARATION9 LoadLeafShader(LPDIRECT3DDEVICE9 pDx)
 
 	return dwShader;
 }
+
+#ifdef WRAPPER_USE_HARDWARE_INSTANCING
+///////////////////////////////////////////////////////////////////////  
+// Instance Vertex Structure (stream 1, one per tree instance)
+
+struct SInstanceVertex
+{
+	FLOAT			m_afPosition[3];		// tree position
+	FLOAT			m_fAlphaRef;			// LOD fade alpha test value (0.0 ~ 1.0)
+};
+
+
+///////////////////////////////////////////////////////////////////////  
+//	Instanced Branch/Frond Vertex Program
+
+static const char g_achBranchInstanceVertexProgram[] = 
+{
+		"vs_3_0\n"												// instancing needs shader model 3
+
+		"def		c95,		1.0,		0.0,		0.0,		0.0\n"
+
+		"dcl_position	v0\n"
+		"dcl_color		v1\n"
+		"dcl_texcoord0	v2\n"
+		"dcl_texcoord1	v3\n"
+		"dcl_texcoord3	v4\n"									// per instance data
+
+		"dcl_position	o0\n"
+		"dcl_color		o1\n"
+		"dcl_texcoord0	o2.xy\n"
+		"dcl_texcoord1	o3.xy\n"
+		"dcl_texcoord2	o4.xy\n"								// x = fog factor, y = alpha test value
+
+		"add		r0.xyz,		v0,			v4\n"				// translate to tree's position
+		"mov		r0.w,		c95.x\n"
+		"m4x4		o0,			r0,			c0\n"				// project to screen
+
+		"mov		o1,			v1\n"							// pass color through
+		"mov		o2.xy,		v2\n"							// pass texcoord0 through
+		"mov		o3.xy,		v3\n"							// pass shadow texcoords through
+
+		"sub		r1.xyz,		r0,			c86\n"				// find range to vertex (same as D3DRS_RANGEFOGENABLE)
+		"dp3		r1.x,		r1,			r1\n"
+		"rsq		r1.y,		r1.x\n"
+		"rcp		r1.x,		r1.y\n"
+
+		"sub		r2.x,		c87.x,		r1.x\n"				// linear fog
+		"mul_sat	r2.x,		r2.x,		c87.y\n"
+		"mul		r2.y,		r1.x,		c87.z\n"			// exp fog (density is pre-scaled by log2(e))
+		"exp		r2.y,		-r2.y\n"
+		"lrp		r2.z,		c88.y,		r2.y,		r2.x\n"	// choose fog mode
+		"lrp		o4.x,		c88.x,		r2.z,		c95.x\n"	// no fog if disabled
+		"mov		o4.y,		v4.w\n"
+};
+
+
+///////////////////////////////////////////////////////////////////////  
+//	Instanced Branch/Frond Pixel Program
+//	stage 0 texture * diffuse, stage 1 self-shadow modulate, alpha test and fog done here
+//	because fixed function texture stages and vertex fog don't work with vs_3_0
+
+static const char g_achBranchInstancePixelProgram[] = 
+{
+		"ps_3_0\n"
+
+		"def		c3,			1.0,		0.0,		0.0,		0.0\n"
+
+		"dcl_color		v0\n"
+		"dcl_texcoord0	v1.xy\n"
+		"dcl_texcoord1	v2.xy\n"
+		"dcl_texcoord2	v3.xy\n"
+		"dcl_2d			s0\n"
+		"dcl_2d			s1\n"
+
+		"texld		r0,			v1,			s0\n"
+		"mul		r0,			r0,			v0\n"				// texture * diffuse
+
+		"sub		r1,			r0.w,		v3.y\n"				// alpha test
+		"texkill	r1\n"
+
+		"texld		r1,			v2,			s1\n"
+		"lrp		r1.xyz,		c0.x,		r1,			c3.x\n"	// no self-shadow if no texture is bound
+		"mul		r0.xyz,		r0,			r1\n"
+
+		"lrp		r0.xyz,		v3.x,		r0,			c1\n"	// fog
+		"mov		oC0,		r0\n"
+};
+
+
+///////////////////////////////////////////////////////////////////////  
+//	LoadBranchInstanceShader
+
+static LPDIRECT3DVERTEXDECLARATION9 LoadBranchInstanceShader(LPDIRECT3DDEVICE9 pDx)
+{
+	// stream 0 is the branch/frond vertex buffer, stream 1 has one SInstanceVertex per tree
+	D3DVERTEXELEMENT9 pBranchInstanceShaderDecl[] = {
+		{ 0, 0, D3DDECLTYPE_FLOAT3, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_POSITION, 0 },
+		{ 0, 12, D3DDECLTYPE_D3DCOLOR, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_COLOR, 0 },
+		{ 0, 16, D3DDECLTYPE_FLOAT2, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_TEXCOORD, 0 },
+		{ 0, 24, D3DDECLTYPE_FLOAT2, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_TEXCOORD, 1 },
+		{ 1, 0, D3DDECLTYPE_FLOAT4, D3DDECLMETHOD_DEFAULT, D3DDECLUSAGE_TEXCOORD, 3 },
+		D3DDECL_END()
+	};
+
+	LPDIRECT3DVERTEXDECLARATION9 dwShader = NULL;
+
+	if (pDx->CreateVertexDeclaration(pBranchInstanceShaderDecl, &dwShader) != D3D_OK)
+		TraceError("Failed to create branch instance vertex declaration.");
+
+	return dwShader;
+}
+
+
+///////////////////////////////////////////////////////////////////////  
+//	LoadBranchInstanceVertexProgram, LoadBranchInstancePixelProgram
+
+static LPD3DXBUFFER AssembleInstanceProgram(const char * c_szProgram, UINT uLength)
+{
+	LPD3DXBUFFER pCode = NULL;
+	LPD3DXBUFFER pError = NULL;
+
+	if (FAILED(D3DXAssembleShader(c_szProgram, uLength, NULL, NULL, 0, &pCode, &pError)))
+	{
+		TraceError("Failed to assemble branch instance shader: %s", pError ? (const char *) pError->GetBufferPointer() : "unknown");
+
+		if (pError)
+			pError->Release();
+
+		return NULL;
+	}
+
+	if (pError)
+		pError->Release();
+
+	return pCode;
+}
+
+static LPDIRECT3DVERTEXSHADER9 LoadBranchInstanceVertexProgram(LPDIRECT3DDEVICE9 pDx)
+{
+	LPD3DXBUFFER pCode = AssembleInstanceProgram(g_achBranchInstanceVertexProgram, sizeof(g_achBranchInstanceVertexProgram) - 1);
+
+	if (!pCode)
+		return NULL;
+
+	LPDIRECT3DVERTEXSHADER9 pShader = NULL;
+
+	if (FAILED(pDx->CreateVertexShader((const DWORD *) pCode->GetBufferPointer(), &pShader)))
+		TraceError("Failed to create branch instance vertex shader.");
+
+	pCode->Release();
+	return pShader;
+}
+
+static LPDIRECT3DPIXELSHADER9 LoadBranchInstancePixelProgram(LPDIRECT3DDEVICE9 pDx)
+{
+	LPD3DXBUFFER pCode = AssembleInstanceProgram(g_achBranchInstancePixelProgram, sizeof(g_achBranchInstancePixelProgram) - 1);
+
+	if (!pCode)
+		return NULL;
+
+	LPDIRECT3DPIXELSHADER9 pShader = NULL;
+
+	if (FAILED(pDx->CreatePixelShader((const DWORD *) pCode->GetBufferPointer(), &pShader)))
+		TraceError("Failed to create branch instance pixel shader.");
+
+	pCode->Release();
+	return pShader;
+}
+#endif
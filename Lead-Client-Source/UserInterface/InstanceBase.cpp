@@ -385,6 +385,9 @@ DWORD CInstanceBase::ms_dwDeformCounter=0;
 
 CDynamicPool<CInstanceBase> CInstanceBase::ms_kPool;
 
+DWORD CInstanceBase::ms_dwInterpolationDelay=CInstanceBase::INTERPOLATION_DELAY_DEFAULT;
+float CInstanceBase::ms_fExtrapolationLimit=CInstanceBase::EXTRAPOLATION_LIMIT_DEFAULT;
+
 bool CInstanceBase::__IsInDustRange()
 {
 	if (!__IsExistMainInstance())
@@ -631,6 +634,15 @@ void CInstanceBase::CreateSystem(UINT uCapacity)
 
 	ms_fDustGap=250.0f;
 	ms_fHorseDustGap=500.0f;
+
+	ms_dwInterpolationDelay=INTERPOLATION_DELAY_DEFAULT;
+	ms_fExtrapolationLimit=EXTRAPOLATION_LIMIT_DEFAULT;
+}
+
+void CInstanceBase::SetMovementInterpolation(UINT uDelay, float fExtrapolationLimit)
+{
+	ms_dwInterpolationDelay=uDelay;
+	ms_fExtrapolationLimit=fExtrapolationLimit;
 }
 
 CInstanceBase* CInstanceBase::New()
@@ -1197,6 +1209,18 @@ void CInstanceBase::PushTCPState(DWORD dwCmdTime, const TPixelPosition& c_rkPPos
 	int nNetworkGap=ELTimer_GetServerFrameMSec()-dwCmdTime;
 	
 	m_nAverageNetworkGap=(m_nAverageNetworkGap*70+nNetworkGap*30)/100;
+
+	//     ʰ  Ŷ  о  Ŷ Ѳ Ǯ.
+	//  ª   ϰ     ξ 鸲 ۰ ϰ Ѵ.
+	if (!m_isNetworkGapFloor || nNetworkGap<m_nNetworkGapFloor)
+	{
+		m_nNetworkGapFloor=nNetworkGap;
+		m_isNetworkGapFloor=true;
+	}
+	else
+	{
+		m_nNetworkGapFloor+=(nNetworkGap-m_nNetworkGapFloor+NETWORK_GAP_FLOOR_RISE-1)/NETWORK_GAP_FLOOR_RISE;
+	}
 	
 	/*
 	if (m_dwBaseCmdTime == 0)
@@ -1212,7 +1236,12 @@ void CInstanceBase::PushTCPState(DWORD dwCmdTime, const TPixelPosition& c_rkPPos
 
 	SCommand kCmdNew;
 	kCmdNew.m_kPPosDst = c_rkPPosDst;
-	kCmdNew.m_dwChkTime = dwCmdTime+m_nAverageNetworkGap;//m_dwBaseChkTime + (dwCmdTime - m_dwBaseCmdTime);// + nNetworkGap;
+	kCmdNew.m_dwChkTime = dwCmdTime+m_nNetworkGapFloor+ms_dwInterpolationDelay;//m_dwBaseChkTime + (dwCmdTime - m_dwBaseCmdTime);// + nNetworkGap;
+
+	//  پ Ŀ ť   ״ д
+	if (!m_kQue_kCmdNew.empty() && kCmdNew.m_dwChkTime<m_kQue_kCmdNew.back().m_dwChkTime)
+		kCmdNew.m_dwChkTime = m_kQue_kCmdNew.back().m_dwChkTime;
+
 	kCmdNew.m_dwCmdTime = dwCmdTime;
 	kCmdNew.m_fDstRot = fDstRot;
 	kCmdNew.m_eFunc = eFunc;
@@ -1630,7 +1659,7 @@ void CInstanceBase::MovementProcess()
 			SetAdvancingRotation(fDstRot);
 
 			//  Ͻð ʾ ʹ  ̵ߴٸ..
-			if (fRestLen < -100.0f)
+			if (fRestLen < -ms_fExtrapolationLimit)
 			{
 				NEW_SetSrcPixelPosition(kPPosCur);
 
@@ -2081,6 +2110,7 @@ void CInstanceBase::SetKiller(bool bFlag)
 void CInstanceBase::SetPartyMemberFlag(bool bFlag)
 {
 	m_isPartyMember = bFlag;
+	m_GraphicThingInstance.SetPartyMember(bFlag);
 }
 
 void CInstanceBase::SetStateFlags(DWORD dwStateFlags)
@@ -3055,6 +3085,8 @@ void CInstanceBase::__Initialize()
 	m_dwLastDmgActorVID=0;
 
 	m_nAverageNetworkGap=0;
+	m_nNetworkGapFloor=0;
+	m_isNetworkGapFloor=false;
 	m_dwNextUpdateHeightTime=0;
 
 	// Moving by keyboard
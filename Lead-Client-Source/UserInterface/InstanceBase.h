@@ -63,6 +63,13 @@ class CInstanceBase
 			FUNC_SKILL = 0x80,
 		};
 
+		enum
+		{
+			INTERPOLATION_DELAY_DEFAULT = 100,	// ms. Ŷ   鸲 Ŀ Ѵ
+			EXTRAPOLATION_LIMIT_DEFAULT = 100,	//  Ŷ  ǥ    ִ Ÿ
+			NETWORK_GAP_FLOOR_RISE = 16,		//  þ   1/16  ø
+		};
+
 		enum
 		{
 			AFFECT_YMIR,
@@ -393,6 +400,10 @@ class CInstanceBase
 		static void SetDustGap(float fDustGap);
 		static void SetHorseDustGap(float fDustGap);
 
+		// ٸ  ̵ Ŷ  ð + ּ  + uDelay  Ѵ.   Ŷ   ݴ Ǯ.
+		//  Ŷ    fExtrapolationLimit ŭ  ȴٰ ǥ ư.
+		static void SetMovementInterpolation(UINT uDelay, float fExtrapolationLimit);
+
 		static void SetEmpireNameMode(bool isEnable);
 		static const D3DXCOLOR& GetIndexedNameColor(UINT eNameColor);
 
@@ -424,6 +435,8 @@ class CInstanceBase
 		static DWORD ms_adwCRCAffectEffect[EFFECT_NUM];
 		static float ms_fDustGap;
 		static float ms_fHorseDustGap;
+		static DWORD ms_dwInterpolationDelay;
+		static float ms_fExtrapolationLimit;
 
 	public:
 		CInstanceBase();
@@ -963,6 +976,8 @@ class CInstanceBase
 		DWORD					m_dwLastDmgActorVID;
 
 		LONG					m_nAverageNetworkGap;
+		LONG					m_nNetworkGapFloor;		// ݱ   ª . þ  õõ 󰣴
+		bool					m_isNetworkGapFloor;
 		DWORD					m_dwNextUpdateHeightTime;
 
 		bool					m_isGoing;
@@ -5,6 +5,8 @@
 
 #include "AbstractPlayer.h"
 
+#include "../gamelib/RaceManager.h"
+
 void SNetworkActorData::UpdatePosition()
 {
 	DWORD dwClientCurTime=ELTimer_GetMSec();
@@ -148,6 +150,7 @@ void CNetworkActorManager::SetMainActorVID(DWORD dwVID)
 	m_lMainPosY=0;
 
 	m_kNetActorDict.clear();
+	m_kSet_dwRequestedRace.clear();
 }
 
 void CNetworkActorManager::Update()
@@ -155,12 +158,36 @@ void CNetworkActorManager::Update()
 	__OLD_Update();
 }
 
+struct FNetActorDistanceCompare
+{
+	LONG m_lMainPosX;
+	LONG m_lMainPosY;
+
+	FNetActorDistanceCompare(LONG lMainPosX, LONG lMainPosY) : m_lMainPosX(lMainPosX), m_lMainPosY(lMainPosY)
+	{
+	}
+
+	double GetDistanceSquare(const SNetworkActorData* c_pkNetActorData) const
+	{
+		double dx=double(c_pkNetActorData->m_lCurX-m_lMainPosX);
+		double dy=double(c_pkNetActorData->m_lCurY-m_lMainPosY);
+		return dx*dx+dy*dy;
+	}
+
+	bool operator () (const SNetworkActorData* c_pkLeft, const SNetworkActorData* c_pkRight) const
+	{
+		return GetDistanceSquare(c_pkLeft)<GetDistanceSquare(c_pkRight);
+	}
+};
+
 void CNetworkActorManager::__OLD_Update()
 {
 	__UpdateMainActor();
 
 	CPythonCharacterManager& rkChrMgr=__GetCharacterManager();
 
+	m_kVct_pkNetActorDataToCreate.clear();
+
 	std::map<DWORD, SNetworkActorData>::iterator i;
 	for (i=m_kNetActorDict.begin(); i!=m_kNetActorDict.end(); ++i)
 	{
@@ -171,18 +198,45 @@ void CNetworkActorManager::__OLD_Update()
 		if (!pkInstFind)
 		{
 			if (__IsVisibleActor(rkNetActorData))
-				__AppendCharacterManagerActor(rkNetActorData);
+				m_kVct_pkNetActorDataToCreate.push_back(&rkNetActorData);
 		}
 	}
+
+	if (m_kVct_pkNetActorDataToCreate.empty())
+		return;
+
+	//  ó Ѳ   ߹Ƿ  ͺ  ðŭ 
+	//    ѱ. ּ ϳ .
+	std::sort(m_kVct_pkNetActorDataToCreate.begin(), m_kVct_pkNetActorDataToCreate.end(), FNetActorDistanceCompare(m_lMainPosX, m_lMainPosY));
+
+	std::vector<DWORD> kVct_dwFailedVID;
+	DWORD dwStartTime=ELTimer_GetMSec();
+
+	for (size_t n=0; n<m_kVct_pkNetActorDataToCreate.size(); ++n)
+	{
+		if (n>0 && ELTimer_GetMSec()-dwStartTime>=ACTOR_CREATE_TIME_BUDGET_MSEC)
+			break;
+
+		SNetworkActorData* pkNetActorData=m_kVct_pkNetActorDataToCreate[n];
+		if (!__AppendCharacterManagerActor(*pkNetActorData))
+			kVct_dwFailedVID.push_back(pkNetActorData->m_dwVID);
+	}
+
+	m_kVct_pkNetActorDataToCreate.clear();
+
+	//    ʹ AppendActor ó    ٽ õ ʰ Ѵ
+	for (size_t n=0; n<kVct_dwFailedVID.size(); ++n)
+		m_kNetActorDict.erase(kVct_dwFailedVID[n]);
 }
 
+//    ʹ  ĳͰ ƴϸ Update    ͸ Ѵ
 CInstanceBase* CNetworkActorManager::__FindActor(SNetworkActorData& rkNetActorData, LONG lDstX, LONG lDstY)
 {
 	CPythonCharacterManager& rkChrMgr=__GetCharacterManager();
 	CInstanceBase * pkInstFind = rkChrMgr.GetInstancePtr(rkNetActorData.m_dwVID);
 	if (!pkInstFind)
 	{
-		if (__IsVisiblePos(lDstX, lDstY))
+		if (__IsMainActorVID(rkNetActorData.m_dwVID) && __IsVisiblePos(lDstX, lDstY))
 			return __AppendCharacterManagerActor(rkNetActorData);
 
 		return NULL;
@@ -197,7 +251,7 @@ CInstanceBase* CNetworkActorManager::__FindActor(SNetworkActorData& rkNetActorDa
 	CInstanceBase * pkInstFind = rkChrMgr.GetInstancePtr(rkNetActorData.m_dwVID);
 	if (!pkInstFind)
 	{
-		if (__IsVisibleActor(rkNetActorData))
+		if (__IsMainActorVID(rkNetActorData.m_dwVID) && __IsVisibleActor(rkNetActorData))
 			return __AppendCharacterManagerActor(rkNetActorData);
 
 		return NULL;
@@ -206,6 +260,41 @@ CInstanceBase* CNetworkActorManager::__FindActor(SNetworkActorData& rkNetActorDa
 	return pkInstFind;
 }
 
+// Ͱ   𵨰 ⺻   ε 忡 ̸ од
+void CNetworkActorManager::__RequestActorResource(DWORD dwRace)
+{
+	if (m_kSet_dwRequestedRace.end()!=m_kSet_dwRequestedRace.find(dwRace))
+		return;
+
+	m_kSet_dwRequestedRace.insert(dwRace);
+
+	CRaceData* pkRaceData;
+	if (!CRaceManager::Instance().GetRaceDataPointer(dwRace, &pkRaceData))
+		return;
+
+	CResourceManager& rkResMgr=CResourceManager::Instance();
+
+	const char* c_szBaseModelFileName=pkRaceData->GetBaseModelFileName();
+	if (c_szBaseModelFileName && c_szBaseModelFileName[0])
+		rkResMgr.RequestBackgroundLoading(c_szBaseModelFileName);
+
+	CRaceData::TMotionModeData* pkMotionModeData;
+	if (!pkRaceData->GetMotionModeDataPointer(CRaceMotionData::MODE_GENERAL, &pkMotionModeData))
+		return;
+
+	CRaceData::TMotionVectorMap::iterator i;
+	for (i=pkMotionModeData->MotionVectorMap.begin(); i!=pkMotionModeData->MotionVectorMap.end(); ++i)
+	{
+		const CRaceData::TMotionVector& c_rkVct_kMotion=i->second;
+
+		for (size_t n=0; n<c_rkVct_kMotion.size(); ++n)
+		{
+			if (c_rkVct_kMotion[n].pMotion)
+				rkResMgr.RequestBackgroundLoading(c_rkVct_kMotion[n].pMotion->GetFileName());
+		}
+	}
+}
+
 void CNetworkActorManager::__RemoveAllGroundItems()
 {
 	CPythonItem& rkItemMgr=CPythonItem::Instance();
@@ -402,6 +491,11 @@ CInstanceBase* CNetworkActorManager::__AppendCharacterManagerActor(SNetworkActor
 		kPPosDst.z=0;
 		pNewInstance->PushTCPState(rkNetActorData.m_dwServerSrcTime+dwElapsedTime, kPPosDst, rkNetActorData.m_fRot, CInstanceBase::FUNC_MOVE, 0);		
 	}
+
+	// ʰ  ͵  ̿    ʰ Ѵ
+	if (rkNetActorData.m_dwOwnerVID)
+		pNewInstance->NEW_SetOwner(rkNetActorData.m_dwOwnerVID);
+
 	return pNewInstance;
 }
 
@@ -430,6 +524,14 @@ void CNetworkActorManager::AppendActor(const SNetworkActorData& c_rkNetActorData
 	SNetworkActorData& rkNetActorData=m_kNetActorDict[c_rkNetActorData.m_dwVID];
 	rkNetActorData=c_rkNetActorData;
 
+	//   ʹ ͸ ΰ Update   .  ĳͿ
+	// ̹ ִ ( Ÿ/ ٽ  ) ٷ ٽ .
+	if (!__IsMainActorVID(c_rkNetActorData.m_dwVID) && !__GetCharacterManager().GetInstancePtr(c_rkNetActorData.m_dwVID))
+	{
+		__RequestActorResource(c_rkNetActorData.m_dwRace);
+		return;
+	}
+
 	if (__IsVisibleActor(rkNetActorData))
 	{
 		if (!__AppendCharacterManagerActor(rkNetActorData))
@@ -504,6 +606,7 @@ void CNetworkActorManager::UpdateActor(const SNetworkUpdateActorData& c_rkNetUpd
 	rkNetActorData.m_dwHair=c_rkNetUpdateActorData.m_dwHair;
 	rkNetActorData.m_sAlignment=c_rkNetUpdateActorData.m_sAlignment;
 	rkNetActorData.m_byPKMode=c_rkNetUpdateActorData.m_byPKMode;
+	rkNetActorData.m_dwStateFlags=c_rkNetUpdateActorData.m_dwStateFlags;
 }
 
 void CNetworkActorManager::MoveActor(const SNetworkMoveActorData& c_rkNetMoveActorData)
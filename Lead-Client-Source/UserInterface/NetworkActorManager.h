@@ -154,11 +154,21 @@ class CNetworkActorManager : public CReferenceObject
 
 		CPythonCharacterManager& __GetCharacterManager();
 
+		void __RequestActorResource(DWORD dwRace);
+
 	protected:
+		enum
+		{
+			ACTOR_CREATE_TIME_BUDGET_MSEC = 4,	//  ӿ  ͸    ð
+		};
+
 		DWORD m_dwMainVID;
 
 		LONG m_lMainPosX;
 		LONG m_lMainPosY;
 
 		std::map<DWORD, SNetworkActorData> m_kNetActorDict;
+
+		std::vector<SNetworkActorData*> m_kVct_pkNetActorDataToCreate;
+		std::set<DWORD> m_kSet_dwRequestedRace;
 };
@@ -364,6 +364,11 @@ inline void Print_TPacketGCCharacterAdd(FILE* f, const void* data, int size) {
     fprintf(f, "dwVID=%u angle=%.2f x=%ld y=%ld z=%ld bType=%u wRaceNum=%u bMovingSpeed=%u bAttackSpeed=%u bStateFlag=%u dwAffectFlag=[2]\n", p.dwVID, p.angle, p.x, p.y, p.z, p.bType, p.wRaceNum, p.bMovingSpeed, p.bAttackSpeed, p.bStateFlag);
 }
 
+inline void Print_TPacketGCCharacterAddBulk(FILE* f, const void* data, int size) {
+    const TPacketGCCharacterAddBulk& p = *(const TPacketGCCharacterAddBulk*)data;
+    fprintf(f, "wSize=%u\n", p.wSize);
+}
+
 inline void Print_TPacketGCCharacterDelete(FILE* f, const void* data, int size) {
     const TPacketGCCharacterDelete& p = *(const TPacketGCCharacterDelete*)data;
     fprintf(f, "id=%u\n", p.id);
@@ -374,6 +379,16 @@ inline void Print_TPacketGCMove(FILE* f, const void* data, int size) {
     fprintf(f, "bFunc=%u bArg=%u bRot=%u dwVID=%u lX=%ld lY=%ld dwTime=%u dwDuration=%u\n", p.bFunc, p.bArg, p.bRot, p.dwVID, p.lX, p.lY, p.dwTime, p.dwDuration);
 }
 
+inline void Print_TPacketGCMoveBulk(FILE* f, const void* data, int size) {
+    const TPacketGCMoveBulk& p = *(const TPacketGCMoveBulk*)data;
+    fprintf(f, "wSize=%u lBaseX=%ld lBaseY=%ld dwBaseTime=%u\n", p.wSize, p.lBaseX, p.lBaseY, p.dwBaseTime);
+}
+
+inline void Print_TPacketGCMoveBulkPacked(FILE* f, const void* data, int size) {
+    const TPacketGCMoveBulkPacked& p = *(const TPacketGCMoveBulkPacked*)data;
+    fprintf(f, "wSize=%u lBaseX=%ld lBaseY=%ld dwBaseTime=%u\n", p.wSize, p.lBaseX, p.lBaseY, p.dwBaseTime);
+}
+
 inline void Print_TPacketGCChat(FILE* f, const void* data, int size) {
     const TPacketGCChat& p = *(const TPacketGCChat*)data;
     fprintf(f, "size=%u type=%u id=%u bEmpire=%u\n", p.size, p.type, p.id, p.bEmpire);
@@ -429,6 +444,16 @@ inline void Print_TPacketGCPointChange(FILE* f, const void* data, int size) {
     fprintf(f, "dwVID=%u type=%u amount=%ld value=%ld\n", p.dwVID, p.type, p.amount, p.value);
 }
 
+inline void Print_TPacketGCPointChangeBulk(FILE* f, const void* data, int size) {
+    const TPacketGCPointChangeBulk& p = *(const TPacketGCPointChangeBulk*)data;
+    fprintf(f, "wSize=%u\n", p.wSize);
+}
+
+inline void Print_TPacketGCPointChangeBulkPacked(FILE* f, const void* data, int size) {
+    const TPacketGCPointChangeBulkPacked& p = *(const TPacketGCPointChangeBulkPacked*)data;
+    fprintf(f, "wSize=%u\n", p.wSize);
+}
+
 inline void Print_TPacketGCChangeSpeed(FILE* f, const void* data, int size) {
     const TPacketGCChangeSpeed& p = *(const TPacketGCChangeSpeed*)data;
     fprintf(f, "vid=%u moving_speed=%u\n", p.vid, p.moving_speed);
@@ -589,6 +614,11 @@ inline void Print_TPacketGCPartyAdd(FILE* f, const void* data, int size) {
     fprintf(f, "pid=%u\n", p.pid);
 }
 
+inline void Print_TPacketGCPartyUpdateBulk(FILE* f, const void* data, int size) {
+    const TPacketGCPartyUpdateBulk& p = *(const TPacketGCPartyUpdateBulk*)data;
+    fprintf(f, "wSize=%u\n", p.wSize);
+}
+
 inline void Print_TPacketGCPartyUpdate(FILE* f, const void* data, int size) {
     const TPacketGCPartyUpdate& p = *(const TPacketGCPartyUpdate*)data;
     fprintf(f, "pid=%u role=%u percent_hp=%u affects=[7]\n", p.pid, p.role, p.percent_hp);
@@ -764,6 +794,11 @@ inline void Print_TPacketGCDamageInfo(FILE* f, const void* data, int size) {
     fprintf(f, "dwVID=%u flag=%u damage=%d\n", p.dwVID, p.flag, p.damage);
 }
 
+inline void Print_TPacketGCDamageInfoBulk(FILE* f, const void* data, int size) {
+    const TPacketGCDamageInfoBulk& p = *(const TPacketGCDamageInfoBulk*)data;
+    fprintf(f, "wSize=%u\n", p.wSize);
+}
+
 inline void Print_TPacketGCCharacterAdditionalInfo(FILE* f, const void* data, int size) {
     const TPacketGCCharacterAdditionalInfo& p = *(const TPacketGCCharacterAdditionalInfo*)data;
     fprintf(f, "dwVID=%u awPart=[CHR_EQUIPPART_NUM] bEmpire=%u dwGuildID=%u dwLevel=%u sAlignment=%d bPKMode=%u dwMountVnum=%u\n", p.dwVID, p.bEmpire, p.dwGuildID, p.dwLevel, p.sAlignment, p.bPKMode, p.dwMountVnum);
@@ -809,6 +844,21 @@ inline void Print_TPacketGCStateCheck(FILE* f, const void* data, int size) {
     fprintf(f, "key=%lu index=%lu state=%u\n", p.key, p.index, p.state);
 }
 
+inline void Print_TPacketCGPacketCompression(FILE* f, const void* data, int size) {
+    const TPacketCGPacketCompression& p = *(const TPacketCGPacketCompression*)data;
+    fprintf(f, "bEnable=%u\n", p.bEnable);
+}
+
+inline void Print_TPacketCGProtocolVersion(FILE* f, const void* data, int size) {
+    const TPacketCGProtocolVersion& p = *(const TPacketCGProtocolVersion*)data;
+    fprintf(f, "wVersion=%u\n", p.wVersion);
+}
+
+inline void Print_TPacketGCCompressedPacket(FILE* f, const void* data, int size) {
+    const TPacketGCCompressedPacket& p = *(const TPacketGCCompressedPacket*)data;
+    fprintf(f, "size=%u dwRealSize=%u\n", p.size, p.dwRealSize);
+}
+
 inline void Print_TPacketGCPhase(FILE* f, const void* data, int size) {
     const TPacketGCPhase& p = *(const TPacketGCPhase*)data;
     fprintf(f, "phase=%u\n", p.phase);
@@ -895,6 +945,8 @@ inline void RegisterAllPacketsGenerated()
     dbg.RegSend(HEADER_CG_DRAGON_SOUL_REFINE, "CG_DRAGON_SOUL_REFINE", Print_TPacketCGDragonSoulRefine);
     dbg.RegSend(HEADER_CG_STATE_CHECKER, "CG_STATE_CHECKER", Print_TPacketCGStateCheck);
     dbg.RegSend(HEADER_CG_CLIENT_VERSION2, "CG_CLIENT_VERSION2", PrintHeaderOnly); // header only
+    dbg.RegSend(HEADER_CG_PACKET_COMPRESSION, "CG_PACKET_COMPRESSION", Print_TPacketCGPacketCompression);
+    dbg.RegSend(HEADER_CG_PROTOCOL_VERSION, "CG_PROTOCOL_VERSION", Print_TPacketCGProtocolVersion);
     dbg.RegSend(HEADER_CG_TIME_SYNC, "CG_TIME_SYNC", PrintHexDump); // no struct (dynamic/deprecated)
     dbg.RegSend(HEADER_CG_CLIENT_VERSION, "CG_CLIENT_VERSION", PrintHeaderOnly); // header only
     dbg.RegSend(HEADER_CG_PONG, "CG_PONG", PrintHeaderOnly); // header only
@@ -904,8 +956,11 @@ inline void RegisterAllPacketsGenerated()
     // Server -> Client (GC) - 107 packets
     //-------------------------------------------------------------------------
     dbg.RegRecv(HEADER_GC_CHARACTER_ADD, "GC_CHARACTER_ADD", Print_TPacketGCCharacterAdd);
+    dbg.RegRecv(HEADER_GC_CHARACTER_ADD_BULK, "GC_CHARACTER_ADD_BULK", Print_TPacketGCCharacterAddBulk); // variable size
     dbg.RegRecv(HEADER_GC_CHARACTER_DEL, "GC_CHARACTER_DEL", Print_TPacketGCCharacterDelete);
     dbg.RegRecv(HEADER_GC_MOVE, "GC_MOVE", Print_TPacketGCMove);
+    dbg.RegRecv(HEADER_GC_MOVE_BULK, "GC_MOVE_BULK", Print_TPacketGCMoveBulk); // variable size
+    dbg.RegRecv(HEADER_GC_MOVE_BULK_PACKED, "GC_MOVE_BULK_PACKED", Print_TPacketGCMoveBulkPacked); // variable size
     dbg.RegRecv(HEADER_GC_CHAT, "GC_CHAT", Print_TPacketGCChat); // variable size
     dbg.RegRecv(HEADER_GC_SYNC_POSITION, "GC_SYNC_POSITION", Print_TPacketGCSyncPosition); // variable size
     dbg.RegRecv(HEADER_GC_LOGIN_SUCCESS, "GC_LOGIN_SUCCESS", Print_TPacketGCLoginSuccess);
@@ -919,6 +974,8 @@ inline void RegisterAllPacketsGenerated()
     dbg.RegRecv(HEADER_GC_DEAD, "GC_DEAD", Print_TPacketGCDead);
     dbg.RegRecv(HEADER_GC_CHARACTER_POINTS, "GC_CHARACTER_POINTS", Print_TPacketGCPoints);
     dbg.RegRecv(HEADER_GC_CHARACTER_POINT_CHANGE, "GC_CHARACTER_POINT_CHANGE", Print_TPacketGCPointChange);
+    dbg.RegRecv(HEADER_GC_CHARACTER_POINT_CHANGE_BULK, "GC_CHARACTER_POINT_CHANGE_BULK", Print_TPacketGCPointChangeBulk); // variable size
+    dbg.RegRecv(HEADER_GC_CHARACTER_POINT_CHANGE_BULK_PACKED, "GC_CHARACTER_POINT_CHANGE_BULK_PACKED", Print_TPacketGCPointChangeBulkPacked); // variable size
     dbg.RegRecv(HEADER_GC_CHANGE_SPEED, "GC_CHANGE_SPEED", Print_TPacketGCChangeSpeed);
     dbg.RegRecv(HEADER_GC_CHARACTER_UPDATE, "GC_CHARACTER_UPDATE", Print_TPacketGCCharacterUpdate);
     dbg.RegRecv(HEADER_GC_ITEM_DEL, "GC_ITEM_DEL", Print_TPacketGCItemDel);
@@ -956,6 +1013,7 @@ inline void RegisterAllPacketsGenerated()
     dbg.RegRecv(HEADER_GC_PARTY_INVITE, "GC_PARTY_INVITE", Print_TPacketGCPartyInvite);
     dbg.RegRecv(HEADER_GC_PARTY_ADD, "GC_PARTY_ADD", Print_TPacketGCPartyAdd);
     dbg.RegRecv(HEADER_GC_PARTY_UPDATE, "GC_PARTY_UPDATE", Print_TPacketGCPartyUpdate);
+    dbg.RegRecv(HEADER_GC_PARTY_UPDATE_BULK, "GC_PARTY_UPDATE_BULK", Print_TPacketGCPartyUpdateBulk); // variable size
     dbg.RegRecv(HEADER_GC_PARTY_REMOVE, "GC_PARTY_REMOVE", Print_TPacketGCPartyRemove);
     dbg.RegRecv(HEADER_GC_QUEST_INFO, "GC_QUEST_INFO", Print_TPacketGCQuestInfo); // variable size
     dbg.RegRecv(HEADER_GC_REQUEST_MAKE_GUILD, "GC_REQUEST_MAKE_GUILD", Print_TPacketGCGuild); // variable size
@@ -997,6 +1055,7 @@ inline void RegisterAllPacketsGenerated()
     dbg.RegRecv(HEADER_GC_SYMBOL_DATA, "GC_SYMBOL_DATA", Print_TPacketGCGuildSymbolData); // variable size
     dbg.RegRecv(HEADER_GC_DIG_MOTION, "GC_DIG_MOTION", Print_TPacketGCDigMotion);
     dbg.RegRecv(HEADER_GC_DAMAGE_INFO, "GC_DAMAGE_INFO", Print_TPacketGCDamageInfo);
+    dbg.RegRecv(HEADER_GC_DAMAGE_INFO_BULK, "GC_DAMAGE_INFO_BULK", Print_TPacketGCDamageInfoBulk); // variable size
     dbg.RegRecv(HEADER_GC_CHAR_ADDITIONAL_INFO, "GC_CHAR_ADDITIONAL_INFO", Print_TPacketGCCharacterAdditionalInfo);
     dbg.RegRecv(HEADER_GC_MAIN_CHARACTER3_BGM, "GC_MAIN_CHARACTER3_BGM", Print_TPacketGCMainCharacter3_BGM);
     dbg.RegRecv(HEADER_GC_MAIN_CHARACTER4_BGM_VOL, "GC_MAIN_CHARACTER4_BGM_VOL", Print_TPacketGCMainCharacter4_BGM_VOL);
@@ -1006,6 +1065,7 @@ inline void RegisterAllPacketsGenerated()
     dbg.RegRecv(HEADER_GC_SPECIFIC_EFFECT, "GC_SPECIFIC_EFFECT", Print_TPacketGCSpecificEffect);
     dbg.RegRecv(HEADER_GC_DRAGON_SOUL_REFINE, "GC_DRAGON_SOUL_REFINE", Print_TPacketGCDragonSoulRefine);
     dbg.RegRecv(HEADER_GC_RESPOND_CHANNELSTATUS, "GC_RESPOND_CHANNELSTATUS", Print_TPacketGCStateCheck);
+    dbg.RegRecv(HEADER_GC_COMPRESSED_PACKET, "GC_COMPRESSED_PACKET", Print_TPacketGCCompressedPacket); // variable size
     dbg.RegRecv(HEADER_GC_TIME_SYNC, "GC_TIME_SYNC", PrintHexDump); // no struct (dynamic/deprecated)
     dbg.RegRecv(HEADER_GC_PHASE, "GC_PHASE", Print_TPacketGCPhase);
     dbg.RegRecv(HEADER_GC_HANDSHAKE, "GC_HANDSHAKE", Print_TPacketGCHandshake);
@@ -1,6 +1,7 @@
 #include "StdAfx.h"
 
 #include <tlhelp32.h>
+#include <process.h>
 
 static BYTE abCRCMagicCube[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
 static BYTE abCRCXorTable[8] = { 102, 30, 188, 44, 39, 201, 43, 5 };
@@ -93,6 +94,45 @@ bool __GetExeCRC(DWORD & r_dwProcCRC, DWORD & r_dwFileCRC)
 	return true;
 }
 
+//   а 1MB  CRC ϴ  ð ɷ ׶ 忡 ̸  д.
+//  尡  ڿ Ƿ   ʴ´.
+static HANDLE s_hProcessCRCThread = NULL;
+static DWORD s_dwProcessCRC = 0;
+static DWORD s_dwFileCRC = 0;
+static bool s_isProcessCRC = false;
+
+static unsigned __stdcall ProcessCRCThread(void * /*pvArg*/)
+{
+	s_isProcessCRC = __GetExeCRC(s_dwProcessCRC, s_dwFileCRC);
+	return 0;
+}
+
+void StartProcessCRC()
+{
+	if (LocaleService_IsHONGKONG() || LocaleService_IsTAIWAN())
+		return;
+
+	if (s_hProcessCRCThread)
+		return;
+
+	s_hProcessCRCThread = (HANDLE) _beginthreadex(NULL, 0, ProcessCRCThread, NULL, 0, NULL);
+}
+
+//   ̸ ׶ ٸ. 带   ⼭  Ѵ.
+static bool __WaitProcessCRC(DWORD & r_dwProcCRC, DWORD & r_dwFileCRC)
+{
+	if (!s_hProcessCRCThread)
+		return __GetExeCRC(r_dwProcCRC, r_dwFileCRC);
+
+	WaitForSingleObject(s_hProcessCRCThread, INFINITE);
+	CloseHandle(s_hProcessCRCThread);
+	s_hProcessCRCThread = NULL;
+
+	r_dwProcCRC = s_dwProcessCRC;
+	r_dwFileCRC = s_dwFileCRC;
+	return s_isProcessCRC;
+}
+
 void BuildProcessCRC()
 {
 	if (LocaleService_IsHONGKONG() || LocaleService_IsTAIWAN())
@@ -103,8 +143,12 @@ void BuildProcessCRC()
 	}
 	
 	DWORD dwProcCRC, dwFileCRC;
+	bool isExeCRC = __WaitProcessCRC(dwProcCRC, dwFileCRC);
+
+	//  ĳ  ƿ    ݺ ٽ  д.
+	StartProcessCRC();
 
-	if (__GetExeCRC(dwProcCRC, dwFileCRC))
+	if (isExeCRC)
 	{
 		abCRCMagicCube[0] = BYTE(dwProcCRC & 0x000000ff);
 		abCRCMagicCube[1] = BYTE(dwFileCRC & 0x000000ff);
@@ -2,5 +2,6 @@
 
 extern bool GetExeCRC(DWORD & r_dwProcCRC, DWORD & r_dwFileCRC);
 
+extern void StartProcessCRC();
 extern void BuildProcessCRC();
 extern BYTE GetProcessCRCMagicCubePiece();
@@ -2,6 +2,7 @@
 #include "../eterBase/Error.h"
 #include "../eterlib/Camera.h"
 #include "../eterlib/AttributeInstance.h"
+#include "../eterlib/FrameProfiler.h"
 #include "../gamelib/AreaTerrain.h"
 #include "../EterGrnLib/Material.h"
 #include "../CWebBrowser/CWebBrowser.h"
@@ -142,6 +143,20 @@ void CPythonApplication::GetInfo(UINT eInfo, std::string* pstInfo)
 	case INFO_TEXTTAIL:
 		m_pyTextTail.GetInfo(pstInfo);
 		break;
+	case INFO_RESOURCE:
+		CResourceManager::Instance().GetInfo(pstInfo);
+		break;
+	case INFO_NETWORK:
+		m_pyNetworkStream.GetInfo(pstInfo);
+		break;
+	case INFO_PYTHON:
+		CPythonProfiler::Instance().GetInfo(pstInfo);
+		pstInfo->append(", ");
+		m_kWndMgr.GetInfo(pstInfo);
+		break;
+	case INFO_FRAME:
+		CFrameProfiler::Instance().GetInfo(pstInfo);
+		break;
 	}
 }
 
@@ -167,7 +182,10 @@ void CPythonApplication::RenderGame()
 
 	CCullingManager::Instance().Process();
 
-	m_kChrMgr.Deform();
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_ACTOR);
+		m_kChrMgr.Deform();
+	}
 
 	m_pyBackground.RenderCharacterShadowToTexture();
 
@@ -190,7 +208,10 @@ void CPythonApplication::RenderGame()
 	m_pyBackground.Render();
 
 	m_pyBackground.SetCharacterDirLight();
-	m_kChrMgr.Render();
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_ACTOR);
+		m_kChrMgr.Render();
+	}
 
 	m_pyBackground.SetBackgroundDirLight();
 	m_pyBackground.RenderWater();
@@ -199,7 +220,10 @@ void CPythonApplication::RenderGame()
 
 	m_pyBackground.EndEnvironment();
 
-	m_kEftMgr.Render();
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_EFFECT);
+		m_kEftMgr.Render();
+	}
 	m_pyItem.Render();
 	m_FlyingManager.Render();
 
@@ -212,6 +236,8 @@ void CPythonApplication::RenderGame()
 
 void CPythonApplication::UpdateGame()
 {
+	CFrameProfilerScope kScope(CFrameProfiler::PHASE_UPDATE);
+
 	POINT ptMouse;
 	GetMousePosition(&ptMouse);
 
@@ -259,6 +285,8 @@ bool CPythonApplication::Process()
 	ELTimer_SetFrameMSec();
 
 	// 	m_Profiler.Clear();
+	CPythonProfiler::Instance().BeginFrame();
+	CFrameProfiler::Instance().BeginFrame();
 	DWORD dwStart = ELTimer_GetMSec();
 
 	///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -297,12 +325,16 @@ bool CPythonApplication::Process()
 	DWORD updatestart = ELTimer_GetMSec();
 
 	// Network I/O	
-	m_pyNetworkStream.Process();	
+	{
+		CFrameProfilerScope kScope(CFrameProfiler::PHASE_NETWORK);
 
-	m_kGuildMarkUploader.Process();
+		m_pyNetworkStream.Process();	
 
-	m_kGuildMarkDownloader.Process();
-	m_kAccountConnector.Process();
+		m_kGuildMarkUploader.Process();
+
+		m_kGuildMarkDownloader.Process();
+		m_kAccountConnector.Process();
+	}
 
 	//////////////////////
 	// Input Process
@@ -408,16 +440,25 @@ bool CPythonApplication::Process()
 				// Interface
 				m_pyGraphic.SetInterfaceRenderState();
 
-				OnUIRender();
-				OnMouseRender();
+				{
+					CFrameProfilerScope kScope(CFrameProfiler::PHASE_UI);
+					OnUIRender();
+					OnMouseRender();
+				}
 				/////////////////////
 
 				m_pyGraphic.End();
 
 				//DWORD t1 = ELTimer_GetMSec();
-				m_pyGraphic.Show();
+				{
+					CFrameProfilerScope kScope(CFrameProfiler::PHASE_PRESENT);
+					m_pyGraphic.Show();
+				}
 				//DWORD t2 = ELTimer_GetMSec();
 
+				// ̹ ӿ  ؽ縦       Ѵ
+				CGraphicTextureStreamer::Instance().Update();
+
 				DWORD dwRenderEndTime = ELTimer_GetMSec();
 
 				static DWORD s_dwRenderCheckTime = dwRenderEndTime;
@@ -93,6 +93,10 @@ class CPythonApplication : public CMSApplication, public CInputKeyboard, public
 			INFO_EFFECT,
 			INFO_ITEM,
 			INFO_TEXTTAIL,
+			INFO_RESOURCE,
+			INFO_NETWORK,
+			INFO_PYTHON,
+			INFO_FRAME,
 		};
 
 		enum ECameraControlDirection
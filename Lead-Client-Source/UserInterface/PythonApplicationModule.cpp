@@ -435,6 +435,23 @@ PyObject* appGetInfo(PyObject* poSelf, PyObject* poArgs)
 	return Py_BuildValue("s", stInfo.c_str());
 }
 
+PyObject* appSetResourceCacheBudget(PyObject* poSelf, PyObject* poArgs)
+{
+	int iGroup;
+	if (!PyTuple_GetInteger(poArgs, 0, &iGroup))
+		return Py_BuildException();
+
+	int iMegaBytes;
+	if (!PyTuple_GetInteger(poArgs, 1, &iMegaBytes))
+		return Py_BuildException();
+
+	if (iMegaBytes < 0)
+		iMegaBytes = 0;
+
+	CResourceManager::Instance().SetCacheBudget(iGroup, iMegaBytes * 1024 * 1024);
+	return Py_BuildNone();
+}
+
 PyObject* appProcess(PyObject* poSelf, PyObject* poArgs)
 {
 	if (CPythonApplication::Instance().Process())
@@ -1180,6 +1197,7 @@ void initapp()
 		{ "SetFrameSkip",				appSetFrameSkip,				METH_VARARGS },
 		{ "GetImageInfo",				appGetImageInfo,				METH_VARARGS },
 		{ "GetInfo",					appGetInfo,						METH_VARARGS },
+		{ "SetResourceCacheBudget",		appSetResourceCacheBudget,		METH_VARARGS },
 		{ "UpdateGame",					appUpdateGame,					METH_VARARGS },
 		{ "RenderGame",					appRenderGame,					METH_VARARGS },
 		{ "Loop",						appLoop,						METH_VARARGS },
@@ -1304,6 +1322,15 @@ void initapp()
 	PyModule_AddIntConstant(poModule, "INFO_ACTOR",		CPythonApplication::INFO_ACTOR);
 	PyModule_AddIntConstant(poModule, "INFO_EFFECT",	CPythonApplication::INFO_EFFECT);
 	PyModule_AddIntConstant(poModule, "INFO_TEXTTAIL",	CPythonApplication::INFO_TEXTTAIL);
+	PyModule_AddIntConstant(poModule, "INFO_RESOURCE",	CPythonApplication::INFO_RESOURCE);
+	PyModule_AddIntConstant(poModule, "INFO_NETWORK",	CPythonApplication::INFO_NETWORK);
+	PyModule_AddIntConstant(poModule, "INFO_PYTHON",	CPythonApplication::INFO_PYTHON);
+	PyModule_AddIntConstant(poModule, "INFO_FRAME",		CPythonApplication::INFO_FRAME);
+
+	PyModule_AddIntConstant(poModule, "RESOURCE_CACHE_TEXTURE",	CResource::CACHE_GROUP_TEXTURE);
+	PyModule_AddIntConstant(poModule, "RESOURCE_CACHE_MODEL",	CResource::CACHE_GROUP_MODEL);
+	PyModule_AddIntConstant(poModule, "RESOURCE_CACHE_MOTION",	CResource::CACHE_GROUP_MOTION);
+	PyModule_AddIntConstant(poModule, "RESOURCE_CACHE_ETC",		CResource::CACHE_GROUP_ETC);
 
 	PyModule_AddIntConstant(poModule, "DEGREE_DIRECTION_SAME",		DEGREE_DIRECTION_SAME);
 	PyModule_AddIntConstant(poModule, "DEGREE_DIRECTION_RIGHT",		DEGREE_DIRECTION_RIGHT);
@@ -25,8 +25,14 @@ void CPythonCharacterManager::AdjustCollisionWithOtherObjects(CActorInstance* pI
 	if( !pInst->IsPC() )
 		return;
 
-	CPythonCharacterManager& rkChrMgr=CPythonCharacterManager::Instance();
-	for(CPythonCharacterManager::CharacterIterator i = rkChrMgr.CharacterInstanceBegin(); i!=rkChrMgr.CharacterInstanceEnd();++i)
+	TPixelPosition kPPosBlending;
+	pInst->GetBlendingPosition(&kPPosBlending);
+
+	// 浹 Ÿ ȿ   ִ ֺ  ĳ͸ ˻Ѵ.
+	static std::vector<CInstanceBase*> s_kVct_pkInstNear;
+	__GetNearActorList(kPPosBlending, &s_kVct_pkInstNear);
+
+	for(std::vector<CInstanceBase*>::iterator i = s_kVct_pkInstNear.begin(); i!=s_kVct_pkInstNear.end();++i)
 	{
 		CInstanceBase*  pkInstEach=*i;
 		CActorInstance* rkActorEach=pkInstEach->GetGraphicThingInstancePtr();
@@ -51,6 +57,130 @@ void CPythonCharacterManager::AdjustCollisionWithOtherObjects(CActorInstance* pI
 }
 
 
+DWORD CPythonCharacterManager::__GetActorGridKey(int iCellX, int iCellY)
+{
+	return (DWORD(iCellX & 0xffff) << 16) | DWORD(iCellY & 0xffff);
+}
+
+void CPythonCharacterManager::__RefreshActorGrid()
+{
+	if (!m_isActorGridDirty)
+		return;
+
+	m_isActorGridDirty = false;
+
+	// ִ ĭ   ޸𸮸 Ѵ.
+	TActorGridMap::iterator c = m_kMap_kActorGrid.begin();
+	while (m_kMap_kActorGrid.end() != c)
+	{
+		TActorGridMap::iterator e = c++;
+
+		if (e->second.kVct_pkInst.empty())
+			m_kMap_kActorGrid.erase(e);
+		else
+			e->second.kVct_pkInst.clear();
+	}
+
+	for (TCharacterInstanceMap::iterator i = m_kAliveInstMap.begin(); i != m_kAliveInstMap.end(); ++i)
+	{
+		CInstanceBase* pkInstEach = i->second;
+		CActorInstance& rkActorEach = pkInstEach->GetGraphicThingInstanceRef();
+
+		TPixelPosition kPPosEach;
+		rkActorEach.GetPixelPosition(&kPPosEach);
+
+		int iCellX = int(floorf(kPPosEach.x / ACTOR_GRID_CELL_SIZE));
+		int iCellY = int(floorf(kPPosEach.y / ACTOR_GRID_CELL_SIZE));
+
+		TActorGridCell& rkCell = m_kMap_kActorGrid[__GetActorGridKey(iCellX, iCellY)];
+
+		if (rkCell.kVct_pkInst.empty())
+		{
+			rkCell.fCenterX = (iCellX + 0.5f) * ACTOR_GRID_CELL_SIZE;
+			rkCell.fCenterY = (iCellY + 0.5f) * ACTOR_GRID_CELL_SIZE;
+			rkCell.fPickRadius = 0.0f;
+		}
+
+		rkCell.kVct_pkInst.push_back(pkInstEach);
+
+		// ĭ ߽ɿ  ĳ ٿ     (ŷ   ǥ y ȣ ݴ)
+		D3DXVECTOR3 v3Center;
+		float fRadius;
+		if (rkActorEach.GetBoundingSphere(v3Center, fRadius))
+		{
+			float fDX = v3Center.x - rkCell.fCenterX;
+			float fDY = -v3Center.y - rkCell.fCenterY;
+			rkCell.fPickRadius = max(rkCell.fPickRadius, sqrtf(fDX * fDX + fDY * fDY) + fRadius);
+		}
+	}
+}
+
+void CPythonCharacterManager::__GetNearActorList(const TPixelPosition & c_rkPPos, std::vector<CInstanceBase*> * pkVct_pkInst)
+{
+	__RefreshActorGrid();
+
+	pkVct_pkInst->clear();
+
+	int iCellX = int(floorf(c_rkPPos.x / ACTOR_GRID_CELL_SIZE));
+	int iCellY = int(floorf(c_rkPPos.y / ACTOR_GRID_CELL_SIZE));
+
+	for (int y = iCellY - 1; y <= iCellY + 1; ++y)
+	{
+		for (int x = iCellX - 1; x <= iCellX + 1; ++x)
+		{
+			TActorGridMap::iterator f = m_kMap_kActorGrid.find(__GetActorGridKey(x, y));
+
+			if (m_kMap_kActorGrid.end() == f)
+				continue;
+
+			pkVct_pkInst->insert(pkVct_pkInst->end(), f->second.kVct_pkInst.begin(), f->second.kVct_pkInst.end());
+		}
+	}
+}
+
+void CPythonCharacterManager::__GetPickableActorList(std::vector<CInstanceBase*> * pkVct_pkInst)
+{
+	__RefreshActorGrid();
+
+	pkVct_pkInst->clear();
+
+	// IntersectDefendingSphere     ˻ϹǷ, 
+	// ٴڿ   ĭ   ĭ .
+	D3DXVECTOR3 v3Start, v3Dir;
+	float fRange;
+	const CRay& c_rkRay = CGraphicBase::GetPickingRay();
+	c_rkRay.GetStartPoint(&v3Start);
+	c_rkRay.GetDirection(&v3Dir, &fRange);
+
+	float fStartX = v3Start.x;
+	float fStartY = -v3Start.y;
+	float fDirX = v3Dir.x;
+	float fDirY = -v3Dir.y;
+	float fDirLen = sqrtf(fDirX * fDirX + fDirY * fDirY);
+
+	for (TActorGridMap::iterator i = m_kMap_kActorGrid.begin(); i != m_kMap_kActorGrid.end(); ++i)
+	{
+		TActorGridCell& rkCell = i->second;
+
+		if (rkCell.kVct_pkInst.empty())
+			continue;
+
+		float fDX = rkCell.fCenterX - fStartX;
+		float fDY = rkCell.fCenterY - fStartY;
+		float fDistance;
+
+		if (fDirLen < 0.0001f)
+			fDistance = sqrtf(fDX * fDX + fDY * fDY);
+		else
+			fDistance = fabsf(fDX * fDirY - fDY * fDirX) / fDirLen;
+
+		if (fDistance > rkCell.fPickRadius + ACTOR_GRID_PICK_SLACK)
+			continue;
+
+		pkVct_pkInst->insert(pkVct_pkInst->end(), rkCell.kVct_pkInst.begin(), rkCell.kVct_pkInst.end());
+	}
+}
+
 void CPythonCharacterManager::EnableSortRendering(bool isEnable)
 {
 }
@@ -157,6 +287,8 @@ void CPythonCharacterManager::Update()
 	DWORD dwDeadInstCount=0;
 	DWORD dwForceVisibleInstCount=0;
 
+	m_isActorGridDirty=true;
+
 	TCharacterInstanceMap::iterator i=m_kAliveInstMap.begin(); 
 	while (m_kAliveInstMap.end()!=i)
 	{
@@ -178,6 +310,7 @@ void CPythonCharacterManager::Update()
 			{
 				__DeleteBlendOutInstance(pkInstEach);
 				m_kAliveInstMap.erase(c);
+				m_isActorGridDirty=true;
 				dwDeadInstCount++;
 			}
 		}
@@ -187,6 +320,9 @@ void CPythonCharacterManager::Update()
 
 	UpdateDeleting();
 
+	// ̵  ġ ŷѴ.
+	m_isActorGridDirty=true;
+
 	__NEW_Pick();
 }
 
@@ -497,6 +633,7 @@ CInstanceBase * CPythonCharacterManager::RegisterInstance(DWORD VirtualID)
 
 	CInstanceBase * pCharacterInstance = CInstanceBase::New();
 	m_kAliveInstMap.insert(TCharacterInstanceMap::value_type(VirtualID, pCharacterInstance));
+	m_isActorGridDirty = true;
 
 	return (pCharacterInstance);
 }
@@ -525,6 +662,7 @@ void CPythonCharacterManager::DeleteInstance(DWORD dwDelVID)
 	CInstanceBase::Delete(pkInstDel);
 
 	m_kAliveInstMap.erase(itor);
+	m_isActorGridDirty = true;
 }
 
 void CPythonCharacterManager::__DeleteBlendOutInstance(CInstanceBase* pkInstDel)
@@ -545,6 +683,7 @@ void CPythonCharacterManager::DeleteInstanceByFade(DWORD dwVID)
 	}
 	__DeleteBlendOutInstance(f->second);
 	m_kAliveInstMap.erase(f);	
+	m_isActorGridDirty = true;
 }
 
 void CPythonCharacterManager::SelectInstance(DWORD VirtualID)
@@ -605,10 +744,13 @@ void CPythonCharacterManager::__UpdatePickedActorList()
 {
 	m_kVct_pkInstPicked.clear();
 
-	TCharacterInstanceMap::iterator i;
-	for (i=m_kAliveInstMap.begin(); i!=m_kAliveInstMap.end(); ++i)
+	static std::vector<CInstanceBase*> s_kVct_pkInstPickable;
+	__GetPickableActorList(&s_kVct_pkInstPickable);
+
+	std::vector<CInstanceBase*>::iterator i;
+	for (i=s_kVct_pkInstPickable.begin(); i!=s_kVct_pkInstPickable.end(); ++i)
 	{
-		CInstanceBase* pkInstEach=i->second;
+		CInstanceBase* pkInstEach=*i;
 		// 2004.07.17.levites.isShow ViewFrustumCheck 
 		if (pkInstEach->CanPickInstance())
 		{
@@ -848,6 +990,8 @@ void CPythonCharacterManager::DestroyAliveInstanceMap()
 		CInstanceBase::Delete(i->second);
 
 	m_kAliveInstMap.clear();
+	m_kMap_kActorGrid.clear();
+	m_isActorGridDirty = true;
 }
 
 void CPythonCharacterManager::DestroyDeadInstanceList()
@@ -872,6 +1016,7 @@ void CPythonCharacterManager::__Initialize()
 	m_pkInstBind = NULL;
 	m_pkInstPick = NULL;
 	m_v2PickedInstProjPos = D3DXVECTOR2(0.0f, 0.0f);
+	m_isActorGridDirty = true;
 }
 
 
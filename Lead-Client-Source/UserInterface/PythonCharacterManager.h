@@ -111,6 +111,29 @@ class CPythonCharacterManager : public CSingleton<CPythonCharacterManager>, publ
 		void __RenderSortedAliveActorList();
 		void __RenderSortedDeadActorList();
 
+		//  ˻  - ִ ĳ ̳ ġ ٲ  ˻  ٽ .
+		DWORD __GetActorGridKey(int iCellX, int iCellY);
+		void __RefreshActorGrid();
+		void __GetNearActorList(const TPixelPosition & c_rkPPos, std::vector<CInstanceBase*> * pkVct_pkInst);
+		void __GetPickableActorList(std::vector<CInstanceBase*> * pkVct_pkInst);
+
+	protected:
+		enum
+		{
+			ACTOR_GRID_CELL_SIZE = 1000,		// TestPhysicsBlendingCollision ˻ Ÿ(800) +   ̵ 
+			ACTOR_GRID_PICK_SLACK = 100,		//   ٿ    츦  
+		};
+
+		typedef struct SActorGridCell
+		{
+			float							fCenterX;
+			float							fCenterY;
+			float							fPickRadius;
+			std::vector<CInstanceBase*>		kVct_pkInst;
+		} TActorGridCell;
+
+		typedef std::map<DWORD, TActorGridCell>	TActorGridMap;
+
 	protected:
 		CInstanceBase *						m_pkInstMain;
 		CInstanceBase *						m_pkInstPick;
@@ -122,6 +145,9 @@ class CPythonCharacterManager : public CSingleton<CPythonCharacterManager>, publ
 
 		std::vector<CInstanceBase*>			m_kVct_pkInstPicked;
 
+		TActorGridMap						m_kMap_kActorGrid;
+		bool								m_isActorGridDirty;
+
 		DWORD								m_adwPointEffect[POINT_MAX_NUM];
 
 	public:
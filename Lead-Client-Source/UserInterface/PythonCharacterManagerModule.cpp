@@ -600,6 +600,23 @@ PyObject * chrmgrSetHorseDustGap(PyObject* poSelf, PyObject* poArgs)
 	return Py_BuildNone();
 }
 
+PyObject * chrmgrSetMovementInterpolation(PyObject* poSelf, PyObject* poArgs)
+{
+	int nDelay;
+	if (!PyTuple_GetInteger(poArgs, 0, &nDelay))
+		return Py_BadArgument();
+
+	float fExtrapolationLimit;
+	if (!PyTuple_GetFloat(poArgs, 1, &fExtrapolationLimit))
+		return Py_BadArgument();
+
+	if (nDelay < 0)
+		nDelay = 0;
+
+	CInstanceBase::SetMovementInterpolation(nDelay, fExtrapolationLimit);
+	return Py_BuildNone();
+}
+
 PyObject * chrmgrToggleDirectionLine(PyObject* poSelf, PyObject* poArgs)
 {
 	static bool s_isVisible=true;
@@ -754,6 +771,7 @@ void initchrmgr()
 		{ "SetMovingSpeed",				chrmgrSetMovingSpeed,					METH_VARARGS },
 		{ "SetDustGap",					chrmgrSetDustGap,						METH_VARARGS },
 		{ "SetHorseDustGap",			chrmgrSetHorseDustGap,					METH_VARARGS },
+		{ "SetMovementInterpolation",	chrmgrSetMovementInterpolation,			METH_VARARGS },
 
 		{ "RegisterTitleName",			chrmgrRegisterTitleName,				METH_VARARGS },
 		{ "RegisterNameColor",			chrmgrRegisterNameColor,				METH_VARARGS },
@@ -27,6 +27,7 @@ void CPythonMiniMap::AddObserver(DWORD dwVID, float fSrcX, float fSrcY)
 		kObserver.fDstY=fSrcY;
 		kObserver.fCurX=fSrcX;
 		kObserver.fCurY=fSrcY;
+		kObserver.isMoving=false;
 		m_kMap_dwVID_kObserver.insert(std::map<DWORD, SObserver>::value_type(dwVID, kObserver));
 	}
 	else
@@ -40,6 +41,7 @@ void CPythonMiniMap::AddObserver(DWORD dwVID, float fSrcX, float fSrcY)
 		rkObserver.fDstY=fSrcY;
 		rkObserver.fCurX=fSrcX;
 		rkObserver.fCurY=fSrcY;		
+		rkObserver.isMoving=false;
 	}
 }
 
@@ -56,6 +58,7 @@ void CPythonMiniMap::MoveObserver(DWORD dwVID, float fDstX, float fDstY)
 	rkObserver.fSrcY=rkObserver.fCurY;
 	rkObserver.fDstX=fDstX;
 	rkObserver.fDstY=fDstY;
+	rkObserver.isMoving=true;
 }
 
 void CPythonMiniMap::RemoveObserver(DWORD dwVID)
@@ -108,7 +111,10 @@ void CPythonMiniMap::Update(float fCenterX, float fCenterY)
 
 	CInstanceBase* pkInstMain=rkChrMgr.GetMainInstancePtr();
 	if (!pkInstMain)
+	{
+		__UpdateMarkVertices();
 		return;
+	}
 
 	CPythonCharacterManager::CharacterIterator i;
 	for(i = rkChrMgr.CharacterInstanceBegin(); i!=rkChrMgr.CharacterInstanceEnd(); ++i)
@@ -145,6 +151,7 @@ void CPythonMiniMap::Update(float fCenterX, float fCenterY)
 		{
 			aMarkPosition.m_fX = ( m_fWidth - (float)m_WhiteMark.GetWidth() ) / 2.0f + fDistanceFromCenterX + m_fScreenX;
 			aMarkPosition.m_fY = ( m_fHeight - (float)m_WhiteMark.GetHeight() ) / 2.0f + fDistanceFromCenterY + m_fScreenY;
+			aMarkPosition.m_eNameColor=CInstanceBase::NAMECOLOR_NPC;
 
 			m_NPCPositionVector.push_back(aMarkPosition);
 		}
@@ -152,6 +159,7 @@ void CPythonMiniMap::Update(float fCenterX, float fCenterY)
 		{
 			aMarkPosition.m_fX = ( m_fWidth - (float)m_WhiteMark.GetWidth() ) / 2.0f + fDistanceFromCenterX + m_fScreenX;
 			aMarkPosition.m_fY = ( m_fHeight - (float)m_WhiteMark.GetHeight() ) / 2.0f + fDistanceFromCenterY + m_fScreenY;
+			aMarkPosition.m_eNameColor=CInstanceBase::NAMECOLOR_MOB;
 
 			m_MonsterPositionVector.push_back(aMarkPosition);
 		}
@@ -159,6 +167,7 @@ void CPythonMiniMap::Update(float fCenterX, float fCenterY)
 		{
 			aMarkPosition.m_fX = ( m_fWidth - (float)m_WhiteMark.GetWidth() ) / 2.0f + fDistanceFromCenterX + m_fScreenX;
 			aMarkPosition.m_fY = ( m_fHeight - (float)m_WhiteMark.GetHeight() ) / 2.0f + fDistanceFromCenterY + m_fScreenY;
+			aMarkPosition.m_eNameColor=CInstanceBase::NAMECOLOR_WARP;
 
 			m_WarpPositionVector.push_back(aMarkPosition);
 		}
@@ -172,12 +181,20 @@ void CPythonMiniMap::Update(float fCenterX, float fCenterY)
 		{
 			SObserver& rkObserver=i->second;
 
-			float fPos=float(dwCurTime-rkObserver.dwSrcTime)/float(rkObserver.dwDstTime-rkObserver.dwSrcTime);			
-			if (fPos<0.0f) fPos=0.0f;
-			else if (fPos>1.0f) fPos=1.0f;
+			// MoveObserver     ڿ  ʴ´.
+			if (rkObserver.isMoving)
+			{
+				float fPos=float(dwCurTime-rkObserver.dwSrcTime)/float(rkObserver.dwDstTime-rkObserver.dwSrcTime);			
+				if (fPos<0.0f) fPos=0.0f;
+				else if (fPos>=1.0f)
+				{
+					fPos=1.0f;
+					rkObserver.isMoving=false;
+				}
 
-			rkObserver.fCurX=(rkObserver.fDstX-rkObserver.fSrcX)*fPos+rkObserver.fSrcX;
-			rkObserver.fCurY=(rkObserver.fDstY-rkObserver.fSrcY)*fPos+rkObserver.fSrcY;
+				rkObserver.fCurX=(rkObserver.fDstX-rkObserver.fSrcX)*fPos+rkObserver.fSrcX;
+				rkObserver.fCurY=(rkObserver.fDstY-rkObserver.fSrcY)*fPos+rkObserver.fSrcY;
+			}
 
 			TPixelPosition kInstancePosition;
 			kInstancePosition.x=rkObserver.fCurX;
@@ -201,6 +218,8 @@ void CPythonMiniMap::Update(float fCenterX, float fCenterY)
 		}
 	}
 
+	__UpdateMarkVertices();
+
 	{
 		TAtlasMarkInfoVector::iterator itor = m_AtlasWayPointInfoVector.begin();
 		for (; itor != m_AtlasWayPointInfoVector.end(); ++itor)
@@ -343,82 +362,27 @@ void CPythonMiniMap::Render(float fScreenX, float fScreenY)
 	SetDiffuseOperation();
 	STATEMANAGER.SetTransform(D3DTS_WORLD, &m_matIdentity);
 
-	STATEMANAGER.SaveRenderState(D3DRS_TEXTUREFACTOR, 0xFFFFFFFF);
-	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLORARG1, D3DTA_TFACTOR);
+	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLORARG1, D3DTA_DIFFUSE);
 	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLORARG2, D3DTA_TEXTURE);
 	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLOROP, D3DTOP_MODULATE);
-	STATEMANAGER.SaveTextureStageState(0, D3DTSS_ALPHAARG1, D3DTA_TFACTOR);
+	STATEMANAGER.SaveTextureStageState(0, D3DTSS_ALPHAARG1, D3DTA_DIFFUSE);
 	STATEMANAGER.SaveTextureStageState(0, D3DTSS_ALPHAARG2, D3DTA_TEXTURE);
 	STATEMANAGER.SaveTextureStageState(0, D3DTSS_ALPHAOP, D3DTOP_SELECTARG2);
 
-	TInstancePositionVectorIterator aIterator;
-
-	if (m_fScale >= 2.0f)
+	// Monster, Other PC, Party PC, NPC, Warp  Update    簢 ѹ ׸.
+	if (m_uPartyMarkVertexCount)
 	{
-		// Monster
-		STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_MOB));//m_MarkTypeToColorMap[TYPE_MONSTER]);
-		aIterator = m_MonsterPositionVector.begin();
-		while (aIterator != m_MonsterPositionVector.end())
-		{
-			TMarkPosition & rPosition = *aIterator;
-			m_WhiteMark.SetPosition(rPosition.m_fX, rPosition.m_fY);
-			m_WhiteMark.Render();
-			++aIterator;
-		}
-
-		// Other PC
-		aIterator = m_OtherPCPositionVector.begin();
-		while (aIterator != m_OtherPCPositionVector.end())
-		{
-			TMarkPosition & rPosition = *aIterator;
-			STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, CInstanceBase::GetIndexedNameColor(rPosition.m_eNameColor));
-			m_WhiteMark.SetPosition(rPosition.m_fX, rPosition.m_fY);
-			m_WhiteMark.Render();
-			++aIterator;
-		}
-
-		// Party PC
-		if (!m_PartyPCPositionVector.empty())
-		{
-			float v = (1+sinf(CTimer::Instance().GetCurrentSecond()*6))/5+0.6;
-			D3DXCOLOR c(CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_PARTY));//(m_MarkTypeToColorMap[TYPE_PARTY]);
-			D3DXCOLOR d(v,v,v,1);
-			D3DXColorModulate(&c,&c,&d);
-			STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, (DWORD)c);
-			aIterator = m_PartyPCPositionVector.begin();
-			while (aIterator != m_PartyPCPositionVector.end())
-			{
-				TMarkPosition & rPosition = *aIterator;
-				m_WhiteMark.SetPosition(rPosition.m_fX, rPosition.m_fY);
-				m_WhiteMark.Render();
-				++aIterator;
-			}
-		}
+		float v = (1+sinf(CTimer::Instance().GetCurrentSecond()*6))/5+0.6;
+		D3DXCOLOR c(CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_PARTY));//(m_MarkTypeToColorMap[TYPE_PARTY]);
+		D3DXCOLOR d(v,v,v,1);
+		D3DXColorModulate(&c,&c,&d);
+
+		DWORD dwPartyColor = (DWORD) c;
+		for (UINT i = m_uPartyMarkVertexBase; i < m_uPartyMarkVertexBase + m_uPartyMarkVertexCount; ++i)
+			m_kVct_kMarkVertex[i].diffuse = dwPartyColor;
 	}
 
-	// NPC
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_NPC));
-	aIterator = m_NPCPositionVector.begin();
-	while (aIterator != m_NPCPositionVector.end())
-	{
-		TMarkPosition & rPosition = *aIterator;
-		m_WhiteMark.SetPosition(rPosition.m_fX, rPosition.m_fY);
-		m_WhiteMark.Render();
-		++aIterator;
-	}
-
-	// Warp
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_WARP));
-	aIterator = m_WarpPositionVector.begin();
-	while (aIterator != m_WarpPositionVector.end())
-	{
-		TMarkPosition & rPosition = *aIterator;
-		m_WhiteMark.SetPosition(rPosition.m_fX, rPosition.m_fY);
-		m_WhiteMark.Render();
-		++aIterator;
-	}
-
-	STATEMANAGER.RestoreRenderState(D3DRS_TEXTUREFACTOR);
+	__RenderMarkVertices(m_kVct_kMarkVertex);
 
 	STATEMANAGER.RestoreTextureStageState(0, D3DTSS_ALPHAARG2);
 	STATEMANAGER.RestoreTextureStageState(0, D3DTSS_ALPHAARG1);
@@ -546,6 +510,8 @@ bool CPythonMiniMap::Create()
 
 	pSubImage = (CGraphicSubImage *) CResourceManager::Instance().GetResourcePointer(strWhiteMark.c_str());
 	m_WhiteMark.SetImagePointer(pSubImage);
+	m_kMarkQuad.iTextureWidth = 0;
+	m_kMarkQuad.iTextureHeight = 0;
 
 	char buf[256];
 	for (int i = 0; i < MINI_WAYPOINT_IMAGE_COUNT; ++i)
@@ -686,6 +652,148 @@ void CPythonMiniMap::__SetPosition()
 		( m_fHeight - (float)m_MiniMapCameraraphicImageInstance.GetHeight() ) / 2.0f  + m_fScreenY );
 }
 
+void CPythonMiniMap::__UpdateMarkTexCoord()
+{
+	if (m_WhiteMark.IsEmpty())
+		return;
+
+	CGraphicImage * pImage = m_WhiteMark.GetGraphicImagePointer();
+	CGraphicTexture * pTexture = pImage->GetTexturePointer();
+
+	if (m_kMarkQuad.iTextureWidth == pTexture->GetWidth() && m_kMarkQuad.iTextureHeight == pTexture->GetHeight())
+		return;
+
+	m_kMarkQuad.iTextureWidth = pTexture->GetWidth();
+	m_kMarkQuad.iTextureHeight = pTexture->GetHeight();
+
+	const RECT & c_rRect = pImage->GetRectReference();
+	float texReverseWidth = 1.0f / float(pTexture->GetWidth());
+	float texReverseHeight = 1.0f / float(pTexture->GetHeight());
+
+	m_kMarkQuad.fWidth = float(pImage->GetWidth());
+	m_kMarkQuad.fHeight = float(pImage->GetHeight());
+	m_kMarkQuad.su = c_rRect.left * texReverseWidth;
+	m_kMarkQuad.sv = c_rRect.top * texReverseHeight;
+	m_kMarkQuad.eu = c_rRect.right * texReverseWidth;
+	m_kMarkQuad.ev = c_rRect.bottom * texReverseHeight;
+
+	m_isMarkDirty = true;
+	m_isAtlasMarkDirty = true;
+}
+
+void CPythonMiniMap::__AppendMarkVertex(std::vector<TPDTVertex> & rkVct_kVertex, float fx, float fy, DWORD dwColor)
+{
+	// CGraphicImageInstance::OnRender   簢
+	TPDTVertex akVertex[4];
+
+	akVertex[0].position = TPosition(fx - 0.5f, fy - 0.5f, 0.0f);
+	akVertex[0].texCoord = TTextureCoordinate(m_kMarkQuad.su, m_kMarkQuad.sv);
+
+	akVertex[1].position = TPosition(fx + m_kMarkQuad.fWidth - 0.5f, fy - 0.5f, 0.0f);
+	akVertex[1].texCoord = TTextureCoordinate(m_kMarkQuad.eu, m_kMarkQuad.sv);
+
+	akVertex[2].position = TPosition(fx - 0.5f, fy + m_kMarkQuad.fHeight - 0.5f, 0.0f);
+	akVertex[2].texCoord = TTextureCoordinate(m_kMarkQuad.su, m_kMarkQuad.ev);
+
+	akVertex[3].position = TPosition(fx + m_kMarkQuad.fWidth - 0.5f, fy + m_kMarkQuad.fHeight - 0.5f, 0.0f);
+	akVertex[3].texCoord = TTextureCoordinate(m_kMarkQuad.eu, m_kMarkQuad.ev);
+
+	for (int i = 0; i < 4; ++i)
+		akVertex[i].diffuse = dwColor;
+
+	rkVct_kVertex.insert(rkVct_kVertex.end(), akVertex, akVertex + 4);
+}
+
+void CPythonMiniMap::__UpdateMarkVertices()
+{
+	__UpdateMarkTexCoord();
+
+	m_kVct_kMarkPosition.clear();
+
+	if (m_fScale >= 2.0f)
+	{
+		m_kVct_kMarkPosition.insert(m_kVct_kMarkPosition.end(), m_MonsterPositionVector.begin(), m_MonsterPositionVector.end());
+		m_kVct_kMarkPosition.insert(m_kVct_kMarkPosition.end(), m_OtherPCPositionVector.begin(), m_OtherPCPositionVector.end());
+		m_kVct_kMarkPosition.insert(m_kVct_kMarkPosition.end(), m_PartyPCPositionVector.begin(), m_PartyPCPositionVector.end());
+	}
+
+	m_kVct_kMarkPosition.insert(m_kVct_kMarkPosition.end(), m_NPCPositionVector.begin(), m_NPCPositionVector.end());
+	m_kVct_kMarkPosition.insert(m_kVct_kMarkPosition.end(), m_WarpPositionVector.begin(), m_WarpPositionVector.end());
+
+	//  Ӱ ũ ġ   簢 ٽ  ʴ´.
+	if (!m_isMarkDirty && m_kVct_kMarkPosition.size() == m_kVct_kLastMarkPosition.size())
+	{
+		if (m_kVct_kMarkPosition.empty())
+			return;
+
+		if (0 == memcmp(&m_kVct_kMarkPosition[0], &m_kVct_kLastMarkPosition[0], sizeof(TMarkPosition) * m_kVct_kMarkPosition.size()))
+			return;
+	}
+
+	m_isMarkDirty = false;
+	m_kVct_kLastMarkPosition.swap(m_kVct_kMarkPosition);
+
+	m_kVct_kMarkVertex.clear();
+	m_uPartyMarkVertexBase = 0;
+	m_uPartyMarkVertexCount = 0;
+
+	for (TInstancePositionVectorIterator i = m_kVct_kLastMarkPosition.begin(); i != m_kVct_kLastMarkPosition.end(); ++i)
+	{
+		const TMarkPosition & c_rPosition = *i;
+
+		// Ƽ ̹Ƿ  Render  ĥѴ.
+		if (CInstanceBase::NAMECOLOR_PARTY == c_rPosition.m_eNameColor)
+		{
+			if (!m_uPartyMarkVertexCount)
+				m_uPartyMarkVertexBase = m_kVct_kMarkVertex.size();
+
+			m_uPartyMarkVertexCount += 4;
+		}
+
+		__AppendMarkVertex(m_kVct_kMarkVertex, c_rPosition.m_fX, c_rPosition.m_fY, CInstanceBase::GetIndexedNameColor(c_rPosition.m_eNameColor));
+	}
+}
+
+void CPythonMiniMap::__UpdateAtlasMarkVertices()
+{
+	__UpdateMarkTexCoord();
+
+	if (!m_isAtlasMarkDirty)
+		return;
+
+	m_isAtlasMarkDirty = false;
+	m_kVct_kAtlasMarkVertex.clear();
+
+	DWORD dwNPCColor = CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_NPC);
+	for (TAtlasMarkInfoVectorIterator i = m_AtlasNPCInfoVector.begin(); i != m_AtlasNPCInfoVector.end(); ++i)
+		__AppendMarkVertex(m_kVct_kAtlasMarkVertex, i->m_fScreenX, i->m_fScreenY, dwNPCColor);
+
+	DWORD dwWarpColor = CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_WARP);
+	for (TAtlasMarkInfoVectorIterator j = m_AtlasWarpInfoVector.begin(); j != m_AtlasWarpInfoVector.end(); ++j)
+		__AppendMarkVertex(m_kVct_kAtlasMarkVertex, j->m_fScreenX, j->m_fScreenY, dwWarpColor);
+}
+
+void CPythonMiniMap::__RenderMarkVertices(std::vector<TPDTVertex> & rkVct_kVertex)
+{
+	if (rkVct_kVertex.empty() || m_WhiteMark.IsEmpty())
+		return;
+
+	CGraphicBase::SetDefaultIndexBuffer(CGraphicBase::DEFAULT_IB_FILL_QUAD);
+	STATEMANAGER.SetTexture(0, m_WhiteMark.GetTexturePointer()->GetD3DTexture());
+	STATEMANAGER.SetTexture(1, NULL);
+	STATEMANAGER.SetFVF(D3DFVF_XYZ|D3DFVF_DIFFUSE|D3DFVF_TEX1);
+
+	UINT uQuadCount = rkVct_kVertex.size() / 4;
+
+	for (UINT uBase = 0; uBase < uQuadCount; uBase += CGraphicBase::FILL_QUAD_MAX_NUM)
+	{
+		UINT uCount = min(uQuadCount - uBase, (UINT) CGraphicBase::FILL_QUAD_MAX_NUM);
+
+		if (CGraphicBase::SetDynamicStream(&rkVct_kVertex[uBase * 4], uCount * 4, sizeof(TPDTVertex)))
+			STATEMANAGER.DrawIndexedPrimitive(D3DPT_TRIANGLELIST, 0, uCount * 4, 0, uCount * 2);
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Atlas
 
@@ -693,6 +801,7 @@ void CPythonMiniMap::ClearAtlasMarkInfo()
 {
 	m_AtlasNPCInfoVector.clear();
 	m_AtlasWarpInfoVector.clear();
+	m_isAtlasMarkDirty = true;
 }
 
 void CPythonMiniMap::RegisterAtlasMark(BYTE byType, const char * c_szName, long lx, long ly)
@@ -703,6 +812,8 @@ void CPythonMiniMap::RegisterAtlasMark(BYTE byType, const char * c_szName, long
 	aAtlasMarkInfo.m_fY = float(ly);
 	aAtlasMarkInfo.m_strText = c_szName;
 
+	m_isAtlasMarkDirty = true;
+
 	aAtlasMarkInfo.m_fScreenX = aAtlasMarkInfo.m_fX / m_fAtlasMaxX * m_fAtlasImageSizeX - (float)m_WhiteMark.GetWidth() / 2.0f;
 	aAtlasMarkInfo.m_fScreenY = aAtlasMarkInfo.m_fY / m_fAtlasMaxY * m_fAtlasImageSizeY - (float)m_WhiteMark.GetHeight() / 2.0f;
 
@@ -978,25 +1089,12 @@ void CPythonMiniMap::RenderAtlas(float fScreenX, float fScreenY)
 	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLORARG2, D3DTA_TEXTURE);
 	STATEMANAGER.SaveTextureStageState(0, D3DTSS_COLOROP, D3DTOP_MODULATE);
 
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_NPC));
-	m_AtlasMarkInfoVectorIterator = m_AtlasNPCInfoVector.begin();
-	while (m_AtlasMarkInfoVectorIterator != m_AtlasNPCInfoVector.end())
-	{
-		TAtlasMarkInfo & rAtlasMarkInfo = *m_AtlasMarkInfoVectorIterator;
-		m_WhiteMark.SetPosition(rAtlasMarkInfo.m_fScreenX, rAtlasMarkInfo.m_fScreenY);
-		m_WhiteMark.Render();
-		++m_AtlasMarkInfoVectorIterator;
-	}
+	// NPC  Warp ũ  ٲ  ٽ .
+	__UpdateAtlasMarkVertices();
 
-	STATEMANAGER.SetRenderState(D3DRS_TEXTUREFACTOR, CInstanceBase::GetIndexedNameColor(CInstanceBase::NAMECOLOR_WARP));
-	m_AtlasMarkInfoVectorIterator = m_AtlasWarpInfoVector.begin();
-	while (m_AtlasMarkInfoVectorIterator != m_AtlasWarpInfoVector.end())
-	{
-		TAtlasMarkInfo & rAtlasMarkInfo = *m_AtlasMarkInfoVectorIterator;
-		m_WhiteMark.SetPosition(rAtlasMarkInfo.m_fScreenX, rAtlasMarkInfo.m_fScreenY);
-		m_WhiteMark.Render();
-		++m_AtlasMarkInfoVectorIterator;
-	}
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLORARG1, D3DTA_DIFFUSE);
+	__RenderMarkVertices(m_kVct_kAtlasMarkVertex);
+	STATEMANAGER.SetTextureStageState(0, D3DTSS_COLORARG1, D3DTA_TFACTOR);
 
 	STATEMANAGER.SetSamplerState(0, D3DSAMP_MINFILTER, D3DTEXF_LINEAR);
 	STATEMANAGER.SetSamplerState(0, D3DSAMP_MAGFILTER, D3DTEXF_LINEAR);
@@ -1454,6 +1552,17 @@ void CPythonMiniMap::__Initialize()
 	D3DXMatrixIdentity(&m_matWorld);
 	D3DXMatrixIdentity(&m_matMiniMapCover);
 	D3DXMatrixIdentity(&m_matWorldAtlas);
+
+	memset(&m_kMarkQuad, 0, sizeof(m_kMarkQuad));
+	m_kVct_kMarkPosition.clear();
+	m_kVct_kLastMarkPosition.clear();
+	m_kVct_kMarkVertex.clear();
+	m_uPartyMarkVertexBase = 0;
+	m_uPartyMarkVertexCount = 0;
+	m_isMarkDirty = true;
+
+	m_kVct_kAtlasMarkVertex.clear();
+	m_isAtlasMarkDirty = true;
 }
 
 void CPythonMiniMap::Destroy()
@@ -108,6 +108,12 @@ class CPythonMiniMap : public CScreen, public CSingleton<CPythonMiniMap>
 
 		void __GlobalPositionToAtlasPosition(long lx, long ly, float * pfx, float * pfy);
 
+		void __UpdateMarkTexCoord();
+		void __UpdateMarkVertices();
+		void __UpdateAtlasMarkVertices();
+		void __AppendMarkVertex(std::vector<TPDTVertex> & rkVct_kVertex, float fx, float fy, DWORD dwColor);
+		void __RenderMarkVertices(std::vector<TPDTVertex> & rkVct_kVertex);
+
 	protected:
 		// Atlas
 		typedef struct 
@@ -146,6 +152,8 @@ class CPythonMiniMap : public CScreen, public CSingleton<CPythonMiniMap>
 
 			DWORD dwSrcTime;
 			DWORD dwDstTime;
+
+			bool isMoving;
 		};
 
 		// ĳ Ʈ
@@ -159,6 +167,16 @@ class CPythonMiniMap : public CScreen, public CSingleton<CPythonMiniMap>
 		typedef std::vector<TMarkPosition>				TInstanceMarkPositionVector;
 		typedef TInstanceMarkPositionVector::iterator	TInstancePositionVectorIterator;
 
+		// ȭƮ ũ 簢 ũ ؽ ǥ
+		typedef struct
+		{
+			float	fWidth;
+			float	fHeight;
+			float	su, sv, eu, ev;
+			int		iTextureWidth;
+			int		iTextureHeight;
+		} TMarkQuad;
+
 	protected:
 		bool __GetWayPoint(DWORD dwID, TAtlasMarkInfo ** ppkInfo);
 		void __UpdateWayPoint(TAtlasMarkInfo * pkInfo, int ix, int iy);
@@ -198,6 +216,18 @@ class CPythonMiniMap : public CScreen, public CSingleton<CPythonMiniMap>
 		TInstanceMarkPositionVector		m_WarpPositionVector;
 		std::map<DWORD, SObserver>		m_kMap_dwVID_kObserver;
 
+		// ׸   ũ ġ ѹ ׸ 簢
+		TMarkQuad						m_kMarkQuad;
+		TInstanceMarkPositionVector		m_kVct_kMarkPosition;
+		TInstanceMarkPositionVector		m_kVct_kLastMarkPosition;
+		std::vector<TPDTVertex>			m_kVct_kMarkVertex;
+		UINT							m_uPartyMarkVertexBase;
+		UINT							m_uPartyMarkVertexCount;
+		bool							m_isMarkDirty;
+
+		std::vector<TPDTVertex>			m_kVct_kAtlasMarkVertex;
+		bool							m_isAtlasMarkDirty;
+
 		bool							m_bAtlas;
 		bool							m_bShow;
 
@@ -11,6 +11,8 @@
 
 #include "ProcessCRC.h"
 
+#include "../EterBase/lzo.h"
+
 // MARK_BUG_FIX
 static DWORD gs_nextDownloadMarkTime = 0;
 // END_OF_MARK_BUG_FIX
@@ -35,10 +37,15 @@ class CMainPacketHeaderMap : public CNetworkPacketHeaderMap
 			Set(HEADER_GC_PVP,					CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPVP), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_DUEL_START,			CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCDuelStart), DYNAMIC_SIZE_PACKET));
 			Set(HEADER_GC_CHARACTER_ADD,		CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCCharacterAdd), STATIC_SIZE_PACKET));
+			Set(HEADER_GC_CHARACTER_ADD_BULK,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCCharacterAddBulk), DYNAMIC_SIZE_PACKET));
 			Set(HEADER_GC_CHAR_ADDITIONAL_INFO,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCCharacterAdditionalInfo), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_CHARACTER_UPDATE,		CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCCharacterUpdate), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_CHARACTER_DEL,		CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCCharacterDelete), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_MOVE,		CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCMove), STATIC_SIZE_PACKET));
+			Set(HEADER_GC_MOVE_BULK,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCMoveBulk), DYNAMIC_SIZE_PACKET));
+			Set(HEADER_GC_CHARACTER_POINT_CHANGE_BULK,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPointChangeBulk), DYNAMIC_SIZE_PACKET));
+			Set(HEADER_GC_MOVE_BULK_PACKED,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCMoveBulkPacked), DYNAMIC_SIZE_PACKET));
+			Set(HEADER_GC_CHARACTER_POINT_CHANGE_BULK_PACKED,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPointChangeBulkPacked), DYNAMIC_SIZE_PACKET));
 			Set(HEADER_GC_CHAT,					CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCChat), DYNAMIC_SIZE_PACKET));
 
 			Set(HEADER_GC_SYNC_POSITION,		CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCSyncPosition), DYNAMIC_SIZE_PACKET));
@@ -85,6 +92,7 @@ class CMainPacketHeaderMap : public CNetworkPacketHeaderMap
 			Set(HEADER_GC_EXCHANGE,		CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCExchange), STATIC_SIZE_PACKET));
 
 			Set(HEADER_GC_PING,			CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPing), STATIC_SIZE_PACKET));
+			Set(HEADER_GC_COMPRESSED_PACKET,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCCompressedPacket), DYNAMIC_SIZE_PACKET));
 
 			Set(HEADER_GC_SCRIPT,			CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCScript), DYNAMIC_SIZE_PACKET));
 			Set(HEADER_GC_QUEST_CONFIRM,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCQuestConfirm), STATIC_SIZE_PACKET));
@@ -109,6 +117,7 @@ class CMainPacketHeaderMap : public CNetworkPacketHeaderMap
 			Set(HEADER_GC_PARTY_INVITE,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyInvite), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_PARTY_ADD,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyAdd), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_PARTY_UPDATE,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyUpdate), STATIC_SIZE_PACKET));
+			Set(HEADER_GC_PARTY_UPDATE_BULK,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyUpdateBulk), DYNAMIC_SIZE_PACKET));
 			Set(HEADER_GC_PARTY_REMOVE,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyRemove), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_PARTY_LINK,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyLink), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_PARTY_UNLINK,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCPartyUnlink), STATIC_SIZE_PACKET));
@@ -153,6 +162,7 @@ class CMainPacketHeaderMap : public CNetworkPacketHeaderMap
 
 			Set(HEADER_GC_DIG_MOTION, CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCDigMotion), STATIC_SIZE_PACKET));
 			Set(HEADER_GC_DAMAGE_INFO, CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCDamageInfo), STATIC_SIZE_PACKET));
+			Set(HEADER_GC_DAMAGE_INFO_BULK, CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCDamageInfoBulk), DYNAMIC_SIZE_PACKET));
 
 
 			Set(HEADER_GC_HYBRIDCRYPT_KEYS,	CNetworkPacketHeaderMap::TPacketType(sizeof(TPacketGCHybridCryptKeys), DYNAMIC_SIZE_PACKET));
@@ -529,6 +539,20 @@ bool CPythonNetworkStream::CheckPacket(TPacketHeader * pRetHeader)
 				DynamicSizePacketHeader.size);
 			return false;
 		}
+
+		// 압축 패킷은 풀어서 수신 버퍼 앞에 다시 넣고 처음부터 확인한다.
+		if (HEADER_GC_COMPRESSED_PACKET == header)
+		{
+			if (!__RecvCompressedPacket())
+			{
+				ClearRecvBuffer();
+
+				PostQuitMessage(0);
+				return false;
+			}
+
+			return CheckPacket(pRetHeader);
+		}
 	}
 	else
 	{
@@ -554,6 +578,44 @@ bool CPythonNetworkStream::CheckPacket(TPacketHeader * pRetHeader)
 	return true;
 }
 
+bool CPythonNetworkStream::__RecvCompressedPacket()
+{
+	static std::vector<BYTE> s_vecCompressed;
+	static std::vector<BYTE> s_vecDecompressed;
+
+	TPacketGCCompressedPacket kPacket;
+
+	if (!Recv(sizeof(kPacket), &kPacket))
+		return false;
+
+	int iCompressedSize = kPacket.size - sizeof(kPacket);
+
+	if (iCompressedSize <= 0 || kPacket.dwRealSize == 0 || kPacket.dwRealSize > 1024 * 1024)
+	{
+		TraceError("CPythonNetworkStream::__RecvCompressedPacket - invalid size %d real %u, last: %d %d",
+			iCompressedSize, kPacket.dwRealSize, g_iLastPacket[0], g_iLastPacket[1]);
+		return false;
+	}
+
+	s_vecCompressed.resize(iCompressedSize);
+
+	if (!Recv(iCompressedSize, &s_vecCompressed[0]))
+		return false;
+
+	s_vecDecompressed.resize(kPacket.dwRealSize);
+
+	lzo_uint uiRealSize = kPacket.dwRealSize;
+
+	if (LZO_E_OK != lzo1x_decompress_safe(&s_vecCompressed[0], iCompressedSize, &s_vecDecompressed[0], &uiRealSize, CLZO::Instance().GetWorkMemory()) ||
+		uiRealSize != kPacket.dwRealSize)
+	{
+		TraceError("CPythonNetworkStream::__RecvCompressedPacket - decompress failed, last: %d %d", g_iLastPacket[0], g_iLastPacket[1]);
+		return false;
+	}
+
+	return __PushRecvBuffer(uiRealSize, &s_vecDecompressed[0]);
+}
+
 bool CPythonNetworkStream::RecvErrorPacket(int header)
 {
 	TraceError("Phase %s does not handle this header (header: %d, last: %d, %d)",
@@ -851,6 +913,9 @@ CPythonNetworkStream::CPythonNetworkStream()
 
 	m_dwLastGamePingTime = 0;
 
+	// 게임 서버 패킷은 프레임이 떨어져도 밀리지 않게 수신 스레드로 받는다
+	SetRecvThreadMode(true);
+
 	m_dwLoginKey = 0;
 	m_isWaitLoginKey = FALSE;
 	m_isStartGame = FALSE;
@@ -859,6 +924,7 @@ CPythonNetworkStream::CPythonNetworkStream()
 	m_strPhase = "OffLine";
 	
 	__InitializeGamePhase();
+	__InitializeGamePacketHandler();
 	__InitializeMarkAuth();
 
 	__DirectEnterMode_Initialize();
@@ -98,6 +98,8 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 
 		DWORD GetGuildID();
 
+		void GetInfo(std::string* pstInfo);
+
 		UINT UploadMark(const char* c_szImageFileName);
 		UINT UploadSymbol(const char* c_szImageFileName);
 
@@ -161,6 +163,7 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 		bool SendShopEndPacket();
 		bool SendShopBuyPacket(BYTE byCount);
 		bool SendShopSellPacket(BYTE bySlot, BYTE byCount);
+		bool SendShopSearchPacket(DWORD dwVnum, DWORD dwMaxPrice, WORD wPage);
 
 		// Exchange
 		bool SendExchangeStartPacket(DWORD vid);
@@ -408,6 +411,8 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 		bool RecvDuelStartPacket();
         bool RecvGlobalTimePacket();
 		bool RecvCharacterAppendPacket();
+		bool RecvCharacterAppendBulkPacket();
+		void __ApplyCharacterAdd(TPacketGCCharacterAdd& chrAddPacket);
 		bool RecvCharacterAdditionalInfo();
 		bool RecvCharacterUpdatePacket();
 		bool RecvCharacterDeletePacket();
@@ -416,11 +421,16 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 		bool RecvSyncPositionPacket();
 		bool RecvWhisperPacket();
 		bool RecvPointChange();					// Alarm to python
+		bool RecvPointChangeBulkPacket();
+		bool RecvPointChangeBulkPackedPacket();
+		void __ApplyPointChange(const TPacketGCPointChange& c_rkPointChange);
 		bool RecvChangeSpeedPacket();
 
 		bool RecvStunPacket();
 		bool RecvDeadPacket();
 		bool RecvCharacterMovePacket();
+		bool RecvCharacterMoveBulkPacket();
+		bool RecvCharacterMoveBulkPackedPacket();
 
 		bool RecvItemDelPacket();					// Alarm to python
 		bool RecvItemSetPacket();					// Alarm to python
@@ -453,6 +463,8 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 		bool RecvTargetPacket();
 		bool RecvViewEquipPacket();
 		bool RecvDamageInfoPacket();
+		bool RecvDamageInfoBulkPacket();
+		void __ApplyDamageInfo(const TPacketGCDamageInfo& c_rkDamageInfo);
 
 		// Fly
 		bool RecvCreateFlyPacket();
@@ -469,6 +481,8 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 		bool RecvPartyInvite();
 		bool RecvPartyAdd();
 		bool RecvPartyUpdate();
+		bool RecvPartyUpdateBulk();
+		void __ApplyPartyUpdate(const TPacketGCPartyUpdate& kPartyUpdatePacket);
 		bool RecvPartyRemove();
 		bool RecvPartyLink();
 		bool RecvPartyUnlink();
@@ -538,6 +552,7 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 
 	protected:
 		bool CheckPacket(TPacketHeader * pRetHeader);
+		bool __RecvCompressedPacket();
 		
 		void __InitializeGamePhase();
 		void __InitializeMarkAuth();
@@ -667,6 +682,38 @@ class CPythonNetworkStream : public CNetworkStream, public CSingleton<CPythonNet
 
 		std::deque<std::string> m_kQue_stHack;
 
+	protected:
+		// Game Phase Packet Handler
+		typedef bool (CPythonNetworkStream::*TPacketHandler)();
+
+		typedef struct SGamePacketHandler
+		{
+			TPacketHandler	pfnRecv;
+			bool			isLeavePhase;	// 처리한 뒤 GamePhase 를 빠져나간다 (페이즈나 암호화가 바뀌는 패킷)
+		} TGamePacketHandler;
+
+		typedef struct SPacketStat
+		{
+			DWORD	dwCount;
+			DWORD	dwTotalUSec;
+			DWORD	dwMaxUSec;
+		} TPacketStat;
+
+		enum
+		{
+			PACKET_HEADER_NUM = 256,
+			GAME_PHASE_RECV_TIME_BUDGET_MSEC = 8,	// 한 프레임에 패킷 처리에 쓰는 시간
+		};
+
+		void __InitializeGamePacketHandler();
+		void __RegisterGamePacketHandler(TPacketHeader header, TPacketHandler pfnRecv, bool isLeavePhase = false);
+		void __AddPacketStat(TPacketHeader header, const LARGE_INTEGER& c_rliBegin, const LARGE_INTEGER& c_rliEnd);
+
+		TGamePacketHandler	m_akGamePacketHandler[PACKET_HEADER_NUM];
+		TPacketStat			m_akPacketStat[PACKET_HEADER_NUM];
+		DWORD				m_dwLastFramePacketCount;
+		DWORD				m_dwLastFramePacketUSec;
+
 	private:
 		struct SDirectEnterMode
 		{
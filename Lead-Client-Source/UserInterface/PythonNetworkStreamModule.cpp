@@ -841,6 +841,22 @@ PyObject* netSendShopSellPacket(PyObject* poSelf, PyObject* poArgs)
 	return Py_BuildNone();
 }
 
+PyObject* netSendShopSearchPacket(PyObject* poSelf, PyObject* poArgs)
+{
+	int iVnum;
+	if (!PyTuple_GetInteger(poArgs, 0, &iVnum))
+		return Py_BuildException();
+	int iMaxPrice;
+	if (!PyTuple_GetInteger(poArgs, 1, &iMaxPrice))
+		return Py_BuildException();
+	int iPage;
+	if (!PyTuple_GetInteger(poArgs, 2, &iPage))
+		return Py_BuildException();
+	CPythonNetworkStream& rkNetStream=CPythonNetworkStream::Instance();
+	rkNetStream.SendShopSearchPacket(iVnum, iMaxPrice, iPage);
+	return Py_BuildNone();
+}
+
 PyObject* netSendExchangeStartPacket(PyObject* poSelf, PyObject* poArgs)
 {
 	int vid;
@@ -1705,6 +1721,7 @@ void initnet()
 		{ "SendShopEndPacket",					netSendShopEndPacket,					METH_VARARGS },
 		{ "SendShopBuyPacket",					netSendShopBuyPacket,					METH_VARARGS },
 		{ "SendShopSellPacket",				netSendShopSellPacket,				METH_VARARGS },
+		{ "SendShopSearchPacket",				netSendShopSearchPacket,				METH_VARARGS },
 
 		{ "SendExchangeStartPacket",			netSendExchangeStartPacket,				METH_VARARGS },
 		{ "SendExchangeItemAddPacket",			netSendExchangeItemAddPacket,			METH_VARARGS },
@@ -1,6 +1,7 @@
 #include "StdAfx.h"
 #include "PythonNetworkStream.h"
 #include "Packet.h"
+#include "../../Lead-Shared-Source/common/varint.h"
 
 #include "PythonGuild.h"
 #include "PythonCharacterManager.h"
@@ -148,17 +149,180 @@ void CPythonNetworkStream::__SetGuildID(DWORD id)
 	}
 }
 
-struct PERF_PacketInfo
-{
-	DWORD dwCount;
-	DWORD dwTime;
+// Game Packet Handler ------------------------------------------------------------------
+void CPythonNetworkStream::__RegisterGamePacketHandler(TPacketHeader header, TPacketHandler pfnRecv, bool isLeavePhase)
+{
+	m_akGamePacketHandler[header].pfnRecv = pfnRecv;
+	m_akGamePacketHandler[header].isLeavePhase = isLeavePhase;
+}
+
+// ϵ   RecvDefaultPacket  
+void CPythonNetworkStream::__InitializeGamePacketHandler()
+{
+	memset(m_akGamePacketHandler, 0, sizeof(m_akGamePacketHandler));
+	memset(m_akPacketStat, 0, sizeof(m_akPacketStat));
+	m_dwLastFramePacketCount = 0;
+	m_dwLastFramePacketUSec = 0;
+
+	__RegisterGamePacketHandler(HEADER_GC_WARP, &CPythonNetworkStream::RecvWarpPacket);
+	__RegisterGamePacketHandler(HEADER_GC_PHASE, &CPythonNetworkStream::RecvPhasePacket, true);
+	__RegisterGamePacketHandler(HEADER_GC_PVP, &CPythonNetworkStream::RecvPVPPacket);
+	__RegisterGamePacketHandler(HEADER_GC_DUEL_START, &CPythonNetworkStream::RecvDuelStartPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_ADD, &CPythonNetworkStream::RecvCharacterAppendPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_ADD_BULK, &CPythonNetworkStream::RecvCharacterAppendBulkPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHAR_ADDITIONAL_INFO, &CPythonNetworkStream::RecvCharacterAdditionalInfo);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_UPDATE, &CPythonNetworkStream::RecvCharacterUpdatePacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_DEL, &CPythonNetworkStream::RecvCharacterDeletePacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHAT, &CPythonNetworkStream::RecvChatPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SYNC_POSITION, &CPythonNetworkStream::RecvSyncPositionPacket);
+	__RegisterGamePacketHandler(HEADER_GC_OWNERSHIP, &CPythonNetworkStream::RecvOwnerShipPacket);
+	__RegisterGamePacketHandler(HEADER_GC_WHISPER, &CPythonNetworkStream::RecvWhisperPacket);
+	__RegisterGamePacketHandler(HEADER_GC_MOVE, &CPythonNetworkStream::RecvCharacterMovePacket);
+	__RegisterGamePacketHandler(HEADER_GC_MOVE_BULK, &CPythonNetworkStream::RecvCharacterMoveBulkPacket);
+	__RegisterGamePacketHandler(HEADER_GC_MOVE_BULK_PACKED, &CPythonNetworkStream::RecvCharacterMoveBulkPackedPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_POSITION, &CPythonNetworkStream::RecvCharacterPositionPacket);
+	__RegisterGamePacketHandler(HEADER_GC_STUN, &CPythonNetworkStream::RecvStunPacket);
+	__RegisterGamePacketHandler(HEADER_GC_DEAD, &CPythonNetworkStream::RecvDeadPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_POINT_CHANGE, &CPythonNetworkStream::RecvPointChange);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_POINT_CHANGE_BULK, &CPythonNetworkStream::RecvPointChangeBulkPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_POINT_CHANGE_BULK_PACKED, &CPythonNetworkStream::RecvPointChangeBulkPackedPacket);
+	__RegisterGamePacketHandler(HEADER_GC_ITEM_DEL, &CPythonNetworkStream::RecvItemDelPacket);
+	__RegisterGamePacketHandler(HEADER_GC_ITEM_SET, &CPythonNetworkStream::RecvItemSetPacket);
+	__RegisterGamePacketHandler(HEADER_GC_ITEM_UPDATE, &CPythonNetworkStream::RecvItemUpdatePacket);
+	__RegisterGamePacketHandler(HEADER_GC_ITEM_GROUND_ADD, &CPythonNetworkStream::RecvItemGroundAddPacket);
+	__RegisterGamePacketHandler(HEADER_GC_ITEM_GROUND_DEL, &CPythonNetworkStream::RecvItemGroundDelPacket);
+	__RegisterGamePacketHandler(HEADER_GC_ITEM_OWNERSHIP, &CPythonNetworkStream::RecvItemOwnership);
+	__RegisterGamePacketHandler(HEADER_GC_QUICKSLOT_ADD, &CPythonNetworkStream::RecvQuickSlotAddPacket);
+	__RegisterGamePacketHandler(HEADER_GC_QUICKSLOT_DEL, &CPythonNetworkStream::RecvQuickSlotDelPacket);
+	__RegisterGamePacketHandler(HEADER_GC_QUICKSLOT_SWAP, &CPythonNetworkStream::RecvQuickSlotMovePacket);
+	__RegisterGamePacketHandler(HEADER_GC_MOTION, &CPythonNetworkStream::RecvMotionPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SHOP, &CPythonNetworkStream::RecvShopPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SHOP_SIGN, &CPythonNetworkStream::RecvShopSignPacket);
+	__RegisterGamePacketHandler(HEADER_GC_EXCHANGE, &CPythonNetworkStream::RecvExchangePacket);
+	__RegisterGamePacketHandler(HEADER_GC_QUEST_INFO, &CPythonNetworkStream::RecvQuestInfoPacket);
+	__RegisterGamePacketHandler(HEADER_GC_REQUEST_MAKE_GUILD, &CPythonNetworkStream::RecvRequestMakeGuild);
+	__RegisterGamePacketHandler(HEADER_GC_PING, &CPythonNetworkStream::RecvPingPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SCRIPT, &CPythonNetworkStream::RecvScriptPacket);
+	__RegisterGamePacketHandler(HEADER_GC_QUEST_CONFIRM, &CPythonNetworkStream::RecvQuestConfirmPacket);
+	__RegisterGamePacketHandler(HEADER_GC_TARGET, &CPythonNetworkStream::RecvTargetPacket);
+	__RegisterGamePacketHandler(HEADER_GC_DAMAGE_INFO, &CPythonNetworkStream::RecvDamageInfoPacket);
+	__RegisterGamePacketHandler(HEADER_GC_DAMAGE_INFO_BULK, &CPythonNetworkStream::RecvDamageInfoBulkPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHANGE_SPEED, &CPythonNetworkStream::RecvChangeSpeedPacket);
+	__RegisterGamePacketHandler(HEADER_GC_CHARACTER_POINTS, &CPythonNetworkStream::__RecvPlayerPoints);
+	__RegisterGamePacketHandler(HEADER_GC_CREATE_FLY, &CPythonNetworkStream::RecvCreateFlyPacket);
+	__RegisterGamePacketHandler(HEADER_GC_FLY_TARGETING, &CPythonNetworkStream::RecvFlyTargetingPacket);
+	__RegisterGamePacketHandler(HEADER_GC_ADD_FLY_TARGETING, &CPythonNetworkStream::RecvAddFlyTargetingPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SKILL_LEVEL, &CPythonNetworkStream::RecvSkillLevel);
+	__RegisterGamePacketHandler(HEADER_GC_MESSENGER, &CPythonNetworkStream::RecvMessenger);
+	__RegisterGamePacketHandler(HEADER_GC_GUILD, &CPythonNetworkStream::RecvGuild);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_INVITE, &CPythonNetworkStream::RecvPartyInvite);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_ADD, &CPythonNetworkStream::RecvPartyAdd);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_UPDATE, &CPythonNetworkStream::RecvPartyUpdate);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_UPDATE_BULK, &CPythonNetworkStream::RecvPartyUpdateBulk);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_REMOVE, &CPythonNetworkStream::RecvPartyRemove);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_LINK, &CPythonNetworkStream::RecvPartyLink);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_UNLINK, &CPythonNetworkStream::RecvPartyUnlink);
+	__RegisterGamePacketHandler(HEADER_GC_PARTY_PARAMETER, &CPythonNetworkStream::RecvPartyParameter);
+	__RegisterGamePacketHandler(HEADER_GC_SAFEBOX_SET, &CPythonNetworkStream::RecvSafeBoxSetPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SAFEBOX_DEL, &CPythonNetworkStream::RecvSafeBoxDelPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SAFEBOX_WRONG_PASSWORD, &CPythonNetworkStream::RecvSafeBoxWrongPasswordPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SAFEBOX_SIZE, &CPythonNetworkStream::RecvSafeBoxSizePacket);
+	__RegisterGamePacketHandler(HEADER_GC_FISHING, &CPythonNetworkStream::RecvFishing);
+	__RegisterGamePacketHandler(HEADER_GC_DUNGEON, &CPythonNetworkStream::RecvDungeon);
+	__RegisterGamePacketHandler(HEADER_GC_TIME, &CPythonNetworkStream::RecvTimePacket);
+	__RegisterGamePacketHandler(HEADER_GC_WALK_MODE, &CPythonNetworkStream::RecvWalkModePacket);
+	__RegisterGamePacketHandler(HEADER_GC_SKILL_GROUP, &CPythonNetworkStream::RecvChangeSkillGroupPacket);
+	__RegisterGamePacketHandler(HEADER_GC_REFINE_INFORMATION, &CPythonNetworkStream::RecvRefineInformationPacket);
+	__RegisterGamePacketHandler(HEADER_GC_SPECIAL_EFFECT, &CPythonNetworkStream::RecvSpecialEffect);
+	__RegisterGamePacketHandler(HEADER_GC_NPC_POSITION, &CPythonNetworkStream::RecvNPCList);
+	__RegisterGamePacketHandler(HEADER_GC_CHANNEL, &CPythonNetworkStream::RecvChannelPacket);
+	__RegisterGamePacketHandler(HEADER_GC_VIEW_EQUIP, &CPythonNetworkStream::RecvViewEquipPacket);
+	__RegisterGamePacketHandler(HEADER_GC_LAND_LIST, &CPythonNetworkStream::RecvLandPacket);
+	__RegisterGamePacketHandler(HEADER_GC_TARGET_CREATE, &CPythonNetworkStream::RecvTargetCreatePacket);
+	__RegisterGamePacketHandler(HEADER_GC_TARGET_UPDATE, &CPythonNetworkStream::RecvTargetUpdatePacket);
+	__RegisterGamePacketHandler(HEADER_GC_TARGET_DELETE, &CPythonNetworkStream::RecvTargetDeletePacket);
+	__RegisterGamePacketHandler(HEADER_GC_AFFECT_ADD, &CPythonNetworkStream::RecvAffectAddPacket);
+	__RegisterGamePacketHandler(HEADER_GC_AFFECT_REMOVE, &CPythonNetworkStream::RecvAffectRemovePacket);
+	__RegisterGamePacketHandler(HEADER_GC_MALL_OPEN, &CPythonNetworkStream::RecvMallOpenPacket);
+	__RegisterGamePacketHandler(HEADER_GC_MALL_SET, &CPythonNetworkStream::RecvMallItemSetPacket);
+	__RegisterGamePacketHandler(HEADER_GC_MALL_DEL, &CPythonNetworkStream::RecvMallItemDelPacket);
+	__RegisterGamePacketHandler(HEADER_GC_LOVER_INFO, &CPythonNetworkStream::RecvLoverInfoPacket);
+	__RegisterGamePacketHandler(HEADER_GC_LOVE_POINT_UPDATE, &CPythonNetworkStream::RecvLovePointUpdatePacket);
+	__RegisterGamePacketHandler(HEADER_GC_DIG_MOTION, &CPythonNetworkStream::RecvDigMotionPacket);
+	__RegisterGamePacketHandler(HEADER_GC_HANDSHAKE, &CPythonNetworkStream::RecvHandshakePacket, true);
+	__RegisterGamePacketHandler(HEADER_GC_TIME_SYNC, &CPythonNetworkStream::RecvHandshakeOKPacket, true);
+	__RegisterGamePacketHandler(HEADER_GC_HYBRIDCRYPT_KEYS, &CPythonNetworkStream::RecvHybridCryptKeyPacket, true);
+	__RegisterGamePacketHandler(HEADER_GC_HYBRIDCRYPT_SDB, &CPythonNetworkStream::RecvHybridCryptSDBPacket, true);
+	__RegisterGamePacketHandler(HEADER_GC_SPECIFIC_EFFECT, &CPythonNetworkStream::RecvSpecificEffect);
+	__RegisterGamePacketHandler(HEADER_GC_DRAGON_SOUL_REFINE, &CPythonNetworkStream::RecvDragonSoulRefine);
+}
+
+void CPythonNetworkStream::__AddPacketStat(TPacketHeader header, const LARGE_INTEGER& c_rliBegin, const LARGE_INTEGER& c_rliEnd)
+{
+	static LARGE_INTEGER s_liFrequency;
+
+	if (!s_liFrequency.QuadPart)
+		QueryPerformanceFrequency(&s_liFrequency);
+
+	DWORD dwUSec = (DWORD) ((c_rliEnd.QuadPart - c_rliBegin.QuadPart) * 1000000 / s_liFrequency.QuadPart);
+
+	TPacketStat & rkStat = m_akPacketStat[header];
+	++rkStat.dwCount;
+	rkStat.dwTotalUSec += dwUSec;
+
+	if (dwUSec > rkStat.dwMaxUSec)
+		rkStat.dwMaxUSec = dwUSec;
+
+	++m_dwLastFramePacketCount;
+	m_dwLastFramePacketUSec += dwUSec;
+}
+
+// ó ð     ش
+void CPythonNetworkStream::GetInfo(std::string* pstInfo)
+{
+	const int TOP_HEADER_NUM = 5;
+
+	int aiTop[TOP_HEADER_NUM];
+	int iTopCount = 0;
+
+	for (int i = 0; i < PACKET_HEADER_NUM; ++i)
+	{
+		if (!m_akPacketStat[i].dwCount)
+			continue;
+
+		int iPos = iTopCount;
+
+		while (iPos > 0 && m_akPacketStat[aiTop[iPos - 1]].dwTotalUSec < m_akPacketStat[i].dwTotalUSec)
+		{
+			if (iPos < TOP_HEADER_NUM)
+				aiTop[iPos] = aiTop[iPos - 1];
+
+			--iPos;
+		}
+
+		if (iPos < TOP_HEADER_NUM)
+		{
+			aiTop[iPos] = i;
+
+			if (iTopCount < TOP_HEADER_NUM)
+				++iTopCount;
+		}
+	}
+
+	char szInfo[128];
+	_snprintf(szInfo, sizeof(szInfo), "Network: frame %u packets %uus, recv buf %d",
+			m_dwLastFramePacketCount, m_dwLastFramePacketUSec, GetRecvBufferSize());
+	pstInfo->append(szInfo);
 
-	PERF_PacketInfo()
+	for (int i = 0; i < iTopCount; ++i)
 	{
-		dwCount=0;
-		dwTime=0;
+		const TPacketStat & c_rkStat = m_akPacketStat[aiTop[i]];
+
+		_snprintf(szInfo, sizeof(szInfo), ", [%d] %u x %uus (max %uus)",
+				aiTop[i], c_rkStat.dwCount, c_rkStat.dwTotalUSec / c_rkStat.dwCount, c_rkStat.dwMaxUSec);
+		pstInfo->append(szInfo);
 	}
-};
+}
 
 // Game Phase ---------------------------------------------------------------------------
 void CPythonNetworkStream::GamePhase()
@@ -172,369 +336,37 @@ void CPythonNetworkStream::GamePhase()
 	TPacketHeader header = 0;
 	bool ret = true;
 
-	const DWORD MAX_RECV_COUNT = 4;
 	const DWORD SAFE_RECV_BUFSIZE = 8192;
-	DWORD dwRecvCount = 0;
+	DWORD dwStartTime = ELTimer_GetMSec();
 
+	m_dwLastFramePacketCount = 0;
+	m_dwLastFramePacketUSec = 0;
+
+	//  ƴ϶ ð ´.  Ŷ ð  ŭ  ӿ óѴ.
     while (ret)
 	{
-		if(dwRecvCount++ >= MAX_RECV_COUNT-1 && GetRecvBufferSize() < SAFE_RECV_BUFSIZE
+		if (ELTimer_GetMSec() - dwStartTime >= GAME_PHASE_RECV_TIME_BUDGET_MSEC && GetRecvBufferSize() < SAFE_RECV_BUFSIZE
 			&& m_strPhase == "Game") //phase_game  ƴϾ   찡 ִ.
 			break;
 
 		if (!CheckPacket(&header))
 			break;
 
-		switch (header)
-		{
-			case HEADER_GC_WARP:
-				ret = RecvWarpPacket();
-				break;
-
-			case HEADER_GC_PHASE:
-				ret = RecvPhasePacket();
-				return; // ߿ Phase  ٲ ϴ  GamePhase Ż - [levites]
-				break;
-
-			case HEADER_GC_PVP:
-				ret = RecvPVPPacket();
-				break;
-
-			case HEADER_GC_DUEL_START:
-				ret = RecvDuelStartPacket();
-				break;
-
-			case HEADER_GC_CHARACTER_ADD:
- 				ret = RecvCharacterAppendPacket();
-				break;
-
-			case HEADER_GC_CHAR_ADDITIONAL_INFO:
-				ret = RecvCharacterAdditionalInfo();
-				break;
-
-			case HEADER_GC_CHARACTER_UPDATE:
-				ret = RecvCharacterUpdatePacket();
-				break;
-
-			case HEADER_GC_CHARACTER_DEL:
-				ret = RecvCharacterDeletePacket();
-				break;
-
-			case HEADER_GC_CHAT:
-				ret = RecvChatPacket();
-				break;
-
-			case HEADER_GC_SYNC_POSITION:
-				ret = RecvSyncPositionPacket();
-				break;
-
-			case HEADER_GC_OWNERSHIP:
-				ret = RecvOwnerShipPacket();
-				break;
-
-			case HEADER_GC_WHISPER:
-				ret = RecvWhisperPacket();
-				break;
-
-			case HEADER_GC_MOVE:
-				ret = RecvCharacterMovePacket();
-				break;
-
-			// Position
-			case HEADER_GC_CHARACTER_POSITION:
-				ret = RecvCharacterPositionPacket();
-				break;
-
-			// Battle Packet
-			case HEADER_GC_STUN:
-				ret = RecvStunPacket();
-				break;
-
-			case HEADER_GC_DEAD:
-				ret = RecvDeadPacket();
-				break;
-
-			case HEADER_GC_CHARACTER_POINT_CHANGE:
-				ret = RecvPointChange();
-				break;
-
-			// item packet.
-			case HEADER_GC_ITEM_DEL:
-				ret = RecvItemDelPacket();
-				break;
-
-			case HEADER_GC_ITEM_SET:
-				ret = RecvItemSetPacket();
-				break;
-
-			case HEADER_GC_ITEM_UPDATE:
-				ret = RecvItemUpdatePacket();
-				break;
-
-			case HEADER_GC_ITEM_GROUND_ADD:
-				ret = RecvItemGroundAddPacket();
-				break;
-
-			case HEADER_GC_ITEM_GROUND_DEL:
-				ret = RecvItemGroundDelPacket();
-				break;
-
-			case HEADER_GC_ITEM_OWNERSHIP:
-				ret = RecvItemOwnership();
-				break;
-
-			case HEADER_GC_QUICKSLOT_ADD:
-				ret = RecvQuickSlotAddPacket();
-				break;
-
-			case HEADER_GC_QUICKSLOT_DEL:
-				ret = RecvQuickSlotDelPacket();
-				break;
-
-			case HEADER_GC_QUICKSLOT_SWAP:
-				ret = RecvQuickSlotMovePacket();
-				break;
-
-			case HEADER_GC_MOTION:
-				ret = RecvMotionPacket();
-				break;
-
-			case HEADER_GC_SHOP:
-				ret = RecvShopPacket();
-				break;
-				
-			case HEADER_GC_SHOP_SIGN:
-				ret = RecvShopSignPacket();
-				break;
-
-			case HEADER_GC_EXCHANGE:
-				ret = RecvExchangePacket();
-				break;
-
-			case HEADER_GC_QUEST_INFO:
-				ret = RecvQuestInfoPacket();
-				break;
-
-			case HEADER_GC_REQUEST_MAKE_GUILD:
-				ret = RecvRequestMakeGuild();
-				break;
-
-			case HEADER_GC_PING:
-				ret = RecvPingPacket();
-				break;
-
-			case HEADER_GC_SCRIPT:
-				ret = RecvScriptPacket();
-				break;
-
-			case HEADER_GC_QUEST_CONFIRM:
-				ret = RecvQuestConfirmPacket();
-				break;
-
-			case HEADER_GC_TARGET:
-				ret = RecvTargetPacket();
-				break;
-
-			case HEADER_GC_DAMAGE_INFO:
-				ret = RecvDamageInfoPacket();
-				break;
-
-			case HEADER_GC_CHANGE_SPEED:
-				ret = RecvChangeSpeedPacket();
-				break;
-
-			case HEADER_GC_CHARACTER_POINTS:
-				ret = __RecvPlayerPoints();
-				break;
-
-			case HEADER_GC_CREATE_FLY:
-				ret = RecvCreateFlyPacket();
-				break;
-
-			case HEADER_GC_FLY_TARGETING:
-				ret = RecvFlyTargetingPacket();
-				break;
-
-			case HEADER_GC_ADD_FLY_TARGETING:
-				ret = RecvAddFlyTargetingPacket();
-				break;
-
-			case HEADER_GC_SKILL_LEVEL:
-				ret = RecvSkillLevel();
-				break;
-
-			case HEADER_GC_MESSENGER:
-				ret = RecvMessenger();
-				break;
-
-			case HEADER_GC_GUILD:
-				ret = RecvGuild();
-				break;
-
-			case HEADER_GC_PARTY_INVITE:
-				ret = RecvPartyInvite();
-				break;
-
-			case HEADER_GC_PARTY_ADD:
-				ret = RecvPartyAdd();
-				break;
-
-			case HEADER_GC_PARTY_UPDATE:
-				ret = RecvPartyUpdate();
-				break;
-
-			case HEADER_GC_PARTY_REMOVE:
-				ret = RecvPartyRemove();
-				break;
-
-			case HEADER_GC_PARTY_LINK:
-				ret = RecvPartyLink();
-				break;
-
-			case HEADER_GC_PARTY_UNLINK:
-				ret = RecvPartyUnlink();
-				break;
-
-			case HEADER_GC_PARTY_PARAMETER:
-				ret = RecvPartyParameter();
-				break;
-
-			case HEADER_GC_SAFEBOX_SET:
-				ret = RecvSafeBoxSetPacket();
-				break;
-
-			case HEADER_GC_SAFEBOX_DEL:
-				ret = RecvSafeBoxDelPacket();
-				break;
-
-			case HEADER_GC_SAFEBOX_WRONG_PASSWORD:
-				ret = RecvSafeBoxWrongPasswordPacket();
-				break;
-
-			case HEADER_GC_SAFEBOX_SIZE:
-				ret = RecvSafeBoxSizePacket();
-				break;
-
-			case HEADER_GC_FISHING:
-				ret = RecvFishing();
-				break;
-
-			case HEADER_GC_DUNGEON:
-				ret = RecvDungeon();
-				break;
-
-			case HEADER_GC_TIME:
-				ret = RecvTimePacket();
-				break;
-
-			case HEADER_GC_WALK_MODE:
-				ret = RecvWalkModePacket();
-				break;
-
-			case HEADER_GC_SKILL_GROUP:
-				ret = RecvChangeSkillGroupPacket();
-				break;
-
-			case HEADER_GC_REFINE_INFORMATION:
-				ret = RecvRefineInformationPacket();
-				break;
-
-			case HEADER_GC_SPECIAL_EFFECT:
-				ret = RecvSpecialEffect();
-				break;
-
-			case HEADER_GC_NPC_POSITION:
-				ret = RecvNPCList();
-				break;
-
-			case HEADER_GC_CHANNEL:
-				ret = RecvChannelPacket();
-				break;
-
-			case HEADER_GC_VIEW_EQUIP:
-				ret = RecvViewEquipPacket();
-				break;
-
-			case HEADER_GC_LAND_LIST:
-				ret = RecvLandPacket();
-				break;
-
-			case HEADER_GC_TARGET_CREATE:
-				ret = RecvTargetCreatePacket();
-				break;
-
-			case HEADER_GC_TARGET_UPDATE:
-				ret = RecvTargetUpdatePacket();
-				break;
-
-			case HEADER_GC_TARGET_DELETE:
-				ret = RecvTargetDeletePacket();
-				break;
-
-			case HEADER_GC_AFFECT_ADD:
-				ret = RecvAffectAddPacket();
-				break;
-
-			case HEADER_GC_AFFECT_REMOVE:
-				ret = RecvAffectRemovePacket();
-				break;
-
-			case HEADER_GC_MALL_OPEN:
-				ret = RecvMallOpenPacket();
-				break;
-
-			case HEADER_GC_MALL_SET:
-				ret = RecvMallItemSetPacket();
-				break;
-
-			case HEADER_GC_MALL_DEL:
-				ret = RecvMallItemDelPacket();
-				break;
-
-			case HEADER_GC_LOVER_INFO:
-				ret = RecvLoverInfoPacket();
-				break;
-
-			case HEADER_GC_LOVE_POINT_UPDATE:
-				ret = RecvLovePointUpdatePacket();
-				break;
-
-			case HEADER_GC_DIG_MOTION:
-				ret = RecvDigMotionPacket();
-				break;
-
-			case HEADER_GC_HANDSHAKE:
-				RecvHandshakePacket();
-				return;
-				break;
-
-			case HEADER_GC_TIME_SYNC:
-				RecvHandshakeOKPacket();
-				return;
-				break;
-			
-			case HEADER_GC_HYBRIDCRYPT_KEYS:
-				RecvHybridCryptKeyPacket();
-				return;
-				break;
+		const TGamePacketHandler & c_rkHandler = m_akGamePacketHandler[header];
 
-			case HEADER_GC_HYBRIDCRYPT_SDB:
-				RecvHybridCryptSDBPacket();
-				return;
-				break;
+		LARGE_INTEGER liBegin, liEnd;
+		QueryPerformanceCounter(&liBegin);
 
-			case HEADER_GC_SPECIFIC_EFFECT:
-				ret = RecvSpecificEffect();
-				break;
+		if (c_rkHandler.pfnRecv)
+			ret = (this->*c_rkHandler.pfnRecv)();
+		else
+			ret = RecvDefaultPacket(header);
 
-			case HEADER_GC_DRAGON_SOUL_REFINE:
-				ret = RecvDragonSoulRefine();
-				break;
+		QueryPerformanceCounter(&liEnd);
+		__AddPacketStat(header, liBegin, liEnd);
 
-			default:
-				ret = RecvDefaultPacket(header);
-				break;
-		}
+		if (c_rkHandler.isLeavePhase)
+			return; // ߿ Phase  ȣȭ ٲ GamePhase Ż - [levites]
 	}
 
 	if (!ret)
@@ -1295,6 +1127,110 @@ bool CPythonNetworkStream::RecvPointChange()
 		return false;
 	}
 
+	__ApplyPointChange(PointChange);
+	return true;
+}
+
+bool CPythonNetworkStream::RecvPointChangeBulkPacket()
+{
+	TPacketGCPointChangeBulk kPacketBulk;
+
+	if (!Recv(sizeof(kPacketBulk), &kPacketBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvPointChangeBulkPacket - PACKET READ ERROR");
+		return false;
+	}
+
+	TPacketGCPointChangeBulkElement kElement;
+	UINT uCount=(kPacketBulk.wSize-sizeof(kPacketBulk))/sizeof(kElement);
+
+	for (UINT i=0; i<uCount; ++i)
+	{
+		if (!Recv(sizeof(kElement), &kElement))
+		{
+			Tracen("CPythonNetworkStream::RecvPointChangeBulkPacket - ELEMENT READ ERROR");
+			return false;
+		}
+
+		TPacketGCPointChange PointChange;
+		PointChange.header = HEADER_GC_CHARACTER_POINT_CHANGE;
+		PointChange.dwVID = kElement.dwVID;
+		PointChange.type = kElement.type;
+		PointChange.amount = kElement.amount;
+		PointChange.value = kElement.value;
+
+		__ApplyPointChange(PointChange);
+	}
+
+	return true;
+}
+
+bool CPythonNetworkStream::RecvPointChangeBulkPackedPacket()
+{
+	TPacketGCPointChangeBulkPacked kPacketBulk;
+
+	if (!Recv(sizeof(kPacketBulk), &kPacketBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvPointChangeBulkPackedPacket - PACKET READ ERROR");
+		return false;
+	}
+
+	static std::vector<BYTE> s_kVec_bBody;
+	int iBodySize=kPacketBulk.wSize-sizeof(kPacketBulk);
+	s_kVec_bBody.resize(iBodySize+1);
+
+	if (iBodySize>0 && !Recv(iBodySize, &s_kVec_bBody[0]))
+	{
+		Tracen("CPythonNetworkStream::RecvPointChangeBulkPackedPacket - BODY READ ERROR");
+		return false;
+	}
+
+	const BYTE* pbCur=&s_kVec_bBody[0];
+	const BYTE* pbEnd=pbCur+iBodySize;
+	DWORD dwVID=0;
+
+	while (pbCur<pbEnd)
+	{
+		DWORD dwDeltaVID, dwAmount, dwValue;
+		int iLen;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwDeltaVID)))
+			break;
+		pbCur+=iLen;
+
+		if (pbCur>=pbEnd)
+			break;
+		BYTE bType=*pbCur++;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwAmount)))
+			break;
+		pbCur+=iLen;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwValue)))
+			break;
+		pbCur+=iLen;
+
+		// VID   ҿ ̷ ´.
+		dwVID+=varint_unzigzag(dwDeltaVID);
+
+		TPacketGCPointChange PointChange;
+		PointChange.header = HEADER_GC_CHARACTER_POINT_CHANGE;
+		PointChange.dwVID = dwVID;
+		PointChange.type = bType;
+		PointChange.amount = varint_unzigzag(dwAmount);
+		PointChange.value = varint_unzigzag(dwValue);
+
+		__ApplyPointChange(PointChange);
+	}
+
+	if (pbCur!=pbEnd)
+		Tracen("CPythonNetworkStream::RecvPointChangeBulkPackedPacket - ELEMENT DECODE ERROR");
+
+	return true;
+}
+
+void CPythonNetworkStream::__ApplyPointChange(const TPacketGCPointChange& PointChange)
+{
 	CPythonCharacterManager& rkChrMgr = CPythonCharacterManager::Instance();
 	rkChrMgr.ShowPointEffect(PointChange.type, PointChange.dwVID);
 
@@ -1351,8 +1287,6 @@ bool CPythonNetworkStream::RecvPointChange()
 				pOtherInstance->UpdateTextTailLevel(PointChange.value);
 		}
 	}
-
-	return true;
 }
 
 bool CPythonNetworkStream::RecvStunPacket()
@@ -1558,6 +1492,29 @@ bool CPythonNetworkStream::RecvShopPacket()
 			}
 			break;
 
+		case SHOP_SUBHEADER_GC_SEARCH_RESULT:
+			{
+				TPacketGCShopSearchResult * pSearchResultPacket = (TPacketGCShopSearchResult *)&vecBuffer[0];
+				TPacketGCShopSearchItem * pSearchItem = (TPacketGCShopSearchItem *)(pSearchResultPacket + 1);
+
+				PyCallClassMemberFunc(m_apoPhaseWnd[PHASE_WINDOW_GAME], "BINARY_ClearShopSearchResult", Py_BuildValue("()"));
+
+				for (BYTE i = 0; i < pSearchResultPacket->count; ++i, ++pSearchItem)
+				{
+					LONG lX = pSearchItem->x;
+					LONG lY = pSearchItem->y;
+					__GlobalPositionToLocalPosition(lX, lY);
+
+					PyCallClassMemberFunc(m_apoPhaseWnd[PHASE_WINDOW_GAME], "BINARY_AppendShopSearchResult",
+						Py_BuildValue("(isiiiiii)", pSearchItem->owner_vid, pSearchItem->owner_name, lX, lY,
+							pSearchItem->pos, pSearchItem->item.vnum, pSearchItem->item.price, pSearchItem->item.count));
+				}
+
+				PyCallClassMemberFunc(m_apoPhaseWnd[PHASE_WINDOW_GAME], "BINARY_RefreshShopSearchResult",
+					Py_BuildValue("(iii)", pSearchResultPacket->vnum, pSearchResultPacket->page, pSearchResultPacket->total_count));
+			}
+			break;
+
 		case SHOP_SUBHEADER_GC_UPDATE_PRICE:
 			PyCallClassMemberFunc(m_apoPhaseWnd[PHASE_WINDOW_GAME], "SetShopSellingPrice", Py_BuildValue("(i)", *(int *)&vecBuffer[0]));
 			break;
@@ -2168,7 +2125,46 @@ bool CPythonNetworkStream::RecvDamageInfoPacket()
 		Tracen("Recv Target Packet Error");
 		return false;
 	}
-	
+
+	__ApplyDamageInfo(DamageInfoPacket);
+	return true;
+}
+
+bool CPythonNetworkStream::RecvDamageInfoBulkPacket()
+{
+	TPacketGCDamageInfoBulk kPacketBulk;
+
+	if (!Recv(sizeof(kPacketBulk), &kPacketBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvDamageInfoBulkPacket - PACKET READ ERROR");
+		return false;
+	}
+
+	TPacketGCDamageInfoBulkElement kElement;
+	UINT uCount=(kPacketBulk.wSize-sizeof(kPacketBulk))/sizeof(kElement);
+
+	for (UINT i=0; i<uCount; ++i)
+	{
+		if (!Recv(sizeof(kElement), &kElement))
+		{
+			Tracen("CPythonNetworkStream::RecvDamageInfoBulkPacket - ELEMENT READ ERROR");
+			return false;
+		}
+
+		TPacketGCDamageInfo DamageInfoPacket;
+		DamageInfoPacket.header = HEADER_GC_DAMAGE_INFO;
+		DamageInfoPacket.dwVID = kElement.dwVID;
+		DamageInfoPacket.flag = kElement.flag;
+		DamageInfoPacket.damage = kElement.damage;
+
+		__ApplyDamageInfo(DamageInfoPacket);
+	}
+
+	return true;
+}
+
+void CPythonNetworkStream::__ApplyDamageInfo(const TPacketGCDamageInfo& DamageInfoPacket)
+{
 	CInstanceBase * pInstTarget = CPythonCharacterManager::Instance().GetInstancePtr(DamageInfoPacket.dwVID);
 	bool bSelf = (pInstTarget == CPythonCharacterManager::Instance().GetMainInstancePtr());
 	bool bTarget = (pInstTarget==m_pInstTarget);
@@ -2179,8 +2175,6 @@ bool CPythonNetworkStream::RecvDamageInfoPacket()
 		else
 			TraceError("Damage is equal or below 0.");
 	}
-
-	return true;
 }
 bool CPythonNetworkStream::RecvTargetPacket()
 {
@@ -2491,7 +2485,10 @@ bool CPythonNetworkStream::RecvMessenger()
 				char_name[on.length] = 0;
 
 				if (on.connected & MESSENGER_CONNECTED_STATE_ONLINE)
+				{
 					CPythonMessenger::Instance().OnFriendLogin(char_name);
+					__RefreshTargetBoardByName(char_name);
+				}
 				else
 					CPythonMessenger::Instance().OnFriendLogout(char_name);
 
@@ -2670,9 +2667,48 @@ bool CPythonNetworkStream::RecvPartyUpdate()
 	if (!Recv(sizeof(kPartyUpdatePacket), &kPartyUpdatePacket))
 		return false;
 
+	__ApplyPartyUpdate(kPartyUpdatePacket);
+	return true;
+}
+
+bool CPythonNetworkStream::RecvPartyUpdateBulk()
+{
+	TPacketGCPartyUpdateBulk kPacketBulk;
+	if (!Recv(sizeof(kPacketBulk), &kPacketBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvPartyUpdateBulk - PACKET READ ERROR");
+		return false;
+	}
+
+	TPacketGCPartyUpdateBulkElement kElement;
+	UINT uCount=(kPacketBulk.wSize-sizeof(kPacketBulk))/sizeof(kElement);
+
+	for (UINT i=0; i<uCount; ++i)
+	{
+		if (!Recv(sizeof(kElement), &kElement))
+		{
+			Tracen("CPythonNetworkStream::RecvPartyUpdateBulk - ELEMENT READ ERROR");
+			return false;
+		}
+
+		TPacketGCPartyUpdate kPartyUpdatePacket;
+		kPartyUpdatePacket.header = HEADER_GC_PARTY_UPDATE;
+		kPartyUpdatePacket.pid = kElement.pid;
+		kPartyUpdatePacket.role = kElement.role;
+		kPartyUpdatePacket.percent_hp = kElement.percent_hp;
+		memcpy(kPartyUpdatePacket.affects, kElement.affects, sizeof(kPartyUpdatePacket.affects));
+
+		__ApplyPartyUpdate(kPartyUpdatePacket);
+	}
+
+	return true;
+}
+
+void CPythonNetworkStream::__ApplyPartyUpdate(const TPacketGCPartyUpdate& kPartyUpdatePacket)
+{
 	CPythonPlayer::TPartyMemberInfo * pPartyMemberInfo;
 	if (!CPythonPlayer::Instance().GetPartyMemberPtr(kPartyUpdatePacket.pid, &pPartyMemberInfo))
-		return true;
+		return;
 
 	BYTE byOldState = pPartyMemberInfo->byState;
 
@@ -2693,8 +2729,6 @@ bool CPythonNetworkStream::RecvPartyUpdate()
 	}
 
 // 	Tracef(" >> RecvPartyUpdate : %d, %d, %d\n", kPartyUpdatePacket.pid, kPartyUpdatePacket.state, kPartyUpdatePacket.percent_hp);
-
-	return true;
 }
 
 bool CPythonNetworkStream::RecvPartyRemove()
@@ -3014,17 +3048,23 @@ bool CPythonNetworkStream::RecvGuild()
 	{
 		case GUILD_SUBHEADER_GC_LOGIN:
 		{
-			DWORD dwPID;
-			if (!Recv(sizeof(DWORD), &dwPID))
-				return false;
+			//  â      pid   Ŷ  پ ´
+			UINT uCount = (GuildPacket.size - sizeof(GuildPacket)) / sizeof(DWORD);
 
-			// Messenger
-			CPythonGuild::TGuildMemberData * pGuildMemberData;
-			if (CPythonGuild::Instance().GetMemberDataPtrByPID(dwPID, &pGuildMemberData))
-				if (0 != pGuildMemberData->strName.compare(CPythonPlayer::Instance().GetName()))
-					CPythonMessenger::Instance().LoginGuildMember(pGuildMemberData->strName.c_str());
+			for (UINT i = 0; i < uCount; ++i)
+			{
+				DWORD dwPID;
+				if (!Recv(sizeof(DWORD), &dwPID))
+					return false;
+
+				// Messenger
+				CPythonGuild::TGuildMemberData * pGuildMemberData;
+				if (CPythonGuild::Instance().GetMemberDataPtrByPID(dwPID, &pGuildMemberData))
+					if (0 != pGuildMemberData->strName.compare(CPythonPlayer::Instance().GetName()))
+						CPythonMessenger::Instance().LoginGuildMember(pGuildMemberData->strName.c_str());
 
-			//Tracef(" <Login> %d\n", dwPID);
+				//Tracef(" <Login> %d\n", dwPID);
+			}
 			break;
 		}
 		case GUILD_SUBHEADER_GC_LOGOUT:
@@ -6,6 +6,7 @@
 #include "PythonApplication.h"
 #include "AbstractPlayer.h"
 #include "../gamelib/ActorInstance.h"
+#include "../../Lead-Shared-Source/common/varint.h"
 
 
 
@@ -86,6 +87,53 @@ bool CPythonNetworkStream::RecvCharacterAppendPacket()
 	if (!Recv(sizeof(chrAddPacket), &chrAddPacket))
 		return false;
 
+	__ApplyCharacterAdd(chrAddPacket);
+	return true;
+}
+
+bool CPythonNetworkStream::RecvCharacterAppendBulkPacket()
+{
+	TPacketGCCharacterAddBulk kPacketBulk;
+	if (!Recv(sizeof(kPacketBulk), &kPacketBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvCharacterAppendBulkPacket - PACKET READ ERROR");
+		return false;
+	}
+
+	TPacketGCCharacterAddBulkElement kElement;
+	UINT uCount=(kPacketBulk.wSize-sizeof(kPacketBulk))/sizeof(kElement);
+
+	for (UINT i=0; i<uCount; ++i)
+	{
+		if (!Recv(sizeof(kElement), &kElement))
+		{
+			Tracen("CPythonNetworkStream::RecvCharacterAppendBulkPacket - ELEMENT READ ERROR");
+			return false;
+		}
+
+		TPacketGCCharacterAdd chrAddPacket;
+		chrAddPacket.header=HEADER_GC_CHARACTER_ADD;
+		chrAddPacket.dwVID=kElement.dwVID;
+		chrAddPacket.angle=kElement.angle;
+		chrAddPacket.x=kElement.x;
+		chrAddPacket.y=kElement.y;
+		chrAddPacket.z=kElement.z;
+		chrAddPacket.bType=kElement.bType;
+		chrAddPacket.wRaceNum=kElement.wRaceNum;
+		chrAddPacket.bMovingSpeed=kElement.bMovingSpeed;
+		chrAddPacket.bAttackSpeed=kElement.bAttackSpeed;
+		chrAddPacket.bStateFlag=kElement.bStateFlag;
+		chrAddPacket.dwAffectFlag[0]=kElement.dwAffectFlag[0];
+		chrAddPacket.dwAffectFlag[1]=kElement.dwAffectFlag[1];
+
+		__ApplyCharacterAdd(chrAddPacket);
+	}
+
+	return true;
+}
+
+void CPythonNetworkStream::__ApplyCharacterAdd(TPacketGCCharacterAdd& chrAddPacket)
+{
 	__GlobalPositionToLocalPosition(chrAddPacket.x, chrAddPacket.y);
 
 	SNetworkActorData kNetActorData;
@@ -133,8 +181,6 @@ bool CPythonNetworkStream::RecvCharacterAppendPacket()
 	{
 		s_kNetActorData = kNetActorData;
 	}
-
-	return true;
 }
 
 bool CPythonNetworkStream::RecvCharacterAdditionalInfo()
@@ -310,6 +356,127 @@ bool CPythonNetworkStream::RecvCharacterMovePacket()
 	return true;
 }
 
+bool CPythonNetworkStream::RecvCharacterMoveBulkPacket()
+{
+	TPacketGCMoveBulk kPacketMoveBulk;
+	if (!Recv(sizeof(kPacketMoveBulk), &kPacketMoveBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvCharacterMoveBulkPacket - PACKET READ ERROR");
+		return false;
+	}
+
+	TPacketGCMoveBulkElement kMove;
+
+	UINT uMoveCount=(kPacketMoveBulk.wSize-sizeof(kPacketMoveBulk))/sizeof(kMove);
+	for (UINT iMove=0; iMove<uMoveCount; ++iMove)
+	{
+		if (!Recv(sizeof(TPacketGCMoveBulkElement), &kMove))
+		{
+			Tracen("CPythonNetworkStream::RecvCharacterMoveBulkPacket - ELEMENT READ ERROR");
+			return false;
+		}
+
+		// ǥ ð  ذ ̷ ´.
+		LONG lPosX=kPacketMoveBulk.lBaseX+kMove.sDeltaX;
+		LONG lPosY=kPacketMoveBulk.lBaseY+kMove.sDeltaY;
+
+		__GlobalPositionToLocalPosition(lPosX, lPosY);
+
+		SNetworkMoveActorData kNetMoveActorData;
+		kNetMoveActorData.m_dwArg=kMove.bArg;
+		kNetMoveActorData.m_dwFunc=kMove.bFunc;
+		kNetMoveActorData.m_dwTime=kPacketMoveBulk.dwBaseTime+kMove.sDeltaTime;
+		kNetMoveActorData.m_dwVID=kMove.dwVID;
+		kNetMoveActorData.m_fRot=kMove.bRot*5.0f;
+		kNetMoveActorData.m_lPosX=lPosX;
+		kNetMoveActorData.m_lPosY=lPosY;
+		kNetMoveActorData.m_dwDuration=kMove.wDuration;
+
+		m_rokNetActorMgr->MoveActor(kNetMoveActorData);
+	}
+
+	return true;
+}
+
+bool CPythonNetworkStream::RecvCharacterMoveBulkPackedPacket()
+{
+	TPacketGCMoveBulkPacked kPacketMoveBulk;
+	if (!Recv(sizeof(kPacketMoveBulk), &kPacketMoveBulk))
+	{
+		Tracen("CPythonNetworkStream::RecvCharacterMoveBulkPackedPacket - PACKET READ ERROR");
+		return false;
+	}
+
+	static std::vector<BYTE> s_kVec_bBody;
+	int iBodySize=kPacketMoveBulk.wSize-sizeof(kPacketMoveBulk);
+	s_kVec_bBody.resize(iBodySize+1);
+
+	if (iBodySize>0 && !Recv(iBodySize, &s_kVec_bBody[0]))
+	{
+		Tracen("CPythonNetworkStream::RecvCharacterMoveBulkPackedPacket - BODY READ ERROR");
+		return false;
+	}
+
+	const BYTE* pbCur=&s_kVec_bBody[0];
+	const BYTE* pbEnd=pbCur+iBodySize;
+
+	while (pbCur<pbEnd)
+	{
+		DWORD dwVID, dwDeltaX, dwDeltaY, dwDeltaTime, dwDuration;
+		int iLen;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwVID)))
+			break;
+		pbCur+=iLen;
+
+		if (pbEnd-pbCur<3)
+			break;
+		BYTE bFunc=pbCur[0];
+		BYTE bArg=pbCur[1];
+		BYTE bRot=pbCur[2];
+		pbCur+=3;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwDeltaX)))
+			break;
+		pbCur+=iLen;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwDeltaY)))
+			break;
+		pbCur+=iLen;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwDeltaTime)))
+			break;
+		pbCur+=iLen;
+
+		if (!(iLen=varint_decode(pbCur, pbEnd-pbCur, &dwDuration)))
+			break;
+		pbCur+=iLen;
+
+		// ǥ ð  ذ ̸ zigzag  ٲ㼭 ´.
+		LONG lPosX=kPacketMoveBulk.lBaseX+varint_unzigzag(dwDeltaX);
+		LONG lPosY=kPacketMoveBulk.lBaseY+varint_unzigzag(dwDeltaY);
+
+		__GlobalPositionToLocalPosition(lPosX, lPosY);
+
+		SNetworkMoveActorData kNetMoveActorData;
+		kNetMoveActorData.m_dwArg=bArg;
+		kNetMoveActorData.m_dwFunc=bFunc;
+		kNetMoveActorData.m_dwTime=kPacketMoveBulk.dwBaseTime+varint_unzigzag(dwDeltaTime);
+		kNetMoveActorData.m_dwVID=dwVID;
+		kNetMoveActorData.m_fRot=bRot*5.0f;
+		kNetMoveActorData.m_lPosX=lPosX;
+		kNetMoveActorData.m_lPosY=lPosY;
+		kNetMoveActorData.m_dwDuration=dwDuration;
+
+		m_rokNetActorMgr->MoveActor(kNetMoveActorData);
+	}
+
+	if (pbCur!=pbEnd)
+		Tracen("CPythonNetworkStream::RecvCharacterMoveBulkPackedPacket - ELEMENT DECODE ERROR");
+
+	return true;
+}
+
 bool CPythonNetworkStream::RecvOwnerShipPacket()
 {
 	TPacketGCOwnership kPacketOwnership;
@@ -435,6 +435,32 @@ bool CPythonNetworkStream::SendShopSellPacket(BYTE bySlot, BYTE byCount)
 	return SendSequence();
 }
 
+bool CPythonNetworkStream::SendShopSearchPacket(DWORD dwVnum, DWORD dwMaxPrice, WORD wPage)
+{
+	TPacketCGShop PacketShop;
+	PacketShop.header = HEADER_CG_SHOP;
+	PacketShop.subheader = SHOP_SUBHEADER_CG_SEARCH;
+
+	TPacketCGShopSearch PacketSearch;
+	PacketSearch.vnum = dwVnum;
+	PacketSearch.max_price = dwMaxPrice;
+	PacketSearch.page = wPage;
+
+	if (!Send(sizeof(TPacketCGShop), &PacketShop))
+	{
+		Tracef("SendShopSearchPacket Error\n");
+		return false;
+	}
+
+	if (!Send(sizeof(TPacketCGShopSearch), &PacketSearch))
+	{
+		Tracef("SendShopSearchPacket Error\n");
+		return false;
+	}
+
+	return SendSequence();
+}
+
 // Send
 bool CPythonNetworkStream::SendItemUsePacket(TItemPos pos)
 {
@@ -214,6 +214,28 @@ bool CPythonNetworkStream::SendLoginPacketNew(const char * c_szName, const char
 	for (DWORD i = 0; i < 4; ++i)
 		LoginPacket.adwClientKey[i] = g_adwEncryptKey[i];
 
+	// 큰 패킷은 압축해서 받는다.
+	TPacketCGPacketCompression CompressionPacket;
+	CompressionPacket.header = HEADER_CG_PACKET_COMPRESSION;
+	CompressionPacket.bEnable = 1;
+
+	if (!Send(sizeof(CompressionPacket), &CompressionPacket) || !SendSequence())
+	{
+		Tracen("SendPacketCompression Error");
+		return false;
+	}
+
+	// 이 클라이언트가 읽을 수 있는 패킷 형식을 알린다. 서버는 둘 중 낮은 버전으로 보낸다.
+	TPacketCGProtocolVersion VersionPacket;
+	VersionPacket.header = HEADER_CG_PROTOCOL_VERSION;
+	VersionPacket.wVersion = PROTOCOL_VERSION_CURRENT;
+
+	if (!Send(sizeof(VersionPacket), &VersionPacket) || !SendSequence())
+	{
+		Tracen("SendProtocolVersion Error");
+		return false;
+	}
+
 	if (!Send(sizeof(LoginPacket), &LoginPacket))
 	{
 		Tracen("SendLogin Error");
@@ -1,5 +1,6 @@
 #include "StdAfx.h"
 #include "../eterLib/Profiler.h"
+#include "../eterLib/FrameProfiler.h"
 
 PyObject * profilerPush(PyObject * poSelf, PyObject * poArgs)
 {
@@ -7,6 +8,7 @@ PyObject * profilerPush(PyObject * poSelf, PyObject * poArgs)
 	if (!PyTuple_GetString(poArgs, 0, &szName))
 		return Py_BuildException();
 
+	CPythonProfiler::Instance().PushScope(szName);
 	return Py_BuildNone();
 }
 
@@ -16,6 +18,71 @@ PyObject * profilerPop(PyObject * poSelf, PyObject * poArgs)
 	if (!PyTuple_GetString(poArgs, 0, &szName))
 		return Py_BuildException();
 
+	CPythonProfiler::Instance().PopScope(szName);
+	return Py_BuildNone();
+}
+
+PyObject * profilerStart(PyObject * poSelf, PyObject * poArgs)
+{
+	CPythonProfiler::Instance().Start();
+	return Py_BuildNone();
+}
+
+PyObject * profilerStop(PyObject * poSelf, PyObject * poArgs)
+{
+	CPythonProfiler::Instance().Stop();
+	return Py_BuildNone();
+}
+
+PyObject * profilerReset(PyObject * poSelf, PyObject * poArgs)
+{
+	CPythonProfiler::Instance().Reset();
+	return Py_BuildNone();
+}
+
+PyObject * profilerIsRunning(PyObject * poSelf, PyObject * poArgs)
+{
+	return Py_BuildValue("i", CPythonProfiler::Instance().IsRunning());
+}
+
+PyObject * profilerDump(PyObject * poSelf, PyObject * poArgs)
+{
+	char * szFileName;
+	if (!PyTuple_GetString(poArgs, 0, &szFileName))
+		return Py_BuildException();
+
+	return Py_BuildValue("i", CPythonProfiler::Instance().Dump(szFileName));
+}
+
+PyObject * profilerStartFrame(PyObject * poSelf, PyObject * poArgs)
+{
+	CFrameProfiler::Instance().Start();
+	return Py_BuildNone();
+}
+
+PyObject * profilerStopFrame(PyObject * poSelf, PyObject * poArgs)
+{
+	CFrameProfiler::Instance().Stop();
+	return Py_BuildNone();
+}
+
+PyObject * profilerIsFrameRunning(PyObject * poSelf, PyObject * poArgs)
+{
+	return Py_BuildValue("i", CFrameProfiler::Instance().IsRunning());
+}
+
+PyObject * profilerStartFrameCapture(PyObject * poSelf, PyObject * poArgs)
+{
+	char * szFileName;
+	if (!PyTuple_GetString(poArgs, 0, &szFileName))
+		return Py_BuildException();
+
+	return Py_BuildValue("i", CFrameProfiler::Instance().StartCapture(szFileName));
+}
+
+PyObject * profilerStopFrameCapture(PyObject * poSelf, PyObject * poArgs)
+{
+	CFrameProfiler::Instance().StopCapture();
 	return Py_BuildNone();
 }
 
@@ -25,6 +92,17 @@ void initProfiler()
 	{
 		{ "Push",				profilerPush,				METH_VARARGS },
 		{ "Pop",				profilerPop,				METH_VARARGS },
+		{ "Start",				profilerStart,				METH_VARARGS },
+		{ "Stop",				profilerStop,				METH_VARARGS },
+		{ "Reset",				profilerReset,				METH_VARARGS },
+		{ "IsRunning",			profilerIsRunning,			METH_VARARGS },
+		{ "Dump",				profilerDump,				METH_VARARGS },
+
+		{ "StartFrame",			profilerStartFrame,			METH_VARARGS },
+		{ "StopFrame",			profilerStopFrame,			METH_VARARGS },
+		{ "IsFrameRunning",		profilerIsFrameRunning,		METH_VARARGS },
+		{ "StartFrameCapture",	profilerStartFrameCapture,	METH_VARARGS },
+		{ "StopFrameCapture",	profilerStopFrameCapture,	METH_VARARGS },
 
 		{ NULL,					NULL,						NULL		 },
 	};
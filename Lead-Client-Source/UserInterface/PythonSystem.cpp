@@ -307,6 +307,13 @@ void CPythonSystem::SetDefaultConfig()
 	m_Config.bAlwaysShowName	= DEFAULT_VALUE_ALWAYS_SHOW_NAME;
 	m_Config.bShowDamage		= true;
 	m_Config.bShowSalesText		= true;
+
+	m_Config.iAniLODHalfDistance	= 3000;
+	m_Config.iAniLODQuarterDistance	= 5000;
+	m_Config.iAniLODFreezeDistance	= 10000;
+	m_Config.iTextureStreamBudget	= 0;
+	m_Config.iEffectCullDistance	= 5000;
+	m_Config.iEffectRenderBudget	= 256;
 }
 
 bool CPythonSystem::IsWindowed()
@@ -456,6 +463,18 @@ bool CPythonSystem::LoadConfig()
 			m_Config.bShowDamage = atoi(value) == 1 ? true : false;
 		else if (!_stricmp(command, "SHOW_SALESTEXT"))
 			m_Config.bShowSalesText = atoi(value) == 1 ? true : false;
+		else if (!_stricmp(command, "ANI_LOD_HALF_DISTANCE"))
+			m_Config.iAniLODHalfDistance = atoi(value);
+		else if (!_stricmp(command, "ANI_LOD_QUARTER_DISTANCE"))
+			m_Config.iAniLODQuarterDistance = atoi(value);
+		else if (!_stricmp(command, "ANI_LOD_FREEZE_DISTANCE"))
+			m_Config.iAniLODFreezeDistance = atoi(value);
+		else if (!_stricmp(command, "TEXTURE_STREAM_BUDGET"))
+			m_Config.iTextureStreamBudget = atoi(value);
+		else if (!_stricmp(command, "EFFECT_CULL_DISTANCE"))
+			m_Config.iEffectCullDistance = atoi(value);
+		else if (!_stricmp(command, "EFFECT_RENDER_BUDGET"))
+			m_Config.iEffectRenderBudget = atoi(value);
 	}
 
 	if (m_Config.bWindowed)
@@ -529,6 +548,12 @@ bool CPythonSystem::SaveConfig()
 	fprintf(fp, "USE_DEFAULT_IME		%d\n", m_Config.bUseDefaultIME);
 	fprintf(fp, "SOFTWARE_TILING		%d\n", m_Config.bSoftwareTiling);
 	fprintf(fp, "SHADOW_LEVEL			%d\n", m_Config.iShadowLevel);
+	fprintf(fp, "ANI_LOD_HALF_DISTANCE		%d\n", m_Config.iAniLODHalfDistance);
+	fprintf(fp, "ANI_LOD_QUARTER_DISTANCE	%d\n", m_Config.iAniLODQuarterDistance);
+	fprintf(fp, "ANI_LOD_FREEZE_DISTANCE	%d\n", m_Config.iAniLODFreezeDistance);
+	fprintf(fp, "TEXTURE_STREAM_BUDGET		%d\n", m_Config.iTextureStreamBudget);
+	fprintf(fp, "EFFECT_CULL_DISTANCE		%d\n", m_Config.iEffectCullDistance);
+	fprintf(fp, "EFFECT_RENDER_BUDGET		%d\n", m_Config.iEffectRenderBudget);
 	fprintf(fp, "\n");
 
 	fclose(fp);
@@ -637,6 +662,17 @@ void CPythonSystem::ChangeSystem()
 		fVoiceVolume = (float)pow(10.0f, (-1.0f + (float)m_Config.voice_volume / 5.0f));
 	*/
 	rkSndMgr.SetSoundVolumeGrade(m_Config.voice_volume);	
+
+	CGraphicThingInstance::SetAnimationLODDistance(
+		float(m_Config.iAniLODHalfDistance),
+		float(m_Config.iAniLODQuarterDistance),
+		float(m_Config.iAniLODFreezeDistance));
+
+	// MB , 0 ̸  ޸ 
+	CGraphicTextureStreamer::SetBudget(DWORD(max(0, m_Config.iTextureStreamBudget)) * 1024 * 1024);
+
+	// 0 ̸ Ÿ Ÿ ʰų    ʴ´
+	CEffectManager::SetCulling(float(max(0, m_Config.iEffectCullDistance)), UINT(max(0, m_Config.iEffectRenderBudget)));
 }
 
 void CPythonSystem::Clear()
@@ -75,6 +75,14 @@ class CPythonSystem : public CSingleton<CPythonSystem>
 			bool			bAlwaysShowName;
 			bool			bShowDamage;
 			bool			bShowSalesText;
+
+			// ִϸ̼ LOD (ī޶κ Ÿ, 0 ̸ )
+			int				iAniLODHalfDistance;
+			int				iAniLODQuarterDistance;
+			int				iAniLODFreezeDistance;
+			int				iTextureStreamBudget;
+			int				iEffectCullDistance;
+			int				iEffectRenderBudget;
 		} TConfig;
 
 	public:
@@ -9,6 +9,7 @@
 #include "PythonGuild.h"
 #include "Locale.h"
 #include "MarkManager.h"
+#include "../eterLib/FrameProfiler.h"
 
 const D3DXCOLOR c_TextTail_Player_Color = D3DXCOLOR(1.0f, 1.0f, 1.0f, 1.0f);
 const D3DXCOLOR c_TextTail_Monster_Color = D3DXCOLOR(1.0f, 0.0f, 0.0f, 1.0f);
@@ -85,10 +86,32 @@ void CPythonTextTail::UpdateAllTextTail()
 	}
 }
 
+// ī޶ ٲ   ٽ ϵ ȣ ø.
+void CPythonTextTail::__UpdateProjectRevision()
+{
+	const D3DXMATRIX & c_rmatView = CGraphicBase::GetViewMatrix();
+	const D3DXMATRIX & c_rmatProj = CGraphicBase::GetProjectionMatrix();
+	const D3DVIEWPORT9 & c_rkViewport = CGraphicBase::GetViewport();
+
+	if (0 == memcmp(&m_matProjectView, &c_rmatView, sizeof(D3DXMATRIX)) &&
+		0 == memcmp(&m_matProjectProj, &c_rmatProj, sizeof(D3DXMATRIX)) &&
+		0 == memcmp(&m_kProjectViewport, &c_rkViewport, sizeof(D3DVIEWPORT9)))
+		return;
+
+	m_matProjectView = c_rmatView;
+	m_matProjectProj = c_rmatProj;
+	m_kProjectViewport = c_rkViewport;
+
+	if (!++m_dwProjectRevision)
+		m_dwProjectRevision = 1;
+}
+
 void CPythonTextTail::UpdateShowingTextTail()
 {
 	TTextTailList::iterator itor;
 
+	__UpdateProjectRevision();
+
 	for (itor = m_ItemTextTailList.begin(); itor != m_ItemTextTailList.end(); ++itor)
 	{
 		UpdateTextTail(*itor);
@@ -124,19 +147,31 @@ void CPythonTextTail::UpdateTextTail(TTextTail * pTextTail)
 
 	/////
 
-	CPythonGraphic & rpyGraphic = CPythonGraphic::Instance();
-	rpyGraphic.Identity();
-
 	const D3DXVECTOR3 & c_rv3Position = pTextTail->pOwner->GetPosition();
-	rpyGraphic.ProjectPosition(c_rv3Position.x,
-							   c_rv3Position.y,
-							   c_rv3Position.z + pTextTail->fHeight,
-							   &pTextTail->x,
-							   &pTextTail->y,
-							   &pTextTail->z);
 
-	pTextTail->x = floorf(pTextTail->x);
-	pTextTail->y = floorf(pTextTail->y);
+	if (pTextTail->dwProjectRevision != m_dwProjectRevision || pTextTail->v3ProjectPosition != c_rv3Position)
+	{
+		CPythonGraphic & rpyGraphic = CPythonGraphic::Instance();
+		rpyGraphic.Identity();
+
+		rpyGraphic.ProjectPosition(c_rv3Position.x,
+								   c_rv3Position.y,
+								   c_rv3Position.z + pTextTail->fHeight,
+								   &pTextTail->xProject,
+								   &pTextTail->yProject,
+								   &pTextTail->zProject);
+
+		pTextTail->xProject = floorf(pTextTail->xProject);
+		pTextTail->yProject = floorf(pTextTail->yProject);
+
+		pTextTail->v3ProjectPosition = c_rv3Position;
+		pTextTail->dwProjectRevision = m_dwProjectRevision;
+	}
+
+	// Ŀ ű     ǥ ٽ Ѵ.
+	pTextTail->x = pTextTail->xProject;
+	pTextTail->y = pTextTail->yProject;
+	pTextTail->z = pTextTail->zProject;
 
 	// NOTE : 13m ۿ  ̸ ֽϴ - [levites]
 	if (pTextTail->fDistanceFromPlayer < 1300.0f)
@@ -341,8 +376,13 @@ void CPythonTextTail::ArrangeTextTail()
 
 void CPythonTextTail::Render()
 {
+	CFrameProfilerScope kScope(CFrameProfiler::PHASE_TEXTTAIL);
+
 	TTextTailList::iterator itor;
 
+	// ĳ ̸ Ƽ ѹ ׸.  ̸ ؿ 򸮴 ڽ  Ѿ ϹǷ .
+	CGraphicTextInstance::BeginBatch();
+
 	for (itor = m_CharacterTextTailList.begin(); itor != m_CharacterTextTailList.end(); ++itor)
 	{
 		TTextTail * pTextTail = *itor;
@@ -362,6 +402,8 @@ void CPythonTextTail::Render()
 		}
 	}
 
+	CGraphicTextInstance::EndBatch();
+
 	for (itor = m_ItemTextTailList.begin(); itor != m_ItemTextTailList.end(); ++itor)
 	{
 		TTextTail * pTextTail = *itor;
@@ -372,12 +414,16 @@ void CPythonTextTail::Render()
 			pTextTail->pOwnerTextInstance->Render();
 	}
 
+	CGraphicTextInstance::BeginBatch();
+
 	for (TChatTailMap::iterator itorChat = m_ChatTailMap.begin(); itorChat!=m_ChatTailMap.end(); ++itorChat)
 	{
 		TTextTail * pTextTail = itorChat->second;
 		if (pTextTail->pOwner->isShow())
 			RenderTextTailName(pTextTail);
 	}
+
+	CGraphicTextInstance::EndBatch();
 }
 
 void CPythonTextTail::RenderTextTailBox(TTextTail * pTextTail)
@@ -408,6 +454,14 @@ void CPythonTextTail::HideAllTextTail()
 {
 	// NOTE : Show All ص Hide All    ߻ ɼ 
 	//         ü ׷ ϰ  ʾ - [levites]
+	TTextTailList::iterator itor;
+
+	for (itor = m_CharacterTextTailList.begin(); itor != m_CharacterTextTailList.end(); ++itor)
+		(*itor)->isShowing = false;
+
+	for (itor = m_ItemTextTailList.begin(); itor != m_ItemTextTailList.end(); ++itor)
+		(*itor)->isShowing = false;
+
 	m_CharacterTextTailList.clear();
 	m_ItemTextTailList.clear();
 }
@@ -445,7 +499,7 @@ void CPythonTextTail::ShowCharacterTextTail(DWORD VirtualID)
 
 	TTextTail * pTextTail = itor->second;
 
-	if (m_CharacterTextTailList.end() != std::find(m_CharacterTextTailList.begin(), m_CharacterTextTailList.end(), pTextTail))
+	if (pTextTail->isShowing)
 	{
 		//Tracef("̹ Ʈ  : %d\n", VirtualID);
 		return;
@@ -464,7 +518,10 @@ void CPythonTextTail::ShowCharacterTextTail(DWORD VirtualID)
 		return;
 
 	if (pInstance->CanPickInstance())
-		m_CharacterTextTailList.push_back(pTextTail);		
+	{
+		pTextTail->isShowing = true;
+		m_CharacterTextTailList.push_back(pTextTail);
+	}
 }
 
 void CPythonTextTail::ShowItemTextTail(DWORD VirtualID)
@@ -476,12 +533,13 @@ void CPythonTextTail::ShowItemTextTail(DWORD VirtualID)
 
 	TTextTail * pTextTail = itor->second;
 
-	if (m_ItemTextTailList.end() != std::find(m_ItemTextTailList.begin(), m_ItemTextTailList.end(), pTextTail))
+	if (pTextTail->isShowing)
 	{
 		//Tracef("̹ Ʈ  : %d\n", VirtualID);
 		return;
 	}
 
+	pTextTail->isShowing = true;
 	m_ItemTextTailList.push_back(pTextTail);
 }
 
@@ -819,11 +877,25 @@ CPythonTextTail::TTextTail * CPythonTextTail::RegisterTextTail(DWORD dwVirtualID
 	pTextTail->pGuildNameTextInstance = NULL;
 	pTextTail->pTitleTextInstance = NULL;
 	pTextTail->pLevelTextInstance = NULL;
+	pTextTail->xProject = pTextTail->x;
+	pTextTail->yProject = pTextTail->y;
+	pTextTail->zProject = pTextTail->z;
+	pTextTail->v3ProjectPosition = D3DXVECTOR3(0.0f, 0.0f, 0.0f);
+	pTextTail->dwProjectRevision = 0;
+	pTextTail->isShowing = false;
 	return pTextTail;
 }
 
 void CPythonTextTail::DeleteTextTail(TTextTail * pTextTail)
 {
+	// Ǯ ư  Ʈ  ٽ  ʵ .
+	if (pTextTail->isShowing)
+	{
+		m_CharacterTextTailList.remove(pTextTail);
+		m_ItemTextTailList.remove(pTextTail);
+		pTextTail->isShowing = false;
+	}
+
 	if (pTextTail->pTextInstance)
 	{
 		CGraphicTextInstance::Delete(pTextTail->pTextInstance);
@@ -1019,6 +1091,11 @@ void CPythonTextTail::Clear()
 
 CPythonTextTail::CPythonTextTail()
 {
+	memset(&m_matProjectView, 0, sizeof(m_matProjectView));
+	memset(&m_matProjectProj, 0, sizeof(m_matProjectProj));
+	memset(&m_kProjectViewport, 0, sizeof(m_kProjectViewport));
+	m_dwProjectRevision = 1;
+
 	Clear();
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <boost/unordered_map.hpp>
+
 #include "../eterBase/Singleton.h"
 
 /*
@@ -38,11 +40,18 @@ class CPythonTextTail : public CSingleton<CPythonTextTail>
 
 			float							fHeight;
 
+			// ķ ű   ǥ. ΰ ī޶ ״θ ٽ  ʴ´.
+			float							xProject, yProject, zProject;
+			D3DXVECTOR3						v3ProjectPosition;
+			DWORD							dwProjectRevision;
+
+			bool							isShowing;		//  Ʈ  ִ
+
 			STextTail() {}
 			virtual ~STextTail() {}
 		} TTextTail;
 
-		typedef std::map<DWORD, TTextTail*>		TTextTailMap;
+		typedef boost::unordered_map<DWORD, TTextTail*>	TTextTailMap;
 		typedef std::list<TTextTail*>			TTextTailList;
 		typedef TTextTailMap					TChatTailMap;
 
@@ -100,6 +109,8 @@ class CPythonTextTail : public CSingleton<CPythonTextTail>
 
 		bool isIn(TTextTail * pSource, TTextTail * pTarget);
 
+		void __UpdateProjectRevision();
+
 	protected:
 		TTextTailMap				m_CharacterTextTailMap;
 		TTextTailMap				m_ItemTextTailMap;
@@ -108,6 +119,12 @@ class CPythonTextTail : public CSingleton<CPythonTextTail>
 		TTextTailList				m_CharacterTextTailList;
 		TTextTailList				m_ItemTextTailList;
 
+		//    ī޶
+		D3DXMATRIX					m_matProjectView;
+		D3DXMATRIX					m_matProjectProj;
+		D3DVIEWPORT9				m_kProjectViewport;
+		DWORD						m_dwProjectRevision;
+
 	private:
 		CDynamicPool<STextTail>		m_TextTailPool;
 };
@@ -4,6 +4,7 @@
 #include "PythonExceptionSender.h"
 #include "resource.h"
 #include "Version.h"
+#include "ProcessCRC.h"
 
 #ifdef _DEBUG
 #include <crtdbg.h>
@@ -209,19 +210,23 @@ bool PackInitialize(const char * c_pszFolder)
 
 	CSoundData::SetPackMode(); // Miles 파일 콜백을 셋팅
 
-	std::string strPackName, strTexCachePackName;
+	CEterPackManager::TPackNameVector kVct_kPackName;
+	CEterPackManager::SPackName kPackName;
 	for (DWORD i = 1; i < TextLoader.GetLineCount() - 1; i += 2)
 	{
 		const std::string & c_rstFolder = TextLoader.GetLineString(i);
 		const std::string & c_rstName = TextLoader.GetLineString(i + 1);
 
-		strPackName = stFolder + c_rstName;
-		strTexCachePackName = strPackName + "_texcache";
+		kPackName.stName = stFolder + c_rstName;
+		kPackName.stDirectory = c_rstFolder;
+		kVct_kPackName.push_back(kPackName);
 
-		CEterPackManager::Instance().RegisterPack(strPackName.c_str(), c_rstFolder.c_str());
-		CEterPackManager::Instance().RegisterPack(strTexCachePackName.c_str(), c_rstFolder.c_str());
+		kPackName.stName += "_texcache";
+		kVct_kPackName.push_back(kPackName);
 	}
 
+	CEterPackManager::Instance().RegisterPacks(kVct_kPackName);
+
 	CEterPackManager::Instance().RegisterRootPack((stFolder + std::string("root")).c_str());
 	NANOEND
 	return true;
@@ -365,6 +370,9 @@ bool Main(HINSTANCE hInstance, LPSTR lpCmdLine)
 	OpenLogFile(false); // false == uses syserr.txt only
 #endif
 
+	// 캐릭터 선택 화면에 들어갈 때 쓰는 CRC 를 팩을 읽는 동안 미리 계산한다.
+	StartProcessCRC();
+
 	static CLZO				lzo;
 	static CEterPackManager	EterPackManager;
 
@@ -384,6 +392,7 @@ bool Main(HINSTANCE hInstance, LPSTR lpCmdLine)
 	bool ret=false;
 	{
 		CPythonLauncher pyLauncher;
+		CPythonProfiler pyProfiler;
 		CPythonExceptionSender pyExceptionSender;
 		SetExceptionSender(&pyExceptionSender);
 
@@ -607,5 +616,10 @@ int Setup(LPSTR lpCmdLine)
     Callback.Function = GrannyError;
     Callback.UserData = 0;
     GrannySetLogCallback(&Callback);
+
+	/*
+	 *	같은 종족의 인스턴스들이 뼈-트랙 바인딩을 나눠 쓰도록 캐시를 넉넉히 잡는다
+	 */
+	GrannySetMaximumAnimationBindingCount(8192);
 	return 1;
 }
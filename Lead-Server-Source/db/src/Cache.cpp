@@ -14,6 +14,7 @@ extern int g_test_server;
 extern int g_iItemPriceListTableCacheFlushSeconds;
 // END_OF_MYSHOP_PRICE_LIST
 extern int g_item_count;
+extern int g_iItemCacheFlushBatchSize;
 
 CItemCache::CItemCache()
 {
@@ -37,109 +38,87 @@ void CItemCache::Delete()
 	if (m_data.vnum == 0)
 		return;
 
-	//char szQuery[QUERY_MAX_LEN];
-	//szQuery[QUERY_MAX_LEN] = '\0';
 	if (g_test_server)
 		sys_log(0, "ItemCache::Delete : DELETE %u", m_data.id);
 
+	//  ٷ    ׷ Ŀ â  ٸ   Ʈ ´.
 	m_data.vnum = 0;
-	m_bNeedQuery = true;
+	m_bNeedQuery = false;
 	m_lastUpdateTime = time(0);
-	OnFlush();
-	
-	//m_bNeedQuery = false;
-	//m_lastUpdateTime = time(0) - m_expireTime; // ٷ ŸӾƿ ǵ .
+	CClientManager::instance().GroupCommitItem(&m_data);
+}
+
+static const char * ITEM_SAVE_COLUMNS =
+	"(id, owner_id, window, pos, count, vnum, socket0, socket1, socket2, "
+	"attrtype0, attrvalue0, "
+	"attrtype1, attrvalue1, "
+	"attrtype2, attrvalue2, "
+	"attrtype3, attrvalue3, "
+	"attrtype4, attrvalue4, "
+	"attrtype5, attrvalue5, "
+	"attrtype6, attrvalue6) ";
+
+static const char * ITEM_SAVE_VALUES = "(?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
+
+static void BindItemSaveRow(CStmtQuery & rkQuery, const TPlayerItem * p)
+{
+	rkQuery.BindUnsigned(p->id);
+	rkQuery.BindUnsigned(p->owner);
+	rkQuery.BindSigned(p->window);
+	rkQuery.BindSigned(p->pos);
+	rkQuery.BindUnsigned(p->count);
+	rkQuery.BindUnsigned(p->vnum);
+
+	//  unsigned ÷̶ 32Ʈ  ״ ִ´.
+	for (int i = 0; i < ITEM_SOCKET_MAX_NUM; ++i)
+		rkQuery.BindUnsigned((DWORD) p->alSockets[i]);
+
+	for (int i = 0; i < ITEM_ATTRIBUTE_MAX_NUM; ++i)
+	{
+		rkQuery.BindSigned(p->aAttr[i].bType);
+		rkQuery.BindSigned(p->aAttr[i].sValue);
+	}
+}
+
+void CreateItemSaveStmt(CStmtQuery & rkQuery, const TPlayerItem * p)
+{
+	char szQuery[QUERY_MAX_LEN];
+
+	snprintf(szQuery, sizeof(szQuery), "REPLACE INTO item%s %sVALUES%s",
+			GetTablePostfix(), ITEM_SAVE_COLUMNS, ITEM_SAVE_VALUES);
+
+	rkQuery.SetQuery(szQuery);
+	BindItemSaveRow(rkQuery, p);
 }
 
 void CItemCache::OnFlush()
 {
+	CStmtQuery kQuery;
+
 	if (m_data.vnum == 0) // vnum 0̸ ϶ ǥõ ̴.
 	{
 		char szQuery[QUERY_MAX_LEN];
-		snprintf(szQuery, sizeof(szQuery), "DELETE FROM item%s WHERE id=%u", GetTablePostfix(), m_data.id);
-		CDBManager::instance().ReturnQuery(szQuery, QID_ITEM_DESTROY, 0, NULL);
+		snprintf(szQuery, sizeof(szQuery), "DELETE FROM item%s WHERE id=?", GetTablePostfix());
+
+		kQuery.SetQuery(szQuery);
+		kQuery.BindUnsigned(m_data.id);
+
+		CClientManager::instance().FlushGroupCommitFor(m_data.id);
+		CDBManager::instance().ReturnStmt(kQuery, QID_ITEM_DESTROY, 0, NULL, SQL_PLAYER, m_data.id);
 
 		if (g_test_server)
 			sys_log(0, "ItemCache::Flush : DELETE %u %s", m_data.id, szQuery);
 	}
 	else
 	{
-		long alSockets[ITEM_SOCKET_MAX_NUM];
-		TPlayerItemAttribute aAttr[ITEM_ATTRIBUTE_MAX_NUM];
-		bool isSocket = false, isAttr = false;
-
-		memset(&alSockets, 0, sizeof(long) * ITEM_SOCKET_MAX_NUM);
-		memset(&aAttr, 0, sizeof(TPlayerItemAttribute) * ITEM_ATTRIBUTE_MAX_NUM);
-
-		TPlayerItem * p = &m_data;
-
-		if (memcmp(alSockets, p->alSockets, sizeof(long) * ITEM_SOCKET_MAX_NUM))
-			isSocket = true;
-
-		if (memcmp(aAttr, p->aAttr, sizeof(TPlayerItemAttribute) * ITEM_ATTRIBUTE_MAX_NUM))
-			isAttr = true;
-
-		char szColumns[QUERY_MAX_LEN];
-		char szValues[QUERY_MAX_LEN];
-		char szUpdate[QUERY_MAX_LEN];
-
-		int iLen = snprintf(szColumns, sizeof(szColumns), "id, owner_id, window, pos, count, vnum");
-
-		int iValueLen = snprintf(szValues, sizeof(szValues), "%u, %u, %d, %d, %u, %u",
-				p->id, p->owner, p->window, p->pos, p->count, p->vnum);
-
-		int iUpdateLen = snprintf(szUpdate, sizeof(szUpdate), "owner_id=%u, window=%d, pos=%d, count=%u, vnum=%u",
-				p->owner, p->window, p->pos, p->count, p->vnum);
-
-		if (isSocket)
-		{
-			iLen += snprintf(szColumns + iLen, sizeof(szColumns) - iLen, ", socket0, socket1, socket2");
-			iValueLen += snprintf(szValues + iValueLen, sizeof(szValues) - iValueLen,
-					", %lu, %lu, %lu", p->alSockets[0], p->alSockets[1], p->alSockets[2]);
-			iUpdateLen += snprintf(szUpdate + iUpdateLen, sizeof(szUpdate) - iUpdateLen,
-					", socket0=%lu, socket1=%lu, socket2=%lu", p->alSockets[0], p->alSockets[1], p->alSockets[2]);
-		}
-
-		if (isAttr)
-		{
-			iLen += snprintf(szColumns + iLen, sizeof(szColumns) - iLen, 
-					", attrtype0, attrvalue0, attrtype1, attrvalue1, attrtype2, attrvalue2, attrtype3, attrvalue3"
-					", attrtype4, attrvalue4, attrtype5, attrvalue5, attrtype6, attrvalue6");
-
-			iValueLen += snprintf(szValues + iValueLen, sizeof(szValues) - iValueLen,
-					", %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d",
-					p->aAttr[0].bType, p->aAttr[0].sValue,
-					p->aAttr[1].bType, p->aAttr[1].sValue,
-					p->aAttr[2].bType, p->aAttr[2].sValue,
-					p->aAttr[3].bType, p->aAttr[3].sValue,
-					p->aAttr[4].bType, p->aAttr[4].sValue,
-					p->aAttr[5].bType, p->aAttr[5].sValue,
-					p->aAttr[6].bType, p->aAttr[6].sValue);
-
-			iUpdateLen += snprintf(szUpdate + iUpdateLen, sizeof(szUpdate) - iUpdateLen,
-					", attrtype0=%d, attrvalue0=%d"
-					", attrtype1=%d, attrvalue1=%d"
-					", attrtype2=%d, attrvalue2=%d"
-					", attrtype3=%d, attrvalue3=%d"
-					", attrtype4=%d, attrvalue4=%d"
-					", attrtype5=%d, attrvalue5=%d"
-					", attrtype6=%d, attrvalue6=%d",
-					p->aAttr[0].bType, p->aAttr[0].sValue,
-					p->aAttr[1].bType, p->aAttr[1].sValue,
-					p->aAttr[2].bType, p->aAttr[2].sValue,
-					p->aAttr[3].bType, p->aAttr[3].sValue,
-					p->aAttr[4].bType, p->aAttr[4].sValue,
-					p->aAttr[5].bType, p->aAttr[5].sValue,
-					p->aAttr[6].bType, p->aAttr[6].sValue);
-		}
-
-		char szItemQuery[QUERY_MAX_LEN + QUERY_MAX_LEN];
-		snprintf(szItemQuery, sizeof(szItemQuery), "REPLACE INTO item%s (%s) VALUES(%s)", GetTablePostfix(), szColumns, szValues);
+		//  ÷ εص ؽƮ  Ƿ /Ӽ     ʴ´.
+		CreateItemSaveStmt(kQuery, &m_data);
 
 		if (g_test_server)	
-			sys_log(0, "ItemCache::Flush :REPLACE  (%s)", szItemQuery);
+			sys_log(0, "ItemCache::Flush :REPLACE  id %u owner %u vnum %u", m_data.id, m_data.owner, m_data.vnum);
 
-		CDBManager::instance().ReturnQuery(szItemQuery, QID_ITEM_SAVE, 0, NULL);
+		CClientManager::instance().FlushGroupCommitFor(m_data.id);
+		CDBManager::instance().ReturnStmt(kQuery, QID_ITEM_SAVE, 0, NULL, SQL_PLAYER, m_data.id);
 
 		//g_item_info.Add(p->vnum);
 		++g_item_count;
@@ -148,12 +127,228 @@ void CItemCache::OnFlush()
 	m_bNeedQuery = false;
 }
 
+void CItemCache::Flush(CItemSaveBatch & rkBatch)
+{
+	if (!m_bNeedQuery)
+		return;
+
+	rkBatch.Add(&m_data);
+
+	m_bNeedQuery = false;
+	m_lastFlushTime = time(0);
+}
+
+//
+// CItemSaveBatch
+//
+//  SQL   item id  .  ȿ   ״ д.
+struct FItemLaneLess
+{
+	DWORD m_dwLanes;
+
+	FItemLaneLess(DWORD dwLanes) : m_dwLanes(dwLanes)
+	{
+	}
+
+	DWORD Lane(const TPlayerItem & r) const
+	{
+		return r.id % m_dwLanes;
+	}
+
+	bool operator () (const TPlayerItem & a, const TPlayerItem & b) const
+	{
+		return Lane(a) < Lane(b);
+	}
+};
+
+CItemSaveBatch::CItemSaveBatch()
+{
+}
+
+CItemSaveBatch::~CItemSaveBatch()
+{
+	Commit();
+}
+
+void CItemSaveBatch::Add(const TPlayerItem * pkItem)
+{
+	//    ⸸ . Ⱑ     嵵 Բ .
+	std::map<DWORD, size_t>::iterator it = m_map_kIndex.find(pkItem->id);
+
+	if (it != m_map_kIndex.end())
+	{
+		m_vec_kItem[it->second] = *pkItem;
+		return;
+	}
+
+	m_map_kIndex.insert(std::make_pair(pkItem->id, m_vec_kItem.size()));
+	m_vec_kItem.push_back(*pkItem);
+}
+
+bool CItemSaveBatch::Overlaps(const CItemSaveBatch & rkOther) const
+{
+	const CItemSaveBatch & rkSmall = GetCount() < rkOther.GetCount() ? *this : rkOther;
+	const CItemSaveBatch & rkLarge = &rkSmall == this ? rkOther : *this;
+
+	for (size_t i = 0; i < rkSmall.m_vec_kItem.size(); ++i)
+		if (rkLarge.Has(rkSmall.m_vec_kItem[i].id))
+			return true;
+
+	return false;
+}
+
+void CItemSaveBatch::Commit(bool bTransaction)
+{
+	if (m_vec_kItem.empty())
+		return;
+
+	// ׷ ĿԿ     װͺ  ̹ Ⱑ ߿ ȴ.
+	CClientManager::instance().FlushGroupCommitFor(*this);
+
+	// id  ϳ̹Ƿ        .
+	for (size_t i = 0; i < m_vec_kItem.size(); ++i)
+	{
+		if (m_vec_kItem[i].vnum == 0) // vnum 0̸ ϶ ǥõ ̴.
+			m_vec_kDelete.push_back(m_vec_kItem[i]);
+		else
+			m_vec_kSave.push_back(m_vec_kItem[i]);
+	}
+
+	m_vec_kItem.clear();
+	m_map_kIndex.clear();
+
+	//   item id  Ű Ƿ  ٲ      ῡ ʷ ȴ.
+	//         ǹǷ Ʈǰ  Ằ ڸ.
+	FItemLaneLess kLess(MAX(1, CDBManager::instance().GetReturnPoolSize(SQL_PLAYER)));
+
+	std::stable_sort(m_vec_kSave.begin(), m_vec_kSave.end(), kLess);
+	std::stable_sort(m_vec_kDelete.begin(), m_vec_kDelete.end(), kLess);
+
+	size_t iDelete = 0, iSave = 0;
+
+	while (iDelete < m_vec_kDelete.size() || iSave < m_vec_kSave.size())
+	{
+		DWORD dwLane;
+
+		if (iSave >= m_vec_kSave.size())
+			dwLane = kLess.Lane(m_vec_kDelete[iDelete]);
+		else if (iDelete >= m_vec_kDelete.size())
+			dwLane = kLess.Lane(m_vec_kSave[iSave]);
+		else
+			dwLane = MIN(kLess.Lane(m_vec_kDelete[iDelete]), kLess.Lane(m_vec_kSave[iSave]));
+
+		size_t uiDelete = 0, uiSave = 0;
+
+		while (iDelete + uiDelete < m_vec_kDelete.size() && kLess.Lane(m_vec_kDelete[iDelete + uiDelete]) == dwLane)
+			++uiDelete;
+
+		while (iSave + uiSave < m_vec_kSave.size() && kLess.Lane(m_vec_kSave[iSave + uiSave]) == dwLane)
+			++uiSave;
+
+		CommitLane(uiDelete ? &m_vec_kDelete[iDelete] : NULL, uiDelete,
+				uiSave ? &m_vec_kSave[iSave] : NULL, uiSave, bTransaction);
+
+		iDelete += uiDelete;
+		iSave += uiSave;
+	}
+
+	m_vec_kSave.clear();
+	m_vec_kDelete.clear();
+}
+
+void CItemSaveBatch::CommitLane(const TPlayerItem * pkDelete, size_t uiDelete, const TPlayerItem * pkSave, size_t uiSave, bool bTransaction)
+{
+	size_t uiBatch = MAX(1, g_iItemCacheFlushBatchSize);
+	DWORD dwKey = uiSave ? pkSave[0].id : pkDelete[0].id;
+
+	if (bTransaction)
+	{
+		size_t uiQueryCount = (uiSave + uiBatch - 1) / uiBatch + (uiDelete + uiBatch - 1) / uiBatch;
+
+		if (uiQueryCount <= 1)
+			bTransaction = false;
+		else // Ʒ ReturnStmt    ϹǷ ReturnQuery .
+			CDBManager::instance().ReturnQuery("START TRANSACTION", QID_ITEM_SAVE, 0, NULL, SQL_PLAYER, dwKey);
+	}
+
+	for (size_t i = 0; i < uiDelete; )
+	{
+		size_t count = MIN(uiBatch, uiDelete - i);
+
+		CommitDelete(&pkDelete[i], count);
+		i += count;
+	}
+
+	for (size_t i = 0; i < uiSave; )
+	{
+		size_t count = MIN(uiBatch, uiSave - i);
+
+		CommitSave(&pkSave[i], count);
+		i += count;
+	}
+
+	if (bTransaction)
+		CDBManager::instance().ReturnQuery("COMMIT", QID_ITEM_SAVE, 0, NULL, SQL_PLAYER, dwKey);
+}
+
+void CItemSaveBatch::CommitSave(const TPlayerItem * pkBegin, size_t count)
+{
+	char szQuery[QUERY_MAX_LEN];
+	snprintf(szQuery, sizeof(szQuery), "REPLACE INTO item%s %sVALUES", GetTablePostfix(), ITEM_SAVE_COLUMNS);
+
+	std::string stQuery(szQuery);
+	stQuery.reserve(stQuery.size() + count * (strlen(ITEM_SAVE_VALUES) + 2));
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (i)
+			stQuery += ", ";
+
+		stQuery += ITEM_SAVE_VALUES;
+	}
+
+	CStmtQuery kQuery(stQuery.c_str());
+
+	for (size_t i = 0; i < count; ++i)
+		BindItemSaveRow(kQuery, pkBegin + i);
+
+	if (g_test_server)
+		sys_log(0, "ItemCache::Flush : REPLACE id %u count %u", pkBegin->id, (DWORD) count);
+
+	CDBManager::instance().ReturnStmt(kQuery, QID_ITEM_SAVE, 0, NULL, SQL_PLAYER, pkBegin->id);
+	g_item_count += count;
+}
+
+void CItemSaveBatch::CommitDelete(const TPlayerItem * pkBegin, size_t count)
+{
+	char szQuery[QUERY_MAX_LEN];
+	snprintf(szQuery, sizeof(szQuery), "DELETE FROM item%s WHERE id IN (", GetTablePostfix());
+
+	std::string stQuery(szQuery);
+
+	for (size_t i = 0; i < count; ++i)
+		stQuery += i ? ", ?" : "?";
+
+	stQuery += ")";
+
+	CStmtQuery kQuery(stQuery.c_str());
+
+	for (size_t i = 0; i < count; ++i)
+		kQuery.BindUnsigned(pkBegin[i].id);
+
+	if (g_test_server)
+		sys_log(0, "ItemCache::Flush : DELETE id %u count %u", pkBegin->id, (DWORD) count);
+
+	CDBManager::instance().ReturnStmt(kQuery, QID_ITEM_DESTROY, 0, NULL, SQL_PLAYER, pkBegin->id);
+}
+
 //
 // CPlayerTableCache
 //
-CPlayerTableCache::CPlayerTableCache()
+CPlayerTableCache::CPlayerTableCache() : m_bFlushed(false)
 {
 	m_expireTime = MIN(1800, g_iPlayerCacheFlushSeconds);
+	memset(&m_kFlushed, 0, sizeof(m_kFlushed));
 }
 
 CPlayerTableCache::~CPlayerTableCache()
@@ -162,12 +357,27 @@ CPlayerTableCache::~CPlayerTableCache()
 
 void CPlayerTableCache::OnFlush()
 {
+	// ó Flush   DB  𸣹Ƿ  .
+	DWORD dwFields = m_bFlushed ? GetPlayerSaveFields(&m_data, &m_kFlushed) : PLAYER_SAVE_ALL;
+
 	if (g_test_server)
-		sys_log(0, "PlayerTableCache::Flush : %s", m_data.name);
+		sys_log(0, "PlayerTableCache::Flush : %s fields %x", m_data.name, dwFields);
 
-	char szQuery[QUERY_MAX_LEN];
-	CreatePlayerSaveQuery(szQuery, sizeof(szQuery), &m_data);
-	CDBManager::instance().ReturnQuery(szQuery, QID_PLAYER_SAVE, 0, NULL);
+	// ٲ ÷  last_play  ؾ ϹǷ UPDATE  ׻ .
+	CStmtQuery kQuery;
+	CreatePlayerSaveStmt(kQuery, &m_data, dwFields);
+	CDBManager::instance().ReturnStmt(kQuery, QID_PLAYER_SAVE, 0, new CClientManager::ClientHandleInfo(0, m_data.id), SQL_PLAYER, m_data.id);
+
+	//  ٸ ʰ    ´. ϸ OnFlushFailed   .
+	thecore_memcpy(&m_kFlushed, &m_data, sizeof(m_kFlushed));
+	m_bFlushed = true;
+}
+
+void CPlayerTableCache::OnFlushFailed()
+{
+	//  ڿ ̹  UPDATE     ̸ Ƿ óó   Ѵ.
+	m_bFlushed = false;
+	m_bNeedQuery = true;
 }
 
 // MYSHOP_PRICE_LIST
@@ -4,6 +4,63 @@
 
 #include "common/cache.h"
 
+class CItemSaveBatch;
+
+/**
+ * ĳ id  ˻ ð() Ŷ ־ ΰ  ð  ͸ .
+ *  ʿ  ƴ ٽ Ȯϰ, ƴϸ  ð ٽ ִ´.
+ */
+class CCacheExpiryQueue
+{
+    public:
+	enum { QUEUE_SECONDS = 2048 };	// ĳ  ð(ִ 1800)  Ѵ.
+
+	CCacheExpiryQueue() : m_tCurrent(time(0)), m_dwSize(0)
+	{
+	}
+
+	//   Ŷ ð ش.
+	time_t Push(DWORD dwID, time_t tDue)
+	{
+		if (tDue < m_tCurrent)
+			tDue = m_tCurrent;
+		else if (tDue >= m_tCurrent + QUEUE_SECONDS)
+			tDue = m_tCurrent + QUEUE_SECONDS - 1;
+
+		m_avec_dwID[tDue % QUEUE_SECONDS].push_back(dwID);
+		++m_dwSize;
+		return tDue;
+	}
+
+	bool Pop(time_t tNow, DWORD & rdwID, time_t & rtQueued)
+	{
+		while (m_tCurrent <= tNow)
+		{
+			std::vector<DWORD> & rvec = m_avec_dwID[m_tCurrent % QUEUE_SECONDS];
+
+			if (!rvec.empty())
+			{
+				rdwID = rvec.back();
+				rtQueued = m_tCurrent;
+				rvec.pop_back();
+				--m_dwSize;
+				return true;
+			}
+
+			++m_tCurrent;
+		}
+
+		return false;
+	}
+
+	DWORD Size() const { return m_dwSize; }
+
+    private:
+	std::vector<DWORD>	m_avec_dwID[QUEUE_SECONDS];
+	time_t			m_tCurrent;
+	DWORD			m_dwSize;
+};
+
 class CItemCache : public cache<TPlayerItem>
 {
     public:
@@ -11,9 +68,44 @@ class CItemCache : public cache<TPlayerItem>
 	virtual ~CItemCache();
 
 	void Delete();
+	void Flush(CItemSaveBatch & rkBatch);
+	using cache<TPlayerItem>::Flush;
 	virtual void OnFlush();
 };
 
+/**
+ *  ĳ ÷ø SQL Ằ   ¥ REPLACE/DELETE  .
+ * Commit  ƹ   ʴ´.  id   Add   ϳ ´.
+ */
+class CItemSaveBatch
+{
+    public:
+	CItemSaveBatch();
+	~CItemSaveBatch();
+
+	void	Add(const TPlayerItem * pkItem);
+	bool	IsEmpty() const	{ return m_vec_kItem.empty(); }
+	DWORD	GetCount() const	{ return m_vec_kItem.size(); }
+
+	bool	Has(DWORD dwID) const	{ return m_map_kIndex.find(dwID) != m_map_kIndex.end(); }
+	bool	Overlaps(const CItemSaveBatch & rkOther) const;
+
+	/// bTransaction ̸   ̻  Ʈ ´.
+	/// item id   SQL (id % Ǯ ũ)  ͳ Ḷ ϳ ´.
+	void	Commit(bool bTransaction = false);
+
+    private:
+	void	CommitLane(const TPlayerItem * pkDelete, size_t uiDelete, const TPlayerItem * pkSave, size_t uiSave, bool bTransaction);
+	void	CommitSave(const TPlayerItem * pkBegin, size_t count);
+	void	CommitDelete(const TPlayerItem * pkBegin, size_t count);
+
+	std::vector<TPlayerItem>	m_vec_kItem;	//  .  id  ڸ Ű 븸 ٲ.
+	std::map<DWORD, size_t>		m_map_kIndex;	// id -> m_vec_kItem ġ
+
+	std::vector<TPlayerItem>	m_vec_kSave;	// Commit ȿ 
+	std::vector<TPlayerItem>	m_vec_kDelete;
+};
+
 class CPlayerTableCache : public cache<TPlayerTable>
 {
     public:
@@ -21,8 +113,14 @@ class CPlayerTableCache : public cache<TPlayerTable>
 	virtual ~CPlayerTableCache();
 
 	virtual void OnFlush();
+	// OnFlush   UPDATE    θ.  Flush   ü ٽ .
+	void OnFlushFailed();
 
 	DWORD GetLastUpdateTime() { return m_lastUpdateTime; }
+
+    private:
+	TPlayerTable	m_kFlushed;	//  DB  . ٲ ÷ UPDATE ϴ  .
+	bool		m_bFlushed;
 };
 
 // MYSHOP_PRICE_LIST
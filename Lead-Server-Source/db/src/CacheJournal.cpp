@@ -0,0 +1,223 @@
+#include "stdafx.h"
+#include "CacheJournal.h"
+
+#include <zlib.h>
+
+#ifdef __WIN32__
+#include <io.h>
+#endif
+
+static DWORD RecordCRC(BYTE bType, const void * c_pvData, DWORD dwSize)
+{
+	uLong crc = crc32(0L, Z_NULL, 0);
+	crc = crc32(crc, (const Bytef *) &bType, 1);
+	return crc32(crc, (const Bytef *) c_pvData, dwSize);
+}
+
+CCacheJournal::CCacheJournal() : m_fp(NULL), m_iSyncMS(0), m_iCheckpointSeconds(0), m_dwLastSyncTime(0), m_tLastCheckpoint(0)
+{
+}
+
+CCacheJournal::~CCacheJournal()
+{
+	//   δ Close   θ. ⼭  ͸  д.
+	if (m_fp)
+	{
+		Sync();
+		fclose(m_fp);
+		m_fp = NULL;
+	}
+}
+
+bool CCacheJournal::Open(const char * c_pszPath, int iSyncMS, int iCheckpointSeconds)
+{
+	m_stPath = c_pszPath;
+	m_stTempPath = m_stPath + ".tmp";
+	m_iSyncMS = iSyncMS;
+	m_iCheckpointSeconds = iCheckpointSeconds;
+
+	//  ࿡   д´. .tmp  üũƮ ߿  ̹Ƿ .
+	m_vecReplay.clear();
+
+	FILE * fp = fopen(m_stPath.c_str(), "rb");
+
+	if (fp)
+	{
+		char buf[65536];
+		size_t len;
+
+		while ((len = fread(buf, 1, sizeof(buf), fp)) > 0)
+			m_vecReplay.insert(m_vecReplay.end(), buf, buf + len);
+
+		fclose(fp);
+		sys_log(0, "CACHE_JOURNAL: %s has %u bytes to replay", m_stPath.c_str(), m_vecReplay.size());
+	}
+
+	remove(m_stTempPath.c_str());
+
+	// ٽ ִ ϵ Append    Ͽ ̵ üũƮó .
+	if (!(m_fp = fopen(m_stTempPath.c_str(), "wb")))
+	{
+		sys_err("CACHE_JOURNAL: cannot open %s: %s", m_stTempPath.c_str(), strerror(errno));
+		return false;
+	}
+
+	m_dwLastSyncTime = get_dword_time();
+	m_tLastCheckpoint = time(0);
+	return true;
+}
+
+void CCacheJournal::Close(bool bClean)
+{
+	if (!m_fp)
+		return;
+
+	Sync();
+	fclose(m_fp);
+	m_fp = NULL;
+
+	if (bClean)
+	{
+		remove(m_stPath.c_str());
+		sys_log(0, "CACHE_JOURNAL: clean shutdown, %s removed", m_stPath.c_str());
+	}
+}
+
+bool CCacheJournal::ReadRecord(size_t & rPos, BYTE & rbType, const char * & rc_pData, DWORD & rdwSize) const
+{
+	if (rPos + sizeof(TRecordHeader) > m_vecReplay.size())
+		return false;
+
+	TRecordHeader h;
+	thecore_memcpy(&h, &m_vecReplay[rPos], sizeof(TRecordHeader));
+
+	//   ٰ ׾ ߷  ִ.
+	if (h.dwSize > m_vecReplay.size() - rPos - sizeof(TRecordHeader))
+		return false;
+
+	const char * c_pData = &m_vecReplay[rPos + sizeof(TRecordHeader)];
+
+	if (RecordCRC(h.bType, c_pData, h.dwSize) != h.dwCRC)
+		return false;
+
+	rbType = h.bType;
+	rc_pData = c_pData;
+	rdwSize = h.dwSize;
+	rPos += sizeof(TRecordHeader) + h.dwSize;
+	return true;
+}
+
+void CCacheJournal::Append(BYTE bType, const void * c_pvData, DWORD dwSize)
+{
+	if (!m_fp)
+		return;
+
+	TRecordHeader h;
+	h.bType = bType;
+	h.dwSize = dwSize;
+	h.dwCRC = RecordCRC(bType, c_pvData, dwSize);
+
+	size_t pos = m_vecPending.size();
+	m_vecPending.resize(pos + sizeof(TRecordHeader) + dwSize);
+	thecore_memcpy(&m_vecPending[pos], &h, sizeof(TRecordHeader));
+	thecore_memcpy(&m_vecPending[pos + sizeof(TRecordHeader)], c_pvData, dwSize);
+}
+
+void CCacheJournal::AppendPlayer(const TPlayerTable * c_pkTab)
+{
+	Append(RECORD_PLAYER, c_pkTab, sizeof(TPlayerTable));
+}
+
+void CCacheJournal::AppendItem(const TPlayerItem * c_pkItem)
+{
+	Append(RECORD_ITEM, c_pkItem, sizeof(TPlayerItem));
+}
+
+void CCacheJournal::AppendItemDelete(DWORD dwItemID)
+{
+	Append(RECORD_ITEM_DELETE, &dwItemID, sizeof(DWORD));
+}
+
+bool CCacheJournal::Sync()
+{
+	m_dwLastSyncTime = get_dword_time();
+
+	if (!m_fp || m_vecPending.empty())
+		return true;
+
+	if (fwrite(&m_vecPending[0], 1, m_vecPending.size(), m_fp) != m_vecPending.size() || fflush(m_fp) != 0)
+	{
+		sys_err("CACHE_JOURNAL: write failed %u bytes: %s", m_vecPending.size(), strerror(errno));
+		clearerr(m_fp);
+		return false;
+	}
+
+#ifdef __WIN32__
+	_commit(_fileno(m_fp));
+#else
+	fsync(fileno(m_fp));
+#endif
+
+	m_vecPending.clear();
+	return true;
+}
+
+void CCacheJournal::Update()
+{
+	if (!m_fp || m_vecPending.empty())
+		return;
+
+	if (get_dword_time() - m_dwLastSyncTime >= (DWORD) m_iSyncMS)
+		Sync();
+}
+
+bool CCacheJournal::NeedCheckpoint() const
+{
+	return m_fp && time(0) - m_tLastCheckpoint >= m_iCheckpointSeconds;
+}
+
+void CCacheJournal::BeginCheckpoint()
+{
+	if (!m_fp)
+		return;
+
+	// ݱ   Ͽ  д.         ٽ д´.
+	Sync();
+	fclose(m_fp);
+
+	if (!(m_fp = fopen(m_stTempPath.c_str(), "wb")))
+	{
+		sys_err("CACHE_JOURNAL: cannot open %s: %s", m_stTempPath.c_str(), strerror(errno));
+
+		// üũƮ ϰ  Ͽ  .
+		if (!(m_fp = fopen(m_stPath.c_str(), "ab")))
+			sys_err("CACHE_JOURNAL: cannot reopen %s, journal disabled", m_stPath.c_str());
+
+		m_tLastCheckpoint = time(0);
+	}
+}
+
+void CCacheJournal::EndCheckpoint()
+{
+	if (!m_fp)
+		return;
+
+	if (!Sync())
+		sys_err("CACHE_JOURNAL: checkpoint sync failed");
+
+	fclose(m_fp);
+	m_fp = NULL;
+
+#ifdef __WIN32__
+	remove(m_stPath.c_str());
+#endif
+
+	if (rename(m_stTempPath.c_str(), m_stPath.c_str()) != 0)
+		sys_err("CACHE_JOURNAL: rename %s -> %s failed: %s", m_stTempPath.c_str(), m_stPath.c_str(), strerror(errno));
+
+	if (!(m_fp = fopen(m_stPath.c_str(), "ab")))
+		sys_err("CACHE_JOURNAL: cannot reopen %s, journal disabled", m_stPath.c_str());
+
+	m_tLastCheckpoint = time(0);
+	sys_log(0, "CACHE_JOURNAL: checkpoint done");
+}
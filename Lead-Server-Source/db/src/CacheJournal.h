@@ -0,0 +1,94 @@
+// vim: ts=8 sw=4
+#ifndef __INC_CACHE_JOURNAL_H__
+#define __INC_CACHE_JOURNAL_H__
+
+/**
+ * ÷̾/ ĳÿ    ڿ ٿ  .
+ *   ξٰ Update      write + fsync Ѵ.
+ *    ٽ  Replay   DB     ִ  ĳÿ ٽ ִ´.
+ *
+ * üũƮ   ÷õ  ĳø  Ͽ ٽ   ϰ ٲ۴.
+ */
+class CCacheJournal : public singleton<CCacheJournal>
+{
+    public:
+	enum ERecordType
+	{
+	    RECORD_PLAYER = 1,		// TPlayerTable
+	    RECORD_ITEM = 2,		// TPlayerItem
+	    RECORD_ITEM_DELETE = 3,	// DWORD item id
+	};
+
+#pragma pack(1)
+	typedef struct SRecordHeader
+	{
+	    BYTE	bType;
+	    DWORD	dwSize;
+	    DWORD	dwCRC;	// bType   crc32
+	} TRecordHeader;
+#pragma pack()
+
+	CCacheJournal();
+	virtual ~CCacheJournal();
+
+	//    о ΰ    . ̾ ݵ Replay  ҷ Ѵ.
+	bool		Open(const char * c_pszPath, int iSyncMS, int iCheckpointSeconds);
+	//  (   ) bClean   .
+	void		Close(bool bClean);
+	bool		IsOpen() const { return m_fp != NULL; }
+
+	//  ִ   f(bType, data, size)  ѱ   η ٲ۴.
+	template <typename F> void Replay(F & f)
+	{
+	    size_t pos = 0;
+	    DWORD dwCount = 0;
+	    BYTE bType;
+	    const char * c_pData;
+	    DWORD dwSize;
+
+	    while (ReadRecord(pos, bType, c_pData, dwSize))
+	    {
+		f(bType, c_pData, dwSize);
+		++dwCount;
+	    }
+
+	    if (pos != m_vecReplay.size())
+		sys_err("CACHE_JOURNAL: broken record at %u / %u, rest ignored", pos, m_vecReplay.size());
+
+	    sys_log(0, "CACHE_JOURNAL: replayed %u records", dwCount);
+
+	    m_vecReplay.clear();
+	    EndCheckpoint();
+	}
+
+	void		AppendPlayer(const TPlayerTable * c_pkTab);
+	void		AppendItem(const TPlayerItem * c_pkItem);
+	void		AppendItemDelete(DWORD dwItemID);
+
+	//  ޽ θ. ȭ      .
+	void		Update();
+
+	bool		NeedCheckpoint() const;
+	// Begin  End ̿  ÷õ  ĳø  Append ؾ Ѵ.
+	void		BeginCheckpoint();
+	void		EndCheckpoint();
+
+    private:
+	void		Append(BYTE bType, const void * c_pvData, DWORD dwSize);
+	bool		ReadRecord(size_t & rPos, BYTE & rbType, const char * & rc_pData, DWORD & rdwSize) const;
+	bool		Sync();
+
+	std::string		m_stPath;
+	std::string		m_stTempPath;
+	FILE *			m_fp;
+
+	std::vector<char>	m_vecPending;
+	std::vector<char>	m_vecReplay;
+
+	int			m_iSyncMS;
+	int			m_iCheckpointSeconds;
+	DWORD			m_dwLastSyncTime;
+	time_t			m_tLastCheckpoint;
+};
+
+#endif
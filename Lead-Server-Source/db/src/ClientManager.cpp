@@ -18,11 +18,20 @@
 #include "Marriage.h"
 #include "ItemIDRangeManager.h"
 #include "Cache.h"
+#include "CacheJournal.h"
 
 extern int g_iPlayerCacheFlushSeconds;
 extern int g_iItemCacheFlushSeconds;
+extern int g_iSafeboxCacheSeconds;
 extern int g_test_server;
 extern int g_log;
+extern int g_iPeerPacketBudget;
+extern int g_iItemAwardPollSeconds;
+extern int g_iClusterStateSeconds;
+extern int g_iGroupCommitMS;
+extern std::string g_stCacheJournalFile;
+extern int g_iCacheJournalSyncMS;
+extern int g_iCacheJournalCheckpointSeconds;
 extern std::string g_stLocale;
 extern std::string g_stLocaleNameColumn;
 bool CreateItemTableFromRes(MYSQL_RES * res, std::vector<TPlayerItem> * pVec, DWORD dwPID);
@@ -45,9 +54,11 @@ CClientManager::CClientManager() :
 	m_pShopTable(NULL),
 	m_iRefineTableSize(0),
 	m_pRefineTable(NULL),
+	m_dwBootTableRawSize(0),
 	m_bShutdowned(FALSE),
 	m_iCacheFlushCount(0),
-	m_iCacheFlushCountLimit(200)
+	m_iCacheFlushCountLimit(200),
+	m_dwGroupCommitStart(0)
 {
 	m_itemRange.dwMin = 0;
 	m_itemRange.dwMax = 0;
@@ -108,6 +119,18 @@ bool CClientManager::Initialize()
 		return false;
 	}
 
+	//  ھ ٱ   ࿡ DB     ִ ĳ  ٽ ִ´.
+	if (!g_stCacheJournalFile.empty())
+	{
+		if (!CCacheJournal::instance().Open(g_stCacheJournalFile.c_str(), g_iCacheJournalSyncMS, g_iCacheJournalCheckpointSeconds))
+		{
+			sys_err("Cache journal open FAILED");
+			return false;
+		}
+
+		ReplayCacheJournal();
+	}
+
 	CGuildManager::instance().BootReserveWar();
 
 	if (!CConfig::instance().GetValue("BIND_PORT", &tmpValue))
@@ -195,16 +218,20 @@ void CClientManager::MainLoop()
 
 	
 	itertype(m_map_itemCache) it2 = m_map_itemCache.begin();
+	CItemSaveBatch kItemBatch;
 	// ÷
 	while (it2 != m_map_itemCache.end())
 	{
 		CItemCache * c = (it2++)->second;
 
-		c->Flush();
+		c->Flush(kItemBatch);
 		delete c;
 	}
+	kItemBatch.Commit();
 	m_map_itemCache.clear();
 
+	FlushGroupCommit();
+
 	// MYSHOP_PRICE_LIST
 	//
 	// λ   Ʈ Flush
@@ -225,9 +252,27 @@ void CClientManager::Quit()
 	m_bShutdowned = TRUE;
 }
 
+static char * EncodeBootTableHeader(char * p, WORD wSize, WORD wCount)
+{
+	thecore_memcpy(p, &wSize, sizeof(WORD));
+	p += sizeof(WORD);
+	thecore_memcpy(p, &wCount, sizeof(WORD));
+	return p + sizeof(WORD);
+}
+
+static char * EncodeBootTable(char * p, WORD wSize, WORD wCount, const void * c_pvData)
+{
+	p = EncodeBootTableHeader(p, wSize, wCount);
+
+	if (wCount)
+		thecore_memcpy(p, c_pvData, wSize * wCount);
+
+	return p + wSize * wCount;
+}
+
 void CClientManager::QUERY_BOOT(CPeer* peer, TPacketGDBoot * p)
 {
-	const BYTE bPacketVersion = 6; // BOOT Ŷ ٲ𶧸 ȣ ø Ѵ.
+	const BYTE bPacketVersion = 7; // BOOT Ŷ ٲ𶧸 ȣ ø Ѵ.
 
 	std::vector<tAdminInfo> vAdmin;
 	std::vector<std::string> vHost;
@@ -240,16 +285,8 @@ void CClientManager::QUERY_BOOT(CPeer* peer, TPacketGDBoot * p)
 	DWORD dwPacketSize = 
 		sizeof(DWORD) +
 		sizeof(BYTE) +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TMobTable) * m_vec_mobTable.size() +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TItemTable) * m_vec_itemTable.size() +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TShopTable) * m_iShopTableSize +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TSkillTable) * m_vec_skillTable.size() +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TRefineTable) * m_iRefineTableSize +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TItemAttrTable) * m_vec_itemAttrTable.size() +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TItemAttrTable) * m_vec_itemRareTable.size() +
-		sizeof(WORD) + sizeof(WORD) + sizeof(TBanwordTable) * m_vec_banwordTable.size() +
+		sizeof(DWORD) + sizeof(DWORD) + m_vec_bootTableCache.size() +
 		sizeof(WORD) + sizeof(WORD) + sizeof(building::TLand) * m_vec_kLandTable.size() +
-		sizeof(WORD) + sizeof(WORD) + sizeof(building::TObjectProto) * m_vec_kObjectProto.size() + 
 		sizeof(WORD) + sizeof(WORD) + sizeof(building::TObject) * m_map_pkObjectTable.size() +
 		sizeof(time_t) + 
 		sizeof(WORD) + sizeof(WORD) + sizeof(TItemIDRangeTable)*2 +
@@ -259,9 +296,17 @@ void CClientManager::QUERY_BOOT(CPeer* peer, TPacketGDBoot * p)
 		//END_ADMIN_MANAGER
 		sizeof(WORD); 
 
-	peer->EncodeHeader(HEADER_DG_BOOT, 0, dwPacketSize);
-	peer->Encode(&dwPacketSize, sizeof(DWORD));
-	peer->Encode(&bPacketVersion, sizeof(BYTE));
+	// Ʈ Ŷ ü  ۿ     ڸ ٷ .
+	char * pcBegin = (char *) peer->EncodePacket(HEADER_DG_BOOT, 0, dwPacketSize);
+
+	if (!pcBegin)
+		return;
+
+	char * pc = pcBegin;
+
+	thecore_memcpy(pc, &dwPacketSize, sizeof(DWORD));
+	pc += sizeof(DWORD);
+	*pc++ = bPacketVersion;
 
 	sys_log(0, "BOOT: PACKET: %d", dwPacketSize);
 	sys_log(0, "BOOT: VERSION: %d", bPacketVersion);
@@ -281,89 +326,70 @@ void CClientManager::QUERY_BOOT(CPeer* peer, TPacketGDBoot * p)
 	sys_log(0, "sizeof(tAdminInfo) = %d * %d ", sizeof(tAdminInfo) * vAdmin.size());
 	//END_ADMIN_MANAGER
 
-	peer->EncodeWORD(sizeof(TMobTable));
-	peer->EncodeWORD(m_vec_mobTable.size());
-	peer->Encode(&m_vec_mobTable[0], sizeof(TMobTable) * m_vec_mobTable.size());
-
-	peer->EncodeWORD(sizeof(TItemTable));
-	peer->EncodeWORD(m_vec_itemTable.size());
-	peer->Encode(&m_vec_itemTable[0], sizeof(TItemTable) * m_vec_itemTable.size());
+	//  ̺ BuildBootTableCache  ̸    ״ δ.
+	DWORD dwCompSize = m_vec_bootTableCache.size();
 
-	peer->EncodeWORD(sizeof(TShopTable));
-	peer->EncodeWORD(m_iShopTableSize);
-	peer->Encode(m_pShopTable, sizeof(TShopTable) * m_iShopTableSize);
+	thecore_memcpy(pc, &m_dwBootTableRawSize, sizeof(DWORD));
+	pc += sizeof(DWORD);
+	thecore_memcpy(pc, &dwCompSize, sizeof(DWORD));
+	pc += sizeof(DWORD);
 
-	peer->EncodeWORD(sizeof(TSkillTable));
-	peer->EncodeWORD(m_vec_skillTable.size());
-	peer->Encode(&m_vec_skillTable[0], sizeof(TSkillTable) * m_vec_skillTable.size());
-
-	peer->EncodeWORD(sizeof(TRefineTable));
-	peer->EncodeWORD(m_iRefineTableSize);
-	peer->Encode(m_pRefineTable, sizeof(TRefineTable) * m_iRefineTableSize);
-
-	peer->EncodeWORD(sizeof(TItemAttrTable));
-	peer->EncodeWORD(m_vec_itemAttrTable.size());
-	peer->Encode(&m_vec_itemAttrTable[0], sizeof(TItemAttrTable) * m_vec_itemAttrTable.size());
-
-	peer->EncodeWORD(sizeof(TItemAttrTable));
-	peer->EncodeWORD(m_vec_itemRareTable.size());
-	peer->Encode(&m_vec_itemRareTable[0], sizeof(TItemAttrTable) * m_vec_itemRareTable.size());
-
-	peer->EncodeWORD(sizeof(TBanwordTable));
-	peer->EncodeWORD(m_vec_banwordTable.size());
-	peer->Encode(&m_vec_banwordTable[0], sizeof(TBanwordTable) * m_vec_banwordTable.size());
-
-	peer->EncodeWORD(sizeof(building::TLand));
-	peer->EncodeWORD(m_vec_kLandTable.size());
-	peer->Encode(&m_vec_kLandTable[0], sizeof(building::TLand) * m_vec_kLandTable.size());
+	if (dwCompSize)
+	{
+		thecore_memcpy(pc, &m_vec_bootTableCache[0], dwCompSize);
+		pc += dwCompSize;
+	}
 
-	peer->EncodeWORD(sizeof(building::TObjectProto));
-	peer->EncodeWORD(m_vec_kObjectProto.size());
-	peer->Encode(&m_vec_kObjectProto[0], sizeof(building::TObjectProto) * m_vec_kObjectProto.size());
+	pc = EncodeBootTable(pc, sizeof(building::TLand), m_vec_kLandTable.size(), m_vec_kLandTable.empty() ? NULL : &m_vec_kLandTable[0]);
 
-	peer->EncodeWORD(sizeof(building::TObject));
-	peer->EncodeWORD(m_map_pkObjectTable.size());
+	// Ʈ map   Ƿ   ϳ Ѵ.
+	pc = EncodeBootTableHeader(pc, sizeof(building::TObject), m_map_pkObjectTable.size());
 
 	itertype(m_map_pkObjectTable) it = m_map_pkObjectTable.begin();
 
 	while (it != m_map_pkObjectTable.end())
-		peer->Encode((it++)->second, sizeof(building::TObject));
+	{
+		thecore_memcpy(pc, (it++)->second, sizeof(building::TObject));
+		pc += sizeof(building::TObject);
+	}
 
 	time_t now = time(0);
-	peer->Encode(&now, sizeof(time_t));
+	thecore_memcpy(pc, &now, sizeof(time_t));
+	pc += sizeof(time_t);
 
 	TItemIDRangeTable itemRange = CItemIDRangeManager::instance().GetRange();
 	TItemIDRangeTable itemRangeSpare = CItemIDRangeManager::instance().GetRange();
 
-	peer->EncodeWORD(sizeof(TItemIDRangeTable));
-	peer->EncodeWORD(1);
-	peer->Encode(&itemRange, sizeof(TItemIDRangeTable));
-	peer->Encode(&itemRangeSpare, sizeof(TItemIDRangeTable));
+	pc = EncodeBootTable(pc, sizeof(TItemIDRangeTable), 1, &itemRange);
+	thecore_memcpy(pc, &itemRangeSpare, sizeof(TItemIDRangeTable));
+	pc += sizeof(TItemIDRangeTable);
 
 	peer->SetItemIDRange(itemRange);
 	peer->SetSpareItemIDRange(itemRangeSpare);
 
 	//ADMIN_MANAGER
-	peer->EncodeWORD(16);
-	peer->EncodeWORD(vHost.size());
+	pc = EncodeBootTableHeader(pc, 16, vHost.size());
 
 	for (size_t n = 0; n < vHost.size(); ++n)
 	{
-		peer->Encode(vHost[n].c_str(), 16);
+		memset(pc, 0, 16);
+		strlcpy(pc, vHost[n].c_str(), 16);
+		pc += 16;
 		sys_log(0, "GMHosts %s", vHost[n].c_str());
 	}
 
-	peer->EncodeWORD(sizeof(tAdminInfo));
-	peer->EncodeWORD(vAdmin.size());
+	pc = EncodeBootTable(pc, sizeof(tAdminInfo), vAdmin.size(), vAdmin.empty() ? NULL : &vAdmin[0]);
 
 	for (size_t n = 0; n < vAdmin.size(); ++n)
-	{
-		peer->Encode(&vAdmin[n], sizeof(tAdminInfo));
 		sys_log(0, "Admin name %s ConntactIP %s", vAdmin[n].m_szName, vAdmin[n].m_szContactIP);
-	}
 	//END_ADMIN_MANAGER
 
-	peer->EncodeWORD(0xffff);
+	WORD wEnd = 0xffff;
+	thecore_memcpy(pc, &wEnd, sizeof(WORD));
+	pc += sizeof(WORD);
+
+	if ((DWORD) (pc - pcBegin) != dwPacketSize)
+		sys_err("BOOT: packet size mismatch written %d expected %u", (int) (pc - pcBegin), dwPacketSize);
 }
 
 void CClientManager::SendPartyOnSetup(CPeer* pkPeer)
@@ -395,6 +421,7 @@ void CClientManager::SendPartyOnSetup(CPeer* pkPeer)
 void CClientManager::QUERY_PLAYER_COUNT(CPeer * pkPeer, TPlayerCountPacket * pPacket)
 {
 	pkPeer->SetUserCount(pPacket->dwCount);
+	pkPeer->SetEmpireUserCount(pPacket->adwEmpireCount);
 }
 
 void CClientManager::QUERY_QUEST_SAVE(CPeer * pkPeer, TQuestTable * pTable, DWORD dwLen)
@@ -407,24 +434,27 @@ void CClientManager::QUERY_QUEST_SAVE(CPeer * pkPeer, TQuestTable * pTable, DWOR
 
 	int iSize = dwLen / sizeof(TQuestTable);
 
-	char szQuery[1024];
+	char szDeleteQuery[256];
+	char szReplaceQuery[256];
+
+	snprintf(szDeleteQuery, sizeof(szDeleteQuery),
+			"DELETE FROM quest%s WHERE dwPID=? AND szName=? AND szState=?", GetTablePostfix());
+	snprintf(szReplaceQuery, sizeof(szReplaceQuery),
+			"REPLACE INTO quest%s (dwPID, szName, szState, lValue) VALUES(?, ?, ?, ?)", GetTablePostfix());
+
+	CStmtQuery kQuery;
 
 	for (int i = 0; i < iSize; ++i, ++pTable)
 	{
-		if (pTable->lValue == 0)
-		{
-			snprintf(szQuery, sizeof(szQuery),
-					"DELETE FROM quest%s WHERE dwPID=%d AND szName='%s' AND szState='%s'",
-					GetTablePostfix(), pTable->dwPID, pTable->szName, pTable->szState);
-		}
-		else
-		{
-			snprintf(szQuery, sizeof(szQuery),
-					"REPLACE INTO quest%s (dwPID, szName, szState, lValue) VALUES(%d, '%s', '%s', %ld)",
-					GetTablePostfix(), pTable->dwPID, pTable->szName, pTable->szState, pTable->lValue);
-		}
+		kQuery.SetQuery(pTable->lValue == 0 ? szDeleteQuery : szReplaceQuery);
+		kQuery.BindUnsigned(pTable->dwPID);
+		kQuery.BindString(pTable->szName);
+		kQuery.BindString(pTable->szState);
+
+		if (pTable->lValue != 0)
+			kQuery.BindSigned(pTable->lValue);
 
-		CDBManager::instance().ReturnQuery(szQuery, QID_QUEST_SAVE, pkPeer->GetHandle(), NULL);
+		CDBManager::instance().ReturnStmt(kQuery, QID_QUEST_SAVE, pkPeer->GetHandle(), NULL, SQL_PLAYER, pTable->dwPID);
 	}
 }
 
@@ -437,6 +467,51 @@ void CClientManager::QUERY_SAFEBOX_LOAD(CPeer * pkPeer, DWORD dwHandle, TSafebox
 	pi->ip[0] = bMall ? 1 : 0;
 	strlcpy(pi->login, packet->szLogin, sizeof(pi->login));
 
+	FlushGroupCommit();
+
+	if (!bMall)
+	{
+		TSafeboxCacheMap::iterator it = m_map_safeboxCache.find(packet->dwID);
+
+		if (it != m_map_safeboxCache.end())
+		{
+			TSafeboxCache & r = it->second;
+			r.time = time(0);
+
+			// RESULT_SAFEBOX_LOAD   йȣ ˻
+			if ((!*r.szPassword && strcmp("000000", pi->safebox_password)) ||
+				(*r.szPassword && strcmp(r.szPassword, pi->safebox_password)))
+			{
+				pkPeer->EncodeHeader(HEADER_DG_SAFEBOX_WRONG_PASSWORD, dwHandle, 0);
+				delete pi;
+				return;
+			}
+
+			pi->pSafebox = new TSafeboxTable;
+			thecore_memcpy(pi->pSafebox, &r.table, sizeof(TSafeboxTable));
+
+			static std::vector<TPlayerItem> s_items;
+			s_items.clear();
+
+			for (itertype(r.map_item) it2 = r.map_item.begin(); it2 != r.map_item.end(); ++it2)
+				s_items.push_back(it2->second);
+
+			size_t sizeCached = s_items.size();
+
+			if (g_log)
+				sys_log(0, "HEADER_GD_SAFEBOX_LOAD (handle: %d account.id %u) from cache, %u items", dwHandle, packet->dwID, sizeCached);
+
+			SendSafeboxLoad(pkPeer, pi, s_items);
+
+			//    
+			for (size_t i = sizeCached; i < s_items.size(); ++i)
+				PutSafeboxCacheItem(&s_items[i]);
+
+			delete pi;
+			return;
+		}
+	}
+
 	char szQuery[QUERY_MAX_LEN];
 	snprintf(szQuery, sizeof(szQuery),
 			"SELECT account_id, size, password FROM safebox%s WHERE account_id=%u",
@@ -467,6 +542,7 @@ void CClientManager::RESULT_SAFEBOX_LOAD(CPeer * pkPeer, SQLMsg * msg)
 		memset(pSafebox, 0, sizeof(TSafeboxTable));
 
 		SQLResult * res = msg->Get();
+		const char * c_szRowPassword = "";
 
 		if (res->uiNumRows == 0)
 		{
@@ -490,6 +566,9 @@ void CClientManager::RESULT_SAFEBOX_LOAD(CPeer * pkPeer, SQLMsg * msg)
 				return;
 			}
 
+			if (row[2])
+				c_szRowPassword = row[2];
+
 			if (!row[0])
 				pSafebox->dwID = 0;
 			else
@@ -519,6 +598,18 @@ void CClientManager::RESULT_SAFEBOX_LOAD(CPeer * pkPeer, SQLMsg * msg)
 
 		pi->pSafebox = pSafebox;
 
+		// ۱  ĳÿ ִ´.   â ٲ  ĳ ʴ´.
+		if (pi->ip[0] == 0 && g_iSafeboxCacheSeconds > 0)
+		{
+			TSafeboxCache & r = m_map_safeboxLoading[pi->account_id];
+
+			r.table = *pSafebox;
+			r.bExist = res->uiNumRows != 0;
+			strlcpy(r.szPassword, c_szRowPassword, sizeof(r.szPassword));
+			r.map_item.clear();
+			r.time = time(0);
+		}
+
 		char szQuery[512];
 		snprintf(szQuery, sizeof(szQuery), 
 				"SELECT id, window+0, pos, count, vnum, socket0, socket1, socket2, "
@@ -534,7 +625,8 @@ void CClientManager::RESULT_SAFEBOX_LOAD(CPeer * pkPeer, SQLMsg * msg)
 
 		pi->account_index = 1;
 
-		CDBManager::instance().ReturnQuery(szQuery, QID_SAFEBOX_LOAD, pkPeer->GetHandle(), pi);
+		//   item id  ٸ  Ƿ ռ  Ⱑ   ڿ д´.
+		CDBManager::instance().ReturnQuery(szQuery, QID_SAFEBOX_LOAD, pkPeer->GetHandle(), pi, SQL_PLAYER, 0, true);
 	}
 	else
 	{
@@ -559,216 +651,330 @@ void CClientManager::RESULT_SAFEBOX_LOAD(CPeer * pkPeer, SQLMsg * msg)
 		static std::vector<TPlayerItem> s_items;
 		CreateItemTableFromRes(msg->Get()->pSQLResult, &s_items, pi->account_id);
 
-		std::set<TItemAward *> * pSet = ItemAwardManager::instance().GetByLogin(pi->login);
+		SendSafeboxLoad(pkPeer, pi, s_items);
 
-		if (pSet && !m_vec_itemTable.empty())
-		{
+		if (pi->ip[0] == 0)
+			PutSafeboxCache(pi->account_id, s_items);
 
-			CGrid grid(5, MAX(1, pi->pSafebox->bSize) * 9);
-			bool bEscape = false;
+		delete pi;
+	}
+}
 
-			for (DWORD i = 0; i < s_items.size(); ++i)
-			{
-				TPlayerItem & r = s_items[i];
+void CClientManager::SendSafeboxLoad(CPeer * pkPeer, ClientHandleInfo * pi, std::vector<TPlayerItem> & s_items)
+{
+	DWORD dwHandle = pi->dwHandle;
 
-				itertype(m_map_itemTableByVnum) it = m_map_itemTableByVnum.find(r.vnum);
+	std::set<TItemAward *> * pSet = ItemAwardManager::instance().GetByLogin(pi->login);
 
-				if (it == m_map_itemTableByVnum.end())
-				{
-					bEscape = true;
-					sys_err("invalid item vnum %u in safebox: login %s", r.vnum, pi->login);
-					break;
-				}
+	if (pSet && !m_vec_itemTable.empty())
+	{
 
-				grid.Put(r.pos, 1, it->second->bSize);
-			}
+		CGrid grid(5, MAX(1, pi->pSafebox->bSize) * 9);
+		bool bEscape = false;
+
+		for (DWORD i = 0; i < s_items.size(); ++i)
+		{
+			TPlayerItem & r = s_items[i];
 
-			if (!bEscape)
+			itertype(m_map_itemTableByVnum) it = m_map_itemTableByVnum.find(r.vnum);
+
+			if (it == m_map_itemTableByVnum.end())
 			{
-				std::vector<std::pair<DWORD, DWORD> > vec_dwFinishedAwardID;
+				bEscape = true;
+				sys_err("invalid item vnum %u in safebox: login %s", r.vnum, pi->login);
+				break;
+			}
 
-				typeof(pSet->begin()) it = pSet->begin();
+			grid.Put(r.pos, 1, it->second->bSize);
+		}
 
-				char szQuery[512];
+		if (!bEscape)
+		{
+			std::vector<std::pair<DWORD, DWORD> > vec_dwFinishedAwardID;
 
-				while (it != pSet->end())
-				{
-					TItemAward * pItemAward = *(it++);
-					const DWORD& dwItemVnum = pItemAward->dwVnum;
+			typeof(pSet->begin()) it = pSet->begin();
 
-					if (pItemAward->bTaken)
-						continue;
+			char szQuery[512];
 
-					if (pi->ip[0] == 0 && pItemAward->bMall)
-						continue;
+			while (it != pSet->end())
+			{
+				TItemAward * pItemAward = *(it++);
+				const DWORD& dwItemVnum = pItemAward->dwVnum;
 
-					if (pi->ip[0] == 1 && !pItemAward->bMall)
-						continue;
+				if (pItemAward->bTaken)
+					continue;
 
-					itertype(m_map_itemTableByVnum) it = m_map_itemTableByVnum.find(pItemAward->dwVnum);
+				if (pi->ip[0] == 0 && pItemAward->bMall)
+					continue;
 
-					if (it == m_map_itemTableByVnum.end())
-					{
-						sys_err("invalid item vnum %u in item_award: login %s", pItemAward->dwVnum, pi->login);
-						continue;
-					}
+				if (pi->ip[0] == 1 && !pItemAward->bMall)
+					continue;
 
-					TItemTable * pItemTable = it->second;
+				itertype(m_map_itemTableByVnum) it = m_map_itemTableByVnum.find(pItemAward->dwVnum);
 
-					int iPos;
+				if (it == m_map_itemTableByVnum.end())
+				{
+					sys_err("invalid item vnum %u in item_award: login %s", pItemAward->dwVnum, pi->login);
+					continue;
+				}
 
-					if ((iPos = grid.FindBlank(1, it->second->bSize)) == -1)
-						break;
+				TItemTable * pItemTable = it->second;
+
+				int iPos;
 
-					TPlayerItem item;
-					memset(&item, 0, sizeof(TPlayerItem));
+				if ((iPos = grid.FindBlank(1, it->second->bSize)) == -1)
+					break;
 
-					DWORD dwSocket2 = 0;
+				TPlayerItem item;
+				memset(&item, 0, sizeof(TPlayerItem));
 
-					if (pItemTable->bType == ITEM_UNIQUE)
-					{
-						if (pItemAward->dwSocket2 != 0)
-							dwSocket2 = pItemAward->dwSocket2;
-						else
-							dwSocket2 = pItemTable->alValues[0];
-					}
-					else if ((dwItemVnum == 50300 || dwItemVnum == 70037) && pItemAward->dwSocket0 == 0)
+				DWORD dwSocket2 = 0;
+
+				if (pItemTable->bType == ITEM_UNIQUE)
+				{
+					if (pItemAward->dwSocket2 != 0)
+						dwSocket2 = pItemAward->dwSocket2;
+					else
+						dwSocket2 = pItemTable->alValues[0];
+				}
+				else if ((dwItemVnum == 50300 || dwItemVnum == 70037) && pItemAward->dwSocket0 == 0)
+				{
+					DWORD dwSkillIdx;
+					DWORD dwSkillVnum;
+
+					do
 					{
-						DWORD dwSkillIdx;
-						DWORD dwSkillVnum;
+						dwSkillIdx = number(0, m_vec_skillTable.size()-1);
 
-						do
-						{
-							dwSkillIdx = number(0, m_vec_skillTable.size()-1);
+						dwSkillVnum = m_vec_skillTable[dwSkillIdx].dwVnum;
 
-							dwSkillVnum = m_vec_skillTable[dwSkillIdx].dwVnum;
+						if (!dwSkillVnum > 120)
+							continue;
 
-							if (!dwSkillVnum > 120)
-								continue;
+						break;
+					} while (1);
 
+					pItemAward->dwSocket0 = dwSkillVnum;
+				}
+				else
+				{
+					switch (dwItemVnum)
+					{
+						case 72723: case 72724: case 72725: case 72726:
+						case 72727: case 72728: case 72729: case 72730:
+						// ù  ϴ  ġ ...
+						// ׷ ׳ ϵ ڵ.  ڿ ڵ ۵.
+						case 76004: case 76005: case 76021: case 76022:
+						case 79012: case 79013:
+							if (pItemAward->dwSocket2 == 0)
+							{
+								dwSocket2 = pItemTable->alValues[0];
+							}
+							else
+							{
+								dwSocket2 = pItemAward->dwSocket2;
+							}
 							break;
-						} while (1);
-
-						pItemAward->dwSocket0 = dwSkillVnum;
 					}
-					else
+				}
+
+				if (GetItemID () > m_itemRange.dwMax)
+				{
+					sys_err("UNIQUE ID OVERFLOW!!");
+					break;
+				}
+
+				{
+					itertype(m_map_itemTableByVnum) it = m_map_itemTableByVnum.find (dwItemVnum);
+					if (it == m_map_itemTableByVnum.end())
 					{
-						switch (dwItemVnum)
-						{
-							case 72723: case 72724: case 72725: case 72726:
-							case 72727: case 72728: case 72729: case 72730:
-							// ù  ϴ  ġ ...
-							// ׷ ׳ ϵ ڵ.  ڿ ڵ ۵.
-							case 76004: case 76005: case 76021: case 76022:
-							case 79012: case 79013:
-								if (pItemAward->dwSocket2 == 0)
-								{
-									dwSocket2 = pItemTable->alValues[0];
-								}
-								else
-								{
-									dwSocket2 = pItemAward->dwSocket2;
-								}
-								break;
-						}
+						sys_err ("Invalid item(vnum : %d). It is not in m_map_itemTableByVnum.", dwItemVnum);
+						continue;
 					}
-
-					if (GetItemID () > m_itemRange.dwMax)
+					TItemTable* item_table = it->second;
+					if (item_table == NULL)
 					{
-						sys_err("UNIQUE ID OVERFLOW!!");
-						break;
+						sys_err ("Invalid item_table (vnum : %d). It's value is NULL in m_map_itemTableByVnum.", dwItemVnum);
+						continue;
 					}
-
+					if (0 == pItemAward->dwSocket0)
 					{
-						itertype(m_map_itemTableByVnum) it = m_map_itemTableByVnum.find (dwItemVnum);
-						if (it == m_map_itemTableByVnum.end())
+						for (int i = 0; i < ITEM_LIMIT_MAX_NUM; i++)
 						{
-							sys_err ("Invalid item(vnum : %d). It is not in m_map_itemTableByVnum.", dwItemVnum);
-							continue;
-						}
-						TItemTable* item_table = it->second;
-						if (item_table == NULL)
-						{
-							sys_err ("Invalid item_table (vnum : %d). It's value is NULL in m_map_itemTableByVnum.", dwItemVnum);
-							continue;
-						}
-						if (0 == pItemAward->dwSocket0)
-						{
-							for (int i = 0; i < ITEM_LIMIT_MAX_NUM; i++)
+							if (LIMIT_REAL_TIME == item_table->aLimits[i].bType)
 							{
-								if (LIMIT_REAL_TIME == item_table->aLimits[i].bType)
-								{
-									if (0 == item_table->aLimits[i].lValue)
-										pItemAward->dwSocket0 = time(0) + 60 * 60 * 24 * 7;
-									else
-										pItemAward->dwSocket0 = time(0) + item_table->aLimits[i].lValue;
-
-									break;
-								}
-								else if (LIMIT_REAL_TIME_START_FIRST_USE == item_table->aLimits[i].bType || LIMIT_TIMER_BASED_ON_WEAR == item_table->aLimits[i].bType)
-								{
-									if (0 == item_table->aLimits[i].lValue)
-										pItemAward->dwSocket0 = 60 * 60 * 24 * 7;
-									else
-										pItemAward->dwSocket0 = item_table->aLimits[i].lValue;
-
-									break;
-								}
+								if (0 == item_table->aLimits[i].lValue)
+									pItemAward->dwSocket0 = time(0) + 60 * 60 * 24 * 7;
+								else
+									pItemAward->dwSocket0 = time(0) + item_table->aLimits[i].lValue;
+
+								break;
 							}
-						}
+							else if (LIMIT_REAL_TIME_START_FIRST_USE == item_table->aLimits[i].bType || LIMIT_TIMER_BASED_ON_WEAR == item_table->aLimits[i].bType)
+							{
+								if (0 == item_table->aLimits[i].lValue)
+									pItemAward->dwSocket0 = 60 * 60 * 24 * 7;
+								else
+									pItemAward->dwSocket0 = item_table->aLimits[i].lValue;
 
-						snprintf(szQuery, sizeof(szQuery), 
-								"INSERT INTO item%s (id, owner_id, window, pos, vnum, count, socket0, socket1, socket2) "
-								"VALUES(%u, %u, '%s', %d, %u, %u, %u, %u, %u)",
-								GetTablePostfix(),
-								GainItemID(),
-								pi->account_id,
-								pi->ip[0] == 0 ? "SAFEBOX" : "MALL",
-								iPos,
-								pItemAward->dwVnum, pItemAward->dwCount, pItemAward->dwSocket0, pItemAward->dwSocket1, dwSocket2);
+								break;
+							}
+						}
 					}
 
-					std::unique_ptr<SQLMsg> pmsg(CDBManager::instance().DirectQuery(szQuery));
-					SQLResult * pRes = pmsg->Get();
-					sys_log(0, "SAFEBOX Query : [%s]", szQuery);
+					snprintf(szQuery, sizeof(szQuery), 
+							"INSERT INTO item%s (id, owner_id, window, pos, vnum, count, socket0, socket1, socket2) "
+							"VALUES(%u, %u, '%s', %d, %u, %u, %u, %u, %u)",
+							GetTablePostfix(),
+							GainItemID(),
+							pi->account_id,
+							pi->ip[0] == 0 ? "SAFEBOX" : "MALL",
+							iPos,
+							pItemAward->dwVnum, pItemAward->dwCount, pItemAward->dwSocket0, pItemAward->dwSocket1, dwSocket2);
+				}
 
-					if (pRes->uiAffectedRows == 0 || pRes->uiInsertID == 0 || pRes->uiAffectedRows == (uint32_t)-1)
-						break;
+				std::unique_ptr<SQLMsg> pmsg(CDBManager::instance().DirectQuery(szQuery));
+				SQLResult * pRes = pmsg->Get();
+				sys_log(0, "SAFEBOX Query : [%s]", szQuery);
 
-					item.id = pmsg->Get()->uiInsertID;
-					item.window = pi->ip[0] == 0 ? SAFEBOX : MALL,
-					item.pos = iPos;
-					item.count = pItemAward->dwCount;
-					item.vnum = pItemAward->dwVnum;
-					item.alSockets[0] = pItemAward->dwSocket0;
-					item.alSockets[1] = pItemAward->dwSocket1;
-					item.alSockets[2] = dwSocket2;
-					s_items.push_back(item);
-
-					vec_dwFinishedAwardID.push_back(std::make_pair(pItemAward->dwID, item.id));
-					grid.Put(iPos, 1, it->second->bSize);
-				}
+				if (pRes->uiAffectedRows == 0 || pRes->uiInsertID == 0 || pRes->uiAffectedRows == (uint32_t)-1)
+					break;
 
-				for (DWORD i = 0; i < vec_dwFinishedAwardID.size(); ++i)
-					ItemAwardManager::instance().Taken(vec_dwFinishedAwardID[i].first, vec_dwFinishedAwardID[i].second);
+				item.id = pmsg->Get()->uiInsertID;
+				item.owner = pi->account_id;	// DB   Ͱ  ؾ ĳÿ ´
+				item.window = pi->ip[0] == 0 ? SAFEBOX : MALL,
+				item.pos = iPos;
+				item.count = pItemAward->dwCount;
+				item.vnum = pItemAward->dwVnum;
+				item.alSockets[0] = pItemAward->dwSocket0;
+				item.alSockets[1] = pItemAward->dwSocket1;
+				item.alSockets[2] = dwSocket2;
+				s_items.push_back(item);
+
+				vec_dwFinishedAwardID.push_back(std::make_pair(pItemAward->dwID, item.id));
+				grid.Put(iPos, 1, it->second->bSize);
 			}
+
+			for (DWORD i = 0; i < vec_dwFinishedAwardID.size(); ++i)
+				ItemAwardManager::instance().Taken(vec_dwFinishedAwardID[i].first, vec_dwFinishedAwardID[i].second);
 		}
+	}
 
-		pi->pSafebox->wItemCount = s_items.size();
+	pi->pSafebox->wItemCount = s_items.size();
 
-		pkPeer->EncodeHeader(pi->ip[0] == 0 ? HEADER_DG_SAFEBOX_LOAD : HEADER_DG_MALL_LOAD, dwHandle, sizeof(TSafeboxTable) + sizeof(TPlayerItem) * s_items.size());
+	pkPeer->EncodeHeader(pi->ip[0] == 0 ? HEADER_DG_SAFEBOX_LOAD : HEADER_DG_MALL_LOAD, dwHandle, sizeof(TSafeboxTable) + sizeof(TPlayerItem) * s_items.size());
 
-		pkPeer->Encode(pi->pSafebox, sizeof(TSafeboxTable));
+	pkPeer->Encode(pi->pSafebox, sizeof(TSafeboxTable));
 
-		if (!s_items.empty())
-			pkPeer->Encode(&s_items[0], sizeof(TPlayerItem) * s_items.size());
+	if (!s_items.empty())
+		pkPeer->Encode(&s_items[0], sizeof(TPlayerItem) * s_items.size());
+}
 
-		delete pi;
+void CClientManager::PutSafeboxCache(DWORD dwAccountID, const std::vector<TPlayerItem> & c_rVec)
+{
+	TSafeboxCacheMap::iterator it = m_map_safeboxLoading.find(dwAccountID);
+
+	if (it == m_map_safeboxLoading.end())
+		return;
+
+	//   бⰡ ̹ ĳ    ݿǾ Ƿ ״ д.
+	if (m_map_safeboxCache.find(dwAccountID) == m_map_safeboxCache.end())
+	{
+		TSafeboxCache & r = m_map_safeboxCache[dwAccountID];
+		r = it->second;
+		r.time = time(0);
+
+		for (DWORD i = 0; i < c_rVec.size(); ++i)
+		{
+			r.map_item[c_rVec[i].id] = c_rVec[i];
+			m_map_safeboxItemOwner[c_rVec[i].id] = dwAccountID;
+		}
+	}
+
+	m_map_safeboxLoading.erase(it);
+}
+
+void CClientManager::PutSafeboxCacheItem(const TPlayerItem * p)
+{
+	boost::unordered_map<DWORD, DWORD>::iterator it_owner = m_map_safeboxItemOwner.find(p->id);
+
+	if (it_owner != m_map_safeboxItemOwner.end() && it_owner->second != p->owner)
+		RemoveSafeboxCacheItem(p->id);
+
+	TSafeboxCacheMap::iterator it = m_map_safeboxCache.find(p->owner);
+
+	if (it == m_map_safeboxCache.end())
+	{
+		m_map_safeboxLoading.erase(p->owner);
+		return;
+	}
+
+	it->second.map_item[p->id] = *p;
+	it->second.time = time(0);
+	m_map_safeboxItemOwner[p->id] = p->owner;
+}
+
+void CClientManager::RemoveSafeboxCacheItem(DWORD dwItemID)
+{
+	boost::unordered_map<DWORD, DWORD>::iterator it_owner = m_map_safeboxItemOwner.find(dwItemID);
+
+	if (it_owner == m_map_safeboxItemOwner.end())
+		return;
+
+	TSafeboxCacheMap::iterator it = m_map_safeboxCache.find(it_owner->second);
+
+	if (it != m_map_safeboxCache.end())
+	{
+		it->second.map_item.erase(dwItemID);
+		it->second.time = time(0);
+	}
+
+	m_map_safeboxItemOwner.erase(it_owner);
+}
+
+void CClientManager::DropSafeboxCache(DWORD dwAccountID)
+{
+	m_map_safeboxLoading.erase(dwAccountID);
+
+	TSafeboxCacheMap::iterator it = m_map_safeboxCache.find(dwAccountID);
+
+	if (it == m_map_safeboxCache.end())
+		return;
+
+	for (itertype(it->second.map_item) it2 = it->second.map_item.begin(); it2 != it->second.map_item.end(); ++it2)
+		m_map_safeboxItemOwner.erase(it2->first);
+
+	m_map_safeboxCache.erase(it);
+}
+
+void CClientManager::UpdateSafeboxCache()
+{
+	time_t tNow = time(0);
+
+	std::vector<DWORD> vec_dwExpired;
+
+	for (TSafeboxCacheMap::iterator it = m_map_safeboxCache.begin(); it != m_map_safeboxCache.end(); ++it)
+		if (tNow - it->second.time > g_iSafeboxCacheSeconds)
+			vec_dwExpired.push_back(it->first);
+
+	for (DWORD i = 0; i < vec_dwExpired.size(); ++i)
+		DropSafeboxCache(vec_dwExpired[i]);
+
+	TSafeboxCacheMap::iterator it = m_map_safeboxLoading.begin();
+
+	while (it != m_map_safeboxLoading.end())
+	{
+		if (tNow - it->second.time > 60)
+			it = m_map_safeboxLoading.erase(it);
+		else
+			++it;
 	}
 }
 
 void CClientManager::QUERY_SAFEBOX_CHANGE_SIZE(CPeer * pkPeer, DWORD dwHandle, TSafeboxChangeSizePacket * p)
 {
+	DropSafeboxCache(p->dwID);
+
 	ClientHandleInfo * pi = new ClientHandleInfo(dwHandle);
 	pi->account_index = p->bSize;	// account_index  ӽ÷ 
 
@@ -805,6 +1011,8 @@ void CClientManager::QUERY_SAFEBOX_CHANGE_PASSWORD(CPeer * pkPeer, DWORD dwHandl
 	strlcpy(pi->login, p->szOldPassword, sizeof(pi->login));
 	pi->account_id = p->dwID;
 
+	DropSafeboxCache(p->dwID);
+
 	char szQuery[QUERY_MAX_LEN];
 	snprintf(szQuery, sizeof(szQuery), "SELECT password FROM safebox%s WHERE account_id=%u", GetTablePostfix(), p->dwID);
 
@@ -920,7 +1128,9 @@ void CClientManager::RESULT_PRICELIST_LOAD_FOR_UPDATE(SQLMsg* pMsg)
 	PutItemPriceListCache(&table);
 
 	// Update cache
-	GetItemPriceListCache(pUpdateTable->dwOwnerID)->UpdateList(pUpdateTable);
+	CItemPriceListTableCache * pCache = GetItemPriceListCache(pUpdateTable->dwOwnerID);
+	pCache->UpdateList(pUpdateTable);
+	QueueItemPriceListCache(pCache);
 
 	delete pUpdateTable;
 }
@@ -995,6 +1205,7 @@ void CClientManager::QUERY_EMPIRE_SELECT(CPeer * pkPeer, DWORD dwHandle, TEmpire
 							pids[i]);
 
 					std::unique_ptr<SQLMsg> pmsg2(CDBManager::instance().DirectQuery(szQuery));
+					DropPlayerPrefetch(pids[i]);
 				}
 			}
 		}
@@ -1230,43 +1441,20 @@ void CClientManager::QUERY_ITEM_SAVE(CPeer * pkPeer, const char * c_pData)
 
 			delete c;
 		}
-		char szQuery[512];
 
-		snprintf(szQuery, sizeof(szQuery), 
-			"REPLACE INTO item%s (id, owner_id, window, pos, count, vnum, socket0, socket1, socket2, "
-			"attrtype0, attrvalue0, "
-			"attrtype1, attrvalue1, "
-			"attrtype2, attrvalue2, "
-			"attrtype3, attrvalue3, "
-			"attrtype4, attrvalue4, "
-			"attrtype5, attrvalue5, "
-			"attrtype6, attrvalue6) "
-			"VALUES(%u, %u, %d, %d, %u, %u, %ld, %ld, %ld, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d)",
-			GetTablePostfix(),
-			p->id,
-			p->owner,
-			p->window,
-			p->pos,
-			p->count,
-			p->vnum,
-			p->alSockets[0],
-			p->alSockets[1],
-			p->alSockets[2],
-			p->aAttr[0].bType, p->aAttr[0].sValue,
-			p->aAttr[1].bType, p->aAttr[1].sValue,
-			p->aAttr[2].bType, p->aAttr[2].sValue,
-			p->aAttr[3].bType, p->aAttr[3].sValue,
-			p->aAttr[4].bType, p->aAttr[4].sValue,
-			p->aAttr[5].bType, p->aAttr[5].sValue,
-			p->aAttr[6].bType, p->aAttr[6].sValue);
-
-		CDBManager::instance().ReturnQuery(szQuery, QID_ITEM_SAVE, pkPeer->GetHandle(), NULL);
+		if (p->window == SAFEBOX)
+			PutSafeboxCacheItem(p);
+		else
+			RemoveSafeboxCacheItem(p->id);
+
+		GroupCommitItem(p);
 	}
 	else
 	{
 		if (g_test_server)
 			sys_log(0, "QUERY_ITEM_SAVE => PutItemCache() owner %d id %d vnum %d ", p->owner, p->id, p->vnum);
 
+		RemoveSafeboxCacheItem(p->id);
 		PutItemCache(p);
 	}
 }
@@ -1306,15 +1494,19 @@ void CClientManager::FlushItemCacheSet(DWORD pid)
 	TItemCacheSet * pSet = it->second;
 	TItemCacheSet::iterator it_set = pSet->begin();
 
+	CItemSaveBatch kBatch;
+
 	while (it_set != pSet->end())
 	{
 		CItemCache * c = *it_set++;
-		c->Flush();
+		c->Flush(kBatch);
 
 		m_map_itemCache.erase(c->Get()->id);
 		delete c;
 	}
 
+	kBatch.Commit(true);
+
 	pSet->clear();
 	delete pSet;
 
@@ -1370,7 +1562,11 @@ void CClientManager::PutItemCache(TPlayerItem * pNew, bool bSkipQuery)
 	}
 
 	// ο  Ʈ 
+	if (!bSkipQuery)
+		CCacheJournal::instance().AppendItem(pNew);
+
 	c->Put(pNew, bSkipQuery);
+	QueueItemCache(c);
 	
 	TItemCacheSetPtrMap::iterator it = m_map_pkItemCacheSetPtr.find(c->Get()->owner);
 
@@ -1402,6 +1598,7 @@ bool CClientManager::DeleteItemCache(DWORD dwID)
 	if (!c)
 		return false;
 
+	CCacheJournal::instance().AppendItemDelete(dwID);
 	c->Delete();
 	return true;
 }
@@ -1430,13 +1627,153 @@ void CClientManager::PutItemPriceListCache(const TItemPriceListTable* pItemPrice
 	pCache->Put(const_cast<TItemPriceListTable*>(pItemPriceList), true);
 }
 
+void CClientManager::QueuePlayerCache(CPlayerTableCache * c)
+{
+	time_t tDue = c->GetTimeoutTime();
+	time_t tFlush = c->GetFlushTime();
+
+	if (tFlush && tFlush < tDue)
+		tDue = tFlush;
+
+	//  ̸ ð ̹   ׶ ٽ Ѵ.
+	if (c->GetQueuedTime() && c->GetQueuedTime() <= tDue)
+		return;
+
+	c->SetQueuedTime(m_kPlayerCacheQueue.Push(c->Get(false)->id, tDue));
+}
+
+void CClientManager::QueueItemCache(CItemCache * c)
+{
+	time_t tDue = c->GetFlushTime();
+
+	if (!tDue || (c->GetQueuedTime() && c->GetQueuedTime() <= tDue))
+		return;
+
+	c->SetQueuedTime(m_kItemCacheQueue.Push(c->Get(false)->id, tDue));
+}
+
+void CClientManager::QueueItemPriceListCache(CItemPriceListTableCache * c)
+{
+	time_t tDue = c->GetFlushTime();
+
+	if (!tDue || (c->GetQueuedTime() && c->GetQueuedTime() <= tDue))
+		return;
+
+	c->SetQueuedTime(m_kItemPriceListCacheQueue.Push(c->Get(false)->dwOwnerID, tDue));
+}
+
+void CClientManager::ReplayCacheJournal()
+{
+	struct FReplay
+	{
+		CClientManager & m_rkManager;
+
+		FReplay(CClientManager & rkManager) : m_rkManager(rkManager)
+		{
+		}
+
+		void operator () (BYTE bType, const char * c_pData, DWORD dwSize)
+		{
+			switch (bType)
+			{
+				case CCacheJournal::RECORD_PLAYER:
+					if (dwSize == sizeof(TPlayerTable))
+					{
+						TPlayerTable tab;
+						thecore_memcpy(&tab, c_pData, sizeof(TPlayerTable));
+						m_rkManager.PutPlayerCache(&tab);
+						return;
+					}
+					break;
+
+				case CCacheJournal::RECORD_ITEM:
+					if (dwSize == sizeof(TPlayerItem))
+					{
+						TPlayerItem item;
+						thecore_memcpy(&item, c_pData, sizeof(TPlayerItem));
+						m_rkManager.PutItemCache(&item);
+						return;
+					}
+					break;
+
+				case CCacheJournal::RECORD_ITEM_DELETE:
+					if (dwSize == sizeof(DWORD))
+					{
+						DWORD dwID;
+						thecore_memcpy(&dwID, c_pData, sizeof(DWORD));
+
+						if (!m_rkManager.DeleteItemCache(dwID))
+						{
+							CCacheJournal::instance().AppendItemDelete(dwID);
+
+							char szQuery[64];
+							snprintf(szQuery, sizeof(szQuery), "DELETE FROM item%s WHERE id=?", GetTablePostfix());
+
+							CStmtQuery kQuery(szQuery);
+							kQuery.BindUnsigned(dwID);
+							m_rkManager.FlushGroupCommitFor(dwID);
+							CDBManager::instance().ReturnStmt(kQuery, QID_ITEM_DESTROY, 0, NULL, SQL_PLAYER, dwID);
+						}
+						return;
+					}
+					break;
+			}
+
+			sys_err("CACHE_JOURNAL: unknown record type %u size %u", bType, dwSize);
+		}
+	};
+
+	FReplay f(*this);
+	CCacheJournal::instance().Replay(f);
+}
+
+//  üũƮ        θ.
+// ׷  ÷õ  ĳø  ο  ȴ.
+void CClientManager::CheckpointCacheJournal()
+{
+	CCacheJournal & rkJournal = CCacheJournal::instance();
+	DWORD dwPlayerCount = 0, dwItemCount = 0;
+
+	rkJournal.BeginCheckpoint();
+
+	for (itertype(m_map_playerCache) it = m_map_playerCache.begin(); it != m_map_playerCache.end(); ++it)
+	{
+		if (!it->second->GetFlushTime())
+			continue;
+
+		rkJournal.AppendPlayer(it->second->Get(false));
+		++dwPlayerCount;
+	}
+
+	for (itertype(m_map_itemCache) it = m_map_itemCache.begin(); it != m_map_itemCache.end(); ++it)
+	{
+		if (!it->second->GetFlushTime())
+			continue;
+
+		rkJournal.AppendItem(it->second->Get(false));
+		++dwItemCount;
+	}
+
+	rkJournal.EndCheckpoint();
+	sys_log(0, "CACHE_JOURNAL: checkpoint player %u item %u", dwPlayerCount, dwItemCount);
+}
+
 void CClientManager::UpdatePlayerCache()
 {
-	TPlayerTableCacheMap::iterator it = m_map_playerCache.begin();
+	time_t tNow = time(0);
+	DWORD dwID;
+	time_t tQueued;
 
-	while (it != m_map_playerCache.end())
+	while (m_kPlayerCacheQueue.Pop(tNow, dwID, tQueued))
 	{
-		CPlayerTableCache * c = (it++)->second;
+		TPlayerTableCacheMap::iterator it = m_map_playerCache.find(dwID);
+
+		// ų ٸ ð ٽ  ĳ
+		if (it == m_map_playerCache.end() || it->second->GetQueuedTime() != tQueued)
+			continue;
+
+		CPlayerTableCache * c = it->second;
+		c->SetQueuedTime(0);
 
 		if (c->CheckTimeout())
 		{
@@ -1447,9 +1784,14 @@ void CClientManager::UpdatePlayerCache()
 
 			// Item Cache Ʈ
 			UpdateItemCacheSet(c->Get()->id);
+
+			// ٽ Put     .
+			continue;
 		}
 		else if (c->CheckFlushTimeout())
 			c->Flush();
+
+		QueuePlayerCache(c);
 	}
 }
 // END_OF_MYSHOP_PRICE_LIST
@@ -1465,11 +1807,21 @@ void CClientManager::UpdateItemCache()
 	if (m_iCacheFlushCount >= m_iCacheFlushCountLimit)
 		return;
 
-	TItemCacheMap::iterator it = m_map_itemCache.begin();
+	time_t tNow = time(0);
+	DWORD dwID;
+	time_t tQueued;
+	CItemSaveBatch kBatch;
 
-	while (it != m_map_itemCache.end())
+	// ѵ ɷ   ť ״ ִٰ   .
+	while (m_kItemCacheQueue.Pop(tNow, dwID, tQueued))
 	{
-		CItemCache * c = (it++)->second;
+		TItemCacheMap::iterator it = m_map_itemCache.find(dwID);
+
+		if (it == m_map_itemCache.end() || it->second->GetQueuedTime() != tQueued)
+			continue;
+
+		CItemCache * c = it->second;
+		c->SetQueuedTime(0);
 
 		//  Flush Ѵ.
 		if (c->CheckFlushTimeout())
@@ -1477,29 +1829,41 @@ void CClientManager::UpdateItemCache()
 			if (g_test_server)
 				sys_log(0, "UpdateItemCache ==> Flush() vnum %d id owner %d", c->Get()->vnum, c->Get()->id, c->Get()->owner);
 
-			c->Flush();
+			c->Flush(kBatch);
 
 			if (++m_iCacheFlushCount >= m_iCacheFlushCountLimit)
 				break;
 		}
+		else
+			QueueItemCache(c);
 	}
+
+	kBatch.Commit();
 }
 
 void CClientManager::UpdateItemPriceListCache()
 {
-	TItemPriceListCacheMap::iterator it = m_mapItemPriceListCache.begin();
+	time_t tNow = time(0);
+	DWORD dwID;
+	time_t tQueued;
 
-	while (it != m_mapItemPriceListCache.end())
+	while (m_kItemPriceListCacheQueue.Pop(tNow, dwID, tQueued))
 	{
+		TItemPriceListCacheMap::iterator it = m_mapItemPriceListCache.find(dwID);
+
+		if (it == m_mapItemPriceListCache.end() || it->second->GetQueuedTime() != tQueued)
+			continue;
+
 		CItemPriceListTableCache* pCache = it->second;
+		pCache->SetQueuedTime(0);
 
 		if (pCache->CheckFlushTimeout())
 		{
 			pCache->Flush();
-			m_mapItemPriceListCache.erase(it++);
+			m_mapItemPriceListCache.erase(it);
 		}
 		else
-			++it;
+			QueueItemPriceListCache(pCache);
 	}
 }
 
@@ -1510,18 +1874,37 @@ void CClientManager::QUERY_ITEM_DESTROY(CPeer * pkPeer, const char * c_pData)
 
 	DWORD dwPID = *(DWORD *) c_pData;
 
+	RemoveSafeboxCacheItem(dwID);
+
 	if (!DeleteItemCache(dwID))
 	{
-		char szQuery[64];
-		snprintf(szQuery, sizeof(szQuery), "DELETE FROM item%s WHERE id=%u", GetTablePostfix(), dwID);
+		CCacheJournal::instance().AppendItemDelete(dwID);
 
 		if (g_log)
 			sys_log(0, "HEADER_GD_ITEM_DESTROY: PID %u ID %u", dwPID, dwID);
 
 		if (dwPID == 0) // ƹ   ٸ, 񵿱 
-			CDBManager::instance().AsyncQuery(szQuery);
+		{
+			char szQuery[64];
+			snprintf(szQuery, sizeof(szQuery), "DELETE FROM item%s WHERE id=?", GetTablePostfix());
+
+			CStmtQuery kQuery(szQuery);
+			kQuery.BindUnsigned(dwID);
+
+			// ٸ      ʰ .
+			FlushGroupCommitFor(dwID);
+			CDBManager::instance().ReturnStmt(kQuery, QID_ITEM_DESTROY, 0, NULL, SQL_PLAYER, dwID);
+		}
 		else
-			CDBManager::instance().ReturnQuery(szQuery, QID_ITEM_DESTROY, pkPeer->GetHandle(), NULL);
+		{
+			TPlayerItem item;
+			memset(&item, 0, sizeof(item));
+
+			item.id = dwID;
+			item.owner = dwPID;	// vnum 0   ǥ
+
+			GroupCommitItem(&item);
+		}
 	}
 }
 
@@ -1664,11 +2047,28 @@ void CClientManager::InsertLoginData(CLoginData * pkLD)
 
 void CClientManager::DeleteLoginData(CLoginData * pkLD)
 {
-	m_map_pkLoginData.erase(pkLD->GetKey());
-	m_map_pkLoginDataByLogin.erase(pkLD->GetAccountRef().login);
-	m_map_pkLoginDataByAID.erase(pkLD->GetAccountRef().id);
+	// InsertLoginData   Ű(ҹ α)  ε  Ͱ  ʴ´.
+	char szLogin[LOGIN_MAX_LEN + 1];
+	trim_and_lower(pkLD->GetAccountRef().login, szLogin, sizeof(szLogin));
+
+	TLoginDataByLoginKey::iterator itKey = m_map_pkLoginData.find(pkLD->GetKey());
+
+	if (itKey != m_map_pkLoginData.end() && itKey->second == pkLD)
+		m_map_pkLoginData.erase(itKey);
 
-	if (m_map_kLogonAccount.find(pkLD->GetAccountRef().login) == m_map_kLogonAccount.end())
+	TLoginDataByLogin::iterator itLogin = m_map_pkLoginDataByLogin.find(szLogin);
+
+	if (itLogin != m_map_pkLoginDataByLogin.end() && itLogin->second == pkLD)
+		m_map_pkLoginDataByLogin.erase(itLogin);
+
+	TLoginDataByAID::iterator itAID = m_map_pkLoginDataByAID.find(pkLD->GetAccountRef().id);
+
+	if (itAID != m_map_pkLoginDataByAID.end() && itAID->second == pkLD)
+		m_map_pkLoginDataByAID.erase(itAID);
+
+	TLogonAccountMap::iterator itLogon = m_map_kLogonAccount.find(szLogin);
+
+	if (itLogon == m_map_kLogonAccount.end() || itLogon->second != pkLD)
 		delete pkLD;
 	else
 		pkLD->SetDeleted(true);
@@ -1720,6 +2120,9 @@ void CClientManager::QUERY_AUTH_LOGIN(CPeer * pkPeer, DWORD dwHandle, TPacketGDA
 
 		pkPeer->EncodeHeader(HEADER_DG_AUTH_LOGIN, dwHandle, sizeof(BYTE));
 		pkPeer->EncodeBYTE(bResult);
+
+		// ĳ   player  ̸ о д.
+		PrefetchAccountPlayers(p->dwID);
 	}
 }
 
@@ -1926,6 +2329,7 @@ void CClientManager::MyshopPricelistUpdate(const TPacketMyshopPricelistHeader* p
 		thecore_memcpy(table.aPriceInfo, pInfo, sizeof(TItemPriceInfo) * pPacket->byCount);
 
 		pCache->UpdateList(&table);
+		QueueItemPriceListCache(pCache);
 	}
 	else
 	{
@@ -1993,7 +2397,7 @@ void CPacketInfo::Reset()
 	m_map_info.clear();
 }
 
-void CClientManager::ProcessPackets(CPeer * peer)
+bool CClientManager::ProcessPackets(CPeer * peer)
 {
 	BYTE		header;
 	DWORD		dwHandle;
@@ -2001,6 +2405,7 @@ void CClientManager::ProcessPackets(CPeer * peer)
 	const char * data = NULL;
 	int			i = 0;
 	int			iCount = 0;
+	DWORD		dwStartTime = get_dword_time();
 
 	while (peer->PeekPacket(i, header, dwHandle, dwLength, &data))
 	{
@@ -2346,9 +2751,24 @@ void CClientManager::ProcessPackets(CPeer * peer)
 				sys_err("Unknown header (header: %d handle: %d length: %d)", header, dwHandle, dwLength);
 				break;
 		}
+
+		//  ھ Ѳ     ʵ ´.
+		//  Ŷ Process  ٸ Ǿ  óѴ.
+		if (g_iPeerPacketBudget > 0 && iCount >= g_iPeerPacketBudget)
+			break;
 	}
 
 	peer->RecvEnd(i);
+
+	DWORD dwElapsed = get_dword_time() - dwStartTime;
+
+	if (dwElapsed >= 100)
+		sys_log(0, "SLOW_PEER_PROCESS: channel %d packets %d last header %d elapsed %u ms",
+				peer->GetChannel(), iCount, m_bLastHeader, dwElapsed);
+
+	bool bBacklog = g_iPeerPacketBudget > 0 && iCount >= g_iPeerPacketBudget;
+	peer->SetRecvBacklog(bBacklog);
+	return bBacklog;
 }
 
 void CClientManager::AddPeer(socket_t fd)
@@ -2439,10 +2859,33 @@ int CClientManager::AnalyzeQueryResult(SQLMsg * msg)
 			delete qi;
 			return true;
 
+		case QID_PLAYER_PREFETCH_INDEX:
+			RESULT_PLAYER_PREFETCH_INDEX(msg);
+			delete qi;
+			return true;
+
+		case QID_PLAYER_PREFETCH:
+			RESULT_PLAYER_PREFETCH(msg);
+			delete qi;
+			return true;
+
+		case QID_PLAYER_SAVE:
+			RESULT_PLAYER_SAVE(msg);
+			delete qi;
+			return true;
+
 		case QID_GUILD_RANKING:
 			CGuildManager::instance().ResultRanking(msg->Get()->pSQLResult);
 			break;
 
+		case QID_GUILD_LOAD:
+			CGuildManager::instance().ResultLoad(msg);
+			break;
+
+		case QID_MARRIAGE_LOAD:
+			marriage::CManager::instance().ResultLoad(msg);
+			break;
+
 			// MYSHOP_PRICE_LIST
 		case QID_ITEMPRICE_LOAD_FOR_UPDATE:
 			RESULT_PRICELIST_LOAD_FOR_UPDATE(msg);
@@ -2466,6 +2909,18 @@ int CClientManager::AnalyzeQueryResult(SQLMsg * msg)
 			RESULT_COMPOSITE_PLAYER(peer, msg, qi->iType);
 			break;
 
+		case QID_PLAYER_COMPOSITE:
+			RESULT_COMPOSITE_PLAYER_MULTI(peer, msg, QID_PLAYER);
+			break;
+
+		case QID_ITEM_COMPOSITE:
+			RESULT_COMPOSITE_PLAYER_MULTI(peer, msg, QID_ITEM);
+			break;
+
+		case QID_QUEST_COMPOSITE:
+			RESULT_COMPOSITE_PLAYER_MULTI(peer, msg, QID_QUEST);
+			break;
+
 		case QID_LOGIN:
 			RESULT_LOGIN(peer, msg);
 			break;
@@ -2494,7 +2949,6 @@ int CClientManager::AnalyzeQueryResult(SQLMsg * msg)
 		case QID_ITEM_SAVE:
 		case QID_ITEM_DESTROY:
 		case QID_QUEST_SAVE:
-		case QID_PLAYER_SAVE:
 		case QID_ITEM_AWARD_TAKEN:
 			break;
 
@@ -2652,20 +3106,44 @@ int CClientManager::Process()
 			UpdateItemCache();
 			//α׾ƿ ó- ĳ ÷
 			UpdateLogoutPlayer();
+			UpdatePlayerPrefetch();
+			UpdateSafeboxCache();
 
 			// MYSHOP_PRICE_LIST
 			UpdateItemPriceListCache();
 			// END_OF_MYSHOP_PRICE_LIST
 
+			//  ť  (̹  ĳ  )
+			if (!(thecore_heart->pulse % (thecore_heart->passes_per_sec * 60)))
+				sys_log(0, "CACHE_QUEUE: player %u item %u pricelist %u safebox %u",
+						m_kPlayerCacheQueue.Size(), m_kItemCacheQueue.Size(), m_kItemPriceListCacheQueue.Size(), m_map_safeboxCache.size());
+
 			CGuildManager::instance().Update();
 			CPrivManager::instance().Update();
 			marriage::CManager::instance().Update();
+
+			UpdateMetrics();
 		}
 
-		if (!(thecore_heart->pulse % (thecore_heart->passes_per_sec * 5)))
-		{
+		// ˸(SIGUSR1) ԰ų д    ٷ, ƴϸ ֱ item_award  д´.
+		if (!(thecore_heart->pulse % (thecore_heart->passes_per_sec * g_iItemAwardPollSeconds)))
 			ItemAwardManager::instance().RequestLoad();
-		}
+		else
+			ItemAwardManager::instance().Update();
+
+		CCacheJournal::instance().Update();
+
+		if (!m_kGroupCommit.IsEmpty() && get_dword_time() - m_dwGroupCommitStart >= (DWORD) g_iGroupCommitMS)
+			FlushGroupCommit();
+
+		if (!(thecore_heart->pulse % (thecore_heart->passes_per_sec * g_iClusterStateSeconds)))
+			SendClusterState();
+
+		//   з  üũƮ ̷.
+		if (CCacheJournal::instance().NeedCheckpoint() && m_kGroupCommit.IsEmpty() &&
+				!CDBManager::instance().CountReturnQuery(SQL_PLAYER) &&
+				!CDBManager::instance().CountAsyncQuery(SQL_PLAYER))
+			CheckpointCacheJournal();
 
 		if (!(thecore_heart->pulse % (thecore_heart->passes_per_sec * 10)))
 		{
@@ -2797,6 +3275,22 @@ int CClientManager::Process()
 		}
 	}
 
+	//    Ǿ   Ŷ Ǿ 길ŭ ư óѴ.
+	bool bBacklog = g_iPeerPacketBudget > 0;
+
+	while (bBacklog)
+	{
+		bBacklog = false;
+
+		for (itertype(m_peerList) it = m_peerList.begin(); it != m_peerList.end(); ++it)
+		{
+			CPeer * pkPeer = *it;
+
+			if (pkPeer->HasRecvBacklog() && ProcessPackets(pkPeer))
+				bBacklog = true;
+		}
+	}
+
 #ifdef __WIN32__
 	if (_kbhit()) {
 		int c = _getch();
@@ -2824,6 +3318,47 @@ void CClientManager::SendAllGuildSkillRechargePacket()
 	ForwardPacket(HEADER_DG_GUILD_SKILL_RECHARGE, NULL, 0);
 }
 
+void CClientManager::SendClusterState()
+{
+	std::map<BYTE, TClusterChannelState> map_kChannel;
+	DWORD dwTotal = 0;
+
+	for (itertype(m_peerList) it = m_peerList.begin(); it != m_peerList.end(); ++it)
+	{
+		CPeer * peer = *it;
+
+		if (!peer->GetChannel())
+			continue;
+
+		TClusterChannelState & r = map_kChannel[peer->GetChannel()];
+		const DWORD * c_pdwEmpire = peer->GetEmpireUserCount();
+
+		r.bChannel = peer->GetChannel();
+		r.dwCount += peer->GetUserCount();
+
+		for (int i = 0; i < EMPIRE_MAX_NUM; ++i)
+			r.adwEmpireCount[i] += c_pdwEmpire[i];
+
+		dwTotal += peer->GetUserCount();
+	}
+
+	if (map_kChannel.empty())
+		return;
+
+	std::vector<char> buf(sizeof(TPacketDGClusterState) + sizeof(TClusterChannelState) * map_kChannel.size());
+
+	TPacketDGClusterState * p = (TPacketDGClusterState *) &buf[0];
+	p->dwTotal = dwTotal;
+	p->bChannelCount = map_kChannel.size();
+
+	TClusterChannelState * pkState = (TClusterChannelState *) (p + 1);
+
+	for (itertype(map_kChannel) it = map_kChannel.begin(); it != map_kChannel.end(); ++it)
+		*pkState++ = it->second;
+
+	ForwardPacket(HEADER_DG_CLUSTER_STATE, &buf[0], buf.size());
+}
+
 void CClientManager::SendTime()
 {
 	time_t now = GetCurrentTime();
@@ -2892,9 +3427,116 @@ bool CClientManager::InitializeNowItemID()
 	
 	sys_log(0, " Init Success Start %u End %u Now %u\n", m_itemRange.dwMin, m_itemRange.dwMax, m_itemRange.dwUsableItemIDMin);
 
+	RegisterMetrics();
 	return true;
 }
 
+enum EDBMetric
+{
+	DB_METRIC_USERS,
+	DB_METRIC_PEERS,
+	DB_METRIC_CACHE_PLAYER,
+	DB_METRIC_CACHE_ITEM,
+	DB_METRIC_CACHE_PRICELIST,
+	DB_METRIC_CACHE_SAFEBOX,
+	DB_METRIC_CACHE_QUEUE_PLAYER,
+	DB_METRIC_CACHE_QUEUE_ITEM,
+	DB_METRIC_CACHE_QUEUE_PRICELIST,
+	DB_METRIC_SQL_RETURN_QUERY,
+	DB_METRIC_SQL_RETURN_RESULT,
+	DB_METRIC_SQL_ASYNC_QUERY,
+	DB_METRIC_SQL_ASYNC_RESULT,
+	DB_METRIC_GROUP_COMMIT,
+	DB_METRIC_GROUP_COMMIT_ROWS,
+	DB_METRIC_MAX_NUM
+};
+
+static LPMETRIC s_apkDBMetric[DB_METRIC_MAX_NUM];
+static HISTOGRAM s_kGroupCommitWait;	// ù Ⱑ   ĿԱ ɸ ð (us)
+
+void CClientManager::RegisterMetrics()
+{
+	s_apkDBMetric[DB_METRIC_USERS]			= metrics_gauge("db_users", "users logged in through all cores");
+	s_apkDBMetric[DB_METRIC_PEERS]			= metrics_gauge("db_peers", "connected game cores");
+	s_apkDBMetric[DB_METRIC_CACHE_PLAYER]		= metrics_gauge("db_cache{kind=\"player\"}", "cached entries");
+	s_apkDBMetric[DB_METRIC_CACHE_ITEM]		= metrics_gauge("db_cache{kind=\"item\"}", "cached entries");
+	s_apkDBMetric[DB_METRIC_CACHE_PRICELIST]	= metrics_gauge("db_cache{kind=\"pricelist\"}", "cached entries");
+	s_apkDBMetric[DB_METRIC_CACHE_SAFEBOX]		= metrics_gauge("db_cache{kind=\"safebox\"}", "cached entries");
+	s_apkDBMetric[DB_METRIC_CACHE_QUEUE_PLAYER]	= metrics_gauge("db_cache_queue{kind=\"player\"}", "cache entries waiting for expiry");
+	s_apkDBMetric[DB_METRIC_CACHE_QUEUE_ITEM]	= metrics_gauge("db_cache_queue{kind=\"item\"}", "cache entries waiting for expiry");
+	s_apkDBMetric[DB_METRIC_CACHE_QUEUE_PRICELIST]	= metrics_gauge("db_cache_queue{kind=\"pricelist\"}", "cache entries waiting for expiry");
+	s_apkDBMetric[DB_METRIC_SQL_RETURN_QUERY]	= metrics_gauge("db_sql_queue{kind=\"return\"}", "player sql queries waiting");
+	s_apkDBMetric[DB_METRIC_SQL_ASYNC_QUERY]	= metrics_gauge("db_sql_queue{kind=\"async\"}", "player sql queries waiting");
+	s_apkDBMetric[DB_METRIC_SQL_RETURN_RESULT]	= metrics_gauge("db_sql_result{kind=\"return\"}", "player sql results not yet handled");
+	s_apkDBMetric[DB_METRIC_SQL_ASYNC_RESULT]	= metrics_gauge("db_sql_result{kind=\"async\"}", "player sql results not yet handled");
+	s_apkDBMetric[DB_METRIC_GROUP_COMMIT]		= metrics_counter("db_group_commit_total", "item write group commits");
+	s_apkDBMetric[DB_METRIC_GROUP_COMMIT_ROWS]	= metrics_counter("db_group_commit_rows_total", "item rows written by group commits");
+
+	metrics_histogram("db_group_commit_wait_us", "time item writes waited for their group commit in microseconds", &s_kGroupCommitWait);
+}
+
+void CClientManager::GroupCommitItem(const TPlayerItem * p)
+{
+	if (g_iGroupCommitMS <= 0)
+	{
+		CItemSaveBatch kBatch;
+		kBatch.Add(p);
+		kBatch.Commit();
+		return;
+	}
+
+	if (m_kGroupCommit.IsEmpty())
+		m_dwGroupCommitStart = get_dword_time();
+
+	m_kGroupCommit.Add(p);
+}
+
+void CClientManager::FlushGroupCommit()
+{
+	if (m_kGroupCommit.IsEmpty())
+		return;
+
+	histogram_record(&s_kGroupCommitWait, (get_dword_time() - m_dwGroupCommitStart) * 1000);
+	metrics_add(s_apkDBMetric[DB_METRIC_GROUP_COMMIT], 1);
+	metrics_add(s_apkDBMetric[DB_METRIC_GROUP_COMMIT_ROWS], m_kGroupCommit.GetCount());
+
+	m_kGroupCommit.Commit(true);
+}
+
+void CClientManager::FlushGroupCommitFor(DWORD dwID)
+{
+	if (m_kGroupCommit.Has(dwID))
+		FlushGroupCommit();
+}
+
+void CClientManager::FlushGroupCommitFor(const CItemSaveBatch & rkBatch)
+{
+	if (&rkBatch != &m_kGroupCommit && m_kGroupCommit.Overlaps(rkBatch))
+		FlushGroupCommit();
+}
+
+void CClientManager::UpdateMetrics()
+{
+	metrics_set(s_apkDBMetric[DB_METRIC_USERS], GetUserCount());
+	metrics_set(s_apkDBMetric[DB_METRIC_PEERS], m_peerList.size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_PLAYER], m_map_playerCache.size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_ITEM], m_map_itemCache.size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_PRICELIST], m_mapItemPriceListCache.size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_SAFEBOX], m_map_safeboxCache.size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_QUEUE_PLAYER], m_kPlayerCacheQueue.Size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_QUEUE_ITEM], m_kItemCacheQueue.Size());
+	metrics_set(s_apkDBMetric[DB_METRIC_CACHE_QUEUE_PRICELIST], m_kItemPriceListCacheQueue.Size());
+
+	CDBManager & rkDB = CDBManager::instance();
+
+	metrics_set(s_apkDBMetric[DB_METRIC_SQL_RETURN_QUERY], rkDB.CountReturnQuery(SQL_PLAYER));
+	metrics_set(s_apkDBMetric[DB_METRIC_SQL_RETURN_RESULT], rkDB.CountReturnResult(SQL_PLAYER));
+	metrics_set(s_apkDBMetric[DB_METRIC_SQL_ASYNC_QUERY], rkDB.CountAsyncQuery(SQL_PLAYER));
+	metrics_set(s_apkDBMetric[DB_METRIC_SQL_ASYNC_RESULT], rkDB.CountAsyncResult(SQL_PLAYER));
+
+	metrics_update();
+}
+
 DWORD CClientManager::GainItemID()
 {
 	return m_itemRange.dwUsableItemIDMin++;
@@ -3436,12 +4078,16 @@ void CClientManager::UpdateItemCacheSet(DWORD pid)
 	TItemCacheSet * pSet = it->second;
 	TItemCacheSet::iterator it_set = pSet->begin();
 
+	CItemSaveBatch kBatch;
+
 	while (it_set != pSet->end())
 	{
 		CItemCache * c = *it_set++;
-		c->Flush();
+		c->Flush(kBatch);
 	}
 
+	kBatch.Commit();
+
 	if (g_log)
 		sys_log(0, "UPDATE_ITEMCACHESET : UpdateItemCachsSet pid(%d)", pid);
 }
@@ -3474,20 +4120,7 @@ void CClientManager::DeleteLoginKey(TPacketDC *data)
 void CClientManager::DeleteAwardId(TPacketDeleteAwardID *data)
 {
 	//sys_log(0,"data from game server arrived %d",data->dwID);
-	std::map<DWORD, TItemAward *>::iterator it;
-	it = ItemAwardManager::Instance().GetMapAward().find(data->dwID);
-	if ( it != ItemAwardManager::Instance().GetMapAward().end() )
-	{
-		std::set<TItemAward *> & kSet = ItemAwardManager::Instance().GetMapkSetAwardByLogin()[it->second->szLogin];
-		if(kSet.erase(it->second))
-			sys_log(0,"erase ItemAward id: %d from cache", data->dwID);
-		ItemAwardManager::Instance().GetMapAward().erase(data->dwID);
-	}
-	else
-	{
-		sys_log(0,"DELETE_AWARDID : could not find the id: %d", data->dwID);
-	}
-
+	ItemAwardManager::Instance().Delete(data->dwID);
 }
 
 void CClientManager::UpdateChannelStatus(TChannelStatus* pData)
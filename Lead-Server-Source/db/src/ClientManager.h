@@ -11,6 +11,8 @@
 #include "Peer.h"
 #include "DBManager.h"
 #include "LoginData.h"
+#include "Cache.h"
+#include "QID.h"
 
 class CPlayerTableCache;
 class CItemCache;
@@ -25,7 +27,25 @@ class CPacketInfo
 	std::map<int, int> m_map_info;
 };
 
-size_t CreatePlayerSaveQuery(char * pszQuery, size_t querySize, TPlayerTable * pkTab);
+// player ̺ ÷ . ٲ  UPDATE Ѵ.
+enum EPlayerSaveFields
+{
+	PLAYER_SAVE_BASIC	= (1 << 0),	// job, voice, ip, part_main, part_hair, skill_group, alignment
+	PLAYER_SAVE_POSITION	= (1 << 1),
+	PLAYER_SAVE_POINT	= (1 << 2),	// hp, mp, stamina, random_hp, random_sp
+	PLAYER_SAVE_PLAYTIME	= (1 << 3),
+	PLAYER_SAVE_LEVEL	= (1 << 4),	// level, level_step, exp
+	PLAYER_SAVE_STAT	= (1 << 5),	// st, ht, dx, iq, *_point, stat_reset_count
+	PLAYER_SAVE_GOLD	= (1 << 6),
+	PLAYER_SAVE_HORSE	= (1 << 7),
+	PLAYER_SAVE_SKILL	= (1 << 8),
+	PLAYER_SAVE_QUICKSLOT	= (1 << 9),
+	PLAYER_SAVE_ALL		= (1 << 10) - 1,
+};
+
+DWORD GetPlayerSaveFields(const TPlayerTable * pkNew, const TPlayerTable * pkOld);
+void CreatePlayerSaveStmt(CStmtQuery & rkQuery, TPlayerTable * pkTab, DWORD dwFields = PLAYER_SAVE_ALL);
+void CreateItemSaveStmt(CStmtQuery & rkQuery, const TPlayerItem * pkItem);
 
 class CClientManager : public CNetBase, public singleton<CClientManager>
 {
@@ -107,6 +127,12 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 	DWORD	GetUserCount();	// ӵ    Ѵ.
 
 	void	SendAllGuildSkillRechargePacket();
+	void	GroupCommitItem(const TPlayerItem * p);
+	void	FlushGroupCommit();	//   б  ҷ   ʰ Ѵ
+	// ׷ Ŀ ġ ʴ   θ.   ׷ ĿԿ    .
+	void	FlushGroupCommitFor(DWORD dwID);
+	void	FlushGroupCommitFor(const CItemSaveBatch & rkBatch);	// rkBatch    ϳ   
+	void	SendClusterState();	//  ھ    äκ    
 	void	SendTime();
 
 	CPlayerTableCache *	GetPlayerCache(DWORD id);
@@ -123,6 +149,13 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 	void			UpdatePlayerCache();
 	void			UpdateItemCache();
 
+	void			ReplayCacheJournal();
+	void			CheckpointCacheJournal();
+
+	void			QueuePlayerCache(CPlayerTableCache * c);
+	void			QueueItemCache(CItemCache * c);
+	void			QueueItemPriceListCache(CItemPriceListTableCache * c);
+
 	// MYSHOP_PRICE_LIST
 	///  Ʈ ĳø ´.
 	/**
@@ -166,6 +199,7 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 
     private:
 	bool		InitializeTables();
+	bool		InitializeSQLTables();
 	bool		InitializeShopTable();
 	bool		InitializeMobTable();
 	bool		InitializeItemTable();
@@ -174,6 +208,7 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 	bool		InitializeRefineTable();
 	bool		InitializeBanwordTable();
 	bool		InitializeItemAttrTable();
+	bool		BuildBootTableCache();
 	bool		InitializeItemRareTable();
 	bool		InitializeLandTable();
 	bool		InitializeObjectProto();
@@ -191,7 +226,7 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 
 	int		Process();
 
-        void            ProcessPackets(CPeer * peer);
+        bool            ProcessPackets(CPeer * peer);	//   Ἥ Ŷ  true
 
 	CLoginData *	GetLoginData(DWORD dwKey);
 	CLoginData *	GetLoginDataByLogin(const char * c_pszLogin);
@@ -232,11 +267,16 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 	void		RESULT_LOGIN(CPeer * peer, SQLMsg *msg);
 
 	void		QUERY_PLAYER_LOAD(CPeer * peer, DWORD dwHandle, TPlayerLoadPacket*);
+	void		QueryPlayerLoad(CPeer * peer, DWORD dwHandle, DWORD dwPID, DWORD dwAID, DWORD dwFirstQID, bool bQuestValueOnly, DWORD dwLastQID = QID_AFFECT);
 	void		RESULT_COMPOSITE_PLAYER(CPeer * peer, SQLMsg * pMsg, DWORD dwQID);
+	void		RESULT_COMPOSITE_PLAYER_MULTI(CPeer * peer, SQLMsg * pMsg, DWORD dwFirstQID);
+	void		RESULT_COMPOSITE_PLAYER_PART(CPeer * peer, MYSQL_RES * pSQLResult, DWORD dwQID, ClientHandleInfo * pkInfo);
 	void		RESULT_PLAYER_LOAD(CPeer * peer, MYSQL_RES * pRes, ClientHandleInfo * pkInfo);
+	void		RESULT_PLAYER_LOAD(CPeer * peer, TPlayerTable * pTab, ClientHandleInfo * pkInfo);
 	void		RESULT_ITEM_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwHandle, DWORD dwPID);
 	void		RESULT_QUEST_LOAD(CPeer * pkPeer, MYSQL_RES * pRes, DWORD dwHandle, DWORD dwPID);
 	void		RESULT_AFFECT_LOAD(CPeer * pkPeer, MYSQL_RES * pRes, DWORD dwHandle);
+	void		RESULT_PLAYER_SAVE(SQLMsg * pMsg);
 
 	// PLAYER_INDEX_CREATE_BUG_FIX
 	void		RESULT_PLAYER_INDEX_CREATE(CPeer *pkPeer, SQLMsg *msg);
@@ -408,6 +448,10 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 	std::vector<building::TObjectProto>	m_vec_kObjectProto;
 	std::map<DWORD, building::TObject *>	m_map_pkObjectTable;
 
+	// QUERY_BOOT   ʴ ̺ κ   . ̺   ٽ .
+	std::vector<char>			m_vec_bootTableCache;
+	DWORD					m_dwBootTableRawSize;
+
 	bool					m_bShutdowned;
 
 	TPlayerTableCacheMap			m_map_playerCache;  // ÷̾ id key
@@ -420,6 +464,11 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 	TItemPriceListCacheMap m_mapItemPriceListCache;  ///< ÷̾   Ʈ
 	// END_OF_MYSHOP_PRICE_LIST
 
+	// ĳ  ü  ʵ  ˻ ð id ־ д.
+	CCacheExpiryQueue			m_kPlayerCacheQueue;
+	CCacheExpiryQueue			m_kItemCacheQueue;
+	CCacheExpiryQueue			m_kItemPriceListCacheQueue;
+
 	TChannelStatusMap m_mChannelStatus;
 
 	struct TPartyInfo
@@ -495,6 +544,53 @@ class CClientManager : public CNetBase, public singleton<CClientManager>
 
 	void FlushPlayerCacheSet(DWORD pid);
 
+	//  α  ̸ о  player . PLAYER_LOAD     .
+	struct TPlayerPrefetch
+	{
+	    TPlayerTable	table;
+	    time_t		time;
+	};
+
+	typedef boost::unordered_map<DWORD, TPlayerPrefetch> TPlayerPrefetchMap;
+	TPlayerPrefetchMap m_map_playerPrefetch;
+
+	void PrefetchAccountPlayers(DWORD dwAID);
+	void RESULT_PLAYER_PREFETCH_INDEX(SQLMsg * pMsg);
+	void RESULT_PLAYER_PREFETCH(SQLMsg * pMsg);
+	bool PopPlayerPrefetch(DWORD pid, TPlayerTable * pTab);
+	void DropPlayerPrefetch(DWORD pid);
+	void UpdatePlayerPrefetch();
+
+	// â  ĳ. â    db   ٲǷ ѹ  
+	// SAFEBOX_LOAD    óѴ.  ۿ ֱ⵵ ϹǷ ĳ ʴ´.
+	struct TSafeboxCache
+	{
+	    TSafeboxTable	table;
+	    bool		bExist;	// safebox  ִ°
+	    char		szPassword[SAFEBOX_PASSWORD_MAX_LEN + 1];
+	    std::map<DWORD, TPlayerItem>	map_item;	//  id  key
+	    time_t		time;	//   ð
+	};
+
+	typedef boost::unordered_map<DWORD, TSafeboxCache> TSafeboxCacheMap;	//  id  key
+	TSafeboxCacheMap			m_map_safeboxCache;
+	TSafeboxCacheMap			m_map_safeboxLoading;	// д  .   ٲ .
+	boost::unordered_map<DWORD, DWORD>	m_map_safeboxItemOwner;	// ĳõ â  id ->  id
+
+	void SendSafeboxLoad(CPeer * pkPeer, ClientHandleInfo * pi, std::vector<TPlayerItem> & s_items);
+	void PutSafeboxCache(DWORD dwAccountID, const std::vector<TPlayerItem> & c_rVec);
+	void PutSafeboxCacheItem(const TPlayerItem * p);
+	void RemoveSafeboxCacheItem(DWORD dwItemID);
+	void DropSafeboxCache(DWORD dwAccountID);
+	void UpdateSafeboxCache();
+
+	//  Ʈ(METRICS_PORT)  ġ
+	void RegisterMetrics();
+	void UpdateMetrics();
+
+	CItemSaveBatch	m_kGroupCommit;		// ٷ  ϴ  ⸦   Ằ Ʈ 
+	DWORD		m_dwGroupCommitStart;	//   ð (ms)
+
 	void SendSpareItemIDRange(CPeer* peer);
 
 	void UpdateHorseName(TPacketUpdateHorseName* data, CPeer* peer);
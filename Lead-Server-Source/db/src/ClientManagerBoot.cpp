@@ -6,36 +6,173 @@
 #include "CsvReader.h"
 #include "ProtoReader.h"
 
+#include <zlib.h>
+
 using namespace std;
 
 extern int g_test_server;
 extern std::string g_stLocaleNameColumn;
 
+// mob/item proto  txt Ͽ а DB   Ƿ,
+// SQL ̺ д   忡 д´.
+struct TProtoLoadJob
+{
+	bool		(CClientManager::*pfnLoad)();
+	const char *	c_pszName;
+	bool		bResult;
+	bool		bThread;
+#ifndef __WIN32__
+	pthread_t	hThread;
+#else
+	HANDLE		hThread;
+#endif
+};
+
+#ifndef __WIN32__
+static void * ProtoLoadThread(void * arg)
+#else
+static unsigned int __stdcall ProtoLoadThread(void * arg)
+#endif
+{
+	TProtoLoadJob * pJob = (TProtoLoadJob *) arg;
+	pJob->bResult = (CClientManager::instance().*(pJob->pfnLoad))();
+	return 0;
+}
+
+static void StartProtoLoad(TProtoLoadJob & rJob)
+{
+#ifndef __WIN32__
+	rJob.bThread = (0 == pthread_create(&rJob.hThread, NULL, ProtoLoadThread, &rJob));
+#else
+	rJob.hThread = (HANDLE) ::_beginthreadex(NULL, 0, ProtoLoadThread, &rJob, 0, NULL);
+	rJob.bThread = (rJob.hThread != 0 && rJob.hThread != INVALID_HANDLE_VALUE);
+#endif
+
+	// 带   ׳ ⼭ д´.
+	if (!rJob.bThread)
+	{
+		sys_err("cannot create thread for %s, loading inline", rJob.c_pszName);
+		ProtoLoadThread(&rJob);
+	}
+}
+
+static void JoinProtoLoad(TProtoLoadJob & rJob)
+{
+	if (!rJob.bThread)
+		return;
+
+#ifndef __WIN32__
+	pthread_join(rJob.hThread, NULL);
+#else
+	::WaitForSingleObject(rJob.hThread, INFINITE);
+	::CloseHandle(rJob.hThread);
+#endif
+	rJob.bThread = false;
+}
+
 bool CClientManager::InitializeTables()
 {
-	if (!InitializeMobTable())
+	TProtoLoadJob akJob[] =
 	{
-		sys_err("InitializeMobTable FAILED");
-		return false;
+		{ &CClientManager::InitializeMobTable,	"InitializeMobTable",	false, false },
+		{ &CClientManager::InitializeItemTable,	"InitializeItemTable",	false, false },
+	};
+
+	const int JOB_COUNT = sizeof(akJob) / sizeof(akJob[0]);
+
+	for (int i = 0; i < JOB_COUNT; ++i)
+		StartProtoLoad(akJob[i]);
+
+	// ص 尡   ٷ ϹǷ ٷ return  ʴ´.
+	bool bResult = InitializeSQLTables();
+
+	for (int i = 0; i < JOB_COUNT; ++i)
+	{
+		JoinProtoLoad(akJob[i]);
+
+		if (!akJob[i].bResult)
+		{
+			sys_err("%s FAILED", akJob[i].c_pszName);
+			bResult = false;
+		}
 	}
+
+	if (!bResult)
+		return false;
+
 	if (!MirrorMobTableIntoDB())
 	{
 		sys_err("MirrorMobTableIntoDB FAILED");
 		return false; 
 	}
 
-	if (!InitializeItemTable())
+	if (!MirrorItemTableIntoDB())
 	{
-		sys_err("InitializeItemTable FAILED");
+		sys_err("MirrorItemTableIntoDB FAILED");
 		return false; 
 	}
 
-	if (!MirrorItemTableIntoDB())
+	if (!BuildBootTableCache())
 	{
-		sys_err("MirrorItemTableIntoDB FAILED");
-		return false; 
+		sys_err("BuildBootTableCache FAILED");
+		return false;
+	}
+
+	return true;
+}
+
+static void AppendBootTable(std::vector<char> & rvec, WORD wSize, WORD wCount, const void * c_pvData)
+{
+	size_t pos = rvec.size();
+	rvec.resize(pos + sizeof(WORD) + sizeof(WORD) + wSize * wCount);
+
+	char * p = &rvec[pos];
+	thecore_memcpy(p, &wSize, sizeof(WORD));
+	thecore_memcpy(p + sizeof(WORD), &wCount, sizeof(WORD));
+
+	if (wCount)
+		thecore_memcpy(p + sizeof(WORD) + sizeof(WORD), c_pvData, wSize * wCount);
+}
+
+// ھ Ȱ   ̺     д.
+// , Ʈ,  ID ,   ٲų ھ ٸǷ QUERY_BOOT   δ.
+bool CClientManager::BuildBootTableCache()
+{
+	std::vector<char> vecRaw;
+
+	AppendBootTable(vecRaw, sizeof(TMobTable), m_vec_mobTable.size(), m_vec_mobTable.empty() ? NULL : &m_vec_mobTable[0]);
+	AppendBootTable(vecRaw, sizeof(TItemTable), m_vec_itemTable.size(), m_vec_itemTable.empty() ? NULL : &m_vec_itemTable[0]);
+	AppendBootTable(vecRaw, sizeof(TShopTable), m_iShopTableSize, m_pShopTable);
+	AppendBootTable(vecRaw, sizeof(TSkillTable), m_vec_skillTable.size(), m_vec_skillTable.empty() ? NULL : &m_vec_skillTable[0]);
+	AppendBootTable(vecRaw, sizeof(TRefineTable), m_iRefineTableSize, m_pRefineTable);
+	AppendBootTable(vecRaw, sizeof(TItemAttrTable), m_vec_itemAttrTable.size(), m_vec_itemAttrTable.empty() ? NULL : &m_vec_itemAttrTable[0]);
+	AppendBootTable(vecRaw, sizeof(TItemAttrTable), m_vec_itemRareTable.size(), m_vec_itemRareTable.empty() ? NULL : &m_vec_itemRareTable[0]);
+	AppendBootTable(vecRaw, sizeof(TBanwordTable), m_vec_banwordTable.size(), m_vec_banwordTable.empty() ? NULL : &m_vec_banwordTable[0]);
+	AppendBootTable(vecRaw, sizeof(building::TObjectProto), m_vec_kObjectProto.size(), m_vec_kObjectProto.empty() ? NULL : &m_vec_kObjectProto[0]);
+
+	uLongf ulCompSize = compressBound(vecRaw.size());
+	m_vec_bootTableCache.resize(ulCompSize);
+
+	int iRet = compress2((Bytef *) &m_vec_bootTableCache[0], &ulCompSize, (const Bytef *) &vecRaw[0], vecRaw.size(), Z_BEST_COMPRESSION);
+
+	if (iRet != Z_OK)
+	{
+		sys_err("compress2 failed %d (raw %u)", iRet, vecRaw.size());
+		m_vec_bootTableCache.clear();
+		m_dwBootTableRawSize = 0;
+		return false;
 	}
 
+	m_vec_bootTableCache.resize(ulCompSize);
+	m_dwBootTableRawSize = vecRaw.size();
+
+	sys_log(0, "BOOT_CACHE: raw %u compressed %u", m_dwBootTableRawSize, m_vec_bootTableCache.size());
+	return true;
+}
+
+// DirectQuery  ϳ̹Ƿ SQL  д ̺ ʴ д´.
+bool CClientManager::InitializeSQLTables()
+{
 	if (!InitializeShopTable())
 	{
 		sys_err("InitializeShopTable FAILED");
@@ -161,6 +298,159 @@ class FCompareVnum
 		}
 };
 
+// mob/item proto .
+// txt  Ľ  ̺ ״  ΰ,  txt  
+// ٲ ʾ    CSV Ľ   д´.
+// ü ũ⳪   ٸų üũ   ϰ txt  д´.
+enum
+{
+	PROTO_SNAPSHOT_MAGIC	= 0x50534432,	// "2DSP"
+	PROTO_SNAPSHOT_VERSION	= 1,
+};
+
+typedef struct SProtoSnapshotHeader
+{
+	DWORD	dwMagic;
+	DWORD	dwVersion;
+	DWORD	dwElemSize;
+	DWORD	dwCount;
+	DWORD	dwSourceStamp;
+	DWORD	dwChecksum;
+} TProtoSnapshotHeader;
+
+static DWORD ProtoSnapshotHash(DWORD dwHash, const void * c_pvData, size_t len)
+{
+	const BYTE * p = (const BYTE *) c_pvData;
+
+	while (len--)
+	{
+		dwHash ^= *p++;
+		dwHash *= 16777619;
+	}
+
+	return dwHash;
+}
+
+//    ؽ.  ϵ ٴ  ü ´.
+static DWORD GetProtoSourceStamp(const char ** c_ppszSources)
+{
+	DWORD dwStamp = 2166136261U;
+	char buf[65536];
+
+	for (; *c_ppszSources; ++c_ppszSources)
+	{
+		dwStamp = ProtoSnapshotHash(dwStamp, *c_ppszSources, strlen(*c_ppszSources) + 1);
+
+		FILE * fp = fopen(*c_ppszSources, "rb");
+
+		if (!fp)
+		{
+			dwStamp = ProtoSnapshotHash(dwStamp, "-", 1);
+			continue;
+		}
+
+		size_t len;
+
+		while ((len = fread(buf, 1, sizeof(buf), fp)) > 0)
+			dwStamp = ProtoSnapshotHash(dwStamp, buf, len);
+
+		fclose(fp);
+	}
+
+	return dwStamp;
+}
+
+template <typename T>
+static bool LoadProtoSnapshot(const char * c_pszFileName, const char ** c_ppszSources, std::vector<T> & rvec)
+{
+	FILE * fp = fopen(c_pszFileName, "rb");
+
+	if (!fp)
+		return false;
+
+	TProtoSnapshotHeader header;
+	std::vector<T> vec;
+	bool bOk = false;
+
+	if (fread(&header, sizeof(header), 1, fp) == 1 &&
+			header.dwMagic == PROTO_SNAPSHOT_MAGIC &&
+			header.dwVersion == PROTO_SNAPSHOT_VERSION &&
+			header.dwElemSize == sizeof(T) &&
+			header.dwCount > 0 &&
+			header.dwSourceStamp == GetProtoSourceStamp(c_ppszSources))
+	{
+		vec.resize(header.dwCount);
+
+		if (fread(&vec[0], sizeof(T), vec.size(), fp) == vec.size() &&
+				ProtoSnapshotHash(2166136261U, &vec[0], sizeof(T) * vec.size()) == header.dwChecksum)
+			bOk = true;
+	}
+
+	fclose(fp);
+
+	if (!bOk)
+	{
+		sys_log(0, "PROTO_SNAPSHOT: %s is stale or broken, reading txt", c_pszFileName);
+		return false;
+	}
+
+	if (!rvec.empty())
+		sys_log(0, "RELOAD: %s", c_pszFileName);
+
+	rvec.swap(vec);
+	sys_log(0, "PROTO_SNAPSHOT: %s loaded (%u rows)", c_pszFileName, header.dwCount);
+	return true;
+}
+
+template <typename T>
+static void SaveProtoSnapshot(const char * c_pszFileName, const char ** c_ppszSources, const std::vector<T> & c_rvec)
+{
+	if (c_rvec.empty())
+		return;
+
+	char szTempName[256];
+	snprintf(szTempName, sizeof(szTempName), "%s.tmp", c_pszFileName);
+
+	FILE * fp = fopen(szTempName, "wb");
+
+	if (!fp)
+	{
+		sys_err("PROTO_SNAPSHOT: cannot open %s", szTempName);
+		return;
+	}
+
+	TProtoSnapshotHeader header;
+	header.dwMagic = PROTO_SNAPSHOT_MAGIC;
+	header.dwVersion = PROTO_SNAPSHOT_VERSION;
+	header.dwElemSize = sizeof(T);
+	header.dwCount = c_rvec.size();
+	header.dwSourceStamp = GetProtoSourceStamp(c_ppszSources);
+	header.dwChecksum = ProtoSnapshotHash(2166136261U, &c_rvec[0], sizeof(T) * c_rvec.size());
+
+	bool bOk = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+		fwrite(&c_rvec[0], sizeof(T), c_rvec.size(), fp) == c_rvec.size();
+
+	if (fclose(fp) != 0)
+		bOk = false;
+
+	//    ٲ ־  ׾ ¥   ʰ Ѵ.
+#ifdef __WIN32__
+	if (bOk)
+		remove(c_pszFileName);
+#endif
+	if (!bOk || rename(szTempName, c_pszFileName) != 0)
+	{
+		sys_err("PROTO_SNAPSHOT: cannot write %s", c_pszFileName);
+		remove(szTempName);
+		return;
+	}
+
+	sys_log(0, "PROTO_SNAPSHOT: %s saved (%u rows)", c_pszFileName, header.dwCount);
+}
+
+static const char * s_c_apszMobProtoSources[] = { "mob_proto.txt", "mob_names.txt", "mob_proto_test.txt", NULL };
+static const char * s_c_apszItemProtoSources[] = { "item_proto.txt", "item_names.txt", "item_proto_test.txt", NULL };
+
 bool CClientManager::InitializeMobTable()
 {
 	//================== Լ  ==================//
@@ -185,6 +475,9 @@ bool CClientManager::InitializeMobTable()
 	//	5) ()  Ŭ̾Ʈ  ۵ ϴ.
 	//_______________________________________________//
 
+	if (LoadProtoSnapshot("mob_proto.bin", s_c_apszMobProtoSources, m_vec_mobTable))
+		return true;
+
 
 	//===============================================//
 	//	1) 'mob_names.txt'  о (a)[localMap]  .
@@ -420,6 +713,7 @@ bool CClientManager::InitializeMobTable()
 		}
 	}
 	sort(m_vec_mobTable.begin(), m_vec_mobTable.end(), FCompareVnum());
+	SaveProtoSnapshot("mob_proto.bin", s_c_apszMobProtoSources, m_vec_mobTable);
 	return true;
 }
 
@@ -585,6 +879,16 @@ bool CClientManager::InitializeItemTable()
 	//	5) ()  Ŭ̾Ʈ  ۵ ϴ.
 	//_______________________________________________//
 
+	if (LoadProtoSnapshot("item_proto.bin", s_c_apszItemProtoSources, m_vec_itemTable))
+	{
+		m_map_itemTableByVnum.clear();
+
+		for (itertype(m_vec_itemTable) it = m_vec_itemTable.begin(); it != m_vec_itemTable.end(); ++it)
+			m_map_itemTableByVnum.insert(std::map<DWORD, TItemTable *>::value_type(it->dwVnum, &(*it)));
+
+		return true;
+	}
+
 
 
 	//=================================================================================//
@@ -831,10 +1135,14 @@ bool CClientManager::InitializeItemTable()
 				item_table->dwRefinedVnum,
 				item_table->wRefineSet,
 				item_table->bAlterToMagicItemPct);
-
-		m_map_itemTableByVnum.insert(std::map<DWORD, TItemTable *>::value_type(item_table->dwVnum, item_table));
 	}
 	sort(m_vec_itemTable.begin(), m_vec_itemTable.end(), FCompareVnum());
+
+	// ϸ Ұ ŰǷ    ڿ .
+	for (it = m_vec_itemTable.begin(); it != m_vec_itemTable.end(); ++it)
+		m_map_itemTableByVnum.insert(std::map<DWORD, TItemTable *>::value_type(it->dwVnum, &(*it)));
+
+	SaveProtoSnapshot("item_proto.bin", s_c_apszItemProtoSources, m_vec_itemTable);
 	return true;
 }
 
@@ -957,33 +1265,17 @@ bool CClientManager::InitializeBanwordTable()
 	return true;
 }
 
-bool CClientManager::InitializeItemAttrTable()
+// Ʒ ̺ DirectQueryEach   ྿ ޾Ƽ  ü    ʴ´.
+struct FItemAttrRow
 {
-	char query[4096];
-	snprintf(query, sizeof(query),
-			"SELECT apply, apply+0, prob, lv1, lv2, lv3, lv4, lv5, weapon, body, wrist, foots, neck, head, shield, ear FROM item_attr%s ORDER BY apply",
-			GetTablePostfix());
+	std::vector<TItemAttrTable> &	m_rvec;
+	const char *			m_c_pszLogName;
 
-	std::unique_ptr<SQLMsg> pkMsg(CDBManager::instance().DirectQuery(query));
-	SQLResult * pRes = pkMsg->Get();
-
-	if (!pRes->uiNumRows)
-	{
-		sys_err("no result from item_attr");
-		return false;
-	}
-
-	if (!m_vec_itemAttrTable.empty())
+	FItemAttrRow(std::vector<TItemAttrTable> & rvec, const char * c_pszLogName) : m_rvec(rvec), m_c_pszLogName(c_pszLogName)
 	{
-		sys_log(0, "RELOAD: item_attr");
-		m_vec_itemAttrTable.clear();
 	}
 
-	m_vec_itemAttrTable.reserve(pRes->uiNumRows);
-
-	MYSQL_ROW	data;
-
-	while ((data = mysql_fetch_row(pRes->pSQLResult)))
+	bool operator () (MYSQL_ROW data)
 	{
 		TItemAttrTable t;
 
@@ -1008,7 +1300,8 @@ bool CClientManager::InitializeItemAttrTable()
 		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_SHIELD], data[col++]);
 		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_EAR], data[col++]);
 
-		sys_log(0, "ITEM_ATTR: %-20s %4lu { %3d %3d %3d %3d %3d } { %d %d %d %d %d %d %d }",
+		sys_log(0, "%s: %-20s %4lu { %3d %3d %3d %3d %3d } { %d %d %d %d %d %d %d }",
+				m_c_pszLogName,
 				t.szApply,
 				t.dwProb,
 				t.lValues[0],
@@ -1025,9 +1318,31 @@ bool CClientManager::InitializeItemAttrTable()
 				t.bMaxLevelBySet[ATTRIBUTE_SET_SHIELD],
 				t.bMaxLevelBySet[ATTRIBUTE_SET_EAR]);
 
-		m_vec_itemAttrTable.push_back(t);
+		m_rvec.push_back(t);
+		return true;
+	}
+};
+
+bool CClientManager::InitializeItemAttrTable()
+{
+	char query[4096];
+	snprintf(query, sizeof(query),
+			"SELECT apply, apply+0, prob, lv1, lv2, lv3, lv4, lv5, weapon, body, wrist, foots, neck, head, shield, ear FROM item_attr%s ORDER BY apply",
+			GetTablePostfix());
+
+	std::vector<TItemAttrTable> vec_kAttr;
+	FItemAttrRow f(vec_kAttr, "ITEM_ATTR");
+
+	if (!CDBManager::instance().DirectQueryEach(query, f) || vec_kAttr.empty())
+	{
+		sys_err("no result from item_attr");
+		return false;
 	}
 
+	if (!m_vec_itemAttrTable.empty())
+		sys_log(0, "RELOAD: item_attr");
+
+	m_vec_itemAttrTable.swap(vec_kAttr);
 	return true;
 }
 
@@ -1038,72 +1353,54 @@ bool CClientManager::InitializeItemRareTable()
 			"SELECT apply, apply+0, prob, lv1, lv2, lv3, lv4, lv5, weapon, body, wrist, foots, neck, head, shield, ear FROM item_attr_rare%s ORDER BY apply",
 			GetTablePostfix());
 
-	std::unique_ptr<SQLMsg> pkMsg(CDBManager::instance().DirectQuery(query));
-	SQLResult * pRes = pkMsg->Get();
+	std::vector<TItemAttrTable> vec_kRare;
+	FItemAttrRow f(vec_kRare, "ITEM_RARE");
 
-	if (!pRes->uiNumRows)
+	if (!CDBManager::instance().DirectQueryEach(query, f) || vec_kRare.empty())
 	{
 		sys_err("no result from item_attr_rare");
 		return false;
 	}
 
 	if (!m_vec_itemRareTable.empty())
-	{
 		sys_log(0, "RELOAD: item_attr_rare");
-		m_vec_itemRareTable.clear();
-	}
 
-	m_vec_itemRareTable.reserve(pRes->uiNumRows);
+	m_vec_itemRareTable.swap(vec_kRare);
+	return true;
+}
 
-	MYSQL_ROW	data;
+struct FLandRow
+{
+	std::vector<building::TLand> & m_rvec;
 
-	while ((data = mysql_fetch_row(pRes->pSQLResult)))
+	FLandRow(std::vector<building::TLand> & rvec) : m_rvec(rvec)
 	{
-		TItemAttrTable t;
+	}
 
-		memset(&t, 0, sizeof(TItemAttrTable));
+	bool operator () (MYSQL_ROW data)
+	{
+		building::TLand t;
+
+		memset(&t, 0, sizeof(t));
 
 		int col = 0;
 
-		strlcpy(t.szApply, data[col++], sizeof(t.szApply));
-		str_to_number(t.dwApplyIndex, data[col++]);
-		str_to_number(t.dwProb, data[col++]);
-		str_to_number(t.lValues[0], data[col++]);
-		str_to_number(t.lValues[1], data[col++]);
-		str_to_number(t.lValues[2], data[col++]);
-		str_to_number(t.lValues[3], data[col++]);
-		str_to_number(t.lValues[4], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_WEAPON], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_BODY], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_WRIST], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_FOOTS], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_NECK], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_HEAD], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_SHIELD], data[col++]);
-		str_to_number(t.bMaxLevelBySet[ATTRIBUTE_SET_EAR], data[col++]);
+		str_to_number(t.dwID, data[col++]);
+		str_to_number(t.lMapIndex, data[col++]);
+		str_to_number(t.x, data[col++]);
+		str_to_number(t.y, data[col++]);
+		str_to_number(t.width, data[col++]);
+		str_to_number(t.height, data[col++]);
+		str_to_number(t.dwGuildID, data[col++]);
+		str_to_number(t.bGuildLevelLimit, data[col++]);
+		str_to_number(t.dwPrice, data[col++]);
 
-		sys_log(0, "ITEM_RARE: %-20s %4lu { %3d %3d %3d %3d %3d } { %d %d %d %d %d %d %d }",
-				t.szApply,
-				t.dwProb,
-				t.lValues[0],
-				t.lValues[1],
-				t.lValues[2],
-				t.lValues[3],
-				t.lValues[4],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_WEAPON],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_BODY],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_WRIST],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_FOOTS],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_NECK],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_HEAD],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_SHIELD],
-				t.bMaxLevelBySet[ATTRIBUTE_SET_EAR]);
+		sys_log(0, "LAND: %lu map %-4ld %7ldx%-7ld w %-4ld h %-4ld", t.dwID, t.lMapIndex, t.x, t.y, t.width, t.height);
 
-		m_vec_itemRareTable.push_back(t);
+		m_rvec.push_back(t);
+		return true;
 	}
-
-	return true;
-}
+};
 
 bool CClientManager::InitializeLandTable()
 {
@@ -1116,43 +1413,14 @@ bool CClientManager::InitializeLandTable()
 		"FROM land%s WHERE enable='YES' ORDER BY id",
 		GetTablePostfix());
 
-	std::unique_ptr<SQLMsg> pkMsg(CDBManager::instance().DirectQuery(query));
-	SQLResult * pRes = pkMsg->Get();
-
 	if (!m_vec_kLandTable.empty())
 	{
 		sys_log(0, "RELOAD: land");
 		m_vec_kLandTable.clear();
 	}
 
-	m_vec_kLandTable.reserve(pRes->uiNumRows);
-
-	MYSQL_ROW	data;
-
-	if (pRes->uiNumRows > 0)
-		while ((data = mysql_fetch_row(pRes->pSQLResult)))
-		{
-			TLand t;
-
-			memset(&t, 0, sizeof(t));
-
-			int col = 0;
-
-			str_to_number(t.dwID, data[col++]);
-			str_to_number(t.lMapIndex, data[col++]);
-			str_to_number(t.x, data[col++]);
-			str_to_number(t.y, data[col++]);
-			str_to_number(t.width, data[col++]);
-			str_to_number(t.height, data[col++]);
-			str_to_number(t.dwGuildID, data[col++]);
-			str_to_number(t.bGuildLevelLimit, data[col++]);
-			str_to_number(t.dwPrice, data[col++]);
-
-			sys_log(0, "LAND: %lu map %-4ld %7ldx%-7ld w %-4ld h %-4ld", t.dwID, t.lMapIndex, t.x, t.y, t.width, t.height);
-
-			m_vec_kLandTable.push_back(t);
-		}
-
+	FLandRow f(m_vec_kLandTable);
+	CDBManager::instance().DirectQueryEach(query, f);
 	return true;
 }
 
@@ -1209,6 +1477,61 @@ void parse_pair_number_string(const char * c_pszString, std::vector<std::pair<in
 	}
 }
 
+struct FObjectProtoRow
+{
+	std::vector<building::TObjectProto> & m_rvec;
+
+	FObjectProtoRow(std::vector<building::TObjectProto> & rvec) : m_rvec(rvec)
+	{
+	}
+
+	bool operator () (MYSQL_ROW data)
+	{
+		building::TObjectProto t;
+
+		memset(&t, 0, sizeof(t));
+
+		int col = 0;
+
+		str_to_number(t.dwVnum, data[col++]);
+		str_to_number(t.dwPrice, data[col++]);
+
+		std::vector<std::pair<int, int> > vec;
+		parse_pair_number_string(data[col++], vec);
+
+		for (unsigned int i = 0; i < building::OBJECT_MATERIAL_MAX_NUM && i < vec.size(); ++i)
+		{
+			std::pair<int, int> & r = vec[i];
+
+			t.kMaterials[i].dwItemVnum = r.first;
+			t.kMaterials[i].dwCount = r.second;
+		}
+
+		str_to_number(t.dwUpgradeVnum, data[col++]);
+		str_to_number(t.dwUpgradeLimitTime, data[col++]);
+		str_to_number(t.lLife, data[col++]);
+		str_to_number(t.lRegion[0], data[col++]);
+		str_to_number(t.lRegion[1], data[col++]);
+		str_to_number(t.lRegion[2], data[col++]);
+		str_to_number(t.lRegion[3], data[col++]);
+
+		// ADD_BUILDING_NPC
+		str_to_number(t.dwNPCVnum, data[col++]);
+		str_to_number(t.dwGroupVnum, data[col++]);
+		str_to_number(t.dwDependOnGroupVnum, data[col++]);
+
+		t.lNPCX = 0;
+		t.lNPCY = MAX(t.lRegion[1], t.lRegion[3])+300;
+		// END_OF_ADD_BUILDING_NPC
+
+		sys_log(0, "OBJ_PROTO: vnum %lu price %lu mat %lu %lu",
+				t.dwVnum, t.dwPrice, t.kMaterials[0].dwItemVnum, t.kMaterials[0].dwCount);
+
+		m_rvec.push_back(t);
+		return true;
+	}
+};
+
 bool CClientManager::InitializeObjectProto()
 {
 	using namespace building;
@@ -1219,67 +1542,51 @@ bool CClientManager::InitializeObjectProto()
 			"FROM object_proto%s ORDER BY vnum",
 			GetTablePostfix());
 
-	std::unique_ptr<SQLMsg> pkMsg(CDBManager::instance().DirectQuery(query));
-	SQLResult * pRes = pkMsg->Get();
-
 	if (!m_vec_kObjectProto.empty())
 	{
 		sys_log(0, "RELOAD: object_proto");
 		m_vec_kObjectProto.clear();
 	}
 
-	m_vec_kObjectProto.reserve(MAX(0, pRes->uiNumRows));
-
-	MYSQL_ROW	data;
-
-	if (pRes->uiNumRows > 0)
-		while ((data = mysql_fetch_row(pRes->pSQLResult)))
-		{
-			TObjectProto t;
-
-			memset(&t, 0, sizeof(t));
-
-			int col = 0;
-
-			str_to_number(t.dwVnum, data[col++]);
-			str_to_number(t.dwPrice, data[col++]);
-
-			std::vector<std::pair<int, int> > vec;
-			parse_pair_number_string(data[col++], vec);
-
-			for (unsigned int i = 0; i < OBJECT_MATERIAL_MAX_NUM && i < vec.size(); ++i)
-			{
-				std::pair<int, int> & r = vec[i];
-
-				t.kMaterials[i].dwItemVnum = r.first;
-				t.kMaterials[i].dwCount = r.second;
-			}
+	FObjectProtoRow f(m_vec_kObjectProto);
+	CDBManager::instance().DirectQueryEach(query, f);
+	return true;
+}
 
-			str_to_number(t.dwUpgradeVnum, data[col++]);
-			str_to_number(t.dwUpgradeLimitTime, data[col++]);
-			str_to_number(t.lLife, data[col++]);
-			str_to_number(t.lRegion[0], data[col++]);
-			str_to_number(t.lRegion[1], data[col++]);
-			str_to_number(t.lRegion[2], data[col++]);
-			str_to_number(t.lRegion[3], data[col++]);
+struct FObjectRow
+{
+	std::map<DWORD, building::TObject *> & m_rmap;
 
-			// ADD_BUILDING_NPC
-			str_to_number(t.dwNPCVnum, data[col++]);
-			str_to_number(t.dwGroupVnum, data[col++]);
-			str_to_number(t.dwDependOnGroupVnum, data[col++]);
+	FObjectRow(std::map<DWORD, building::TObject *> & rmap) : m_rmap(rmap)
+	{
+	}
 
-			t.lNPCX = 0;
-			t.lNPCY = MAX(t.lRegion[1], t.lRegion[3])+300;
-			// END_OF_ADD_BUILDING_NPC
+	bool operator () (MYSQL_ROW data)
+	{
+		building::TObject * k = new building::TObject;
 
-			sys_log(0, "OBJ_PROTO: vnum %lu price %lu mat %lu %lu",
-					t.dwVnum, t.dwPrice, t.kMaterials[0].dwItemVnum, t.kMaterials[0].dwCount);
+		memset(k, 0, sizeof(building::TObject));
 
-			m_vec_kObjectProto.push_back(t);
-		}
+		int col = 0;
 
-	return true;
-}
+		str_to_number(k->dwID, data[col++]);
+		str_to_number(k->dwLandID, data[col++]);
+		str_to_number(k->dwVnum, data[col++]);
+		str_to_number(k->lMapIndex, data[col++]);
+		str_to_number(k->x, data[col++]);
+		str_to_number(k->y, data[col++]);
+		str_to_number(k->xRot, data[col++]);
+		str_to_number(k->yRot, data[col++]);
+		str_to_number(k->zRot, data[col++]);
+		str_to_number(k->lLife, data[col++]);
+
+		sys_log(0, "OBJ: %lu vnum %lu map %-4ld %7ldx%-7ld life %ld", 
+				k->dwID, k->dwVnum, k->lMapIndex, k->x, k->y, k->lLife);
+
+		m_rmap.insert(std::make_pair(k->dwID, k));
+		return true;
+	}
+};
 
 bool CClientManager::InitializeObjectTable()
 {
@@ -1288,43 +1595,14 @@ bool CClientManager::InitializeObjectTable()
 	char query[4096];
 	snprintf(query, sizeof(query), "SELECT id, land_id, vnum, map_index, x, y, x_rot, y_rot, z_rot, life FROM object%s ORDER BY id", GetTablePostfix());
 
-	std::unique_ptr<SQLMsg> pkMsg(CDBManager::instance().DirectQuery(query));
-	SQLResult * pRes = pkMsg->Get();
-
 	if (!m_map_pkObjectTable.empty())
 	{
 		sys_log(0, "RELOAD: object");
 		m_map_pkObjectTable.clear();
 	}
 
-	MYSQL_ROW data;
-
-	if (pRes->uiNumRows > 0)
-		while ((data = mysql_fetch_row(pRes->pSQLResult)))
-		{
-			TObject * k = new TObject;
-
-			memset(k, 0, sizeof(TObject));
-
-			int col = 0;
-
-			str_to_number(k->dwID, data[col++]);
-			str_to_number(k->dwLandID, data[col++]);
-			str_to_number(k->dwVnum, data[col++]);
-			str_to_number(k->lMapIndex, data[col++]);
-			str_to_number(k->x, data[col++]);
-			str_to_number(k->y, data[col++]);
-			str_to_number(k->xRot, data[col++]);
-			str_to_number(k->yRot, data[col++]);
-			str_to_number(k->zRot, data[col++]);
-			str_to_number(k->lLife, data[col++]);
-
-			sys_log(0, "OBJ: %lu vnum %lu map %-4ld %7ldx%-7ld life %ld", 
-					k->dwID, k->dwVnum, k->lMapIndex, k->x, k->y, k->lLife);
-
-			m_map_pkObjectTable.insert(std::make_pair(k->dwID, k));
-		}
-
+	FObjectRow f(m_map_pkObjectTable);
+	CDBManager::instance().DirectQueryEach(query, f);
 	return true;
 }
 
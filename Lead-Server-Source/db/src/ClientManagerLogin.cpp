@@ -7,6 +7,7 @@
 #include "Config.h"
 #include "QID.h"
 #include "Cache.h"
+#include "GuildManager.h"
 
 extern std::string g_stLocale;
 extern bool CreatePlayerTableFromRes(MYSQL_RES * res, TPlayerTable * pkTab);
@@ -188,6 +189,8 @@ void CClientManager::RESULT_LOGIN_BY_KEY(CPeer * peer, SQLMsg * msg)
 	str_to_number(info->pAccountTable->bEmpire, row[col++]);
 	info->account_index = 1;
 
+	CGuildManager::instance().RequestLoadByAccount(*info->pAccountTable);
+
 	extern std::string g_stLocale;
 	if (g_stLocale == "gb2312")
 	{
@@ -510,6 +513,7 @@ void CClientManager::QUERY_CHANGE_NAME(CPeer * peer, DWORD dwHandle, TPacketGDCh
 			"UPDATE player%s SET name='%s',change_name=0 WHERE id=%u", GetTablePostfix(), p->name, p->pid);
 
 	std::unique_ptr<SQLMsg> pMsg0(CDBManager::instance().DirectQuery(queryStr, SQL_PLAYER));
+	DropPlayerPrefetch(p->pid);
 
 	TPacketDGChangeName pdg;
 	peer->EncodeHeader(HEADER_DG_CHANGE_NAME, dwHandle, sizeof(TPacketDGChangeName));
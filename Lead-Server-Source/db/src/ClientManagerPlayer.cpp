@@ -7,11 +7,16 @@
 #include "QID.h"
 #include "ItemAwardManager.h"
 #include "Cache.h"
+#include "CacheJournal.h"
 
 
 extern std::string g_stLocale;
 extern int g_test_server;
 extern int g_log;
+extern bool g_bPlayerLoadComposite;
+extern int g_iPlayerPrefetchSeconds;
+
+bool CreatePlayerTableFromRes(MYSQL_RES * res, TPlayerTable * pkTab);
 
 //
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -69,105 +74,171 @@ bool CreateItemTableFromRes(MYSQL_RES * res, std::vector<TPlayerItem> * pVec, DW
 	return true;
 }
 
-size_t CreatePlayerSaveQuery(char * pszQuery, size_t querySize, TPlayerTable * pkTab)
+#define PLAYER_FIELD_CHANGED(field) (memcmp(&pkNew->field, &pkOld->field, sizeof(pkNew->field)) != 0)
+
+DWORD GetPlayerSaveFields(const TPlayerTable * pkNew, const TPlayerTable * pkOld)
 {
-	size_t queryLen;
-
-	queryLen = snprintf(pszQuery, querySize,
-			"UPDATE player%s SET "
-			"job = %d, "
-			"voice = %d, "
-			"dir = %d, "
-			"x = %d, "
-			"y = %d, "
-			"z = %d, "
-			"map_index = %d, "
-			"exit_x = %ld, "
-			"exit_y = %ld, "
-			"exit_map_index = %ld, "
-			"hp = %d, "
-			"mp = %d, "
-			"stamina = %d, "
-			"random_hp = %d, "
-			"random_sp = %d, "
-			"playtime = %d, "
-			"level = %d, "
-			"level_step = %d, "
-			"st = %d, "
-			"ht = %d, "
-			"dx = %d, "
-			"iq = %d, "
-			"gold = %d, "
-			"exp = %u, "
-			"stat_point = %d, "
-			"skill_point = %d, "
-			"sub_skill_point = %d, "
-			"stat_reset_count = %d, "
-			"ip = '%s', "
-			"part_main = %d, "
-			"part_hair = %d, "
-			"last_play = NOW(), "
-			"skill_group = %d, "
-			"alignment = %ld, "
-			"horse_level = %d, "
-			"horse_riding = %d, "
-			"horse_hp = %d, "
-			"horse_hp_droptime = %u, "
-			"horse_stamina = %d, "
-			"horse_skill_point = %d, "
-			,
-		GetTablePostfix(),
-		pkTab->job,
-		pkTab->voice,
-		pkTab->dir,
-		pkTab->x,
-		pkTab->y,
-		pkTab->z,
-		pkTab->lMapIndex,
-		pkTab->lExitX,
-		pkTab->lExitY,
-		pkTab->lExitMapIndex,
-		pkTab->hp,
-		pkTab->sp,
-		pkTab->stamina,
-		pkTab->sRandomHP,
-		pkTab->sRandomSP,
-		pkTab->playtime,
-		pkTab->level,
-		pkTab->level_step,
-		pkTab->st,
-		pkTab->ht,
-		pkTab->dx,
-		pkTab->iq,
-		pkTab->gold,
-		pkTab->exp,
-		pkTab->stat_point,
-		pkTab->skill_point,
-		pkTab->sub_skill_point,
-		pkTab->stat_reset_count,
-		pkTab->ip,
-		pkTab->parts[PART_MAIN],
-		pkTab->parts[PART_HAIR],
-		pkTab->skill_group,
-		pkTab->lAlignment,
-		pkTab->horse.bLevel,
-		pkTab->horse.bRiding,
-		pkTab->horse.sHealth,
-		pkTab->horse.dwHorseHealthDropTime,
-		pkTab->horse.sStamina,
-		pkTab->horse_skill_point);
-
-	// Binary  ٲٱ  ӽ 
-	static char text[8192 + 1];
-
-	CDBManager::instance().EscapeString(text, pkTab->skills, sizeof(pkTab->skills));
-	queryLen += snprintf(pszQuery + queryLen, querySize - queryLen, "skill_level = '%s', ", text);
-
-	CDBManager::instance().EscapeString(text, pkTab->quickslot, sizeof(pkTab->quickslot));
-	queryLen += snprintf(pszQuery + queryLen, querySize - queryLen, "quickslot = '%s' ", text);
-
-	queryLen += snprintf(pszQuery + queryLen, querySize - queryLen, " WHERE id=%d", pkTab->id);
-	return queryLen;
+	DWORD dwFields = 0;
+
+	if (PLAYER_FIELD_CHANGED(job) || PLAYER_FIELD_CHANGED(voice) || PLAYER_FIELD_CHANGED(ip) ||
+			PLAYER_FIELD_CHANGED(parts[PART_MAIN]) || PLAYER_FIELD_CHANGED(parts[PART_HAIR]) ||
+			PLAYER_FIELD_CHANGED(skill_group) || PLAYER_FIELD_CHANGED(lAlignment))
+		dwFields |= PLAYER_SAVE_BASIC;
+
+	if (PLAYER_FIELD_CHANGED(dir) || PLAYER_FIELD_CHANGED(x) || PLAYER_FIELD_CHANGED(y) || PLAYER_FIELD_CHANGED(z) ||
+			PLAYER_FIELD_CHANGED(lMapIndex) || PLAYER_FIELD_CHANGED(lExitX) || PLAYER_FIELD_CHANGED(lExitY) ||
+			PLAYER_FIELD_CHANGED(lExitMapIndex))
+		dwFields |= PLAYER_SAVE_POSITION;
+
+	if (PLAYER_FIELD_CHANGED(hp) || PLAYER_FIELD_CHANGED(sp) || PLAYER_FIELD_CHANGED(stamina) ||
+			PLAYER_FIELD_CHANGED(sRandomHP) || PLAYER_FIELD_CHANGED(sRandomSP))
+		dwFields |= PLAYER_SAVE_POINT;
+
+	if (PLAYER_FIELD_CHANGED(playtime))
+		dwFields |= PLAYER_SAVE_PLAYTIME;
+
+	if (PLAYER_FIELD_CHANGED(level) || PLAYER_FIELD_CHANGED(level_step) || PLAYER_FIELD_CHANGED(exp))
+		dwFields |= PLAYER_SAVE_LEVEL;
+
+	if (PLAYER_FIELD_CHANGED(st) || PLAYER_FIELD_CHANGED(ht) || PLAYER_FIELD_CHANGED(dx) || PLAYER_FIELD_CHANGED(iq) ||
+			PLAYER_FIELD_CHANGED(stat_point) || PLAYER_FIELD_CHANGED(skill_point) ||
+			PLAYER_FIELD_CHANGED(sub_skill_point) || PLAYER_FIELD_CHANGED(stat_reset_count))
+		dwFields |= PLAYER_SAVE_STAT;
+
+	if (PLAYER_FIELD_CHANGED(gold))
+		dwFields |= PLAYER_SAVE_GOLD;
+
+	if (PLAYER_FIELD_CHANGED(horse) || PLAYER_FIELD_CHANGED(horse_skill_point))
+		dwFields |= PLAYER_SAVE_HORSE;
+
+	if (PLAYER_FIELD_CHANGED(skills))
+		dwFields |= PLAYER_SAVE_SKILL;
+
+	if (PLAYER_FIELD_CHANGED(quickslot))
+		dwFields |= PLAYER_SAVE_QUICKSLOT;
+
+	return dwFields;
+}
+
+#undef PLAYER_FIELD_CHANGED
+
+// ÷  Bind  ƾ ϹǷ    ĥ .
+void CreatePlayerSaveStmt(CStmtQuery & rkQuery, TPlayerTable * pkTab, DWORD dwFields)
+{
+	char szQuery[QUERY_MAX_LEN];
+	snprintf(szQuery, sizeof(szQuery), "UPDATE player%s SET ", GetTablePostfix());
+
+	std::string stQuery(szQuery);
+
+	if (dwFields & PLAYER_SAVE_BASIC)
+		stQuery += "job = ?, voice = ?, ip = ?, part_main = ?, part_hair = ?, skill_group = ?, alignment = ?, ";
+
+	if (dwFields & PLAYER_SAVE_POSITION)
+		stQuery += "dir = ?, x = ?, y = ?, z = ?, map_index = ?, exit_x = ?, exit_y = ?, exit_map_index = ?, ";
+
+	if (dwFields & PLAYER_SAVE_POINT)
+		stQuery += "hp = ?, mp = ?, stamina = ?, random_hp = ?, random_sp = ?, ";
+
+	if (dwFields & PLAYER_SAVE_PLAYTIME)
+		stQuery += "playtime = ?, ";
+
+	if (dwFields & PLAYER_SAVE_LEVEL)
+		stQuery += "level = ?, level_step = ?, exp = ?, ";
+
+	if (dwFields & PLAYER_SAVE_STAT)
+		stQuery += "st = ?, ht = ?, dx = ?, iq = ?, stat_point = ?, skill_point = ?, sub_skill_point = ?, stat_reset_count = ?, ";
+
+	if (dwFields & PLAYER_SAVE_GOLD)
+		stQuery += "gold = ?, ";
+
+	if (dwFields & PLAYER_SAVE_HORSE)
+		stQuery += "horse_level = ?, horse_riding = ?, horse_hp = ?, horse_hp_droptime = ?, horse_stamina = ?, horse_skill_point = ?, ";
+
+	if (dwFields & PLAYER_SAVE_SKILL)
+		stQuery += "skill_level = ?, ";
+
+	if (dwFields & PLAYER_SAVE_QUICKSLOT)
+		stQuery += "quickslot = ?, ";
+
+	stQuery += "last_play = NOW() WHERE id=?";
+
+	rkQuery.SetQuery(stQuery.c_str());
+
+	if (dwFields & PLAYER_SAVE_BASIC)
+	{
+		rkQuery.BindSigned(pkTab->job);
+		rkQuery.BindSigned(pkTab->voice);
+		rkQuery.BindString(pkTab->ip);
+		rkQuery.BindSigned(pkTab->parts[PART_MAIN]);
+		rkQuery.BindSigned(pkTab->parts[PART_HAIR]);
+		rkQuery.BindSigned(pkTab->skill_group);
+		rkQuery.BindSigned(pkTab->lAlignment);
+	}
+
+	if (dwFields & PLAYER_SAVE_POSITION)
+	{
+		rkQuery.BindSigned(pkTab->dir);
+		rkQuery.BindSigned(pkTab->x);
+		rkQuery.BindSigned(pkTab->y);
+		rkQuery.BindSigned(pkTab->z);
+		rkQuery.BindSigned(pkTab->lMapIndex);
+		rkQuery.BindSigned(pkTab->lExitX);
+		rkQuery.BindSigned(pkTab->lExitY);
+		rkQuery.BindSigned(pkTab->lExitMapIndex);
+	}
+
+	if (dwFields & PLAYER_SAVE_POINT)
+	{
+		rkQuery.BindSigned(pkTab->hp);
+		rkQuery.BindSigned(pkTab->sp);
+		rkQuery.BindSigned(pkTab->stamina);
+		rkQuery.BindSigned(pkTab->sRandomHP);
+		rkQuery.BindSigned(pkTab->sRandomSP);
+	}
+
+	if (dwFields & PLAYER_SAVE_PLAYTIME)
+		rkQuery.BindSigned(pkTab->playtime);
+
+	if (dwFields & PLAYER_SAVE_LEVEL)
+	{
+		rkQuery.BindSigned(pkTab->level);
+		rkQuery.BindSigned(pkTab->level_step);
+		rkQuery.BindUnsigned(pkTab->exp);
+	}
+
+	if (dwFields & PLAYER_SAVE_STAT)
+	{
+		rkQuery.BindSigned(pkTab->st);
+		rkQuery.BindSigned(pkTab->ht);
+		rkQuery.BindSigned(pkTab->dx);
+		rkQuery.BindSigned(pkTab->iq);
+		rkQuery.BindSigned(pkTab->stat_point);
+		rkQuery.BindSigned(pkTab->skill_point);
+		rkQuery.BindSigned(pkTab->sub_skill_point);
+		rkQuery.BindSigned(pkTab->stat_reset_count);
+	}
+
+	if (dwFields & PLAYER_SAVE_GOLD)
+		rkQuery.BindSigned(pkTab->gold);
+
+	if (dwFields & PLAYER_SAVE_HORSE)
+	{
+		rkQuery.BindSigned(pkTab->horse.bLevel);
+		rkQuery.BindSigned(pkTab->horse.bRiding);
+		rkQuery.BindSigned(pkTab->horse.sHealth);
+		rkQuery.BindUnsigned(pkTab->horse.dwHorseHealthDropTime);
+		rkQuery.BindSigned(pkTab->horse.sStamina);
+		rkQuery.BindSigned(pkTab->horse_skill_point);
+	}
+
+	// ̳ʸ ״ Ƿ escape  ʴ´.
+	if (dwFields & PLAYER_SAVE_SKILL)
+		rkQuery.BindBlob(pkTab->skills, sizeof(pkTab->skills));
+
+	if (dwFields & PLAYER_SAVE_QUICKSLOT)
+		rkQuery.BindBlob(pkTab->quickslot, sizeof(pkTab->quickslot));
+
+	rkQuery.BindUnsigned(pkTab->id);
 }
 
 CPlayerTableCache * CClientManager::GetPlayerCache(DWORD id)
@@ -182,6 +253,33 @@ CPlayerTableCache * CClientManager::GetPlayerCache(DWORD id)
 	return it->second;
 }
 
+void CClientManager::RESULT_PLAYER_SAVE(SQLMsg * pMsg)
+{
+	CQueryInfo * qi = (CQueryInfo *) pMsg->pvUserData;
+	std::unique_ptr<ClientHandleInfo> info((ClientHandleInfo *) qi->pvData);
+
+	if (pMsg->uiSQLErrno == 0)
+		return;
+
+	sys_err("PLAYER_SAVE failed: pid %u errno %u", info->player_id, pMsg->uiSQLErrno);
+
+	TPlayerTableCacheMap::iterator it = m_map_playerCache.find(info->player_id);
+
+	// α׾ƿϸ ĳð  ǻ츱  .
+	if (it == m_map_playerCache.end())
+		return;
+
+	CPlayerTableCache * c = it->second;
+	c->OnFlushFailed();
+
+	// üũƮ ÷õ   ο   Ƿ ٽ ´.
+	CCacheJournal::instance().AppendPlayer(c->Get(false));
+
+	//  ĳô ٽ ť  ٷ  Flush ǹǷ  Put ̳   ̰ д.
+	if (!c->CheckTimeout())
+		QueuePlayerCache(c);
+}
+
 void CClientManager::PutPlayerCache(TPlayerTable * pNew)
 {
 	CPlayerTableCache * c;
@@ -194,7 +292,9 @@ void CClientManager::PutPlayerCache(TPlayerTable * pNew)
 		m_map_playerCache.insert(TPlayerTableCacheMap::value_type(pNew->id, c));
 	}
 
+	CCacheJournal::instance().AppendPlayer(pNew);
 	c->Put(pNew);
+	QueuePlayerCache(c);
 }
 
 /*
@@ -210,6 +310,9 @@ void CClientManager::QUERY_PLAYER_LOAD(CPeer * peer, DWORD dwHandle, TPlayerLoad
 	//
 	CLoginData * pLoginData = GetLoginDataByAID(packet->account_id);
 
+	//     Ⱑ  б⺸   Ѵ.
+	FlushGroupCommit();
+
 	if (pLoginData)
 	{
 		for (int n = 0; n < PLAYER_PER_ACCOUNT; ++n)
@@ -255,12 +358,18 @@ void CClientManager::QUERY_PLAYER_LOAD(CPeer * peer, DWORD dwHandle, TPlayerLoad
 			peer->Encode( &logInfo, sizeof(TPacketNeedLoginLogInfo) );
 		}
 
-		char szQuery[1024] = { 0, };
-
 		TItemCacheSet * pSet = GetItemCacheSet(pTab->id);
 
 		sys_log(0, "[PLAYER_LOAD] ID %s pid %d gold %d ", pTab->name, pTab->id, pTab->gold);
 
+		//   ھ , Ʈ, Ʈ  ھ  Ѱ ⼭  ʴ´.
+		//   Ѱܹ  ״ Ƿ DB    Ʈ   ɸ.
+		if (packet->bHandoff)
+		{
+			sys_log(0, "[PLAYER_LOAD] handoff pid %d", pTab->id);
+			return;
+		}
+
 		//--------------------------------------------
 		//  & AFFECT & QUEST ε : 
 		//--------------------------------------------
@@ -272,73 +381,45 @@ void CClientManager::QUERY_PLAYER_LOAD(CPeer * peer, DWORD dwHandle, TPlayerLoad
 		/////////////////////////////////////////////
 		if (pSet)
 		{
-			static std::vector<TPlayerItem> s_items;
-			s_items.resize(pSet->size());
-
 			DWORD dwCount = 0;
-			TItemCacheSet::iterator it = pSet->begin();
+			TItemCacheSet::iterator it;
 
-			while (it != pSet->end())
-			{
-				CItemCache * c = *it++;
-				TPlayerItem * p = c->Get();
-
-				if (p->vnum) // vnum   ̴.
-					thecore_memcpy(&s_items[dwCount++], p, sizeof(TPlayerItem));
-			}
+			for (it = pSet->begin(); it != pSet->end(); ++it)
+				if ((*it)->Get()->vnum) // vnum   ̴.
+					++dwCount;
 
 			if (g_test_server)
 				sys_log(0, "ITEM_CACHE: HIT! %s count: %u", pTab->name, dwCount);
 
-			peer->EncodeHeader(HEADER_DG_ITEM_LOAD, dwHandle, sizeof(DWORD) + sizeof(TPlayerItem) * dwCount);
-			peer->EncodeDWORD(dwCount);
+			// ĳÿ  ۷ ٷ Ѵ.
+			char * pc = (char *) peer->EncodePacket(HEADER_DG_ITEM_LOAD, dwHandle, sizeof(DWORD) + sizeof(TPlayerItem) * dwCount);
+
+			if (pc)
+			{
+				thecore_memcpy(pc, &dwCount, sizeof(DWORD));
+				pc += sizeof(DWORD);
 
-			if (dwCount)
-				peer->Encode(&s_items[0], sizeof(TPlayerItem) * dwCount);
+				for (it = pSet->begin(); it != pSet->end(); ++it)
+				{
+					TPlayerItem * p = (*it)->Get();
 
-			// Quest
-			snprintf(szQuery, sizeof(szQuery),
-					"SELECT dwPID,szName,szState,lValue FROM quest%s WHERE dwPID=%d AND lValue<>0",
-					GetTablePostfix(), pTab->id);
-			
-			CDBManager::instance().ReturnQuery(szQuery, QID_QUEST, peer->GetHandle(), new ClientHandleInfo(dwHandle,0,packet->account_id));
+					if (!p->vnum)
+						continue;
 
-			// Affect
-			snprintf(szQuery, sizeof(szQuery),
-					"SELECT dwPID,bType,bApplyOn,lApplyValue,dwFlag,lDuration,lSPCost FROM affect%s WHERE dwPID=%d",
-					GetTablePostfix(), pTab->id);
-			CDBManager::instance().ReturnQuery(szQuery, QID_AFFECT, peer->GetHandle(), new ClientHandleInfo(dwHandle, packet->player_id));
+					thecore_memcpy(pc, p, sizeof(TPlayerItem));
+					pc += sizeof(TPlayerItem);
+				}
+			}
+
+			// Quest, Affect
+			QueryPlayerLoad(peer, dwHandle, pTab->id, packet->account_id, QID_QUEST, true);
 		}
 		/////////////////////////////////////////////
 		// 2)  DBCache   : DB   
 		/////////////////////////////////////////////
 		else
 		{
-			snprintf(szQuery, sizeof(szQuery), 
-					"SELECT id,window+0,pos,count,vnum,socket0,socket1,socket2,attrtype0,attrvalue0,attrtype1,attrvalue1,attrtype2,attrvalue2,attrtype3,attrvalue3,attrtype4,attrvalue4,attrtype5,attrvalue5,attrtype6,attrvalue6 "
-					"FROM item%s WHERE owner_id=%d AND (window < %d or window = %d)",
-					GetTablePostfix(), pTab->id, SAFEBOX, DRAGON_SOUL_INVENTORY);
-
-			CDBManager::instance().ReturnQuery(szQuery,
-					QID_ITEM,
-					peer->GetHandle(),
-					new ClientHandleInfo(dwHandle, pTab->id));
-			snprintf(szQuery, sizeof(szQuery), 
-					"SELECT dwPID, szName, szState, lValue FROM quest%s WHERE dwPID=%d",
-					GetTablePostfix(), pTab->id);
-
-			CDBManager::instance().ReturnQuery(szQuery,
-					QID_QUEST,
-					peer->GetHandle(),
-					new ClientHandleInfo(dwHandle, pTab->id));
-			snprintf(szQuery, sizeof(szQuery), 
-					"SELECT dwPID, bType, bApplyOn, lApplyValue, dwFlag, lDuration, lSPCost FROM affect%s WHERE dwPID=%d",
-					GetTablePostfix(), pTab->id);
-
-			CDBManager::instance().ReturnQuery(szQuery,
-					QID_AFFECT,
-					peer->GetHandle(),
-					new ClientHandleInfo(dwHandle, pTab->id));
+			QueryPlayerLoad(peer, dwHandle, pTab->id, packet->account_id, QID_ITEM, false);
 		}
 		//ljw
 		//return;
@@ -350,52 +431,216 @@ void CClientManager::QUERY_PLAYER_LOAD(CPeer * peer, DWORD dwHandle, TPlayerLoad
 	{
 		sys_log(0, "[PLAYER_LOAD] Load from PlayerDB pid[%d]", packet->player_id);
 
-		char queryStr[QUERY_MAX_LEN];
+		TPlayerTable tab;
 
+		//  α  ̸ о  ĳ   player  Ѵ.
+		if (PopPlayerPrefetch(packet->player_id, &tab))
+		{
+			sys_log(0, "[PLAYER_LOAD] prefetched pid[%d]", packet->player_id);
+
+			ClientHandleInfo kInfo(dwHandle, packet->player_id, packet->account_id);
+			RESULT_PLAYER_LOAD(peer, &tab, &kInfo);
+
+			if (!packet->bHandoff)
+				QueryPlayerLoad(peer, dwHandle, packet->player_id, packet->account_id, QID_ITEM, false);
+		}
+		// Ѱܹ   ĳÿ   player  д´.
+		else if (packet->bHandoff)
+			QueryPlayerLoad(peer, dwHandle, packet->player_id, packet->account_id, QID_PLAYER, false, QID_PLAYER);
+		else
+			QueryPlayerLoad(peer, dwHandle, packet->player_id, packet->account_id, QID_PLAYER, false);
+	}
+}
+
+static int FormatPlayerLoadQuery(char * pszQuery, size_t size, DWORD dwQID, DWORD dwPID, bool bQuestValueOnly)
+{
+	switch (dwQID)
+	{
 		//--------------------------------------------------------------
-		// ĳ   :  DB 
+		// ĳ   
 		//--------------------------------------------------------------
-		snprintf(queryStr, sizeof(queryStr),
-				"SELECT "
-				"id,name,job,voice,dir,x,y,z,map_index,exit_x,exit_y,exit_map_index,hp,mp,stamina,random_hp,random_sp,playtime,"
-				"gold,level,level_step,st,ht,dx,iq,exp,"
-				"stat_point,skill_point,sub_skill_point,stat_reset_count,part_base,part_hair,"
-				"skill_level,quickslot,skill_group,alignment,horse_level,horse_riding,horse_hp,horse_hp_droptime,horse_stamina,"
-				"UNIX_TIMESTAMP(NOW())-UNIX_TIMESTAMP(last_play),horse_skill_point FROM player%s WHERE id=%d",
-				GetTablePostfix(), packet->player_id);
-
-		ClientHandleInfo * pkInfo = new ClientHandleInfo(dwHandle, packet->player_id);
-		pkInfo->account_id = packet->account_id;
-		CDBManager::instance().ReturnQuery(queryStr, QID_PLAYER, peer->GetHandle(), pkInfo);
+		case QID_PLAYER:
+			return snprintf(pszQuery, size,
+					"SELECT "
+					"id,name,job,voice,dir,x,y,z,map_index,exit_x,exit_y,exit_map_index,hp,mp,stamina,random_hp,random_sp,playtime,"
+					"gold,level,level_step,st,ht,dx,iq,exp,"
+					"stat_point,skill_point,sub_skill_point,stat_reset_count,part_base,part_hair,"
+					"skill_level,quickslot,skill_group,alignment,horse_level,horse_riding,horse_hp,horse_hp_droptime,horse_stamina,"
+					"UNIX_TIMESTAMP(NOW())-UNIX_TIMESTAMP(last_play),horse_skill_point FROM player%s WHERE id=%d",
+					GetTablePostfix(), dwPID);
 
 		//--------------------------------------------------------------
 		//   
 		//--------------------------------------------------------------
-		snprintf(queryStr, sizeof(queryStr),
-				"SELECT id,window+0,pos,count,vnum,socket0,socket1,socket2,attrtype0,attrvalue0,attrtype1,attrvalue1,attrtype2,attrvalue2,attrtype3,attrvalue3,attrtype4,attrvalue4,attrtype5,attrvalue5,attrtype6,attrvalue6 "
-				"FROM item%s WHERE owner_id=%d AND (window < %d or window = %d)",
-				GetTablePostfix(), packet->player_id, SAFEBOX, DRAGON_SOUL_INVENTORY);
-		CDBManager::instance().ReturnQuery(queryStr, QID_ITEM, peer->GetHandle(), new ClientHandleInfo(dwHandle, packet->player_id));
+		case QID_ITEM:
+			return snprintf(pszQuery, size,
+					"SELECT id,window+0,pos,count,vnum,socket0,socket1,socket2,attrtype0,attrvalue0,attrtype1,attrvalue1,attrtype2,attrvalue2,attrtype3,attrvalue3,attrtype4,attrvalue4,attrtype5,attrvalue5,attrtype6,attrvalue6 "
+					"FROM item%s WHERE owner_id=%d AND (window < %d or window = %d)",
+					GetTablePostfix(), dwPID, SAFEBOX, DRAGON_SOUL_INVENTORY);
 
 		//--------------------------------------------------------------
 		// QUEST  
 		//--------------------------------------------------------------
-		snprintf(queryStr, sizeof(queryStr),
-				"SELECT dwPID,szName,szState,lValue FROM quest%s WHERE dwPID=%d",
-				GetTablePostfix(), packet->player_id);
-		CDBManager::instance().ReturnQuery(queryStr, QID_QUEST, peer->GetHandle(), new ClientHandleInfo(dwHandle, packet->player_id,packet->account_id));
-		//  ɿ item_award̺ login   account id Ѱش
+		case QID_QUEST:
+			return snprintf(pszQuery, size,
+					"SELECT dwPID,szName,szState,lValue FROM quest%s WHERE dwPID=%d%s",
+					GetTablePostfix(), dwPID, bQuestValueOnly ? " AND lValue<>0" : "");
+
 		//--------------------------------------------------------------
 		// AFFECT  
 		//--------------------------------------------------------------
-		snprintf(queryStr, sizeof(queryStr),
-				"SELECT dwPID,bType,bApplyOn,lApplyValue,dwFlag,lDuration,lSPCost FROM affect%s WHERE dwPID=%d",
-				GetTablePostfix(), packet->player_id);
-		CDBManager::instance().ReturnQuery(queryStr, QID_AFFECT, peer->GetHandle(), new ClientHandleInfo(dwHandle, packet->player_id));
+		case QID_AFFECT:
+			return snprintf(pszQuery, size,
+					"SELECT dwPID,bType,bApplyOn,lApplyValue,dwFlag,lDuration,lSPCost FROM affect%s WHERE dwPID=%d",
+					GetTablePostfix(), dwPID);
 	}
-	
-	
+
+	return 0;
 }
+
+// dwFirstQID  dwLastQID  ʷ д´.
+// g_bPlayerLoadComposite ̸       ޾   óѴ.
+void CClientManager::QueryPlayerLoad(CPeer * peer, DWORD dwHandle, DWORD dwPID, DWORD dwAID, DWORD dwFirstQID, bool bQuestValueOnly, DWORD dwLastQID)
+{
+	char szQuery[QUERY_MAX_LEN];
+
+	// ģ   ׻ QID_AFFECT    óϹǷ  ٸ  .
+	if (g_bPlayerLoadComposite && dwFirstQID < QID_AFFECT && dwLastQID == QID_AFFECT)
+	{
+		int len = 0;
+
+		for (DWORD dwQID = dwFirstQID; dwQID <= QID_AFFECT; ++dwQID)
+		{
+			if (len)
+				szQuery[len++] = ';';
+
+			len += FormatPlayerLoadQuery(szQuery + len, sizeof(szQuery) - len, dwQID, dwPID, bQuestValueOnly);
+
+			if (len >= (int) sizeof(szQuery) - 1)
+			{
+				sys_err("composite player load query too long pid %u", dwPID);
+				return;
+			}
+		}
+
+		int iType = dwFirstQID == QID_PLAYER ? QID_PLAYER_COMPOSITE : dwFirstQID == QID_ITEM ? QID_ITEM_COMPOSITE : QID_QUEST_COMPOSITE;
+
+		//   item id  Ű  ῡ Ƿ item  д  ռ Ⱑ   ڿ .
+		CDBManager::instance().ReturnQuery(szQuery, iType, peer->GetHandle(), new ClientHandleInfo(dwHandle, dwPID, dwAID), SQL_PLAYER, dwPID,
+				dwFirstQID <= QID_ITEM);
+		return;
+	}
+
+	for (DWORD dwQID = dwFirstQID; dwQID <= dwLastQID; ++dwQID)
+	{
+		FormatPlayerLoadQuery(szQuery, sizeof(szQuery), dwQID, dwPID, bQuestValueOnly);
+		CDBManager::instance().ReturnQuery(szQuery, dwQID, peer->GetHandle(), new ClientHandleInfo(dwHandle, dwPID, dwAID), SQL_PLAYER, dwPID,
+				dwQID == QID_ITEM);
+	}
+}
+
+/*
+ * PLAYER PREFETCH
+ */
+void CClientManager::PrefetchAccountPlayers(DWORD dwAID)
+{
+	if (g_iPlayerPrefetchSeconds <= 0)
+		return;
+
+	char szQuery[256];
+	snprintf(szQuery, sizeof(szQuery), "SELECT id FROM player%s WHERE account_id=%u", GetTablePostfix(), dwAID);
+
+	CDBManager::instance().ReturnQuery(szQuery, QID_PLAYER_PREFETCH_INDEX, 0, new ClientHandleInfo(0, 0, dwAID), SQL_PLAYER, dwAID);
+}
+
+void CClientManager::RESULT_PLAYER_PREFETCH_INDEX(SQLMsg * pMsg)
+{
+	CQueryInfo * qi = (CQueryInfo *) pMsg->pvUserData;
+	std::unique_ptr<ClientHandleInfo> info((ClientHandleInfo *) qi->pvData);
+
+	MYSQL_RES * pSQLResult = pMsg->Get()->pSQLResult;
+
+	if (!pSQLResult)
+		return;
+
+	char szQuery[QUERY_MAX_LEN];
+	MYSQL_ROW row;
+
+	while ((row = mysql_fetch_row(pSQLResult)))
+	{
+		DWORD dwPID = 0;
+		str_to_number(dwPID, row[0]);
+
+		// ĳÿ ִ  ĳð ´.
+		if (!dwPID || GetPlayerCache(dwPID))
+			continue;
+
+		//  pid  Ű   ĳ   ڿ  Ѵ.
+		FormatPlayerLoadQuery(szQuery, sizeof(szQuery), QID_PLAYER, dwPID, false);
+		CDBManager::instance().ReturnQuery(szQuery, QID_PLAYER_PREFETCH, 0, new ClientHandleInfo(0, dwPID, info->account_id), SQL_PLAYER, dwPID);
+	}
+}
+
+void CClientManager::RESULT_PLAYER_PREFETCH(SQLMsg * pMsg)
+{
+	CQueryInfo * qi = (CQueryInfo *) pMsg->pvUserData;
+	std::unique_ptr<ClientHandleInfo> info((ClientHandleInfo *) qi->pvData);
+
+	MYSQL_RES * pSQLResult = pMsg->Get()->pSQLResult;
+
+	if (!pSQLResult || GetPlayerCache(info->player_id))
+		return;
+
+	TPlayerPrefetch & r = m_map_playerPrefetch[info->player_id];
+
+	if (!CreatePlayerTableFromRes(pSQLResult, &r.table))
+	{
+		m_map_playerPrefetch.erase(info->player_id);
+		return;
+	}
+
+	r.time = time(0);
+}
+
+bool CClientManager::PopPlayerPrefetch(DWORD pid, TPlayerTable * pTab)
+{
+	TPlayerPrefetchMap::iterator it = m_map_playerPrefetch.find(pid);
+
+	if (it == m_map_playerPrefetch.end())
+		return false;
+
+	time_t tElapsed = time(0) - it->second.time;
+	bool bValid = tElapsed <= g_iPlayerPrefetchSeconds;
+
+	if (bValid)
+	{
+		thecore_memcpy(pTab, &it->second.table, sizeof(TPlayerTable));
+		pTab->logoff_interval += tElapsed;
+	}
+
+	m_map_playerPrefetch.erase(it);
+	return bValid;
+}
+
+void CClientManager::DropPlayerPrefetch(DWORD pid)
+{
+	m_map_playerPrefetch.erase(pid);
+}
+
+void CClientManager::UpdatePlayerPrefetch()
+{
+	time_t tNow = time(0);
+	TPlayerPrefetchMap::iterator it = m_map_playerPrefetch.begin();
+
+	while (it != m_map_playerPrefetch.end())
+	{
+		if (tNow - it->second.time > g_iPlayerPrefetchSeconds)
+			it = m_map_playerPrefetch.erase(it);
+		else
+			++it;
+	}
+}
+
 void CClientManager::ItemAward(CPeer * peer,char* login)
 {
 	char login_t[LOGIN_MAX_LEN + 1] = "";
@@ -543,25 +788,57 @@ void CClientManager::RESULT_COMPOSITE_PLAYER(CPeer * peer, SQLMsg * pMsg, DWORD
 		return;
 	}
 
+	RESULT_COMPOSITE_PLAYER_PART(peer, pSQLResult, dwQID, info.get());
+}
+
+// QueryPlayerLoad      .   dwFirstQID  QID_AFFECT .
+void CClientManager::RESULT_COMPOSITE_PLAYER_MULTI(CPeer * peer, SQLMsg * pMsg, DWORD dwFirstQID)
+{
+	CQueryInfo * qi = (CQueryInfo *) pMsg->pvUserData;
+	std::unique_ptr<ClientHandleInfo> info((ClientHandleInfo *) qi->pvData);
+
+	for (DWORD dwQID = dwFirstQID; dwQID <= QID_AFFECT; ++dwQID)
+	{
+		SQLResult * pRes = pMsg->Get();
+
+		// ߰  ϸ     ʴ´.
+		if (!pRes || !pRes->pSQLResult)
+		{
+			sys_err("null MYSQL_RES QID %u (composite %d) pid %u", dwQID, qi->iType, info->player_id);
+			return;
+		}
+
+		RESULT_COMPOSITE_PLAYER_PART(peer, pRes->pSQLResult, dwQID, info.get());
+
+		if (dwQID != QID_AFFECT && !pMsg->Next())
+		{
+			sys_err("missing result after QID %u (composite %d) pid %u", dwQID, qi->iType, info->player_id);
+			return;
+		}
+	}
+}
+
+void CClientManager::RESULT_COMPOSITE_PLAYER_PART(CPeer * peer, MYSQL_RES * pSQLResult, DWORD dwQID, ClientHandleInfo * pkInfo)
+{
 	switch (dwQID)
 	{
 		case QID_PLAYER:
-			sys_log(0, "QID_PLAYER %u %u", info->dwHandle, info->player_id);
-			RESULT_PLAYER_LOAD(peer, pSQLResult, info.get());
+			sys_log(0, "QID_PLAYER %u %u", pkInfo->dwHandle, pkInfo->player_id);
+			RESULT_PLAYER_LOAD(peer, pSQLResult, pkInfo);
 
 			break;
 
 		case QID_ITEM:
-			sys_log(0, "QID_ITEM %u", info->dwHandle);
-			RESULT_ITEM_LOAD(peer, pSQLResult, info->dwHandle, info->player_id);
+			sys_log(0, "QID_ITEM %u", pkInfo->dwHandle);
+			RESULT_ITEM_LOAD(peer, pSQLResult, pkInfo->dwHandle, pkInfo->player_id);
 			break;
 
 		case QID_QUEST:
 			{
-				sys_log(0, "QID_QUEST %u", info->dwHandle);
-				RESULT_QUEST_LOAD(peer, pSQLResult, info->dwHandle, info->player_id);
+				sys_log(0, "QID_QUEST %u", pkInfo->dwHandle);
+				RESULT_QUEST_LOAD(peer, pSQLResult, pkInfo->dwHandle, pkInfo->player_id);
 				//aid
-				ClientHandleInfo*  temp1 = info.get();
+				ClientHandleInfo*  temp1 = pkInfo;
 				if (temp1 == NULL)
 					break;
 				
@@ -577,7 +854,7 @@ void CClientManager::RESULT_COMPOSITE_PLAYER(CPeer * peer, SQLMsg * pMsg, DWORD
 			break;
 
 		case QID_AFFECT:
-			sys_log(0, "QID_AFFECT %u", info->dwHandle);
+			sys_log(0, "QID_AFFECT %u", pkInfo->dwHandle);
 
 			// fix: if there are no affects, make an empty one to send the packet
 			if (!mysql_num_rows(pSQLResult))
@@ -585,14 +862,14 @@ void CClientManager::RESULT_COMPOSITE_PLAYER(CPeer * peer, SQLMsg * pMsg, DWORD
 				TPacketAffectElement pAffElem{};
 				DWORD dwCount = 0;
 
-				peer->EncodeHeader(HEADER_DG_AFFECT_LOAD, info->dwHandle, sizeof(DWORD) + sizeof(DWORD) + sizeof(TPacketAffectElement) * dwCount);
-				peer->Encode(&info->player_id, sizeof(DWORD));
+				peer->EncodeHeader(HEADER_DG_AFFECT_LOAD, pkInfo->dwHandle, sizeof(DWORD) + sizeof(DWORD) + sizeof(TPacketAffectElement) * dwCount);
+				peer->Encode(&pkInfo->player_id, sizeof(DWORD));
 				peer->Encode(&dwCount, sizeof(DWORD));
 				peer->Encode(&pAffElem, sizeof(TPacketAffectElement) * dwCount);
 				break;
 			}
 
-			RESULT_AFFECT_LOAD(peer, pSQLResult, info->dwHandle);
+			RESULT_AFFECT_LOAD(peer, pSQLResult, pkInfo->dwHandle);
 			break;
 	}
 	
@@ -608,6 +885,13 @@ void CClientManager::RESULT_PLAYER_LOAD(CPeer * peer, MYSQL_RES * pRes, ClientHa
 		return;
 	}
 
+	RESULT_PLAYER_LOAD(peer, &tab, pkInfo);
+}
+
+void CClientManager::RESULT_PLAYER_LOAD(CPeer * peer, TPlayerTable * pTab, ClientHandleInfo * pkInfo)
+{
+	TPlayerTable & tab = *pTab;
+
 	CLoginData * pkLD = GetLoginDataByAID(pkInfo->account_id);
 	
 	if (!pkLD || pkLD->IsPlay())
@@ -642,8 +926,15 @@ void CClientManager::RESULT_ITEM_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwHa
 	CreateItemTableFromRes(pRes, &s_items, dwPID);
 	DWORD dwCount = s_items.size();
 
-	peer->EncodeHeader(HEADER_DG_ITEM_LOAD, dwHandle, sizeof(DWORD) + sizeof(TPlayerItem) * dwCount);
-	peer->EncodeDWORD(dwCount);
+	char * pc = (char *) peer->EncodePacket(HEADER_DG_ITEM_LOAD, dwHandle, sizeof(DWORD) + sizeof(TPlayerItem) * dwCount);
+
+	if (pc)
+	{
+		thecore_memcpy(pc, &dwCount, sizeof(DWORD));
+
+		if (dwCount)
+			thecore_memcpy(pc + sizeof(DWORD), &s_items[0], sizeof(TPlayerItem) * dwCount);
+	}
 
 	//CacheSet   
 	CreateItemCacheSet(dwPID);
@@ -652,13 +943,8 @@ void CClientManager::RESULT_ITEM_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwHa
 	sys_log(0, "ITEM_LOAD: count %u pid %u", dwCount, dwPID);
 	// END_OF_ITEM_LOAD_LOG_ATTACH_PID
 
-	if (dwCount)
-	{
-		peer->Encode(&s_items[0], sizeof(TPlayerItem) * dwCount);
-
-		for (DWORD i = 0; i < dwCount; ++i)
-			PutItemCache(&s_items[i], true); // ε    ʿ Ƿ,  bSkipQuery true ִ´.
-	}
+	for (DWORD i = 0; i < dwCount; ++i)
+		PutItemCache(&s_items[i], true); // ε    ʿ Ƿ,  bSkipQuery true ִ´.
 }
 
 void CClientManager::RESULT_AFFECT_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwHandle)
@@ -668,16 +954,22 @@ void CClientManager::RESULT_AFFECT_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dw
 	if ((iNumRows = mysql_num_rows(pRes)) == 0) //  
 		return;
 
-	static std::vector<TPacketAffectElement> s_elements;
-	s_elements.resize(iNumRows);
-
+	DWORD dwCount = iNumRows;
 	DWORD dwPID = 0;
 
+	//   ۿ ٷ ä. PID  ù   ڿ .
+	char * pc = (char *) peer->EncodePacket(HEADER_DG_AFFECT_LOAD, dwHandle, sizeof(DWORD) + sizeof(DWORD) + sizeof(TPacketAffectElement) * dwCount);
+
+	if (!pc)
+		return;
+
+	TPacketAffectElement * pElements = (TPacketAffectElement *) (pc + sizeof(DWORD) + sizeof(DWORD));
+
 	MYSQL_ROW row;
 
 	for (int i = 0; i < iNumRows; ++i)
 	{
-		TPacketAffectElement & r = s_elements[i];
+		TPacketAffectElement & r = pElements[i];
 		row = mysql_fetch_row(pRes);
 
 		if (dwPID == 0)
@@ -691,14 +983,10 @@ void CClientManager::RESULT_AFFECT_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dw
 		str_to_number(r.lSPCost, row[6]);
 	}
 
-	sys_log(0, "AFFECT_LOAD: count %d PID %u", s_elements.size(), dwPID);
-
-	DWORD dwCount = s_elements.size();
+	sys_log(0, "AFFECT_LOAD: count %u PID %u", dwCount, dwPID);
 
-	peer->EncodeHeader(HEADER_DG_AFFECT_LOAD, dwHandle, sizeof(DWORD) + sizeof(DWORD) + sizeof(TPacketAffectElement) * dwCount);
-	peer->Encode(&dwPID, sizeof(DWORD));
-	peer->Encode(&dwCount, sizeof(DWORD));
-	peer->Encode(&s_elements[0], sizeof(TPacketAffectElement) * dwCount);
+	thecore_memcpy(pc, &dwPID, sizeof(DWORD));
+	thecore_memcpy(pc + sizeof(DWORD), &dwCount, sizeof(DWORD));
 }
 
 void CClientManager::RESULT_QUEST_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwHandle, DWORD pid)
@@ -713,14 +1001,22 @@ void CClientManager::RESULT_QUEST_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwH
 		return;
 	}
 
-	static std::vector<TQuestTable> s_table;
-	s_table.resize(iNumRows);
+	DWORD dwCount = iNumRows;
+
+	char * pc = (char *) peer->EncodePacket(HEADER_DG_QUEST_LOAD, dwHandle, sizeof(DWORD) + sizeof(TQuestTable) * dwCount);
+
+	if (!pc)
+		return;
+
+	thecore_memcpy(pc, &dwCount, sizeof(DWORD));
+
+	TQuestTable * pTable = (TQuestTable *) (pc + sizeof(DWORD));
 
 	MYSQL_ROW row;
 
 	for (int i = 0; i < iNumRows; ++i)
 	{
-		TQuestTable & r = s_table[i];
+		TQuestTable & r = pTable[i];
 
 		row = mysql_fetch_row(pRes);
 
@@ -730,13 +1026,7 @@ void CClientManager::RESULT_QUEST_LOAD(CPeer * peer, MYSQL_RES * pRes, DWORD dwH
 		str_to_number(r.lValue, row[3]);
 	}
 
-	sys_log(0, "QUEST_LOAD: count %d PID %u", s_table.size(), s_table[0].dwPID);
-
-	DWORD dwCount = s_table.size();
-
-	peer->EncodeHeader(HEADER_DG_QUEST_LOAD, dwHandle, sizeof(DWORD) + sizeof(TQuestTable) * dwCount);
-	peer->Encode(&dwCount, sizeof(DWORD));
-	peer->Encode(&s_table[0], sizeof(TQuestTable) * dwCount);
+	sys_log(0, "QUEST_LOAD: count %u PID %u", dwCount, pTable[0].dwPID);
 }
 
 /*
@@ -928,6 +1218,8 @@ void CClientManager::__QUERY_PLAYER_DELETE(CPeer* peer, DWORD dwHandle, TPlayerD
 	if (!packet->login[0] || !packet->player_id || packet->account_index >= PLAYER_PER_ACCOUNT)
 		return;
 
+	FlushGroupCommit();
+
 	CLoginData * ld = GetLoginDataByLogin(packet->login);
 
 	if (!ld)
@@ -1016,6 +1308,8 @@ void CClientManager::__RESULT_PLAYER_DELETE(CPeer *peer, SQLMsg* msg)
 			delete pkPlayerCache;
 		}
 
+		DropPlayerPrefetch(pi->player_id);
+
 		// ۵ ĳ Ѵ.
 		TItemCacheSet * pSet = GetItemCacheSet(pi->player_id);
 
@@ -1058,10 +1352,10 @@ void CClientManager::__RESULT_PLAYER_DELETE(CPeer *peer, SQLMsg* msg)
 		delete CDBManager::instance().DirectQuery(queryStr);
 
 		snprintf(queryStr, sizeof(queryStr), "DELETE FROM quest%s WHERE dwPID=%d", GetTablePostfix(), pi->player_id);
-		CDBManager::instance().AsyncQuery(queryStr);
+		CDBManager::instance().AsyncQuery(queryStr, SQL_PLAYER, pi->player_id);
 
 		snprintf(queryStr, sizeof(queryStr), "DELETE FROM affect%s WHERE dwPID=%d", GetTablePostfix(), pi->player_id);
-		CDBManager::instance().AsyncQuery(queryStr);
+		CDBManager::instance().AsyncQuery(queryStr, SQL_PLAYER, pi->player_id);
 
 		snprintf(queryStr, sizeof(queryStr), "DELETE FROM guild_member%s WHERE pid=%d", GetTablePostfix(), pi->player_id);
 		CDBManager::instance().AsyncQuery(queryStr);
@@ -1109,17 +1403,19 @@ void CClientManager::QUERY_ADD_AFFECT(CPeer * peer, TPacketGDAddAffect * p)
 	   */
 	snprintf(queryStr, sizeof(queryStr),
 			"REPLACE INTO affect%s (dwPID, bType, bApplyOn, lApplyValue, dwFlag, lDuration, lSPCost) "
-			"VALUES(%u, %u, %u, %ld, %u, %ld, %ld)",
-			GetTablePostfix(),
-			p->dwPID,
-			p->elem.dwType,
-			p->elem.bApplyOn,
-			p->elem.lApplyValue,
-			p->elem.dwFlag,
-			p->elem.lDuration,
-			p->elem.lSPCost);
-
-	CDBManager::instance().AsyncQuery(queryStr);
+			"VALUES(?, ?, ?, ?, ?, ?, ?)",
+			GetTablePostfix());
+
+	CStmtQuery kQuery(queryStr);
+	kQuery.BindUnsigned(p->dwPID);
+	kQuery.BindUnsigned(p->elem.dwType);
+	kQuery.BindUnsigned(p->elem.bApplyOn);
+	kQuery.BindSigned(p->elem.lApplyValue);
+	kQuery.BindUnsigned(p->elem.dwFlag);
+	kQuery.BindSigned(p->elem.lDuration);
+	kQuery.BindSigned(p->elem.lSPCost);
+
+	CDBManager::instance().AsyncStmt(kQuery, SQL_PLAYER, p->dwPID);
 }
 
 void CClientManager::QUERY_REMOVE_AFFECT(CPeer * peer, TPacketGDRemoveAffect * p)
@@ -1127,10 +1423,15 @@ void CClientManager::QUERY_REMOVE_AFFECT(CPeer * peer, TPacketGDRemoveAffect * p
 	char queryStr[QUERY_MAX_LEN];
 
 	snprintf(queryStr, sizeof(queryStr),
-			"DELETE FROM affect%s WHERE dwPID=%u AND bType=%u AND bApplyOn=%u",
-			GetTablePostfix(), p->dwPID, p->dwType, p->bApplyOn);
+			"DELETE FROM affect%s WHERE dwPID=? AND bType=? AND bApplyOn=?",
+			GetTablePostfix());
+
+	CStmtQuery kQuery(queryStr);
+	kQuery.BindUnsigned(p->dwPID);
+	kQuery.BindUnsigned(p->dwType);
+	kQuery.BindUnsigned(p->bApplyOn);
 
-	CDBManager::instance().AsyncQuery(queryStr);
+	CDBManager::instance().AsyncStmt(kQuery, SQL_PLAYER, p->dwPID);
 }
 
 void CClientManager::InsertLogoutPlayer(DWORD pid)
@@ -21,6 +21,7 @@ void CDBManager::Initialize()
 		m_mainSQL[i] = NULL;
 		m_directSQL[i] = NULL;
 		m_asyncSQL[i] = NULL;
+		m_aiPoolSize[i] = 1;
 	}
 }
 
@@ -52,7 +53,7 @@ void CDBManager::Clear()
 		}
 	}
 
-	Initialize();
+	// m_aiPoolSize  Connect õ Ƿ ״ д.
 }
 
 void CDBManager::Quit()
@@ -107,17 +108,17 @@ int CDBManager::Connect(int iSlot, const char * db_address, const int db_port, c
 	}
 
 
-	sys_log(0, "CREATING MAIN_SQL");
-	m_mainSQL[iSlot] = new CAsyncSQL2;
-	if (!m_mainSQL[iSlot]->Setup(db_address, user, pwd, db_name, g_stLocale.c_str(), false, db_port))
+	sys_log(0, "CREATING MAIN_SQL (pool %d)", m_aiPoolSize[iSlot]);
+	m_mainSQL[iSlot] = new CAsyncSQLPool;
+	if (!m_mainSQL[iSlot]->Setup(db_address, user, pwd, db_name, g_stLocale.c_str(), m_aiPoolSize[iSlot], db_port))
 	{
 		Clear();
 		return false;
 	}
 
-	sys_log(0, "CREATING ASYNC_SQL");
-	m_asyncSQL[iSlot] = new CAsyncSQL2;
-	if (!m_asyncSQL[iSlot]->Setup(db_address, user, pwd, db_name, g_stLocale.c_str(), false, db_port))
+	sys_log(0, "CREATING ASYNC_SQL (pool %d)", m_aiPoolSize[iSlot]);
+	m_asyncSQL[iSlot] = new CAsyncSQLPool;
+	if (!m_asyncSQL[iSlot]->Setup(db_address, user, pwd, db_name, g_stLocale.c_str(), m_aiPoolSize[iSlot], db_port))
 	{
 		Clear();
 		return false;
@@ -126,6 +127,14 @@ int CDBManager::Connect(int iSlot, const char * db_address, const int db_port, c
 	return true;
 }
 
+void CDBManager::SetPoolSize(int iSlot, int iSize)
+{
+	if (iSlot < 0 || iSlot >= SQL_MAX_NUM)
+		return;
+
+	m_aiPoolSize[iSlot] = MAX(1, iSize);
+}
+
 SQLMsg * CDBManager::DirectQuery(const char * c_pszQuery, int iSlot)
 {
 	return m_directSQL[iSlot]->DirectQuery(c_pszQuery);
@@ -134,7 +143,7 @@ SQLMsg * CDBManager::DirectQuery(const char * c_pszQuery, int iSlot)
 extern CPacketInfo g_query_info;
 extern int g_query_count[2];
 
-void CDBManager::ReturnQuery(const char * c_pszQuery, int iType, IDENT dwIdent, void * udata, int iSlot)
+void CDBManager::ReturnQuery(const char * c_pszQuery, int iType, IDENT dwIdent, void * udata, int iSlot, DWORD dwKey, bool bAfterAll)
 {
 	assert(iSlot < SQL_MAX_NUM);
 	//sys_log(0, "ReturnQuery %s", c_pszQuery);
@@ -144,16 +153,36 @@ void CDBManager::ReturnQuery(const char * c_pszQuery, int iType, IDENT dwIdent,
 	p->dwIdent = dwIdent;
 	p->pvData = udata;
 
-	m_mainSQL[iSlot]->ReturnQuery(c_pszQuery, p);
+	m_mainSQL[iSlot]->ReturnQuery(c_pszQuery, p, dwKey, bAfterAll);
 
 	//g_query_info.Add(iType);
 	++g_query_count[0];
 }
 
-void CDBManager::AsyncQuery(const char * c_pszQuery, int iSlot)
+void CDBManager::AsyncQuery(const char * c_pszQuery, int iSlot, DWORD dwKey)
+{
+	assert(iSlot < SQL_MAX_NUM);
+	m_asyncSQL[iSlot]->AsyncQuery(c_pszQuery, dwKey);
+	++g_query_count[1];
+}
+
+void CDBManager::ReturnStmt(const CStmtQuery & c_rkQuery, int iType, IDENT dwIdent, void * udata, int iSlot, DWORD dwKey)
+{
+	assert(iSlot < SQL_MAX_NUM);
+	CQueryInfo * p = new CQueryInfo;
+
+	p->iType = iType;
+	p->dwIdent = dwIdent;
+	p->pvData = udata;
+
+	m_mainSQL[iSlot]->ReturnStmt(c_rkQuery, p, dwKey);
+	++g_query_count[0];
+}
+
+void CDBManager::AsyncStmt(const CStmtQuery & c_rkQuery, int iSlot, DWORD dwKey)
 {
 	assert(iSlot < SQL_MAX_NUM);
-	m_asyncSQL[iSlot]->AsyncQuery(c_pszQuery);
+	m_asyncSQL[iSlot]->AsyncStmt(c_rkQuery, dwKey);
 	++g_query_count[1];
 }
 
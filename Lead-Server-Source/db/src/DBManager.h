@@ -43,16 +43,33 @@ class CDBManager : public singleton<CDBManager>
 
 	int			Connect(int iSlot, const char * host, int port, const char* dbname, const char* user, const char* pass);
 
-	void			ReturnQuery(const char * c_pszQuery, int iType, DWORD dwIdent, void * pvData, int iSlot = SQL_PLAYER);
-	void			AsyncQuery(const char * c_pszQuery, int iSlot = SQL_PLAYER);
+	// Connect  ҷ Ѵ. ReturnQuery/AsyncQuery   iSize  .
+	void			SetPoolSize(int iSlot, int iSize);
+
+	// dwKey     ȴ. ( player id,   item id) 0 ̸   ʴ´.
+	// bAfterAll ̸ Ű       ڿ ȴ.  Ű ģ ̺   .
+	void			ReturnQuery(const char * c_pszQuery, int iType, DWORD dwIdent, void * pvData, int iSlot = SQL_PLAYER, DWORD dwKey = 0, bool bAfterAll = false);
+	void			AsyncQuery(const char * c_pszQuery, int iSlot = SQL_PLAYER, DWORD dwKey = 0);
+
+	// prepared statement  Ѵ.     ƿ´.
+	void			ReturnStmt(const CStmtQuery & c_rkQuery, int iType, DWORD dwIdent, void * pvData, int iSlot = SQL_PLAYER, DWORD dwKey = 0);
+	void			AsyncStmt(const CStmtQuery & c_rkQuery, int iSlot = SQL_PLAYER, DWORD dwKey = 0);
 	SQLMsg *		DirectQuery(const char * c_pszQuery, int iSlot = SQL_PLAYER);
 
+	// ū ̺    ü ޸𸮿  ʰ  ྿ fn(row)  ѱ.
+	template <typename F> bool DirectQueryEach(const char * c_pszQuery, F & fn, int iSlot = SQL_PLAYER)
+	{
+		assert(iSlot < SQL_MAX_NUM);
+		return m_directSQL[iSlot]->DirectQueryEach(c_pszQuery, fn);
+	}
+
 	SQLMsg *		PopResult();
 	SQLMsg * 		PopResult(eSQL_SLOT slot );
 
 	unsigned long		EscapeString(void * to, const void * from, unsigned long length, int iSlot = SQL_PLAYER);
 
 	DWORD			CountReturnQuery(int i) { return m_mainSQL[i] ? m_mainSQL[i]->CountQuery() : 0; }
+	int			GetReturnPoolSize(int i) { return m_mainSQL[i] ? m_mainSQL[i]->GetPoolSize() : 1; }
 	DWORD			CountReturnResult(int i) { return m_mainSQL[i] ? m_mainSQL[i]->CountResult() : 0; }
 	DWORD			CountReturnQueryFinished(int i) { return m_mainSQL[i] ? m_mainSQL[i]->CountQueryFinished() : 0; }
 	DWORD			CountReturnCopiedQuery(int i) { return m_mainSQL[i] ? m_mainSQL[i]->GetCopiedQueryCount() : 0; }
@@ -81,9 +98,10 @@ class CDBManager : public singleton<CDBManager>
 	}
 
     private:
-	CAsyncSQL2 *		m_mainSQL[SQL_MAX_NUM];
+	CAsyncSQLPool *		m_mainSQL[SQL_MAX_NUM];
 	CAsyncSQL2 *	 	m_directSQL[SQL_MAX_NUM];
-	CAsyncSQL2 *		m_asyncSQL[SQL_MAX_NUM];
+	CAsyncSQLPool *		m_asyncSQL[SQL_MAX_NUM];
+	int			m_aiPoolSize[SQL_MAX_NUM];
 
 	int			m_quit;		// looping flag
 
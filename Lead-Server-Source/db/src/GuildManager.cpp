@@ -7,6 +7,7 @@
 #include <math.h>
 
 extern std::string g_stLocale;
+extern int g_iGuildWarmDays;
 
 const int GUILD_RANK_MAX_NUM = 20;
 
@@ -117,7 +118,7 @@ CGuildManager::~CGuildManager()
 
 TGuild & CGuildManager::TouchGuild(DWORD GID)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+	itertype(m_map_kGuild) it = FindGuild(GID);
 
 	if (it != m_map_kGuild.end())
 		return it->second;
@@ -127,6 +128,18 @@ TGuild & CGuildManager::TouchGuild(DWORD GID)
 	return m_map_kGuild[GID];
 }
 
+std::map<DWORD, TGuild>::iterator CGuildManager::FindGuild(DWORD GID)
+{
+	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+
+	if (it != m_map_kGuild.end() || !GID)
+		return it;
+
+	//    ʾҰ α б⵵    .    ٸ ٷ д´.
+	Load(GID);
+	return m_map_kGuild.find(GID);
+}
+
 void CGuildManager::ParseResult(SQLResult * pRes)
 {
 	MYSQL_ROW row;
@@ -135,7 +148,11 @@ void CGuildManager::ParseResult(SQLResult * pRes)
 	{
 		DWORD GID = strtoul(row[0], NULL, 10);
 
-		TGuild & r_info = TouchGuild(GID);
+		// ޸𸮿 ִ   ̴ֽ (gold  ޸𸮿 ٲٰ 񵿱 Ѵ)
+		if (m_map_kGuild.find(GID) != m_map_kGuild.end())
+			continue;
+
+		TGuild & r_info = m_map_kGuild[GID];
 
 		strlcpy(r_info.szName, row[1], sizeof(r_info.szName));
 		str_to_number(r_info.ladder_point, row[2]);
@@ -158,12 +175,25 @@ void CGuildManager::ParseResult(SQLResult * pRes)
 void CGuildManager::Initialize()
 {
 	char szQuery[1024];
-	snprintf(szQuery, sizeof(szQuery), "SELECT id, name, ladder_point, win, draw, loss, gold, level FROM guild%s", GetTablePostfix());
+
+	// GUILD_WARM_DAYS  0 ̸ ó  带 д´.
+	// ƴϸ  Ⱓ ȿ   ִ 常 а  ó   д´.
+	if (g_iGuildWarmDays > 0)
+		snprintf(szQuery, sizeof(szQuery),
+				"SELECT DISTINCT g.id, g.name, g.ladder_point, g.win, g.draw, g.loss, g.gold, g.level "
+				"FROM guild%s AS g, guild_member%s AS m, player%s AS p "
+				"WHERE m.guild_id = g.id AND p.id = m.pid AND p.last_play >= DATE_SUB(NOW(), INTERVAL %d DAY)",
+				GetTablePostfix(), GetTablePostfix(), GetTablePostfix(), g_iGuildWarmDays);
+	else
+		snprintf(szQuery, sizeof(szQuery), "SELECT id, name, ladder_point, win, draw, loss, gold, level FROM guild%s", GetTablePostfix());
+
 	std::unique_ptr<SQLMsg> pmsg(CDBManager::instance().DirectQuery(szQuery));
 
 	if (pmsg->Get()->uiNumRows)
 		ParseResult(pmsg->Get());
 
+	sys_log(0, "GUILD: %u guilds loaded at boot (warm days %d)", (DWORD) m_map_kGuild.size(), g_iGuildWarmDays);
+
 	char str[128 + 1];
 
 	if (!CConfig::instance().GetValue("POLY_POWER", str, sizeof(str)))
@@ -196,6 +226,43 @@ void CGuildManager::Load(DWORD dwGuildID)
 		ParseResult(pmsg->Get());
 }
 
+void CGuildManager::RequestLoadByAccount(const TAccountTable & r)
+{
+	if (g_iGuildWarmDays <= 0)
+		return;
+
+	char szPID[128];
+	int iLen = 0;
+
+	for (int i = 0; i < PLAYER_PER_ACCOUNT; ++i)
+	{
+		if (!r.players[i].dwID)
+			continue;
+
+		iLen += snprintf(szPID + iLen, sizeof(szPID) - iLen, iLen ? ",%u" : "%u", r.players[i].dwID);
+	}
+
+	if (!iLen)
+		return;
+
+	char szQuery[512];
+	snprintf(szQuery, sizeof(szQuery),
+			"SELECT g.id, g.name, g.ladder_point, g.win, g.draw, g.loss, g.gold, g.level "
+			"FROM guild%s AS g, guild_member%s AS m WHERE m.pid IN (%s) AND g.id = m.guild_id",
+			GetTablePostfix(), GetTablePostfix(), szPID);
+
+	CDBManager::instance().ReturnQuery(szQuery, QID_GUILD_LOAD, 0, NULL);
+}
+
+void CGuildManager::ResultLoad(SQLMsg * msg)
+{
+	if (msg->uiSQLErrno != 0 || !msg->Get()->pSQLResult)
+		return;
+
+	if (msg->Get()->uiNumRows)
+		ParseResult(msg->Get());
+}
+
 void CGuildManager::QueryRanking()
 {
 	char szQuery[256];
@@ -343,7 +410,7 @@ void CGuildManager::OnSetup(CPeer* peer)
 
 void CGuildManager::GuildWarWin(DWORD GID)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+	itertype(m_map_kGuild) it = FindGuild(GID);
 
 	if (it == m_map_kGuild.end())
 		return;
@@ -357,7 +424,7 @@ void CGuildManager::GuildWarWin(DWORD GID)
 
 void CGuildManager::GuildWarLose(DWORD GID)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+	itertype(m_map_kGuild) it = FindGuild(GID);
 
 	if (it == m_map_kGuild.end())
 		return;
@@ -371,7 +438,7 @@ void CGuildManager::GuildWarLose(DWORD GID)
 
 void CGuildManager::GuildWarDraw(DWORD GID)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+	itertype(m_map_kGuild) it = FindGuild(GID);
 
 	if (it == m_map_kGuild.end())
 		return;
@@ -668,8 +735,8 @@ void CGuildManager::RemoveDeclare(DWORD guild_from, DWORD guild_to)
 
 bool CGuildManager::TakeBetPrice(DWORD dwGuildTo, DWORD dwGuildFrom, long lWarPrice)
 {
-	itertype(m_map_kGuild) it_from = m_map_kGuild.find(dwGuildFrom);
-	itertype(m_map_kGuild) it_to = m_map_kGuild.find(dwGuildTo);
+	itertype(m_map_kGuild) it_from = FindGuild(dwGuildFrom);
+	itertype(m_map_kGuild) it_to = FindGuild(dwGuildTo);
 
 	if (it_from == m_map_kGuild.end() || it_to == m_map_kGuild.end())
 	{
@@ -716,7 +783,7 @@ bool CGuildManager::WaitStart(TPacketGuildWar * p)
 
 int CGuildManager::GetLadderPoint(DWORD GID)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+	itertype(m_map_kGuild) it = FindGuild(GID);
 
 	if (it == m_map_kGuild.end())
 		return 0;
@@ -726,7 +793,7 @@ int CGuildManager::GetLadderPoint(DWORD GID)
 
 void CGuildManager::ChangeLadderPoint(DWORD GID, int change)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(GID);
+	itertype(m_map_kGuild) it = FindGuild(GID);
 
 	if (it == m_map_kGuild.end())
 		return;
@@ -784,7 +851,7 @@ void CGuildManager::DepositMoney(DWORD dwGuild, INT iGold)
 	if (iGold <= 0)
 		return;
 
-	itertype(m_map_kGuild) it = m_map_kGuild.find(dwGuild);
+	itertype(m_map_kGuild) it = FindGuild(dwGuild);
 
 	if (it == m_map_kGuild.end())
 	{
@@ -800,7 +867,7 @@ void CGuildManager::DepositMoney(DWORD dwGuild, INT iGold)
 
 void CGuildManager::WithdrawMoney(CPeer* peer, DWORD dwGuild, INT iGold)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(dwGuild);
+	itertype(m_map_kGuild) it = FindGuild(dwGuild);
 
 	if (it == m_map_kGuild.end())
 	{
@@ -825,7 +892,7 @@ void CGuildManager::WithdrawMoney(CPeer* peer, DWORD dwGuild, INT iGold)
 
 void CGuildManager::WithdrawMoneyReply(DWORD dwGuild, BYTE bGiveSuccess, INT iGold)
 {
-	itertype(m_map_kGuild) it = m_map_kGuild.find(dwGuild);
+	itertype(m_map_kGuild) it = FindGuild(dwGuild);
 
 	if (it == m_map_kGuild.end())
 		return;
@@ -949,6 +1016,10 @@ void CGuildManager::BootReserveWar()
 			{
 				sys_log(0, "%s : OK", buf);
 				m_map_kWarReserve.insert(std::make_pair(t.dwID, pkReserve));
+
+				//     ο  ̸ о д.
+				FindGuild(t.dwGuildFrom);
+				FindGuild(t.dwGuildTo);
 			}
 		}
 	}
@@ -1098,8 +1169,8 @@ void CGuildManager::ProcessReserveWar()
 		{
 			int iMin = (int) ceil((int)(r.dwTime - dwCurTime) / 60.0);
 
-			TGuild & r_1 = m_map_kGuild[r.dwGuildFrom];
-			TGuild & r_2 = m_map_kGuild[r.dwGuildTo];
+			TGuild & r_1 = TouchGuild(r.dwGuildFrom);
+			TGuild & r_2 = TouchGuild(r.dwGuildTo);
 
 			sys_log(0, "GuildWar: started GID1 %u GID2 %u %d time %d min %d", r.dwGuildFrom, r.dwGuildTo, r.bStarted, dwCurTime - r.dwTime, iMin);
 
@@ -1179,7 +1250,7 @@ void CGuildManager::CancelWar(DWORD GID1, DWORD GID2)
 
 bool CGuildManager::ChangeMaster(DWORD dwGID, DWORD dwFrom, DWORD dwTo)
 {
-	itertype(m_map_kGuild) iter = m_map_kGuild.find(dwGID);
+	itertype(m_map_kGuild) iter = FindGuild(dwGID);
 
 	if (iter == m_map_kGuild.end())
 		return false;
@@ -167,6 +167,8 @@ class CGuildManager : public singleton<CGuildManager>
 	void	Initialize();
 
 	void	Load(DWORD dwGuildID);
+	void	RequestLoadByAccount(const TAccountTable & r);	// α  ĳͰ  带 񵿱 д´
+	void	ResultLoad(SQLMsg * msg);
 
 	TGuild & TouchGuild(DWORD GID);
 
@@ -216,6 +218,7 @@ class CGuildManager : public singleton<CGuildManager>
 
     private:
 	void ParseResult(SQLResult * pRes);
+	std::map<DWORD, TGuild>::iterator FindGuild(DWORD GID);	//   常 DB  о 
 
 	void RemoveWar(DWORD GID1, DWORD GID2);	// erase war from m_WarMap and set end on priority queue
 
@@ -8,24 +8,64 @@
 
 
 
+extern int g_iItemAwardLoadBatch;
+
 DWORD g_dwLastCachedItemAwardID = 0;
-ItemAwardManager::ItemAwardManager()
+
+volatile bool ItemAwardManager::ms_bNotified = false;
+
+ItemAwardManager::ItemAwardManager() : m_bLoading(false), m_bLoadMore(false)
 {
 }
 
 ItemAwardManager::~ItemAwardManager()
 {
+	for (itertype(m_map_award) it = m_map_award.begin(); it != m_map_award.end(); ++it)
+		delete it->second;
+}
+
+void ItemAwardManager::Notify()
+{
+	ms_bNotified = true;
+}
+
+void ItemAwardManager::Update()
+{
+	if (ms_bNotified)
+	{
+		ms_bNotified = false;
+		m_bLoadMore = true;
+	}
+
+	if (m_bLoadMore)
+		RequestLoad();
 }
 
 void ItemAwardManager::RequestLoad()
 {
+	//     ƿ ƿ ڿ ̾ д´.
+	if (m_bLoading)
+	{
+		m_bLoadMore = true;
+		return;
+	}
+
+	m_bLoading = true;
+	m_bLoadMore = false;
+
 	char szQuery[QUERY_MAX_LEN];
-	snprintf(szQuery, sizeof(szQuery), "SELECT id,login,vnum,count,socket0,socket1,socket2,mall,why FROM item_award WHERE taken_time IS NULL and id > %d", g_dwLastCachedItemAwardID);
+	snprintf(szQuery, sizeof(szQuery), "SELECT id,login,vnum,count,socket0,socket1,socket2,mall,why FROM item_award WHERE taken_time IS NULL and id > %u ORDER BY id LIMIT %d", g_dwLastCachedItemAwardID, g_iItemAwardLoadBatch);
 	CDBManager::instance().ReturnQuery(szQuery, QID_ITEM_AWARD_LOAD, 0, NULL);
 }
 
 void ItemAwardManager::Load(SQLMsg * pMsg)
 {
+	m_bLoading = false;
+
+	// ġ  ä   Ƿ  Update  ̾ д´.
+	if (pMsg->Get()->uiNumRows >= (uint) g_iItemAwardLoadBatch)
+		m_bLoadMore = true;
+
 	MYSQL_RES * pRes = pMsg->Get()->pSQLResult;
 
 	for (uint i = 0; i < pMsg->Get()->uiNumRows; ++i)
@@ -75,15 +115,14 @@ void ItemAwardManager::Load(SQLMsg * pMsg)
 
 		printf("ITEM_AWARD load id %u bMall %d \n", kData->dwID, kData->bMall);
 		sys_log(0, "ITEM_AWARD: load id %lu login %s vnum %lu count %u socket %lu", kData->dwID, kData->szLogin, kData->dwVnum, kData->dwCount, kData->dwSocket0);
-		std::set<TItemAward *> & kSet = m_map_kSetAwardByLogin[kData->szLogin];
-		kSet.insert(kData);
+		m_map_kSetAwardByLogin[kData->szLogin].insert(kData);
 
 		if (dwID > g_dwLastCachedItemAwardID)
 			g_dwLastCachedItemAwardID = dwID;
 	}
 }
 
-std::set<TItemAward *> * ItemAwardManager::GetByLogin(const char * c_pszLogin)
+TItemAwardSet * ItemAwardManager::GetByLogin(const char * c_pszLogin)
 {
 	itertype(m_map_kSetAwardByLogin) it = m_map_kSetAwardByLogin.find(c_pszLogin);
 
@@ -103,9 +142,6 @@ void ItemAwardManager::Taken(DWORD dwAwardID, DWORD dwItemID)
 		return;
 	}
 
-	TItemAward * k = it->second;
-	k->bTaken = true;
-
 	//
 	// Update taken_time in database to prevent not to give him again.
 	// 
@@ -116,14 +152,37 @@ void ItemAwardManager::Taken(DWORD dwAwardID, DWORD dwItemID)
 			dwItemID, dwAwardID);
 
 	CDBManager::instance().ReturnQuery(szQuery, QID_ITEM_AWARD_TAKEN, 0, NULL);
+
+	// ޾ư  ٽ   Ƿ ޸𸮿 . id >  id θ Ƿ ٽ ö ʴ´.
+	Remove(it->second);
 }
 
-std::map<DWORD, TItemAward *>& ItemAwardManager::GetMapAward()
+void ItemAwardManager::Delete(DWORD dwAwardID)
 {
-	return m_map_award;
+	itertype(m_map_award) it = m_map_award.find(dwAwardID);
+
+	if (it == m_map_award.end())
+	{
+		sys_log(0, "DELETE_AWARDID : could not find the id: %d", dwAwardID);
+		return;
+	}
+
+	sys_log(0, "erase ItemAward id: %d from cache", dwAwardID);
+	Remove(it->second);
 }
 
-std::map<std::string, std::set<TItemAward *> >& ItemAwardManager::GetMapkSetAwardByLogin()
+void ItemAwardManager::Remove(TItemAward * pkAward)
 {
-	return m_map_kSetAwardByLogin;
+	itertype(m_map_kSetAwardByLogin) it = m_map_kSetAwardByLogin.find(pkAward->szLogin);
+
+	if (it != m_map_kSetAwardByLogin.end())
+	{
+		it->second.erase(pkAward);
+
+		if (it->second.empty())
+			m_map_kSetAwardByLogin.erase(it);
+	}
+
+	m_map_award.erase(pkAward->dwID);
+	delete pkAward;
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 #define __INC_ITEM_AWARD_H
 #include <map>
 #include <set>
+#include <boost/unordered_map.hpp>
 #include "Peer.h"
 
 typedef struct SItemAward
@@ -19,25 +20,41 @@ typedef struct SItemAward
     bool	bMall;
 } TItemAward;
 
+typedef std::set<TItemAward *> TItemAwardSet;
+
 class ItemAwardManager : public singleton<ItemAwardManager>
 {
     public:
 	ItemAwardManager();
 	virtual ~ItemAwardManager();
 
+	// ñ׳ ڵ鷯 ҷ ȴ.  Update  ٷ   д´.
+	static void			Notify();
+
+	void				Update();
 	void				RequestLoad();
 	void				Load(SQLMsg * pMsg);
-	std::set<TItemAward *> *	GetByLogin(const char * c_pszLogin);
+	TItemAwardSet *			GetByLogin(const char * c_pszLogin);
 
 	void				Taken(DWORD dwAwardID, DWORD dwItemID);
 	// gift notify
-	std::map<DWORD, TItemAward *>& GetMapAward();
-	std::map<std::string, std::set<TItemAward *> >& GetMapkSetAwardByLogin();
+	void				Delete(DWORD dwAwardID);
+
     private:
+	void				Remove(TItemAward * pkAward);
+
+	typedef boost::unordered_map<DWORD, TItemAward *>		TItemAwardMap;
+	typedef boost::unordered_map<std::string, TItemAwardSet>	TItemAwardSetByLogin;
+
 	// ID, ItemAward pair
-	std::map<DWORD, TItemAward *>			m_map_award;
-	// PID, ItemAward pair
-	std::map<std::string, std::set<TItemAward *> >	m_map_kSetAwardByLogin;
+	TItemAwardMap			m_map_award;
+	// login, ItemAward pair
+	TItemAwardSetByLogin		m_map_kSetAwardByLogin;
+
+	bool				m_bLoading;	// б  ƿ⸦ ٸ 
+	bool				m_bLoadMore;	//   ġ  äų ߿ ˸ Դ
+
+	static volatile bool		ms_bNotified;
 };
 
 #endif
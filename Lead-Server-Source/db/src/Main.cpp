@@ -9,6 +9,7 @@
 #include "MoneyLog.h"
 #include "Marriage.h"
 #include "ItemIDRangeManager.h"
+#include "CacheJournal.h"
 #include <signal.h>
 
 void SetPlayerDBName(const char* c_pszPlayerDBName);
@@ -26,6 +27,21 @@ BOOL g_test_server = false;
 int g_iPlayerCacheFlushSeconds = 60*7;
 int g_iItemCacheFlushSeconds = 60*5;
 
+//  ĳ ÷  REPLACE ϳ  ִ  
+int g_iItemCacheFlushBatchSize = 50;
+
+// â / ó ٷ  ⸦  δ ð (ms). 0 ̸  ʴ´.
+int g_iGroupCommitMS = 5;
+
+// PLAYER_LOAD  player/item/quest/affect    .
+bool g_bPlayerLoadComposite = true;
+
+//  α  ̸ о  ĳ   ð. 0 ̸ ̸  ʴ´.
+int g_iPlayerPrefetchSeconds = 300;
+
+// â  ĳø  ʰ  ð. 0 ̸ ĳ ʴ´.
+int g_iSafeboxCacheSeconds = 60*30;
+
 //g_iLogoutSeconds ġ g_iPlayerCacheFlushSeconds  g_iItemCacheFlushSeconds   Ѵ.
 int g_iLogoutSeconds = 60*10;
 
@@ -36,6 +52,24 @@ int g_log = 1;
 int g_iItemPriceListTableCacheFlushSeconds = 540;
 // END_OF_MYSHOP_PRICE_LIST
 
+//  Ǿ Ŷ ѹ ̸ŭ óϸ ٸ Ǿ Ѿ. 0 ̸  
+int g_iPeerPacketBudget = 256;
+
+// item_award    д ִ  , ˸   ٽ Ȯϴ ()
+int g_iItemAwardLoadBatch = 500;
+int g_iItemAwardPollSeconds = 5;
+
+// ĳ  .  ̸    ʴ´.
+std::string g_stCacheJournalFile = "";
+int g_iCacheJournalSyncMS = 100;
+int g_iCacheJournalCheckpointSeconds = 60*5;
+
+// ھ     ھ  ֱ()
+int g_iClusterStateSeconds = 5;
+
+//    Ⱓ() ȿ   ִ 常 ̸ д´. 0 ̸  带 д´.
+int g_iGuildWarmDays = 14;
+
 #ifdef __FreeBSD__
 extern const char * _malloc_options;
 #endif
@@ -47,7 +81,11 @@ void emergency_sig(int sig)
 	if (sig == SIGSEGV)
 		sys_log(0, "SIGNAL: SIGSEGV");
 	else if (sig == SIGUSR1)
+	{
+		//  item_award     ˸
 		sys_log(0, "SIGNAL: SIGUSR1");
+		ItemAwardManager::Notify();
+	}
 
 	if (sig == SIGSEGV)
 		abort();
@@ -69,6 +107,7 @@ int main()
 	CPrivManager PrivManager;
 	CMoneyLog MoneyLog;
 	ItemAwardManager ItemAwardManager;
+	CCacheJournal CacheJournal;
 	marriage::CManager MarriageManager;
 	CItemIDRangeManager ItemIDRangeManager;
 
@@ -83,6 +122,7 @@ int main()
 	CClientManager::instance().MainLoop();
 
 	signal_timer_disable();
+	metrics_destroy();
 
 	DBManager.Quit();
 	int iCount;
@@ -101,6 +141,9 @@ int main()
 		sys_log(0, "WAITING_QUERY_COUNT %d", iCount);
 	}
 
+	//    Ƿ   ʿ .
+	CacheJournal.Close(true);
+
 	return 1;
 }
 
@@ -159,6 +202,21 @@ int Start()
 		fprintf(stderr, "Setting log keeping days to %d\n", tmpValue);
 	}
 
+	if (CConfig::instance().GetValue("LOG_ASYNC_QUEUE", &tmpValue))
+	{
+		tmpValue = MINMAX(0, tmpValue, 65536);
+		log_set_async_queue_size(tmpValue);
+		fprintf(stderr, "Setting async log queue to %d records\n", tmpValue);
+	}
+
+	char szLogOverflow[16];
+
+	if (CConfig::instance().GetValue("LOG_ASYNC_OVERFLOW", szLogOverflow, sizeof(szLogOverflow)))
+	{
+		log_set_async_overflow(!strcasecmp(szLogOverflow, "block") ? LOG_ASYNC_OVERFLOW_BLOCK : LOG_ASYNC_OVERFLOW_DROP);
+		fprintf(stderr, "Setting async log overflow to %s\n", szLogOverflow);
+	}
+
 	thecore_init(heart_beat, emptybeat);
 	signal_timer_enable(60);
 
@@ -190,6 +248,95 @@ int Start()
 		sys_log(0, "ITEM_CACHE_FLUSH_SECONDS: %d", g_iItemCacheFlushSeconds);
 	}
 
+	if (CConfig::instance().GetValue("ITEM_CACHE_FLUSH_BATCH_SIZE", szBuf, 256))
+	{
+		str_to_number(g_iItemCacheFlushBatchSize, szBuf);
+		g_iItemCacheFlushBatchSize = MINMAX(1, g_iItemCacheFlushBatchSize, 100);
+		sys_log(0, "ITEM_CACHE_FLUSH_BATCH_SIZE: %d", g_iItemCacheFlushBatchSize);
+	}
+
+	if (CConfig::instance().GetValue("PLAYER_LOAD_COMPOSITE", szBuf, 256))
+	{
+		g_bPlayerLoadComposite = atoi(szBuf) != 0;
+		sys_log(0, "PLAYER_LOAD_COMPOSITE: %d", g_bPlayerLoadComposite);
+	}
+
+	if (CConfig::instance().GetValue("PEER_PACKET_BUDGET", szBuf, 256))
+	{
+		str_to_number(g_iPeerPacketBudget, szBuf);
+		g_iPeerPacketBudget = MAX(0, g_iPeerPacketBudget);
+		sys_log(0, "PEER_PACKET_BUDGET: %d", g_iPeerPacketBudget);
+	}
+
+	if (CConfig::instance().GetValue("CACHE_JOURNAL_FILE", szBuf, 256))
+	{
+		g_stCacheJournalFile = szBuf;
+		sys_log(0, "CACHE_JOURNAL_FILE: %s", g_stCacheJournalFile.c_str());
+	}
+
+	if (CConfig::instance().GetValue("CACHE_JOURNAL_SYNC_MS", szBuf, 256))
+	{
+		str_to_number(g_iCacheJournalSyncMS, szBuf);
+		g_iCacheJournalSyncMS = MAX(0, g_iCacheJournalSyncMS);
+		sys_log(0, "CACHE_JOURNAL_SYNC_MS: %d", g_iCacheJournalSyncMS);
+	}
+
+	if (CConfig::instance().GetValue("CACHE_JOURNAL_CHECKPOINT_SECONDS", szBuf, 256))
+	{
+		str_to_number(g_iCacheJournalCheckpointSeconds, szBuf);
+		g_iCacheJournalCheckpointSeconds = MAX(10, g_iCacheJournalCheckpointSeconds);
+		sys_log(0, "CACHE_JOURNAL_CHECKPOINT_SECONDS: %d", g_iCacheJournalCheckpointSeconds);
+	}
+
+	if (CConfig::instance().GetValue("CLUSTER_STATE_SECONDS", szBuf, 256))
+	{
+		str_to_number(g_iClusterStateSeconds, szBuf);
+		g_iClusterStateSeconds = MAX(1, g_iClusterStateSeconds);
+		sys_log(0, "CLUSTER_STATE_SECONDS: %d", g_iClusterStateSeconds);
+	}
+
+	if (CConfig::instance().GetValue("GROUP_COMMIT_MS", szBuf, 256))
+	{
+		str_to_number(g_iGroupCommitMS, szBuf);
+		g_iGroupCommitMS = MAX(0, g_iGroupCommitMS);
+		sys_log(0, "GROUP_COMMIT_MS: %d", g_iGroupCommitMS);
+	}
+
+	if (CConfig::instance().GetValue("GUILD_WARM_DAYS", szBuf, 256))
+	{
+		str_to_number(g_iGuildWarmDays, szBuf);
+		g_iGuildWarmDays = MAX(0, g_iGuildWarmDays);
+		sys_log(0, "GUILD_WARM_DAYS: %d", g_iGuildWarmDays);
+	}
+
+	if (CConfig::instance().GetValue("ITEM_AWARD_LOAD_BATCH", szBuf, 256))
+	{
+		str_to_number(g_iItemAwardLoadBatch, szBuf);
+		g_iItemAwardLoadBatch = MAX(1, g_iItemAwardLoadBatch);
+		sys_log(0, "ITEM_AWARD_LOAD_BATCH: %d", g_iItemAwardLoadBatch);
+	}
+
+	if (CConfig::instance().GetValue("ITEM_AWARD_POLL_SECONDS", szBuf, 256))
+	{
+		str_to_number(g_iItemAwardPollSeconds, szBuf);
+		g_iItemAwardPollSeconds = MAX(1, g_iItemAwardPollSeconds);
+		sys_log(0, "ITEM_AWARD_POLL_SECONDS: %d", g_iItemAwardPollSeconds);
+	}
+
+	if (CConfig::instance().GetValue("PLAYER_PREFETCH_SECONDS", szBuf, 256))
+	{
+		str_to_number(g_iPlayerPrefetchSeconds, szBuf);
+		g_iPlayerPrefetchSeconds = MAX(0, g_iPlayerPrefetchSeconds);
+		sys_log(0, "PLAYER_PREFETCH_SECONDS: %d", g_iPlayerPrefetchSeconds);
+	}
+
+	if (CConfig::instance().GetValue("SAFEBOX_CACHE_SECONDS", szBuf, 256))
+	{
+		str_to_number(g_iSafeboxCacheSeconds, szBuf);
+		g_iSafeboxCacheSeconds = MAX(0, g_iSafeboxCacheSeconds);
+		sys_log(0, "SAFEBOX_CACHE_SECONDS: %d", g_iSafeboxCacheSeconds);
+	}
+
 	// MYSHOP_PRICE_LIST
 	if (CConfig::instance().GetValue("ITEM_PRICELIST_CACHE_FLUSH_SECONDS", szBuf, 256)) 
 	{
@@ -223,6 +370,14 @@ int Start()
 	int iPort;
 	char line[256+1];
 
+	// player  ReturnQuery/AsyncQuery  .  player    ῡ  ȴ.
+	int iPlayerSQLPoolSize = 1;
+	if (CConfig::instance().GetValue("SQL_PLAYER_POOL_SIZE", &iPlayerSQLPoolSize))
+	{
+		sys_log(0, "SQL_PLAYER_POOL_SIZE: %d", iPlayerSQLPoolSize);
+		CDBManager::instance().SetPoolSize(SQL_PLAYER, iPlayerSQLPoolSize);
+	}
+
 	if (CConfig::instance().GetValue("SQL_PLAYER", line, 256))
 	{
 		sscanf(line, " %s %s %s %s %d ", szAddr, szDB, szUser, szPassword, &iPort);
@@ -321,6 +476,28 @@ int Start()
 
 	sys_log(0, "   OK");
 
+	int iMetricsPort = 0;
+
+	if (CConfig::instance().GetValue("METRICS_PORT", &iMetricsPort) && iMetricsPort)
+	{
+		char szMetricsIP[64];
+
+		if (!CConfig::instance().GetValue("METRICS_IP", szMetricsIP, sizeof(szMetricsIP)))
+			strlcpy(szMetricsIP, "127.0.0.1", sizeof(szMetricsIP));
+
+		// ޴  METRICS_ALLOW_IP   Ѵ.  127.0.0.1  ޴´.
+		char szAllow[256];
+
+		if (CConfig::instance().GetValue("METRICS_ALLOW_IP", szAllow, sizeof(szAllow)))
+		{
+			for (char * ip = strtok(szAllow, " \t,"); ip; ip = strtok(NULL, " \t,"))
+				metrics_allow_ip(ip);
+		}
+
+		if (metrics_listen(szMetricsIP, iMetricsPort))
+			fprintf(stderr, "Metrics listening on %s:%d\n", szMetricsIP, iMetricsPort);
+	}
+
 #ifndef __WIN32__
 	signal(SIGUSR1, emergency_sig);
 #endif
@@ -3,6 +3,7 @@
 #include "Main.h"
 #include "DBManager.h"
 #include "ClientManager.h"
+#include "QID.h"
 
 namespace marriage
 {
@@ -36,14 +37,26 @@ namespace marriage
 	{
 		char szQuery[1024];
 
+		// ȥ (is_married = 0)   Ƿ  ʴ´.
+		//   ʵ  񵿱 а ResultLoad  ä.
 		snprintf(szQuery, sizeof(szQuery),
-				"SELECT pid1, pid2, love_point, time, is_married, p1.name, p2.name FROM marriage, player%s as p1, player%s as p2 WHERE p1.id = pid1 AND p2.id = pid2",
+				"SELECT pid1, pid2, love_point, time, is_married, p1.name, p2.name FROM marriage, player%s as p1, player%s as p2 WHERE p1.id = pid1 AND p2.id = pid2 AND is_married <> 0",
 				GetTablePostfix(), GetTablePostfix());
 
-		unique_ptr<SQLMsg> pmsg_delete(CDBManager::instance().DirectQuery("DELETE FROM marriage WHERE is_married = 0"));
-		unique_ptr<SQLMsg> pmsg(CDBManager::instance().DirectQuery(szQuery));
+		CDBManager::instance().AsyncQuery("DELETE FROM marriage WHERE is_married = 0");
+		CDBManager::instance().ReturnQuery(szQuery, QID_MARRIAGE_LOAD, 0, NULL);
+		return true;
+	}
 
-		SQLResult * pRes = pmsg->Get();
+	void CManager::ResultLoad(SQLMsg * msg)
+	{
+		if (msg->uiSQLErrno != 0 || !msg->Get()->pSQLResult)
+		{
+			sys_err("cannot load marriage list");
+			return;
+		}
+
+		SQLResult * pRes = msg->Get();
 		sys_log(0, "MarriageList(size=%lu)", pRes->uiNumRows);
 
 		if (pRes->uiNumRows > 0)
@@ -60,15 +73,34 @@ namespace marriage
 				const char* name1 = row[5];
 				const char* name2 = row[6];
 
+				// д ̿ Add    
+				if (IsMarried(pid1) || IsMarried(pid2))
+					continue;
+
 				TMarriage* pMarriage = new TMarriage(pid1, pid2, love_point, time, is_married, name1, name2);
 				m_Marriages.insert(pMarriage);
 				m_MarriageByPID.insert(make_pair(pid1, pMarriage));
 				m_MarriageByPID.insert(make_pair(pid2, pMarriage));
 
 				sys_log(0, "Marriage %lu: LP:%d TM:%u ST:%d %10lu:%16s %10lu:%16s ", uiRow, love_point, time, is_married, pid1, name1, pid2, name2);
+
+				// ̹ OnSetup  ģ peer Դ ⼭ .  ϴ peer  OnSetup  ޴´.
+				TPacketMarriageAdd p;
+				p.dwPID1 = pid1;
+				p.dwPID2 = pid2;
+				p.tMarryTime = time;
+				strlcpy(p.szName1, name1, sizeof(p.szName1));
+				strlcpy(p.szName2, name2, sizeof(p.szName2));
+				CClientManager::instance().ForwardPacket(HEADER_DG_MARRIAGE_ADD, &p, sizeof(p));
+
+				TPacketMarriageUpdate p2;
+				p2.dwPID1 = pid1;
+				p2.dwPID2 = pid2;
+				p2.iLovePoint = love_point;
+				p2.byMarried = is_married;
+				CClientManager::instance().ForwardPacket(HEADER_DG_MARRIAGE_UPDATE, &p2, sizeof(p2));
 			}
 		}
-		return true;
 	}
 
 	TMarriage* CManager::Get(DWORD dwPlayerID)
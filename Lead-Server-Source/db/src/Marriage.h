@@ -7,6 +7,7 @@
 #include <deque>
 
 #include "Peer.h"
+#include "../../libsql/libsql.h"
 
 namespace marriage
 {
@@ -77,6 +78,7 @@ namespace marriage
 			virtual ~CManager();
 
 			bool Initialize();
+			void ResultLoad(SQLMsg * msg);
 
 			TMarriage* Get(DWORD dwPlayerID);
 			bool IsMarried(DWORD dwPlayerID)
@@ -10,8 +10,10 @@ CPeer::CPeer()
 	m_dwUserCount = 0;
 	m_wListenPort = 0;
 	m_wP2PPort = 0;
+	m_bRecvBacklog = false;
 
 	memset(m_alMaps, 0, sizeof(m_alMaps));
+	memset(m_adwEmpireUserCount, 0, sizeof(m_adwEmpireUserCount));
 
 	m_itemRange.dwMin = m_itemRange.dwMax = m_itemRange.dwUsableItemIDMin = 0;
 	m_itemSpareRange.dwMin = m_itemSpareRange.dwMax = m_itemSpareRange.dwUsableItemIDMin = 0;
@@ -67,6 +69,11 @@ void CPeer::SetUserCount(DWORD dwCount)
 	m_dwUserCount = dwCount;
 }
 
+void CPeer::SetEmpireUserCount(const DWORD * c_pdwCount)
+{
+	thecore_memcpy(m_adwEmpireUserCount, c_pdwCount, sizeof(m_adwEmpireUserCount));
+}
+
 bool CPeer::PeekPacket(int & iBytesProceed, BYTE & header, DWORD & dwHandle, DWORD & dwLength, const char ** data)
 {
 	if (GetRecvLength() < iBytesProceed + 9)
@@ -109,6 +116,22 @@ void CPeer::EncodeHeader(BYTE header, DWORD dwHandle, DWORD dwSize)
 	Encode(&h, sizeof(HEADER));
 }
 
+void * CPeer::EncodePacket(BYTE header, DWORD dwHandle, DWORD dwSize)
+{
+	sys_log(1, "EncodePacket %u handle %u size %u", header, dwHandle, dwSize);
+
+	char * p = (char *) EncodeReserve(sizeof(HEADER) + dwSize);
+
+	if (!p)
+		return NULL;
+
+	HEADER * h = (HEADER *) p;
+	h->bHeader = header;
+	h->dwHandle = dwHandle;
+	h->dwSize = dwSize;
+	return p + sizeof(HEADER);
+}
+
 void CPeer::EncodeReturn(BYTE header, DWORD dwHandle)
 {
 	EncodeHeader(header, dwHandle, 0);
@@ -30,6 +30,8 @@ class CPeer : public CPeerBase
 	virtual ~CPeer();
 
 	void	EncodeHeader(BYTE header, DWORD dwHandle, DWORD dwSize);
+	// + ũ⸦   Ƽ  ä   ġ ش.
+	void *	EncodePacket(BYTE header, DWORD dwHandle, DWORD dwSize);
 	bool 	PeekPacket(int & iBytesProceed, BYTE & header, DWORD & dwHandle, DWORD & dwLength, const char ** data);
 	void	EncodeReturn(BYTE header, DWORD dwHandle);
 
@@ -39,6 +41,8 @@ class CPeer : public CPeerBase
 	DWORD	GetHandle();
 	DWORD	GetUserCount();
 	void	SetUserCount(DWORD dwCount);
+	void	SetEmpireUserCount(const DWORD * c_pdwCount);
+	const DWORD * GetEmpireUserCount() const	{ return m_adwEmpireUserCount; }
 
 	void	SetPublicIP(const char * ip)	{ m_stPublicIP = ip; }
 	const char * GetPublicIP()		{ return m_stPublicIP.c_str(); }
@@ -55,6 +59,10 @@ class CPeer : public CPeerBase
 	void	SetMaps(long* pl);
 	long *	GetMaps() { return &m_alMaps[0]; }
 
+	// Ŷ   Ἥ  Ŷ   ִ
+	void	SetRecvBacklog(bool bBacklog)	{ m_bRecvBacklog = bBacklog; }
+	bool	HasRecvBacklog() const		{ return m_bRecvBacklog; }
+
 	bool	SetItemIDRange(TItemIDRangeTable itemRange);
 	bool	SetSpareItemIDRange(TItemIDRangeTable itemRange);
 	bool	CheckItemIDRangeCollision(TItemIDRangeTable itemRange);
@@ -66,9 +74,11 @@ class CPeer : public CPeerBase
 	BYTE	m_bChannel;
 	DWORD	m_dwHandle;
 	DWORD	m_dwUserCount;
+	DWORD	m_adwEmpireUserCount[EMPIRE_MAX_NUM];
 	WORD	m_wListenPort;	// Ӽ Ŭ̾Ʈ  listen ϴ Ʈ
 	WORD	m_wP2PPort;	// Ӽ Ӽ P2P   listen ϴ Ʈ
 	long	m_alMaps[32];	//   ϰ ִ°?
+	bool	m_bRecvBacklog;
 
 	TItemIDRangeTable m_itemRange;
 	TItemIDRangeTable m_itemSpareRange;
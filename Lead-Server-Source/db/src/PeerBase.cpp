@@ -143,6 +143,22 @@ void CPeerBase::Encode(const void* data, DWORD size)
 	fdwatch_add_fd(m_fdWatcher, m_fd, this, FDW_WRITE, true);
 }
 
+void * CPeerBase::EncodeReserve(DWORD size)
+{
+	if (!m_outBuffer)
+	{
+		sys_err("Not ready to write");
+		return NULL;
+	}
+
+	buffer_adjust_size(m_outBuffer, size);
+
+	void * p = buffer_write_peek(m_outBuffer);
+	buffer_write_proceed(m_outBuffer, size);
+	fdwatch_add_fd(m_fdWatcher, m_fd, this, FDW_WRITE, true);
+	return p;
+}
+
 int CPeerBase::Recv()
 {
 	if (!m_inBuffer)
@@ -37,6 +37,9 @@ class CPeerBase : public CNetBase
 	void		EncodeWORD(WORD w);
 	void		EncodeDWORD(DWORD dw);
 	void		Encode(const void* data, DWORD size);
+	// size ŭ  ۿ ̸ Ƶΰ  ġ ش. ȣڴ ٷ ä ϸ
+	// ʹ  Encode* ȣ  ȿϴ.
+	void *		EncodeReserve(DWORD size);
 	int		Send();
 
 	int		Recv();
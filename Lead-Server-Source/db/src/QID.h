@@ -33,6 +33,14 @@ enum QID
     QID_ITEMPRICE_LOAD_FOR_UPDATE,	///< 23,  Ʈ    ε 
     QID_ITEMPRICE_LOAD,			///< 24,   ε 
 	// END_OF_MYSHOP_PRICE_LIST
+
+    QID_PLAYER_COMPOSITE,		// 25, player/item/quest/affect   
+    QID_ITEM_COMPOSITE,			// 26, item/quest/affect   
+    QID_QUEST_COMPOSITE,		// 27, quest/affect   
+    QID_PLAYER_PREFETCH_INDEX,		// 28,  α   ĳ id
+    QID_PLAYER_PREFETCH,		// 29,  α  ĳ 
+    QID_GUILD_LOAD,			// 30, α   б
+    QID_MARRIAGE_LOAD,			// 31,   ȥ  (񵿱)
 };
 
 #endif
@@ -20,10 +20,16 @@ extern int passes_per_sec;
 
 time_t UseBlueDragonSkill(LPCHARACTER pChar, unsigned int idx)
 {
-	LPSECTREE_MAP pSecMap = SECTREE_MANAGER::instance().GetMap( pChar->GetMapIndex() );
+	if (NULL == SECTREE_MANAGER::instance().GetMap( pChar->GetMapIndex() ))
+		return 0;
 
-	if (NULL == pSecMap)
+	if (idx >= BLUEDRAGON_SKILL_MAX_NUM)
+	{
+		sys_err("BlueDragon: Wrong Skill Index: %d", idx);
 		return 0;
+	}
+
+	const TBlueDragonSkillSetting & c_rkSkill = BlueDragon_GetSetting().akSkill[idx];
 
 	int nextUsingTime = 0;
 
@@ -35,9 +41,9 @@ time_t UseBlueDragonSkill(LPCHARACTER pChar, unsigned int idx)
 
 				FSkillBreath f(pChar);
 
-				pSecMap->for_each( f );
+				f.Resolve();
 
-				nextUsingTime = number(BlueDragon_GetSkillFactor(3, "Skill0", "period", "min"), BlueDragon_GetSkillFactor(3, "Skill0", "period", "max"));
+				nextUsingTime = number(c_rkSkill.kPeriod.iMin, c_rkSkill.kPeriod.iMax);
 			}
 			break;
 
@@ -47,9 +53,9 @@ time_t UseBlueDragonSkill(LPCHARACTER pChar, unsigned int idx)
 
 				FSkillWeakBreath f(pChar);
 
-				pSecMap->for_each( f );
+				f.Resolve();
 
-				nextUsingTime = number(BlueDragon_GetSkillFactor(3, "Skill1", "period", "min"), BlueDragon_GetSkillFactor(3, "Skill1", "period", "max"));
+				nextUsingTime = number(c_rkSkill.kPeriod.iMin, c_rkSkill.kPeriod.iMax);
 			}
 			break;
 
@@ -59,9 +65,9 @@ time_t UseBlueDragonSkill(LPCHARACTER pChar, unsigned int idx)
 
 				FSkillEarthQuake f(pChar);
 
-				pSecMap->for_each( f );
+				f.Resolve();
 
-				nextUsingTime = number(BlueDragon_GetSkillFactor(3, "Skill2", "period", "min"), BlueDragon_GetSkillFactor(3, "Skill2", "period", "max"));
+				nextUsingTime = number(c_rkSkill.kPeriod.iMin, c_rkSkill.kPeriod.iMax);
 
 				if (NULL != f.pFarthestChar)
 				{
@@ -75,40 +81,41 @@ time_t UseBlueDragonSkill(LPCHARACTER pChar, unsigned int idx)
 			return 0;
 	}
 
-	int addPct = BlueDragon_GetRangeFactor("hp_period", pChar->GetHPPct());
+	int addPct = BlueDragon_GetRangePct(BlueDragon_GetSetting().vec_kHPPeriod, pChar->GetHPPct());
 
 	nextUsingTime += (nextUsingTime * addPct) / 100;
 
 	return nextUsingTime;
 }
 
+// ü  ų 켱.  ü iHPPctAbove   ù  .
+static const struct SBlueDragonSkillPriority
+{
+	int iHPPctAbove;
+	int aiSkill[BLUEDRAGON_SKILL_MAX_NUM];
+} s_akBlueDragonSkillPriority[] =
+{
+	{	76,	{ 1, 0, 2 }	},
+	{	31,	{ 0, 1, 2 }	},
+	{	-1,	{ 0, 2, 1 }	},
+};
+
 int BlueDragon_StateBattle(LPCHARACTER pChar)
 {
-	if (pChar->GetHPPct() > 98)
+	const int iHPPct = pChar->GetHPPct();
+
+	if (iHPPct > 98)
 		return PASSES_PER_SEC(1);
 
-	const int SkillCount = 3;
-	int SkillPriority[SkillCount];
+	const int SkillCount = BLUEDRAGON_SKILL_MAX_NUM;
 	static time_t timeSkillCanUseTime[SkillCount];
 
-	if (pChar->GetHPPct() > 76)
-	{
-		SkillPriority[0] = 1;
-		SkillPriority[1] = 0;
-		SkillPriority[2] = 2;
-	}
-	else if (pChar->GetHPPct() > 31)
-	{
-		SkillPriority[0] = 0;
-		SkillPriority[1] = 1;
-		SkillPriority[2] = 2;
-	}
-	else
-	{
-		SkillPriority[0] = 0;
-		SkillPriority[1] = 2;
-		SkillPriority[2] = 1;
-	}
+	const SBlueDragonSkillPriority * pkPriority = &s_akBlueDragonSkillPriority[0];
+
+	while (iHPPct <= pkPriority->iHPPctAbove)
+		++pkPriority;
+
+	const int * SkillPriority = pkPriority->aiSkill;
 
 	time_t timeNow = static_cast<time_t>(get_dword_time());
 
@@ -139,57 +146,28 @@ int BlueDragon_Damage (LPCHARACTER me, LPCHARACTER pAttacker, int dam)
 
 	if (true == pAttacker->IsMonster() && 2493 == pAttacker->GetMobTable().dwVnum)
 	{
-		for (int i=1 ; i <= 4 ; ++i)
-		{
-			if (ATK_BONUS == BlueDragon_GetIndexFactor("DragonStone", i, "effect_type"))
-			{
-				DWORD dwDragonStoneID = BlueDragon_GetIndexFactor("DragonStone", i, "vnum");
-				size_t val = BlueDragon_GetIndexFactor("DragonStone", i, "val");
-				size_t cnt = SECTREE_MANAGER::instance().GetMonsterCountInMap( pAttacker->GetMapIndex(), dwDragonStoneID );
-
-				dam += (dam * (val*cnt))/100;
-
-				break;
-			}
-		}
+		dam += (dam * BlueDragon_GetStoneBonus(pAttacker->GetMapIndex(), ATK_BONUS))/100;
 	}
 
 	if (true == me->IsMonster() && 2493 == me->GetMobTable().dwVnum)
 	{
-		for (int i=1 ; i <= 4 ; ++i)
-		{
-			if (DEF_BONUS == BlueDragon_GetIndexFactor("DragonStone", i, "effect_type"))
-			{
-				DWORD dwDragonStoneID = BlueDragon_GetIndexFactor("DragonStone", i, "vnum");
-				size_t val = BlueDragon_GetIndexFactor("DragonStone", i, "val");
-				size_t cnt = SECTREE_MANAGER::instance().GetMonsterCountInMap( me->GetMapIndex(), dwDragonStoneID );
+		const int iDefBonus = BlueDragon_GetStoneBonus(me->GetMapIndex(), DEF_BONUS);
 
-				dam -= (dam * (val*cnt))/100;
-
-				if (dam <= 0)
-					dam = 1;
+		if (0 != iDefBonus)
+		{
+			dam -= (dam * iDefBonus)/100;
 
-				break;
-			}
+			if (dam <= 0)
+				dam = 1;
 		}
 	}
 
 	if (true == me->IsStone() && 0 != pAttacker->GetMountVnum())
 	{
-		for (int i=1 ; i <= 4 ; ++i)
-		{
-			if (me->GetMobTable().dwVnum == BlueDragon_GetIndexFactor("DragonStone", i, "vnum"))
-			{
-				if (pAttacker->GetMountVnum() == BlueDragon_GetIndexFactor("DragonStone", i, "enemy"))
-				{
-					size_t val = BlueDragon_GetIndexFactor("DragonStone", i, "enemy_val");
+		unsigned int val = 0;
 
-					dam *= val;
-
-					break;
-				}
-			}
-		}
+		if (true == BlueDragon_FindStoneEnemy(me->GetMobTable().dwVnum, pAttacker->GetMountVnum(), &val))
+			dam *= val;
 	}
 
 	return dam;
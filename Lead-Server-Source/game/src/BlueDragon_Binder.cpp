@@ -4,166 +4,148 @@
 #include "BlueDragon_Binder.h"
 
 #include "questmanager.h"
+#include "char.h"
+#include "sectree_manager.h"
 
-unsigned int BlueDragon_GetSkillFactor(const size_t cnt, ...)
-{
-	lua_State* L = quest::CQuestManager::instance().GetLuaState();
+static TBlueDragonSetting s_kBlueDragonSetting;
 
-	const int stack_top = lua_gettop(L);
+static const char* s_apszBlueDragonJobKey[JOB_MAX_NUM] = { "musa", "assa", "sura", "muda" };
+static const char* s_apszBlueDragonSexKey[BLUEDRAGON_SEX_MAX_NUM] = { "male", "female" };
 
-	lua_getglobal( L, "BlueDragonSetting" );
+//  top  ̺ key  ã ø. ̺ ƴϸ ƹ͵  ʴ´.
+static bool BlueDragon_PushTable(lua_State* L, const char* key)
+{
+	lua_pushstring( L, key );
+	lua_gettable( L, -2 );
 
 	if (false == lua_istable(L, -1))
 	{
-		lua_settop( L, stack_top );
-
-		return 0;
-	}
-
-	va_list vl;
-
-	va_start(vl, cnt);
-
-	for( size_t i=0 ; i < cnt ; ++i )
-	{
-		const char* key = va_arg(vl, const char*);
-
-		if (NULL == key)
-		{
-			va_end(vl);
-			lua_settop( L, stack_top );
-			sys_err("BlueDragon: wrong key list");
-			return 0;
-		}
-
-		lua_pushstring( L, key );
-		lua_gettable( L, -2 );
-
-		if (false == lua_istable(L, -1) && i != cnt-1)
-		{
-			va_end(vl);
-			lua_settop( L, stack_top );
-			sys_err("BlueDragon: wrong key table %s", key);
-			return 0;
-		}
+		lua_pop(L, 1);
+		return false;
 	}
 
-	va_end(vl);
+	return true;
+}
 
-	if (false == lua_isnumber(L, -1))
-	{
-		lua_settop( L, stack_top );
-		sys_err("BlueDragon: Last key is not a number");
-		return 0;
-	}
+static int BlueDragon_GetNumber(lua_State* L, const char* key)
+{
+	lua_pushstring( L, key );
+	lua_gettable( L, -2 );
 
-	int val = static_cast<int>(lua_tonumber( L, -1 ));
+	const int val = lua_isnumber(L, -1) ? static_cast<int>(lua_tonumber(L, -1)) : 0;
 
-	lua_settop( L, stack_top );
+	lua_pop(L, 1);
 
 	return val;
 }
 
-unsigned int BlueDragon_GetRangeFactor(const char* key, const int val)
+static void BlueDragon_LoadMinMax(lua_State* L, const char* key, TBlueDragonMinMax & r)
 {
-	lua_State* L = quest::CQuestManager::instance().GetLuaState();
-
-	const int stack_top = lua_gettop(L);
+	r.iMin = r.iMax = 0;
 
-	lua_getglobal( L, "BlueDragonSetting" );
+	if (false == BlueDragon_PushTable(L, key))
+		return;
 
-	if (false == lua_istable(L, -1))
-	{
-		lua_settop( L, stack_top );
+	r.iMin = BlueDragon_GetNumber(L, "min");
+	r.iMax = BlueDragon_GetNumber(L, "max");
 
-		return 0;
-	}
+	lua_pop(L, 1);
+}
 
-	lua_pushstring( L, key );
-	lua_gettable( L, -2 );
+static void BlueDragon_LoadRangePct(lua_State* L, const char* key, std::vector<TBlueDragonRangePct> & r_vec)
+{
+	r_vec.clear();
 
-	if (false == lua_istable(L, -1))
+	if (false == BlueDragon_PushTable(L, key))
 	{
-		lua_settop( L, stack_top );
-
 		sys_err("BlueDragon: no required table %s", key);
-		return 0;
+		return;
 	}
 
-	const size_t cnt = static_cast<size_t>(luaL_getn(L, -1));
+	const int cnt = luaL_getn(L, -1);
 
-	for( size_t i=1 ; i <= cnt ; ++i )
+	for( int i=1 ; i <= cnt ; ++i )
 	{
 		lua_rawgeti( L, -1, i );
 
-		if (false == lua_istable(L, -1))
+		if (true == lua_istable(L, -1))
 		{
-			lua_settop( L, stack_top );
-
-			sys_err("BlueDragon: wrong table index %s %d", key, i);
-			return 0;
-		}
+			TBlueDragonRangePct k;
 
-		lua_pushstring( L, "min" );
-		lua_gettable( L, -2 );
+			k.iMin = BlueDragon_GetNumber(L, "min");
+			k.iMax = BlueDragon_GetNumber(L, "max");
+			k.iPct = BlueDragon_GetNumber(L, "pct");
 
-		if (false == lua_isnumber(L, -1))
+			r_vec.push_back(k);
+		}
+		else
 		{
-			lua_settop( L, stack_top );
-
-			sys_err("BlueDragon: no min value set %s", key);
-			return 0;
+			sys_err("BlueDragon: wrong table index %s %d", key, i);
 		}
 
-		const int min = static_cast<int>(lua_tonumber(L, -1));
-
 		lua_pop(L, 1);
+	}
 
-		lua_pushstring( L, "max" );
-		lua_gettable( L, -2 );
+	lua_pop(L, 1);
+}
 
-		if (false == lua_isnumber(L, -1))
-		{
-			lua_settop( L, stack_top );
+static void BlueDragon_LoadSkill(lua_State* L, int idx, TBlueDragonSkillSetting & r)
+{
+	memset(&r, 0, sizeof(r));
 
-			sys_err("BlueDragon: no max value set %s", key);
-			return 0;
-		}
+	char szKey[16];
+	snprintf(szKey, sizeof(szKey), "Skill%d", idx);
 
-		const int max = static_cast<int>(lua_tonumber(L, -1));
+	if (false == BlueDragon_PushTable(L, szKey))
+	{
+		sys_err("BlueDragon: no required table %s", szKey);
+		return;
+	}
 
-		lua_pop(L, 1);
+	r.iDamageArea = BlueDragon_GetNumber(L, "damage_area");
 
-		if (min <= val && val <= max)
-		{
-			lua_pushstring( L, "pct" );
-			lua_gettable( L, -2 );
+	BlueDragon_LoadMinMax(L, "period", r.kPeriod);
+	BlueDragon_LoadMinMax(L, "default_damage", r.kDefaultDamage);
 
-			if (false == lua_isnumber(L, -1))
-			{
-				lua_settop( L, stack_top );
+	if (true == BlueDragon_PushTable(L, "damage"))
+	{
+		for (int i=0 ; i < JOB_MAX_NUM ; ++i)
+			BlueDragon_LoadMinMax(L, s_apszBlueDragonJobKey[i], r.akJobDamage[i]);
 
-				sys_err("BlueDragon: no pct value set %s", key);
-				return 0;
-			}
+		lua_pop(L, 1);
+	}
 
-			const int pct = static_cast<int>(lua_tonumber(L, -1));
+	if (true == BlueDragon_PushTable(L, "gender"))
+	{
+		for (int i=0 ; i < BLUEDRAGON_SEX_MAX_NUM ; ++i)
+			BlueDragon_LoadMinMax(L, s_apszBlueDragonSexKey[i], r.akGender[i]);
 
-			lua_settop( L, stack_top );
+		lua_pop(L, 1);
+	}
 
-			return pct;
-		}
+	if (true == BlueDragon_PushTable(L, "stun_time"))
+	{
+		BlueDragon_LoadMinMax(L, "default", r.kStunDefault);
+
+		for (int i=0 ; i < JOB_MAX_NUM ; ++i)
+			BlueDragon_LoadMinMax(L, s_apszBlueDragonJobKey[i], r.akJobStun[i]);
 
 		lua_pop(L, 1);
 	}
 
-	lua_settop( L, stack_top );
-
-	return 0;
+	lua_pop(L, 1);
 }
 
-unsigned int BlueDragon_GetIndexFactor(const char* container, const size_t idx, const char* key)
+void BlueDragon_LoadSetting()
 {
+	for (int i=0 ; i < BLUEDRAGON_SKILL_MAX_NUM ; ++i)
+		memset(&s_kBlueDragonSetting.akSkill[i], 0, sizeof(TBlueDragonSkillSetting));
+
+	s_kBlueDragonSetting.vec_kHPPeriod.clear();
+	s_kBlueDragonSetting.vec_kHPDamage.clear();
+	s_kBlueDragonSetting.vec_kHPRegen.clear();
+	memset(s_kBlueDragonSetting.akStone, 0, sizeof(s_kBlueDragonSetting.akStone));
+
 	lua_State* L = quest::CQuestManager::instance().GetLuaState();
 
 	const int stack_top = lua_gettop(L);
@@ -174,45 +156,136 @@ unsigned int BlueDragon_GetIndexFactor(const char* container, const size_t idx,
 	{
 		lua_settop( L, stack_top );
 
-		return 0;
+		return;
 	}
 
-	lua_pushstring( L, container );
-	lua_gettable( L, -2 );
+	for (int i=0 ; i < BLUEDRAGON_SKILL_MAX_NUM ; ++i)
+		BlueDragon_LoadSkill(L, i, s_kBlueDragonSetting.akSkill[i]);
 
-	if (false == lua_istable(L, -1))
+	BlueDragon_LoadRangePct(L, "hp_period", s_kBlueDragonSetting.vec_kHPPeriod);
+	BlueDragon_LoadRangePct(L, "hp_damage", s_kBlueDragonSetting.vec_kHPDamage);
+	BlueDragon_LoadRangePct(L, "hp_regen", s_kBlueDragonSetting.vec_kHPRegen);
+
+	if (true == BlueDragon_PushTable(L, "DragonStone"))
 	{
-		lua_settop( L, stack_top );
+		for (int i=0 ; i < BLUEDRAGON_STONE_MAX_NUM ; ++i)
+		{
+			lua_rawgeti( L, -1, i + 1 );
 
-		sys_err("BlueDragon: no required table %s", key);
-		return 0;
-	}
+			if (true == lua_istable(L, -1))
+			{
+				TBlueDragonStone & r = s_kBlueDragonSetting.akStone[i];
 
-	lua_rawgeti( L, -1, idx );
+				r.dwVnum		= BlueDragon_GetNumber(L, "vnum");
+				r.uEffectType	= BlueDragon_GetNumber(L, "effect_type");
+				r.uVal			= BlueDragon_GetNumber(L, "val");
+				r.dwEnemy		= BlueDragon_GetNumber(L, "enemy");
+				r.uEnemyVal		= BlueDragon_GetNumber(L, "enemy_val");
+			}
 
-	if (false == lua_istable(L, -1))
+			lua_pop(L, 1);
+		}
+	}
+	else
 	{
-		lua_settop( L, stack_top );
+		sys_err("BlueDragon: no required table DragonStone");
+	}
+
+	lua_settop( L, stack_top );
 
-		sys_err("BlueDragon: wrong table index %s %d", key, idx);
-		return 0;
+	sys_log(0, "BlueDragon: setting loaded (hp_period %u hp_damage %u hp_regen %u)",
+			s_kBlueDragonSetting.vec_kHPPeriod.size(), s_kBlueDragonSetting.vec_kHPDamage.size(), s_kBlueDragonSetting.vec_kHPRegen.size());
+}
+
+const TBlueDragonSetting & BlueDragon_GetSetting()
+{
+	return s_kBlueDragonSetting;
+}
+
+int BlueDragon_GetRangePct(const std::vector<TBlueDragonRangePct> & c_rvec, const int val)
+{
+	for (size_t i=0 ; i < c_rvec.size() ; ++i)
+	{
+		if (c_rvec[i].iMin <= val && val <= c_rvec[i].iMax)
+			return c_rvec[i].iPct;
 	}
 
-	lua_pushstring( L, key );
-	lua_gettable( L, -2 );
+	return 0;
+}
 
-	if (false == lua_isnumber(L, -1))
+struct FCountBlueDragonStone
+{
+	size_t m_auCount[BLUEDRAGON_STONE_MAX_NUM];
+
+	FCountBlueDragonStone()
 	{
-		lua_settop( L, stack_top );
+		memset(m_auCount, 0, sizeof(m_auCount));
+	}
+
+	void operator() (LPENTITY ent)
+	{
+		if (true == ent->IsType(ENTITY_CHARACTER))
+		{
+			LPCHARACTER pChar = static_cast<LPCHARACTER>(ent);
 
-		sys_err("BlueDragon: no min value set %s", key);
-		return 0;
+			if (true == pChar->IsStone())
+			{
+				for (int i=0 ; i < BLUEDRAGON_STONE_MAX_NUM ; ++i)
+				{
+					if (pChar->GetMobTable().dwVnum == s_kBlueDragonSetting.akStone[i].dwVnum)
+						m_auCount[i]++;
+				}
+			}
+		}
 	}
+};
 
-	const unsigned int ret = static_cast<unsigned int>(lua_tonumber(L, -1));
+//  뼮    ü  ʵ   ʰ pulse   д.
+static long		s_lStoneCountMapIndex = 0;
+static int		s_iStoneCountPulse = -1;
+static size_t	s_auStoneCount[BLUEDRAGON_STONE_MAX_NUM];
 
-	lua_settop( L, stack_top );
+int BlueDragon_GetStoneBonus(long lMapIndex, unsigned int uEffectType)
+{
+	for (int i=0 ; i < BLUEDRAGON_STONE_MAX_NUM ; ++i)
+	{
+		const TBlueDragonStone & r = s_kBlueDragonSetting.akStone[i];
 
-	return ret;
+		if (r.uEffectType != uEffectType)
+			continue;
+
+		if (s_lStoneCountMapIndex != lMapIndex || s_iStoneCountPulse != thecore_pulse())
+		{
+			FCountBlueDragonStone f;
+
+			LPSECTREE_MAP pSecMap = SECTREE_MANAGER::instance().GetMap( lMapIndex );
+
+			if (NULL != pSecMap)
+				pSecMap->for_each_kind( SPATIAL_KIND_NPC, f );
+
+			memcpy(s_auStoneCount, f.m_auCount, sizeof(s_auStoneCount));
+			s_lStoneCountMapIndex = lMapIndex;
+			s_iStoneCountPulse = thecore_pulse();
+		}
+
+		return r.uVal * s_auStoneCount[i];
+	}
+
+	return 0;
 }
 
+bool BlueDragon_FindStoneEnemy(DWORD dwStoneVnum, DWORD dwMountVnum, unsigned int * puEnemyVal)
+{
+	for (int i=0 ; i < BLUEDRAGON_STONE_MAX_NUM ; ++i)
+	{
+		const TBlueDragonStone & r = s_kBlueDragonSetting.akStone[i];
+
+		if (r.dwVnum == dwStoneVnum && r.dwEnemy == dwMountVnum)
+		{
+			*puEnemyVal = r.uEnemyVal;
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -1,4 +1,6 @@
 
+#include "common/length.h"
+
 enum BLUEDRAGON_STONE_EFFECT
 {
 	DEF_BONUS	=	1,
@@ -7,7 +9,61 @@ enum BLUEDRAGON_STONE_EFFECT
 	REGEN_PECT_BONUS	=	4,
 };
 
-extern unsigned int BlueDragon_GetRangeFactor (const char* key, const int val);
-extern unsigned int BlueDragon_GetSkillFactor (const size_t cnt, ...);
-extern unsigned int BlueDragon_GetIndexFactor (const char* container, const size_t idx, const char* key);
+enum
+{
+	BLUEDRAGON_SKILL_MAX_NUM	=	3,
+	BLUEDRAGON_STONE_MAX_NUM	=	4,
+	BLUEDRAGON_SEX_MAX_NUM		=	2,
+};
+
+struct TBlueDragonMinMax
+{
+	int iMin;
+	int iMax;
+};
+
+struct TBlueDragonRangePct
+{
+	int iMin;
+	int iMax;
+	int iPct;
+};
+
+struct TBlueDragonStone
+{
+	DWORD dwVnum;
+	unsigned int uEffectType;
+	unsigned int uVal;
+	DWORD dwEnemy;
+	unsigned int uEnemyVal;
+};
+
+struct TBlueDragonSkillSetting
+{
+	int iDamageArea;
+	TBlueDragonMinMax kPeriod;
+	TBlueDragonMinMax kDefaultDamage;
+	TBlueDragonMinMax akJobDamage[JOB_MAX_NUM];			// Skill0 damage.<job>
+	TBlueDragonMinMax akGender[BLUEDRAGON_SEX_MAX_NUM];	// Skill0, Skill2 gender.<sex>
+	TBlueDragonMinMax kStunDefault;						// Skill2 stun_time.default
+	TBlueDragonMinMax akJobStun[JOB_MAX_NUM];			// Skill2 stun_time.<job>
+};
+
+// settings.lua  BlueDragonSetting  Ʈ Lua  ʱȭ  ѹ о  ǥ.
+//   ų , , ȸ  Lua  θ ʰ ̰ .
+struct TBlueDragonSetting
+{
+	TBlueDragonSkillSetting akSkill[BLUEDRAGON_SKILL_MAX_NUM];
+	std::vector<TBlueDragonRangePct> vec_kHPPeriod;
+	std::vector<TBlueDragonRangePct> vec_kHPDamage;
+	std::vector<TBlueDragonRangePct> vec_kHPRegen;
+	TBlueDragonStone akStone[BLUEDRAGON_STONE_MAX_NUM];		// DragonStone[1..4]
+};
+
+extern void BlueDragon_LoadSetting ();
+extern const TBlueDragonSetting & BlueDragon_GetSetting ();
+extern int BlueDragon_GetRangePct (const std::vector<TBlueDragonRangePct> & c_rvec, const int val);
+// effect_type  ´ ù 뼮 val * ʿ  ִ  뼮 . 뼮  ʸ pulse  ѹ .
+extern int BlueDragon_GetStoneBonus (long lMapIndex, unsigned int uEffectType);
+extern bool BlueDragon_FindStoneEnemy (DWORD dwStoneVnum, DWORD dwMountVnum, unsigned int * puEnemyVal);
 
@@ -1,11 +1,43 @@
+//  ų   PC   Ƿ ѹ  ,  ü¿     ѹ ϰ
+// 󸶴     ʷ Ѵ.   BlueDragon_GetSetting  ǥ д´.
+struct FBlueDragonSkillTargets
+{
+	std::vector<LPENTITY> vecEntity;
+	std::vector<LPCHARACTER> vecTarget;
+
+	void Collect(LPCHARACTER pAttacker, int iRange)
+	{
+		vecEntity.clear();
+		vecTarget.clear();
+
+		SECTREE_MANAGER::instance().FindInRange(pAttacker->GetMapIndex(), pAttacker->GetX(), pAttacker->GetY(), iRange, SPATIAL_KIND_PC, vecEntity);
+
+		for (size_t i=0 ; i < vecEntity.size() ; ++i)
+		{
+			LPCHARACTER ch = static_cast<LPCHARACTER>(vecEntity[i]);
+
+			if (true == ch->IsDead())
+				continue;
+
+			if (NULL != ch->FindAffect(AFFECT_REVIVE_INVISIBLE, APPLY_NONE))
+				continue;
+
+			vecTarget.push_back(ch);
+		}
+	}
+};
 
-struct FSkillBreath
+struct FSkillBreath : public FBlueDragonSkillTargets
 {
 	EJobs Set1;
 	EJobs Set2;
 	ESex gender;
 	LPCHARACTER pAttacker;
 
+	std::vector<int> vecDamage;
+	std::vector<int> vecPct;
+	std::vector<int> vecOverlap;
+
 	FSkillBreath(LPCHARACTER p)
 	{
 		pAttacker = p;
@@ -15,165 +47,129 @@ struct FSkillBreath
 		gender = static_cast<ESex>(number(0,2));
 	}
 
-	void operator()(LPENTITY ent)
+	void Resolve()
 	{
-		if (NULL != ent)
+		const TBlueDragonSkillSetting & c_rkSkill = BlueDragon_GetSetting().akSkill[0];
+
+		Collect(pAttacker, c_rkSkill.iDamageArea);
+
+		const int addPct = BlueDragon_GetRangePct(BlueDragon_GetSetting().vec_kHPDamage, pAttacker->GetHPPct());
+
+		vecDamage.resize(vecTarget.size());
+		vecPct.resize(vecTarget.size());
+		vecOverlap.resize(vecTarget.size());
+
+		for (size_t i=0 ; i < vecTarget.size() ; ++i)
 		{
-			if (true == ent->IsType(ENTITY_CHARACTER))
+			LPCHARACTER ch = vecTarget[i];
+
+			int overlapDamageCount = 0;
+
+			int pct = 0;
+			if (ch->GetJob() == Set1)
 			{
-				LPCHARACTER ch = static_cast<LPCHARACTER>(ent);
-
-				if (true == ch->IsPC() && false == ch->IsDead())
-				{
-					if (NULL != ch->FindAffect(AFFECT_REVIVE_INVISIBLE, APPLY_NONE))
-						return;
-
-					if ((signed)BlueDragon_GetSkillFactor(2, "Skill0", "damage_area") < DISTANCE_APPROX(pAttacker->GetX()-ch->GetX(), pAttacker->GetY()-ch->GetY()))
-					{
-						sys_log(0, "BlueDragon: Breath too far (%d)", DISTANCE_APPROX(pAttacker->GetX()-ch->GetX(), pAttacker->GetY()-ch->GetY()) );
-						return;
-					}
-
-					int overlapDamageCount = 0;
-
-					int pct = 0;
-					if (ch->GetJob() == Set1)
-					{
-						const char* ptr = NULL;
-
-						switch ( Set1 )
-						{
-							case JOB_WARRIOR:	ptr = "musa";	break;
-							case JOB_ASSASSIN:	ptr = "assa";	break;
-							case JOB_SURA:		ptr = "sura";	break;
-							case JOB_SHAMAN:	ptr = "muda";	break;
-
-							default:
-							case JOB_MAX_NUM:	return;
-						}
-
-
-						int firstDamagePercent =  number(BlueDragon_GetSkillFactor(4, "Skill0", "damage", ptr, "min"), BlueDragon_GetSkillFactor(4, "Skill0", "damage", ptr, "max"));
-						pct += firstDamagePercent;
-
-						if (firstDamagePercent > 0)
-							overlapDamageCount++;
-					}
-
-					if (ch->GetJob() == Set2)
-					{
-						const char* ptr = NULL;
-
-						switch ( Set2 )
-						{
-							case JOB_WARRIOR:	ptr = "musa";	break;
-							case JOB_ASSASSIN:	ptr = "assa";	break;
-							case JOB_SURA:		ptr = "sura";	break;
-							case JOB_SHAMAN:	ptr = "muda";	break;
-
-							default:
-							case JOB_MAX_NUM:	return;
-						}
-
-						int secondDamagePercent = number(BlueDragon_GetSkillFactor(4, "Skill0", "damage", ptr, "min"), BlueDragon_GetSkillFactor(4, "Skill0", "damage", ptr, "max"));
-						pct += secondDamagePercent;
-
-						if (secondDamagePercent > 0)
-							overlapDamageCount++;
-					}
-
-					if (GET_SEX(ch) == gender)
-					{
-						const char* ptr = NULL;
-
-						switch (gender)
-						{
-							case SEX_MALE:		ptr = "male";	break;
-							case SEX_FEMALE:	ptr = "female";	break;
-							default:			return;
-						}
-
-						int thirdDamagePercent = number(BlueDragon_GetSkillFactor(4, "Skill0", "gender", ptr, "min"), BlueDragon_GetSkillFactor(4, "Skill0", "gender", ptr, "max"));
-						pct += thirdDamagePercent;
-
-						if (thirdDamagePercent > 0)
-							overlapDamageCount++;
-					}
-
-					switch (overlapDamageCount)
-					{
-						case 1:
-							ch->EffectPacket(SE_PERCENT_DAMAGE1);
-							break;
-						case 2:
-							ch->EffectPacket(SE_PERCENT_DAMAGE2);
-							break;
-						case 3:
-							ch->EffectPacket(SE_PERCENT_DAMAGE3);
-							break;
-					}
-
-					int addPct = BlueDragon_GetRangeFactor("hp_damage", pAttacker->GetHPPct());
-
-					pct += addPct;
-
-					int dam = number(BlueDragon_GetSkillFactor(3, "Skill0", "default_damage", "min"), BlueDragon_GetSkillFactor(3, "Skill0", "default_damage", "max"));
-
-					dam += (dam * addPct) / 100;
-					dam += (ch->GetMaxHP() * pct) / 100;
-
-					ch->Damage( pAttacker, dam, DAMAGE_TYPE_ICE );
-
-					sys_log(0, "BlueDragon: Breath to %s pct(%d) dam(%d) overlap(%d)", ch->GetName(), pct, dam, overlapDamageCount);
-				}
+				int firstDamagePercent = number(c_rkSkill.akJobDamage[Set1].iMin, c_rkSkill.akJobDamage[Set1].iMax);
+				pct += firstDamagePercent;
+
+				if (firstDamagePercent > 0)
+					overlapDamageCount++;
 			}
+
+			if (ch->GetJob() == Set2)
+			{
+				int secondDamagePercent = number(c_rkSkill.akJobDamage[Set2].iMin, c_rkSkill.akJobDamage[Set2].iMax);
+				pct += secondDamagePercent;
+
+				if (secondDamagePercent > 0)
+					overlapDamageCount++;
+			}
+
+			if (GET_SEX(ch) == gender)
+			{
+				int thirdDamagePercent = number(c_rkSkill.akGender[gender].iMin, c_rkSkill.akGender[gender].iMax);
+				pct += thirdDamagePercent;
+
+				if (thirdDamagePercent > 0)
+					overlapDamageCount++;
+			}
+
+			pct += addPct;
+
+			int dam = number(c_rkSkill.kDefaultDamage.iMin, c_rkSkill.kDefaultDamage.iMax);
+
+			dam += (dam * addPct) / 100;
+			dam += (ch->GetMaxHP() * pct) / 100;
+
+			vecDamage[i] = dam;
+			vecPct[i] = pct;
+			vecOverlap[i] = overlapDamageCount;
+		}
+
+		for (size_t i=0 ; i < vecTarget.size() ; ++i)
+		{
+			LPCHARACTER ch = vecTarget[i];
+
+			switch (vecOverlap[i])
+			{
+				case 1:
+					ch->EffectPacket(SE_PERCENT_DAMAGE1);
+					break;
+				case 2:
+					ch->EffectPacket(SE_PERCENT_DAMAGE2);
+					break;
+				case 3:
+					ch->EffectPacket(SE_PERCENT_DAMAGE3);
+					break;
+			}
+
+			ch->Damage( pAttacker, vecDamage[i], DAMAGE_TYPE_ICE );
+
+			sys_log(0, "BlueDragon: Breath to %s pct(%d) dam(%d) overlap(%d)", ch->GetName(), vecPct[i], vecDamage[i], vecOverlap[i]);
 		}
 	}
 };
 
-struct FSkillWeakBreath
+struct FSkillWeakBreath : public FBlueDragonSkillTargets
 {
 	LPCHARACTER pAttacker;
 
+	std::vector<int> vecDamage;
+
 	FSkillWeakBreath(LPCHARACTER p)
 	{
 		pAttacker = p;
 	}
 
-	void operator()(LPENTITY ent)
+	void Resolve()
 	{
-		if (NULL != ent)
-		{
-			if (true == ent->IsType(ENTITY_CHARACTER))
-			{
-				LPCHARACTER ch = static_cast<LPCHARACTER>(ent);
+		const TBlueDragonSkillSetting & c_rkSkill = BlueDragon_GetSetting().akSkill[1];
 
-				if (true == ch->IsPC() && false == ch->IsDead())
-				{
-					if (NULL != ch->FindAffect(AFFECT_REVIVE_INVISIBLE, APPLY_NONE))
-						return;
+		Collect(pAttacker, c_rkSkill.iDamageArea);
 
-					if ((signed)BlueDragon_GetSkillFactor(2, "Skill1", "damage_area") < DISTANCE_APPROX(pAttacker->GetX()-ch->GetX(), pAttacker->GetY()-ch->GetY()))
-					{
-						sys_log(0, "BlueDragon: Breath too far (%d)", DISTANCE_APPROX(pAttacker->GetX()-ch->GetX(), pAttacker->GetY()-ch->GetY()) );
-						return;
-					}
+		const int addPct = BlueDragon_GetRangePct(BlueDragon_GetSetting().vec_kHPDamage, pAttacker->GetHPPct());
 
-					int addPct = BlueDragon_GetRangeFactor("hp_damage", pAttacker->GetHPPct());
+		vecDamage.resize(vecTarget.size());
 
-					int dam = number( BlueDragon_GetSkillFactor(3, "Skill1", "default_damage", "min"), BlueDragon_GetSkillFactor(3, "Skill1", "default_damage", "max") );
-					dam += (dam * addPct) / 100;
+		for (size_t i=0 ; i < vecTarget.size() ; ++i)
+		{
+			int dam = number( c_rkSkill.kDefaultDamage.iMin, c_rkSkill.kDefaultDamage.iMax );
+			dam += (dam * addPct) / 100;
 
-					ch->Damage( pAttacker, dam, DAMAGE_TYPE_ICE );
+			vecDamage[i] = dam;
+		}
 
-					sys_log(0, "BlueDragon: WeakBreath to %s addPct(%d) dam(%d)", ch->GetName(), addPct, dam);
-				}
-			}
+		for (size_t i=0 ; i < vecTarget.size() ; ++i)
+		{
+			LPCHARACTER ch = vecTarget[i];
+
+			ch->Damage( pAttacker, vecDamage[i], DAMAGE_TYPE_ICE );
+
+			sys_log(0, "BlueDragon: WeakBreath to %s addPct(%d) dam(%d)", ch->GetName(), addPct, vecDamage[i]);
 		}
 	}
 };
 
-struct FSkillEarthQuake
+struct FSkillEarthQuake : public FBlueDragonSkillTargets
 {
 	EJobs Set1;
 	EJobs Set2;
@@ -182,6 +178,9 @@ struct FSkillEarthQuake
 	LPCHARACTER pAttacker;
 	LPCHARACTER pFarthestChar;
 
+	std::vector<int> vecDamage;
+	std::vector<int> vecStunSec;
+
 	FSkillEarthQuake(LPCHARACTER p)
 	{
 		pAttacker = p;
@@ -194,148 +193,111 @@ struct FSkillEarthQuake
 		gender = static_cast<ESex>(number(0,2));
 	}
 
-	void operator()(LPENTITY ent)
+	void Resolve()
 	{
-		if (NULL != ent)
+		const TBlueDragonSkillSetting & c_rkSkill = BlueDragon_GetSetting().akSkill[2];
+
+		Collect(pAttacker, c_rkSkill.iDamageArea);
+
+		const int addPct = BlueDragon_GetRangePct(BlueDragon_GetSetting().vec_kHPDamage, pAttacker->GetHPPct());
+
+		vecDamage.resize(vecTarget.size());
+		vecStunSec.resize(vecTarget.size());
+
+		for (size_t i=0 ; i < vecTarget.size() ; ++i)
 		{
-			if (true == ent->IsType(ENTITY_CHARACTER))
-			{
-				LPCHARACTER ch = static_cast<LPCHARACTER>(ent);
+			LPCHARACTER ch = vecTarget[i];
+
+			int sec = number(c_rkSkill.kStunDefault.iMin, c_rkSkill.kStunDefault.iMax);
+
+			if (ch->GetJob() == Set1)
+				sec += number(c_rkSkill.akJobStun[Set1].iMin, c_rkSkill.akJobStun[Set1].iMax);
+
+			if (ch->GetJob() == Set2)
+				sec += number(c_rkSkill.akJobStun[Set2].iMin, c_rkSkill.akJobStun[Set2].iMax);
+
+			if (GET_SEX(ch) == gender)
+				sec += number(c_rkSkill.akGender[gender].iMin, c_rkSkill.akGender[gender].iMax);
+
+			int dam = number( c_rkSkill.kDefaultDamage.iMin, c_rkSkill.kDefaultDamage.iMax );
+			dam += (dam * addPct) / 100;
+
+			vecDamage[i] = dam;
+			vecStunSec[i] = sec;
+		}
+
+		for (size_t i=0 ; i < vecTarget.size() ; ++i)
+		{
+			LPCHARACTER ch = vecTarget[i];
 
-				if (true == ch->IsPC() && false == ch->IsDead())
-				{
-					if (NULL != ch->FindAffect(AFFECT_REVIVE_INVISIBLE, APPLY_NONE))
-						return;
+			ch->Damage( pAttacker, vecDamage[i], DAMAGE_TYPE_ICE);
 
-					if ((signed)BlueDragon_GetSkillFactor(2, "Skill2", "damage_area") < DISTANCE_APPROX(pAttacker->GetX()-ch->GetX(), pAttacker->GetY()-ch->GetY()))
-					{
-						sys_log(0, "BlueDragon: Breath too far (%d)", DISTANCE_APPROX(pAttacker->GetX()-ch->GetX(), pAttacker->GetY()-ch->GetY()) );
-						return;
-					}
-
-					int sec = number(BlueDragon_GetSkillFactor(4, "Skill2", "stun_time", "default", "min"), BlueDragon_GetSkillFactor(4, "Skill2", "stun_time", "default", "max"));
-
-					if (ch->GetJob() == Set1)
-					{
-						const char* ptr = NULL;
-
-						switch ( Set1 )
-						{
-							case JOB_WARRIOR:	ptr = "musa";	break;
-							case JOB_ASSASSIN:	ptr = "assa";	break;
-							case JOB_SURA:		ptr = "sura";	break;
-							case JOB_SHAMAN:	ptr = "muda";	break;
-
-							default:
-							case JOB_MAX_NUM:	return;
-						}
-
-						sec += number(BlueDragon_GetSkillFactor(4, "Skill2", "stun_time", ptr, "min"), BlueDragon_GetSkillFactor(4, "Skill2", "stun_time", ptr, "max"));
-					}
-
-					if (ch->GetJob() == Set2)
-					{
-						const char* ptr = NULL;
-
-						switch ( Set2 )
-						{
-							case JOB_WARRIOR:	ptr = "musa";	break;
-							case JOB_ASSASSIN:	ptr = "assa";	break;
-							case JOB_SURA:		ptr = "sura";	break;
-							case JOB_SHAMAN:	ptr = "muda";	break;
-
-							default:
-							case JOB_MAX_NUM:	return;
-						}
-
-						sec += number(BlueDragon_GetSkillFactor(4, "Skill2", "stun_time", ptr, "min"), BlueDragon_GetSkillFactor(4, "Skill2", "stun_time", ptr, "max"));
-					}
-
-					if (GET_SEX(ch) == gender)
-					{
-						const char* ptr = NULL;
-
-						switch (gender)
-						{
-							case SEX_MALE:		ptr = "male";	break;
-							case SEX_FEMALE:	ptr = "female";	break;
-							default:			return;
-						}
-
-						sec += number(BlueDragon_GetSkillFactor(4, "Skill2", "gender", ptr, "min"), BlueDragon_GetSkillFactor(4, "Skill2", "gender", ptr, "max"));
-					}
-
-					int addPct = BlueDragon_GetRangeFactor("hp_damage", pAttacker->GetHPPct());
-
-					int dam = number( BlueDragon_GetSkillFactor(3, "Skill2", "default_damage", "min"), BlueDragon_GetSkillFactor(3, "Skill2", "default_damage", "max") );
-					dam += (dam * addPct) / 100;
-
-					ch->Damage( pAttacker, dam, DAMAGE_TYPE_ICE);
-
-					SkillAttackAffect( ch, 1000, IMMUNE_STUN, AFFECT_STUN, POINT_NONE, 0, AFF_STUN, sec, "BDRAGON_STUN" );
-
-					sys_log(0, "BlueDragon: EarthQuake to %s addPct(%d) dam(%d) sec(%d)", ch->GetName(), addPct, dam, sec);
-
-
-					VECTOR vec;
-					vec.x = static_cast<float>(pAttacker->GetX() - ch->GetX());
-					vec.y = static_cast<float>(pAttacker->GetY() - ch->GetY());
-					vec.z = 0.0f;
-
-					Normalize( &vec, &vec );
-
-					const int nFlyDistance = 1000;
-
-					long tx = ch->GetX() + vec.x * nFlyDistance;
-					long ty = ch->GetY() + vec.y * nFlyDistance;
-
-					for (int i=0 ; i < 5 ; ++i)
-					{
-						if (true == SECTREE_MANAGER::instance().IsMovablePosition( ch->GetMapIndex(), tx, ty ))
-						{
-							break;
-						}
-
-						switch( i )
-						{
-							case 0:
-								tx = ch->GetX() + vec.x * nFlyDistance * -1;
-								ty = ch->GetY() + vec.y * nFlyDistance * -1;
-								break;
-							case 1:
-								tx = ch->GetX() + vec.x * nFlyDistance * -1;
-								ty = ch->GetY() + vec.y * nFlyDistance;
-								break;
-							case 2:
-								tx = ch->GetX() + vec.x * nFlyDistance;
-								ty = ch->GetY() + vec.y * nFlyDistance * -1;
-								break;
-							case 3:
-								tx = ch->GetX() + vec.x * number(1,100);
-								ty = ch->GetY() + vec.y * number(1,100);
-								break;
-							case 4:
-								tx = ch->GetX() + vec.x * number(1,10);
-								ty = ch->GetY() + vec.y * number(1,10);
-								break;
-						}
-					}
-
-					ch->Sync( tx , ty );
-					ch->Goto( tx , ty );
-					ch->CalculateMoveDuration();
-
-					ch->SyncPacket();
-
-					long dist = DISTANCE_APPROX( pAttacker->GetX() - ch->GetX(), pAttacker->GetY() - ch->GetY() );
-
-					if (dist > MaxDistance)
-					{
-						MaxDistance = dist;
-						pFarthestChar = ch;
-					}
-				}
+			SkillAttackAffect( ch, 1000, IMMUNE_STUN, AFFECT_STUN, POINT_NONE, 0, AFF_STUN, vecStunSec[i], "BDRAGON_STUN" );
+
+			sys_log(0, "BlueDragon: EarthQuake to %s addPct(%d) dam(%d) sec(%d)", ch->GetName(), addPct, vecDamage[i], vecStunSec[i]);
+
+			KnockBack(ch);
+		}
+	}
+
+	void KnockBack(LPCHARACTER ch)
+	{
+		VECTOR vec;
+		vec.x = static_cast<float>(pAttacker->GetX() - ch->GetX());
+		vec.y = static_cast<float>(pAttacker->GetY() - ch->GetY());
+		vec.z = 0.0f;
+
+		Normalize( &vec, &vec );
+
+		const int nFlyDistance = 1000;
+
+		long tx = ch->GetX() + vec.x * nFlyDistance;
+		long ty = ch->GetY() + vec.y * nFlyDistance;
+
+		for (int i=0 ; i < 5 ; ++i)
+		{
+			if (true == SECTREE_MANAGER::instance().IsMovablePosition( ch->GetMapIndex(), tx, ty ))
+			{
+				break;
 			}
+
+			switch( i )
+			{
+				case 0:
+					tx = ch->GetX() + vec.x * nFlyDistance * -1;
+					ty = ch->GetY() + vec.y * nFlyDistance * -1;
+					break;
+				case 1:
+					tx = ch->GetX() + vec.x * nFlyDistance * -1;
+					ty = ch->GetY() + vec.y * nFlyDistance;
+					break;
+				case 2:
+					tx = ch->GetX() + vec.x * nFlyDistance;
+					ty = ch->GetY() + vec.y * nFlyDistance * -1;
+					break;
+				case 3:
+					tx = ch->GetX() + vec.x * number(1,100);
+					ty = ch->GetY() + vec.y * number(1,100);
+					break;
+				case 4:
+					tx = ch->GetX() + vec.x * number(1,10);
+					ty = ch->GetY() + vec.y * number(1,10);
+					break;
+			}
+		}
+
+		ch->Sync( tx , ty );
+		ch->Goto( tx , ty );
+		ch->CalculateMoveDuration();
+
+		ch->SyncPacket();
+
+		long dist = DISTANCE_APPROX( pAttacker->GetX() - ch->GetX(), pAttacker->GetY() - ch->GetY() );
+
+		if (dist > MaxDistance)
+		{
+			MaxDistance = dist;
+			pFarthestChar = ch;
 		}
 	}
 };
@@ -105,7 +105,7 @@ EVENTFUNC( DragonLair_Collapse_Event )
 		if (NULL != pMap)
 		{
 			FWarpToVillage f;
-			pMap->for_each( f );
+			pMap->for_each_kind( SPATIAL_KIND_PC, f );
 		}
 
 		pInfo->step++;
@@ -195,7 +195,7 @@ bool CDragonLairManager::Start(long MapIndexFrom, long BaseMapIndex, DWORD Guild
 		{
 			FWarpToDragronLairWithGuildMembers f(GuildID, instanceMapIndex, 844000, 1066900);
 
-			pMap->for_each( f );
+			pMap->for_each_kind( SPATIAL_KIND_PC, f );
 
 			LairMap_.insert( std::make_pair(GuildID, M2_NEW CDragonLair(GuildID, BaseMapIndex, instanceMapIndex)) );
 
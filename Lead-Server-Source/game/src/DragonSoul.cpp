@@ -31,6 +31,21 @@ int Gamble(std::vector<float>& vec_probs)
 	return -1;
 }
 
+//  Ȯ ̺ ̴´.   Ȯ ̺ Gamble  Ͱ .
+int GambleCumulative(const std::vector<float>& vec_cum_probs)
+{
+	if (vec_cum_probs.empty())
+		return -1;
+
+	float fProb = fnumber(0.f, vec_cum_probs.back());
+	std::vector<float>::const_iterator it = std::lower_bound(vec_cum_probs.begin(), vec_cum_probs.end(), fProb);
+
+	if (it == vec_cum_probs.end())
+		return -1;
+
+	return it - vec_cum_probs.begin();
+}
+
 // ġ ̺(prob_lst) ޾ random_set.size() index Ͽ random_set return
 bool MakeDistinctRandomNumberSet(std::list <float> prob_lst, OUT std::vector<int>& random_set)
 {
@@ -337,15 +352,14 @@ bool DSManager::ExtractDragonHeart(LPCHARACTER ch, LPITEM pItem, LPITEM pExtract
 		iBonus = pExtractor->GetValue(0);
 	}
 
-	std::vector <float> vec_chargings;
-	std::vector <float> vec_probs;
+	const DragonSoulTable::TDragonHeartExtValues * pkExtValues = m_pTable->GetDragonHeartExtValues(ds_type, grade_idx);
 
-	if (!m_pTable->GetDragonHeartExtValues(ds_type, grade_idx, vec_chargings, vec_probs))
+	if (NULL == pkExtValues)
 	{
 		return false;
 	}
 
-	int idx = Gamble(vec_probs);
+	int idx = GambleCumulative(pkExtValues->vec_cum_probs);
 
 	float sum = 0.f;
 	if (-1 == idx)
@@ -354,7 +368,7 @@ bool DSManager::ExtractDragonHeart(LPCHARACTER ch, LPITEM pItem, LPITEM pExtract
 		return false;
 	}
 
-	float fCharge = vec_chargings[idx] * (100 + iBonus) / 100.f;
+	float fCharge = pkExtValues->vec_chargings[idx] * (100 + iBonus) / 100.f;
 	fCharge = std::MINMAX <float> (0.f, fCharge, 100.f);
 
 	if (fCharge < FLT_EPSILON)
@@ -551,7 +565,7 @@ bool DSManager::DoRefineGrade(LPCHARACTER ch, TItemPos (&aItemPoses)[DRAGON_SOUL
 	int count = set_items.size();
 	int need_count = 0;
 	int fee = 0;
-	std::vector <float> vec_probs;
+	const DragonSoulTable::TRefineValues * pkRefineValues = NULL;
 	float prob_sum;
 
 	BYTE ds_type, grade_idx, step_idx, strength_idx;
@@ -564,13 +578,16 @@ bool DSManager::DoRefineGrade(LPCHARACTER ch, TItemPos (&aItemPoses)[DRAGON_SOUL
 
 		GetDragonSoulInfo(pItem->GetVnum(), ds_type, grade_idx, step_idx, strength_idx);
 		
-		if (!m_pTable->GetRefineGradeValues(ds_type, grade_idx, need_count, fee, vec_probs))
+		if (NULL == (pkRefineValues = m_pTable->GetRefineGradeValues(ds_type, grade_idx)))
 		{
 			ch->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("This item cannot be advanced this way."));
 			SendRefineResultPacket(ch, DS_SUB_HEADER_REFINE_FAIL_INVALID_MATERIAL, TItemPos(pItem->GetWindow(), pItem->GetCell()));
 
 			return false;
 		}
+
+		need_count = pkRefineValues->need_count;
+		fee = pkRefineValues->fee;
 	}
 	while (++it != set_items.end())
 	{
@@ -608,7 +625,7 @@ bool DSManager::DoRefineGrade(LPCHARACTER ch, TItemPos (&aItemPoses)[DRAGON_SOUL
 		return false;
 	}
 	
-	if (-1 == (result_grade = Gamble(vec_probs)))
+	if (-1 == (result_grade = GambleCumulative(pkRefineValues->vec_cum_probs)))
 	{
 		sys_err ("Gamble failed. See RefineGardeTables' probabilities");
 		return false;
@@ -708,7 +725,7 @@ bool DSManager::DoRefineStep(LPCHARACTER ch, TItemPos (&aItemPoses)[DRAGON_SOUL_
 	int count = set_items.size();
 	int need_count = 0;
 	int fee = 0;
-	std::vector <float> vec_probs;
+	const DragonSoulTable::TRefineValues * pkRefineValues = NULL;
 
 	BYTE ds_type, grade_idx, step_idx, strength_idx;
 	int result_step;
@@ -719,12 +736,15 @@ bool DSManager::DoRefineStep(LPCHARACTER ch, TItemPos (&aItemPoses)[DRAGON_SOUL_
 		LPITEM pItem = *it;
 		GetDragonSoulInfo(pItem->GetVnum(), ds_type, grade_idx, step_idx, strength_idx);
 
-		if (!m_pTable->GetRefineStepValues(ds_type, step_idx, need_count, fee, vec_probs))
+		if (NULL == (pkRefineValues = m_pTable->GetRefineStepValues(ds_type, step_idx)))
 		{
 			ch->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("This item is not required for refinement."));
 			SendRefineResultPacket(ch, DS_SUB_HEADER_REFINE_FAIL_INVALID_MATERIAL, TItemPos(pItem->GetWindow(), pItem->GetCell()));
 			return false;
 		}
+
+		need_count = pkRefineValues->need_count;
+		fee = pkRefineValues->fee;
 	}
 
 	while(++it != set_items.end())
@@ -762,7 +782,7 @@ bool DSManager::DoRefineStep(LPCHARACTER ch, TItemPos (&aItemPoses)[DRAGON_SOUL_
 	
 	float sum = 0.f;
 
-	if (-1 == (result_step = Gamble(vec_probs)))
+	if (-1 == (result_step = GambleCumulative(pkRefineValues->vec_cum_probs)))
 	{
 		sys_err ("Gamble failed. See RefineStepTables' probabilities");
 		return false;
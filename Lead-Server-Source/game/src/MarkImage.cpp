@@ -16,9 +16,11 @@ void DeleteMarkImage(CGuildMarkImage * pkImage)
 }
 
 CGuildMarkImage::CGuildMarkImage()
-	: m_uImg(INVALID_HANDLE)
+	: m_uImg(INVALID_HANDLE), m_dwVersion(1), m_dwSendDataVersion(0), m_dwDiffVersion(0), m_dwDiffCount(0)
 {
 	memset( &m_apxImage, 0, sizeof(m_apxImage) );
+	memset( &m_adwSendDataOffset, 0, sizeof(m_adwSendDataOffset) );
+	memset( &m_adwDiffCRC, 0, sizeof(m_adwDiffCRC) );
 }
 
 CGuildMarkImage::~CGuildMarkImage()
@@ -156,7 +158,13 @@ bool CGuildMarkImage::SaveMark(DWORD posMark, BYTE * pbImage)
 
 	Pixel apxBuf[SGuildMarkBlock::SIZE];
 	GetData(colBlock * SGuildMarkBlock::WIDTH, rowBlock * SGuildMarkBlock::HEIGHT, SGuildMarkBlock::WIDTH, SGuildMarkBlock::HEIGHT, apxBuf);
+
+	//  ũ ٽ ø   ٽ  ʴ´.
+	if (m_aakBlock[rowBlock][colBlock].m_crc == GetCRC32((const char *) apxBuf, sizeof(apxBuf)))
+		return true;
+
 	m_aakBlock[rowBlock][colBlock].Compress(apxBuf);
+	++m_dwVersion;
 	return true;
 }
 
@@ -208,6 +216,34 @@ void CGuildMarkImage::BuildAllBlocks() // 
 			GetData(col * SGuildMarkBlock::WIDTH, row * SGuildMarkBlock::HEIGHT, SGuildMarkBlock::WIDTH, SGuildMarkBlock::HEIGHT, apxBuf);
 			m_aakBlock[row][col].Compress(apxBuf);
 		}
+
+	++m_dwVersion;
+}
+
+void CGuildMarkImage::__BuildSendData()
+{
+	if (m_dwSendDataVersion == m_dwVersion)
+		return;
+
+	m_vec_bSendData.clear();
+
+	BYTE posBlock = 0;
+
+	for (DWORD row = 0; row < BLOCK_ROW_COUNT; ++row)
+		for (DWORD col = 0; col < BLOCK_COL_COUNT; ++col)
+		{
+			const SGuildMarkBlock & rkBlock = m_aakBlock[row][col];
+			DWORD dwCompSize = rkBlock.m_sizeCompBuf;
+
+			m_adwSendDataOffset[posBlock] = m_vec_bSendData.size();
+			m_vec_bSendData.push_back(posBlock);
+			m_vec_bSendData.insert(m_vec_bSendData.end(), (const BYTE *) &dwCompSize, (const BYTE *) &dwCompSize + sizeof(DWORD));
+			m_vec_bSendData.insert(m_vec_bSendData.end(), rkBlock.m_abCompBuf, rkBlock.m_abCompBuf + dwCompSize);
+			++posBlock;
+		}
+
+	m_adwSendDataOffset[BLOCK_TOTAL_COUNT] = m_vec_bSendData.size();
+	m_dwSendDataVersion = m_dwVersion;
 }
 
 DWORD CGuildMarkImage::GetEmptyPosition()
@@ -228,20 +264,49 @@ DWORD CGuildMarkImage::GetEmptyPosition()
 	return INVALID_MARK_POSITION;
 }
 
-void CGuildMarkImage::GetDiffBlocks(const DWORD * crcList, std::map<BYTE, const SGuildMarkBlock *> & mapDiffBlocks)
+const BYTE * CGuildMarkImage::GetDiffBlockData(const DWORD * crcList, DWORD & r_dwSize, DWORD & r_dwCount)
 {
-	BYTE posBlock = 0;
+	__BuildSendData();
 
-	for (DWORD row = 0; row < BLOCK_ROW_COUNT; ++row)
-		for (DWORD col = 0; col < BLOCK_COL_COUNT; ++col)
+	if (m_dwDiffVersion != m_dwVersion || memcmp(m_adwDiffCRC, crcList, sizeof(m_adwDiffCRC)))
+	{
+		const SGuildMarkBlock * pkBlock = &m_aakBlock[0][0];
+
+		m_vec_bDiffData.clear();
+		m_dwDiffCount = 0;
+
+		for (DWORD posBlock = 0; posBlock < BLOCK_TOTAL_COUNT; ++posBlock)
+			if (pkBlock[posBlock].m_crc != crcList[posBlock])
+				++m_dwDiffCount;
+
+		if (m_dwDiffCount != BLOCK_TOTAL_COUNT)
 		{
-			if (m_aakBlock[row][col].m_crc != *crcList)
+			for (DWORD posBlock = 0; posBlock < BLOCK_TOTAL_COUNT; ++posBlock)
 			{
-				mapDiffBlocks.insert(std::map<BYTE, const SGuildMarkBlock *>::value_type(posBlock, &m_aakBlock[row][col]));
+				if (pkBlock[posBlock].m_crc == crcList[posBlock])
+					continue;
+
+				m_vec_bDiffData.insert(m_vec_bDiffData.end(),
+						m_vec_bSendData.begin() + m_adwSendDataOffset[posBlock],
+						m_vec_bSendData.begin() + m_adwSendDataOffset[posBlock + 1]);
 			}
-			++crcList;
-			++posBlock;
 		}
+
+		thecore_memcpy(m_adwDiffCRC, crcList, sizeof(m_adwDiffCRC));
+		m_dwDiffVersion = m_dwVersion;
+	}
+
+	r_dwCount = m_dwDiffCount;
+
+	//  ٸ (ó ޴ Ŭ̾Ʈ) ü  ͸ ״ .
+	if (m_dwDiffCount == BLOCK_TOTAL_COUNT)
+	{
+		r_dwSize = m_vec_bSendData.size();
+		return &m_vec_bSendData[0];
+	}
+
+	r_dwSize = m_vec_bDiffData.size();
+	return m_vec_bDiffData.empty() ? NULL : &m_vec_bDiffData[0];
 }
 
 void CGuildMarkImage::GetBlockCRCList(DWORD * crcList)
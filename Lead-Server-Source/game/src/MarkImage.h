@@ -92,7 +92,11 @@ class CGuildMarkImage
 		DWORD GetEmptyPosition(); //  ũ ġ ´.
 
 		void GetBlockCRCList(DWORD * crcList);
-		void GetDiffBlocks(const DWORD * crcList, std::map<BYTE, const SGuildMarkBlock *> & mapDiffBlocks);
+
+		// Ŭ̾Ʈ CRC ϰ ٸ   ͸ ´. ()
+		//  ġ(BYTE),  ũ(DWORD),    ȭǾ ִ.
+		const BYTE * GetDiffBlockData(const DWORD * crcList, DWORD & r_dwSize, DWORD & r_dwCount);
+		DWORD GetVersion() const { return m_dwVersion; }
 
 	private:
 		enum
@@ -101,11 +105,23 @@ class CGuildMarkImage
 		};
 
 		void	BuildAllBlocks();
+		void	__BuildSendData();
 
 		SGuildMarkBlock	m_aakBlock[BLOCK_ROW_COUNT][BLOCK_COL_COUNT];
 		Pixel m_apxImage[WIDTH * HEIGHT * sizeof(Pixel)];
 
 		ILuint m_uImg;
+
+		DWORD	m_dwVersion;	//  ٲ  
+		DWORD	m_dwSendDataVersion;
+		std::vector<BYTE> m_vec_bSendData;	// ü   
+		DWORD	m_adwSendDataOffset[BLOCK_TOTAL_COUNT + 1];
+
+		//  diff .  CRC  ޾  ״ .
+		DWORD	m_dwDiffVersion;
+		DWORD	m_adwDiffCRC[BLOCK_TOTAL_COUNT];
+		DWORD	m_dwDiffCount;
+		std::vector<BYTE> m_vec_bDiffData;
 };
 
 #endif
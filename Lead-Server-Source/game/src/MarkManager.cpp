@@ -13,7 +13,7 @@ void CGuildMarkManager::__DeleteImage(CGuildMarkImage * pkImgDel)
 	M2_DELETE(pkImgDel);
 }
 
-CGuildMarkManager::CGuildMarkManager()
+CGuildMarkManager::CGuildMarkManager() : m_bMarkIdxDirty(true)
 {
 	//  mark id  . ()
 	for (DWORD i = 0; i < MAX_IMAGE_COUNT * CGuildMarkImage::MARK_TOTAL_COUNT; ++i)
@@ -155,6 +155,7 @@ bool CGuildMarkManager::AddMarkIDByGuildID(DWORD guildID, DWORD markID)
 	//sys_log(0, "MarkManager: guild_id=%d mark_id=%d", guildID, markID);
 	m_mapGID_MarkID.insert(std::map<DWORD, DWORD>::value_type(guildID, markID));
 	m_setFreeMarkID.erase(markID);
+	m_bMarkIdxDirty = true;
 	return true;
 }
 
@@ -208,6 +209,23 @@ void CGuildMarkManager::CopyMarkIdx(char * pcBuf) const
 	}
 }
 
+// SERVER
+const BYTE * CGuildMarkManager::GetMarkIdxData(DWORD & r_dwSize)
+{
+	if (m_bMarkIdxDirty)
+	{
+		m_vec_wMarkIdx.resize(GetMarkCount() * 2);
+
+		if (!m_vec_wMarkIdx.empty())
+			CopyMarkIdx((char *) &m_vec_wMarkIdx[0]);
+
+		m_bMarkIdxDirty = false;
+	}
+
+	r_dwSize = m_vec_wMarkIdx.size() * sizeof(WORD);
+	return m_vec_wMarkIdx.empty() ? NULL : (const BYTE *) &m_vec_wMarkIdx[0];
+}
+
 // SERVER
 DWORD CGuildMarkManager::SaveMark(DWORD guildID, BYTE * pbMarkImage)
 {
@@ -255,26 +273,38 @@ void CGuildMarkManager::DeleteMark(DWORD guildID)
 
 	m_setFreeMarkID.insert(it->second);
 	m_mapGID_MarkID.erase(it);
+	m_bMarkIdxDirty = true;
 
 	SaveMarkIndex();
 }
 
 // SERVER
-void CGuildMarkManager::GetDiffBlocks(DWORD imgIdx, const DWORD * crcList, std::map<BYTE, const SGuildMarkBlock *> & mapDiffBlocks)
+const BYTE * CGuildMarkManager::GetDiffBlockData(DWORD imgIdx, const DWORD * crcList, DWORD & r_dwSize, DWORD & r_dwCount)
 {
-	mapDiffBlocks.clear();
+	r_dwSize = 0;
+	r_dwCount = 0;
 
 	// Ŭ̾Ʈ   ̹ û  .
-	if (m_mapIdx_Image.end() == m_mapIdx_Image.find(imgIdx))
+	std::map<DWORD, CGuildMarkImage *>::iterator it = m_mapIdx_Image.find(imgIdx);
+
+	if (m_mapIdx_Image.end() == it)
 	{
 		sys_err("invalid idx %u", imgIdx);
-		return;
+		return NULL;
 	}
 
-	CGuildMarkImage * p = __GetImage(imgIdx);
+	return it->second->GetDiffBlockData(crcList, r_dwSize, r_dwCount);
+}
 
-	if (p)
-		p->GetDiffBlocks(crcList, mapDiffBlocks);
+// SERVER
+DWORD CGuildMarkManager::GetMarkImageVersion(DWORD imgIdx) const
+{
+	std::map<DWORD, CGuildMarkImage *>::const_iterator it = m_mapIdx_Image.find(imgIdx);
+
+	if (m_mapIdx_Image.end() == it)
+		return 0;
+
+	return it->second->GetVersion();
 }
 
 // CLIENT
@@ -46,9 +46,11 @@ class CGuildMarkManager : public singleton<CGuildMarkManager>
 
 		// SERVER
 		void CopyMarkIdx(char * pcBuf) const;
+		const BYTE * GetMarkIdxData(DWORD & r_dwSize); // ũ ٲ  ٽ .
 		DWORD SaveMark(DWORD guildID, BYTE * pbMarkImage);
 		void DeleteMark(DWORD guildID);
-		void GetDiffBlocks(DWORD imgIdx, const DWORD * crcList, std::map<BYTE, const SGuildMarkBlock *> & mapDiffBlocks);
+		const BYTE * GetDiffBlockData(DWORD imgIdx, const DWORD * crcList, DWORD & r_dwSize, DWORD & r_dwCount);
+		DWORD GetMarkImageVersion(DWORD imgIdx) const;
 
 		// CLIENT
 		bool SaveBlockFromCompressedData(DWORD imgIdx, DWORD idBlock, const BYTE * pbBlock, DWORD dwSize);
@@ -72,6 +74,9 @@ class CGuildMarkManager : public singleton<CGuildMarkManager>
 		std::set<DWORD> m_setFreeMarkID;
 		std::string		m_pathPrefix;
 
+		std::vector<WORD>	m_vec_wMarkIdx;	// CopyMarkIdx  ĳ
+		bool			m_bMarkIdxDirty;
+
 	private:
 		//
 		// Symbol
@@ -10,6 +10,7 @@
 #include "char_manager.h"
 #include "OXEvent.h"
 #include "desc.h"
+#include "desc_manager.h"
 
 bool COXEventManager::Initialize()
 {
@@ -262,6 +263,21 @@ bool COXEventManager::Quiz(unsigned char level, int timelimit)
 	return true;
 }
 
+//     pulse  Ƿ  ޼ Ƽ ѹ ,
+// ٸ  ̴ ȯȣ Ʈ ̵ó view_lod 󵵷 ٿ .
+static std::vector<LPDESC> s_vecCorrectRelay;
+
+static void OXEffectPacket(LPCHARACTER pkChar, int enumEffectType)
+{
+	TPacketGCSpecialEffect p;
+
+	p.header = HEADER_GC_SPECIAL_EFFECT;
+	p.type = enumEffectType;
+	p.vid = pkChar->GetVID();
+
+	pkChar->PacketViewLOD(&p, sizeof(TPacketGCSpecialEffect));
+}
+
 bool COXEventManager::CheckAnswer(bool answer)
 {
 	if (m_map_attender.size() <= 0) return true;
@@ -289,6 +305,9 @@ bool COXEventManager::CheckAnswer(bool answer)
 	
 	LPCHARACTER pkChar = NULL;
 	PIXEL_POSITION pos;
+
+	s_vecCorrectRelay.clear();
+
 	for (; iter != m_map_attender.end();)
 	{
 		pkChar = CHARACTER_MANAGER::instance().FindByPID(iter->second);
@@ -298,7 +317,7 @@ bool COXEventManager::CheckAnswer(bool answer)
 
 			if (pos.x < rect[0] || pos.x > rect[2] || pos.y < rect[1] || pos.y > rect[3])
 			{
-				pkChar->EffectPacket(SE_FAIL);
+				OXEffectPacket(pkChar, SE_FAIL);
 				iter_tmp = iter;
 				iter++;
 				m_map_attender.erase(iter_tmp);
@@ -306,7 +325,9 @@ bool COXEventManager::CheckAnswer(bool answer)
 			}
 			else
 			{
-				pkChar->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("Correct!"));
+				if (pkChar->GetDesc())
+					s_vecCorrectRelay.push_back(pkChar->GetDesc());
+
 				// pkChar->CreateFly(number(FLY_FIREWORK1, FLY_FIREWORK6), pkChar);
 				char chatbuf[256];
 				int len = snprintf(chatbuf, sizeof(chatbuf), 
@@ -324,13 +345,14 @@ bool COXEventManager::CheckAnswer(bool answer)
 				pack_chat.size = sizeof(TPacketGCChat) + len;
 				pack_chat.type = CHAT_TYPE_COMMAND;
 				pack_chat.id = 0;
+				pack_chat.bEmpire = 0;
 
 				TEMP_BUFFER buf;
 				buf.write(&pack_chat, sizeof(TPacketGCChat));
 				buf.write(chatbuf, len);
 
-				pkChar->PacketAround(buf.read_peek(), buf.size());
-				pkChar->EffectPacket(SE_SUCCESS);
+				pkChar->PacketViewLOD(buf.read_peek(), buf.size());
+				OXEffectPacket(pkChar, SE_SUCCESS);
 
 				++iter;
 			}
@@ -348,6 +370,8 @@ bool COXEventManager::CheckAnswer(bool answer)
 			m_map_attender.erase(iter_tmp);
 		}
 	}
+
+	DESC_MANAGER::instance().RelayChat(s_vecCorrectRelay, CHAT_TYPE_INFO, LC_TEXT("Correct!"));
 	return true;
 }
 
@@ -12,39 +12,6 @@
 #include "item.h"
 
 
-extern int passes_per_sec;
-EVENTINFO(petsystem_event_info)
-{
-	CPetSystem* pPetSystem;
-};
-
-// PetSystem update ִ event.
-// PetSystem CHRACTER_MANAGER  FSM update ִ  chracters ޸,
-// Owner STATE update   _UpdateFollowAI Լ update ش.
-// ׷ owner state update CHRACTER_MANAGER ֱ ,
-// petsystem updateϴٰ pet unsummonϴ κп  .
-// (CHRACTER_MANAGER update ϸ chracter destroy pendingǾ, CPetSystem dangling ͸  ְ ȴ.)
-//  PetSystem Ʈ ִ event ߻Ŵ.
-EVENTFUNC(petsystem_update_event)
-{
-	petsystem_event_info* info = dynamic_cast<petsystem_event_info*>( event->info );
-	if ( info == NULL )
-	{
-		sys_err( "check_speedhack_event> <Factor> Null pointer" );
-		return 0;
-	}
-
-	CPetSystem*	pPetSystem = info->pPetSystem;
-
-	if (NULL == pPetSystem)
-		return 0;
-
-	
-	pPetSystem->Update(0);
-	// 0.25ʸ .
-	return PASSES_PER_SEC(1) / 4;
-}
-
 /// NOTE: 1ĳͰ     ִ ... ĳ͸  ٸ ҰŶ  ֵ... ..
 ///   ִ  ÿ ȯ  ִ  Ʋ  ִµ ̷ ȹ  ϴ 
 const float PET_COUNT_LIMIT = 3;
@@ -119,20 +86,31 @@ void CPetActor::Unsummon()
 {
 	if (true == this->IsSummoned())
 	{
-		//  
-		this->ClearBuff();
-		this->SetSummonItem(NULL);
-		if (NULL != m_pkOwner)
-			m_pkOwner->ComputePoints();
+		LPCHARACTER pkChar = m_pkChar;
 
-		if (NULL != m_pkChar)
-			M2_DESTROY_CHARACTER(m_pkChar);
+		//  Ǵ  ¸ӽ  ͸ θ ʵ  .
+		pkChar->SetPetActor(NULL);
+		this->DetachCharacter();
 
-		m_pkChar = 0;
-		m_dwVID = 0;
+		M2_DESTROY_CHARACTER(pkChar);
 	}
 }
 
+void CPetActor::DetachCharacter()
+{
+	if (false == this->IsSummoned())
+		return;
+
+	//  
+	this->ClearBuff();
+	this->SetSummonItem(NULL);
+	if (NULL != m_pkOwner)
+		m_pkOwner->ComputePoints();
+
+	m_pkChar = 0;
+	m_dwVID = 0;
+}
+
 DWORD CPetActor::Summon(const char* petName, LPITEM pSummonItem, bool bSpawnFar)
 {
 	long x = m_pkOwner->GetX();
@@ -171,6 +149,7 @@ DWORD CPetActor::Summon(const char* petName, LPITEM pSummonItem, bool bSpawnFar)
 	}
 
 	m_pkChar->SetPet();
+	m_pkChar->SetPetActor(this);
 
 //	m_pkOwner->DetailLog();
 //	m_pkChar->DetailLog();
@@ -218,7 +197,7 @@ bool CPetActor::_UpdatAloneActionAI(float fMinDist, float fMaxDist)
 	return true;
 }
 
-// char_state.cpp StateHorseԼ ׳ C&P -_-;
+// char_state.cpp StateHorse   CHARACTER::FollowOwner  .
 bool CPetActor::_UpdateFollowAI()
 {
 	if (0 == m_pkChar->m_pkMobData)
@@ -243,11 +222,6 @@ bool CPetActor::_UpdateFollowAI()
 	float	RESPAWN_DISTANCE = 4500.f;			//  Ÿ ̻ ־   ȯ.
 	int		APPROACH = 200;						//  Ÿ
 
-	bool bDoMoveAlone = true;					// ĳͿ    ȥ  ϰ  -_-;
-	bool bRun = false;							// پ ϳ?
-
-	DWORD currentTime = get_dword_time();
-
 	long ownerX = m_pkOwner->GetX();		long ownerY = m_pkOwner->GetY();
 	long charX = m_pkChar->GetX();			long charY = m_pkChar->GetY();
 
@@ -264,33 +238,14 @@ bool CPetActor::_UpdateFollowAI()
 		}
 	}
 	
-	
+	//    ƹ Ŷ  ʴ´. ( Ź FUNC_WAIT  )
 	if (fDist >= START_FOLLOW_DISTANCE)
 	{
-		if( fDist >= START_RUN_DISTANCE)
-		{
-			bRun = true;
-		}
+		m_pkChar->SetNowWalking(fDist < START_RUN_DISTANCE);		// NOTE: Լ ̸ ߴ° ˾Ҵµ SetNowWalking(false) ϸ ٴ°.. -_-;
 
-		m_pkChar->SetNowWalking(!bRun);		// NOTE: Լ ̸ ߴ° ˾Ҵµ SetNowWalking(false) ϸ ٴ°.. -_-;
-		
-		Follow(APPROACH);
-
-		m_pkChar->SetLastAttacked(currentTime);
-		m_dwLastActionTime = currentTime;
+		if (m_pkChar->FollowOwner(m_pkOwner, START_FOLLOW_DISTANCE, APPROACH, APPROACH))
+			m_dwLastActionTime = get_dword_time();
 	}
-	//else
-	//{
-	//	if (fabs(m_pkChar->GetRotation() - GetDegreeFromPositionXY(charX, charY, ownerX, ownerX)) > 10.f || fabs(m_pkChar->GetRotation() - GetDegreeFromPositionXY(charX, charY, ownerX, ownerX)) < 350.f)
-	//	{
-	//		m_pkChar->Follow(m_pkOwner, APPROACH);
-	//		m_pkChar->SetLastAttacked(currentTime);
-	//		m_dwLastActionTime = currentTime;
-	//	}
-	//}
-	// Follow  ΰ  Ÿ ̳ ٸ 
-	else 
-		m_pkChar->SendMovePacket(FUNC_WAIT, 0, 0, 0, 0);
 	//else if (currentTime - m_dwLastActionTime > number(5000, 12000))
 	//{
 	//	this->_UpdatAloneActionAI(START_FOLLOW_DISTANCE / 2, START_FOLLOW_DISTANCE);
@@ -320,38 +275,6 @@ bool CPetActor::Update(DWORD deltaTime)
 	return bResult;
 }
 
-//NOTE : !!! MinDistance ũ   ŭ ȭ follow ʴ´,
-bool CPetActor::Follow(float fMinDistance)
-{
-	//  ġ ٶ Ѵ.
-	if( !m_pkOwner || !m_pkChar) 
-		return false;
-
-	float fOwnerX = m_pkOwner->GetX();
-	float fOwnerY = m_pkOwner->GetY();
-
-	float fPetX = m_pkChar->GetX();
-	float fPetY = m_pkChar->GetY();
-
-	float fDist = DISTANCE_SQRT(fOwnerX - fPetX, fOwnerY - fPetY);
-	if (fDist <= fMinDistance)
-		return false;
-
-	m_pkChar->SetRotationToXY(fOwnerX, fOwnerY);
-
-	float fx, fy;
-
-	float fDistToGo = fDist - fMinDistance;
-	GetDeltaByDegree(m_pkChar->GetRotation(), fDistToGo, &fx, &fy);
-	
-	if (!m_pkChar->Goto((int)(fPetX+fx+0.5f), (int)(fPetY+fy+0.5f)) )
-		return false;
-
-	m_pkChar->SendMovePacket(FUNC_WAIT, 0, 0, 0, 0, 0);
-
-	return true;
-}
-
 void CPetActor::SetSummonItem (LPITEM pItem)
 {
 	if (NULL == pItem)
@@ -407,9 +330,6 @@ CPetSystem::CPetSystem(LPCHARACTER owner)
 //	assert(0 != owner && "[CPetSystem::CPetSystem] Invalid owner");
 
 	m_pkOwner = owner;
-	m_dwUpdatePeriod = 400;
-
-	m_dwLastUpdateTime = 0;
 }
 
 CPetSystem::~CPetSystem()
@@ -428,51 +348,9 @@ void CPetSystem::Destroy()
 			delete petActor;
 		}
 	}
-	event_cancel(&m_pkPetSystemUpdateEvent);
 	m_petActorMap.clear();
 }
 
-///  ý Ʈ. ϵ  AI ó  .
-bool CPetSystem::Update(DWORD deltaTime)
-{
-	bool bResult = true;
-
-	DWORD currentTime = get_dword_time();
-
-	// CHARACTER_MANAGER ĳͷ Update  Ű ִ (Pulse Ǿִ)  Ӱ ð ˾Ҵµ
-	//  ٸ ̶-_-; ⿡ Է  deltaTime ǹ̰ Ф	
-	
-	if (m_dwUpdatePeriod > currentTime - m_dwLastUpdateTime)
-		return true;
-	
-	std::vector <CPetActor*> v_garbageActor;
-
-	for (TPetActorMap::iterator iter = m_petActorMap.begin(); iter != m_petActorMap.end(); ++iter)
-	{
-		CPetActor* petActor = iter->second;
-
-		if (0 != petActor && petActor->IsSummoned())
-		{
-			LPCHARACTER pPet = petActor->GetCharacter();
-			
-			if (NULL == CHARACTER_MANAGER::instance().Find(pPet->GetVID()))
-			{
-				v_garbageActor.push_back(petActor);
-			}
-			else
-			{
-				bResult = bResult && petActor->Update(deltaTime);
-			}
-		}
-	}
-	for (std::vector<CPetActor*>::iterator it = v_garbageActor.begin(); it != v_garbageActor.end(); it++)
-		DeletePet(*it);
-
-	m_dwLastUpdateTime = currentTime;
-
-	return bResult;
-}
-
 ///  Ͽ  
 void CPetSystem::DeletePet(DWORD mobVnum)
 {
@@ -524,17 +402,6 @@ void CPetSystem::Unsummon(DWORD vnum, bool bDeleteFromList)
 
 	if (true == bDeleteFromList)
 		this->DeletePet(actor);
-
-	bool bActive = false;
-	for (TPetActorMap::iterator it = m_petActorMap.begin(); it != m_petActorMap.end(); it++)
-	{
-		bActive |= it->second->IsSummoned();
-	}
-	if (false == bActive)
-	{
-		event_cancel(&m_pkPetSystemUpdateEvent);
-		m_pkPetSystemUpdateEvent = NULL;
-	}
 }
 
 
@@ -549,16 +416,8 @@ CPetActor* CPetSystem::Summon(DWORD mobVnum, LPITEM pSummonItem, const char* pet
 		m_petActorMap.insert(std::make_pair(mobVnum, petActor));
 	}
 
-	DWORD petVID = petActor->Summon(petName, pSummonItem, bSpawnFar);
-
-	if (NULL == m_pkPetSystemUpdateEvent)
-	{
-		petsystem_event_info* info = AllocEventInfo<petsystem_event_info>();
-
-		info->pPetSystem = this;
-
-		m_pkPetSystemUpdateEvent = event_create(petsystem_update_event, info, PASSES_PER_SEC(1) / 4);	// 0.25	
-	}
+	// AI  ȯ  ĳ ¸ӽ(CHARACTER::StatePet) .
+	petActor->Summon(petName, pSummonItem, bSpawnFar);
 
 	return petActor;
 }
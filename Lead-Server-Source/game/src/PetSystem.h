@@ -25,6 +25,7 @@ public:
 
 protected:
 	friend class CPetSystem;
+	friend class CHARACTER;		// CHARACTER::StatePet  Update  θ.
 
 	CPetActor(LPCHARACTER owner, DWORD vnum, DWORD options = EPetOption_Followable | EPetOption_Summonable);
 //	CPetActor(LPCHARACTER owner, DWORD vnum, const SPetAbility& petAbility, DWORD options = EPetOption_Followable | EPetOption_Summonable);
@@ -40,9 +41,6 @@ protected:
 	/// @TODO
 	//virtual bool	_UpdateCombatAI();
 
-private:
-	bool Follow(float fMinDistance = 50.f);
-
 public:
 	LPCHARACTER		GetCharacter()	const					{ return m_pkChar; }
 	LPCHARACTER		GetOwner()	const						{ return m_pkOwner; }
@@ -58,6 +56,7 @@ public:
 
 	DWORD			Summon(const char* petName, LPITEM pSummonItem, bool bSpawnFar = false);
 	void			Unsummon();
+	void			DetachCharacter();			///<  ĳͰ     ŵΰ ´.
 
 	bool			IsSummoned() const			{ return 0 != m_pkChar; }
 	void			SetSummonItem (LPITEM pItem);
@@ -104,14 +103,11 @@ public:
 	CPetActor*	GetByVID(DWORD vid) const;
 	CPetActor*	GetByVnum(DWORD vnum) const;
 
-	bool		Update(DWORD deltaTime);
 	void		Destroy();
 
 	size_t		CountSummoned() const;			///<  ȯ(üȭ  ĳͰ ִ)  
 
 public:
-	void		SetUpdatePeriod(DWORD ms);
-
 	CPetActor*	Summon(DWORD mobVnum, LPITEM pSummonItem, const char* petName, bool bSpawnFar, DWORD options = CPetActor::EPetOption_Followable | CPetActor::EPetOption_Summonable);
 
 	void		Unsummon(DWORD mobVnum, bool bDeleteFromList = false);
@@ -127,9 +123,6 @@ public:
 private:
 	TPetActorMap	m_petActorMap;
 	LPCHARACTER		m_pkOwner;					///<  ý Owner
-	DWORD			m_dwUpdatePeriod;			///< Ʈ ֱ (ms)
-	DWORD			m_dwLastUpdateTime;
-	LPEVENT			m_pkPetSystemUpdateEvent;
 };
 
 /**
@@ -151,6 +144,7 @@ petSystem->Unsummon(petVID);
 petActor->Mount()..
 
 
+// ȯ  ĳ ¸ӽ(CHARACTER::StatePet) θ.
 CPetActor::Update(...)
 {
 	// AI : Follow, actions, etc...
@@ -1,19 +1,22 @@
 
 #include "stdafx.h"
 
-#include <boost/pool/object_pool.hpp>
-
 #include "affect.h"
+#include "object_allocator.h"
+
+// boost::object_pool::free  free list  ĵ ä ϴ O(n) ̴.
+// ̺Ʈ  free list Ҵڸ .
+enum { AFFECT_POOL_FREE_TRIGGER = 65536 };
 
-boost::object_pool<CAffect> affect_pool;
+typedef LateAllocator<CAffect, AFFECT_POOL_FREE_TRIGGER> AffectAllocator;
 
 CAffect* CAffect::Acquire()
 {
-	return affect_pool.malloc();
+	return static_cast<CAffect*>(AffectAllocator::Alloc(sizeof(CAffect)));
 }
 
 void CAffect::Release(CAffect* p)
 {
-	affect_pool.free(p);
+	AffectAllocator::Free(p);
 }
 
@@ -167,6 +167,9 @@ enum EAffectBits
 
 extern void SendAffectAddPacket(LPDESC d, CAffect * pkAff);
 
+// DB   ʴ (  ѱ ʴ) affect
+#define IS_NO_SAVE_AFFECT(type) ((type) == AFFECT_WAR_FLAG || (type) == AFFECT_REVIVE_INVISIBLE || ((type) >= AFFECT_PREMIUM_START && (type) <= AFFECT_PREMIUM_END))
+
 // AFFECT_DURATION_BUG_FIX
 enum AffectVariable
 {
@@ -66,4 +66,32 @@ inline bool operator != (const TAffectFlag& lhs, const TAffectFlag& rhs)
 	return !(lhs == rhs);
 }
 
+// affect type   Ʈ Ѵ .    type  affect  Ȯ .
+//  ־   Ƿ  ˻ ̳ʿ ؾ Ѵ.
+struct TAffectTypeMask
+{
+	enum { MASK_BITS = 256 };
+
+	DWORD bits[MASK_BITS / 32];
+
+	inline TAffectTypeMask() { Clear(); }
+
+	inline void Clear()
+	{
+		memset(bits, 0, sizeof(bits));
+	}
+
+	inline void Set(DWORD dwType)
+	{
+		dwType &= MASK_BITS - 1;
+		SET_BIT(bits[dwType >> 5], (((DWORD)1) << (dwType & 31)));
+	}
+
+	inline bool MayContain(DWORD dwType) const
+	{
+		dwType &= MASK_BITS - 1;
+		return IS_SET(bits[dwType >> 5], (((DWORD)1) << (dwType & 31))) != 0;
+	}
+};
+
 #endif
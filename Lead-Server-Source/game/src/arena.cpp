@@ -3,6 +3,7 @@
 #include "config.h"
 #include "packet.h"
 #include "desc.h"
+#include "desc_manager.h"
 #include "buffer_manager.h"
 #include "start_position.h"
 #include "questmanager.h"
@@ -978,29 +979,37 @@ void CArena::RemoveObserver(DWORD pid)
 	}
 }
 
-void CArena::SendPacketToObserver(const void * c_pvData, int iSize)
+//  ʹ  ڿ    Ƿ   PID  ã  .
+static std::vector<LPDESC> s_vecObserverRelay;
+
+void CArena::BuildObserverRelay()
 {
-	/*
+	s_vecObserverRelay.clear();
+
 	itertype(m_mapObserver) iter = m_mapObserver.begin();
 
 	for (; iter != m_mapObserver.end(); iter++)
 	{
-		LPCHARACTER pChar = iter->second;
+		LPCHARACTER pChar = CHARACTER_MANAGER::instance().FindByPID(iter->first);
 
-		if (pChar != NULL)
-		{
-			if (pChar->GetDesc() != NULL)
-			{
-				pChar->GetDesc()->Packet(c_pvData, iSize);
-			}
-		}
+		if (pChar != NULL && pChar->GetDesc() != NULL)
+			s_vecObserverRelay.push_back(pChar->GetDesc());
 	}
-	*/
+}
+
+void CArena::SendPacketToObserver(const void * c_pvData, int iSize)
+{
+	BuildObserverRelay();
+	DESC_MANAGER::instance().RelayPacket(s_vecObserverRelay, c_pvData, iSize);
 }
 
 void CArena::SendChatPacketToObserver(BYTE type, const char * format, ...)
 {
-	/*
+	BuildObserverRelay();
+
+	if (s_vecObserverRelay.empty())
+		return;
+
 	char chatbuf[CHAT_MAX_LEN + 1];
 	va_list args;
 
@@ -1008,21 +1017,7 @@ void CArena::SendChatPacketToObserver(BYTE type, const char * format, ...)
 	vsnprintf(chatbuf, sizeof(chatbuf), format, args);
 	va_end(args);
 
-	itertype(m_mapObserver) iter = m_mapObserver.begin();
-
-	for (; iter != m_mapObserver.end(); iter++)
-	{
-		LPCHARACTER pChar = iter->second;
-
-		if (pChar != NULL)
-		{
-			if (pChar->GetDesc() != NULL)
-			{
-				pChar->ChatPacket(type, chatbuf);
-			}
-		}
-	}
-	*/
+	DESC_MANAGER::instance().RelayChat(s_vecObserverRelay, type, chatbuf);
 }
 
 bool CArenaManager::EndDuel(DWORD pid)
@@ -51,6 +51,7 @@ class CArena
 	bool IsMyObserver(WORD ObserverX, WORD ObserverY);
 	bool AddObserver(LPCHARACTER pChar);
 	bool RegisterObserverPtr(LPCHARACTER pChar);
+	void BuildObserverRelay();
 
 	public :
 	DWORD GetPlayerAPID() { return m_dwPIDA; }
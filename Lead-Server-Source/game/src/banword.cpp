@@ -20,6 +20,14 @@ bool CBanwordManager::Initialize(TBanwordTable * p, WORD wSize)
 	for (WORD i = 0; i < wSize; ++i, ++p)
 		m_hashmap_words[p->szWord] = true;
 
+	std::vector<std::string> vec_stWord;
+	vec_stWord.reserve(m_hashmap_words.size());
+
+	for (TBanwordHashmap::iterator it = m_hashmap_words.begin(); it != m_hashmap_words.end(); ++it)
+		vec_stWord.push_back(it->first);
+
+	m_kMatcher.Build(vec_stWord, 0);
+
 	char szBuf[256];
 	snprintf(szBuf, sizeof(szBuf), "Banword reloaded! (total %zu banwords)", m_hashmap_words.size());
 	SendLog(szBuf);
@@ -31,96 +39,83 @@ bool CBanwordManager::Find(const char * c_pszString)
 	return m_hashmap_words.end() != m_hashmap_words.find(c_pszString);
 }
 
-bool CBanwordManager::CheckString(const char * c_pszString, size_t _len)
+// is_twobyte   ڰ ϴ ġ 1. ܾ  ߰   .
+static const BYTE * banword_char_boundary(const char * c_pszString, size_t len)
 {
-	if (m_hashmap_words.empty())
-		return false;
+	static std::vector<BYTE> s_vec_bBoundary;
+
+	s_vec_bBoundary.assign(len + 1, 0);
+
+	for (size_t i = 0; i < len; i += is_twobyte(c_pszString + i) ? 2 : 1)
+		s_vec_bBoundary[i] = 1;
+
+	return &s_vec_bBoundary[0];
+}
+
+struct FBanwordFind
+{
+	const CWordMatcher &	m_rkMatcher;
+	const BYTE *		m_pbBoundary;
+	bool			m_bFound;
 
-	typeof(m_hashmap_words.begin()) it = m_hashmap_words.begin();
+	FBanwordFind(const CWordMatcher & rkMatcher, const BYTE * pbBoundary) : m_rkMatcher(rkMatcher), m_pbBoundary(pbBoundary), m_bFound(false)
+	{
+	}
 
-	while (it != m_hashmap_words.end())
+	bool operator () (int iWord, int iEnd)
 	{
-		const std::string & r = it->first;
-		const char * tmp = c_pszString;
-		ssize_t len = _len;
-
-		while (len > 0)
-		{
-			if (is_twobyte(tmp))
-			{
-				if (!strncmp(tmp, r.c_str(), r.size()))
-					return true;
-
-				tmp += 2;
-				len -= 2;
-			}
-			else
-			{
-				if (!strncmp(tmp, r.c_str(), r.size()))
-					return true;
-
-				++tmp;
-				--len;
-			}
-		}
-
-		it++;
+		if (!m_pbBoundary[iEnd - m_rkMatcher.GetWordLength(iWord)])
+			return true;
+
+		m_bFound = true;
+		return false;
 	}
+};
+
+bool CBanwordManager::CheckString(const char * c_pszString, size_t _len)
+{
+	if (m_kMatcher.IsEmpty())
+		return false;
 
-	return false;
+	FBanwordFind f(m_kMatcher, banword_char_boundary(c_pszString, _len));
+	m_kMatcher.Scan(c_pszString, _len, f);
+	return f.m_bFound;
 }
 
-void CBanwordManager::ConvertString(char * c_pszString, size_t _len)
+struct FBanwordCollect
 {
-	typeof(m_hashmap_words.begin()) it = m_hashmap_words.begin();
+	const CWordMatcher &			m_rkMatcher;
+	const BYTE *				m_pbBoundary;
+	std::vector<std::pair<int, int> > &	m_rvec_kRange;
 
-	while (it != m_hashmap_words.end())
+	FBanwordCollect(const CWordMatcher & rkMatcher, const BYTE * pbBoundary, std::vector<std::pair<int, int> > & rvec_kRange)
+		: m_rkMatcher(rkMatcher), m_pbBoundary(pbBoundary), m_rvec_kRange(rvec_kRange)
 	{
-		const std::string & r = it->first;
-
-		char * tmp = c_pszString;
-		ssize_t len = _len;
-
-		while (len > 0)
-		{
-			if (is_twobyte(tmp))
-			{
-				if (!strncmp(tmp, r.c_str(), r.size()))
-				{
-					memset(tmp, '*', r.size());
-					tmp += r.size();
-					len -= r.size();
-				}
-				else
-				{
-					tmp += 2;
-					len -= 2;
-				}
-			}
-			else
-			{
-				if (*tmp == '*')
-				{
-					++tmp;
-					--len;
-					continue;
-				}
-
-				if (!strncmp(tmp, r.c_str(), r.size()))
-				{
-					memset(tmp, '*', r.size());
-					tmp += r.size();
-					len -= r.size();
-				}
-				else
-				{
-					++tmp;
-					--len;
-				}
-			}
-		}
-
-		it++;
 	}
-}
 
+	bool operator () (int iWord, int iEnd)
+	{
+		int iStart = iEnd - m_rkMatcher.GetWordLength(iWord);
+
+		if (m_pbBoundary[iStart])
+			m_rvec_kRange.push_back(std::make_pair(iStart, iEnd));
+
+		return true;
+	}
+};
+
+// ã ܾ    Ѳ *  ٲ۴. ġ ܾ  .
+void CBanwordManager::ConvertString(char * c_pszString, size_t _len)
+{
+	if (m_kMatcher.IsEmpty())
+		return;
+
+	static std::vector<std::pair<int, int> > s_vec_kRange;
+	s_vec_kRange.clear();
+
+	FBanwordCollect f(m_kMatcher, banword_char_boundary(c_pszString, _len), s_vec_kRange);
+	m_kMatcher.Scan(c_pszString, _len, f);
+
+	for (size_t i = 0; i < s_vec_kRange.size(); ++i)
+		memset(c_pszString + s_vec_kRange[i].first, '*', s_vec_kRange[i].second - s_vec_kRange[i].first);
+}
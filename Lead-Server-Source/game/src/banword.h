@@ -1,9 +1,10 @@
-
 #ifndef BANWORD_MANAGER_H_
 #define BANWORD_MANAGER_H_
 
 #include <boost/unordered_map.hpp>
 
+#include "word_matcher.h"
+
 class CBanwordManager : public singleton<CBanwordManager>
 {
 	public:
@@ -18,7 +19,9 @@ class CBanwordManager : public singleton<CBanwordManager>
 	protected:
 		typedef boost::unordered_map<std::string, bool> TBanwordHashmap;
 		TBanwordHashmap m_hashmap_words;
+
+		// m_hashmap_words  ܾ Initialize  ٽ .
+		CWordMatcher m_kMatcher;
 };
 
 #endif /* BANWORD_MANAGER_H_ */
-
@@ -205,29 +205,90 @@ int CalcMagicDamage(LPCHARACTER pkAttacker, LPCHARACTER pkVictim)
 	return CalcMagicDamageWithValue(iDam, pkAttacker, pkVictim);
 }
 
-float CalcAttackRating(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, bool bIgnoreTargetRating)
+// , ȸ . Է MIN(90, (dx * 4 + lv * 2) / 6) ̹Ƿ 0 ~ 90  ǥ .
+enum
 {
-	int iARSrc;
-	int iERSrc;
+	RATING_SRC_MAX = 90,
+};
 
-	int attacker_dx = pkAttacker->GetPolymorphPoint(POINT_DX);
-	int attacker_lv = pkAttacker->GetLevel();
+static struct SRatingTable
+{
+	float	afAR[RATING_SRC_MAX + 1];
+	float	afER[RATING_SRC_MAX + 1];
 
-	int victim_dx = pkVictim->GetPolymorphPoint(POINT_DX);
-	int victim_lv = pkAttacker->GetLevel();
+	static float CalcAR(int iSrc)
+	{
+		return ((float) iSrc + 210.0f) / 300.0f; // fAR = 0.7 ~ 1.0
+	}
+
+	static float CalcER(int iSrc)
+	{
+		// ((Edx * 2 + 20) / (Edx + 110)) * 0.3
+		return ((float) (iSrc * 2 + 5) / (iSrc + 95)) * 3.0f / 10.0f;
+	}
+
+	SRatingTable()
+	{
+		for (int i = 0; i <= RATING_SRC_MAX; ++i)
+		{
+			afAR[i] = CalcAR(i);
+			afER[i] = CalcER(i);
+		}
+	}
+
+	float GetAR(int iSrc) const	{ return iSrc >= 0 ? afAR[iSrc] : CalcAR(iSrc); }
+	float GetER(int iSrc) const	{ return iSrc >= 0 ? afER[iSrc] : CalcER(iSrc); }
+} s_kRatingTable;
 
-	iARSrc = MIN(90, (attacker_dx * 4	+ attacker_lv * 2) / 6);
-	iERSrc = MIN(90, (victim_dx	  * 4	+ victim_lv   * 2) / 6);
+float CalcAttackRating(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, bool bIgnoreTargetRating)
+{
+	int attacker_dx = pkAttacker->GetCombatFactor().iRatingDX;
+	int attacker_lv = pkAttacker->GetLevel();
+
+	int iARSrc = MIN(RATING_SRC_MAX, (attacker_dx * 4	+ attacker_lv * 2) / 6);
 
-	float fAR = ((float) iARSrc + 210.0f) / 300.0f; // fAR = 0.7 ~ 1.0
+	float fAR = s_kRatingTable.GetAR(iARSrc);
 
 	if (bIgnoreTargetRating)
 		return fAR;
 
-	// ((Edx * 2 + 20) / (Edx + 110)) * 0.3
-	float fER = ((float) (iERSrc * 2 + 5) / (iERSrc + 95)) * 3.0f / 10.0f;
+	int victim_dx = pkVictim->GetCombatFactor().iRatingDX;
+	int victim_lv = pkAttacker->GetLevel();
+
+	int iERSrc = MIN(RATING_SRC_MAX, (victim_dx	  * 4	+ victim_lv   * 2) / 6);
 
-	return fAR - fER;
+	return fAR - s_kRatingTable.GetER(iERSrc);
+}
+
+// CalcAttBonus    ÷׸ ˻ϴ . ó ´  ϳ Ѵ.
+static const struct SRaceAttBonus
+{
+	DWORD	dwRaceFlag;
+	BYTE	bPoint;
+} sc_akRaceAttBonus[] =
+{
+	{ RACE_FLAG_ANIMAL,	POINT_ATTBONUS_ANIMAL	},
+	{ RACE_FLAG_UNDEAD,	POINT_ATTBONUS_UNDEAD	},
+	{ RACE_FLAG_DEVIL,	POINT_ATTBONUS_DEVIL	},
+	{ RACE_FLAG_HUMAN,	POINT_ATTBONUS_HUMAN	},
+	{ RACE_FLAG_ORC,	POINT_ATTBONUS_ORC		},
+	{ RACE_FLAG_MILGYO,	POINT_ATTBONUS_MILGYO	},
+	{ RACE_FLAG_INSECT,	POINT_ATTBONUS_INSECT	},
+	{ RACE_FLAG_FIRE,	POINT_ATTBONUS_FIRE		},
+	{ RACE_FLAG_ICE,	POINT_ATTBONUS_ICE		},
+	{ RACE_FLAG_DESERT,	POINT_ATTBONUS_DESERT	},
+	{ RACE_FLAG_TREE,	POINT_ATTBONUS_TREE		},
+};
+
+BYTE GetRaceAttBonusPoint(DWORD dwRaceFlag)
+{
+	for (size_t i = 0; i < sizeof(sc_akRaceAttBonus) / sizeof(sc_akRaceAttBonus[0]); ++i)
+	{
+		if (IS_SET(dwRaceFlag, sc_akRaceAttBonus[i].dwRaceFlag))
+			return sc_akRaceAttBonus[i].bPoint;
+	}
+
+	return POINT_NONE;
 }
 
 int CalcAttBonus(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, int iAtk)
@@ -250,28 +311,10 @@ int CalcAttBonus(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, int iAtk)
 
 	if (pkVictim->IsNPC())
 	{
-		if (pkVictim->IsRaceFlag(RACE_FLAG_ANIMAL))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_ANIMAL)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_UNDEAD))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_UNDEAD)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_DEVIL))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_DEVIL)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_HUMAN))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_HUMAN)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_ORC))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_ORC)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_MILGYO))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_MILGYO)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_INSECT))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_INSECT)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_FIRE))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_FIRE)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_ICE))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_ICE)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_DESERT))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_DESERT)) / 100;
-		else if (pkVictim->IsRaceFlag(RACE_FLAG_TREE))
-			iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_TREE)) / 100;
+		BYTE bRaceAttBonusPoint = pkVictim->GetCombatFactor().bRaceAttBonusPoint;
+
+		if (bRaceAttBonusPoint != POINT_NONE)
+			iAtk += (iAtk * pkAttacker->GetPoint(bRaceAttBonusPoint)) / 100;
 
 		iAtk += (iAtk * pkAttacker->GetPoint(POINT_ATTBONUS_MONSTER)) / 100;
 	}
@@ -455,7 +498,7 @@ int CalcMeleeDamage(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, bool bIgnoreDe
 	}
 
 	iAtk += pkAttacker->GetPoint(POINT_PARTY_ATTACKER_BONUS); // party attacker role bonus
-	iAtk = (int) (iAtk * (100 + (pkAttacker->GetPoint(POINT_ATT_BONUS) + pkAttacker->GetPoint(POINT_MELEE_MAGIC_ATT_BONUS_PER))) / 100);
+	iAtk = (int) (iAtk * pkAttacker->GetCombatFactor().iAttBonusPct / 100);
 
 	iAtk = CalcAttBonus(pkAttacker, pkVictim, iAtk);
 
@@ -463,7 +506,7 @@ int CalcMeleeDamage(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, bool bIgnoreDe
 
 	if (!bIgnoreDefense)
 	{
-		iDef = (pkVictim->GetPoint(POINT_DEF_GRADE) * (100 + pkVictim->GetPoint(POINT_DEF_BONUS)) / 100);
+		iDef = pkVictim->GetCombatFactor().iDefense;
 
 		if (!pkAttacker->IsPC())
 			iDef += pkVictim->GetMarriageBonus(UNIQUE_ITEM_MARRIAGE_DEFENSE_BONUS);
@@ -573,7 +616,7 @@ int CalcArrowDamage(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, LPITEM pkBow,
 	iAtk += pkBow->GetValue(5) * 2;
 
 	iAtk += pkAttacker->GetPoint(POINT_PARTY_ATTACKER_BONUS);
-	iAtk = (int) (iAtk * (100 + (pkAttacker->GetPoint(POINT_ATT_BONUS) + pkAttacker->GetPoint(POINT_MELEE_MAGIC_ATT_BONUS_PER))) / 100);
+	iAtk = (int) (iAtk * pkAttacker->GetCombatFactor().iAttBonusPct / 100);
 
 	iAtk = CalcAttBonus(pkAttacker, pkVictim, iAtk);
 
@@ -17,6 +17,7 @@ extern int	CalcMeleeDamage(LPCHARACTER pAttacker, LPCHARACTER pVictim, bool bIgn
 extern int	CalcMagicDamage(LPCHARACTER pAttacker, LPCHARACTER pVictim);
 extern int	CalcArrowDamage(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, LPITEM pkBow, LPITEM pkArrow, bool bIgnoreDefense = false);
 extern float	CalcAttackRating(LPCHARACTER pkAttacker, LPCHARACTER pkVictim, bool bIgnoreTargetRating = false);
+extern BYTE	GetRaceAttBonusPoint(DWORD dwRaceFlag);
 
 extern bool	battle_is_attackable(LPCHARACTER ch, LPCHARACTER victim);
 extern int	battle_melee_attack(LPCHARACTER ch, LPCHARACTER victim);
@@ -0,0 +1,595 @@
+#include "stdafx.h"
+#include "../../libgame/include/attribute.h"
+#include "../../libpoly/Poly.h"
+#include "constants.h"
+#include "utils.h"
+#include "config.h"
+#include "event_queue.h"
+#include "entity.h"
+#include "sectree.h"
+#include "sectree_manager.h"
+#include "item_manager.h"
+#include "questmanager.h"
+
+//
+//  ٽ ڷᱸ ũκġũ. make bench && ../bench [̸ Ϻ]
+//
+// Է  seed   Ź . ׸񸶴 BENCH_REPEAT  缭
+// ns/op  ߰ ּҰ , check    ̶ ڷᱸ
+// ٲ ķ ƾ Ѵ.  ĵ ٲ  ״ diff Ѵ.
+//
+enum
+{
+	BENCH_REPEAT	= 5,
+};
+
+int	max_bytes_written = 0;
+int	total_bytes_written = 0;
+int	current_bytes_written = 0;
+
+LPFDWATCH	main_fdw = NULL;
+
+bool g_bShutdown = false;
+
+void ContinueOnFatalError()
+{
+}
+
+void ShutdownOnFatalError()
+{
+}
+
+void heartbeat(LPHEART heart, int pulse)
+{
+}
+
+//  seed  xorshift. random()  ٸ ڵ尡  Ƿ  ʴ´.
+static DWORD s_dwBenchSeed;
+
+static void bench_srandom(DWORD dwSeed)
+{
+	s_dwBenchSeed = dwSeed ? dwSeed : 1;
+}
+
+static DWORD bench_random()
+{
+	s_dwBenchSeed ^= s_dwBenchSeed << 13;
+	s_dwBenchSeed ^= s_dwBenchSeed >> 17;
+	s_dwBenchSeed ^= s_dwBenchSeed << 5;
+	return s_dwBenchSeed;
+}
+
+static double bench_usec()
+{
+	struct timeval tv;
+	gettimeofday(&tv, NULL);
+	return tv.tv_sec * 1000000.0 + tv.tv_usec;
+}
+
+//
+// CEventQueue: 4096   ִ ¿  ̸   ϳ ֱ
+// ֱ  ̺Ʈó κ 1  ̰ Ϻδ   ¥.
+//
+static int bench_event_duration()
+{
+	DWORD r = bench_random();
+
+	if ((r & 15) == 0)
+		return PASSES_PER_SEC(60) + (r >> 4) % PASSES_PER_SEC(300);
+
+	return 1 + (r >> 4) % PASSES_PER_SEC(1);
+}
+
+static DWORD bench_event_queue(int iLoop)
+{
+	const int QUEUE_DEPTH = 4096;
+
+	CEventQueue q;
+	int iPulse = 0;
+	DWORD dwCheck = 0;
+
+	bench_srandom(1);
+
+	for (int i = 0; i < QUEUE_DEPTH; ++i)
+		q.Enqueue(LPEVENT(), bench_event_duration(), iPulse);
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		TQueueElement * pElem;
+
+		while (!(pElem = q.Dequeue(iPulse)))
+			++iPulse;
+
+		dwCheck = dwCheck * 31 + pElem->iKey;
+		q.Delete(pElem);
+		q.Enqueue(LPEVENT(), bench_event_duration(), iPulse);
+	}
+
+	// Destroy   ̺Ʈ ǵ帮Ƿ   д.
+	TQueueElement * pElem;
+
+	while ((pElem = q.Dequeue(iPulse + PASSES_PER_SEC(400))))
+		q.Delete(pElem);
+
+	return dwCheck;
+}
+
+//
+// 32 x 32 Ʈ  ( 2km ). ForEachAround  Ʈ ƼƼ д.
+//
+enum
+{
+	BENCH_MAP_SECTREES	= 32,
+	BENCH_MAP_BASE		= 256 * SECTREE_SIZE,	//  ó 0  ƴ  Ѵ
+	BENCH_ENTITY_PER_SECTREE	= 16,
+};
+
+class CBenchEntity : public CEntity
+{
+	public:
+		CBenchEntity()		{ Initialize(ENTITY_OBJECT); }
+		virtual ~CBenchEntity()	{ Destroy(); }
+
+		virtual void	EncodeInsertPacket(LPENTITY entity)	{}
+		virtual void	EncodeRemovePacket(LPENTITY entity)	{}
+};
+
+static LPSECTREE_MAP			s_pkBenchMap = NULL;
+static std::vector<CBenchEntity *>	s_vec_pkBenchEntity;
+
+static void bench_prepare_map()
+{
+	if (s_pkBenchMap)
+		return;
+
+	TMapSetting setting;
+	memset(&setting, 0, sizeof(setting));
+
+	setting.iBaseX = BENCH_MAP_BASE;
+	setting.iBaseY = BENCH_MAP_BASE;
+	setting.iWidth = BENCH_MAP_SECTREES * SECTREE_SIZE;
+	setting.iHeight = BENCH_MAP_SECTREES * SECTREE_SIZE;
+	setting.iCellScale = 50;
+
+	s_pkBenchMap = SECTREE_MANAGER::instance().BuildSectreeFromSetting(setting);
+	s_pkBenchMap->Build();
+
+	bench_srandom(2);
+
+	for (int i = 0; i < BENCH_MAP_SECTREES * BENCH_MAP_SECTREES * BENCH_ENTITY_PER_SECTREE; ++i)
+	{
+		long x = BENCH_MAP_BASE + bench_random() % (BENCH_MAP_SECTREES * SECTREE_SIZE);
+		long y = BENCH_MAP_BASE + bench_random() % (BENCH_MAP_SECTREES * SECTREE_SIZE);
+
+		LPSECTREE tree = s_pkBenchMap->Find(x, y);
+
+		if (!tree)
+			continue;
+
+		CBenchEntity * pkEnt = M2_NEW CBenchEntity;
+		pkEnt->SetXYZ(x, y, 0);
+		tree->InsertEntity(pkEnt);
+		s_vec_pkBenchEntity.push_back(pkEnt);
+	}
+}
+
+static void bench_destroy_map()
+{
+	for (size_t i = 0; i < s_vec_pkBenchEntity.size(); ++i)
+	{
+		CBenchEntity * pkEnt = s_vec_pkBenchEntity[i];
+
+		if (pkEnt->GetSectree())
+			pkEnt->GetSectree()->RemoveEntity(pkEnt);
+
+		M2_DELETE(pkEnt);
+	}
+
+	s_vec_pkBenchEntity.clear();
+
+	if (s_pkBenchMap)
+	{
+		M2_DELETE(s_pkBenchMap);
+		s_pkBenchMap = NULL;
+	}
+}
+
+static DWORD bench_sectree_find(int iLoop)
+{
+	DWORD dwCheck = 0;
+
+	bench_srandom(3);
+
+	// 1/8    ǥ ã´.
+	for (int i = 0; i < iLoop; ++i)
+	{
+		DWORD r = bench_random();
+		DWORD x = BENCH_MAP_BASE + (r & 0xffff) % (BENCH_MAP_SECTREES * SECTREE_SIZE + SECTREE_SIZE * 4) - SECTREE_SIZE * 2;
+		DWORD y = BENCH_MAP_BASE + (r >> 16) % (BENCH_MAP_SECTREES * SECTREE_SIZE + SECTREE_SIZE * 4) - SECTREE_SIZE * 2;
+
+		LPSECTREE tree = s_pkBenchMap->Find(x, y);
+		dwCheck = dwCheck * 31 + (tree ? tree->GetID().package : 0);
+	}
+
+	return dwCheck;
+}
+
+struct FBenchCount
+{
+	DWORD	m_dwCount;
+	long	m_lSum;
+
+	FBenchCount() : m_dwCount(0), m_lSum(0) {}
+
+	void operator () (LPENTITY ent)
+	{
+		++m_dwCount;
+		m_lSum += ent->GetX() - ent->GetY();
+	}
+};
+
+static DWORD bench_for_each_around(int iLoop)
+{
+	DWORD dwCheck = 0;
+
+	bench_srandom(4);
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		long x = BENCH_MAP_BASE + bench_random() % (BENCH_MAP_SECTREES * SECTREE_SIZE);
+		long y = BENCH_MAP_BASE + bench_random() % (BENCH_MAP_SECTREES * SECTREE_SIZE);
+
+		LPSECTREE tree = s_pkBenchMap->Find(x, y);
+
+		if (!tree)
+			continue;
+
+		FBenchCount f;
+		tree->ForEachAround(f);
+		dwCheck = dwCheck * 31 + f.m_dwCount + (DWORD) f.m_lSum;
+	}
+
+	return dwCheck;
+}
+
+static DWORD bench_for_each_around_in_range(int iLoop)
+{
+	DWORD dwCheck = 0;
+
+	bench_srandom(4);
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		long x = BENCH_MAP_BASE + bench_random() % (BENCH_MAP_SECTREES * SECTREE_SIZE);
+		long y = BENCH_MAP_BASE + bench_random() % (BENCH_MAP_SECTREES * SECTREE_SIZE);
+
+		LPSECTREE tree = s_pkBenchMap->Find(x, y);
+
+		if (!tree)
+			continue;
+
+		// ų  
+		FBenchCount f;
+		tree->ForEachAroundInRange(x, y, 1500, SPATIAL_KIND_ALL, f);
+		dwCheck = dwCheck * 31 + f.m_dwCount + (DWORD) f.m_lSum;
+	}
+
+	return dwCheck;
+}
+
+//
+// buffer_write / buffer_read: DESC  ó  Ŷ װ   .
+//
+static DWORD bench_buffer(int iLoop)
+{
+	LPBUFFER buf = buffer_new(64 * 1024);
+	BYTE abPacket[256];
+	BYTE abRead[16 * 1024];
+	DWORD dwCheck = 0;
+
+	bench_srandom(5);
+
+	for (size_t i = 0; i < sizeof(abPacket); ++i)
+		abPacket[i] = bench_random();
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		int iSize = 8 + (bench_random() & 63);
+
+		buffer_write(buf, abPacket + (i & 127), iSize);
+
+		if (buffer_size(buf) >= (int) sizeof(abRead) / 2)
+		{
+			int iRead = buffer_size(buf);
+			buffer_read(buf, abRead, iRead);
+			dwCheck = dwCheck * 31 + iRead + abRead[iRead - 1];
+		}
+	}
+
+	dwCheck += buffer_size(buf);
+	buffer_delete(buf);
+	return dwCheck;
+}
+
+//
+// ITEM_MANAGER::GetTable: item_proto  ϰ  vnum 6000   
+// ã vnum  ִ ,  ,   δ.
+//
+enum
+{
+	BENCH_ITEM_PROTO_COUNT	= 6000,
+};
+
+static std::vector<DWORD> s_vec_dwBenchVnum;
+
+static void bench_prepare_item()
+{
+	if (!s_vec_dwBenchVnum.empty())
+		return;
+
+	std::vector<TItemTable> vec_kTable(BENCH_ITEM_PROTO_COUNT);
+	DWORD dwVnum = 10;
+
+	bench_srandom(6);
+
+	for (int i = 0; i < BENCH_ITEM_PROTO_COUNT; ++i)
+	{
+		TItemTable & r = vec_kTable[i];
+
+		memset(&r, 0, sizeof(r));
+		r.dwVnum = dwVnum;
+		r.bType = ITEM_WEAPON;
+		snprintf(r.szName, sizeof(r.szName), "bench%u", dwVnum);
+		snprintf(r.szLocaleName, sizeof(r.szLocaleName), "bench%u", dwVnum);
+
+		// ȭ ܰó 10  پ ִٰ  ũ ǳʶڴ.
+		if ((i % 97) == 0)
+			r.dwVnumRange = 5;
+
+		dwVnum += ((i % 10) == 9) ? 10 + bench_random() % 500 : 1;
+	}
+
+	ITEM_MANAGER::instance().Initialize(&vec_kTable[0], vec_kTable.size());
+
+	for (int i = 0; i < 4096; ++i)
+	{
+		DWORD r = bench_random();
+		const TItemTable & c_rkTable = vec_kTable[r % BENCH_ITEM_PROTO_COUNT];
+
+		switch ((r >> 16) & 3)
+		{
+			case 0:
+			case 1:
+				s_vec_dwBenchVnum.push_back(c_rkTable.dwVnum);
+				break;
+
+			case 2:
+				s_vec_dwBenchVnum.push_back(c_rkTable.dwVnum + 1 + (r >> 20) % 3);
+				break;
+
+			default:
+				s_vec_dwBenchVnum.push_back((r >> 8) % (dwVnum + 1000));
+				break;
+		}
+	}
+}
+
+static DWORD bench_item_get_table(int iLoop)
+{
+	ITEM_MANAGER & rkItemMgr = ITEM_MANAGER::instance();
+	DWORD dwCheck = 0;
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		TItemTable * p = rkItemMgr.GetTable(s_vec_dwBenchVnum[i & 4095]);
+		dwCheck = dwCheck * 31 + (p ? p->dwVnum : 0);
+	}
+
+	return dwCheck;
+}
+
+//
+// CPoly::Eval: skill_proto   İ   ų  ٲ  
+//
+static CPoly	s_kBenchPoly;
+static int	s_iBenchPolyK = -1;
+
+static void bench_prepare_poly()
+{
+	if (s_iBenchPolyK >= 0)
+		return;
+
+	s_kBenchPoly.SetStr("(3 * iq + 2 * str + lv) * (0.5 + k) + min(k * 100, 75) + max(dex - 40, 0) * 1.5");
+
+	if (!s_kBenchPoly.Analyze())
+	{
+		sys_err("bench poly: analyze failed");
+		return;
+	}
+
+	s_kBenchPoly.SetVar("iq", 60);
+	s_kBenchPoly.SetVar("str", 45);
+	s_kBenchPoly.SetVar("lv", 75);
+	s_kBenchPoly.SetVar("dex", 52);
+	s_iBenchPolyK = s_kBenchPoly.FindVarSlot("k");
+}
+
+static DWORD bench_poly_eval(int iLoop)
+{
+	DWORD dwCheck = 0;
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		s_kBenchPoly.SetVarSlot(s_iBenchPolyK, (i % 41) / 40.0);
+		dwCheck = dwCheck * 31 + (DWORD) s_kBenchPoly.Eval();
+	}
+
+	return dwCheck;
+}
+
+//
+// CAttribute::Get: Ʈ ϳ (128 x 128 )  block/water Ӽ  ġ б
+//
+static CAttribute *	s_pkBenchAttr = NULL;
+
+static void bench_prepare_attribute()
+{
+	if (s_pkBenchAttr)
+		return;
+
+	const DWORD CELLS = SECTREE_SIZE / CELL_SIZE;
+
+	s_pkBenchAttr = M2_NEW CAttribute(CELLS, CELLS);
+
+	bench_srandom(7);
+
+	//  ó  ִ   
+	for (int i = 0; i < 200; ++i)
+	{
+		DWORD bx = bench_random() % CELLS;
+		DWORD by = bench_random() % CELLS;
+		DWORD dwAttr = (i & 3) ? ATTR_BLOCK : ATTR_WATER;
+
+		for (DWORD y = by; y < MIN(by + 6, CELLS); ++y)
+			for (DWORD x = bx; x < MIN(bx + 6, CELLS); ++x)
+				s_pkBenchAttr->Set(x, y, dwAttr);
+	}
+}
+
+static DWORD bench_attribute_get(int iLoop)
+{
+	const DWORD CELLS = SECTREE_SIZE / CELL_SIZE;
+	DWORD dwCheck = 0;
+
+	bench_srandom(8);
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		DWORD r = bench_random();
+		dwCheck = dwCheck * 31 + s_pkBenchAttr->Get((r & 0xffff) % CELLS, (r >> 16) % CELLS);
+	}
+
+	return dwCheck;
+}
+
+//
+// TEA: DESC  Ŷ ϴ ó  Ŷ ϳ, ׸ ū  ϳ
+//
+static DWORD bench_tea(int iLoop, int iSize)
+{
+	static const DWORD s_adwKey[4] = { 0x12345678, 0x9abcdef0, 0x0fedcba9, 0x87654321 };
+	DWORD adwBuf[1024 / sizeof(DWORD)];
+	DWORD dwCheck = 0;
+
+	bench_srandom(9);
+
+	for (size_t i = 0; i < sizeof(adwBuf) / sizeof(DWORD); ++i)
+		adwBuf[i] = bench_random();
+
+	for (int i = 0; i < iLoop; ++i)
+	{
+		TEA_Encrypt(adwBuf, adwBuf, s_adwKey, iSize);
+		dwCheck += adwBuf[i & (iSize / sizeof(DWORD) - 1)];
+	}
+
+	for (int i = 0; i < iLoop; ++i)
+		TEA_Decrypt(adwBuf, adwBuf, s_adwKey, iSize);
+
+	return dwCheck * 31 + adwBuf[0];
+}
+
+static DWORD bench_tea_64(int iLoop)
+{
+	return bench_tea(iLoop, 64);
+}
+
+static DWORD bench_tea_1k(int iLoop)
+{
+	return bench_tea(iLoop, 1024);
+}
+
+typedef struct SBench
+{
+	const char *	c_pszName;
+	void		(*Prepare)();
+	DWORD		(*Run)(int iLoop);
+	int		iLoop;
+	const char *	c_pszOp;	//   
+} TBench;
+
+static const TBench s_akBench[] =
+{
+	{ "event_queue",		NULL,			bench_event_queue,		1000000,	"dequeue + enqueue, 4096 queued"	},
+	{ "sectree_find",		bench_prepare_map,	bench_sectree_find,		4000000,	"Find(x, y) on 32x32 sectrees"		},
+	{ "for_each_around",		bench_prepare_map,	bench_for_each_around,		100000,		"9 sectrees, 16 entities each"		},
+	{ "for_each_around_in_range",	bench_prepare_map,	bench_for_each_around_in_range,	100000,		"range 1500"				},
+	{ "buffer_write_read",		NULL,			bench_buffer,			4000000,	"8~71 byte write, read at 8KB"		},
+	{ "item_get_table",		bench_prepare_item,	bench_item_get_table,		4000000,	"6000 protos, hit/range/miss"		},
+	{ "poly_eval",			bench_prepare_poly,	bench_poly_eval,		2000000,	"skill formula, 5 vars"			},
+	{ "attribute_get",		bench_prepare_attribute,	bench_attribute_get,	4000000,	"128x128 cells, random cell"		},
+	{ "tea_encrypt_64",		NULL,			bench_tea_64,			1000000,	"64 bytes encrypt + decrypt"		},
+	{ "tea_encrypt_1k",		NULL,			bench_tea_1k,			100000,		"1024 bytes encrypt + decrypt"		},
+};
+
+static void bench_run(const TBench & c_rkBench)
+{
+	if (c_rkBench.Prepare)
+		c_rkBench.Prepare();
+
+	double adNs[BENCH_REPEAT];
+	DWORD dwCheck = 0;
+
+	// ĳÿ pool      ʴ´.
+	c_rkBench.Run(c_rkBench.iLoop / 10);
+
+	for (int i = 0; i < BENCH_REPEAT; ++i)
+	{
+		double dStart = bench_usec();
+		DWORD dwRunCheck = c_rkBench.Run(c_rkBench.iLoop);
+		adNs[i] = (bench_usec() - dStart) * 1000.0 / c_rkBench.iLoop;
+
+		if (i && dwRunCheck != dwCheck)
+			printf("WARNING: %s check differs between runs\n", c_rkBench.c_pszName);
+
+		dwCheck = dwRunCheck;
+	}
+
+	std::sort(adNs, adNs + BENCH_REPEAT);
+
+	printf("%-26s %9d %10.1f %10.1f   %08x  %s\n",
+			c_rkBench.c_pszName, c_rkBench.iLoop, adNs[BENCH_REPEAT / 2], adNs[0], dwCheck, c_rkBench.c_pszOp);
+	fflush(stdout);
+}
+
+int main(int argc, char ** argv)
+{
+	SECTREE_MANAGER		sectree_manager;
+	ITEM_MANAGER		item_manager;
+	quest::CQuestManager	quest_manager;
+
+	thecore_init(25, heartbeat);
+	signal_timer_disable();
+
+	const char * c_pszFilter = argc > 1 ? argv[1] : NULL;
+
+	printf("%-26s %9s %10s %10s   %-8s  %s\n", "benchmark", "loops", "ns/op(med)", "ns/op(min)", "check", "op");
+
+	for (size_t i = 0; i < sizeof(s_akBench) / sizeof(s_akBench[0]); ++i)
+	{
+		if (c_pszFilter && !strstr(s_akBench[i].c_pszName, c_pszFilter))
+			continue;
+
+		bench_run(s_akBench[i]);
+	}
+
+	bench_destroy_map();
+
+	if (s_pkBenchAttr)
+	{
+		M2_DELETE(s_pkBenchAttr);
+		s_pkBenchAttr = NULL;
+	}
+
+	thecore_destroy();
+	return 0;
+}
@@ -48,6 +48,8 @@
 #include "horsename_manager.h"
 #include "gm.h"
 #include "map_location.h"
+#include "lzo_manager.h"
+#include "path_finder.h"
 #include "BlueDragon_Binder.h"
 #include "skill_power.h"
 #include "buff_on_attributes.h"
@@ -145,6 +147,8 @@ void CHARACTER::Initialize()
 	m_pkMobData		= NULL;
 	m_pkMobInst		= NULL;
 
+	memset(&m_kCombatFactor, 0, sizeof(m_kCombatFactor));
+
 	m_pkShop		= NULL;
 	m_pkChrShopOwner	= NULL;
 	m_pkMyShop		= NULL;
@@ -161,7 +165,8 @@ void CHARACTER::Initialize()
 	m_pkWarpNPCEvent = NULL;
 	m_pkDeadEvent = NULL;
 	m_pkStunEvent = NULL;
-	m_pkSaveEvent = NULL;
+	m_iPeriodicSaveSlot = -1;
+	m_dwLastSaveCRC = 0;
 	m_pkRecoveryEvent = NULL;
 	m_pkTimedEvent = NULL;
 	m_pkFishingEvent = NULL;
@@ -178,6 +183,7 @@ void CHARACTER::Initialize()
 
 	m_pkAffectEvent = NULL;
 	m_afAffectFlag = TAffectFlag(0, 0);
+	m_kAffectTypeMask.Clear();
 
 	m_pkDestroyWhenIdleEvent = NULL;
 
@@ -185,7 +191,7 @@ void CHARACTER::Initialize()
 
 	memset(&m_points, 0, sizeof(m_points));
 	memset(&m_pointsInstant, 0, sizeof(m_pointsInstant));
-	memset(&m_quickslot, 0, sizeof(m_quickslot));
+	m_pPCPoints = NULL;
 
 	m_bCharType = CHAR_TYPE_MONSTER;
 
@@ -211,10 +217,14 @@ void CHARACTER::Initialize()
 
 	m_posWarp.x = m_posWarp.y = m_posWarp.z = 0;
 	m_lWarpMapIndex = 0;
+	m_lWarpAddr = 0;
+	m_wWarpPort = 0;
 
 	m_posExit.x = m_posExit.y = m_posExit.z = 0;
 	m_lExitMapIndex = 0;
 
+	m_posFollowOwner.x = m_posFollowOwner.y = m_posFollowOwner.z = 0;
+
 	m_pSkillLevels = NULL;
 
 	m_dwMoveStartTime = 0;
@@ -249,12 +259,17 @@ void CHARACTER::Initialize()
 	m_iAlignment = 0;
 	m_iRealAlignment = 0;
 
+	m_dwInsertPacketVersion = 1;
+	m_dwAddInfoCacheVersion = 0;
+
 	m_iKillerModePulse = 0;
 	m_bPKMode = PK_MODE_PEACE;
+	m_bHasPVP = false;
 
 	m_dwQuestNPCVID = 0;
 	m_dwQuestByVnum = 0;
 	m_pQuestItem = NULL;
+	m_pkQuestPC = NULL;
 
 	m_dwUnderGuildWarInfoMessageTime = get_dword_time()-60000;
 
@@ -333,6 +348,7 @@ void CHARACTER::Initialize()
 	m_strNewName = "";
 
 	m_known_guild.clear();
+	m_map_inventoryCellByVnum.clear();
 
 	m_dwLogOffInterval = 0;
 
@@ -352,6 +368,7 @@ void CHARACTER::Initialize()
 #ifdef __PET_SYSTEM__
 	m_petSystem = 0;
 	m_bIsPet = false;
+	m_pkPetActor = NULL;
 #endif
 
 	m_fAttMul = 1.0f;
@@ -373,6 +390,8 @@ void CHARACTER::Create(const char * c_pszName, DWORD vid, bool isPC)
 
 	if (isPC)
 		m_stName = c_pszName;
+
+	InvalidateInsertPacketCache();
 }
 
 void CHARACTER::Destroy()
@@ -406,6 +425,13 @@ void CHARACTER::Destroy()
 
 		m_petSystem = 0;
 	}
+
+	// Unsummon  ġ ʰ  (,   ) Ϳ .
+	if (m_pkPetActor)
+	{
+		m_pkPetActor->DetachCharacter();
+		m_pkPetActor = NULL;
+	}
 #endif
 
 	HorseSummon(false);
@@ -485,7 +511,7 @@ void CHARACTER::Destroy()
 	event_cancel(&m_pkWarpNPCEvent);
 	event_cancel(&m_pkRecoveryEvent);
 	event_cancel(&m_pkDeadEvent);
-	event_cancel(&m_pkSaveEvent);
+	CHARACTER_MANAGER::instance().UnregisterPeriodicSave(this);
 	event_cancel(&m_pkTimedEvent);
 	event_cancel(&m_pkStunEvent);
 	event_cancel(&m_pkFishingEvent);
@@ -505,12 +531,7 @@ void CHARACTER::Destroy()
 	event_cancel(&m_pkMiningEvent);
 	// END_OF_MINING
 
-	for (itertype(m_mapMobSkillEvent) it = m_mapMobSkillEvent.begin(); it != m_mapMobSkillEvent.end(); ++it)
-	{
-		LPEVENT pkEvent = it->second;
-		event_cancel(&pkEvent);
-	}
-	m_mapMobSkillEvent.clear();
+	m_vec_kMobSkillHit.clear();
 
 	//event_cancel(&m_pkAffectEvent);
 	ClearAffect();
@@ -532,6 +553,12 @@ void CHARACTER::Destroy()
 		m_pSkillLevels = NULL;
 	}
 
+	if (m_pPCPoints)
+	{
+		M2_DELETE(m_pPCPoints);
+		m_pPCPoints = NULL;
+	}
+
 	CEntity::Destroy();
 
 	if (GetSectree())
@@ -541,6 +568,17 @@ void CHARACTER::Destroy()
 		CHARACTER_MANAGER::instance().UnregisterForMonsterLog(this);
 }
 
+CHARACTER_POINT_PC & CHARACTER::AllocPCPoints()
+{
+	if (!m_pPCPoints)
+	{
+		m_pPCPoints = M2_NEW CHARACTER_POINT_PC;
+		memset(m_pPCPoints, 0, sizeof(CHARACTER_POINT_PC));
+	}
+
+	return *m_pPCPoints;
+}
+
 const char * CHARACTER::GetName() const
 {
 	return m_stName.empty() ? (m_pkMobData ? m_pkMobData->m_table.szLocaleName : "") : m_stName.c_str();
@@ -561,7 +599,7 @@ void CHARACTER::OpenMyShop(const char * c_pszSign, TShopItemTable * pTable, BYTE
 	}
 
 	//  Ʈ     .
-	quest::PC * pPC = quest::CQuestManager::instance().GetPCForce(GetPlayerID());
+	quest::PC * pPC = quest::CQuestManager::instance().GetPCForce(this);
 
 	// GetPCForce NULL  Ƿ  Ȯ 
 	if (pPC->IsRunning())
@@ -782,6 +820,53 @@ void CHARACTER::RestartAtSamePos()
 
 
 // Entity  Ÿٰ Ŷ .
+const TPacketGCCharacterAdditionalInfo & CHARACTER::GetAdditionalInfoPacket()
+{
+	TPacketGCCharacterAdditionalInfo & r = m_kAddInfoCache;
+
+	if (m_dwAddInfoCacheVersion == m_dwInsertPacketVersion)
+		return r;
+
+	m_dwAddInfoCacheVersion = m_dwInsertPacketVersion;
+
+	memset(&r, 0, sizeof(TPacketGCCharacterAdditionalInfo));
+
+	r.header = HEADER_GC_CHAR_ADDITIONAL_INFO;
+	r.dwVID = m_vid;
+
+	r.awPart[CHR_EQUIPPART_ARMOR] = GetPart(PART_MAIN);
+	r.awPart[CHR_EQUIPPART_WEAPON] = GetPart(PART_WEAPON);
+	r.awPart[CHR_EQUIPPART_HEAD] = GetPart(PART_HEAD);
+	r.awPart[CHR_EQUIPPART_HAIR] = GetPart(PART_HAIR);
+
+	r.bPKMode = m_bPKMode;
+	r.dwMountVnum = GetMountVnum();
+	r.bEmpire = m_bEmpire;
+
+	if (IsPC() == true)
+	{
+		r.dwLevel = GetLevel();
+	}
+	else
+	{
+		r.dwLevel = 0;
+	}
+
+	strlcpy(r.name, GetName(), sizeof(r.name));
+
+	if (GetGuild() != NULL)
+	{	
+		r.dwGuildID = GetGuild()->GetID();
+	}
+	else
+	{
+		r.dwGuildID = 0;
+	}
+
+	r.sAlignment = m_iAlignment / 10;
+	return r;
+}
+
 void CHARACTER::EncodeInsertPacket(LPENTITY entity)
 {
 
@@ -835,65 +920,7 @@ void CHARACTER::EncodeInsertPacket(LPENTITY entity)
 	d->Packet(&pack, sizeof(pack));
 
 	if (IsPC() == true || m_bCharType == CHAR_TYPE_NPC)
-	{
-		TPacketGCCharacterAdditionalInfo addPacket;
-		memset(&addPacket, 0, sizeof(TPacketGCCharacterAdditionalInfo));
-
-		addPacket.header = HEADER_GC_CHAR_ADDITIONAL_INFO;
-		addPacket.dwVID = m_vid;
-
-		addPacket.awPart[CHR_EQUIPPART_ARMOR] = GetPart(PART_MAIN);
-		addPacket.awPart[CHR_EQUIPPART_WEAPON] = GetPart(PART_WEAPON);
-		addPacket.awPart[CHR_EQUIPPART_HEAD] = GetPart(PART_HEAD);
-		addPacket.awPart[CHR_EQUIPPART_HAIR] = GetPart(PART_HAIR);
-
-		addPacket.bPKMode = m_bPKMode;
-		addPacket.dwMountVnum = GetMountVnum();
-		addPacket.bEmpire = m_bEmpire;
-
-		if (IsPC() == true)
-		{
-			addPacket.dwLevel = GetLevel();
-		}
-		else
-		{
-			addPacket.dwLevel = 0;
-		}
-
-		if (false)
-		{
-			LPCHARACTER ch = (LPCHARACTER) entity;
-
-			if (GetEmpire() == ch->GetEmpire() || ch->GetGMLevel() > GM_PLAYER || m_bCharType == CHAR_TYPE_NPC)
-			{
-				goto show_all_info;
-			}
-			else
-			{
-				memset(addPacket.name, 0, CHARACTER_NAME_MAX_LEN);
-				addPacket.dwGuildID = 0;
-				addPacket.sAlignment = 0;
-			}
-		}
-		else
-		{
-		show_all_info:
-			strlcpy(addPacket.name, GetName(), sizeof(addPacket.name));
-
-			if (GetGuild() != NULL)
-			{	
-				addPacket.dwGuildID = GetGuild()->GetID();
-			}
-			else
-			{
-				addPacket.dwGuildID = 0;
-			}
-
-			addPacket.sAlignment = m_iAlignment / 10;
-		}
-
-		d->Packet(&addPacket, sizeof(TPacketGCCharacterAdditionalInfo));
-	}
+		d->Packet(&GetAdditionalInfoPacket(), sizeof(TPacketGCCharacterAdditionalInfo));
 
 	if (iDur)
 	{
@@ -963,6 +990,8 @@ void CHARACTER::EncodeRemovePacket(LPENTITY entity)
 
 void CHARACTER::UpdatePacket()
 {
+	InvalidateInsertPacketCache();
+
 	if (GetSectree() == NULL) return;
 
 	TPacketGCCharacterUpdate pack;
@@ -1205,7 +1234,7 @@ void CHARACTER::CreatePlayerProto(TPlayerTable & tab)
 	tab.sRandomSP = m_points.iRandomSP;
 
 	for (int i = 0; i < QUICKSLOT_MAX_NUM; ++i)
-		tab.quickslot[i] = m_quickslot[i];
+		tab.quickslot[i] = GetPCPoints().quickslot[i];
 
 	thecore_memcpy(tab.parts, m_pointsInstant.parts, sizeof(tab.parts));
 
@@ -1217,23 +1246,35 @@ void CHARACTER::CreatePlayerProto(TPlayerTable & tab)
 }
 
 
-void CHARACTER::SaveReal()
+bool CHARACTER::SaveReal()
 {
 	if (m_bSkipSave)
-		return;
+		return false;
 
 	if (!GetDesc())
 	{
 		sys_err("Character::Save : no descriptor when saving (name: %s)", GetName());
-		return;
+		return false;
 	}
 
 	TPlayerTable table;
 	CreatePlayerProto(table);
 
-	db_clientdesc->DBPacket(HEADER_GD_PLAYER_SAVE, GetDesc()->GetHandle(), &table, sizeof(TPlayerTable));
+	//  ־ и þ ÷ ð  Ѵ. ٸ  ٲų     ȴ.
+	DWORD dwPlayTime = table.playtime;
+	table.playtime = 0;
+	DWORD dwCRC = GetCRC32((const char *) &table, sizeof(TPlayerTable));
+	table.playtime = dwPlayTime;
+
+	bool bSaved = dwCRC != m_dwLastSaveCRC;
+
+	if (bSaved)
+	{
+		db_clientdesc->DBPacket(HEADER_GD_PLAYER_SAVE, GetDesc()->GetHandle(), &table, sizeof(TPlayerTable));
+		m_dwLastSaveCRC = dwCRC;
+	}
 
-	quest::PC * pkQuestPC = quest::CQuestManager::instance().GetPCForce(GetPlayerID());
+	quest::PC * pkQuestPC = quest::CQuestManager::instance().GetPCForce(this);
 
 	if (!pkQuestPC)
 		sys_err("CHARACTER::Save : null quest::PC pointer! (name %s)", GetName());
@@ -1245,6 +1286,8 @@ void CHARACTER::SaveReal()
 	marriage::TMarriage* pMarriage = marriage::CManager::instance().Get(GetPlayerID());
 	if (pMarriage)
 		pMarriage->Save();
+
+	return bSaved;
 }
 
 void CHARACTER::FlushDelayedSaveItem()
@@ -1316,6 +1359,9 @@ void CHARACTER::Disconnect(const char * c_pszReason)
 	}
 
 
+	//    ٲ   Ѵ.
+	m_dwLastSaveCRC = 0;
+
 	if (!CHARACTER_MANAGER::instance().FlushDelayedSave(this))
 	{
 		SaveReal();
@@ -1324,6 +1370,7 @@ void CHARACTER::Disconnect(const char * c_pszReason)
 	FlushDelayedSaveItem();
 
 	SaveAffect();
+	SendWarpHandoff();
 	m_bIsLoadedAffect = false;
 
 	m_bSkipSave = true; //  Ŀ ̻ ϸ ȵȴ.
@@ -1348,7 +1395,7 @@ void CHARACTER::Disconnect(const char * c_pszReason)
 	M2_DESTROY_CHARACTER(this);
 }
 
-bool CHARACTER::Show(long lMapIndex, long x, long y, long z, bool bShowSpawnMotion/* = false */)
+bool CHARACTER::Show(long lMapIndex, long x, long y, long z, bool bShowSpawnMotion/* = false */, bool bDeferView/* = false */)
 {
 	LPSECTREE sectree = SECTREE_MANAGER::instance().Get(lMapIndex, x, y);
 
@@ -1360,6 +1407,9 @@ bool CHARACTER::Show(long lMapIndex, long x, long y, long z, bool bShowSpawnMoti
 
 	SetMapIndex(lMapIndex);
 
+	if (IsPC() && GetDesc())
+		DESC_MANAGER::instance().SubscribeChat(GetDesc(), GetDesc()->GetEmpire(), lMapIndex);
+
 	bool bChangeTree = false;
 
 	if (!GetSectree() || GetSectree() != sectree)
@@ -1407,6 +1457,13 @@ bool CHARACTER::Show(long lMapIndex, long x, long y, long z, bool bShowSpawnMoti
 		EncodeInsertPacket(this);
 		sectree->InsertEntity(this);
 
+		//   ´ þ߸  ߰ Ŷ  ڿ 
+		if (bDeferView)
+		{
+			SetValidComboInterval(0);
+			return true;
+		}
+
 		UpdateSectree();
 	}
 	else
@@ -1421,6 +1478,11 @@ bool CHARACTER::Show(long lMapIndex, long x, long y, long z, bool bShowSpawnMoti
 	return true;
 }
 
+void CHARACTER::ClearSpawnState()
+{
+	REMOVE_BIT(m_bAddChrState, ADD_CHARACTER_STATE_SPAWN);
+}
+
 // BGM_INFO
 struct BGMInfo
 {
@@ -1639,6 +1701,8 @@ BYTE CHARACTER::GetJob() const
 void CHARACTER::SetLevel(BYTE level)
 {
 	m_points.level = level;
+	InvalidateCombatFactor();
+	InvalidateInsertPacketCache();
 
 	if (IsPC())
 	{
@@ -1654,6 +1718,7 @@ void CHARACTER::SetLevel(BYTE level)
 void CHARACTER::SetEmpire(BYTE bEmpire)
 {
 	m_bEmpire = bEmpire;
+	InvalidateInsertPacketCache();
 }
 
 void CHARACTER::SetPlayerProto(const TPlayerTable * t)
@@ -1688,6 +1753,8 @@ void CHARACTER::SetPlayerProto(const TPlayerTable * t)
 	thecore_memcpy(m_pSkillLevels, t->skills, sizeof(TPlayerSkill) * SKILL_MAX_NUM);
 	// END_OF_REMOVE_REAL_SKILL_LEVLES
 
+	AllocPCPoints();
+
 	if (t->lMapIndex >= 10000)
 	{
 		m_posWarp.x = t->lExitX;
@@ -1774,6 +1841,21 @@ void CHARACTER::SetPlayerProto(const TPlayerTable * t)
 #endif
 }
 
+#ifdef __PET_SYSTEM__
+void CHARACTER::SetPetActor(CPetActor * pkActor)
+{
+	m_pkPetActor = pkActor;
+
+	if (!pkActor)
+		return;
+
+	// ó / ¿  󰣴.
+	m_stateIdle.Set(this, &CHARACTER::BeginStateEmpty, &CHARACTER::StatePet, &CHARACTER::EndStateEmpty);
+	m_stateMove.Set(this, &CHARACTER::BeginStateEmpty, &CHARACTER::StateMove, &CHARACTER::EndStateEmpty);
+	m_stateBattle.Set(this, &CHARACTER::BeginStateEmpty, &CHARACTER::StatePet, &CHARACTER::EndStateEmpty);
+}
+#endif
+
 EVENTFUNC(kill_ore_load_event)
 {
 	char_event_info* info = dynamic_cast<char_event_info*>( event->info );
@@ -1800,6 +1882,8 @@ void CHARACTER::SetProto(const CMob * pkMob)
 
 	m_pkMobData = pkMob;
 	m_pkMobInst = M2_NEW CMobInstance;
+	InvalidateCombatFactor();
+	InvalidateInsertPacketCache();
 
 	m_bPKMode = PK_MODE_FREE;
 
@@ -2132,6 +2216,8 @@ void CHARACTER::ComputeBattlePoints()
 
 void CHARACTER::ComputePoints()
 {
+	InvalidateCombatFactor();
+
 	long lStat = GetPoint(POINT_STAT);
 	long lStatResetCount = GetPoint(POINT_STAT_RESET_COUNT);
 	long lSkillActive = GetPoint(POINT_SKILL);
@@ -2347,22 +2433,9 @@ EVENTFUNC(recovery_event)
 
 		if (2493 == ch->GetMobTable().dwVnum)
 		{
-			int regenPct = BlueDragon_GetRangeFactor("hp_regen", ch->GetHPPct());
+			int regenPct = BlueDragon_GetRangePct(BlueDragon_GetSetting().vec_kHPRegen, ch->GetHPPct());
 			regenPct += ch->GetMobTable().bRegenPercent;
-
-			for (int i=1 ; i <= 4 ; ++i)
-			{
-				if (REGEN_PECT_BONUS == BlueDragon_GetIndexFactor("DragonStone", i, "effect_type"))
-				{
-					DWORD dwDragonStoneID = BlueDragon_GetIndexFactor("DragonStone", i, "vnum");
-					size_t val = BlueDragon_GetIndexFactor("DragonStone", i, "val");
-					size_t cnt = SECTREE_MANAGER::instance().GetMonsterCountInMap( ch->GetMapIndex(), dwDragonStoneID );
-
-					regenPct += (val*cnt);
-
-					break;
-				}
-			}
+			regenPct += BlueDragon_GetStoneBonus(ch->GetMapIndex(), REGEN_PECT_BONUS);
 
 			ch->PointChange(POINT_HP, MAX(1, (ch->GetMaxHP() * regenPct) / 100));
 		}
@@ -2380,16 +2453,10 @@ EVENTFUNC(recovery_event)
 
 		if (2493 == ch->GetMobTable().dwVnum)
 		{
-			for (int i=1 ; i <= 4 ; ++i)
+			for (int i=0 ; i < BLUEDRAGON_STONE_MAX_NUM ; ++i)
 			{
-				if (REGEN_TIME_BONUS == BlueDragon_GetIndexFactor("DragonStone", i, "effect_type"))
-				{
-					DWORD dwDragonStoneID = BlueDragon_GetIndexFactor("DragonStone", i, "vnum");
-					size_t val = BlueDragon_GetIndexFactor("DragonStone", i, "val");
-					size_t cnt = SECTREE_MANAGER::instance().GetMonsterCountInMap( ch->GetMapIndex(), dwDragonStoneID );
-
-					return PASSES_PER_SEC(MAX(1, (ch->GetMobTable().bRegenCycle - (val*cnt))));
-				}
+				if (REGEN_TIME_BONUS == BlueDragon_GetSetting().akStone[i].uEffectType)
+					return PASSES_PER_SEC(MAX(1, (ch->GetMobTable().bRegenCycle - BlueDragon_GetStoneBonus(ch->GetMapIndex(), REGEN_TIME_BONUS))));
 			}
 		}
 
@@ -2766,7 +2833,12 @@ void CHARACTER::SendMovePacket(BYTE bFunc, BYTE bArg, DWORD x, DWORD y, DWORD dw
 	}
 
 	EncodeMovePacket(pack, GetVID(), bFunc, bArg, x, y, dwDuration, dwTime, iRot == -1 ? (int) GetRotation() / 5 : iRot);
-	PacketView(&pack, sizeof(TPacketGCMove), this);
+
+	//  FUNC_WAIT  Goto    ̵̴.  (Stop ) ο .
+	if (bFunc == FUNC_MOVE || (bFunc == FUNC_WAIT && !IsPC() && IsStateMove()))
+		PacketViewLOD(&pack, sizeof(TPacketGCMove), this);
+	else
+		PacketView(&pack, sizeof(TPacketGCMove), this);
 }
 
 int CHARACTER::GetRealPoint(BYTE type) const
@@ -2811,6 +2883,21 @@ int CHARACTER::GetPolymorphPoint(BYTE type) const
 	return GetPoint(type);
 }
 
+const CHARACTER_COMBAT_FACTOR & CHARACTER::GetCombatFactor() const
+{
+	if (m_kCombatFactor.bValid)
+		return m_kCombatFactor;
+
+	m_kCombatFactor.iRatingDX = GetPolymorphPoint(POINT_DX);
+	m_kCombatFactor.iAttBonusPct = 100 + GetPoint(POINT_ATT_BONUS) + GetPoint(POINT_MELEE_MAGIC_ATT_BONUS_PER);
+	m_kCombatFactor.iDefense = GetPoint(POINT_DEF_GRADE) * (100 + GetPoint(POINT_DEF_BONUS)) / 100;
+	m_kCombatFactor.bRaceAttBonusPoint = m_pkMobData ? GetRaceAttBonusPoint(m_pkMobData->m_table.dwRaceFlag) : POINT_NONE;
+
+	//   DX   ų   ٲǷ   ʴ´.
+	m_kCombatFactor.bValid = !(IsPolymorphed() && !IsPolyMaintainStat());
+	return m_kCombatFactor;
+}
+
 int CHARACTER::GetPoint(BYTE type) const
 {
 	if (type >= POINT_MAX_NUM)
@@ -2903,6 +2990,7 @@ void CHARACTER::SetPoint(BYTE type, int val)
 	}
 
 	m_pointsInstant.points[type] = val;
+	InvalidateCombatFactor();
 
 	//  ̵  ȳٸ ̵ ð  ٽ ؾ Ѵ.
 	if (type == POINT_MOV_SPEED && get_dword_time() < m_dwMoveStartTime + m_dwMoveDuration)
@@ -3692,35 +3780,10 @@ void CHARACTER::Motion(BYTE motion, LPCHARACTER victim)
 	PacketAround(&pack_motion, sizeof(struct packet_motion));
 }
 
-EVENTFUNC(save_event)
-{
-	char_event_info* info = dynamic_cast<char_event_info*>( event->info );
-	if ( info == NULL )
-	{
-		sys_err( "save_event> <Factor> Null pointer" );
-		return 0;
-	}
-
-	LPCHARACTER ch = info->ch;
-
-	if (ch == NULL) { // <Factor>
-		return 0;
-	}	
-	sys_log(1, "SAVE_EVENT: %s", ch->GetName());
-	ch->Save();
-	ch->FlushDelayedSaveItem();
-	return (save_event_second_cycle);
-}
-
+// ĳ͸ ̺Ʈ  ʰ CHARACTER_MANAGER  pulse   Ѵ.
 void CHARACTER::StartSaveEvent()
 {
-	if (m_pkSaveEvent)
-		return;
-
-	char_event_info* info = AllocEventInfo<char_event_info>();
-
-	info->ch = this;
-	m_pkSaveEvent = event_create(save_event, info, save_event_second_cycle);
+	CHARACTER_MANAGER::instance().RegisterPeriodicSave(this);
 }
 
 void CHARACTER::MonsterLog(const char* format, ...)
@@ -3939,6 +4002,9 @@ void CHARACTER::StopStateMachine()
 
 void CHARACTER::UpdateStateMachine(DWORD dwPulse)
 {
+	if (!m_vec_kMobSkillHit.empty())
+		UpdateMobSkillHit(dwPulse);
+
 	if (dwPulse < m_dwNextStatePulse)
 		return;
 
@@ -3947,6 +4013,34 @@ void CHARACTER::UpdateStateMachine(DWORD dwPulse)
 
 	Update();
 	m_dwNextStatePulse = dwPulse + m_dwStateDuration;
+
+	// ֺ PC   ϵ  PC ٽ   .
+	if (CanGoDormant())
+		StopStateMachine();
+}
+
+bool CHARACTER::CanGoDormant()
+{
+	if (IsPC())
+		return false;
+
+#ifdef __PET_SYSTEM__
+	//   ָ  󰡾 ϹǷ  ʴ´.
+	if (IsPet())
+		return false;
+#endif
+
+	// ̳߰   ʹ   .
+	if (IsMonster() && (!IsStateIdle() || GetVictim()))
+		return false;
+
+	//    ų  Ҵ
+	if (!m_vec_kMobSkillHit.empty())
+		return false;
+
+	LPSECTREE pkSectree = GetSectree();
+
+	return pkSectree && pkSectree->GetPCCount() == 0;
 }
 
 void CHARACTER::SetNextStatePulse(int iNextPulse)
@@ -3985,6 +4079,7 @@ void CHARACTER::SetPart(BYTE bPartPos, WORD wVal)
 {
 	assert(bPartPos < PART_MAX_NUM);
 	m_pointsInstant.parts[bPartPos] = wVal;
+	InvalidateInsertPacketCache();
 }
 
 WORD CHARACTER::GetPart(BYTE bPartPos) const
@@ -5105,6 +5200,8 @@ bool CHARACTER::WarpSet(long x, long y, long lPrivateMapIndex)
 	m_lWarpMapIndex = lMapIndex;
 	m_posWarp.x = x;
 	m_posWarp.y = y;
+	m_lWarpAddr = lAddr;
+	m_wWarpPort = wPort;
 
 	sys_log(0, "WarpSet %s %d %d current map %d target map %d", GetName(), x, y, GetMapIndex(), lMapIndex);
 
@@ -5125,6 +5222,149 @@ bool CHARACTER::WarpSet(long x, long y, long lPrivateMapIndex)
 	return true;
 }
 
+//     , Ʈ, Ʈ  ھ  ѱ.
+//  ھ  α Ű ϸ ̰  DB  ÷̾ ̺ ûѴ.
+// ѱ ϸ  ھ ó DB  Ƿ ص  .
+void CHARACTER::SendWarpHandoff()
+{
+	if (!g_bWarpHandoff || !m_wWarpPort || !GetDesc() || !GetDesc()->GetLoginKey())
+		return;
+
+	quest::PC * pPC = GetQuestPC();
+
+	if (!IsItemLoaded() || !IsLoadedAffect() || !pPC || !pPC->IsLoaded())
+		return;
+
+	LPDESC pkPeer = NULL;
+	bool bSelf = m_lWarpAddr == (long) inet_addr(g_szPublicIP) && m_wWarpPort == mother_port;
+
+	if (!bSelf && !(pkPeer = P2P_MANAGER::instance().FindPeerByListenAddr(m_lWarpAddr, m_wWarpPort)))
+	{
+		sys_log(0, "WARP_HANDOFF: no peer for %s port %u", GetName(), m_wWarpPort);
+		return;
+	}
+
+	static std::vector<char> s_vecData;
+	static std::vector<TQuestTable> s_vecQuest;
+
+	s_vecData.clear();
+
+	DWORD dwItemCount = 0;
+	LPITEM item;
+
+	for (int i = 0; i < INVENTORY_AND_EQUIP_SLOT_MAX + DRAGON_SOUL_INVENTORY_MAX_NUM; ++i)
+	{
+		if (i < INVENTORY_AND_EQUIP_SLOT_MAX)
+			item = GetInventoryItem(i);
+		else
+			item = GetItem(TItemPos(DRAGON_SOUL_INVENTORY, i - INVENTORY_AND_EQUIP_SLOT_MAX));
+
+		if (!item)
+			continue;
+
+		// ITEM_MANAGER::SaveSingleItem   
+		TPlayerItem t;
+
+		t.id = item->GetID();
+		t.window = item->GetWindow();
+		t.pos = t.window == EQUIPMENT ? item->GetCell() - INVENTORY_MAX_NUM : item->GetCell();
+		t.count = item->GetCount();
+		t.vnum = item->GetOriginalVnum();
+		t.owner = GetPlayerID();
+		thecore_memcpy(t.alSockets, item->GetSockets(), sizeof(t.alSockets));
+		thecore_memcpy(t.aAttr, item->GetAttributes(), sizeof(t.aAttr));
+
+		s_vecData.insert(s_vecData.end(), (const char *) &t, (const char *) &t + sizeof(t));
+		++dwItemCount;
+	}
+
+	pPC->GetFlagTable(s_vecQuest);
+
+	if (!s_vecQuest.empty())
+		s_vecData.insert(s_vecData.end(), (const char *) &s_vecQuest[0], (const char *) &s_vecQuest[0] + sizeof(TQuestTable) * s_vecQuest.size());
+
+	DWORD dwAffectCount = 0;
+
+	for (itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin(); it != m_vec_pkAffect.end(); ++it)
+	{
+		CAffect * pkAff = *it;
+
+		// SaveAffect   ͸ ѱ.
+		if (IS_NO_SAVE_AFFECT(pkAff->dwType))
+			continue;
+
+		TPacketAffectElement e;
+
+		e.dwType	= pkAff->dwType;
+		e.bApplyOn	= pkAff->bApplyOn;
+		e.lApplyValue	= pkAff->lApplyValue;
+		e.dwFlag	= pkAff->dwFlag;
+		e.lDuration	= pkAff->lDuration;
+		e.lSPCost	= pkAff->lSPCost;
+
+		s_vecData.insert(s_vecData.end(), (const char *) &e, (const char *) &e + sizeof(e));
+		++dwAffectCount;
+	}
+
+	if (bSelf)
+	{
+		CHARACTER_MANAGER::instance().AddWarpHandoff(GetDesc()->GetLoginKey(), GetPlayerID(), dwItemCount, s_vecQuest.size(), dwAffectCount,
+				s_vecData.empty() ? NULL : &s_vecData[0]);
+		return;
+	}
+
+	if (s_vecQuest.size() > CHARACTER_MANAGER::WARP_HANDOFF_QUEST_MAX || dwAffectCount > CHARACTER_MANAGER::WARP_HANDOFF_AFFECT_MAX)
+	{
+		sys_log(0, "WARP_HANDOFF: %s has too many quest flags %u or affects %u", GetName(), (DWORD) s_vecQuest.size(), dwAffectCount);
+		return;
+	}
+
+	TPacketGGCharacterHandoff p;
+
+	p.bHeader = HEADER_GG_CHARACTER_HANDOFF;
+	p.lSize = s_vecData.size();
+	p.lRealSize = 0;
+	p.dwLoginKey = GetDesc()->GetLoginKey();
+	p.dwPID = GetPlayerID();
+	p.dwItemCount = dwItemCount;
+	p.dwQuestCount = s_vecQuest.size();
+	p.dwAffectCount = dwAffectCount;
+
+	const void * c_pvData = s_vecData.empty() ? NULL : &s_vecData[0];
+
+	// Ʈ ̺  ڿ ڸ   پ.
+	if (p.lSize > 0)
+	{
+		static std::vector<BYTE> s_vecCompressed;
+
+		s_vecCompressed.resize(LZOManager::instance().GetMaxCompressedSize(p.lSize));
+		lzo_uint uiCompressedSize = 0;
+
+		if (LZOManager::instance().Compress((const BYTE *) c_pvData, p.lSize, &s_vecCompressed[0], &uiCompressedSize) &&
+				(long) uiCompressedSize < p.lSize)
+		{
+			p.lRealSize = p.lSize;
+			p.lSize = uiCompressedSize;
+			c_pvData = &s_vecCompressed[0];
+		}
+	}
+
+	// ޴  Է ۿ    Ѵ.
+	if (sizeof(p) + p.lSize > MAX_INPUT_LEN / 2)
+	{
+		sys_log(0, "WARP_HANDOFF: %s too large (%d bytes)", GetName(), p.lSize);
+		return;
+	}
+
+	pkPeer->Packet(&p, sizeof(p));
+
+	if (p.lSize > 0)
+		pkPeer->Packet(c_pvData, p.lSize);
+
+	sys_log(0, "WARP_HANDOFF: %s to %s item %u quest %u affect %u (%d bytes)",
+			GetName(), pkPeer->GetHostName(), p.dwItemCount, p.dwQuestCount, p.dwAffectCount, p.lSize);
+}
+
 void CHARACTER::WarpEnd()
 {
 	if (test_server)
@@ -5344,8 +5584,20 @@ bool CHARACTER::Follow(LPCHARACTER pkChr, float fMinDistance)
 		float fDistToGo = fDist - fMinDistance;
 		GetDeltaByDegree(GetRotation(), fDistToGo, &fx, &fy);
 
+		long lDestX = GetX() + (int) fx;
+		long lDestY = GetY() + (int) fy;
+		PIXEL_POSITION posWaypoint;
+
+		//      ã  ̴  .
+		if (CPathFinder::instance().GetNextWaypoint(GetMapIndex(), GetX(), GetY(), lDestX, lDestY, posWaypoint))
+		{
+			lDestX = posWaypoint.x;
+			lDestY = posWaypoint.y;
+			SetRotationToXY(lDestX, lDestY);
+		}
+
 		//sys_log(0, " ̵ %s", GetName());
-		if (!Goto(GetX() + (int) fx, GetY() + (int) fy))
+		if (!Goto(lDestX, lDestY))
 			return false;
 	}
 
@@ -5985,6 +6237,7 @@ void CHARACTER::SetPolymorph(DWORD dwRaceNum, bool bMaintainStat)
 
 	m_bPolyMaintainStat = bMaintainStat;
 	m_dwPolymorphRace = dwRaceNum;
+	InvalidateCombatFactor();
 
 	sys_log(0, "POLYMORPH: %s race %u ", GetName(), dwRaceNum);
 
@@ -6118,6 +6371,7 @@ void CHARACTER::MountVnum(DWORD vnum)
 
 	m_dwMountVnum = vnum;
 	m_dwMountTime = get_dword_time();
+	InvalidateInsertPacketCache();
 
 	if (m_bIsObserver)
 		return;
@@ -6268,7 +6522,7 @@ EVENTFUNC(warp_npc_event)
 
 	FuncCheckWarp f(ch);
 	if (f.Valid())
-		ch->GetSectree()->ForEachAround(f);
+		ch->GetSectree()->ForEachAroundKind(SPATIAL_KIND_PC, f);
 
 	return passes_per_sec / 2;
 }
@@ -7,15 +7,23 @@
 #include "entity.h"
 #include "FSM.h"
 #include "horse_rider.h"
+#include "object_allocator.h"
 #include "vid.h"
 #include "constants.h"
 #include "affect.h"
 #include "affect_flag.h"
 #include "cube.h"
 #include "mining.h"
+#include "packet.h"
 
 class CBuffOnAttributes;
 class CPetSystem;
+class CPetActor;
+
+namespace quest
+{
+	class PC;
+}
 
 #define INSTANT_FLAG_DEATH_PENALTY		(1 << 0)
 #define INSTANT_FLAG_SHOP			(1 << 1)
@@ -180,15 +188,7 @@ typedef struct character_point_instant
 
 	WORD			parts[PART_MAX_NUM];
 
-	LPITEM			pItems[INVENTORY_AND_EQUIP_SLOT_MAX];
-	BYTE			bItemGrid[INVENTORY_AND_EQUIP_SLOT_MAX];
-
-	// ȥ κ丮.
-	LPITEM			pDSItems[DRAGON_SOUL_INVENTORY_MAX_NUM];
-	WORD			wDSItemGrid[DRAGON_SOUL_INVENTORY_MAX_NUM];
-
 	// by mhh
-	LPITEM			pCubeItems[CUBE_MAX_NUM];
 	LPCHARACTER		pCubeNpc;
 
 	LPCHARACTER			battle_victim;
@@ -205,6 +205,40 @@ typedef struct character_point_instant
 	LPENTITY		m_pDragonSoulRefineWindowOpener;
 } CHARACTER_POINT_INSTANT;
 
+// PC    ĭ . ʹ   Ƿ CHARACTER  
+// ʿ   (CHARACTER::m_pPCPoints).  CHARACTER   12KB پ.
+typedef struct character_point_pc
+{
+	LPITEM			pItems[INVENTORY_AND_EQUIP_SLOT_MAX];
+	BYTE			bItemGrid[INVENTORY_AND_EQUIP_SLOT_MAX];
+	// ⺻ κ丮   Ʈ. bItemGrid[i] != 0 ̸ ش  (i % INVENTORY_SLOT_PER_PAGE) Ʈ .
+	uint64_t		aqwItemGridMask[INVENTORY_PAGE_COUNT];
+
+	// ȥ κ丮.
+	LPITEM			pDSItems[DRAGON_SOUL_INVENTORY_MAX_NUM];
+	WORD			wDSItemGrid[DRAGON_SOUL_INVENTORY_MAX_NUM];
+	// ȥ (DRAGON_SOUL_BOX_SIZE ĭ)  Ʈ
+	DWORD			adwDSItemGridMask[DRAGON_SOUL_INVENTORY_MAX_NUM / DRAGON_SOUL_BOX_SIZE];
+
+	// by mhh
+	LPITEM			pCubeItems[CUBE_MAX_NUM];
+
+	TQuickslot		quickslot[QUICKSLOT_MAX_NUM];
+
+	// ų vnum  CHARACTER::m_vec_kSkillUseInfo  (ĭ + 1). 0 ̸    ų
+	BYTE			abSkillUseSlot[SKILL_MAX_NUM];
+} CHARACTER_POINT_PC;
+
+// Ÿݸ battle.cpp  ٽ ϴ . SetPoint, SetLevel, SetPolymorph, SetProto  ȿȭȴ.
+typedef struct character_combat_factor
+{
+	bool			bValid;
+	int				iRatingDX;			// GetPolymorphPoint(POINT_DX)
+	int				iAttBonusPct;		// 100 + POINT_ATT_BONUS + POINT_MELEE_MAGIC_ATT_BONUS_PER
+	int				iDefense;			// POINT_DEF_GRADE * (100 + POINT_DEF_BONUS) / 100
+	BYTE			bRaceAttBonusPoint;	//  شϴ POINT_ATTBONUS_*. Ͱ ƴϰų  POINT_NONE
+} CHARACTER_COMBAT_FACTOR;
+
 #define TRIGGERPARAM		LPCHARACTER ch, LPCHARACTER causer
 
 typedef struct trigger
@@ -289,7 +323,11 @@ enum e_overtime
 	OT_5HOUR,
 };
 
-class CHARACTER : public CEntity, public CFSM, public CHorseRider
+//  CHARACTER   ֱ  Ǯ ܵ ִ .
+// Ϳ  װ ٽ  ŭ  ġ ʴ´.
+enum { CHARACTER_POOL_FREE_TRIGGER = 1024 };
+
+class CHARACTER : public CEntity, public CFSM, public CHorseRider, public ObjectAllocator<CHARACTER, CHARACTER_POOL_FREE_TRIGGER, MEM_TAG_CHARACTER>
 {
 	protected:
 		//////////////////////////////////////////////////////////////////////////////////
@@ -301,6 +339,17 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 	public:
 		LPCHARACTER			FindCharacterInView(const char * name, bool bFindPCOnly);
 		void				UpdatePacket();
+		void				InvalidateInsertPacketCache()	{ ++m_dwInsertPacketVersion; }	// ̸///  ٲ θ
+
+	protected:
+		//  viewer  Ȱ  ΰ  Ŷ.  ٲ  ٽ .
+		const TPacketGCCharacterAdditionalInfo &	GetAdditionalInfoPacket();
+
+		TPacketGCCharacterAdditionalInfo	m_kAddInfoCache;
+		DWORD				m_dwInsertPacketVersion;
+		DWORD				m_dwAddInfoCacheVersion;
+
+	public:
 
 		//////////////////////////////////////////////////////////////////////////////////
 		// FSM (Finite State Machine) 
@@ -317,6 +366,9 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		virtual void		StateFlagBase();
 		void				StateHorse();
 
+		//     󰡱.   true
+		bool				FollowOwner(LPCHARACTER pkOwner, float fStartFollowDist, int iMinApproach, int iMaxApproach);
+
 	protected:
 		// STATE_IDLE_REFACTORING
 		void				__StateIdle_Monster();
@@ -379,7 +431,7 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		WORD			GetRaceNum() const;
 
 		void			Save();		// DelayedSave
-		void			SaveReal();	//  
+		bool			SaveReal();	//  . ÷̾ ̺     ʰ false
 		void			FlushDelayedSaveItem();
 
 		const char *	GetName() const;
@@ -466,6 +518,9 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		int				GetLimitPoint(BYTE idx) const;
 		int				GetPolymorphPoint(BYTE idx) const;
 
+		const CHARACTER_COMBAT_FACTOR &	GetCombatFactor() const;
+		void			InvalidateCombatFactor()	{ m_kCombatFactor.bValid = false; }
+
 		const TMobTable &	GetMobTable() const;
 		BYTE				GetMobRank() const;
 		BYTE				GetMobBattleType() const;
@@ -512,7 +567,9 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		void			ApplyPoint(BYTE bApplyType, int iVal);
 		void			CheckMaximumPoints();	// HP, SP    ִ밪   ˻ϰ ٸ .
 
-		bool			Show(long lMapIndex, long x, long y, long z = LONG_MAX, bool bShowSpawnMotion = false);
+		// bDeferView  Ʈ ְ þߴ  ʴ´. CHARACTER_MANAGER::EndSpawnBatch  .
+		bool			Show(long lMapIndex, long x, long y, long z = LONG_MAX, bool bShowSpawnMotion = false, bool bDeferView = false);
+		void			ClearSpawnState();
 
 		void			Sitdown(int is_ground);
 		void			Standup();
@@ -569,11 +626,15 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 
 		CHARACTER_POINT		m_points;
 		CHARACTER_POINT_INSTANT	m_pointsInstant;
+		CHARACTER_POINT_PC *	m_pPCPoints;	// SetPlayerProto  ó    .   NULL
+		TR1_NS::unordered_map<DWORD, std::vector<BYTE> >	m_map_inventoryCellByVnum;	// ⺻ κ丮 vnum  ĭ ()
+		mutable CHARACTER_COMBAT_FACTOR	m_kCombatFactor;
 
 		int				m_iMoveCount;
 		DWORD			m_dwPlayStartTime;
 		BYTE			m_bAddChrState;
 		bool			m_bSkipSave;
+		DWORD			m_dwLastSaveCRC;	//   ÷̾ ̺ (÷ ð )
 		BYTE			m_bChatCounter;
 
 		// End of Basic Points
@@ -632,6 +693,7 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 
 	protected:
 		void			ClearSync();
+		void			SendWarpHandoff();
 
 		float			m_fSyncTime;
 		LPCHARACTER		m_pkChrSyncOwner;
@@ -641,10 +703,14 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		PIXEL_POSITION	m_posStart;
 		PIXEL_POSITION	m_posWarp;
 		long			m_lWarpMapIndex;
+		long			m_lWarpAddr;	// WarpSet    ھ.    ĳ ¸ ѱ.
+		WORD			m_wWarpPort;
 
 		PIXEL_POSITION	m_posExit;
 		long			m_lExitMapIndex;
 
+		PIXEL_POSITION	m_posFollowOwner;	// FollowOwner     ġ
+
 		DWORD			m_dwMoveStartTime;
 		DWORD			m_dwMoveDuration;
 
@@ -668,7 +734,11 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		void			ChainQuickslotItem(LPITEM pItem, BYTE bType, BYTE bOldPos);
 
 	protected:
-		TQuickslot		m_quickslot[QUICKSLOT_MAX_NUM];
+		// б. m_pPCPoints    ĭ ش.
+		const CHARACTER_POINT_PC &	GetPCPoints() const	{ return m_pPCPoints ? *m_pPCPoints : msc_kEmptyPCPoints; }
+		CHARACTER_POINT_PC &		AllocPCPoints();
+
+		static const CHARACTER_POINT_PC	msc_kEmptyPCPoints;
 
 		////////////////////////////////////////////////////////////////////////////////////////
 		// Affect
@@ -696,13 +766,16 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		void			RemoveBadAffect();
 
 		CAffect *		FindAffect(DWORD dwType, BYTE bApply=APPLY_NONE) const;
-		const std::list<CAffect *> & GetAffectContainer() const	{ return m_list_pkAffect; }
+		const std::vector<CAffect *> & GetAffectContainer() const	{ return m_vec_pkAffect; }
 		bool			RemoveAffect(CAffect * pkAff);
 
 	protected:
+		void			RebuildAffectTypeMask();
+
 		bool			m_bIsLoadedAffect;
 		TAffectFlag		m_afAffectFlag;
-		std::list<CAffect *>	m_list_pkAffect;
+		std::vector<CAffect *>	m_vec_pkAffect;		// ߰ 
+		TAffectTypeMask		m_kAffectTypeMask;	// m_vec_pkAffect  ִ type , FindAffect   
 
 	public:
 		// PARTY_JOIN_BUG_FIX
@@ -913,6 +986,15 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 
 		int				CountEmptyInventory() const;
 
+		// ⺻ κ丮  Ʈ. ȯó   ڸ ̸ ƺ  
+		// 纻 FindInventoryGridBlank / PutInventoryGridMask   .
+		const uint64_t *	GetInventoryGridMask() const	{ return GetPCPoints().aqwItemGridMask; }
+		static int		FindInventoryGridBlank(const uint64_t * pqwGridMask, BYTE bSize);
+		static void		PutInventoryGridMask(uint64_t * pqwGridMask, int iCell, BYTE bSize);
+
+		// ⺻ κ丮 ش vnum   ĭ (ĭ ȣ ).  NULL
+		const std::vector<BYTE> *	GetInventoryCellsByVnum(DWORD dwVnum) const;
+
 		int				CountSpecifyItem(DWORD vnum) const;
 		void			RemoveSpecifyItem(DWORD vnum, DWORD count = 1);
 		LPITEM			FindSpecifyItem(DWORD vnum) const;
@@ -1062,6 +1144,10 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		BYTE				GetPKMode() const;
 		void				SetPKMode(BYTE bPKMode);
 
+		// (û ) 밡 ϳ ִ. CPVPManager   ش.
+		bool				HasPVP() const			{ return m_bHasPVP; }
+		void				SetHasPVP(bool bHasPVP)	{ m_bHasPVP = bHasPVP; }
+
 		void				ItemDropPenalty(LPCHARACTER pkKiller);
 
 		void				UpdateAggrPoint(LPCHARACTER ch, EDamageType type, int dam);
@@ -1108,6 +1194,7 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		int					m_iRealAlignment;
 		int					m_iKillerModePulse;
 		BYTE				m_bPKMode;
+		bool				m_bHasPVP;
 
 		// Aggro
 		DWORD				m_dwLastVictimSetTime;
@@ -1194,7 +1281,20 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		bool				UseMobSkill(unsigned int idx);
 		void				ResetMobSkillCooltime();
 	protected:
+		// dwTiming ڿ ´ ÷ . ̺Ʈ  UpdateStateMachine   pulse  ģ.
+		struct TMobSkillHit
+		{
+			DWORD			dwPulse;
+			PIXEL_POSITION	pos;
+			DWORD			dwVnum;
+			BYTE			bLevel;
+			size_t			index;		// vecSplashAttack   °.       ٲ۴
+		};
+
+		void				UpdateMobSkillHit(DWORD dwPulse);
+
 		DWORD				m_adwMobSkillCooltime[MOB_SKILL_MAX_NUM];
+		std::vector<TMobSkillHit>	m_vec_kMobSkillHit;
 		// END_OF_MOB_SKILL
 
 		// for SKILL_MUYEONG
@@ -1233,7 +1333,10 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 	protected:
 		TPlayerSkill*					m_pSkillLevels;
 		boost::unordered_map<BYTE, int>		m_SkillDamageBonus;
-		std::map<int, TSkillUseInfo>	m_SkillUseInfo;
+		std::vector<TSkillUseInfo>		m_vec_kSkillUseInfo;	//  . ĭ CHARACTER_POINT_PC::abSkillUseSlot
+
+		TSkillUseInfo &					GetSkillUseInfo(DWORD dwVnum);
+		TSkillUseInfo *					FindSkillUseInfo(DWORD dwVnum);
 
 		////////////////////////////////////////////////////////////////////////////////////////
 		// AI related
@@ -1442,10 +1545,15 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 
 		void				ConfirmWithMsg(const char* szMsg, int iTimeout, DWORD dwRequestPID);
 
+		// Ʈ Ŵ ó ã  ä DisconnectPC  .
+		quest::PC *			GetQuestPC() const		{ return m_pkQuestPC; }
+		void				SetQuestPC(quest::PC * pPC)	{ m_pkQuestPC = pPC; }
+
 	private:
 		DWORD				m_dwQuestNPCVID;
 		DWORD				m_dwQuestByVnum;
 		LPITEM				m_pQuestItem;
+		quest::PC *			m_pkQuestPC;
 
 		// Events
 	public:
@@ -1453,6 +1561,7 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		void				StopStateMachine();
 		void				UpdateStateMachine(DWORD dwPulse);
 		void				SetNextStatePulse(int iPulseNext);
+		bool				CanGoDormant();		// nothing to finish and no PC around, woken again by StartStateMachine
 
 		// ĳ νϽ Ʈ Լ.  ̻ ӱ CFSM::Update Լ ȣϰų UpdateStateMachine Լ ߴµ,  Ʈ Լ ߰.
 		void				UpdateCharacter(DWORD dwPulse);
@@ -1485,7 +1594,7 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 
 		LPEVENT				m_pkDeadEvent;
 		LPEVENT				m_pkStunEvent;
-		LPEVENT				m_pkSaveEvent;
+		int				m_iPeriodicSaveSlot;	// CHARACTER_MANAGER  ֱ  ĭ.  -1
 		LPEVENT				m_pkRecoveryEvent;
 		LPEVENT				m_pkTimedEvent;
 		LPEVENT				m_pkFishingEvent;
@@ -1502,7 +1611,6 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		LPEVENT				m_pkWarpEvent;
 		LPEVENT				m_pkCheckSpeedHackEvent;
 		LPEVENT				m_pkDestroyWhenIdleEvent;
-		LPEVENT				m_pkPetSystemUpdateEvent;
 
 		bool IsWarping() const { return m_pkWarpEvent ? true : false; }
 
@@ -1511,8 +1619,6 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		const CMob *		m_pkMobData;
 		CMobInstance *		m_pkMobInst;
 
-		std::map<int, LPEVENT> m_mapMobSkillEvent;
-
 		friend struct FuncSplashDamage;
 		friend struct FuncSplashAffect;
 		friend class CFuncShoot;
@@ -1606,7 +1712,7 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 		bool ItemProcess_Polymorph(LPITEM item);
 
 		// by mhh
-		LPITEM*	GetCubeItem() { return m_pointsInstant.pCubeItems; }
+		LPITEM*	GetCubeItem() { return AllocPCPoints().pCubeItems; }
 		bool IsCubeOpen () const	{ return (m_pointsInstant.pCubeNpc?true:false); }
 		void SetCubeNpc(LPCHARACTER npc)	{ m_pointsInstant.pCubeNpc = npc; }
 		bool CanDoCube() const;
@@ -1700,6 +1806,14 @@ class CHARACTER : public CEntity, public CFSM, public CHorseRider
 	public:
 		void SetPet() { m_bIsPet = true; }
 		bool IsPet() { return m_bIsPet; }
+
+		//  ĳʹ ڱ ¸ӽſ CPetActor::Update  θ.
+		void SetPetActor(CPetActor * pkActor);
+		void StatePet();
+
+	private:
+		CPetActor *		m_pkPetActor;
+	public:
 #endif
 
 	//  .
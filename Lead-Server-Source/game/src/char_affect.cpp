@@ -18,7 +18,6 @@
 #include "item.h"
 #include "DragonSoul.h"
 
-#define IS_NO_SAVE_AFFECT(type) ((type) == AFFECT_WAR_FLAG || (type) == AFFECT_REVIVE_INVISIBLE || ((type) >= AFFECT_PREMIUM_START && (type) <= AFFECT_PREMIUM_END))
 #define IS_NO_CLEAR_ON_DEATH_AFFECT(type) ((type) == AFFECT_BLOCK_CHAT || ((type) >= 500 && (type) < 600))
 
 void SendAffectRemovePacket(LPDESC d, DWORD pid, DWORD type, BYTE point)
@@ -52,9 +51,12 @@ void SendAffectAddPacket(LPDESC d, CAffect * pkAff)
 // Affect
 CAffect * CHARACTER::FindAffect(DWORD dwType, BYTE bApply) const
 {
-	itertype(m_list_pkAffect) it = m_list_pkAffect.begin();
+	if (!m_kAffectTypeMask.MayContain(dwType))
+		return NULL;
 
-	while (it != m_list_pkAffect.end())
+	itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin();
+
+	while (it != m_vec_pkAffect.end())
 	{
 		CAffect * pkAffect = *it++;
 
@@ -177,9 +179,9 @@ void CHARACTER::ClearAffect(bool bSave)
 	WORD	wMovSpd = GetPoint(POINT_MOV_SPEED);
 	WORD	wAttSpd = GetPoint(POINT_ATT_SPEED);
 
-	itertype(m_list_pkAffect) it = m_list_pkAffect.begin();
+	itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin();
 
-	while (it != m_list_pkAffect.end())
+	while (it != m_vec_pkAffect.end())
 	{
 		CAffect * pkAff = *it;
 
@@ -199,10 +201,12 @@ void CHARACTER::ClearAffect(bool bSave)
 
 		ComputeAffect(pkAff, false);
 
-		it = m_list_pkAffect.erase(it);
+		it = m_vec_pkAffect.erase(it);
 		CAffect::Release(pkAff);
 	}
 
+	RebuildAffectTypeMask();
+
 	if (afOld != m_afAffectFlag ||
 			wMovSpd != GetPoint(POINT_MOV_SPEED) ||
 			wAttSpd != GetPoint(POINT_ATT_SPEED))
@@ -210,7 +214,7 @@ void CHARACTER::ClearAffect(bool bSave)
 
 	CheckMaximumPoints();
 
-	if (m_list_pkAffect.empty())
+	if (m_vec_pkAffect.empty())
 		event_cancel(&m_pkAffectEvent);
 }
 
@@ -269,13 +273,12 @@ int CHARACTER::ProcessAffect()
 	long lMovSpd = GetPoint(POINT_MOV_SPEED);
 	long lAttSpd = GetPoint(POINT_ATT_SPEED);
 
-	itertype(m_list_pkAffect) it;
-
-	it = m_list_pkAffect.begin();
+	// ComputeAffect  ̳ʰ ٲ ϵ ε .
+	size_t i = 0;
 
-	while (it != m_list_pkAffect.end())
+	while (i < m_vec_pkAffect.size())
 	{
-		pkAff = *it;
+		pkAff = m_vec_pkAffect[i];
 
 		bool bEnd = false;
 
@@ -304,7 +307,7 @@ int CHARACTER::ProcessAffect()
 
 		if (bEnd)
 		{
-			it = m_list_pkAffect.erase(it);
+			m_vec_pkAffect.erase(m_vec_pkAffect.begin() + i);
 			ComputeAffect(pkAff, false);
 			bDiff = true;
 			if (IsPC())
@@ -317,11 +320,13 @@ int CHARACTER::ProcessAffect()
 			continue;
 		}
 
-		++it;
+		++i;
 	}
 
 	if (bDiff)
 	{
+		RebuildAffectTypeMask();
+
 		if (afOld != m_afAffectFlag ||
 				lMovSpd != GetPoint(POINT_MOV_SPEED) ||
 				lAttSpd != GetPoint(POINT_ATT_SPEED))
@@ -332,7 +337,7 @@ int CHARACTER::ProcessAffect()
 		CheckMaximumPoints();
 	}
 
-	if (m_list_pkAffect.empty())
+	if (m_vec_pkAffect.empty())
 		return true;
 
 	return false;
@@ -342,9 +347,9 @@ void CHARACTER::SaveAffect()
 {
 	TPacketGDAddAffect p;
 
-	itertype(m_list_pkAffect) it = m_list_pkAffect.begin();
+	itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin();
 
-	while (it != m_list_pkAffect.end())
+	while (it != m_vec_pkAffect.end())
 	{
 		CAffect * pkAff = *it++;
 
@@ -493,7 +498,7 @@ void CHARACTER::LoadAffect(DWORD dwCount, TPacketAffectElement * pElements)
 		}
 
 		CAffect* pkAff = CAffect::Acquire();
-		m_list_pkAffect.push_back(pkAff);
+		m_vec_pkAffect.push_back(pkAff);
 
 		pkAff->dwType		= pElements->dwType;
 		pkAff->bApplyOn		= pElements->bApplyOn;
@@ -502,6 +507,8 @@ void CHARACTER::LoadAffect(DWORD dwCount, TPacketAffectElement * pElements)
 		pkAff->lDuration	= pElements->lDuration;
 		pkAff->lSPCost		= pElements->lSPCost;
 
+		m_kAffectTypeMask.Set(pkAff->dwType);
+
 		SendAffectAddPacket(GetDesc(), pkAff);
 
 		ComputeAffect(pkAff, true);
@@ -577,7 +584,7 @@ bool CHARACTER::AddAffect(DWORD dwType, BYTE bApplyOn, long lApplyValue, DWORD d
 		// NOTE:   type ε  Ʈ   ִ.
 		// 
 		pkAff = CAffect::Acquire();
-		m_list_pkAffect.push_back(pkAff);
+		m_vec_pkAffect.push_back(pkAff);
 
 	}
 
@@ -591,6 +598,8 @@ bool CHARACTER::AddAffect(DWORD dwType, BYTE bApplyOn, long lApplyValue, DWORD d
 	pkAff->lDuration	= lDuration;
 	pkAff->lSPCost	= lSPCost;
 
+	m_kAffectTypeMask.Set(pkAff->dwType);
+
 	WORD wMovSpd = GetPoint(POINT_MOV_SPEED);
 	WORD wAttSpd = GetPoint(POINT_ATT_SPEED);
 
@@ -624,9 +633,9 @@ bool CHARACTER::AddAffect(DWORD dwType, BYTE bApplyOn, long lApplyValue, DWORD d
 
 void CHARACTER::RefreshAffect()
 {
-	itertype(m_list_pkAffect) it = m_list_pkAffect.begin();
+	itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin();
 
-	while (it != m_list_pkAffect.end())
+	while (it != m_vec_pkAffect.end())
 	{
 		CAffect * pkAff = *it++;
 		ComputeAffect(pkAff, true);
@@ -666,15 +675,143 @@ void CHARACTER::ComputeAffect(CAffect * pkAff, bool bAdd)
 	}
 }
 
+// ٸ Ʈ 꿡  ʰ, PointChange  ׳ ϱ⸸ ϴ Ʈ.
+// ̷ Ʈ Ŵ affect  ComputeAffect(false)  ⸸ ص ComputePoints  .
+static bool IsIndependentAffectPoint(BYTE bApplyOn)
+{
+	switch (bApplyOn)
+	{
+		case POINT_NONE:
+		case POINT_ATT_SPEED:
+		case POINT_MOV_SPEED:
+		case POINT_CASTING_SPEED:
+		case POINT_ATT_GRADE:
+		case POINT_MAGIC_ATT_GRADE:
+		case POINT_MAGIC_DEF_GRADE:
+		case POINT_HP_REGEN:
+		case POINT_SP_REGEN:
+		case POINT_BOW_DISTANCE:
+		case POINT_ATTBONUS_HUMAN:
+		case POINT_ATTBONUS_ANIMAL:
+		case POINT_ATTBONUS_ORC:
+		case POINT_ATTBONUS_MILGYO:
+		case POINT_ATTBONUS_UNDEAD:
+		case POINT_ATTBONUS_DEVIL:
+		case POINT_ATTBONUS_MONSTER:
+		case POINT_ATTBONUS_SURA:
+		case POINT_ATTBONUS_ASSASSIN:
+		case POINT_ATTBONUS_WARRIOR:
+		case POINT_ATTBONUS_SHAMAN:
+		case POINT_POISON_PCT:
+		case POINT_STUN_PCT:
+		case POINT_SLOW_PCT:
+		case POINT_BLOCK:
+		case POINT_DODGE:
+		case POINT_CRITICAL_PCT:
+		case POINT_RESIST_CRITICAL:
+		case POINT_PENETRATE_PCT:
+		case POINT_RESIST_PENETRATE:
+		case POINT_CURSE_PCT:
+		case POINT_STEAL_HP:
+		case POINT_STEAL_SP:
+		case POINT_MANA_BURN_PCT:
+		case POINT_DAMAGE_SP_RECOVER:
+		case POINT_RESIST_NORMAL_DAMAGE:
+		case POINT_RESIST_SWORD:
+		case POINT_RESIST_TWOHAND:
+		case POINT_RESIST_DAGGER:
+		case POINT_RESIST_BELL:
+		case POINT_RESIST_FAN:
+		case POINT_RESIST_BOW:
+		case POINT_RESIST_FIRE:
+		case POINT_RESIST_ELEC:
+		case POINT_RESIST_MAGIC:
+		case POINT_RESIST_WIND:
+		case POINT_RESIST_ICE:
+		case POINT_RESIST_EARTH:
+		case POINT_RESIST_DARK:
+		case POINT_REFLECT_MELEE:
+		case POINT_REFLECT_CURSE:
+		case POINT_POISON_REDUCE:
+		case POINT_KILL_SP_RECOVER:
+		case POINT_KILL_HP_RECOVERY:
+		case POINT_HIT_HP_RECOVERY:
+		case POINT_HIT_SP_RECOVERY:
+		case POINT_MANASHIELD:
+		case POINT_ATT_BONUS:
+		case POINT_DEF_BONUS:
+		case POINT_SKILL_DAMAGE_BONUS:
+		case POINT_NORMAL_HIT_DAMAGE_BONUS:
+		case POINT_SKILL_DEFEND_BONUS:
+		case POINT_NORMAL_HIT_DEFEND_BONUS:
+		case POINT_RESIST_WARRIOR:
+		case POINT_RESIST_ASSASSIN:
+		case POINT_RESIST_SURA:
+		case POINT_RESIST_SHAMAN:
+			return true;
+	}
+
+	return false;
+}
+
+// ComputePoints   Ǵ affect ΰ?
+static bool CanRemoveAffectIncrementally(LPCHARACTER ch, const CAffect * pkAff)
+{
+	// а ߿ ComputePoints   ٽ ϴ  ٸǷ ״ д.
+	if (ch->IsPolymorphed())
+		return false;
+
+	//  ų  ߿ Ƿ       .
+	if (pkAff->dwType >= GUILD_SKILL_START && pkAff->dwType <= GUILD_SKILL_END)
+		return false;
+
+	if (!IsIndependentAffectPoint(pkAff->bApplyOn))
+		return false;
+
+	//  flag   affect    ComputeAffect   flag  RefreshAffect  ٽ Ѿ Ѵ.
+	if (pkAff->dwFlag)
+	{
+		const std::vector<CAffect *> & rVec = ch->GetAffectContainer();
+
+		for (itertype(rVec) it = rVec.begin(); it != rVec.end(); ++it)
+		{
+			if ((*it)->dwFlag == pkAff->dwFlag)
+				return false;
+		}
+	}
+
+	return true;
+}
+
+// compute_points_check: κ   ComputePoints   ȮѴ.
+static void CheckIncrementalPoints(LPCHARACTER ch, const CAffect * pkAff)
+{
+	long alPoints[POINT_MAX_NUM];
+
+	for (int i = 0; i < POINT_MAX_NUM; ++i)
+		alPoints[i] = ch->GetPoint(i);
+
+	ch->ComputePoints();
+
+	for (int i = 0; i < POINT_MAX_NUM; ++i)
+	{
+		if (alPoints[i] != ch->GetPoint(i))
+			sys_err("COMPUTE_POINTS_MISMATCH: %s affect %u apply %u point %d incremental %ld full %ld",
+					ch->GetName(), pkAff->dwType, pkAff->bApplyOn, i, alPoints[i], (long) ch->GetPoint(i));
+	}
+}
+
 bool CHARACTER::RemoveAffect(CAffect * pkAff)
 {
 	if (!pkAff)
 		return false;
 
 	// AFFECT_BUF_FIX
-	m_list_pkAffect.remove(pkAff);
+	m_vec_pkAffect.erase(std::remove(m_vec_pkAffect.begin(), m_vec_pkAffect.end(), pkAff), m_vec_pkAffect.end());
 	// END_OF_AFFECT_BUF_FIX
 
+	RebuildAffectTypeMask();
+
 	ComputeAffect(pkAff, false);
 
 	//   .
@@ -686,9 +823,20 @@ bool CHARACTER::RemoveAffect(CAffect * pkAff)
 	//  AFFECT_REVIVE_INVISIBLE RemoveAffect Ǵ 츸 Ѵ.
 	// ð  Ǿ  ȿ Ǯ  װ ߻ Ƿ ׿ Ȱ .
 	//		(ProcessAffect  ð  Ǿ Affect Ǵ , ComputePoints θ ʴ´.)
+	//
+	// ٸ Ʈ   affect   ComputeAffect  ϴ.
+	//   ٲ RemoveAffect  ComputePoints  ϴ  ũ.
 	if (AFFECT_REVIVE_INVISIBLE != pkAff->dwType)
 	{
-		ComputePoints();
+		if (CanRemoveAffectIncrementally(this, pkAff))
+		{
+			if (g_bComputePointsCheck)
+				CheckIncrementalPoints(this, pkAff);
+			else
+				UpdatePacket();
+		}
+		else
+			ComputePoints();
 	}
 	CheckMaximumPoints();
 
@@ -726,6 +874,14 @@ bool CHARACTER::RemoveAffect(DWORD dwType)
 	return flag;
 }
 
+void CHARACTER::RebuildAffectTypeMask()
+{
+	m_kAffectTypeMask.Clear();
+
+	for (itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin(); it != m_vec_pkAffect.end(); ++it)
+		m_kAffectTypeMask.Set((*it)->dwType);
+}
+
 bool CHARACTER::IsAffectFlag(DWORD dwAff) const
 {
 	return m_afAffectFlag.IsSet(dwAff);
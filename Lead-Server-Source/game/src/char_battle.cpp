@@ -1389,9 +1389,9 @@ void CHARACTER::Dead(LPCHARACTER pkKiller, bool bImmediateDead)
 		//
 		// Ŭ̾Ʈ Ʈ Ŷ ٽ .
 		//
-		itertype(m_list_pkAffect) it = m_list_pkAffect.begin();
+		itertype(m_vec_pkAffect) it = m_vec_pkAffect.begin();
 
-		while (it != m_list_pkAffect.end())
+		while (it != m_vec_pkAffect.end())
 			SendAffectAddPacket(GetDesc(), *it++);
 	}
 
@@ -2346,65 +2346,54 @@ static void GiveExp(LPCHARACTER from, LPCHARACTER to, int iExp)
 
 namespace NPartyExpDistribute
 {
-	struct FPartyTotaler
+	//   Ƽ  ġ     д. հ й踦   ʴ´.
+	struct FPartyCollector
 	{
+		LPCHARACTER	members[PARTY_MAX_MEMBER];
 		int		total;
 		int		member_count;
 		int		x, y;
 
-		FPartyTotaler(LPCHARACTER center)
+		FPartyCollector(LPCHARACTER center)
 			: total(0), member_count(0), x(center->GetX()), y(center->GetY())
 		{};
 
 		void operator () (LPCHARACTER ch)
 		{
+			if (member_count >= PARTY_MAX_MEMBER)
+				return;
+
 			if (DISTANCE_APPROX(ch->GetX() - x, ch->GetY() - y) <= PARTY_DEFAULT_RANGE)
 			{
 				total += party_exp_distribute_table[ch->GetLevel()];
 
-				++member_count;
+				members[member_count++] = ch;
 			}
 		}
-	};
-
-	struct FPartyDistributor
-	{
-		int		total;
-		LPCHARACTER	c;
-		int		x, y;
-		DWORD		_iExp;
-		int		m_iMode;
-		int		m_iMemberCount;
-
-		FPartyDistributor(LPCHARACTER center, int member_count, int total, DWORD iExp, int iMode) 
-			: total(total), c(center), x(center->GetX()), y(center->GetY()), _iExp(iExp), m_iMode(iMode), m_iMemberCount(member_count)
-			{
-				if (m_iMemberCount == 0)
-					m_iMemberCount = 1;
-			};
 
-		void operator () (LPCHARACTER ch)
+		void Distribute(LPCHARACTER center, DWORD iExp, int iMode)
 		{
-			if (DISTANCE_APPROX(ch->GetX() - x, ch->GetY() - y) <= PARTY_DEFAULT_RANGE)
+			for (int i = 0; i < member_count; ++i)
 			{
+				LPCHARACTER ch = members[i];
 				DWORD iExp2 = 0;
 
-				switch (m_iMode)
+				switch (iMode)
 				{
 					case PARTY_EXP_DISTRIBUTION_NON_PARITY:
-						iExp2 = (DWORD) (_iExp * (float) party_exp_distribute_table[ch->GetLevel()] / total);
+						iExp2 = (DWORD) (iExp * (float) party_exp_distribute_table[ch->GetLevel()] / total);
 						break;
 
 					case PARTY_EXP_DISTRIBUTION_PARITY:
-						iExp2 = _iExp / m_iMemberCount;
+						iExp2 = iExp / member_count;
 						break;
 
 					default:
-						sys_err("Unknown party exp distribution mode %d", m_iMode);
+						sys_err("Unknown party exp distribution mode %d", iMode);
 						return;
 				}
 
-				GiveExp(c, ch, iExp2);
+				GiveExp(center, ch, iExp2);
 			}
 		}
 	};
@@ -2428,7 +2417,7 @@ typedef struct SDamageInfo
 			GiveExp(ch, pAttacker, iExp);
 		else if (pParty)
 		{
-			NPartyExpDistribute::FPartyTotaler f(ch);
+			NPartyExpDistribute::FPartyCollector f(ch);
 			pParty->ForEachOnlineMember(f);
 
 			if (pParty->IsPositionNearLeader(ch))
@@ -2454,8 +2443,7 @@ typedef struct SDamageInfo
 				}
 			}
 
-			NPartyExpDistribute::FPartyDistributor fDist(ch, f.member_count, f.total, iExp, pParty->GetExpDistributionMode());
-			pParty->ForEachOnlineMember(fDist);
+			f.Distribute(ch, iExp, pParty->GetExpDistributionMode());
 		}
 	}
 } TDamageInfo;
@@ -2473,7 +2461,9 @@ LPCHARACTER CHARACTER::DistributeExp()
 
 	typedef std::vector<TDamageInfo> TDamageInfoTable;
 	TDamageInfoTable damage_info_table;
-	std::map<LPPARTY, TDamageInfo> map_party_damage;
+
+	//     Ƽ     ǹǷ map   ã´.
+	TDamageInfoTable party_damage_table;
 
 	damage_info_table.reserve(m_map_kDamage.size());
 
@@ -2500,20 +2490,26 @@ LPCHARACTER CHARACTER::DistributeExp()
 			iMostDam = iDam;
 		}
 
-		if (pAttacker->GetParty())
+		LPPARTY pParty = pAttacker->GetParty();
+
+		if (pParty)
 		{
-			std::map<LPPARTY, TDamageInfo>::iterator it = map_party_damage.find(pAttacker->GetParty());
-			if (it == map_party_damage.end())
+			TDamageInfoTable::iterator itParty = party_damage_table.begin();
+
+			while (itParty != party_damage_table.end() && itParty->pParty != pParty)
+				++itParty;
+
+			if (itParty != party_damage_table.end())
 			{
-				TDamageInfo di;
-				di.iDam = iDam;
-				di.pAttacker = NULL;
-				di.pParty = pAttacker->GetParty();
-				map_party_damage.insert(std::make_pair(di.pParty, di));
+				itParty->iDam += iDam;
 			}
 			else
 			{
-				it->second.iDam += iDam;
+				TDamageInfo di;
+				di.iDam = iDam;
+				di.pAttacker = NULL;
+				di.pParty = pParty;
+				party_damage_table.push_back(di);
 			}
 		}
 		else
@@ -2530,11 +2526,7 @@ LPCHARACTER CHARACTER::DistributeExp()
 		}
 	}
 
-	for (std::map<LPPARTY, TDamageInfo>::iterator it = map_party_damage.begin(); it != map_party_damage.end(); ++it)
-	{
-		damage_info_table.push_back(it->second);
-		//sys_log(0, "__ pq_damage_party [%u] %d", it->second.pParty->GetLeaderPID(), it->second.iDam);
-	}
+	damage_info_table.insert(damage_info_table.end(), party_damage_table.begin(), party_damage_table.end());
 
 	SetExp(0);
 	//m_map_kDamage.clear();
@@ -2684,9 +2676,9 @@ class CFuncShoot
 				if (g_bSkillDisable)
 					return;
 
-				m_me->m_SkillUseInfo[m_bType].SetMainTargetVID(dwTargetVID);
+				m_me->GetSkillUseInfo(m_bType).SetMainTargetVID(dwTargetVID);
 				/*if (m_bType == SKILL_BIPABU || m_bType == SKILL_KWANKYEOK)
-				  m_me->m_SkillUseInfo[m_bType].ResetHitCount();*/
+				  m_me->GetSkillUseInfo(m_bType).ResetHitCount();*/
 			}
 
 			LPCHARACTER pkVictim = CHARACTER_MANAGER::instance().Find(dwTargetVID);
@@ -3316,7 +3308,7 @@ void CHARACTER::ForgetMyAttacker()
 	if (pSec)
 	{
 		FuncForgetMyAttacker f(this);
-		pSec->ForEachAround(f);
+		pSec->ForEachAroundKind(SPATIAL_KIND_NPC, f);
 	}
 	ReviveInvisible(5);
 }
@@ -3327,7 +3319,7 @@ void CHARACTER::AggregateMonster()
 	if (pSec)
 	{
 		FuncAggregateMonster f(this);
-		pSec->ForEachAround(f);
+		pSec->ForEachAroundKind(SPATIAL_KIND_NPC, f);
 	}
 }
 
@@ -3337,7 +3329,7 @@ void CHARACTER::AttractRanger()
 	if (pSec)
 	{
 		FuncAttractRanger f(this);
-		pSec->ForEachAround(f);
+		pSec->ForEachAroundKind(SPATIAL_KIND_NPC, f);
 	}
 }
 
@@ -3347,7 +3339,7 @@ void CHARACTER::PullMonster()
 	if (pSec)
 	{
 		FuncPullMonster f(this);
-		pSec->ForEachAround(f);
+		pSec->ForEachAroundKind(SPATIAL_KIND_NPC, f);
 	}
 }
 
@@ -200,6 +200,8 @@ void CHARACTER::HorseSummon(bool bSummon, bool bFromFar, DWORD dwVnum, const cha
 			m_chHorse->m_stName += LC_TEXT("'s Horse");
 		}
 
+		m_chHorse->InvalidateInsertPacketCache();
+
 		if (!m_chHorse->Show(GetMapIndex(), x, y, GetZ()))
 		{
 			M2_DESTROY_CHARACTER(m_chHorse);
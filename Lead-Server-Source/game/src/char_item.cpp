@@ -49,6 +49,7 @@ const DWORD CHARACTER::msc_dwDefaultChangeItemAttrCycle = 10;
 const char CHARACTER::msc_szLastChangeItemAttrFlag[] = "Item.LastChangeItemAttr";
 const char CHARACTER::msc_szChangeItemAttrCycleFlag[] = "change_itemattr_cycle";
 // END_OF_CHANGE_ITEM_ATTRIBUTES
+const CHARACTER_POINT_PC CHARACTER::msc_kEmptyPCPoints = CHARACTER_POINT_PC();
 const BYTE g_aBuffOnAttrPoints[] = { POINT_ENERGY, POINT_COSTUME_ATTR_BONUS };
 
 struct FFindStone
@@ -238,14 +239,14 @@ LPITEM CHARACTER::GetItem(TItemPos Cell) const
 			sys_err("CHARACTER::GetInventoryItem: invalid item cell %d", wCell);
 			return NULL;
 		}
-		return m_pointsInstant.pItems[wCell];
+		return GetPCPoints().pItems[wCell];
 	case DRAGON_SOUL_INVENTORY:
 		if (wCell >= DRAGON_SOUL_INVENTORY_MAX_NUM)
 		{
 			sys_err("CHARACTER::GetInventoryItem: invalid DS item cell %d", wCell);
 			return NULL;
 		}
-		return m_pointsInstant.pDSItems[wCell];
+		return GetPCPoints().pDSItems[wCell];
 
 	default:
 		return NULL;
@@ -269,6 +270,13 @@ void CHARACTER::SetItem(TItemPos Cell, LPITEM pItem)
 		assert(!"GetOwner exist");
 		return;
 	}
+
+	//  ĭ   ͵ 
+	if (!m_pPCPoints && !pItem)
+		return;
+
+	AllocPCPoints();
+
 	// ⺻ κ丮
 	switch(window_type)
 	{
@@ -281,7 +289,7 @@ void CHARACTER::SetItem(TItemPos Cell, LPITEM pItem)
 				return;
 			}
 
-			LPITEM pOld = m_pointsInstant.pItems[wCell];
+			LPITEM pOld = m_pPCPoints->pItems[wCell];
 
 			if (pOld)
 			{
@@ -294,14 +302,29 @@ void CHARACTER::SetItem(TItemPos Cell, LPITEM pItem)
 						if (p >= INVENTORY_MAX_NUM)
 							continue;
 
-						if (m_pointsInstant.pItems[p] && m_pointsInstant.pItems[p] != pOld)
+						if (m_pPCPoints->pItems[p] && m_pPCPoints->pItems[p] != pOld)
 							continue;
 
-						m_pointsInstant.bItemGrid[p] = 0;
+						m_pPCPoints->bItemGrid[p] = 0;
+						m_pPCPoints->aqwItemGridMask[p / INVENTORY_SLOT_PER_PAGE] &= ~(1ULL << (p % INVENTORY_SLOT_PER_PAGE));
+					}
+
+					itertype(m_map_inventoryCellByVnum) it = m_map_inventoryCellByVnum.find(pOld->GetVnum());
+
+					if (it != m_map_inventoryCellByVnum.end())
+					{
+						std::vector<BYTE> & rvec_bCell = it->second;
+						std::vector<BYTE>::iterator itCell = std::lower_bound(rvec_bCell.begin(), rvec_bCell.end(), (BYTE) wCell);
+
+						if (itCell != rvec_bCell.end() && *itCell == wCell)
+							rvec_bCell.erase(itCell);
+
+						if (rvec_bCell.empty())
+							m_map_inventoryCellByVnum.erase(it);
 					}
 				}
 				else
-					m_pointsInstant.bItemGrid[wCell] = 0;
+					m_pPCPoints->bItemGrid[wCell] = 0;
 			}
 
 			if (pItem)
@@ -317,20 +340,27 @@ void CHARACTER::SetItem(TItemPos Cell, LPITEM pItem)
 
 						// wCell + 1  ϴ   üũ  
 						//  óϱ 
-						m_pointsInstant.bItemGrid[p] = wCell + 1;
+						m_pPCPoints->bItemGrid[p] = wCell + 1;
+						m_pPCPoints->aqwItemGridMask[p / INVENTORY_SLOT_PER_PAGE] |= (1ULL << (p % INVENTORY_SLOT_PER_PAGE));
 					}
+
+					std::vector<BYTE> & rvec_bCell = m_map_inventoryCellByVnum[pItem->GetVnum()];
+					std::vector<BYTE>::iterator itCell = std::lower_bound(rvec_bCell.begin(), rvec_bCell.end(), (BYTE) wCell);
+
+					if (itCell == rvec_bCell.end() || *itCell != wCell)
+						rvec_bCell.insert(itCell, (BYTE) wCell);
 				}
 				else
-					m_pointsInstant.bItemGrid[wCell] = wCell + 1;
+					m_pPCPoints->bItemGrid[wCell] = wCell + 1;
 			}
 
-			m_pointsInstant.pItems[wCell] = pItem;
+			m_pPCPoints->pItems[wCell] = pItem;
 		}
 		break;
 	// ȥ κ丮
 	case DRAGON_SOUL_INVENTORY:
 		{
-			LPITEM pOld = m_pointsInstant.pDSItems[wCell];
+			LPITEM pOld = m_pPCPoints->pDSItems[wCell];
 
 			if (pOld)
 			{
@@ -343,14 +373,15 @@ void CHARACTER::SetItem(TItemPos Cell, LPITEM pItem)
 						if (p >= DRAGON_SOUL_INVENTORY_MAX_NUM)
 							continue;
 
-						if (m_pointsInstant.pDSItems[p] && m_pointsInstant.pDSItems[p] != pOld)
+						if (m_pPCPoints->pDSItems[p] && m_pPCPoints->pDSItems[p] != pOld)
 							continue;
 
-						m_pointsInstant.wDSItemGrid[p] = 0;
+						m_pPCPoints->wDSItemGrid[p] = 0;
+						m_pPCPoints->adwDSItemGridMask[p / DRAGON_SOUL_BOX_SIZE] &= ~(1U << (p % DRAGON_SOUL_BOX_SIZE));
 					}
 				}
 				else
-					m_pointsInstant.wDSItemGrid[wCell] = 0;
+					m_pPCPoints->wDSItemGrid[wCell] = 0;
 			}
 
 			if (pItem)
@@ -372,14 +403,15 @@ void CHARACTER::SetItem(TItemPos Cell, LPITEM pItem)
 
 						// wCell + 1  ϴ   üũ  
 						//  óϱ 
-						m_pointsInstant.wDSItemGrid[p] = wCell + 1;
+						m_pPCPoints->wDSItemGrid[p] = wCell + 1;
+						m_pPCPoints->adwDSItemGridMask[p / DRAGON_SOUL_BOX_SIZE] |= (1U << (p % DRAGON_SOUL_BOX_SIZE));
 					}
 				}
 				else
-					m_pointsInstant.wDSItemGrid[wCell] = wCell + 1;
+					m_pPCPoints->wDSItemGrid[wCell] = wCell + 1;
 			}
 
-			m_pointsInstant.pDSItems[wCell] = pItem;
+			m_pPCPoints->pDSItems[wCell] = pItem;
 		}
 		break;
 	default:
@@ -451,7 +483,7 @@ LPITEM CHARACTER::GetWear(BYTE bCell) const
 		return NULL;
 	}
 
-	return m_pointsInstant.pItems[INVENTORY_MAX_NUM + bCell];
+	return GetPCPoints().pItems[INVENTORY_MAX_NUM + bCell];
 }
 
 void CHARACTER::SetWear(BYTE bCell, LPITEM item)
@@ -529,9 +561,9 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 				if (false == CBeltInventoryHelper::IsAvailableCell(bCell - BELT_INVENTORY_SLOT_START, beltItem->GetValue(0)))
 					return false;
 
-				if (m_pointsInstant.bItemGrid[bCell])
+				if (GetPCPoints().bItemGrid[bCell])
 				{
-					if (m_pointsInstant.bItemGrid[bCell] == iExceptionCell)
+					if (GetPCPoints().bItemGrid[bCell] == iExceptionCell)
 						return true;
 
 					return false;
@@ -544,9 +576,9 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 			else if (bCell >= INVENTORY_MAX_NUM)
 				return false;
 
-			if (m_pointsInstant.bItemGrid[bCell])
+			if (GetPCPoints().bItemGrid[bCell])
 			{
-				if (m_pointsInstant.bItemGrid[bCell] == iExceptionCell)
+				if (GetPCPoints().bItemGrid[bCell] == iExceptionCell)
 				{
 					if (bSize == 1)
 						return true;
@@ -564,8 +596,8 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 						if (p / (INVENTORY_MAX_NUM / INVENTORY_PAGE_COUNT) != bPage)
 							return false;
 
-						if (m_pointsInstant.bItemGrid[p])
-							if (m_pointsInstant.bItemGrid[p] != iExceptionCell)
+						if (GetPCPoints().bItemGrid[p])
+							if (GetPCPoints().bItemGrid[p] != iExceptionCell)
 								return false;
 					}
 					while (++j < bSize);
@@ -594,8 +626,8 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 					if (p / (INVENTORY_MAX_NUM / INVENTORY_PAGE_COUNT) != bPage)
 						return false;
 
-					if (m_pointsInstant.bItemGrid[p])
-						if (m_pointsInstant.bItemGrid[p] != iExceptionCell)
+					if (GetPCPoints().bItemGrid[p])
+						if (GetPCPoints().bItemGrid[p] != iExceptionCell)
 							return false;
 				}
 				while (++j < bSize);
@@ -614,9 +646,9 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 			//  iExceptionCell 1  Ѵ.
 			iExceptionCell++;
 
-			if (m_pointsInstant.wDSItemGrid[wCell])
+			if (GetPCPoints().wDSItemGrid[wCell])
 			{
-				if (m_pointsInstant.wDSItemGrid[wCell] == iExceptionCell)
+				if (GetPCPoints().wDSItemGrid[wCell] == iExceptionCell)
 				{
 					if (bSize == 1)
 						return true;
@@ -630,8 +662,8 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 						if (p >= DRAGON_SOUL_INVENTORY_MAX_NUM)
 							return false;
 
-						if (m_pointsInstant.wDSItemGrid[p])
-							if (m_pointsInstant.wDSItemGrid[p] != iExceptionCell)
+						if (GetPCPoints().wDSItemGrid[p])
+							if (GetPCPoints().wDSItemGrid[p] != iExceptionCell)
 								return false;
 					}
 					while (++j < bSize);
@@ -656,8 +688,8 @@ bool CHARACTER::IsEmptyItemGrid(TItemPos Cell, BYTE bSize, int iExceptionCell) c
 					if (p >= DRAGON_SOUL_INVENTORY_MAX_NUM)
 						return false;
 
-					if (m_pointsInstant.bItemGrid[p])
-						if (m_pointsInstant.wDSItemGrid[p] != iExceptionCell)
+					if (GetPCPoints().bItemGrid[p])
+						if (GetPCPoints().wDSItemGrid[p] != iExceptionCell)
 							return false;
 				}
 				while (++j < bSize);
@@ -672,12 +704,58 @@ int CHARACTER::GetEmptyInventory(BYTE size) const
 {
 	// NOTE:   Լ  , ȹ     κ丮  ĭ ã  ǰ ִµ,
 	//		Ʈ κ丮 Ư κ丮̹Ƿ ˻ ʵ Ѵ. (⺻ κ丮: INVENTORY_MAX_NUM  ˻)
-	for ( int i = 0; i < INVENTORY_MAX_NUM; ++i)
-		if (IsEmptyItemGrid(TItemPos (INVENTORY, i), size))
-			return i;
+	//		 ĭ ˻ bItemGrid  ĭ     Ʈ Ѵ.
+	return FindInventoryGridBlank(GetPCPoints().aqwItemGridMask, size);
+}
+
+int CHARACTER::FindInventoryGridBlank(const uint64_t * pqwGridMask, BYTE bSize)
+{
+	const uint64_t qwPageMask = (1ULL << INVENTORY_SLOT_PER_PAGE) - 1;
+
+	for (int iPage = 0; iPage < INVENTORY_PAGE_COUNT; ++iPage)
+	{
+		uint64_t qwFree = ~pqwGridMask[iPage] & qwPageMask;
+
+		// Ʈ i   i, i + 5, ...  bSize ĭ  ִ.
+		//   Ʈ 0 ̹Ƿ Ʒ ġ ڸ ڿ .
+		uint64_t qwFit = qwFree;
+
+		for (int j = 1; j < bSize && qwFit; ++j)
+			qwFit &= qwFree >> (INVENTORY_SLOT_WIDTH * j);
+
+		if (!qwFit)
+			continue;
+
+		int iPos = 0;
+
+		while (!(qwFit & 1))
+		{
+			qwFit >>= 1;
+			++iPos;
+		}
+
+		return iPage * INVENTORY_SLOT_PER_PAGE + iPos;
+	}
+
 	return -1;
 }
 
+void CHARACTER::PutInventoryGridMask(uint64_t * pqwGridMask, int iCell, BYTE bSize)
+{
+	if (iCell < 0 || iCell >= INVENTORY_MAX_NUM)
+		return;
+
+	for (int j = 0; j < bSize; ++j)
+	{
+		int p = iCell + (INVENTORY_SLOT_WIDTH * j);
+
+		if (p >= INVENTORY_MAX_NUM)
+			break;
+
+		pqwGridMask[p / INVENTORY_SLOT_PER_PAGE] |= (1ULL << (p % INVENTORY_SLOT_PER_PAGE));
+	}
+}
+
 int CHARACTER::GetEmptyDragonSoulInventory(LPITEM pItem) const
 {
 	if (NULL == pItem || !pItem->IsDragonSoul())
@@ -689,30 +767,58 @@ int CHARACTER::GetEmptyDragonSoulInventory(LPITEM pItem) const
 	BYTE bSize = pItem->GetSize();
 	WORD wBaseCell = DSManager::instance().GetBasePosition(pItem);
 
-	if (WORD_MAX == wBaseCell)
+	if (WORD_MAX == wBaseCell || wBaseCell % DRAGON_SOUL_BOX_SIZE || wBaseCell >= DRAGON_SOUL_INVENTORY_MAX_NUM)
 		return -1;
 
-	for (int i = 0; i < DRAGON_SOUL_BOX_SIZE; ++i)
-		if (IsEmptyItemGrid(TItemPos(DRAGON_SOUL_INVENTORY, i + wBaseCell), bSize))
-			return i + wBaseCell;
+	//  ϳ DWORD ϳ̹Ƿ GetEmptyInventory    ã´.
+	DWORD dwFree = ~GetPCPoints().adwDSItemGridMask[wBaseCell / DRAGON_SOUL_BOX_SIZE];
+	DWORD dwFit = dwFree;
 
-	return -1;
+	for (int j = 1; j < bSize && dwFit; ++j)
+		dwFit &= dwFree >> (DRAGON_SOUL_BOX_COLUMN_NUM * j);
+
+	if (!dwFit)
+		return -1;
+
+	int iPos = 0;
+
+	while (!(dwFit & 1))
+	{
+		dwFit >>= 1;
+		++iPos;
+	}
+
+	return iPos + wBaseCell;
+}
+
+const std::vector<BYTE> * CHARACTER::GetInventoryCellsByVnum(DWORD dwVnum) const
+{
+	TR1_NS::unordered_map<DWORD, std::vector<BYTE> >::const_iterator it = m_map_inventoryCellByVnum.find(dwVnum);
+
+	if (it == m_map_inventoryCellByVnum.end())
+		return NULL;
+
+	return &it->second;
 }
 
 void CHARACTER::CopyDragonSoulItemGrid(std::vector<WORD>& vDragonSoulItemGrid) const
 {
 	vDragonSoulItemGrid.resize(DRAGON_SOUL_INVENTORY_MAX_NUM);
 
-	std::copy(m_pointsInstant.wDSItemGrid, m_pointsInstant.wDSItemGrid + DRAGON_SOUL_INVENTORY_MAX_NUM, vDragonSoulItemGrid.begin());
+	std::copy(GetPCPoints().wDSItemGrid, GetPCPoints().wDSItemGrid + DRAGON_SOUL_INVENTORY_MAX_NUM, vDragonSoulItemGrid.begin());
 }
 
 int CHARACTER::CountEmptyInventory() const
 {
 	int	count = 0;
 
-	for (int i = 0; i < INVENTORY_MAX_NUM; ++i)
-		if (GetInventoryItem(i))
-			count += GetInventoryItem(i)->GetSize();
+	for (int iPage = 0; iPage < INVENTORY_PAGE_COUNT; ++iPage)
+	{
+		uint64_t qwUsed = GetPCPoints().aqwItemGridMask[iPage];
+
+		for (; qwUsed; qwUsed &= qwUsed - 1)
+			++count;
+	}
 
 	return (INVENTORY_MAX_NUM - count);
 }
@@ -5157,7 +5263,7 @@ bool CHARACTER::DropItem(TItemPos Cell, BYTE bCount)
 	if (true == item->isLocked())
 		return false;
 
-	if (quest::CQuestManager::instance().GetPCForce(GetPlayerID())->IsRunning() == true)
+	if (quest::CQuestManager::instance().GetPCForce(this)->IsRunning() == true)
 		return false;
 
 	if (IS_SET(item->GetAntiFlag(), ITEM_ANTIFLAG_DROP | ITEM_ANTIFLAG_GIVE))
@@ -5534,10 +5640,11 @@ bool CHARACTER::PickupItem(DWORD dwVID)
 				if (item->IsStackable() && !IS_SET(item->GetAntiFlag(), ITEM_ANTIFLAG_STACK))
 				{
 					BYTE bCount = item->GetCount();
+					const std::vector<BYTE> * pvec_bCell = GetInventoryCellsByVnum(item->GetVnum());
 
-					for (int i = 0; i < INVENTORY_MAX_NUM; ++i)
+					for (size_t i = 0; pvec_bCell && i < pvec_bCell->size(); ++i)
 					{
-						LPITEM item2 = GetInventoryItem(i);
+						LPITEM item2 = GetInventoryItem((*pvec_bCell)[i]);
 
 						if (!item2)
 							continue;
@@ -6077,10 +6184,11 @@ int CHARACTER::CountSpecifyItem(DWORD vnum) const
 {
 	int	count = 0;
 	LPITEM item;
+	const std::vector<BYTE> * pvec_bCell = GetInventoryCellsByVnum(vnum);
 
-	for (int i = 0; i < INVENTORY_MAX_NUM; ++i)
+	for (size_t i = 0; pvec_bCell && i < pvec_bCell->size(); ++i)
 	{
-		item = GetInventoryItem(i);
+		item = GetInventoryItem((*pvec_bCell)[i]);
 		if (NULL != item && item->GetVnum() == vnum)
 		{
 			//   ϵ ̸ Ѿ.
@@ -6264,9 +6372,11 @@ LPITEM CHARACTER::AutoGiveItem(DWORD dwItemVnum, BYTE bCount, int iRarePct, bool
 
 	if (p->dwFlags & ITEM_FLAG_STACKABLE && p->bType != ITEM_BLEND) 
 	{
-		for (int i = 0; i < INVENTORY_MAX_NUM; ++i)
+		const std::vector<BYTE> * pvec_bCell = GetInventoryCellsByVnum(dwItemVnum);
+
+		for (size_t i = 0; pvec_bCell && i < pvec_bCell->size(); ++i)
 		{
-			LPITEM item = GetInventoryItem(i);
+			LPITEM item = GetInventoryItem((*pvec_bCell)[i]);
 
 			if (!item)
 				continue;
@@ -6305,9 +6415,11 @@ LPITEM CHARACTER::AutoGiveItem(DWORD dwItemVnum, BYTE bCount, int iRarePct, bool
 
 	if (item->GetType() == ITEM_BLEND)
 	{
-		for (int i=0; i < INVENTORY_MAX_NUM; i++)
+		const std::vector<BYTE> * pvec_bCell = GetInventoryCellsByVnum(item->GetVnum());
+
+		for (size_t i = 0; pvec_bCell && i < pvec_bCell->size(); i++)
 		{
-			LPITEM inv_item = GetInventoryItem(i);
+			LPITEM inv_item = GetInventoryItem((*pvec_bCell)[i]);
 
 			if (inv_item == NULL) continue;
 
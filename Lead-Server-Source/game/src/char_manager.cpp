@@ -20,10 +20,16 @@
 #include <boost/bind.hpp>
 #endif
 
+//  Ѱ  ĳ ¸  ִ ð
+static const DWORD WARP_HANDOFF_EXPIRE_SEC = 60;
+
 CHARACTER_MANAGER::CHARACTER_MANAGER() :
 	m_iVIDCount(0),
 	m_pkChrSelectedStone(NULL),
-	m_bUsePendingDestroy(false)
+	m_bUsePendingDestroy(false),
+	m_dwChrPoolReuse(0), m_dwChrPoolAlloc(0), m_dwChrLivePeak(0),
+	m_iSpawnBatchDepth(0),
+	m_uiPeriodicSaveCursor(0)
 {
 	RegisterRaceNum(xmas::MOB_XMAS_FIRWORK_SELLER_VNUM);
 	RegisterRaceNum(xmas::MOB_SANTA_VNUM);
@@ -77,9 +83,18 @@ LPCHARACTER CHARACTER_MANAGER::CreateCharacter(const char * name, DWORD dwPID)
 {
 	DWORD dwVID = AllocVID();
 
+	if (CHARACTER::GetFreeBlockCount())
+		++m_dwChrPoolReuse;
+	else
+		++m_dwChrPoolAlloc;
+
+	// Ǯ  ̶ ڰ Initialize   ٽ ʱȭѴ.
 	LPCHARACTER ch = M2_NEW CHARACTER;
 	ch->Create(name, dwVID, dwPID ? true : false);
 
+	if (CHARACTER::GetUsedBlockCount() > m_dwChrLivePeak)
+		m_dwChrLivePeak = CHARACTER::GetUsedBlockCount();
+
 	m_map_pkChrByVID.insert(std::make_pair(dwVID, ch));
 
 	if (dwPID)
@@ -88,6 +103,7 @@ LPCHARACTER CHARACTER_MANAGER::CreateCharacter(const char * name, DWORD dwPID)
 		str_lower(name, szName, sizeof(szName));
 
 		m_map_pkPCChr.insert(NAME_MAP::value_type(szName, ch));
+		m_list_pkPCUpdate.Add(ch);
 		m_map_pkChrByPID.insert(std::make_pair(dwPID, ch));
 	}
 
@@ -106,6 +122,14 @@ void CHARACTER_MANAGER::DestroyCharacter(LPCHARACTER ch)
 		return; // prevent duplicated destrunction
 	}
 
+	if (!m_vec_pkSpawnBatch.empty())
+	{
+		CHARACTER_VECTOR::iterator it_batch = std::find(m_vec_pkSpawnBatch.begin(), m_vec_pkSpawnBatch.end(), ch);
+
+		if (it_batch != m_vec_pkSpawnBatch.end())
+			m_vec_pkSpawnBatch.erase(it_batch);
+	}
+
 	//  Ҽӵ ʹ  ϵ.
 	if (ch->IsNPC() && !ch->IsPet() && ch->GetRider() == NULL)
 	{
@@ -125,14 +149,12 @@ void CHARACTER_MANAGER::DestroyCharacter(LPCHARACTER ch)
 
 	if (true == ch->IsPC())
 	{
-		char szName[CHARACTER_NAME_MAX_LEN + 1];
-
-		str_lower(ch->GetName(), szName, sizeof(szName));
-
-		NAME_MAP::iterator it = m_map_pkPCChr.find(szName);
+		NAME_MAP::iterator it = m_map_pkPCChr.find(GetNameKey(ch->GetName()));
 
 		if (m_map_pkPCChr.end() != it)
 			m_map_pkPCChr.erase(it);
+
+		m_list_pkPCUpdate.Remove(ch);
 	}
 
 	if (0 != ch->GetPlayerID())
@@ -152,6 +174,17 @@ void CHARACTER_MANAGER::DestroyCharacter(LPCHARACTER ch)
 	M2_DELETE(ch);
 }
 
+void CHARACTER_MANAGER::DumpCharacterPoolStat()
+{
+	sys_log(0, "CHARACTER_POOL: live %u peak %u free %u reuse %u alloc %u size %u vid_map %u",
+			(DWORD) CHARACTER::GetUsedBlockCount(), m_dwChrLivePeak, (DWORD) CHARACTER::GetFreeBlockCount(),
+			m_dwChrPoolReuse, m_dwChrPoolAlloc, (DWORD) sizeof(CHARACTER), (DWORD) m_map_pkChrByVID.size());
+
+	m_dwChrPoolReuse = 0;
+	m_dwChrPoolAlloc = 0;
+	m_dwChrLivePeak = CHARACTER::GetUsedBlockCount();
+}
+
 LPCHARACTER CHARACTER_MANAGER::Find(DWORD dwVID)
 {
 	itertype(m_map_pkChrByVID) it = m_map_pkChrByVID.find(dwVID);
@@ -194,18 +227,27 @@ LPCHARACTER CHARACTER_MANAGER::FindByPID(DWORD dwPID)
 	return found;
 }
 
-LPCHARACTER CHARACTER_MANAGER::FindPC(const char * name)
+const std::string & CHARACTER_MANAGER::GetNameKey(const char * c_pszName)
 {
 	char szName[CHARACTER_NAME_MAX_LEN + 1];
-	str_lower(name, szName, sizeof(szName));
-	NAME_MAP::iterator it = m_map_pkPCChr.find(szName);
+	str_lower(c_pszName, szName, sizeof(szName));
+
+	//  ۿ Ƿ capacity  ϸ Ҵ Ͼ ʴ´
+	m_stNameKey.assign(szName);
+	return m_stNameKey;
+}
+
+LPCHARACTER CHARACTER_MANAGER::FindPC(const char * name)
+{
+	const std::string & c_rstKey = GetNameKey(name);
+	NAME_MAP::iterator it = m_map_pkPCChr.find(c_rstKey);
 
 	if (it == m_map_pkPCChr.end())
 		return NULL;
 
 	// <Factor> Added sanity check
 	LPCHARACTER found = it->second;
-	if (found != NULL && strncasecmp(szName, found->GetName(), CHARACTER_NAME_MAX_LEN) != 0) {
+	if (found != NULL && strncasecmp(c_rstKey.c_str(), found->GetName(), CHARACTER_NAME_MAX_LEN) != 0) {
 		sys_err("[CHARACTER_MANAGER::FindPC] <Factor> %s != %s", name, found->GetName());
 		return NULL;
 	}
@@ -262,7 +304,18 @@ LPCHARACTER CHARACTER_MANAGER::SpawnMobRandomPosition(DWORD dwVnum, long lMapInd
 
 	int i;
 	long x, y;
-	for (i=0; i<2000; i++)
+	bool bFound = false;
+
+	//   ִ  ٷ ̰, Ӽ ٲ  ɸ ó ã´.
+	if (pkSectreeMap->GetRandomWalkablePosition(SECTREE_MAP::WALKABLE_SPAWN, x, y))
+	{
+		LPSECTREE tree = pkSectreeMap->Find(x, y);
+
+		if (tree && !IS_SET(tree->GetAttribute(x, y), ATTR_BLOCK | ATTR_OBJECT | ATTR_BANPK))
+			bFound = true;
+	}
+
+	for (i=0; !bFound && i<2000; i++)
 	{
 		x = number(1, (pkSectreeMap->m_setting.iWidth / 100)  - 1) * 100 + pkSectreeMap->m_setting.iBaseX;
 		y = number(1, (pkSectreeMap->m_setting.iHeight / 100) - 1) * 100 + pkSectreeMap->m_setting.iBaseY;
@@ -280,10 +333,11 @@ LPCHARACTER CHARACTER_MANAGER::SpawnMobRandomPosition(DWORD dwVnum, long lMapInd
 		if (IS_SET(dwAttr, ATTR_BANPK))
 			continue;
 
+		bFound = true;
 		break;
 	}
 
-	if (i == 2000)
+	if (!bFound)
 	{
 		sys_err("cannot find valid location");
 		return NULL;
@@ -415,16 +469,50 @@ LPCHARACTER CHARACTER_MANAGER::SpawnMob(DWORD dwVnum, long lMapIndex, long x, lo
 
 	ch->SetRotation(iRot);
 
-	if (bShow && !ch->Show(lMapIndex, x, y, z, bSpawnMotion))
+	bool bDeferView = m_iSpawnBatchDepth > 0;
+
+	if (bShow && !ch->Show(lMapIndex, x, y, z, bSpawnMotion, bDeferView))
 	{
 		M2_DESTROY_CHARACTER(ch);
 		sys_log(0, "SpawnMob: cannot show monster");
 		return NULL;
 	}
 
+	if (bShow && bDeferView)
+		m_vec_pkSpawnBatch.push_back(ch);
+
 	return (ch);
 }
 
+void CHARACTER_MANAGER::BeginSpawnBatch()
+{
+	++m_iSpawnBatchDepth;
+}
+
+void CHARACTER_MANAGER::EndSpawnBatch()
+{
+	if (m_iSpawnBatchDepth <= 0)
+	{
+		sys_err("EndSpawnBatch without BeginSpawnBatch");
+		return;
+	}
+
+	if (--m_iSpawnBatchDepth > 0)
+		return;
+
+	if (m_vec_pkSpawnBatch.empty())
+		return;
+
+	std::vector<LPENTITY> vec_pkEnt(m_vec_pkSpawnBatch.begin(), m_vec_pkSpawnBatch.end());
+	CHARACTER_VECTOR vec_pkChr;
+	vec_pkChr.swap(m_vec_pkSpawnBatch);
+
+	CEntity::UpdateSectreeBulk(vec_pkEnt);
+
+	for (size_t i = 0; i < vec_pkChr.size(); ++i)
+		vec_pkChr[i]->ClearSpawnState();
+}
+
 LPCHARACTER CHARACTER_MANAGER::SpawnMobRange(DWORD dwVnum, long lMapIndex, int sx, int sy, int ex, int ey, bool bIsException, bool bSpawnMotion, bool bAggressive )
 {
 	const CMob * pkMob = CMobManager::instance().Get(dwVnum);
@@ -574,6 +662,9 @@ LPCHARACTER CHARACTER_MANAGER::SpawnGroup(DWORD dwVnum, long lMapIndex, int sx,
 
 	LPCHARACTER chLeader = NULL;
 
+	//  ü Ʈ   þ߸ Ѳ 
+	BeginSpawnBatch();
+
 	for (DWORD i = 0; i < c_rdwMembers.size(); ++i)
 	{
 		LPCHARACTER tch = SpawnMobRange(c_rdwMembers[i], lMapIndex, sx, sy, ex, ey, true, bSpawnedByStone);
@@ -581,7 +672,10 @@ LPCHARACTER CHARACTER_MANAGER::SpawnGroup(DWORD dwVnum, long lMapIndex, int sx,
 		if (!tch)
 		{
 			if (i == 0)	//  Ͱ  쿡 ׳ 
+			{
+				EndSpawnBatch();
 				return NULL;
+			}
 
 			continue;
 		}
@@ -615,6 +709,8 @@ LPCHARACTER CHARACTER_MANAGER::SpawnGroup(DWORD dwVnum, long lMapIndex, int sx,
 			tch->SetAggressive();
 	}
 
+	EndSpawnBatch();
+
 	return chLeader;
 }
 
@@ -638,26 +734,17 @@ void CHARACTER_MANAGER::Update(int iPulse)
 
 	// PC ĳ Ʈ
 	{
-		if (!m_map_pkPCChr.empty())
+		if (!m_list_pkPCUpdate.empty())
 		{
-			// ̳ 
-			CHARACTER_VECTOR v;
-			v.reserve(m_map_pkPCChr.size());
-#ifdef __GNUC__
-			transform(m_map_pkPCChr.begin(), m_map_pkPCChr.end(), back_inserter(v), select2nd<NAME_MAP::value_type>());
-#else
-			transform(m_map_pkPCChr.begin(), m_map_pkPCChr.end(), back_inserter(v), boost::bind(&NAME_MAP::value_type::second, _1));
-#endif
-
 			if (0 == (iPulse % PASSES_PER_SEC(5)))
 			{
 				FuncUpdateAndResetChatCounter f;
-				for_each(v.begin(), v.end(), f);
+				m_list_pkPCUpdate.ForEach(f);
 			}
 			else
 			{
 				//for_each(v.begin(), v.end(), mem_fun(&CFSM::Update));
-				for_each(v.begin(), v.end(), std::bind(&CHARACTER::UpdateCharacter, std::placeholders::_1, iPulse));
+				m_list_pkPCUpdate.ForEach(std::bind(&CHARACTER::UpdateCharacter, std::placeholders::_1, iPulse));
 			}
 		}
 
@@ -666,17 +753,8 @@ void CHARACTER_MANAGER::Update(int iPulse)
 
 	//  Ʈ
 	{
-		if (!m_set_pkChrState.empty())
-		{
-			CHARACTER_VECTOR v;
-			v.reserve(m_set_pkChrState.size());
-#ifdef __GNUC__
-			transform(m_set_pkChrState.begin(), m_set_pkChrState.end(), back_inserter(v), identity<CHARACTER_SET::value_type>());
-#else
-			v.insert(v.end(), m_set_pkChrState.begin(), m_set_pkChrState.end());
-#endif
-			for_each(v.begin(), v.end(), std::bind(&CHARACTER::UpdateStateMachine, std::placeholders::_1, iPulse));
-		}
+		if (!m_list_pkChrState.empty())
+			m_list_pkChrState.ForEach(std::bind(&CHARACTER::UpdateStateMachine, std::placeholders::_1, iPulse));
 	}
 
 	// Ÿ  Ʈ
@@ -703,8 +781,150 @@ void CHARACTER_MANAGER::Update(int iPulse)
 	if (test_server && 0 == (iPulse % PASSES_PER_SEC(60)))
 		sys_log(0, "CHARACTER COUNT vid %zu pid %zu", m_map_pkChrByVID.size(), m_map_pkChrByPID.size());
 
+	if (0 == (iPulse % PASSES_PER_SEC(10)))
+		ExpireWarpHandoff();
+
+	ProcessPeriodicSave(iPulse);
+
 	//  DestroyCharacter ϱ
 	FlushPendingDestroy();
+
+	// Ʈ   ĳ ڸ Ѵ.
+	m_list_pkPCUpdate.Compact();
+	m_list_pkChrState.Compact();
+}
+
+void CHARACTER_MANAGER::RegisterPeriodicSave(LPCHARACTER ch)
+{
+	if (ch->m_iPeriodicSaveSlot >= 0)
+		return;
+
+	//    ó   ĭ .
+	if (m_vec_kPeriodicSaveSlot.empty())
+		m_vec_kPeriodicSaveSlot.resize(MAX(1, save_event_second_cycle));
+
+	size_t uiSlot = m_uiPeriodicSaveCursor;
+	m_uiPeriodicSaveCursor = (m_uiPeriodicSaveCursor + 1) % m_vec_kPeriodicSaveSlot.size();
+
+	m_vec_kPeriodicSaveSlot[uiSlot].push_back(ch);
+	ch->m_iPeriodicSaveSlot = uiSlot;
+}
+
+void CHARACTER_MANAGER::UnregisterPeriodicSave(LPCHARACTER ch)
+{
+	if (ch->m_iPeriodicSaveSlot < 0)
+		return;
+
+	//  ĭ    Ƿ ׳ ã´.
+	CHARACTER_VECTOR & r = m_vec_kPeriodicSaveSlot[ch->m_iPeriodicSaveSlot];
+	CHARACTER_VECTOR::iterator it = std::find(r.begin(), r.end(), ch);
+
+	if (it != r.end())
+	{
+		*it = r.back();
+		r.pop_back();
+	}
+
+	ch->m_iPeriodicSaveSlot = -1;
+}
+
+void CHARACTER_MANAGER::ProcessPeriodicSave(int iPulse)
+{
+	if (m_vec_kPeriodicSaveSlot.empty())
+		return;
+
+	const CHARACTER_VECTOR & r = m_vec_kPeriodicSaveSlot[iPulse % m_vec_kPeriodicSaveSlot.size()];
+
+	for (size_t i = 0; i < r.size(); ++i)
+		m_deque_dwPeriodicSavePending.push_back(r[i]->GetPlayerID());
+
+	int iSaved = 0;
+
+	while (!m_deque_dwPeriodicSavePending.empty())
+	{
+		if (g_iSaveMaxPerPulse > 0 && iSaved >= g_iSaveMaxPerPulse)
+			break;
+
+		DWORD dwPID = m_deque_dwPeriodicSavePending.front();
+		m_deque_dwPeriodicSavePending.pop_front();
+
+		// ٸ    ִ.
+		LPCHARACTER ch = FindByPID(dwPID);
+
+		if (!ch || ch->m_iPeriodicSaveSlot < 0)
+			continue;
+
+		sys_log(1, "SAVE_EVENT: %s", ch->GetName());
+
+		// ٲ     ĳʹ ѿ  ʴ´.
+		m_set_pkChrForDelayedSave.erase(ch);
+
+		if (ch->SaveReal())
+			++iSaved;
+
+		ch->FlushDelayedSaveItem();
+	}
+}
+
+void CHARACTER_MANAGER::AddWarpHandoff(DWORD dwLoginKey, DWORD dwPID, DWORD dwItemCount, DWORD dwQuestCount, DWORD dwAffectCount, const char * c_pData)
+{
+	TWarpHandoff & r = m_map_kWarpHandoff[dwPID];
+
+	r.dwLoginKey = dwLoginKey;
+	r.dwTime = get_dword_time();
+
+	DWORD dwItemSize = sizeof(TPlayerItem) * dwItemCount;
+	DWORD dwQuestSize = sizeof(TQuestTable) * dwQuestCount;
+	DWORD dwAffectSize = sizeof(TPacketAffectElement) * dwAffectCount;
+
+	r.vecItem.assign((const char *) &dwItemCount, (const char *) &dwItemCount + sizeof(DWORD));
+	r.vecItem.insert(r.vecItem.end(), c_pData, c_pData + dwItemSize);
+	c_pData += dwItemSize;
+
+	r.vecQuest.assign((const char *) &dwQuestCount, (const char *) &dwQuestCount + sizeof(DWORD));
+	r.vecQuest.insert(r.vecQuest.end(), c_pData, c_pData + dwQuestSize);
+	c_pData += dwQuestSize;
+
+	r.vecAffect.assign((const char *) &dwPID, (const char *) &dwPID + sizeof(DWORD));
+	r.vecAffect.insert(r.vecAffect.end(), (const char *) &dwAffectCount, (const char *) &dwAffectCount + sizeof(DWORD));
+	r.vecAffect.insert(r.vecAffect.end(), c_pData, c_pData + dwAffectSize);
+
+	sys_log(0, "WARP_HANDOFF: add key %u pid %u item %u quest %u affect %u", dwLoginKey, dwPID, dwItemCount, dwQuestCount, dwAffectCount);
+}
+
+const CHARACTER_MANAGER::TWarpHandoff * CHARACTER_MANAGER::FindWarpHandoff(DWORD dwLoginKey, DWORD dwPID)
+{
+	std::map<DWORD, TWarpHandoff>::iterator it = m_map_kWarpHandoff.find(dwPID);
+
+	if (it == m_map_kWarpHandoff.end() || it->second.dwLoginKey != dwLoginKey)
+		return NULL;
+
+	// ĳ ú DB   ʰ Ѵ.
+	it->second.dwTime = get_dword_time();
+	return &it->second;
+}
+
+void CHARACTER_MANAGER::RemoveWarpHandoff(DWORD dwPID)
+{
+	m_map_kWarpHandoff.erase(dwPID);
+}
+
+// Ѱ ް    DB  ̹ Ǿ Ƿ .
+void CHARACTER_MANAGER::ExpireWarpHandoff()
+{
+	DWORD dwNow = get_dword_time();
+	std::map<DWORD, TWarpHandoff>::iterator it = m_map_kWarpHandoff.begin();
+
+	while (it != m_map_kWarpHandoff.end())
+	{
+		if (dwNow - it->second.dwTime >= WARP_HANDOFF_EXPIRE_SEC * 1000)
+		{
+			sys_log(0, "WARP_HANDOFF: expire pid %u key %u", it->first, it->second.dwLoginKey);
+			m_map_kWarpHandoff.erase(it++);
+		}
+		else
+			++it;
+	}
 }
 
 void CHARACTER_MANAGER::ProcessDelayedSave()
@@ -724,26 +944,13 @@ bool CHARACTER_MANAGER::AddToStateList(LPCHARACTER ch)
 {
 	assert(ch != NULL);
 
-	CHARACTER_SET::iterator it = m_set_pkChrState.find(ch);
-
-	if (it == m_set_pkChrState.end())
-	{
-		m_set_pkChrState.insert(ch);
-		return true;
-	}
-
-	return false;
+	return m_list_pkChrState.Add(ch);
 }
 
 void CHARACTER_MANAGER::RemoveFromStateList(LPCHARACTER ch)
 {
-	CHARACTER_SET::iterator it = m_set_pkChrState.find(ch);
-
-	if (it != m_set_pkChrState.end())
-	{
-		//sys_log(0, "RemoveFromStateList %p", ch);
-		m_set_pkChrState.erase(it);
-	}
+	//sys_log(0, "RemoveFromStateList %p", ch);
+	m_list_pkChrState.Remove(ch);
 }
 
 void CHARACTER_MANAGER::DelayedSave(LPCHARACTER ch)
@@ -839,7 +1046,7 @@ void CHARACTER_MANAGER::UnregisterRaceNumMap(LPCHARACTER ch)
 
 bool CHARACTER_MANAGER::GetCharactersByRaceNum(DWORD dwRaceNum, CharacterVectorInteractor & i)
 {
-	std::map<DWORD, CHARACTER_SET>::iterator it = m_map_pkChrByRaceNum.find(dwRaceNum);
+	itertype(m_map_pkChrByRaceNum) it = m_map_pkChrByRaceNum.find(dwRaceNum);
 
 	if (it == m_map_pkChrByRaceNum.end())
 		return false;
@@ -849,6 +1056,16 @@ bool CHARACTER_MANAGER::GetCharactersByRaceNum(DWORD dwRaceNum, CharacterVectorI
 	return true;
 }
 
+const CHARACTER_SET * CHARACTER_MANAGER::GetCharactersByRaceNum(DWORD dwRaceNum) const
+{
+	TR1_NS::unordered_map<DWORD, CHARACTER_SET>::const_iterator it = m_map_pkChrByRaceNum.find(dwRaceNum);
+
+	if (it == m_map_pkChrByRaceNum.end())
+		return NULL;
+
+	return &it->second;
+}
+
 #define FIND_JOB_WARRIOR_0	(1 << 3)
 #define FIND_JOB_WARRIOR_1	(1 << 4)
 #define FIND_JOB_WARRIOR_2	(1 << 5)
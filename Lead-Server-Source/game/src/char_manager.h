@@ -10,6 +10,83 @@ class CDungeon;
 class CHARACTER;
 class CharacterVectorInteractor;
 
+// Characters updated every pulse. Kept in a vector so the update walks
+// contiguous memory and never allocates, removal only clears the slot and
+// the holes are squeezed out by Compact() outside of ForEach().
+class CharacterUpdateList
+{
+	public:
+		CharacterUpdateList() : m_bDirty(false)
+		{
+		}
+
+		bool Add(LPCHARACTER ch)
+		{
+			if (m_map_index.find(ch) != m_map_index.end())
+				return false;
+
+			m_map_index.insert(std::make_pair(ch, m_vec.size()));
+			m_vec.push_back(ch);
+			return true;
+		}
+
+		bool Remove(LPCHARACTER ch)
+		{
+			TR1_NS::unordered_map<LPCHARACTER, size_t>::iterator it = m_map_index.find(ch);
+
+			if (it == m_map_index.end())
+				return false;
+
+			m_vec[it->second] = NULL;
+			m_map_index.erase(it);
+			m_bDirty = true;
+			return true;
+		}
+
+		size_t size() const	{ return m_map_index.size(); }
+		bool empty() const	{ return m_map_index.empty(); }
+
+		// characters added while iterating are updated from the next pulse on
+		template <class Func> void ForEach(Func f)
+		{
+			size_t count = m_vec.size();
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				LPCHARACTER ch = m_vec[i];
+
+				if (ch)
+					f(ch);
+			}
+		}
+
+		void Compact()
+		{
+			if (!m_bDirty)
+				return;
+
+			size_t j = 0;
+
+			for (size_t i = 0; i < m_vec.size(); ++i)
+			{
+				if (!m_vec[i])
+					continue;
+
+				m_vec[j] = m_vec[i];
+				m_map_index[m_vec[j]] = j;
+				++j;
+			}
+
+			m_vec.resize(j);
+			m_bDirty = false;
+		}
+
+	private:
+		std::vector<LPCHARACTER>	m_vec;
+		TR1_NS::unordered_map<LPCHARACTER, size_t> m_map_index;
+		bool				m_bDirty;
+};
+
 class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 {
 	public:
@@ -26,6 +103,7 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 
 		LPCHARACTER             CreateCharacter(const char * name, DWORD dwPID = 0);
 		void DestroyCharacter(LPCHARACTER ch);
+		void			DumpCharacterPoolStat();
 
 		void			Update(int iPulse);
 		void			DestroyCharacterInMap(long lMapIndex);
@@ -37,6 +115,11 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 		bool			SpawnMoveGroup(DWORD dwVnum, long lMapIndex, int sx, int sy, int ex, int ey, int tx, int ty, LPREGEN pkRegen = NULL, bool bAggressive_ = false);
 		LPCHARACTER		SpawnMobRandomPosition(DWORD dwVnum, long lMapIndex);
 
+		// Begin  End ̿ SpawnMob  Ÿ ĳʹ Ʈ ־ ΰ
+		// End  Ʈ   ֺ  þ߸ Ѳ .
+		void			BeginSpawnBatch();
+		void			EndSpawnBatch();
+
 		void			SelectStone(LPCHARACTER pkChrStone);
 
 		NAME_MAP &		GetPCMap() { return m_map_pkPCChr; }
@@ -46,6 +129,8 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 		LPCHARACTER		FindPC(const char * name);
 		LPCHARACTER		FindByPID(DWORD dwPID);
 
+		const std::string &	GetNameKey(const char * c_pszName);
+
 		bool			AddToStateList(LPCHARACTER ch);
 		void			RemoveFromStateList(LPCHARACTER ch);
 
@@ -56,6 +141,11 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 		bool                    FlushDelayedSave(LPCHARACTER ch); // Delayed Ʈ ִٸ  Ѵ.  ó  .
 		void			ProcessDelayedSave();
 
+		// ֱ : save_event_second_cycle  pulse  ĭ ϳ ΰ   ư
+		// ִ´. Ѳ ص   ,  pulse  g_iSaveMaxPerPulse  Ѵ.
+		void			RegisterPeriodicSave(LPCHARACTER ch);
+		void			UnregisterPeriodicSave(LPCHARACTER ch);
+
 		template<class Func>	Func for_each_pc(Func f);
 
 		void			RegisterForMonsterLog(LPCHARACTER ch);
@@ -68,6 +158,9 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 		void			RegisterRaceNumMap(LPCHARACTER ch);
 		void			UnregisterRaceNumMap(LPCHARACTER ch);
 		bool			GetCharactersByRaceNum(DWORD dwRaceNum, CharacterVectorInteractor & i);
+		//  ʰ ϵ  ״ ش. ϵ  ̸ NULL.
+		// ȸ ߿ ĳ͸  ȵǹǷ      Ѵ.
+		const CHARACTER_SET *	GetCharactersByRaceNum(DWORD dwRaceNum) const;
 
 		LPCHARACTER		FindSpecifyPC(unsigned int uiJobFlag, long lMapIndex, LPCHARACTER except=NULL, int iMinLevel = 1, int iMaxLevel = PLAYER_MAX_LEVEL_CONST);
 
@@ -96,7 +189,34 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 		bool			BeginPendingDestroy();
 		void			FlushPendingDestroy();
 
+		//   ĳ , Ʈ, Ʈ.  ھ P2P  Ѱ   ִٰ 
+		// α Ű ϸ DB  .  ʹ DB   ITEM_LOAD, QUEST_LOAD, AFFECT_LOAD
+		// Ŷ  ̴.
+		typedef struct SWarpHandoff
+		{
+			DWORD			dwLoginKey;
+			DWORD			dwTime;
+			std::vector<char>	vecItem;
+			std::vector<char>	vecQuest;
+			std::vector<char>	vecAffect;
+		} TWarpHandoff;
+
+		// P2P    ũ⸦ ϱ     ´.   ʰ DB  д´.
+		enum
+		{
+			WARP_HANDOFF_ITEM_MAX	= INVENTORY_AND_EQUIP_SLOT_MAX + DRAGON_SOUL_INVENTORY_MAX_NUM,
+			WARP_HANDOFF_QUEST_MAX	= 8192,
+			WARP_HANDOFF_AFFECT_MAX	= 1024,
+		};
+
+		void			AddWarpHandoff(DWORD dwLoginKey, DWORD dwPID, DWORD dwItemCount, DWORD dwQuestCount, DWORD dwAffectCount, const char * c_pData);
+		const TWarpHandoff *	FindWarpHandoff(DWORD dwLoginKey, DWORD dwPID);	// ã  ð ٽ .
+		void			RemoveWarpHandoff(DWORD dwPID);
+
 	private:
+		void			ExpireWarpHandoff();
+		void			ProcessPeriodicSave(int iPulse);
+
 		int					m_iMobItemRate;
 		int					m_iMobDamageRate;
 		int					m_iMobGoldAmountRate;
@@ -115,9 +235,11 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 		TR1_NS::unordered_map<DWORD, LPCHARACTER> m_map_pkChrByVID;
 		TR1_NS::unordered_map<DWORD, LPCHARACTER> m_map_pkChrByPID;
 		NAME_MAP			m_map_pkPCChr;
+		std::string			m_stNameKey;	// ̸ ˻ ҹ Ű. Ź  Ҵ ʵ Ѵ.
+		CharacterUpdateList	m_list_pkPCUpdate;
 
 		char				dummy1[1024];	// memory barrier
-		CHARACTER_SET		m_set_pkChrState;	// FSM ư ִ 
+		CharacterUpdateList	m_list_pkChrState;	// FSM ư ִ 
 		CHARACTER_SET		m_set_pkChrForDelayedSave;
 		CHARACTER_SET		m_set_pkChrMonsterLog;
 
@@ -125,11 +247,24 @@ class CHARACTER_MANAGER : public singleton<CHARACTER_MANAGER>
 
 		std::map<DWORD, DWORD> m_map_dwMobKillCount;
 
-		std::set<DWORD>		m_set_dwRegisteredRaceNum;
-		std::map<DWORD, CHARACTER_SET> m_map_pkChrByRaceNum;
+		TR1_NS::unordered_set<DWORD>	m_set_dwRegisteredRaceNum;
+		TR1_NS::unordered_map<DWORD, CHARACTER_SET> m_map_pkChrByRaceNum;
 
 		bool				m_bUsePendingDestroy;
 		CHARACTER_SET		m_set_pkChrPendingDestroy;
+
+		DWORD				m_dwChrPoolReuse;	// Ǯ ٽ  CHARACTER  (DumpCharacterPoolStat  ʱȭ)
+		DWORD				m_dwChrPoolAlloc;	//   Ҵ CHARACTER 
+		DWORD				m_dwChrLivePeak;
+
+		int				m_iSpawnBatchDepth;
+		CHARACTER_VECTOR		m_vec_pkSpawnBatch;	// þ߸    ĳ
+
+		std::map<DWORD, TWarpHandoff>	m_map_kWarpHandoff;	// PID
+
+		std::vector<CHARACTER_VECTOR>	m_vec_kPeriodicSaveSlot;
+		size_t				m_uiPeriodicSaveCursor;	//   ĳͰ  ĭ
+		std::deque<DWORD>		m_deque_dwPeriodicSavePending;	// ʰ  pulse   и PID
 };
 
 	template<class Func>	
@@ -16,7 +16,7 @@ void CHARACTER::SyncQuickslot(BYTE bType, BYTE bOldPos, BYTE bNewPos) // bNewPos
 
 	for (int i = 0; i < QUICKSLOT_MAX_NUM; ++i)
 	{
-		if (m_quickslot[i].type == bType && m_quickslot[i].pos == bOldPos)
+		if (GetPCPoints().quickslot[i].type == bType && GetPCPoints().quickslot[i].pos == bOldPos)
 		{
 			if (bNewPos == 255)
 				DelQuickslot(i);
@@ -38,7 +38,7 @@ bool CHARACTER::GetQuickslot(BYTE pos, TQuickslot ** ppSlot)
 	if (pos >= QUICKSLOT_MAX_NUM)
 		return false;
 
-	*ppSlot = &m_quickslot[pos];
+	*ppSlot = &AllocPCPoints().quickslot[pos];
 	return true;
 }
 
@@ -56,7 +56,7 @@ bool CHARACTER::SetQuickslot(BYTE pos, TQuickslot & rSlot)
 	{
 		if (rSlot.type == 0)
 			continue;
-		else if (m_quickslot[i].type == rSlot.type && m_quickslot[i].pos == rSlot.pos)
+		else if (GetPCPoints().quickslot[i].type == rSlot.type && GetPCPoints().quickslot[i].pos == rSlot.pos)
 			DelQuickslot(i);
 	}
 
@@ -83,13 +83,15 @@ bool CHARACTER::SetQuickslot(BYTE pos, TQuickslot & rSlot)
 			return false;
 	}
 
-	m_quickslot[pos] = rSlot;
+	TQuickslot * pkQuickslot = AllocPCPoints().quickslot;
+
+	pkQuickslot[pos] = rSlot;
 
 	if (GetDesc())
 	{
 		pack_quickslot_add.header	= HEADER_GC_QUICKSLOT_ADD;
 		pack_quickslot_add.pos		= pos;
-		pack_quickslot_add.slot		= m_quickslot[pos];
+		pack_quickslot_add.slot		= pkQuickslot[pos];
 
 		GetDesc()->Packet(&pack_quickslot_add, sizeof(pack_quickslot_add));
 	}
@@ -104,7 +106,7 @@ bool CHARACTER::DelQuickslot(BYTE pos)
 	if (pos >= QUICKSLOT_MAX_NUM)
 		return false;
 
-	memset(&m_quickslot[pos], 0, sizeof(TQuickslot));
+	memset(&AllocPCPoints().quickslot[pos], 0, sizeof(TQuickslot));
 
 	pack_quickslot_del.header	= HEADER_GC_QUICKSLOT_DEL;
 	pack_quickslot_del.pos	= pos;
@@ -122,10 +124,12 @@ bool CHARACTER::SwapQuickslot(BYTE a, BYTE b)
 		return false;
 
 	//   ڸ  ٲ۴.
-	quickslot = m_quickslot[a];
+	TQuickslot * pkQuickslot = AllocPCPoints().quickslot;
+
+	quickslot = pkQuickslot[a];
 
-	m_quickslot[a] = m_quickslot[b];
-	m_quickslot[b] = quickslot;
+	pkQuickslot[a] = pkQuickslot[b];
+	pkQuickslot[b] = quickslot;
 
 	pack_quickslot_swap.header	= HEADER_GC_QUICKSLOT_SWAP;
 	pack_quickslot_swap.pos	= a;
@@ -141,7 +145,7 @@ void CHARACTER::ChainQuickslotItem(LPITEM pItem, BYTE bType, BYTE bOldPos)
 		return;
 	for ( int i=0; i < QUICKSLOT_MAX_NUM; ++i )
 	{
-		if ( m_quickslot[i].type == bType && m_quickslot[i].pos == bOldPos )
+		if ( GetPCPoints().quickslot[i].type == bType && GetPCPoints().quickslot[i].pos == bOldPos )
 		{
 			TQuickslot slot;
 			slot.type = bType;
@@ -123,6 +123,34 @@ bool TSkillUseInfo::UseSkill(bool isGrandMaster, DWORD vid, DWORD dwCooltime, in
 	return true;
 }
 
+TSkillUseInfo & CHARACTER::GetSkillUseInfo(DWORD dwVnum)
+{
+	if (dwVnum >= SKILL_MAX_NUM)
+	{
+		sys_err("%s skill vnum overflow %u", GetName(), dwVnum);
+		dwVnum = 0;
+	}
+
+	BYTE & rbSlot = AllocPCPoints().abSkillUseSlot[dwVnum];
+
+	if (!rbSlot)
+	{
+		m_vec_kSkillUseInfo.push_back(TSkillUseInfo());
+		rbSlot = m_vec_kSkillUseInfo.size();
+	}
+
+	return m_vec_kSkillUseInfo[rbSlot - 1];
+}
+
+TSkillUseInfo * CHARACTER::FindSkillUseInfo(DWORD dwVnum)
+{
+	if (dwVnum >= SKILL_MAX_NUM)
+		return NULL;
+
+	BYTE bSlot = GetPCPoints().abSkillUseSlot[dwVnum];
+	return bSlot ? &m_vec_kSkillUseInfo[bSlot - 1] : NULL;
+}
+
 int CHARACTER::GetChainLightningMaxCount() const
 { 
 	return aiChainLightningCountBySkillLevel[MIN(SKILL_MAX_LEVEL, GetSkillLevel(SKILL_CHAIN))];
@@ -876,7 +904,7 @@ EVENTFUNC(ChainLightningEvent)
 
 		if (pkChrVictim->GetSectree())
 		{
-			pkChrVictim->GetSectree()->ForEachAround(f);
+			pkChrVictim->GetSectree()->ForEachAroundKind(SPATIAL_KIND_CHARACTER, f);
 			// 2. If exist, compute it again
 			pkTarget = f.GetVictim();
 		}
@@ -971,12 +999,19 @@ struct FuncSplashDamage
 				}
 
 		++m_iCount;
+		m_vecVictim.push_back(pkChrVictim);
+	}
 
-		int iDam;
+	// Ƶ     ϰ    Ѵ.
+	// ϴ  ƹ͵  Ƿ     ̴.
+	void Resolve()
+	{
+		if (m_vecVictim.empty())
+			return;
 
-		////////////////////////////////////////////////////////////////////////////////
-		//float k = 1.0f * m_pkChr->GetSkillPower(m_pkSk->dwVnum) * m_pkSk->bMaxLevel / 100;
-		//m_pkSk->kPointPoly2.SetVar("k", 1.0 * m_bUseSkillPower * m_pkSk->bMaxLevel / 100);
+		const size_t uCount = m_vecVictim.size();
+
+		//    󸶴 Ƿ   ִ´.
 		m_pkSk->SetPointVar("k", 1.0 * m_bUseSkillPower * m_pkSk->bMaxLevel / 100);
 		m_pkSk->SetPointVar("lv", m_pkChr->GetLevel());
 		m_pkSk->SetPointVar("iq", m_pkChr->GetPoint(POINT_IQ));
@@ -987,258 +1022,322 @@ struct FuncSplashDamage
 		m_pkSk->SetPointVar("odef", m_pkChr->GetPoint(POINT_DEF_GRADE) - m_pkChr->GetPoint(POINT_DEF_GRADE_BONUS));
 		m_pkSk->SetPointVar("horse_level", m_pkChr->GetHorseLevel());
 
-		//int iPenetratePct = (int)(1 + k*4);
-		bool bIgnoreDefense = false;
-
-		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_PENETRATE))
-		{
-			int iPenetratePct = (int) m_pkSk->kPointPoly2.Eval();
-
-			if (number(1, 100) <= iPenetratePct)
-				bIgnoreDefense = true;
-		}
+		bool bUnderEunhyung = m_pkChr->GetAffectedEunhyung() > 0; // ̰  ⼭ ??
 
-		bool bIgnoreTargetRating = false;
+		m_pkSk->SetPointVar("ek", m_pkChr->GetAffectedEunhyung()*1./100);
+		//m_pkChr->ClearAffectedEunhyung();
 
-		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_IGNORE_TARGET_RATING))
-		{
-			int iPct = (int) m_pkSk->kPointPoly2.Eval();
+		const bool bMasterBonus = m_pkChr->GetUsedSkillMasterType(m_pkSk->dwVnum) >= SKILL_GRAND_MASTER;
+		const int iAttackerLevel = m_pkChr->GetLevel();
 
-			if (number(1, 100) <= iPct)
-				bIgnoreTargetRating = true;
-		}
+		LPITEM pkAttackerWeapon = m_pkChr->GetWear(WEAR_WEAPON);
+		const bool bDagger = pkAttackerWeapon && pkAttackerWeapon->GetSubType() == WEAPON_DAGGER;
 
-		m_pkSk->SetPointVar("ar", CalcAttackRating(m_pkChr, pkChrVictim, bIgnoreTargetRating));
+		// TODO ų   Ÿ ؾѴ.
+		EDamageType dt = DAMAGE_TYPE_NONE;
 
-		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_USE_MELEE_DAMAGE))
-			m_pkSk->SetPointVar("atk", CalcMeleeDamage(m_pkChr, pkChrVictim, true, bIgnoreTargetRating));
-		else if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_USE_ARROW_DAMAGE))
+		switch (m_pkSk->bSkillAttrType)
 		{
-			LPITEM pkBow, pkArrow;
+			case SKILL_ATTR_TYPE_NORMAL:	break;
+			case SKILL_ATTR_TYPE_MELEE:	dt = DAMAGE_TYPE_MELEE;	break;
+			case SKILL_ATTR_TYPE_RANGE:	dt = DAMAGE_TYPE_RANGE;	break;
+			case SKILL_ATTR_TYPE_MAGIC:	dt = DAMAGE_TYPE_MAGIC;	break;
 
-			if (1 == m_pkChr->GetArrowAndBow(&pkBow, &pkArrow, 1))
-				m_pkSk->SetPointVar("atk", CalcArrowDamage(m_pkChr, pkChrVictim, pkBow, pkArrow, true));
-			else
-				m_pkSk->SetPointVar("atk", 0);
+			default:
+				sys_err("Unknown skill attr type %u vnum %u", m_pkSk->bSkillAttrType, m_pkSk->dwVnum);
+				break;
 		}
 
-		if (m_pkSk->bPointOn == POINT_MOV_SPEED)
-			m_pkSk->kPointPoly.SetVar("maxv", pkChrVictim->GetLimitPoint(POINT_MOV_SPEED));
+		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_COMPUTE_MAGIC_DAMAGE))
+			dt = DAMAGE_TYPE_MAGIC;
 
-		m_pkSk->SetPointVar("maxhp", pkChrVictim->GetMaxHP());
-		m_pkSk->SetPointVar("maxsp", pkChrVictim->GetMaxSP());
+		BYTE AntiSkillID = 0;
 
-		m_pkSk->SetPointVar("chain", m_pkChr->GetChainLightningIndex());
-		m_pkChr->IncChainLightningIndex();
+		switch (m_pkSk->dwVnum)
+		{
+			case SKILL_TANHWAN:		AntiSkillID = SKILL_7_A_ANTI_TANHWAN;		break;
+			case SKILL_AMSEOP:		AntiSkillID = SKILL_7_B_ANTI_AMSEOP;		break;
+			case SKILL_SWAERYUNG:	AntiSkillID = SKILL_7_C_ANTI_SWAERYUNG;		break;
+			case SKILL_YONGBI:		AntiSkillID = SKILL_7_D_ANTI_YONGBI;		break;
+			case SKILL_GIGONGCHAM:	AntiSkillID = SKILL_8_A_ANTI_GIGONGCHAM;	break;
+			case SKILL_YEONSA:		AntiSkillID = SKILL_8_B_ANTI_YEONSA;		break;
+			case SKILL_MAHWAN:		AntiSkillID = SKILL_8_C_ANTI_MAHWAN;		break;
+			case SKILL_BYEURAK:		AntiSkillID = SKILL_8_D_ANTI_BYEURAK;		break;
+		}
 
-		bool bUnderEunhyung = m_pkChr->GetAffectedEunhyung() > 0; // ̰  ⼭ ??
+		SnapshotVictims(pkAttackerWeapon, AntiSkillID);
 
-		m_pkSk->SetPointVar("ek", m_pkChr->GetAffectedEunhyung()*1./100);
-		//m_pkChr->ClearAffectedEunhyung();
-		SetPolyVarForAttack(m_pkChr, m_pkSk, m_pkWeapon);
+		//    kPointPoly2      ǾǷ ⼭ 󸶴 ̸  д.
+		const bool bNeedPoly2 = IS_SET(m_pkSk->dwFlag, SKILL_FLAG_REMOVE_GOOD_AFFECT |
+				SKILL_FLAG_SLOW | SKILL_FLAG_STUN | SKILL_FLAG_FIRE_CONT | SKILL_FLAG_POISON |
+				SKILL_FLAG_HP_ABSORB | SKILL_FLAG_SP_ABSORB);
 
-		int iAmount = 0;
+		m_vec_iDamage.resize(uCount);
+		m_vec_iPoly2.resize(uCount);
+		m_vec_bChainNext.resize(uCount);
 
-		if (m_pkChr->GetUsedSkillMasterType(m_pkSk->dwVnum) >= SKILL_GRAND_MASTER)
-		{
-			iAmount = (int) m_pkSk->kMasterBonusPoly.Eval();
-		}
-		else
-		{
-			iAmount = (int) m_pkSk->kPointPoly.Eval();
-		}
-
-		if (test_server && iAmount == 0 && m_pkSk->bPointOn != POINT_NONE)
-		{
-			m_pkChr->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("It doesn't work. Check the skill formula"));
-		}
 		////////////////////////////////////////////////////////////////////////////////
-		iAmount = -iAmount;
-
-		if (m_pkSk->dwVnum == SKILL_AMSEOP)
+		// 1. 
+		for (size_t i = 0; i < uCount; ++i)
 		{
-			float fDelta = GetDegreeDelta(m_pkChr->GetRotation(), pkChrVictim->GetRotation());
-			float adjust = (fDelta < 35.0f) ? 1.5f : 1.0f;
+			LPCHARACTER pkChrVictim = m_vecVictim[i];
 
-			if (bUnderEunhyung)
-				adjust += 0.5f;
+			//int iPenetratePct = (int)(1 + k*4);
+			bool bIgnoreDefense = false;
 
-			if (m_pkChr->GetWear(WEAR_WEAPON) && m_pkChr->GetWear(WEAR_WEAPON)->GetSubType() == WEAPON_DAGGER)
-				adjust += 0.5f;
+			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_PENETRATE))
+			{
+				int iPenetratePct = (int) m_pkSk->kPointPoly2.Eval();
 
-			iAmount = (int) (iAmount * adjust);
-		}
-		else if (m_pkSk->dwVnum == SKILL_GUNGSIN)
-		{
-			float adjust = 1.0;
+				if (number(1, 100) <= iPenetratePct)
+					bIgnoreDefense = true;
+			}
+
+			bool bIgnoreTargetRating = false;
 
-			if (m_pkChr->GetWear(WEAR_WEAPON) && m_pkChr->GetWear(WEAR_WEAPON)->GetSubType() == WEAPON_DAGGER)
+			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_IGNORE_TARGET_RATING))
 			{
-				adjust = 1.35f;
+				int iPct = (int) m_pkSk->kPointPoly2.Eval();
+
+				if (number(1, 100) <= iPct)
+					bIgnoreTargetRating = true;
 			}
 
-			iAmount = (int) (iAmount * adjust);
-		}
-		////////////////////////////////////////////////////////////////////////////////
-		//sys_log(0, "name: %s skill: %s amount %d to %s", m_pkChr->GetName(), m_pkSk->szName, iAmount, pkChrVictim->GetName());
+			m_pkSk->SetPointVar("ar", CalcAttackRating(m_pkChr, pkChrVictim, bIgnoreTargetRating));
 
-		iDam = CalcBattleDamage(iAmount, m_pkChr->GetLevel(), pkChrVictim->GetLevel());
+			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_USE_MELEE_DAMAGE))
+				m_pkSk->SetPointVar("atk", CalcMeleeDamage(m_pkChr, pkChrVictim, true, bIgnoreTargetRating));
+			else if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_USE_ARROW_DAMAGE))
+			{
+				LPITEM pkBow, pkArrow;
 
-		if (m_pkChr->IsPC() && m_pkChr->m_SkillUseInfo[m_pkSk->dwVnum].GetMainTargetVID() != (DWORD) pkChrVictim->GetVID())
-		{
-			//  
-			iDam = (int) (iDam * m_pkSk->kSplashAroundDamageAdjustPoly.Eval());
-		}
+				if (1 == m_pkChr->GetArrowAndBow(&pkBow, &pkArrow, 1))
+					m_pkSk->SetPointVar("atk", CalcArrowDamage(m_pkChr, pkChrVictim, pkBow, pkArrow, true));
+				else
+					m_pkSk->SetPointVar("atk", 0);
+			}
 
-		// TODO ų   Ÿ ؾѴ.
-		EDamageType dt = DAMAGE_TYPE_NONE;
+			if (m_pkSk->bPointOn == POINT_MOV_SPEED)
+				m_pkSk->kPointPoly.SetVar("maxv", m_kVictim.vec_iMaxMovSpeed[i]);
 
-		switch (m_pkSk->bSkillAttrType)
-		{
-			case SKILL_ATTR_TYPE_NORMAL:
-				break;
+			m_pkSk->SetPointVar("maxhp", m_kVictim.vec_iMaxHP[i]);
+			m_pkSk->SetPointVar("maxsp", m_kVictim.vec_iMaxSP[i]);
 
-			case SKILL_ATTR_TYPE_MELEE:
-				{
-					dt = DAMAGE_TYPE_MELEE;
+			m_pkSk->SetPointVar("chain", m_pkChr->GetChainLightningIndex());
+			m_pkChr->IncChainLightningIndex();
+			m_vec_bChainNext[i] = m_pkChr->GetChainLightningIndex() < m_pkChr->GetChainLightningMaxCount();
+
+			SetPolyVarForAttack(m_pkChr, m_pkSk, m_pkWeapon);
 
-					LPITEM pkWeapon = m_pkChr->GetWear(WEAR_WEAPON);
+			int iAmount = 0;
 
-					if (pkWeapon)
-						switch (pkWeapon->GetSubType())
-						{
-							case WEAPON_SWORD:
-								iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_SWORD)) / 100;
-								break;
+			if (bMasterBonus)
+				iAmount = (int) m_pkSk->kMasterBonusPoly.Eval();
+			else
+				iAmount = (int) m_pkSk->kPointPoly.Eval();
 
-							case WEAPON_TWO_HANDED:
-								iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_TWOHAND)) / 100;
-								// հ Ƽ 10%
-								//iDam = iDam * 95 / 100;
+			if (test_server && iAmount == 0 && m_pkSk->bPointOn != POINT_NONE)
+			{
+				m_pkChr->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("It doesn't work. Check the skill formula"));
+			}
+			////////////////////////////////////////////////////////////////////////////////
+			iAmount = -iAmount;
 
-								break;
+			if (m_pkSk->dwVnum == SKILL_AMSEOP)
+			{
+				float fDelta = GetDegreeDelta(m_pkChr->GetRotation(), pkChrVictim->GetRotation());
+				float adjust = (fDelta < 35.0f) ? 1.5f : 1.0f;
 
-							case WEAPON_DAGGER:
-								iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_DAGGER)) / 100;
-								break;
+				if (bUnderEunhyung)
+					adjust += 0.5f;
 
-							case WEAPON_BELL:
-								iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_BELL)) / 100;
-								break;
+				if (bDagger)
+					adjust += 0.5f;
 
-							case WEAPON_FAN:
-								iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_FAN)) / 100;
-								break;
-						}
+				iAmount = (int) (iAmount * adjust);
+			}
+			else if (m_pkSk->dwVnum == SKILL_GUNGSIN)
+			{
+				float adjust = 1.0;
 
-					if (!bIgnoreDefense)
-						iDam -= pkChrVictim->GetPoint(POINT_DEF_GRADE);
+				if (bDagger)
+				{
+					adjust = 1.35f;
 				}
-				break;
 
-			case SKILL_ATTR_TYPE_RANGE:
-				dt = DAMAGE_TYPE_RANGE;
-				// ƾƾƾ
-				//  ߴ װ ־   ٽϸ  
-				//iDam -= pkChrVictim->GetPoint(POINT_DEF_GRADE);
-				iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_BOW)) / 100;
-				break;
+				iAmount = (int) (iAmount * adjust);
+			}
+			////////////////////////////////////////////////////////////////////////////////
+			//sys_log(0, "name: %s skill: %s amount %d to %s", m_pkChr->GetName(), m_pkSk->szName, iAmount, pkChrVictim->GetName());
 
-			case SKILL_ATTR_TYPE_MAGIC:
-				dt = DAMAGE_TYPE_MAGIC;
-				iDam = CalcAttBonus(m_pkChr, pkChrVictim, iDam);
-				// ƾƾƾ
-				//  ߴ װ ־   ٽϸ  
-				//iDam -= pkChrVictim->GetPoint(POINT_MAGIC_DEF_GRADE);
-				iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_MAGIC)) / 100;
-				break;
+			int iDam = CalcBattleDamage(iAmount, iAttackerLevel, m_kVictim.vec_iLevel[i]);
 
-			default:
-				sys_err("Unknown skill attr type %u vnum %u", m_pkSk->bSkillAttrType, m_pkSk->dwVnum);
-				break;
-		}
+			if (m_kVictim.vec_bSplashAdjust[i])
+			{
+				//  
+				iDam = (int) (iDam * m_pkSk->kSplashAroundDamageAdjustPoly.Eval());
+			}
 
-		//
-		// 20091109  ų Ӽ û ۾
-		//  ų ̺ SKILL_FLAG_WIND, SKILL_FLAG_ELEC, SKILL_FLAG_FIRE  ų
-		//  Ƿ  RESIST_WIND, RESIST_ELEC, RESIST_FIRE  ʰ ־.
-		//
-		// PvP PvE뷱 и  ǵ NPC ϵ   뷱 
-		//  ϱ  mob_proto RESIST_MAGIC RESIST_WIND, RESIST_ELEC, RESIST_FIRE
-		// Ͽ.
-		//
-		if (pkChrVictim->IsNPC())
-		{
-			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_WIND))
+			switch (m_pkSk->bSkillAttrType)
 			{
-				iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_WIND)) / 100;
+				case SKILL_ATTR_TYPE_MELEE:
+					//   ´ . հ Ƽ 10%  ݴ (iDam = iDam * 95 / 100)
+					iDam = iDam * (100 - m_kVictim.vec_iResist[i]) / 100;
+
+					if (!bIgnoreDefense)
+						iDam -= m_kVictim.vec_iDefGrade[i];
+					break;
+
+				case SKILL_ATTR_TYPE_RANGE:
+					// ƾƾƾ
+					//  ߴ װ ־   ٽϸ  
+					//iDam -= pkChrVictim->GetPoint(POINT_DEF_GRADE);
+					iDam = iDam * (100 - m_kVictim.vec_iResist[i]) / 100;
+					break;
+
+				case SKILL_ATTR_TYPE_MAGIC:
+					iDam = CalcAttBonus(m_pkChr, pkChrVictim, iDam);
+					// ƾƾƾ
+					//  ߴ װ ־   ٽϸ  
+					//iDam -= pkChrVictim->GetPoint(POINT_MAGIC_DEF_GRADE);
+					iDam = iDam * (100 - m_kVictim.vec_iResist[i]) / 100;
+					break;
 			}
 
-			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_ELEC))
+			//
+			// 20091109  ų Ӽ û ۾
+			//  ų ̺ SKILL_FLAG_WIND, SKILL_FLAG_ELEC, SKILL_FLAG_FIRE  ų
+			//  Ƿ  RESIST_WIND, RESIST_ELEC, RESIST_FIRE  ʰ ־.
+			//
+			// PvP PvE뷱 и  ǵ NPC ϵ   뷱 
+			//  ϱ  mob_proto RESIST_MAGIC RESIST_WIND, RESIST_ELEC, RESIST_FIRE
+			// Ͽ.
+			//
+			if (m_kVictim.vec_bNPC[i])
 			{
-				iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_ELEC)) / 100;
+				if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_WIND))
+				{
+					iDam = iDam * (100 - m_kVictim.vec_iResistWind[i]) / 100;
+				}
+
+				if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_ELEC))
+				{
+					iDam = iDam * (100 - m_kVictim.vec_iResistElec[i]) / 100;
+				}
+
+				if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_FIRE))
+				{
+					iDam = iDam * (100 - m_kVictim.vec_iResistFire[i]) / 100;
+				}
 			}
 
-			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_FIRE))
+			if (m_pkSk->dwVnum == SKILL_CHAIN)
+				sys_log(0, "%s CHAIN INDEX %d DAM %d DT %d", m_pkChr->GetName(), m_pkChr->GetChainLightningIndex() - 1, iDam, dt);
+
+			if (m_kVictim.vec_bAntiSkillLevel[i])
 			{
-				iDam = iDam * (100 - pkChrVictim->GetPoint(POINT_RESIST_FIRE)) / 100;
+				CSkillProto* pkSk = CSkillManager::instance().Get(AntiSkillID);
+				if (!pkSk)
+				{
+					sys_err ("There is no anti skill(%d) in skill proto", AntiSkillID);
+				}
+				else
+				{
+					pkSk->SetPointVar("k", 1.0f * pkChrVictim->GetSkillPower(AntiSkillID) * pkSk->bMaxLevel / 100);
+
+					double ResistAmount = pkSk->kPointPoly.Eval();
+
+					sys_log(0, "ANTI_SKILL: Resist(%lf) Orig(%d) Reduce(%d)", ResistAmount, iDam, int(iDam * (ResistAmount/100.0)));
+
+					iDam -= iDam * (ResistAmount/100.0);
+				}
 			}
+
+			m_vec_iDamage[i] = iDam;
+
+			if (bNeedPoly2)
+				m_vec_iPoly2[i] = (int) m_pkSk->kPointPoly2.Eval();
 		}
 
-		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_COMPUTE_MAGIC_DAMAGE))
-			dt = DAMAGE_TYPE_MAGIC;
+		////////////////////////////////////////////////////////////////////////////////
+		// 2. 
+		for (size_t i = 0; i < uCount; ++i)
+		{
+			LPCHARACTER pkChrVictim = m_vecVictim[i];
+			int iDam = m_vec_iDamage[i];
 
-		if (pkChrVictim->CanBeginFight())
-			pkChrVictim->BeginFight(m_pkChr);
+			if (pkChrVictim->CanBeginFight())
+				pkChrVictim->BeginFight(m_pkChr);
 
-		if (m_pkSk->dwVnum == SKILL_CHAIN)
-			sys_log(0, "%s CHAIN INDEX %d DAM %d DT %d", m_pkChr->GetName(), m_pkChr->GetChainLightningIndex() - 1, iDam, dt);
+			Apply(pkChrVictim, iDam, dt, m_vec_iPoly2[i], m_vec_bChainNext[i]);
+		}
 
-		{
-			BYTE AntiSkillID = 0;
+		if(test_server)
+			sys_log(0, "FuncSplashDamage End :%s victims %u", m_pkChr->GetName(), (unsigned int) uCount);
+	}
 
-			switch (m_pkSk->dwVnum)
-			{
-				case SKILL_TANHWAN:		AntiSkillID = SKILL_7_A_ANTI_TANHWAN;		break;
-				case SKILL_AMSEOP:		AntiSkillID = SKILL_7_B_ANTI_AMSEOP;		break;
-				case SKILL_SWAERYUNG:	AntiSkillID = SKILL_7_C_ANTI_SWAERYUNG;		break;
-				case SKILL_YONGBI:		AntiSkillID = SKILL_7_D_ANTI_YONGBI;		break;
-				case SKILL_GIGONGCHAM:	AntiSkillID = SKILL_8_A_ANTI_GIGONGCHAM;	break;
-				case SKILL_YEONSA:		AntiSkillID = SKILL_8_B_ANTI_YEONSA;		break;
-				case SKILL_MAHWAN:		AntiSkillID = SKILL_8_C_ANTI_MAHWAN;		break;
-				case SKILL_BYEURAK:		AntiSkillID = SKILL_8_D_ANTI_BYEURAK;		break;
-			}
+	private:
+	//  ɷġ 迭  д.   ĳ͸  ǵ帮 ʴ´.
+	void SnapshotVictims(LPITEM pkAttackerWeapon, BYTE AntiSkillID)
+	{
+		const size_t uCount = m_vecVictim.size();
 
-			if (0 != AntiSkillID)
-			{
-				BYTE AntiSkillLevel = pkChrVictim->GetSkillLevel(AntiSkillID);
+		m_kVictim.Resize(uCount);
 
-				if (0 != AntiSkillLevel)
-				{
-					CSkillProto* pkSk = CSkillManager::instance().Get(AntiSkillID);
-					if (!pkSk)
+		// ų Ӽ شϴ .     ޶.
+		BYTE bResistPoint = POINT_NONE;
+
+		switch (m_pkSk->bSkillAttrType)
+		{
+			case SKILL_ATTR_TYPE_MELEE:
+				if (pkAttackerWeapon)
+					switch (pkAttackerWeapon->GetSubType())
 					{
-						sys_err ("There is no anti skill(%d) in skill proto", AntiSkillID);
+						case WEAPON_SWORD:	bResistPoint = POINT_RESIST_SWORD;	break;
+						case WEAPON_TWO_HANDED:	bResistPoint = POINT_RESIST_TWOHAND;	break;
+						case WEAPON_DAGGER:	bResistPoint = POINT_RESIST_DAGGER;	break;
+						case WEAPON_BELL:	bResistPoint = POINT_RESIST_BELL;	break;
+						case WEAPON_FAN:	bResistPoint = POINT_RESIST_FAN;	break;
 					}
-					else
-					{
-						pkSk->SetPointVar("k", 1.0f * pkChrVictim->GetSkillPower(AntiSkillID) * pkSk->bMaxLevel / 100);
+				break;
 
-						double ResistAmount = pkSk->kPointPoly.Eval();
+			case SKILL_ATTR_TYPE_RANGE:
+				bResistPoint = POINT_RESIST_BOW;
+				break;
 
-						sys_log(0, "ANTI_SKILL: Resist(%lf) Orig(%d) Reduce(%d)", ResistAmount, iDam, int(iDam * (ResistAmount/100.0)));
+			case SKILL_ATTR_TYPE_MAGIC:
+				bResistPoint = POINT_RESIST_MAGIC;
+				break;
+		}
 
-						iDam -= iDam * (ResistAmount/100.0);
-					}
-				}
-			}
+		const bool bSplashAdjust = m_pkChr->IsPC();
+
+		for (size_t i = 0; i < uCount; ++i)
+		{
+			LPCHARACTER pkChrVictim = m_vecVictim[i];
+
+			m_kVictim.vec_iLevel[i] = pkChrVictim->GetLevel();
+			m_kVictim.vec_iMaxHP[i] = pkChrVictim->GetMaxHP();
+			m_kVictim.vec_iMaxSP[i] = pkChrVictim->GetMaxSP();
+			m_kVictim.vec_iMaxMovSpeed[i] = pkChrVictim->GetLimitPoint(POINT_MOV_SPEED);
+			m_kVictim.vec_iResist[i] = bResistPoint != POINT_NONE ? pkChrVictim->GetPoint(bResistPoint) : 0;
+			m_kVictim.vec_iDefGrade[i] = pkChrVictim->GetPoint(POINT_DEF_GRADE);
+			m_kVictim.vec_bNPC[i] = pkChrVictim->IsNPC();
+			m_kVictim.vec_iResistWind[i] = pkChrVictim->GetPoint(POINT_RESIST_WIND);
+			m_kVictim.vec_iResistElec[i] = pkChrVictim->GetPoint(POINT_RESIST_ELEC);
+			m_kVictim.vec_iResistFire[i] = pkChrVictim->GetPoint(POINT_RESIST_FIRE);
+			m_kVictim.vec_bSplashAdjust[i] = bSplashAdjust && m_pkChr->GetSkillUseInfo(m_pkSk->dwVnum).GetMainTargetVID() != (DWORD) pkChrVictim->GetVID();
+			m_kVictim.vec_bAntiSkillLevel[i] = AntiSkillID ? pkChrVictim->GetSkillLevel(AntiSkillID) : 0;
 		}
+	}
 
+	void Apply(LPCHARACTER pkChrVictim, int iDam, EDamageType dt, int iPoly2, bool bChainNext)
+	{
 		if (!pkChrVictim->Damage(m_pkChr, iDam, dt) && !pkChrVictim->IsStun())
 		{
 			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_REMOVE_GOOD_AFFECT))
 			{
-				int iAmount2 = (int) m_pkSk->kPointPoly2.Eval();
+				int iAmount2 = iPoly2;
 				int iDur2 = (int) m_pkSk->kDurationPoly2.Eval();
 				iDur2 += m_pkChr->GetPoint(POINT_PARTY_BUFFER_BONUS);
 
@@ -1251,7 +1350,7 @@ struct FuncSplashDamage
 
 			if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_SLOW | SKILL_FLAG_STUN | SKILL_FLAG_FIRE_CONT | SKILL_FLAG_POISON))
 			{
-				int iPct = (int) m_pkSk->kPointPoly2.Eval();
+				int iPct = iPoly2;
 				int iDur = (int) m_pkSk->kDurationPoly2.Eval();
 
 				iDur += m_pkChr->GetPoint(POINT_PARTY_BUFFER_BONUS);
@@ -1323,7 +1422,7 @@ struct FuncSplashDamage
 				pkChrVictim->Goto(tx, ty);
 				pkChrVictim->CalculateMoveDuration();
 
-				if (m_pkChr->IsPC() && m_pkChr->m_SkillUseInfo[m_pkSk->dwVnum].GetMainTargetVID() == (DWORD) pkChrVictim->GetVID())
+				if (m_pkChr->IsPC() && m_pkChr->GetSkillUseInfo(m_pkSk->dwVnum).GetMainTargetVID() == (DWORD) pkChrVictim->GetVID())
 				{
 					SkillAttackAffect(pkChrVictim, 1000, IMMUNE_STUN, m_pkSk->dwVnum, POINT_NONE, 0, AFF_STUN, 4, m_pkSk->szName);
 				}
@@ -1336,17 +1435,17 @@ struct FuncSplashDamage
 
 		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_HP_ABSORB))
 		{
-			int iPct = (int) m_pkSk->kPointPoly2.Eval();
+			int iPct = iPoly2;
 			m_pkChr->PointChange(POINT_HP, iDam * iPct / 100);
 		}
 
 		if (IS_SET(m_pkSk->dwFlag, SKILL_FLAG_SP_ABSORB))
 		{
-			int iPct = (int) m_pkSk->kPointPoly2.Eval();
+			int iPct = iPoly2;
 			m_pkChr->PointChange(POINT_SP, iDam * iPct / 100);
 		}
 
-		if (m_pkSk->dwVnum == SKILL_CHAIN && m_pkChr->GetChainLightningIndex() < m_pkChr->GetChainLightningMaxCount())
+		if (m_pkSk->dwVnum == SKILL_CHAIN && bChainNext)
 		{
 			chain_lightning_event_info* info = AllocEventInfo<chain_lightning_event_info>();
 
@@ -1355,10 +1454,43 @@ struct FuncSplashDamage
 
 			event_create(ChainLightningEvent, info, passes_per_sec / 5);
 		}
-		if(test_server)
-			sys_log(0, "FuncSplashDamage End :%s ", m_pkChr->GetName());
 	}
 
+	//  ɷġ.    д´.
+	struct SVictimStat
+	{
+		std::vector<int>	vec_iLevel;
+		std::vector<int>	vec_iMaxHP;
+		std::vector<int>	vec_iMaxSP;
+		std::vector<int>	vec_iMaxMovSpeed;
+		std::vector<int>	vec_iResist;	// ų Ӽ شϴ  (, Ȱ, )
+		std::vector<int>	vec_iDefGrade;
+		std::vector<int>	vec_iResistWind;
+		std::vector<int>	vec_iResistElec;
+		std::vector<int>	vec_iResistFire;
+		std::vector<BYTE>	vec_bNPC;
+		std::vector<BYTE>	vec_bSplashAdjust;	//  Ÿ ƴ϶  δ
+		std::vector<BYTE>	vec_bAntiSkillLevel;
+
+		void Resize(size_t uCount)
+		{
+			vec_iLevel.resize(uCount);
+			vec_iMaxHP.resize(uCount);
+			vec_iMaxSP.resize(uCount);
+			vec_iMaxMovSpeed.resize(uCount);
+			vec_iResist.resize(uCount);
+			vec_iDefGrade.resize(uCount);
+			vec_iResistWind.resize(uCount);
+			vec_iResistElec.resize(uCount);
+			vec_iResistFire.resize(uCount);
+			vec_bNPC.resize(uCount);
+			vec_bSplashAdjust.resize(uCount);
+			vec_bAntiSkillLevel.resize(uCount);
+		}
+	};
+
+	public:
+
 	int		m_x;
 	int		m_y;
 	CSkillProto * m_pkSk;
@@ -1371,6 +1503,11 @@ struct FuncSplashDamage
 	bool m_bDisableCooltime;
 	TSkillUseInfo* m_pInfo;
 	BYTE m_bUseSkillPower;
+	std::vector<LPCHARACTER>	m_vecVictim;
+	SVictimStat			m_kVictim;
+	std::vector<int>		m_vec_iDamage;
+	std::vector<int>		m_vec_iPoly2;
+	std::vector<BYTE>		m_vec_bChainNext;
 };
 
 struct FuncSplashAffect
@@ -1624,18 +1761,20 @@ int CHARACTER::ComputeSkillAtPosition(DWORD dwVnum, const PIXEL_POSITION& posTar
 		{
 			int iAG = 0;
 
-			FuncSplashDamage f(posTarget.x, posTarget.y, pkSk, this, iAmount, iAG, pkSk->lMaxHit, pkWeapon, m_bDisableCooltime, IsPC()?&m_SkillUseInfo[dwVnum]:NULL, GetSkillPower(dwVnum, bSkillLevel));
+			FuncSplashDamage f(posTarget.x, posTarget.y, pkSk, this, iAmount, iAG, pkSk->lMaxHit, pkWeapon, m_bDisableCooltime, IsPC()?&GetSkillUseInfo(dwVnum):NULL, GetSkillPower(dwVnum, bSkillLevel));
 
 			if (IS_SET(pkSk->dwFlag, SKILL_FLAG_SPLASH))
 			{
 				if (GetSectree())
-					GetSectree()->ForEachAround(f);
+					GetSectree()->ForEachAroundInRange(posTarget.x, posTarget.y, pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 			}
 			else
 			{
 				//if (dwVnum == SKILL_CHAIN) sys_log(0, "CHAIN skill call FuncSplashDamage %s", GetName());
 				f(this);
 			}
+
+			f.Resolve();
 		}
 		else
 		{
@@ -1644,7 +1783,7 @@ int CHARACTER::ComputeSkillAtPosition(DWORD dwVnum, const PIXEL_POSITION& posTar
 
 			if (IsPC())
 				if (!(dwVnum >= GUILD_SKILL_START && dwVnum <= GUILD_SKILL_END)) //  ų Ÿ ó  ʴ´.
-					if (!m_bDisableCooltime && !m_SkillUseInfo[dwVnum].HitOnce(dwVnum) && dwVnum != SKILL_MUYEONG)
+					if (!m_bDisableCooltime && !GetSkillUseInfo(dwVnum).HitOnce(dwVnum) && dwVnum != SKILL_MUYEONG)
 					{
 						//if (dwVnum == SKILL_CHAIN) sys_log(0, "CHAIN skill cannot hit %s", GetName());
 						return BATTLE_NONE;
@@ -1662,7 +1801,7 @@ int CHARACTER::ComputeSkillAtPosition(DWORD dwVnum, const PIXEL_POSITION& posTar
 					if (GetSectree())
 					{
 						FuncSplashAffect f(this, posTarget.x, posTarget.y, pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn, iAmount, pkSk->dwAffectFlag, iDur, 0, true, pkSk->lMaxHit);
-						GetSectree()->ForEachAround(f);
+						GetSectree()->ForEachAroundInRange(posTarget.x, posTarget.y, pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 				bAdded = true;
@@ -1686,7 +1825,7 @@ int CHARACTER::ComputeSkillAtPosition(DWORD dwVnum, const PIXEL_POSITION& posTar
 					if (GetSectree())
 					{
 						FuncSplashAffect f(this, posTarget.x, posTarget.y, pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn2, iAmount2, pkSk->dwAffectFlag2, iDur, 0, !bAdded, pkSk->lMaxHit);
-						GetSectree()->ForEachAround(f);
+						GetSectree()->ForEachAroundInRange(posTarget.x, posTarget.y, pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 				bAdded = true;
@@ -1713,7 +1852,7 @@ int CHARACTER::ComputeSkillAtPosition(DWORD dwVnum, const PIXEL_POSITION& posTar
 					if (GetSectree())
 					{
 						FuncSplashAffect f(this, posTarget.x, posTarget.y, pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn3, iAmount3, 0 /*pkSk->dwAffectFlag3*/, iDur, 0, !bAdded, pkSk->lMaxHit);
-						GetSectree()->ForEachAround(f);
+						GetSectree()->ForEachAroundInRange(posTarget.x, posTarget.y, pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 			}
@@ -1972,16 +2111,18 @@ int CHARACTER::ComputeSkill(DWORD dwVnum, LPCHARACTER pkVictim, BYTE bSkillLevel
 			int iAG = 0;
 			
 
-			FuncSplashDamage f(pkVictim->GetX(), pkVictim->GetY(), pkSk, this, iAmount, iAG, pkSk->lMaxHit, pkWeapon, m_bDisableCooltime, IsPC()?&m_SkillUseInfo[dwVnum]:NULL, GetSkillPower(dwVnum, bSkillLevel));
+			FuncSplashDamage f(pkVictim->GetX(), pkVictim->GetY(), pkSk, this, iAmount, iAG, pkSk->lMaxHit, pkWeapon, m_bDisableCooltime, IsPC()?&GetSkillUseInfo(dwVnum):NULL, GetSkillPower(dwVnum, bSkillLevel));
 			if (IS_SET(pkSk->dwFlag, SKILL_FLAG_SPLASH))
 			{
 				if (pkVictim->GetSectree())
-					pkVictim->GetSectree()->ForEachAround(f);
+					pkVictim->GetSectree()->ForEachAroundInRange(pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 			}
 			else
 			{
 				f(pkVictim);
 			}
+
+			f.Resolve();
 		}
 		else
 		{
@@ -1991,7 +2132,7 @@ int CHARACTER::ComputeSkill(DWORD dwVnum, LPCHARACTER pkVictim, BYTE bSkillLevel
 
 			if (IsPC())
 				if (!(dwVnum >= GUILD_SKILL_START && dwVnum <= GUILD_SKILL_END)) //  ų Ÿ ó  ʴ´.
-					if (!m_bDisableCooltime && !m_SkillUseInfo[dwVnum].HitOnce(dwVnum) && dwVnum != SKILL_MUYEONG)
+					if (!m_bDisableCooltime && !GetSkillUseInfo(dwVnum).HitOnce(dwVnum) && dwVnum != SKILL_MUYEONG)
 					{
 						return BATTLE_NONE;
 					}
@@ -2007,7 +2148,7 @@ int CHARACTER::ComputeSkill(DWORD dwVnum, LPCHARACTER pkVictim, BYTE bSkillLevel
 					if (pkVictim->GetSectree())
 					{
 						FuncSplashAffect f(this, pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn, iAmount, pkSk->dwAffectFlag, iDur, 0, true, pkSk->lMaxHit);
-						pkVictim->GetSectree()->ForEachAround(f);
+						pkVictim->GetSectree()->ForEachAroundInRange(pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 				bAdded = true;
@@ -2030,7 +2171,7 @@ int CHARACTER::ComputeSkill(DWORD dwVnum, LPCHARACTER pkVictim, BYTE bSkillLevel
 					if (pkVictim->GetSectree())
 					{
 						FuncSplashAffect f(this, pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn2, iAmount2, pkSk->dwAffectFlag2, iDur, 0, !bAdded, pkSk->lMaxHit);
-						pkVictim->GetSectree()->ForEachAround(f);
+						pkVictim->GetSectree()->ForEachAroundInRange(pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 
@@ -2060,7 +2201,7 @@ int CHARACTER::ComputeSkill(DWORD dwVnum, LPCHARACTER pkVictim, BYTE bSkillLevel
 					if (pkVictim->GetSectree())
 					{
 						FuncSplashAffect f(this, pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn3, iAmount3, /*pkSk->dwAffectFlag3*/ 0, iDur, 0, !bAdded, pkSk->lMaxHit);
-						pkVictim->GetSectree()->ForEachAround(f);
+						pkVictim->GetSectree()->ForEachAroundInRange(pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 
@@ -2216,7 +2357,7 @@ int CHARACTER::ComputeSkill(DWORD dwVnum, LPCHARACTER pkVictim, BYTE bSkillLevel
 					if (pkVictim->GetSectree())
 					{
 						FuncSplashAffect f(this, pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, pkSk->dwVnum, pkSk->bPointOn3, iAmount3, /*pkSk->dwAffectFlag3*/ 0, iDur, 0, !bAdded, pkSk->lMaxHit);
-						pkVictim->GetSectree()->ForEachAround(f);
+						pkVictim->GetSectree()->ForEachAroundInRange(pkVictim->GetX(), pkVictim->GetY(), pkSk->iSplashRange, SPATIAL_KIND_CHARACTER, f);
 					}
 				}
 
@@ -2306,7 +2447,7 @@ bool CHARACTER::UseSkill(DWORD dwVnum, LPCHARACTER pkVictim, bool bUseGrandMaste
 		return false;
 	// END_OF_MINING
 
-	m_SkillUseInfo[dwVnum].TargetVIDMap.clear();
+	GetSkillUseInfo(dwVnum).TargetVIDMap.clear();
 
 	if (pkSk->IsChargeSkill())
 	{
@@ -2321,7 +2462,7 @@ bool CHARACTER::UseSkill(DWORD dwVnum, LPCHARACTER pkVictim, bool bUseGrandMaste
 					return false;
 			}
 
-			m_SkillUseInfo[dwVnum].SetMainTargetVID(pkVictim->GetVID());
+			GetSkillUseInfo(dwVnum).SetMainTargetVID(pkVictim->GetVID());
 			// DASH  źȯ ݱ
 			ComputeSkill(dwVnum, pkVictim);
 			RemoveAffect(dwVnum);
@@ -2363,9 +2504,9 @@ bool CHARACTER::UseSkill(DWORD dwVnum, LPCHARACTER pkVictim, bool bUseGrandMaste
 
 	DWORD dwCur = get_dword_time();
 
-	if (dwVnum == SKILL_TERROR && m_SkillUseInfo[dwVnum].bUsed && m_SkillUseInfo[dwVnum].dwNextSkillUsableTime > dwCur )
+	if (dwVnum == SKILL_TERROR && GetSkillUseInfo(dwVnum).bUsed && GetSkillUseInfo(dwVnum).dwNextSkillUsableTime > dwCur )
 	{
-		sys_log(0, " SKILL_TERROR's Cooltime is not delta over %u", m_SkillUseInfo[dwVnum].dwNextSkillUsableTime  - dwCur );
+		sys_log(0, " SKILL_TERROR's Cooltime is not delta over %u", GetSkillUseInfo(dwVnum).dwNextSkillUsableTime  - dwCur );
 		return false;
 	}
 
@@ -2427,7 +2568,7 @@ bool CHARACTER::UseSkill(DWORD dwVnum, LPCHARACTER pkVictim, bool bUseGrandMaste
 	if (false == m_bDisableCooltime)
 	{
 		if (false == 
-				m_SkillUseInfo[dwVnum].UseSkill(
+				GetSkillUseInfo(dwVnum).UseSkill(
 					bUseGrandMaster,
 				   	(NULL != pkVictim && SKILL_HORSE_WILDATTACK != dwVnum) ? pkVictim->GetVID() : NULL,
 				   	ComputeCooltime(iCooltime * 1000),
@@ -2464,7 +2605,7 @@ bool CHARACTER::UseSkill(DWORD dwVnum, LPCHARACTER pkVictim, bool bUseGrandMaste
 
 int CHARACTER::GetUsedSkillMasterType(DWORD dwVnum)
 {
-	const TSkillUseInfo& rInfo = m_SkillUseInfo[dwVnum];
+	const TSkillUseInfo& rInfo = GetSkillUseInfo(dwVnum);
 
 	if (GetSkillMasterType(dwVnum) < SKILL_GRAND_MASTER)
 		return GetSkillMasterType(dwVnum);
@@ -2561,7 +2702,7 @@ EVENTFUNC(skill_muyoung_event)
 	FFindNearVictim f(ch, ch);
 	if (ch->GetSectree())
 	{
-		ch->GetSectree()->ForEachAround(f);
+		ch->GetSectree()->ForEachAroundKind(SPATIAL_KIND_CHARACTER, f);
 		// 2. Shoot!
 		if (f.GetVictim())
 		{
@@ -2696,44 +2837,24 @@ bool CHARACTER::CanUseMobSkill(unsigned int idx) const
 	return true;
 }
 
-EVENTINFO(mob_skill_event_info)
+void CHARACTER::UpdateMobSkillHit(DWORD dwPulse)
 {
-	DynamicCharacterPtr ch;
-	PIXEL_POSITION pos;
-	DWORD vnum;
-	int index;
-	BYTE level;
+	// ġ      Ƿ ĭ ȣ .
+	size_t i = 0;
 
-	mob_skill_event_info()
-	: ch()
-	, pos()
-	, vnum(0)
-	, index(0)
-	, level(0)
+	while (i < m_vec_kMobSkillHit.size())
 	{
-	}
-};
-
-EVENTFUNC(mob_skill_hit_event)
-{
-	mob_skill_event_info * info = dynamic_cast<mob_skill_event_info *>( event->info );
+		if (m_vec_kMobSkillHit[i].dwPulse > dwPulse)
+		{
+			++i;
+			continue;
+		}
 
-	if ( info == NULL )
-	{
-		sys_err( "mob_skill_event_info> <Factor> Null pointer" );
-		return 0;
-	}
+		TMobSkillHit kHit = m_vec_kMobSkillHit[i];
+		m_vec_kMobSkillHit.erase(m_vec_kMobSkillHit.begin() + i);
 
-	// <Factor>
-	LPCHARACTER ch = info->ch;
-	if (ch == NULL) {
-		return 0;
+		ComputeSkillAtPosition(kHit.dwVnum, kHit.pos, kHit.bLevel);
 	}
-
-	ch->ComputeSkillAtPosition(info->vnum, info->pos, info->level);
-	ch->m_mapMobSkillEvent.erase(info->index);
-
-	return 0;
 }
 
 bool CHARACTER::UseMobSkill(unsigned int idx)
@@ -2785,23 +2906,24 @@ bool CHARACTER::UseMobSkill(unsigned int idx)
 			if (test_server)
 				sys_log(0, "               timing %ums", rInfo.dwTiming);
 
-			mob_skill_event_info* info = AllocEventInfo<mob_skill_event_info>();
+			TMobSkillHit kHit;
 
-			info->ch = this;
-			info->pos = pos;
-			info->level = pInfo->bSkillLevel;
-			info->vnum = dwVnum;
-			info->index = i;
+			kHit.dwPulse = thecore_pulse() + MAX(1, PASSES_PER_SEC(rInfo.dwTiming) / 1000);
+			kHit.pos = pos;
+			kHit.dwVnum = dwVnum;
+			kHit.bLevel = pInfo->bSkillLevel;
+			kHit.index = i;
 
-			// <Factor> Cancel existing event first
-			itertype(m_mapMobSkillEvent) it = m_mapMobSkillEvent.find(i);
-			if (it != m_mapMobSkillEvent.end()) {
-				LPEVENT existing = it->second;
-				event_cancel(&existing);
-				m_mapMobSkillEvent.erase(it);
-			}
+			//        ٲ۴
+			size_t j = 0;
+
+			while (j < m_vec_kMobSkillHit.size() && m_vec_kMobSkillHit[j].index != i)
+				++j;
+
+			if (j < m_vec_kMobSkillHit.size())
+				m_vec_kMobSkillHit.erase(m_vec_kMobSkillHit.begin() + j);
 
-			m_mapMobSkillEvent.insert(std::make_pair(i, event_create(mob_skill_hit_event, info, PASSES_PER_SEC(rInfo.dwTiming) / 1000)));
+			m_vec_kMobSkillHit.push_back(kHit);
 		}
 		else
 		{
@@ -3354,15 +3476,15 @@ bool CHARACTER::CanUseSkill(DWORD dwSkillVnum) const
 
 bool CHARACTER::CheckSkillHitCount(const BYTE SkillID, const VID TargetVID)
 {
-	std::map<int, TSkillUseInfo>::iterator iter = m_SkillUseInfo.find(SkillID);
+	TSkillUseInfo * pkSkillUseInfo = FindSkillUseInfo(SkillID);
 
-	if (iter == m_SkillUseInfo.end())
+	if (!pkSkillUseInfo)
 	{
 		sys_log(0, "SkillHack: Skill(%u) is not in container", SkillID);
 		return false;
 	}
 
-	TSkillUseInfo& rSkillUseInfo = iter->second;
+	TSkillUseInfo& rSkillUseInfo = *pkSkillUseInfo;
 
 	if (false == rSkillUseInfo.bUsed)
 	{
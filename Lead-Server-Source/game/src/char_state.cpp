@@ -24,6 +24,10 @@
 
 #include "common/VnumHelper.h"
 
+#ifdef __PET_SYSTEM__
+#include "PetSystem.h"
+#endif
+
 BOOL g_test_server;
 extern LPCHARACTER FindVictim(LPCHARACTER pkChr, int iMaxDistance);
 
@@ -516,7 +520,7 @@ void CHARACTER::__StateIdle_NPC()
 			FuncFindGuardVictim f(this, 50000);
 
 			if (GetSectree())
-				GetSectree()->ForEachAround(f);
+				GetSectree()->ForEachAroundKind(SPATIAL_KIND_NPC, f);
 
 			LPCHARACTER victim = f.GetVictim();
 
@@ -1130,7 +1134,7 @@ void CHARACTER::StateFlag()
 		return;
 
 	FuncFindChrForFlag f(this);
-	GetSectree()->ForEachAround(f);
+	GetSectree()->ForEachAroundKind(SPATIAL_KIND_PC, f);
 
 	if (!f.m_pkChrFind)
 		return;
@@ -1158,7 +1162,31 @@ void CHARACTER::StateFlagBase()
 	m_dwStateDuration = (DWORD) PASSES_PER_SEC(0.5);
 
 	FuncFindChrForFlagBase f(this);
-	GetSectree()->ForEachAround(f);
+	GetSectree()->ForEachAroundKind(SPATIAL_KIND_PC, f);
+}
+
+//  START_FOLLOW Ÿ ̸ 󰣴.   ڷ 
+//   ʾ(     )  ̵ ٽ  ʴ´.
+bool CHARACTER::FollowOwner(LPCHARACTER pkOwner, float fStartFollowDist, int iMinApproach, int iMaxApproach)
+{
+	const float REPATH_DISTANCE = 150.0f;		//  ̸ŭ   
+
+	// ٴϴ  Follow  (Return) ʵ Ѵ.
+	SetLastAttacked(get_dword_time());
+
+	float fDist = DISTANCE_APPROX(GetX() - pkOwner->GetX(), GetY() - pkOwner->GetY());
+
+	if (fDist < fStartFollowDist)
+		return false;
+
+	if (DISTANCE_APPROX(pkOwner->GetX() - m_posFollowOwner.x, pkOwner->GetY() - m_posFollowOwner.y) < REPATH_DISTANCE)
+		return false;
+
+	if (!Follow(pkOwner, number(iMinApproach, iMaxApproach)))
+		return false;
+
+	m_posFollowOwner = pkOwner->GetXYZ();
+	return true;
 }
 
 void CHARACTER::StateHorse()
@@ -1187,8 +1215,6 @@ void CHARACTER::StateHorse()
 		return;
 	}
 
-	m_pkMobInst->m_posLastAttacked = GetXYZ();
-
 	float fDist = DISTANCE_APPROX(GetX() - victim->GetX(), GetY() - victim->GetY());
 
 	if (fDist >= START_FOLLOW_DISTANCE)
@@ -1196,9 +1222,7 @@ void CHARACTER::StateHorse()
 		if (fDist > START_RUN_DISTANCE)
 			SetNowWalking(!bRun);		// NOTE: Լ ̸ ߴ° ˾Ҵµ SetNowWalking(false) ϸ ٴ°.. -_-;
 
-		Follow(victim, number(MIN_APPROACH, MAX_APPROACH));
-
-		m_dwStateDuration = STATE_DURATION;
+		FollowOwner(victim, START_FOLLOW_DISTANCE, MIN_APPROACH, MAX_APPROACH);
 	}
 	else if (bDoMoveAlone && (get_dword_time() > m_dwLastAttackTime))
 	{
@@ -1224,3 +1248,17 @@ void CHARACTER::StateHorse()
 	}
 }
 
+
+#ifdef __PET_SYSTEM__
+void CHARACTER::StatePet()
+{
+	m_dwStateDuration = (DWORD) PASSES_PER_SEC(0.4);
+
+	// Ͱ   ȯ ʿ Ѵ.
+	if (!m_pkPetActor)
+		return;
+
+	//   ⼭    ִ(  ).
+	m_pkPetActor->Update(0);
+}
+#endif
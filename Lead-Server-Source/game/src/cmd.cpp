@@ -224,12 +224,32 @@ ACMD (do_ds_list);
 ACMD (do_clear_affect);
 
 ACMD(do_free_regen);
+ACMD(do_view_memory);
+ACMD(do_packet_stat);
+ACMD(do_traffic);
+ACMD(do_mem_stat);
+ACMD(do_pulse_stat);
+ACMD(do_packet_capture);
+ACMD(do_profiler);
+ACMD(do_event_stat);
+ACMD(do_quest_profile);
+ACMD(do_server_timer_list);
 
 struct command_info cmd_info[] =
 {
 	{ "!RESERVED!",	NULL,			0,			POS_DEAD,	GM_IMPLEMENTOR	},
 	{ "who",		do_who,			0,			POS_DEAD,	GM_IMPLEMENTOR	},
 	{ "free_regens",	do_free_regen,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "view_memory",	do_view_memory,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "packet_stat",	do_packet_stat,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "traffic",		do_traffic,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "mem_stat",		do_mem_stat,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "pulse_stat",		do_pulse_stat,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "packet_capture",	do_packet_capture,	0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "profiler",		do_profiler,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "event_stat",		do_event_stat,		0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "quest_profile",	do_quest_profile,	0,			POS_DEAD,	GM_IMPLEMENTOR	},
+	{ "server_timer_list",	do_server_timer_list,	0,			POS_DEAD,	GM_HIGH_WIZARD	},
 	{ "war",		do_war,			0,			POS_DEAD,	GM_PLAYER	},
 	{ "warp",		do_warp,		0,			POS_DEAD,	GM_LOW_WIZARD	},
 	{ "user",		do_user,		0,			POS_DEAD,	GM_HIGH_WIZARD	},
@@ -32,6 +32,10 @@
 #include "log.h"
 #include "unique_item.h"
 #include "DragonSoul.h"
+#include "pulse_stat.h"
+#include "mem_stat.h"
+#include "packet_capture.h"
+#include "profiler.h"
 
 extern bool DropEvent_RefineBox_SetValue(const std::string& name, int value);
 
@@ -1082,29 +1086,26 @@ void SendNotice(const char * c_pszBuf)
 	std::for_each(c_ref_set.begin(), c_ref_set.end(), notice_packet_func(c_pszBuf));
 }
 
-struct notice_map_packet_func
+// OX ó   ʿ  Ŷ  ѹ   ش.
+static std::vector<LPDESC> s_vecNoticeMapRelay;
+
+void SendNoticeMap(const char* c_pszBuf, int nMapIndex, bool bBigFont)
 {
-	const char* m_str;
-	int m_mapIndex;
-	bool m_bBigFont;
+	const DESC_MANAGER::DESC_SET & c_ref_set = DESC_MANAGER::instance().GetMapChatSet(nMapIndex);
 
-	notice_map_packet_func(const char* str, int idx, bool bBigFont) : m_str(str), m_mapIndex(idx), m_bBigFont(bBigFont)
-	{
-	}
+	s_vecNoticeMapRelay.clear();
 
-	void operator() (LPDESC d)
+	for (DESC_MANAGER::DESC_SET::const_iterator it = c_ref_set.begin(); it != c_ref_set.end(); ++it)
 	{
-		if (d->GetCharacter() == NULL) return;
-		if (d->GetCharacter()->GetMapIndex() != m_mapIndex) return;
+		LPDESC d = *it;
+
+		if (d->GetCharacter() == NULL) continue;
+		if (d->GetCharacter()->GetMapIndex() != nMapIndex) continue;
 
-		d->GetCharacter()->ChatPacket(m_bBigFont == true ? CHAT_TYPE_BIG_NOTICE : CHAT_TYPE_NOTICE, LC_TEXT("%s"), m_str);
+		s_vecNoticeMapRelay.push_back(d);
 	}
-};
 
-void SendNoticeMap(const char* c_pszBuf, int nMapIndex, bool bBigFont)
-{
-	const DESC_MANAGER::DESC_SET & c_ref_set = DESC_MANAGER::instance().GetClientSet();
-	std::for_each(c_ref_set.begin(), c_ref_set.end(), notice_map_packet_func(c_pszBuf, nMapIndex, bBigFont));
+	DESC_MANAGER::instance().RelayChat(s_vecNoticeMapRelay, bBigFont == true ? CHAT_TYPE_BIG_NOTICE : CHAT_TYPE_NOTICE, c_pszBuf);
 }
 
 struct log_packet_func
@@ -1172,6 +1173,7 @@ ACMD(do_who)
 
 	ch->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("Total [%d] %d / %d / %d (this server %d)"), 
 			iTotal, paiEmpireUserCount[1], paiEmpireUserCount[2], paiEmpireUserCount[3], iLocal);
+	ch->ChatPacket(CHAT_TYPE_INFO, "All channels %d", DESC_MANAGER::instance().GetClusterUserCount());
 }
 
 class user_func
@@ -1672,7 +1674,7 @@ ACMD(do_qf)
 	if (!*arg1)
 		return;
 
-	quest::PC* pPC = quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+	quest::PC* pPC = quest::CQuestManager::instance().GetPCForce(ch);
 	std::string questname = pPC->GetCurrentQuestName();
 
 	if (!questname.empty())
@@ -2047,17 +2049,11 @@ ACMD(do_reload)
 					else
 						ch->ChatPacket(CHAT_TYPE_INFO, "reload success: ETCDropItem: %s", szETCDropItemFileName);
 
+					//  ɸ   ٸ 忡 а,    ˷ش.
 					ch->ChatPacket(CHAT_TYPE_INFO, "Reloading: SpecialItemGroup: %s", szSpecialItemGroupFileName);
-					if (!ITEM_MANAGER::instance().ReadSpecialDropItemFile(szSpecialItemGroupFileName))
-						ch->ChatPacket(CHAT_TYPE_INFO, "failed to reload SpecialItemGroup: %s", szSpecialItemGroupFileName);
-					else
-						ch->ChatPacket(CHAT_TYPE_INFO, "reload success: SpecialItemGroup: %s", szSpecialItemGroupFileName);
-
 					ch->ChatPacket(CHAT_TYPE_INFO, "Reloading: MOBDropItemFile: %s", szMOBDropItemFileName);
-					if (!ITEM_MANAGER::instance().ReadMonsterDropItemGroup(szMOBDropItemFileName))
-						ch->ChatPacket(CHAT_TYPE_INFO, "failed to reload MOBDropItemFile: %s", szMOBDropItemFileName);
-					else
-						ch->ChatPacket(CHAT_TYPE_INFO, "reload success: MOBDropItemFile: %s", szMOBDropItemFileName);
+					if (!ITEM_MANAGER::instance().RequestDropTableReload(szSpecialItemGroupFileName, szMOBDropItemFileName, ch->GetPlayerID()))
+						ch->ChatPacket(CHAT_TYPE_INFO, "SpecialItemGroup and MOBDropItemFile are already being reloaded");
 
 					ch->ChatPacket(CHAT_TYPE_INFO, "Reloading: CommonDropItem: %s", szCommonDropItemFileName);
 					if (!ITEM_MANAGER::instance().ReadCommonDropItemFile(szCommonDropItemFileName))
@@ -2237,7 +2233,7 @@ ACMD(do_weaken)
 	if (*arg1 && !strcmp(arg1, "all"))
 		func.m_bAll = true;
 
-	ch->GetSectree()->ForEachAround(func);
+	ch->GetSectree()->ForEachAroundKind(SPATIAL_KIND_CHARACTER, func);
 }
 
 ACMD(do_getqf)
@@ -2278,7 +2274,7 @@ ACMD(do_set_state)
 	if (!*arg1 || !*arg2)
 		return;
 
-	quest::PC* pPC = quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+	quest::PC* pPC = quest::CQuestManager::instance().GetPCForce(ch);
 	std::string questname = arg1;
 	std::string statename = arg2;
 
@@ -3096,7 +3092,7 @@ ACMD(do_clear_quest)
 	if (!*arg1)
 		return;
 
-	quest::PC* pPC = quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+	quest::PC* pPC = quest::CQuestManager::instance().GetPCForce(ch);
 	pPC->ClearQuest(arg1);
 }
 
@@ -3237,7 +3233,7 @@ ACMD(do_affect_remove)
 		ch->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("-- Affect List of %s -------------------------------"), tch->GetName());
 		ch->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("Type Point Modif Duration Flag"));
 
-		const std::list<CAffect *> & cont = tch->GetAffectContainer();
+		const std::vector<CAffect *> & cont = tch->GetAffectContainer();
 
 		itertype(cont) it = cont.begin();
 
@@ -4197,6 +4193,274 @@ ACMD (do_ds_list)
 	}
 }
 
+struct FCountViewMemory
+{
+	size_t m_entities;
+	size_t m_views;
+	size_t m_bytes;
+
+	FCountViewMemory() : m_entities(0), m_views(0), m_bytes(0)
+	{
+	}
+
+	void operator () (LPENTITY ent)
+	{
+		++m_entities;
+		m_views += ent->GetViewCount();
+		m_bytes += ent->GetViewMemoryUsage();
+	}
+};
+
+ACMD(do_view_memory)
+{
+	char arg1[256];
+	one_argument(argument, arg1, sizeof(arg1));
+
+	long lMapIndex = ch->GetMapIndex();
+
+	if (*arg1)
+		str_to_number(lMapIndex, arg1);
+
+	LPSECTREE_MAP pSecMap = SECTREE_MANAGER::instance().GetMap(lMapIndex);
+
+	if (!pSecMap)
+	{
+		ch->ChatPacket(CHAT_TYPE_INFO, "no map %ld", lMapIndex);
+		return;
+	}
+
+	FCountViewMemory f;
+	pSecMap->for_each(f);
+
+	ch->ChatPacket(CHAT_TYPE_INFO, "map %ld: entities %u views %u memory %u KB",
+			lMapIndex, (unsigned int) f.m_entities, (unsigned int) f.m_views, (unsigned int) (f.m_bytes / 1024));
+}
+
+// /pulse_stat [reset]
+ACMD(do_pulse_stat)
+{
+	char arg1[256];
+	one_argument(argument, arg1, sizeof(arg1));
+
+	pulse_stat_print(ch);
+
+	if (!strcmp(arg1, "reset"))
+	{
+		pulse_stat_reset();
+		ch->ChatPacket(CHAT_TYPE_INFO, "pulse stat reset");
+	}
+}
+
+// /mem_stat [reset] : reset  ִ밪   ǵ.
+ACMD(do_mem_stat)
+{
+	char arg1[256];
+	one_argument(argument, arg1, sizeof(arg1));
+
+	mem_stat_update();
+	mem_stat_print(ch);
+
+	if (!strcmp(arg1, "reset"))
+	{
+		mem_stat_reset_peak();
+		ch->ChatPacket(CHAT_TYPE_INFO, "mem stat peak reset");
+	}
+}
+
+// /packet_capture [start <file>|stop]
+//  ھ ޴ Ŭ̾Ʈ Ŷ file  . LoadBot -p  Ѵ.
+ACMD(do_packet_capture)
+{
+	char arg1[256], arg2[256];
+	two_arguments(argument, arg1, sizeof(arg1), arg2, sizeof(arg2));
+
+	if (!strcmp(arg1, "start"))
+	{
+		if (!*arg2)
+		{
+			ch->ChatPacket(CHAT_TYPE_INFO, "Usage: packet_capture start <file>");
+			return;
+		}
+
+		if (!packet_capture_open(arg2))
+		{
+			ch->ChatPacket(CHAT_TYPE_INFO, "cannot open %s", arg2);
+			return;
+		}
+	}
+	else if (!strcmp(arg1, "stop"))
+		packet_capture_close();
+
+	packet_capture_print(ch);
+}
+
+// /profiler [on|off|reset|dump]
+// dump  profile.folded  flamegraph.pl Է  .
+ACMD(do_profiler)
+{
+	char arg1[256];
+	one_argument(argument, arg1, sizeof(arg1));
+
+	CProfiler & rkProfiler = CProfiler::instance();
+
+	if (!strcmp(arg1, "on"))
+		rkProfiler.Enable(true);
+	else if (!strcmp(arg1, "off"))
+		rkProfiler.Enable(false);
+	else if (!strcmp(arg1, "reset"))
+		rkProfiler.Reset();
+	else if (!strcmp(arg1, "dump"))
+	{
+		if (rkProfiler.Dump("profile.folded"))
+			ch->ChatPacket(CHAT_TYPE_INFO, "profile written to profile.folded");
+	}
+
+	rkProfiler.Print(ch);
+}
+
+// /event_stat [reset|log]
+//  ð ū ̺Ʈ Լ 20   ش. log  θ syslog  .
+ACMD(do_event_stat)
+{
+	char arg1[256];
+	one_argument(argument, arg1, sizeof(arg1));
+
+	if (!strcmp(arg1, "log"))
+	{
+		event_log_func_stat();
+		ch->ChatPacket(CHAT_TYPE_INFO, "event stat written to syslog");
+		return;
+	}
+
+	std::vector<TEventFuncStat> vec;
+	event_get_func_stat(vec);
+
+	ch->ChatPacket(CHAT_TYPE_INFO, "%-32s %10s %10s %8s %6s", "event", "calls", "ms", "max us", "live");
+
+	for (size_t i = 0; i < vec.size() && i < 20; ++i)
+	{
+		const TEventFuncStat & rStat = vec[i];
+		ch->ChatPacket(CHAT_TYPE_INFO, "%-32s %10u %10u %8u %6u",
+				rStat.name, rStat.calls, (DWORD) (rStat.usec / 1000), rStat.max_usec, rStat.live);
+	}
+
+	if (!strcmp(arg1, "reset"))
+	{
+		event_reset_func_stat();
+		ch->ChatPacket(CHAT_TYPE_INFO, "event stat reset");
+	}
+}
+
+ACMD(do_packet_stat)
+{
+	char arg1[256];
+	one_argument(argument, arg1, sizeof(arg1));
+
+	if (!strcmp(arg1, "reset"))
+	{
+		CInputProcessor::ResetPacketStat();
+		ch->ChatPacket(CHAT_TYPE_INFO, "packet stat reset");
+		return;
+	}
+
+	if (!strcmp(arg1, "log"))
+	{
+		CInputProcessor::LogPacketStat();
+		ch->ChatPacket(CHAT_TYPE_INFO, "packet stat written to syslog");
+		return;
+	}
+
+	int iCount = 10;
+
+	if (*arg1)
+		str_to_number(iCount, arg1);
+
+	CInputProcessor::LogPacketStat(ch, MAX(1, iCount));
+}
+
+// /traffic [desc|packet] [count]
+// /traffic reset :  踦 . Ằ     ´.
+ACMD(do_traffic)
+{
+	char arg1[256], arg2[256];
+	two_arguments(argument, arg1, sizeof(arg1), arg2, sizeof(arg2));
+
+	if (!strcmp(arg1, "reset"))
+	{
+		DESC_MANAGER::instance().ResetOutputPacketStat();
+		ch->ChatPacket(CHAT_TYPE_INFO, "output packet stat reset");
+		return;
+	}
+
+	int iCount = 10;
+
+	if (*arg2)
+		str_to_number(iCount, arg2);
+
+	iCount = MAX(1, iCount);
+
+	if (!*arg1 || !strcmp(arg1, "desc"))
+	{
+		ch->ChatPacket(CHAT_TYPE_INFO, "-- connections by in + out bytes/s");
+		DESC_MANAGER::instance().LogDescTraffic(ch, iCount);
+	}
+
+	if (!*arg1 || !strcmp(arg1, "packet"))
+	{
+		ch->ChatPacket(CHAT_TYPE_INFO, "-- outbound packet headers by bytes/s");
+		DESC_MANAGER::instance().LogOutputPacketStat(ch, iCount);
+	}
+}
+
+// /quest_profile on|off|reset|dump [filename]
+ACMD(do_quest_profile)
+{
+	char arg1[256];
+	char arg2[256];
+	two_arguments(argument, arg1, sizeof(arg1), arg2, sizeof(arg2));
+
+	quest::CQuestManager & q = quest::CQuestManager::instance();
+
+	if (!strcmp(arg1, "on"))
+	{
+		q.StartProfile();
+		ch->ChatPacket(CHAT_TYPE_INFO, "quest profile on");
+	}
+	else if (!strcmp(arg1, "off"))
+	{
+		q.StopProfile();
+		ch->ChatPacket(CHAT_TYPE_INFO, "quest profile off");
+	}
+	else if (!strcmp(arg1, "reset"))
+	{
+		q.ResetProfile();
+		ch->ChatPacket(CHAT_TYPE_INFO, "quest profile reset");
+	}
+	else if (!strcmp(arg1, "dump"))
+	{
+		const char * c_pszFileName = *arg2 ? arg2 : "quest_profile.txt";
+
+		//  丮 ۿ  ʴ´.
+		if (strchr(c_pszFileName, '/') || strchr(c_pszFileName, '\\'))
+		{
+			ch->ChatPacket(CHAT_TYPE_INFO, "file name only, no path");
+			return;
+		}
+
+		if (q.DumpProfile(c_pszFileName))
+			ch->ChatPacket(CHAT_TYPE_INFO, "quest profile written to %s", c_pszFileName);
+		else
+			ch->ChatPacket(CHAT_TYPE_INFO, "cannot write %s", c_pszFileName);
+	}
+	else
+		ch->ChatPacket(CHAT_TYPE_INFO, "usage: quest_profile on|off|reset|dump [filename] (now %s)", q.IsProfiling() ? "on" : "off");
+}
+
+ACMD(do_server_timer_list)
+{
+	quest::CQuestManager::instance().SendServerTimerList(ch);
+}
+
 ACMD(do_free_regen)
 {
 	ch->ChatPacket(CHAT_TYPE_INFO, "freeing regens on mapindex %ld", ch->GetMapIndex());
@@ -51,6 +51,11 @@ BYTE		g_bAuthServer = false;
 string		g_stAuthMasterIP;
 WORD		g_wAuthMasterPort = 0;
 
+int			g_iAuthSQLPoolSize = 4;	//  ȸ  SQL  . 0 ̸ ⺻   .
+int			g_iAuthCacheTTL = 30;	//    ٽ ȸ ʰ ޾ִ . 0 ̸ .
+int			g_iAuthShardIndex = 0;	//      α Ű ġ ʵ  .
+int			g_iAuthShardCount = 1;
+
 static std::set<DWORD> s_set_dwFileCRC;
 static std::set<DWORD> s_set_dwProcessCRC;
 
@@ -88,6 +93,40 @@ bool		g_bCheckMultiHack = true;
 
 int			g_iSpamBlockMaxLevel = 10;
 
+int			g_iPacketCompressThreshold = 1024;	//  ũ ̻ Ŷ Ѵ. 0 ̸  
+int			g_iP2PBatchCompressThreshold = 4096;	// P2P ġ  ũ ̸̻ Ѵ. 0 ̸  
+bool			g_bBulkMovePacket = true;	//  pulse  ̵ Ŷ HEADER_GC_MOVE_BULK   .
+bool			g_bPackedPacket = true;	// HEADER_CG_PROTOCOL_VERSION   Ŭ̾Ʈ  Ŷ varint  ٿ .
+bool			g_bBulkPointPacket = true;	//  pulse    Ŷ HEADER_GC_CHARACTER_POINT_CHANGE_BULK   .
+bool			g_bBulkDamagePacket = true;	//  pulse    Ŷ HEADER_GC_DAMAGE_INFO_BULK   .
+bool			g_bBulkCharacterAddPacket = true;	// ̾  ĳ ߰ Ŷ HEADER_GC_CHARACTER_ADD_BULK   .
+int			g_iWarBroadcastInterval = 500;	//  /ο   (ms)  . 0 ̸ ٷ 
+bool			g_bBulkMessengerStatus = true;	//  pulse  ģ    ޴   Ŷ ϳ .
+int			g_iLogBatchRows = 100;		// α INSERT ϳ  ִ  
+bool			g_bQuestGCManaged = false;	// Ʈ lua GC  ޽  ð Ѵ.
+int			g_iQuestGCStepKB = 1024;	//  ̸ŭ ø GC 
+int			g_iQuestGCBudgetUsec = 5000;	// ޽ ̸ŭ ƾ GC Ѵ.
+std::string	g_stAttrSnapshotDir;	// Ǯ  server_attr   丮  ΰ  ÿ Ѵ.    ʴ´
+int			g_iMapLoadThreadCount = 4;	//   server_attr  ̸ŭ   д´. 1 ̸ ʷ д´
+int			g_iPathNodeBudget = 20000;	//  pulse    ã ġ ִ  . 0 ̸  ã⸦  ʴ´
+int			g_iMetricsPort = 0;		//  ġ Ʈ (Prometheus ). 0 ̸  ʴ´
+std::string	g_stMetricsIP = "127.0.0.1";
+int			g_iPulseStatInterval = 60;	//  () pulse_stat.txt   ׷ . 0 ̸  ʴ´
+int			g_iRegenSpawnBudget = 50;	//  pulse   ⿭ ϴ ִ . 0 ̸ ̺Ʈ ٷ Ѵ
+bool			g_bComputePointsCheck = false;	// affect  κ    ComputePoints  Ѵ (׿)
+int			g_iLogQueueLimit = 1000;	// α DB ť   ̸ŭ̸  α׸ . 0 ̸  
+std::string	g_stPacketCaptureFile;		// ϸ鼭 Ŭ̾Ʈ Ŷ ĸĸ  Ϸ Ѵ.    ʴ´
+int			g_iLoginThrottleBurst = 0;	//  IP  ޾   ִ  . 0 ̸  ʴ´
+int			g_iLoginThrottlePerMin = 30;	//  IP   뷮 д ̸ŭ ٽ 
+int			g_iMaxHalfOpen = 0;		// ڵũ ġ   ִ . 0 ̸  ʴ´
+int			g_iMaxHalfOpenPerIP = 0;	//  IP  ڵũ ġ   ִ . 0 ̸  ʴ´
+int			g_iListenBacklog = 0;		// Ŭ̾Ʈ Ʈ listen backlog. 0 ̸ SOMAXCONN
+bool			g_bReusePort = false;		// Ŭ̾Ʈ Ʈ SO_REUSEPORT  Ҵ.
+int			g_iViewLODRange = 0;		//  Ÿ  viewer Դ ̵ Ŷ g_iViewLODInterval    . 0 ̸  
+int			g_iViewLODInterval = 3;
+int			g_iSaveMaxPerPulse = 10;		// ֱ   pulse  ̸ŭ Ѵ.   pulse  ̷. 0 ̸  
+bool			g_bWarpHandoff = true;		//   , Ʈ, Ʈ  ھ P2P  Ѱ DB ε Ѵ.
+
 void		LoadStateUserCount();
 void		LoadValidCRCList();
 bool            g_protectNormalPlayer   = false;        // ڰ "ȭ"  Ϲ  
@@ -165,6 +204,28 @@ void map_allow_copy(long * pl, int size)
 	}
 }
 
+// ʺ view_lod_map .  view_lod  .
+static std::map<long, std::pair<int, int> > s_map_ViewLOD;
+
+void view_lod_get(long lMapIndex, int * piRange, int * piInterval)
+{
+	// νϽ     .
+	if (lMapIndex >= 10000)
+		lMapIndex /= 10000;
+
+	std::map<long, std::pair<int, int> >::const_iterator it = s_map_ViewLOD.find(lMapIndex);
+
+	if (it == s_map_ViewLOD.end())
+	{
+		*piRange = g_iViewLODRange;
+		*piInterval = g_iViewLODInterval;
+		return;
+	}
+
+	*piRange = it->second.first;
+	*piInterval = it->second.second;
+}
+
 static void FN_add_adminpageIP(char *line)
 {
 	char	*last;
@@ -696,6 +757,23 @@ void config_init(const string& st_localeServiceName)
 			continue;
 		}
 
+		TOKEN("log_async_queue")
+		{
+			int i = 0;
+			str_to_number(i, value_string);
+			log_set_async_queue_size(MINMAX(0, i, 65536));
+			fprintf(stdout, "LOG_ASYNC_QUEUE: %d\n", i);
+			continue;
+		}
+
+		TOKEN("log_async_overflow")
+		{
+			// drop: ť    (⺻), block: ڸ   ٸ
+			log_set_async_overflow(!strcasecmp(value_string, "block") ? LOG_ASYNC_OVERFLOW_BLOCK : LOG_ASYNC_OVERFLOW_DROP);
+			fprintf(stdout, "LOG_ASYNC_OVERFLOW: %s\n", value_string);
+			continue;
+		}
+
 		TOKEN("passes_per_sec")
 		{
 			str_to_number(passes_per_sec, value_string);
@@ -862,6 +940,41 @@ void config_init(const string& st_localeServiceName)
 			continue;
 		}
 
+		TOKEN("auth_sql_pool")
+		{
+			str_to_number(g_iAuthSQLPoolSize, value_string);
+			g_iAuthSQLPoolSize = MINMAX(0, g_iAuthSQLPoolSize, 32);
+			fprintf(stdout, "AUTH_SQL_POOL: %d\n", g_iAuthSQLPoolSize);
+			continue;
+		}
+
+		TOKEN("auth_cache_ttl")
+		{
+			str_to_number(g_iAuthCacheTTL, value_string);
+			fprintf(stdout, "AUTH_CACHE_TTL: %d\n", g_iAuthCacheTTL);
+			continue;
+		}
+
+		TOKEN("auth_shard")
+		{
+			char szIndex[32];
+			char szCount[32];
+
+			two_arguments(value_string, szIndex, sizeof(szIndex), szCount, sizeof(szCount));
+
+			str_to_number(g_iAuthShardIndex, szIndex);
+			str_to_number(g_iAuthShardCount, szCount);
+
+			if (g_iAuthShardCount < 1 || g_iAuthShardIndex < 0 || g_iAuthShardIndex >= g_iAuthShardCount)
+			{
+				fprintf(stderr, "AUTH_SHARD: syntax error: <index> <count> (0 <= index < count)\n");
+				exit(1);
+			}
+
+			fprintf(stdout, "AUTH_SHARD: %d / %d\n", g_iAuthShardIndex, g_iAuthShardCount);
+			continue;
+		}
+
 		TOKEN("quest_dir")
 		{
 			sys_log(0, "QUEST_DIR SETTING : %s", value_string);
@@ -940,6 +1053,210 @@ void config_init(const string& st_localeServiceName)
 		{
 			str_to_number(g_iSpamBlockMaxLevel, value_string);
 		}
+		TOKEN("packet_compress_threshold")
+		{
+			str_to_number(g_iPacketCompressThreshold, value_string);
+			fprintf(stdout, "PACKET_COMPRESS_THRESHOLD: %d\n", g_iPacketCompressThreshold);
+		}
+		TOKEN("p2p_batch_compress_threshold")
+		{
+			str_to_number(g_iP2PBatchCompressThreshold, value_string);
+			fprintf(stdout, "P2P_BATCH_COMPRESS_THRESHOLD: %d\n", g_iP2PBatchCompressThreshold);
+		}
+		TOKEN("bulk_move_packet")
+		{
+			str_to_number(g_bBulkMovePacket, value_string);
+			fprintf(stdout, "BULK_MOVE_PACKET: %d\n", g_bBulkMovePacket);
+		}
+
+		TOKEN("packed_packet")
+		{
+			str_to_number(g_bPackedPacket, value_string);
+			fprintf(stdout, "PACKED_PACKET: %d\n", g_bPackedPacket);
+		}
+
+		TOKEN("bulk_point_packet")
+		{
+			str_to_number(g_bBulkPointPacket, value_string);
+			fprintf(stdout, "BULK_POINT_PACKET: %d\n", g_bBulkPointPacket);
+		}
+
+		TOKEN("bulk_damage_packet")
+		{
+			str_to_number(g_bBulkDamagePacket, value_string);
+			fprintf(stdout, "BULK_DAMAGE_PACKET: %d\n", g_bBulkDamagePacket);
+		}
+
+		TOKEN("bulk_character_add_packet")
+		{
+			str_to_number(g_bBulkCharacterAddPacket, value_string);
+			fprintf(stdout, "BULK_CHARACTER_ADD_PACKET: %d\n", g_bBulkCharacterAddPacket);
+		}
+
+		TOKEN("bulk_messenger_status")
+		{
+			str_to_number(g_bBulkMessengerStatus, value_string);
+			fprintf(stdout, "BULK_MESSENGER_STATUS: %d\n", g_bBulkMessengerStatus);
+		}
+
+		TOKEN("view_lod")
+		{
+			sscanf(value_string, " %d %d ", &g_iViewLODRange, &g_iViewLODInterval);
+			g_iViewLODRange = MAX(0, g_iViewLODRange);
+			g_iViewLODInterval = MINMAX(1, g_iViewLODInterval, 100);
+			fprintf(stdout, "VIEW_LOD: range %d interval %d\n", g_iViewLODRange, g_iViewLODInterval);
+		}
+
+		TOKEN("view_lod_map")
+		{
+			long lMapIndex = 0;
+			int iRange = 0, iInterval = 1;
+
+			if (sscanf(value_string, " %ld %d %d ", &lMapIndex, &iRange, &iInterval) != 3)
+			{
+				fprintf(stderr, "VIEW_LOD_MAP: usage view_lod_map: <map index> <range> <interval>\n");
+				continue;
+			}
+
+			iRange = MAX(0, iRange);
+			iInterval = MINMAX(1, iInterval, 100);
+			s_map_ViewLOD[lMapIndex] = std::make_pair(iRange, iInterval);
+			fprintf(stdout, "VIEW_LOD_MAP: map %ld range %d interval %d\n", lMapIndex, iRange, iInterval);
+		}
+
+		TOKEN("warp_handoff")
+		{
+			str_to_number(g_bWarpHandoff, value_string);
+			fprintf(stdout, "WARP_HANDOFF: %d\n", g_bWarpHandoff);
+		}
+
+		TOKEN("save_max_per_pulse")
+		{
+			str_to_number(g_iSaveMaxPerPulse, value_string);
+			g_iSaveMaxPerPulse = MAX(0, g_iSaveMaxPerPulse);
+			fprintf(stdout, "SAVE_MAX_PER_PULSE: %d\n", g_iSaveMaxPerPulse);
+		}
+
+		TOKEN("war_broadcast_interval")
+		{
+			str_to_number(g_iWarBroadcastInterval, value_string);
+			g_iWarBroadcastInterval = MINMAX(0, g_iWarBroadcastInterval, 10000);
+			fprintf(stdout, "WAR_BROADCAST_INTERVAL: %d\n", g_iWarBroadcastInterval);
+		}
+		TOKEN("map_load_thread")
+		{
+			str_to_number(g_iMapLoadThreadCount, value_string);
+			g_iMapLoadThreadCount = MINMAX(1, g_iMapLoadThreadCount, 32);
+			fprintf(stdout, "MAP_LOAD_THREAD: %d\n", g_iMapLoadThreadCount);
+		}
+
+		TOKEN("attr_snapshot_dir")
+		{
+			g_stAttrSnapshotDir = value_string;
+			fprintf(stdout, "ATTR_SNAPSHOT_DIR: %s\n", g_stAttrSnapshotDir.c_str());
+		}
+
+		TOKEN("path_node_budget")
+		{
+			str_to_number(g_iPathNodeBudget, value_string);
+			g_iPathNodeBudget = MAX(0, g_iPathNodeBudget);
+			fprintf(stdout, "PATH_NODE_BUDGET: %d\n", g_iPathNodeBudget);
+		}
+
+		TOKEN("metrics_port")
+		{
+			str_to_number(g_iMetricsPort, value_string);
+			fprintf(stdout, "METRICS_PORT: %d\n", g_iMetricsPort);
+		}
+
+		TOKEN("metrics_ip")
+		{
+			g_stMetricsIP = value_string;
+			fprintf(stdout, "METRICS_IP: %s\n", g_stMetricsIP.c_str());
+		}
+
+		TOKEN("pulse_stat_interval")
+		{
+			str_to_number(g_iPulseStatInterval, value_string);
+			g_iPulseStatInterval = MAX(0, g_iPulseStatInterval);
+			fprintf(stdout, "PULSE_STAT_INTERVAL: %d\n", g_iPulseStatInterval);
+		}
+
+		TOKEN("packet_capture")
+		{
+			g_stPacketCaptureFile = value_string;
+			fprintf(stdout, "PACKET_CAPTURE: %s\n", g_stPacketCaptureFile.c_str());
+		}
+
+		TOKEN("regen_spawn_budget")
+		{
+			str_to_number(g_iRegenSpawnBudget, value_string);
+			g_iRegenSpawnBudget = MAX(0, g_iRegenSpawnBudget);
+			fprintf(stdout, "REGEN_SPAWN_BUDGET: %d\n", g_iRegenSpawnBudget);
+		}
+
+		TOKEN("log_batch_rows")
+		{
+			str_to_number(g_iLogBatchRows, value_string);
+			g_iLogBatchRows = MINMAX(1, g_iLogBatchRows, 1000);
+			fprintf(stdout, "LOG_BATCH_ROWS: %d\n", g_iLogBatchRows);
+		}
+		TOKEN("login_throttle_burst")
+		{
+			str_to_number(g_iLoginThrottleBurst, value_string);
+			fprintf(stdout, "LOGIN_THROTTLE_BURST: %d\n", g_iLoginThrottleBurst);
+		}
+		TOKEN("login_throttle_per_min")
+		{
+			str_to_number(g_iLoginThrottlePerMin, value_string);
+			fprintf(stdout, "LOGIN_THROTTLE_PER_MIN: %d\n", g_iLoginThrottlePerMin);
+		}
+		TOKEN("max_half_open")
+		{
+			str_to_number(g_iMaxHalfOpen, value_string);
+			fprintf(stdout, "MAX_HALF_OPEN: %d\n", g_iMaxHalfOpen);
+		}
+		TOKEN("max_half_open_per_ip")
+		{
+			str_to_number(g_iMaxHalfOpenPerIP, value_string);
+			fprintf(stdout, "MAX_HALF_OPEN_PER_IP: %d\n", g_iMaxHalfOpenPerIP);
+		}
+		TOKEN("listen_backlog")
+		{
+			str_to_number(g_iListenBacklog, value_string);
+			fprintf(stdout, "LISTEN_BACKLOG: %d\n", g_iListenBacklog);
+		}
+		TOKEN("reuse_port")
+		{
+			g_bReusePort = is_string_true(value_string);
+			fprintf(stdout, "REUSE_PORT: %d\n", g_bReusePort);
+		}
+		TOKEN("log_queue_limit")
+		{
+			str_to_number(g_iLogQueueLimit, value_string);
+			fprintf(stdout, "LOG_QUEUE_LIMIT: %d\n", g_iLogQueueLimit);
+		}
+		TOKEN("quest_gc_managed")
+		{
+			g_bQuestGCManaged = is_string_true(value_string);
+			fprintf(stdout, "QUEST_GC_MANAGED: %s\n", g_bQuestGCManaged ? "on" : "off");
+		}
+		TOKEN("quest_gc_step_kb")
+		{
+			str_to_number(g_iQuestGCStepKB, value_string);
+			g_iQuestGCStepKB = MAX(64, g_iQuestGCStepKB);
+			fprintf(stdout, "QUEST_GC_STEP_KB: %d\n", g_iQuestGCStepKB);
+		}
+		TOKEN("quest_gc_budget_usec")
+		{
+			str_to_number(g_iQuestGCBudgetUsec, value_string);
+			fprintf(stdout, "QUEST_GC_BUDGET_USEC: %d\n", g_iQuestGCBudgetUsec);
+		}
+		TOKEN("compute_points_check")
+		{
+			g_bComputePointsCheck = is_string_true(value_string);
+			fprintf(stdout, "COMPUTE_POINTS_CHECK: %s\n", g_bComputePointsCheck ? "on" : "off");
+		}
 		TOKEN("protect_normal_player")
 		{
 			str_to_number(g_protectNormalPlayer, value_string);
@@ -30,6 +30,7 @@ extern bool	g_bNoRegen;
 extern BYTE	g_bChannel;
 
 extern bool	map_allow_find(int index);
+extern void	view_lod_get(long lMapIndex, int * piRange, int * piInterval);
 extern void	map_allow_copy(long * pl, int size);
 extern bool	no_wander;
 
@@ -57,6 +58,10 @@ extern void		LoadStateUserCount();
 extern bool	g_bEmpireWhisper;
 
 extern BYTE	g_bAuthServer;
+extern int	g_iAuthSQLPoolSize;
+extern int	g_iAuthCacheTTL;
+extern int	g_iAuthShardIndex;
+extern int	g_iAuthShardCount;
 
 extern BYTE	PK_PROTECT_LEVEL;
 
@@ -102,5 +107,39 @@ extern int g_SkillBookExp;
 
 extern bool g_BlockCharCreation;
 
+extern int g_iPacketCompressThreshold;
+extern int g_iP2PBatchCompressThreshold;
+extern bool g_bBulkMovePacket;
+extern bool g_bPackedPacket;
+extern bool g_bBulkPointPacket;
+extern bool g_bBulkDamagePacket;
+extern bool g_bBulkCharacterAddPacket;
+extern bool g_bBulkMessengerStatus;
+extern int g_iWarBroadcastInterval;
+extern int g_iLogBatchRows;
+extern int g_iLogQueueLimit;
+extern bool g_bQuestGCManaged;
+extern int g_iQuestGCStepKB;
+extern int g_iQuestGCBudgetUsec;
+extern bool g_bComputePointsCheck;
+extern int g_iMapLoadThreadCount;
+extern std::string g_stAttrSnapshotDir;
+extern int g_iPathNodeBudget;
+extern int g_iRegenSpawnBudget;
+extern int g_iPulseStatInterval;
+extern int g_iMetricsPort;
+extern std::string g_stMetricsIP;
+extern std::string g_stPacketCaptureFile;
+extern int g_iLoginThrottleBurst;
+extern int g_iLoginThrottlePerMin;
+extern int g_iMaxHalfOpen;
+extern int g_iMaxHalfOpenPerIP;
+extern int g_iListenBacklog;
+extern int g_iViewLODRange;
+extern int g_iViewLODInterval;
+extern bool g_bWarpHandoff;
+extern int g_iSaveMaxPerPulse;
+extern bool g_bReusePort;
+
 #endif /* __INC_METIN_II_GAME_CONFIG_H__ */
 
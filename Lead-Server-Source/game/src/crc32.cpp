@@ -54,10 +54,58 @@ static unsigned long CRCTable[256] =
 #define DO8(buf, i)	DO4(buf, i); DO4(buf, i + 4);
 #define DO16(buf, i)	DO8(buf, i); DO8(buf, i + 8);
 
+//   8Ʈ óϴ slice-by-8 ̺. s_aaCRCTable8[0]  CRCTable  .
+// SSE4.2  crc32  ٸ ׽(CRC-32C)̶  ޶Ƿ  ʴ´.
+static crc_t s_aaCRCTable8[8][256];
+static unsigned char s_abUpper[256];
+static bool s_isCRCTable8Ready = false;
+
+// ٸ  ü ڿ ҷ ̺    Ʈ óѴ.
+static struct SCRCTable8Initializer
+{
+	SCRCTable8Initializer()
+	{
+		for (int i = 0; i < 256; ++i)
+		{
+			s_aaCRCTable8[0][i] = CRCTable[i];
+			s_abUpper[i] = (unsigned char) UPPER(i);
+		}
+
+		for (int k = 1; k < 8; ++k)
+			for (int i = 0; i < 256; ++i)
+				s_aaCRCTable8[k][i] = (s_aaCRCTable8[k - 1][i] >> 8) ^ s_aaCRCTable8[0][s_aaCRCTable8[k - 1][i] & 0xff];
+
+		s_isCRCTable8Ready = true;
+	}
+} s_kCRCTable8Initializer;
+
+#define SLICE8(b0, b1, b2, b3, b4, b5, b6, b7) \
+	{ \
+		crc_t lo = crc ^ ((crc_t) (b0) | ((crc_t) (b1) << 8) | ((crc_t) (b2) << 16) | ((crc_t) (b3) << 24)); \
+		crc = s_aaCRCTable8[7][lo & 0xff] ^ s_aaCRCTable8[6][(lo >> 8) & 0xff] ^ \
+			s_aaCRCTable8[5][(lo >> 16) & 0xff] ^ s_aaCRCTable8[4][lo >> 24] ^ \
+			s_aaCRCTable8[3][(unsigned char) (b4)] ^ s_aaCRCTable8[2][(unsigned char) (b5)] ^ \
+			s_aaCRCTable8[1][(unsigned char) (b6)] ^ s_aaCRCTable8[0][(unsigned char) (b7)]; \
+	}
+
 crc_t GetCRC32(const char * buf, size_t len)
 {
 	crc_t crc = 0xffffffff;
 
+	if (s_isCRCTable8Ready)
+	{
+		const unsigned char * p = (const unsigned char *) buf;
+
+		while (len >= 8)
+		{
+			SLICE8(p[0], p[1], p[2], p[3], p[4], p[5], p[6], p[7]);
+			p += 8;
+			len -= 8;
+		}
+
+		buf = (const char *) p;
+	}
+
 	if (16 <= len)
 	{
 		do
@@ -94,6 +142,21 @@ crc_t GetCaseCRC32(const char * buf, size_t len)
 {
 	crc_t crc = 0xffffffff;
 
+	if (s_isCRCTable8Ready)
+	{
+		const unsigned char * p = (const unsigned char *) buf;
+		const unsigned char * u = s_abUpper;
+
+		while (len >= 8)
+		{
+			SLICE8(u[p[0]], u[p[1]], u[p[2]], u[p[3]], u[p[4]], u[p[5]], u[p[6]], u[p[7]]);
+			p += 8;
+			len -= 8;
+		}
+
+		buf = (const char *) p;
+	}
+
 	if (16 <= len)
 	{
 		do
@@ -33,6 +33,13 @@ extern int test_server;
 static std::vector<CUBE_DATA*>	s_cube_proto;
 static bool s_isInitializedCubeMaterialInformation = false;
 
+// (NPC,  vnum ) ñ״ó ->  . ؽ 浹 can_make_item  ɷ.
+typedef std::vector<CUBE_DATA*>							TCubeDataList;
+typedef boost::unordered_map<DWORD, TCubeDataList>		TCubeDataMap;
+
+static TCubeDataMap	s_cube_by_signature;
+static TCubeDataMap	s_cube_by_npc;
+
 
 
 /*--------------------------------------------------------*/
@@ -81,7 +88,7 @@ struct SItemNameAndLevel
 // ڷᱸ ̷ ΰ ...  ȥ  ¿ 
 typedef std::vector<SCubeMaterialInfo>								TCubeResultList;
 typedef boost::unordered_map<DWORD, TCubeResultList>				TCubeMapByNPC;				//  NPC     ְ ᰡ ...
-typedef boost::unordered_map<DWORD, std::string>					TCubeResultInfoTextByNPC;	//  NPC   ִ     
+typedef boost::unordered_map<DWORD, std::string>					TCubeResultInfoTextByNPC;	//  NPC  "cube r_list ..."  ü ̸   
 
 TCubeMapByNPC cube_info_map;
 TCubeResultInfoTextByNPC cube_result_info_map_by_npc;				// ̹  Ű 
@@ -145,32 +152,97 @@ static void FN_remove_material (LPITEM *items, DWORD item_vnum, int need_count)
 }
 
 
-static CUBE_DATA* FN_find_cube (LPITEM *items, WORD npc_vnum)
+// , ߺ ŵ  vnum ϰ NPC   ñ״ó . (FNV-1a)
+static DWORD FN_cube_signature (WORD npc_vnum, DWORD *vnums, int count)
 {
-	DWORD	i, end_index;
+	std::sort(vnums, vnums + count);
+	count = std::unique(vnums, vnums + count) - vnums;
 
-	if (0==npc_vnum)	return NULL;
+	DWORD signature = 2166136261u;
 
-	// FOR ALL CUBE_PROTO
-	end_index = s_cube_proto.size();
-	for (i=0; i<end_index; ++i)
+	signature = (signature ^ npc_vnum) * 16777619u;
+
+	for (int i = 0; i < count; ++i)
+		signature = (signature ^ vnums[i]) * 16777619u;
+
+	return signature;
+}
+
+static void FN_build_cube_index ()
+{
+	s_cube_by_signature.clear();
+	s_cube_by_npc.clear();
+
+	for (DWORD i = 0; i < s_cube_proto.size(); ++i)
 	{
-		if ( s_cube_proto[i]->can_make_item(items, npc_vnum) )
-			return s_cube_proto[i];
+		CUBE_DATA * cube_data = s_cube_proto[i];
+		std::vector<DWORD> vnums;
+
+		for (DWORD j = 0; j < cube_data->item.size(); ++j)
+			vnums.push_back(cube_data->item[j].vnum);
+
+		for (DWORD j = 0; j < cube_data->npc_vnum.size(); ++j)
+		{
+			WORD npc_vnum = cube_data->npc_vnum[j];
+			std::vector<DWORD> sorted(vnums);
+
+			s_cube_by_signature[FN_cube_signature(npc_vnum, sorted.empty() ? NULL : &sorted[0], sorted.size())].push_back(cube_data);
+
+			TCubeDataList & npc_list = s_cube_by_npc[npc_vnum];
+
+			if (npc_list.empty() || npc_list.back() != cube_data)
+				npc_list.push_back(cube_data);
+		}
 	}
 
-	return NULL;
+	sys_log(0, "CUBE: indexed %u recipes, %u signatures, %u npcs",
+			s_cube_proto.size(), s_cube_by_signature.size(), s_cube_by_npc.size());
 }
 
-static bool FN_check_valid_npc( WORD vnum )
+static CUBE_DATA* FN_find_cube (LPITEM *items, WORD npc_vnum)
 {
-	for ( std::vector<CUBE_DATA*>::iterator iter = s_cube_proto.begin(); iter != s_cube_proto.end(); iter++ )
+	if (0==npc_vnum)	return NULL;
+
+	// ÷       Ȯ  찡 κ̹Ƿ
+	// ñ״ó ϳ ĺ ã  ȮѴ.
+	DWORD	vnums[CUBE_MAX_NUM];
+	int		count = 0;
+
+	for (int i=0; i<CUBE_MAX_NUM; ++i)
 	{
-		if ( std::find((*iter)->npc_vnum.begin(), (*iter)->npc_vnum.end(), vnum) != (*iter)->npc_vnum.end() )
-			return true;
+		if (NULL != items[i])
+			vnums[count++] = items[i]->GetVnum();
 	}
 
-	return false;
+	TCubeDataMap::iterator it = s_cube_by_signature.find(FN_cube_signature(npc_vnum, vnums, count));
+
+	if (it != s_cube_by_signature.end())
+	{
+		for (TCubeDataList::iterator iter = it->second.begin(); iter != it->second.end(); ++iter)
+		{
+			if ((*iter)->can_make_item(items, npc_vnum))
+				return *iter;
+		}
+	}
+
+	// ʿ  ᰡ   ñ״ó ޶Ƿ ش NPC  ո  ˻Ѵ.
+	it = s_cube_by_npc.find(npc_vnum);
+
+	if (it == s_cube_by_npc.end())
+		return NULL;
+
+	for (TCubeDataList::iterator iter = it->second.begin(); iter != it->second.end(); ++iter)
+	{
+		if ((*iter)->can_make_item(items, npc_vnum))
+			return *iter;
+	}
+
+	return NULL;
+}
+
+static bool FN_check_valid_npc( WORD vnum )
+{
+	return s_cube_by_npc.find(vnum) != s_cube_by_npc.end();
 }
 
 // ť굥Ÿ ùٸ ʱȭ Ǿ üũѴ.
@@ -379,6 +451,8 @@ void Cube_init()
 	}
 
 	s_cube_proto.clear();
+	s_cube_by_signature.clear();
+	s_cube_by_npc.clear();
 
 	if (false == Cube_load(file_name))
 		sys_err("Cube_Init failed");
@@ -467,6 +541,8 @@ bool Cube_load (const char *file)
 	}
 
 	fclose(fp);
+
+	FN_build_cube_index();
 	return true;
 }
 
@@ -797,6 +873,31 @@ void Cube_MakeCubeInformationText()
 
 			//sys_err("\t\tNPC: %d, Reward: %d(%s)\n\t\t\tInfo: %s", npcVNUM, materialInfo.reward.vnum, ITEM_MANAGER::Instance().GetTable(materialInfo.reward.vnum)->szName, materialInfo.infoText.c_str());
 		} // for resultList
+
+		// NPC      ̸  д.
+		// (Server -> Client) /cube r_list npcVNUM resultCount vnum1,count1/vnum2,count2,/vnum3,count3/...
+		std::string resultText;
+
+		for (TCubeResultList::const_iterator resultIter = resultList.begin(); resultList.end() != resultIter; ++resultIter)
+		{
+			char temp[128];
+			snprintf(temp, sizeof(temp), "%s%d,%d", resultText.empty() ? "" : "/", resultIter->reward.vnum, resultIter->reward.count);
+			resultText += temp;
+		}
+
+		size_t resultCount = resultList.size();
+
+		// ä Ŷ Ѱ踦 Ѿ  ... ȹ е  ش޶ ûϰų, ߿ ٸ  ٲٰų...
+		if (resultText.size() + 20 >= CHAT_MAX_LEN)
+		{
+			sys_err("[CubeInfo] Too long cube result list text. (NPC: %d, length: %d)", npcVNUM, resultText.size());
+			resultText.clear();
+			resultCount = 0;
+		}
+
+		char command[CHAT_MAX_LEN + 1];
+		snprintf(command, sizeof(command), "cube r_list %u %u %s", npcVNUM, resultCount, resultText.c_str());
+		cube_result_info_map_by_npc[npcVNUM] = command;
 	} // for npc
 }
 
@@ -904,44 +1005,19 @@ void Cube_request_result_list(LPCHARACTER ch)
 		return;
 
 	DWORD npcVNUM = npc->GetRaceNum();
-	size_t resultCount = 0;
 
-	std::string& resultText = cube_result_info_map_by_npc[npcVNUM];
+	//  NPC   ִ ۵  Ʒ  Ѵ.
+	//  ڿ Cube_MakeCubeInformationText  NPC  ̸  д.
+	// (Server -> Client) /cube r_list 20383 4 123,1/125,1/128,1/130,5
+	TCubeResultInfoTextByNPC::const_iterator it = cube_result_info_map_by_npc.find(npcVNUM);
 
-	// ش NPC   ִ    ٸ ĳø 
-	if (resultText.length() == 0)
+	if (cube_result_info_map_by_npc.end() == it)
 	{
-		resultText.clear();
-
-		const TCubeResultList& resultList = cube_info_map[npcVNUM];
-		for (TCubeResultList::const_iterator iter = resultList.begin(); resultList.end() != iter; ++iter)
-		{
-			const SCubeMaterialInfo& materialInfo = *iter;
-			char temp[128];
-			sprintf(temp, "%d,%d", materialInfo.reward.vnum, materialInfo.reward.count);
-
-			resultText += std::string(temp) + "/";
-		}
-
-		resultCount = resultList.size();
-
-		resultText.erase(resultText.size() - 1);
-
-		// ä Ŷ Ѱ踦 Ѿ  ... ȹ е  ش޶ ûϰų, ߿ ٸ  ٲٰų...
-		if (resultText.size() - 20 >= CHAT_MAX_LEN)
-		{
-			sys_err("[CubeInfo] Too long cube result list text. (NPC: %d, length: %d)", npcVNUM, resultText.size());
-			resultText.clear();
-			resultCount = 0;
-		}
-
+		ch->ChatPacket(CHAT_TYPE_COMMAND, "cube r_list %u 0 ", npcVNUM);
+		return;
 	}
 
-	//  NPC   ִ ۵  Ʒ  Ѵ.
-	// (Server -> Client) /cube r_list npcVNUM resultCount vnum1,count1/vnum2,count2,/vnum3,count3/...
-	// (Server -> Client) /cube r_list 20383 4 123,1/125,1/128,1/130,5
-	
-	ch->ChatPacket(CHAT_TYPE_COMMAND, "cube r_list %d %d %s", npcVNUM, resultCount, resultText.c_str());
+	ch->ChatPacket(CHAT_TYPE_COMMAND, "%s", it->second.c_str());
 }
 
 // 
@@ -1,5 +1,10 @@
 ﻿#include "stdafx.h"
 #include <sstream>
+#ifdef __FreeBSD__
+#include <md5.h>
+#else
+#include "../../libthecore/include/xmd5.h"
+#endif
 #include "common/length.h"
 
 #include "db.h"
@@ -19,12 +24,180 @@
 
 extern std::string g_stBlockDate;
 
+static const size_t AUTH_CACHE_MAX_COUNT = 8192;	// 이 이상 쌓이면 만료된 것부터 비운다
+
 DBManager::DBManager() : m_bIsConnect(false)
 {
+	for (size_t i = 0; i < sizeof(m_abAuthCacheSalt); ++i)
+		m_abAuthCacheSalt[i] = number(0, 255);
 }
 
 DBManager::~DBManager()
 {
+	for (size_t i = 0; i < m_vec_pkAuthSQL.size(); ++i)
+		M2_DELETE(m_vec_pkAuthSQL[i]);
+
+	m_vec_pkAuthSQL.clear();
+}
+
+void DBManager::SetupAuthSQLPool(int iCount)
+{
+	for (int i = 0; i < iCount; ++i)
+	{
+		CAsyncSQL * pkSQL = M2_NEW CAsyncSQL;
+
+		if (!pkSQL->Setup(&m_sql, false))
+		{
+			sys_err("cannot open auth sql connection %d", i);
+			M2_DELETE(pkSQL);
+			break;
+		}
+
+		m_vec_pkAuthSQL.push_back(pkSQL);
+	}
+
+	sys_log(0, "AUTH_SQL_POOL: %u connections", m_vec_pkAuthSQL.size());
+}
+
+void DBManager::AuthLoginQuery(const char * c_pszLogin, DWORD dwIdent, void * pvData, const char * c_pszFormat, ...)
+{
+	char szQuery[4096];
+	va_list args;
+
+	va_start(args, c_pszFormat);
+	vsnprintf(szQuery, sizeof(szQuery), c_pszFormat, args);
+	va_end(args);
+
+	CReturnQueryInfo * p = M2_NEW CReturnQueryInfo;
+
+	p->iQueryType = QUERY_TYPE_RETURN;
+	p->iType = QID_AUTH_LOGIN;
+	p->dwIdent = dwIdent;
+	p->pvData = pvData;
+
+	if (m_vec_pkAuthSQL.empty())
+	{
+		m_sql.ReturnQuery(szQuery, p);
+		return;
+	}
+
+	DWORD dwHash = 0;
+
+	for (const char * c = c_pszLogin; *c; ++c)
+		dwHash = dwHash * 31 + (BYTE) *c;
+
+	m_vec_pkAuthSQL[dwHash % m_vec_pkAuthSQL.size()]->ReturnQuery(szQuery, p);
+}
+
+void DBManager::MakePasswdDigest(const char * c_pszPasswd, BYTE * pbDigest)
+{
+	MD5_CTX ctx;
+
+	MD5Init(&ctx);
+	MD5Update(&ctx, m_abAuthCacheSalt, sizeof(m_abAuthCacheSalt));
+	MD5Update(&ctx, (const unsigned char *) c_pszPasswd, strlen(c_pszPasswd));
+	MD5Final(pbDigest, &ctx);
+}
+
+const TAuthCacheEntry * DBManager::FindAuthCache(const char * c_pszLogin, const char * c_pszPasswd)
+{
+	if (g_iAuthCacheTTL <= 0)
+		return NULL;
+
+	std::map<std::string, TAuthCacheEntry>::iterator it = m_map_authCache.find(c_pszLogin);
+
+	if (it == m_map_authCache.end())
+		return NULL;
+
+	if (it->second.tExpire < get_global_time())
+	{
+		m_map_authCache.erase(it);
+		return NULL;
+	}
+
+	BYTE abDigest[16];
+	MakePasswdDigest(c_pszPasswd, abDigest);
+
+	if (memcmp(abDigest, it->second.abPasswdDigest, sizeof(abDigest)))
+		return NULL;
+
+	return &it->second;
+}
+
+void DBManager::InsertAuthCache(const char * c_pszLogin, const char * c_pszPasswd, DWORD dwID, const char * c_pszSocialID, const int * paiPremiumTimes,
+		BYTE bNotAvail, const char * c_pszStatus, const char * c_pszCreateDate)
+{
+	if (g_iAuthCacheTTL <= 0)
+		return;
+
+	if (m_map_authCache.size() >= AUTH_CACHE_MAX_COUNT)
+	{
+		time_t now = get_global_time();
+		std::map<std::string, TAuthCacheEntry>::iterator it = m_map_authCache.begin();
+
+		while (it != m_map_authCache.end())
+		{
+			if (it->second.tExpire < now)
+				m_map_authCache.erase(it++);
+			else
+				++it;
+		}
+
+		if (m_map_authCache.size() >= AUTH_CACHE_MAX_COUNT)
+			m_map_authCache.clear();
+	}
+
+	TAuthCacheEntry & r = m_map_authCache[c_pszLogin];
+
+	r.dwID = dwID;
+	strlcpy(r.szSocialID, c_pszSocialID, sizeof(r.szSocialID));
+	thecore_memcpy(r.aiPremiumTimes, paiPremiumTimes, sizeof(r.aiPremiumTimes));
+	MakePasswdDigest(c_pszPasswd, r.abPasswdDigest);
+	r.bNotAvail = bNotAvail;
+	strlcpy(r.szStatus, c_pszStatus, sizeof(r.szStatus));
+	strlcpy(r.szCreateDate, c_pszCreateDate, sizeof(r.szCreateDate));
+	r.tExpire = get_global_time() + g_iAuthCacheTTL;
+}
+
+void DBManager::EraseAuthCache(const char * c_pszLogin)
+{
+	m_map_authCache.erase(c_pszLogin);
+}
+
+// account 를 읽은 결과로 로그인을 막아야 하면 그 사유를 돌려준다. 캐시로 받아줄 때도 같은 검사를 거친다.
+const char * DBManager::CheckAuthLogin(const char * c_pszLogin, BYTE bNotAvail, const char * c_pszStatus, const char * c_pszCreateDate)
+{
+	if (bNotAvail)
+		return "NOTAVAIL";
+
+	if (DESC_MANAGER::instance().FindByLoginName(c_pszLogin))
+		return "ALREADY";
+
+	if (strcmp(c_pszStatus, "OK"))
+		return c_pszStatus;
+
+	if (strncmp(c_pszCreateDate, g_stBlockDate.c_str(), 8) >= 0)
+		return "BLKLOGIN";
+
+	return NULL;
+}
+
+void DBManager::AuthLoginSuccess(LPDESC d, const char * c_pszLogin, const char * c_pszPasswd, DWORD * pdwClientKey, DWORD dwID, const char * c_pszSocialID, int * paiPremiumTimes)
+{
+	// 메인 루프를 막지 않도록 비동기로 보낸다.
+	Query("UPDATE account SET last_play=NOW() WHERE id=%u", dwID);
+
+	TAccountTable & r = d->GetAccountTable();
+
+	r.id = dwID;
+	trim_and_lower(c_pszLogin, r.login, sizeof(r.login));
+	strlcpy(r.passwd, c_pszPasswd, sizeof(r.passwd));
+	strlcpy(r.social_id, c_pszSocialID, sizeof(r.social_id));
+	DESC_MANAGER::instance().ConnectAccount(r.login, d);
+
+	sys_log(0, "QID_AUTH_LOGIN: SUCCESS %s", c_pszLogin);
+
+	LoginPrepare(0, 0, 0, d, pdwClientKey, paiPremiumTimes);
 }
 
 bool DBManager::Connect(const char * host, const int port, const char * user, const char * pwd, const char * db)
@@ -99,6 +272,10 @@ SQLMsg * DBManager::PopResult()
 	if (m_sql.PopResult(&p))
 		return p;
 
+	for (size_t i = 0; i < m_vec_pkAuthSQL.size(); ++i)
+		if (m_vec_pkAuthSQL[i]->PopResult(&p))
+			return p;
+
 	return NULL;
 }
 
@@ -267,6 +444,11 @@ void DBManager::AnalyzeReturnQuery(SQLMsg * pMsg)
 
 				sys_log(0, "QID_AUTH_LOGIN: START %u %p", qi->dwIdent, get_pointer(d));
 
+				// DB 결과가 새로 왔으니 예전 캐시는 버리고 성공했을 때만 다시 넣는다.
+				char szCacheLogin[LOGIN_MAX_LEN + 1];
+				trim_and_lower(pinfo->login, szCacheLogin, sizeof(szCacheLogin));
+				EraseAuthCache(szCacheLogin);
+
 				if (pMsg->Get()->uiNumRows == 0)
 				{
 					sys_log(0, "   NOID");
@@ -373,57 +555,18 @@ void DBManager::AnalyzeReturnQuery(SQLMsg * pMsg)
 					}
 
 					int nPasswordDiff = strcmp(szEncrytPassword, szPassword);
+					const char * c_pszFailure = nPasswordDiff ? "WRONGPWD" : CheckAuthLogin(pinfo->login, bNotAvail, szStatus, szCreateDate);
 
-					if (nPasswordDiff)
-					{
-						LoginFailure(d, "WRONGPWD");
-						sys_log(0, "   WRONGPWD");
-						M2_DELETE(pinfo);
-					}
-					else if (bNotAvail)
+					if (c_pszFailure)
 					{
-						LoginFailure(d, "NOTAVAIL");
-						sys_log(0, "   NOTAVAIL");
-						M2_DELETE(pinfo);
-					}
-					else if (DESC_MANAGER::instance().FindByLoginName(pinfo->login))
-					{
-						LoginFailure(d, "ALREADY");
-						sys_log(0, "   ALREADY");
-						M2_DELETE(pinfo);
-					}
-					else if (strcmp(szStatus, "OK"))
-					{
-						LoginFailure(d, szStatus);
-						sys_log(0, "   STATUS: %s", szStatus);
+						LoginFailure(d, c_pszFailure);
+						sys_log(0, "   %s", c_pszFailure);
 						M2_DELETE(pinfo);
 					}
 					else
 					{
-						if (strncmp(szCreateDate, g_stBlockDate.c_str(), 8) >= 0)
-						{
-							LoginFailure(d, "BLKLOGIN");
-							sys_log(0, "   BLKLOGIN");
-							M2_DELETE(pinfo);
-							break;
-						}
-
-						char szQuery[1024];
-						snprintf(szQuery, sizeof(szQuery), "UPDATE account SET last_play=NOW() WHERE id=%u", dwID);
-						std::unique_ptr<SQLMsg> msg( DBManager::instance().DirectQuery(szQuery) );
-
-						TAccountTable & r = d->GetAccountTable();
-
-						r.id = dwID;
-						trim_and_lower(pinfo->login, r.login, sizeof(r.login));
-						strlcpy(r.passwd, pinfo->passwd, sizeof(r.passwd));
-						strlcpy(r.social_id, szSocialID, sizeof(r.social_id));
-						DESC_MANAGER::instance().ConnectAccount(r.login, d);
-
-
-						sys_log(0, "QID_AUTH_LOGIN: SUCCESS %s", pinfo->login);
-
-						LoginPrepare(0, 0, 0, d, pinfo->adwClientKey, aiPremiumTimes);
+						InsertAuthCache(szCacheLogin, pinfo->passwd, dwID, szSocialID, aiPremiumTimes, bNotAvail, szStatus, szCreateDate);
+						AuthLoginSuccess(d, pinfo->login, pinfo->passwd, pinfo->adwClientKey, dwID, szSocialID, aiPremiumTimes);
 						M2_DELETE(pinfo);
 					}
 				}
@@ -2,6 +2,7 @@
 #define __INC_METIN_II_DB_MANAGER_H__
 
 #include "../../libsql/AsyncSQL.h"
+#include "common/length.h"
 #include "any_function.h"
 
 enum
@@ -52,6 +53,19 @@ class CFuncAfterQueryInfo : public CQueryInfo
 
 class CLoginData;
 
+// ֱٿ   .  ó    ٽ   account ȸ ǳʶڴ.
+struct TAuthCacheEntry
+{
+	DWORD	dwID;
+	char	szSocialID[SOCIAL_ID_MAX_LEN + 1];
+	int	aiPremiumTimes[PREMIUM_MAX_NUM];
+	BYTE	abPasswdDigest[16];
+	BYTE	bNotAvail;
+	char	szStatus[ACCOUNT_STATUS_MAX_LEN + 1];
+	char	szCreateDate[8 + 1];
+	time_t	tExpire;
+};
+
 
 class DBManager : public singleton<DBManager>
 {
@@ -67,6 +81,17 @@ class DBManager : public singleton<DBManager>
 		SQLMsg *		DirectQuery(const char * c_pszFormat, ...);
 		void			ReturnQuery(int iType, DWORD dwIdent, void* pvData, const char * c_pszFormat, ...);
 
+		//     Ǯ.   ׻     ȴ.
+		void			SetupAuthSQLPool(int iCount);
+		void			AuthLoginQuery(const char * c_pszLogin, DWORD dwIdent, void * pvData, const char * c_pszFormat, ...);
+
+		const TAuthCacheEntry *	FindAuthCache(const char * c_pszLogin, const char * c_pszPasswd);
+		void			InsertAuthCache(const char * c_pszLogin, const char * c_pszPasswd, DWORD dwID, const char * c_pszSocialID, const int * paiPremiumTimes,
+						BYTE bNotAvail, const char * c_pszStatus, const char * c_pszCreateDate);
+		void			EraseAuthCache(const char * c_pszLogin);
+		const char *		CheckAuthLogin(const char * c_pszLogin, BYTE bNotAvail, const char * c_pszStatus, const char * c_pszCreateDate);
+		void			AuthLoginSuccess(LPDESC d, const char * c_pszLogin, const char * c_pszPasswd, DWORD * pdwClientKey, DWORD dwID, const char * c_pszSocialID, int * paiPremiumTimes);
+
 		void			Process();
 		void			AnalyzeReturnQuery(SQLMsg * pmsg);
 
@@ -94,13 +119,17 @@ class DBManager : public singleton<DBManager>
 
 	private:
 		SQLMsg *				PopResult();
+		void					MakePasswdDigest(const char * c_pszPasswd, BYTE * pbDigest);
 
 		CAsyncSQL				m_sql;
+		std::vector<CAsyncSQL *>		m_vec_pkAuthSQL;
 		CAsyncSQL				m_sql_direct;
 		bool					m_bIsConnect;
 
 		std::map<std::string, std::string>	m_map_dbstring;
 		std::map<DWORD, CLoginData *>		m_map_pkLoginData;
+		std::map<std::string, TAuthCacheEntry>	m_map_authCache;
+		BYTE					m_abAuthCacheSalt[16];
 };
 
 template <class Functor> void DBManager::FuncQuery(Functor f, const char* c_pszFormat, ...)
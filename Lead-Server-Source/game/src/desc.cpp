@@ -16,11 +16,19 @@
 #include "guild_manager.h"
 #include "locale_service.h"
 #include "log.h"
+#include "lzo_manager.h"
+#include "packet_capture.h"
+#include "common/varint.h"
 
 extern int max_bytes_written;
 extern int current_bytes_written;
 extern int total_bytes_written;
 
+static const size_t BULK_MOVE_MAX_COUNT = 256;	// HEADER_GC_MOVE_BULK 하나에 넣는 최대 이동 수
+static const size_t BULK_POINT_MAX_COUNT = 128;	// HEADER_GC_CHARACTER_POINT_CHANGE_BULK 하나에 넣는 최대 변경 수
+static const size_t BULK_DAMAGE_MAX_COUNT = 128;	// HEADER_GC_DAMAGE_INFO_BULK 하나에 넣는 최대 데미지 수
+static const size_t BULK_CHARACTER_ADD_MAX_COUNT = 128;	// HEADER_GC_CHARACTER_ADD_BULK 하나에 넣는 최대 캐릭터 수
+
 DESC::DESC()
 {
 	Initialize();
@@ -33,6 +41,19 @@ DESC::~DESC()
 void DESC::Initialize()
 {
 	m_bDestroyed = false;
+	m_bFlushRequested = false;
+	m_bPacketCompression = false;
+	m_bP2PBatchPending = false;
+	m_wProtocolVersion = PROTOCOL_VERSION_LEGACY;
+
+	memset(&m_kBulkMoveBase, 0, sizeof(m_kBulkMoveBase));
+	m_vec_kBulkMove.clear();
+	m_vec_kBulkPointChange.clear();
+	m_vec_kBulkDamage.clear();
+	m_vec_kBulkCharacterAdd.clear();
+
+	m_kTrafficIn.Reset();
+	m_kTrafficOut.Reset();
 
 	m_pInputProcessor = NULL;
 	m_lpFdw = NULL;
@@ -45,6 +66,7 @@ void DESC::Initialize()
 
 	m_lpInputBuffer = NULL;
 	m_iMinInputBufferLen = 0;
+	m_iDecryptedInputLen = 0;
 
 	m_dwHandshake = 0;
 	m_dwHandshakeSentTime = 0;
@@ -66,11 +88,20 @@ void DESC::Initialize()
 
 	m_wP2PPort = 0;
 	m_bP2PChannel = 0;
+	m_lP2PListenAddr = 0;
+	m_wP2PListenPort = 0;
 
 	m_bAdminMode = false;
 	m_bPong = true;
 	m_bChannelStatusRequested = false;
 
+	m_bSmallBuffer = false;
+	m_bHalfOpen = false;
+
+	m_bChatSubscribed = false;
+	m_bChatEmpire = 0;
+	m_lChatMapIndex = 0;
+
 	m_iCurrentSequence = 0;
 
 
@@ -101,8 +132,10 @@ void DESC::Destroy()
 	}
 	m_bDestroyed = true;
 
+	packet_capture_disconnect(this);
+
 	if (m_pkLoginKey)
-		m_pkLoginKey->Expire();
+		DESC_MANAGER::instance().ExpireLoginKey(m_pkLoginKey);
 
 	if (GetAccountTable().id)
 		DESC_MANAGER::instance().DisconnectAccount(GetAccountTable().login);
@@ -197,6 +230,17 @@ void DESC::SetPong(bool b)
 	m_bPong = b;
 }
 
+static void GrowBuffer(LPBUFFER & buffer, int iSize)
+{
+	if (buffer->mem_size >= iSize)
+		return;
+
+	LPBUFFER temp = buffer_new(iSize);
+	buffer_write(temp, buffer_read_peek(buffer), buffer_size(buffer));
+	buffer_delete(buffer);
+	buffer = temp;
+}
+
 bool DESC::Setup(LPFDWATCH _fdw, socket_t _fd, const struct sockaddr_in & c_rSockAddr, DWORD _handle, DWORD _handshake)
 {
 	m_lpFdw		= _fdw;
@@ -207,10 +251,13 @@ bool DESC::Setup(LPFDWATCH _fdw, socket_t _fd, const struct sockaddr_in & c_rSoc
 	m_dwHandle		= _handle;
 
 	//NOTE: 이걸 나라별로 다르게 잡아야할 이유가 있나?
-	m_lpOutputBuffer = buffer_new(DEFAULT_PACKET_BUFFER_SIZE * 2);
+	// 접속 폭주 때 핸드셰이크도 못 하는 접속마다 수백 KB 를 잡지 않도록 작게 시작한다.
+	// 핸드셰이크가 끝나 phase 가 바뀌면 GrowBuffers 에서 원래 크기로 늘린다.
+	m_lpOutputBuffer = buffer_new(HANDSHAKE_OUTPUT_BUFFER_SIZE);
 
-	m_iMinInputBufferLen = MAX_INPUT_LEN >> 1;
-	m_lpInputBuffer = buffer_new(MAX_INPUT_LEN);
+	m_iMinInputBufferLen = HANDSHAKE_INPUT_LEN >> 1;
+	m_lpInputBuffer = buffer_new(HANDSHAKE_INPUT_LEN);
+	m_bSmallBuffer = true;
 
 	m_SockAddr = c_rSockAddr;
 
@@ -248,6 +295,13 @@ int DESC::ProcessInput()
 		return -1;
 	}
 
+	if (!m_bSmallBuffer && m_lpInputBuffer->mem_size < MAX_INPUT_LEN)
+		GrowBuffer(m_lpInputBuffer, MAX_INPUT_LEN);
+
+	// 남은 공간이 모자랄 때만 아직 처리하지 못한 데이터를 앞으로 당긴다. 그래도 모자라면 늘린다.
+	if (buffer_has_space(m_lpInputBuffer) < m_iMinInputBufferLen)
+		buffer_compact(m_lpInputBuffer);
+
 	buffer_adjust_size(m_lpInputBuffer, m_iMinInputBufferLen);
 	bytes_read = socket_read(m_sock, (char *) buffer_write_peek(m_lpInputBuffer), buffer_has_space(m_lpInputBuffer));
 
@@ -257,6 +311,7 @@ int DESC::ProcessInput()
 		return 0;
 
 	buffer_write_proceed(m_lpInputBuffer, bytes_read);
+	m_kTrafficIn.AddBytes(bytes_read);
 
 	if (!m_pInputProcessor)
 		sys_err("no input processor");
@@ -272,51 +327,35 @@ int DESC::ProcessInput()
 		}
 
 		buffer_read_proceed(m_lpInputBuffer, iBytesProceed);
+		m_iDecryptedInputLen = 0;
 	}
 	else
 	{
-		int iSizeBuffer = buffer_size(m_lpInputBuffer);
+		// 입력 버퍼 안에서 바로 복호화하고 바로 처리한다. 복호화는 이미 풀어놓은 부분
+		// 뒤의 8바이트 단위만 한다. 8바이트 단위에 부족하면 잘못된 암호화 버퍼를 복호화
+		// 할 가능성이 있으므로 다음 read 까지 남겨둔다.
+		int iSizeCrypted = buffer_size(m_lpInputBuffer) - m_iDecryptedInputLen;
 
-		// 8바이트 단위로만 처리한다. 8바이트 단위에 부족하면 잘못된 암호화 버퍼를 복호화
-		// 할 가능성이 있으므로 짤라서 처리하기로 한다.
-		if (iSizeBuffer & 7) // & 7은 % 8과 같다. 2의 승수에서만 가능
-			iSizeBuffer -= iSizeBuffer & 7;
+		iSizeCrypted -= iSizeCrypted & 7; // & 7은 % 8과 같다. 2의 승수에서만 가능
 
-		if (iSizeBuffer > 0)
+		if (iSizeCrypted > 0)
 		{
-			auto lpBufferDecrypt = buffer_new(iSizeBuffer);
-
-			const int iSizeAfter = TEA_Decrypt(
-				static_cast<DWORD*>(buffer_write_peek(lpBufferDecrypt)),
-				static_cast<const DWORD*>(buffer_read_peek(m_lpInputBuffer)),
-				GetDecryptionKey(),
-				iSizeBuffer
-			);
-
-			buffer_write_proceed(lpBufferDecrypt, iSizeAfter);
-
-			int iBytesProceed = 0;
-
-			// false가 리턴 되면 다른 phase로 바뀐 것이므로 다시 프로세스로 돌입한다!
-			while (!m_pInputProcessor->Process(this, buffer_read_peek(lpBufferDecrypt), buffer_size(lpBufferDecrypt), iBytesProceed))
-			{
-				if (iBytesProceed > iSizeBuffer)
-				{
-					buffer_read_proceed(m_lpInputBuffer, iSizeBuffer);
-					iSizeBuffer = 0;
-					iBytesProceed = 0;
-					break;
-				}
-
-				buffer_read_proceed(m_lpInputBuffer, iBytesProceed);
-				iSizeBuffer -= iBytesProceed;
+			DWORD * pdwCrypted = (DWORD *) ((char *) buffer_read_peek(m_lpInputBuffer) + m_iDecryptedInputLen);
+			m_iDecryptedInputLen += TEA_Decrypt(pdwCrypted, pdwCrypted, GetDecryptionKey(), iSizeCrypted);
+		}
 
-				buffer_read_proceed(lpBufferDecrypt, iBytesProceed);
-				iBytesProceed = 0;
-			}
+		int iBytesProceed = 0;
 
+		// false가 리턴 되면 다른 phase로 바뀐 것이므로 다시 프로세스로 돌입한다!
+		while (m_iDecryptedInputLen > 0 && !m_pInputProcessor->Process(this, buffer_read_peek(m_lpInputBuffer), m_iDecryptedInputLen, iBytesProceed))
+		{
 			buffer_read_proceed(m_lpInputBuffer, iBytesProceed);
+			m_iDecryptedInputLen -= iBytesProceed;
+			iBytesProceed = 0;
 		}
+
+		buffer_read_proceed(m_lpInputBuffer, iBytesProceed);
+		m_iDecryptedInputLen -= iBytesProceed;
 	}
 
 	return (bytes_read);
@@ -327,28 +366,31 @@ int DESC::ProcessOutput()
 	if (buffer_size(m_lpOutputBuffer) <= 0)
 		return 0;
 
-	int buffer_left = fdwatch_get_buffer_size(m_lpFdw, m_sock);
-
-	if (buffer_left <= 0)
-		return 0;
+	// 소켓이 non-blocking 이므로 커널 버퍼 크기를 따로 묻지 않고 쌓인 것을 한번에 보낸다.
+	// 다 못 보낸 나머지는 다음 write 이벤트에서 이어서 보낸다.
+	int bytes_written = socket_write_tcp(m_sock, (const char *) buffer_read_peek(m_lpOutputBuffer), buffer_size(m_lpOutputBuffer));
+	int result = 0;
 
-	int bytes_to_write = MIN(buffer_left, buffer_size(m_lpOutputBuffer));
-
-	if (bytes_to_write == 0)
-		return 0;
-
-	int result = socket_write(m_sock, (const char *) buffer_read_peek(m_lpOutputBuffer), bytes_to_write);
-
-	if (result == 0)
+	if (bytes_written < 0)
+	{
+		sys_err("write to desc error");
+		result = -1;
+	}
+	else if (bytes_written == 0)
+	{
+		fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, true);
+	}
+	else
 	{
 		//sys_log(0, "%d bytes written to %s first %u", bytes_to_write, GetHostName(), *(BYTE *) buffer_read_peek(m_lpOutputBuffer));
 		//Log("%d bytes written", bytes_to_write);
-		max_bytes_written = MAX(bytes_to_write, max_bytes_written);
+		max_bytes_written = MAX(bytes_written, max_bytes_written);
 
-		total_bytes_written += bytes_to_write;
-		current_bytes_written += bytes_to_write;
+		total_bytes_written += bytes_written;
+		current_bytes_written += bytes_written;
+		m_kTrafficOut.AddBytes(bytes_written);
 
-		buffer_read_proceed(m_lpOutputBuffer, bytes_to_write);
+		buffer_read_proceed(m_lpOutputBuffer, bytes_written);
 
 		if (buffer_size(m_lpOutputBuffer) != 0)
 			fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, true);
@@ -362,12 +404,523 @@ void DESC::BufferedPacket(const void * c_pvData, int iSize)
 	if (m_iPhase == PHASE_CLOSE)
 		return;
 
+	// 버퍼링된 패킷은 다음 Packet 과 함께 나가므로 모아둔 이동, 점수 변경 패킷을 먼저 보낸다.
+	FlushBulk();
+
 	if (!m_lpBufferedOutputBuffer)
 		m_lpBufferedOutputBuffer = buffer_new(MAX(1024, iSize));
 
+	CountOutputPacket(c_pvData, iSize);
+
 	buffer_write(m_lpBufferedOutputBuffer, c_pvData, iSize);
 }
 
+// 압축해서 작아지면 c_pvData/iSize 를 HEADER_GC_COMPRESSED_PACKET 으로 바꾼다.
+// 반환된 데이터는 다음 호출 전까지만 유효하다.
+static bool CompressOutgoingPacket(const void ** pc_pvData, int * piSize)
+{
+	static std::vector<BYTE> s_vecCompressed;
+
+	const BYTE * pbRaw = (const BYTE *) *pc_pvData;
+	int iRawSize = *piSize;
+
+	size_t nMaxSize = sizeof(TPacketGCCompressedPacket) + LZOManager::instance().GetMaxCompressedSize(iRawSize);
+
+	if (s_vecCompressed.size() < nMaxSize)
+		s_vecCompressed.resize(nMaxSize);
+
+	lzo_uint uiCompressedSize = 0;
+
+	if (!LZOManager::instance().Compress(pbRaw, iRawSize, &s_vecCompressed[0] + sizeof(TPacketGCCompressedPacket), &uiCompressedSize))
+		return false;
+
+	int iPacketSize = sizeof(TPacketGCCompressedPacket) + uiCompressedSize;
+
+	if (iPacketSize >= iRawSize || iPacketSize > 0xffff)
+	{
+		DESC_MANAGER::instance().AddCompressStat(pbRaw[0], iRawSize, 0);
+		return false;
+	}
+
+	TPacketGCCompressedPacket * p = (TPacketGCCompressedPacket *) &s_vecCompressed[0];
+	p->header = HEADER_GC_COMPRESSED_PACKET;
+	p->size = iPacketSize;
+	p->dwRealSize = iRawSize;
+
+	DESC_MANAGER::instance().AddCompressStat(pbRaw[0], iRawSize, iPacketSize);
+
+	*pc_pvData = &s_vecCompressed[0];
+	*piSize = iPacketSize;
+	return true;
+}
+
+bool DESC::IsBulkMoveTarget(const void * c_pvData, int iSize) const
+{
+	if (!g_bBulkMovePacket)
+		return false;
+
+	if (iSize != sizeof(TPacketGCMove) || *(const BYTE *) c_pvData != HEADER_GC_MOVE)
+		return false;
+
+	// 릴레이나 BufferedPacket 에 붙어 나가는 패킷은 그대로 보낸다.
+	return m_iPhase == PHASE_GAME && m_stRelayName.length() == 0 && !m_lpBufferedOutputBuffer;
+}
+
+void DESC::PushBulkMove(const TPacketGCMove & c_rPack)
+{
+	// 진행 시간이 WORD 를 넘는 이동은 묶지 않는다.
+	if (c_rPack.dwDuration > USHRT_MAX)
+	{
+		FlushBulkMove();
+		WritePacket(&c_rPack, sizeof(TPacketGCMove));
+		return;
+	}
+
+	if (!m_vec_kBulkMove.empty())
+	{
+		long lDeltaX = c_rPack.lX - m_kBulkMoveBase.lX;
+		long lDeltaY = c_rPack.lY - m_kBulkMoveBase.lY;
+		int iDeltaTime = (int) (c_rPack.dwTime - m_kBulkMoveBase.dwTime);
+
+		// 기준값과의 차이가 short 를 넘거나 너무 많이 모였으면 지금까지 모은 것을 먼저 보낸다.
+		if (m_vec_kBulkMove.size() >= BULK_MOVE_MAX_COUNT ||
+				lDeltaX < SHRT_MIN || lDeltaX > SHRT_MAX ||
+				lDeltaY < SHRT_MIN || lDeltaY > SHRT_MAX ||
+				iDeltaTime < SHRT_MIN || iDeltaTime > SHRT_MAX)
+			FlushBulkMove();
+	}
+
+	if (m_vec_kBulkMove.empty())
+	{
+		m_kBulkMoveBase = c_rPack;
+		RequestFlush();
+	}
+
+	TPacketGCMoveBulkElement elem;
+
+	elem.dwVID = c_rPack.dwVID;
+	elem.bFunc = c_rPack.bFunc;
+	elem.bArg = c_rPack.bArg;
+	elem.bRot = c_rPack.bRot;
+	elem.sDeltaX = (short) (c_rPack.lX - m_kBulkMoveBase.lX);
+	elem.sDeltaY = (short) (c_rPack.lY - m_kBulkMoveBase.lY);
+	elem.sDeltaTime = (short) (int) (c_rPack.dwTime - m_kBulkMoveBase.dwTime);
+	elem.wDuration = (WORD) c_rPack.dwDuration;
+
+	m_vec_kBulkMove.push_back(elem);
+}
+
+void DESC::FlushBulkMove()
+{
+	if (m_vec_kBulkMove.empty())
+		return;
+
+	if (m_iPhase == PHASE_CLOSE)
+	{
+		m_vec_kBulkMove.clear();
+		return;
+	}
+
+	// 하나 뿐이면 묶음 헤더가 더 크므로 원래 패킷으로 보낸다. 하나일 때는 기준값이 그 패킷이다.
+	if (m_vec_kBulkMove.size() == 1)
+	{
+		m_vec_kBulkMove.clear();
+		WritePacket(&m_kBulkMoveBase, sizeof(TPacketGCMove));
+		return;
+	}
+
+	TEMP_BUFFER buf;
+
+	if (IsPackedPacket())
+	{
+		TPacketGCMoveBulkPacked pack;
+
+		pack.bHeader = HEADER_GC_MOVE_BULK_PACKED;
+		pack.wSize = 0;
+		pack.lBaseX = m_kBulkMoveBase.lX;
+		pack.lBaseY = m_kBulkMoveBase.lY;
+		pack.dwBaseTime = m_kBulkMoveBase.dwTime;
+
+		buf.write(&pack, sizeof(pack));
+
+		for (size_t i = 0; i < m_vec_kBulkMove.size(); ++i)
+		{
+			const TPacketGCMoveBulkElement & elem = m_vec_kBulkMove[i];
+			BYTE abElem[VARINT_MAX_LEN * 5 + 3];
+			int iLen = 0;
+
+			iLen += varint_encode(abElem + iLen, elem.dwVID);
+			abElem[iLen++] = elem.bFunc;
+			abElem[iLen++] = elem.bArg;
+			abElem[iLen++] = elem.bRot;
+			iLen += varint_encode(abElem + iLen, varint_zigzag(elem.sDeltaX));
+			iLen += varint_encode(abElem + iLen, varint_zigzag(elem.sDeltaY));
+			iLen += varint_encode(abElem + iLen, varint_zigzag(elem.sDeltaTime));
+			iLen += varint_encode(abElem + iLen, elem.wDuration);
+
+			buf.write(abElem, iLen);
+		}
+
+		// 원소 수가 BULK_MOVE_MAX_COUNT 로 묶여 있어서 WORD 를 넘지 않는다.
+		((TPacketGCMoveBulkPacked *) buf.read_peek())->wSize = buf.size();
+	}
+	else
+	{
+		TPacketGCMoveBulk pack;
+
+		pack.bHeader = HEADER_GC_MOVE_BULK;
+		pack.wSize = sizeof(TPacketGCMoveBulk) + sizeof(TPacketGCMoveBulkElement) * m_vec_kBulkMove.size();
+		pack.lBaseX = m_kBulkMoveBase.lX;
+		pack.lBaseY = m_kBulkMoveBase.lY;
+		pack.dwBaseTime = m_kBulkMoveBase.dwTime;
+
+		buf.write(&pack, sizeof(pack));
+		buf.write(&m_vec_kBulkMove[0], sizeof(TPacketGCMoveBulkElement) * m_vec_kBulkMove.size());
+	}
+
+	DESC_MANAGER::instance().AddBulkMoveStat(m_vec_kBulkMove.size(), buf.size());
+	m_vec_kBulkMove.clear();
+
+	WritePacket(buf.read_peek(), buf.size());
+}
+
+bool DESC::IsPackedPacket() const
+{
+	return g_bPackedPacket && m_wProtocolVersion >= PROTOCOL_VERSION_PACKED;
+}
+
+bool DESC::IsBulkPointChangeTarget(const void * c_pvData, int iSize) const
+{
+	if (!g_bBulkPointPacket)
+		return false;
+
+	// header 가 int 라서 첫 바이트만 비교한다.
+	if (iSize != sizeof(TPacketGCPointChange) || *(const BYTE *) c_pvData != HEADER_GC_CHARACTER_POINT_CHANGE)
+		return false;
+
+	return m_iPhase == PHASE_GAME && m_stRelayName.length() == 0 && !m_lpBufferedOutputBuffer;
+}
+
+void DESC::PushBulkPointChange(const TPacketGCPointChange & c_rPack)
+{
+	// 같은 VID, type 의 변경이 이미 있으면 합친다. 변경량의 부호가 다르면 (돈을 주웠다가 쓴 경우 등)
+	// 클라이언트가 보여주는 변경량이 달라지므로 따로 둔다.
+	for (size_t i = 0; i < m_vec_kBulkPointChange.size(); ++i)
+	{
+		TPacketGCPointChangeBulkElement & elem = m_vec_kBulkPointChange[i];
+
+		if (elem.dwVID != c_rPack.dwVID || elem.type != c_rPack.type)
+			continue;
+
+		if ((elem.amount > 0) != (c_rPack.amount > 0))
+			continue;
+
+		elem.amount += c_rPack.amount;
+		elem.value = c_rPack.value;
+		DESC_MANAGER::instance().AddBulkPointMergeStat();
+		return;
+	}
+
+	if (m_vec_kBulkPointChange.size() >= BULK_POINT_MAX_COUNT)
+		FlushBulkPointChange();
+
+	if (m_vec_kBulkPointChange.empty())
+		RequestFlush();
+
+	TPacketGCPointChangeBulkElement elem;
+
+	elem.dwVID = c_rPack.dwVID;
+	elem.type = c_rPack.type;
+	elem.amount = c_rPack.amount;
+	elem.value = c_rPack.value;
+
+	m_vec_kBulkPointChange.push_back(elem);
+}
+
+void DESC::FlushBulkPointChange()
+{
+	if (m_vec_kBulkPointChange.empty())
+		return;
+
+	if (m_iPhase == PHASE_CLOSE)
+	{
+		m_vec_kBulkPointChange.clear();
+		return;
+	}
+
+	if (m_vec_kBulkPointChange.size() == 1)
+	{
+		const TPacketGCPointChangeBulkElement & elem = m_vec_kBulkPointChange[0];
+		TPacketGCPointChange pack;
+
+		pack.header = HEADER_GC_CHARACTER_POINT_CHANGE;
+		pack.dwVID = elem.dwVID;
+		pack.type = elem.type;
+		pack.amount = elem.amount;
+		pack.value = elem.value;
+
+		m_vec_kBulkPointChange.clear();
+		WritePacket(&pack, sizeof(pack));
+		return;
+	}
+
+	TEMP_BUFFER buf;
+
+	if (IsPackedPacket())
+	{
+		TPacketGCPointChangeBulkPacked pack;
+
+		pack.bHeader = HEADER_GC_CHARACTER_POINT_CHANGE_BULK_PACKED;
+		pack.wSize = 0;
+
+		buf.write(&pack, sizeof(pack));
+
+		DWORD dwLastVID = 0;
+
+		for (size_t i = 0; i < m_vec_kBulkPointChange.size(); ++i)
+		{
+			const TPacketGCPointChangeBulkElement & elem = m_vec_kBulkPointChange[i];
+			BYTE abElem[VARINT_MAX_LEN * 3 + 1];
+			int iLen = 0;
+
+			// 대부분 자기 자신의 변경이라 앞 원소와 VID 가 같다.
+			iLen += varint_encode(abElem + iLen, varint_zigzag((long) (elem.dwVID - dwLastVID)));
+			abElem[iLen++] = elem.type;
+			iLen += varint_encode(abElem + iLen, varint_zigzag(elem.amount));
+			iLen += varint_encode(abElem + iLen, varint_zigzag(elem.value));
+
+			buf.write(abElem, iLen);
+			dwLastVID = elem.dwVID;
+		}
+
+		((TPacketGCPointChangeBulkPacked *) buf.read_peek())->wSize = buf.size();
+	}
+	else
+	{
+		TPacketGCPointChangeBulk pack;
+
+		pack.bHeader = HEADER_GC_CHARACTER_POINT_CHANGE_BULK;
+		pack.wSize = sizeof(TPacketGCPointChangeBulk) + sizeof(TPacketGCPointChangeBulkElement) * m_vec_kBulkPointChange.size();
+
+		buf.write(&pack, sizeof(pack));
+		buf.write(&m_vec_kBulkPointChange[0], sizeof(TPacketGCPointChangeBulkElement) * m_vec_kBulkPointChange.size());
+	}
+
+	DESC_MANAGER::instance().AddBulkPointStat(m_vec_kBulkPointChange.size(), buf.size());
+	m_vec_kBulkPointChange.clear();
+
+	WritePacket(buf.read_peek(), buf.size());
+}
+
+bool DESC::IsBulkDamageTarget(const void * c_pvData, int iSize) const
+{
+	if (!g_bBulkDamagePacket)
+		return false;
+
+	if (iSize != sizeof(TPacketGCDamageInfo) || *(const BYTE *) c_pvData != HEADER_GC_DAMAGE_INFO)
+		return false;
+
+	return m_iPhase == PHASE_GAME && m_stRelayName.length() == 0 && !m_lpBufferedOutputBuffer;
+}
+
+void DESC::PushBulkDamage(const TPacketGCDamageInfo & c_rPack)
+{
+	// 데미지는 맞을 때마다 숫자가 따로 떠야 하므로 합치지 않는다.
+	if (m_vec_kBulkDamage.size() >= BULK_DAMAGE_MAX_COUNT)
+		FlushBulkDamage();
+
+	if (m_vec_kBulkDamage.empty())
+		RequestFlush();
+
+	TPacketGCDamageInfoBulkElement elem;
+
+	elem.dwVID = c_rPack.dwVID;
+	elem.flag = c_rPack.flag;
+	elem.damage = c_rPack.damage;
+
+	m_vec_kBulkDamage.push_back(elem);
+}
+
+void DESC::FlushBulkDamage()
+{
+	if (m_vec_kBulkDamage.empty())
+		return;
+
+	if (m_iPhase == PHASE_CLOSE)
+	{
+		m_vec_kBulkDamage.clear();
+		return;
+	}
+
+	if (m_vec_kBulkDamage.size() == 1)
+	{
+		const TPacketGCDamageInfoBulkElement & elem = m_vec_kBulkDamage[0];
+		TPacketGCDamageInfo pack;
+
+		pack.header = HEADER_GC_DAMAGE_INFO;
+		pack.dwVID = elem.dwVID;
+		pack.flag = elem.flag;
+		pack.damage = elem.damage;
+
+		m_vec_kBulkDamage.clear();
+		WritePacket(&pack, sizeof(pack));
+		return;
+	}
+
+	TPacketGCDamageInfoBulk pack;
+
+	pack.bHeader = HEADER_GC_DAMAGE_INFO_BULK;
+	pack.wSize = sizeof(TPacketGCDamageInfoBulk) + sizeof(TPacketGCDamageInfoBulkElement) * m_vec_kBulkDamage.size();
+
+	TEMP_BUFFER buf;
+	buf.write(&pack, sizeof(pack));
+	buf.write(&m_vec_kBulkDamage[0], sizeof(TPacketGCDamageInfoBulkElement) * m_vec_kBulkDamage.size());
+
+	DESC_MANAGER::instance().AddBulkDamageStat(m_vec_kBulkDamage.size(), buf.size());
+	m_vec_kBulkDamage.clear();
+
+	WritePacket(buf.read_peek(), buf.size());
+}
+
+bool DESC::IsBulkCharacterAddTarget(const void * c_pvData, int iSize) const
+{
+	if (!g_bBulkCharacterAddPacket)
+		return false;
+
+	if (iSize != sizeof(TPacketGCCharacterAdd) || *(const BYTE *) c_pvData != HEADER_GC_CHARACTER_ADD)
+		return false;
+
+	return m_iPhase == PHASE_GAME && m_stRelayName.length() == 0 && !m_lpBufferedOutputBuffer;
+}
+
+void DESC::PushBulkCharacterAdd(const TPacketGCCharacterAdd & c_rPack)
+{
+	if (m_vec_kBulkCharacterAdd.size() >= BULK_CHARACTER_ADD_MAX_COUNT)
+		FlushBulkCharacterAdd();
+
+	if (m_vec_kBulkCharacterAdd.empty())
+		RequestFlush();
+
+	TPacketGCCharacterAddBulkElement elem;
+
+	elem.dwVID = c_rPack.dwVID;
+	elem.angle = c_rPack.angle;
+	elem.x = c_rPack.x;
+	elem.y = c_rPack.y;
+	elem.z = c_rPack.z;
+	elem.bType = c_rPack.bType;
+	elem.wRaceNum = c_rPack.wRaceNum;
+	elem.bMovingSpeed = c_rPack.bMovingSpeed;
+	elem.bAttackSpeed = c_rPack.bAttackSpeed;
+	elem.bStateFlag = c_rPack.bStateFlag;
+	elem.dwAffectFlag[0] = c_rPack.dwAffectFlag[0];
+	elem.dwAffectFlag[1] = c_rPack.dwAffectFlag[1];
+
+	m_vec_kBulkCharacterAdd.push_back(elem);
+}
+
+void DESC::FlushBulkCharacterAdd()
+{
+	if (m_vec_kBulkCharacterAdd.empty())
+		return;
+
+	if (m_iPhase == PHASE_CLOSE)
+	{
+		m_vec_kBulkCharacterAdd.clear();
+		return;
+	}
+
+	if (m_vec_kBulkCharacterAdd.size() == 1)
+	{
+		const TPacketGCCharacterAddBulkElement & elem = m_vec_kBulkCharacterAdd[0];
+		TPacketGCCharacterAdd pack;
+
+		pack.header = HEADER_GC_CHARACTER_ADD;
+		pack.dwVID = elem.dwVID;
+		pack.angle = elem.angle;
+		pack.x = elem.x;
+		pack.y = elem.y;
+		pack.z = elem.z;
+		pack.bType = elem.bType;
+		pack.wRaceNum = elem.wRaceNum;
+		pack.bMovingSpeed = elem.bMovingSpeed;
+		pack.bAttackSpeed = elem.bAttackSpeed;
+		pack.bStateFlag = elem.bStateFlag;
+		pack.dwAffectFlag[0] = elem.dwAffectFlag[0];
+		pack.dwAffectFlag[1] = elem.dwAffectFlag[1];
+
+		m_vec_kBulkCharacterAdd.clear();
+		WritePacket(&pack, sizeof(pack));
+		return;
+	}
+
+	TPacketGCCharacterAddBulk pack;
+
+	pack.bHeader = HEADER_GC_CHARACTER_ADD_BULK;
+	pack.wSize = sizeof(TPacketGCCharacterAddBulk) + sizeof(TPacketGCCharacterAddBulkElement) * m_vec_kBulkCharacterAdd.size();
+
+	TEMP_BUFFER buf;
+	buf.write(&pack, sizeof(pack));
+	buf.write(&m_vec_kBulkCharacterAdd[0], sizeof(TPacketGCCharacterAddBulkElement) * m_vec_kBulkCharacterAdd.size());
+
+	DESC_MANAGER::instance().AddBulkCharacterAddStat(m_vec_kBulkCharacterAdd.size(), buf.size());
+	m_vec_kBulkCharacterAdd.clear();
+
+	WritePacket(buf.read_peek(), buf.size());
+}
+
+void DESC::FlushBulk()
+{
+	FlushBulkMove();
+	FlushBulkPointChange();
+	FlushBulkDamage();
+	FlushBulkCharacterAdd();
+}
+
+// 묶을 수 있는 패킷이면 해당 묶음에 넣고 true 를 돌려준다. 다른 묶음은 먼저 내보내서 순서를 지킨다.
+// 묶을 수 없는 패킷이면 쌓인 것을 모두 내보내고 false 를 돌려준다.
+bool DESC::PushBulk(const void * c_pvData, int iSize)
+{
+	if (IsBulkMoveTarget(c_pvData, iSize))
+	{
+		FlushBulkPointChange();
+		FlushBulkDamage();
+		FlushBulkCharacterAdd();
+		PushBulkMove(*(const TPacketGCMove *) c_pvData);
+		return true;
+	}
+
+	if (IsBulkPointChangeTarget(c_pvData, iSize))
+	{
+		FlushBulkMove();
+		FlushBulkDamage();
+		FlushBulkCharacterAdd();
+		PushBulkPointChange(*(const TPacketGCPointChange *) c_pvData);
+		return true;
+	}
+
+	if (IsBulkDamageTarget(c_pvData, iSize))
+	{
+		FlushBulkMove();
+		FlushBulkPointChange();
+		FlushBulkCharacterAdd();
+		PushBulkDamage(*(const TPacketGCDamageInfo *) c_pvData);
+		return true;
+	}
+
+	if (IsBulkCharacterAddTarget(c_pvData, iSize))
+	{
+		FlushBulkMove();
+		FlushBulkPointChange();
+		FlushBulkDamage();
+		PushBulkCharacterAdd(*(const TPacketGCCharacterAdd *) c_pvData);
+		return true;
+	}
+
+	FlushBulk();
+	return false;
+}
+
 void DESC::Packet(const void * c_pvData, int iSize)
 {
 	assert(iSize > 0);
@@ -375,6 +928,43 @@ void DESC::Packet(const void * c_pvData, int iSize)
 	if (m_iPhase == PHASE_CLOSE) // 끊는 상태면 보내지 않는다.
 		return;
 
+	if (PushBulk(c_pvData, iSize))
+		return;
+	WritePacket(c_pvData, iSize);
+}
+
+void DESC::CountOutputPacket(const void * c_pvData, int iSize)
+{
+	m_kTrafficOut.AddPacket();
+
+	// P2P 와 DB 연결은 헤더 번호가 클라이언트 패킷과 겹치므로 헤더별 통계에 넣지 않는다.
+	if (m_iPhase != PHASE_P2P && m_iPhase != PHASE_DBCLIENT)
+		DESC_MANAGER::instance().AddOutputPacketStat(*(const BYTE *) c_pvData, iSize);
+}
+
+void DESC::GrowBuffers()
+{
+	if (!m_bSmallBuffer)
+		return;
+
+	m_bSmallBuffer = false;
+
+	// 입력 버퍼는 처리 중에 phase 가 바뀔 수 있으므로 다음 ProcessInput 에서 늘린다.
+	GrowBuffer(m_lpOutputBuffer, DEFAULT_PACKET_BUFFER_SIZE * 2);
+	m_iMinInputBufferLen = MAX_INPUT_LEN >> 1;
+}
+
+void DESC::WritePacket(const void * c_pvData, int iSize)
+{
+	if (m_bP2PBatchPending)
+		P2P_MANAGER::instance().FlushBatch(this);
+
+	// 핸드셰이크 중에 보내는 패킷이 작은 버퍼를 넘으면 미리 늘린다.
+	if (m_bSmallBuffer && buffer_has_space(m_lpOutputBuffer) < iSize + 8 + (int) sizeof(TPacketGGRelay) + (m_lpBufferedOutputBuffer ? buffer_size(m_lpBufferedOutputBuffer) : 0))
+		GrowBuffers();
+
+	CountOutputPacket(c_pvData, iSize);
+
 	if (m_stRelayName.length() != 0)
 	{
 		// Relay 패킷은 암호화하지 않는다.
@@ -408,6 +998,9 @@ void DESC::Packet(const void * c_pvData, int iSize)
 			iSize = buffer_size(m_lpBufferedOutputBuffer);
 		}
 
+		if (m_bPacketCompression && g_iPacketCompressThreshold > 0 && iSize >= g_iPacketCompressThreshold)
+			CompressOutgoingPacket(&c_pvData, &iSize);
+
 		if (!m_bEncrypted)
 		{
 			if (!packet_encode(m_lpOutputBuffer, c_pvData, iSize))
@@ -445,7 +1038,57 @@ void DESC::Packet(const void * c_pvData, int iSize)
 
 	//sys_log(0, "%d bytes written (first byte %d)", iSize, *(BYTE *) c_pvData);
 	if (m_iPhase != PHASE_CLOSE)
-		fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, true);
+		RequestFlush();
+}
+
+void DESC::SharedPacket(const void * c_pvData, int iSize)
+{
+	assert(iSize > 0);
+
+	if (m_iPhase == PHASE_CLOSE)
+		return;
+
+	if (PushBulk(c_pvData, iSize))
+		return;
+
+	// 암호화하지 않거나 릴레이/버퍼링된 패킷이 있으면 일반 경로로 보낸다.
+	// 압축 대상인 경우도 마찬가지.
+	if (!m_bEncrypted || m_stRelayName.length() != 0 || m_lpBufferedOutputBuffer ||
+			(m_bPacketCompression && g_iPacketCompressThreshold > 0 && iSize >= g_iPacketCompressThreshold))
+	{
+		Packet(c_pvData, iSize);
+		return;
+	}
+
+	if (m_bSmallBuffer && buffer_has_space(m_lpOutputBuffer) < iSize + 8)
+		GrowBuffers();
+
+	if (buffer_has_space(m_lpOutputBuffer) < iSize + 8)
+	{
+		sys_err("desc buffer mem_size overflow. memsize(%u) write_pos(%u) iSize(%d)", 
+				m_lpOutputBuffer->mem_size, m_lpOutputBuffer->write_point_pos, iSize);
+
+		m_iPhase = PHASE_CLOSE;
+		return;
+	}
+
+	CountOutputPacket(c_pvData, iSize);
+
+	// 공유 버퍼에서 출력 버퍼로 바로 암호화한다. (복사 후 제자리 암호화를 하지 않는다)
+	DWORD * pdwWritePoint = (DWORD *) buffer_write_peek(m_lpOutputBuffer);
+	int iSize2 = TEA_Encrypt(pdwWritePoint, (const DWORD *) c_pvData, GetEncryptionKey(), iSize);
+	buffer_write_proceed(m_lpOutputBuffer, iSize2);
+
+	RequestFlush();
+}
+
+void DESC::RequestFlush()
+{
+	if (m_bFlushRequested)
+		return;
+
+	m_bFlushRequested = true;
+	DESC_MANAGER::instance().RequestFlush(this);
 }
 
 void DESC::LargePacket(const void * c_pvData, int iSize)
@@ -458,6 +1101,16 @@ void DESC::LargePacket(const void * c_pvData, int iSize)
 
 void DESC::SetPhase(int _phase)
 {
+	// 핸드셰이크를 벗어나면 더 이상 반쯤 열린 접속으로 세지 않는다.
+	if (_phase != PHASE_HANDSHAKE)
+	{
+		if (m_bHalfOpen)
+			DESC_MANAGER::instance().ReleaseHalfOpen(this);
+
+		if (_phase != PHASE_CLOSE)
+			GrowBuffers();
+	}
+
 	m_iPhase = _phase;
 
 	TPacketGCPhase pack;
@@ -625,11 +1278,18 @@ DWORD DESC::GetClientTime()
 
 void DESC::SetRelay(const char * c_pszName)
 {
+	// 배치를 Relay 로 감싸지 않도록 이름을 정하기 전에 내보낸다.
+	if (m_bP2PBatchPending)
+		P2P_MANAGER::instance().FlushBatch(this);
+
 	m_stRelayName = c_pszName;
 }
 
 void DESC::BindCharacter(LPCHARACTER ch)
 {
+	if (!ch)
+		DESC_MANAGER::instance().UnsubscribeChat(this);
+
 	m_lpCharacter = ch;
 }
 
@@ -639,6 +1299,8 @@ void DESC::FlushOutput()
 		return;
 	}
 
+	FlushBulk();
+
 	if (buffer_size(m_lpOutputBuffer) <= 0)
 		return;
 
@@ -650,6 +1312,9 @@ void DESC::FlushOutput()
 	socket_block(m_sock);
 	sys_log(0, "FLUSH START %d", buffer_size(m_lpOutputBuffer));
 
+	// Packet()은 write 이벤트를 걸지 않으므로 여기서 직접 건다.
+	fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, true);
+
 	while (buffer_size(m_lpOutputBuffer) > 0)
 	{
 		gettimeofday(&now_tv, NULL);
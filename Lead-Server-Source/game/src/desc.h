@@ -8,6 +8,10 @@
 //#define MAX_INPUT_LEN			2048
 #define MAX_INPUT_LEN			65536
 
+// 핸드셰이크가 끝나기 전에는 이만큼만 잡아 두고 phase 가 바뀌면 원래 크기로 늘린다.
+#define HANDSHAKE_OUTPUT_BUFFER_SIZE	4096
+#define HANDSHAKE_INPUT_LEN			1024
+
 #define HANDSHAKE_RETRY_LIMIT		32
 
 class CInputProcessor;
@@ -52,6 +56,51 @@ struct seq_t
 typedef std::vector<seq_t>	seq_vector_t;
 // sequence 버그 찾기용 데이타
 
+// 바이트/패킷 누적과 초당 속도. 속도는 DESC_MANAGER::UpdateTraffic 이 1초마다
+// 그동안 쌓인 창을 접어 지수 평균한다.
+typedef struct STrafficCounter
+{
+	uint64_t	qwBytes;
+	uint64_t	qwPackets;
+	DWORD		dwWindowBytes;
+	DWORD		dwWindowPackets;
+	float		fByteRate;
+	float		fPacketRate;
+
+	void	Reset()			{ memset(this, 0, sizeof(*this)); }
+	void	AddBytes(int iBytes)	{ qwBytes += iBytes; dwWindowBytes += iBytes; }
+	void	AddPacket()		{ ++qwPackets; ++dwWindowPackets; }
+
+	void	Roll(float fSec)
+	{
+		// 새 값의 비중은 1/4. 대략 최근 4초의 평균이 된다.
+		fByteRate += (dwWindowBytes / fSec - fByteRate) * 0.25f;
+		fPacketRate += (dwWindowPackets / fSec - fPacketRate) * 0.25f;
+		dwWindowBytes = dwWindowPackets = 0;
+	}
+} TTrafficCounter;
+
+// 여러 DESC 에 SharedPacket 으로 그대로 넣을 수 있게 8바이트 단위로 패딩해 둔 패킷
+typedef struct SSharedPacketBlob
+{
+	int					iSize;
+	std::vector<char>	vecData;
+
+	SSharedPacketBlob() : iSize(0) {}
+
+	bool	IsEmpty() const	{ return iSize == 0; }
+	void	Clear()			{ iSize = 0; vecData.clear(); }
+
+	void	Assign(const void * c_pvData, int iDataSize)
+	{
+		iSize = iDataSize;
+		vecData.assign((iDataSize + 7) & ~7, 0);
+
+		if (iDataSize > 0)
+			thecore_memcpy(&vecData[0], c_pvData, iDataSize);
+	}
+} TSharedPacketBlob;
+
 class DESC
 {
 	public:
@@ -86,13 +135,38 @@ class DESC
 		WORD			GetP2PPort() const		{ return m_wP2PPort; }
 		BYTE			GetP2PChannel() const	{ return m_bP2PChannel;	}
 
+		// peer 가 클라이언트를 받는 주소. 워프 대상 코어를 찾을 때 쓴다.
+		void			SetP2PListen(long lAddr, WORD wPort) { m_lP2PListenAddr = lAddr; m_wP2PListenPort = wPort; }
+		long			GetP2PListenAddr() const	{ return m_lP2PListenAddr; }
+		WORD			GetP2PListenPort() const	{ return m_wP2PListenPort; }
+
 		void			BufferedPacket(const void * c_pvData, int iSize);
 		void			Packet(const void * c_pvData, int iSize);
+		// c_pvData must be zero padded up to the next 8 byte boundary
+		void			SharedPacket(const void * c_pvData, int iSize);
+		void			SharedPacket(const TSharedPacketBlob & c_rBlob)	{ if (!c_rBlob.IsEmpty()) SharedPacket(&c_rBlob.vecData[0], c_rBlob.iSize); }
 		void			LargePacket(const void * c_pvData, int iSize);
 
+		// 게임 중 HEADER_GC_MOVE 는 바로 보내지 않고 모았다가 HEADER_GC_MOVE_BULK 하나로 보낸다.
+		// 다른 패킷을 보내기 전과 pulse 끝 (DESC_MANAGER::FlushRequested) 에 내보내므로 순서는 그대로다.
+		void			FlushBulkMove();
+		// HEADER_GC_CHARACTER_POINT_CHANGE 도 같은 방식으로 HEADER_GC_CHARACTER_POINT_CHANGE_BULK 로 묶는다.
+		// 두 묶음 중 하나만 쌓이므로 FlushBulk 는 쌓인 것을 그대로 내보낸다.
+		void			FlushBulkPointChange();
+		// 범위 스킬의 HEADER_GC_DAMAGE_INFO 는 HEADER_GC_DAMAGE_INFO_BULK 로 묶는다.
+		void			FlushBulkDamage();
+		// 몬스터 무리가 나타날 때 이어서 가는 HEADER_GC_CHARACTER_ADD 는 HEADER_GC_CHARACTER_ADD_BULK 로 묶는다.
+		void			FlushBulkCharacterAdd();
+		void			FlushBulk();
+
 		int			ProcessInput();		// returns -1 if error
 		int			ProcessOutput();	// returns -1 if error
 
+		// 쌓인 출력은 pulse 끝에 DESC_MANAGER::FlushRequested 에서 한번에 보낸다.
+		void			RequestFlush();
+		bool			IsFlushRequested() const	{ return m_bFlushRequested; }
+		void			ClearFlushRequest()		{ m_bFlushRequested = false; }
+
 		CInputProcessor	*	GetInputProcessor()	{ return m_pInputProcessor; }
 
 		DWORD			GetHandle() const	{ return m_dwHandle; }
@@ -105,6 +179,7 @@ class DESC
 		LPCHARACTER		GetCharacter()		{ return m_lpCharacter; }
 
 		bool			IsPhase(int phase) const	{ return m_iPhase == phase ? true : false; }
+		int			GetPhase() const	{ return m_iPhase; }
 
 		const struct sockaddr_in & GetAddr()		{ return m_SockAddr;	}
 
@@ -129,6 +204,10 @@ class DESC
 		BYTE			GetEmpire();
 
 		// for p2p
+		// P2P_MANAGER 에 이 desc 로 보낼 배치가 쌓여있는지. 직접 보내는 패킷보다 먼저 내보낸다.
+		void			SetP2PBatchPending(bool b)	{ m_bP2PBatchPending = b; }
+		bool			IsP2PBatchPending() const	{ return m_bP2PBatchPending; }
+
 		void			SetRelay(const char * c_pszName);
 		bool			DelayedDisconnect(int iSec);
 		void			DisconnectOfSameLogin();
@@ -139,6 +218,15 @@ class DESC
 		void			SetPong(bool b);
 		bool			IsPong();
 
+		// 클라이언트가 HEADER_CG_PACKET_COMPRESSION 으로 요청하면 큰 패킷을 압축해서 보낸다.
+		void			SetPacketCompression(bool b)	{ m_bPacketCompression = b; }
+		bool			IsPacketCompression() const	{ return m_bPacketCompression; }
+
+		// HEADER_CG_PROTOCOL_VERSION 으로 맞춘 버전. 보내지 않은 클라이언트는 PROTOCOL_VERSION_LEGACY 다.
+		void			SetProtocolVersion(WORD w)	{ m_wProtocolVersion = w; }
+		WORD			GetProtocolVersion() const	{ return m_wProtocolVersion; }
+		bool			IsPackedPacket() const;
+
 		BYTE			GetSequence();
 		void			SetNextSequence();
 
@@ -150,12 +238,49 @@ class DESC
 
 		void			AssembleCRCMagicCube(BYTE bProcPiece, BYTE bFilePiece);
 
+		// 받은 바이트는 소켓에서 읽은 그대로, 보낸 바이트는 소켓에 쓴 그대로 (압축, 암호화 후) 센다.
+		// 패킷 수는 보통 패킷 단위다. HEADER_GC_MOVE_BULK 같은 묶음은 하나로 센다.
+		const TTrafficCounter &	GetTrafficIn() const	{ return m_kTrafficIn; }
+		const TTrafficCounter &	GetTrafficOut() const	{ return m_kTrafficOut; }
+		void			CountInputPacket()	{ m_kTrafficIn.AddPacket(); }
+		void			RollTraffic(float fSec)	{ m_kTrafficIn.Roll(fSec); m_kTrafficOut.Roll(fSec); }
+
+		// 핸드셰이크 전의 작은 버퍼를 원래 크기로 늘린다. 이미 늘렸으면 아무것도 하지 않는다.
+		void			GrowBuffers();
+
+		// DESC_MANAGER 가 핸드셰이크를 마치지 않은 접속으로 세고 있는가
+		bool			IsHalfOpen() const	{ return m_bHalfOpen; }
+		void			SetHalfOpen(bool bHalfOpen)	{ m_bHalfOpen = bHalfOpen; }
+
+		// DESC_MANAGER 의 제국별, 맵별 채팅 구독 목록에 들어가 있는 값. CHARACTER::Show 에서 갱신한다.
+		bool			IsChatSubscribed() const	{ return m_bChatSubscribed; }
+		BYTE			GetChatEmpire() const		{ return m_bChatEmpire; }
+		long			GetChatMapIndex() const		{ return m_lChatMapIndex; }
+		void			SetChatSubscription(bool bSubscribed, BYTE bEmpire, long lMapIndex)
+		{
+			m_bChatSubscribed = bSubscribed;
+			m_bChatEmpire = bEmpire;
+			m_lChatMapIndex = lMapIndex;
+		}
+
 		bool			isChannelStatusRequested() const { return m_bChannelStatusRequested; }
 		void			SetChannelStatusRequested(bool bChannelStatusRequested) { m_bChannelStatusRequested = bChannelStatusRequested; }
 
 	protected:
 		void			Initialize();
 
+		void			WritePacket(const void * c_pvData, int iSize);
+		void			CountOutputPacket(const void * c_pvData, int iSize);
+		bool			IsBulkMoveTarget(const void * c_pvData, int iSize) const;
+		void			PushBulkMove(const TPacketGCMove & c_rPack);
+		bool			IsBulkPointChangeTarget(const void * c_pvData, int iSize) const;
+		void			PushBulkPointChange(const TPacketGCPointChange & c_rPack);
+		bool			IsBulkDamageTarget(const void * c_pvData, int iSize) const;
+		void			PushBulkDamage(const TPacketGCDamageInfo & c_rPack);
+		bool			IsBulkCharacterAddTarget(const void * c_pvData, int iSize) const;
+		void			PushBulkCharacterAdd(const TPacketGCCharacterAdd & c_rPack);
+		bool			PushBulk(const void * c_pvData, int iSize);
+
 	protected:
 		CInputProcessor *	m_pInputProcessor;
 		CInputClose		m_inputClose;
@@ -177,6 +302,7 @@ class DESC
 
 		LPBUFFER		m_lpInputBuffer;
 		int				m_iMinInputBufferLen;
+		int				m_iDecryptedInputLen;	// m_lpInputBuffer 의 읽는 위치부터 이미 복호화된 길이
 	
 		DWORD			m_dwHandshake;
 		DWORD			m_dwHandshakeSentTime;
@@ -199,6 +325,8 @@ class DESC
 		std::string		m_stP2PHost;
 		WORD			m_wP2PPort;
 		BYTE			m_bP2PChannel;
+		long			m_lP2PListenAddr;
+		WORD			m_wP2PListenPort;
 
 		bool			m_bAdminMode; // Handshake 에서 어드민 명령을 쓸수있나?
 		bool			m_bPong;
@@ -221,6 +349,26 @@ class DESC
 
 		bool			m_bDestroyed;
 		bool			m_bChannelStatusRequested;
+		bool			m_bFlushRequested;
+		bool			m_bPacketCompression;
+		bool			m_bP2PBatchPending;
+		WORD			m_wProtocolVersion;
+
+		bool			m_bSmallBuffer;
+		bool			m_bHalfOpen;
+
+		bool			m_bChatSubscribed;
+		BYTE			m_bChatEmpire;
+		long			m_lChatMapIndex;
+
+		TPacketGCMove		m_kBulkMoveBase;	// 모으기 시작한 첫 이동 패킷. 좌표와 시간의 기준값
+		std::vector<TPacketGCMoveBulkElement>	m_vec_kBulkMove;
+		std::vector<TPacketGCPointChangeBulkElement>	m_vec_kBulkPointChange;
+		std::vector<TPacketGCDamageInfoBulkElement>	m_vec_kBulkDamage;
+		std::vector<TPacketGCCharacterAddBulkElement>	m_vec_kBulkCharacterAdd;
+
+		TTrafficCounter		m_kTrafficIn;
+		TTrafficCounter		m_kTrafficOut;
 
 		// Obsolete encryption stuff here
 		bool			m_bEncrypted;
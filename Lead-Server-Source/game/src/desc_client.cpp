@@ -14,6 +14,14 @@
 
 extern LPFDWATCH	main_fdw;
 
+enum
+{
+	CONNECT_TIMEOUT_MS		= 10000,
+	CONNECT_RETRY_MIN_MS		= 3000,
+	CONNECT_RETRY_MAX_MS		= 60000,
+	CONNECT_RESOLVE_FAIL_COUNT	= 4,
+};
+
 LPCLIENT_DESC db_clientdesc = NULL;
 LPCLIENT_DESC g_pkAuthMasterDesc = NULL;
 
@@ -30,7 +38,12 @@ CLIENT_DESC::CLIENT_DESC()
 {
 	m_iPhaseWhenSucceed = 0;
 	m_bRetryWhenClosed = false;
-	m_LastTryToConnectTime = 0;
+	m_sockConnecting = INVALID_SOCKET;
+	m_dwConnectStartTime = 0;
+	m_dwNextConnectTime = 0;
+	m_iConnectFailCount = 0;
+	m_bAddrResolved = false;
+	memset(&m_kAddr, 0, sizeof(m_kAddr));
 	m_tLastChannelStatusUpdateTime = 0;
 }
 
@@ -40,6 +53,12 @@ CLIENT_DESC::~CLIENT_DESC()
 
 void CLIENT_DESC::Destroy()
 {
+	if (m_sockConnecting != INVALID_SOCKET)
+	{
+		socket_close(m_sockConnecting);
+		m_sockConnecting = INVALID_SOCKET;
+	}
+
 	if (m_sock == INVALID_SOCKET) {
 		return;
 	}
@@ -74,31 +93,92 @@ bool CLIENT_DESC::Connect(int iPhaseWhenSucceed)
 	if (iPhaseWhenSucceed != 0)
 		m_iPhaseWhenSucceed = iPhaseWhenSucceed;
 
-	if (get_global_time() - m_LastTryToConnectTime < 3)	// 3
+	if (m_sock != INVALID_SOCKET)
 		return false;
 
-	m_LastTryToConnectTime = get_global_time();
+	DWORD dwNow = get_dword_time();
 
-	if (m_sock != INVALID_SOCKET)
+	if (m_sockConnecting != INVALID_SOCKET)
+		return CheckConnect(dwNow);
+
+	if ((long) (dwNow - m_dwNextConnectTime) < 0)
 		return false;
 
+	//  ٷ ܵ 3 ȿ ٽ  ʴ´.
+	m_dwNextConnectTime = dwNow + CONNECT_RETRY_MIN_MS;
+
+	// ּҴ   Ǯ ΰ, а ׿  ٽ Ǭ.
+	if (!m_bAddrResolved)
+	{
+		if (!socket_resolve(m_stHost.c_str(), m_wPort, &m_kAddr))
+		{
+			ConnectFailed(dwNow);
+			return false;
+		}
+
+		m_bAddrResolved = true;
+	}
+
 	sys_log(0, "SYSTEM: Trying to connect to %s:%d", m_stHost.c_str(), m_wPort);
 
-	m_sock = socket_connect(m_stHost.c_str(), m_wPort);
+	SetPhase(PHASE_CLIENT_CONNECTING);
 
-	if (m_sock != INVALID_SOCKET)
+	if ((m_sockConnecting = socket_connect_async(&m_kAddr)) == INVALID_SOCKET)
+	{
+		sys_err("HOST %s:%d, could not connect.", m_stHost.c_str(), m_wPort);
+		ConnectFailed(dwNow);
+		return false;
+	}
+
+	m_dwConnectStartTime = dwNow;
+	return CheckConnect(dwNow);
+}
+
+bool CLIENT_DESC::CheckConnect(DWORD dwNow)
+{
+	int iRet = socket_connect_check(m_sockConnecting);
+
+	if (iRet == 0)
 	{
-		sys_log(0, "SYSTEM: connected to server (fd %d, ptr %p)", m_sock, this);
-		fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_READ, false);
-		fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, false);
-		SetPhase(m_iPhaseWhenSucceed);
-		return true;
+		if (dwNow - m_dwConnectStartTime < CONNECT_TIMEOUT_MS)
+			return false;
+
+		sys_err("HOST %s:%d connection timeout.", m_stHost.c_str(), m_wPort);
 	}
-	else
+	else if (iRet < 0)
+		sys_err("HOST %s:%d, could not connect.", m_stHost.c_str(), m_wPort);
+
+	if (iRet <= 0)
 	{
-		SetPhase(PHASE_CLIENT_CONNECTING);
+		socket_close(m_sockConnecting);
+		m_sockConnecting = INVALID_SOCKET;
+		ConnectFailed(dwNow);
 		return false;
 	}
+
+	m_sock = m_sockConnecting;
+	m_sockConnecting = INVALID_SOCKET;
+	m_iConnectFailCount = 0;
+
+	sys_log(0, "SYSTEM: connected to server (fd %d, ptr %p)", m_sock, this);
+	fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_READ, false);
+	SetPhase(m_iPhaseWhenSucceed);
+	return true;
+}
+
+void CLIENT_DESC::ConnectFailed(DWORD dwNow)
+{
+	++m_iConnectFailCount;
+
+	// 3ʺ  辿 ÷ ִ 60ʱ ٸ.
+	DWORD dwDelay = MIN(CONNECT_RETRY_MIN_MS << MIN(m_iConnectFailCount - 1, 5), CONNECT_RETRY_MAX_MS);
+	m_dwNextConnectTime = dwNow + dwDelay;
+
+	// ּҰ ٲ     ϸ ٽ Ǭ.
+	if (m_iConnectFailCount % CONNECT_RESOLVE_FAIL_COUNT == 0)
+		m_bAddrResolved = false;
+
+	sys_log(0, "SYSTEM: connect to %s:%d failed %d times, retry in %u ms", m_stHost.c_str(), m_wPort, m_iConnectFailCount, dwDelay);
 }
 
 void CLIENT_DESC::Setup(LPFDWATCH _fdw, const char * _host, WORD _port)
@@ -207,6 +287,10 @@ void CLIENT_DESC::SetPhase(int iPhase)
 
 				DBPacket(HEADER_GD_SETUP, 0, buf.read_peek(), buf.size());
 				m_pInputProcessor = &m_inputDB;
+
+				//  ʰ   Ƿ ä ´   .
+				if (!g_bAuthServer)
+					UpdateChannelStatus(0, true);
 			}
 			break;
 
@@ -235,6 +319,10 @@ void CLIENT_DESC::DBPacketHeader(BYTE bHeader, DWORD dwHandle, DWORD dwSize)
 	buffer_write(m_lpOutputBuffer, encode_byte(bHeader), sizeof(BYTE));
 	buffer_write(m_lpOutputBuffer, encode_4bytes(dwHandle), sizeof(DWORD));
 	buffer_write(m_lpOutputBuffer, encode_4bytes(dwSize), sizeof(DWORD));
+
+	// write  ׻ ɾ θ fdwatch  Ź ٷ Ƿ     Ǵ.
+	if (m_sock != INVALID_SOCKET)
+		fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, true);
 }
 
 void CLIENT_DESC::DBPacket(BYTE bHeader, DWORD dwHandle, const void * c_pvData, DWORD dwSize)
@@ -259,6 +347,7 @@ void CLIENT_DESC::Packet(const void * c_pvData, int iSize)
 		return;
 	}
 	buffer_write(m_lpOutputBuffer, c_pvData, iSize);
+	fdwatch_add_fd(m_lpFdw, m_sock, this, FDW_WRITE, true);
 }
 
 bool CLIENT_DESC::IsRetryWhenClosed()
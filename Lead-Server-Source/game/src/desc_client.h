@@ -15,6 +15,7 @@ class CLIENT_DESC : public DESC
 
 		bool 		Connect(int iPhaseWhenSucceed = 0);
 		void		Setup(LPFDWATCH _fdw, const char * _host, WORD _port);
+		bool		IsConnecting() const { return m_sockConnecting != INVALID_SOCKET; }
 
 		void		SetRetryWhenClosed(bool);
 
@@ -31,11 +32,20 @@ class CLIENT_DESC : public DESC
 
 	private:
 		void InitializeBuffers();
+		bool CheckConnect(DWORD dwNow);
+		void ConnectFailed(DWORD dwNow);
 
 	protected:
 		int			m_iPhaseWhenSucceed;
 		bool		m_bRetryWhenClosed;
-		time_t		m_LastTryToConnectTime;
+
+		//  ŷ ɰ io_loop   .
+		socket_t	m_sockConnecting;
+		DWORD		m_dwConnectStartTime;
+		DWORD		m_dwNextConnectTime;
+		int			m_iConnectFailCount;
+		bool		m_bAddrResolved;
+		struct sockaddr_in	m_kAddr;
 		time_t		m_tLastChannelStatusUpdateTime;
 
 		CInputDB 	m_inputDB;
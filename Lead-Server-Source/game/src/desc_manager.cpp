@@ -72,6 +72,29 @@ void DESC_MANAGER::Initialize()
 	m_iHandleCount = 0;
 	m_iLocalUserCount = 0;
 	memset(m_aiEmpireUserCount, 0, sizeof(m_aiEmpireUserCount));
+	memset(m_aiLocalEmpireUserCount, 0, sizeof(m_aiLocalEmpireUserCount));
+	m_iOtherUserCount = 0;
+	memset(m_aiOtherEmpireUserCount, 0, sizeof(m_aiOtherEmpireUserCount));
+	m_iClusterUserCount = 0;
+	memset(&m_kReportedUserCount, 0, sizeof(m_kReportedUserCount));
+	memset(m_aCompressStat, 0, sizeof(m_aCompressStat));
+	memset(m_aOutputPacketStat, 0, sizeof(m_aOutputPacketStat));
+	m_dwTrafficUpdateTime = 0;
+	m_iHalfOpenCount = 0;
+
+	m_dwBulkMoveCount = 0;
+	m_dwBulkMoveElementCount = 0;
+	m_dwBulkMoveBytes = 0;
+	m_dwBulkPointCount = 0;
+	m_dwBulkPointElementCount = 0;
+	m_dwBulkPointMergeCount = 0;
+	m_dwBulkPointBytes = 0;
+	m_dwBulkDamageCount = 0;
+	m_dwBulkDamageElementCount = 0;
+	m_dwBulkDamageBytes = 0;
+	m_dwBulkCharacterAddCount = 0;
+	m_dwBulkCharacterAddElementCount = 0;
+	m_dwBulkCharacterAddBytes = 0;
 	m_bDisconnectInvalidCRC = false;
 }
 
@@ -156,6 +179,14 @@ LPDESC DESC_MANAGER::AcceptDesc(LPFDWATCH fdw, socket_t s)
 	if ((desc = socket_accept(s, &peer)) == -1)
 		return NULL;
 
+	//    DESC    .
+	if (!ConsumeLoginToken(peer.sin_addr, get_dword_time()))
+	{
+		sys_log(1, "connection from %s was throttled.", inet_ntoa(peer.sin_addr));
+		socket_close(desc);
+		return NULL;
+	}
+
 	strlcpy(host, inet_ntoa(peer.sin_addr), sizeof(host));
 
 	if (g_bAuthServer)
@@ -178,6 +209,26 @@ LPDESC DESC_MANAGER::AcceptDesc(LPFDWATCH fdw, socket_t s)
 		}
 	}
 
+	// ڵũ ġ   ʹ  DESC    ´.
+	if (g_iMaxHalfOpen > 0 && m_iHalfOpenCount >= g_iMaxHalfOpen)
+	{
+		sys_log(1, "connection from %s dropped: half open %d >= %d", host, m_iHalfOpenCount, g_iMaxHalfOpen);
+		socket_close(desc);
+		return NULL;
+	}
+
+	if (g_iMaxHalfOpenPerIP > 0)
+	{
+		boost::unordered_map<DWORD, int>::const_iterator it = m_map_iHalfOpenByIP.find(peer.sin_addr.s_addr);
+
+		if (it != m_map_iHalfOpenByIP.end() && it->second >= g_iMaxHalfOpenPerIP)
+		{
+			sys_log(1, "connection from %s dropped: half open per ip %d >= %d", host, it->second, g_iMaxHalfOpenPerIP);
+			socket_close(desc);
+			return NULL;
+		}
+	}
+
 	newd = M2_NEW DESC;
 	crc_t handshake = CreateHandshake();
 
@@ -191,11 +242,29 @@ LPDESC DESC_MANAGER::AcceptDesc(LPFDWATCH fdw, socket_t s)
 	m_map_handshake.insert(DESC_HANDSHAKE_MAP::value_type(handshake, newd));
 	m_map_handle.insert(DESC_HANDLE_MAP::value_type(newd->GetHandle(), newd));
 
+	++m_iHalfOpenCount;
+	++m_map_iHalfOpenByIP[peer.sin_addr.s_addr];
+	newd->SetHalfOpen(true);
+
 	m_set_pkDesc.insert(newd);
 	++m_iSocketsConnected;
 	return (newd);
 }
 
+void DESC_MANAGER::ReleaseHalfOpen(LPDESC d)
+{
+	if (!d->IsHalfOpen())
+		return;
+
+	d->SetHalfOpen(false);
+	--m_iHalfOpenCount;
+
+	boost::unordered_map<DWORD, int>::iterator it = m_map_iHalfOpenByIP.find(d->GetAddr().sin_addr.s_addr);
+
+	if (it != m_map_iHalfOpenByIP.end() && --it->second <= 0)
+		m_map_iHalfOpenByIP.erase(it);
+}
+
 LPDESC DESC_MANAGER::AcceptP2PDesc(LPFDWATCH fdw, socket_t bind_fd)
 {
 	socket_t           fd;
@@ -250,6 +319,17 @@ void DESC_MANAGER::DestroyDesc(LPDESC d, bool bEraseFromSet)
 	else
 		m_set_pkClientDesc.erase((LPCLIENT_DESC) d);
 
+	UnsubscribeChat(d);
+	ReleaseHalfOpen(d);
+
+	if (d->IsFlushRequested())
+	{
+		std::vector<LPDESC>::iterator it = std::find(m_vec_pkFlushDesc.begin(), m_vec_pkFlushDesc.end(), d);
+
+		if (it != m_vec_pkFlushDesc.end())
+			*it = NULL;
+	}
+
 	// Explicit call to the virtual function Destroy()
 	d->Destroy();
 
@@ -286,6 +366,281 @@ void DESC_MANAGER::DestroyClosed()
 	}
 }
 
+void DESC_MANAGER::RequestFlush(LPDESC d)
+{
+	m_vec_pkFlushDesc.push_back(d);
+}
+
+void DESC_MANAGER::FlushRequested()
+{
+	for (size_t i = 0; i < m_vec_pkFlushDesc.size(); ++i)
+	{
+		LPDESC d = m_vec_pkFlushDesc[i];
+
+		if (!d)
+			continue;
+
+		// Ƶ ̵ Ŷ ̹ pulse ¿ ԽŲ. û ÷׸  ̶ ٽ ϵ ʴ´.
+		d->FlushBulk();
+		d->ClearFlushRequest();
+
+		if (d->IsPhase(PHASE_CLOSE))
+			continue;
+
+		if (d->ProcessOutput() < 0)
+			d->SetPhase(PHASE_CLOSE);
+	}
+
+	m_vec_pkFlushDesc.clear();
+}
+
+void DESC_MANAGER::AddCompressStat(BYTE bHeader, int iRawSize, int iCompressedSize)
+{
+	SCompressStat & r = m_aCompressStat[bHeader];
+
+	if (!iCompressedSize)
+	{
+		++r.dwSkipCount;
+		return;
+	}
+
+	++r.dwCount;
+	r.dwRawBytes += iRawSize;
+	r.dwCompressedBytes += iCompressedSize;
+}
+
+void DESC_MANAGER::DumpCompressStat()
+{
+	for (int i = 0; i < 256; ++i)
+	{
+		const SCompressStat & r = m_aCompressStat[i];
+
+		if (!r.dwCount && !r.dwSkipCount)
+			continue;
+
+		sys_log(0, "COMPRESS_STAT: header %3d count %u skip %u raw %u compressed %u ratio %.2f",
+				i, r.dwCount, r.dwSkipCount, r.dwRawBytes, r.dwCompressedBytes,
+				r.dwRawBytes ? (float) r.dwCompressedBytes / r.dwRawBytes : 0.0f);
+	}
+
+	memset(m_aCompressStat, 0, sizeof(m_aCompressStat));
+}
+
+void DESC_MANAGER::AddOutputPacketStat(BYTE bHeader, int iBytes)
+{
+	TTrafficCounter & r = m_aOutputPacketStat[bHeader];
+	r.AddPacket();
+	r.AddBytes(iBytes);
+}
+
+void DESC_MANAGER::UpdateTraffic()
+{
+	DWORD dwNow = get_dword_time();
+
+	if (!m_dwTrafficUpdateTime)
+	{
+		m_dwTrafficUpdateTime = dwNow;
+		return;
+	}
+
+	if (dwNow == m_dwTrafficUpdateTime)
+		return;
+
+	float fSec = (dwNow - m_dwTrafficUpdateTime) / 1000.0f;
+	m_dwTrafficUpdateTime = dwNow;
+
+	for (DESC_SET::iterator it = m_set_pkDesc.begin(); it != m_set_pkDesc.end(); ++it)
+		(*it)->RollTraffic(fSec);
+
+	for (int i = 0; i < 256; ++i)
+		m_aOutputPacketStat[i].Roll(fSec);
+}
+
+struct FCompareDescTraffic
+{
+	bool operator () (LPDESC a, LPDESC b) const
+	{
+		return a->GetTrafficIn().fByteRate + a->GetTrafficOut().fByteRate > b->GetTrafficIn().fByteRate + b->GetTrafficOut().fByteRate;
+	}
+};
+
+void DESC_MANAGER::LogDescTraffic(LPCHARACTER ch, size_t iMaxCount)
+{
+	std::vector<LPDESC> vec(m_set_pkDesc.begin(), m_set_pkDesc.end());
+
+	if (iMaxCount && iMaxCount < vec.size())
+	{
+		std::partial_sort(vec.begin(), vec.begin() + iMaxCount, vec.end(), FCompareDescTraffic());
+		vec.resize(iMaxCount);
+	}
+	else
+		std::sort(vec.begin(), vec.end(), FCompareDescTraffic());
+
+	for (size_t n = 0; n < vec.size(); ++n)
+	{
+		LPDESC d = vec[n];
+		const TTrafficCounter & rIn = d->GetTrafficIn();
+		const TTrafficCounter & rOut = d->GetTrafficOut();
+
+		const char * c_pszName = d->GetCharacter() ? d->GetCharacter()->GetName() : d->GetAccountTable().login;
+
+		char szLine[256];
+		snprintf(szLine, sizeof(szLine), "%-15s %-16s phase %d in %.1fKB/s %.0f/s out %.1fKB/s %.0f/s total in %lluKB out %lluKB",
+				d->GetHostName(), *c_pszName ? c_pszName : "-", d->GetPhase(),
+				rIn.fByteRate / 1024.0f, rIn.fPacketRate, rOut.fByteRate / 1024.0f, rOut.fPacketRate,
+				(unsigned long long) (rIn.qwBytes >> 10), (unsigned long long) (rOut.qwBytes >> 10));
+
+		if (ch)
+			ch->ChatPacket(CHAT_TYPE_INFO, "%s", szLine);
+		else
+			sys_log(0, "DESC_TRAFFIC: %s", szLine);
+	}
+}
+
+struct FCompareOutputPacketStat
+{
+	bool operator () (const TTrafficCounter * a, const TTrafficCounter * b) const
+	{
+		if (a->fByteRate != b->fByteRate)
+			return a->fByteRate > b->fByteRate;
+
+		return a->qwBytes > b->qwBytes;
+	}
+};
+
+void DESC_MANAGER::LogOutputPacketStat(LPCHARACTER ch, size_t iMaxCount)
+{
+	std::vector<const TTrafficCounter *> vec;
+
+	for (int i = 0; i < 256; ++i)
+		if (m_aOutputPacketStat[i].qwPackets)
+			vec.push_back(&m_aOutputPacketStat[i]);
+
+	std::sort(vec.begin(), vec.end(), FCompareOutputPacketStat());
+
+	for (size_t n = 0; n < vec.size(); ++n)
+	{
+		if (iMaxCount && n >= iMaxCount)
+			break;
+
+		const TTrafficCounter * p = vec[n];
+
+		char szLine[256];
+		snprintf(szLine, sizeof(szLine), "header %3d %.1fKB/s %.0f/s total %llu packets %lluKB avg %.1f",
+				(int) (p - m_aOutputPacketStat), p->fByteRate / 1024.0f, p->fPacketRate,
+				(unsigned long long) p->qwPackets, (unsigned long long) (p->qwBytes >> 10),
+				(float) p->qwBytes / p->qwPackets);
+
+		if (ch)
+			ch->ChatPacket(CHAT_TYPE_INFO, "%s", szLine);
+		else
+			sys_log(0, "OUTPUT_PACKET_STAT: %s", szLine);
+	}
+}
+
+void DESC_MANAGER::ResetOutputPacketStat()
+{
+	memset(m_aOutputPacketStat, 0, sizeof(m_aOutputPacketStat));
+}
+
+void DESC_MANAGER::AddBulkMoveStat(int iElementCount, int iBytes)
+{
+	++m_dwBulkMoveCount;
+	m_dwBulkMoveElementCount += iElementCount;
+	m_dwBulkMoveBytes += iBytes;
+}
+
+void DESC_MANAGER::DumpBulkMoveStat()
+{
+	if (m_dwBulkMoveCount)
+	{
+		DWORD dwRawBytes = m_dwBulkMoveElementCount * sizeof(TPacketGCMove);
+
+		sys_log(0, "BULK_MOVE_STAT: count %u moves %u avg %.1f bytes %u raw %u ratio %.2f",
+				m_dwBulkMoveCount, m_dwBulkMoveElementCount, (float) m_dwBulkMoveElementCount / m_dwBulkMoveCount,
+				m_dwBulkMoveBytes, dwRawBytes, dwRawBytes ? (float) m_dwBulkMoveBytes / dwRawBytes : 0.0f);
+	}
+
+	m_dwBulkMoveCount = 0;
+	m_dwBulkMoveElementCount = 0;
+	m_dwBulkMoveBytes = 0;
+}
+
+void DESC_MANAGER::AddBulkPointStat(int iElementCount, int iBytes)
+{
+	++m_dwBulkPointCount;
+	m_dwBulkPointElementCount += iElementCount;
+	m_dwBulkPointBytes += iBytes;
+}
+
+void DESC_MANAGER::AddBulkPointMergeStat()
+{
+	++m_dwBulkPointMergeCount;
+}
+
+void DESC_MANAGER::DumpBulkPointStat()
+{
+	if (m_dwBulkPointCount || m_dwBulkPointMergeCount)
+	{
+		DWORD dwRawBytes = (m_dwBulkPointElementCount + m_dwBulkPointMergeCount) * sizeof(TPacketGCPointChange);
+
+		sys_log(0, "BULK_POINT_STAT: count %u changes %u merged %u bytes %u raw %u ratio %.2f",
+				m_dwBulkPointCount, m_dwBulkPointElementCount, m_dwBulkPointMergeCount,
+				m_dwBulkPointBytes, dwRawBytes, dwRawBytes ? (float) m_dwBulkPointBytes / dwRawBytes : 0.0f);
+	}
+
+	m_dwBulkPointCount = 0;
+	m_dwBulkPointElementCount = 0;
+	m_dwBulkPointMergeCount = 0;
+	m_dwBulkPointBytes = 0;
+}
+
+void DESC_MANAGER::AddBulkDamageStat(int iElementCount, int iBytes)
+{
+	++m_dwBulkDamageCount;
+	m_dwBulkDamageElementCount += iElementCount;
+	m_dwBulkDamageBytes += iBytes;
+}
+
+void DESC_MANAGER::DumpBulkDamageStat()
+{
+	if (m_dwBulkDamageCount)
+	{
+		DWORD dwRawBytes = m_dwBulkDamageElementCount * sizeof(TPacketGCDamageInfo);
+
+		sys_log(0, "BULK_DAMAGE_STAT: count %u damages %u avg %.1f bytes %u raw %u ratio %.2f",
+				m_dwBulkDamageCount, m_dwBulkDamageElementCount, (float) m_dwBulkDamageElementCount / m_dwBulkDamageCount,
+				m_dwBulkDamageBytes, dwRawBytes, dwRawBytes ? (float) m_dwBulkDamageBytes / dwRawBytes : 0.0f);
+	}
+
+	m_dwBulkDamageCount = 0;
+	m_dwBulkDamageElementCount = 0;
+	m_dwBulkDamageBytes = 0;
+}
+
+void DESC_MANAGER::AddBulkCharacterAddStat(int iElementCount, int iBytes)
+{
+	++m_dwBulkCharacterAddCount;
+	m_dwBulkCharacterAddElementCount += iElementCount;
+	m_dwBulkCharacterAddBytes += iBytes;
+}
+
+void DESC_MANAGER::DumpBulkCharacterAddStat()
+{
+	if (m_dwBulkCharacterAddCount)
+	{
+		DWORD dwRawBytes = m_dwBulkCharacterAddElementCount * sizeof(TPacketGCCharacterAdd);
+
+		sys_log(0, "BULK_CHARACTER_ADD_STAT: count %u characters %u avg %.1f bytes %u raw %u ratio %.2f",
+				m_dwBulkCharacterAddCount, m_dwBulkCharacterAddElementCount, (float) m_dwBulkCharacterAddElementCount / m_dwBulkCharacterAddCount,
+				m_dwBulkCharacterAddBytes, dwRawBytes, dwRawBytes ? (float) m_dwBulkCharacterAddBytes / dwRawBytes : 0.0f);
+	}
+
+	m_dwBulkCharacterAddCount = 0;
+	m_dwBulkCharacterAddElementCount = 0;
+	m_dwBulkCharacterAddBytes = 0;
+}
+
 LPDESC DESC_MANAGER::FindByLoginName(const std::string& login)
 {
 	DESC_LOGINNAME_MAP::iterator it = m_map_loginName.find(login);
@@ -311,6 +666,191 @@ const DESC_MANAGER::DESC_SET & DESC_MANAGER::GetClientSet()
 	return m_set_pkDesc;
 }
 
+void DESC_MANAGER::SubscribeChat(LPDESC d, BYTE bEmpire, long lMapIndex)
+{
+	if (bEmpire >= EMPIRE_MAX_NUM)
+		bEmpire = 0;
+
+	if (d->IsChatSubscribed())
+	{
+		if (d->GetChatEmpire() == bEmpire && d->GetChatMapIndex() == lMapIndex)
+			return;
+
+		UnsubscribeChat(d);
+	}
+
+	m_aset_pkEmpireChatDesc[bEmpire].insert(d);
+	m_map_pkMapChatDesc[lMapIndex].insert(d);
+	d->SetChatSubscription(true, bEmpire, lMapIndex);
+}
+
+void DESC_MANAGER::UnsubscribeChat(LPDESC d)
+{
+	if (!d->IsChatSubscribed())
+		return;
+
+	m_aset_pkEmpireChatDesc[d->GetChatEmpire()].erase(d);
+
+	DESC_MAP_INDEX_MAP::iterator it = m_map_pkMapChatDesc.find(d->GetChatMapIndex());
+
+	if (it != m_map_pkMapChatDesc.end())
+	{
+		it->second.erase(d);
+
+		if (it->second.empty())
+			m_map_pkMapChatDesc.erase(it);
+	}
+
+	d->SetChatSubscription(false, 0, 0);
+}
+
+const DESC_MANAGER::DESC_SET & DESC_MANAGER::GetEmpireChatSet(BYTE bEmpire)
+{
+	if (bEmpire >= EMPIRE_MAX_NUM)
+		bEmpire = 0;
+
+	return m_aset_pkEmpireChatDesc[bEmpire];
+}
+
+const DESC_MANAGER::DESC_SET & DESC_MANAGER::GetMapChatSet(long lMapIndex)
+{
+	static DESC_SET s_set_empty;
+
+	DESC_MAP_INDEX_MAP::const_iterator it = m_map_pkMapChatDesc.find(lMapIndex);
+
+	if (it == m_map_pkMapChatDesc.end())
+		return s_set_empty;
+
+	return it->second;
+}
+
+void DESC_MANAGER::QueueShout(const char * c_pszText, BYTE bEmpire)
+{
+	m_vec_kQueuedShout.push_back(SQueuedShout());
+
+	SQueuedShout & r = m_vec_kQueuedShout.back();
+	r.bEmpire = bEmpire;
+	r.stText.assign(c_pszText, MIN(strlen(c_pszText), (size_t) CHAT_MAX_LEN));
+}
+
+// Ŷ bEmpire  ޴  ̹Ƿ ޴  ѹ .
+// SharedPacket  8Ʈ  ٷ ȣȭϹǷ Ŷ 8Ʈ е д.
+static std::vector<char>	s_vecShoutPayload;
+static std::vector<size_t>	s_vecShoutOffset;
+
+void DESC_MANAGER::FlushShout()
+{
+	if (m_vec_kQueuedShout.empty())
+		return;
+
+	for (BYTE bEmpire = 0; bEmpire < EMPIRE_MAX_NUM; ++bEmpire)
+	{
+		const DESC_SET & c_rset = m_aset_pkEmpireChatDesc[bEmpire];
+
+		if (c_rset.empty())
+			continue;
+
+		s_vecShoutPayload.clear();
+		s_vecShoutOffset.clear();
+
+		for (size_t i = 0; i < m_vec_kQueuedShout.size(); ++i)
+		{
+			const std::string & c_rstText = m_vec_kQueuedShout[i].stText;
+
+			TPacketGCChat pack_chat;
+
+			pack_chat.header	= HEADER_GC_CHAT;
+			pack_chat.size		= sizeof(TPacketGCChat) + c_rstText.length();
+			pack_chat.type		= CHAT_TYPE_SHOUT;
+			pack_chat.id		= 0;
+			pack_chat.bEmpire	= bEmpire;
+
+			size_t offset = s_vecShoutPayload.size();
+			s_vecShoutOffset.push_back(offset);
+			s_vecShoutPayload.resize(offset + ((pack_chat.size + 7) & ~7), 0);
+
+			thecore_memcpy(&s_vecShoutPayload[offset], &pack_chat, sizeof(TPacketGCChat));
+			thecore_memcpy(&s_vecShoutPayload[offset + sizeof(TPacketGCChat)], c_rstText.data(), c_rstText.length());
+		}
+
+		for (DESC_SET::const_iterator it = c_rset.begin(); it != c_rset.end(); ++it)
+		{
+			LPDESC d = *it;
+			LPCHARACTER ch = d->GetCharacter();
+
+			if (!ch)
+				continue;
+
+			// ڴ ٸ  ġ⵵ ޴´.
+			bool bAllEmpire = ch->GetGMLevel() != GM_PLAYER;
+
+			for (size_t i = 0; i < m_vec_kQueuedShout.size(); ++i)
+			{
+				if (!bAllEmpire && m_vec_kQueuedShout[i].bEmpire != bEmpire)
+					continue;
+
+				d->SharedPacket(&s_vecShoutPayload[s_vecShoutOffset[i]], sizeof(TPacketGCChat) + m_vec_kQueuedShout[i].stText.length());
+			}
+		}
+	}
+
+	m_vec_kQueuedShout.clear();
+}
+
+static std::vector<char>	s_vecRelayPayload;
+
+void DESC_MANAGER::RelayPacket(const std::vector<LPDESC> & c_rvec, const void * c_pvData, int iSize)
+{
+	if (c_rvec.empty())
+		return;
+
+	s_vecRelayPayload.assign((iSize + 7) & ~7, 0);
+	thecore_memcpy(&s_vecRelayPayload[0], c_pvData, iSize);
+
+	for (size_t i = 0; i < c_rvec.size(); ++i)
+		c_rvec[i]->SharedPacket(&s_vecRelayPayload[0], iSize);
+}
+
+void DESC_MANAGER::RelayChat(const std::vector<LPDESC> & c_rvec, BYTE bType, const char * c_pszText)
+{
+	if (c_rvec.empty() || !c_pszText)
+		return;
+
+	int len = MIN((int) strlen(c_pszText), CHAT_MAX_LEN);
+
+	TPacketGCChat pack_chat;
+
+	pack_chat.header	= HEADER_GC_CHAT;
+	pack_chat.size		= sizeof(TPacketGCChat) + len;
+	pack_chat.type		= bType;
+	pack_chat.id		= 0;
+
+	for (BYTE bEmpire = 0; bEmpire < EMPIRE_MAX_NUM; ++bEmpire)
+	{
+		bool bBuilt = false;
+
+		for (size_t i = 0; i < c_rvec.size(); ++i)
+		{
+			LPDESC d = c_rvec[i];
+
+			if (d->GetEmpire() != bEmpire)
+				continue;
+
+			if (!bBuilt)
+			{
+				pack_chat.bEmpire = bEmpire;
+
+				s_vecRelayPayload.assign((pack_chat.size + 7) & ~7, 0);
+				thecore_memcpy(&s_vecRelayPayload[0], &pack_chat, sizeof(TPacketGCChat));
+				thecore_memcpy(&s_vecRelayPayload[sizeof(TPacketGCChat)], c_pszText, len);
+				bBuilt = true;
+			}
+
+			d->SharedPacket(&s_vecRelayPayload[0], pack_chat.size);
+		}
+	}
+}
+
 struct name_with_desc_func
 {
 	const char * m_name;
@@ -419,24 +959,54 @@ void DESC_MANAGER::UpdateLocalUserCount()
 	f = std::for_each(c_ref_set.begin(), c_ref_set.end(), f);
 
 	m_iLocalUserCount = f.iTotalCount;
-	thecore_memcpy(m_aiEmpireUserCount, f.aiEmpireUserCount, sizeof(m_aiEmpireUserCount));
+	thecore_memcpy(m_aiLocalEmpireUserCount, f.aiEmpireUserCount, sizeof(m_aiLocalEmpireUserCount));
 
-	m_aiEmpireUserCount[1] += P2P_MANAGER::instance().GetEmpireUserCount(1);
-	m_aiEmpireUserCount[2] += P2P_MANAGER::instance().GetEmpireUserCount(2);
-	m_aiEmpireUserCount[3] += P2P_MANAGER::instance().GetEmpireUserCount(3);
+	for (int i = 0; i < EMPIRE_MAX_NUM; ++i)
+		m_aiEmpireUserCount[i] = m_aiLocalEmpireUserCount[i] + m_aiOtherEmpireUserCount[i];
 }
 
 void DESC_MANAGER::GetUserCount(int & iTotal, int ** paiEmpireUserCount, int & iLocalCount)
 {
 	*paiEmpireUserCount = &m_aiEmpireUserCount[0];
-	
-	int iCount = P2P_MANAGER::instance().GetCount();
-	if (iCount < 0)
+
+	iTotal = m_iLocalUserCount + m_iOtherUserCount;
+	iLocalCount = m_iLocalUserCount;
+}
+
+void DESC_MANAGER::ReportUserCount()
+{
+	m_kReportedUserCount.dwCount = m_iLocalUserCount;
+
+	for (int i = 0; i < EMPIRE_MAX_NUM; ++i)
+		m_kReportedUserCount.adwEmpireCount[i] = m_aiLocalEmpireUserCount[i];
+
+	db_clientdesc->DBPacket(HEADER_GD_PLAYER_COUNT, 0, &m_kReportedUserCount, sizeof(TPlayerCountPacket));
+}
+
+void DESC_MANAGER::SetClusterState(const TPacketDGClusterState * p)
+{
+	const TClusterChannelState * c_pkState = (const TClusterChannelState *) (p + 1);
+
+	m_iClusterUserCount = p->dwTotal;
+	m_iOtherUserCount = 0;
+	memset(m_aiOtherEmpireUserCount, 0, sizeof(m_aiOtherEmpireUserCount));
+
+	for (int i = 0; i < p->bChannelCount; ++i, ++c_pkState)
 	{
-		sys_err("P2P_MANAGER::instance().GetCount() == -1");
+		if (c_pkState->bChannel != g_bChannel)
+			continue;
+
+		// 迡  ھ     ִ.
+		m_iOtherUserCount = MAX(0, (int) c_pkState->dwCount - (int) m_kReportedUserCount.dwCount);
+
+		for (int j = 0; j < EMPIRE_MAX_NUM; ++j)
+			m_aiOtherEmpireUserCount[j] = MAX(0, (int) c_pkState->adwEmpireCount[j] - (int) m_kReportedUserCount.adwEmpireCount[j]);
+
+		break;
 	}
-	iTotal = m_iLocalUserCount + iCount;
-	iLocalCount = m_iLocalUserCount;
+
+	for (int i = 0; i < EMPIRE_MAX_NUM; ++i)
+		m_aiEmpireUserCount[i] = m_aiLocalEmpireUserCount[i] + m_aiOtherEmpireUserCount[i];
 }
 
 
@@ -460,7 +1030,7 @@ bool DESC_MANAGER::GetRandomKey(DWORD dwHandle, DWORD* prandom_key)
 
 LPDESC DESC_MANAGER::FindByLoginKey(DWORD dwKey)
 {
-	std::map<DWORD, CLoginKey *>::iterator it = m_map_pkLoginKey.find(dwKey);
+	LOGIN_KEY_MAP::iterator it = m_map_pkLoginKey.find(dwKey);
 
 	if (it == m_map_pkLoginKey.end())
 		return NULL;
@@ -475,7 +1045,8 @@ DWORD DESC_MANAGER::CreateLoginKey(LPDESC d)
 
 	do
 	{
-		dwKey = number(1, INT_MAX);
+		//   (dwKey - 1) % g_iAuthShardCount  ٸ  Ἥ Ű ġ ʴ´.
+		dwKey = number(0, INT_MAX / g_iAuthShardCount - 1) * g_iAuthShardCount + g_iAuthShardIndex + 1;
 
 		if (m_map_pkLoginKey.find(dwKey) != m_map_pkLoginKey.end())
 			continue;
@@ -489,31 +1060,39 @@ DWORD DESC_MANAGER::CreateLoginKey(LPDESC d)
 	return dwKey;
 }
 
-void DESC_MANAGER::ProcessExpiredLoginKey()
+void DESC_MANAGER::ExpireLoginKey(CLoginKey * pkKey)
 {
-	DWORD dwCurrentTime = get_dword_time();
+	if (pkKey->m_dwExpireTime)
+		return;
 
-	std::map<DWORD, CLoginKey *>::iterator it, it2;
+	pkKey->Expire();
+	m_deque_pkExpiredLoginKey.push_back(pkKey);
+}
 
-	it = m_map_pkLoginKey.begin();
+void DESC_MANAGER::ProcessExpiredLoginKey()
+{
+	DWORD dwCurrentTime = get_dword_time();
 
-	while (it != m_map_pkLoginKey.end())
+	//  ð  ̹Ƿ տ 60ʰ  ͸ .
+	// ü Ű    ʴ´.
+	while (!m_deque_pkExpiredLoginKey.empty())
 	{
-		it2 = it++;
+		CLoginKey * pkKey = m_deque_pkExpiredLoginKey.front();
 
-		if (it2->second->m_dwExpireTime == 0)
-			continue;
+		if (dwCurrentTime - pkKey->m_dwExpireTime <= 60000)
+			break;
 
-		if (dwCurrentTime - it2->second->m_dwExpireTime > 60000)
-		{
-			M2_DELETE(it2->second);
-			m_map_pkLoginKey.erase(it2);
-		}
+		m_deque_pkExpiredLoginKey.pop_front();
+		m_map_pkLoginKey.erase(pkKey->m_dwKey);
+		M2_DELETE(pkKey);
 	}
 }
 
 bool DESC_MANAGER::LoadClientPackageCryptInfo(const char* pDirName)
 {
+	m_kPackageCryptKeyPacket.Clear();
+	m_map_kPackageSDBPacket.clear();
+
 	return m_pPackageCrypt->LoadPackageCryptInfo(pDirName);
 }
 
@@ -524,16 +1103,21 @@ void DESC_MANAGER::SendClientPackageCryptKey( LPDESC desc )
 		return;
 	}
 
-	TPacketGCHybridCryptKeys packet;
+	if( m_kPackageCryptKeyPacket.IsEmpty() )
 	{
-		packet.bHeader = HEADER_GC_HYBRIDCRYPT_KEYS;
-		m_pPackageCrypt->GetPackageCryptKeys( &(packet.pDataKeyStream), packet.KeyStreamLen );
-	}
+		TPacketGCHybridCryptKeys packet;
+		{
+			packet.bHeader = HEADER_GC_HYBRIDCRYPT_KEYS;
+			m_pPackageCrypt->GetPackageCryptKeys( &(packet.pDataKeyStream), packet.KeyStreamLen );
+		}
 
-	if( packet.KeyStreamLen > 0 )
-	{
-		desc->Packet( packet.GetStreamData(), packet.GetStreamSize() );
+		if( packet.KeyStreamLen <= 0 )
+			return;
+
+		m_kPackageCryptKeyPacket.Assign( packet.GetStreamData(), packet.GetStreamSize() );
 	}
+
+	desc->SharedPacket( m_kPackageCryptKeyPacket );
 }
 
 void DESC_MANAGER::SendClientPackageSDBToLoadMap( LPDESC desc, const char* pMapName )
@@ -543,16 +1127,24 @@ void DESC_MANAGER::SendClientPackageSDBToLoadMap( LPDESC desc, const char* pMapN
 		return;
 	}
 
-	TPacketGCPackageSDB packet;
-	{
-		packet.bHeader      = HEADER_GC_HYBRIDCRYPT_SDB;
-		if( !m_pPackageCrypt->GetRelatedMapSDBStreams( pMapName, &(packet.m_pDataSDBStream), packet.iStreamLen ) )
-			return; 
-	}
+	// ʿ SDB    Ŷ   ã ʴ´.
+	boost::unordered_map<std::string, TSharedPacketBlob>::iterator it = m_map_kPackageSDBPacket.find( pMapName );
 
-	if( packet.iStreamLen > 0 )
+	if( it == m_map_kPackageSDBPacket.end() )
 	{
-		desc->Packet( packet.GetStreamData(), packet.GetStreamSize());
+		it = m_map_kPackageSDBPacket.insert( std::make_pair( std::string( pMapName ), TSharedPacketBlob() ) ).first;
+
+		TPacketGCPackageSDB packet;
+		{
+			packet.bHeader      = HEADER_GC_HYBRIDCRYPT_SDB;
+			if( !m_pPackageCrypt->GetRelatedMapSDBStreams( pMapName, &(packet.m_pDataSDBStream), packet.iStreamLen ) )
+				return; 
+		}
+
+		if( packet.iStreamLen > 0 )
+			it->second.Assign( packet.GetStreamData(), packet.GetStreamSize() );
 	}
+
+	desc->SharedPacket( it->second );
 }
 
@@ -6,6 +6,8 @@
 #include "common/stl.h"
 #include "common/length.h"
 
+#include "desc.h"
+
 class CLoginKey;
 class CClientPackageCryptInfo;
 
@@ -19,6 +21,8 @@ class DESC_MANAGER : public singleton<DESC_MANAGER>
 		typedef std::map<DWORD, LPDESC>					DESC_ACCOUNTID_MAP;
 		typedef boost::unordered_map<std::string, LPDESC>	DESC_LOGINNAME_MAP;
 		typedef std::map<DWORD, DWORD>					DESC_HANDLE_RANDOM_KEY_MAP;
+		typedef TR1_NS::unordered_map<DWORD, CLoginKey *>	LOGIN_KEY_MAP;
+		typedef boost::unordered_map<long, DESC_SET>	DESC_MAP_INDEX_MAP;
 
 	public:
 		DESC_MANAGER();
@@ -29,6 +33,10 @@ class DESC_MANAGER : public singleton<DESC_MANAGER>
 
 		LPDESC			AcceptDesc(LPFDWATCH fdw, socket_t s);
 		LPDESC			AcceptP2PDesc(LPFDWATCH fdw, socket_t s);
+
+		// ڵũ ġ   . AcceptDesc  max_half_open(_per_ip)    ʴ´.
+		void			ReleaseHalfOpen(LPDESC d);
+		int				GetHalfOpenCount() const	{ return m_iHalfOpenCount; }
 		void			DestroyDesc(LPDESC d, bool erase_from_set = true);
 
 		DWORD			CreateHandshake();
@@ -46,17 +54,64 @@ class DESC_MANAGER : public singleton<DESC_MANAGER>
 
 		void			DestroyClosed();
 
+		void			RequestFlush(LPDESC d);
+		void			FlushRequested();	// ̹ pulse    ϸ ѹ .
+
+		//  Ŷ . iCompressedSize  0 ̸ ۾ ʾ  ʰ  ̴.
+		void			AddCompressStat(BYTE bHeader, int iRawSize, int iCompressedSize);
+		void			DumpCompressStat();
+
+		// HEADER_GC_MOVE_BULK .  ̵ Ŷ   Ʈ
+		void			AddBulkMoveStat(int iElementCount, int iBytes);
+		void			DumpBulkMoveStat();
+		void			AddBulkPointStat(int iElementCount, int iBytes);
+		void			AddBulkPointMergeStat();
+		void			DumpBulkPointStat();
+		void			AddBulkDamageStat(int iElementCount, int iBytes);
+		void			DumpBulkDamageStat();
+		void			AddBulkCharacterAddStat(int iElementCount, int iBytes);
+		void			DumpBulkCharacterAddStat();
+
+		// Ŭ̾Ʈ   Ʈ, Ŷ . ũ , ȣȭ ̴.
+		void			AddOutputPacketStat(BYTE bHeader, int iBytes);
+		// 1ʸ ҷ Ằ,  ʴ ӵ Ѵ.
+		void			UpdateTraffic();
+		// ch  NULL ̸ syslog  . iMaxCount  0 ̸ 
+		void			LogDescTraffic(LPCHARACTER ch, size_t iMaxCount);
+		void			LogOutputPacketStat(LPCHARACTER ch, size_t iMaxCount);
+		void			ResetOutputPacketStat();
+
 		void			UpdateLocalUserCount();
 		DWORD			GetLocalUserCount() { return m_iLocalUserCount; }
 		void			GetUserCount(int & iTotal, int ** paiEmpireUserCount, int & iLocalCount);
+		void			ReportUserCount();
+		void			SetClusterState(const TPacketDGClusterState * p);
+		int				GetClusterUserCount() { return m_iClusterUserCount; }
 
 		const DESC_SET &	GetClientSet();
 
+		//   ĳ , ʺ DESC . ġ,  ä,   ü   ̰ .
+		void			SubscribeChat(LPDESC d, BYTE bEmpire, long lMapIndex);
+		void			UnsubscribeChat(LPDESC d);
+		const DESC_SET &	GetEmpireChatSet(BYTE bEmpire);
+		const DESC_SET &	GetMapChatSet(long lMapIndex);
+
+		// ġ pulse   ξٰ FlushShout  ޴  ѹ Ŷ 
+		// ڸ ѹ  SharedPacket  ִ´.
+		void			QueueShout(const char * c_pszText, BYTE bEmpire);
+		void			FlushShout();
+
+		// , ̺Ʈ ó ޴   Ͽ Ŷ ѹ  SharedPacket   ش.
+		// ä bEmpire  ޴  ̹Ƿ Ͽ ִ  ѹ .
+		void			RelayPacket(const std::vector<LPDESC> & c_rvec, const void * c_pvData, int iSize);
+		void			RelayChat(const std::vector<LPDESC> & c_rvec, BYTE bType, const char * c_pszText);
+
 		DWORD			MakeRandomKey(DWORD dwHandle);
 		bool			GetRandomKey(DWORD dwHandle, DWORD* prandom_key);
 
 		DWORD			CreateLoginKey(LPDESC d);
 		LPDESC			FindByLoginKey(DWORD dwKey);
+		void			ExpireLoginKey(CLoginKey * pkKey);
 		void			ProcessExpiredLoginKey();
 
 		bool			IsDisconnectInvalidCRC() { return m_bDisconnectInvalidCRC; }
@@ -76,23 +131,78 @@ class DESC_MANAGER : public singleton<DESC_MANAGER>
 
 		CLIENT_DESC_SET		m_set_pkClientDesc;
 		DESC_SET			m_set_pkDesc;
+		std::vector<LPDESC>	m_vec_pkFlushDesc;
+
+		int					m_iHalfOpenCount;
+		boost::unordered_map<DWORD, int>	m_map_iHalfOpenByIP;
+
+		DESC_SET			m_aset_pkEmpireChatDesc[EMPIRE_MAX_NUM];
+		DESC_MAP_INDEX_MAP	m_map_pkMapChatDesc;
+
+		struct SQueuedShout
+		{
+			BYTE		bEmpire;
+			std::string	stText;
+		};
+
+		std::vector<SQueuedShout>	m_vec_kQueuedShout;
+
+		struct SCompressStat
+		{
+			DWORD	dwCount;
+			DWORD	dwSkipCount;
+			DWORD	dwRawBytes;
+			DWORD	dwCompressedBytes;
+		};
+
+		SCompressStat		m_aCompressStat[256];
+
+		TTrafficCounter		m_aOutputPacketStat[256];
+		DWORD			m_dwTrafficUpdateTime;
+
+		DWORD			m_dwBulkMoveCount;
+		DWORD			m_dwBulkMoveElementCount;
+		DWORD			m_dwBulkMoveBytes;
+		DWORD			m_dwBulkPointCount;
+		DWORD			m_dwBulkPointElementCount;
+		DWORD			m_dwBulkPointMergeCount;
+		DWORD			m_dwBulkPointBytes;
+		DWORD			m_dwBulkDamageCount;
+		DWORD			m_dwBulkDamageElementCount;
+		DWORD			m_dwBulkDamageBytes;
+		DWORD			m_dwBulkCharacterAddCount;
+		DWORD			m_dwBulkCharacterAddElementCount;
+		DWORD			m_dwBulkCharacterAddBytes;
 
 		DESC_HANDLE_MAP			m_map_handle;
 		DESC_HANDSHAKE_MAP		m_map_handshake;
 		//DESC_ACCOUNTID_MAP		m_AccountIDMap;
 		DESC_LOGINNAME_MAP		m_map_loginName;
-		std::map<DWORD, CLoginKey *>	m_map_pkLoginKey;
+		LOGIN_KEY_MAP			m_map_pkLoginKey;
+		std::deque<CLoginKey *>	m_deque_pkExpiredLoginKey;	// Expire   =  ð 
 
 		int				m_iSocketsConnected;
 
 		int				m_iHandleCount;
 
 		int				m_iLocalUserCount;
-		int				m_aiEmpireUserCount[EMPIRE_MAX_NUM];
+		int				m_aiEmpireUserCount[EMPIRE_MAX_NUM];	//  ä ü (ٸ ھ db )
+		int				m_aiLocalEmpireUserCount[EMPIRE_MAX_NUM];
+
+		// db   ִ HEADER_DG_CLUSTER_STATE   ھ    
+		int				m_iOtherUserCount;
+		int				m_aiOtherEmpireUserCount[EMPIRE_MAX_NUM];
+		int				m_iClusterUserCount;
+
+		TPlayerCountPacket	m_kReportedUserCount;
 
 		bool			m_bDestroyed;
 
 		CClientPackageCryptInfo*	m_pPackageCrypt;
+
+		// о  ڷ ٲ Ƿ ѹ  Ŷ ״ . LoadClientPackageCryptInfo  .
+		TSharedPacketBlob			m_kPackageCryptKeyPacket;
+		boost::unordered_map<std::string, TSharedPacketBlob>	m_map_kPackageSDBPacket;
 };
 
 #endif
@@ -73,6 +73,7 @@ bool DragonSoulTable::ReadDragonSoulTableFile(const char * c_pszFileName)
 		&& CheckDragonHeartExtTables()
 		&& CheckDragonSoulExtTables())
 	{
+		BuildRefineTables();
 		return true;
 	}
 	else
@@ -346,7 +347,7 @@ bool DragonSoulTable::CheckRefineGradeTables()
 			{
 				int need_count, fee;
 				std::vector <float> vec_probs;
-				if (!GetRefineGradeValues(m_vecDragonSoulTypes[i], j, need_count, fee, vec_probs))
+				if (!ReadRefineGradeValues(m_vecDragonSoulTypes[i], j, need_count, fee, vec_probs))
 				{
 					sys_err ("In %s group of RefineGradeTables, values in Grade(%s) row is invalid.", 
 						m_vecDragonSoulNames[i].c_str(), g_astGradeName[j].c_str());
@@ -400,7 +401,7 @@ bool DragonSoulTable::CheckRefineStepTables ()
 			{
 				int need_count, fee;
 				std::vector <float> vec_probs;
-				if (!GetRefineStepValues(m_vecDragonSoulTypes[i], j, need_count, fee, vec_probs))
+				if (!ReadRefineStepValues(m_vecDragonSoulTypes[i], j, need_count, fee, vec_probs))
 				{
 					sys_err ("In %s group of RefineStepTables, values in Step(%s) row is invalid.", 
 						m_vecDragonSoulNames[i].c_str(), g_astStepName[j].c_str());
@@ -498,7 +499,7 @@ bool DragonSoulTable::CheckDragonHeartExtTables()
 			std::vector <float> vec_chargings;
 			std::vector <float> vec_probs;
 
-			if (!GetDragonHeartExtValues(m_vecDragonSoulTypes[i], j, vec_chargings, vec_probs))
+			if (!ReadDragonHeartExtValues(m_vecDragonSoulTypes[i], j, vec_chargings, vec_probs))
 			{
 				sys_err ("In %s group of DragonHeartExtTables, CHARGING row or Grade(%s) row are invalid.", 
 					m_vecDragonSoulNames[i].c_str(), g_astGradeName[j].c_str());
@@ -670,7 +671,7 @@ bool DragonSoulTable::GetWeight(BYTE ds_type, BYTE grade_idx, BYTE step_index, B
 	return false;
 }
 
-bool DragonSoulTable::GetRefineGradeValues(BYTE ds_type, BYTE grade_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs)
+bool DragonSoulTable::ReadRefineGradeValues(BYTE ds_type, BYTE grade_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs)
 {
 	if (grade_idx >= DRAGON_SOUL_GRADE_MAX -1)
 	{
@@ -718,7 +719,7 @@ bool DragonSoulTable::GetRefineGradeValues(BYTE ds_type, BYTE grade_idx, OUT int
 	return true;
 }
 
-bool DragonSoulTable::GetRefineStepValues(BYTE ds_type, BYTE step_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs)
+bool DragonSoulTable::ReadRefineStepValues(BYTE ds_type, BYTE step_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs)
 {
 	if (step_idx >= DRAGON_SOUL_STEP_MAX - 1)
 	{
@@ -800,7 +801,7 @@ bool DragonSoulTable::GetRefineStrengthValues(BYTE ds_type, BYTE material_type,
 	return true;
 }
 
-bool DragonSoulTable::GetDragonHeartExtValues(BYTE ds_type, BYTE grade_idx, OUT std::vector<float>& vec_chargings, OUT std::vector<float>& vec_probs)
+bool DragonSoulTable::ReadDragonHeartExtValues(BYTE ds_type, BYTE grade_idx, OUT std::vector<float>& vec_chargings, OUT std::vector<float>& vec_probs)
 {
 	if (grade_idx >= DRAGON_SOUL_GRADE_MAX)
 	{
@@ -858,6 +859,105 @@ bool DragonSoulTable::GetDragonHeartExtValues(BYTE ds_type, BYTE grade_idx, OUT
 	return true;
 }
 
+static void MakeCumulativeProbs(const std::vector<float>& vec_probs, OUT std::vector<float>& vec_cum_probs)
+{
+	float sum = 0.f;
+
+	vec_cum_probs.resize(vec_probs.size());
+
+	for (size_t i = 0; i < vec_probs.size(); i++)
+	{
+		sum += vec_probs[i];
+		vec_cum_probs[i] = sum;
+	}
+}
+
+// ˻縦  ̺ θǷ ⼭ ϴ  .
+void DragonSoulTable::BuildRefineTables()
+{
+	m_vecRefineTable.clear();
+	m_vecRefineTable.resize(m_vecDragonSoulTypes.size());
+
+	for (int i = 0; i <= UCHAR_MAX; i++)
+		m_aiRefineTableIndex[i] = -1;
+
+	for (int i = 0; i < m_vecDragonSoulTypes.size(); i++)
+	{
+		BYTE ds_type = m_vecDragonSoulTypes[i];
+		TRefineTable & rkTable = m_vecRefineTable[i];
+
+		for (int j = 0; j < DRAGON_SOUL_GRADE_MAX - 1; j++)
+		{
+			TRefineValues & rkValues = rkTable.akGrade[j];
+			ReadRefineGradeValues(ds_type, j, rkValues.need_count, rkValues.fee, rkValues.vec_probs);
+			MakeCumulativeProbs(rkValues.vec_probs, rkValues.vec_cum_probs);
+		}
+
+		for (int j = 0; j < DRAGON_SOUL_STEP_MAX - 1; j++)
+		{
+			TRefineValues & rkValues = rkTable.akStep[j];
+			ReadRefineStepValues(ds_type, j, rkValues.need_count, rkValues.fee, rkValues.vec_probs);
+			MakeCumulativeProbs(rkValues.vec_probs, rkValues.vec_cum_probs);
+		}
+
+		for (int j = 0; j < DRAGON_SOUL_GRADE_MAX; j++)
+		{
+			TDragonHeartExtValues & rkValues = rkTable.akDragonHeartExt[j];
+			ReadDragonHeartExtValues(ds_type, j, rkValues.vec_chargings, rkValues.vec_probs);
+			MakeCumulativeProbs(rkValues.vec_probs, rkValues.vec_cum_probs);
+		}
+
+		m_aiRefineTableIndex[ds_type] = i;
+	}
+}
+
+const DragonSoulTable::TRefineTable * DragonSoulTable::GetRefineTable(BYTE ds_type) const
+{
+	if (m_aiRefineTableIndex[ds_type] < 0)
+	{
+		sys_err ("Invalid dragon soul type(%d).", ds_type);
+		return NULL;
+	}
+
+	return &m_vecRefineTable[m_aiRefineTableIndex[ds_type]];
+}
+
+const DragonSoulTable::TRefineValues * DragonSoulTable::GetRefineGradeValues(BYTE ds_type, BYTE grade_idx) const
+{
+	if (grade_idx >= DRAGON_SOUL_GRADE_MAX -1)
+	{
+		sys_err ("Invalid dragon soul grade_idx(%d).", grade_idx);
+		return NULL;
+	}
+
+	const TRefineTable * pkTable = GetRefineTable(ds_type);
+	return pkTable ? &pkTable->akGrade[grade_idx] : NULL;
+}
+
+const DragonSoulTable::TRefineValues * DragonSoulTable::GetRefineStepValues(BYTE ds_type, BYTE step_idx) const
+{
+	if (step_idx >= DRAGON_SOUL_STEP_MAX - 1)
+	{
+		sys_err ("Invalid dragon soul step_idx(%d).", step_idx);
+		return NULL;
+	}
+
+	const TRefineTable * pkTable = GetRefineTable(ds_type);
+	return pkTable ? &pkTable->akStep[step_idx] : NULL;
+}
+
+const DragonSoulTable::TDragonHeartExtValues * DragonSoulTable::GetDragonHeartExtValues(BYTE ds_type, BYTE grade_idx) const
+{
+	if (grade_idx >= DRAGON_SOUL_GRADE_MAX)
+	{
+		sys_err ("Invalid dragon soul grade_idx(%d).", grade_idx);
+		return NULL;
+	}
+
+	const TRefineTable * pkTable = GetRefineTable(ds_type);
+	return pkTable ? &pkTable->akDragonHeartExt[grade_idx] : NULL;
+}
+
 bool DragonSoulTable::GetDragonSoulExtValues(BYTE ds_type, BYTE grade_idx, OUT float& prob, OUT DWORD& by_product)
 {
 	if (grade_idx >= DRAGON_SOUL_GRADE_MAX)
@@ -894,6 +994,9 @@ bool DragonSoulTable::GetDragonSoulExtValues(BYTE ds_type, BYTE grade_idx, OUT f
 DragonSoulTable::DragonSoulTable()
 {
 	m_pLoader = NULL;
+
+	for (int i = 0; i <= UCHAR_MAX; i++)
+		m_aiRefineTableIndex[i] = -1;
 }
 DragonSoulTable::~DragonSoulTable ()
 {
@@ -20,6 +20,22 @@ public:
 	~DragonSoulTable();
 	typedef std::vector <SApply> TVecApplys;
 	typedef std::map <BYTE, TVecApplys> TMapApplyGroup;
+
+	//   ã . ε   ΰ ͷ ش.
+	typedef struct SRefineValues
+	{
+		int			need_count;
+		int			fee;
+		std::vector <float>	vec_probs;
+		std::vector <float>	vec_cum_probs;	///< vec_probs   .   ü 
+	} TRefineValues;
+
+	typedef struct SDragonHeartExtValues
+	{
+		std::vector <float>	vec_chargings;
+		std::vector <float>	vec_probs;
+		std::vector <float>	vec_cum_probs;
+	} TDragonHeartExtValues;
 	
 	bool	ReadDragonSoulTableFile(const char * c_pszFileName);
 	bool	GetDragonSoulGroupName(BYTE bType, std::string& stGroupName) const;
@@ -29,10 +45,10 @@ public:
 
 	bool	GetApplyNumSettings(BYTE ds_type, BYTE grade_idx, OUT int& basis, OUT int& add_min, OUT int& add_max);
 	bool	GetWeight(BYTE ds_type, BYTE grade_idx, BYTE step_index, BYTE strength_idx, OUT float& fWeight);
-	bool	GetRefineGradeValues(BYTE ds_type, BYTE grade_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs);
-	bool	GetRefineStepValues(BYTE ds_type, BYTE step_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs);
+	const TRefineValues *		GetRefineGradeValues(BYTE ds_type, BYTE grade_idx) const;
+	const TRefineValues *		GetRefineStepValues(BYTE ds_type, BYTE step_idx) const;
 	bool	GetRefineStrengthValues(BYTE ds_type, BYTE material_type, BYTE strength_idx, OUT int& fee, OUT float& prob);
-	bool	GetDragonHeartExtValues(BYTE ds_type, BYTE grade_idx, OUT std::vector<float>& vec_chargings, OUT std::vector<float>& vec_probs);
+	const TDragonHeartExtValues *	GetDragonHeartExtValues(BYTE ds_type, BYTE grade_idx) const;
 	bool	GetDragonSoulExtValues(BYTE ds_type, BYTE grade_idx, OUT float& prob, OUT DWORD& by_product);
 
 private:
@@ -58,6 +74,24 @@ private:
 	TMapApplyGroup m_map_basic_applys_group;
 	TMapApplyGroup m_map_additional_applys_group;
 
+	typedef struct SRefineTable
+	{
+		TRefineValues		akGrade[DRAGON_SOUL_GRADE_MAX - 1];
+		TRefineValues		akStep[DRAGON_SOUL_STEP_MAX - 1];
+		TDragonHeartExtValues	akDragonHeartExt[DRAGON_SOUL_GRADE_MAX];
+	} TRefineTable;
+
+	std::vector <TRefineTable>	m_vecRefineTable;		///< m_vecDragonSoulTypes   
+	int				m_aiRefineTableIndex[UCHAR_MAX + 1];	///< ds_type -> m_vecRefineTable ε,  -1
+
+	const TRefineTable *	GetRefineTable(BYTE ds_type) const;
+	void	BuildRefineTables();
+
+	// Ʈ  д´. ε  ˻ BuildRefineTables  .
+	bool	ReadRefineGradeValues(BYTE ds_type, BYTE grade_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs);
+	bool	ReadRefineStepValues(BYTE ds_type, BYTE step_idx, OUT int& need_count, OUT int& fee, OUT std::vector<float>& vec_probs);
+	bool	ReadDragonHeartExtValues(BYTE ds_type, BYTE grade_idx, OUT std::vector<float>& vec_chargings, OUT std::vector<float>& vec_probs);
+
 	bool	ReadVnumMapper();
 	bool	ReadBasicApplys();
 	bool	ReadAdditionalApplys();
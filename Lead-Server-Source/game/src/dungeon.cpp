@@ -331,7 +331,7 @@ void CDungeon::JumpAll(long lFromMapIndex, int x, int y)
 	FWarpToPosition f(m_lMapIndex, x, y);
 
 	// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_PC, f);
 }
 
 void CDungeon::WarpAll(long lFromMapIndex, int x, int y)
@@ -350,7 +350,7 @@ void CDungeon::WarpAll(long lFromMapIndex, int x, int y)
 	FWarpToPositionForce f(m_lMapIndex, x, y);
 
 	// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_PC, f);
 }
 
 void CDungeon::JumpParty(LPPARTY pParty, long lFromMapIndex, int x, int y)
@@ -1046,7 +1046,7 @@ int CDungeon::CountRealMonster()
 	FCountMonster f;
 
 	// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_NPC | SPATIAL_KIND_BUILDING, f);
 	return f.n;
 }
 
@@ -1077,7 +1077,7 @@ void CDungeon::ExitAll()
 	FExitDungeon f;
 
 	// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_PC, f);
 }
 
 // DUNGEON_NOTICE
@@ -1114,7 +1114,7 @@ void CDungeon::Notice(const char* msg)
 	}
 
 	FNotice f(msg);
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_PC, f);
 }
 // END_OF_DUNGEON_NOTICE
 
@@ -1153,7 +1153,7 @@ void CDungeon::ExitAllToStartPosition()
 	FExitDungeonToStartPosition f;
 
 	// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_PC, f);
 }
 
 EVENTFUNC(dungeon_jump_to_event)
@@ -1292,7 +1292,7 @@ void CDungeon::JumpToEliminateLocation()
 		FWarpToPosition f(m_lWarpMapIndex, m_lWarpX * 100, m_lWarpY * 100);
 
 		// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-		pMap->for_each(f);
+		pMap->for_each_kind(SPATIAL_KIND_PC, f);
 	}
 }
 
@@ -1339,7 +1339,7 @@ bool CDungeon::IsAllPCNearTo(int x, int y, int dist)
 	FNearPosition f(x, y, dist);
 
 	// <Factor> SECTREE::for_each -> SECTREE::for_each_entity
-	pMap->for_each(f);
+	pMap->for_each_kind(SPATIAL_KIND_PC, f);
 
 	return f.ret;
 }
@@ -2,6 +2,7 @@
 #include "char.h"
 #include "desc.h"
 #include "sectree_manager.h"
+#include "config.h"
 
 CEntity::CEntity()
 {
@@ -20,10 +21,14 @@ void CEntity::Initialize(int type)
 
 	m_iType = type;
 	m_iViewAge = 0;
+	m_dwViewLODSequence = 0;
 	m_pos.x = m_pos.y = m_pos.z = 0;
 	m_map_view.clear();
 
 	m_pSectree = NULL;
+	m_iSpatialCell = -1;
+	m_iSpatialSlot = -1;
+	m_iSpatialKindSlot = -1;
 	m_lpDesc = NULL;
 	m_lMapIndex = 0;
 	m_bIsObserver = false;
@@ -39,6 +44,11 @@ void CEntity::Destroy()
 	m_bIsDestroyed = true;
 }
 
+void CEntity::UpdateSpatial()
+{
+	m_pSectree->MoveSpatial(this);
+}
+
 void CEntity::SetType(int type)
 {
 	m_iType = type;
@@ -54,14 +64,25 @@ bool CEntity::IsType(int type) const
 	return (m_iType == type ? true : false);
 }
 
+// εĳƮ Ŷ ѹ 8Ʈ  е ΰ  viewer Ѵ.
+static std::vector<char> s_vecBroadcastPayload;
+
 struct FuncPacketAround
 {
 	const void *        m_data;
 	int                 m_bytes;
 	LPENTITY            m_except;
 
-	FuncPacketAround(const void * data, int bytes, LPENTITY except = NULL) :m_data(data), m_bytes(bytes), m_except(except)
+	FuncPacketAround(const void * data, int bytes, LPENTITY except = NULL) : m_bytes(bytes), m_except(except)
 	{
+		size_t padded = (bytes + 7) & ~7;
+
+		if (s_vecBroadcastPayload.size() < padded)
+			s_vecBroadcastPayload.resize(padded);
+
+		thecore_memcpy(&s_vecBroadcastPayload[0], data, bytes);
+		memset(&s_vecBroadcastPayload[0] + bytes, 0, padded - bytes);
+		m_data = &s_vecBroadcastPayload[0];
 	}
 
 	void operator () (LPENTITY ent)
@@ -70,7 +91,7 @@ struct FuncPacketAround
 			return;
 
 		if (ent->GetDesc())
-			ent->GetDesc()->Packet(m_data, m_bytes);
+			ent->GetDesc()->SharedPacket(m_data, m_bytes);
 	}
 };
 
@@ -85,6 +106,36 @@ struct FuncPacketView : public FuncPacketAround
 	}
 };
 
+struct FuncPacketViewLOD : public FuncPacketAround
+{
+	LPENTITY	m_pkSelf;
+	long long	m_llRangeSq;
+
+	FuncPacketViewLOD(const void * data, int bytes, LPENTITY except, LPENTITY self, int iRange)
+		: FuncPacketAround(data, bytes, except), m_pkSelf(self), m_llRangeSq((long long) iRange * iRange)
+	{}
+
+	void operator() (const CEntity::ENTITY_MAP::value_type& v)
+	{
+		LPENTITY ent = v.first;
+
+		if (!ent->GetDesc())
+			return;
+
+		// ڴ Ÿ  ָ ִ viewer ó  󵵷θ ޴´.
+		if (ent != m_pkSelf && ent->IsObserverMode())
+			return;
+
+		long long dx = ent->GetX() - m_pkSelf->GetX();
+		long long dy = ent->GetY() - m_pkSelf->GetY();
+
+		if (dx * dx + dy * dy > m_llRangeSq)
+			return;
+
+		FuncPacketAround::operator() (ent);
+	}
+};
+
 void CEntity::PacketAround(const void * data, int bytes, LPENTITY except)
 {
 	PacketView(data, bytes, except);
@@ -104,6 +155,30 @@ void CEntity::PacketView(const void * data, int bytes, LPENTITY except)
 	f(std::make_pair(this, 0));
 }
 
+void CEntity::PacketViewLOD(const void * data, int bytes, LPENTITY except)
+{
+	int iRange, iInterval;
+
+	view_lod_get(GetMapIndex(), &iRange, &iInterval);
+
+	// ̹ ʿ ָ ִ viewer  ޴´.
+	if (iRange <= 0 || iInterval <= 1 || ++m_dwViewLODSequence % iInterval == 0)
+	{
+		PacketView(data, bytes, except);
+		return;
+	}
+
+	if (!GetSectree())
+		return;
+
+	FuncPacketViewLOD f(data, bytes, except, this, iRange);
+
+	if (!m_bIsObserver)
+		for_each(m_map_view.begin(), m_map_view.end(), f);
+
+	f(std::make_pair(this, 0));
+}
+
 void CEntity::SetObserverMode(bool bFlag)
 {
 	if (m_bIsObserver == bFlag)
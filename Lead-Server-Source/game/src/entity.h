@@ -3,10 +3,82 @@
 
 class SECTREE;
 
+/**
+ * Set of entities in view, kept as a vector sorted by entity pointer with the
+ * view age stored inline. Iterators are invalidated by insert and erase, use
+ * the iterator returned by erase to keep walking.
+ */
+class CEntityViewSet
+{
+	public:
+		typedef std::pair<LPENTITY, int>		value_type;
+		typedef std::vector<value_type>			container_type;
+		typedef container_type::iterator		iterator;
+		typedef container_type::const_iterator	const_iterator;
+
+	public:
+		iterator		begin()			{ return m_vec.begin();	}
+		iterator		end()			{ return m_vec.end();	}
+		const_iterator	begin() const	{ return m_vec.begin();	}
+		const_iterator	end() const		{ return m_vec.end();	}
+
+		size_t			size() const	{ return m_vec.size();	}
+		bool			empty() const	{ return m_vec.empty();	}
+
+		iterator find(LPENTITY ent)
+		{
+			iterator it = std::lower_bound(m_vec.begin(), m_vec.end(), ent, LessEntity());
+
+			if (it != m_vec.end() && it->first == ent)
+				return it;
+
+			return m_vec.end();
+		}
+
+		std::pair<iterator, bool> insert(const value_type & v)
+		{
+			iterator it = std::lower_bound(m_vec.begin(), m_vec.end(), v.first, LessEntity());
+
+			if (it != m_vec.end() && it->first == v.first)
+				return std::make_pair(it, false);
+
+			return std::make_pair(m_vec.insert(it, v), true);
+		}
+
+		iterator		erase(iterator it)	{ return m_vec.erase(it); }
+
+		void clear()
+		{
+			container_type().swap(m_vec);
+		}
+
+		// give back memory left over from a crowd that has moved out of view
+		void shrink()
+		{
+			if (m_vec.capacity() > 32 && m_vec.size() * 4 < m_vec.capacity())
+				container_type(m_vec).swap(m_vec);
+		}
+
+		size_t GetMemoryUsage() const
+		{
+			return m_vec.capacity() * sizeof(value_type);
+		}
+
+	private:
+		struct LessEntity
+		{
+			bool operator () (const value_type & v, LPENTITY ent) const { return v.first < ent; }
+		};
+
+		container_type	m_vec;
+};
+
 class CEntity
 {
+	friend class SECTREE;
+
 	public:
-		typedef TR1_NS::unordered_map<LPENTITY, int> ENTITY_MAP;
+		typedef CEntityViewSet ENTITY_MAP;
 
 	public:
 		CEntity();
@@ -31,21 +103,27 @@ class CEntity
 		void			ViewReencode();	//  Entity Ŷ ٽ .
 
 		int				GetViewAge() const	{ return m_iViewAge;	}
+		size_t			GetViewCount() const	{ return m_map_view.size();	}
+		size_t			GetViewMemoryUsage() const	{ return m_map_view.GetMemoryUsage();	}
 
 		long			GetX() const		{ return m_pos.x; }
 		long			GetY() const		{ return m_pos.y; }
 		long			GetZ() const		{ return m_pos.z; }
 		const PIXEL_POSITION &	GetXYZ() const		{ return m_pos; }
 
-		void			SetXYZ(long x, long y, long z)		{ m_pos.x = x, m_pos.y = y, m_pos.z = z; }
-		void			SetXYZ(const PIXEL_POSITION & pos)	{ m_pos = pos; }
+		void			SetXYZ(long x, long y, long z)		{ m_pos.x = x, m_pos.y = y, m_pos.z = z; if (m_pSectree) UpdateSpatial(); }
+		void			SetXYZ(const PIXEL_POSITION & pos)	{ m_pos = pos; if (m_pSectree) UpdateSpatial(); }
 
 		LPSECTREE		GetSectree() const			{ return m_pSectree;	}
 		void			SetSectree(LPSECTREE tree)	{ m_pSectree = tree;	}
 
 		void			UpdateSectree();
+		// Ѳ Ʈ  ƼƼ þ߸ . ֺ ƼƼ Ʈ   .
+		static void		UpdateSectreeBulk(const std::vector<LPENTITY> & c_rvec_pkEnt);
 		void			PacketAround(const void * data, int bytes, LPENTITY except = NULL);
 		void			PacketView(const void * data, int bytes, LPENTITY except = NULL);
+		// ̵ó  Ŷ    . view_lod Ÿ  viewer  ڿԴ     .
+		void			PacketViewLOD(const void * data, int bytes, LPENTITY except = NULL);
 
 		void			BindDesc(LPDESC _d)     { m_lpDesc = _d; }
 		LPDESC			GetDesc() const			{ return m_lpDesc; }
@@ -71,8 +149,16 @@ class CEntity
 		PIXEL_POSITION		m_pos;
 
 		int			m_iViewAge;
+		DWORD		m_dwViewLODSequence;
 
 		LPSECTREE		m_pSectree;
+
+		// position of this entity in its sectree's spatial cells, -1 when not linked
+		void			UpdateSpatial();
+
+		int			m_iSpatialCell;
+		int			m_iSpatialSlot;
+		int			m_iSpatialKindSlot;	// index in the sectree's list of its kind
 };
 
 #endif
@@ -150,14 +150,14 @@ void CEntity::UpdateSectree()
 
 			while (it != m_map_view.end())
 			{
-				this_it = it++;
+				this_it = it;
 				if (this_it->second < m_iViewAge)
 				{
 					LPENTITY ent = this_it->first;
 
 					//    .
 					ent->EncodeRemovePacket(this);
-					m_map_view.erase(this_it);
+					it = m_map_view.erase(this_it);
 
 					//    .
 					ent->ViewRemove(this, false);
@@ -174,6 +174,7 @@ void CEntity::UpdateSectree()
 					//    .
 					//ent->ViewRemove(this, false);
 					EncodeRemovePacket(ent);
+					++it;
 				}
 			}
 		}
@@ -183,7 +184,7 @@ void CEntity::UpdateSectree()
 
 			while (it != m_map_view.end())
 			{
-				this_it = it++;
+				this_it = it;
 
 				if (this_it->second < m_iViewAge)
 				{
@@ -191,7 +192,7 @@ void CEntity::UpdateSectree()
 
 					//    .
 					ent->EncodeRemovePacket(this);
-					m_map_view.erase(this_it);
+					it = m_map_view.erase(this_it);
 
 					//    .
 					ent->ViewRemove(this, false);
@@ -203,6 +204,7 @@ void CEntity::UpdateSectree()
 					EncodeInsertPacket(ent);
 
 					ent->ViewInsert(this, true);
+					++it;
 				}
 			}
 		}
@@ -217,7 +219,7 @@ void CEntity::UpdateSectree()
 
 			while (it != m_map_view.end())
 			{
-				this_it = it++;
+				this_it = it;
 
 				if (this_it->second < m_iViewAge)
 				{
@@ -225,13 +227,64 @@ void CEntity::UpdateSectree()
 
 					//    .
 					ent->EncodeRemovePacket(this);
-					m_map_view.erase(this_it);
+					it = m_map_view.erase(this_it);
 
 					//    .
 					ent->ViewRemove(this, false);
 				}
+				else
+					++it;
 			}
 		}
 	}
+
+	m_map_view.shrink();
+}
+
+void CEntity::UpdateSectreeBulk(const std::vector<LPENTITY> & c_rvec_pkEnt)
+{
+	std::vector<bool> vec_bDone(c_rvec_pkEnt.size(), false);
+
+	for (size_t i = 0; i < c_rvec_pkEnt.size(); ++i)
+	{
+		if (vec_bDone[i])
+			continue;
+
+		LPENTITY pkFirst = c_rvec_pkEnt[i];
+		LPSECTREE pkSectree = pkFirst->GetSectree();
+
+		if (!pkSectree)
+		{
+			pkFirst->UpdateSectree();
+			vec_bDone[i] = true;
+			continue;
+		}
+
+		//  Ʈ ִ ƼƼ   ֺ  
+		FCollectEntity collector;
+		pkSectree->ForEachAround(collector);
+
+		for (size_t j = i; j < c_rvec_pkEnt.size(); ++j)
+		{
+			LPENTITY ent = c_rvec_pkEnt[j];
+
+			if (vec_bDone[j] || ent->GetSectree() != pkSectree)
+				continue;
+
+			vec_bDone[j] = true;
+
+			// ̹ þ߰   ͵ ãƾ ϹǷ  Ѵ
+			if (!ent->m_map_view.empty() || ent->m_bObserverModeChange)
+			{
+				ent->UpdateSectree();
+				continue;
+			}
+
+			++ent->m_iViewAge;
+
+			CFuncViewInsert f(ent);
+			collector.ForEach(f);
+		}
+	}
 }
 
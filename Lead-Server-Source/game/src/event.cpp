@@ -7,14 +7,114 @@
 #include "stdafx.h"
 
 #include "event_queue.h"
+#include "pulse_stat.h"
 
 extern void ContinueOnFatalError();
 extern void ShutdownOnFatalError();
 
+// Լ ͺ . ̺Ʈ   ڱ ׸  Ƿ   ã ʴ´.
+// unordered_map   rehash Ǿ ּҰ ٲ ʴ´. ť   ʰ ش.
+typedef TR1_NS::unordered_map<TEVENTFUNC, TEventFuncStat> TEventFuncStatMap;
+static TEventFuncStatMap s_map_funcStat;
+
 static CEventQueue cxx_q;
+static int s_iFiredPeak = 0;
+
+static TEventFuncStat * event_func_stat(TEVENTFUNC func, const char * c_pszFuncName)
+{
+	TEventFuncStatMap::iterator it = s_map_funcStat.find(func);
+
+	if (it == s_map_funcStat.end())
+	{
+		TEventFuncStat stat;
+		memset(&stat, 0, sizeof(stat));
+		stat.name = c_pszFuncName ? c_pszFuncName : "unknown";
+
+		it = s_map_funcStat.insert(TEventFuncStatMap::value_type(func, stat)).first;
+	}
+
+	return &it->second;
+}
+
+namespace
+{
+	enum
+	{
+		EVENT_INFO_SIZE_STEP	= 16,
+		EVENT_INFO_SIZE_CLASSES	= 8,	// infos up to 128 bytes are pooled
+		EVENT_INFO_FREE_TRIGGER	= 8192,
+	};
+
+	template <size_t CLASS>
+	struct TEventInfoBlock
+	{
+		char data[CLASS * EVENT_INFO_SIZE_STEP];
+	};
+
+	template <size_t CLASS>
+	struct TEventInfoPool
+	{
+		typedef LateAllocator<TEventInfoBlock<CLASS>, EVENT_INFO_FREE_TRIGGER> Allocator;
+
+		static void* Alloc()		{ return Allocator::Alloc(sizeof(TEventInfoBlock<CLASS>)); }
+		static void Free(void* p)	{ Allocator::Free(p); }
+		static size_t GetUsed()		{ return Allocator::GetUsedBlockCount(); }
+		static size_t GetFree()		{ return Allocator::GetFreeBlockCount(); }
+	};
+
+	struct TEventInfoPoolFunc
+	{
+		void*	(*Alloc)();
+		void	(*Free)(void*);
+		size_t	(*GetUsed)();
+		size_t	(*GetFree)();
+	};
+
+#define EVENT_INFO_POOL(n) { TEventInfoPool<n>::Alloc, TEventInfoPool<n>::Free, TEventInfoPool<n>::GetUsed, TEventInfoPool<n>::GetFree }
+
+	const TEventInfoPoolFunc s_aInfoPools[EVENT_INFO_SIZE_CLASSES] =
+	{
+		EVENT_INFO_POOL(1), EVENT_INFO_POOL(2), EVENT_INFO_POOL(3), EVENT_INFO_POOL(4),
+		EVENT_INFO_POOL(5), EVENT_INFO_POOL(6), EVENT_INFO_POOL(7), EVENT_INFO_POOL(8),
+	};
+
+#undef EVENT_INFO_POOL
+}
+
+// Every EVENTINFO is created with AllocEventInfo<T>() and deleted through the
+// virtual destructor, which passes the size of the most derived type here.
+void* event_info_data::operator new(size_t size)
+{
+	mem_stat_alloc(MEM_TAG_EVENT, size);
+
+	size_t idx = (size + EVENT_INFO_SIZE_STEP - 1) / EVENT_INFO_SIZE_STEP;
+
+	if (idx == 0 || idx > EVENT_INFO_SIZE_CLASSES)
+		return ::malloc(size);
+
+	return s_aInfoPools[idx - 1].Alloc();
+}
+
+void event_info_data::operator delete(void* p, size_t size)
+{
+	if (!p)
+		return;
+
+	mem_stat_free(MEM_TAG_EVENT, size);
+
+	size_t idx = (size + EVENT_INFO_SIZE_STEP - 1) / EVENT_INFO_SIZE_STEP;
+
+	if (idx == 0 || idx > EVENT_INFO_SIZE_CLASSES)
+	{
+		::free(p);
+		return;
+	}
+
+	s_aInfoPools[idx - 1].Free(p);
+}
 
 /* ̺Ʈ ϰ Ѵ */
-LPEVENT event_create_ex(TEVENTFUNC func, event_info_data* info, long when)
+LPEVENT event_create_ex(TEVENTFUNC func, event_info_data* info, long when, const char * c_pszFuncName)
 {
 	LPEVENT new_event = NULL;
 
@@ -28,6 +128,8 @@ LPEVENT event_create_ex(TEVENTFUNC func, event_info_data* info, long when)
 
 	new_event->func = func;
 	new_event->info	= info;
+	new_event->stat	= event_func_stat(func, c_pszFuncName);
+	++new_event->stat->live;
 	new_event->q_el	= cxx_q.Enqueue(new_event, when, thecore_heart->pulse);
 	new_event->is_processing = FALSE;
 	new_event->is_force_to_end = FALSE;
@@ -54,7 +156,10 @@ void event_cancel(LPEVENT * ppevent)
 		event->is_force_to_end = TRUE;
 
 		if (event->q_el)
-			event->q_el->bCancel = TRUE;
+		{
+			cxx_q.Cancel(event->q_el);
+			event->q_el = NULL;
+		}
 
 		*ppevent = NULL;
 		return;
@@ -67,13 +172,8 @@ void event_cancel(LPEVENT * ppevent)
 		return;
 	}
 
-	if (event->q_el->bCancel)
-	{
-		*ppevent = NULL;
-		return;
-	}
-
-	event->q_el->bCancel = TRUE;
+	cxx_q.Cancel(event->q_el);
+	event->q_el = NULL;
 
 	*ppevent = NULL;
 }
@@ -83,9 +183,9 @@ void event_reset_time(LPEVENT event, long when)
 	if (!event->is_processing)
 	{
 		if (event->q_el)
-			event->q_el->bCancel = TRUE;
-
-		event->q_el = cxx_q.Enqueue(event, when, thecore_heart->pulse);
+			cxx_q.Requeue(event->q_el, when, thecore_heart->pulse);
+		else
+			event->q_el = cxx_q.Enqueue(event, when, thecore_heart->pulse);
 	}
 }
 
@@ -94,19 +194,14 @@ int event_process(int pulse)
 {
 	long	new_time;
 	int		num_events = 0;
+	TQueueElement * pElem;
+
+	cxx_q.Collect();
 
 	// event_q  ̺Ʈ ť  ð  pulse    
 	//  ʰ ȴ.
-	while (pulse >= cxx_q.GetTopKey())
+	while ((pElem = cxx_q.Dequeue(pulse)))
 	{
-		TQueueElement * pElem = cxx_q.Dequeue();
-
-		if (pElem->bCancel)
-		{
-			cxx_q.Delete(pElem);
-			continue;
-		}
-
 		new_time = pElem->iKey;
 
 		LPEVENT the_event = pElem->pvData;
@@ -129,8 +224,18 @@ int event_process(int pulse)
 		else
 		{
 			//sys_log(0, "EVENT: %s %d event %p info %p", the_event->file, the_event->line, the_event, the_event->info);
+			DWORD dwStartUSec = pulse_stat_usec();
+			TEventFuncStat * pStat = the_event->stat;
+
 			new_time = (the_event->func) (get_pointer(the_event), processing_time);
-			
+
+			DWORD dwUSec = pulse_stat_usec() - dwStartUSec;
+			++pStat->calls;
+			pStat->usec += dwUSec;
+
+			if (dwUSec > pStat->max_usec)
+				pStat->max_usec = dwUSec;
+
 			if (new_time <= 0 || the_event->is_force_to_end)
 			{
 				the_event->q_el = NULL;
@@ -145,6 +250,9 @@ int event_process(int pulse)
 		++num_events;
 	}
 
+	if (num_events > s_iFiredPeak)
+		s_iFiredPeak = num_events;
+
 	return num_events;
 }
 
@@ -175,25 +283,83 @@ long event_time(LPEVENT event)
 /*  ̺Ʈ Ѵ */
 void event_destroy(void)
 {
-	TQueueElement * pElem;
+	cxx_q.Destroy();
+}
+
+int event_count()
+{
+	return cxx_q.Size();
+}
 
-	while ((pElem = cxx_q.Dequeue()))
+void event_get_pool_stat(TEventPoolStat & rStat)
+{
+	rStat.event_used = EVENT::GetUsedBlockCount();
+	rStat.event_free = EVENT::GetFreeBlockCount();
+	rStat.element_used = TQueueElement::GetUsedBlockCount();
+	rStat.element_free = TQueueElement::GetFreeBlockCount();
+	rStat.info_used = 0;
+	rStat.info_free = 0;
+
+	for (int i = 0; i < EVENT_INFO_SIZE_CLASSES; ++i)
 	{
-		LPEVENT the_event = (LPEVENT) pElem->pvData;
+		rStat.info_used += s_aInfoPools[i].GetUsed();
+		rStat.info_free += s_aInfoPools[i].GetFree();
+	}
+}
 
-		if (!pElem->bCancel)
-		{
-			// no op here
-		}
+struct FEventFuncStatGreater
+{
+	bool operator () (const TEventFuncStat & lhs, const TEventFuncStat & rhs) const
+	{
+		return lhs.usec > rhs.usec;
+	}
+};
 
-		cxx_q.Delete(pElem);
-		the_event->q_el = NULL;
+void event_get_func_stat(std::vector<TEventFuncStat> & r_vec)
+{
+	r_vec.clear();
+	r_vec.reserve(s_map_funcStat.size());
+
+	for (TEventFuncStatMap::const_iterator it = s_map_funcStat.begin(); it != s_map_funcStat.end(); ++it)
+		r_vec.push_back(it->second);
+
+	std::sort(r_vec.begin(), r_vec.end(), FEventFuncStatGreater());
+}
+
+void event_reset_func_stat()
+{
+	for (TEventFuncStatMap::iterator it = s_map_funcStat.begin(); it != s_map_funcStat.end(); ++it)
+	{
+		TEventFuncStat & rStat = it->second;
+		rStat.calls = 0;
+		rStat.usec = 0;
+		rStat.max_usec = 0;
 	}
 }
 
-int event_count()
+void event_log_func_stat()
 {
-	return cxx_q.Size();
+	std::vector<TEventFuncStat> vec;
+	event_get_func_stat(vec);
+
+	for (size_t i = 0; i < vec.size(); ++i)
+	{
+		const TEventFuncStat & rStat = vec[i];
+
+		if (!rStat.calls && !rStat.live)
+			continue;
+
+		sys_log(0, "EVENT_STAT: %-40s calls %10u usec %12llu avg %6u max %8u live %u",
+				rStat.name, rStat.calls, (unsigned long long) rStat.usec,
+				rStat.calls ? (DWORD) (rStat.usec / rStat.calls) : 0, rStat.max_usec, rStat.live);
+	}
+}
+
+int event_fired_peak()
+{
+	int peak = s_iFiredPeak;
+	s_iFiredPeak = 0;
+	return peak;
 }
 
 void intrusive_ptr_add_ref(EVENT* p) {
@@ -202,6 +368,9 @@ void intrusive_ptr_add_ref(EVENT* p) {
 
 void intrusive_ptr_release(EVENT* p) {
 	if ( --(p->ref_count) == 0 ) {
+		if (p->stat)
+			--p->stat->live;
+
 		M2_DELETE(p);
 	}
 }
@@ -9,13 +9,23 @@
 
 #include <boost/intrusive_ptr.hpp>
 
+#include "object_allocator.h"
+
+// Freed events and queue elements kept for reuse before going back to the heap
+enum { EVENT_POOL_FREE_TRIGGER = 65536 };
+
 /**
  * Base class for all event info data
+ *
+ * Subclasses are allocated from per-size pools, see event.cpp.
  */
 struct event_info_data 
 {
 	event_info_data() {}
 	virtual ~event_info_data() {}
+
+	static void* operator new(size_t size);
+	static void operator delete(void* p, size_t size);
 };
 	
 typedef struct event EVENT;
@@ -27,9 +37,19 @@ typedef long (*TEVENTFUNC) (LPEVENT event, long processing_time);
 
 struct TQueueElement;
 
-struct event
+// ̺Ʈ Լ ȣ   ð. ̸ event_create  ѱ Լ ̸̴.
+struct TEventFuncStat
+{
+	const char *	name;
+	DWORD		calls;
+	DWORD		live;		//   ִ ̺Ʈ 
+	uint64_t	usec;
+	DWORD		max_usec;
+};
+
+struct event : public ObjectAllocator<event, EVENT_POOL_FREE_TRIGGER, MEM_TAG_EVENT>
 {
-	event() : func(NULL), info(NULL), q_el(NULL), ref_count(0) {}
+	event() : func(NULL), info(NULL), q_el(NULL), stat(NULL), ref_count(0) {}
 	~event() {
 		if (info != NULL) {
 			M2_DELETE(info);
@@ -38,6 +58,7 @@ struct event
 	TEVENTFUNC			func;
 	event_info_data* 	info;
 	TQueueElement *		q_el;
+	TEventFuncStat *	stat;
 	char				is_force_to_end;
 	char				is_processing;
 
@@ -55,15 +76,32 @@ T* AllocEventInfo() {
 extern void		event_destroy();
 extern int		event_process(int pulse);
 extern int		event_count();
+extern int		event_fired_peak();	// most events fired by one event_process() since the last call
 
-#define event_create(func, info, when) event_create_ex(func, info, when)
-extern LPEVENT	event_create_ex(TEVENTFUNC func, event_info_data* info, long when);
+#define event_create(func, info, when) event_create_ex(func, info, when, #func)
+extern LPEVENT	event_create_ex(TEVENTFUNC func, event_info_data* info, long when, const char * c_pszFuncName = NULL);
 extern void		event_cancel(LPEVENT * event);			// ̺Ʈ 
 extern long		event_processing_time(LPEVENT event);	//  ð 
 extern long		event_time(LPEVENT event);			//  ð 
 extern void		event_reset_time(LPEVENT event, long when);	//  ð  
 extern void		event_set_verbose(int level);
 
+struct TEventPoolStat
+{
+	size_t	event_used;
+	size_t	event_free;
+	size_t	element_used;
+	size_t	element_free;
+	size_t	info_used;
+	size_t	info_free;
+};
+
+extern void		event_get_pool_stat(TEventPoolStat & rStat);
+
+extern void		event_get_func_stat(std::vector<TEventFuncStat> & r_vec);	//  ð ū 
+extern void		event_reset_func_stat();	// live  ״ д
+extern void		event_log_func_stat();
+
 extern event_info_data* FindEventInfo(DWORD dwID);
 extern event_info_data*	event_info(LPEVENT event);
 
@@ -8,8 +8,11 @@
 
 #include "event_queue.h"
 
-CEventQueue::CEventQueue()
+CEventQueue::CEventQueue() : m_iCurrent(0), m_iSize(0)
 {
+	memset(m_aSlots, 0, sizeof(m_aSlots));
+	m_kCanceled.pHead = NULL;
+	m_kCanceled.pTail = NULL;
 }
 
 CEventQueue::~CEventQueue()
@@ -19,13 +22,25 @@ CEventQueue::~CEventQueue()
 
 void CEventQueue::Destroy()
 {
-	while (!m_pq_queue.empty())
+	for (int iLevel = 0; iLevel < WHEEL_LEVELS; ++iLevel)
 	{
-		TQueueElement * pElem = m_pq_queue.top();
-		m_pq_queue.pop();
+		for (int iIndex = 0; iIndex < WHEEL_SIZE; ++iIndex)
+		{
+			TQueueSlot & rSlot = m_aSlots[iLevel][iIndex];
 
-		Delete(pElem);
+			while (rSlot.pHead)
+			{
+				TQueueElement * pElem = rSlot.pHead;
+				Unlink(pElem);
+
+				pElem->pvData->q_el = NULL;
+				Delete(pElem);
+			}
+		}
 	}
+
+	m_iSize = 0;
+	Collect();
 }
 
 TQueueElement * CEventQueue::Enqueue(LPEVENT pvData, int duration, int pulse)
@@ -35,20 +50,34 @@ TQueueElement * CEventQueue::Enqueue(LPEVENT pvData, int duration, int pulse)
 	pElem->pvData = pvData;
 	pElem->iStartTime = pulse;
 	pElem->iKey = duration + pulse;
-	pElem->bCancel = FALSE;
+	pElem->pSlot = NULL;
+	pElem->pPrev = NULL;
+	pElem->pNext = NULL;
 
-	m_pq_queue.push(pElem);
+	Link(pElem);
+	++m_iSize;
 	return pElem;
 }
 
-TQueueElement * CEventQueue::Dequeue()
+TQueueElement * CEventQueue::Dequeue(int pulse)
 {
-	if (m_pq_queue.empty())
-		return NULL;
+	while (true)
+	{
+		TQueueSlot & rSlot = m_aSlots[0][m_iCurrent & WHEEL_MASK];
 
-	TQueueElement * pElem = m_pq_queue.top();
-	m_pq_queue.pop();
-	return pElem;
+		if (rSlot.pHead)
+		{
+			TQueueElement * pElem = rSlot.pHead;
+			Unlink(pElem);
+			--m_iSize;
+			return pElem;
+		}
+
+		if (m_iCurrent - pulse >= 0)
+			return NULL;
+
+		Advance();
+	}
 }
 
 void CEventQueue::Delete(TQueueElement * pElem)
@@ -56,16 +85,128 @@ void CEventQueue::Delete(TQueueElement * pElem)
 	M2_DELETE(pElem);
 }
 
-int CEventQueue::GetTopKey()
+void CEventQueue::Cancel(TQueueElement * pElem)
 {
-	if (m_pq_queue.empty())
-		return INT_MAX;
+	Unlink(pElem);
+	--m_iSize;
 
-	return m_pq_queue.top()->iKey;
+	// The element still holds a reference to its event. Keep it until the
+	// next Collect() so a caller that cancels the last reference can still
+	// touch the event info for the rest of the current pulse.
+	pElem->pNext = m_kCanceled.pHead;
+	m_kCanceled.pHead = pElem;
+}
+
+void CEventQueue::Collect()
+{
+	while (m_kCanceled.pHead)
+	{
+		TQueueElement * pElem = m_kCanceled.pHead;
+		m_kCanceled.pHead = pElem->pNext;
+		Delete(pElem);
+	}
+}
+
+void CEventQueue::Requeue(TQueueElement * pElem, int duration, int pulse)
+{
+	Unlink(pElem);
+
+	pElem->iStartTime = pulse;
+	pElem->iKey = duration + pulse;
+
+	Link(pElem);
 }
 
 int CEventQueue::Size()
 {
-	return m_pq_queue.size();
+	return m_iSize;
+}
+
+void CEventQueue::Link(TQueueElement * pElem)
+{
+	TQueueSlot * pSlot;
+
+	if (pElem->iKey - m_iCurrent <= 0)
+	{
+		// overdue, run it with the slot being drained right now
+		pSlot = &m_aSlots[0][m_iCurrent & WHEEL_MASK];
+	}
+	else
+	{
+		unsigned int uDelta = pElem->iKey - m_iCurrent;
+		int iLevel = 0;
+
+		while (iLevel < WHEEL_LEVELS - 1 && uDelta >= (1U << (WHEEL_BITS * (iLevel + 1))))
+			++iLevel;
+
+		pSlot = &m_aSlots[iLevel][(pElem->iKey >> (WHEEL_BITS * iLevel)) & WHEEL_MASK];
+	}
+
+	pElem->pSlot = pSlot;
+	pElem->pNext = NULL;
+	pElem->pPrev = pSlot->pTail;
+
+	if (pSlot->pTail)
+		pSlot->pTail->pNext = pElem;
+	else
+		pSlot->pHead = pElem;
+
+	pSlot->pTail = pElem;
+}
+
+void CEventQueue::Unlink(TQueueElement * pElem)
+{
+	TQueueSlot * pSlot = pElem->pSlot;
+
+	if (!pSlot)
+		return;
+
+	if (pElem->pPrev)
+		pElem->pPrev->pNext = pElem->pNext;
+	else
+		pSlot->pHead = pElem->pNext;
+
+	if (pElem->pNext)
+		pElem->pNext->pPrev = pElem->pPrev;
+	else
+		pSlot->pTail = pElem->pPrev;
+
+	pElem->pSlot = NULL;
+	pElem->pPrev = NULL;
+	pElem->pNext = NULL;
+}
+
+void CEventQueue::Cascade(int iLevel, int iIndex)
+{
+	TQueueSlot & rSlot = m_aSlots[iLevel][iIndex];
+	TQueueElement * pElem = rSlot.pHead;
+
+	rSlot.pHead = NULL;
+	rSlot.pTail = NULL;
+
+	while (pElem)
+	{
+		TQueueElement * pNext = pElem->pNext;
+		Link(pElem);
+		pElem = pNext;
+	}
+}
+
+void CEventQueue::Advance()
+{
+	++m_iCurrent;
+
+	if (m_iCurrent & WHEEL_MASK)
+		return;
+
+	for (int iLevel = 1; iLevel < WHEEL_LEVELS; ++iLevel)
+	{
+		int iIndex = (m_iCurrent >> (WHEEL_BITS * iLevel)) & WHEEL_MASK;
+
+		Cascade(iLevel, iIndex);
+
+		if (iIndex != 0)
+			break;
+	}
 }
 
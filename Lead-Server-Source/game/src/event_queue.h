@@ -1,25 +1,45 @@
 #ifndef __INC_LIBTHECORE_EVENT_QUEUE_H__
 #define __INC_LIBTHECORE_EVENT_QUEUE_H__
 
-#include "stable_priority_queue.h"
+struct TQueueSlot;
 
-struct TQueueElement
+struct TQueueElement : public ObjectAllocator<TQueueElement, EVENT_POOL_FREE_TRIGGER, MEM_TAG_EVENT>
 {
 	LPEVENT	pvData;
 	int		iStartTime;
 	int		iKey;
-	bool	bCancel;
+
+	TQueueSlot *	pSlot;
+	TQueueElement *	pPrev;
+	TQueueElement *	pNext;
+};
+
+struct TQueueSlot
+{
+	TQueueElement *	pHead;
+	TQueueElement *	pTail;
 };
 
+/**
+ * Hierarchical timing wheel keyed on pulse.
+ *
+ * Level 0 has one slot per pulse for the next 256 pulses, every further
+ * level covers 256 times the range of the previous one. Elements of a higher
+ * level are cascaded down when the wheel below wraps around, so Enqueue,
+ * Cancel and Requeue are O(1) and Dequeue touches only due elements.
+ * Elements sharing a slot are dequeued in insertion order.
+ *
+ * Canceled elements are unlinked at once but only freed by Collect().
+ */
 class CEventQueue
 {
 	public:
-		struct FuncQueueComp
+		enum
 		{
-			bool operator () (TQueueElement * left, TQueueElement * right) const
-			{
-				return (left->iKey > right->iKey);
-			}
+			WHEEL_BITS	= 8,
+			WHEEL_SIZE	= 1 << WHEEL_BITS,
+			WHEEL_MASK	= WHEEL_SIZE - 1,
+			WHEEL_LEVELS	= 4,
 		};
 
 	public:
@@ -27,17 +47,26 @@ class CEventQueue
 		~CEventQueue();
 
 		TQueueElement *	Enqueue(LPEVENT data, int duration, int pulse);
-		TQueueElement *	Dequeue();
+		TQueueElement *	Dequeue(int pulse);
 		void		Delete(TQueueElement * pElem);
-		void		Requeue(TQueueElement *, int key);
-		int		GetTopKey();
+		void		Cancel(TQueueElement * pElem);
+		void		Requeue(TQueueElement * pElem, int duration, int pulse);
+		void		Collect();
 		int		Size();
 
-	protected:
 		void		Destroy();
 
+	protected:
+		void		Link(TQueueElement * pElem);
+		void		Unlink(TQueueElement * pElem);
+		void		Cascade(int iLevel, int iIndex);
+		void		Advance();
+
 	private:
-		stable_priority_queue<TQueueElement *, std::vector<TQueueElement *>, FuncQueueComp> m_pq_queue;
+		TQueueSlot	m_aSlots[WHEEL_LEVELS][WHEEL_SIZE];
+		TQueueSlot	m_kCanceled;
+		int		m_iCurrent;	// pulse of the level 0 slot being drained
+		int		m_iSize;
 };
 
 #endif
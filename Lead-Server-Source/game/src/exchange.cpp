@@ -296,25 +296,13 @@ bool CExchange::Check(int * piItemCount)
 
 bool CExchange::CheckSpace()
 {
-	static std::vector s_grids(INVENTORY_PAGE_COUNT, CGrid(INVENTORY_SLOT_WIDTH, INVENTORY_SLOT_HEIGHT));
-
-	for (auto& grid: s_grids)
-		grid.Clear();
-
 	LPCHARACTER	victim = GetCompany()->GetOwner();
 	LPITEM item;
 	int i;
 
-	for (i = 0; i < INVENTORY_MAX_NUM; ++i)
-	{
-		if (!((item = victim->GetInventoryItem(i))))
-			continue;
-
-		const int page = i / INVENTORY_SLOT_PER_PAGE; // 0..INVENTORY_PAGE_COUNT-1
-		const int localPos = i % INVENTORY_SLOT_PER_PAGE; // Slot within a single page
-
-		s_grids[page].Put(localPos, 1, item->GetSize());
-	}
+	//  κ丮  Ʈ  ΰ   ڸ ʷ ƺ.
+	uint64_t aqwGridMask[INVENTORY_PAGE_COUNT];
+	memcpy(aqwGridMask, victim->GetInventoryGridMask(), sizeof(aqwGridMask));
 
 	// ...   ... ȥ κ  κ     ߸̴ Ф
 	static std::vector <WORD> s_vDSGrid(DRAGON_SOUL_INVENTORY_MAX_NUM);
@@ -377,18 +365,12 @@ bool CExchange::CheckSpace()
 		}
 		else
 		{
-			for (CGrid& grid : s_grids)
-			{
-				int iPos = grid.FindBlank(1, item->GetSize());
+			int iPos = CHARACTER::FindInventoryGridBlank(aqwGridMask, item->GetSize());
 
-				if (iPos >= 0)
-				{
-					grid.Put(iPos, 1, item->GetSize());
-					return true;
-				}
-			}
+			if (iPos < 0)
+				return false;
 
-			return false;
+			CHARACTER::PutInventoryGridMask(aqwGridMask, iPos, item->GetSize());
 		}
 	}
 
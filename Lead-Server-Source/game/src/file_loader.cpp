@@ -1,87 +1,229 @@
 #include "stdafx.h"
 #include "file_loader.h"
 
-CMemoryTextFileLoader::CMemoryTextFileLoader()
+#ifndef __WIN32__
+#include <sys/mman.h>
+#endif
+
+CMemoryTextFileLoader::CMemoryTextFileLoader() : m_pcData(NULL), m_dataSize(0), m_bMapped(false)
 {
 }
 
 CMemoryTextFileLoader::~CMemoryTextFileLoader()
 {
+	Clear();
+}
+
+void CMemoryTextFileLoader::Clear()
+{
+#ifndef __WIN32__
+	if (m_bMapped)
+		munmap((void *) m_pcData, m_dataSize);
+#endif
+
+	m_pcData = NULL;
+	m_dataSize = 0;
+	m_bMapped = false;
+
+	m_vecCopy.clear();
+	m_vecLine.clear();
 }
 
 bool CMemoryTextFileLoader::SplitLine(DWORD dwLine, std::vector<std::string>* pstTokenVector, const char * c_szDelimeter)
 {
-	pstTokenVector->clear();
+	assert(CheckLineIndex(dwLine));
+
+	const TLineSpan & c_rkSpan = m_vecLine[dwLine];
+	const char * c_pcLine = m_pcData + c_rkSpan.dwBegin;
+	const DWORD dwLength = c_rkSpan.dwLength;
+
+	//  ̺. find_first_of   '\0'  ڰ ƴϴ.
+	bool abDelimeter[256];
+	memset(abDelimeter, 0, sizeof(abDelimeter));
 
-	std::string stToken;
-	const std::string & c_rstLine = GetLineString(dwLine);
+	for (const char * p = c_szDelimeter; *p; ++p)
+		abDelimeter[(unsigned char) *p] = true;
 
+	//  ٿ  ū ڿ ۸ ״ ٽ .
+	size_t tokenCount = 0;
+	bool bRet = true;
 	DWORD basePos = 0;
 
 	do
 	{
-		int beginPos = c_rstLine.find_first_not_of(c_szDelimeter, basePos);
-		if (beginPos < 0)
-			return false;
+		DWORD beginPos = basePos;
 
-		int endPos;
+		while (beginPos < dwLength && abDelimeter[(unsigned char) c_pcLine[beginPos]])
+			++beginPos;
+
+		if (beginPos >= dwLength)
+		{
+			bRet = false;
+			break;
+		}
+
+		DWORD endPos;
 
-		if (c_rstLine[beginPos] == '#' && c_rstLine.compare(beginPos, 4, "#--#") != 0)
+		if (c_pcLine[beginPos] == '#' && (dwLength - beginPos < 4 || memcmp(c_pcLine + beginPos, "#--#", 4) != 0))
 		{
-			return false;
+			bRet = false;
+			break;
 		}
-		else if (c_rstLine[beginPos] == '"')
+		else if (c_pcLine[beginPos] == '"')
 		{
 			++beginPos;
-			endPos = c_rstLine.find_first_of("\"", beginPos);
 
-			if (endPos < 0)
-				return false;
+			const char * c_pcQuote = (const char *) memchr(c_pcLine + beginPos, '"', dwLength - beginPos);
+
+			if (!c_pcQuote)
+			{
+				bRet = false;
+				break;
+			}
 
+			endPos = c_pcQuote - c_pcLine;
 			basePos = endPos + 1;
 		}
 		else
 		{
-			endPos = c_rstLine.find_first_of(c_szDelimeter, beginPos);
+			endPos = beginPos;
+
+			while (endPos < dwLength && !abDelimeter[(unsigned char) c_pcLine[endPos]])
+				++endPos;
+
 			basePos = endPos;
 		}
 
-		pstTokenVector->push_back(c_rstLine.substr(beginPos, endPos - beginPos));
+		if (tokenCount < pstTokenVector->size())
+			(*pstTokenVector)[tokenCount].assign(c_pcLine + beginPos, endPos - beginPos);
+		else
+			pstTokenVector->push_back(std::string(c_pcLine + beginPos, endPos - beginPos));
+
+		++tokenCount;
 
 		// ߰ ڵ. ǵڿ  ִ 츦 üũѴ. - [levites]
-		if (int(c_rstLine.find_first_not_of(c_szDelimeter, basePos)) < 0)
+		DWORD tailPos = basePos;
+
+		while (tailPos < dwLength && abDelimeter[(unsigned char) c_pcLine[tailPos]])
+			++tailPos;
+
+		if (tailPos >= dwLength)
 			break;
-	} while (basePos < c_rstLine.length());
+	} while (basePos < dwLength);
 
-	return true;
+	pstTokenVector->resize(tokenCount);
+	return bRet;
 }
 
 DWORD CMemoryTextFileLoader::GetLineCount()
 {
-	return m_stLineVector.size();
+	return m_vecLine.size();
 }
 
 bool CMemoryTextFileLoader::CheckLineIndex(DWORD dwLine)
 {
-	if (dwLine >= m_stLineVector.size())
+	if (dwLine >= m_vecLine.size())
 		return false;
 
 	return true;
 }
 
-const std::string & CMemoryTextFileLoader::GetLineString(DWORD dwLine)
+std::string CMemoryTextFileLoader::GetLineString(DWORD dwLine)
 {
 	assert(CheckLineIndex(dwLine));
-	return m_stLineVector[dwLine];
+	return std::string(m_pcData + m_vecLine[dwLine].dwBegin, m_vecLine[dwLine].dwLength);
+}
+
+bool CMemoryTextFileLoader::LoadFile(const char * c_szFileName)
+{
+	Clear();
+
+#ifndef __WIN32__
+	int fd = open(c_szFileName, O_RDONLY);
+
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+
+	if (fstat(fd, &st) < 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	if (st.st_size > 0)
+	{
+		void * pvMap = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (MAP_FAILED != pvMap)
+		{
+			madvise(pvMap, st.st_size, MADV_SEQUENTIAL);
+
+			m_pcData = (const char *) pvMap;
+			m_dataSize = st.st_size;
+			m_bMapped = true;
+		}
+	}
+
+	close(fd);
+
+	if (m_bMapped || 0 == st.st_size)
+	{
+		IndexLines();
+		return true;
+	}
+#endif
+
+	// mmap     ѹ о δ.
+	FILE * fp = fopen(c_szFileName, "rb");
+
+	if (NULL == fp)
+		return false;
+
+	fseek(fp, 0L, SEEK_END);
+	const long fileSize = ftell(fp);
+	fseek(fp, 0L, SEEK_SET);
+
+	if (fileSize > 0)
+	{
+		m_vecCopy.resize(fileSize);
+		m_vecCopy.resize(fread(&m_vecCopy[0], 1, fileSize, fp));
+	}
+
+	fclose(fp);
+
+	m_pcData = m_vecCopy.empty() ? NULL : &m_vecCopy[0];
+	m_dataSize = m_vecCopy.size();
+
+	IndexLines();
+	return true;
 }
 
 void CMemoryTextFileLoader::Bind(int bufSize, const void* c_pvBuf)
 {
-	m_stLineVector.clear();
+	Clear();
+
+	if (bufSize > 0)
+		m_vecCopy.assign((const char *) c_pvBuf, (const char *) c_pvBuf + bufSize);
+
+	m_pcData = m_vecCopy.empty() ? NULL : &m_vecCopy[0];
+	m_dataSize = m_vecCopy.size();
+
+	IndexLines();
+}
+
+void CMemoryTextFileLoader::IndexLines()
+{
+	m_vecLine.clear();
+
+	const char * c_pcBuf = m_pcData;
+	const DWORD bufSize = m_dataSize;
+	TLineSpan kSpan;
+	DWORD pos = 0;
 
-	const char * c_pcBuf = (const char *)c_pvBuf;
-	std::string stLine;
-	int pos = 0;
+	kSpan.dwBegin = 0;
+	kSpan.dwLength = 0;
 
 	while (pos < bufSize)
 	{
@@ -93,20 +235,26 @@ void CMemoryTextFileLoader::Bind(int bufSize, const void* c_pvBuf)
 				if ('\n' == c_pcBuf[pos] || '\r' == c_pcBuf[pos])
 					++pos;
 
-			m_stLineVector.push_back(stLine);
-			stLine = "";
+			m_vecLine.push_back(kSpan);
+			kSpan.dwBegin = pos;
+			kSpan.dwLength = 0;
 		}
-		else if (c < 0)
+		else if (c & 0x80)
 		{
-			stLine.append(c_pcBuf + (pos-1), 2);
-			++pos;
+			// 2Ʈ ڴ ι° Ʈ  ڿ ٿ ԽŲ.
+			if (pos < bufSize)
+			{
+				kSpan.dwLength += 2;
+				++pos;
+			}
+			else
+				++kSpan.dwLength;
 		}
 		else
 		{
-			stLine += c;
+			++kSpan.dwLength;
 		}
 	}
 
-	m_stLineVector.push_back(stLine);
+	m_vecLine.push_back(kSpan);
 }
-
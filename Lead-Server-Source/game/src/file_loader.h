@@ -5,19 +5,38 @@ typedef std::vector< std::string > TTokenVector;
 
 class CMemoryTextFileLoader
 {
+	public:
+		//      ġ.  ڿ    ʴ´.
+		typedef struct SLineSpan
+		{
+			DWORD	dwBegin;
+			DWORD	dwLength;
+		} TLineSpan;
+
 	public:
 		CMemoryTextFileLoader();
 		virtual ~CMemoryTextFileLoader();
 
+		//  mmap  ٿ  ġ εѴ. (н о )
+		bool			LoadFile(const char * c_szFileName);
 		void			Bind(int bufSize, const void* c_pvBuf);
+		void			Clear();
+
 		DWORD			GetLineCount();
 		bool			CheckLineIndex(DWORD dwLine);
 		bool			SplitLine(DWORD dwLine, std::vector<std::string> * pstTokenVector, const char * c_szDelimeter = " \t");
-		const std::string &	GetLineString(DWORD dwLine);
+		std::string		GetLineString(DWORD dwLine);
 
 	protected:
-		std::vector<std::string> m_stLineVector;
+		void			IndexLines();
+
+	protected:
+		const char *		m_pcData;
+		size_t			m_dataSize;
+		bool			m_bMapped;
+
+		std::vector<char>	m_vecCopy;
+		std::vector<TLineSpan>	m_vecLine;
 };
 
 #endif /* __INC_METIN_II_COMMON_FILE_LOADER_H__ */
-
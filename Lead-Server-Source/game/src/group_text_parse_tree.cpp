@@ -24,22 +24,9 @@ bool CGroupTextParseTreeLoader::Load(const char * c_szFileName)
 
 	m_dwcurLineIndex = 0;
 
-	FILE* fp = fopen(c_szFileName, "rb");
-
-	if (NULL == fp)
+	if (!m_fileLoader.LoadFile(c_szFileName))
 		return false;
 
-	fseek(fp, 0L, SEEK_END);
-	const size_t fileSize = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
-
-	char * pData = M2_NEW char[fileSize];
-	fread(pData, fileSize, 1, fp);
-	fclose(fp);
-
-	m_fileLoader.Bind(fileSize, pData);
-	M2_DELETE_ARRAY(pData);
-
 	if (NULL != m_pRootGroupNode)
 	{
 		delete m_pRootGroupNode;
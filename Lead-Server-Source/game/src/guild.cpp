@@ -124,10 +124,14 @@ void CGuild::Initialize()
 		abSkillUsable[i] = true;
 
 	m_iMemberCountBonus = 0;
+
+	m_vec_bListPacket.clear();
+	m_bListPacketDirty = true;
 }
 
 CGuild::~CGuild()
 {
+	mem_stat_free(MEM_TAG_CACHE, m_vec_bListPacket.capacity());
 }
 
 void CGuild::RequestAddMember(LPCHARACTER ch, int grade)
@@ -166,6 +170,7 @@ void CGuild::AddMember(TPacketDGGuildMember * p)
 		r_gm.is_general = p->isGeneral;
 	}
 
+	InvalidateListPacket();
 	CGuildManager::instance().Link(p->dwPID, this);
 
 	SendListOneToAll(p->dwPID);
@@ -215,6 +220,7 @@ bool CGuild::RemoveMember(DWORD pid)
 		m_general_count--;
 
 	m_member.erase(it);
+	InvalidateListPacket();
 	SendOnlineRemoveOnePacket(pid);
 
 	CGuildManager::instance().Unlink(pid);
@@ -242,10 +248,7 @@ void CGuild::P2PLoginMember(DWORD pid)
 	m_memberP2POnline.insert(pid);
 
 	// Login event occur + Send List
-	TGuildMemberOnlineContainer::iterator it;
-
-	for (it = m_memberOnline.begin(); it!=m_memberOnline.end();++it)
-		SendLoginPacket(*it, pid);
+	SendLoginPacketToAll(pid);
 }
 
 void CGuild::LoginMember(LPCHARACTER ch)
@@ -259,10 +262,7 @@ void CGuild::LoginMember(LPCHARACTER ch)
 	ch->SetGuild(this);
 
 	// Login event occur + Send List
-	TGuildMemberOnlineContainer::iterator it;
-
-	for (it = m_memberOnline.begin(); it!=m_memberOnline.end();++it)
-		SendLoginPacket(*it, ch);
+	SendLoginPacketToAll(ch->GetPlayerID());
 
 	m_memberOnline.insert(ch);
 
@@ -286,11 +286,7 @@ void CGuild::P2PLogoutMember(DWORD pid)
 	m_memberP2POnline.erase(pid);
 
 	// Logout event occur
-	TGuildMemberOnlineContainer::iterator it;
-	for (it = m_memberOnline.begin(); it!=m_memberOnline.end();++it)
-	{
-		SendLogoutPacket(*it, pid);
-	}
+	SendLogoutPacketToAll(pid);
 }
 
 void CGuild::LogoutMember(LPCHARACTER ch)
@@ -307,11 +303,7 @@ void CGuild::LogoutMember(LPCHARACTER ch)
 	m_memberOnline.erase(ch);
 
 	// Logout event occur
-	TGuildMemberOnlineContainer::iterator it;
-	for (it = m_memberOnline.begin(); it!=m_memberOnline.end();++it)
-	{
-		SendLogoutPacket(*it, ch);
-	}
+	SendLogoutPacketToAll(ch->GetPlayerID());
 }
 
 void CGuild::SendOnlineRemoveOnePacket(DWORD pid)
@@ -422,45 +414,129 @@ void CGuild::SendListPacket(LPCHARACTER ch)
 	if (!(d=ch->GetDesc()))
 		return;
 
+	if (m_bListPacketDirty)
+		BuildListPacket();
+
+	d->Packet(&m_vec_bListPacket[0], m_vec_bListPacket.size());
+
+	//    LOGIN ϳ pid   ٿ 
+	size_t nOnline = m_memberOnline.size() + m_memberP2POnline.size();
+
+	if (!nOnline)
+		return;
+
 	TPacketGCGuild pack;
 	pack.header = HEADER_GC_GUILD;
-	pack.size = sizeof(TPacketGCGuild);
-	pack.subheader = GUILD_SUBHEADER_GC_LIST;
-
-	pack.size += sizeof(TGuildMemberPacketData) * m_member.size();
+	pack.size = sizeof(pack) + sizeof(DWORD) * nOnline;
+	pack.subheader = GUILD_SUBHEADER_GC_LOGIN;
 
 	TEMP_BUFFER buf;
+	buf.write(&pack, sizeof(pack));
 
-	buf.write(&pack,sizeof(pack));
+	for (TGuildMemberOnlineContainer::iterator it = m_memberOnline.begin(); it != m_memberOnline.end(); ++it)
+	{
+		DWORD pid = (*it)->GetPlayerID();
+		buf.write(&pid, sizeof(pid));
+	}
 
-	char c[CHARACTER_NAME_MAX_LEN+1];
+	for (TGuildMemberP2POnlineContainer::iterator it = m_memberP2POnline.begin(); it != m_memberP2POnline.end(); ++it)
+	{
+		DWORD pid = *it;
+		buf.write(&pid, sizeof(pid));
+	}
 
-	for (TGuildMemberContainer::iterator it = m_member.begin(); it != m_member.end(); ++it)
+	d->Packet(buf.read_peek(), buf.size());
+}
+
+void CGuild::BuildListPacket()
+{
+	/*
+	   List Packet
+
+	   Header
+	   [ TGuildMemberPacketData ] * Count
+	 */
+	TPacketGCGuild pack;
+	pack.header = HEADER_GC_GUILD;
+	pack.size = sizeof(TPacketGCGuild) + sizeof(TGuildMemberPacketData) * m_member.size();
+	pack.subheader = GUILD_SUBHEADER_GC_LIST;
+
+	size_t uOldCapacity = m_vec_bListPacket.capacity();
+	m_vec_bListPacket.resize(pack.size);
+
+	if (m_vec_bListPacket.capacity() != uOldCapacity)
 	{
-		it->second._dummy = 1;
+		mem_stat_free(MEM_TAG_CACHE, uOldCapacity);
+		mem_stat_alloc(MEM_TAG_CACHE, m_vec_bListPacket.capacity());
+	}
 
-		buf.write(&(it->second), sizeof(DWORD)*3+1);
+	BYTE * pb = &m_vec_bListPacket[0];
+	memcpy(pb, &pack, sizeof(pack));
+	pb += sizeof(pack);
 
-		strlcpy(c, it->second.name.c_str(), MIN(sizeof(c), it->second.name.length() + 1));
+	for (TGuildMemberContainer::iterator it = m_member.begin(); it != m_member.end(); ++it)
+	{
+		const TGuildMember & r = it->second;
+		TGuildMemberPacketData data;
+
+		data.pid = r.pid;
+		data.grade = r.grade;
+		data.is_general = r.is_general;
+		data.job = r.job;
+		data.level = r.level;
+		data.offer = r.offer_exp;
+		data.name_flag = 1;
+		memset(data.name, 0, sizeof(data.name));
+		strlcpy(data.name, r.name.c_str(), sizeof(data.name));
 
-		buf.write(c, CHARACTER_NAME_MAX_LEN+1 );
+		memcpy(pb, &data, sizeof(data));
+		pb += sizeof(data);
 
 		if ( test_server )
-			sys_log(0 ,"name %s job %d  ", it->second.name.c_str(), it->second.job );
+			sys_log(0 ,"name %s job %d  ", r.name.c_str(), r.job );
 	}
 
-	d->Packet(buf.read_peek(), buf.size());
+	m_bListPacketDirty = false;
+}
+
+void CGuild::SendLoginPacketToAll(DWORD pid)
+{
+	TPacketGCGuild pack;
+	pack.header = HEADER_GC_GUILD;
+	pack.size = sizeof(pack)+4;
+	pack.subheader = GUILD_SUBHEADER_GC_LOGIN;
+
+	TEMP_BUFFER buf;
+	buf.write(&pack, sizeof(pack));
+	buf.write(&pid, 4);
 
 	for (TGuildMemberOnlineContainer::iterator it = m_memberOnline.begin(); it != m_memberOnline.end(); ++it)
 	{
-		SendLoginPacket(ch, *it);
+		LPDESC d = (*it)->GetDesc();
+
+		if (d)
+			d->Packet(buf.read_peek(), buf.size());
 	}
+}
 
-	for (TGuildMemberP2POnlineContainer::iterator it = m_memberP2POnline.begin(); it != m_memberP2POnline.end(); ++it)
+void CGuild::SendLogoutPacketToAll(DWORD pid)
+{
+	TPacketGCGuild pack;
+	pack.header = HEADER_GC_GUILD;
+	pack.size = sizeof(pack)+4;
+	pack.subheader = GUILD_SUBHEADER_GC_LOGOUT;
+
+	TEMP_BUFFER buf;
+	buf.write(&pack, sizeof(pack));
+	buf.write(&pid, 4);
+
+	for (TGuildMemberOnlineContainer::iterator it = m_memberOnline.begin(); it != m_memberOnline.end(); ++it)
 	{
-		SendLoginPacket(ch, *it);
-	}
+		LPDESC d = (*it)->GetDesc();
 
+		if (d)
+			d->Packet(buf.read_peek(), buf.size());
+	}
 }
 
 void CGuild::SendLoginPacket(LPCHARACTER ch, LPCHARACTER chLogin)
@@ -528,6 +604,7 @@ void CGuild::LoadGuildMemberData(SQLMsg* pmsg)
 	m_general_count = 0;
 
 	m_member.clear();
+	InvalidateListPacket();
 
 	for (uint i = 0; i < pmsg->Get()->uiNumRows; ++i)
 	{
@@ -937,6 +1014,7 @@ bool CGuild::OfferExp(LPCHARACTER ch, int amount)
 
 	cit->second.offer_exp += amount / 100;
 	cit->second._dummy = 0;
+	InvalidateListPacket();
 
 	TPacketGCGuild pack;
 	pack.header = HEADER_GC_GUILD;
@@ -1109,6 +1187,7 @@ bool CGuild::ChangeMemberGeneral(DWORD pid, BYTE is_general)
 		--m_general_count;
 
 	it->second.is_general = is_general;
+	InvalidateListPacket();
 
 	TGuildMemberOnlineContainer::iterator itOnline = m_memberOnline.begin();
 
@@ -1144,6 +1223,7 @@ void CGuild::ChangeMemberGrade(DWORD pid, BYTE grade)
 		return;
 
 	it->second.grade = grade;
+	InvalidateListPacket();
 
 	TGuildMemberOnlineContainer::iterator itOnline = m_memberOnline.begin();
 
@@ -1578,6 +1658,7 @@ void CGuild::LevelChange(DWORD pid, BYTE level)
 		return;
 
 	cit->second.level = level;
+	InvalidateListPacket();
 
 	TPacketGuildChangeMemberData gd_guild;
 
@@ -1618,6 +1699,7 @@ void CGuild::ChangeMemberData(DWORD pid, DWORD offer, BYTE level, BYTE grade)
 	cit->second.level = level;
 	cit->second.grade = grade;
 	cit->second._dummy = 0;
+	InvalidateListPacket();
 
 	TPacketGCGuild pack;
 	memset(&pack, 0, sizeof(pack));
@@ -1915,14 +1997,14 @@ EVENTFUNC( GuildInviteEvent )
 
 void CGuild::Invite( LPCHARACTER pchInviter, LPCHARACTER pchInvitee )
 {
-	if (quest::CQuestManager::instance().GetPCForce(pchInviter->GetPlayerID())->IsRunning() == true)
+	if (quest::CQuestManager::instance().GetPCForce(pchInviter)->IsRunning() == true)
 	{
 	    pchInviter->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("<Guild> The other party cannot receive invitation requests."));
 	    return;
 	}
 
 	
-	if (quest::CQuestManager::instance().GetPCForce(pchInvitee->GetPlayerID())->IsRunning() == true)
+	if (quest::CQuestManager::instance().GetPCForce(pchInvitee)->IsRunning() == true)
 		return;
 
 	if ( pchInvitee->IsBlockMode( BLOCK_GUILD_INVITE ) ) 
@@ -168,6 +168,9 @@ class CGuild
 		void		SendLogoutPacket(LPCHARACTER ch, LPCHARACTER chLogout);
 		void		SendLoginPacket(LPCHARACTER ch, DWORD pid);
 		void		SendLogoutPacket(LPCHARACTER ch, DWORD pid);
+		//    ο pid  /Ḧ  ۷ 
+		void		SendLoginPacketToAll(DWORD pid);
+		void		SendLogoutPacketToAll(DWORD pid);
 		void		SendGuildInfoPacket(LPCHARACTER ch);
 		void		SendGuildDataUpdateToAllMember(SQLMsg* pmsg);
 
@@ -325,6 +328,13 @@ class CGuild
 		typedef std::set<DWORD>	TGuildMemberP2POnlineContainer;
 		TGuildMemberP2POnlineContainer m_memberP2POnline;
 
+		// SendListPacket   ü  Ŷ.  ٲ InvalidateListPacket  ٽ .
+		std::vector<BYTE>	m_vec_bListPacket;
+		bool		m_bListPacketDirty;
+
+		void		InvalidateListPacket()	{ m_bListPacketDirty = true; }
+		void		BuildListPacket();
+
 		void LoadGuildData(SQLMsg* pmsg);
 		void LoadGuildGradeData(SQLMsg* pmsg);
 		void LoadGuildMemberData(SQLMsg* pmsg);
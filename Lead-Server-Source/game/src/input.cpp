@@ -7,6 +7,7 @@
 #include "buffer_manager.h"
 #include "config.h"
 #include "profiler.h"
+#include "packet_capture.h"
 #include "p2p.h"
 #include "log.h"
 #include "db.h"
@@ -52,6 +53,83 @@ void CInputProcessor::BindPacketInfo(CPacketInfo * pPacketInfo)
 	m_pPacketInfo = pPacketInfo;
 }
 
+typedef struct SPacketStat
+{
+	DWORD	dwCalled;
+	DWORD	dwBytes;
+	DWORD	dwUsec;
+	char	szName[32];
+} TPacketStat;
+
+static TPacketStat s_aPacketStat[INPROC_MAX_NUM][256];
+
+static const char * s_apszInputTypeName[INPROC_MAX_NUM] =
+{
+	"CLOSE", "HANDSHAKE", "LOGIN", "MAIN", "DEAD", "DB", "P2P", "AUTH"
+};
+
+struct FComparePacketStatUsec
+{
+	bool operator () (const TPacketStat * a, const TPacketStat * b) const
+	{
+		return a->dwUsec > b->dwUsec;
+	}
+};
+
+void CInputProcessor::AddPacketStat(BYTE bType, BYTE bHeader, const char * c_pszName, int iBytes, DWORD dwUsec)
+{
+	if (bType >= INPROC_MAX_NUM)
+		return;
+
+	TPacketStat & r = s_aPacketStat[bType][bHeader];
+
+	if (!r.dwCalled)
+		strlcpy(r.szName, c_pszName, sizeof(r.szName));
+
+	++r.dwCalled;
+	r.dwBytes += iBytes;
+	r.dwUsec += dwUsec;
+}
+
+void CInputProcessor::LogPacketStat(LPCHARACTER ch, size_t iMaxCount)
+{
+	std::vector<const TPacketStat *> vec;
+
+	for (int i = 0; i < INPROC_MAX_NUM; ++i)
+		for (int j = 0; j < 256; ++j)
+			if (s_aPacketStat[i][j].dwCalled)
+				vec.push_back(&s_aPacketStat[i][j]);
+
+	std::sort(vec.begin(), vec.end(), FComparePacketStatUsec());
+
+	for (size_t n = 0; n < vec.size(); ++n)
+	{
+		const TPacketStat * p = vec[n];
+		int iType = (p - &s_aPacketStat[0][0]) / 256;
+		int iHeader = (p - &s_aPacketStat[0][0]) % 256;
+
+		char szLine[256];
+		snprintf(szLine, sizeof(szLine), "%-9s %3d %-16s called %u bytes %u usec %u avg %.1f",
+				s_apszInputTypeName[iType], iHeader, p->szName,
+				p->dwCalled, p->dwBytes, p->dwUsec, (float) p->dwUsec / p->dwCalled);
+
+		if (ch)
+		{
+			if (iMaxCount && n >= iMaxCount)
+				break;
+
+			ch->ChatPacket(CHAT_TYPE_INFO, "%s", szLine);
+		}
+		else
+			sys_log(0, "PACKET_STAT: %s", szLine);
+	}
+}
+
+void CInputProcessor::ResetPacketStat()
+{
+	memset(s_aPacketStat, 0, sizeof(s_aPacketStat));
+}
+
 bool CInputProcessor::Process(LPDESC lpDesc, const void * c_pvOrig, int iBytes, int & r_iBytesProceed)
 {
 	const char * c_pData = (const char *) c_pvOrig;
@@ -92,14 +170,26 @@ bool CInputProcessor::Process(LPDESC lpDesc, const void * c_pvOrig, int iBytes,
 
 			m_pPacketInfo->Start();
 
+			int iPhase = lpDesc->GetPhase();
+
+			// Ŷ ̸ packet info   ִ ڿ̶ Ͱ ٲ ʴ´.
+			PROF_UNIT puPacket(c_pszName);
 			int iExtraPacketSize = Analyze(lpDesc, bHeader, c_pData);
+			puPacket.Pop();
 
 			if (iExtraPacketSize < 0)
 				return true;
 
 			iPacketLen += iExtraPacketSize;
 			lpDesc->Log("%s %d", c_pszName, iPacketLen);
-			m_pPacketInfo->End();
+
+			if (GetType() != INPROC_DB && GetType() != INPROC_P2P && packet_capture_is_open())
+			{
+				bool bSequence = m_pPacketInfo->IsSequence(bHeader);
+				packet_capture_record(lpDesc, iPhase, bSequence, c_pData, iPacketLen - (bSequence ? sizeof(BYTE) : 0));
+			}
+			AddPacketStat(GetType(), bHeader, c_pszName, iPacketLen, m_pPacketInfo->End());
+			lpDesc->CountInputPacket();
 		}
 
 		if (bHeader == HEADER_CG_PONG)
@@ -13,6 +13,7 @@ enum
 	INPROC_DB,
 	INPROC_P2P,
 	INPROC_AUTH,
+	INPROC_MAX_NUM
 };
 
 void LoginFailure(LPDESC d, const char * c_pszStatus);
@@ -32,9 +33,15 @@ class CInputProcessor
 		void Handshake(LPDESC d, const char * c_pData);
 		void Version(LPCHARACTER ch, const char* c_pData);
 
+		//  DESC   Ŷ Է ó (phase)   
+		static void	LogPacketStat(LPCHARACTER ch = NULL, size_t iMaxCount = 0);
+		static void	ResetPacketStat();
+
 	protected:
 		virtual int	Analyze(LPDESC d, BYTE bHeader, const char * c_pData) = 0;
 
+		static void	AddPacketStat(BYTE bType, BYTE bHeader, const char * c_pszName, int iBytes, DWORD dwUsec);
+
 		CPacketInfo * m_pPacketInfo;
 		int	m_iBufferLeft;
 
@@ -288,6 +295,8 @@ class CInputP2P : public CInputProcessor
 		void		Login(LPDESC d, const char * c_pData);
 		void		Logout(LPDESC d, const char * c_pData);
 		int			Relay(LPDESC d, const char * c_pData, size_t uiBytes);
+		int			Batch(LPDESC d, const char * c_pData, size_t uiBytes);
+		int			CharacterHandoff(LPDESC d, const char * c_pData, size_t uiBytes);
 		int			Notice(LPDESC d, const char * c_pData, size_t uiBytes);
 		int			Guild(LPDESC d, const char* c_pData, size_t uiBytes);
 		void		Shout(const char * c_pData);
@@ -97,6 +97,33 @@ void CInputAuth::Login(LPDESC d, const char * c_pData)
 
 	DWORD dwKey = DESC_MANAGER::instance().CreateLoginKey(d);
 
+	// 방금 인증에 성공했던 계정이면 account 를 다시 읽지 않는다.
+	const TAuthCacheEntry * pkCache = DBManager::instance().FindAuthCache(login, passwd);
+
+	if (pkCache)
+	{
+		sys_log(0, "InputAuth::Login : AUTH_CACHE_HIT %s desc %p", login, get_pointer(d));
+
+		d->SetLogin(login);
+
+		// DB 결과로 받을 때와 같은 검사를 거친다. 막히면 캐시를 버려 다음에는 account 를 다시 읽는다.
+		const char * c_pszFailure = DBManager::instance().CheckAuthLogin(login, pkCache->bNotAvail, pkCache->szStatus, pkCache->szCreateDate);
+
+		if (c_pszFailure)
+		{
+			sys_log(0, "   %s", c_pszFailure);
+			LoginFailure(d, c_pszFailure);
+			DBManager::instance().EraseAuthCache(login);
+			return;
+		}
+
+		int aiPremiumTimes[PREMIUM_MAX_NUM];
+		thecore_memcpy(aiPremiumTimes, pkCache->aiPremiumTimes, sizeof(aiPremiumTimes));
+
+		DBManager::instance().AuthLoginSuccess(d, login, passwd, pinfo->adwClientKey, pkCache->dwID, pkCache->szSocialID, aiPremiumTimes);
+		return;
+	}
+
 	TPacketCGLogin3 * p = M2_NEW TPacketCGLogin3;
 	thecore_memcpy(p, pinfo, sizeof(TPacketCGLogin3));
 
@@ -111,7 +138,7 @@ void CInputAuth::Login(LPDESC d, const char * c_pData)
 	{
 		sys_log(0, "ChannelServiceLogin [%s]", szLogin);
 
-		DBManager::instance().ReturnQuery(QID_AUTH_LOGIN, dwKey, p,
+		DBManager::instance().AuthLoginQuery(login, dwKey, p,
 				"SELECT '%s',password,social_id,id,status,availDt - NOW() > 0,"
 				"UNIX_TIMESTAMP(silver_expire),"
 				"UNIX_TIMESTAMP(gold_expire),"
@@ -128,7 +155,7 @@ void CInputAuth::Login(LPDESC d, const char * c_pData)
 	// END_OF_CHANNEL_SERVICE_LOGIN
 	else
 	{
-		DBManager::instance().ReturnQuery(QID_AUTH_LOGIN, dwKey, p, 
+		DBManager::instance().AuthLoginQuery(login, dwKey, p,
 				"SELECT PASSWORD('%s'),password,social_id,id,status,availDt - NOW() > 0,"
 				"UNIX_TIMESTAMP(silver_expire),"
 				"UNIX_TIMESTAMP(gold_expire),"
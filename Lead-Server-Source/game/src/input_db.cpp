@@ -41,6 +41,8 @@
 #include "map_location.h"
 #include "DragonSoul.h"
 
+#include <zlib.h>
+
 extern BYTE		g_bAuthServer;
 extern void gm_insert(const char * name, BYTE level);
 extern BYTE	gm_get_level(const char * name, const char * host, const char* account );
@@ -398,8 +400,118 @@ void CInputDB::PlayerLoad(LPDESC d, const char * data)
 			ch->GetGMLevel());
 
 	ch->QuerySafeboxSize();
+
+	// 워프 전 코어가 넘겨 준 상태를 DB 에서 읽은 것처럼 넣는다.
+	// 넘겨받은 것이 있으면 bHandoff 로 로딩을 요청했으므로 DB 는 캐시가 있든 없든 아이템, 퀘스트, 어펙트를 보내지 않는다.
+	const CHARACTER_MANAGER::TWarpHandoff * pkHandoff = CHARACTER_MANAGER::instance().FindWarpHandoff(d->GetLoginKey(), ch->GetPlayerID());
+
+	if (pkHandoff)
+	{
+		sys_log(0, "WARP_HANDOFF: load %s", ch->GetName());
+
+		ItemLoad(d, &pkHandoff->vecItem[0]);
+		QuestLoad(d, &pkHandoff->vecQuest[0]);
+		AffectLoad(d, &pkHandoff->vecAffect[0]);
+
+		CHARACTER_MANAGER::instance().RemoveWarpHandoff(ch->GetPlayerID());
+	}
 }
 
+// QUERY_BOOT 의 압축된 프로토 테이블들을 하나씩 순서대로 풀어준다.
+// 풀린 테이블은 Boot 가 끝날 때까지 같은 자리에 남아 있다.
+class CBootTableInflater
+{
+	public:
+		CBootTableInflater(const char * c_pData, DWORD dwCompSize, DWORD dwRawSize) : m_dwRawPos(0), m_bReady(false)
+		{
+			memset(&m_kStream, 0, sizeof(m_kStream));
+
+			if (inflateInit(&m_kStream) != Z_OK)
+			{
+				sys_err("inflateInit failed");
+				return;
+			}
+
+			m_kStream.next_in = (Bytef *) c_pData;
+			m_kStream.avail_in = dwCompSize;
+			m_vecRaw.resize(dwRawSize);
+			m_bReady = true;
+		}
+
+		~CBootTableInflater()
+		{
+			if (m_bReady)
+				inflateEnd(&m_kStream);
+		}
+
+		// 테이블 하나(크기, 개수, 데이터)를 풀어서 데이터 위치를 돌려준다. 실패하면 NULL.
+		const char * Read(WORD wExpectedSize, const char * c_pszName, WORD & rwCount)
+		{
+			const char * c_pHeader = Inflate(sizeof(WORD) + sizeof(WORD));
+
+			if (!c_pHeader)
+				return NULL;
+
+			if (decode_2bytes(c_pHeader) != wExpectedSize)
+			{
+				sys_err("%s table size error", c_pszName);
+				return NULL;
+			}
+
+			rwCount = decode_2bytes(c_pHeader + sizeof(WORD));
+
+			const char * c_pTable = Inflate(wExpectedSize * rwCount);
+
+			if (!c_pTable)
+				sys_err("%s table inflate error", c_pszName);
+
+			return c_pTable;
+		}
+
+		bool IsEnd() const
+		{
+			return m_bReady && m_dwRawPos == m_vecRaw.size();
+		}
+
+	private:
+		const char * Inflate(DWORD dwBytes)
+		{
+			if (!m_bReady || m_dwRawPos + dwBytes > m_vecRaw.size())
+				return NULL;
+
+			// 빈 테이블이라도 유효한 위치를 돌려준다.
+			char * pBegin = m_vecRaw.empty() ? NULL : &m_vecRaw[0] + m_dwRawPos;
+
+			if (!dwBytes)
+				return pBegin ? pBegin : "";
+
+			m_kStream.next_out = (Bytef *) pBegin;
+			m_kStream.avail_out = dwBytes;
+
+			while (m_kStream.avail_out)
+			{
+				int iRet = inflate(&m_kStream, Z_NO_FLUSH);
+
+				if (iRet == Z_STREAM_END && !m_kStream.avail_out)
+					break;
+
+				if (iRet != Z_OK)
+				{
+					sys_err("inflate error %d", iRet);
+					return NULL;
+				}
+			}
+
+			m_dwRawPos += dwBytes;
+			return pBegin;
+		}
+
+		z_stream		m_kStream;
+		std::vector<char>	m_vecRaw;
+		DWORD			m_dwRawPos;
+		bool			m_bReady;
+};
+
 void CInputDB::Boot(const char* data)
 {
 	signal_timer_disable();
@@ -414,7 +526,7 @@ void CInputDB::Boot(const char* data)
 
 	sys_log(0, "BOOT: PACKET: %d", dwPacketSize);
 	sys_log(0, "BOOT: VERSION: %d", bVersion);
-	if (bVersion != 6)
+	if (bVersion != 7)
 	{
 		sys_err("boot version error");
 		thecore_shutdown();
@@ -435,147 +547,125 @@ void CInputDB::Boot(const char* data)
 	sys_log(0, "sizeof(TAdminManager) = %d", sizeof (TAdminInfo) );
 	//END_ADMIN_MANAGER
 
+	// 프로토 테이블들은 압축되어 온다. 테이블 하나씩 풀면서 바로 매니저에 넘긴다.
+	DWORD dwRawSize = decode_4bytes(data);
+	data += 4;
+
+	DWORD dwCompSize = decode_4bytes(data);
+	data += 4;
+
+	sys_log(0, "BOOT: TABLES: raw %u compressed %u", dwRawSize, dwCompSize);
+
+	CBootTableInflater kInflater(data, dwCompSize, dwRawSize);
+	data += dwCompSize;
+
 	WORD size;
+	const char * c_pTable;
 
 	/*
 	 * MOB
 	 */
 
-	if (decode_2bytes(data)!=sizeof(TMobTable))
+	if (!(c_pTable = kInflater.Read(sizeof(TMobTable), "mob", size)))
 	{
-		sys_err("mob table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: MOB: %d", size);
 
 	if (size)
-	{
-		CMobManager::instance().Initialize((TMobTable *) data, size);
-		data += size * sizeof(TMobTable);
-	}
+		CMobManager::instance().Initialize((TMobTable *) c_pTable, size);
 
 	/*
 	 * ITEM
 	 */
 
-	if (decode_2bytes(data) != sizeof(TItemTable))
+	if (!(c_pTable = kInflater.Read(sizeof(TItemTable), "item", size)))
 	{
-		sys_err("item table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: ITEM: %d", size);
 
-
 	if (size)
-	{
-		ITEM_MANAGER::instance().Initialize((TItemTable *) data, size);
-		data += size * sizeof(TItemTable);
-	}
+		ITEM_MANAGER::instance().Initialize((TItemTable *) c_pTable, size);
 
 	/*
 	 * SHOP
 	 */
 
-	if (decode_2bytes(data) != sizeof(TShopTable))
+	if (!(c_pTable = kInflater.Read(sizeof(TShopTable), "shop", size)))
 	{
-		sys_err("shop table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: SHOP: %d", size);
 
-
 	if (size)
 	{
-		if (!CShopManager::instance().Initialize((TShopTable *) data, size))
+		if (!CShopManager::instance().Initialize((TShopTable *) c_pTable, size))
 		{
 			sys_err("shop table Initialize error");
 			thecore_shutdown();
 			return;
 		}
-		data += size * sizeof(TShopTable);
 	}
 
 	/*
 	 * SKILL
 	 */
 
-	if (decode_2bytes(data) != sizeof(TSkillTable))
+	if (!(c_pTable = kInflater.Read(sizeof(TSkillTable), "skill", size)))
 	{
-		sys_err("skill table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: SKILL: %d", size);
 
 	if (size)
 	{
-		if (!CSkillManager::instance().Initialize((TSkillTable *) data, size))
+		if (!CSkillManager::instance().Initialize((TSkillTable *) c_pTable, size))
 		{
 			sys_err("cannot initialize skill table");
 			thecore_shutdown();
 			return;
 		}
-
-		data += size * sizeof(TSkillTable);
 	}
+
 	/*
 	 * REFINE RECIPE
 	 */
-	if (decode_2bytes(data) != sizeof(TRefineTable))
+
+	if (!(c_pTable = kInflater.Read(sizeof(TRefineTable), "refine", size)))
 	{
-		sys_err("refine table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: REFINE: %d", size);
 
 	if (size)
-	{
-		CRefineManager::instance().Initialize((TRefineTable*) data, size);
-		data += size * sizeof(TRefineTable);
-	}
+		CRefineManager::instance().Initialize((TRefineTable*) c_pTable, size);
 
 	/*
 	 * ITEM ATTR
 	 */
-	if (decode_2bytes(data) != sizeof(TItemAttrTable))
+
+	if (!(c_pTable = kInflater.Read(sizeof(TItemAttrTable), "item attr", size)))
 	{
-		sys_err("item attr table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: ITEM_ATTR: %d", size);
 
 	if (size)
 	{
-		TItemAttrTable * p = (TItemAttrTable *) data;
+		TItemAttrTable * p = (TItemAttrTable *) c_pTable;
 
 		for (int i = 0; i < size; ++i, ++p)
 		{
@@ -587,27 +677,21 @@ void CInputDB::Boot(const char* data)
 		}
 	}
 
-	data += size * sizeof(TItemAttrTable);
-
-
 	/*
-     * ITEM RARE
-     */
-	if (decode_2bytes(data) != sizeof(TItemAttrTable))
+	 * ITEM RARE
+	 */
+
+	if (!(c_pTable = kInflater.Read(sizeof(TItemAttrTable), "item rare", size)))
 	{
-		sys_err("item rare table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
 
-	size = decode_2bytes(data);
-	data += 2;
 	sys_log(0, "BOOT: ITEM_RARE: %d", size);
 
 	if (size)
 	{
-		TItemAttrTable * p = (TItemAttrTable *) data;
+		TItemAttrTable * p = (TItemAttrTable *) c_pTable;
 
 		for (int i = 0; i < size; ++i, ++p)
 		{
@@ -619,58 +703,47 @@ void CInputDB::Boot(const char* data)
 		}
 	}
 
-	data += size * sizeof(TItemAttrTable);
-
-
 	/*
 	 * BANWORDS
 	 */
 
-	if (decode_2bytes(data) != sizeof(TBanwordTable))
+	if (!(c_pTable = kInflater.Read(sizeof(TBanwordTable), "ban word", size)))
 	{
-		sys_err("ban word table size error");
 		thecore_shutdown();
 		return;
 	}
-	data += 2;
-
-	size = decode_2bytes(data);
-	data += 2;
 
-	CBanwordManager::instance().Initialize((TBanwordTable *) data, size);
-	data += size * sizeof(TBanwordTable);
+	CBanwordManager::instance().Initialize((TBanwordTable *) c_pTable, size);
 
 	{
 		using namespace building;
 
 		/*
-		 * LANDS
+		 * OBJECT PROTO
 		 */
 
-		if (decode_2bytes(data) != sizeof(TLand))
+		if (!(c_pTable = kInflater.Read(sizeof(TObjectProto), "object proto", size)))
 		{
-			sys_err("land table size error");
 			thecore_shutdown();
 			return;
 		}
-		data += 2;
-
-		size = decode_2bytes(data);
-		data += 2;
 
-		TLand * kLand = (TLand *) data;
-		data += size * sizeof(TLand);
+		CManager::instance().LoadObjectProto((TObjectProto *) c_pTable, size);
 
-		for (WORD i = 0; i < size; ++i, ++kLand)
-			CManager::instance().LoadLand(kLand);
+		if (!kInflater.IsEnd())
+		{
+			sys_err("boot table stream has trailing data");
+			thecore_shutdown();
+			return;
+		}
 
 		/*
-		 * OBJECT PROTO
+		 * LANDS
 		 */
 
-		if (decode_2bytes(data) != sizeof(TObjectProto))
+		if (decode_2bytes(data) != sizeof(TLand))
 		{
-			sys_err("object proto table size error");
+			sys_err("land table size error");
 			thecore_shutdown();
 			return;
 		}
@@ -679,8 +752,11 @@ void CInputDB::Boot(const char* data)
 		size = decode_2bytes(data);
 		data += 2;
 
-		CManager::instance().LoadObjectProto((TObjectProto *) data, size);
-		data += size * sizeof(TObjectProto);
+		TLand * kLand = (TLand *) data;
+		data += size * sizeof(TLand);
+
+		for (WORD i = 0; i < size; ++i, ++kLand)
+			CManager::instance().LoadLand(kLand);
 
 		/*
 		 * OBJECT 
@@ -983,7 +1059,7 @@ void CInputDB::QuestLoad(LPDESC d, const char * c_pData)
 
 		sys_log(0, "QUEST_LOAD: count %d", dwCount);
 
-		quest::PC * pkPC = quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+		quest::PC * pkPC = quest::CQuestManager::instance().GetPCForce(ch);
 
 		if (!pkPC)
 		{
@@ -2223,6 +2299,10 @@ int CInputDB::Analyze(LPDESC d, BYTE bHeader, const char * c_pData)
 	case HEADER_DG_RESPOND_CHANNELSTATUS:
 		RespondChannelStatus(DESC_MANAGER::instance().FindByHandle(m_dwHandle), c_pData);
 		break;
+
+	case HEADER_DG_CLUSTER_STATE:
+		DESC_MANAGER::instance().SetClusterState((const TPacketDGClusterState *) c_pData);
+		break;
 	default:
 		return (-1);
 	}
@@ -228,6 +228,8 @@ void CInputLogin::CharacterSelect(LPDESC d, const char * data)
 	player_load_packet.account_id	= c_r.id;
 	player_load_packet.player_id	= c_r.players[pinfo->index].dwID;
 	player_load_packet.account_index	= pinfo->index;
+	//  鼭  ھ ĳ ¸ Ѱ ־ DB  ÷̾ ̺ .
+	player_load_packet.bHandoff	= CHARACTER_MANAGER::instance().FindWarpHandoff(d->GetLoginKey(), player_load_packet.player_id) != NULL;
 
 	db_clientdesc->DBPacket(HEADER_GD_PLAYER_LOAD, d->GetHandle(), &player_load_packet, sizeof(TPlayerLoadPacket));
 }
@@ -801,14 +803,8 @@ void CInputLogin::GuildMarkIDXList(LPDESC d, const char* c_pData)
 {
 	CGuildMarkManager & rkMarkMgr = CGuildMarkManager::instance();
 	
-	DWORD bufSize = sizeof(WORD) * 2 * rkMarkMgr.GetMarkCount();
-	char * buf = NULL;
-
-	if (bufSize > 0)
-	{
-		buf = (char *) malloc(bufSize);
-		rkMarkMgr.CopyMarkIdx(buf);
-	}
+	DWORD bufSize = 0;
+	const BYTE * buf = rkMarkMgr.GetMarkIdxData(bufSize);
 
 	TPacketGCMarkIDXList p;
 	p.header = HEADER_GC_MARK_IDXLIST;
@@ -819,7 +815,6 @@ void CInputLogin::GuildMarkIDXList(LPDESC d, const char* c_pData)
 	{
 		d->BufferedPacket(&p, sizeof(p));
 		d->LargePacket(buf, bufSize);
-		free(buf);
 	}
 	else
 		d->Packet(&p, sizeof(p));
@@ -831,37 +826,26 @@ void CInputLogin::GuildMarkCRCList(LPDESC d, const char* c_pData)
 {
 	TPacketCGMarkCRCList * pCG = (TPacketCGMarkCRCList *) c_pData;
 
-	std::map<BYTE, const SGuildMarkBlock *> mapDiffBlocks;
-	CGuildMarkManager::instance().GetDiffBlocks(pCG->imgIdx, pCG->crclist, mapDiffBlocks);
+	CGuildMarkManager & rkMarkMgr = CGuildMarkManager::instance();
 
+	//   ʹ ̹ ĳõǾ Ƿ CRC   ״ .
+	DWORD bufSize = 0;
 	DWORD blockCount = 0;
-	TEMP_BUFFER buf(1024 * 1024); // 1M 
-
-	for (itertype(mapDiffBlocks) it = mapDiffBlocks.begin(); it != mapDiffBlocks.end(); ++it)
-	{
-		BYTE posBlock = it->first;
-		const SGuildMarkBlock & rkBlock = *it->second;
-
-		buf.write(&posBlock, sizeof(BYTE));
-		buf.write(&rkBlock.m_sizeCompBuf, sizeof(DWORD));
-		buf.write(rkBlock.m_abCompBuf, rkBlock.m_sizeCompBuf);
-
-		++blockCount;
-	}
+	const BYTE * buf = rkMarkMgr.GetDiffBlockData(pCG->imgIdx, pCG->crclist, bufSize, blockCount);
 
 	TPacketGCMarkBlock pGC;
 
 	pGC.header = HEADER_GC_MARK_BLOCK;
 	pGC.imgIdx = pCG->imgIdx;
-	pGC.bufSize = buf.size() + sizeof(TPacketGCMarkBlock);
+	pGC.bufSize = bufSize + sizeof(TPacketGCMarkBlock);
 	pGC.count = blockCount;
 
-	sys_log(0, "MARK_SERVER: Sending blocks. (imgIdx %u diff %u size %u)", pCG->imgIdx, mapDiffBlocks.size(), pGC.bufSize);
+	sys_log(0, "MARK_SERVER: Sending blocks. (imgIdx %u version %u diff %u size %u)", pCG->imgIdx, rkMarkMgr.GetMarkImageVersion(pCG->imgIdx), blockCount, pGC.bufSize);
 
-	if (buf.size() > 0)
+	if (buf && bufSize > 0)
 	{
 		d->BufferedPacket(&pGC, sizeof(TPacketGCMarkBlock));
-		d->LargePacket(buf.read_peek(), buf.size());
+		d->LargePacket(buf, bufSize);
 	}
 	else
 		d->Packet(&pGC, sizeof(TPacketGCMarkBlock));
@@ -889,6 +873,14 @@ int CInputLogin::Analyze(LPDESC d, BYTE bHeader, const char * c_pData)
 			LoginByKey(d, c_pData);
 			break;
 
+		case HEADER_CG_PACKET_COMPRESSION:
+			d->SetPacketCompression(((TPacketCGPacketCompression *) c_pData)->bEnable && g_iPacketCompressThreshold > 0);
+			break;
+
+		case HEADER_CG_PROTOCOL_VERSION:
+			d->SetProtocolVersion(MIN(((TPacketCGProtocolVersion *) c_pData)->wVersion, PROTOCOL_VERSION_CURRENT));
+			break;
+
 		case HEADER_CG_CHARACTER_SELECT:
 			CharacterSelect(d, c_pData);
 			break;
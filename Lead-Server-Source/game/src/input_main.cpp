@@ -751,7 +751,8 @@ int CInputMain::Chat(LPCHARACTER ch, const char * data, size_t uiBytes)
 	{
 		case CHAT_TYPE_TALKING:
 			{
-				const DESC_MANAGER::DESC_SET & c_ref_set = DESC_MANAGER::instance().GetClientSet();
+				//  ʿ ִ Ը Ƿ   ϸ .
+				const DESC_MANAGER::DESC_SET & c_ref_set = DESC_MANAGER::instance().GetMapChatSet(ch->GetMapIndex());
 
 				if (false)
 				{
@@ -1034,6 +1035,15 @@ int CInputMain::Shop(LPCHARACTER ch, const char * data, size_t uiBytes)
 				return sizeof(BYTE) + sizeof(BYTE);
 			}
 
+		case SHOP_SUBHEADER_CG_SEARCH:
+			{
+				if (uiBytes < sizeof(TPacketCGShopSearch))
+					return -1;
+
+				CShopManager::instance().Search(ch, (const TPacketCGShopSearch *) c_pData);
+				return sizeof(TPacketCGShopSearch);
+			}
+
 		default:
 			sys_err("CInputMain::Shop : Unknown subheader %d : %s", p->subheader, ch->GetName());
 			break;
@@ -1610,7 +1620,11 @@ void CInputMain::Move(LPCHARACTER ch, const char * data)
 	pack.dwTime       = pinfo->dwTime;
 	pack.dwDuration   = (pinfo->bFunc == FUNC_MOVE) ? ch->GetCurrentMoveDuration() : 0;
 
-	ch->PacketAround(&pack, sizeof(TPacketGCMove), ch);
+	// ߴ Ŷ ָ ִ viewer  ޾ƾ ڸ ´´.
+	if (pinfo->bFunc == FUNC_MOVE)
+		ch->PacketViewLOD(&pack, sizeof(TPacketGCMove), ch);
+	else
+		ch->PacketAround(&pack, sizeof(TPacketGCMove), ch);
 /*
 	if (pinfo->dwTime == 10653691) //  ߰
 	{
@@ -1903,7 +1917,7 @@ void CInputMain::ScriptButton(LPCHARACTER ch, const void* c_pData)
 	TPacketCGScriptButton * p = (TPacketCGScriptButton *) c_pData;
 	sys_log(0, "QUEST ScriptButton pid %d idx %u", ch->GetPlayerID(), p->idx);
 
-	quest::PC* pc = quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+	quest::PC* pc = quest::CQuestManager::instance().GetPCForce(ch);
 	if (pc && pc->IsConfirmWait())
 	{
 		quest::CQuestManager::instance().Confirm(ch->GetPlayerID(), quest::CONFIRM_TIMEOUT);
@@ -1991,7 +2005,7 @@ void CInputMain::Warp(LPCHARACTER ch, const char * pcData)
 
 void CInputMain::SafeboxCheckin(LPCHARACTER ch, const char * c_pData)
 {
-	if (quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID())->IsRunning() == true)
+	if (quest::CQuestManager::instance().GetPCForce(ch)->IsRunning() == true)
 		return;
 
 	TPacketCGSafeboxCheckin * p = (TPacketCGSafeboxCheckin *) c_pData;
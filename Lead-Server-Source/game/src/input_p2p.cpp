@@ -17,6 +17,7 @@
 #include "locale_service.h"
 #include "questmanager.h"
 #include "skill.h"
+#include "lzo_manager.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -28,7 +29,12 @@ CInputP2P::CInputP2P()
 
 void CInputP2P::Login(LPDESC d, const char * c_pData)
 {
-	P2P_MANAGER::instance().Login(d, (TPacketGGLogin *) c_pData);
+	TPacketGGLogin * p = (TPacketGGLogin *) c_pData;
+
+	// 다른 코어에 접속했으면 넘겨 받아 둔 워프 상태는 더 이상 맞지 않는다.
+	CHARACTER_MANAGER::instance().RemoveWarpHandoff(p->dwPID);
+
+	P2P_MANAGER::instance().Login(d, p);
 }
 
 void CInputP2P::Logout(LPDESC d, const char * c_pData)
@@ -98,6 +104,120 @@ int CInputP2P::Relay(LPDESC d, const char * c_pData, size_t uiBytes)
 	return (p->lSize);
 }
 
+int CInputP2P::Batch(LPDESC d, const char * c_pData, size_t uiBytes)
+{
+	TPacketGGBatch * p = (TPacketGGBatch *) c_pData;
+
+	if (p->lSize < 0 || p->lRealSize < 0)
+	{
+		sys_err("invalid batch length %d real %d", p->lSize, p->lRealSize);
+		d->SetPhase(PHASE_CLOSE);
+		return -1;
+	}
+
+	if (uiBytes < sizeof(TPacketGGBatch) + p->lSize)
+		return -1;
+
+	const char * c_pBatch = c_pData + sizeof(TPacketGGBatch);
+	int iBatchSize = p->lSize;
+
+	if (p->lRealSize)
+	{
+		static std::vector<BYTE> s_vecDecompressed;
+
+		s_vecDecompressed.resize(p->lRealSize);
+		lzo_uint uiRealSize = p->lRealSize;
+
+		if (!LZOManager::instance().Decompress((const BYTE *) c_pBatch, p->lSize, &s_vecDecompressed[0], &uiRealSize) ||
+				uiRealSize != (lzo_uint) p->lRealSize)
+		{
+			sys_err("cannot decompress batch (size %d real %d)", p->lSize, p->lRealSize);
+			d->SetPhase(PHASE_CLOSE);
+			return -1;
+		}
+
+		c_pBatch = (const char *) &s_vecDecompressed[0];
+		iBatchSize = p->lRealSize;
+	}
+
+	// 묶인 패킷들을 그대로 처리한다. 바깥 버퍼의 남은 크기는 보존해야 한다.
+	int iBufferLeft = m_iBufferLeft;
+	int iBytesProceed = 0;
+
+	CInputProcessor::Process(d, c_pBatch, iBatchSize, iBytesProceed);
+
+	m_iBufferLeft = iBufferLeft;
+
+	if (iBytesProceed != iBatchSize)
+	{
+		sys_err("broken batch: %d of %d bytes proceed, count %u", iBytesProceed, iBatchSize, p->wCount);
+		d->SetPhase(PHASE_CLOSE);
+		return -1;
+	}
+
+	return (p->lSize);
+}
+
+int CInputP2P::CharacterHandoff(LPDESC d, const char * c_pData, size_t uiBytes)
+{
+	TPacketGGCharacterHandoff * p = (TPacketGGCharacterHandoff *) c_pData;
+
+	if (p->lSize < 0 || p->lRealSize < 0)
+	{
+		sys_err("invalid handoff length %d real %d", p->lSize, p->lRealSize);
+		d->SetPhase(PHASE_CLOSE);
+		return -1;
+	}
+
+	if (uiBytes < sizeof(TPacketGGCharacterHandoff) + p->lSize)
+		return -1;
+
+	// 꺼 두었으면 받지 않는다. 캐릭터는 평소처럼 DB 에서 읽는다.
+	if (!g_bWarpHandoff)
+		return p->lSize;
+
+	// 개수를 곱하기 전에 막아야 아래 크기 계산이 넘치지 않는다.
+	if (p->dwItemCount > CHARACTER_MANAGER::WARP_HANDOFF_ITEM_MAX ||
+			p->dwQuestCount > CHARACTER_MANAGER::WARP_HANDOFF_QUEST_MAX ||
+			p->dwAffectCount > CHARACTER_MANAGER::WARP_HANDOFF_AFFECT_MAX)
+	{
+		sys_err("broken handoff: pid %u item %u quest %u affect %u", p->dwPID, p->dwItemCount, p->dwQuestCount, p->dwAffectCount);
+		return p->lSize;
+	}
+
+	size_t uiExpectedSize = sizeof(TPlayerItem) * p->dwItemCount + sizeof(TQuestTable) * p->dwQuestCount + sizeof(TPacketAffectElement) * p->dwAffectCount;
+
+	// 압축을 풀기 전에 맞춰 봐야 lRealSize 만큼 함부로 잡지 않는다.
+	if ((size_t) (p->lRealSize ? p->lRealSize : p->lSize) != uiExpectedSize)
+	{
+		sys_err("broken handoff: pid %u size %d real %d item %u quest %u affect %u",
+				p->dwPID, p->lSize, p->lRealSize, p->dwItemCount, p->dwQuestCount, p->dwAffectCount);
+		return p->lSize;
+	}
+
+	const char * c_pHandoff = c_pData + sizeof(TPacketGGCharacterHandoff);
+
+	if (p->lRealSize)
+	{
+		static std::vector<BYTE> s_vecDecompressed;
+
+		s_vecDecompressed.resize(p->lRealSize);
+		lzo_uint uiRealSize = p->lRealSize;
+
+		if (!LZOManager::instance().Decompress((const BYTE *) c_pHandoff, p->lSize, &s_vecDecompressed[0], &uiRealSize) ||
+				uiRealSize != (lzo_uint) p->lRealSize)
+		{
+			sys_err("cannot decompress handoff (pid %u size %d real %d)", p->dwPID, p->lSize, p->lRealSize);
+			return p->lSize;
+		}
+
+		c_pHandoff = (const char *) &s_vecDecompressed[0];
+	}
+
+	CHARACTER_MANAGER::instance().AddWarpHandoff(p->dwLoginKey, p->dwPID, p->dwItemCount, p->dwQuestCount, p->dwAffectCount, c_pHandoff);
+	return p->lSize;
+}
+
 int CInputP2P::Notice(LPDESC d, const char * c_pData, size_t uiBytes)
 {
 	TPacketGGNotice * p = (TPacketGGNotice *) c_pData;
@@ -162,28 +282,10 @@ int CInputP2P::Guild(LPDESC d, const char* c_pData, size_t uiBytes)
 }
 
 
-struct FuncShout
-{
-	const char * m_str;
-	BYTE m_bEmpire;
-
-	FuncShout(const char * str, BYTE bEmpire) : m_str(str), m_bEmpire(bEmpire)
-	{
-	}   
-
-	void operator () (LPDESC d)
-	{
-		if (!d->GetCharacter() || (d->GetCharacter()->GetGMLevel() == GM_PLAYER && d->GetEmpire() != m_bEmpire))
-			return;
-
-		d->GetCharacter()->ChatPacket(CHAT_TYPE_SHOUT, LC_TEXT("%s"), m_str);
-	}
-};
-
+// 외치기는 이번 pulse 에 모아서 DESC_MANAGER::FlushShout 에서 제국 구독자에게만 보낸다.
 void SendShout(const char * szText, BYTE bEmpire)
 {
-	const DESC_MANAGER::DESC_SET & c_ref_set = DESC_MANAGER::instance().GetClientSet();
-	std::for_each(c_ref_set.begin(), c_ref_set.end(), FuncShout(szText, bEmpire));
+	DESC_MANAGER::instance().QueueShout(szText, bEmpire);
 }
 
 void CInputP2P::Shout(const char * c_pData)
@@ -212,8 +314,12 @@ void CInputP2P::Disconnect(const char * c_pData)
 void CInputP2P::Setup(LPDESC d, const char * c_pData)
 {
 	TPacketGGSetup * p = (TPacketGGSetup *) c_pData;
-	sys_log(0, "P2P: Setup %s:%d", d->GetHostName(), p->wPort);
+	struct in_addr kListenAddr;
+	kListenAddr.s_addr = p->lListenAddr;
+
+	sys_log(0, "P2P: Setup %s:%d listen %s:%d", d->GetHostName(), p->wPort, inet_ntoa(kListenAddr), p->wListenPort);
 	d->SetP2P(d->GetHostName(), p->wPort, p->bChannel);
+	d->SetP2PListen(p->lListenAddr, p->wListenPort);
 }
 
 void CInputP2P::MessengerAdd(const char * c_pData)
@@ -379,6 +485,16 @@ int CInputP2P::Analyze(LPDESC d, BYTE bHeader, const char * c_pData)
 				return -1;
 			break;
 
+		case HEADER_GG_BATCH:
+			if ((iExtraLen = Batch(d, c_pData, m_iBufferLeft)) < 0)
+				return -1;
+			break;
+
+		case HEADER_GG_CHARACTER_HANDOFF:
+			if ((iExtraLen = CharacterHandoff(d, c_pData, m_iBufferLeft)) < 0)
+				return -1;
+			break;
+
 		case HEADER_GG_NOTICE:
 			if ((iExtraLen = Notice(d, c_pData, m_iBufferLeft)) < 0)
 				return -1;
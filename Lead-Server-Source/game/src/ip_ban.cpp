@@ -17,6 +17,8 @@ typedef unsigned char BYTE;
 typedef unsigned long DWORD;
 
 #else
+#include <boost/unordered_map.hpp>
+#include "config.h"
 #include "ip_ban.h"
 #endif
 
@@ -86,6 +88,9 @@ class IP
 			return (dwStart & 0x000000FF);
 		}
 
+		DWORD GetStart() const	{ return dwStart; }
+		DWORD GetMask() const	{ return dwMask; }
+
 		void Print()
 		{
 			struct in_addr in_ip, in_mask, in_end;
@@ -134,7 +139,95 @@ class IP
 		DWORD dwMask;
 };
 
-std::map<int, std::vector<IP> > mapBanIP;
+#ifndef __MAIN__
+// ڸ ̾ ũ(CIDR) Ʈ Ʈ̷ ã ּ ϳ ƾ 32 ܰ .
+// ,  ּҷ  ũ ̾ ʰų ù ڸ ġ 뿪 ó ϳ Ѵ.
+struct SBanNode
+{
+	int		aiChild[2];
+	bool	bBanned;
+};
+
+static std::vector<SBanNode>	s_vec_kBanNode;
+static std::vector<IP>			s_vec_kBanIrregular;
+
+static int BanNodeNew()
+{
+	SBanNode kNode;
+	kNode.aiChild[0] = kNode.aiChild[1] = 0;
+	kNode.bBanned = false;
+
+	s_vec_kBanNode.push_back(kNode);
+	return s_vec_kBanNode.size() - 1;
+}
+
+static void BanNodeInsert(DWORD dwPrefix, int iPrefixLen)
+{
+	if (s_vec_kBanNode.empty())
+		BanNodeNew();
+
+	int iNode = 0;
+
+	for (int i = 0; i < iPrefixLen; ++i)
+	{
+		// ̹   뿪  ִ.
+		if (s_vec_kBanNode[iNode].bBanned)
+			return;
+
+		int iBit = (dwPrefix >> (31 - i)) & 1;
+
+		if (!s_vec_kBanNode[iNode].aiChild[iBit])
+		{
+			int iChild = BanNodeNew();
+			s_vec_kBanNode[iNode].aiChild[iBit] = iChild;
+		}
+
+		iNode = s_vec_kBanNode[iNode].aiChild[iBit];
+	}
+
+	s_vec_kBanNode[iNode].bBanned = true;
+}
+
+static bool BanNodeFind(DWORD dwAddr)
+{
+	if (s_vec_kBanNode.empty())
+		return false;
+
+	int iNode = 0;
+
+	for (int i = 0; i < 32; ++i)
+	{
+		iNode = s_vec_kBanNode[iNode].aiChild[(dwAddr >> (31 - i)) & 1];
+
+		if (!iNode)
+			return false;
+
+		if (s_vec_kBanNode[iNode].bBanned)
+			return true;
+	}
+
+	return false;
+}
+
+static void AddBanIP(IP & ip)
+{
+	DWORD dwMask = ntohl(ip.GetMask());
+	DWORD dwHost = ~dwMask;
+
+	// dwHost + 1  2 ŵ̸ ũ տ ̾ ִ.
+	//  ˻ ù ڸ ƾ Ƿ /8   뿪 Ʈ̿  ʴ´.
+	if ((dwHost & (dwHost + 1)) == 0 && (dwMask & 0xff000000) == 0xff000000)
+	{
+		int iPrefixLen = 0;
+
+		while (iPrefixLen < 32 && (dwMask & (0x80000000 >> iPrefixLen)))
+			++iPrefixLen;
+
+		BanNodeInsert(ntohl(ip.GetStart()) & dwMask, iPrefixLen);
+	}
+	else
+		s_vec_kBanIrregular.push_back(ip);
+}
 
 bool LoadBanIP(const char * filename)
 {
@@ -143,6 +236,9 @@ bool LoadBanIP(const char * filename)
 	if (!fp)
 		return false;
 
+	s_vec_kBanNode.clear();
+	s_vec_kBanIrregular.clear();
+
 	char buf[256];
 	char start[256];
 	char end[256];
@@ -173,42 +269,96 @@ bool LoadBanIP(const char * filename)
 		}
 
 		IP ip(start, end);
-
-		itertype(mapBanIP) it = mapBanIP.find(ip.hash());
-
-		if (it == mapBanIP.end())
-		{
-			std::vector<IP> v;
-			v.push_back(ip);
-			mapBanIP.insert(std::map<DWORD, std::vector<IP> >::value_type(ip.hash(), v));
-		}
-		else
-			it->second.push_back(ip);
+		AddBanIP(ip);
 	}
 
 	fclose(fp);
 
+	fprintf(stderr, "BANNED IP: %u trie nodes, %u irregular ranges\n", s_vec_kBanNode.size(), s_vec_kBanIrregular.size());
 	return true;
 }
 
 bool IsBanIP(struct in_addr in)
 {
-	IP ip(in);
-
-	itertype(mapBanIP) it = mapBanIP.find(ip.hash());
+	if (BanNodeFind(ntohl(in.s_addr)))
+		return true;
 
-	if (it == mapBanIP.end())
+	if (s_vec_kBanIrregular.empty())
 		return false;
 
-	itertype(it->second) it2 = it->second.begin();
+	IP ip(in);
 
-	while (it2 != it->second.end())
-		if (ip.IsChildOf(*(it2++)))
+	for (itertype(s_vec_kBanIrregular) it = s_vec_kBanIrregular.begin(); it != s_vec_kBanIrregular.end(); ++it)
+	{
+		if (ip.hash() == it->hash() && ip.IsChildOf(*it))
 			return true;
+	}
 
 	return false;
 }
 
+// ū 1/1000   .
+struct SLoginToken
+{
+	DWORD	dwMilliTokens;
+	DWORD	dwLastTime;
+};
+
+typedef boost::unordered_map<DWORD, SLoginToken> TLoginTokenMap;
+static TLoginTokenMap s_map_kLoginToken;
+
+static DWORD LoginTokenRefill(const SLoginToken & r, DWORD dwNow)
+{
+	// д g_iLoginThrottlePerMin  = ms  g_iLoginThrottlePerMin / 60 (1/1000 )
+	uint64_t qwMax = g_iLoginThrottleBurst * 1000;
+	uint64_t qwTokens = r.dwMilliTokens + (uint64_t) (dwNow - r.dwLastTime) * g_iLoginThrottlePerMin / 60;
+
+	return (DWORD) MIN(qwTokens, qwMax);
+}
+
+bool ConsumeLoginToken(struct in_addr in, DWORD dwNow)
+{
+	if (g_iLoginThrottleBurst <= 0)
+		return true;
+
+	TLoginTokenMap::iterator it = s_map_kLoginToken.find(in.s_addr);
+
+	if (it == s_map_kLoginToken.end())
+	{
+		SLoginToken & r = s_map_kLoginToken[in.s_addr];
+		r.dwMilliTokens = (g_iLoginThrottleBurst - 1) * 1000;
+		r.dwLastTime = dwNow;
+		return true;
+	}
+
+	SLoginToken & r = it->second;
+	r.dwMilliTokens = LoginTokenRefill(r, dwNow);
+	r.dwLastTime = dwNow;
+
+	if (r.dwMilliTokens < 1000)
+		return false;
+
+	r.dwMilliTokens -= 1000;
+	return true;
+}
+
+void ExpireLoginToken(DWORD dwNow)
+{
+	DWORD dwMax = g_iLoginThrottleBurst * 1000;
+
+	TLoginTokenMap::iterator it = s_map_kLoginToken.begin();
+
+	while (it != s_map_kLoginToken.end())
+	{
+		//  ä Ŷ  Ͱ .
+		if (g_iLoginThrottleBurst <= 0 || LoginTokenRefill(it->second, dwNow) >= dwMax)
+			it = s_map_kLoginToken.erase(it);
+		else
+			++it;
+	}
+}
+#endif
+
 #ifdef __MAIN__
 void UniqueIP(std::vector<IP> & v)
 {
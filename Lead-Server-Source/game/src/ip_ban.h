@@ -4,4 +4,9 @@
 extern bool LoadBanIP(const char * filename);
 extern bool IsBanIP(struct in_addr in);
 
+//  IP    ū Ŷ Ѵ. false   ʴ´.
+// login_throttle_burst  0 ̸ ׻ true
+extern bool ConsumeLoginToken(struct in_addr in, DWORD dwNow);
+extern void ExpireLoginToken(DWORD dwNow);
+
 #endif
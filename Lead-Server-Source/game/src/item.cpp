@@ -24,13 +24,14 @@
 
 CItem::CItem(DWORD dwVnum)
 	: m_dwVnum(dwVnum), m_bWindow(0), m_dwID(0), m_bEquipped(false), m_dwVID(0), m_wCell(0), m_dwCount(0), m_lFlag(0), m_dwLastOwnerPID(0),
-	m_bExchanging(false), m_pkDestroyEvent(NULL), m_pkUniqueExpireEvent(NULL), m_pkTimerBasedOnWearExpireEvent(NULL), m_pkRealTimeExpireEvent(NULL),
+	m_bExchanging(false), m_dwDestroyTime(0), m_pkUniqueExpireEvent(NULL), m_pkTimerBasedOnWearExpireEvent(NULL), m_pkRealTimeExpireEvent(NULL),
 	m_pkExpireEvent(NULL),
-   	m_pkAccessorySocketExpireEvent(NULL), m_pkOwnershipEvent(NULL), m_dwOwnershipPID(0), m_bSkipSave(false), m_isLocked(false),
+   	m_pkAccessorySocketExpireEvent(NULL), m_dwOwnershipTime(0), m_dwOwnershipPID(0), m_bSkipSave(false), m_isLocked(false),
 	m_dwMaskVnum(0), m_dwSIGVnum (0)
 {
 	memset( &m_alSockets, 0, sizeof(m_alSockets) );
 	memset( &m_aAttr, 0, sizeof(m_aAttr) );
+	m_szOwnershipName[0] = '\0';
 }
 
 CItem::~CItem()
@@ -52,9 +53,10 @@ void CItem::Initialize()
 	memset(&m_alSockets, 0, sizeof(m_alSockets));
 	memset(&m_aAttr, 0, sizeof(m_aAttr));
 
-	m_pkDestroyEvent = NULL;
-	m_pkOwnershipEvent = NULL;
+	m_dwDestroyTime = 0;
+	m_dwOwnershipTime = 0;
 	m_dwOwnershipPID = 0;
+	m_szOwnershipName[0] = '\0';
 	m_pkUniqueExpireEvent = NULL;
 	m_pkTimerBasedOnWearExpireEvent = NULL;
 	m_pkRealTimeExpireEvent = NULL;
@@ -67,8 +69,8 @@ void CItem::Initialize()
 
 void CItem::Destroy()
 {
-	event_cancel(&m_pkDestroyEvent);
-	event_cancel(&m_pkOwnershipEvent);
+	m_dwDestroyTime = 0;
+	m_dwOwnershipTime = 0;
 	event_cancel(&m_pkUniqueExpireEvent);
 	event_cancel(&m_pkTimerBasedOnWearExpireEvent);
 	event_cancel(&m_pkRealTimeExpireEvent);
@@ -80,40 +82,45 @@ void CItem::Destroy()
 		GetSectree()->RemoveEntity(this);
 }
 
-EVENTFUNC(item_destroy_event)
+void CItem::StartDestroyEvent(int iSec)
 {
-	item_event_info* info = dynamic_cast<item_event_info*>( event->info );
+	if (m_dwDestroyTime)
+		return;
 
-	if ( info == NULL )
+	m_dwDestroyTime = get_global_time() + MAX(1, iSec);
+	ITEM_MANAGER::instance().RegisterGroundExpire(this, m_dwDestroyTime, false);
+}
+
+// ITEM_MANAGER::UpdateGroundExpire  θ.   ð ٲ Ѵ.
+void CItem::OnGroundExpire(DWORD dwTime, bool bOwnership)
+{
+	if (bOwnership)
 	{
-		sys_err( "item_destroy_event> <Factor> Null pointer" );
-		return 0;
-	}
+		if (m_dwOwnershipTime != dwTime)
+			return;
 
-	LPITEM pkItem = info->item;
+		m_dwOwnershipTime = 0;
+		m_dwOwnershipPID = 0;
 
-	if (pkItem->GetOwner())
-		sys_err("item_destroy_event: Owner exist. (item %s owner %s)", pkItem->GetName(), pkItem->GetOwner()->GetName());
+		TPacketGCItemOwnership p;
 
-	pkItem->SetDestroyEvent(NULL);
-	M2_DESTROY_ITEM(pkItem);
-	return 0;
-}
+		p.bHeader	= HEADER_GC_ITEM_OWNERSHIP;
+		p.dwVID	= m_dwVID;
+		p.szName[0]	= '\0';
 
-void CItem::SetDestroyEvent(LPEVENT pkEvent)
-{
-	m_pkDestroyEvent = pkEvent;
-}
+		PacketAround(&p, sizeof(p));
+		return;
+	}
 
-void CItem::StartDestroyEvent(int iSec)
-{
-	if (m_pkDestroyEvent)
+	if (m_dwDestroyTime != dwTime)
 		return;
 
-	item_event_info* info = AllocEventInfo<item_event_info>();
-	info->item = this;
+	if (GetOwner())
+		sys_err("CItem::OnGroundExpire: Owner exist. (item %s owner %s)", GetName(), GetOwner()->GetName());
 
-	SetDestroyEvent(event_create(item_destroy_event, info, PASSES_PER_SEC(iSec)));
+	m_dwDestroyTime = 0;
+	LPITEM pkItem = this;
+	M2_DESTROY_ITEM(pkItem);
 }
 
 void CItem::EncodeInsertPacket(LPENTITY ent)
@@ -137,21 +144,13 @@ void CItem::EncodeInsertPacket(LPENTITY ent)
 
 	d->Packet(&pack, sizeof(pack));
 
-	if (m_pkOwnershipEvent != NULL)
+	if (m_dwOwnershipTime)
 	{
-		item_event_info * info = dynamic_cast<item_event_info *>(m_pkOwnershipEvent->info);
-
-		if ( info == NULL )
-		{
-			sys_err( "CItem::EncodeInsertPacket> <Factor> Null pointer" );
-			return;
-		}
-
 		TPacketGCItemOwnership p;
 
 		p.bHeader = HEADER_GC_ITEM_OWNERSHIP;
 		p.dwVID = m_dwVID;
-		strlcpy(p.szName, info->szOwnerName, sizeof(p.szName));
+		strlcpy(p.szName, m_szOwnershipName, sizeof(p.szName));
 
 		d->Packet(&p, sizeof(TPacketGCItemOwnership));
 	}
@@ -352,7 +351,7 @@ bool CItem::AddToCharacter(LPCHARACTER ch, TItemPos Cell)
 	if (ch->GetDesc())
 		m_dwLastOwnerPID = ch->GetPlayerID();
 
-	event_cancel(&m_pkDestroyEvent);
+	m_dwDestroyTime = 0;
 
 	ch->SetItem(TItemPos(window_type, pos), this);
 	m_pOwner = ch;
@@ -1016,48 +1015,19 @@ int CItem::GetShopBuyPrice()
 
 bool CItem::IsOwnership(LPCHARACTER ch)
 {
-	if (!m_pkOwnershipEvent)
+	if (!m_dwOwnershipTime)
 		return true;
 
 	return m_dwOwnershipPID == ch->GetPlayerID() ? true : false;
 }
 
-EVENTFUNC(ownership_event)
-{
-	item_event_info* info = dynamic_cast<item_event_info*>( event->info );
-
-	if ( info == NULL )
-	{
-		sys_err( "ownership_event> <Factor> Null pointer" );
-		return 0;
-	}
-
-	LPITEM pkItem = info->item;
-
-	pkItem->SetOwnershipEvent(NULL);
-
-	TPacketGCItemOwnership p;
-
-	p.bHeader	= HEADER_GC_ITEM_OWNERSHIP;
-	p.dwVID	= pkItem->GetVID();
-	p.szName[0]	= '\0';
-
-	pkItem->PacketAround(&p, sizeof(p));
-	return 0;
-}
-
-void CItem::SetOwnershipEvent(LPEVENT pkEvent)
-{
-	m_pkOwnershipEvent = pkEvent;
-}
-
 void CItem::SetOwnership(LPCHARACTER ch, int iSec)
 {
 	if (!ch)
 	{
-		if (m_pkOwnershipEvent)
+		if (m_dwOwnershipTime)
 		{
-			event_cancel(&m_pkOwnershipEvent);
+			m_dwOwnershipTime = 0;
 			m_dwOwnershipPID = 0;
 
 			TPacketGCItemOwnership p;
@@ -1071,19 +1041,17 @@ void CItem::SetOwnership(LPCHARACTER ch, int iSec)
 		return;
 	}
 
-	if (m_pkOwnershipEvent)
+	if (m_dwOwnershipTime)
 		return;
 
 	if (iSec <= 10)
 		iSec = 30;
 
 	m_dwOwnershipPID = ch->GetPlayerID();
+	strlcpy(m_szOwnershipName, ch->GetName(), sizeof(m_szOwnershipName));
 
-	item_event_info* info = AllocEventInfo<item_event_info>();
-	strlcpy(info->szOwnerName, ch->GetName(), sizeof(info->szOwnerName));
-	info->item = this;
-
-	SetOwnershipEvent(event_create(ownership_event, info, PASSES_PER_SEC(iSec)));
+	m_dwOwnershipTime = get_global_time() + iSec;
+	ITEM_MANAGER::instance().RegisterGroundExpire(this, m_dwOwnershipTime, true);
 
 	TPacketGCItemOwnership p;
 
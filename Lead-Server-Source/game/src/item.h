@@ -2,8 +2,12 @@
 #define __INC_METIN_II_GAME_ITEM_H__
 
 #include "entity.h"
+#include "object_allocator.h"
 
-class CItem : public CEntity
+//     ֱ  Ǯ ܵ ִ 
+enum { ITEM_POOL_FREE_TRIGGER = 16384 };
+
+class CItem : public CEntity, public ObjectAllocator<CItem, ITEM_POOL_FREE_TRIGGER, MEM_TAG_ITEM>
 {
 	protected:
 		// override methods from ENTITY class
@@ -126,8 +130,9 @@ class CItem : public CEntity
 		bool		HasAttr(BYTE bApply);
 		bool		HasRareAttr(BYTE bApply);
 
-		void		SetDestroyEvent(LPEVENT pkEvent);
+		// ٴ  ı/  ITEM_MANAGER     óѴ.
 		void		StartDestroyEvent(int iSec=300);
+		void		OnGroundExpire(DWORD dwTime, bool bOwnership);
 
 		DWORD		GetRefinedVnum()	{ return m_pProto ? m_pProto->dwRefinedVnum : 0; }
 		DWORD		GetRefineFromVnum();
@@ -138,7 +143,6 @@ class CItem : public CEntity
 
 		bool		IsOwnership(LPCHARACTER ch);
 		void		SetOwnership(LPCHARACTER ch, int iSec = 10);
-		void		SetOwnershipEvent(LPEVENT pkEvent);
 
 		DWORD		GetLastOwnerPID()	{ return m_dwLastOwnerPID; }
 
@@ -261,15 +265,16 @@ class CItem : public CEntity
 		long		m_alSockets[ITEM_SOCKET_MAX_NUM];	//  Ĺ
 		TPlayerItemAttribute	m_aAttr[ITEM_ATTRIBUTE_MAX_NUM];
 
-		LPEVENT		m_pkDestroyEvent;
+		DWORD		m_dwDestroyTime;	// ٴڿ  ð(). 0 ̸ .
 		LPEVENT		m_pkExpireEvent;
 		LPEVENT		m_pkUniqueExpireEvent;
 		LPEVENT		m_pkTimerBasedOnWearExpireEvent;
 		LPEVENT		m_pkRealTimeExpireEvent;
 		LPEVENT		m_pkAccessorySocketExpireEvent;
-		LPEVENT		m_pkOwnershipEvent;
 
+		DWORD		m_dwOwnershipTime;	//  Ǯ ð(). 0 ̸  .
 		DWORD		m_dwOwnershipPID;
+		char		m_szOwnershipName[CHARACTER_NAME_MAX_LEN + 1];
 
 		bool		m_bSkipSave;
 
@@ -22,9 +22,11 @@
 #include "common/VnumHelper.h"
 #include "DragonSoul.h"
 #include "cube.h"
+#include "mob_manager.h"
 
 ITEM_MANAGER::ITEM_MANAGER()
-	: m_iTopOfTable(0), m_dwVIDCount(0), m_dwCurrentID(0)
+	: m_iTopOfTable(0), m_dwVIDCount(0), m_dwCurrentID(0),
+	m_dwItemPoolReuse(0), m_dwItemPoolAlloc(0), m_dwItemLivePeak(0), m_pkDropTableReloadJob(NULL)
 {
 	m_ItemIDRange.dwMin = m_ItemIDRange.dwMax = m_ItemIDRange.dwUsableItemIDMin = 0;
 	m_ItemIDSpareRange.dwMin = m_ItemIDSpareRange.dwMax = m_ItemIDSpareRange.dwUsableItemIDMin = 0;
@@ -37,11 +39,16 @@ ITEM_MANAGER::~ITEM_MANAGER()
 
 void ITEM_MANAGER::Destroy()
 {
+	ProcessDropTableReload(true);
+
 	itertype(m_VIDMap) it = m_VIDMap.begin();
 	for ( ; it != m_VIDMap.end(); ++it) {
 		M2_DELETE(it->second);
 	}
 	m_VIDMap.clear();
+
+	m_map_vecGroundDestroy.clear();
+	m_map_vecGroundOwnership.clear();
 }
 
 void ITEM_MANAGER::GracefulShutdown()
@@ -56,11 +63,16 @@ void ITEM_MANAGER::GracefulShutdown()
 
 bool ITEM_MANAGER::Initialize(TItemTable * table, int size)
 {
+	//  ̺ д 尡  ̺  Ƿ  .
+	ProcessDropTableReload(true);
+
 	if (!m_vec_prototype.empty())
 		m_vec_prototype.clear();
 
 	int	i;
 
+	m_vec_item_vnum_range_info.clear();
+
 	m_vec_prototype.resize(size);
 	thecore_memcpy(&m_vec_prototype[0], table, sizeof(TItemTable) * size);
 	for (int i = 0; i < size; i++)
@@ -71,6 +83,11 @@ bool ITEM_MANAGER::Initialize(TItemTable * table, int size)
 		}
 	}
 
+	BuildVnumIndex();
+
+	if (test_server)
+		BenchmarkVnumIndex();
+
 	m_map_ItemRefineFrom.clear();
 	for (i = 0; i < size; ++i)
 	{
@@ -160,17 +177,27 @@ LPITEM ITEM_MANAGER::CreateItem(DWORD vnum, DWORD count, DWORD id, bool bTryMagi
 	LPITEM item = NULL;
 
 	//id ˻ؼ Ѵٸ -- ! 
-	if (m_map_pkItemByID.find(id) != m_map_pkItemByID.end())
+	itertype(m_map_pkItemByID) itDup = m_map_pkItemByID.find(id);
+
+	if (itDup != m_map_pkItemByID.end())
 	{
-		item = m_map_pkItemByID[id];
+		item = itDup->second;
 		LPCHARACTER owner = item->GetOwner();
 		sys_err("ITEM_ID_DUP: %u %s owner %p", id, item->GetName(), get_pointer(owner));
 		return NULL;
 	}
 
 	// ϳ Ҵϰ
+	if (CItem::GetFreeBlockCount())
+		++m_dwItemPoolReuse;
+	else
+		++m_dwItemPoolAlloc;
+
 	item = M2_NEW CItem(vnum);
 
+	if (CItem::GetUsedBlockCount() > m_dwItemLivePeak)
+		m_dwItemLivePeak = CItem::GetUsedBlockCount();
+
 	bool bIsNewItem = (0 == id);
 
 	//ʱȭ ϰ. ̺ ϰ
@@ -245,7 +272,7 @@ LPITEM ITEM_MANAGER::CreateItem(DWORD vnum, DWORD count, DWORD id, bool bTryMagi
 		m_VIDMap.insert(ITEM_VID_MAP::value_type(item->GetVID(), item));
 
 	if (item->GetID() != 0 && bSkipSave == false)
-		m_map_pkItemByID.insert(std::map<DWORD, LPITEM>::value_type(item->GetID(), item));
+		m_map_pkItemByID.insert(ITEM_ID_MAP::value_type(item->GetID(), item));
 
 	if (!item->SetCount(count))
 		return NULL;
@@ -455,6 +482,41 @@ void ITEM_MANAGER::Update()
 	}
 }
 
+void ITEM_MANAGER::RegisterGroundExpire(LPITEM item, DWORD dwTime, bool bOwnership)
+{
+	TGroundExpireMap & rMap = bOwnership ? m_map_vecGroundOwnership : m_map_vecGroundDestroy;
+	rMap[dwTime].push_back(item->GetVID());
+}
+
+static void SweepGroundExpire(std::map<DWORD, std::vector<DWORD> > & rMap, DWORD dwNow, bool bOwnership)
+{
+	while (!rMap.empty() && rMap.begin()->first <= dwNow)
+	{
+		DWORD dwTime = rMap.begin()->first;
+		std::vector<DWORD> vecVID;
+		vecVID.swap(rMap.begin()->second);
+		rMap.erase(rMap.begin());
+
+		// vid  ٽ  Ƿ ̹   ã ʴ´.
+		for (size_t i = 0; i < vecVID.size(); ++i)
+		{
+			LPITEM item = ITEM_MANAGER::instance().FindByVID(vecVID[i]);
+
+			if (item)
+				item->OnGroundExpire(dwTime, bOwnership);
+		}
+	}
+}
+
+void ITEM_MANAGER::UpdateGroundExpire()
+{
+	DWORD dwNow = get_global_time();
+
+	//    ʿ ǵ Ǯ ۿ  Ŷ  ʴ´.
+	SweepGroundExpire(m_map_vecGroundDestroy, dwNow, false);
+	SweepGroundExpire(m_map_vecGroundOwnership, dwNow, true);
+}
+
 void ITEM_MANAGER::RemoveItem(LPITEM item, const char * c_pszReason)
 {
 	LPCHARACTER o;
@@ -533,6 +595,17 @@ void ITEM_MANAGER::DestroyItem(LPITEM item)
 	M2_DELETE(item);
 }
 
+void ITEM_MANAGER::DumpItemPoolStat()
+{
+	sys_log(0, "ITEM_POOL: live %u peak %u free %u reuse %u alloc %u vid_map %u id_map %u",
+			(DWORD) CItem::GetUsedBlockCount(), m_dwItemLivePeak, (DWORD) CItem::GetFreeBlockCount(),
+			m_dwItemPoolReuse, m_dwItemPoolAlloc, (DWORD) m_VIDMap.size(), (DWORD) m_map_pkItemByID.size());
+
+	m_dwItemPoolReuse = 0;
+	m_dwItemPoolAlloc = 0;
+	m_dwItemLivePeak = CItem::GetUsedBlockCount();
+}
+
 LPITEM ITEM_MANAGER::Find(DWORD id)
 {
 	itertype(m_map_pkItemByID) it = m_map_pkItemByID.find(id);
@@ -551,7 +624,90 @@ LPITEM ITEM_MANAGER::FindByVID(DWORD vid)
 	return (it->second);
 }
 
+void ITEM_MANAGER::BuildVnumIndex()
+{
+	DWORD dwEnd = 0;
+
+	for (DWORD i = 0; i < m_vec_prototype.size(); ++i)
+	{
+		const TItemTable & r = m_vec_prototype[i];
+		dwEnd = MAX(dwEnd, MAX(r.dwVnum + 1, r.dwVnum + r.dwVnumRange));
+	}
+
+	dwEnd = MIN(dwEnd, (DWORD) ITEM_VNUM_INDEX_MAX);
+
+	m_vec_iVnumIndex.assign(dwEnd, -1);
+
+	// Ȯ ġϴ vnum   켱̴.
+	for (DWORD i = 0; i < m_vec_prototype.size(); ++i)
+	{
+		if (m_vec_prototype[i].dwVnum < dwEnd && m_vec_iVnumIndex[m_vec_prototype[i].dwVnum] < 0)
+			m_vec_iVnumIndex[m_vec_prototype[i].dwVnum] = i;
+	}
+
+	//  ġ SearchTable    ϵ  ̱.
+	for (DWORD i = 0; i < m_vec_item_vnum_range_info.size(); ++i)
+	{
+		const TItemTable * p = m_vec_item_vnum_range_info[i];
+		int idx = p - &m_vec_prototype[0];
+		DWORD dwLast = MIN(p->dwVnum + p->dwVnumRange, dwEnd);
+
+		for (DWORD v = p->dwVnum + 1; v < dwLast; ++v)
+		{
+			if (m_vec_iVnumIndex[v] < 0)
+				m_vec_iVnumIndex[v] = idx;
+		}
+	}
+
+	sys_log(0, "ITEM_VNUM_INDEX: %u slots (%u KB) for %u protos, %u ranges",
+			dwEnd, (DWORD) (dwEnd * sizeof(int) / 1024), (DWORD) m_vec_prototype.size(), (DWORD) m_vec_item_vnum_range_info.size());
+}
+
+void ITEM_MANAGER::BenchmarkVnumIndex()
+{
+	if (m_vec_prototype.empty())
+		return;
+
+	const int LOOKUP_COUNT = 1000000;
+	DWORD dwSize = m_vec_prototype.size();
+	DWORD dwMismatch = 0;
+	struct timeval tv_start, tv_index, tv_search;
+
+	//  ִ vnum,   Ǵ  vnum  ãƺ.
+	gettimeofday(&tv_start, NULL);
+	for (int i = 0; i < LOOKUP_COUNT; ++i)
+	{
+		DWORD vnum = m_vec_prototype[i % dwSize].dwVnum + (i & 1);
+		if (GetTable(vnum) != SearchTable(vnum))
+			++dwMismatch;
+	}
+	gettimeofday(&tv_index, NULL);
+	for (int i = 0; i < LOOKUP_COUNT; ++i)
+		SearchTable(m_vec_prototype[i % dwSize].dwVnum + (i & 1));
+	gettimeofday(&tv_search, NULL);
+
+	long lBoth = (tv_index.tv_sec - tv_start.tv_sec) * 1000000 + (tv_index.tv_usec - tv_start.tv_usec);
+	long lSearch = (tv_search.tv_sec - tv_index.tv_sec) * 1000000 + (tv_search.tv_usec - tv_index.tv_usec);
+
+	sys_log(0, "ITEM_VNUM_INDEX: %d lookups, indexed %ld usec, search %ld usec, mismatch %u",
+			LOOKUP_COUNT, MAX(lBoth - lSearch, 0L), lSearch, dwMismatch);
+
+	if (dwMismatch)
+		sys_err("ITEM_VNUM_INDEX: %u lookups differ from the binary search", dwMismatch);
+}
+
 TItemTable * ITEM_MANAGER::GetTable(DWORD vnum)
+{
+	if (vnum < m_vec_iVnumIndex.size())
+	{
+		int idx = m_vec_iVnumIndex[vnum];
+		return idx < 0 ? NULL : &m_vec_prototype[idx];
+	}
+
+	return SearchTable(vnum);
+}
+
+TItemTable * ITEM_MANAGER::SearchTable(DWORD vnum)
 {
 	int rnum = RealNumber(vnum);
 
@@ -577,21 +733,24 @@ int ITEM_MANAGER::RealNumber(DWORD vnum)
 {
 	int bot, top, mid;
 
+	if (m_vec_prototype.empty())
+		return (-1);
+
 	bot = 0;
-	top = m_vec_prototype.size();
+	top = m_vec_prototype.size() - 1;
 
 	TItemTable * pTable = &m_vec_prototype[0];
 
 	while (1)
 	{
+		if (bot > top)
+			return (-1);
+
 		mid = (bot + top) >> 1;
 
 		if ((pTable + mid)->dwVnum == vnum)
 			return (mid);
 
-		if (bot >= top)
-			return (-1);
-
 		if ((pTable + mid)->dwVnum > vnum)
 			top = mid - 1;
 		else        
@@ -701,6 +860,130 @@ bool ITEM_MANAGER::GetDropPct(LPCHARACTER pkChr, LPCHARACTER pkKiller, OUT int&
 	return true;
 }
 
+void CDropAliasTable::Build(const std::vector<int>& vecCumulativeProbs)
+{
+	m_iTotal = 0;
+	m_vecCut.clear();
+	m_vecAlias.clear();
+
+	if (vecCumulativeProbs.empty())
+		return;
+
+	int n = vecCumulativeProbs.size();
+	int iTotal = vecCumulativeProbs.back();
+
+	// ġ ȣϴ  lower_bound  .
+	if (iTotal <= 0 || (long long) n * iTotal > INT_MAX)
+		return;
+
+	//  ĭ ũ iTotal, ׸ i  n * w(i) ŭ Ѵ.
+	std::vector<long long> vecScaled(n);
+	std::vector<int> vecSmall, vecLarge;
+	int iPrev = 0;
+
+	for (int i = 0; i < n; ++i)
+	{
+		int w = vecCumulativeProbs[i] - iPrev;
+		iPrev = vecCumulativeProbs[i];
+
+		if (w < 0)
+			return;
+
+		vecScaled[i] = (long long) n * w;
+
+		if (vecScaled[i] < iTotal)
+			vecSmall.push_back(i);
+		else
+			vecLarge.push_back(i);
+	}
+
+	std::vector<int> vecCut(n, iTotal);
+	std::vector<int> vecAlias(n);
+
+	for (int i = 0; i < n; ++i)
+		vecAlias[i] = i;
+
+	while (!vecSmall.empty() && !vecLarge.empty())
+	{
+		int l = vecSmall.back();
+		int g = vecLarge.back();
+		vecSmall.pop_back();
+
+		vecCut[l] = (int) vecScaled[l];
+		vecAlias[l] = g;
+		vecScaled[g] -= iTotal - vecScaled[l];
+
+		if (vecScaled[g] < iTotal)
+		{
+			vecLarge.pop_back();
+			vecSmall.push_back(g);
+		}
+	}
+
+	//  Ƿ  ĭ Ȯ   ִ (vecCut == iTotal).
+	m_iTotal = iTotal;
+	m_vecCut.swap(vecCut);
+	m_vecAlias.swap(vecAlias);
+}
+
+void ITEM_MANAGER::BuildMobDropPlan()
+{
+	std::map<DWORD, SMobDropPlan> mapPlan;
+
+	for (itertype(m_map_pkDropItemGroup) it = m_map_pkDropItemGroup.begin(); it != m_map_pkDropItemGroup.end(); ++it)
+		mapPlan[it->first].pkDropGroup = it->second;
+
+	for (itertype(m_map_pkMobItemGroup) it = m_map_pkMobItemGroup.begin(); it != m_map_pkMobItemGroup.end(); ++it)
+		mapPlan[it->first].pvec_pkMobGroup = &it->second;
+
+	for (itertype(m_map_pkLevelItemGroup) it = m_map_pkLevelItemGroup.begin(); it != m_map_pkLevelItemGroup.end(); ++it)
+		mapPlan[it->first].pkLevelGroup = it->second;
+
+	for (itertype(m_map_pkGloveItemGroup) it = m_map_pkGloveItemGroup.begin(); it != m_map_pkGloveItemGroup.end(); ++it)
+		mapPlan[it->first].pkGloveGroup = it->second;
+
+	// etc drop   proto  dwDropItemVnum  ã´. proto  ٲ CreateDropItem  ʿ ٽ ã´.
+	for (CMobManager::iterator it = CMobManager::instance().begin(); it != CMobManager::instance().end(); ++it)
+	{
+		const TMobTable & t = it->second->m_table;
+
+		if (!t.dwDropItemVnum)
+			continue;
+
+		itertype(m_map_dwEtcItemDropProb) itEtc = m_map_dwEtcItemDropProb.find(t.dwDropItemVnum);
+
+		if (itEtc == m_map_dwEtcItemDropProb.end())
+			continue;
+
+		SMobDropPlan & r = mapPlan[t.dwVnum];
+		r.dwEtcDropVnum = itEtc->first;
+		r.dwEtcDropProb = itEtc->second;
+	}
+
+	m_vec_kMobDropPlan.clear();
+	m_vec_iMobDropPlanIndex.clear();
+
+	if (mapPlan.empty())
+		return;
+
+	// race  WORD ̹Ƿ 迭 ũ⵵  ȿ ִ.
+	DWORD dwMaxRace = MIN(mapPlan.rbegin()->first, (DWORD) USHRT_MAX);
+
+	m_vec_kMobDropPlan.reserve(mapPlan.size());
+	m_vec_iMobDropPlanIndex.assign(dwMaxRace + 1, -1);
+
+	for (itertype(mapPlan) it = mapPlan.begin(); it != mapPlan.end(); ++it)
+	{
+		if (it->first > dwMaxRace)
+			break;
+
+		m_vec_iMobDropPlanIndex[it->first] = m_vec_kMobDropPlan.size();
+		m_vec_kMobDropPlan.push_back(it->second);
+	}
+
+	sys_log(0, "MOB_DROP_PLAN: %u mobs, %u slots", (DWORD) m_vec_kMobDropPlan.size(), (DWORD) m_vec_iMobDropPlanIndex.size());
+}
+
 bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::vector<LPITEM> & vec_item)
 {
 	int iLevel = pkKiller->GetLevel();
@@ -714,6 +997,8 @@ bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::
 	BYTE bRank = pkChr->GetMobRank();
 	LPITEM item = NULL;
 
+	const SMobDropPlan * pkPlan = GetMobDropPlan(pkChr->GetRaceNum());
+
 	// Common Drop Items
 	std::vector<CItemDropInfo>::iterator it = g_vec_pkCommonDropItem[bRank].begin();
 
@@ -761,12 +1046,9 @@ bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::
 
 	// Drop Item Group
 	{
-		itertype(m_map_pkDropItemGroup) it;
-		it = m_map_pkDropItemGroup.find(pkChr->GetRaceNum());
-
-		if (it != m_map_pkDropItemGroup.end())
+		if (pkPlan && pkPlan->pkDropGroup)
 		{
-			typeof(it->second->GetVector()) v = it->second->GetVector();
+			typeof(pkPlan->pkDropGroup->GetVector()) v = pkPlan->pkDropGroup->GetVector();
 
 			for (DWORD i = 0; i < v.size(); ++i)
 			{
@@ -795,12 +1077,9 @@ bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::
 
 	// MobDropItem Group
 	{
-		itertype(m_map_pkMobItemGroup) it;
-		it = m_map_pkMobItemGroup.find(pkChr->GetRaceNum());
-
-		if (it != m_map_pkMobItemGroup.end())
+		if (pkPlan && pkPlan->pvec_pkMobGroup)
 		{
-			std::vector<CMobItemGroup*>& vec_pGroups = it->second;
+			const std::vector<CMobItemGroup*>& vec_pGroups = *pkPlan->pvec_pkMobGroup;
 
 			for (int i = 0; i < vec_pGroups.size(); ++i)
 			{
@@ -831,22 +1110,21 @@ bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::
 
 	// Level Item Group
 	{
-		itertype(m_map_pkLevelItemGroup) it;
-		it = m_map_pkLevelItemGroup.find(pkChr->GetRaceNum());
-
-		if (it != m_map_pkLevelItemGroup.end())
+		if (pkPlan && pkPlan->pkLevelGroup)
 		{
-			if (it->second->GetLevelLimitStart() <= (DWORD)iLevel)
+			CLevelItemGroup * pkLevelGroup = pkPlan->pkLevelGroup;
+
+			if (pkLevelGroup->GetLevelLimitStart() <= (DWORD)iLevel)
 			{
 				iLevelMin = true;
 			}
-			if (it->second->GetLevelLimitEnd() >= (DWORD)iLevel)
+			if (pkLevelGroup->GetLevelLimitEnd() >= (DWORD)iLevel)
 			{
 				iLevelMax = true;
 			}
 			if (iLevelMin && iLevelMax)
 			{
-				typeof(it->second->GetVector()) v = it->second->GetVector();
+				typeof(pkLevelGroup->GetVector()) v = pkLevelGroup->GetVector();
 
 				for (DWORD i = 0; i < v.size(); i++)
 				{
@@ -866,12 +1144,9 @@ bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::
 		if (pkKiller->GetPremiumRemainSeconds(PREMIUM_ITEM) > 0 ||
 			pkKiller->IsEquipUniqueGroup(UNIQUE_GROUP_DOUBLE_ITEM))
 		{
-			itertype(m_map_pkGloveItemGroup) it;
-			it = m_map_pkGloveItemGroup.find(pkChr->GetRaceNum());
-
-			if (it != m_map_pkGloveItemGroup.end())
+			if (pkPlan && pkPlan->pkGloveGroup)
 			{
-				typeof(it->second->GetVector()) v = it->second->GetVector();
+				typeof(pkPlan->pkGloveGroup->GetVector()) v = pkPlan->pkGloveGroup->GetVector();
 
 				for (DWORD i = 0; i < v.size(); ++i)
 				{
@@ -891,11 +1166,21 @@ bool ITEM_MANAGER::CreateDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::
 	// 
 	if (pkChr->GetMobDropItemVnum())
 	{
-		itertype(m_map_dwEtcItemDropProb) it = m_map_dwEtcItemDropProb.find(pkChr->GetMobDropItemVnum());
+		DWORD dwEtcDropProb = 0;
+
+		if (pkPlan && pkPlan->dwEtcDropVnum == pkChr->GetMobDropItemVnum())
+			dwEtcDropProb = pkPlan->dwEtcDropProb;
+		else
+		{
+			itertype(m_map_dwEtcItemDropProb) it = m_map_dwEtcItemDropProb.find(pkChr->GetMobDropItemVnum());
+
+			if (it != m_map_dwEtcItemDropProb.end())
+				dwEtcDropProb = it->second;
+		}
 
-		if (it != m_map_dwEtcItemDropProb.end())
+		if (dwEtcDropProb)
 		{
-			int iPercent = (it->second * iDeltaPercent) / 100;
+			int iPercent = (dwEtcDropProb * iDeltaPercent) / 100;
 
 			if (iPercent >= number(1, iRandRange))
 			{
@@ -24,6 +24,36 @@ public:
 	std::vector<CSpecialAttrInfo> m_vecAttrs;
 };
 
+// Walker alias table.
+//  Ȯ (m_vecProbs) , number()   ϳ .
+// ĭ  *  int    ʰ IsEmpty()  true  ȴ.
+class CDropAliasTable
+{
+public:
+	CDropAliasTable() : m_iTotal(0)
+	{
+	}
+
+	void Build(const std::vector<int>& vecCumulativeProbs);
+
+	bool IsEmpty() const
+	{
+		return m_vecCut.empty();
+	}
+
+	int Pick() const
+	{
+		int n = number(0, m_vecCut.size() * m_iTotal - 1);
+		int idx = n / m_iTotal;
+		return (n % m_iTotal) < m_vecCut[idx] ? idx : m_vecAlias[idx];
+	}
+
+private:
+	int m_iTotal;
+	std::vector<int> m_vecCut;
+	std::vector<int> m_vecAlias;
+};
+
 class CSpecialItemGroup
 {
 public:
@@ -70,6 +100,7 @@ public:
 			prob += m_vecProbs.back();
 		m_vecProbs.push_back(prob);
 		m_vecItems.push_back(CSpecialItemInfo(vnum, count, rare));
+		m_kAlias.Build(m_vecProbs);
 	}
 
 	bool IsEmpty() const
@@ -111,6 +142,9 @@ public:
 
 	int GetOneIndex() const
 	{
+		if (!m_kAlias.IsEmpty())
+			return m_kAlias.Pick();
+
 		int n = number(1, m_vecProbs.back());
 		itertype(m_vecProbs) it = lower_bound(m_vecProbs.begin(), m_vecProbs.end(), n);
 		return std::distance(m_vecProbs.begin(), it);
@@ -167,6 +201,7 @@ public:
 	BYTE	m_bType;
 	std::vector<int> m_vecProbs;
 	std::vector<CSpecialItemInfo> m_vecItems; // vnum, count
+	CDropAliasTable m_kAlias;
 };
 
 class CMobItemGroup
@@ -206,6 +241,7 @@ public:
 			iPartPct += m_vecProbs.back();
 		m_vecProbs.push_back(iPartPct);
 		m_vecItems.push_back(SMobItemGroupInfo(dwItemVnumStart, dwItemVnumEnd, iCount, iRarePct));
+		m_kAlias.Build(m_vecProbs);
 	}
 
 	// MOB_DROP_ITEM_BUG_FIX
@@ -216,6 +252,9 @@ public:
 
 	int GetOneIndex() const
 	{
+		if (!m_kAlias.IsEmpty())
+			return m_kAlias.Pick();
+
 		int n = number(1, m_vecProbs.back());
 		itertype(m_vecProbs) it = lower_bound(m_vecProbs.begin(), m_vecProbs.end(), n);
 		return std::distance(m_vecProbs.begin(), it);
@@ -243,6 +282,7 @@ private:
 	std::string m_stName;
 	std::vector<int> m_vecProbs;
 	std::vector<SMobItemGroupInfo> m_vecItems;
+	CDropAliasTable m_kAlias;
 };
 
 class CDropItemGroup
@@ -378,6 +418,7 @@ class ITEM_MANAGER : public singleton<ITEM_MANAGER>
 		bool                    Initialize(TItemTable * table, int size);
 		void			Destroy();
 		void			Update();	//   θ.
+		void			DumpItemPoolStat();
 		void			GracefulShutdown();
 
 		DWORD			GetNewID();
@@ -391,6 +432,10 @@ class ITEM_MANAGER : public singleton<ITEM_MANAGER>
 		void			FlushDelayedSave(LPITEM item); // Delayed Ʈ ִٸ  Ѵ.  ó  .
 		void			SaveSingleItem(LPITEM item);
 
+		// ٴ ۸ ̺Ʈ  ʰ     1ʿ   óѴ.
+		void			RegisterGroundExpire(LPITEM item, DWORD dwTime, bool bOwnership);
+		void			UpdateGroundExpire();
+
 		LPITEM                  CreateItem(DWORD vnum, DWORD count = 1, DWORD dwID = 0, bool bTryMagic = false, int iRarePct = -1, bool bSkipSave = false);
 		void DestroyItem(LPITEM item);
 		void			RemoveItem(LPITEM item, const char * c_pszReason=NULL); // ڷ   
@@ -409,6 +454,12 @@ class ITEM_MANAGER : public singleton<ITEM_MANAGER>
 		bool			ReadDropItemGroup(const char * c_pszFileName);
 		bool			ReadMonsterDropItemGroup(const char* c_pszFileName);
 		bool			ReadSpecialDropItemFile(const char* c_pszFileName);
+
+		// special_item_group, mob_drop_item  ٸ 忡 о ΰ ProcessDropTableReload  ٲ ִ´.
+		bool			RequestDropTableReload(const char * c_pszSpecialFileName, const char * c_pszMobFileName, DWORD dwRequesterPID);
+		void			ProcessDropTableReload(bool bWait = false);	//  ޽ θ.
+
+		void			BuildMobDropPlan();
 		
 		// convert name -> vnum special_item_group.txt
 		bool			ConvSpecialDropItemFile();
@@ -429,30 +480,72 @@ class ITEM_MANAGER : public singleton<ITEM_MANAGER>
 		// END_OF_CHECK_UNIQUE_GROUP
 
 	protected:
+		enum
+		{
+			ITEM_VNUM_INDEX_MAX	= 1 << 20,	// ̺  vnum  m_vec_iVnumIndex  ٷ ã´
+		};
+
 		int                     RealNumber(DWORD vnum);
+		TItemTable *		SearchTable(DWORD vnum);
+		void			BuildVnumIndex();
+		void			BenchmarkVnumIndex();
 		void			CreateQuestDropItem(LPCHARACTER pkChr, LPCHARACTER pkKiller, std::vector<LPITEM> & vec_item, int iDeltaPercent, int iRandRange);
 
+		//    ׷. Apply*  ٲ ֱ  ƹ  ʴ´.
+		struct SDropTableSnapshot
+		{
+			std::map<DWORD, CSpecialAttrGroup*>		map_pkSpecialAttrGroup;
+			std::map<DWORD, CSpecialItemGroup*>		map_pkSpecialItemGroup;
+			std::map<DWORD, CSpecialItemGroup*>		map_pkQuestItemGroup;
+			std::map<DWORD, DWORD>				map_dwItemToSpecialGroup;
+			std::vector<DWORD>				vec_dwQuestNPCVnum;	///< Ʈ Ŵ  quest Ÿ ׷ vnum
+
+			std::map<DWORD, std::vector<CMobItemGroup*> >	map_pkMobItemGroup;
+			std::map<DWORD, CDropItemGroup*>		map_pkDropItemGroup;
+			std::map<DWORD, CLevelItemGroup*>		map_pkLevelItemGroup;
+			std::map<DWORD, CBuyerThiefGlovesItemGroup*>	map_pkGloveItemGroup;
+		};
+
+		struct SDropTableReloadJob;
+
+		bool			BuildSpecialDropItemTable(const char * c_pszFileName, SDropTableSnapshot & rkSnapshot);
+		void			ApplySpecialDropItemTable(SDropTableSnapshot & rkSnapshot);
+		bool			BuildMonsterDropItemGroup(const char * c_pszFileName, SDropTableSnapshot & rkSnapshot);
+		void			ApplyMonsterDropItemGroup(SDropTableSnapshot & rkSnapshot);
+
+		static void *		DropTableReloadThread(void * pvJob);
+
 	public:
 		const std::map<DWORD, std::vector<CMobItemGroup*> >& GetMobItemGroupMap() const { return m_map_pkMobItemGroup; }
 		const std::map<DWORD, CDropItemGroup*>& GetDropItemGroupMap() const { return m_map_pkDropItemGroup; }
 		const std::map<DWORD, CLevelItemGroup*>& GetLevelItemGroupMap() const { return m_map_pkLevelItemGroup; }
 
 	protected:
-		typedef std::map<DWORD, LPITEM> ITEM_VID_MAP;		
+		typedef TR1_NS::unordered_map<DWORD, LPITEM> ITEM_VID_MAP;
+		typedef TR1_NS::unordered_map<DWORD, LPITEM> ITEM_ID_MAP;
 
 		std::vector<TItemTable>		m_vec_prototype;
 		std::vector<TItemTable*> m_vec_item_vnum_range_info;
+		std::vector<int>		m_vec_iVnumIndex;	///< vnum -> m_vec_prototype ε (  ,  -1)
 		std::map<DWORD, DWORD>		m_map_ItemRefineFrom;
 		int				m_iTopOfTable;
 
 		ITEM_VID_MAP			m_VIDMap;			///< m_dwVIDCount    Ѵ.
 		DWORD				m_dwVIDCount;			///< ̳༮ VID ƴ϶ ׳ μ  ũ ȣ.
 		DWORD				m_dwCurrentID;
+		DWORD				m_dwItemPoolReuse;		///< Ǯ ٽ   CItem  (DumpItemPoolStat  ʱȭ)
+		DWORD				m_dwItemPoolAlloc;		///<   Ҵ CItem 
+		DWORD				m_dwItemLivePeak;
 		TItemIDRangeTable	m_ItemIDRange;
 		TItemIDRangeTable	m_ItemIDSpareRange;
 
 		TR1_NS::unordered_set<LPITEM> m_set_pkItemForDelayedSave;
-		std::map<DWORD, LPITEM>		m_map_pkItemByID;
+
+		//  ð() -> vid.   ֿų ð ٲ    ɷ.
+		typedef std::map<DWORD, std::vector<DWORD> > TGroundExpireMap;
+		TGroundExpireMap		m_map_vecGroundDestroy;
+		TGroundExpireMap		m_map_vecGroundOwnership;
+		ITEM_ID_MAP			m_map_pkItemByID;
 		std::map<DWORD, DWORD>		m_map_dwEtcItemDropProb;
 		std::map<DWORD, CDropItemGroup*> m_map_pkDropItemGroup;
 		std::map<DWORD, CSpecialItemGroup*> m_map_pkSpecialItemGroup;
@@ -462,6 +555,30 @@ class ITEM_MANAGER : public singleton<ITEM_MANAGER>
 		std::map<DWORD, CLevelItemGroup*> m_map_pkLevelItemGroup;
 		std::map<DWORD, CBuyerThiefGlovesItemGroup*> m_map_pkGloveItemGroup;
 
+		SDropTableReloadJob *		m_pkDropTableReloadJob;	///< ٸ 忡 д   ̺,  NULL
+
+		//   ׷ ͸ ̸ Ƶд. ׷  ٲٴ Read* Լ ٽ .
+		struct SMobDropPlan
+		{
+			CDropItemGroup *			pkDropGroup;
+			const std::vector<CMobItemGroup*> *	pvec_pkMobGroup;
+			CLevelItemGroup *			pkLevelGroup;
+			CBuyerThiefGlovesItemGroup *		pkGloveGroup;
+			DWORD					dwEtcDropVnum;
+			DWORD					dwEtcDropProb;
+		};
+
+		const SMobDropPlan *	GetMobDropPlan(DWORD dwRaceNum) const
+		{
+			if (dwRaceNum >= m_vec_iMobDropPlanIndex.size() || m_vec_iMobDropPlanIndex[dwRaceNum] < 0)
+				return NULL;
+
+			return &m_vec_kMobDropPlan[m_vec_iMobDropPlanIndex[dwRaceNum]];
+		}
+
+		std::vector<SMobDropPlan>	m_vec_kMobDropPlan;
+		std::vector<int>		m_vec_iMobDropPlanIndex;	///< race -> m_vec_kMobDropPlan ε,  -1
+
 		// CHECK_UNIQUE_GROUP
 		std::map<DWORD, int>		m_ItemToSpecialGroup;
 		// END_OF_CHECK_UNIQUE_GROUP
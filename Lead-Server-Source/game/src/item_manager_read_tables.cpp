@@ -185,6 +185,18 @@ bool ITEM_MANAGER::ReadCommonDropItemFile(const char * c_pszFileName)
 }
 
 bool ITEM_MANAGER::ReadSpecialDropItemFile(const char* c_pszFileName)
+{
+	SDropTableSnapshot kSnapshot;
+
+	if (!BuildSpecialDropItemTable(c_pszFileName, kSnapshot))
+		return false;
+
+	ApplySpecialDropItemTable(kSnapshot);
+	return true;
+}
+
+//   ̺ ǵ帮 ʰ rkSnapshot  . ٸ 忡 ҷ ȴ.
+bool ITEM_MANAGER::BuildSpecialDropItemTable(const char* c_pszFileName, SDropTableSnapshot & rkSnapshot)
 {
 	CTextFileLoader loader;
 
@@ -193,10 +205,10 @@ bool ITEM_MANAGER::ReadSpecialDropItemFile(const char* c_pszFileName)
 
 	DeleteMapValues MapCleaner;
 
-	std::map<DWORD, CSpecialAttrGroup*> tempSpecAttr;
-	std::map<DWORD, CSpecialItemGroup*> tempSpecItem;
-	std::map<DWORD, CSpecialItemGroup*> tempSpecItemQuest;
-	std::map<DWORD, DWORD> tempItemToGroupMap;
+	std::map<DWORD, CSpecialAttrGroup*> & tempSpecAttr = rkSnapshot.map_pkSpecialAttrGroup;
+	std::map<DWORD, CSpecialItemGroup*> & tempSpecItem = rkSnapshot.map_pkSpecialItemGroup;
+	std::map<DWORD, CSpecialItemGroup*> & tempSpecItemQuest = rkSnapshot.map_pkQuestItemGroup;
+	std::map<DWORD, DWORD> & tempItemToGroupMap = rkSnapshot.map_dwItemToSpecialGroup;
 
 	std::string stName;
 
@@ -233,7 +245,7 @@ bool ITEM_MANAGER::ReadSpecialDropItemFile(const char* c_pszFileName)
 			else if (stType == "quest")
 			{
 				type = CSpecialItemGroup::QUEST;
-				quest::CQuestManager::instance().RegisterNPCVnum(iVnum);
+				rkSnapshot.vec_dwQuestNPCVnum.push_back(iVnum);
 			}
 			else if (stType == "special")
 			{
@@ -405,20 +417,31 @@ bool ITEM_MANAGER::ReadSpecialDropItemFile(const char* c_pszFileName)
 		}
 	}
 
+	return true;
+}
+
+void ITEM_MANAGER::ApplySpecialDropItemTable(SDropTableSnapshot & rkSnapshot)
+{
+	DeleteMapValues MapCleaner;
+
 	MapCleaner(m_map_pkSpecialItemGroup);
 	MapCleaner(m_map_pkQuestItemGroup);
 	MapCleaner(m_map_pkSpecialAttrGroup);
 
-	m_map_pkSpecialItemGroup = tempSpecItem;
-	m_map_pkQuestItemGroup = tempSpecItemQuest;
-	m_map_pkSpecialAttrGroup = tempSpecAttr;
+	m_map_pkSpecialItemGroup.swap(rkSnapshot.map_pkSpecialItemGroup);
+	m_map_pkQuestItemGroup.swap(rkSnapshot.map_pkQuestItemGroup);
+	m_map_pkSpecialAttrGroup.swap(rkSnapshot.map_pkSpecialAttrGroup);
+
+	for (size_t i = 0; i < rkSnapshot.vec_dwQuestNPCVnum.size(); ++i)
+		quest::CQuestManager::instance().RegisterNPCVnum(rkSnapshot.vec_dwQuestNPCVnum[i]);
 
-	for (std::map<DWORD, DWORD>::iterator it = tempItemToGroupMap.begin(); it != tempItemToGroupMap.end(); ++it)
+	for (std::map<DWORD, DWORD>::iterator it = rkSnapshot.map_dwItemToSpecialGroup.begin(); it != rkSnapshot.map_dwItemToSpecialGroup.end(); ++it)
 	{
 		m_ItemToSpecialGroup[it->first] = it->second;
 	}
 
-	return true;
+	rkSnapshot.vec_dwQuestNPCVnum.clear();
+	rkSnapshot.map_dwItemToSpecialGroup.clear();
 }
 
 bool ITEM_MANAGER::ConvSpecialDropItemFile()
@@ -603,10 +626,23 @@ bool ITEM_MANAGER::ReadEtcDropItemFile(const char* c_pszFileName)
 
 	m_map_dwEtcItemDropProb = tempLoader;
 
+	BuildMobDropPlan();
 	return true;
 }
 
 bool ITEM_MANAGER::ReadMonsterDropItemGroup(const char* c_pszFileName)
+{
+	SDropTableSnapshot kSnapshot;
+
+	if (!BuildMonsterDropItemGroup(c_pszFileName, kSnapshot))
+		return false;
+
+	ApplyMonsterDropItemGroup(kSnapshot);
+	return true;
+}
+
+// BuildSpecialDropItemTable   rkSnapshot  .
+bool ITEM_MANAGER::BuildMonsterDropItemGroup(const char* c_pszFileName, SDropTableSnapshot & rkSnapshot)
 {
 	CTextFileLoader loader;
 
@@ -617,10 +653,10 @@ bool ITEM_MANAGER::ReadMonsterDropItemGroup(const char* c_pszFileName)
 	DeleteVectorMapValues VectorMapCleaner;
 
 	// Temporary containers
-	std::map<DWORD, std::vector<CMobItemGroup*> > tempMobItemGr;
-	std::map<DWORD, CDropItemGroup*> tempDropItemGr;
-	std::map<DWORD, CLevelItemGroup*> tempLevelItemGr;
-	std::map<DWORD, CBuyerThiefGlovesItemGroup*> tempThiefGlovesGr;
+	std::map<DWORD, std::vector<CMobItemGroup*> > & tempMobItemGr = rkSnapshot.map_pkMobItemGroup;
+	std::map<DWORD, CDropItemGroup*> & tempDropItemGr = rkSnapshot.map_pkDropItemGroup;
+	std::map<DWORD, CLevelItemGroup*> & tempLevelItemGr = rkSnapshot.map_pkLevelItemGroup;
+	std::map<DWORD, CBuyerThiefGlovesItemGroup*> & tempThiefGlovesGr = rkSnapshot.map_pkGloveItemGroup;
 
 	for (DWORD i = 0; i < loader.GetChildNodeCount(); ++i)
 	{
@@ -1161,6 +1197,14 @@ bool ITEM_MANAGER::ReadMonsterDropItemGroup(const char* c_pszFileName)
 		loader.SetParentNode();
 	}
 
+	return true;
+}
+
+void ITEM_MANAGER::ApplyMonsterDropItemGroup(SDropTableSnapshot & rkSnapshot)
+{
+	DeleteMapValues MapCleaner;
+	DeleteVectorMapValues VectorMapCleaner;
+
 	{
 		VectorMapCleaner(m_map_pkMobItemGroup);
 		MapCleaner(m_map_pkGloveItemGroup);
@@ -1168,14 +1212,136 @@ bool ITEM_MANAGER::ReadMonsterDropItemGroup(const char* c_pszFileName)
 		MapCleaner(m_map_pkDropItemGroup);
 	}
 
-	m_map_pkGloveItemGroup = tempThiefGlovesGr;
-	m_map_pkLevelItemGroup = tempLevelItemGr;
-	m_map_pkDropItemGroup = tempDropItemGr;
-	m_map_pkMobItemGroup = tempMobItemGr;
+	m_map_pkGloveItemGroup.swap(rkSnapshot.map_pkGloveItemGroup);
+	m_map_pkLevelItemGroup.swap(rkSnapshot.map_pkLevelItemGroup);
+	m_map_pkDropItemGroup.swap(rkSnapshot.map_pkDropItemGroup);
+	m_map_pkMobItemGroup.swap(rkSnapshot.map_pkMobItemGroup);
 
+	BuildMobDropPlan();
+}
+
+struct ITEM_MANAGER::SDropTableReloadJob
+{
+	std::string		stSpecialFileName;
+	std::string		stMobFileName;
+	DWORD			dwRequesterPID;
+
+	SDropTableSnapshot	kSnapshot;
+	bool			bSpecialLoaded;
+	bool			bMobLoaded;
+
+	bool			bDone;
+#ifndef __WIN32__
+	bool			bThread;
+	pthread_t		hThread;
+	pthread_mutex_t		mutex;
+#endif
+};
+
+void * ITEM_MANAGER::DropTableReloadThread(void * pvJob)
+{
+	SDropTableReloadJob * pkJob = (SDropTableReloadJob *) pvJob;
+	ITEM_MANAGER & rkItemMgr = ITEM_MANAGER::instance();
+
+	pkJob->bSpecialLoaded = rkItemMgr.BuildSpecialDropItemTable(pkJob->stSpecialFileName.c_str(), pkJob->kSnapshot);
+	pkJob->bMobLoaded = rkItemMgr.BuildMonsterDropItemGroup(pkJob->stMobFileName.c_str(), pkJob->kSnapshot);
+
+#ifndef __WIN32__
+	pthread_mutex_lock(&pkJob->mutex);
+	pkJob->bDone = true;
+	pthread_mutex_unlock(&pkJob->mutex);
+#else
+	pkJob->bDone = true;
+#endif
+	return NULL;
+}
+
+// д     ̺ ״ . ѹ ϳ .
+bool ITEM_MANAGER::RequestDropTableReload(const char * c_pszSpecialFileName, const char * c_pszMobFileName, DWORD dwRequesterPID)
+{
+	if (m_pkDropTableReloadJob)
+		return false;
+
+	SDropTableReloadJob * pkJob = M2_NEW SDropTableReloadJob;
+
+	pkJob->stSpecialFileName = c_pszSpecialFileName;
+	pkJob->stMobFileName = c_pszMobFileName;
+	pkJob->dwRequesterPID = dwRequesterPID;
+	pkJob->bSpecialLoaded = false;
+	pkJob->bMobLoaded = false;
+	pkJob->bDone = false;
+
+	m_pkDropTableReloadJob = pkJob;
+
+	sys_log(0, "DROP_TABLE_RELOAD start %s %s", c_pszSpecialFileName, c_pszMobFileName);
+
+#ifndef __WIN32__
+	pthread_mutex_init(&pkJob->mutex, NULL);
+	pkJob->bThread = (0 == pthread_create(&pkJob->hThread, NULL, DropTableReloadThread, pkJob));
+
+	if (pkJob->bThread)
+		return true;
+
+	sys_err("cannot create drop table reload thread, reading on this thread");
+#endif
+
+	DropTableReloadThread(pkJob);
 	return true;
 }
 
+void ITEM_MANAGER::ProcessDropTableReload(bool bWait)
+{
+	SDropTableReloadJob * pkJob = m_pkDropTableReloadJob;
+
+	if (!pkJob)
+		return;
+
+#ifndef __WIN32__
+	if (!bWait)
+	{
+		pthread_mutex_lock(&pkJob->mutex);
+		bool bDone = pkJob->bDone;
+		pthread_mutex_unlock(&pkJob->mutex);
+
+		if (!bDone)
+			return;
+	}
+
+	if (pkJob->bThread)
+		pthread_join(pkJob->hThread, NULL);
+
+	pthread_mutex_destroy(&pkJob->mutex);
+#endif
+
+	m_pkDropTableReloadJob = NULL;
+
+	// ޽ ̿ ѹ ٲ Ƿ   ߿ ̺ ٲ ʴ´.
+	if (pkJob->bSpecialLoaded)
+		ApplySpecialDropItemTable(pkJob->kSnapshot);
+
+	if (pkJob->bMobLoaded)
+		ApplyMonsterDropItemGroup(pkJob->kSnapshot);
+
+	sys_log(0, "DROP_TABLE_RELOAD done special %d mob %d", pkJob->bSpecialLoaded, pkJob->bMobLoaded);
+
+	LPCHARACTER ch = CHARACTER_MANAGER::instance().FindByPID(pkJob->dwRequesterPID);
+
+	if (ch)
+	{
+		if (pkJob->bSpecialLoaded)
+			ch->ChatPacket(CHAT_TYPE_INFO, "reload success: SpecialItemGroup: %s", pkJob->stSpecialFileName.c_str());
+		else
+			ch->ChatPacket(CHAT_TYPE_INFO, "failed to reload SpecialItemGroup: %s", pkJob->stSpecialFileName.c_str());
+
+		if (pkJob->bMobLoaded)
+			ch->ChatPacket(CHAT_TYPE_INFO, "reload success: MOBDropItemFile: %s", pkJob->stMobFileName.c_str());
+		else
+			ch->ChatPacket(CHAT_TYPE_INFO, "failed to reload MOBDropItemFile: %s", pkJob->stMobFileName.c_str());
+	}
+
+	M2_DELETE(pkJob);
+}
+
 bool ITEM_MANAGER::ReadDropItemGroup(const char* c_pszFileName)
 {
 	CTextFileLoader loader;
@@ -1301,6 +1467,7 @@ bool ITEM_MANAGER::ReadDropItemGroup(const char* c_pszFileName)
 	MapCleaner(m_map_pkDropItemGroup);
 	m_map_pkDropItemGroup = tempDropItemGr;
 
+	BuildMobDropPlan();
 	return true;
 }
 
@@ -10,7 +10,7 @@
 
 static char	__escape_hint[1024];
 
-LogManager::LogManager() : m_bIsConnect(false)
+LogManager::LogManager() : m_bIsConnect(false), m_dwBatchRows(0), m_dwBatchQueries(0), m_dwDroppedRows(0)
 {
 }
 
@@ -41,6 +41,81 @@ void LogManager::Query(const char * c_pszFormat, ...)
 	m_sql.AsyncQuery(szQuery);
 }
 
+void LogManager::InsertRow(const char * c_pszTable, const char * c_pszColumns, const char * c_pszFormat, ...)
+{
+	char szRow[4096];
+	va_list args;
+
+	va_start(args, c_pszFormat);
+	int len = vsnprintf(szRow, sizeof(szRow), c_pszFormat, args);
+	va_end(args);
+
+	if (len < 0 || len >= (int) sizeof(szRow))
+	{
+		sys_err("LOG: row too long (table %s)", c_pszTable);
+		return;
+	}
+
+	// α DB з   ޸𸮰   ʵ .
+	if (g_iLogQueueLimit > 0 && m_sql.CountQuery() >= (DWORD) g_iLogQueueLimit)
+	{
+		++m_dwDroppedRows;
+		return;
+	}
+
+	std::string stKey(c_pszTable);
+	stKey += c_pszColumns;
+
+	TRowBuffer & rBuf = m_map_rowBuffer[stKey];
+
+	if (rBuf.iRowCount == 0)
+	{
+		char szInsert[512];
+		snprintf(szInsert, sizeof(szInsert), "INSERT INTO %s%s %s VALUES", c_pszTable, get_table_postfix(), c_pszColumns);
+		rBuf.stQuery = szInsert;
+	}
+	else
+		rBuf.stQuery += ",";
+
+	rBuf.stQuery.append(szRow, len);
+
+	if (test_server)
+		sys_log(0, "LOG: %s%s %s", c_pszTable, get_table_postfix(), szRow);
+
+	if (++rBuf.iRowCount >= g_iLogBatchRows || rBuf.stQuery.size() >= LOG_BATCH_MAX_LEN)
+		FlushRows(rBuf);
+}
+
+void LogManager::FlushRows(TRowBuffer & rBuf)
+{
+	if (rBuf.iRowCount == 0)
+		return;
+
+	m_sql.AsyncQuery(rBuf.stQuery.c_str());
+
+	m_dwBatchRows += rBuf.iRowCount;
+	++m_dwBatchQueries;
+
+	rBuf.stQuery.clear();
+	rBuf.iRowCount = 0;
+}
+
+void LogManager::Flush()
+{
+	for (itertype(m_map_rowBuffer) it = m_map_rowBuffer.begin(); it != m_map_rowBuffer.end(); ++it)
+		FlushRows(it->second);
+}
+
+void LogManager::DumpBatchStat()
+{
+	sys_log(0, "LOG_BATCH_STAT: rows %u queries %u dropped %u queue %u",
+			m_dwBatchRows, m_dwBatchQueries, m_dwDroppedRows, m_sql.CountQuery());
+
+	m_dwBatchRows = 0;
+	m_dwBatchQueries = 0;
+	m_dwDroppedRows = 0;
+}
+
 bool LogManager::IsConnected()
 {
 	return m_bIsConnect;
@@ -50,8 +125,8 @@ void LogManager::ItemLog(DWORD dwPID, DWORD x, DWORD y, DWORD dwItemID, const ch
 {
 	m_sql.EscapeString(__escape_hint, sizeof(__escape_hint), c_pszHint, strlen(c_pszHint));
 
-	Query("INSERT DELAYED INTO log%s (type, time, who, x, y, what, how, hint, ip, vnum) VALUES('ITEM', NOW(), %u, %u, %u, %u, '%s', '%s', '%s', %u)",
-			get_table_postfix(), dwPID, x, y, dwItemID, c_pszText, __escape_hint, c_pszIP, dwVnum);
+	InsertRow("log", "(type, time, who, x, y, what, how, hint, ip, vnum)", "('ITEM', NOW(), %u, %u, %u, %u, '%s', '%s', '%s', %u)",
+			dwPID, x, y, dwItemID, c_pszText, __escape_hint, c_pszIP, dwVnum);
 }
 
 void LogManager::ItemLog(LPCHARACTER ch, LPITEM item, const char * c_pszText, const char * c_pszHint)
@@ -77,8 +152,8 @@ void LogManager::CharLog(DWORD dwPID, DWORD x, DWORD y, DWORD dwValue, const cha
 {
 	m_sql.EscapeString(__escape_hint, sizeof(__escape_hint), c_pszHint, strlen(c_pszHint));
 
-	Query("INSERT DELAYED INTO log%s (type, time, who, x, y, what, how, hint, ip) VALUES('CHARACTER', NOW(), %u, %u, %u, %u, '%s', '%s', '%s')",
-			get_table_postfix(), dwPID, x, y, dwValue, c_pszText, __escape_hint, c_pszIP);
+	InsertRow("log", "(type, time, who, x, y, what, how, hint, ip)", "('CHARACTER', NOW(), %u, %u, %u, %u, '%s', '%s', '%s')",
+			dwPID, x, y, dwValue, c_pszText, __escape_hint, c_pszIP);
 }
 
 void LogManager::CharLog(LPCHARACTER ch, DWORD dw, const char * c_pszText, const char * c_pszHint)
@@ -91,8 +166,8 @@ void LogManager::CharLog(LPCHARACTER ch, DWORD dw, const char * c_pszText, const
 
 void LogManager::LoginLog(bool isLogin, DWORD dwAccountID, DWORD dwPID, BYTE bLevel, BYTE bJob, DWORD dwPlayTime)
 {
-	Query("INSERT DELAYED INTO loginlog%s (type, time, channel, account_id, pid, level, job, playtime) VALUES (%s, NOW(), %d, %u, %u, %d, %d, %u)",
-			get_table_postfix(), isLogin ? "'LOGIN'" : "'LOGOUT'", g_bChannel, dwAccountID, dwPID, bLevel, bJob, dwPlayTime);
+	InsertRow("loginlog", "(type, time, channel, account_id, pid, level, job, playtime)", "(%s, NOW(), %d, %u, %u, %d, %d, %u)",
+			isLogin ? "'LOGIN'" : "'LOGOUT'", g_bChannel, dwAccountID, dwPID, bLevel, bJob, dwPlayTime);
 }
 
 void LogManager::MoneyLog(BYTE type, DWORD vnum, int gold)
@@ -103,7 +178,7 @@ void LogManager::MoneyLog(BYTE type, DWORD vnum, int gold)
 		return;
 	}
 
-	Query("INSERT DELAYED INTO money_log%s VALUES (NOW(), %d, %d, %d)", get_table_postfix(), type, vnum, gold);
+	InsertRow("money_log", "", "(NOW(), %d, %d, %d)", type, vnum, gold);
 }
 
 void LogManager::HackLog(const char * c_pszHackName, const char * c_pszLogin, const char * c_pszName, const char * c_pszIP)
@@ -168,15 +243,15 @@ void LogManager::GoldBarLog(DWORD dwPID, DWORD dwItemID, GOLDBAR_HOW eHow, const
 			break;
 	}
 	
-	Query("INSERT DELAYED INTO goldlog%s (date, time, pid, what, how, hint) VALUES(CURDATE(), CURTIME(), %u, %u, %s, '%s')", 
-			get_table_postfix(), dwPID, dwItemID, szHow, c_pszHint);
+	InsertRow("goldlog", "(date, time, pid, what, how, hint)", "(CURDATE(), CURTIME(), %u, %u, %s, '%s')",
+			dwPID, dwItemID, szHow, c_pszHint);
 }
 
 void LogManager::CubeLog(DWORD dwPID, DWORD x, DWORD y, DWORD item_vnum, DWORD item_uid, int item_count, bool success)
 {
-	Query("INSERT DELAYED INTO cube%s (pid, time, x, y, item_vnum, item_uid, item_count, success) "
-			"VALUES(%u, NOW(), %u, %u, %u, %u, %d, %d)",
-			get_table_postfix(), dwPID, x, y, item_vnum, item_uid, item_count, success?1:0);
+	InsertRow("cube", "(pid, time, x, y, item_vnum, item_uid, item_count, success)",
+			"(%u, NOW(), %u, %u, %u, %u, %d, %d)",
+			dwPID, x, y, item_vnum, item_uid, item_count, success?1:0);
 }
 
 void LogManager::SpeedHackLog(DWORD pid, DWORD x, DWORD y, int hack_count)
@@ -188,26 +263,26 @@ void LogManager::SpeedHackLog(DWORD pid, DWORD x, DWORD y, int hack_count)
 
 void LogManager::ChangeNameLog(DWORD pid, const char *old_name, const char *new_name, const char *ip)
 {
-	Query("INSERT DELAYED INTO change_name%s (pid, old_name, new_name, time, ip) "
-			"VALUES(%u, '%s', '%s', NOW(), '%s') ",
-			get_table_postfix(), pid, old_name, new_name, ip);
+	InsertRow("change_name", "(pid, old_name, new_name, time, ip)",
+			"(%u, '%s', '%s', NOW(), '%s')",
+			pid, old_name, new_name, ip);
 }
 
 void LogManager::GMCommandLog(DWORD dwPID, const char* szName, const char* szIP, BYTE byChannel, const char* szCommand)
 {
 	m_sql.EscapeString(__escape_hint, sizeof(__escape_hint), szCommand, strlen(szCommand));
 
-	Query("INSERT DELAYED INTO command_log%s (userid, server, ip, port, username, command, date ) "
-			"VALUES(%u, 999, '%s', %u, '%s', '%s', NOW()) ",
-			get_table_postfix(), dwPID, szIP, byChannel, szName, __escape_hint);
+	InsertRow("command_log", "(userid, server, ip, port, username, command, date)",
+			"(%u, 999, '%s', %u, '%s', '%s', NOW())",
+			dwPID, szIP, byChannel, szName, __escape_hint);
 }
 
 void LogManager::RefineLog(DWORD pid, const char* item_name, DWORD item_id, int item_refine_level, int is_success, const char* how)
 {
 	m_sql.EscapeString(__escape_hint, sizeof(__escape_hint), item_name, strlen(item_name));
 
-	Query("INSERT INTO refinelog%s (pid, item_name, item_id, step, time, is_success, setType) VALUES(%u, '%s', %u, %d, NOW(), %d, '%s')",
-			get_table_postfix(), pid, __escape_hint, item_id, item_refine_level, is_success, how);
+	InsertRow("refinelog", "(pid, item_name, item_id, step, time, is_success, setType)", "(%u, '%s', %u, %d, NOW(), %d, '%s')",
+			pid, __escape_hint, item_id, item_refine_level, is_success, how);
 }
 
 
@@ -239,8 +314,7 @@ void LogManager::BootLog(const char * c_pszHostName, BYTE bChannel)
 
 void LogManager::FishLog(DWORD dwPID, int prob_idx, int fish_id, int fish_level, DWORD dwMiliseconds, DWORD dwVnum, DWORD dwValue)
 {
-	Query("INSERT INTO fish_log%s VALUES(NOW(), %u, %d, %u, %d, %u, %u, %u)",
-			get_table_postfix(),
+	InsertRow("fish_log", "", "(NOW(), %u, %d, %u, %d, %u, %u, %u)",
 			dwPID,
 			prob_idx,
 			fish_id,
@@ -252,8 +326,7 @@ void LogManager::FishLog(DWORD dwPID, int prob_idx, int fish_id, int fish_level,
 
 void LogManager::QuestRewardLog(const char * c_pszQuestName, DWORD dwPID, DWORD dwLevel, int iValue1, int iValue2)
 {
-	Query("INSERT INTO quest_reward_log%s VALUES('%s',%u,%u,2,%u,%u,NOW())", 
-			get_table_postfix(), 
+	InsertRow("quest_reward_log", "", "('%s',%u,%u,2,%u,%u,NOW())",
 			c_pszQuestName,
 			dwPID,
 			dwLevel,
@@ -21,6 +21,8 @@ class LogManager : public singleton<LogManager>
 		virtual ~LogManager();
 
 		bool		IsConnected();
+		DWORD		CountQuery()		{ return m_sql.CountQuery(); }
+		DWORD		CountQueryResult()	{ return m_sql.CountResult(); }
 
 		bool		Connect(const char * host, const int port, const char * user, const char * pwd, const char * db);
 
@@ -50,11 +52,40 @@ class LogManager : public singleton<LogManager>
 		void		DetailLoginLog(bool isLogin, LPCHARACTER ch);
 		void		DragonSlayLog(DWORD dwGuildID, DWORD dwDragonVnum, DWORD dwStartTime, DWORD dwEndTime);
 
+		//   α   INSERT Ѵ.  , ׸   θ.
+		void		Flush();
+		void		DumpBatchStat();
+
 	private:
+		enum
+		{
+			LOG_BATCH_MAX_LEN = 60000,	// max_allowed_packet  ۰
+		};
+
+		struct TRowBuffer
+		{
+			std::string	stQuery;
+			int		iRowCount;
+
+			TRowBuffer() : iRowCount(0)
+			{
+			}
+		};
+
 		void		Query(const char * c_pszFormat, ...);
 
+		//  ̺/÷    ¥ INSERT ϳ .
+		void		InsertRow(const char * c_pszTable, const char * c_pszColumns, const char * c_pszFormat, ...);
+		void		FlushRows(TRowBuffer & rBuf);
+
 		CAsyncSQL	m_sql;
 		bool		m_bIsConnect;
+
+		std::map<std::string, TRowBuffer>	m_map_rowBuffer;
+
+		DWORD		m_dwBatchRows;
+		DWORD		m_dwBatchQueries;
+		DWORD		m_dwDroppedRows;
 };
 
 #endif
@@ -50,6 +50,11 @@
 #include "spam.h"
 #include "DragonLair.h"
 #include "skill_power.h"
+#include "path_finder.h"
+#include "pulse_stat.h"
+#include "mem_stat.h"
+#include "packet_capture.h"
+#include "ip_ban.h"
 #include "DragonSoul.h"
 #include <boost/bind.hpp>
 
@@ -76,10 +81,13 @@ socket_t	p2p_socket = 0;
 LPFDWATCH	main_fdw = NULL;
 
 int		io_loop(LPFDWATCH fdw);
+int		io_poll(LPFDWATCH fdw, struct timeval * timeout);
+static void	io_wait(struct timeval * timeout);
 
 int		start(int argc, char **argv);
 int		idle();
 void	destroy();
+void	RegisterMetrics();
 
 void 	test();
 
@@ -185,26 +193,34 @@ unsigned int save_idx = 0;
 void heartbeat(LPHEART ht, int pulse) 
 {
 	DWORD t;
+	DWORD dwUSec = pulse_stat_usec();
 
 	t = get_dword_time();
+	PROF_SCOPE(puEvent, "event");
 	num_events_called += event_process(pulse);
+	regen_process_pending();
+	puEvent.Pop();
 	s_dwProfiler[PROF_EVENT] += (get_dword_time() - t);
 
+	{
+		DWORD dwNow = pulse_stat_usec();
+		pulse_stat_record(PULSE_STAT_EVENT, dwNow - dwUSec);
+		dwUSec = dwNow;
+	}
+
 	t = get_dword_time();
+	PROF_SCOPE(puHeartbeat, "heartbeat");
+
+	// ٸ 忡 ٽ   ̺  ⼭ ٲ ִ´.
+	ITEM_MANAGER::instance().ProcessDropTableReload();
 
 	// 1ʸ
 	if (!(pulse % ht->passes_per_sec))
 	{
-		if (!g_bAuthServer)
-		{
-			TPlayerCountPacket pack;
-			pack.dwCount = DESC_MANAGER::instance().GetLocalUserCount();
-			db_clientdesc->DBPacket(HEADER_GD_PLAYER_COUNT, 0, &pack, sizeof(TPlayerCountPacket));
-		}
-		else
-		{
+		if (g_bAuthServer)
 			DESC_MANAGER::instance().ProcessExpiredLoginKey();
-		}
+		else
+			ITEM_MANAGER::instance().UpdateGroundExpire();
 
 		{
 			int count = 0;
@@ -218,6 +234,9 @@ void heartbeat(LPHEART ht, int pulse)
 				sys_log(0, "SAVE_FLUSH %d", count);
 			}
 		}
+
+		LogManager::instance().Flush();
+		DESC_MANAGER::instance().UpdateTraffic();
 	}
 
 	//
@@ -233,13 +252,54 @@ void heartbeat(LPHEART ht, int pulse)
 	{
 		ITEM_MANAGER::instance().Update();
 		DESC_MANAGER::instance().UpdateLocalUserCount();
+
+		// ٸ ھ   db   HEADER_DG_CLUSTER_STATE   ش.
+		if (!g_bAuthServer)
+			DESC_MANAGER::instance().ReportUserCount();
 	}
 
+	//  1и  ʴ buffer ش. 10и 踦 .
+	if (!(pulse % (passes_per_sec * 60 + 3)))
+	{
+		if (!(pulse % ((passes_per_sec * 60 + 3) * 10)))
+		{
+			buffer_pool_dump();
+			DESC_MANAGER::instance().DumpCompressStat();
+			DESC_MANAGER::instance().DumpBulkMoveStat();
+			DESC_MANAGER::instance().DumpBulkPointStat();
+			DESC_MANAGER::instance().DumpBulkDamageStat();
+			DESC_MANAGER::instance().DumpBulkCharacterAddStat();
+			DESC_MANAGER::instance().LogDescTraffic(NULL, 20);
+			DESC_MANAGER::instance().LogOutputPacketStat(NULL, 0);
+			mem_stat_print(NULL);
+			CInputProcessor::LogPacketStat();
+			CInputProcessor::ResetPacketStat();
+			P2P_MANAGER::instance().LogBatchStat();
+			LogManager::instance().DumpBatchStat();
+			quest::DumpScriptCacheStat();
+			quest::CQuestManager::instance().DumpGCStat();
+			quest::CQuestManager::instance().DumpThreadPoolStat();
+			ITEM_MANAGER::instance().DumpItemPoolStat();
+			CHARACTER_MANAGER::instance().DumpCharacterPoolStat();
+			CPathFinder::instance().DumpStat();
+			regen_dump_stat();
+			event_log_func_stat();
+		}
+
+		buffer_pool_trim();
+		ExpireLoginToken(get_dword_time());
+	}
+
+	puHeartbeat.Pop();
 	s_dwProfiler[PROF_HEARTBEAT] += (get_dword_time() - t);
 
+	PROF_SCOPE(puDBProcess, "db_process");
 	DBManager::instance().Process();
 	AccountDB::instance().Process();
 	CPVPManager::instance().Process();
+	puDBProcess.Pop();
+
+	pulse_stat_record(PULSE_STAT_HEARTBEAT, pulse_stat_usec() - dwUSec);
 
 	if (g_bShutdown)
 	{
@@ -281,6 +341,7 @@ int main(int argc, char **argv)
 	CSkillManager	skill_manager;
 	CPVPManager		pvp_manager;
 	LZOManager		lzo_manager;
+	CPathFinder		path_finder;
 	DBManager		db_manager;
 	AccountDB 		account_db;
 
@@ -335,6 +396,8 @@ int main(int argc, char **argv)
 	Blend_Item_init();
 	ani_init();
 
+	RegisterMetrics();
+
 	while (idle());
 
 	sys_log(0, "<shutdown> Starting...");
@@ -393,6 +456,9 @@ int main(int argc, char **argv)
 	sys_log(0, "<shutdown> Destroying building::CManager...");
 	building_manager.Destroy();
 
+	sys_log(0, "<shutdown> Flushing LogManager...");
+	log_manager.Flush();
+
 	destroy();
 
 	return 1;
@@ -502,7 +568,7 @@ int start(int argc, char **argv)
 	
 	main_fdw = fdwatch_new(4096);
 
-	if ((tcp_socket = socket_tcp_bind(g_szPublicIP, mother_port)) == INVALID_SOCKET)
+	if ((tcp_socket = socket_tcp_bind_ex(g_szPublicIP, mother_port, g_iListenBacklog, g_bReusePort)) == INVALID_SOCKET)
 	{
 		perror("socket_tcp_bind: tcp_socket");
 		return 0;
@@ -521,13 +587,14 @@ int start(int argc, char **argv)
 	fdwatch_add_fd(main_fdw, tcp_socket, NULL, FDW_READ, false);
 	fdwatch_add_fd(main_fdw, p2p_socket, NULL, FDW_READ, false);
 
+	heart_set_wait(thecore_heart, io_wait);
+
 	db_clientdesc = DESC_MANAGER::instance().CreateConnectionDesc(main_fdw, db_addr, db_port, PHASE_DBCLIENT, true);
-	if (!g_bAuthServer) {
-		db_clientdesc->UpdateChannelStatus(0, true);
-	}
 
 	if (g_bAuthServer)
 	{
+		DBManager::instance().SetupAuthSQLPool(g_iAuthSQLPoolSize);
+
 		if (g_stAuthMasterIP.length() != 0)
 		{
 			fprintf(stderr, "SlaveAuth");
@@ -554,6 +621,9 @@ int start(int argc, char **argv)
 		LoadSpamDB();
 	}
 
+	if (!g_stPacketCaptureFile.empty())
+		packet_capture_open(g_stPacketCaptureFile.c_str());
+
 	signal_timer_enable(30);
 	return 1;
 }
@@ -566,6 +636,12 @@ void destroy()
 	sys_log(0, "<shutdown> regen_free()...");
 	regen_free();
 
+	sys_log(0, "<shutdown> metrics_destroy()...");
+	metrics_destroy();
+
+	sys_log(0, "<shutdown> packet_capture_close()...");
+	packet_capture_close();
+
 	sys_log(0, "<shutdown> Closing sockets...");
 	socket_close(tcp_socket);
 	socket_close(p2p_socket);
@@ -600,6 +676,12 @@ int idle()
 	assert(passed_pulses > 0);
 
 	DWORD t;
+	DWORD dwLoopUSec = pulse_stat_usec();
+	DWORD dwUSec;
+
+	pulse_stat_record_passed(passed_pulses);
+
+	PROF_SCOPE(puIdle, "idle");
 
 	while (passed_pulses--) {
 		heartbeat(thecore_heart, ++thecore_heart->pulse);
@@ -609,33 +691,69 @@ int idle()
 	}
 
 	t = get_dword_time();
+	dwUSec = pulse_stat_usec();
+	PROF_SCOPE(puChrUpdate, "chr_update");
 	CHARACTER_MANAGER::instance().Update(thecore_heart->pulse);
 	db_clientdesc->Update(t);
+	puChrUpdate.Pop();
 	s_dwProfiler[PROF_CHR_UPDATE] += (get_dword_time() - t);
+	pulse_stat_record(PULSE_STAT_CHR_UPDATE, pulse_stat_usec() - dwUSec);
 
 	t = get_dword_time();
+	dwUSec = pulse_stat_usec();
+	PROF_SCOPE(puIO, "io_loop");
 	if (!io_loop(main_fdw)) return 0;
+	puIO.Pop();
+	PROF_SCOPE(puFlush, "flush");
+	MessengerManager::instance().FlushStatus();
+	CShopManager::instance().FlushUpdateItem();
+	P2P_MANAGER::instance().FlushBatch();
+	DESC_MANAGER::instance().FlushShout();
+	DESC_MANAGER::instance().FlushRequested();
+	puFlush.Pop();
+	puIdle.Pop();
 	s_dwProfiler[PROF_IO] += (get_dword_time() - t);
 
+	{
+		DWORD dwNow = pulse_stat_usec();
+		pulse_stat_record(PULSE_STAT_IO, dwNow - dwUSec);
+		pulse_stat_record(PULSE_STAT_IDLE_LOOP, dwNow - dwLoopUSec);
+	}
+
 	log_rotate();
 
 	gettimeofday(&now, (struct timezone *) 0);
 	++process_time_count;
 
+	// ̹ ޽  ð ˳ϸ Ʈ lua GC  Ѵ.
+	{
+		long lElapsed = (now.tv_sec - thecore_heart->last_time.tv_sec) * 1000000L + (now.tv_usec - thecore_heart->last_time.tv_usec);
+		quest::CQuestManager::instance().CollectGarbageIdle(thecore_heart->opt_time.tv_usec - lElapsed);
+	}
+
 	if (now.tv_sec - pta.tv_sec > 0)
 	{
-		pt_log("[%3d] event %5d/%-5d idle %-4ld event %-4ld heartbeat %-4ld I/O %-4ld chrUpate %-4ld | WRITE: %-7d | PULSE: %d",
+		TEventPoolStat pool;
+		event_get_pool_stat(pool);
+
+		pt_log("[%3d] event %5d/%-5d peak %-4d idle %-4ld event %-4ld heartbeat %-4ld I/O %-4ld chrUpate %-4ld | WRITE: %-7d | POOL: ev %u/%u info %u/%u | PULSE: %d",
 				process_time_count,
 				num_events_called,
 				event_count(),
+				event_fired_peak(),
 				thecore_profiler[PF_IDLE],
 				s_dwProfiler[PROF_EVENT],
 				s_dwProfiler[PROF_HEARTBEAT],
 				s_dwProfiler[PROF_IO],
 				s_dwProfiler[PROF_CHR_UPDATE],
 				current_bytes_written,
+				(unsigned int) pool.event_used, (unsigned int) pool.event_free,
+				(unsigned int) pool.info_used, (unsigned int) pool.info_free,
 				thecore_pulse());
 
+		mem_stat_update();
+		metrics_update();
+
 		num_events_called = 0;
 		current_bytes_written = 0;
 
@@ -644,6 +762,8 @@ int idle()
 
 		memset(&thecore_profiler[0], 0, sizeof(thecore_profiler));
 		memset(&s_dwProfiler[0], 0, sizeof(s_dwProfiler));
+
+		pulse_stat_update();
 	}
 
 #ifdef __WIN32__
@@ -662,17 +782,76 @@ int idle()
 	return 1;
 }
 
-int io_loop(LPFDWATCH fdw)
+static double metric_local_users()	{ return DESC_MANAGER::instance().GetLocalUserCount(); }
+static double metric_client_desc()	{ return DESC_MANAGER::instance().GetClientSet().size(); }
+static double metric_bytes_written()	{ return (unsigned int) total_bytes_written; }
+static double metric_event_count()	{ return event_count(); }
+static double metric_event_pool_used()	{ TEventPoolStat pool; event_get_pool_stat(pool); return pool.event_used; }
+static double metric_sql_player_query()	{ return DBManager::instance().CountQuery(); }
+static double metric_sql_player_result()	{ return DBManager::instance().CountQueryResult(); }
+static double metric_sql_log_query()	{ return LogManager::instance().CountQuery(); }
+static double metric_sql_log_result()	{ return LogManager::instance().CountQueryResult(); }
+
+//  Ʈ  ġ Ѵ.   metrics_update  д´.
+void RegisterMetrics()
 {
-	LPDESC	d;
-	int		num_events, event_idx;
+	metrics_func(METRIC_GAUGE, "game_local_users", "users on this core", metric_local_users);
+	metrics_func(METRIC_GAUGE, "game_client_desc", "client connections", metric_client_desc);
+	metrics_func(METRIC_COUNTER, "game_bytes_written_total", "bytes written to clients", metric_bytes_written);
+	metrics_func(METRIC_GAUGE, "game_events", "queued events", metric_event_count);
+	metrics_func(METRIC_GAUGE, "game_event_pool_used", "event objects in use", metric_event_pool_used);
+	metrics_func(METRIC_GAUGE, "game_sql_queue{db=\"player\"}", "async sql queries waiting", metric_sql_player_query);
+	metrics_func(METRIC_GAUGE, "game_sql_queue{db=\"log\"}", "async sql queries waiting", metric_sql_log_query);
+	metrics_func(METRIC_GAUGE, "game_sql_result{db=\"player\"}", "async sql results not yet handled", metric_sql_player_result);
+	metrics_func(METRIC_GAUGE, "game_sql_result{db=\"log\"}", "async sql results not yet handled", metric_sql_log_result);
+	pulse_stat_register_metrics();
+	mem_stat_register_metrics();
+
+	if (!g_iMetricsPort)
+		return;
+
+	// adminpage_ip    ޴´.
+	metrics_allow_ip("127.0.0.1");
+
+	for (itertype(g_stAdminPageIP) it = g_stAdminPageIP.begin(); it != g_stAdminPageIP.end(); ++it)
+		metrics_allow_ip(it->c_str());
+
+	metrics_listen(g_stMetricsIP.c_str(), g_iMetricsPort);
+}
+
+//  pulse   ð  fdwatch  ٸ鼭   д´.
+//  Ŷ ٷ óǰ, ׿   pulse  FlushRequested  .
+static void io_wait(struct timeval * timeout)
+{
+	if (io_poll(main_fdw, timeout) < 0)
+	{
+		thecore_sleep(timeout);
+		return;
+	}
+
+	//    θ EOF ̺Ʈ  ö  ð  굷.
+	DESC_MANAGER::instance().DestroyClosed();
+}
 
+int io_loop(LPFDWATCH fdw)
+{
 	DESC_MANAGER::instance().DestroyClosed(); // PHASE_CLOSE ӵ ش.
 	DESC_MANAGER::instance().TryConnect();
 
-	if ((num_events = fdwatch(fdw, 0)) < 0)
+	if (io_poll(fdw, NULL) < 0)
 		return 0;
 
+	return 1;
+}
+
+int io_poll(LPFDWATCH fdw, struct timeval * timeout)
+{
+	LPDESC	d;
+	int		num_events, event_idx;
+
+	if ((num_events = fdwatch(fdw, timeout)) < 0)
+		return -1;
+
 	for (event_idx = 0; event_idx < num_events; ++event_idx)
 	{
 		d = (LPDESC) fdwatch_get_client_data(fdw, event_idx);
@@ -752,6 +931,6 @@ int io_loop(LPFDWATCH fdw)
 		}
 	}
 
-	return 1;
+	return num_events;
 }
 
@@ -0,0 +1,99 @@
+#include "stdafx.h"
+#include "utils.h"
+#include "char.h"
+#include "item.h"
+#include "event_queue.h"
+#include "questmanager.h"
+#include "mem_stat.h"
+
+TMemStat	g_akMemStat[MEM_TAG_MAX_NUM];
+
+static const char * s_apszMemTagName[MEM_TAG_MAX_NUM] =
+{
+	"character",
+	"item",
+	"sectree",
+	"event",
+	"quest",
+	"buffer",
+	"cache",
+};
+
+static LPMETRIC	s_apkMemMetric[MEM_TAG_MAX_NUM];
+
+const char * mem_stat_name(int iTag)
+{
+	if (iTag < 0 || iTag >= MEM_TAG_MAX_NUM)
+		return "unknown";
+
+	return s_apszMemTagName[iTag];
+}
+
+void mem_stat_update()
+{
+	lua_State * L = quest::CQuestManager::instance().GetLuaState();
+
+	if (L)
+		mem_stat_set(MEM_TAG_QUEST, (size_t) lua_getgccount(L) * 1024);
+
+	size_t used, pooled;
+	buffer_pool_get_bytes(&used, &pooled);
+	mem_stat_set(MEM_TAG_BUFFER, used);
+	g_akMemStat[MEM_TAG_BUFFER].pooled = pooled;
+
+	g_akMemStat[MEM_TAG_CHARACTER].pooled = CHARACTER::GetFreeBlockCount() * sizeof(CHARACTER);
+	g_akMemStat[MEM_TAG_ITEM].pooled = CItem::GetFreeBlockCount() * sizeof(CItem);
+
+	TEventPoolStat pool;
+	event_get_pool_stat(pool);
+	g_akMemStat[MEM_TAG_EVENT].pooled = pool.event_free * sizeof(event) + pool.element_free * sizeof(TQueueElement);
+
+	for (int i = 0; i < MEM_TAG_MAX_NUM; ++i)
+		if (s_apkMemMetric[i])
+			metrics_set(s_apkMemMetric[i], (double) g_akMemStat[i].current);
+}
+
+void mem_stat_reset_peak()
+{
+	for (int i = 0; i < MEM_TAG_MAX_NUM; ++i)
+		g_akMemStat[i].peak = g_akMemStat[i].current;
+}
+
+void mem_stat_print(LPCHARACTER ch)
+{
+	size_t total = 0;
+
+	for (int i = 0; i < MEM_TAG_MAX_NUM; ++i)
+	{
+		const TMemStat & r = g_akMemStat[i];
+
+		char szLine[256];
+		snprintf(szLine, sizeof(szLine), "%-10s current %8uKB peak %8uKB pooled %7uKB alloc %u free %u",
+				s_apszMemTagName[i],
+				(unsigned int) (r.current >> 10), (unsigned int) (r.peak >> 10), (unsigned int) (r.pooled >> 10),
+				r.alloc_count, r.free_count);
+
+		total += r.current + r.pooled;
+
+		if (ch)
+			ch->ChatPacket(CHAT_TYPE_INFO, "%s", szLine);
+		else
+			sys_log(0, "MEM_STAT: %s", szLine);
+	}
+
+	if (ch)
+		ch->ChatPacket(CHAT_TYPE_INFO, "total %uKB", (unsigned int) (total >> 10));
+	else
+		sys_log(0, "MEM_STAT: total %uKB", (unsigned int) (total >> 10));
+}
+
+void mem_stat_register_metrics()
+{
+	char szName[128];
+
+	for (int i = 0; i < MEM_TAG_MAX_NUM; ++i)
+	{
+		snprintf(szName, sizeof(szName), "game_memory_bytes{tag=\"%s\"}", s_apszMemTagName[i]);
+		s_apkMemMetric[i] = metrics_gauge(szName, "live bytes per subsystem");
+	}
+}
@@ -0,0 +1,73 @@
+#ifndef __INC_METIN_II_GAME_MEM_STAT_H__
+#define __INC_METIN_II_GAME_MEM_STAT_H__
+
+//
+// ýۺ ޸ 뷮 (, ִ).
+// ü Ҵ  ٷ . ObjectAllocator  ±׸ ָ operator new/delete 
+//   ֹǷ ϱ   ̴.  忡 θ.
+// quest VM  buffer ó ̺귯  ִ  mem_stat_update   о ´.
+//
+// ü ũ⸸ Ƿ ü   STL ̳   ʴ´.
+//  þ ±׸ ã 뵵̴.
+//
+enum EMemTag
+{
+	MEM_TAG_NONE = -1,
+	MEM_TAG_CHARACTER,	// CHARACTER
+	MEM_TAG_ITEM,		// CItem
+	MEM_TAG_SECTREE,	// SECTREE_MAP::GetMemorySize (Ʈ, Ӽ, ã span)
+	MEM_TAG_EVENT,		// event, ť , event info
+	MEM_TAG_QUEST,		// lua   ޸
+	MEM_TAG_BUFFER,		// libthecore buffer
+	MEM_TAG_CACHE,		//  ,   Ŷ ĳ
+	MEM_TAG_MAX_NUM
+};
+
+typedef struct SMemStat
+{
+	size_t	current;
+	size_t	peak;		// mem_stat_reset_peak 
+	size_t	pooled;		//  pool  ܵ Ʈ (mem_stat_update  )
+	DWORD	alloc_count;
+	DWORD	free_count;
+} TMemStat;
+
+extern TMemStat	g_akMemStat[MEM_TAG_MAX_NUM];
+
+inline void mem_stat_alloc(int iTag, size_t size)
+{
+	TMemStat & r = g_akMemStat[iTag];
+
+	r.current += size;
+	++r.alloc_count;
+
+	if (r.current > r.peak)
+		r.peak = r.current;
+}
+
+inline void mem_stat_free(int iTag, size_t size)
+{
+	TMemStat & r = g_akMemStat[iTag];
+
+	r.current = r.current > size ? r.current - size : 0;
+	++r.free_count;
+}
+
+// ̺귯   ° ٲ۴.
+inline void mem_stat_set(int iTag, size_t size)
+{
+	TMemStat & r = g_akMemStat[iTag];
+
+	r.current = size;
+
+	if (r.current > r.peak)
+		r.peak = r.current;
+}
+
+extern const char *	mem_stat_name(int iTag);
+extern void		mem_stat_update();		// 
+extern void		mem_stat_reset_peak();
+extern void		mem_stat_print(LPCHARACTER ch);	// NULL ̸ syslog  MEM_STAT  
+extern void		mem_stat_register_metrics();
+
+#endif
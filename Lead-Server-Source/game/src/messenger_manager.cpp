@@ -83,7 +83,7 @@ void MessengerManager::LoadList(SQLMsg * msg)
 	std::set<MessengerManager::keyT>::iterator it;
 
 	for (it = m_InverseRelation[account].begin(); it != m_InverseRelation[account].end(); ++it)
-		SendLogin(*it, account);
+		QueueStatus(*it, account, true);
 }
 
 void MessengerManager::Logout(MessengerManager::keyA account)
@@ -95,20 +95,20 @@ void MessengerManager::Logout(MessengerManager::keyA account)
 
 	std::set<MessengerManager::keyT>::iterator it;
 
+	// account  ģ   m_InverseRelation[account]   Ƿ
+	// ü m_Relation   ʰ   Ͽ .
 	for (it = m_InverseRelation[account].begin(); it != m_InverseRelation[account].end(); ++it)
 	{
-		SendLogout(*it, account);
-	}
+		QueueStatus(*it, account, false);
 
-	std::map<keyT, std::set<keyT> >::iterator it2 = m_Relation.begin();
+		std::map<keyT, std::set<keyT> >::iterator it2 = m_Relation.find(*it);
 
-	while (it2 != m_Relation.end())
-	{
-		it2->second.erase(account);
-		++it2;
+		if (it2 != m_Relation.end())
+			it2->second.erase(account);
 	}
 
 	m_Relation.erase(account);
+	m_map_pendingStatus.erase(account);
 }
 
 void MessengerManager::RequestToAdd(LPCHARACTER ch, LPCHARACTER target)
@@ -116,13 +116,13 @@ void MessengerManager::RequestToAdd(LPCHARACTER ch, LPCHARACTER target)
 	if (!ch->IsPC() || !target->IsPC())
 		return;
 	
-	if (quest::CQuestManager::instance().GetPCForce(ch->GetPlayerID())->IsRunning() == true)
+	if (quest::CQuestManager::instance().GetPCForce(ch)->IsRunning() == true)
 	{
 	    ch->ChatPacket(CHAT_TYPE_INFO, LC_TEXT("The other person is unable to add you as a friend."));
 	    return;
 	}
 
-	if (quest::CQuestManager::instance().GetPCForce(target->GetPlayerID())->IsRunning() == true)
+	if (quest::CQuestManager::instance().GetPCForce(target)->IsRunning() == true)
 		return;
 
 	DWORD dw1 = GetCRC32(ch->GetName(), strlen(ch->GetName()));
@@ -353,6 +353,96 @@ void MessengerManager::SendLogin(MessengerManager::keyA account, MessengerManage
 	d->Packet(companion.c_str(), companion.size());
 }
 
+void MessengerManager::QueueStatus(MessengerManager::keyA account, MessengerManager::keyA companion, bool bLogin)
+{
+	if (!g_bBulkMessengerStatus)
+	{
+		if (bLogin)
+			SendLogin(account, companion);
+		else
+			SendLogout(account, companion);
+		return;
+	}
+
+	//       .
+	if (!CHARACTER_MANAGER::instance().FindPC(account.c_str()))
+		return;
+
+	m_map_pendingStatus[account][companion] = bLogin;
+}
+
+void MessengerManager::FlushStatus()
+{
+	if (m_map_pendingStatus.empty())
+		return;
+
+	std::map<keyT, std::map<keyT, bool> > mapStatus;
+	mapStatus.swap(m_map_pendingStatus);
+
+	for (itertype(mapStatus) it = mapStatus.begin(); it != mapStatus.end(); ++it)
+	{
+		keyA account = it->first;
+		const std::map<keyT, bool> & rkStatus = it->second;
+
+		// ϳ̸  Ŷ ״ .
+		if (rkStatus.size() == 1)
+		{
+			if (rkStatus.begin()->second)
+				SendLogin(account, rkStatus.begin()->first);
+			else
+				SendLogout(account, rkStatus.begin()->first);
+			continue;
+		}
+
+		LPCHARACTER ch = CHARACTER_MANAGER::instance().FindPC(account.c_str());
+		LPDESC d = ch ? ch->GetDesc() : NULL;
+
+		if (!d)
+			continue;
+
+		// Ŭ̾Ʈ  Ŷ ׸񸶴 / ó ϹǷ  濡 ״ .
+		TEMP_BUFFER buf(8 * 1024);
+
+		for (itertype(rkStatus) it2 = rkStatus.begin(); it2 != rkStatus.end(); ++it2)
+		{
+			keyA companion = it2->first;
+
+			if (companion.empty())
+				continue;
+
+			TPacketGCMessengerListOnline pack_status;
+
+			if (it2->second)
+			{
+				// SendLogin   Ϲ Դ   ˸ ʴ´.
+				if (ch->GetGMLevel() == GM_PLAYER && gm_get_level(companion.c_str()) != GM_PLAYER)
+					continue;
+
+				pack_status.connected = 1;
+			}
+			else
+				pack_status.connected = 0;
+
+			pack_status.length = companion.size();
+
+			buf.write(&pack_status, sizeof(TPacketGCMessengerListOnline));
+			buf.write(companion.c_str(), companion.size());
+		}
+
+		if (buf.size() == 0)
+			continue;
+
+		TPacketGCMessenger pack;
+
+		pack.header		= HEADER_GC_MESSENGER;
+		pack.subheader	= MESSENGER_SUBHEADER_GC_LIST;
+		pack.size		= sizeof(TPacketGCMessenger) + buf.size();
+
+		d->BufferedPacket(&pack, sizeof(TPacketGCMessenger));
+		d->Packet(buf.read_peek(), buf.size());
+	}
+}
+
 void MessengerManager::SendLogout(MessengerManager::keyA account, MessengerManager::keyA companion)
 {
 	if (!companion.size())
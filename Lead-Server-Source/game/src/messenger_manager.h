@@ -32,10 +32,13 @@ class MessengerManager : public singleton<MessengerManager>
 
 		void	Initialize();
 
+		void	FlushStatus();	// ̹ pulse      ޴  ѹ .
+
 	private:
 		void	SendList(keyA account);
 		void	SendLogin(keyA account, keyA companion);
 		void	SendLogout(keyA account, keyA companion);
+		void	QueueStatus(keyA account, keyA companion, bool bLogin);
 
 		void	LoadList(SQLMsg * pmsg);
 
@@ -45,6 +48,9 @@ class MessengerManager : public singleton<MessengerManager>
 		std::map<keyT, std::set<keyT> >	m_Relation;
 		std::map<keyT, std::set<keyT> >	m_InverseRelation;
 		std::set<DWORD>			m_set_requestToAdd;
+
+		// ޴  -> (ģ ->  ).  ģ   ͸ ´.
+		std::map<keyT, std::map<keyT, bool> >	m_map_pendingStatus;
 };
 
 #endif
@@ -2,13 +2,18 @@
 #define _OBJECT_ALLOCATOR_H_
 
 #include "debug_allocator.h"
+#include "mem_stat.h"
 
 #include <assert.h>
-#include <deque>
 
 enum { DEFAULT_FREE_TRIGGER_COUNT = 32 };
 
-typedef std::deque<void*> FreeList; 
+// Freed blocks are chained through their own first bytes, so keeping them
+// costs no extra allocation and the list needs no static constructor.
+struct FreeBlock
+{
+	FreeBlock* pNext;
+};
 
 template <typename OBJ, size_t FREE_TRIGGER>
 class LateAllocator 
@@ -18,17 +23,17 @@ public:
 
 	~LateAllocator()
 	{
-		while ( m_freeBlockCount > 0 )
+		while ( m_freeBlocks != NULL )
 		{
-			void* p = m_freeBlocks.front();
+			void* p = m_freeBlocks;
+
+			m_freeBlocks = m_freeBlocks->pNext;
 #ifdef DEBUG_ALLOC
 			::free(reinterpret_cast<size_t*>(p) - 1);
 #else
 			::free( p );
 #endif
 
-			m_freeBlocks.pop_front();
-
 			--m_freeBlockCount;
 		}
 	}
@@ -38,16 +43,21 @@ public:
 	{
 		void* p = 0;
 
-		if ( m_freeBlockCount > 0 )
+		if ( m_freeBlocks != NULL )
 		{	
-			p = m_freeBlocks.front();
+			p = m_freeBlocks;
 
-			m_freeBlocks.pop_front();
+			m_freeBlocks = m_freeBlocks->pNext;
 
 			--m_freeBlockCount;
 		}	
 		else
 		{
+			if ( size < sizeof(FreeBlock) )
+			{
+				size = sizeof(FreeBlock);
+			}
+
 #ifdef DEBUG_ALLOC
 			// Reserve size_t age header at the beginning of the block
 			// to support quick reference test
@@ -58,6 +68,11 @@ public:
 #endif
 		}
 
+		if ( p != NULL )
+		{
+			++m_usedBlockCount;
+		}
+
 		return p;
 	}
 
@@ -70,9 +85,12 @@ public:
 		}
 
 #ifdef DEBUG_ALLOC
-		::memset( p, 0, sizeof(OBJ) );
+		// poison the block so a use after free reads garbage instead of zeros
+		::memset( p, 0xdd, sizeof(OBJ) );
 #endif
 
+		--m_usedBlockCount;
+
 		if ( m_freeBlockCount >= FREE_TRIGGER )
 		{
 #ifdef DEBUG_ALLOC
@@ -86,7 +104,9 @@ public:
 		{
 			++m_freeBlockCount;	
 
-			m_freeBlocks.push_back(p);
+			FreeBlock* pBlock = reinterpret_cast<FreeBlock*>(p);
+			pBlock->pNext = m_freeBlocks;
+			m_freeBlocks = pBlock;
 		}
 	}
 
@@ -95,24 +115,36 @@ public:
 		return m_freeBlockCount;
 	}
 
+	// Blocks handed out and not yet returned.
+	static size_t GetUsedBlockCount() 
+	{
+		return m_usedBlockCount;
+	}
+
 private:
 
 	static size_t 		m_freeBlockCount;
-	static FreeList 	m_freeBlocks;
+	static size_t 		m_usedBlockCount;
+	static FreeBlock* 	m_freeBlocks;
 };
 
 template <typename OBJ, size_t FREE_TRIGGER>
 size_t LateAllocator<OBJ, FREE_TRIGGER>::m_freeBlockCount = 0;
 
 template <typename OBJ, size_t FREE_TRIGGER>
-FreeList LateAllocator<OBJ, FREE_TRIGGER>::m_freeBlocks;
+size_t LateAllocator<OBJ, FREE_TRIGGER>::m_usedBlockCount = 0;
+
+template <typename OBJ, size_t FREE_TRIGGER>
+FreeBlock* LateAllocator<OBJ, FREE_TRIGGER>::m_freeBlocks = NULL;
 
 /**
  * @class ObjectAllocator 
  * 
  * NOTE: One must use M2_OBJ_NEW, M2_OBJ_DELETE macros 
+ *
+ * MEM_TAG other than MEM_TAG_NONE counts the live bytes in mem_stat.
  */
-template <typename OBJ, size_t FREE_TRIGGER=DEFAULT_FREE_TRIGGER_COUNT> 
+template <typename OBJ, size_t FREE_TRIGGER=DEFAULT_FREE_TRIGGER_COUNT, int MEM_TAG=MEM_TAG_NONE> 
 class ObjectAllocator 
 {
 public:
@@ -121,21 +153,43 @@ public:
 
 	static void* operator new( size_t size )
 	{
-		return m_allocator.Alloc( size );
+		void* p = Allocator::Alloc( size );
+
+		if ( MEM_TAG != MEM_TAG_NONE && p != NULL )
+		{
+			mem_stat_alloc( MEM_TAG, size );
+		}
+
+		return p;
 	}
 
 	static void operator delete( void* p, size_t size )
 	{
+		if ( p == NULL )
+		{
+			return;
+		}
+
+		if ( MEM_TAG != MEM_TAG_NONE )
+		{
+			mem_stat_free( MEM_TAG, size );
+		}
+
 #ifdef DEBUG_ALLOC
 		size_t& age = *(reinterpret_cast<size_t*>(p) - 1);
 		age = AllocTag::IncreaseAge(age);
 #endif 		
-		m_allocator.Free( p );
+		Allocator::Free( p );
 	}
 
 	static void* operator new( size_t size, const char* f, size_t l )
 	{
-		void* p = m_allocator.Alloc( size );
+		void* p = Allocator::Alloc( size );
+
+		if ( MEM_TAG != MEM_TAG_NONE && p != NULL )
+		{
+			mem_stat_alloc( MEM_TAG, size );
+		}
 #ifdef DEBUG_ALLOC
 		if (p != NULL) 
 		{
@@ -148,11 +202,16 @@ public:
 
 	static size_t GetFreeBlockCount() 
 	{
-		return m_allocator.GetFreeBlockCount();
+		return Allocator::GetFreeBlockCount();
+	}
+
+	static size_t GetUsedBlockCount() 
+	{
+		return Allocator::GetUsedBlockCount();
 	}
 
 private:
-	static LateAllocator<OBJ, FREE_TRIGGER> m_allocator;	
+	typedef LateAllocator<OBJ, FREE_TRIGGER> Allocator;
 };
 
 #ifdef DEBUG_ALLOC
@@ -14,6 +14,7 @@
 #include "marriage.h"
 #include "utils.h"
 #include "locale_service.h"
+#include "lzo_manager.h"
 #include <sstream>
 
 P2P_MANAGER::P2P_MANAGER()
@@ -21,7 +22,11 @@ P2P_MANAGER::P2P_MANAGER()
 	m_pkInputProcessor = NULL;
 	m_iHandleCount = 0;
 
-	memset(m_aiEmpireUserCount, 0, sizeof(m_aiEmpireUserCount));
+	m_dwBatchCount = 0;
+	m_dwBatchMessageCount = 0;
+	m_dwBatchMaxMessage = 0;
+	m_dwBatchBytes = 0;
+	m_dwBatchCompressedBytes = 0;
 }
 
 P2P_MANAGER::~P2P_MANAGER()
@@ -53,6 +58,8 @@ void P2P_MANAGER::Boot(LPDESC d)
 
 void P2P_MANAGER::FlushOutput()
 {
+	FlushBatch();
+
 	TR1_NS::unordered_set<LPDESC>::iterator it = m_set_pkPeers.begin();
 
 	while (it != m_set_pkPeers.end())
@@ -67,12 +74,14 @@ void P2P_MANAGER::RegisterAcceptor(LPDESC d)
 	sys_log(0, "P2P Acceptor opened (host %s)", d->GetHostName());
 	m_set_pkPeers.insert(d);
 	Boot(d);
+	SendSetup(d);
 }
 
 void P2P_MANAGER::UnregisterAcceptor(LPDESC d)
 {
 	sys_log(0, "P2P Acceptor closed (host %s)", d->GetHostName());
 	EraseUserByDesc(d);
+	EraseBatch(d);
 	m_set_pkPeers.erase(d);
 }
 
@@ -81,14 +90,36 @@ void P2P_MANAGER::RegisterConnector(LPDESC d)
 	sys_log(0, "P2P Connector opened (host %s)", d->GetHostName());
 	m_set_pkPeers.insert(d);
 	Boot(d);
+	SendSetup(d);
+}
 
+//     Ŭ̾Ʈ ޴ ּҸ ˰ Ѵ.
+void P2P_MANAGER::SendSetup(LPDESC d)
+{
 	TPacketGGSetup p;
 	p.bHeader = HEADER_GG_SETUP;
 	p.wPort = p2p_port;
 	p.bChannel = g_bChannel;
+	p.lListenAddr = inet_addr(g_szPublicIP);
+	p.wListenPort = mother_port;
 	d->Packet(&p, sizeof(p));
 }
 
+LPDESC P2P_MANAGER::FindPeerByListenAddr(long lAddr, WORD wPort)
+{
+	TR1_NS::unordered_set<LPDESC>::iterator it = m_set_pkPeers.begin();
+
+	while (it != m_set_pkPeers.end())
+	{
+		LPDESC pkDesc = *it++;
+
+		if (pkDesc->GetP2PListenAddr() == lAddr && pkDesc->GetP2PListenPort() == wPort)
+			return pkDesc;
+	}
+
+	return NULL;
+}
+
 void P2P_MANAGER::UnregisterConnector(LPDESC d)
 {
 	TR1_NS::unordered_set<LPDESC>::iterator it = m_set_pkPeers.find(d);
@@ -97,6 +128,7 @@ void P2P_MANAGER::UnregisterConnector(LPDESC d)
 	{
 		sys_log(0, "P2P Connector closed (host %s)", d->GetHostName());
 		EraseUserByDesc(d);
+		EraseBatch(d);
 		m_set_pkPeers.erase(it);
 	}
 }
@@ -126,10 +158,116 @@ void P2P_MANAGER::Send(const void * c_pvData, int iSize, LPDESC except)
 		if (except == pkDesc)
 			continue;
 
-		pkDesc->Packet(c_pvData, iSize);
+		TBatch & r = m_map_batch[pkDesc];
+
+		if (!r.iCount)
+		{
+			m_vec_pkBatchPeer.push_back(pkDesc);
+			pkDesc->SetP2PBatchPending(true);
+		}
+
+		r.vecData.insert(r.vecData.end(), (const char *) c_pvData, (const char *) c_pvData + iSize);
+		++r.iCount;
 	}
 }
 
+void P2P_MANAGER::FlushBatch()
+{
+	for (size_t i = 0; i < m_vec_pkBatchPeer.size(); ++i)
+	{
+		if (m_vec_pkBatchPeer[i])
+			FlushBatch(m_vec_pkBatchPeer[i]);
+	}
+
+	m_vec_pkBatchPeer.clear();
+}
+
+void P2P_MANAGER::FlushBatch(LPDESC d)
+{
+	d->SetP2PBatchPending(false);
+
+	std::map<LPDESC, TBatch>::iterator it = m_map_batch.find(d);
+
+	if (it == m_map_batch.end() || !it->second.iCount)
+		return;
+
+	TBatch & r = it->second;
+	int iSize = r.vecData.size();
+
+	++m_dwBatchCount;
+	m_dwBatchMessageCount += r.iCount;
+	m_dwBatchMaxMessage = MAX(m_dwBatchMaxMessage, (DWORD) r.iCount);
+	m_dwBatchBytes += iSize;
+
+	if (r.iCount == 1)
+	{
+		// ϳ̸  ʿ䰡 .
+		m_dwBatchCompressedBytes += iSize;
+		d->Packet(&r.vecData[0], iSize);
+	}
+	else
+	{
+		static std::vector<BYTE> s_vecCompressed;
+
+		TPacketGGBatch p;
+		p.bHeader = HEADER_GG_BATCH;
+		p.wCount = MIN(r.iCount, 0xffff);
+		p.lSize = iSize;
+		p.lRealSize = 0;
+
+		const void * c_pvData = &r.vecData[0];
+
+		if (g_iP2PBatchCompressThreshold > 0 && iSize >= g_iP2PBatchCompressThreshold)
+		{
+			s_vecCompressed.resize(LZOManager::instance().GetMaxCompressedSize(iSize));
+			lzo_uint uiCompressedSize = 0;
+
+			if (LZOManager::instance().Compress((const BYTE *) c_pvData, iSize, &s_vecCompressed[0], &uiCompressedSize) &&
+					(int) uiCompressedSize < iSize)
+			{
+				p.lSize = uiCompressedSize;
+				p.lRealSize = iSize;
+				c_pvData = &s_vecCompressed[0];
+			}
+		}
+
+		m_dwBatchCompressedBytes += p.lSize;
+
+		d->Packet(&p, sizeof(p));
+		d->Packet(c_pvData, p.lSize);
+	}
+
+	r.vecData.clear();
+	r.iCount = 0;
+}
+
+void P2P_MANAGER::EraseBatch(LPDESC d)
+{
+	m_map_batch.erase(d);
+
+	for (size_t i = 0; i < m_vec_pkBatchPeer.size(); ++i)
+	{
+		if (m_vec_pkBatchPeer[i] == d)
+			m_vec_pkBatchPeer[i] = NULL;
+	}
+
+	d->SetP2PBatchPending(false);
+}
+
+void P2P_MANAGER::LogBatchStat()
+{
+	sys_log(0, "P2P_BATCH: batches %u messages %u (avg %.1f max %u) bytes %u sent %u",
+			m_dwBatchCount, m_dwBatchMessageCount,
+			m_dwBatchCount ? (float) m_dwBatchMessageCount / m_dwBatchCount : 0.0f,
+			m_dwBatchMaxMessage, m_dwBatchBytes, m_dwBatchCompressedBytes);
+
+	m_dwBatchCount = 0;
+	m_dwBatchMessageCount = 0;
+	m_dwBatchMaxMessage = 0;
+	m_dwBatchBytes = 0;
+	m_dwBatchCompressedBytes = 0;
+}
+
 void P2P_MANAGER::Login(LPDESC d, const TPacketGGLogin * p)
 {
 	CCI* pkCCI = Find(p->szName);
@@ -146,18 +284,6 @@ void P2P_MANAGER::Login(LPDESC d, const TPacketGGLogin * p)
 		pkCCI->dwPID = p->dwPID;
 		pkCCI->bEmpire = p->bEmpire;
 
-		if (p->bChannel == g_bChannel)
-		{
-			if (pkCCI->bEmpire < EMPIRE_MAX_NUM)
-			{
-				++m_aiEmpireUserCount[pkCCI->bEmpire];
-			}
-			else
-			{
-				sys_err("LOGIN_EMPIRE_ERROR: %d >= MAX(%d)", pkCCI->bEmpire, EMPIRE_MAX_NUM);
-			}
-		}
-
 		m_map_pkCCI.insert(std::make_pair(pkCCI->szName, pkCCI));
 		m_map_dwPID_pkCCI.insert(std::make_pair(pkCCI->dwPID, pkCCI));
 	}
@@ -179,22 +305,6 @@ void P2P_MANAGER::Login(LPDESC d, const TPacketGGLogin * p)
 
 void P2P_MANAGER::Logout(CCI * pkCCI)
 {
-	if (pkCCI->bChannel == g_bChannel)
-	{
-		if (pkCCI->bEmpire < EMPIRE_MAX_NUM)
-		{
-			--m_aiEmpireUserCount[pkCCI->bEmpire];
-			if (m_aiEmpireUserCount[pkCCI->bEmpire] < 0)
-			{
-				sys_err("m_aiEmpireUserCount[%d] < 0", pkCCI->bEmpire);
-			}
-		}
-		else
-		{
-			sys_err("LOGOUT_EMPIRE_ERROR: %d >= MAX(%d)", pkCCI->bEmpire, EMPIRE_MAX_NUM);
-		}
-	}
-
 	std::string name(pkCCI->szName);
 
 	CGuildManager::instance().P2PLogoutMember(pkCCI->dwPID);
@@ -238,18 +348,6 @@ CCI * P2P_MANAGER::Find(const char * c_pszName)
 	return it->second;
 }
 
-int P2P_MANAGER::GetCount()
-{
-	//return m_map_pkCCI.size();
-	return m_aiEmpireUserCount[1] + m_aiEmpireUserCount[2] + m_aiEmpireUserCount[3];
-}
-
-int P2P_MANAGER::GetEmpireUserCount(int idx)
-{
-	assert(idx < EMPIRE_MAX_NUM);
-	return m_aiEmpireUserCount[idx];
-}
-
 
 int P2P_MANAGER::GetDescCount()
 {
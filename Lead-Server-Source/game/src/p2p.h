@@ -40,19 +40,26 @@ class P2P_MANAGER : public singleton<P2P_MANAGER>
 
 		void			Send(const void * c_pvData, int iSize, LPDESC except = NULL);
 
+		// Send   Ŷ peer  Ƶξٰ pulse  HEADER_GG_BATCH ϳ .
+		void			FlushBatch();
+		void			FlushBatch(LPDESC d);
+		void			LogBatchStat();
+
 		void			Login(LPDESC d, const TPacketGGLogin * p);
 		void			Logout(const char * c_pszName);
 
 		CCI *			Find(const char * c_pszName);
 		CCI *			FindByPID(DWORD pid);
 
-		int				GetCount();
-		int				GetEmpireUserCount(int idx);
+		LPDESC			FindPeerByListenAddr(long lAddr, WORD wPort);	// Ŭ̾Ʈ ϴ ּҷ peer  ã´.
+
 		int				GetDescCount();
 		void			GetP2PHostNames(std::string& hostNames);
 
 	private:
 		void			Logout(CCI * pkCCI);
+		void			EraseBatch(LPDESC d);
+		void			SendSetup(LPDESC d);
 
 		CInputProcessor *	m_pkInputProcessor;
 		int			m_iHandleCount;
@@ -61,9 +68,23 @@ class P2P_MANAGER : public singleton<P2P_MANAGER>
 		typedef boost::unordered_map<DWORD, CCI*> TPIDCCIMap;
 
 		TR1_NS::unordered_set<LPDESC> m_set_pkPeers;
+
+		typedef struct SBatch
+		{
+			std::vector<char>	vecData;
+			int			iCount;
+		} TBatch;
+
+		std::map<LPDESC, TBatch>	m_map_batch;
+		std::vector<LPDESC>		m_vec_pkBatchPeer;	// ̹ pulse  ġ  peer
+
+		DWORD			m_dwBatchCount;
+		DWORD			m_dwBatchMessageCount;
+		DWORD			m_dwBatchMaxMessage;
+		DWORD			m_dwBatchBytes;
+		DWORD			m_dwBatchCompressedBytes;
 		TCCIMap			m_map_pkCCI;
 		TPIDCCIMap		m_map_dwPID_pkCCI;
-		int			m_aiEmpireUserCount[EMPIRE_MAX_NUM];
 };
 
 #endif /* P2P_MANAGER_H_ */
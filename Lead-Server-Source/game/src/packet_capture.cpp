@@ -0,0 +1,136 @@
+#include "stdafx.h"
+#include "utils.h"
+#include "config.h"
+#include "char.h"
+#include "desc.h"
+#include "packet_capture.h"
+#include "common/packet_capture.h"
+
+static FILE *		s_fpCapture = NULL;
+static std::string	s_stCaptureFileName;
+static DWORD		s_dwCaptureStartTime = 0;
+static DWORD		s_dwCapturePackets = 0;
+static DWORD		s_dwCaptureBytes = 0;
+static std::set<DWORD>	s_set_dwCaptureHandle;	// CONNECT   handle
+
+static void packet_capture_write(DWORD dwHandle, BYTE bType, int iPhase, bool bSequence, const void * c_pData, int iSize)
+{
+	TPacketCaptureRecord rec;
+
+	rec.dwTime = get_dword_time() - s_dwCaptureStartTime;
+	rec.dwHandle = dwHandle;
+	rec.bType = bType;
+	rec.bPhase = iPhase;
+	rec.bSequence = bSequence ? 1 : 0;
+	rec.wSize = iSize;
+
+	if (fwrite(&rec, sizeof(rec), 1, s_fpCapture) != 1 || (iSize > 0 && fwrite(c_pData, iSize, 1, s_fpCapture) != 1))
+	{
+		sys_err("packet capture: write to %s failed, stopping", s_stCaptureFileName.c_str());
+		packet_capture_close();
+		return;
+	}
+
+	s_dwCaptureBytes += sizeof(rec) + iSize;
+}
+
+bool packet_capture_open(const char * c_pszFileName)
+{
+	packet_capture_close();
+
+	if (!(s_fpCapture = fopen(c_pszFileName, "wb")))
+	{
+		sys_err("packet capture: cannot open %s", c_pszFileName);
+		return false;
+	}
+
+	// Ŷ write   ʵ ũ Ƽ .
+	setvbuf(s_fpCapture, NULL, _IOFBF, 256 * 1024);
+
+	TPacketCaptureHeader header;
+
+	header.dwMagic = PACKET_CAPTURE_MAGIC;
+	header.wVersion = PACKET_CAPTURE_VERSION;
+	header.wPort = mother_port;
+	header.dwStartTime = get_global_time();
+
+	if (fwrite(&header, sizeof(header), 1, s_fpCapture) != 1)
+	{
+		sys_err("packet capture: cannot write header to %s", c_pszFileName);
+		fclose(s_fpCapture);
+		s_fpCapture = NULL;
+		return false;
+	}
+
+	s_stCaptureFileName = c_pszFileName;
+	s_dwCaptureStartTime = get_dword_time();
+	s_dwCapturePackets = 0;
+	s_dwCaptureBytes = sizeof(header);
+	s_set_dwCaptureHandle.clear();
+
+	sys_log(0, "packet capture: started to %s", c_pszFileName);
+	return true;
+}
+
+void packet_capture_close()
+{
+	if (!s_fpCapture)
+		return;
+
+	fclose(s_fpCapture);
+	s_fpCapture = NULL;
+	s_set_dwCaptureHandle.clear();
+
+	sys_log(0, "packet capture: stopped, %u packets %u bytes in %s", s_dwCapturePackets, s_dwCaptureBytes, s_stCaptureFileName.c_str());
+}
+
+bool packet_capture_is_open()
+{
+	return s_fpCapture != NULL;
+}
+
+void packet_capture_record(LPDESC d, int iPhase, bool bSequence, const void * c_pData, int iSize)
+{
+	if (!s_fpCapture)
+		return;
+
+	if (iSize <= 0 || iSize > USHRT_MAX)
+		return;
+
+	// ĸĸ ѱ  پ ִ  handshake     
+	// ð    ״ .
+	if (s_set_dwCaptureHandle.insert(d->GetHandle()).second)
+		packet_capture_write(d->GetHandle(), PACKET_CAPTURE_CONNECT, iPhase, false, NULL, 0);
+
+	if (!s_fpCapture)
+		return;
+
+	packet_capture_write(d->GetHandle(), PACKET_CAPTURE_PACKET, iPhase, bSequence, c_pData, iSize);
+	++s_dwCapturePackets;
+}
+
+void packet_capture_disconnect(LPDESC d)
+{
+	if (!s_fpCapture)
+		return;
+
+	if (!s_set_dwCaptureHandle.erase(d->GetHandle()))
+		return;
+
+	packet_capture_write(d->GetHandle(), PACKET_CAPTURE_CLOSE, d->GetPhase(), false, NULL, 0);
+}
+
+void packet_capture_print(LPCHARACTER ch)
+{
+	if (!s_fpCapture)
+	{
+		ch->ChatPacket(CHAT_TYPE_INFO, "packet capture: off");
+		return;
+	}
+
+	ch->ChatPacket(CHAT_TYPE_INFO, "packet capture: %s, %u sec, %u connections, %u packets, %u KB",
+			s_stCaptureFileName.c_str(),
+			(get_dword_time() - s_dwCaptureStartTime) / 1000,
+			(unsigned int) s_set_dwCaptureHandle.size(),
+			s_dwCapturePackets, s_dwCaptureBytes / 1024);
+}
@@ -0,0 +1,19 @@
+#ifndef __INC_METIN_II_GAME_PACKET_CAPTURE_H__
+#define __INC_METIN_II_GAME_PACKET_CAPTURE_H__
+
+//
+// Ŭ̾Ʈ  Ŷ CInputProcessor::Process  Ӻ ð Բ
+// Ͽ .  common/packet_capture.h,  Lead-Tools/LoadBot -p.
+// Ǽ Ʈ    ׽Ʈ  pulse ð ٽ  .
+//
+extern bool	packet_capture_open(const char * c_pszFileName);
+extern void	packet_capture_close();
+extern bool	packet_capture_is_open();
+
+// c_pData   iSize Ʈ, sequence Ʈ  ѱ.
+extern void	packet_capture_record(LPDESC d, int iPhase, bool bSequence, const void * c_pData, int iSize);
+extern void	packet_capture_disconnect(LPDESC d);	// DESC::Destroy
+
+extern void	packet_capture_print(LPCHARACTER ch);
+
+#endif
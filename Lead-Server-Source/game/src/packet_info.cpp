@@ -4,21 +4,30 @@
 #include "packet_info.h"
 
 CPacketInfo::CPacketInfo()
-	: m_pCurrentPacket(NULL), m_dwStartTime(0)
+	: m_pCurrentPacket(NULL)
 {
+	memset(m_apPacketElement, 0, sizeof(m_apPacketElement));
+	memset(&m_tvStartTime, 0, sizeof(m_tvStartTime));
 }
 
 CPacketInfo::~CPacketInfo()
 {
-	itertype(m_pPacketMap) it = m_pPacketMap.begin();
-	for ( ; it != m_pPacketMap.end(); ++it) {
-		M2_DELETE(it->second);
+	for (int i = 0; i < 256; ++i)
+	{
+		if (m_apPacketElement[i])
+			M2_DELETE(m_apPacketElement[i]);
 	}
 }
 
 void CPacketInfo::Set(int header, int iSize, const char * c_pszName, bool bSeq)
 {
-	if (m_pPacketMap.find(header) != m_pPacketMap.end())
+	if (header < 0 || header >= 256)
+	{
+		sys_err("invalid header %d (%s)", header, c_pszName);
+		return;
+	}
+
+	if (m_apPacketElement[header])
 		return;
 
 	TPacketElement * element = M2_NEW TPacketElement;
@@ -33,20 +42,20 @@ void CPacketInfo::Set(int header, int iSize, const char * c_pszName, bool bSeq)
 	if (element->bSequencePacket)
 		element->iSize += sizeof(BYTE);
 
-	m_pPacketMap.insert(std::map<int, TPacketElement *>::value_type(header, element));
+	m_apPacketElement[header] = element;
 }
 
 bool CPacketInfo::Get(int header, int * size, const char ** c_ppszName)
 {
-	std::map<int, TPacketElement *>::iterator it = m_pPacketMap.find(header);
+	TPacketElement * pkElement = GetElement(header);
 
-	if (it == m_pPacketMap.end())
+	if (!pkElement)
 		return false;
 
-	*size = it->second->iSize;
-	*c_ppszName = it->second->stName.c_str();
+	*size = pkElement->iSize;
+	*c_ppszName = pkElement->stName.c_str();
 
-	m_pCurrentPacket = it->second;
+	m_pCurrentPacket = pkElement;
 	return true;
 }
 
@@ -79,24 +88,28 @@ void CPacketInfo::SetSequence(int header, bool bSeq)
 
 TPacketElement * CPacketInfo::GetElement(int header)
 {
-	std::map<int, TPacketElement *>::iterator it = m_pPacketMap.find(header);
-
-	if (it == m_pPacketMap.end())
+	if (header < 0 || header >= 256)
 		return NULL;
 
-	return it->second;
+	return m_apPacketElement[header];
 }
 
 void CPacketInfo::Start()
 {
 	assert(m_pCurrentPacket != NULL);
-	m_dwStartTime = get_dword_time();
+	gettimeofday(&m_tvStartTime, NULL);
 }
 
-void CPacketInfo::End()
+DWORD CPacketInfo::End()
 {
+	struct timeval tvNow;
+	gettimeofday(&tvNow, NULL);
+
+	DWORD dwUsec = (tvNow.tv_sec - m_tvStartTime.tv_sec) * 1000000 + (tvNow.tv_usec - m_tvStartTime.tv_usec);
+
 	++m_pCurrentPacket->iCalled;
-	m_pCurrentPacket->dwLoad += get_dword_time() - m_dwStartTime;
+	m_pCurrentPacket->dwLoad += dwUsec;
+	return dwUsec;
 }
 
 void CPacketInfo::Log(const char * c_pszFileName)
@@ -108,14 +121,14 @@ void CPacketInfo::Log(const char * c_pszFileName)
 	if (!fp)
 		return;
 
-	std::map<int, TPacketElement *>::iterator it = m_pPacketMap.begin();
-
 	fprintf(fp, "Name             Called     Load       Ratio\n");
 
-	while (it != m_pPacketMap.end())
+	for (int i = 0; i < 256; ++i)
 	{
-		TPacketElement * p = it->second;
-		++it;
+		TPacketElement * p = m_apPacketElement[i];
+
+		if (!p)
+			continue;
 
 		fprintf(fp, "%-16s %-10d %-10u %.2f\n",
 				p->stName.c_str(),
@@ -141,6 +154,8 @@ CPacketInfoCG::CPacketInfoCG()
 	Set(HEADER_CG_SYMBOL_CRC, sizeof(TPacketCGSymbolCRC), "SymbolCRC", false);
 	Set(HEADER_CG_LOGIN, sizeof(TPacketCGLogin), "Login", true);
 	Set(HEADER_CG_LOGIN2, sizeof(TPacketCGLogin2), "Login2", true);
+	Set(HEADER_CG_PACKET_COMPRESSION, sizeof(TPacketCGPacketCompression), "PacketCompression", true);
+	Set(HEADER_CG_PROTOCOL_VERSION, sizeof(TPacketCGProtocolVersion), "ProtocolVersion", true);
 	Set(HEADER_CG_LOGIN3, sizeof(TPacketCGLogin3), "Login3", true);
 	Set(HEADER_CG_ATTACK, sizeof(TPacketCGAttack), "Attack", true);
 	Set(HEADER_CG_CHAT, sizeof(TPacketCGChat), "Chat", true);
@@ -252,6 +267,8 @@ CPacketInfoGG::CPacketInfoGG()
 	// END_OF_BLOCK_CHAT
 
 	Set(HEADER_GG_CHECK_AWAKENESS,		sizeof(TPacketGGCheckAwakeness),	"CheckAwakeness",		false);
+	Set(HEADER_GG_BATCH,		sizeof(TPacketGGBatch),		"Batch", false);
+	Set(HEADER_GG_CHARACTER_HANDOFF,	sizeof(TPacketGGCharacterHandoff),	"CharacterHandoff", false);
 }
 
 CPacketInfoGG::~CPacketInfoGG()
@@ -8,7 +8,7 @@ typedef struct SPacketElement
 	int		iSize;
 	std::string	stName;
 	int		iCalled;
-	DWORD	dwLoad;
+	DWORD	dwLoad;		// microseconds
 	bool	bSequencePacket;
 } TPacketElement;
 
@@ -22,7 +22,7 @@ class CPacketInfo
 		bool Get(int header, int * size, const char ** c_ppszName);
 
 		void Start();
-		void End();
+		DWORD End();	// returns the microseconds passed since Start()
 
 		void Log(const char * c_pszFileName);
 
@@ -33,9 +33,9 @@ class CPacketInfo
 		TPacketElement * GetElement(int header);
 
 	protected:
-		std::map<int, TPacketElement *> m_pPacketMap;
+		TPacketElement * m_apPacketElement[256];	// indexed by header
 		TPacketElement * m_pCurrentPacket;
-		DWORD m_dwStartTime;
+		struct timeval m_tvStartTime;
 };
 
 class CPacketInfoCG : public CPacketInfo
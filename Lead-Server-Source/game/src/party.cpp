@@ -8,6 +8,7 @@
 #include "desc_client.h"
 #include "dungeon.h"
 #include "unique_item.h"
+#include "buffer_manager.h"
 
 CPartyManager::CPartyManager()
 {
@@ -800,6 +801,8 @@ void CParty::SendPartyInfoOneToAll(DWORD pid)
 	p.percent_hp = 255;
 	p.role = it->second.bRole;
 
+	it->second.bUpdateSent = false;
+
 	for (it = m_memberMap.begin();it!= m_memberMap.end(); ++it)
 	{
 		if ((it->second.pCharacter) && (it->second.pCharacter->GetDesc()))
@@ -821,6 +824,14 @@ void CParty::SendPartyInfoOneToAll(LPCHARACTER ch)
 	TPacketGCPartyUpdate p;
 	ch->BuildUpdatePartyPacket(p);
 
+	it = m_memberMap.find(ch->GetPlayerID());
+
+	if (it != m_memberMap.end())
+	{
+		it->second.kLastUpdate = p;
+		it->second.bUpdateSent = true;
+	}
+
 	for (it = m_memberMap.begin();it!= m_memberMap.end(); ++it)
 	{
 		if ((it->second.pCharacter) && (it->second.pCharacter->GetDesc()))
@@ -839,6 +850,10 @@ void CParty::SendPartyInfoAllToOne(LPCHARACTER ch)
 
 	for (it = m_memberMap.begin(); it != m_memberMap.end(); ++it)
 	{
+		// ch    Ƿ ٸ Ƽ   Ͱ ٸ  ִ.
+		//  Update   ٽ  .
+		it->second.bUpdateSent = false;
+
 		if (!it->second.pCharacter)
 		{
 			DWORD pid = it->first;
@@ -857,6 +872,64 @@ void CParty::SendPartyInfoAllToOne(LPCHARACTER ch)
 	}
 }
 
+void CParty::AppendPartyInfoDelta(TMember & rMember, std::vector<TPacketGCPartyUpdate> & vec, bool bForce)
+{
+	LPCHARACTER ch = rMember.pCharacter;
+
+	if (!ch || !ch->GetDesc())
+		return;
+
+	TPacketGCPartyUpdate p;
+
+	if (!ch->BuildUpdatePartyPacket(p))
+		return;
+
+	if (!bForce && rMember.bUpdateSent && !memcmp(&p, &rMember.kLastUpdate, sizeof(p)))
+		return;
+
+	rMember.kLastUpdate = p;
+	rMember.bUpdateSent = true;
+	vec.push_back(p);
+}
+
+void CParty::SendPartyInfoBulkToAll(const std::vector<TPacketGCPartyUpdate> & vec)
+{
+	if (vec.empty())
+		return;
+
+	TEMP_BUFFER buf;
+
+	if (vec.size() == 1)
+		buf.write(&vec[0], sizeof(TPacketGCPartyUpdate));
+	else
+	{
+		TPacketGCPartyUpdateBulk pack;
+
+		pack.bHeader = HEADER_GC_PARTY_UPDATE_BULK;
+		pack.wSize = sizeof(TPacketGCPartyUpdateBulk) + sizeof(TPacketGCPartyUpdateBulkElement) * vec.size();
+
+		buf.write(&pack, sizeof(pack));
+
+		for (size_t i = 0; i < vec.size(); ++i)
+		{
+			TPacketGCPartyUpdateBulkElement elem;
+
+			elem.pid = vec[i].pid;
+			elem.role = vec[i].role;
+			elem.percent_hp = vec[i].percent_hp;
+			memcpy(elem.affects, vec[i].affects, sizeof(elem.affects));
+
+			buf.write(&elem, sizeof(elem));
+		}
+	}
+
+	for (TMemberMap::iterator it = m_memberMap.begin(); it != m_memberMap.end(); ++it)
+	{
+		if (it->second.pCharacter && it->second.pCharacter->GetDesc())
+			it->second.pCharacter->GetDesc()->Packet(buf.read_peek(), buf.size());
+	}
+}
+
 void CParty::SendMessage(LPCHARACTER ch, BYTE bMsg, DWORD dwArg1, DWORD dwArg2)
 {
 	if (ch->GetParty() != this)
@@ -1368,6 +1441,9 @@ void CParty::Update()
 		bResendAll = true;
 	}
 
+	//  Ƽ   ޶ ͸ Ƽ ѹ 
+	std::vector<TPacketGCPartyUpdate> vec_kUpdate;
+
 	for (it = m_memberMap.begin(); it != m_memberMap.end(); ++it)
 	{
 		LPCHARACTER ch = it->second.pCharacter;
@@ -1385,7 +1461,7 @@ void CParty::Update()
 		if (bNear)
 		{
 			if (!bResendAll)
-				SendPartyInfoOneToAll(ch);
+				AppendPartyInfoDelta(it->second, vec_kUpdate, false);
 		}
 	}
 
@@ -1427,9 +1503,10 @@ void CParty::Update()
 	if (bResendAll)
 	{
 		for (TMemberMap::iterator it = m_memberMap.begin(); it != m_memberMap.end(); ++it)
-			if (it->second.pCharacter)
-				SendPartyInfoOneToAll(it->second.pCharacter);
+			AppendPartyInfoDelta(it->second, vec_kUpdate, true);
 	}
+
+	SendPartyInfoBulkToAll(vec_kUpdate);
 }
 
 void CParty::UpdateOnlineState(DWORD dwPID, const char* name)
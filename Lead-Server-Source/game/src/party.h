@@ -2,6 +2,7 @@
 #define __INC_METIN_II_GAME_PARTY_H__
 
 #include "char.h"
+#include "packet.h"
 
 enum // unit : minute
 {
@@ -88,6 +89,15 @@ class CParty
 			BYTE	bRole;
 			BYTE	bLevel;
 			std::string strName;
+
+			// Update   ο  .  ٽ  ʴ´.
+			bool	bUpdateSent;
+			TPacketGCPartyUpdate	kLastUpdate;
+
+			SMember() : bUpdateSent(false)
+			{
+				memset(&kLastUpdate, 0, sizeof(kLastUpdate));
+			}
 		} TMember;
 
 		typedef std::map<DWORD, TMember> TMemberMap;
@@ -132,6 +142,10 @@ class CParty
 		void		SendPartyInfoOneToAll(DWORD pid);
 		void		SendPartyInfoOneToAll(LPCHARACTER ch);
 		void		SendPartyInfoAllToOne(LPCHARACTER ch);
+		// ޶ Ƽ  vec  ִ´. bForce  Ƶ ִ´.
+		void		AppendPartyInfoDelta(TMember & rMember, std::vector<TPacketGCPartyUpdate> & vec, bool bForce);
+		// vec   ޴  HEADER_GC_PARTY_UPDATE_BULK ϳ .
+		void		SendPartyInfoBulkToAll(const std::vector<TPacketGCPartyUpdate> & vec);
 
 		void		SendPartyLinkOneToAll(LPCHARACTER ch);
 		void		SendPartyLinkAllToOne(LPCHARACTER ch);
@@ -0,0 +1,386 @@
+#include "stdafx.h"
+#include <queue>
+#include "config.h"
+#include "sectree_manager.h"
+#include "path_finder.h"
+
+enum
+{
+	PATH_FLAG_CHECKED	= (1 << 0),
+	PATH_FLAG_WALKABLE	= (1 << 1),
+	PATH_FLAG_OPEN		= (1 << 2),
+	PATH_FLAG_CLOSED	= (1 << 3),
+};
+
+enum
+{
+	PATH_COST_STRAIGHT	= 10,
+	PATH_COST_DIAGONAL	= 14,
+};
+
+struct SPathNode
+{
+	int	iScore;
+	int	idx;
+
+	bool operator < (const SPathNode & r) const
+	{
+		return iScore > r.iScore;	// priority_queue   ͺ 
+	}
+};
+
+static int GetPathHeuristic(int dx, int dy)
+{
+	dx = abs(dx);
+	dy = abs(dy);
+	return PATH_COST_STRAIGHT * (dx + dy) + (PATH_COST_DIAGONAL - 2 * PATH_COST_STRAIGHT) * MIN(dx, dy);
+}
+
+static DWORD GetPathCacheCell(long x, long y)
+{
+	DWORD cx = (x / CELL_SIZE) >> CPathFinder::CACHE_QUANT_SHIFT;
+	DWORD cy = (y / CELL_SIZE) >> CPathFinder::CACHE_QUANT_SHIFT;
+	return (cx & 0xffff) | ((cy & 0xffff) << 16);
+}
+
+CPathFinder::CPathFinder() : m_pkMap(NULL), m_lWindowX(0), m_lWindowY(0), m_iWindowWidth(0), m_iWindowHeight(0),
+	m_iBudgetPulse(0), m_iBudgetUsed(0),
+	m_dwStatRequest(0), m_dwStatStraight(0), m_dwStatCacheHit(0), m_dwStatSearch(0),
+	m_dwStatNoPath(0), m_dwStatBudgetSkip(0), m_dwStatNode(0)
+{
+}
+
+CPathFinder::~CPathFinder()
+{
+}
+
+bool CPathFinder::IsWalkable(long x, long y)
+{
+	LPSECTREE tree = m_pkMap->Find(x, y);
+
+	if (!tree)
+		return false;
+
+	return !tree->IsAttr(x, y, ATTR_BLOCK | ATTR_OBJECT);
+}
+
+//   ʴ´.     ־   ְ
+bool CPathFinder::IsLineWalkable(long sx, long sy, long ex, long ey)
+{
+	long dx = ex - sx;
+	long dy = ey - sy;
+	int iSteps = MAX(abs(dx), abs(dy)) / (CELL_SIZE / 2) + 1;
+
+	for (int i = 1; i <= iSteps; ++i)
+	{
+		if (!IsWalkable(sx + dx * i / iSteps, sy + dy * i / iSteps))
+			return false;
+	}
+
+	return true;
+}
+
+bool CPathFinder::IsStraightWalkable(long lMapIndex, long sx, long sy, long ex, long ey)
+{
+	m_pkMap = SECTREE_MANAGER::instance().GetMap(lMapIndex);
+
+	if (!m_pkMap)
+		return false;
+
+	return IsLineWalkable(sx, sy, ex, ey);
+}
+
+bool CPathFinder::IsWindowCellWalkable(int idx)
+{
+	BYTE & bFlag = m_vec_bFlag[idx];
+
+	if (!(bFlag & PATH_FLAG_CHECKED))
+	{
+		long x = (m_lWindowX + idx % m_iWindowWidth) * CELL_SIZE + CELL_SIZE / 2;
+		long y = (m_lWindowY + idx / m_iWindowWidth) * CELL_SIZE + CELL_SIZE / 2;
+
+		bFlag |= PATH_FLAG_CHECKED;
+
+		if (IsWalkable(x, y))
+			bFlag |= PATH_FLAG_WALKABLE;
+	}
+
+	return (bFlag & PATH_FLAG_WALKABLE) != 0;
+}
+
+int CPathFinder::GetNodeBudget()
+{
+	if (m_iBudgetPulse != thecore_pulse())
+	{
+		m_iBudgetPulse = thecore_pulse();
+		m_iBudgetUsed = 0;
+	}
+
+	return MAX(0, g_iPathNodeBudget - m_iBudgetUsed);
+}
+
+bool CPathFinder::Search(long sx, long sy, long ex, long ey, std::vector<PIXEL_POSITION> & r_vec_pos)
+{
+	static const int s_aiDir[8][3] =
+	{
+		{  1,  0, PATH_COST_STRAIGHT }, { -1,  0, PATH_COST_STRAIGHT },
+		{  0,  1, PATH_COST_STRAIGHT }, {  0, -1, PATH_COST_STRAIGHT },
+		{  1,  1, PATH_COST_DIAGONAL }, { -1,  1, PATH_COST_DIAGONAL },
+		{  1, -1, PATH_COST_DIAGONAL }, { -1, -1, PATH_COST_DIAGONAL },
+	};
+
+	long scx = sx / CELL_SIZE, scy = sy / CELL_SIZE;
+	long ecx = ex / CELL_SIZE, ecy = ey / CELL_SIZE;
+
+	m_lWindowX = MAX(0, MIN(scx, ecx) - WINDOW_MARGIN);
+	m_lWindowY = MAX(0, MIN(scy, ecy) - WINDOW_MARGIN);
+	m_iWindowWidth = MAX(scx, ecx) + WINDOW_MARGIN + 1 - m_lWindowX;
+	m_iWindowHeight = MAX(scy, ecy) + WINDOW_MARGIN + 1 - m_lWindowY;
+
+	r_vec_pos.clear();
+
+	if (m_iWindowWidth > WINDOW_MAX || m_iWindowHeight > WINDOW_MAX)
+		return false;
+
+	int iCellCount = m_iWindowWidth * m_iWindowHeight;
+	int iStart = (scy - m_lWindowY) * m_iWindowWidth + (scx - m_lWindowX);
+	int iGoal = (ecy - m_lWindowY) * m_iWindowWidth + (ecx - m_lWindowX);
+
+	m_vec_iCost.assign(iCellCount, INT_MAX);
+	m_vec_iParent.assign(iCellCount, -1);
+	m_vec_bFlag.assign(iCellCount, 0);
+
+	if (!IsWindowCellWalkable(iGoal))
+		return false;
+
+	std::priority_queue<SPathNode> queue;
+	SPathNode node;
+
+	m_vec_iCost[iStart] = 0;
+	node.iScore = GetPathHeuristic(ecx - scx, ecy - scy);
+	node.idx = iStart;
+	queue.push(node);
+
+	int iMaxNode = MIN((int) SEARCH_MAX_NODE, GetNodeBudget());
+	int iNode = 0;
+	bool bFound = false;
+
+	while (!queue.empty() && iNode < iMaxNode)
+	{
+		node = queue.top();
+		queue.pop();
+
+		if (m_vec_bFlag[node.idx] & PATH_FLAG_CLOSED)
+			continue;
+
+		m_vec_bFlag[node.idx] |= PATH_FLAG_CLOSED;
+		++iNode;
+
+		if (node.idx == iGoal)
+		{
+			bFound = true;
+			break;
+		}
+
+		int cx = node.idx % m_iWindowWidth;
+		int cy = node.idx / m_iWindowWidth;
+
+		for (int i = 0; i < 8; ++i)
+		{
+			int nx = cx + s_aiDir[i][0];
+			int ny = cy + s_aiDir[i][1];
+
+			if (nx < 0 || ny < 0 || nx >= m_iWindowWidth || ny >= m_iWindowHeight)
+				continue;
+
+			int nidx = ny * m_iWindowWidth + nx;
+
+			if ((m_vec_bFlag[nidx] & PATH_FLAG_CLOSED) || !IsWindowCellWalkable(nidx))
+				continue;
+
+			// 밢    շ ־ Ѵ. 𼭸  ʵ
+			if (s_aiDir[i][0] && s_aiDir[i][1])
+				if (!IsWindowCellWalkable(cy * m_iWindowWidth + nx) || !IsWindowCellWalkable(ny * m_iWindowWidth + cx))
+					continue;
+
+			int iCost = m_vec_iCost[node.idx] + s_aiDir[i][2];
+
+			if (iCost >= m_vec_iCost[nidx])
+				continue;
+
+			m_vec_iCost[nidx] = iCost;
+			m_vec_iParent[nidx] = node.idx;
+
+			SPathNode next;
+			next.iScore = iCost + GetPathHeuristic(ecx - (m_lWindowX + nx), ecy - (m_lWindowY + ny));
+			next.idx = nidx;
+			queue.push(next);
+		}
+	}
+
+	m_iBudgetUsed += iNode;
+	m_dwStatNode += iNode;
+
+	if (!bFound)
+		return false;
+
+	//  ߽ ǥ  ¤  ̴  ǳʶپ ̴  .
+	std::vector<PIXEL_POSITION> vec_posCell;
+
+	for (int idx = m_vec_iParent[iGoal]; idx >= 0 && idx != iStart; idx = m_vec_iParent[idx])
+	{
+		PIXEL_POSITION pos;
+		pos.x = (m_lWindowX + idx % m_iWindowWidth) * CELL_SIZE + CELL_SIZE / 2;
+		pos.y = (m_lWindowY + idx / m_iWindowWidth) * CELL_SIZE + CELL_SIZE / 2;
+		pos.z = 0;
+		vec_posCell.push_back(pos);
+	}
+
+	std::reverse(vec_posCell.begin(), vec_posCell.end());
+
+	PIXEL_POSITION posGoal;
+	posGoal.x = ex;
+	posGoal.y = ey;
+	posGoal.z = 0;
+	vec_posCell.push_back(posGoal);
+
+	long lFromX = sx, lFromY = sy;
+	size_t i = 0;
+
+	while (i < vec_posCell.size())
+	{
+		size_t j = i;
+
+		while (j + 1 < vec_posCell.size() && IsLineWalkable(lFromX, lFromY, vec_posCell[j + 1].x, vec_posCell[j + 1].y))
+			++j;
+
+		r_vec_pos.push_back(vec_posCell[j]);
+		lFromX = vec_posCell[j].x;
+		lFromY = vec_posCell[j].y;
+		i = j + 1;
+	}
+
+	return true;
+}
+
+void CPathFinder::InsertCache(const SCacheKey & key, const std::vector<PIXEL_POSITION> & r_vec_pos)
+{
+	if (m_map_kCache.size() >= CACHE_MAX)
+	{
+		int iNow = thecore_pulse();
+
+		for (TCacheMap::iterator it = m_map_kCache.begin(); it != m_map_kCache.end(); )
+		{
+			if (iNow - it->second.iPulse >= PASSES_PER_SEC(CACHE_LIFETIME_SEC))
+				m_map_kCache.erase(it++);
+			else
+				++it;
+		}
+
+		if (m_map_kCache.size() >= CACHE_MAX)
+			m_map_kCache.clear();
+	}
+
+	SCachePath & r = m_map_kCache[key];
+	r.iPulse = thecore_pulse();
+	r.vec_posWaypoint = r_vec_pos;
+}
+
+bool CPathFinder::GetNextWaypoint(long lMapIndex, long sx, long sy, long ex, long ey, PIXEL_POSITION & r_pos)
+{
+	if (g_iPathNodeBudget <= 0)
+		return false;
+
+	m_pkMap = SECTREE_MANAGER::instance().GetMap(lMapIndex);
+
+	if (!m_pkMap)
+		return false;
+
+	++m_dwStatRequest;
+
+	if (IsLineWalkable(sx, sy, ex, ey))
+	{
+		++m_dwStatStraight;
+		return false;
+	}
+
+	SCacheKey key;
+	key.lMapIndex = lMapIndex;
+	key.dwStart = GetPathCacheCell(sx, sy);
+	key.dwGoal = GetPathCacheCell(ex, ey);
+
+	const std::vector<PIXEL_POSITION> * pvec_pos = NULL;
+	TCacheMap::iterator it = m_map_kCache.find(key);
+
+	if (it != m_map_kCache.end() && thecore_pulse() - it->second.iPulse < PASSES_PER_SEC(CACHE_LIFETIME_SEC))
+	{
+		++m_dwStatCacheHit;
+		pvec_pos = &it->second.vec_posWaypoint;
+	}
+	else
+	{
+		if (GetNodeBudget() <= 0)
+		{
+			++m_dwStatBudgetSkip;
+			return false;
+		}
+
+		std::vector<PIXEL_POSITION> vec_pos;
+
+		++m_dwStatSearch;
+
+		if (!Search(sx, sy, ex, ey, vec_pos))
+			++m_dwStatNoPath;
+
+		//   ͵ ־ ξ   Ź ٽ ã ʰ Ѵ.
+		InsertCache(key, vec_pos);
+		pvec_pos = &m_map_kCache[key].vec_posWaypoint;
+	}
+
+	if (pvec_pos->empty())
+		return false;
+
+	// ĳõ   ٸ ڸ ã   Ƿ  ڸ ̴    .
+	size_t iPick = 0;
+
+	for (size_t i = MIN(pvec_pos->size(), (size_t) 4); i > 1; --i)
+	{
+		if (IsLineWalkable(sx, sy, (*pvec_pos)[i - 1].x, (*pvec_pos)[i - 1].y))
+		{
+			iPick = i - 1;
+			break;
+		}
+	}
+
+	r_pos = (*pvec_pos)[iPick];
+	return true;
+}
+
+void CPathFinder::ClearMap(long lMapIndex)
+{
+	for (TCacheMap::iterator it = m_map_kCache.begin(); it != m_map_kCache.end(); )
+	{
+		if (it->first.lMapIndex == lMapIndex)
+			m_map_kCache.erase(it++);
+		else
+			++it;
+	}
+}
+
+void CPathFinder::DumpStat()
+{
+	if (m_dwStatRequest)
+	{
+		sys_log(0, "PATH_STAT: request %u straight %u cache_hit %u search %u no_path %u budget_skip %u nodes %u avg %.1f cache %u",
+				m_dwStatRequest, m_dwStatStraight, m_dwStatCacheHit, m_dwStatSearch, m_dwStatNoPath, m_dwStatBudgetSkip,
+				m_dwStatNode, m_dwStatSearch ? (float) m_dwStatNode / m_dwStatSearch : 0.0f, m_map_kCache.size());
+	}
+
+	m_dwStatRequest = 0;
+	m_dwStatStraight = 0;
+	m_dwStatCacheHit = 0;
+	m_dwStatSearch = 0;
+	m_dwStatNoPath = 0;
+	m_dwStatBudgetSkip = 0;
+	m_dwStatNode = 0;
+}
@@ -0,0 +1,92 @@
+#ifndef __INC_METIN_II_GAME_PATH_FINDER_H__
+#define __INC_METIN_II_GAME_PATH_FINDER_H__
+
+//
+//    ã. sectree Ӽ ATTR_BLOCK | ATTR_OBJECT  ؼ
+//  ǥ ֺ â ȿ A*  ã, ã   ĳ д.
+//  pulse  ġ   path_node_budget  Ѵ.
+//
+class CPathFinder : public singleton<CPathFinder>
+{
+	public:
+		enum
+		{
+			WINDOW_MARGIN		= 16,	// , ǥ ٱ    
+			WINDOW_MAX		= 128,	// â   ִ  . ̺ ָ ã ʴ´
+			SEARCH_MAX_NODE		= 4096,	//   ã  ġ ִ  
+			CACHE_QUANT_SHIFT	= 2,	// ĳ Ű 4  (200) 
+			CACHE_MAX		= 4096,
+			CACHE_LIFETIME_SEC	= 3,
+		};
+
+		CPathFinder();
+		virtual ~CPathFinder();
+
+		// (sx, sy)  (ex, ey)        r_pos  ش.
+		//    ְų,  ų, ̹ pulse    false
+		bool	GetNextWaypoint(long lMapIndex, long sx, long sy, long ex, long ey, PIXEL_POSITION & r_pos);
+		bool	IsStraightWalkable(long lMapIndex, long sx, long sy, long ex, long ey);
+
+		void	ClearMap(long lMapIndex);	// private map   
+		void	DumpStat();
+
+	private:
+		struct SCacheKey
+		{
+			long	lMapIndex;
+			DWORD	dwStart;
+			DWORD	dwGoal;
+
+			bool operator < (const SCacheKey & r) const
+			{
+				if (lMapIndex != r.lMapIndex)
+					return lMapIndex < r.lMapIndex;
+
+				if (dwStart != r.dwStart)
+					return dwStart < r.dwStart;
+
+				return dwGoal < r.dwGoal;
+			}
+		};
+
+		struct SCachePath
+		{
+			int				iPulse;
+			std::vector<PIXEL_POSITION>	vec_posWaypoint;	//    
+		};
+
+		typedef std::map<SCacheKey, SCachePath> TCacheMap;
+
+		bool	IsWalkable(long x, long y);
+		bool	IsLineWalkable(long sx, long sy, long ex, long ey);
+		bool	IsWindowCellWalkable(int idx);
+		bool	Search(long sx, long sy, long ex, long ey, std::vector<PIXEL_POSITION> & r_vec_pos);
+		int	GetNodeBudget();
+		void	InsertCache(const SCacheKey & key, const std::vector<PIXEL_POSITION> & r_vec_pos);
+
+		LPSECTREE_MAP	m_pkMap;	//  ã ִ 
+
+		// ã â.  ǥ  ǥ / CELL_SIZE
+		long		m_lWindowX;
+		long		m_lWindowY;
+		int		m_iWindowWidth;
+		int		m_iWindowHeight;
+		std::vector<int>	m_vec_iCost;
+		std::vector<int>	m_vec_iParent;
+		std::vector<BYTE>	m_vec_bFlag;
+
+		TCacheMap	m_map_kCache;
+
+		int		m_iBudgetPulse;
+		int		m_iBudgetUsed;
+
+		DWORD		m_dwStatRequest;
+		DWORD		m_dwStatStraight;
+		DWORD		m_dwStatCacheHit;
+		DWORD		m_dwStatSearch;
+		DWORD		m_dwStatNoPath;
+		DWORD		m_dwStatBudgetSkip;
+		DWORD		m_dwStatNode;
+};
+
+#endif
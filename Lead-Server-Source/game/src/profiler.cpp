@@ -0,0 +1,227 @@
+#include "stdafx.h"
+#include "char.h"
+#include "profiler.h"
+
+const char *	CProfiler::ms_apszScopeName[CProfiler::SCOPE_MAX_NUM] = { "root" };
+int		CProfiler::ms_iScopeCount = 1;
+const char *	CProfiler::ms_apszHashKey[CProfiler::SCOPE_HASH_SIZE];
+WORD		CProfiler::ms_awHashScope[CProfiler::SCOPE_HASH_SIZE];
+
+CProfiler::CProfiler() : m_bEnabled(false), m_bResetRequested(false)
+{
+	m_akNode.resize(NODE_MAX_NUM);
+	Clear();
+}
+
+CProfiler::~CProfiler()
+{
+}
+
+WORD CProfiler::RegisterScope(const char * c_pszName)
+{
+	DWORD dwHash = (DWORD) ((size_t) c_pszName >> 3) * 2654435761U;
+	int iSlot = dwHash % SCOPE_HASH_SIZE;
+
+	for (int i = 0; i < SCOPE_HASH_SIZE; ++i, iSlot = (iSlot + 1) % SCOPE_HASH_SIZE)
+	{
+		if (ms_apszHashKey[iSlot] == c_pszName)
+			return ms_awHashScope[iSlot];
+
+		if (ms_apszHashKey[iSlot])
+			continue;
+
+		// ó  .  ̸ ٸ   ϵǾ  ִ.
+		WORD wScope = 0;
+
+		for (int j = 1; j < ms_iScopeCount; ++j)
+		{
+			if (!strcmp(ms_apszScopeName[j], c_pszName))
+			{
+				wScope = j;
+				break;
+			}
+		}
+
+		if (!wScope)
+		{
+			if (ms_iScopeCount >= SCOPE_MAX_NUM)
+			{
+				sys_err("too many profiler scopes, %s is counted as root", c_pszName);
+				return 0;
+			}
+
+			wScope = ms_iScopeCount;
+			ms_apszScopeName[ms_iScopeCount++] = c_pszName;
+		}
+
+		ms_apszHashKey[iSlot] = c_pszName;
+		ms_awHashScope[iSlot] = wScope;
+		return wScope;
+	}
+
+	return 0;
+}
+
+const char * CProfiler::GetScopeName(WORD wScope)
+{
+	if (wScope >= ms_iScopeCount)
+		return "unknown";
+
+	return ms_apszScopeName[wScope];
+}
+
+void CProfiler::Enable(bool bEnable)
+{
+	if (bEnable && !m_bEnabled && m_iStackDepth == 0)
+		Clear();
+
+	m_bEnabled = bEnable;
+}
+
+void CProfiler::Reset()
+{
+	if (m_iStackDepth == 0)
+		Clear();
+	else
+		m_bResetRequested = true;	//  ٱ    
+}
+
+void CProfiler::Clear()
+{
+	TProfileNode & rRoot = m_akNode[0];
+	memset(&rRoot, 0, sizeof(rRoot));
+	rRoot.iParent = -1;
+	rRoot.iFirstChild = -1;
+	rRoot.iNextSibling = -1;
+
+	m_iNodeCount = 1;
+	m_dwDroppedCount = 0;
+	m_iStackDepth = 0;
+	m_iDepthOverflow = 0;
+	m_bResetRequested = false;
+
+	m_qwStartTick = Tick();
+	gettimeofday(&m_tvStart, (struct timezone *) 0);
+}
+
+int CProfiler::FindChild(int iParent, WORD wScope)
+{
+	if (iParent < 0)
+		return -1;
+
+	int iNode = m_akNode[iParent].iFirstChild;
+
+	while (iNode >= 0)
+	{
+		if (m_akNode[iNode].wScope == wScope)
+			return iNode;
+
+		iNode = m_akNode[iNode].iNextSibling;
+	}
+
+	if (m_iNodeCount >= NODE_MAX_NUM)
+	{
+		++m_dwDroppedCount;
+		return -1;
+	}
+
+	iNode = m_iNodeCount++;
+
+	TProfileNode & rNode = m_akNode[iNode];
+	rNode.wScope = wScope;
+	rNode.iParent = iParent;
+	rNode.iFirstChild = -1;
+	rNode.iNextSibling = m_akNode[iParent].iFirstChild;
+	rNode.dwCallCount = 0;
+	rNode.qwTicks = 0;
+
+	m_akNode[iParent].iFirstChild = iNode;
+	return iNode;
+}
+
+double CProfiler::GetTicksPerUSec() const
+{
+	struct timeval now;
+	gettimeofday(&now, (struct timezone *) 0);
+
+	double dUSec = (now.tv_sec - m_tvStart.tv_sec) * 1000000.0 + (now.tv_usec - m_tvStart.tv_usec);
+
+	if (dUSec < 1000.0)
+		return 1.0;
+
+	return (Tick() - m_qwStartTick) / dUSec;
+}
+
+bool CProfiler::Dump(const char * c_pszFileName)
+{
+	FILE * fp = fopen(c_pszFileName, "w");
+
+	if (!fp)
+	{
+		sys_err("cannot open %s", c_pszFileName);
+		return false;
+	}
+
+	double dTicksPerUSec = GetTicksPerUSec();
+	std::string stPath;
+
+	// Ʈ Ʒ  켱  ڱ ð(ڽ ð  ð) .
+	int iNode = m_akNode[0].iFirstChild;
+
+	while (iNode > 0)
+	{
+		const TProfileNode & rNode = m_akNode[iNode];
+
+		stPath.clear();
+
+		for (int i = iNode; i > 0; i = m_akNode[i].iParent)
+		{
+			if (!stPath.empty())
+				stPath.insert(0, ";");
+
+			stPath.insert(0, GetScopeName(m_akNode[i].wScope));
+		}
+
+		uint64_t qwSelf = rNode.qwTicks;
+
+		for (int iChild = rNode.iFirstChild; iChild >= 0; iChild = m_akNode[iChild].iNextSibling)
+			qwSelf = qwSelf > m_akNode[iChild].qwTicks ? qwSelf - m_akNode[iChild].qwTicks : 0;
+
+		DWORD dwSelfUSec = (DWORD) (qwSelf / dTicksPerUSec);
+
+		if (dwSelfUSec)
+			fprintf(fp, "%s %u\n", stPath.c_str(), dwSelfUSec);
+
+		if (rNode.iFirstChild >= 0)
+		{
+			iNode = rNode.iFirstChild;
+			continue;
+		}
+
+		while (iNode > 0 && m_akNode[iNode].iNextSibling < 0)
+			iNode = m_akNode[iNode].iParent;
+
+		if (iNode > 0)
+			iNode = m_akNode[iNode].iNextSibling;
+	}
+
+	fclose(fp);
+	return true;
+}
+
+void CProfiler::Print(LPCHARACTER ch)
+{
+	ch->ChatPacket(CHAT_TYPE_INFO, "profiler %s scopes %d nodes %d/%d dropped %u ticks/us %.1f",
+			m_bEnabled ? "on" : "off", ms_iScopeCount - 1, m_iNodeCount, NODE_MAX_NUM,
+			m_dwDroppedCount, GetTicksPerUSec());
+
+	// Ʈ ٷ Ʒ   ð
+	double dTicksPerUSec = GetTicksPerUSec();
+
+	for (int iNode = m_akNode[0].iFirstChild; iNode >= 0; iNode = m_akNode[iNode].iNextSibling)
+	{
+		const TProfileNode & rNode = m_akNode[iNode];
+		ch->ChatPacket(CHAT_TYPE_INFO, "  %-20s calls %u total %.0f ms",
+				GetScopeName(rNode.wScope), rNode.dwCallCount, rNode.qwTicks / dTicksPerUSec / 1000.0);
+	}
+}
@@ -1,274 +1,181 @@
 #ifndef __INC_METIN_II_GAME_PROFILER_H__
 #define __INC_METIN_II_GAME_PROFILER_H__
 
-#include <boost/unordered_map.hpp>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
+//   Ϸ.     bool ϳ .
+//
+//  ̸  ڿ̾ ϸ ó    ID  ϵȴ.
+//  ִ  ȣ Ʈ  ũ  迭 TSC ƽ װ,
+// Dump()  flamegraph.pl  д folded stack (a;b;c usec) .
+//   ̴. ٸ 忡 θ ڵ忡   ʴ´.
 class CProfiler : public singleton<CProfiler>
 {
 	public:
 		enum
 		{
-			STACK_DATA_MAX_NUM = 64,
+			SCOPE_MAX_NUM	= 1024,
+			SCOPE_HASH_SIZE	= 2048,
+			NODE_MAX_NUM	= 8192,
+			DEPTH_MAX_NUM	= 64,
 		};
 
-	public:
-		typedef struct SProfileStackData
+		typedef struct SProfileNode
 		{
-			int iCallStep;
-			long iStartTime;
-			long iEndTime;
+			WORD		wScope;
+			int		iParent;
+			int		iFirstChild;
+			int		iNextSibling;
+			DWORD		dwCallCount;
+			uint64_t	qwTicks;
+		} TProfileNode;
 
-			std::string strName;
-		} TProfileStackData;
-
-		typedef struct SProfileAccumData
-		{
-			int iStartTime;
-			int iCallingCount;
-			int iCollapsedTime;
-			int iDepth;
-
-			std::string strName;
-		} TProfileAccumData;
-
-		struct stringhash
+		typedef struct SProfileStackData
 		{
-			size_t operator () (const std::string& str) const
-			{
-				const unsigned char * s = (const unsigned char *) str.c_str();
-				const unsigned char * end = s + str.size();
-				size_t h = 0;
-
-				while (s < end)
-				{
-					h *= 16777619;
-					h ^= (unsigned char) *(unsigned char *) (s++);
-				}
-
-				return h;
-
-			}
-		};
-
-		typedef boost::unordered_map<std::string, TProfileAccumData> TProfileAccumDataMap;
+			int		iNode;		// -1 ̸  ʴ ׸ ( )
+			uint64_t	qwStartTick;
+		} TProfileStackData;
 
 	public:
-		CProfiler()
-		{
-			Initialize();
-		}
-
-		virtual ~CProfiler()
-		{
-		}
-
-		void Initialize()
-		{
-			m_iAccumDepth = 0;
-			m_ProfileStackDataCount = 0;
-			m_iCallStep = 0;
-		}
-
-		void Clear()
-		{
-			TProfileAccumDataMap::iterator it = m_ProfileAccumDataMap.begin();
-
-			for (; it != m_ProfileAccumDataMap.end(); ++it)
-			{
-				TProfileAccumData & rData = it->second;
-				rData.iCallingCount = 0;
-				rData.iCollapsedTime = 0;
-			}
-
-			Initialize();
+		CProfiler();
+		virtual ~CProfiler();
+
+		//  ʹ  ID. ó  ʹ ̸    ã´.
+		static WORD	RegisterScope(const char * c_pszName);
+		static const char *	GetScopeName(WORD wScope);
+
+		static uint64_t	Tick()
+		{
+#if defined(_MSC_VER)
+			return __rdtsc();
+#elif defined(__i386__) || defined(__x86_64__)
+			unsigned int lo, hi;
+			__asm__ __volatile__ ("rdtsc" : "=a" (lo), "=d" (hi));
+			return ((uint64_t) hi << 32) | lo;
+#else
+			struct timeval tv;
+			gettimeofday(&tv, (struct timezone *) 0);
+			return (uint64_t) tv.tv_sec * 1000000 + tv.tv_usec;
+#endif
 		}
 
-		void Push(const char * c_szName)
-		{
-			assert(m_ProfileStackDataCount < STACK_DATA_MAX_NUM);
-			TProfileStackData & rProfileStackData = m_ProfileStackDatas[m_ProfileStackDataCount++];
-
-			rProfileStackData.iCallStep = m_iCallStep;
-			rProfileStackData.iStartTime = get_dword_time();
-			rProfileStackData.strName = c_szName;
-
-			++m_iCallStep;
-		}
+		void		Enable(bool bEnable);
+		bool		IsEnabled() const	{ return m_bEnabled; }
+		void		Reset();	//     ڿ 
 
-		void Pop(const char * c_szName)
+		void		Enter(WORD wScope)
 		{
-			TProfileStackData * pProfileStackData;
+			if (m_iStackDepth == 0 && m_bResetRequested)
+				Clear();
 
-			if (!GetProfileStackDataPointer(c_szName, &pProfileStackData))
+			if (m_iStackDepth >= DEPTH_MAX_NUM)
 			{
-				assert(!"The name doesn't exist");
+				++m_iDepthOverflow;
 				return;
 			}
 
-			pProfileStackData->iEndTime = get_dword_time();
-			--m_iCallStep;
+			TProfileStackData & rData = m_aStack[m_iStackDepth++];
+			rData.iNode = FindChild(m_iStackDepth >= 2 ? m_aStack[m_iStackDepth - 2].iNode : 0, wScope);
+			rData.qwStartTick = Tick();
 		}
 
-		__inline void PushAccum(const char * c_szName)
+		void		Leave()
 		{
-			TProfileAccumDataMap::iterator it = m_ProfileAccumDataMap.find(c_szName);
-
-			if (it == m_ProfileAccumDataMap.end())
+			if (m_iDepthOverflow)
 			{
-				TProfileAccumData ProfileAccumData;
-
-				ProfileAccumData.iCollapsedTime = 0;
-				ProfileAccumData.iCallingCount = 0;
-				ProfileAccumData.strName = c_szName;
-				ProfileAccumData.iDepth = m_iAccumDepth;
-
-				m_ProfileAccumDataMap.insert(TProfileAccumDataMap::value_type(c_szName, ProfileAccumData));
-				it = m_ProfileAccumDataMap.find(c_szName);
-				m_vec_Accum.push_back(&it->second);
+				--m_iDepthOverflow;
+				return;
 			}
 
-			TProfileAccumData & rData = it->second;
-			rData.iStartTime = get_dword_time();
-			++m_iAccumDepth;
-		}
-
-		__inline void PopAccum(const char * c_szName)
-		{
-			TProfileAccumDataMap::iterator it = m_ProfileAccumDataMap.find(c_szName);
-
-			if (it == m_ProfileAccumDataMap.end())
+			if (m_iStackDepth == 0)
 				return;
 
-			TProfileAccumData & rData = it->second;
-			rData.iCollapsedTime += get_dword_time() - rData.iStartTime;
-			++rData.iCallingCount;
-			--m_iAccumDepth;
-		}
-
-		void Log(const char * c_pszFileName)
-		{
-			FILE * fp = fopen(c_pszFileName, "w");
+			TProfileStackData & rData = m_aStack[--m_iStackDepth];
 
-			if (!fp)
+			if (rData.iNode < 0)
 				return;
 
-			Print(fp);
-			fclose(fp);
+			TProfileNode & rNode = m_akNode[rData.iNode];
+			++rNode.dwCallCount;
+			rNode.qwTicks += Tick() - rData.qwStartTick;
 		}
 
-		void Print(FILE * fp = stderr)
-		{
-			for (int i = 0; i < m_ProfileStackDataCount; ++i)
-			{
-				TProfileStackData & rProfileStackData = m_ProfileStackDatas[i];
-
-				for (int i = 0; i < rProfileStackData.iCallStep; ++i)
-					fprintf(fp, "\t");
-
-				fprintf(fp, "%-24s: %lu\n", rProfileStackData.strName.c_str(), rProfileStackData.iEndTime - rProfileStackData.iStartTime);
-			}
-
-			fprintf(fp, "Name                                 Call/Load       Ratio\n");
-
-			std::string stLine;
-
-			for (DWORD k = 0; k < m_vec_Accum.size(); ++k)
-			{
-				TProfileAccumData * p = m_vec_Accum[k];
-
-				stLine.assign(p->iDepth * 5, ' ');
-				stLine += p->strName;
+		bool		Dump(const char * c_pszFileName);
+		void		Print(LPCHARACTER ch);
 
-				fprintf(fp, "%-30s %10d/%-10d %.2f\n", 
-						stLine.c_str(),
-						p->iCallingCount, p->iCollapsedTime,
-						p->iCallingCount != 0 ? (float) p->iCollapsedTime / p->iCallingCount : 0.0f);
-			}
-		}
+	protected:
+		void		Clear();
+		int		FindChild(int iParent, WORD wScope);
+		double		GetTicksPerUSec() const;
 
-		void PrintOneStackData(const char * c_szName)
-		{
-			TProfileStackData * pProfileStackData;
+	protected:
+		bool			m_bEnabled;
+		bool			m_bResetRequested;
 
-			if (!GetProfileStackDataPointer(c_szName, &pProfileStackData))
-				return;
+		std::vector<TProfileNode>	m_akNode;	// NODE_MAX_NUM  ̸  д. 0  Ʈ
+		int			m_iNodeCount;
+		DWORD			m_dwDroppedCount;
 
-			sys_log(0, "%-10s: %3d", pProfileStackData->strName.c_str(), pProfileStackData->iEndTime - pProfileStackData->iStartTime);
-		}
+		TProfileStackData	m_aStack[DEPTH_MAX_NUM];
+		int			m_iStackDepth;
+		int			m_iDepthOverflow;
 
-		void PrintOneAccumData(const char * c_szName)
-		{
-			TProfileAccumDataMap::iterator it = m_ProfileAccumDataMap.find(c_szName);
+		uint64_t		m_qwStartTick;	// ƽ ð    
+		struct timeval		m_tvStart;
 
-			if (it == m_ProfileAccumDataMap.end())
-				return;
-
-			TProfileAccumData & rData = it->second;
-
-			sys_log(0, "%-10s : [CollapsedTime : %3d] / [CallingCount : %3d]",
-					rData.strName.c_str(),
-					rData.iCollapsedTime,
-					rData.iCallingCount);
-		}
+		static const char *	ms_apszScopeName[SCOPE_MAX_NUM];
+		static int		ms_iScopeCount;
+		static const char *	ms_apszHashKey[SCOPE_HASH_SIZE];
+		static WORD		ms_awHashScope[SCOPE_HASH_SIZE];
+};
 
-	protected:
-		bool GetProfileStackDataPointer(const char * c_szName, TProfileStackData ** ppProfileStackData)
+class CProfileUnit
+{
+	public:
+		explicit CProfileUnit(WORD wScope) : m_bPushed(false)
 		{
-			for (int i = 0; i < m_ProfileStackDataCount; ++i)
+			if (CProfiler::instance().IsEnabled())
 			{
-				if (0 == m_ProfileStackDatas[i].strName.compare(c_szName))
-				{
-					*ppProfileStackData = &m_ProfileStackDatas[i];
-
-					return true;
-				}
+				CProfiler::instance().Enter(wScope);
+				m_bPushed = true;
 			}
-
-			return false;
 		}
 
-	protected:
-		// Profile Stack Data
-		int m_ProfileStackDataCount;
-		TProfileStackData m_ProfileStackDatas[STACK_DATA_MAX_NUM];
-
-		// Profile Accum Data
-		TProfileAccumDataMap			m_ProfileAccumDataMap;
-		std::vector<TProfileAccumData *>	m_vec_Accum;
-		int					m_iAccumDepth;
-
-		int					m_iCallStep;
-};
-
-template <typename T> class CProfileUnit
-{
-	public:
-		CProfileUnit(const char * c_pszName)
+		// Ŷ ̸ó  ߿  ̸.  ؽø    ģ.
+		explicit CProfileUnit(const char * c_pszName) : m_bPushed(false)
 		{
-			m_stName = c_pszName;
-			CProfiler::instance().PushAccum(m_stName.c_str());
-			m_bPushed = true;
+			if (CProfiler::instance().IsEnabled())
+			{
+				CProfiler::instance().Enter(CProfiler::RegisterScope(c_pszName));
+				m_bPushed = true;
+			}
 		}
 
 		~CProfileUnit()
 		{
-			if (m_bPushed)
-				Pop();
+			Pop();
 		}
 
 		void Pop()
 		{
 			if (m_bPushed)
 			{
-				CProfiler::instance().PopAccum(m_stName.c_str());
+				CProfiler::instance().Leave();
 				m_bPushed = false;
 			}
 		}
 
-		std::string	m_stName;
+	protected:
 		bool		m_bPushed;
 };
 
-#define PROF_UNIT CProfileUnit<void>
+#define PROF_UNIT CProfileUnit
+
+// PROF_SCOPE(puEvent, "event"); ó . ID  ó     ϵȴ.
+#define PROF_SCOPE(var, name) \
+	static const WORD var##_scope = CProfiler::RegisterScope(name); \
+	CProfileUnit var(var##_scope)
 
 #endif
@@ -0,0 +1,182 @@
+#include "stdafx.h"
+#include "utils.h"
+#include "config.h"
+#include "char.h"
+#include "pulse_stat.h"
+
+static const char * s_apszPulseStatName[PULSE_STAT_MAX_NUM] =
+{
+	"event",
+	"heartbeat",
+	"chr_update",
+	"io",
+	"idle_loop",
+};
+
+static HISTOGRAM	s_akPulseHistogram[PULSE_STAT_MAX_NUM];
+static HISTOGRAM	s_akPulseHistogramTotal[PULSE_STAT_MAX_NUM];	//  ʴ  (metrics )
+static DWORD		s_dwOverrunTotal = 0;
+static DWORD		s_dwSkippedPulseTotal = 0;
+static DWORD		s_dwPulseCount = 0;
+static DWORD		s_dwOverrunCount = 0;	// passed_pulses  2 ̻̾ Ƚ
+static DWORD		s_dwSkippedPulse = 0;	// ׶ и pulse 
+static int		s_iMaxPassedPulse = 0;
+static time_t		s_tWindowStart = 0;
+
+DWORD pulse_stat_usec()
+{
+	struct timeval tv;
+	gettimeofday(&tv, (struct timezone *) 0);
+	return (DWORD) (tv.tv_sec * 1000000 + tv.tv_usec);
+}
+
+void pulse_stat_record(int iStat, DWORD dwUSec)
+{
+	if (iStat < 0 || iStat >= PULSE_STAT_MAX_NUM)
+		return;
+
+	histogram_record(&s_akPulseHistogram[iStat], dwUSec);
+	histogram_record(&s_akPulseHistogramTotal[iStat], dwUSec);
+}
+
+void pulse_stat_record_passed(int iPassedPulses)
+{
+	s_dwPulseCount += iPassedPulses;
+
+	if (iPassedPulses > 1)
+	{
+		++s_dwOverrunCount;
+		s_dwSkippedPulse += iPassedPulses - 1;
+		++s_dwOverrunTotal;
+		s_dwSkippedPulseTotal += iPassedPulses - 1;
+	}
+
+	if (iPassedPulses > s_iMaxPassedPulse)
+		s_iMaxPassedPulse = iPassedPulses;
+}
+
+void pulse_stat_reset()
+{
+	for (int i = 0; i < PULSE_STAT_MAX_NUM; ++i)
+		histogram_reset(&s_akPulseHistogram[i]);
+
+	s_dwPulseCount = 0;
+	s_dwOverrunCount = 0;
+	s_dwSkippedPulse = 0;
+	s_iMaxPassedPulse = 0;
+	s_tWindowStart = get_global_time();
+}
+
+void pulse_stat_update()
+{
+	if (!s_tWindowStart)
+	{
+		s_tWindowStart = get_global_time();
+		return;
+	}
+
+	if (g_iPulseStatInterval <= 0 || get_global_time() - s_tWindowStart < g_iPulseStatInterval)
+		return;
+
+	pulse_stat_write("pulse_stat.txt");
+	pulse_stat_reset();
+}
+
+static int pulse_stat_format_header(char * buf, int size)
+{
+	return snprintf(buf, size, "pulse time=%ld window=%ld pulses=%u overrun=%u skipped=%u max_passed=%d budget_us=%d",
+			(long) get_global_time(), (long) (get_global_time() - s_tWindowStart),
+			s_dwPulseCount, s_dwOverrunCount, s_dwSkippedPulse, s_iMaxPassedPulse, 1000000 / passes_per_sec);
+}
+
+static int pulse_stat_format_line(int iStat, char * buf, int size)
+{
+	const HISTOGRAM & h = s_akPulseHistogram[iStat];
+
+	return snprintf(buf, size, "%s count=%u p50=%u p90=%u p99=%u p999=%u max=%u mean=%u",
+			s_apszPulseStatName[iStat],
+			h.total_count,
+			histogram_percentile(&h, 50.0),
+			histogram_percentile(&h, 90.0),
+			histogram_percentile(&h, 99.0),
+			histogram_percentile(&h, 99.9),
+			h.max_value,
+			histogram_mean(&h));
+}
+
+bool pulse_stat_write(const char * c_pszFileName)
+{
+	char szTempName[256];
+	char buf[256];
+
+	// д      ʵ ٸ ̸  ٲ۴.
+	snprintf(szTempName, sizeof(szTempName), "%s.tmp", c_pszFileName);
+
+	FILE * fp = fopen(szTempName, "w");
+
+	if (!fp)
+	{
+		sys_err("cannot open %s", szTempName);
+		return false;
+	}
+
+	pulse_stat_format_header(buf, sizeof(buf));
+	fprintf(fp, "%s\n", buf);
+
+	for (int i = 0; i < PULSE_STAT_MAX_NUM; ++i)
+	{
+		pulse_stat_format_line(i, buf, sizeof(buf));
+		fprintf(fp, "%s\n", buf);
+	}
+
+	fclose(fp);
+
+#ifdef __WIN32__
+	remove(c_pszFileName);
+#endif
+	if (rename(szTempName, c_pszFileName) != 0)
+	{
+		sys_err("cannot rename %s to %s", szTempName, c_pszFileName);
+		return false;
+	}
+
+	return true;
+}
+
+static double pulse_stat_metric_overrun()
+{
+	return s_dwOverrunTotal;
+}
+
+static double pulse_stat_metric_skipped()
+{
+	return s_dwSkippedPulseTotal;
+}
+
+void pulse_stat_register_metrics()
+{
+	char szName[128];
+
+	for (int i = 0; i < PULSE_STAT_MAX_NUM; ++i)
+	{
+		snprintf(szName, sizeof(szName), "game_pulse_usec{stage=\"%s\"}", s_apszPulseStatName[i]);
+		metrics_histogram(szName, "pulse processing time per stage in microseconds", &s_akPulseHistogramTotal[i]);
+	}
+
+	metrics_func(METRIC_COUNTER, "game_pulse_overrun_total", "idle loops that ran more than one pulse", pulse_stat_metric_overrun);
+	metrics_func(METRIC_COUNTER, "game_pulse_skipped_total", "pulses run late because of overruns", pulse_stat_metric_skipped);
+}
+
+void pulse_stat_print(LPCHARACTER ch)
+{
+	char buf[256];
+
+	pulse_stat_format_header(buf, sizeof(buf));
+	ch->ChatPacket(CHAT_TYPE_INFO, "%s", buf);
+
+	for (int i = 0; i < PULSE_STAT_MAX_NUM; ++i)
+	{
+		pulse_stat_format_line(i, buf, sizeof(buf));
+		ch->ChatPacket(CHAT_TYPE_INFO, "%s", buf);
+	}
+}
@@ -0,0 +1,29 @@
+#ifndef __INC_METIN_II_GAME_PULSE_STAT_H__
+#define __INC_METIN_II_GAME_PULSE_STAT_H__
+
+//
+// pulse ó ð  ׷(us)  p50/p99/max  .
+// ո  pt_log δ  Ƣ pulse   ʱ ̴.
+// pulse_stat_interval ʸ pulse_stat.txt   .
+//
+enum EPulseStat
+{
+	PULSE_STAT_EVENT,	// event_process
+	PULSE_STAT_HEARTBEAT,	// heartbeat  
+	PULSE_STAT_CHR_UPDATE,	// CHARACTER_MANAGER::Update
+	PULSE_STAT_IO,		// io_loop  flush
+	PULSE_STAT_IDLE_LOOP,	// idle()   ü
+	PULSE_STAT_MAX_NUM
+};
+
+extern DWORD	pulse_stat_usec();
+extern void	pulse_stat_record(int iStat, DWORD dwUSec);
+extern void	pulse_stat_record_passed(int iPassedPulses);	// passed_pulses > 1 ̸ overrun
+
+extern void	pulse_stat_update();	//  ҷ ָ ֱ⸶  
+extern void	pulse_stat_reset();
+extern bool	pulse_stat_write(const char * c_pszFileName);
+extern void	pulse_stat_print(LPCHARACTER ch);
+extern void	pulse_stat_register_metrics();	//    ׷ metrics  Ѵ
+
+#endif
@@ -1,7 +1,6 @@
 #include "stdafx.h"
 #include "constants.h"
 #include "pvp.h"
-#include "crc32.h"
 #include "packet.h"
 #include "desc.h"
 #include "desc_manager.h"
@@ -29,10 +28,7 @@ CPVP::CPVP(DWORD dwPID1, DWORD dwPID2)
 		m_players[1].bAgree = true;
 	}
 
-	DWORD adwID[2];
-	adwID[0] = m_players[0].dwPID;
-	adwID[1] = m_players[1].dwPID;
-	m_dwCRC = GetFastHash((const char *) &adwID, 8);
+	m_qwKey = MakeKey(dwPID1, dwPID2);
 	m_bRevenge = false;
 
 	SetLastFightTime();
@@ -43,7 +39,7 @@ CPVP::CPVP(CPVP & k)
 	m_players[0] = k.m_players[0];
 	m_players[1] = k.m_players[1];
 
-	m_dwCRC = k.m_dwCRC;
+	m_qwKey = k.m_qwKey;
 	m_bRevenge = k.m_bRevenge;
 
 	SetLastFightTime();
@@ -178,7 +174,7 @@ void CPVPManager::Insert(LPCHARACTER pkChr, LPCHARACTER pkVictim)
 
 	CPVP * pkPVP;
 
-	if ((pkPVP = Find(kPVP.m_dwCRC)))
+	if ((pkPVP = Find(kPVP.m_qwKey)))
 	{
 		//    ٷ ο!
 		if (pkPVP->Agree(pkChr->GetPlayerID()))
@@ -194,11 +190,14 @@ void CPVPManager::Insert(LPCHARACTER pkChr, LPCHARACTER pkVictim)
 	pkPVP->SetVID(pkChr->GetPlayerID(), pkChr->GetVID());
 	pkPVP->SetVID(pkVictim->GetPlayerID(), pkVictim->GetVID());
 
-	m_map_pkPVP.insert(map<DWORD, CPVP *>::value_type(pkPVP->m_dwCRC, pkPVP));
+	m_map_pkPVP.insert(CPVPMap::value_type(pkPVP->m_qwKey, pkPVP));
 
 	m_map_pkPVPSetByID[pkChr->GetPlayerID()].insert(pkPVP);
 	m_map_pkPVPSetByID[pkVictim->GetPlayerID()].insert(pkPVP);
 
+	pkChr->SetHasPVP(true);
+	pkVictim->SetHasPVP(true);
+
 	pkPVP->Packet();
 
 	char msg[CHAT_MAX_LEN + 1];
@@ -251,6 +250,19 @@ void CPVPManager::ConnectEx(LPCHARACTER pkChr, bool bDisconnect)
 void CPVPManager::Connect(LPCHARACTER pkChr)
 {
 	ConnectEx(pkChr, false);
+	UpdateHasPVP(pkChr->GetPlayerID());
+}
+
+// ĳ   ÷׸ m_map_pkPVPSetByID  .    α  .
+void CPVPManager::UpdateHasPVP(DWORD dwPID)
+{
+	LPCHARACTER ch = CHARACTER_MANAGER::instance().FindByPID(dwPID);
+
+	if (!ch)
+		return;
+
+	CPVPSetMap::iterator it = m_map_pkPVPSetByID.find(dwPID);
+	ch->SetHasPVP(it != m_map_pkPVPSetByID.end() && !it->second.empty());
 }
 
 void CPVPManager::Disconnect(LPCHARACTER pkChr)
@@ -291,7 +303,10 @@ void CPVPManager::GiveUp(LPCHARACTER pkChr, DWORD dwKillerPID) // This method is
 		if (it->second.empty())
 			m_map_pkPVPSetByID.erase(it);
 
-		m_map_pkPVP.erase(pkPVP->m_dwCRC);
+		m_map_pkPVP.erase(pkPVP->m_qwKey);
+
+		UpdateHasPVP(pkChr->GetPlayerID());
+		UpdateHasPVP(dwCompanionPID);
 
 		pkPVP->Packet(true);
 		M2_DELETE(pkPVP);
@@ -533,8 +548,11 @@ bool CPVPManager::CanAttack(LPCHARACTER pkChr, LPCHARACTER pkVictim)
 		}
 	}
 
-	CPVP kPVP(pkChr->GetPlayerID(), pkVictim->GetPlayerID());
-	CPVP * pkPVP = Find(kPVP.m_dwCRC);
+	//   ϳ  밡  ãƺ ʿ䰡 .
+	CPVP * pkPVP = NULL;
+
+	if (pkChr->HasPVP() && pkVictim->HasPVP())
+		pkPVP = Find(CPVP::MakeKey(pkChr->GetPlayerID(), pkVictim->GetPlayerID()));
 
 	if (!pkPVP || !pkPVP->IsFight())
 	{
@@ -548,9 +566,9 @@ bool CPVPManager::CanAttack(LPCHARACTER pkChr, LPCHARACTER pkVictim)
 	return true;
 }
 
-CPVP * CPVPManager::Find(DWORD dwCRC)
+CPVP * CPVPManager::Find(uint64_t qwKey)
 {
-	map<DWORD, CPVP *>::iterator it = m_map_pkPVP.find(dwCRC);
+	CPVPMap::iterator it = m_map_pkPVP.find(qwKey);
 
 	if (it == m_map_pkPVP.end())
 		return NULL;
@@ -560,21 +578,35 @@ CPVP * CPVPManager::Find(DWORD dwCRC)
 
 void CPVPManager::Delete(CPVP * pkPVP)
 {
-	map<DWORD, CPVP *>::iterator it = m_map_pkPVP.find(pkPVP->m_dwCRC);
+	CPVPMap::iterator it = m_map_pkPVP.find(pkPVP->m_qwKey);
 
 	if (it == m_map_pkPVP.end())
 		return;
 
 	m_map_pkPVP.erase(it);
-	m_map_pkPVPSetByID[pkPVP->m_players[0].dwPID].erase(pkPVP);
-	m_map_pkPVPSetByID[pkPVP->m_players[1].dwPID].erase(pkPVP);
+
+	for (int i = 0; i < 2; ++i)
+	{
+		DWORD dwPID = pkPVP->m_players[i].dwPID;
+		CPVPSetMap::iterator itSet = m_map_pkPVPSetByID.find(dwPID);
+
+		if (itSet != m_map_pkPVPSetByID.end())
+		{
+			itSet->second.erase(pkPVP);
+
+			if (itSet->second.empty())
+				m_map_pkPVPSetByID.erase(itSet);
+		}
+
+		UpdateHasPVP(dwPID);
+	}
 
 	M2_DELETE(pkPVP);
 }
 
 void CPVPManager::SendList(LPDESC d)
 {
-	map<DWORD, CPVP *>::iterator it = m_map_pkPVP.begin();
+	CPVPMap::iterator it = m_map_pkPVP.begin();
 
 	DWORD dwVID = d->GetCharacter()->GetVID();
 
@@ -638,7 +670,7 @@ void CPVPManager::SendList(LPDESC d)
 
 void CPVPManager::Process()
 {
-	map<DWORD, CPVP *>::iterator it = m_map_pkPVP.begin();
+	CPVPMap::iterator it = m_map_pkPVP.begin();
 
 	while (it != m_map_pkPVP.end())
 	{
@@ -3,8 +3,8 @@
 
 class CHARACTER;
 
-// CPVP DWORD ̵ ΰ ޾Ƽ m_dwCRC   ִ´.
-// CPVPManager ̷  CRC  ˻Ѵ.
+// CPVP DWORD ̵ ΰ ޾Ƽ m_qwKey   ִ´.
+// CPVPManager ̷  Ű  ˻Ѵ. (ū PID  32Ʈ ġ ʴ´)
 class CPVP
 {
 	public:
@@ -37,11 +37,19 @@ class CPVP
 		void	SetLastFightTime();
 		DWORD	GetLastFightTime();
 
-		DWORD 	GetCRC() { return m_dwCRC; }
+		uint64_t	GetKey() { return m_qwKey; }
+
+		static uint64_t	MakeKey(DWORD dwPID1, DWORD dwPID2)
+		{
+			if (dwPID1 > dwPID2)
+				return ((uint64_t) dwPID1 << 32) | dwPID2;
+
+			return ((uint64_t) dwPID2 << 32) | dwPID1;
+		}
 
 	protected:
 		TPlayer	m_players[2];
-		DWORD	m_dwCRC;
+		uint64_t	m_qwKey;
 		bool	m_bRevenge;
 
 		DWORD   m_dwLastFightTime;
@@ -49,7 +57,8 @@ class CPVP
 
 class CPVPManager : public singleton<CPVPManager>
 {
-	typedef std::map<DWORD, TR1_NS::unordered_set<CPVP*> > CPVPSetMap;
+	typedef TR1_NS::unordered_map<uint64_t, CPVP *> CPVPMap;
+	typedef TR1_NS::unordered_map<DWORD, TR1_NS::unordered_set<CPVP*> > CPVPSetMap;
 
 	public:
 	CPVPManager();
@@ -68,11 +77,12 @@ class CPVPManager : public singleton<CPVPManager>
 	void			Process();
 
 	public:
-	CPVP *			Find(DWORD dwCRC);
+	CPVP *			Find(uint64_t qwKey);
 	protected:
 	void			ConnectEx(LPCHARACTER pkChr, bool bDisconnect);
+	void			UpdateHasPVP(DWORD dwPID);
 
-	std::map<DWORD, CPVP *>	m_map_pkPVP;
+	CPVPMap			m_map_pkPVP;
 	CPVPSetMap		m_map_pkPVPSetByID;
 };
 
@@ -114,6 +114,7 @@ namespace quest
 		int		iIndex;
 		bool		bStart;
 		int		st;
+		int		iEventIndex;	//  ¸  ̺Ʈ. Ϸ .
 
 		std::string	_title;
 		std::string	_clock_name;
@@ -125,7 +126,7 @@ namespace quest
 		std::vector<AArgScript *> chat_scripts;
 
 		QuestState()
-			: co(NULL), ico(0), args(0), suspend_state(SUSPEND_STATE_NONE), iIndex(0), bStart(false), st(-1),
+			: co(NULL), ico(0), args(0), suspend_state(SUSPEND_STATE_NONE), iIndex(0), bStart(false), st(-1), iEventIndex(-1),
 			_clock_value(0), _counter_value(0)
 		{}
 	};
@@ -12,6 +12,7 @@ extern "C" {
 #endif
 
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <set>
 #include <map>
@@ -23,6 +24,8 @@ extern "C" {
 
 #ifndef __WIN32__
 #include <unistd.h>
+#include <dirent.h>
+#include <sys/wait.h>
 #else
 #include <boost/typeof/typeof.hpp>
 #define typeof(t) BOOST_TYPEOF(t)
@@ -32,6 +35,8 @@ extern "C" {
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "crc32.h"
 
@@ -41,6 +46,12 @@ using namespace std;
 
 lua_State* L;
 
+// -b : ũƮ lua Ʈڵ Ѵ.  lua_load  ˾Ƽ Ѵ.
+bool g_bBytecode = false;
+
+// ̹ Ʈ   . object/manifest/<quest>  .
+vector<string> g_vecOutputFiles;
+
 typedef struct LoadF {
 	FILE *f;
 	char buff[LUAL_BUFFERSIZE];
@@ -183,6 +194,97 @@ int none_c_function(lua_State* L)
 	return 0;
 }
 
+static int string_writer(lua_State * L, const void * p, size_t size, void * ud)
+{
+	((string *) ud)->append((const char *) p, size);
+	return 1;
+}
+
+// ӽ Ͽ    ٲġ ؼ, ߰ ׾     ʰ Ѵ.
+string temp_path(const string & path)
+{
+	return path + ".tmp";
+}
+
+void commit_file(const string & path)
+{
+#ifdef __WIN32__
+	remove(path.c_str());
+#endif
+	if (0 != rename(temp_path(path).c_str(), path.c_str()))
+	{
+		perror(path.c_str());
+		exit(1);
+	}
+}
+
+const char * output_format()
+{
+	return g_bBytecode ? LUA_VERSION " bytecode" : "source";
+}
+
+string read_file(const char * filename)
+{
+	ifstream inf(filename, ios::in | ios::binary);
+	istreambuf_iterator<char> ib(inf), ie;
+	return string(ib, ie);
+}
+
+//  lua ڵ带 . Ʈڵ  ؼ Ѵ.
+void write_chunk(const string & path, const string & code, const string & module)
+{
+	ofstream ouf(temp_path(path).c_str(), ios::out | ios::binary);
+
+	if (!g_bBytecode || code.empty())
+	{
+		ouf.write(code.data(), code.size());
+	}
+	else
+	{
+		if (luaL_loadbuffer(L, code.data(), code.size(), module.c_str()))
+		{
+			cerr << code << endl;
+			error((string("syntax error : ") + lua_tostring(L, -1)).c_str());
+		}
+
+		string dump;
+		lua_dump(L, string_writer, &dump);
+		lua_pop(L, 1);
+
+		ouf.write(dump.data(), dump.size());
+	}
+
+	if (!ouf)
+	{
+		perror(path.c_str());
+		exit(1);
+	}
+
+	ouf.close();
+	commit_file(path);
+	g_vecOutputFiles.push_back(path);
+}
+
+//      Դ   ְ .
+// manifest  Ʈ ٸ      .   ϴٴ ̴.
+void write_manifest(const string & quest_name, const char * filename)
+{
+	mkdir(OUTPUT_FOLDER "/manifest", 0755);
+
+	const string path = string(OUTPUT_FOLDER "/manifest/") + quest_name;
+
+	{
+		ofstream ouf(temp_path(path).c_str());
+		ouf << "source " << filename << ' ' << hex << get_string_crc(read_file(filename)) << dec << endl;
+		ouf << "format " << output_format() << endl;
+
+		for (size_t i = 0; i < g_vecOutputFiles.size(); ++i)
+			ouf << "file " << g_vecOutputFiles[i] << endl;
+	}
+
+	commit_file(path);
+}
+
 set<string> function_defs;
 set<string> function_calls;
 
@@ -808,7 +910,7 @@ void parse(char * filename)
 			}
 		}
 
-		ofstream ouf((string(OUTPUT_FOLDER "/state/")+quest_name).c_str());
+		ostringstream ouf;
 		ouf << quest_name << "={[\"start\"]=0";
 		set<string> :: iterator it;
 
@@ -852,6 +954,8 @@ void parse(char * filename)
 		ouf << all_functions;
 
 		ouf << "}";
+
+		write_chunk(string(OUTPUT_FOLDER "/state/")+quest_name, ouf.str(), quest_name);
 	}
 
 	if (!start_condition.empty())
@@ -865,10 +969,7 @@ void parse(char * filename)
 			}
 		}
 
-		ofstream ouf((string(OUTPUT_FOLDER "/begin_condition/")+quest_name).c_str());
-
-		ouf << "return " <<start_condition;
-		ouf.close();
+		write_chunk(string(OUTPUT_FOLDER "/begin_condition/")+quest_name, "return " + start_condition, quest_name);
 	}
 
 	{
@@ -908,21 +1009,21 @@ void parse(char * filename)
 				{
 					ostringstream os;
 					os << i;
+					write_chunk(path+quest_name+"."+it2->first+"."+os.str()+"."+"script", it2->second[i].script, quest_name);
+
+					if (!it2->second[i].when_condition.empty())
+						write_chunk(path+quest_name+"."+it2->first+"."+os.str()+"."+"when", "return " + it2->second[i].when_condition, quest_name);
+					else
+						write_chunk(path+quest_name+"."+it2->first+"."+os.str()+"."+"when", "", quest_name);
+
 					{
-						ofstream ouf((path+quest_name+"."+it2->first+"."+os.str()+"."+"script").c_str());
-						copy(it2->second[i].script.begin(),it2->second[i].script.end(), ostreambuf_iterator<char>(ouf));
-					}
-					{
-						ofstream ouf((path+quest_name+"."+it2->first+"."+os.str()+"."+"when").c_str());
-						if (!it2->second[i].when_condition.empty())
+						const string arg_path = path+quest_name+"."+it2->first+"."+os.str()+"."+"arg";
 						{
-							ouf << "return ";
-							copy(it2->second[i].when_condition.begin(),it2->second[i].when_condition.end(), ostreambuf_iterator<char>(ouf));
+							ofstream ouf(temp_path(arg_path).c_str());
+							copy(it2->second[i].when_argument.begin()+1,it2->second[i].when_argument.end(), ostreambuf_iterator<char>(ouf));
 						}
-					}
-					{
-						ofstream ouf((path+quest_name+"."+it2->first+"."+os.str()+"."+"arg").c_str());
-						copy(it2->second[i].when_argument.begin()+1,it2->second[i].when_argument.end(), ostreambuf_iterator<char>(ouf));
+						commit_file(arg_path);
+						g_vecOutputFiles.push_back(arg_path);
 					}
 				}
 			}
@@ -958,13 +1059,184 @@ void parse(char * filename)
 			map<string,string>::iterator it2;
 			for (it2 = it->second.begin();it2!=it->second.end();++it2)
 			{
-				ofstream ouf((path+quest_name+"."+it2->first).c_str());
-				copy(it2->second.begin(),it2->second.end(), ostreambuf_iterator<char>(ouf));
+				write_chunk(path+quest_name+"."+it2->first, it2->second, quest_name);
 			}
 		}
 	}
 
 	CheckUsedFunction();    
+
+	write_manifest(quest_name, filename);
+	g_vecOutputFiles.clear();
+}
+
+struct BuiltQuest
+{
+	string hash;
+	string format;
+	vector<string> files;
+};
+
+// object/manifest  о ҽ  ̸ ->    .
+void load_manifests(map<string, BuiltQuest> & built)
+{
+#ifndef __WIN32__
+	DIR * dir = opendir(OUTPUT_FOLDER "/manifest");
+
+	if (!dir)
+		return;
+
+	dirent * pde;
+
+	while ((pde = readdir(dir)))
+	{
+		if (pde->d_name[0] == '.')
+			continue;
+
+		ifstream inf((string(OUTPUT_FOLDER "/manifest/") + pde->d_name).c_str());
+		string line, source;
+		BuiltQuest q;
+
+		while (getline(inf, line))
+		{
+			if (line.compare(0, 7, "source ") == 0)
+			{
+				size_t sep = line.rfind(' ');
+				source = line.substr(7, sep - 7);
+				q.hash = line.substr(sep + 1);
+			}
+			else if (line.compare(0, 7, "format ") == 0)
+				q.format = line.substr(7);
+			else if (line.compare(0, 5, "file ") == 0)
+				q.files.push_back(line.substr(5));
+		}
+
+		if (!source.empty())
+			built[source] = q;
+	}
+
+	closedir(dir);
+#endif
+}
+
+bool is_up_to_date(const map<string, BuiltQuest> & built, const string & filename)
+{
+	map<string, BuiltQuest>::const_iterator it = built.find(filename);
+
+	if (it == built.end() || it->second.format != output_format())
+		return false;
+
+	ostringstream hash;
+	hash << hex << get_string_crc(read_file(filename.c_str()));
+
+	if (hash.str() != it->second.hash)
+		return false;
+
+	for (size_t i = 0; i < it->second.files.size(); ++i)
+	{
+		struct stat st;
+
+		if (0 != stat(it->second.files[i].c_str(), &st))
+			return false;
+	}
+
+	return true;
+}
+
+// Ʈ  jobs  ڽ μ  Ѵ.
+// parse()   ¸    abort ϹǷ,   ϸ fork Ѵ.
+int run_batch(const vector<string> & files, int jobs)
+{
+	map<string, BuiltQuest> built;
+	load_manifests(built);
+
+	vector<string> queue;
+	int skipped = 0;
+
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		if (is_up_to_date(built, files[i]))
+			++skipped;
+		else
+			queue.push_back(files[i]);
+	}
+
+	vector<string> failed;
+
+#ifndef __WIN32__
+	map<pid_t, string> running;
+	size_t next = 0;
+
+	while (next < queue.size() || !running.empty())
+	{
+		while (next < queue.size() && (int) running.size() < jobs)
+		{
+			cout.flush();
+			cerr.flush();
+
+			pid_t pid = fork();
+
+			if (pid < 0)
+			{
+				perror("fork");
+				exit(1);
+			}
+
+			if (pid == 0)
+			{
+				g_filename = const_cast<char *>(queue[next].c_str());
+				parse(g_filename);
+				cout.flush();
+				_exit(0);
+			}
+
+			running[pid] = queue[next++];
+		}
+
+		int status;
+		pid_t pid = wait(&status);
+
+		if (pid < 0)
+		{
+			perror("wait");
+			exit(1);
+		}
+
+		map<pid_t, string>::iterator it = running.find(pid);
+
+		if (it == running.end())
+			continue;
+
+		if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+			failed.push_back(it->second);
+
+		running.erase(it);
+	}
+#else
+	for (size_t i = 0; i < queue.size(); ++i)
+	{
+		g_filename = const_cast<char *>(queue[i].c_str());
+		parse(g_filename);
+	}
+#endif
+
+	cout << "BATCH: " << files.size() << " quests, " << queue.size() - failed.size() << " compiled, "
+		<< skipped << " up to date, " << failed.size() << " failed" << endl;
+
+	for (size_t i = 0; i < failed.size(); ++i)
+		cerr << "FAILED: " << failed[i] << endl;
+
+	return failed.empty() ? 0 : 1;
+}
+
+void usage()
+{
+	cerr << "usage: qc [-b] file..." << endl;
+	cerr << "       qc [-b] [-j jobs] -l listfile [file...]" << endl;
+	cerr << "  -b  write lua bytecode" << endl;
+	cerr << "  -j  compile with that many processes (batch mode)" << endl;
+	cerr << "  -l  read quest file names from listfile, one per line (batch mode)" << endl;
+	cerr << "In batch mode quests whose source has not changed since the last build are skipped." << endl;
 }
 
 int main(int argc, char* argv[])
@@ -973,16 +1245,69 @@ int main(int argc, char* argv[])
 	L = lua_open();
 	luaX_init(L);
 
-	if (argc > 1)
+	vector<string> files;
+	bool batch = false;
+	int jobs = 1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "-b"))
+		{
+			g_bBytecode = true;
+		}
+		else if (!strcmp(argv[i], "-j") || !strcmp(argv[i], "-l"))
+		{
+			if (i + 1 >= argc)
+			{
+				usage();
+				return 1;
+			}
+
+			batch = true;
+
+			if (argv[i][1] == 'j')
+			{
+				jobs = max(1, atoi(argv[++i]));
+			}
+			else
+			{
+				ifstream inf(argv[++i]);
+				string line;
+
+				if (!inf)
+				{
+					perror(argv[i]);
+					return 1;
+				}
+
+				while (getline(inf, line))
+				{
+					if (!line.empty() && line[line.size() - 1] == '\r')
+						line.erase(line.size() - 1);
+
+					if (!line.empty() && line[0] != '#')
+						files.push_back(line);
+				}
+			}
+		}
+		else
+			files.push_back(argv[i]);
+	}
+
+	int ret = 0;
+
+	if (batch)
+		ret = run_batch(files, jobs);
+	else
 	{
-		for (int i = 1; i < argc; ++i)
+		for (size_t i = 0; i < files.size(); ++i)
 		{
-			g_filename = argv[i];
-			parse(argv[i]);
+			g_filename = const_cast<char *>(files[i].c_str());
+			parse(g_filename);
 		}
 	}
 
 	lua_close(L);
-	return 0;
+	return ret;
 }
 
@@ -20,29 +20,19 @@ namespace quest
 		event_cancel(ppEvent);
 	}
 
-	EVENTFUNC(quest_server_timer_event)
+	EVENTFUNC(quest_server_timer_bucket_event)
 	{
-		quest_server_event_info * info = dynamic_cast<quest_server_event_info *>( event->info );
+		quest_server_timer_bucket_info * info = dynamic_cast<quest_server_timer_bucket_info *>( event->info );
 
 		if ( info == NULL )
 		{
-			sys_err( "quest_server_timer_event> <Factor> Null pointer" );
+			sys_err( "quest_server_timer_bucket_event> <Factor> Null pointer" );
 			return 0;
 		}
 
-		CQuestManager& q = CQuestManager::instance();
-
-		if (!q.ServerTimer(info->npc_id, info->arg))
-			return passes_per_sec / 2 + 1;
-
-		if (0 == info->time_cycle)	//  ƴ϶  Ų.
-		{
-			q.ClearServerTimerNotCancel(info->name, info->arg);
-			M2_DELETE_ARRAY(info->name);
-			info->name = NULL;
-		}
-
-		return info->time_cycle;
+		// ٽ ︱ Ÿ̸Ӵ  ޽  ŰǷ  ̺Ʈ   .
+		CQuestManager::instance().DispatchServerTimers(info->pulse);
+		return 0;
 	}
 
 	EVENTFUNC(quest_timer_event)
@@ -83,23 +73,13 @@ END_OF_TIMER_EVENT:
 		return info->time_cycle;
 	}
 
-	LPEVENT quest_create_server_timer_event(const char * name, double when, unsigned int timernpc, bool loop, unsigned int arg)
+	LPEVENT quest_create_server_timer_bucket_event(int pulse)
 	{
-		const int nameCapacity = strlen(name) + 1;
-
-		long ltime_cycle = (long) (rint(PASSES_PER_SEC(when)));
+		quest_server_timer_bucket_info* info = AllocEventInfo<quest_server_timer_bucket_info>();
 
-		quest_server_event_info* info = AllocEventInfo<quest_server_event_info>();
-
-		info->npc_id = timernpc;
-		info->time_cycle = loop ? ltime_cycle : 0;
-		info->arg = arg;
-		info->name		= M2_NEW char[nameCapacity];
-
-		if (info->name)
-			strlcpy(info->name, name, nameCapacity);
+		info->pulse = pulse;
 
-		return event_create(quest_server_timer_event, info, ltime_cycle);
+		return event_create(quest_server_timer_bucket_event, info, pulse - thecore_pulse());
 	}
 
 	LPEVENT quest_create_timer_event(const char * name, unsigned int player_id, double when, unsigned int npc_id, bool loop)
@@ -3,18 +3,13 @@
 
 namespace quest
 {
-	EVENTINFO(quest_server_event_info)
+	//  ޽ ︮  Ÿ̸ӵ  ̺Ʈ ´.
+	EVENTINFO(quest_server_timer_bucket_info)
 	{
-		int		time_cycle;
-		unsigned int 	npc_id;
-		unsigned int	arg;
-		char*		name;
+		int		pulse;
 
-		quest_server_event_info()
-		: time_cycle( 0 )
-		, npc_id( 0 )
-		, arg( 0 )
-		, name( 0 )
+		quest_server_timer_bucket_info()
+		: pulse( 0 )
 		{
 		}
 	};
@@ -35,7 +30,7 @@ namespace quest
 		}
 	};
 
-	extern LPEVENT quest_create_server_timer_event(const char* name, double when, unsigned int timernpc = QUEST_NO_NPC, bool loop = false, unsigned int arg = 0);
+	extern LPEVENT quest_create_server_timer_bucket_event(int pulse);
 	extern LPEVENT quest_create_timer_event(const char* name, unsigned int player_id, double when, unsigned int npc_id=QUEST_NO_NPC, bool loop = false);
 	extern void CancelTimerEvent(LPEVENT* ppEvent);
 }
@@ -18,6 +18,7 @@
 #include "guild.h"
 #include "guild_manager.h"
 #include "sectree_manager.h"
+#include "BlueDragon_Binder.h"
 
 #undef sys_err
 #ifndef __WIN32__
@@ -30,12 +31,144 @@ namespace quest
 {
 	using namespace std;
 
+	//
+	// when ǰ arg ũƮ Ź  ʵ  Լ __condcache  д.
+	// when  __codecache ó ڵ Ͱ Ṵ̋, arg  Ѿ ڿ
+	// Ź  Ƿ  Ű. quest  ٽ  lua state  Բ .
+	//
+	struct TScriptCacheStat
+	{
+		DWORD	dwHit;
+		DWORD	dwMiss;
+		DWORD	dwPrecompiled;
+	};
+
+	static TScriptCacheStat s_kCondCacheStat;
+	static TScriptCacheStat s_kArgCacheStat;
+
+	// stack : (key)  θ.
+	// ϸ stack : (compiled-code), ϸ stack : (error-message)
+	static int LoadCachedScript(lua_State * L, const char * code, size_t size, const char * name, DWORD * pdwHit, DWORD * pdwMiss)
+	{
+		lua_getglobal(L, "__condcache");
+		// stack : (key) __condcache
+		lua_pushvalue(L, -2);
+		lua_rawget(L, -2);
+		// stack : (key) __condcache (compiled-code)
+
+		if (!lua_isnil(L, -1))
+		{
+			// cache hit
+			if (pdwHit)
+				++*pdwHit;
+
+			lua_replace(L, -3);
+			lua_pop(L, 1);
+			return 0;
+		}
+
+		// cache miss
+		if (pdwMiss)
+			++*pdwMiss;
+
+		lua_pop(L, 1);
+		// stack : (key) __condcache
+		int errcode = luaL_loadbuffer(L, code, size, name);
+
+		if (!errcode)
+		{
+			// stack : (key) __condcache (compiled-code)
+			lua_pushvalue(L, -3);
+			lua_pushvalue(L, -2);
+			lua_rawset(L, -4);
+		}
+
+		// stack : (key) __condcache (compiled-code or error-message)
+		lua_replace(L, -3);
+		lua_pop(L, 1);
+		return errcode;
+	}
+
+	static int LoadConditionScript(lua_State * L, const char * code, int size, DWORD * pdwHit, DWORD * pdwMiss)
+	{
+		lua_pushnumber(L, (long) code);
+		return LoadCachedScript(L, code, size, "IsScriptTrue", pdwHit, pdwMiss);
+	}
+
+	static int LoadArgScript(lua_State * L, const string & str, DWORD * pdwHit, DWORD * pdwMiss)
+	{
+		const string stCode("return " + str);
+
+		lua_pushlstring(L, str.c_str(), str.size());
+		return LoadCachedScript(L, stCode.c_str(), stCode.size(), "ScriptToString", pdwHit, pdwMiss);
+	}
+
+	// quest    ̸  д.     ٽ  .
+	void PrecompileConditionScript(const char * code, int size)
+	{
+		if (size == 0)
+			return;
+
+		lua_State * L = CQuestManager::instance().GetLuaState();
+		int x = lua_gettop(L);
+
+		if (!LoadConditionScript(L, code, size, NULL, NULL))
+			++s_kCondCacheStat.dwPrecompiled;
+
+		lua_settop(L, x);
+	}
+
+	void ForgetConditionScript(const char * code)
+	{
+		lua_State * L = CQuestManager::instance().GetLuaState();
+
+		lua_getglobal(L, "__condcache");
+		lua_pushnumber(L, (long) code);
+		lua_pushnil(L);
+		lua_rawset(L, -3);
+		lua_pop(L, 1);
+	}
+
+	void PrecompileArgScript(const string & str)
+	{
+		if (str.empty())
+			return;
+
+		lua_State * L = CQuestManager::instance().GetLuaState();
+		int x = lua_gettop(L);
+
+		if (!LoadArgScript(L, str, NULL, NULL))
+			++s_kArgCacheStat.dwPrecompiled;
+
+		lua_settop(L, x);
+	}
+
+	static void DumpScriptCacheStat(const char * c_pszName, TScriptCacheStat & r)
+	{
+		DWORD dwTotal = r.dwHit + r.dwMiss;
+
+		sys_log(0, "QUEST_SCRIPT_CACHE: %s precompiled %u hit %u miss %u (hit %.1f%%)",
+				c_pszName, r.dwPrecompiled, r.dwHit, r.dwMiss, dwTotal ? r.dwHit * 100.0 / dwTotal : 0.0);
+
+		r.dwHit = r.dwMiss = 0;
+	}
+
+	void DumpScriptCacheStat()
+	{
+		DumpScriptCacheStat("when", s_kCondCacheStat);
+		DumpScriptCacheStat("arg", s_kArgCacheStat);
+	}
+
 	string ScriptToString(const string& str)
 	{
 		lua_State* L = CQuestManager::instance().GetLuaState();
 		int x = lua_gettop(L);
 
-		int errcode = lua_dobuffer(L, ("return "+str).c_str(), str.size()+7, "ScriptToString");
+		int errcode = LoadArgScript(L, str, &s_kArgCacheStat.dwHit, &s_kArgCacheStat.dwMiss);
+
+		if (!errcode)
+			errcode = lua_pcall(L, 0, 1, 0);
+
 		string retstr;
 		if (!errcode)
 		{
@@ -44,7 +177,7 @@ namespace quest
 		}
 		else
 		{
-			sys_err("LUA ScriptRunError (code:%d src:[%s])", errcode, str.c_str());
+			sys_err("LUA ScriptRunError (code:%d src:[%s] %s)", errcode, str.c_str(), lua_isstring(L, -1) ? lua_tostring(L, -1) : "");
 		}
 		lua_settop(L,x);
 		return retstr;
@@ -63,7 +196,7 @@ namespace quest
 		if (!ch->IsPC())
 			return;
 
-		PC * pPC = CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+		PC * pPC = CQuestManager::instance().GetPCForce(ch);
 
 		if (pPC)
 			pPC->SetFlag(flagname, value);
@@ -74,7 +207,7 @@ namespace quest
 		if (!ch->IsPC())
 			return false;
 
-		PC * pPC = CQuestManager::instance().GetPCForce(ch->GetPlayerID());
+		PC * pPC = CQuestManager::instance().GetPCForce(ch);
 		bool returnBool;
 		if (pPC)
 		{
@@ -175,8 +308,12 @@ namespace quest
 
 		lua_State* L = CQuestManager::instance().GetLuaState();
 		int x = lua_gettop(L);
-		int errcode = lua_dobuffer(L, code, size, "IsScriptTrue");
-		int bStart = lua_toboolean(L, -1);
+		int errcode = LoadConditionScript(L, code, size, &s_kCondCacheStat.dwHit, &s_kCondCacheStat.dwMiss);
+
+		if (!errcode)
+			errcode = lua_pcall(L, 0, 1, 0);
+
+		int bStart = !errcode && lua_toboolean(L, -1);
 		if (errcode)
 		{
 			char buf[100];
@@ -383,8 +520,13 @@ namespace quest
 
 		while ((preg->name))
 		{
+			// Ϸ   ְ  Լ 踦 upvalue   Ŭ Ѵ.
+			TQuestProfile & rProfile = m_mapNativeProfile[string(c_pszName) + "." + preg->name];
+
 			lua_pushstring(L, preg->name);
-			lua_pushcfunction(L, preg->func);
+			lua_pushlightuserdata(L, (void *) preg->func);
+			lua_pushlightuserdata(L, &rProfile);
+			lua_pushcclosure(L, ProfiledCFunction, 2);
 			lua_rawset(L, -3);
 			preg++;
 		}
@@ -392,6 +534,25 @@ namespace quest
 		lua_setglobal(L, c_pszName);
 	}
 
+	int CQuestManager::ProfiledCFunction(lua_State * L)
+	{
+		lua_CFunction func = (lua_CFunction) lua_touserdata(L, lua_upvalueindex(1));
+
+		if (!CQuestManager::instance().m_bProfiling)
+			return func(L);
+
+		struct timeval tv_start, tv_end;
+		gettimeofday(&tv_start, NULL);
+
+		int ret = func(L);
+
+		gettimeofday(&tv_end, NULL);
+
+		TQuestProfile * pProfile = (TQuestProfile *) lua_touserdata(L, lua_upvalueindex(2));
+		pProfile->Add((tv_end.tv_sec - tv_start.tv_sec) * 1000000 + (tv_end.tv_usec - tv_start.tv_usec));
+		return ret;
+	}
+
 	void CQuestManager::BuildStateIndexToName(const char* questName)
 	{
 		int x = lua_gettop(L);
@@ -485,6 +646,10 @@ namespace quest
 		//
 		RegisterGlobalFunctionTable(L);
 
+		// NPC::Set  when/arg ũƮ ̸  ִ´.
+		lua_newtable(L);
+		lua_setglobal(L, "__condcache");
+
 		// LUA_INIT_ERROR_MESSAGE
 		{
 			char settingsFileName[256];
@@ -497,6 +662,8 @@ namespace quest
 				sys_err("LOAD_SETTINS_FAILURE(%s)", settingsFileName);
 				return false;
 			}
+
+			BlueDragon_LoadSetting();
 		}
 
 		{
@@ -572,6 +739,8 @@ namespace quest
 
 		lua_newtable(L);
 		lua_setglobal(L, "__codecache");
+
+		ResetGCThreshold();
 		return true;
 	}
 
@@ -731,8 +900,23 @@ namespace quest
 		QuestState qs;
 		qs.args=0;
 		qs.st = state_index;
-		qs.co = lua_newthread(L);
-		qs.ico = lua_ref(L, 1/*qs.co*/);
+
+		if (!m_vecThreadPool.empty())
+		{
+			qs.co = m_vecThreadPool.back().first;
+			qs.ico = m_vecThreadPool.back().second;
+			m_vecThreadPool.pop_back();
+			++m_dwThreadPoolHit;
+		}
+		else
+		{
+			qs.co = lua_newthread(L);
+			qs.ico = lua_ref(L, 1/*qs.co*/);
+			++m_dwThreadCreate;
+		}
+
+		++m_iLiveThreads;
+		qs.iEventIndex = m_iRunningEventIndex;
 		return qs;
 	}
 
@@ -746,7 +930,27 @@ namespace quest
 		ClearError();
 
 		m_CurrentRunningState = &qs;
-		int ret = lua_resume(qs.co, qs.args);
+
+		int ret;
+
+		if (m_bProfiling)
+		{
+			//  ߿ qs    Ƿ Ű  .
+			TQuestProfileKey key;
+			key.dwQuestIndex = qs.iIndex;
+			key.iState = qs.st;
+			key.iEventIndex = qs.iEventIndex;
+
+			struct timeval tv_start, tv_end;
+			gettimeofday(&tv_start, NULL);
+
+			ret = lua_resume(qs.co, qs.args);
+
+			gettimeofday(&tv_end, NULL);
+			m_mapStateProfile[key].Add((tv_end.tv_sec - tv_start.tv_sec) * 1000000 + (tv_end.tv_usec - tv_start.tv_usec));
+		}
+		else
+			ret = lua_resume(qs.co, qs.args);
 
 		if (ret == 0)
 		{
@@ -809,7 +1013,19 @@ namespace quest
 		if (qs.co)
 		{
 			//cerr << "ICO "<<qs.ico <<endl;
-			lua_unref(L, qs.ico);
+			lua_Debug ar;
+
+			// ų  ǰ ڷƾ ȣ   ٽ   ִ.
+			// yield  ä   .
+			if (m_vecThreadPool.size() < QUEST_THREAD_POOL_MAX && lua_getstack(qs.co, 0, &ar) == 0)
+			{
+				lua_settop(qs.co, 0);
+				m_vecThreadPool.push_back(make_pair(qs.co, qs.ico));
+			}
+			else
+				lua_unref(L, qs.ico);
+
+			--m_iLiveThreads;
 			qs.co = 0;
 		}
 	}
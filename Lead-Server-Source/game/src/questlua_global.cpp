@@ -153,8 +153,7 @@ namespace quest
 
 		int timernpc = q.LoadTimerScript(name);
 
-		LPEVENT event = quest_create_server_timer_event(name, t, timernpc, false, arg);
-		q.AddServerTimer(name, arg, event);
+		q.AddServerTimer(name, arg, t, timernpc, false);
 		return 0;
 	}
 
@@ -177,8 +176,7 @@ namespace quest
 
 		int timernpc = q.LoadTimerScript(name);
 
-		LPEVENT event = quest_create_server_timer_event(name, t, timernpc, true, arg);
-		q.AddServerTimer(name, arg, event);
+		q.AddServerTimer(name, arg, t, timernpc, true);
 		return 0;
 	}
 
@@ -771,13 +769,13 @@ namespace quest
 
 		DWORD race = (DWORD) lua_tonumber(L, 1);
 
-		CharacterVectorInteractor i;
+		const CHARACTER_SET * pkSet = CHARACTER_MANAGER::instance().GetCharactersByRaceNum(race);
 
-		if (CHARACTER_MANAGER::instance().GetCharactersByRaceNum(race, i))
+		if (pkSet)
 		{
-			CharacterVectorInteractor::iterator it = i.begin();
+			CHARACTER_SET::const_iterator it = pkSet->begin();
 
-			while (it != i.end())
+			while (it != pkSet->end())
 			{
 				LPCHARACTER tch = *(it++);
 
@@ -8,6 +8,7 @@
 #include "char.h"
 #include "char_manager.h"
 #include "questmanager.h"
+#include "questevent.h"
 #include "lzo_manager.h"
 #include "item.h"
 #include "config.h"
@@ -27,10 +28,14 @@ namespace quest
 	using namespace std;
 
 	CQuestManager::CQuestManager()
-		: m_pSelectedDungeon(NULL), m_dwServerTimerArg(0), m_iRunningEventIndex(0), L(NULL), m_bNoSend (false),
+		: m_pSelectedDungeon(NULL), m_dwServerTimerArg(0), m_dwServerTimerFired(0), m_dwServerTimerBucketFired(0), m_iRunningEventIndex(0), L(NULL), m_bNoSend (false),
 		m_CurrentRunningState(NULL), m_pCurrentCharacter(NULL), m_pCurrentNPCCharacter(NULL), m_pCurrentPartyMember(NULL),
-		m_pCurrentPC(NULL),  m_iCurrentSkin(0), m_bError(false), m_pOtherPCBlockRootPC(NULL)
+		m_pCurrentPC(NULL),  m_iCurrentSkin(0), m_bError(false), m_pOtherPCBlockRootPC(NULL),
+		m_iGCBaseKB(0), m_dwGCCount(0), m_dwGCOverdueCount(0), m_dwGCMaxPauseUsec(0),
+		m_bProfiling(false), m_dwProfileStartTime(0),
+		m_iLiveThreads(0), m_dwThreadPoolHit(0), m_dwThreadCreate(0)
 	{
+		memset(m_adwGCPause, 0, sizeof(m_adwGCPause));
 	}
 
 	CQuestManager::~CQuestManager()
@@ -45,6 +50,8 @@ namespace quest
 			lua_close(L);
 			L = NULL;
 		}
+
+		m_vecThreadPool.clear();
 	}	
 
 	bool CQuestManager::Initialize()
@@ -466,8 +473,8 @@ namespace quest
 	bool CQuestManager::ServerTimer(unsigned int npc, unsigned int arg)
 	{
 		SetServerTimerArg(arg);
-		sys_log(0, "XXX ServerTimer Call NPC %p", GetPCForce(0));
-		m_pCurrentPC = GetPCForce(0);
+		sys_log(0, "XXX ServerTimer Call NPC %p", GetPCForce(0U));
+		m_pCurrentPC = GetPCForce(0U);
 		m_pCurrentCharacter = NULL;
 		m_pSelectedDungeon = NULL;
 		return m_mapNPC[npc].OnServerTimer(*m_pCurrentPC);
@@ -856,7 +863,7 @@ namespace quest
 		{
 			const string& stQuestObjectDir = *it;
 			string full_name = stQuestObjectDir + "/begin_condition/" + quest_name;
-			ifstream inf(full_name.c_str());
+			ifstream inf(full_name.c_str(), ios::in | ios::binary);
 
 			if (inf.is_open())
 			{
@@ -897,6 +904,7 @@ namespace quest
 	void CQuestManager::DisconnectPC(LPCHARACTER ch)
 	{
 		m_mapPC.erase(ch->GetPlayerID());
+		ch->SetQuestPC(NULL);
 	}
 
 	PC * CQuestManager::GetPCForce(unsigned int pc)
@@ -913,6 +921,19 @@ namespace quest
 		return &it->second;
 	}
 
+	PC * CQuestManager::GetPCForce(LPCHARACTER ch)
+	{
+		PC * pPC = ch->GetQuestPC();
+
+		if (!pPC)
+		{
+			pPC = GetPCForce(ch->GetPlayerID());
+			ch->SetQuestPC(pPC);
+		}
+
+		return pPC;
+	}
+
 	PC * CQuestManager::GetPC(unsigned int pc)
 	{
 		PCMap::iterator it;
@@ -922,7 +943,7 @@ namespace quest
 		if (!pkChr)
 			return NULL;
 
-		m_pCurrentPC = GetPCForce(pc);
+		m_pCurrentPC = GetPCForce(pkChr);
 		m_pCurrentCharacter = pkChr;
 		m_pSelectedDungeon = NULL;
 		return (m_pCurrentPC);
@@ -1165,10 +1186,11 @@ namespace quest
 		static const char*	DROPEVENT_CHARTONE_NAME		= "drop_char_stone";
 		static const int	DROPEVENT_CHARTONE_NAME_LEN = strlen(DROPEVENT_CHARTONE_NAME);
 
-		int prev_value = m_mapEventFlag[name];
+		int & rValue = m_mapEventFlag[name];
+		int prev_value = rValue;
 
-		sys_log(0, "QUEST eventflag %s %d prev_value %d", name.c_str(), value, m_mapEventFlag[name]);
-		m_mapEventFlag[name] = value;
+		sys_log(0, "QUEST eventflag %s %d prev_value %d", name.c_str(), value, prev_value);
+		rValue = value;
 
 		if (name == "mob_item")
 		{
@@ -1412,16 +1434,16 @@ namespace quest
 			static DWORD new_santa = 20126;
 			if (value != 0)
 			{
-				CharacterVectorInteractor i;
 				bool map1_santa_exist = false;
 				bool map21_santa_exist = false;
 				bool map41_santa_exist = false;
+				const CHARACTER_SET * pkSet = CHARACTER_MANAGER::instance().GetCharactersByRaceNum(new_santa);
 				
-				if (CHARACTER_MANAGER::instance().GetCharactersByRaceNum(new_santa, i))
+				if (pkSet)
 				{
-					CharacterVectorInteractor::iterator it = i.begin();
+					CHARACTER_SET::const_iterator it = pkSet->begin();
 
-					while (it != i.end())
+					while (it != pkSet->end())
 					{
 						LPCHARACTER tch = *(it++);
 
@@ -1471,7 +1493,7 @@ namespace quest
 
 	int	CQuestManager::GetEventFlag(const string& name)
 	{
-		map<string,int>::iterator it = m_mapEventFlag.find(name);
+		itertype(m_mapEventFlag) it = m_mapEventFlag.find(name);
 
 		if (it == m_mapEventFlag.end())
 			return 0;
@@ -1540,6 +1562,179 @@ namespace quest
 		}
 	}
 
+	void CQuestManager::ResetGCThreshold()
+	{
+		m_iGCBaseKB = lua_getgccount(L);
+
+		if (g_bQuestGCManaged)
+			lua_setgcthreshold(L, m_iGCBaseKB + g_iQuestGCStepKB * QUEST_GC_SAFETY_STEPS);
+	}
+
+	void CQuestManager::CollectGarbageIdle(long lSlackUsec)
+	{
+		if (!L || !g_bQuestGCManaged)
+			return;
+
+		int iKB = lua_getgccount(L);
+
+		if (iKB < m_iGCBaseKB + g_iQuestGCStepKB)
+			return;
+
+		bool bOverdue = iKB >= m_iGCBaseKB + g_iQuestGCStepKB * QUEST_GC_OVERDUE_STEPS;
+
+		if (!bOverdue && lSlackUsec < g_iQuestGCBudgetUsec)
+			return;
+
+		struct timeval tv_start, tv_end;
+		gettimeofday(&tv_start, NULL);
+
+		// lua 5.0     .  0   ٷ Ѵ.
+		lua_setgcthreshold(L, 0);
+
+		gettimeofday(&tv_end, NULL);
+
+		DWORD dwPauseUsec = (tv_end.tv_sec - tv_start.tv_sec) * 1000000 + (tv_end.tv_usec - tv_start.tv_usec);
+		static const DWORD s_adwBucketUsec[QUEST_GC_PAUSE_BUCKET_MAX - 1] = { 1000, 2000, 5000, 10000, 20000 };
+
+		int iBucket = 0;
+
+		while (iBucket < QUEST_GC_PAUSE_BUCKET_MAX - 1 && dwPauseUsec >= s_adwBucketUsec[iBucket])
+			++iBucket;
+
+		++m_adwGCPause[iBucket];
+		++m_dwGCCount;
+
+		if (bOverdue)
+			++m_dwGCOverdueCount;
+
+		m_dwGCMaxPauseUsec = MAX(m_dwGCMaxPauseUsec, dwPauseUsec);
+
+		if (test_server)
+			sys_log(0, "QUEST_GC: %dKB -> %dKB %uus%s", iKB, lua_getgccount(L), dwPauseUsec, bOverdue ? " (overdue)" : "");
+
+		ResetGCThreshold();
+	}
+
+	void CQuestManager::DumpGCStat()
+	{
+		if (!L)
+			return;
+
+		sys_log(0, "QUEST_GC: heap %dKB threshold %dKB collect %u overdue %u max %uus pause <1ms %u <2ms %u <5ms %u <10ms %u <20ms %u >=20ms %u",
+				lua_getgccount(L), lua_getgcthreshold(L), m_dwGCCount, m_dwGCOverdueCount, m_dwGCMaxPauseUsec,
+				m_adwGCPause[0], m_adwGCPause[1], m_adwGCPause[2], m_adwGCPause[3], m_adwGCPause[4], m_adwGCPause[5]);
+
+		m_dwGCCount = m_dwGCOverdueCount = m_dwGCMaxPauseUsec = 0;
+		memset(m_adwGCPause, 0, sizeof(m_adwGCPause));
+	}
+
+	void CQuestManager::DumpThreadPoolStat()
+	{
+		sys_log(0, "QUEST_THREAD: live %d pooled %u hit %u create %u",
+				m_iLiveThreads, (unsigned int) m_vecThreadPool.size(), m_dwThreadPoolHit, m_dwThreadCreate);
+
+		m_dwThreadPoolHit = m_dwThreadCreate = 0;
+	}
+
+	void CQuestManager::StartProfile()
+	{
+		if (m_bProfiling)
+			return;
+
+		ResetProfile();
+		m_bProfiling = true;
+	}
+
+	void CQuestManager::StopProfile()
+	{
+		m_bProfiling = false;
+	}
+
+	void CQuestManager::ResetProfile()
+	{
+		m_dwProfileStartTime = get_dword_time();
+		m_mapStateProfile.clear();
+
+		for (itertype(m_mapNativeProfile) it = m_mapNativeProfile.begin(); it != m_mapNativeProfile.end(); ++it)
+			it->second = TQuestProfile();
+	}
+
+	struct FProfileTotalGreater
+	{
+		template <typename T>
+		bool operator () (const T & lhs, const T & rhs) const
+		{
+			return lhs.second.dTotalUsec > rhs.second.dTotalUsec;
+		}
+	};
+
+	bool CQuestManager::DumpProfile(const char * c_pszFileName)
+	{
+		FILE * fp = fopen(c_pszFileName, "w");
+
+		if (!fp)
+		{
+			sys_err("QUEST_PROFILE: cannot open %s", c_pszFileName);
+			return false;
+		}
+
+		fprintf(fp, "# quest profile %s, %u sec\n", m_bProfiling ? "running" : "stopped", (get_dword_time() - m_dwProfileStartTime) / 1000);
+		fprintf(fp, "# calls total_ms avg_us max_us name\n");
+		fprintf(fp, "# state time includes the natives and nested states it runs\n");
+
+		vector<pair<string, TQuestProfile> > vec;
+		vec.reserve(m_mapStateProfile.size());
+
+		for (itertype(m_mapStateProfile) it = m_mapStateProfile.begin(); it != m_mapStateProfile.end(); ++it)
+		{
+			const string & stQuestName = GetQuestNameByIndex(it->first.dwQuestIndex);
+			const char * c_pszStateName = GetQuestStateName(stQuestName, it->first.iState);
+
+			char szName[256];
+			snprintf(szName, sizeof(szName), "%s.%s %s", stQuestName.c_str(), c_pszStateName ? c_pszStateName : "?", GetEventName(it->first.iEventIndex));
+			vec.push_back(make_pair(string(szName), it->second));
+		}
+
+		std::sort(vec.begin(), vec.end(), FProfileTotalGreater());
+
+		for (size_t i = 0; i < vec.size(); ++i)
+		{
+			const TQuestProfile & r = vec[i].second;
+			fprintf(fp, "STATE %u %.1f %.1f %u %s\n", r.dwCalls, r.dTotalUsec / 1000.0, r.dTotalUsec / r.dwCalls, r.dwMaxUsec, vec[i].first.c_str());
+		}
+
+		vec.clear();
+
+		for (itertype(m_mapNativeProfile) it = m_mapNativeProfile.begin(); it != m_mapNativeProfile.end(); ++it)
+		{
+			if (it->second.dwCalls)
+				vec.push_back(*it);
+		}
+
+		std::sort(vec.begin(), vec.end(), FProfileTotalGreater());
+
+		for (size_t i = 0; i < vec.size(); ++i)
+		{
+			const TQuestProfile & r = vec[i].second;
+			fprintf(fp, "NATIVE %u %.1f %.1f %u %s\n", r.dwCalls, r.dTotalUsec / 1000.0, r.dTotalUsec / r.dwCalls, r.dwMaxUsec, vec[i].first.c_str());
+		}
+
+		fclose(fp);
+		sys_log(0, "QUEST_PROFILE: %u states %u natives written to %s", (unsigned int) m_mapStateProfile.size(), (unsigned int) vec.size(), c_pszFileName);
+		return true;
+	}
+
+	const char * CQuestManager::GetEventName(int iEventIndex)
+	{
+		for (itertype(m_mapEventName) it = m_mapEventName.begin(); it != m_mapEventName.end(); ++it)
+		{
+			if (it->second == iEventIndex)
+				return it->first.c_str();
+		}
+
+		return "";
+	}
+
 	bool CQuestManager::ExecuteQuestScript(PC& pc, DWORD quest_index, const int state, const char* code, const int code_size, vector<AArgScript*>* pChatScripts, bool bUseCache)
 	{
 		return ExecuteQuestScript(pc, CQuestManager::instance().GetQuestNameByIndex(quest_index), state, code, code_size, pChatScripts, bUseCache);
@@ -1636,15 +1831,7 @@ namespace quest
 	{
 		const char * state_name = GetQuestStateName(GetCurrentQuestName(), GetCurrentState()->st);
 
-		string event_index_name = "";
-		for (itertype(m_mapEventName) it = m_mapEventName.begin(); it != m_mapEventName.end(); ++it)
-		{
-			if (it->second == m_iRunningEventIndex)
-			{
-				event_index_name = it->first;
-				break;
-			}
-		}
+		string event_index_name = GetEventName(m_iRunningEventIndex);
 
 		sys_err("LUA_ERROR: quest %s.%s %s", GetCurrentQuestName().c_str(), state_name, event_index_name.c_str() );
 		if (GetCurrentCharacterPtr() && test_server)
@@ -1695,20 +1882,69 @@ namespace quest
 	}
 #endif
 
-	void CQuestManager::AddServerTimer(const std::string& name, DWORD arg, LPEVENT event)
+	void CQuestManager::AddServerTimer(const std::string& name, DWORD arg, double when, unsigned int npc, bool loop)
 	{
-		sys_log(0, "XXX AddServerTimer %s %d %p", name.c_str(), arg, get_pointer(event));
+		sys_log(0, "XXX AddServerTimer %s %d %.1f", name.c_str(), arg, when);
 		if (m_mapServerTimer.find(make_pair(name, arg)) != m_mapServerTimer.end())
 		{
 			sys_err("already registered server timer name:%s arg:%u", name.c_str(), arg);
 			return;
 		}
-		m_mapServerTimer.insert(make_pair(make_pair(name, arg), event));
+
+		int cycle = (int) rint(PASSES_PER_SEC(when));
+
+		TServerTimer * pTimer = M2_NEW TServerTimer;
+		pTimer->name = name;
+		pTimer->arg = arg;
+		pTimer->npc = npc;
+		pTimer->cycle = loop ? cycle : 0;
+		pTimer->dispatching = false;
+		pTimer->canceled = false;
+
+		m_mapServerTimer.insert(make_pair(make_pair(name, arg), pTimer));
+		ScheduleServerTimer(pTimer, thecore_pulse() + MAX(1, cycle));
 	}
 
-	void CQuestManager::ClearServerTimerNotCancel(const std::string& name, DWORD arg)
+	void CQuestManager::ScheduleServerTimer(TServerTimer * pTimer, int due)
 	{
-		m_mapServerTimer.erase(make_pair(name, arg));
+		TServerTimerBucket & rBucket = m_mapServerTimerBucket[due];
+
+		if (!rBucket.event)
+			rBucket.event = quest_create_server_timer_bucket_event(due);
+
+		pTimer->due = due;
+		rBucket.timers.push_back(pTimer);
+	}
+
+	void CQuestManager::UnscheduleServerTimer(TServerTimer * pTimer)
+	{
+		itertype(m_mapServerTimerBucket) it = m_mapServerTimerBucket.find(pTimer->due);
+
+		if (it == m_mapServerTimerBucket.end())
+			return;
+
+		vector<TServerTimer *> & rTimers = it->second.timers;
+		rTimers.erase(std::remove(rTimers.begin(), rTimers.end(), pTimer), rTimers.end());
+
+		if (rTimers.empty())
+		{
+			event_cancel(&it->second.event);
+			m_mapServerTimerBucket.erase(it);
+		}
+	}
+
+	// ȣ  m_mapServerTimer  .
+	void CQuestManager::CancelServerTimer(TServerTimer * pTimer)
+	{
+		// ︮    DispatchServerTimers  .
+		if (pTimer->dispatching)
+		{
+			pTimer->canceled = true;
+			return;
+		}
+
+		UnscheduleServerTimer(pTimer);
+		M2_DELETE(pTimer);
 	}
 
 	void CQuestManager::ClearServerTimer(const std::string& name, DWORD arg)
@@ -1716,21 +1952,104 @@ namespace quest
 		itertype(m_mapServerTimer) it = m_mapServerTimer.find(make_pair(name, arg));
 		if (it != m_mapServerTimer.end())
 		{
-			LPEVENT event = it->second;
-			event_cancel(&event);
+			TServerTimer * pTimer = it->second;
 			m_mapServerTimer.erase(it);
+			CancelServerTimer(pTimer);
 		}
 	}
 
 	void CQuestManager::CancelServerTimers(DWORD arg)
 	{
 		itertype(m_mapServerTimer) it = m_mapServerTimer.begin();
-		for ( ; it != m_mapServerTimer.end(); ++it) {
-			if (it->first.second == arg) {
-				LPEVENT event = it->second;
-				event_cancel(&event);
-				m_mapServerTimer.erase(it);
+		while (it != m_mapServerTimer.end())
+		{
+			if (it->first.second == arg)
+			{
+				TServerTimer * pTimer = it->second;
+				m_mapServerTimer.erase(it++);
+				CancelServerTimer(pTimer);
 			}
+			else
+				++it;
+		}
+	}
+
+	void CQuestManager::DispatchServerTimers(int pulse)
+	{
+		itertype(m_mapServerTimerBucket) itBucket = m_mapServerTimerBucket.find(pulse);
+
+		if (itBucket == m_mapServerTimerBucket.end())
+			return;
+
+		//  ̺Ʈ   Ƿ  event ʿ .
+		vector<TServerTimer *> timers;
+		timers.swap(itBucket->second.timers);
+		m_mapServerTimerBucket.erase(itBucket);
+
+		++m_dwServerTimerBucketFired;
+
+		for (size_t i = 0; i < timers.size(); ++i)
+			timers[i]->dispatching = true;
+
+		for (size_t i = 0; i < timers.size(); ++i)
+		{
+			TServerTimer * pTimer = timers[i];
+
+			//  Ÿ̸ ũƮ   ִ.
+			if (!pTimer->canceled)
+			{
+				++m_dwServerTimerFired;
+
+				if (!ServerTimer(pTimer->npc, pTimer->arg))
+				{
+					// Ʈ  ̶    ڿ ٽ Ѵ.
+					if (!pTimer->canceled)
+					{
+						pTimer->dispatching = false;
+						ScheduleServerTimer(pTimer, thecore_pulse() + passes_per_sec / 2 + 1);
+						continue;
+					}
+				}
+				else if (!pTimer->canceled)
+				{
+					pTimer->dispatching = false;
+
+					if (pTimer->cycle)
+					{
+						ScheduleServerTimer(pTimer, thecore_pulse() + pTimer->cycle);
+						continue;
+					}
+
+					m_mapServerTimer.erase(make_pair(pTimer->name, pTimer->arg));
+				}
+			}
+
+			M2_DELETE(pTimer);
+		}
+	}
+
+	void CQuestManager::SendServerTimerList(LPCHARACTER ch)
+	{
+		ch->ChatPacket(CHAT_TYPE_INFO, "server timers %u in %u pulses, fired %u in %u batches",
+				(unsigned int) m_mapServerTimer.size(), (unsigned int) m_mapServerTimerBucket.size(),
+				m_dwServerTimerFired, m_dwServerTimerBucketFired);
+
+		int iCount = 0;
+
+		for (itertype(m_mapServerTimer) it = m_mapServerTimer.begin(); it != m_mapServerTimer.end(); ++it)
+		{
+			if (++iCount > 50)
+			{
+				ch->ChatPacket(CHAT_TYPE_INFO, "...");
+				break;
+			}
+
+			const TServerTimer * pTimer = it->second;
+
+			ch->ChatPacket(CHAT_TYPE_INFO, "%s arg %u npc %u in %.1fs%s",
+					pTimer->name.c_str(), pTimer->arg, pTimer->npc,
+					(float) (pTimer->due - thecore_pulse()) / passes_per_sec,
+					pTimer->cycle ? " loop" : "");
 		}
 	}
 
@@ -15,6 +15,10 @@ namespace quest
 
 	bool IsScriptTrue(const char* code, int size);
 	string ScriptToString(const string& str);
+	void PrecompileConditionScript(const char * code, int size);
+	void ForgetConditionScript(const char * code);
+	void PrecompileArgScript(const string & str);
+	void DumpScriptCacheStat();
 
 	class CQuestManager : public singleton<CQuestManager>
 	{
@@ -30,7 +34,7 @@ namespace quest
 			};
 
 			typedef map<string, int>		TEventNameMap;
-			typedef map<unsigned int, PC>	PCMap;
+			typedef boost::unordered_map<unsigned int, PC>	PCMap;	//  ּҰ rehash  ٲ ʴ´.
 
 		public:
 			CQuestManager();
@@ -51,6 +55,7 @@ namespace quest
 
 			PC *		GetPC(unsigned int pc);
 			PC *		GetPCForce(unsigned int pc);	//  PC ٲ ʰ PC ͸ ´.
+			PC *		GetPCForce(LPCHARACTER ch);	// ĳͿ ޾Ƶ ͸ .
 
 			unsigned int	GetCurrentNPCRace();
 			const string & 	GetCurrentQuestName();
@@ -68,10 +73,11 @@ namespace quest
 			LPITEM		GetCurrentItem();
 			void		ClearCurrentItem();
 			void		SetCurrentItem(LPITEM item);
-			void		AddServerTimer(const string& name, DWORD arg, LPEVENT event);
+			void		AddServerTimer(const string& name, DWORD arg, double when, unsigned int npc, bool loop);
 			void		ClearServerTimer(const string& name, DWORD arg);
-			void		ClearServerTimerNotCancel(const string& name, DWORD arg);
 			void		CancelServerTimers(DWORD arg);
+			void		DispatchServerTimers(int pulse);
+			void		SendServerTimerList(LPCHARACTER ch);
 
 			void		SetServerTimerArg(DWORD dwArg);
 			DWORD		GetServerTimerArg();
@@ -176,15 +182,107 @@ namespace quest
 
 			void		RegisterNPCVnum(DWORD dwVnum);
 
+			// quest_gc_managed   lua   GC  ʰ ΰ, ޽  ð Ƽ Ѵ.
+			void		CollectGarbageIdle(long lSlackUsec);
+			void		ResetGCThreshold();
+			void		DumpGCStat();
+			void		DumpThreadPoolStat();
+
+			// Ʈ   C Լ ȣ ð .    .
+			void		StartProfile();
+			void		StopProfile();
+			void		ResetProfile();
+			bool		IsProfiling() const { return m_bProfiling; }
+			bool		DumpProfile(const char * c_pszFileName);
+
+			const char *	GetEventName(int iEventIndex);
+
 		private:
+			struct TQuestProfile
+			{
+				DWORD	dwCalls;
+				DWORD	dwMaxUsec;
+				double	dTotalUsec;
+
+				TQuestProfile() : dwCalls(0), dwMaxUsec(0), dTotalUsec(0.0)
+				{
+				}
+
+				void Add(DWORD dwUsec)
+				{
+					++dwCalls;
+					dTotalUsec += dwUsec;
+
+					if (dwUsec > dwMaxUsec)
+						dwMaxUsec = dwUsec;
+				}
+			};
+
+			struct TQuestProfileKey
+			{
+				DWORD	dwQuestIndex;
+				int	iState;
+				int	iEventIndex;
+
+				bool operator < (const TQuestProfileKey & rhs) const
+				{
+					if (dwQuestIndex != rhs.dwQuestIndex)
+						return dwQuestIndex < rhs.dwQuestIndex;
+
+					if (iState != rhs.iState)
+						return iState < rhs.iState;
+
+					return iEventIndex < rhs.iEventIndex;
+				}
+			};
+
+			static int		ProfiledCFunction(lua_State * L);
+
+			enum
+			{
+				QUEST_GC_OVERDUE_STEPS	= 4,	// ̸ŭ ø  ð ڶ Ѵ.
+				QUEST_GC_SAFETY_STEPS	= 8,	// ̸ŭ ø lua   Ѵ.
+				QUEST_GC_PAUSE_BUCKET_MAX	= 6,
+				QUEST_THREAD_POOL_MAX	= 256,	//   ڷƾ ̸ŭ ΰ ٽ .
+			};
+
 			LPDUNGEON			m_pSelectedDungeon;
 			DWORD			m_dwServerTimerArg;
 
-			map<pair<string, DWORD>, LPEVENT>	m_mapServerTimer;
+			//  Ÿ̸Ӵ ︱ ޽   ̺Ʈ ϳ Ǵ.
+			struct TServerTimer
+			{
+				string		name;
+				DWORD		arg;
+				unsigned int	npc;
+				int		cycle;		// 0 ̸  
+				int		due;		// ︱ ޽
+				bool		dispatching;	//  ︮   ִ
+				bool		canceled;
+			};
+
+			struct TServerTimerBucket
+			{
+				LPEVENT			event;
+				vector<TServerTimer *>	timers;
+
+				TServerTimerBucket() : event(NULL)
+				{
+				}
+			};
+
+			void			ScheduleServerTimer(TServerTimer * pTimer, int due);
+			void			UnscheduleServerTimer(TServerTimer * pTimer);
+			void			CancelServerTimer(TServerTimer * pTimer);
+
+			map<pair<string, DWORD>, TServerTimer *>	m_mapServerTimer;
+			map<int, TServerTimerBucket>	m_mapServerTimerBucket;
+			DWORD			m_dwServerTimerFired;
+			DWORD			m_dwServerTimerBucketFired;
 
 			int				m_iRunningEventIndex;
 
-			map<string, int>		m_mapEventFlag;
+			boost::unordered_map<string, int>	m_mapEventFlag;
 
 			void			GotoSelectState(QuestState& qs);
 			void			GotoPauseState(QuestState& qs);
@@ -257,6 +355,22 @@ namespace quest
 		private:
 			PC*			m_pOtherPCBlockRootPC;
 			std::vector <DWORD>	m_vecPCStack;
+
+			int			m_iGCBaseKB;	//  GC   ũ
+			DWORD			m_dwGCCount;
+			DWORD			m_dwGCOverdueCount;
+			DWORD			m_dwGCMaxPauseUsec;
+			DWORD			m_adwGCPause[QUEST_GC_PAUSE_BUCKET_MAX];
+
+			bool			m_bProfiling;
+			DWORD			m_dwProfileStartTime;
+			map<TQuestProfileKey, TQuestProfile>	m_mapStateProfile;
+			map<string, TQuestProfile>	m_mapNativeProfile;	// Ŭ  ͸  Ƿ  ʴ´.
+
+			vector<pair<lua_State *, int> >	m_vecThreadPool;	// (co, ico)
+			int			m_iLiveThreads;
+			DWORD			m_dwThreadPoolHit;
+			DWORD			m_dwThreadCreate;
 	};
 };
 
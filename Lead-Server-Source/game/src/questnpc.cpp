@@ -26,6 +26,9 @@ namespace quest
 	{
 		m_vnum = vnum;
 
+		// ٽ  when  ۰ Ű  Ƿ ͷ ־    .
+		PrecompileArgScripts(true);
+
 		char buf[PATH_MAX];
 
 		CQuestManager::TEventNameMap::iterator itEventName = CQuestManager::instance().m_mapEventName.begin();
@@ -68,11 +71,40 @@ namespace quest
 				closedir(pdir);
 			}
 		}
+
+		PrecompileArgScripts(false);
+	}
+
+	void NPC::PrecompileArgScripts(bool bForget)
+	{
+		for (int i = 0; i < QUEST_EVENT_COUNT; ++i)
+		{
+			for (itertype(m_mapOwnArgQuest[i]) itQuest = m_mapOwnArgQuest[i].begin(); itQuest != m_mapOwnArgQuest[i].end(); ++itQuest)
+			{
+				for (itertype(itQuest->second) itState = itQuest->second.begin(); itState != itQuest->second.end(); ++itState)
+				{
+					for (itertype(itState->second) it = itState->second.begin(); it != itState->second.end(); ++it)
+					{
+						if (!it->when_condition.empty())
+						{
+							if (bForget)
+								ForgetConditionScript(&it->when_condition[0]);
+							else
+								PrecompileConditionScript(&it->when_condition[0], it->when_condition.size());
+						}
+
+						if (!bForget)
+							PrecompileArgScript(it->arg);
+					}
+				}
+			}
+		}
 	}
 
 	void NPC::LoadStateScript(int event_index, const char* filename, const char* script_name)
 	{
-		ifstream inf(filename);
+		// qc -b   Ʈڵ  Ƿ ̳ʸ д´.
+		ifstream inf(filename, ios::in | ios::binary);
 		const string s(script_name);
 
 		size_t i = s.find('.');
@@ -254,6 +286,7 @@ namespace quest
 				continue;
 
 			sys_log(1, "OnTarget execute qi %u st %d code %s", dwQuestIndex, iState, (const char *) argScript.script.GetCode());
+			CQuestManager::instance().SetCurrentEventIndex(QUEST_TARGET_EVENT);
 			bRet = CQuestManager::ExecuteQuestScript(pc, dwQuestIndex, iState, argScript.script.GetCode(), argScript.script.GetSize());
 			bRet = true;
 			return true;
@@ -485,6 +518,8 @@ namespace quest
 			return false;
 		}
 
+		CQuestManager::instance().SetCurrentEventIndex(EventIndex);
+
 		FuncMissHandleEvent fMiss;
 		FuncMatchHandleEvent fMatch;
 		MatchingQuest(pc, m_mapOwnQuest[EventIndex], fMatch, fMiss);
@@ -606,6 +641,8 @@ namespace quest
 			return false;
 		}
 
+		CQuestManager::instance().SetCurrentEventIndex(EventIndex);
+
 		FuncMissHandleReceiveAllEvent fMiss;
 		FuncMatchHandleReceiveAllEvent fMatch;
 
@@ -724,6 +761,8 @@ namespace quest
 		}
 		*/
 
+		CQuestManager::instance().SetCurrentEventIndex(EventIndex);
+
 		//FuncDoNothing fMiss;
 		FuncMissHandleReceiveAllNoWaitEvent fMiss;
 		FuncMatchHandleReceiveAllNoWaitEvent fMatch;
@@ -752,6 +791,8 @@ namespace quest
 			return false;
 		}
 
+		CQuestManager::instance().SetCurrentEventIndex(EventIndex);
+
 		PC::QuestInfoIterator itPCQuest = pc.quest_find(quest_index);
 
 		if (pc.quest_end() == itPCQuest)
@@ -801,6 +842,8 @@ namespace quest
 			return false;
 		}
 
+		CQuestManager::instance().SetCurrentEventIndex(EventIndex);
+
 		PC::QuestInfoIterator itPCQuest = pc.quest_find(quest_index);
 
 		QuestMapType & rmapEventOwnQuest = m_mapOwnQuest[EventIndex];
@@ -901,6 +944,8 @@ namespace quest
 		const int EventIndex = QUEST_CHAT_EVENT;
 		vector<AArgScript*> AvailScript;
 
+		CQuestManager::instance().SetCurrentEventIndex(EventIndex);
+
 		FuncMatchChatEvent fMatch(AvailScript);
 		FuncMissChatEvent fMiss(AvailScript);
 		MatchingQuest(pc, m_mapOwnArgQuest[EventIndex], fMatch, fMiss);
@@ -16,6 +16,12 @@ namespace quest
 		QUEST_FISH_REFINE_STATE_INDEX = -2,
 	};
 
+	enum
+	{
+		// NPC Ʈ  *   <= PC Ʈ  ̸ MatchingQuest    ã⸦ .
+		MATCHING_QUEST_FIND_RATIO = 8,
+	};
+
 	class PC;
 
 	class NPC
@@ -96,6 +102,7 @@ namespace quest
 			// true if quest still running, false if ended
 
 			void LoadStateScript(int idx, const char* filename, const char* script_name);
+			void PrecompileArgScripts(bool bForget);
 
 			unsigned int m_vnum;
 			QuestMapType m_mapOwnQuest[QUEST_EVENT_COUNT];
@@ -112,6 +119,23 @@ namespace quest
 			PC::QuestInfoIterator itPCQuest = pc.quest_begin();
 			typename TQuestMapType::iterator itQuestMap = QuestMap.begin();
 
+			//   kill ó  NPC  ɸ Ʈ PC   Ʈ ξ 
+			// PC Ʈ ó  ʰ  NPC  Ʈ ãƺ. ȣ  .
+			if (QuestMap.size() * MATCHING_QUEST_FIND_RATIO <= pc.quest_size())
+			{
+				for (; itQuestMap != QuestMap.end(); ++itQuestMap)
+				{
+					itPCQuest = pc.quest_find(itQuestMap->first);
+
+					if (itPCQuest == pc.quest_end())
+						fMiss(itPCQuest, itQuestMap);
+					else
+						fMatch(itPCQuest, itQuestMap);
+				}
+
+				return;
+			}
+
 			while (itQuestMap != QuestMap.end())
 			{
 				if (itPCQuest == pc.quest_end() || itPCQuest->first > itQuestMap->first)
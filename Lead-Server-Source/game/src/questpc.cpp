@@ -586,6 +586,33 @@ namespace quest
 		m_FlagSaveMap.clear();
 	}
 
+	void PC::GetFlagTable(std::vector<TQuestTable> & rvec_kTable) const
+	{
+		rvec_kTable.clear();
+		rvec_kTable.reserve(m_FlagMap.size());
+
+		for (TFlagMap::const_iterator it = m_FlagMap.begin(); it != m_FlagMap.end(); ++it)
+		{
+			const std::string & stComp = it->first;
+			std::string::size_type iPos = stComp.find(".");
+
+			if (iPos == std::string::npos || iPos == 0 || iPos + 1 >= stComp.length())
+				continue;
+
+			if (iPos >= QUEST_NAME_MAX_LEN || stComp.length() - iPos - 1 >= QUEST_STATE_MAX_LEN)
+				continue;
+
+			TQuestTable r;
+
+			r.dwPID = m_dwID;
+			strlcpy(r.szName, stComp.substr(0, iPos).c_str(), sizeof(r.szName));
+			strlcpy(r.szState, stComp.substr(iPos + 1).c_str(), sizeof(r.szState));
+			r.lValue = it->second;
+
+			rvec_kTable.push_back(r);
+		}
+	}
+
 	bool PC::HasQuest(const string & quest_name)
 	{
 		unsigned int qi = CQuestManager::instance().GetQuestIndexByName(quest_name);
@@ -685,7 +712,8 @@ namespace quest
 			if (itNow->second != 0 && itNow->first.compare(0, quest_name_with_dot.size(), quest_name_with_dot) == 0)
 			{
 				//m_FlagMap.erase(itNow);
-				SetFlag(itNow->first, 0);
+				// SetFlag  itNow  Ƿ ̸  ѱ.
+				SetFlag(string(itNow->first), 0);
 			}
 		}
 
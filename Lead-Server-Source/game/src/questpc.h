@@ -1,9 +1,12 @@
 #ifndef __QUEST_PC_H
 #define __QUEST_PC_H
 
+#include <boost/unordered_map.hpp>
+
 #include "quest.h"
 
 class CHARACTER;
+struct SQuestTable;
 
 namespace quest
 {
@@ -48,6 +51,7 @@ namespace quest
 			inline QuestInfoIterator quest_begin();
 			inline QuestInfoIterator quest_end();
 			inline QuestInfoIterator quest_find(DWORD quest_index);
+			inline size_t quest_size() const;
 
 			inline bool IsRunning();
 
@@ -113,6 +117,8 @@ namespace quest
 			void		Build();
 			// DB 
 			void		Save();
+			//  ο    ÷ θ DB      ä. ( ڵ)
+			void		GetFlagTable(std::vector<SQuestTable> & rvec_kTable) const;
 
 			bool		HasReward() { return !m_vRewardData.empty() || m_bIsGivenReward; }
 			void		Reward(LPCHARACTER ch);
@@ -156,7 +162,8 @@ namespace quest
 			QuestState *	m_RunningQuestState;
 			string		m_stCurQuest;
 
-			typedef map<string, int> TFlagMap;
+			// Ʈ ϳ   ȭ    ãǷ ؽ÷ д.
+			typedef boost::unordered_map<string, int> TFlagMap;
 			TFlagMap		m_FlagMap;
 
 			TFlagMap		m_FlagSaveMap;
@@ -188,6 +195,11 @@ namespace quest
 		return m_QuestInfo.find(quest_index);
 	}
 
+	inline size_t PC::quest_size() const
+	{
+		return m_QuestInfo.size();
+	}
+
 	inline bool PC::IsRunning()
 	{
 		return m_RunningQuestState != NULL;
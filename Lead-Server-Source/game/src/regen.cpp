@@ -249,6 +249,55 @@ static bool read_line(FILE *fp, LPREGEN regen)
 	return false;
 }
 
+// Ϻ о   . ó  Ϸ   ϸ  ٽ  ʴ´.
+// regen_reload  .
+typedef std::vector<REGEN> TRegenTemplateVector;
+typedef std::map<std::string, TRegenTemplateVector> TRegenTemplateMap;
+
+static TRegenTemplateMap s_map_regenTemplate;
+
+static const TRegenTemplateVector * regen_get_template(const char* filename)
+{
+	TRegenTemplateMap::iterator it = s_map_regenTemplate.find(filename);
+
+	if (it != s_map_regenTemplate.end())
+		return &it->second;
+
+	FILE* fp = fopen(filename, "rt");
+
+	//   ߿   Ƿ  ʴ´.
+	if (NULL == fp)
+		return NULL;
+
+	TRegenTemplateVector & rvecTemplate = s_map_regenTemplate[filename];
+
+	while (true)
+	{
+		REGEN tmp;
+
+		memset(&tmp, 0, sizeof(tmp));
+
+		if (!read_line(fp, &tmp))
+			break;
+
+		rvecTemplate.push_back(tmp);
+	}
+
+	fclose(fp);
+
+	mem_stat_alloc(MEM_TAG_CACHE, rvecTemplate.capacity() * sizeof(REGEN));
+	sys_log(1, "REGEN_CACHE: %s %u lines", filename, (unsigned int) rvecTemplate.size());
+	return &rvecTemplate;
+}
+
+void regen_clear_cache()
+{
+	for (TRegenTemplateMap::iterator it = s_map_regenTemplate.begin(); it != s_map_regenTemplate.end(); ++it)
+		mem_stat_free(MEM_TAG_CACHE, it->second.capacity() * sizeof(REGEN));
+
+	s_map_regenTemplate.clear();
+}
+
 bool is_regen_exception(long x, long y)
 {
 	LPREGEN_EXCEPTION exc;
@@ -426,22 +475,17 @@ bool regen_do(const char* filename, long lMapIndex, int base_x, int base_y, LPDU
 		return true;
 
 	LPREGEN regen = NULL;
-	FILE* fp = fopen(filename, "rt");
+	const TRegenTemplateVector * pvecTemplate = regen_get_template(filename);
 
-	if (NULL == fp)
+	if (NULL == pvecTemplate)
 	{
 		sys_err("SYSTEM: regen_do: %s: file not found", filename);
 		return false;
 	}
 
-	while (true)
+	for (TRegenTemplateVector::const_iterator it = pvecTemplate->begin(); it != pvecTemplate->end(); ++it)
 	{
-		REGEN tmp;
-
-		memset(&tmp, 0, sizeof(tmp));
-
-		if (!read_line(fp, &tmp))
-			break;
+		REGEN tmp = *it;
 
 		if (tmp.type == REGEN_TYPE_MOB ||
 			tmp.type == REGEN_TYPE_GROUP ||
@@ -516,7 +560,6 @@ bool regen_do(const char* filename, long lMapIndex, int base_x, int base_y, LPDU
 		}
 	}
 
-	fclose(fp);
 	return true;
 }
 
@@ -526,22 +569,17 @@ bool regen_load_in_file(const char* filename, long lMapIndex, int base_x, int ba
 		return true;
 
 	LPREGEN regen = NULL;
-	FILE * fp = fopen(filename, "rt");
+	const TRegenTemplateVector * pvecTemplate = regen_get_template(filename);
 
-	if (NULL == fp)
+	if (NULL == pvecTemplate)
 	{
 		sys_err("SYSTEM: regen_do: %s: file not found", filename);
 		return false;
 	}
 
-	while (true)
+	for (TRegenTemplateVector::const_iterator it = pvecTemplate->begin(); it != pvecTemplate->end(); ++it)
 	{
-		REGEN tmp;
-
-		memset(&tmp, 0, sizeof(tmp));
-
-		if (!read_line(fp, &tmp))
-			break;
+		REGEN tmp = *it;
 
 		if (tmp.type == REGEN_TYPE_MOB ||
 			tmp.type == REGEN_TYPE_GROUP ||
@@ -591,10 +629,104 @@ bool regen_load_in_file(const char* filename, long lMapIndex, int base_x, int ba
 		}
 	}
 
-	fclose(fp);
 	return true;
 }
 
+//  ̺Ʈ  regen  ⿭ ֱ⸸ ϰ, ⿭  pulse
+// regen_spawn_budget  Ѵ.  pulse     pulse  .
+// ֱ ̺Ʈ ϹǷ ״̰,   ŭ ʾ.
+struct SRegenPending
+{
+	LPREGEN	regen;
+	int	iPulse;
+};
+
+static std::deque<SRegenPending> s_deque_kRegenPending;
+
+static DWORD s_dwRegenStatQueued = 0;
+static DWORD s_dwRegenStatSpawned = 0;
+static DWORD s_dwRegenStatMaxBacklog = 0;
+static DWORD s_dwRegenStatWaitPulse = 0;
+static int s_iRegenStatMaxWait = 0;
+
+static void regen_queue_spawn(LPREGEN regen)
+{
+	if (g_iRegenSpawnBudget <= 0)
+	{
+		regen_spawn(regen, false);
+		return;
+	}
+
+	//     ̸   ڶ ŭ ä.
+	if (regen->is_pending)
+		return;
+
+	SRegenPending pending;
+	pending.regen = regen;
+	pending.iPulse = thecore_pulse();
+
+	regen->is_pending = true;
+	s_deque_kRegenPending.push_back(pending);
+
+	++s_dwRegenStatQueued;
+	s_dwRegenStatMaxBacklog = MAX(s_dwRegenStatMaxBacklog, s_deque_kRegenPending.size());
+}
+
+static void regen_remove_pending(long lMapIndex)
+{
+	std::deque<SRegenPending>::iterator it = s_deque_kRegenPending.begin();
+
+	while (it != s_deque_kRegenPending.end())
+	{
+		if (it->regen->lMapIndex == lMapIndex)
+		{
+			it->regen->is_pending = false;
+			it = s_deque_kRegenPending.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+void regen_process_pending()
+{
+	int iBudget = g_iRegenSpawnBudget;
+	int iPulse = thecore_pulse();
+
+	while (!s_deque_kRegenPending.empty() && iBudget > 0)
+	{
+		SRegenPending pending = s_deque_kRegenPending.front();
+		s_deque_kRegenPending.pop_front();
+
+		LPREGEN regen = pending.regen;
+		regen->is_pending = false;
+
+		// ׷         .
+		iBudget -= MAX(1, regen->max_count - regen->count);
+		regen_spawn(regen, false);
+
+		++s_dwRegenStatSpawned;
+		s_dwRegenStatWaitPulse += iPulse - pending.iPulse;
+		s_iRegenStatMaxWait = MAX(s_iRegenStatMaxWait, iPulse - pending.iPulse);
+	}
+}
+
+void regen_dump_stat()
+{
+	if (s_dwRegenStatQueued)
+	{
+		sys_log(0, "REGEN_STAT: queued %u spawned %u backlog %u max_backlog %u avg_wait %.1f max_wait %d pulses",
+				s_dwRegenStatQueued, s_dwRegenStatSpawned, s_deque_kRegenPending.size(), s_dwRegenStatMaxBacklog,
+				s_dwRegenStatSpawned ? (float) s_dwRegenStatWaitPulse / s_dwRegenStatSpawned : 0.0f, s_iRegenStatMaxWait);
+	}
+
+	s_dwRegenStatQueued = 0;
+	s_dwRegenStatSpawned = 0;
+	s_dwRegenStatMaxBacklog = s_deque_kRegenPending.size();
+	s_dwRegenStatWaitPulse = 0;
+	s_iRegenStatMaxWait = 0;
+}
+
 EVENTFUNC(regen_event)
 {
 	regen_event_info* info = dynamic_cast<regen_event_info*>( event->info );
@@ -613,7 +745,7 @@ EVENTFUNC(regen_event)
 	if (regen->time == 0)
 		regen->event = NULL;
 
-	regen_spawn(regen, false);
+	regen_queue_spawn(regen);
 	return PASSES_PER_SEC(regen->time);
 }
 
@@ -623,22 +755,17 @@ bool regen_load(const char* filename, long lMapIndex, int base_x, int base_y)
 		return true;
 
 	LPREGEN regen = NULL;
-	FILE* fp = fopen(filename, "rt");
+	const TRegenTemplateVector * pvecTemplate = regen_get_template(filename);
 
-	if (NULL == fp)
+	if (NULL == pvecTemplate)
 	{
 		sys_log(0, "SYSTEM: regen_load: %s: file not found", filename);
 		return false;
 	}
 
-	while (true)
+	for (TRegenTemplateVector::const_iterator it = pvecTemplate->begin(); it != pvecTemplate->end(); ++it)
 	{
-		REGEN tmp;
-
-		memset(&tmp, 0, sizeof(tmp));
-
-		if (!read_line(fp, &tmp))
-			break;
+		REGEN tmp = *it;
 
 		if (tmp.type == REGEN_TYPE_MOB ||
 			tmp.type == REGEN_TYPE_GROUP ||
@@ -707,7 +834,8 @@ bool regen_load(const char* filename, long lMapIndex, int base_x, int base_y)
 
 				info->regen = regen;
 
-				regen->event = event_create(regen_event, info, PASSES_PER_SEC(number(0, 16)) + PASSES_PER_SEC(regen->time)); 
+				//        pulse  Ƿ pulse  ´.
+				regen->event = event_create(regen_event, info, number(0, PASSES_PER_SEC(16)) + PASSES_PER_SEC(regen->time)); 
 			}
 			//END_NO_REGEN
 		}
@@ -727,7 +855,6 @@ bool regen_load(const char* filename, long lMapIndex, int base_x, int base_y)
 		}
 	}
 
-	fclose(fp);
 	return true;
 }
 
@@ -746,6 +873,8 @@ void regen_free(void)
 
 	regen_list = NULL;
 
+	s_deque_kRegenPending.clear();
+
 	for (exc = regen_exception_list; exc; exc = next_exc)
 	{
 		next_exc = exc->next;
@@ -794,6 +923,8 @@ void regen_free_map(long lMapIndex)
 {
 	LPREGEN		regen, prev, next, next_regen;
 
+	regen_remove_pending(lMapIndex);
+
 	for (regen = regen_list; regen; regen = next_regen)
 	{
 		next_regen = regen->next;
@@ -810,6 +941,9 @@ void regen_reload(long lMapIndex)
 	if (mbMapDataContainer.find(lMapIndex) == mbMapDataContainer.end())
 		return;
 
+	//   ϵ    Ƿ  ٽ а Ѵ.
+	regen_clear_cache();
+
 	char szFilename[256];
 
 	snprintf(szFilename, sizeof(szFilename), "%sregen.txt", mbMapDataContainer[lMapIndex]->szBaseName);
@@ -30,6 +30,8 @@ typedef struct regen
 
 	LPEVENT	event;
 
+	bool	is_pending;	//  ⿭  ִ
+
 	size_t id; // to help dungeon regen identification
 
 	regen() :
@@ -45,6 +47,7 @@ typedef struct regen
 		vnum(0),
 		is_aggressive(0),
 		event(NULL),
+		is_pending(false),
 		id(0)
 	{}
 } REGEN;
@@ -86,11 +89,14 @@ EVENTINFO(dungeon_regen_event_info)
 extern bool	regen_load(const char *filename, long lMapIndex, int base_x, int base_y);
 extern void regen_free_map(long lMapIndex);
 extern void regen_reload(long lMapIndex);
+extern void regen_clear_cache();
 extern void regen_register_map(const char* szBaseName, long lMapIndex, int base_x, int base_y);
 extern bool is_valid_regen(LPREGEN currRegen);
 extern bool	regen_do(const char* filename, long lMapIndex, int base_x, int base_y, LPDUNGEON pDungeon, bool bOnce = true );
 extern bool	regen_load_in_file(const char* filename, long lMapIndex, int base_x, int base_y );
 extern void	regen_free();
+extern void	regen_process_pending();	//  pulse  ⿭ 길ŭ óѴ
+extern void	regen_dump_stat();
 
 extern bool	is_regen_exception(long x, long y);
 extern void	regen_reset(int x, int y);
@@ -1,5 +1,6 @@
 #include "stdafx.h"
 #include "../../libgame/include/attribute.h"
+#include "utils.h"
 #include "sectree_manager.h"
 #include "char.h"
 #include "char_manager.h"
@@ -8,6 +9,30 @@
 #include "desc_manager.h"
 #include "packet.h"
 
+namespace
+{
+	// A functor run over a snapshot may take another snapshot (PacketAround
+	// inside ForEachAround and so on), so free buffers are kept as a stack
+	// rather than one shared vector.
+	thread_local std::vector<FCollectEntity::ListType *> s_vecFreeCollectBuffers;
+}
+
+FCollectEntity::ListType & FCollectEntity::AcquireBuffer()
+{
+	if (s_vecFreeCollectBuffers.empty())
+		return *M2_NEW ListType;
+
+	ListType * pBuffer = s_vecFreeCollectBuffers.back();
+	s_vecFreeCollectBuffers.pop_back();
+	return *pBuffer;
+}
+
+void FCollectEntity::ReleaseBuffer(ListType & buffer)
+{
+	buffer.clear();
+	s_vecFreeCollectBuffers.push_back(&buffer);
+}
+
 SECTREE::SECTREE()
 {
 	Initialize();
@@ -24,6 +49,12 @@ void SECTREE::Initialize()
 	m_pkAttribute = NULL;
 	m_iPCCount = 0;
 	isClone = false;
+
+	for (int i = 0; i < SPATIAL_CELL_COUNT; ++i)
+		m_avec_kSpatial[i].clear();
+
+	for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
+		m_avec_pkKindEntity[i].clear();
 }
 
 void SECTREE::Destroy()
@@ -63,6 +94,12 @@ void SECTREE::Destroy()
 	}
 	m_set_entity.clear();
 
+	for (int i = 0; i < SPATIAL_CELL_COUNT; ++i)
+		m_avec_kSpatial[i].clear();
+
+	for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
+		m_avec_pkKindEntity[i].clear();
+
 	if (!isClone && m_pkAttribute)
 	{
 		M2_DELETE(m_pkAttribute);
@@ -111,7 +148,10 @@ void SECTREE::DecreasePC()
 				if (pkEnt->IsType(ENTITY_CHARACTER))
 				{
 					LPCHARACTER ch = (LPCHARACTER) pkEnt;
-					ch->StopStateMachine();
+
+					// οų ư  ʹ idle    .
+					if (ch->CanGoDormant())
+						ch->StopStateMachine();
 				}
 			}
 		}
@@ -131,12 +171,16 @@ bool SECTREE::InsertEntity(LPENTITY pkEnt)
 	}
 
 	if (pkCurTree)
+	{
 		pkCurTree->m_set_entity.erase(pkEnt);
+		pkCurTree->RemoveSpatial(pkEnt);
+	}
 
 	pkEnt->SetSectree(this);
 	//pkEnt->UpdateSectree();
 
 	m_set_entity.insert(pkEnt);
+	InsertSpatial(pkEnt);
 
 	if (pkEnt->IsType(ENTITY_CHARACTER))
 	{
@@ -167,6 +211,7 @@ void SECTREE::RemoveEntity(LPENTITY pkEnt)
 	}
 	m_set_entity.erase(it);
 
+	RemoveSpatial(pkEnt);
 	pkEnt->SetSectree(NULL);
 
 	if (pkEnt->IsType(ENTITY_CHARACTER))
@@ -176,6 +221,209 @@ void SECTREE::RemoveEntity(LPENTITY pkEnt)
 	}
 }
 
+static DWORD GetSpatialKind(LPENTITY pkEnt)
+{
+	switch (pkEnt->GetType())
+	{
+		case ENTITY_CHARACTER:
+			{
+				LPCHARACTER ch = (LPCHARACTER) pkEnt;
+
+				if (ch->IsPC())
+					return SPATIAL_KIND_PC;
+
+				return ch->IsBuilding() ? SPATIAL_KIND_BUILDING : SPATIAL_KIND_NPC;
+			}
+
+		case ENTITY_ITEM:
+			return SPATIAL_KIND_ITEM;
+
+		case ENTITY_OBJECT:
+			return SPATIAL_KIND_OBJECT;
+	}
+
+	return 0;
+}
+
+// GetSpatialKind gives a single bit, this is its list index or -1
+static int GetSpatialKindIndex(DWORD dwKind)
+{
+	for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
+		if (dwKind == (DWORD) (1 << i))
+			return i;
+
+	return -1;
+}
+
+int SECTREE::GetSpatialCell(long x, long y) const
+{
+	// an entity can sit just outside its sectree until UpdateSectree moves it, keep it in the edge cell
+	long cx = (x - (long) m_id.coord.x * SECTREE_SIZE) / SPATIAL_CELL_SIZE;
+	long cy = (y - (long) m_id.coord.y * SECTREE_SIZE) / SPATIAL_CELL_SIZE;
+
+	cx = MINMAX(0, cx, SPATIAL_CELL_SIDE - 1);
+	cy = MINMAX(0, cy, SPATIAL_CELL_SIDE - 1);
+
+	return cy * SPATIAL_CELL_SIDE + cx;
+}
+
+void SECTREE::InsertSpatial(LPENTITY pkEnt)
+{
+	if (pkEnt->m_iSpatialCell >= 0)
+	{
+		sys_err("entity %p already linked to a spatial cell", get_pointer(pkEnt));
+		return;
+	}
+
+	TSpatialEntry entry;
+
+	entry.x = pkEnt->GetX();
+	entry.y = pkEnt->GetY();
+	entry.pkEnt = pkEnt;
+	entry.dwKind = GetSpatialKind(pkEnt);
+
+	int iCell = GetSpatialCell(entry.x, entry.y);
+
+	pkEnt->m_iSpatialCell = iCell;
+	pkEnt->m_iSpatialSlot = m_avec_kSpatial[iCell].size();
+	m_avec_kSpatial[iCell].push_back(entry);
+
+	int iKind = GetSpatialKindIndex(entry.dwKind);
+
+	if (iKind >= 0)
+	{
+		pkEnt->m_iSpatialKindSlot = m_avec_pkKindEntity[iKind].size();
+		m_avec_pkKindEntity[iKind].push_back(pkEnt);
+	}
+}
+
+void SECTREE::RemoveSpatial(LPENTITY pkEnt)
+{
+	if (pkEnt->m_iSpatialCell < 0)
+		return;
+
+	std::vector<TSpatialEntry> & rvec = m_avec_kSpatial[pkEnt->m_iSpatialCell];
+	int iSlot = pkEnt->m_iSpatialSlot;
+
+	if (iSlot < 0 || iSlot >= (int) rvec.size() || rvec[iSlot].pkEnt != pkEnt)
+	{
+		sys_err("spatial entry mismatch %p cell %d slot %d", get_pointer(pkEnt), pkEnt->m_iSpatialCell, iSlot);
+		return;
+	}
+
+	int iKind = GetSpatialKindIndex(rvec[iSlot].dwKind);
+
+	if (iKind >= 0)
+	{
+		std::vector<LPENTITY> & rvec_kind = m_avec_pkKindEntity[iKind];
+		int iKindSlot = pkEnt->m_iSpatialKindSlot;
+
+		if (iKindSlot >= 0 && iKindSlot < (int) rvec_kind.size() && rvec_kind[iKindSlot] == pkEnt)
+		{
+			rvec_kind[iKindSlot] = rvec_kind.back();
+			rvec_kind[iKindSlot]->m_iSpatialKindSlot = iKindSlot;
+			rvec_kind.pop_back();
+		}
+		else
+			sys_err("spatial kind entry mismatch %p kind %d slot %d", get_pointer(pkEnt), iKind, iKindSlot);
+	}
+
+	pkEnt->m_iSpatialKindSlot = -1;
+
+	if (iSlot != (int) rvec.size() - 1)
+	{
+		rvec[iSlot] = rvec.back();
+		rvec[iSlot].pkEnt->m_iSpatialSlot = iSlot;
+	}
+
+	rvec.pop_back();
+
+	pkEnt->m_iSpatialCell = -1;
+	pkEnt->m_iSpatialSlot = -1;
+}
+
+void SECTREE::MoveSpatial(LPENTITY pkEnt)
+{
+	if (pkEnt->m_iSpatialCell < 0)
+		return;
+
+	int iCell = GetSpatialCell(pkEnt->GetX(), pkEnt->GetY());
+
+	if (iCell == pkEnt->m_iSpatialCell)
+	{
+		TSpatialEntry & entry = m_avec_kSpatial[iCell][pkEnt->m_iSpatialSlot];
+
+		entry.x = pkEnt->GetX();
+		entry.y = pkEnt->GetY();
+		return;
+	}
+
+	RemoveSpatial(pkEnt);
+	InsertSpatial(pkEnt);
+}
+
+void SECTREE::CollectInRange(long x, long y, int iRange, DWORD dwKindMask, std::vector<LPENTITY> & r_vec, std::vector<int> * pvec_iDist)
+{
+	if (!GetKindCount(dwKindMask))
+		return;
+
+	// no range and no distances wanted: the kind lists are all that is needed
+	if (iRange < 0 && !pvec_iDist)
+	{
+		CollectKind(dwKindMask, r_vec);
+		return;
+	}
+
+	long csx = 0, csy = 0, cex = SPATIAL_CELL_SIDE - 1, cey = SPATIAL_CELL_SIDE - 1;
+
+	if (iRange >= 0)
+	{
+		// DISTANCE_APPROX is at least 123/128 of the larger axis, so the box has to be a bit wider than the range
+		long lBox = iRange + iRange / 24 + 1;
+		long sx = x - lBox - (long) m_id.coord.x * SECTREE_SIZE;
+		long sy = y - lBox - (long) m_id.coord.y * SECTREE_SIZE;
+		long ex = x + lBox - (long) m_id.coord.x * SECTREE_SIZE;
+		long ey = y + lBox - (long) m_id.coord.y * SECTREE_SIZE;
+
+		if (ex < 0 || ey < 0 || sx >= SECTREE_SIZE || sy >= SECTREE_SIZE)
+			return;
+
+		csx = MAX(0, sx) / SPATIAL_CELL_SIZE;
+		csy = MAX(0, sy) / SPATIAL_CELL_SIZE;
+		cex = MIN(SECTREE_SIZE - 1, ex) / SPATIAL_CELL_SIZE;
+		cey = MIN(SECTREE_SIZE - 1, ey) / SPATIAL_CELL_SIZE;
+	}
+
+	for (long cy = csy; cy <= cey; ++cy)
+	{
+		for (long cx = csx; cx <= cex; ++cx)
+		{
+			const std::vector<TSpatialEntry> & rvec = m_avec_kSpatial[cy * SPATIAL_CELL_SIDE + cx];
+
+			for (size_t i = 0; i < rvec.size(); ++i)
+			{
+				const TSpatialEntry & entry = rvec[i];
+
+				if (!(entry.dwKind & dwKindMask))
+					continue;
+
+				if (iRange >= 0 || pvec_iDist)
+				{
+					int iDist = DISTANCE_APPROX(entry.x - x, entry.y - y);
+
+					if (iRange >= 0 && iDist > iRange)
+						continue;
+
+					if (pvec_iDist)
+						pvec_iDist->push_back(iDist);
+				}
+
+				r_vec.push_back(entry.pkEnt);
+			}
+		}
+	}
+}
+
 void SECTREE::BindAttribute(CAttribute * pkAttribute)
 {
 	m_pkAttribute = pkAttribute;
@@ -187,18 +435,67 @@ void SECTREE::CloneAttribute(LPSECTREE tree)
 	isClone = true;
 }
 
+void SECTREE::DetachAttribute()
+{
+	if (!isClone || !m_pkAttribute)
+		return;
+
+	m_pkAttribute = M2_NEW CAttribute(*m_pkAttribute);
+	isClone = false;
+}
+
 void SECTREE::SetAttribute(DWORD x, DWORD y, DWORD dwAttr)
 {
 	assert(m_pkAttribute != NULL);
+	DetachAttribute();
 	m_pkAttribute->Set(x, y, dwAttr);
 }
 
 void SECTREE::RemoveAttribute(DWORD x, DWORD y, DWORD dwAttr)
 {
 	assert(m_pkAttribute != NULL);
+	DetachAttribute();
 	m_pkAttribute->Remove(x, y, dwAttr);
 }
 
+void SECTREE::CollectKind(DWORD dwKindMask, std::vector<LPENTITY> & r_vec) const
+{
+	for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
+		if (dwKindMask & (1 << i))
+			r_vec.insert(r_vec.end(), m_avec_pkKindEntity[i].begin(), m_avec_pkKindEntity[i].end());
+}
+
+int SECTREE::GetKindCount(DWORD dwKindMask) const
+{
+	int iCount = 0;
+
+	for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
+		if (dwKindMask & (1 << i))
+			iCount += m_avec_pkKindEntity[i].size();
+
+	return iCount;
+}
+
+size_t SECTREE::GetMemorySize() const
+{
+	size_t size = sizeof(*this);
+
+	// list node: value plus two links
+	size += m_neighbor_list.size() * sizeof(void *) * 3;
+	size += m_set_entity.bucket_count() * sizeof(void *) + m_set_entity.size() * sizeof(void *) * 2;
+
+	for (int i = 0; i < SPATIAL_CELL_COUNT; ++i)
+		size += m_avec_kSpatial[i].capacity() * sizeof(TSpatialEntry);
+
+	for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
+		size += m_avec_pkKindEntity[i].capacity() * sizeof(LPENTITY);
+
+	if (!isClone && m_pkAttribute)
+		size += m_pkAttribute->GetMemorySize();
+
+	return size;
+}
+
 DWORD SECTREE::GetAttribute(long x, long y)
 {
 	assert(m_pkAttribute != NULL);
@@ -10,6 +10,28 @@ enum ESectree
 	CELL_SIZE		= 50
 };
 
+// Entity kinds for the spatial queries, taken when an entity enters a sectree.
+enum ESpatialKind
+{
+	SPATIAL_KIND_PC		= (1 << 0),
+	SPATIAL_KIND_NPC	= (1 << 1),	// any non PC character except buildings
+	SPATIAL_KIND_BUILDING	= (1 << 2),
+	SPATIAL_KIND_ITEM	= (1 << 3),
+	SPATIAL_KIND_OBJECT	= (1 << 4),
+
+	SPATIAL_KIND_CHARACTER	= SPATIAL_KIND_PC | SPATIAL_KIND_NPC | SPATIAL_KIND_BUILDING,
+	SPATIAL_KIND_ALL	= SPATIAL_KIND_CHARACTER | SPATIAL_KIND_ITEM | SPATIAL_KIND_OBJECT,
+	SPATIAL_KIND_MAX_NUM	= 5,
+};
+
+typedef struct SSpatialEntry
+{
+	long		x;
+	long		y;
+	LPENTITY	pkEnt;
+	DWORD		dwKind;
+} TSpatialEntry;
+
 typedef struct sectree_coord
 {
 	unsigned            x : 16;
@@ -31,6 +53,11 @@ enum
 };
 
 struct FCollectEntity {
+	typedef std::vector<LPENTITY> ListType;
+
+	FCollectEntity() : result(AcquireBuffer()) {}
+	~FCollectEntity() { ReleaseBuffer(result); }
+
 	void operator()(LPENTITY entity) {
 		// Consider removing sanity check after debug pass
 		/*
@@ -73,8 +100,15 @@ struct FCollectEntity {
 			f(entity);
 		}
 	}
-	typedef std::vector<LPENTITY> ListType;
-	ListType result; // list collected
+	ListType & result; // list collected
+
+	private:
+		// Buffers are recycled so a snapshot costs no allocation once warmed up
+		static ListType & AcquireBuffer();
+		static void ReleaseBuffer(ListType & buffer);
+
+		FCollectEntity(const FCollectEntity &);
+		FCollectEntity & operator=(const FCollectEntity &);
 };
 
 class CAttribute;
@@ -126,6 +160,31 @@ class SECTREE
 			*/
 		}
 
+		// Like ForEachAround, over the entities of the given kinds whose
+		// DISTANCE_APPROX from (x, y) is at most iRange. Only the spatial
+		// cells overlapping the range are read. iRange < 0 means no range
+		// check, the whole neighborhood is walked for the kinds.
+		template <class _Func> void ForEachAroundInRange(long x, long y, int iRange, DWORD dwKindMask, _Func & func)
+		{
+			FCollectEntity collector;
+			LPSECTREE_LIST::iterator it = m_neighbor_list.begin();
+			for ( ; it != m_neighbor_list.end(); ++it)
+				(*it)->CollectInRange(x, y, iRange, dwKindMask, collector.result, NULL);
+			collector.ForEach(func);
+		}
+
+		// Like ForEachAround, over the entities of the given kinds only. The
+		// per kind lists are read, so a character scan never walks the
+		// buildings, objects and ground items of the neighborhood.
+		template <class _Func> void ForEachAroundKind(DWORD dwKindMask, _Func & func)
+		{
+			FCollectEntity collector;
+			LPSECTREE_LIST::iterator it = m_neighbor_list.begin();
+			for ( ; it != m_neighbor_list.end(); ++it)
+				(*it)->CollectKind(dwKindMask, collector.result);
+			collector.ForEach(func);
+		}
+
 		template <class _Func> void for_each_for_find_victim(_Func & func)
 		{
 			LPSECTREE_LIST::iterator it_tree = m_neighbor_list.begin();
@@ -139,13 +198,20 @@ class SECTREE
 		}
 		template <class _Func> bool for_each_entity_for_find_victim(_Func & func)
 		{
-			itertype(m_set_entity) it = m_set_entity.begin();
-
-			while (it != m_set_entity.end())
+			// victims are characters, the item and object lists are not read
+			for (int i = 0; i < SPATIAL_KIND_MAX_NUM; ++i)
 			{
-				// ã ٷ 
-				if ( func(*it++) )
-					return true;
+				if (!(SPATIAL_KIND_CHARACTER & (1 << i)))
+					continue;
+
+				const std::vector<LPENTITY> & rvec = m_avec_pkKindEntity[i];
+
+				for (size_t j = 0; j < rvec.size(); ++j)
+				{
+					// ã ٷ 
+					if ( func(rvec[j]) )
+						return true;
+				}
 			}
 			return false;
 		}
@@ -168,6 +234,7 @@ class SECTREE
 
 		void				IncreasePC();
 		void				DecreasePC();
+		int				GetPCCount() const	{ return m_iPCCount; }
 
 		void				BindAttribute(CAttribute * pkAttribute);
 
@@ -183,6 +250,24 @@ class SECTREE
 		void				SetAttribute(DWORD x, DWORD y, DWORD dwAttr);
 		void				RemoveAttribute(DWORD x, DWORD y, DWORD dwAttr);
 
+		size_t				GetMemorySize() const;	// approximate bytes owned by this sectree
+
+		enum
+		{
+			SPATIAL_CELL_SIZE	= 1600,
+			SPATIAL_CELL_SIDE	= SECTREE_SIZE / SPATIAL_CELL_SIZE,
+			SPATIAL_CELL_COUNT	= SPATIAL_CELL_SIDE * SPATIAL_CELL_SIDE,
+		};
+
+		void				MoveSpatial(LPENTITY pkEnt);
+
+		// Appends the entities of the kinds in range to r_vec, and their
+		// distances to pvec_iDist when it is given. See ForEachAroundInRange.
+		void				CollectInRange(long x, long y, int iRange, DWORD dwKindMask, std::vector<LPENTITY> & r_vec, std::vector<int> * pvec_iDist);
+		// Appends the entities of the kinds in this sectree only.
+		void				CollectKind(DWORD dwKindMask, std::vector<LPENTITY> & r_vec) const;
+		int				GetKindCount(DWORD dwKindMask) const;
+
 	private:
 		template <class _Func> void for_each_entity(_Func & func)
 		{
@@ -206,6 +291,19 @@ class SECTREE
 		bool				isClone;
 
 		CAttribute *			m_pkAttribute;
+
+		// a cloned sectree gets its own copy of the attribute before the first change
+		void				DetachAttribute();
+
+		void				InsertSpatial(LPENTITY pkEnt);
+		void				RemoveSpatial(LPENTITY pkEnt);
+		int				GetSpatialCell(long x, long y) const;
+
+		// entity positions bucketed by SPATIAL_CELL_SIZE cells, kept in
+		// step with SetXYZ so queries read packed arrays instead of entities
+		std::vector<TSpatialEntry>	m_avec_kSpatial[SPATIAL_CELL_COUNT];
+		// the same entities split by kind, unordered (removal swaps the last in)
+		std::vector<LPENTITY>		m_avec_pkKindEntity[SPATIAL_KIND_MAX_NUM];
 };
 
 #endif
@@ -1,5 +1,8 @@
 #include "stdafx.h"
 #include <sstream>
+#ifndef __WIN32__
+#include <sys/mman.h>
+#endif
 #include "../../libgame/include/targa.h"
 #include "../../libgame/include/attribute.h"
 #include "config.h"
@@ -17,48 +20,111 @@
 #include "packet.h"
 #include "start_position.h"
 #include "dev_log.h"
+#include "path_finder.h"
 
 WORD SECTREE_MANAGER::current_sectree_version = MAKEWORD(0, 3);
 
-SECTREE_MAP::SECTREE_MAP()
+SECTREE_MAP::SECTREE_MAP() : grid_x_(0), grid_y_(0), grid_width_(0), grid_height_(0), clone_block_(NULL), walkable_(NULL), walkable_owner_(false), mem_stat_bytes_(0)
 {
 	memset( &m_setting, 0, sizeof(m_setting) );
 }
 
 SECTREE_MAP::~SECTREE_MAP()
 {
-	MapType::iterator it = map_.begin();
+	mem_stat_free(MEM_TAG_SECTREE, mem_stat_bytes_);
 
-	while (it != map_.end()) {
-		LPSECTREE sectree = (it++)->second;
-		M2_DELETE(sectree);
+	if (clone_block_)
+	{
+		map_.clear();
+		M2_DELETE_ARRAY(clone_block_);
+		clone_block_ = NULL;
+	}
+	else
+	{
+		MapType::iterator it = map_.begin();
+
+		while (it != map_.end()) {
+			LPSECTREE sectree = (it++)->second;
+			M2_DELETE(sectree);
+		}
 	}
 
 	map_.clear();
+	grid_.clear();
+
+	if (walkable_owner_)
+		M2_DELETE(walkable_);
+
+	walkable_ = NULL;
 }
 
-SECTREE_MAP::SECTREE_MAP(SECTREE_MAP & r)
+// Private map copy. Only the per-instance entity lists are new, the attribute
+// grids stay shared with the original until SECTREE::SetAttribute copies one.
+SECTREE_MAP::SECTREE_MAP(SECTREE_MAP & r) : grid_x_(0), grid_y_(0), grid_width_(0), grid_height_(0), clone_block_(NULL), walkable_(r.walkable_), walkable_owner_(false), mem_stat_bytes_(0)
 {
 	m_setting = r.m_setting;
 
-	MapType::iterator it = r.map_.begin();
+	if (!r.map_.empty())
+		clone_block_ = M2_NEW SECTREE[r.map_.size()];
 
-	while (it != r.map_.end())
-	{
-		LPSECTREE tree = M2_NEW SECTREE;
+	LPSECTREE tree = clone_block_;
 
+	for (MapType::iterator it = r.map_.begin(); it != r.map_.end(); ++it, ++tree)
+	{
 		tree->m_id.coord = it->second->m_id.coord;
 		tree->CloneAttribute(it->second);
 
-		map_.insert(MapType::value_type(it->first, tree));
-		++it;
+		// source is sorted, so every insert lands at the end
+		map_.insert(map_.end(), MapType::value_type(it->first, tree));
 	}
 
 	Build();
 }
 
+size_t SECTREE_MAP::GetMemorySize() const
+{
+	size_t size = sizeof(*this) + grid_.capacity() * sizeof(LPSECTREE);
+
+	// std::map node: value plus three links and the color
+	size += map_.size() * (sizeof(MapType::value_type) + sizeof(void *) * 4);
+
+	for (MapType::const_iterator it = map_.begin(); it != map_.end(); ++it)
+		size += it->second->GetMemorySize();
+
+	if (walkable_owner_)
+	{
+		size += sizeof(SWalkable);
+
+		for (int i = 0; i < WALKABLE_MAX_NUM; ++i)
+			size += walkable_->vec_kSpan[i].capacity() * sizeof(SWalkableSpan);
+	}
+
+	return size;
+}
+
+void SECTREE_MAP::UpdateMemStat()
+{
+	mem_stat_free(MEM_TAG_SECTREE, mem_stat_bytes_);
+	mem_stat_bytes_ = GetMemorySize();
+	mem_stat_alloc(MEM_TAG_SECTREE, mem_stat_bytes_);
+}
+
 LPSECTREE SECTREE_MAP::Find(DWORD dwPackage)
 {
+	if (!grid_.empty())
+	{
+		SECTREEID id;
+		id.package = dwPackage;
+
+		DWORD gx = id.coord.x - grid_x_;
+		DWORD gy = id.coord.y - grid_y_;
+
+		if (gx >= grid_width_ || gy >= grid_height_)
+			return NULL;
+
+		return grid_[gy * grid_width_ + gx];
+	}
+
 	MapType::iterator it = map_.find(dwPackage);
 
 	if (it == map_.end())
@@ -69,6 +135,18 @@ LPSECTREE SECTREE_MAP::Find(DWORD dwPackage)
 
 LPSECTREE SECTREE_MAP::Find(DWORD x, DWORD y)
 {
+	if (!grid_.empty())
+	{
+		// same 16 bit truncation as SECTREE_COORD
+		DWORD gx = ((x / SECTREE_SIZE) & 0xffff) - grid_x_;
+		DWORD gy = ((y / SECTREE_SIZE) & 0xffff) - grid_y_;
+
+		if (gx >= grid_width_ || gy >= grid_height_)
+			return NULL;
+
+		return grid_[gy * grid_width_ + gx];
+	}
+
 	SECTREEID id;
 	id.coord.x = x / SECTREE_SIZE;
 	id.coord.y = y / SECTREE_SIZE;
@@ -92,6 +170,8 @@ void SECTREE_MAP::Build()
 		{  SECTREE_SIZE,	 SECTREE_SIZE	},
 	};
 
+	BuildGrid();
+
 	MapType::iterator it = map_.begin();
 
 	while (it != map_.end())
@@ -118,6 +198,168 @@ void SECTREE_MAP::Build()
 
 		++it;
 	}
+
+	UpdateMemStat();
+}
+
+void SECTREE_MAP::BuildGrid()
+{
+	// keep large enough for any real map, a broken setting falls back to map_
+	const DWORD MAX_GRID_CELLS = 1 << 20;
+
+	grid_.clear();
+
+	if (map_.empty())
+		return;
+
+	DWORD min_x = 0xffff, min_y = 0xffff, max_x = 0, max_y = 0;
+
+	for (MapType::iterator it = map_.begin(); it != map_.end(); ++it)
+	{
+		const SECTREE_COORD & coord = it->second->m_id.coord;
+
+		min_x = MIN(min_x, coord.x);
+		min_y = MIN(min_y, coord.y);
+		max_x = MAX(max_x, coord.x);
+		max_y = MAX(max_y, coord.y);
+	}
+
+	DWORD width = max_x - min_x + 1;
+	DWORD height = max_y - min_y + 1;
+
+	if (width * height > MAX_GRID_CELLS)
+	{
+		sys_err("sectree grid too large (%ux%u) for map %d, using tree lookup", width, height, m_setting.iIndex);
+		return;
+	}
+
+	grid_x_ = min_x;
+	grid_y_ = min_y;
+	grid_width_ = width;
+	grid_height_ = height;
+	grid_.assign(width * height, (LPSECTREE) NULL);
+
+	for (MapType::iterator it = map_.begin(); it != map_.end(); ++it)
+	{
+		const SECTREE_COORD & coord = it->second->m_id.coord;
+		grid_[(coord.y - min_y) * width + (coord.x - min_x)] = it->second;
+	}
+}
+
+void SECTREE_MAP::BuildWalkable()
+{
+	static const DWORD s_adwExclude[WALKABLE_MAX_NUM] =
+	{
+		ATTR_BLOCK | ATTR_OBJECT,
+		ATTR_BLOCK | ATTR_OBJECT | ATTR_BANPK,
+	};
+
+	const int MARGIN = 2;
+	const int CELLS_PER_SECTREE = SECTREE_SIZE / CELL_SIZE;
+
+	if (!walkable_owner_)
+	{
+		walkable_ = M2_NEW SWalkable;
+		walkable_owner_ = true;
+	}
+
+	for (int i = 0; i < WALKABLE_MAX_NUM; ++i)
+	{
+		walkable_->vec_kSpan[i].clear();
+		walkable_->adwCellCount[i] = 0;
+	}
+
+	int iCellWidth = MIN(m_setting.iWidth / CELL_SIZE, 0xffff);
+	int iCellHeight = MIN(m_setting.iHeight / CELL_SIZE, 0xffff);
+	int iSectreeCols = (iCellWidth + CELLS_PER_SECTREE - 1) / CELLS_PER_SECTREE;
+
+	std::vector<DWORD> vec_dwRow(iSectreeCols * CELLS_PER_SECTREE);
+
+	for (int cy = MARGIN; cy < iCellHeight - MARGIN; ++cy)
+	{
+		long y = m_setting.iBaseY + cy * CELL_SIZE;
+
+		//   Ӽ sectree  .     .
+		for (int sx = 0; sx < iSectreeCols; ++sx)
+		{
+			LPSECTREE tree = Find(m_setting.iBaseX + sx * SECTREE_SIZE, y);
+			DWORD * pdwRow = &vec_dwRow[sx * CELLS_PER_SECTREE];
+
+			if (tree && tree->m_pkAttribute)
+				tree->m_pkAttribute->CopyRow((y % SECTREE_SIZE) / CELL_SIZE, pdwRow);
+			else
+				std::fill(pdwRow, pdwRow + CELLS_PER_SECTREE, (DWORD) ATTR_BLOCK);
+		}
+
+		for (int i = 0; i < WALKABLE_MAX_NUM; ++i)
+		{
+			int iStart = -1;
+
+			for (int cx = MARGIN; cx <= iCellWidth - MARGIN; ++cx)
+			{
+				if (cx < iCellWidth - MARGIN && !IS_SET(vec_dwRow[cx], s_adwExclude[i]))
+				{
+					if (iStart < 0)
+						iStart = cx;
+
+					continue;
+				}
+
+				if (iStart < 0)
+					continue;
+
+				SWalkableSpan span;
+				span.dwFirst = walkable_->adwCellCount[i];
+				span.wCellX = iStart;
+				span.wCellY = cy;
+				span.wLength = cx - iStart;
+
+				walkable_->vec_kSpan[i].push_back(span);
+				walkable_->adwCellCount[i] += span.wLength;
+				iStart = -1;
+			}
+		}
+	}
+
+	sys_log(0, "WALKABLE: map %d movable %u cells %u spans, spawn %u cells %u spans",
+			m_setting.iIndex,
+			walkable_->adwCellCount[WALKABLE_MOVABLE], walkable_->vec_kSpan[WALKABLE_MOVABLE].size(),
+			walkable_->adwCellCount[WALKABLE_SPAWN], walkable_->vec_kSpan[WALKABLE_SPAWN].size());
+}
+
+struct FWalkableSpanFirst
+{
+	template <typename T>
+	bool operator () (DWORD dwIndex, const T & r) const
+	{
+		return dwIndex < r.dwFirst;
+	}
+};
+
+bool SECTREE_MAP::GetRandomWalkablePosition(int iType, long & r_x, long & r_y)
+{
+	if (!walkable_ || iType < 0 || iType >= WALKABLE_MAX_NUM || !walkable_->adwCellCount[iType])
+		return false;
+
+	const std::vector<SWalkableSpan> & r_vec = walkable_->vec_kSpan[iType];
+
+	DWORD dwIndex = number(0, walkable_->adwCellCount[iType] - 1);
+
+	// dwFirst  dwIndex   
+	std::vector<SWalkableSpan>::const_iterator it = std::upper_bound(r_vec.begin(), r_vec.end(), dwIndex, FWalkableSpanFirst());
+	const SWalkableSpan & r = *(--it);
+
+	r_x = m_setting.iBaseX + (r.wCellX + (dwIndex - r.dwFirst)) * CELL_SIZE + number(0, CELL_SIZE - 1);
+	r_y = m_setting.iBaseY + r.wCellY * CELL_SIZE + number(0, CELL_SIZE - 1);
+	return true;
+}
+
+DWORD SECTREE_MAP::GetWalkableCellCount(int iType) const
+{
+	if (!walkable_ || iType < 0 || iType >= WALKABLE_MAX_NUM)
+		return 0;
+
+	return walkable_->adwCellCount[iType];
 }
 
 SECTREE_MANAGER::SECTREE_MANAGER()
@@ -383,32 +625,470 @@ bool SECTREE_MANAGER::LoadMapRegion(const char * c_pszFileName, TMapSetting & r_
 	return true;
 }
 
-bool SECTREE_MANAGER::LoadAttribute(LPSECTREE_MAP pkMapSectree, const char * c_pszFileName, TMapSetting & r_setting)
+// server_attr  ϳ б ۾.  Ǯ CAttribute  ۾ 忡 ϰ,
+// sectree  ̴ Ͱ  α״  忡 Ѵ.
+struct SAttrLoadJob
 {
-	FILE * fp = fopen(c_pszFileName, "rb");
+	std::string	stFileName;
+	std::string	stMapName;
+	TMapSetting	setting;
+	LPSECTREE_MAP	pkMapSectree;
+
+	int		iWidth;
+	int		iHeight;
+	std::vector<CAttribute *>	vec_pkAttr;	// y * iWidth + x 
+	bool		bOpenFailed;
+	int		iFailIndex;	//  ġ  Ǯ ߴ. -1 ̸  Ǯ
+	lzo_uint	uiFailDestSize;
+	bool		bFromSnapshot;
+	bool		bSnapshotSaveFailed;
+};
 
-	if (!fp)
+static const size_t c_uAttrDataSize = sizeof(DWORD) * (SECTREE_SIZE / CELL_SIZE) * (SECTREE_SIZE / CELL_SIZE);
+
+static void LoadAttributeData(const BYTE * pbData, size_t uSize, SAttrLoadJob & rJob)
+{
+	const BYTE * pbEnd = pbData + uSize;
+
+	if (uSize < sizeof(int) * 2)
 	{
-		sys_err("SECTREE_MANAGER::LoadAttribute : cannot open %s", c_pszFileName);
+		rJob.iFailIndex = 0;
+		return;
+	}
+
+	memcpy(&rJob.iWidth, pbData, sizeof(int));
+	memcpy(&rJob.iHeight, pbData + sizeof(int), sizeof(int));
+	pbData += sizeof(int) * 2;
+
+	if (rJob.iWidth <= 0 || rJob.iHeight <= 0)
+		return;
+
+	// LZOManager::Decompress  work memory   Ƿ  忡 ҷ ȴ.
+	size_t maxMemSize = LZOManager::instance().GetMaxCompressedSize(c_uAttrDataSize);
+	std::vector<DWORD> vec_dwAttr(maxMemSize);
+
+	rJob.vec_pkAttr.reserve(rJob.iWidth * rJob.iHeight);
+
+	for (int i = 0; i < rJob.iWidth * rJob.iHeight; ++i)
+	{
+		unsigned int uiSize;
+
+		if (pbEnd - pbData < (long) sizeof(int))
+		{
+			rJob.iFailIndex = i;
+			return;
+		}
+
+		memcpy(&uiSize, pbData, sizeof(int));
+		pbData += sizeof(int);
+
+		if ((size_t) (pbEnd - pbData) < uiSize)
+			uiSize = pbEnd - pbData;
+
+		lzo_uint uiDestSize = sizeof(DWORD) * maxMemSize;
+		LZOManager::instance().Decompress(pbData, uiSize, (BYTE *) &vec_dwAttr[0], &uiDestSize);
+		pbData += uiSize;
+
+		if (uiDestSize != c_uAttrDataSize)
+		{
+			rJob.iFailIndex = i;
+			rJob.uiFailDestSize = uiDestSize;
+			return;
+		}
+
+		rJob.vec_pkAttr.push_back(M2_NEW CAttribute(&vec_dwAttr[0], SECTREE_SIZE / CELL_SIZE, SECTREE_SIZE / CELL_SIZE));
+	}
+}
+
+#ifndef __WIN32__
+// Ǯ  CAttribute  ״   . server_attr  ũ ð 
+//  ÿ  Ǯ ʰ   ؼ ͸  .
+//  ӽ äε     ȴ.
+enum
+{
+	ATTR_SNAPSHOT_MAGIC	= 0x4e534154,	// "TASN"
+	ATTR_SNAPSHOT_VERSION	= 1,		// CAttribute  ޸ ġ ٲ ø
+	ATTR_SNAPSHOT_ALIGN	= 8,
+	ATTR_SNAPSHOT_MAX_SIDE	= 1024,		//   sectree ,   
+};
+
+struct SAttrSnapshotHeader
+{
+	DWORD	dwMagic;
+	DWORD	dwVersion;
+	DWORD	dwSrcSize;
+	DWORD	dwSrcMTime;
+	int	iWidth;
+	int	iHeight;
+	DWORD	dwCellCount;	// sectree    
+};
+
+struct SAttrSnapshotEntry
+{
+	int	iDataType;
+	DWORD	dwDefaultAttr;
+	DWORD	dwOffset;	// 0 ̸   dwDefaultAttr θ ä sectree
+	DWORD	dwSize;
+};
+
+static size_t AlignAttrSnapshot(size_t uSize)
+{
+	return (uSize + ATTR_SNAPSHOT_ALIGN - 1) & ~(size_t) (ATTR_SNAPSHOT_ALIGN - 1);
+}
+
+static std::string GetAttrSnapshotFileName(const SAttrLoadJob & rJob)
+{
+	return g_stAttrSnapshotDir + "/" + rJob.stMapName + ".attr";
+}
+
+static bool LoadAttributeSnapshot(SAttrLoadJob & rJob, const struct stat & c_rSrcStat)
+{
+	std::string stFileName = GetAttrSnapshotFileName(rJob);
+	int fd = open(stFileName.c_str(), O_RDONLY);
+
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+
+	if (fstat(fd, &st) < 0 || st.st_size < (off_t) sizeof(SAttrSnapshotHeader))
+	{
+		close(fd);
+		return false;
+	}
+
+	void * pvMap = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (pvMap == MAP_FAILED)
+		return false;
+
+	const BYTE * pbBase = (const BYTE *) pvMap;
+	size_t uSize = st.st_size;
+	const SAttrSnapshotHeader * pHeader = (const SAttrSnapshotHeader *) pbBase;
+	size_t uCount = 0;
+
+	if (pHeader->dwMagic == ATTR_SNAPSHOT_MAGIC &&
+			pHeader->dwVersion == ATTR_SNAPSHOT_VERSION &&
+			pHeader->dwSrcSize == (DWORD) c_rSrcStat.st_size &&
+			pHeader->dwSrcMTime == (DWORD) c_rSrcStat.st_mtime &&
+			pHeader->dwCellCount == SECTREE_SIZE / CELL_SIZE &&
+			pHeader->iWidth > 0 && pHeader->iWidth <= ATTR_SNAPSHOT_MAX_SIDE &&
+			pHeader->iHeight > 0 && pHeader->iHeight <= ATTR_SNAPSHOT_MAX_SIDE)
+		uCount = pHeader->iWidth * pHeader->iHeight;
+
+	if (!uCount || sizeof(SAttrSnapshotHeader) + uCount * sizeof(SAttrSnapshotEntry) > uSize)
+	{
+		munmap(pvMap, st.st_size);
+		return false;
+	}
+
+	const SAttrSnapshotEntry * pEntry = (const SAttrSnapshotEntry *) (pbBase + sizeof(SAttrSnapshotHeader));
+	std::vector<CAttribute *> vec_pkAttr;
+	vec_pkAttr.reserve(uCount);
+
+	for (size_t i = 0; i < uCount; ++i)
+	{
+		const SAttrSnapshotEntry & e = pEntry[i];
+
+		if (e.iDataType < D_DWORD || e.iDataType > D_BIT)
+			break;
+
+		if (e.dwOffset && ((size_t) e.dwOffset > uSize || e.dwSize > uSize - e.dwOffset))
+			break;
+
+		CAttribute * pkAttr = M2_NEW CAttribute(e.iDataType, e.dwDefaultAttr, SECTREE_SIZE / CELL_SIZE, SECTREE_SIZE / CELL_SIZE,
+				e.dwOffset ? pbBase + e.dwOffset : NULL);
+
+		if (e.dwOffset && pkAttr->GetDataSize() != e.dwSize)
+		{
+			M2_DELETE(pkAttr);
+			break;
+		}
+
+		vec_pkAttr.push_back(pkAttr);
+	}
+
+	if (vec_pkAttr.size() != uCount)
+	{
+		for (size_t i = 0; i < vec_pkAttr.size(); ++i)
+			M2_DELETE(vec_pkAttr[i]);
+
+		munmap(pvMap, st.st_size);
 		return false;
 	}
 
-	int iWidth, iHeight;
+	// CAttribute    Ƿ μ   Ǯ ʴ´.
+	rJob.iWidth = pHeader->iWidth;
+	rJob.iHeight = pHeader->iHeight;
+	rJob.vec_pkAttr.swap(vec_pkAttr);
+	rJob.bFromSnapshot = true;
+	return true;
+}
+
+static void SaveAttributeSnapshot(SAttrLoadJob & rJob, const struct stat & c_rSrcStat)
+{
+	std::string stFileName = GetAttrSnapshotFileName(rJob);
+	char szTempName[512];
+	snprintf(szTempName, sizeof(szTempName), "%s.%d.tmp", stFileName.c_str(), (int) getpid());
+
+	FILE * fp = fopen(szTempName, "wb");
 
-	fread(&iWidth, sizeof(int), 1, fp);
-	fread(&iHeight, sizeof(int), 1, fp);
+	if (!fp)
+	{
+		rJob.bSnapshotSaveFailed = true;
+		return;
+	}
+
+	SAttrSnapshotHeader header;
+	header.dwMagic = ATTR_SNAPSHOT_MAGIC;
+	header.dwVersion = ATTR_SNAPSHOT_VERSION;
+	header.dwSrcSize = c_rSrcStat.st_size;
+	header.dwSrcMTime = c_rSrcStat.st_mtime;
+	header.iWidth = rJob.iWidth;
+	header.iHeight = rJob.iHeight;
+	header.dwCellCount = SECTREE_SIZE / CELL_SIZE;
 
-	int maxMemSize = LZOManager::instance().GetMaxCompressedSize(sizeof(DWORD) * (SECTREE_SIZE / CELL_SIZE) * (SECTREE_SIZE / CELL_SIZE));
+	std::vector<SAttrSnapshotEntry> vec_entry(rJob.vec_pkAttr.size());
+	size_t uOffset = AlignAttrSnapshot(sizeof(header) + sizeof(SAttrSnapshotEntry) * vec_entry.size());
 
-	unsigned int uiSize;
-	unsigned int uiDestSize;
+	for (size_t i = 0; i < rJob.vec_pkAttr.size(); ++i)
+	{
+		CAttribute * pkAttr = rJob.vec_pkAttr[i];
+		SAttrSnapshotEntry & e = vec_entry[i];
 
-#ifndef _MSC_VER
-	BYTE abComp[maxMemSize];
+		e.iDataType = pkAttr->GetDataType();
+		e.dwDefaultAttr = pkAttr->GetDefaultAttr();
+		e.dwOffset = 0;
+		e.dwSize = 0;
+
+		if (pkAttr->GetDataPtr())
+		{
+			e.dwOffset = uOffset;
+			e.dwSize = pkAttr->GetDataSize();
+			uOffset = AlignAttrSnapshot(uOffset + e.dwSize);
+		}
+	}
+
+	static const BYTE s_abPad[ATTR_SNAPSHOT_ALIGN] = { 0 };
+	bool bOK = fwrite(&header, sizeof(header), 1, fp) == 1;
+
+	if (bOK && !vec_entry.empty())
+		bOK = fwrite(&vec_entry[0], sizeof(SAttrSnapshotEntry), vec_entry.size(), fp) == vec_entry.size();
+
+	size_t uWritten = sizeof(header) + sizeof(SAttrSnapshotEntry) * vec_entry.size();
+
+	for (size_t i = 0; bOK && i < rJob.vec_pkAttr.size(); ++i)
+	{
+		const SAttrSnapshotEntry & e = vec_entry[i];
+
+		if (!e.dwOffset)
+			continue;
+
+		if (e.dwOffset > uWritten)
+			bOK = fwrite(s_abPad, 1, e.dwOffset - uWritten, fp) == e.dwOffset - uWritten;
+
+		if (bOK)
+			bOK = fwrite(rJob.vec_pkAttr[i]->GetDataPtr(), 1, e.dwSize, fp) == e.dwSize;
+
+		uWritten = e.dwOffset + e.dwSize;
+	}
+
+	if (fclose(fp) != 0)
+		bOK = false;
+
+	// ٸ ä   ϰ   Ƿ  ʰ ̸ ٲ۴.
+	if (!bOK || rename(szTempName, stFileName.c_str()) != 0)
+	{
+		unlink(szTempName);
+		rJob.bSnapshotSaveFailed = true;
+	}
+}
+#endif
+
+static void LoadAttributeFile(SAttrLoadJob & rJob)
+{
+	rJob.iWidth = rJob.iHeight = 0;
+	rJob.bOpenFailed = false;
+	rJob.iFailIndex = -1;
+	rJob.uiFailDestSize = 0;
+	rJob.bFromSnapshot = false;
+	rJob.bSnapshotSaveFailed = false;
+
+#ifndef __WIN32__
+	int fd = open(rJob.stFileName.c_str(), O_RDONLY);
+
+	if (fd < 0)
+	{
+		rJob.bOpenFailed = true;
+		return;
+	}
+
+	struct stat st;
+
+	if (fstat(fd, &st) < 0)
+	{
+		close(fd);
+		rJob.bOpenFailed = true;
+		return;
+	}
+
+	if (!g_stAttrSnapshotDir.empty() && LoadAttributeSnapshot(rJob, st))
+	{
+		close(fd);
+		return;
+	}
+
+	void * pvMap = st.st_size > 0 ? mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+	close(fd);
+
+	if (pvMap != MAP_FAILED)
+	{
+		LoadAttributeData((const BYTE *) pvMap, st.st_size, rJob);
+		munmap(pvMap, st.st_size);
+
+		if (!g_stAttrSnapshotDir.empty() && rJob.iFailIndex == -1 &&
+				rJob.iWidth > 0 && rJob.vec_pkAttr.size() == (size_t) (rJob.iWidth * rJob.iHeight))
+			SaveAttributeSnapshot(rJob, st);
+
+		return;
+	}
+#endif
+
+	// mmap    ° д´.
+	FILE * fp = fopen(rJob.stFileName.c_str(), "rb");
+
+	if (!fp)
+	{
+		rJob.bOpenFailed = true;
+		return;
+	}
+
+	std::vector<BYTE> vec_bData;
+	BYTE abBuf[64 * 1024];
+	size_t uRead;
+
+	while ((uRead = fread(abBuf, 1, sizeof(abBuf), fp)) > 0)
+		vec_bData.insert(vec_bData.end(), abBuf, abBuf + uRead);
+
+	fclose(fp);
+
+	if (vec_bData.empty())
+		LoadAttributeData(NULL, 0, rJob);
+	else
+		LoadAttributeData(&vec_bData[0], vec_bData.size(), rJob);
+}
+
+struct SAttrLoadPool
+{
+	std::vector<SAttrLoadJob *> *	pvec_pkJob;
+	size_t		uNext;
+#ifndef __WIN32__
+	pthread_mutex_t	mutex;
+#endif
+};
+
+#ifndef __WIN32__
+static void * AttrLoadThread(void * arg)
+{
+	SAttrLoadPool * pPool = (SAttrLoadPool *) arg;
+
+	while (true)
+	{
+		pthread_mutex_lock(&pPool->mutex);
+		size_t uIndex = pPool->uNext++;
+		pthread_mutex_unlock(&pPool->mutex);
+
+		if (uIndex >= pPool->pvec_pkJob->size())
+			break;
+
+		LoadAttributeFile(*(*pPool->pvec_pkJob)[uIndex]);
+	}
+
+	return NULL;
+}
+#endif
+
+//   server_attr бⰡ  ð κ̶    д´.
+// 带  ϰų 쿡  忡 ʷ д´.
+static void LoadAttributeFiles(std::vector<SAttrLoadJob *> & vec_pkJob)
+{
+	if (vec_pkJob.empty())
+		return;
+
+	size_t uThreadCount = MINMAX(1, g_iMapLoadThreadCount, vec_pkJob.size());
+
+#ifndef __WIN32__
+	SAttrLoadPool pool;
+	pool.pvec_pkJob = &vec_pkJob;
+	pool.uNext = 0;
+	pthread_mutex_init(&pool.mutex, NULL);
+
+	std::vector<pthread_t> vec_hThread;
+
+	//  嵵 ϳ  д´.
+	for (size_t i = 1; i < uThreadCount; ++i)
+	{
+		pthread_t hThread;
+
+		if (0 != pthread_create(&hThread, NULL, AttrLoadThread, &pool))
+		{
+			sys_err("cannot create attribute load thread, %u threads running", vec_hThread.size());
+			break;
+		}
+
+		vec_hThread.push_back(hThread);
+	}
+
+	AttrLoadThread(&pool);
+
+	for (size_t i = 0; i < vec_hThread.size(); ++i)
+		pthread_join(vec_hThread[i], NULL);
+
+	pthread_mutex_destroy(&pool.mutex);
 #else
-	BYTE* abComp = M2_NEW BYTE[maxMemSize];
+	for (size_t i = 0; i < vec_pkJob.size(); ++i)
+		LoadAttributeFile(*vec_pkJob[i]);
 #endif
-	DWORD * attr = M2_NEW DWORD[maxMemSize];
+}
+
+bool SECTREE_MANAGER::LoadAttribute(LPSECTREE_MAP pkMapSectree, const char * c_pszFileName, TMapSetting & r_setting)
+{
+	SAttrLoadJob job;
+	job.stFileName = c_pszFileName;
+	job.setting = r_setting;
+	job.pkMapSectree = pkMapSectree;
+
+	LoadAttributeFile(job);
+	return BindAttribute(job);
+}
+
+//   CAttribute  .
+static void ReleaseAttribute(SAttrLoadJob & rJob, size_t uFrom)
+{
+	for (size_t i = uFrom; i < rJob.vec_pkAttr.size(); ++i)
+		M2_DELETE(rJob.vec_pkAttr[i]);
+
+	rJob.vec_pkAttr.clear();
+}
+
+bool SECTREE_MANAGER::BindAttribute(SAttrLoadJob & rJob)
+{
+	const char * c_pszFileName = rJob.stFileName.c_str();
+	LPSECTREE_MAP pkMapSectree = rJob.pkMapSectree;
+	TMapSetting & r_setting = rJob.setting;
+	int iWidth = rJob.iWidth;
+	int iHeight = rJob.iHeight;
+	size_t uBound = 0;
+
+	if (rJob.bOpenFailed)
+	{
+		sys_err("SECTREE_MANAGER::LoadAttribute : cannot open %s", c_pszFileName);
+		return false;
+	}
+
+	if (rJob.bSnapshotSaveFailed)
+		sys_err("SECTREE_MANAGER::LoadAttribute : cannot write snapshot of %s to %s", c_pszFileName, g_stAttrSnapshotDir.c_str());
 
 	for (int y = 0; y < iHeight; ++y)
 		for (int x = 0; x < iWidth; ++x)
@@ -431,10 +1111,7 @@ bool SECTREE_MANAGER::LoadAttribute(LPSECTREE_MAP pkMapSectree, const char * c_p
 				pkMapSectree->DumpAllToSysErr();
 				abort();
 
-				M2_DELETE_ARRAY(attr);
-#ifdef _MSC_VER
-				M2_DELETE_ARRAY(abComp);
-#endif
+				ReleaseAttribute(rJob, uBound);
 				return false;
 			}
 			// END_OF_SERVER_ATTR_LOAD_ERROR
@@ -443,44 +1120,22 @@ bool SECTREE_MANAGER::LoadAttribute(LPSECTREE_MAP pkMapSectree, const char * c_p
 			{
 				sys_err("returned tree id mismatch! return %u, request %u", 
 						tree->m_id.package, id.package);
-				fclose(fp);
-
-				M2_DELETE_ARRAY(attr);
-#ifdef _MSC_VER
-				M2_DELETE_ARRAY(abComp);
-#endif
+				ReleaseAttribute(rJob, uBound);
 				return false;
 			}
 
-			fread(&uiSize, sizeof(int), 1, fp);
-			fread(abComp, sizeof(char), uiSize, fp);
-
-			//LZOManager::instance().Decompress(abComp, uiSize, (BYTE *) tree->GetAttributePointer(), &uiDestSize);
-			uiDestSize = sizeof(DWORD) * maxMemSize;
-			LZOManager::instance().Decompress(abComp, uiSize, (BYTE *) attr, &uiDestSize);
-
-			if (uiDestSize != sizeof(DWORD) * (SECTREE_SIZE / CELL_SIZE) * (SECTREE_SIZE / CELL_SIZE))
+			if (uBound >= rJob.vec_pkAttr.size())
 			{
 				sys_err("SECTREE_MANAGER::LoadAttribte : %s : %d %d size mismatch! %d",
-						c_pszFileName, tree->m_id.coord.x, tree->m_id.coord.y, uiDestSize);
-				fclose(fp);
-
-				M2_DELETE_ARRAY(attr);
-#ifdef _MSC_VER
-				M2_DELETE_ARRAY(abComp);
-#endif
+						c_pszFileName, tree->m_id.coord.x, tree->m_id.coord.y, rJob.uiFailDestSize);
+				ReleaseAttribute(rJob, uBound);
 				return false;
 			}
 
-			tree->BindAttribute(M2_NEW CAttribute(attr, SECTREE_SIZE / CELL_SIZE, SECTREE_SIZE / CELL_SIZE));
+			tree->BindAttribute(rJob.vec_pkAttr[uBound++]);
 		}
 
-	fclose(fp);
-
-	M2_DELETE_ARRAY(attr);
-#ifdef _MSC_VER
-	M2_DELETE_ARRAY(abComp);
-#endif
+	ReleaseAttribute(rJob, uBound);
 	return true;
 }
 
@@ -683,6 +1338,7 @@ int SECTREE_MANAGER::Build(const char * c_pszListFileName, const char* c_pszMapB
 	char szFilename[256];
 	char szMapName[256];
 	int iIndex;
+	std::list<SAttrLoadJob> lst_kAttrJob;
 
 	while (fgets(buf, 256, fp))
 	{
@@ -724,31 +1380,67 @@ int SECTREE_MANAGER::Build(const char * c_pszListFileName, const char* c_pszMapB
 			m_map_pkSectree.insert(std::map<DWORD, LPSECTREE_MAP>::value_type(iIndex, pkMapSectree));
 
 			snprintf(szFilename, sizeof(szFilename), "%s/%s/server_attr", c_pszMapBasePath, szMapName);
-			LoadAttribute(pkMapSectree, szFilename, setting);
 
-			snprintf(szFilename, sizeof(szFilename), "%s/%s/", c_pszMapBasePath, szMapName);
-			regen_register_map(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+			// server_attr       Ѳ д´.
+			lst_kAttrJob.push_back(SAttrLoadJob());
+			SAttrLoadJob & rJob = lst_kAttrJob.back();
+			rJob.stFileName = szFilename;
+			rJob.stMapName = szMapName;
+			rJob.setting = setting;
+			rJob.pkMapSectree = pkMapSectree;
+		}
+	}
+
+	fclose(fp);
 
-			snprintf(szFilename, sizeof(szFilename), "%s/%s/regen.txt", c_pszMapBasePath, szMapName);
-			regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+	std::vector<SAttrLoadJob *> vec_pkAttrJob;
 
-			snprintf(szFilename, sizeof(szFilename), "%s/%s/npc.txt", c_pszMapBasePath, szMapName);
-			regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+	for (itertype(lst_kAttrJob) it = lst_kAttrJob.begin(); it != lst_kAttrJob.end(); ++it)
+		vec_pkAttrJob.push_back(&(*it));
 
-			snprintf(szFilename, sizeof(szFilename), "%s/%s/boss.txt", c_pszMapBasePath, szMapName);
-			regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+	DWORD dwStartTime = get_dword_time();
+	LoadAttributeFiles(vec_pkAttrJob);
 
-			snprintf(szFilename, sizeof(szFilename), "%s/%s/stone.txt", c_pszMapBasePath, szMapName);
-			regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+	size_t uSnapshotCount = 0;
 
-			snprintf(szFilename, sizeof(szFilename), "%s/%s/dungeon.txt", c_pszMapBasePath, szMapName);
-			LoadDungeon(iIndex, szFilename);
+	for (size_t i = 0; i < vec_pkAttrJob.size(); ++i)
+		if (vec_pkAttrJob[i]->bFromSnapshot)
+			++uSnapshotCount;
 
-			pkMapSectree->Build();
-		}
-	}
+	sys_log(0, "[BUILD] server_attr of %u maps loaded in %u ms (threads %d, snapshot %u)",
+			vec_pkAttrJob.size(), get_dword_time() - dwStartTime, g_iMapLoadThreadCount, uSnapshotCount);
 
-	fclose(fp);
+	//  Ӽ  ڿ ؾ ϹǷ   ⼭ Ѵ.
+	for (size_t i = 0; i < vec_pkAttrJob.size(); ++i)
+	{
+		SAttrLoadJob & rJob = *vec_pkAttrJob[i];
+		TMapSetting & setting = rJob.setting;
+		LPSECTREE_MAP pkMapSectree = rJob.pkMapSectree;
+		const char * c_pszMapName = rJob.stMapName.c_str();
+
+		BindAttribute(rJob);
+		pkMapSectree->BuildWalkable();
+
+		snprintf(szFilename, sizeof(szFilename), "%s/%s/", c_pszMapBasePath, c_pszMapName);
+		regen_register_map(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+
+		snprintf(szFilename, sizeof(szFilename), "%s/%s/regen.txt", c_pszMapBasePath, c_pszMapName);
+		regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+
+		snprintf(szFilename, sizeof(szFilename), "%s/%s/npc.txt", c_pszMapBasePath, c_pszMapName);
+		regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+
+		snprintf(szFilename, sizeof(szFilename), "%s/%s/boss.txt", c_pszMapBasePath, c_pszMapName);
+		regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+
+		snprintf(szFilename, sizeof(szFilename), "%s/%s/stone.txt", c_pszMapBasePath, c_pszMapName);
+		regen_load(szFilename, setting.iIndex, setting.iBaseX, setting.iBaseY);
+
+		snprintf(szFilename, sizeof(szFilename), "%s/%s/dungeon.txt", c_pszMapBasePath, c_pszMapName);
+		LoadDungeon(setting.iIndex, szFilename);
+
+		pkMapSectree->Build();
+	}
 
 	return 1;
 }
@@ -868,6 +1560,24 @@ bool SECTREE_MANAGER::GetRandomLocation(long lMapIndex, PIXEL_POSITION & r_pos,
 		if (rRegion.index != lMapIndex)
 			continue;
 
+		//   ִ  ٷ ̴´. ǹ  Ӽ ٲ Ʒ ٽ ã´.
+		if (iMaxDistance == 0)
+		{
+			long lx, ly;
+
+			if (pkSectreeMap->GetRandomWalkablePosition(SECTREE_MAP::WALKABLE_MOVABLE, lx, ly))
+			{
+				LPSECTREE tree = pkSectreeMap->Find(lx, ly);
+
+				if (tree && !tree->IsAttr(lx, ly, ATTR_BLOCK | ATTR_OBJECT))
+				{
+					r_pos.x = lx;
+					r_pos.y = ly;
+					return true;
+				}
+			}
+		}
+
 		int i = 0;
 
 		while (i++ < 100)
@@ -998,7 +1708,7 @@ long SECTREE_MANAGER::CreatePrivateMap(long lMapIndex)
 	pkMapSectree = M2_NEW SECTREE_MAP(*pkMapSectree);
 	m_map_pkSectree.insert(std::map<DWORD, LPSECTREE_MAP>::value_type(lNewMapIndex, pkMapSectree));
 
-	sys_log(0, "PRIVATE_MAP: %d created (original %d)", lNewMapIndex, lMapIndex);
+	sys_log(0, "PRIVATE_MAP: %d created (original %d) bytes %u", lNewMapIndex, lMapIndex, (unsigned int) pkMapSectree->GetMemorySize());
 	return lNewMapIndex;
 }
 
@@ -1046,10 +1756,16 @@ void SECTREE_MANAGER::DestroyPrivateMap(long lMapIndex)
 	FDestroyPrivateMapEntity f;
 	pkMapSectree->for_each(f);
 
+	// includes the attribute grids copied by building placement
+	size_t uBytes = pkMapSectree->GetMemorySize();
+
 	m_map_pkSectree.erase(lMapIndex);
 	M2_DELETE(pkMapSectree);
 
-	sys_log(0, "PRIVATE_MAP: %d destroyed", lMapIndex);
+	//  ε ٽ   Ƿ ã   .
+	CPathFinder::instance().ClearMap(lMapIndex);
+
+	sys_log(0, "PRIVATE_MAP: %d destroyed bytes %u", lMapIndex, (unsigned int) uBytes);
 }
 
 TAreaMap& SECTREE_MANAGER::GetDungeonArea(long lMapIndex)
@@ -1071,42 +1787,45 @@ void SECTREE_MANAGER::SendNPCPosition(LPCHARACTER ch)
 
 	long lMapIndex = ch->GetMapIndex();
 
-	if (m_mapNPCPosition[lMapIndex].empty())
+	itertype(m_mapNPCPosition) itMap = m_mapNPCPosition.find(lMapIndex);
+
+	if (itMap == m_mapNPCPosition.end() || itMap->second.empty())
 		return;
 
-	TEMP_BUFFER buf;
-	TPacketGCNPCPosition p;
-	p.header = HEADER_GC_NPC_POSITION;
-	p.count = m_mapNPCPosition[lMapIndex].size();
+	// α,      ʵ ʸ ѹ  д.
+	TSharedPacketBlob & rBlob = m_mapNPCPositionPacket[lMapIndex];
 
-	TNPCPosition np;
+	if (rBlob.IsEmpty())
+	{
+		TEMP_BUFFER buf;
+		TPacketGCNPCPosition p;
+		p.header = HEADER_GC_NPC_POSITION;
+		p.count = itMap->second.size();
+		p.size = sizeof(p) + sizeof(TNPCPosition) * itMap->second.size();
 
-	// TODO m_mapNPCPosition[lMapIndex]  ּ
-	itertype(m_mapNPCPosition[lMapIndex]) it;
+		buf.write(&p, sizeof(p));
 
-	for (it = m_mapNPCPosition[lMapIndex].begin(); it != m_mapNPCPosition[lMapIndex].end(); ++it)
-	{
-		np.bType = it->bType;
-		strlcpy(np.name, it->name, sizeof(np.name));
-		np.x = it->x;
-		np.y = it->y;
-		buf.write(&np, sizeof(np));
-	}
+		TNPCPosition np;
 
-	p.size = sizeof(p) + buf.size();
+		for (itertype(itMap->second) it = itMap->second.begin(); it != itMap->second.end(); ++it)
+		{
+			np.bType = it->bType;
+			strlcpy(np.name, it->name, sizeof(np.name));
+			np.x = it->x;
+			np.y = it->y;
+			buf.write(&np, sizeof(np));
+		}
 
-	if (buf.size())
-	{
-		d->BufferedPacket(&p, sizeof(TPacketGCNPCPosition));
-		d->Packet(buf.read_peek(), buf.size());
+		rBlob.Assign(buf.read_peek(), buf.size());
 	}
-	else
-		d->Packet(&p, sizeof(TPacketGCNPCPosition));
+
+	d->SharedPacket(rBlob);
 }
 
 void SECTREE_MANAGER::InsertNPCPosition(long lMapIndex, BYTE bType, const char* szName, long x, long y)
 {
 	m_mapNPCPosition[lMapIndex].push_back(npc_info(bType, szName, x, y));
+	m_mapNPCPositionPacket.erase(lMapIndex);
 }
 
 BYTE SECTREE_MANAGER::GetEmpireFromMapIndex(long lMapIndex)
@@ -1607,4 +2326,87 @@ size_t SECTREE_MANAGER::GetMonsterCountInMap(long lMapIndex, DWORD dwVnum)
 	return 0;
 }
 
+size_t SECTREE_MANAGER::FindInRange(long lMapIndex, long x, long y, int iRange, DWORD dwKindMask, std::vector<LPENTITY> & r_vec)
+{
+	LPSECTREE_MAP pkSectreeMap = GetMap(lMapIndex);
+
+	if (!pkSectreeMap || iRange < 0)
+		return 0;
+
+	size_t uOldSize = r_vec.size();
+	long lBox = iRange + iRange / 24 + 1;	// see SECTREE::CollectInRange
+
+	for (long sy = MAX(0, y - lBox) / SECTREE_SIZE; sy <= (y + lBox) / SECTREE_SIZE; ++sy)
+	{
+		for (long sx = MAX(0, x - lBox) / SECTREE_SIZE; sx <= (x + lBox) / SECTREE_SIZE; ++sx)
+		{
+			LPSECTREE tree = pkSectreeMap->Find(sx * SECTREE_SIZE, sy * SECTREE_SIZE);
+
+			if (tree)
+				tree->CollectInRange(x, y, iRange, dwKindMask, r_vec, NULL);
+		}
+	}
+
+	return r_vec.size() - uOldSize;
+}
+
+namespace
+{
+	struct FLessSpatialDistance
+	{
+		bool operator () (const std::pair<int, LPENTITY> & a, const std::pair<int, LPENTITY> & b) const
+		{
+			return a.first < b.first;
+		}
+	};
+}
+
+size_t SECTREE_MANAGER::FindNearestInRange(long lMapIndex, long x, long y, int iRange, size_t uMaxCount, DWORD dwKindMask, std::vector<LPENTITY> & r_vec)
+{
+	LPSECTREE_MAP pkSectreeMap = GetMap(lMapIndex);
+
+	if (!pkSectreeMap || iRange < 0)
+		return 0;
+
+	static std::vector<LPENTITY> s_vecEntity;
+	static std::vector<int> s_vecDist;
+	static std::vector<std::pair<int, LPENTITY> > s_vecSort;
+
+	s_vecEntity.clear();
+	s_vecDist.clear();
+
+	long lBox = iRange + iRange / 24 + 1;
+
+	for (long sy = MAX(0, y - lBox) / SECTREE_SIZE; sy <= (y + lBox) / SECTREE_SIZE; ++sy)
+	{
+		for (long sx = MAX(0, x - lBox) / SECTREE_SIZE; sx <= (x + lBox) / SECTREE_SIZE; ++sx)
+		{
+			LPSECTREE tree = pkSectreeMap->Find(sx * SECTREE_SIZE, sy * SECTREE_SIZE);
+
+			if (tree)
+				tree->CollectInRange(x, y, iRange, dwKindMask, s_vecEntity, &s_vecDist);
+		}
+	}
+
+	s_vecSort.clear();
+
+	for (size_t i = 0; i < s_vecEntity.size(); ++i)
+		s_vecSort.push_back(std::make_pair(s_vecDist[i], s_vecEntity[i]));
+
+	size_t uCount = s_vecSort.size();
+
+	if (uMaxCount && uMaxCount < uCount)
+	{
+		std::partial_sort(s_vecSort.begin(), s_vecSort.begin() + uMaxCount, s_vecSort.end(), FLessSpatialDistance());
+		uCount = uMaxCount;
+	}
+	else
+		std::stable_sort(s_vecSort.begin(), s_vecSort.end(), FLessSpatialDistance());
+
+	for (size_t i = 0; i < uCount; ++i)
+		r_vec.push_back(s_vecSort[i].second);
+
+	return uCount;
+}
+
 
@@ -2,6 +2,7 @@
 #define __INC_METIN_II_GAME_SECTREE_MANAGER_H__
 
 #include "sectree.h"
+#include "desc.h"
 
 
 typedef struct SMapRegion
@@ -58,6 +59,8 @@ class SECTREE_MAP
 		virtual ~SECTREE_MAP();
 
 		bool Add(DWORD key, LPSECTREE sectree) {
+			// the grid is rebuilt by Build(), until then Find() uses map_
+			grid_.clear();
 			return map_.insert(MapType::value_type(key, sectree)).second;
 		}
 
@@ -65,6 +68,25 @@ class SECTREE_MAP
 		LPSECTREE	Find(DWORD x, DWORD y);
 		void		Build();
 
+		size_t		GetMemorySize() const;	// approximate bytes owned by this map
+		// Recounts GetMemorySize into MEM_TAG_SECTREE, done by Build().
+		void		UpdateMemStat();
+
+		enum EWalkable
+		{
+			WALKABLE_MOVABLE,	// not ATTR_BLOCK | ATTR_OBJECT
+			WALKABLE_SPAWN,		// movable and not ATTR_BANPK either
+			WALKABLE_MAX_NUM,
+		};
+
+		// Collects the walkable cells of the loaded attributes as row spans,
+		// leaving out the two cells along the map border.
+		void		BuildWalkable();
+		// Uniform random point over the walkable cells of the kind. The spans
+		// are not updated by SetAttribute, so callers check the point again.
+		bool		GetRandomWalkablePosition(int iType, long & r_x, long & r_y);
+		DWORD		GetWalkableCellCount(int iType) const;
+
 		TMapSetting	m_setting;
 
 		template< typename Func >
@@ -89,6 +111,18 @@ class SECTREE_MAP
 			*/
 		}
 
+		// Same as for_each but only reads the sectree lists of the given
+		// spatial kinds, so a PC scan does not walk every mob and object.
+		template< typename Func >
+		void for_each_kind( DWORD dwKindMask, Func & rfunc )
+		{
+			FCollectEntity collector;
+			std::map<DWORD, LPSECTREE>::iterator it = map_.begin();
+			for ( ; it != map_.end(); ++it)
+				it->second->CollectKind(dwKindMask, collector.result);
+			collector.ForEach(rfunc);
+		}
+
 		void DumpAllToSysErr() {
 			SECTREE_MAP::MapType::iterator i;
 			for (i = map_.begin(); i != map_.end(); ++i)
@@ -98,9 +132,46 @@ class SECTREE_MAP
 		}
 
 	private:
+		void BuildGrid();
+
+		struct SWalkableSpan
+		{
+			DWORD	dwFirst;	// number of walkable cells before this span
+			WORD	wCellX;		// cell coordinates from the map base
+			WORD	wCellY;
+			WORD	wLength;
+		};
+
+		struct SWalkable
+		{
+			std::vector<SWalkableSpan>	vec_kSpan[WALKABLE_MAX_NUM];
+			DWORD				adwCellCount[WALKABLE_MAX_NUM];
+		};
+
+		// private maps share the table of the original map, which outlives them
+		SWalkable * walkable_;
+		bool walkable_owner_;
+
 		MapType map_;
+
+		// Dense sectree grid covering the bounding box of map_, row major.
+		// Coordinates are in sectree units, cells without a sectree are NULL.
+		std::vector<LPSECTREE> grid_;
+		DWORD grid_x_;
+		DWORD grid_y_;
+		DWORD grid_width_;
+		DWORD grid_height_;
+
+		// Sectrees of a private map are allocated as one block in map_ order,
+		// NULL for maps loaded from files whose sectrees are allocated one by one.
+		LPSECTREE clone_block_;
+
+		// bytes last added to MEM_TAG_SECTREE for this map
+		size_t mem_stat_bytes_;
 };
 
+struct SAttrLoadJob;
+
 enum EAttrRegionMode
 {
 	ATTR_REGION_MODE_SET,
@@ -133,6 +204,7 @@ class SECTREE_MANAGER : public singleton<SECTREE_MANAGER>
 		int		Build(const char * c_pszListFileName, const char* c_pszBasePath);
 		LPSECTREE_MAP BuildSectreeFromSetting(TMapSetting & r_setting);
 		bool		LoadAttribute(LPSECTREE_MAP pkMapSectree, const char * c_pszFileName, TMapSetting & r_setting);
+		bool		BindAttribute(SAttrLoadJob & rJob);	// ̸ о  server_attr  sectree  δ
 		void		LoadDungeon(int iIndex, const char * c_pszFileName);
 		bool		GetValidLocation(long lMapIndex, long x, long y, long & r_lValidMapIndex, PIXEL_POSITION & r_pos, BYTE empire = 0);
 		bool		GetSpawnPosition(long x, long y, PIXEL_POSITION & r_pos);
@@ -165,6 +237,13 @@ class SECTREE_MANAGER : public singleton<SECTREE_MANAGER>
 		size_t		GetMonsterCountInMap(long lMapIndex);
 		size_t		GetMonsterCountInMap(long lMpaIndex, DWORD dwVnum);
 
+		// Entities of the kinds (ESpatialKind) whose DISTANCE_APPROX from
+		// (x, y) is at most iRange, over every sectree of the map the range
+		// touches. FindNearestInRange keeps the uMaxCount nearest (all when
+		// 0), nearest first. Both append to r_vec and return the count added.
+		size_t		FindInRange(long lMapIndex, long x, long y, int iRange, DWORD dwKindMask, std::vector<LPENTITY> & r_vec);
+		size_t		FindNearestInRange(long lMapIndex, long x, long y, int iRange, size_t uMaxCount, DWORD dwKindMask, std::vector<LPENTITY> & r_vec);
+
 		///   Sectree  Attribute   Ư ó Ѵ.
 		/**
 		 * @param [in]	lMapIndex  Map index
@@ -223,6 +302,7 @@ class SECTREE_MANAGER : public singleton<SECTREE_MANAGER>
 		std::map<int, TAreaMap>	m_map_pkArea;
 		std::vector<TMapRegion>		m_vec_mapRegion;
 		std::map<DWORD, std::vector<npc_info> > m_mapNPCPosition;
+		std::map<DWORD, TSharedPacketBlob> m_mapNPCPositionPacket;	// ʸ ѹ  δ HEADER_GC_NPC_POSITION. InsertNPCPosition  .
 
 		// <Factor> Circular private map indexing
 		typedef TR1_NS::unordered_map<long, int> PrivateIndexMapType;
@@ -4,6 +4,7 @@
 #include "utils.h"
 #include "config.h"
 #include "shop.h"
+#include "shop_manager.h"
 #include "desc.h"
 #include "desc_manager.h"
 #include "char.h"
@@ -35,6 +36,9 @@ CShop::~CShop()
 
 	Broadcast(&pack, sizeof(pack));
 
+	if (!m_vec_bUpdatePos.empty())
+		CShopManager::instance().CancelUpdateItem(this);
+
 	GuestMapType::iterator it;
 
 	it = m_map_guest.begin();
@@ -88,6 +92,9 @@ void CShop::SetShopItems(TShopItemTable * pTable, BYTE bItemCount)
 	m_itemVector.resize(SHOP_HOST_ITEM_MAX_NUM);
 	memset(&m_itemVector[0], 0, sizeof(SHOP_ITEM) * m_itemVector.size());
 
+	m_set_itemID.clear();
+	m_map_countByVnum.clear();
+
 	for (int i = 0; i < bItemCount; ++i)
 	{
 		LPITEM pkItem = NULL;
@@ -184,6 +191,15 @@ void CShop::SetShopItems(TShopItemTable * pTable, BYTE bItemCount)
 		sys_log(0, "SHOP_ITEM: %-36s PRICE %-5d", name, item.price);
 		++pTable;
 	}
+
+	// Ǹ Ŀ itemid, vnum, count  ״̹Ƿ ⼭ ѹ .
+	for (DWORD i = 0; i < m_itemVector.size(); ++i)
+	{
+		const SHOP_ITEM & item = m_itemVector[i];
+
+		m_set_itemID.insert(item.itemid);
+		m_map_countByVnum[item.vnum] += item.count;
+	}
 }
 
 int CShop::Buy(LPCHARACTER ch, BYTE pos)
@@ -339,6 +355,7 @@ int CShop::Buy(LPCHARACTER ch, BYTE pos)
 
 		r_item.pkItem = NULL;
 		BroadcastUpdateItem(pos);
+		CShopManager::instance().RemoveSearchItem(this, pos);
 
 		m_pkPC->PointChange(POINT_GOLD, dwPrice, false);
 
@@ -471,74 +488,80 @@ void CShop::Broadcast(const void * data, int bytes)
 
 void CShop::BroadcastUpdateItem(BYTE pos)
 {
-	TPacketGCShop pack;
-	TPacketGCShopUpdateItem pack2;
+	if (pos >= m_itemVector.size() || m_map_guest.empty())
+		return;
 
-	TEMP_BUFFER	buf;
+	if (std::find(m_vec_bUpdatePos.begin(), m_vec_bUpdatePos.end(), pos) != m_vec_bUpdatePos.end())
+		return;
 
-	pack.header		= HEADER_GC_SHOP;
-	pack.subheader	= SHOP_SUBHEADER_GC_UPDATE_ITEM;
-	pack.size		= sizeof(pack) + sizeof(pack2);
+	if (m_vec_bUpdatePos.empty())
+		CShopManager::instance().RequestUpdateItem(this);
 
-	pack2.pos		= pos;
+	m_vec_bUpdatePos.push_back(pos);
+}
 
-	if (m_pkPC && !m_itemVector[pos].pkItem)
-		pack2.item.vnum = 0;
-	else
+void CShop::FlushUpdateItem()
+{
+	if (m_vec_bUpdatePos.empty())
+		return;
+
+	TEMP_BUFFER	buf;
+
+	for (DWORD i = 0; i < m_vec_bUpdatePos.size(); ++i)
 	{
-		pack2.item.vnum	= m_itemVector[pos].vnum;
-		if (m_itemVector[pos].pkItem)
-		{
-			thecore_memcpy(pack2.item.alSockets, m_itemVector[pos].pkItem->GetSockets(), sizeof(pack2.item.alSockets));
-			thecore_memcpy(pack2.item.aAttr, m_itemVector[pos].pkItem->GetAttributes(), sizeof(pack2.item.aAttr));
-		}
+		BYTE pos = m_vec_bUpdatePos[i];
+
+		TPacketGCShop pack;
+		TPacketGCShopUpdateItem pack2;
+
+		pack.header		= HEADER_GC_SHOP;
+		pack.subheader	= SHOP_SUBHEADER_GC_UPDATE_ITEM;
+		pack.size		= sizeof(pack) + sizeof(pack2);
+
+		pack2.pos		= pos;
+
+		if (m_pkPC && !m_itemVector[pos].pkItem)
+			pack2.item.vnum = 0;
 		else
 		{
-			memset(pack2.item.alSockets, 0, sizeof(pack2.item.alSockets));
-			memset(pack2.item.aAttr, 0, sizeof(pack2.item.aAttr));
+			pack2.item.vnum	= m_itemVector[pos].vnum;
+			if (m_itemVector[pos].pkItem)
+			{
+				thecore_memcpy(pack2.item.alSockets, m_itemVector[pos].pkItem->GetSockets(), sizeof(pack2.item.alSockets));
+				thecore_memcpy(pack2.item.aAttr, m_itemVector[pos].pkItem->GetAttributes(), sizeof(pack2.item.aAttr));
+			}
+			else
+			{
+				memset(pack2.item.alSockets, 0, sizeof(pack2.item.alSockets));
+				memset(pack2.item.aAttr, 0, sizeof(pack2.item.aAttr));
+			}
 		}
-	}
 
-	pack2.item.price	= m_itemVector[pos].price;
-	pack2.item.count	= m_itemVector[pos].count;
+		pack2.item.price	= m_itemVector[pos].price;
+		pack2.item.count	= m_itemVector[pos].count;
+
+		buf.write(&pack, sizeof(pack));
+		buf.write(&pack2, sizeof(pack2));
+	}
 
-	buf.write(&pack, sizeof(pack));
-	buf.write(&pack2, sizeof(pack2));
+	m_vec_bUpdatePos.clear();
 
 	Broadcast(buf.read_peek(), buf.size());
 }
 
 int CShop::GetNumberByVnum(DWORD dwVnum)
 {
-	int itemNumber = 0;
-
-	for (DWORD i = 0; i < m_itemVector.size() && i < SHOP_HOST_ITEM_MAX_NUM; ++i)
-	{
-		const SHOP_ITEM & item = m_itemVector[i];
+	TR1_NS::unordered_map<DWORD, int>::const_iterator it = m_map_countByVnum.find(dwVnum);
 
-		if (item.vnum == dwVnum)
-		{
-			itemNumber += item.count;
-		}
-	}
+	if (it == m_map_countByVnum.end())
+		return 0;
 
-	return itemNumber;
+	return it->second;
 }
 
 bool CShop::IsSellingItem(DWORD itemID)
 {
-	bool isSelling = false;
-
-	for (DWORD i = 0; i < m_itemVector.size() && i < SHOP_HOST_ITEM_MAX_NUM; ++i)
-	{
-		if (m_itemVector[i].itemid == itemID)
-		{
-			isSelling = true;
-			break;
-		}
-	}
-
-	return isSelling;
+	return m_set_itemID.find(itemID) != m_set_itemID.end();
 
 }
 
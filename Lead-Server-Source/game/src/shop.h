@@ -48,7 +48,9 @@ class CShop
 		virtual int	Buy(LPCHARACTER ch, BYTE pos);
 
 		// ԽƮ Ŷ 
+		// ٷ  ʰ  ξٰ pulse  FlushUpdateItem  ѹ .
 		void	BroadcastUpdateItem(BYTE pos);
+		void	FlushUpdateItem();
 
 		// Ǹ   ˷ش.
 		int		GetNumberByVnum(DWORD dwVnum);
@@ -59,6 +61,11 @@ class CShop
 		DWORD	GetVnum() { return m_dwVnum; }
 		DWORD	GetNPCVnum() { return m_dwNPCVnum; }
 
+		//  ˻ ο
+		LPCHARACTER		GetPC() const { return m_pkPC; }
+		DWORD			GetShopItemCount() const { return m_itemVector.size(); }
+		const SHOP_ITEM &	GetShopItem(DWORD pos) const { return m_itemVector[pos]; }
+
 	protected:
 		void	Broadcast(const void * data, int bytes);
 
@@ -72,6 +79,12 @@ class CShop
 		GuestMapType m_map_guest;
 		std::vector<SHOP_ITEM>		m_itemVector;	//   ϴ ǵ
 
+		// SetShopItems   m_itemVector 
+		TR1_NS::unordered_set<int>		m_set_itemID;
+		TR1_NS::unordered_map<DWORD, int>	m_map_countByVnum;
+
+		std::vector<BYTE>		m_vec_bUpdatePos;	// ԽƮ    ٲ ڸ
+
 		LPCHARACTER			m_pkPC;
 };
 
@@ -81,6 +81,7 @@ void CShopManager::Destroy()
 	}
 
 	m_map_pkShop.clear();
+	m_map_searchIndex.clear();
 }
 
 LPSHOP CShopManager::Get(DWORD dwVnum)
@@ -176,9 +177,169 @@ LPSHOP CShopManager::CreatePCShop(LPCHARACTER ch, TShopItemTable * pTable, BYTE
 	pkShop->SetShopItems(pTable, bItemCount);
 
 	m_map_pkShopByPC.insert(TShopMap::value_type(ch->GetVID(), pkShop));
+	AddSearchIndex(pkShop);
 	return pkShop;
 }
 
+void CShopManager::RequestUpdateItem(LPSHOP pkShop)
+{
+	m_set_pkUpdateShop.insert(pkShop);
+}
+
+void CShopManager::CancelUpdateItem(LPSHOP pkShop)
+{
+	m_set_pkUpdateShop.erase(pkShop);
+}
+
+void CShopManager::FlushUpdateItem()
+{
+	if (m_set_pkUpdateShop.empty())
+		return;
+
+	std::set<LPSHOP> set_pkShop;
+	set_pkShop.swap(m_set_pkUpdateShop);
+
+	for (std::set<LPSHOP>::iterator it = set_pkShop.begin(); it != set_pkShop.end(); ++it)
+		(*it)->FlushUpdateItem();
+}
+
+void CShopManager::AddSearchIndex(LPSHOP pkShop)
+{
+	for (DWORD i = 0; i < pkShop->GetShopItemCount(); ++i)
+	{
+		const CShop::SHOP_ITEM & item = pkShop->GetShopItem(i);
+
+		if (!item.pkItem)
+			continue;
+
+		TSearchEntry entry;
+		entry.dwPrice = item.price;
+		entry.pkShop = pkShop;
+		entry.bPos = i;
+
+		TSearchEntryVector & v = m_map_searchIndex[item.vnum];
+		v.insert(std::upper_bound(v.begin(), v.end(), entry), entry);
+	}
+}
+
+void CShopManager::RemoveSearchIndex(LPSHOP pkShop)
+{
+	for (DWORD i = 0; i < pkShop->GetShopItemCount(); ++i)
+		RemoveSearchItem(pkShop, i);
+}
+
+void CShopManager::RemoveSearchItem(LPSHOP pkShop, BYTE pos)
+{
+	if (pos >= pkShop->GetShopItemCount())
+		return;
+
+	if (!pkShop->GetShopItem(pos).vnum)
+		return;
+
+	TR1_NS::unordered_map<DWORD, TSearchEntryVector>::iterator it = m_map_searchIndex.find(pkShop->GetShopItem(pos).vnum);
+
+	if (it == m_map_searchIndex.end())
+		return;
+
+	TSearchEntryVector & v = it->second;
+
+	for (TSearchEntryVector::iterator it2 = v.begin(); it2 != v.end(); ++it2)
+	{
+		if (it2->pkShop == pkShop && it2->bPos == pos)
+		{
+			v.erase(it2);
+			break;
+		}
+	}
+
+	if (v.empty())
+		m_map_searchIndex.erase(it);
+}
+
+void CShopManager::Search(LPCHARACTER ch, const TPacketCGShopSearch * p)
+{
+	LPDESC d = ch->GetDesc();
+
+	if (!d)
+		return;
+
+	TPacketGCShopSearchResult pack2;
+
+	pack2.vnum			= p->vnum;
+	pack2.page			= p->page;
+	pack2.total_count	= 0;
+	pack2.count			= 0;
+
+	TEMP_BUFFER buf;
+
+	TR1_NS::unordered_map<DWORD, TSearchEntryVector>::const_iterator it = m_map_searchIndex.find(p->vnum);
+
+	if (it != m_map_searchIndex.end())
+	{
+		const TSearchEntryVector & v = it->second;
+		TSearchEntryVector::const_iterator it_end = v.end();
+
+		if (p->max_price)
+		{
+			TSearchEntry kMax;
+			kMax.dwPrice = p->max_price;
+			it_end = std::upper_bound(v.begin(), v.end(), kMax);
+		}
+
+		size_t total = it_end - v.begin();
+		size_t start = (size_t) p->page * SHOP_SEARCH_PAGE_SIZE;
+
+		pack2.total_count = MIN(total, USHRT_MAX);
+
+		for (TSearchEntryVector::const_iterator it2 = v.begin() + MIN(start, total); it2 != it_end && pack2.count < SHOP_SEARCH_PAGE_SIZE; ++it2)
+		{
+			LPSHOP pkShop = it2->pkShop;
+			LPCHARACTER pkOwner = pkShop->GetPC();
+			const CShop::SHOP_ITEM & item = pkShop->GetShopItem(it2->bPos);
+
+			if (!pkOwner || !item.pkItem)
+				continue;
+
+			TPacketGCShopSearchItem entry;
+			memset(&entry, 0, sizeof(entry));
+
+			entry.owner_vid = pkOwner->GetVID();
+			strlcpy(entry.owner_name, pkOwner->GetName(), sizeof(entry.owner_name));
+			entry.x = pkOwner->GetX();
+			entry.y = pkOwner->GetY();
+			entry.pos = it2->bPos;
+
+			entry.item.vnum = item.vnum;
+			entry.item.price = item.price;
+			entry.item.count = item.count;
+			entry.item.display_pos = it2->bPos;
+			thecore_memcpy(entry.item.alSockets, item.pkItem->GetSockets(), sizeof(entry.item.alSockets));
+			thecore_memcpy(entry.item.aAttr, item.pkItem->GetAttributes(), sizeof(entry.item.aAttr));
+
+			buf.write(&entry, sizeof(entry));
+			++pack2.count;
+		}
+	}
+
+	TPacketGCShop pack;
+
+	pack.header		= HEADER_GC_SHOP;
+	pack.subheader	= SHOP_SUBHEADER_GC_SEARCH_RESULT;
+	pack.size		= sizeof(pack) + sizeof(pack2) + buf.size();
+
+	d->BufferedPacket(&pack, sizeof(pack));
+
+	if (buf.size())
+	{
+		d->BufferedPacket(&pack2, sizeof(pack2));
+		d->Packet(buf.read_peek(), buf.size());
+	}
+	else
+		d->Packet(&pack2, sizeof(pack2));
+
+	sys_log(1, "SHOP: SEARCH: %s vnum %u page %u total %u", ch->GetName(), p->vnum, p->page, pack2.total_count);
+}
+
 void CShopManager::DestroyPCShop(LPCHARACTER ch)
 {
 	LPSHOP pkShop = FindPCShop(ch->GetVID());
@@ -191,6 +352,7 @@ void CShopManager::DestroyPCShop(LPCHARACTER ch)
 	//END_PREVENT_ITEM_COPY
 	
 	m_map_pkShopByPC.erase(ch->GetVID());
+	RemoveSearchIndex(pkShop);
 	M2_DELETE(pkShop);
 }
 
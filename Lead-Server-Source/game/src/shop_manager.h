@@ -1,6 +1,8 @@
 #ifndef __INC_METIN_II_GAME_SHOP_MANAGER_H__
 #define __INC_METIN_II_GAME_SHOP_MANAGER_H__
 
+#include "packet.h"
+
 class CShop;
 typedef class CShop * LPSHOP;
 
@@ -29,11 +31,39 @@ public:
 	LPSHOP	FindPCShop(DWORD dwVID);
 	void	DestroyPCShop(LPCHARACTER ch);
 
+	//    pulse   ѹ .
+	void	RequestUpdateItem(LPSHOP pkShop);
+	void	CancelUpdateItem(LPSHOP pkShop);
+	void	FlushUpdateItem();
+
+	//    ˻.     ݰ   ŵȴ.
+	void	Search(LPCHARACTER ch, const TPacketCGShopSearch * p);
+	void	RemoveSearchItem(LPSHOP pkShop, BYTE pos);
+
+private:
+	void	AddSearchIndex(LPSHOP pkShop);
+	void	RemoveSearchIndex(LPSHOP pkShop);
+
+	typedef struct SSearchEntry
+	{
+		DWORD	dwPrice;
+		LPSHOP	pkShop;
+		BYTE	bPos;
+
+		bool operator < (const SSearchEntry & rhs) const { return dwPrice < rhs.dwPrice; }
+	} TSearchEntry;
+
+	typedef std::vector<TSearchEntry> TSearchEntryVector;	//  
+
+	TR1_NS::unordered_map<DWORD, TSearchEntryVector>	m_map_searchIndex;	// item vnum
+
 private:
 	TShopMap	m_map_pkShop;
 	TShopMap	m_map_pkShopByNPCVnum;
 	TShopMap	m_map_pkShopByPC;
 
+	std::set<LPSHOP>	m_set_pkUpdateShop;
+
 	bool	ReadShopTableEx(const char* stFileName);
 };
 
@@ -0,0 +1,151 @@
+#include "stdafx.h"
+#include "spam.h"
+
+SpamManager::SpamManager() : m_bDirty(false), m_dwMatchSerial(0)
+{
+}
+
+void SpamManager::Clear()
+{
+	m_vec_kWord.clear();
+	m_bDirty = true;
+}
+
+void SpamManager::Insert(const char * str, unsigned int score)
+{
+	TSpamWord kWord;
+
+	kWord.stWord = str;
+	kWord.uiScore = score;
+	kWord.bAnchorBegin = true;
+	kWord.bAnchorEnd = true;
+	kWord.dwMatchSerial = 0;
+
+	m_vec_kWord.push_back(kWord);
+	m_bDirty = true;
+
+	sys_log(0, "SPAM: %2d %s", score, str);
+}
+
+void SpamManager::Build()
+{
+	std::vector<std::string> vec_stLiteral;
+
+	m_vec_iMatcherWord.clear();
+	m_vec_iWildcardWord.clear();
+
+	for (size_t i = 0; i < m_vec_kWord.size(); ++i)
+	{
+		TSpamWord & r = m_vec_kWord[i];
+		const std::string & s = r.stWord;
+
+		size_t begin = 0;
+		size_t end = s.length();
+
+		while (begin < end && s[begin] == '*')
+			++begin;
+
+		while (end > begin && s[end - 1] == '*')
+			--end;
+
+		r.bAnchorBegin = (begin == 0);
+		r.bAnchorEnd = (end == s.length());
+
+		std::string stLiteral = s.substr(begin, end - begin);
+
+		if (stLiteral.empty() || stLiteral.find_first_of("*?") != std::string::npos)
+		{
+			m_vec_iWildcardWord.push_back(i);
+			continue;
+		}
+
+		vec_stLiteral.push_back(stLiteral);
+		m_vec_iMatcherWord.push_back(i);
+	}
+
+	m_kMatcher.Build(vec_stLiteral, CWordMatcher::FLAG_IGNORE_CASE | CWordMatcher::FLAG_SKIP_SPACE);
+	m_bDirty = false;
+
+	sys_log(0, "SPAM: %u words, %u wildcard, %u states",
+			(unsigned int) m_vec_kWord.size(), (unsigned int) m_vec_iWildcardWord.size(), (unsigned int) m_kMatcher.GetNodeCount());
+}
+
+struct FSpamMatch
+{
+	const CWordMatcher &		m_rkMatcher;
+	std::vector<SpamManager::TSpamWord> &	m_rvec_kWord;
+	const std::vector<int> &	m_rvec_iMatcherWord;
+	int				m_iTextLen;	//   
+	DWORD				m_dwSerial;
+	unsigned int			m_uiScore;
+	int				m_iLastWord;
+
+	FSpamMatch(const CWordMatcher & rkMatcher, std::vector<SpamManager::TSpamWord> & rvec_kWord, const std::vector<int> & rvec_iMatcherWord, int iTextLen, DWORD dwSerial)
+		: m_rkMatcher(rkMatcher), m_rvec_kWord(rvec_kWord), m_rvec_iMatcherWord(rvec_iMatcherWord),
+		m_iTextLen(iTextLen), m_dwSerial(dwSerial), m_uiScore(0), m_iLastWord(-1)
+	{
+	}
+
+	bool operator () (int iWord, int iEnd)
+	{
+		int idx = m_rvec_iMatcherWord[iWord];
+		SpamManager::TSpamWord & r = m_rvec_kWord[idx];
+
+		if (r.bAnchorBegin && iEnd != m_rkMatcher.GetWordLength(iWord))
+			return true;
+
+		if (r.bAnchorEnd && iEnd != m_iTextLen)
+			return true;
+
+		if (r.dwMatchSerial == m_dwSerial)
+			return true;
+
+		r.dwMatchSerial = m_dwSerial;
+		m_uiScore += r.uiScore;
+		m_iLastWord = MAX(m_iLastWord, idx);
+		return true;
+	}
+};
+
+const char * SpamManager::GetSpamScore(const char * src, size_t len, unsigned int & score)
+{
+	score = 0;
+
+	if (m_bDirty)
+		Build();
+
+	if (m_vec_kWord.empty())
+		return NULL;
+
+	int iTextLen = 0;
+
+	for (size_t i = 0; i < len; ++i)
+		if (!isspace((BYTE) src[i]))
+			++iTextLen;
+
+	FSpamMatch f(m_kMatcher, m_vec_kWord, m_vec_iMatcherWord, iTextLen, ++m_dwMatchSerial);
+	m_kMatcher.Scan(src, len, f);
+
+	score = f.m_uiScore;
+	int iLastWord = f.m_iLastWord;
+
+	if (!m_vec_iWildcardWord.empty())
+	{
+		std::string strOrig(src, len);
+		strOrig.erase(std::remove_if(strOrig.begin(), strOrig.end(), isspace), strOrig.end());
+
+		for (size_t i = 0; i < m_vec_iWildcardWord.size(); ++i)
+		{
+			int idx = m_vec_iWildcardWord[i];
+			const TSpamWord & r = m_vec_kWord[idx];
+
+			if (true == WildCaseCmp(r.stWord.c_str(), strOrig.c_str()))
+			{
+				score += r.uiScore;
+				iLastWord = MAX(iLastWord, idx);
+			}
+		}
+	}
+
+	return iLastWord >= 0 ? m_vec_kWord[iLastWord].stWord.c_str() : NULL;
+}
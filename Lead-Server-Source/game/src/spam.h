@@ -9,45 +9,44 @@
 
 #include "common/singleton.h"
 #include "utils.h"
+#include "word_matcher.h"
 
+//
+//  ܾ WildCaseCmp ̰   ȭ ü  .
+// յ *  ִ  (κ *ܾ*)  CWordMatcher    ã
+//  *  ?  ִ ͸ ó ϳ WildCaseCmp   .
+//
 class SpamManager : public singleton<SpamManager>
 {
 	public:
-		inline const char * GetSpamScore(const char * src, size_t len, unsigned int & score)
-		{
-			const char * word = NULL;
-			score = 0;
-
-			std::string strOrig(src);
-			strOrig.erase( remove_if(strOrig.begin(), strOrig.end(), isspace), strOrig.end() );
+		SpamManager();
 
-			for (size_t i = 0; i < m_vec_word.size(); ++i)
-			{
-				std::pair<std::string, unsigned int> & r = m_vec_word[i];
+		// ɸ ܾ     ְ score    ش.
+		const char *	GetSpamScore(const char * src, size_t len, unsigned int & score);
 
-				if (true == WildCaseCmp(r.first.c_str(), strOrig.c_str()))
-				{
-					word = r.first.c_str();
-					score += r.second;
-				}
-			}
+		void		Clear();
+		void		Insert(const char * str, unsigned int score = 10);
 
-			return word;
-		}
+	private:
+		friend struct FSpamMatch;
 
-		inline void Clear()
-		{
-			m_vec_word.clear();
-		}
+		void		Build();
 
-		inline void Insert(const char * str, unsigned int score = 10)
+		typedef struct SSpamWord
 		{
-			m_vec_word.push_back(std::make_pair(str, score));
-			sys_log(0, "SPAM: %2d %s", score, str);
-		}
-
-	private:
-		std::vector< std::pair<std::string, unsigned int> > m_vec_word;
+			std::string	stWord;
+			unsigned int	uiScore;
+			bool		bAnchorBegin;	// տ *   ȭ ó ¾ƾ Ѵ
+			bool		bAnchorEnd;	// ڿ *   ȭ  ¾ƾ Ѵ
+			DWORD		dwMatchSerial;	//  ȭ   ϱ  GetSpamScore ȣ
+		} TSpamWord;
+
+		std::vector<TSpamWord>	m_vec_kWord;
+		std::vector<int>	m_vec_iMatcherWord;	// m_kMatcher  ܾ ȣ -> m_vec_kWord
+		std::vector<int>	m_vec_iWildcardWord;	// WildCaseCmp    m_vec_kWord
+		CWordMatcher		m_kMatcher;
+		bool			m_bDirty;	// Insert, Clear   GetSpamScore  ٽ 
+		DWORD			m_dwMatchSerial;
 };
 
 #endif
@@ -56,6 +56,32 @@ TEST( allocator, object_allocator_2 )
 	EXPECT_TRUE( T2::GetFreeBlockCount() == 1 );
 }
 
+struct T3 : public ObjectAllocator<T3, 4>
+{
+	int v[3];
+};
+
+TEST( allocator, object_allocator_used_count )
+{
+	T3* p[8];
+
+	for ( size_t i=0; i<8; ++i )
+	{
+		p[i] = M2_OBJ_NEW T3;
+	}
+
+	EXPECT_TRUE( T3::GetUsedBlockCount() == 8 );
+	EXPECT_TRUE( T3::GetFreeBlockCount() == 0 );
+
+	for ( size_t i=0; i<8; ++i )
+	{
+		M2_OBJ_DELETE( p[i] );
+	}
+
+	EXPECT_TRUE( T3::GetUsedBlockCount() == 0 );
+	EXPECT_TRUE( T3::GetFreeBlockCount() == 4 );
+}
+
 TEST( allocator, character_alloc )
 {
 #if 0
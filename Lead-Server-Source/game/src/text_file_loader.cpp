@@ -3,9 +3,16 @@
 #include "text_file_loader.h"
 
 CDynamicPool<CTextFileLoader::TGroupNode> CTextFileLoader::ms_groupNodePool;
+CTextFileLoader::TSnapshotMap CTextFileLoader::ms_snapshotMap;
+
+#ifndef __WIN32__
+//  ̺ ٸ 忡 Ƿ  Ǯ   ٴ.
+static pthread_mutex_t s_loadMutex = PTHREAD_MUTEX_INITIALIZER;
+#endif
 
 void CTextFileLoader::DestroySystem()
 {
+	ms_snapshotMap.clear();
 	ms_groupNodePool.Clear();
 }
 
@@ -28,28 +35,56 @@ const char * CTextFileLoader::GetFileName()
 }
 
 bool CTextFileLoader::Load(const char * c_szFileName)
+{
+#ifndef __WIN32__
+	pthread_mutex_lock(&s_loadMutex);
+	bool bRet = LoadLocked(c_szFileName);
+	pthread_mutex_unlock(&s_loadMutex);
+	return bRet;
+#else
+	return LoadLocked(c_szFileName);
+#endif
+}
+
+bool CTextFileLoader::LoadLocked(const char * c_szFileName)
 {
 	m_strFileName = c_szFileName;
 
 	m_dwcurLineIndex = 0;
 
-	FILE* fp = fopen(c_szFileName, "rb");
+	struct stat st;
+
+	if (stat(c_szFileName, &st) < 0)
+		return false;
+
+	// ٲ   ٽ Ľ ʰ  Ʈ ״ .
+	// ׷  DestroySystem  Ǯ  ְ б⸸ ϹǷ ص ȴ.
+	TSnapshotMap::iterator it = ms_snapshotMap.find(m_strFileName);
+
+	if (it != ms_snapshotMap.end() && it->second.tMTime == st.st_mtime && it->second.lSize == (long) st.st_size)
+	{
+		m_globalNode.LocalTokenVectorMap = it->second.pRootNode->LocalTokenVectorMap;
+		m_globalNode.ChildNodeVector = it->second.pRootNode->ChildNodeVector;
+		return true;
+	}
 
-	if (NULL == fp)
+	if (!m_fileLoader.LoadFile(c_szFileName))
 		return false;
 
-	fseek(fp, 0L, SEEK_END);
-	const size_t fileSize = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
+	TGroupNode * pRootNode = ms_groupNodePool.Alloc();
+	pRootNode->strGroupName = m_globalNode.strGroupName;
+	pRootNode->pParentNode = NULL;
 
-	char * pData = M2_NEW char[fileSize];
-	fread(pData, fileSize, 1, fp);
-	fclose(fp);
+	LoadGroup(pRootNode);
+	m_fileLoader.Clear();
 
-	m_fileLoader.Bind(fileSize, pData);
-	M2_DELETE_ARRAY(pData);
+	m_globalNode.LocalTokenVectorMap = pRootNode->LocalTokenVectorMap;
+	m_globalNode.ChildNodeVector = pRootNode->ChildNodeVector;
 
-	LoadGroup(&m_globalNode);
+	TSnapshot & rkSnapshot = ms_snapshotMap[m_strFileName];
+	rkSnapshot.tMTime = st.st_mtime;
+	rkSnapshot.lSize = st.st_size;
+	rkSnapshot.pRootNode = pRootNode;
 	return true;
 }
 
@@ -61,6 +61,18 @@ class CTextFileLoader
 		BOOL GetTokenString(const std::string & c_rstrKey, std::string * pString);
 
 	protected:
+		// Ϻ  Ľ Ʈ.  ð ũⰡ  Ѵ.
+		typedef struct SSnapshot
+		{
+			time_t		tMTime;
+			long		lSize;
+			TGroupNode *	pRootNode;
+		} TSnapshot;
+
+		typedef std::map<std::string, TSnapshot> TSnapshotMap;
+
+	protected:
+		bool LoadLocked(const char * c_szFileName);
 		bool LoadGroup(TGroupNode * pGroupNode);
 
 	protected:
@@ -75,6 +87,7 @@ class CTextFileLoader
 
 	private:
 		static CDynamicPool<TGroupNode>			ms_groupNodePool;
+		static TSnapshotMap				ms_snapshotMap;
 };
 
 #endif
@@ -162,7 +162,19 @@ LPCHARACTER FindVictim(LPCHARACTER pkChr, int iMaxDistance)
 {
 	FuncFindMobVictim f(pkChr, iMaxDistance);
 	if (pkChr->GetSectree() != NULL) {
-		pkChr->GetSectree()->ForEachAround(f);	
+		//   ǹ Ÿ   ֺ Ʈ ü ã´.
+		pkChr->GetSectree()->ForEachAroundInRange(pkChr->GetX(), pkChr->GetY(), -1, SPATIAL_KIND_BUILDING, f);
+
+		//   Ƿ ó ǿ ´ ĳͰ   ̴.
+		static std::vector<LPENTITY> s_vecCandidate;
+		s_vecCandidate.clear();
+
+		SECTREE_MANAGER::instance().FindNearestInRange(pkChr->GetMapIndex(), pkChr->GetX(), pkChr->GetY(), iMaxDistance, 0,
+				SPATIAL_KIND_PC | SPATIAL_KIND_NPC, s_vecCandidate);
+
+		for (size_t i = 0; i < s_vecCandidate.size(); ++i)
+			if (f(s_vecCandidate[i]))
+				break;
 	}
 	return f.GetVictim();
 }
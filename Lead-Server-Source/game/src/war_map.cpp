@@ -67,6 +67,21 @@ EVENTFUNC(war_end_event)
 	}
 }
 
+EVENTFUNC(war_broadcast_event)
+{
+	war_map_info* info = dynamic_cast<war_map_info*>( event->info );
+
+	if ( info == NULL )
+	{
+		sys_err( "war_broadcast_event> <Factor> Null pointer" );
+		return 0;
+	}
+
+	CWarMap * pMap = info->pWarMap;
+	pMap->FlushBroadcast();
+	return 0;
+}
+
 EVENTFUNC(war_timeout_event)
 {
 	war_map_info* info = dynamic_cast<war_map_info*>( event->info );
@@ -118,6 +133,9 @@ CWarMap::CWarMap(long lMapIndex, const TGuildWarInfo & r_info, TWarMapInfo * pkW
 	m_pkEndEvent = NULL;
 	m_pkTimeoutEvent = NULL;
 	m_pkResetFlagEvent = NULL;
+	m_pkBroadcastEvent = NULL;
+	m_bScoreDirty = false;
+	m_bUserCountDirty = false;
 	m_bTimeout = false;
 	m_dwStartTime = get_dword_time();
 	m_bEnded = false;
@@ -137,6 +155,7 @@ CWarMap::~CWarMap()
 	event_cancel(&m_pkEndEvent);
 	event_cancel(&m_pkTimeoutEvent);
 	event_cancel(&m_pkResetFlagEvent);
+	event_cancel(&m_pkBroadcastEvent);
 
 	sys_log(0, "WarMap::~WarMap : map index %d", GetMapIndex());
 
@@ -329,6 +348,43 @@ struct FSendUserCount
 
 void CWarMap::UpdateUserCount()
 {
+	m_bUserCountDirty = true;
+	RequestBroadcast();
+}
+
+void CWarMap::RequestBroadcast()
+{
+	if (g_iWarBroadcastInterval <= 0)
+	{
+		FlushBroadcast();
+		return;
+	}
+
+	// ̹ Ǿ  ׶ Բ .
+	if (m_pkBroadcastEvent)
+		return;
+
+	war_map_info* info = AllocEventInfo<war_map_info>();
+	info->pWarMap = this;
+
+	m_pkBroadcastEvent = event_create(war_broadcast_event, info, MAX(1, g_iWarBroadcastInterval * passes_per_sec / 1000));
+}
+
+void CWarMap::FlushBroadcast()
+{
+	event_cancel(&m_pkBroadcastEvent);
+
+	if (m_bScoreDirty)
+	{
+		m_bScoreDirty = false;
+		SendScoreBoard();
+	}
+
+	if (!m_bUserCountDirty)
+		return;
+
+	m_bUserCountDirty = false;
+
 	FSendUserCount f(
 			m_TeamData[0].dwID, 
 			m_TeamData[0].GetAccumulatedJoinerCount(), 
@@ -393,8 +449,7 @@ void CWarMap::IncMember(LPCHARACTER ch)
 	LPDESC d = ch->GetDesc();
 
 	SendWarPacket(d);
-	SendScorePacket(0, d);
-	SendScorePacket(1, d);
+	SendScoreBoard(d);
 }
 
 void CWarMap::DecMember(LPCHARACTER ch)
@@ -658,6 +713,30 @@ void CWarMap::SendScorePacket(BYTE bIdx, LPDESC d)
 		Packet(buf.read_peek(), buf.size());
 }
 
+void CWarMap::SendScoreBoard(LPDESC d)
+{
+	TPacketGCGuild p;
+
+	p.header = HEADER_GC_GUILD;
+	p.subheader = GUILD_SUBHEADER_GC_WAR_SCORE;
+	p.size = sizeof(p) + sizeof(DWORD) + sizeof(DWORD) + sizeof(long);
+
+	TEMP_BUFFER buf;
+
+	for (BYTE bIdx = 0; bIdx < 2; ++bIdx)
+	{
+		buf.write(&p, sizeof(p));
+		buf.write(&m_TeamData[bIdx].dwID, sizeof(DWORD));
+		buf.write(&m_TeamData[bIdx ? 0 : 1].dwID, sizeof(DWORD));
+		buf.write(&m_TeamData[bIdx].iScore, sizeof(long));
+	}
+
+	if (d)
+		d->Packet(buf.read_peek(), buf.size());
+	else
+		Packet(buf.read_peek(), buf.size());
+}
+
 void CWarMap::UpdateScore(DWORD g1, int score1, DWORD g2, int score2)
 {
 	BYTE idx;
@@ -667,7 +746,7 @@ void CWarMap::UpdateScore(DWORD g1, int score1, DWORD g2, int score2)
 		if (m_TeamData[idx].iScore != score1)
 		{
 			m_TeamData[idx].iScore = score1;
-			SendScorePacket(idx);
+			m_bScoreDirty = true;
 		}
 	}
 
@@ -676,10 +755,13 @@ void CWarMap::UpdateScore(DWORD g1, int score1, DWORD g2, int score2)
 		if (m_TeamData[idx].iScore != score2)
 		{
 			m_TeamData[idx].iScore = score2;
-			SendScorePacket(idx);
+			m_bScoreDirty = true;
 		}
 	}
 
+	if (m_bScoreDirty)
+		RequestBroadcast();
+
 	CheckScore();
 }
 
@@ -770,6 +852,9 @@ bool CWarMap::SetEnded()
 	event_cancel(&m_pkResetFlagEvent);
 	m_bEnded = true;
 
+	//   ٸ ʰ .
+	FlushBroadcast();
+
 	war_map_info* info = AllocEventInfo<war_map_info>();
 
 	info->pWarMap = this;
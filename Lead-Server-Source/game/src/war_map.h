@@ -90,6 +90,10 @@ class CWarMap
 		void	Notice(const char * psz);
 		void	SendWarPacket(LPDESC d);
 		void	SendScorePacket(BYTE bIdx, LPDESC d = NULL);
+		void	SendScoreBoard(LPDESC d = NULL);	//    Ŷ ϳ 
+
+		// UpdateScore / ο     ü .
+		void	FlushBroadcast();
 
 		void	OnKill(LPCHARACTER killer, LPCHARACTER ch);
 
@@ -101,6 +105,7 @@ class CWarMap
 
 	private:
 		void	UpdateUserCount();
+		void	RequestBroadcast();
 
 	private:
 		TWarMapInfo	m_kMapInfo;
@@ -110,6 +115,10 @@ class CWarMap
 		LPEVENT m_pkTimeoutEvent;
 		LPEVENT m_pkEndEvent;
 		LPEVENT	m_pkResetFlagEvent;
+		LPEVENT	m_pkBroadcastEvent;
+
+		bool		m_bScoreDirty;
+		bool		m_bUserCountDirty;
 
 		typedef struct STeamData
 		{
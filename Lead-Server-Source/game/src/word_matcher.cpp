@@ -0,0 +1,128 @@
+#include "stdafx.h"
+#include "word_matcher.h"
+
+CWordMatcher::CWordMatcher()
+{
+	Clear();
+}
+
+void CWordMatcher::Clear()
+{
+	m_iFlags = 0;
+	m_vec_kNode.clear();
+	m_vec_kEdge.clear();
+	m_vec_iWordLength.clear();
+	m_vec_iWordNext.clear();
+	memset(m_aiRootEdge, 0, sizeof(m_aiRootEdge));
+}
+
+void CWordMatcher::Build(const std::vector<std::string> & c_rvec_stWord, int iFlags)
+{
+	Clear();
+	m_iFlags = iFlags;
+
+	//  ڽ  trie   ĵ  迭 ű.
+	std::vector<std::vector<std::pair<BYTE, int> > > vec_vec_kChild(1);
+	std::vector<int> vec_iWordHead(1, -1);
+
+	m_vec_iWordLength.resize(c_rvec_stWord.size());
+	m_vec_iWordNext.resize(c_rvec_stWord.size(), -1);
+
+	for (size_t iWord = 0; iWord < c_rvec_stWord.size(); ++iWord)
+	{
+		const std::string & c_rstWord = c_rvec_stWord[iWord];
+
+		m_vec_iWordLength[iWord] = c_rstWord.length();
+
+		if (c_rstWord.empty())
+			continue;
+
+		int iState = 0;
+
+		for (size_t i = 0; i < c_rstWord.length(); ++i)
+		{
+			BYTE c = (BYTE) c_rstWord[i];
+
+			if ((m_iFlags & FLAG_IGNORE_CASE) && c >= 'A' && c <= 'Z')
+				c += 'a' - 'A';
+
+			std::vector<std::pair<BYTE, int> > & rvec_kChild = vec_vec_kChild[iState];
+			int iNext = 0;
+
+			for (size_t j = 0; j < rvec_kChild.size(); ++j)
+			{
+				if (rvec_kChild[j].first == c)
+				{
+					iNext = rvec_kChild[j].second;
+					break;
+				}
+			}
+
+			if (!iNext)
+			{
+				iNext = vec_vec_kChild.size();
+				vec_vec_kChild[iState].push_back(std::make_pair(c, iNext));
+				vec_vec_kChild.push_back(std::vector<std::pair<BYTE, int> >());
+				vec_iWordHead.push_back(-1);
+			}
+
+			iState = iNext;
+		}
+
+		m_vec_iWordNext[iWord] = vec_iWordHead[iState];
+		vec_iWordHead[iState] = iWord;
+	}
+
+	m_vec_kNode.resize(vec_vec_kChild.size());
+
+	for (size_t iState = 0; iState < vec_vec_kChild.size(); ++iState)
+	{
+		std::vector<std::pair<BYTE, int> > & rvec_kChild = vec_vec_kChild[iState];
+		std::sort(rvec_kChild.begin(), rvec_kChild.end());
+
+		TNode & rkNode = m_vec_kNode[iState];
+		rkNode.dwFirstEdge = m_vec_kEdge.size();
+		rkNode.wEdgeCount = rvec_kChild.size();
+		rkNode.iFail = 0;
+		rkNode.iWordHead = vec_iWordHead[iState];
+		rkNode.iOutputLink = 0;
+
+		for (size_t j = 0; j < rvec_kChild.size(); ++j)
+		{
+			TEdge kEdge;
+			kEdge.bByte = rvec_kChild[j].first;
+			kEdge.iNext = rvec_kChild[j].second;
+			m_vec_kEdge.push_back(kEdge);
+
+			if (iState == 0)
+				m_aiRootEdge[kEdge.bByte] = kEdge.iNext;
+		}
+	}
+
+	//   fail  ä. θ fail  ׻   ִ.
+	std::deque<int> deq_iState;
+
+	for (int j = 0; j < m_vec_kNode[0].wEdgeCount; ++j)
+		deq_iState.push_back(m_vec_kEdge[j].iNext);
+
+	while (!deq_iState.empty())
+	{
+		int iState = deq_iState.front();
+		deq_iState.pop_front();
+
+		const TNode & rkNode = m_vec_kNode[iState];
+
+		for (int j = 0; j < rkNode.wEdgeCount; ++j)
+		{
+			const TEdge & rkEdge = m_vec_kEdge[rkNode.dwFirstEdge + j];
+			TNode & rkChild = m_vec_kNode[rkEdge.iNext];
+
+			rkChild.iFail = Next(rkNode.iFail, rkEdge.bByte);
+
+			const TNode & rkFail = m_vec_kNode[rkChild.iFail];
+			rkChild.iOutputLink = rkFail.iWordHead >= 0 ? rkChild.iFail : rkFail.iOutputLink;
+
+			deq_iState.push_back(rkEdge.iNext);
+		}
+	}
+}
@@ -0,0 +1,118 @@
+#ifndef __INC_METIN_II_GAME_WORD_MATCHER_H__
+#define __INC_METIN_II_GAME_WORD_MATCHER_H__
+
+//
+//  ܾ ڿ   Ⱦ ã Aho-Corasick 丶. Ģ  ܾ  .
+// ܾ   ڿ ̿ Ѵ. Ʈ  ãǷ  Ʈ 
+// 迡 ϴ θ ʿ ȮѴ.
+//
+class CWordMatcher
+{
+	public:
+		enum
+		{
+			FLAG_IGNORE_CASE	= (1 << 0),	// ASCII ҹڸ  ʴ´
+			FLAG_SKIP_SPACE		= (1 << 1),	//    . ġ   ġ̴
+		};
+
+		CWordMatcher();
+
+		void	Clear();
+		// ܾ ȣ c_rvec_stWord  ̴.  ܾ ã ʴ´.
+		void	Build(const std::vector<std::string> & c_rvec_stWord, int iFlags);
+
+		bool	IsEmpty() const			{ return m_vec_kNode.size() <= 1; }
+		int	GetWordLength(int iWord) const	{ return m_vec_iWordLength[iWord]; }
+		size_t	GetNodeCount() const		{ return m_vec_kNode.size(); }
+
+		// ܾ ã  f(iWord, iEnd)  θ. iEnd  ܾ  ٷ  ġ̰
+		//  iEnd - GetWordLength(iWord) ̴. f  false  ָ ׸ ã´.
+		template <typename F>
+		void	Scan(const char * c_pszText, size_t len, F & f) const
+		{
+			if (IsEmpty())
+				return;
+
+			int iState = 0;
+			int iPos = 0;
+
+			for (size_t i = 0; i < len; ++i)
+			{
+				BYTE c = (BYTE) c_pszText[i];
+
+				if ((m_iFlags & FLAG_SKIP_SPACE) && isspace(c))
+					continue;
+
+				if ((m_iFlags & FLAG_IGNORE_CASE) && c >= 'A' && c <= 'Z')
+					c += 'a' - 'A';
+
+				iState = Next(iState, c);
+				++iPos;
+
+				const TNode & rkNode = m_vec_kNode[iState];
+
+				for (int iOut = rkNode.iWordHead >= 0 ? iState : rkNode.iOutputLink; iOut > 0; iOut = m_vec_kNode[iOut].iOutputLink)
+					for (int iWord = m_vec_kNode[iOut].iWordHead; iWord >= 0; iWord = m_vec_iWordNext[iWord])
+						if (!f(iWord, iPos))
+							return;
+			}
+		}
+
+	private:
+		typedef struct SNode
+		{
+			DWORD	dwFirstEdge;
+			WORD	wEdgeCount;
+			int	iFail;
+			int	iWordHead;	//  ¿  ܾ. m_vec_iWordNext  ̾
+			int	iOutputLink;	// fail  󰡴 ó  ܾ  .  0
+		} TNode;
+
+		typedef struct SEdge
+		{
+			BYTE	bByte;
+			int	iNext;
+		} TEdge;
+
+		int	FindEdge(int iState, BYTE c) const
+		{
+			const TNode & rkNode = m_vec_kNode[iState];
+			const TEdge * pkEdge = &m_vec_kEdge[rkNode.dwFirstEdge];
+
+			// Ʈ  ĵǾ ְ 밳 ѵ ̴.
+			for (int i = 0; i < rkNode.wEdgeCount; ++i)
+			{
+				if (pkEdge[i].bByte == c)
+					return pkEdge[i].iNext;
+
+				if (pkEdge[i].bByte > c)
+					break;
+			}
+
+			return 0;
+		}
+
+		int	Next(int iState, BYTE c) const
+		{
+			while (iState)
+			{
+				int iNext = FindEdge(iState, c);
+
+				if (iNext)
+					return iNext;
+
+				iState = m_vec_kNode[iState].iFail;
+			}
+
+			return m_aiRootEdge[c];
+		}
+
+		int			m_iFlags;
+		std::vector<TNode>	m_vec_kNode;	// 0  Ѹ
+		std::vector<TEdge>	m_vec_kEdge;
+		int			m_aiRootEdge[256];	// Ѹ ٷ ã´
+		std::vector<int>	m_vec_iWordLength;
+		std::vector<int>	m_vec_iWordNext;
+};
+
+#endif
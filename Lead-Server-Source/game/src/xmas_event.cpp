@@ -42,10 +42,8 @@ namespace xmas
 			{
 				if (value > 0 && prev_value == 0)
 				{
-					CharacterVectorInteractor i;
-
 					//  ش
-					if (!CHARACTER_MANAGER::instance().GetCharactersByRaceNum(MOB_XMAS_TREE_VNUM, i))
+					if (!CHARACTER_MANAGER::instance().GetCharactersByRaceNum(MOB_XMAS_TREE_VNUM))
 						CHARACTER_MANAGER::instance().SpawnMob(MOB_XMAS_TREE_VNUM, 61, 76500 + 358400, 60900 + 153600, 0, false, -1);
 				}
 				else if (prev_value > 0 && value == 0)
@@ -89,9 +87,7 @@ namespace xmas
 					{
 						quest::CQuestManager::instance().RequestSetEventFlag("xmas_santa", 2);
 
-						CharacterVectorInteractor i;
-
-						if (CHARACTER_MANAGER::instance().GetCharactersByRaceNum(MOB_SANTA_VNUM, i))
+						if (CHARACTER_MANAGER::instance().GetCharactersByRaceNum(MOB_SANTA_VNUM))
 							CHARACTER_MANAGER::instance().SpawnMobRandomPosition(MOB_SANTA_VNUM, 61);
 					}
 					break;
@@ -127,9 +123,7 @@ namespace xmas
 		if (quest::CQuestManager::instance().GetEventFlag("xmas_santa") == 0)
 			return 0;
 
-		CharacterVectorInteractor i;
-
-		if (CHARACTER_MANAGER::instance().GetCharactersByRaceNum(MOB_SANTA_VNUM, i))
+		if (CHARACTER_MANAGER::instance().GetCharactersByRaceNum(MOB_SANTA_VNUM))
 			return 0;
 
 		if (CHARACTER_MANAGER::instance().SpawnMobRandomPosition(xmas::MOB_SANTA_VNUM, lMapIndex))
@@ -5,39 +5,99 @@ enum EDataType
 {
     D_DWORD,
     D_WORD,
-    D_BYTE
+    D_BYTE,
+    D_BIT,	//  4Ʈ. block, water, banpk   Ӽ
 };
 
 //
 //  Ӽ ó  
 //
+// ʹ      ´. D_BIT  8x8  Ÿ 
+//  (Ÿ ϳ 32 Ʈ)    ĳ ο ְ Ѵ.
+//
 class CAttribute
 {
     public:
+	enum
+	{
+	    BIT_ATTR_MASK	= 0x0f,	// D_BIT    ִ Ӽ Ʈ
+	    TILE_SHIFT		= 3,
+	    TILE_SIZE		= (1 << TILE_SHIFT),
+	    TILE_MASK		= TILE_SIZE - 1,
+	    TILE_BYTES		= TILE_SIZE * TILE_SIZE / 2,
+	};
+
 	CAttribute(DWORD width, DWORD height); // dword Ÿ  0 ä.
 	CAttribute(DWORD * attr, DWORD width, DWORD height); // attr о smartϰ Ӽ о´.
+	CAttribute(const CAttribute & r); // ͱ Ѵ.
+	// ó ٸ   ͸ ״ Ų. Set/Remove   ؼ ڱ  .
+	CAttribute(int dataType, DWORD defaultAttr, DWORD width, DWORD height, const void * sharedData);
 	~CAttribute();
 	void Alloc();
 	int GetDataType();
 	void * GetDataPtr();
+	DWORD GetDefaultAttr() const	{ return defaultAttr; }
+	size_t GetDataSize() const;	//  Ÿ ͸   Ʈ
 	void Set(DWORD x, DWORD y, DWORD attr);
 	void Remove(DWORD x, DWORD y, DWORD attr);
-	DWORD Get(DWORD x, DWORD y);
 	void CopyRow(DWORD y, DWORD * row);
+	size_t GetMemorySize() const; // Ͱ ϴ Ʈ
+
+	// ̵,  ˻縶 ҸǷ ζ ٷ д´.
+	DWORD Get(DWORD x, DWORD y) const
+	{
+	    if (x >= width || y >= height)
+		return 0;
+
+	    if (!data)
+		return defaultAttr;
+
+	    switch (dataType)
+	    {
+		case D_BIT:
+		    return GetBit(x, y);
+
+		case D_BYTE:
+		    return ((const BYTE *) data)[y * width + x];
+
+		case D_WORD:
+		    return ((const WORD *) data)[y * width + x];
+	    }
+
+	    return ((const DWORD *) data)[y * width + x];
+	}
 
     private:
 	void Initialize(DWORD width, DWORD height);
+	void Convert(int newType);
+	void Unshare();
+
+	// D_BIT  (x, y)  ȣ. Ÿ ȣ * 64 + Ÿ  ġ
+	DWORD GetBitIndex(DWORD x, DWORD y) const
+	{
+	    return ((((y >> TILE_SHIFT) * tileCols + (x >> TILE_SHIFT)) << (TILE_SHIFT * 2))
+		    | ((y & TILE_MASK) << TILE_SHIFT) | (x & TILE_MASK));
+	}
+
+	DWORD GetBit(DWORD x, DWORD y) const
+	{
+	    DWORD idx = GetBitIndex(x, y);
+	    BYTE b = ((const BYTE *) data)[idx >> 1];
+	    return (idx & 1) ? (b >> 4) : (b & BIT_ATTR_MASK);
+	}
+
+	void SetBit(DWORD x, DWORD y, DWORD attr);
+
+	CAttribute & operator=(const CAttribute &);
 
     private:
 	int dataType;
 	DWORD defaultAttr;
 	DWORD width, height;
+	DWORD tileCols, tileRows;	// D_BIT Ÿ 
 
 	void * data;
-
-	BYTE **	bytePtr;
-	WORD **	wordPtr;
-	DWORD ** dwordPtr;
+	bool ownData;	// false  data   ̶ free  ʴ´
 };
 
 #endif
@@ -10,79 +10,126 @@ void CAttribute::Initialize(DWORD width, DWORD height)
     defaultAttr = 0;
     this->width = width;
     this->height = height;
+    tileCols = (width + TILE_MASK) >> TILE_SHIFT;
+    tileRows = (height + TILE_MASK) >> TILE_SHIFT;
     data = NULL;
-    bytePtr = NULL;
-    wordPtr = NULL;
-    dwordPtr = NULL;
+    ownData = true;
 }
 
-void CAttribute::Alloc()
+size_t CAttribute::GetDataSize() const
 {
-    size_t memSize;
-
     switch (dataType)
     {
 	case D_DWORD:
-	    memSize = width * height * sizeof(DWORD);
-	    break;
+	    return width * height * sizeof(DWORD);
 
 	case D_WORD:
-	    memSize = width * height * sizeof(WORD);
-	    break;
+	    return width * height * sizeof(WORD);
 
 	case D_BYTE:
-	    memSize = width * height;
-	    break;
+	    return width * height;
 
-	default:
-	    assert(!"dataType error!");
-	    return;
+	case D_BIT:
+	    return tileCols * tileRows * TILE_BYTES;
+    }
+
+    return 0;
+}
+
+void CAttribute::Alloc()
+{
+    if (dataType != D_DWORD && dataType != D_WORD && dataType != D_BYTE && dataType != D_BIT)
+    {
+	assert(!"dataType error!");
+	return;
     }
 
+    size_t memSize = GetDataSize();
+    DWORD size = width * height;
+
     //sys_log(0, "Alloc::dataType %u width %d height %d memSize %d", dataType, width, height, memSize);
     data = malloc(memSize);
+    ownData = true;
 
     switch (dataType)
     {
 	case D_DWORD:
-	    dwordPtr = new DWORD * [height];
-	    dwordPtr[0] = (DWORD *) data;
+	    for (DWORD i = 0; i < size; ++i)
+		((DWORD *) data)[i] = defaultAttr;
+	    break;
 
-	    for (DWORD y = 1; y < height; ++y)
-		dwordPtr[y] = dwordPtr[y - 1] + width;
+	case D_WORD:
+	    for (DWORD i = 0; i < size; ++i)
+		((WORD *) data)[i] = defaultAttr;
+	    break;
 
-	    for (DWORD y = 0; y < height; ++y)
-		for (DWORD x = 0; x < width; ++x)
-		    dwordPtr[y][x] = defaultAttr;
+	case D_BYTE:
+	    memset(data, defaultAttr & 0xff, memSize);
+	    break;
 
+	case D_BIT:
+	    // Ÿ      ä.
+	    memset(data, (defaultAttr & BIT_ATTR_MASK) | ((defaultAttr & BIT_ATTR_MASK) << 4), memSize);
 	    break;
+    }
+}
 
-	case D_WORD:
-	    wordPtr = new WORD * [height];
-	    wordPtr[0] = (WORD *) data;
+// ٸ Ÿ ٲ۴. Ͱ   θ.
+void CAttribute::Convert(int newType)
+{
+    DWORD * attr = new DWORD[width * height];
 
-	    for (DWORD y = 1; y < height; ++y)
-		wordPtr[y] = wordPtr[y - 1] + width;
+    for (DWORD y = 0; y < height; ++y)
+	CopyRow(y, attr + y * width);
 
-	    for (DWORD y = 0; y < height; ++y)
-		for (DWORD x = 0; x < width; ++x)
-		    wordPtr[y][x] = defaultAttr;
+    if (ownData)
+	free(data);
 
-	    break;
+    data = NULL;
 
-	case D_BYTE:
-	    bytePtr = new BYTE * [height];
-	    bytePtr[0] = (BYTE *) data;
+    dataType = newType;
+    Alloc();
+
+    for (DWORD y = 0; y < height; ++y)
+	for (DWORD x = 0; x < width; ++x)
+	{
+	    DWORD v = attr[y * width + x];
 
-	    for (DWORD y = 1; y < height; ++y)
-		bytePtr[y] = bytePtr[y - 1] + width;
+	    switch (dataType)
+	    {
+		case D_BIT:	SetBit(x, y, v);	break;
+		case D_BYTE:	((BYTE *) data)[y * width + x] = v;	break;
+		case D_WORD:	((WORD *) data)[y * width + x] = v;	break;
+		default:	((DWORD *) data)[y * width + x] = v;	break;
+	    }
+	}
 
-	    for (DWORD y = 0; y < height; ++y)
-		for (DWORD x = 0; x < width; ++x)
-		    bytePtr[y][x] = defaultAttr;
+    delete [] attr;
+}
 
-	    break;
-    }
+//  ͸ ġ  ڱ ޸𸮷 ű.
+void CAttribute::Unshare()
+{
+    if (!data || ownData)
+	return;
+
+    const void * shared = data;
+    size_t memSize = GetDataSize();
+
+    data = malloc(memSize);
+    ownData = true;
+    thecore_memcpy(data, shared, memSize);
+}
+
+void CAttribute::SetBit(DWORD x, DWORD y, DWORD attr)
+{
+    DWORD idx = GetBitIndex(x, y);
+    BYTE & b = ((BYTE *) data)[idx >> 1];
+
+    if (idx & 1)
+	b = (b & BIT_ATTR_MASK) | ((attr & BIT_ATTR_MASK) << 4);
+    else
+	b = (b & ~BIT_ATTR_MASK) | (attr & BIT_ATTR_MASK);
 }
 
 CAttribute::CAttribute(DWORD width, DWORD height) // dword Ÿ  0 ä.
@@ -104,7 +151,13 @@ CAttribute::CAttribute(DWORD * attr, DWORD width, DWORD height) // attr
 
     // Ӽ    defaultAttr Ѵ.
     if (i == size)
+    {
 	defaultAttr = attr[0];
+
+	// ߿ Set  ͸  Ǹ   ´.
+	if (!(defaultAttr & ~BIT_ATTR_MASK))
+	    dataType = D_BIT;
+    }
     else
     {
 	int allAttr = 0;
@@ -112,8 +165,11 @@ CAttribute::CAttribute(DWORD * attr, DWORD width, DWORD height) // attr
 	for (i = 0; i < size; ++i)
 	    allAttr |= attr[i];
 
+	// block, water, banpk   κ  D_BIT
+	if (!(allAttr & ~BIT_ATTR_MASK))
+	    dataType = D_BIT;
 	//  8Ʈ   D_BYTE
-	if (!(allAttr & 0xffffff00))
+	else if (!(allAttr & 0xffffff00))
 	    dataType = D_BYTE;
 	//  16Ʈ   D_WORD
 	else if (!(allAttr & 0xffff0000))
@@ -130,35 +186,59 @@ CAttribute::CAttribute(DWORD * attr, DWORD width, DWORD height) // attr
 	    // ƴϸ Ʈ ؾ Ѵ.
 	    DWORD * pdw = (DWORD *) attr;
 
-	    if (dataType == D_BYTE)
+	    if (dataType == D_BIT)
 	    {
 		for (DWORD y = 0; y < height; ++y)
 		    for (DWORD x = 0; x < width; ++x)
-			bytePtr[y][x] = *(pdw++);
+			SetBit(x, y, *(pdw++));
+	    }
+	    else if (dataType == D_BYTE)
+	    {
+		for (DWORD i = 0; i < width * height; ++i)
+		    ((BYTE *) data)[i] = *(pdw++);
 	    }
 	    else if (dataType == D_WORD)
 	    {
-		for (DWORD y = 0; y < height; ++y)
-		    for (DWORD x = 0; x < width; ++x)
-			wordPtr[y][x] = *(pdw++);
+		for (DWORD i = 0; i < width * height; ++i)
+		    ((WORD *) data)[i] = *(pdw++);
 	    }
 	}
     }
 }
 
-CAttribute::~CAttribute()
+CAttribute::CAttribute(const CAttribute & r)
 {
-    if (data)
-	free(data);
+    Initialize(r.width, r.height);
 
-    if (bytePtr)
-	delete [] bytePtr;
+    dataType = r.dataType;
+    defaultAttr = r.defaultAttr;
 
-    if (wordPtr)
-	delete [] wordPtr;
+    //   Ӽ̶ Ͱ  ״ д.
+    if (r.data)
+    {
+	Alloc();
+	thecore_memcpy(data, r.data, GetDataSize());
+    }
+}
 
-    if (dwordPtr)
-	delete [] dwordPtr;
+CAttribute::CAttribute(int dataType, DWORD defaultAttr, DWORD width, DWORD height, const void * sharedData)
+{
+    Initialize(width, height);
+
+    this->dataType = dataType;
+    this->defaultAttr = defaultAttr;
+
+    if (sharedData)
+    {
+	data = const_cast<void *>(sharedData);
+	ownData = false;
+    }
+}
+
+CAttribute::~CAttribute()
+{
+    if (data && ownData)
+	free(data);
 }
 
 int CAttribute::GetDataType()
@@ -173,65 +253,82 @@ void * CAttribute::GetDataPtr()
 
 void CAttribute::Set(DWORD x, DWORD y, DWORD attr)
 {
-    if (x > width || y > height)
+    if (x >= width || y >= height)
 	return;
 
     if (!data)
 	Alloc();
+    else
+	Unshare();
 
-    if (bytePtr)
+    switch (dataType)
     {
-	SET_BIT(bytePtr[y][x], attr);
-	return;
-    }
+	case D_BIT:
+	    if (!(attr & ~BIT_ATTR_MASK))
+	    {
+		SetBit(x, y, GetBit(x, y) | attr);
+		return;
+	    }
 
-    if (wordPtr)
-    {
-	SET_BIT(wordPtr[y][x], attr);
-	return;
+	    // ǹ ATTR_OBJECT ó 4Ʈ   Ӽ  D_BYTE  Ǭ.
+	    Convert(D_BYTE);
+	    // fall through
+
+	case D_BYTE:
+	    SET_BIT(((BYTE *) data)[y * width + x], attr);
+	    return;
+
+	case D_WORD:
+	    SET_BIT(((WORD *) data)[y * width + x], attr);
+	    return;
     }
 
-    SET_BIT(dwordPtr[y][x], attr);
+    SET_BIT(((DWORD *) data)[y * width + x], attr);
 }
 
 void CAttribute::Remove(DWORD x, DWORD y, DWORD attr)
 {
-    if (x > width || y > height)
+    if (x >= width || y >= height)
 	return;
 
     if (!data) // Ӽ    Ͱ  ׳ Ѵ.
-	return;
-
-    if (bytePtr)
     {
-	REMOVE_BIT(bytePtr[y][x], attr);
-	return;
+	//   Ӽ  Ʈ  ̸ ͸ ƾ Ѵ.
+	if (!(defaultAttr & attr))
+	    return;
+
+	Alloc();
     }
+    else
+	Unshare();
 
-    if (wordPtr)
+    switch (dataType)
     {
-	REMOVE_BIT(wordPtr[y][x], attr);
-	return;
+	case D_BIT:
+	    SetBit(x, y, GetBit(x, y) & ~attr);
+	    return;
+
+	case D_BYTE:
+	    REMOVE_BIT(((BYTE *) data)[y * width + x], attr);
+	    return;
+
+	case D_WORD:
+	    REMOVE_BIT(((WORD *) data)[y * width + x], attr);
+	    return;
     }
 
-    REMOVE_BIT(dwordPtr[y][x], attr);
+    REMOVE_BIT(((DWORD *) data)[y * width + x], attr);
 }
 
-DWORD CAttribute::Get(DWORD x, DWORD y)
+size_t CAttribute::GetMemorySize() const
 {
-    if (x > width || y > height)
-	return 0;
-
-    if (!data)
-	return defaultAttr;
-
-    if (bytePtr)
-	return bytePtr[y][x];
+    size_t size = sizeof(*this);
 
-    if (wordPtr)
-	return wordPtr[y][x];
+    //  ʹ  ̶ ⼭  ʴ´.
+    if (data && ownData)
+	size += GetDataSize();
 
-    return dwordPtr[y][x];
+    return size;
 }
 
 void CAttribute::CopyRow(DWORD y, DWORD * row)
@@ -244,20 +341,25 @@ void CAttribute::CopyRow(DWORD y, DWORD * row)
 	return;
     }
 
-    if (dwordPtr)
-	thecore_memcpy(row, dwordPtr[y], sizeof(DWORD) * width);
-    else
+    switch (dataType)
     {
-	if (bytePtr)
-	{
+	case D_DWORD:
+	    thecore_memcpy(row, (DWORD *) data + y * width, sizeof(DWORD) * width);
+	    break;
+
+	case D_WORD:
 	    for (DWORD x = 0; x < width; ++x)
-		row[x] = bytePtr[y][x];
-	}
-	else if (wordPtr)
-	{
+		row[x] = ((WORD *) data)[y * width + x];
+	    break;
+
+	case D_BYTE:
 	    for (DWORD x = 0; x < width; ++x)
-		row[x] = wordPtr[y][x];
-	}
+		row[x] = ((BYTE *) data)[y * width + x];
+	    break;
+
+	case D_BIT:
+	    for (DWORD x = 0; x < width; ++x)
+		row[x] = GetBit(x, y);
+	    break;
     }
 }
-
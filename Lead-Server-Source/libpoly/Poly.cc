@@ -32,7 +32,7 @@ double CPoly::my_frandom(double start, double end)
 
 CPoly::CPoly()
 	: iToken(0), iNumToken(0), iLookAhead(0), iErrorPos(0), ErrorOccur(true),
-	uiLookPos(0), STSize(0)
+	uiLookPos(0), STSize(0), iResultReg(0), bCompiled(false)
 {
     lSymbol.clear();
     lSymbol.reserve(50);
@@ -51,6 +51,199 @@ void CPoly::SetStr(const string & str)
 }
 
 double CPoly::Eval()
+{
+	if (ErrorOccur)
+		return 0;
+
+	if (!bCompiled)
+		return EvalInterpreted();
+
+	double * r = &registers[0];
+	double t;
+
+	for (vector<SInstr>::const_iterator it = program.begin(); it != program.end(); ++it)
+	{
+		const SInstr & c = *it;
+
+		switch (c.op)
+		{
+			case PLU:	r[c.dst] = r[c.a] + r[c.b]; break;
+			case MIN:	r[c.dst] = r[c.a] - r[c.b]; break;
+			case MUL:	r[c.dst] = r[c.a] * r[c.b]; break;
+			case MOD:
+				if (r[c.b] == 0)
+					return 0;
+				r[c.dst] = fmod(r[c.a], r[c.b]);
+				break;
+			case DIV:
+				if (r[c.b] == 0)
+					return 0;
+				r[c.dst] = r[c.a] / r[c.b];
+				break;
+			case POW:	r[c.dst] = pow(r[c.a], r[c.b]); break;
+			case ROOT:
+				if (r[c.a] < 0)
+					return 0;
+				r[c.dst] = sqrt(r[c.a]);
+				break;
+			case COS:	r[c.dst] = cos(r[c.a]); break;
+			case SIN:	r[c.dst] = sin(r[c.a]); break;
+			case SIGN:
+				if (r[c.a] == 0.0) r[c.dst] = 0.0;
+				else if (r[c.a] < 0.0) r[c.dst] = -1.0;
+				else r[c.dst] = 1.0;
+				break;
+			case TAN:
+				if (!cos(r[c.a]))
+					return 0;
+				r[c.dst] = tan(r[c.a]);
+				break;
+			case CSC:
+				if (!(t = sin(r[c.a])))
+					return 0;
+				r[c.dst] = 1 / t;
+				break;
+			case SEC:
+				if (!(t = cos(r[c.a])))
+					return 0;
+				r[c.dst] = 1 / t;
+				break;
+			case COT:
+				if (!(t = sin(r[c.a])))
+					return 0;
+				r[c.dst] = cos(r[c.a]) / t;
+				break;
+			case LN:
+				if (r[c.a] <= 0)
+					return 0;
+				r[c.dst] = log(r[c.a]);
+				break;
+			case LOG10:
+				if (r[c.a] <= 0)
+					return 0;
+				r[c.dst] = log10(r[c.a]);
+				break;
+			case LOG:
+				if (r[c.b] <= 0 || r[c.a] <= 0 || r[c.a] == 1)
+					return 0;
+				r[c.dst] = log(r[c.b]) / log(r[c.a]);
+				break;
+			case ABS:	r[c.dst] = fabs(r[c.a]); break;
+			case FLOOR:	r[c.dst] = floor(r[c.a]); break;
+			case IRAND:	r[c.dst] = my_irandom(r[c.a], r[c.b]); break;
+			case FRAND:	r[c.dst] = my_frandom(r[c.a], r[c.b]); break;
+			case MINF:	r[c.dst] = (r[c.a] < r[c.b]) ? r[c.a] : r[c.b]; break;
+			case MAXF:	r[c.dst] = (r[c.a] > r[c.b]) ? r[c.a] : r[c.b]; break;
+			default:
+				return 0;
+		}
+	}
+
+	return r[iResultReg];
+}
+
+bool CPoly::compile()
+{
+	program.clear();
+	registers.clear();
+	bCompiled = false;
+
+	// first pass: count constants and the deepest stack so every register
+	// index is known before any instruction is emitted
+	int iConstCount = 0;
+	int iDepth = 0, iMaxDepth = 0;
+
+	for (unsigned int i = 0; i < tokenBase.size(); ++i)
+	{
+		switch (tokenBase[i])
+		{
+			case NUM:
+				++iConstCount;
+				++iDepth;
+				break;
+			case ID:
+				if (++i >= tokenBase.size() || tokenBase[i] < 0 || tokenBase[i] >= STSize)
+					return false;
+				++iDepth;
+				break;
+			case ROOT: case COS: case SIN: case SIGN: case TAN: case CSC:
+			case SEC: case COT: case LN: case LOG10: case ABS: case FLOOR:
+				if (iDepth < 1)
+					return false;
+				break;
+			case PLU: case MIN: case MUL: case MOD: case DIV: case POW:
+			case LOG: case IRAND: case FRAND: case MINF: case MAXF:
+				if (iDepth < 2)
+					return false;
+				--iDepth;
+				break;
+			default:
+				return false;
+		}
+
+		if (iDepth > MAXSTACK)
+			return false;
+
+		if (iDepth > iMaxDepth)
+			iMaxDepth = iDepth;
+	}
+
+	if (iDepth != 1 || iConstCount != (int) numBase.size())
+		return false;
+
+	const int iConstBase = STSize;
+	const int iTempBase = iConstBase + iConstCount;
+
+	registers.resize(iTempBase + iMaxDepth);
+
+	for (int i = 0; i < STSize; ++i)
+		registers[i] = lSymbol[i]->dVal;
+
+	for (int i = 0; i < iConstCount; ++i)
+		registers[iConstBase + i] = numBase[i];
+
+	// second pass: the register standing for each stack entry; an
+	// operation writes the temporary of the depth its result lands on
+	int stack[MAXSTACK];
+	int iSp = 0, iConst = 0;
+
+	for (unsigned int i = 0; i < tokenBase.size(); ++i)
+	{
+		SInstr c;
+		c.op = tokenBase[i];
+
+		switch (c.op)
+		{
+			case NUM:
+				stack[iSp++] = iConstBase + iConst++;
+				continue;
+			case ID:
+				stack[iSp++] = tokenBase[++i];
+				continue;
+			case ROOT: case COS: case SIN: case SIGN: case TAN: case CSC:
+			case SEC: case COT: case LN: case LOG10: case ABS: case FLOOR:
+				c.a = stack[iSp - 1];
+				c.b = c.a;
+				c.dst = iTempBase + iSp - 1;
+				break;
+			default:
+				c.a = stack[iSp - 2];
+				c.b = stack[iSp - 1];
+				c.dst = iTempBase + iSp - 2;
+				--iSp;
+				break;
+		}
+
+		stack[iSp - 1] = c.dst;
+		program.push_back(c);
+	}
+
+	iResultReg = stack[0];
+	bCompiled = true;
+	return true;
+}
+
+double CPoly::EvalInterpreted()
 {
 	int stNow;
 	double save[MAXSTACK],t;
@@ -238,6 +431,9 @@ int CPoly::Analyze(const char * pszStr)
 	return false;
     }
 
+    if (!ErrorOccur)
+	compile();
+
     return !ErrorOccur;
 }
 
@@ -258,6 +454,11 @@ void CPoly::Clear()
     lSymbol.clear();
     SymbolIndex.clear();
     STSize=0;
+
+    program.clear();
+    registers.clear();
+    iResultReg = 0;
+    bCompiled = false;
 }
 
 void CPoly::expr() 
@@ -566,9 +767,30 @@ int CPoly::SetVar(const string & strName, double dVar)
     if (index == -1) return false;
     CSymTable * stVar = lSymbol[(/*FindIndex*/(index))];
     stVar->dVal = dVar;
+
+    if (bCompiled)
+	registers[index] = dVar;
+
     return true;
 }
 
+int CPoly::FindVarSlot(const std::string & strName)
+{
+    if (ErrorOccur) return -1;
+    return find(strName);
+}
+
+void CPoly::SetVarSlot(int iSlot, double dVar)
+{
+    if (ErrorOccur || iSlot < 0 || iSlot >= STSize)
+	return;
+
+    lSymbol[iSlot]->dVal = dVar;
+
+    if (bCompiled)
+	registers[iSlot] = dVar;
+}
+
 double CPoly::GetVar(const std::string & strName)
 {
     if (ErrorOccur) return false;
@@ -15,11 +15,17 @@ class CPoly
 
 		int	Analyze(const char * pszStr = NULL);
 		double	Eval();
+		double	EvalInterpreted();	// walks the token list, kept for checks and benchmarks
 		void	SetStr(const std::string & str);
 		int	SetVar(const std::string & strName, double dVar);
 		double GetVar(const std::string & strName);
 		void	Clear();
 
+		// A slot stays valid until the next Analyze or Clear, so callers
+		// evaluating the same formula many times can skip the name lookup.
+		int	FindVarSlot(const std::string & strName);
+		void	SetVarSlot(int iSlot, double dVar);
+
 	protected:
 		int		my_irandom(double start, double end);
 		double		my_frandom(double start, double end);
@@ -35,6 +41,18 @@ class CPoly
 		int		lexan();
 		void		error();
 		void		expr();
+		bool		compile();
+
+		// Analyze compiles the postfix token list into a flat program over
+		// one register file: variable slots (same index as lSymbol), then
+		// constants, then one temporary per stack depth.
+		struct SInstr
+		{
+			int	op;
+			int	dst;
+			int	a;
+			int	b;
+		};
 
 		int		iToken;
 		double		iNumToken;
@@ -51,6 +69,11 @@ class CPoly
 		int				STSize;
 		std::string			strData;
 
+		std::vector<SInstr>		program;
+		std::vector<double>		registers;
+		int				iResultReg;
+		bool				bCompiled;
+
 };
 
 #endif 
@@ -1,15 +1,56 @@
 #ifdef __WIN32__
 #include <windows.h>
+#else
+#include <unistd.h>
 #endif
 
 #include "Poly.h"
 
 #include <cstdlib>
+#include <cstdio>
 #include <ctime>
 #include <iostream>
 
 using namespace std;
 
+static void seed_random(unsigned int seed)
+{
+#ifndef __WIN32__
+	srandom(seed);
+#else
+	srand(seed);
+#endif
+}
+
+// Eval() against EvalInterpreted() over the same formula. Both draw random
+// numbers in the same order, so with the same seed the results must match.
+static void benchmark(CPoly & p, int iLoop)
+{
+	unsigned int seed = time(0);
+	double dSum[2] = { 0.0, 0.0 };
+	double dSec[2];
+
+	for (int k = 0; k < 2; ++k)
+	{
+		seed_random(seed);
+		clock_t start = clock();
+
+		for (int i = 0; i < iLoop; ++i)
+		{
+			p.SetVar("k", i % 40);
+			dSum[k] += k ? p.Eval() : p.EvalInterpreted();
+		}
+
+		dSec[k] = (double) (clock() - start) / CLOCKS_PER_SEC;
+	}
+
+	printf("interpreted %.3f sec, compiled %.3f sec (x%.2f) for %d evals\n",
+			dSec[0], dSec[1], dSec[1] > 0.0 ? dSec[0] / dSec[1] : 0.0, iLoop);
+
+	if (dSum[0] != dSum[1])
+		printf("MISMATCH: interpreted %f compiled %f\n", dSum[0], dSum[1]);
+}
+
 int main(int argc, char ** argv)
 {
 	printf( "12345\n" );
@@ -20,9 +61,9 @@ int main(int argc, char ** argv)
 	srand(time(0) + GetCurrentProcessId());
 #endif
 
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
 	{
-		cout << "argc != 3"  << endl;
+		cout << "usage: poly <formula> <b> [benchmark loop count]"  << endl;
 		return 0;
 	}
 
@@ -42,6 +83,10 @@ int main(int argc, char ** argv)
 
     cout << (int) p.Eval() << endl;
     cout << p.Eval() << endl;
+
+    if (argc == 4)
+	benchmark(p, atoi(argv[3]));
+
     return 0;
 }
 
@@ -42,6 +42,8 @@ CAsyncSQL::~CAsyncSQL()
 
 void CAsyncSQL::Destroy()
 {
+	ClearStmt();
+
 	if (m_hDB.host)
 	{
 		sys_log(0, "AsyncSQL: closing mysql connection.");
@@ -277,6 +279,45 @@ SQLMsg * CAsyncSQL::DirectQuery(const char * c_pszQuery)
 	return p;
 }
 
+MYSQL_RES * CAsyncSQL::DirectUseResult(const char * c_pszQuery)
+{
+	if (m_ulThreadID != mysql_thread_id(&m_hDB))
+	{
+		sys_err("MySQL connection was reconnected. querying locale set");
+		while (!QueryLocaleSet());
+		m_ulThreadID = mysql_thread_id(&m_hDB);
+	}
+
+	if (mysql_real_query(&m_hDB, c_pszQuery, strlen(c_pszQuery)))
+	{
+		sys_err("AsyncSQL::DirectQueryEach : mysql_query error: %s\nquery: %s", mysql_error(&m_hDB), c_pszQuery);
+		return NULL;
+	}
+
+	MYSQL_RES * pRes = mysql_use_result(&m_hDB);
+
+	if (!pRes)
+		sys_err("AsyncSQL::DirectQueryEach : no result set: %s\nquery: %s", mysql_error(&m_hDB), c_pszQuery);
+
+	return pRes;
+}
+
+bool CAsyncSQL::EndUseResult(MYSQL_RES * pRes, const char * c_pszQuery)
+{
+	bool bOk = true;
+
+	//  ޴ ߿   mysql_fetch_row  NULL  ְ  ´.
+	if (mysql_errno(&m_hDB))
+	{
+		sys_err("AsyncSQL::DirectQueryEach : fetch error: %s\nquery: %s", mysql_error(&m_hDB), c_pszQuery);
+		bOk = false;
+	}
+
+	// use_result     о  ٽ   ִ. free_result  о .
+	mysql_free_result(pRes);
+	return bOk;
+}
+
 void CAsyncSQL::AsyncQuery(const char * c_pszQuery)
 {
 	SQLMsg * p = new SQLMsg;
@@ -301,6 +342,34 @@ void CAsyncSQL::ReturnQuery(const char * c_pszQuery, void * pvUserData)
 	PushQuery(p);
 }
 
+void CAsyncSQL::AsyncStmt(const CStmtQuery & c_rkQuery)
+{
+	SQLMsg * p = new SQLMsg;
+
+	p->m_pkSQL = &m_hDB;
+	p->iID = ++m_iMsgCount;
+	p->stQuery = c_rkQuery.GetQuery();
+	p->bStmt = true;
+	p->vec_stmtParam = c_rkQuery.GetParams();
+
+	PushQuery(p);
+}
+
+void CAsyncSQL::ReturnStmt(const CStmtQuery & c_rkQuery, void * pvUserData)
+{
+	SQLMsg * p = new SQLMsg;
+
+	p->m_pkSQL = &m_hDB;
+	p->iID = ++m_iMsgCount;
+	p->stQuery = c_rkQuery.GetQuery();
+	p->bStmt = true;
+	p->vec_stmtParam = c_rkQuery.GetParams();
+	p->bReturn = true;
+	p->pvUserData = pvUserData;
+
+	PushQuery(p);
+}
+
 void CAsyncSQL::PushResult(SQLMsg * p)
 {
 	MUTEX_LOCK(m_mtxResult);
@@ -338,6 +407,18 @@ void CAsyncSQL::PushQuery(SQLMsg * p)
 	MUTEX_UNLOCK(m_mtxQuery);
 }
 
+void CAsyncSQL::PushFence(SQLFence * pkFence, bool bMark)
+{
+	SQLMsg * p = new SQLMsg;
+
+	p->m_pkSQL = &m_hDB;
+	p->iID = ++m_iMsgCount;
+	p->pkFence = pkFence;
+	p->bFenceMark = bMark;
+
+	PushQuery(p);
+}
+
 bool CAsyncSQL::PeekQuery(SQLMsg ** pp)
 {
 	MUTEX_LOCK(m_mtxQuery);
@@ -416,6 +497,26 @@ bool CAsyncSQL::PopQueryFromCopyQueue()
 
 	return true;
 }
+bool CAsyncSQL::PassFence(SQLMsg * p)
+{
+	if (!p->pkFence)
+		return false;
+
+	// Release  ڿ ٸ    Ƿ Ÿ   ʴ´.
+	if (p->bFenceMark)
+		p->pkFence->sem.Release();
+	else
+	{
+		for (int i = 0; i < p->pkFence->iWait; ++i)
+			p->pkFence->sem.Wait();
+
+		delete p->pkFence;
+	}
+
+	p->pkFence = NULL;
+	return true;
+}
+
 int		CAsyncSQL::GetCopiedQueryCount()
 {
 	return m_iCopiedQuery;
@@ -432,6 +533,131 @@ void	CAsyncSQL::AddCopiedQueryCount(int iCopiedQuery)
 
 
 
+bool CAsyncSQL::Execute(SQLMsg * p)
+{
+	if (p->bStmt)
+		return ExecuteStmt(p);
+
+	if (mysql_real_query(&m_hDB, p->stQuery.c_str(), p->stQuery.length()))
+	{
+		p->uiSQLErrno = mysql_errno(&m_hDB);
+		m_stError = mysql_error(&m_hDB);
+		return false;
+	}
+
+	return true;
+}
+
+MYSQL_STMT * CAsyncSQL::GetStmt(SQLMsg * p)
+{
+	std::map<std::string, MYSQL_STMT *>::iterator it = m_map_pkStmt.find(p->stQuery);
+
+	if (it != m_map_pkStmt.end())
+		return it->second;
+
+	MYSQL_STMT * pkStmt = mysql_stmt_init(&m_hDB);
+
+	if (!pkStmt)
+	{
+		p->uiSQLErrno = mysql_errno(&m_hDB);
+		m_stError = mysql_error(&m_hDB);
+		return NULL;
+	}
+
+	if (mysql_stmt_prepare(pkStmt, p->stQuery.c_str(), p->stQuery.length()))
+	{
+		p->uiSQLErrno = mysql_stmt_errno(pkStmt);
+		m_stError = mysql_stmt_error(pkStmt);
+		mysql_stmt_close(pkStmt);
+		return NULL;
+	}
+
+	m_map_pkStmt.insert(std::make_pair(p->stQuery, pkStmt));
+	return pkStmt;
+}
+
+bool CAsyncSQL::ExecuteStmt(SQLMsg * p)
+{
+	MYSQL_STMT * pkStmt = GetStmt(p);
+
+	if (!pkStmt)
+		return false;
+
+	size_t count = p->vec_stmtParam.size();
+
+	if (mysql_stmt_param_count(pkStmt) != count)
+	{
+		p->uiSQLErrno = CR_INVALID_PARAMETER_NO;
+		m_stError = "parameter count mismatch";
+		return false;
+	}
+
+	std::vector<MYSQL_BIND> vec_bind(count);
+	std::vector<unsigned long> vec_length(count);
+
+	if (count)
+		memset(&vec_bind[0], 0, sizeof(MYSQL_BIND) * count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		SQLStmtParam & r = p->vec_stmtParam[i];
+		MYSQL_BIND & bind = vec_bind[i];
+
+		bind.buffer_type = r.type;
+
+		if (r.type == MYSQL_TYPE_LONGLONG)
+		{
+			bind.buffer = &r.llValue;
+			bind.is_unsigned = r.bUnsigned;
+		}
+		else
+		{
+			vec_length[i] = r.stData.length();
+
+			bind.buffer = (void *) r.stData.data();
+			bind.buffer_length = vec_length[i];
+			bind.length = &vec_length[i];
+		}
+	}
+
+	if ((count && mysql_stmt_bind_param(pkStmt, &vec_bind[0])) || mysql_stmt_execute(pkStmt))
+	{
+		p->uiSQLErrno = mysql_stmt_errno(pkStmt);
+		m_stError = mysql_stmt_error(pkStmt);
+
+		//    ȿ Ǿ  Ƿ  ٽ prepare Ѵ.
+		CloseStmt(p->stQuery);
+		return false;
+	}
+
+	p->uiStmtAffectedRows = mysql_stmt_affected_rows(pkStmt);
+	p->uiStmtInsertID = mysql_stmt_insert_id(pkStmt);
+
+	mysql_stmt_free_result(pkStmt);
+	return true;
+}
+
+void CAsyncSQL::CloseStmt(const std::string & c_rstQuery)
+{
+	std::map<std::string, MYSQL_STMT *>::iterator it = m_map_pkStmt.find(c_rstQuery);
+
+	if (it == m_map_pkStmt.end())
+		return;
+
+	mysql_stmt_close(it->second);
+	m_map_pkStmt.erase(it);
+}
+
+void CAsyncSQL::ClearStmt()
+{
+	std::map<std::string, MYSQL_STMT *>::iterator it = m_map_pkStmt.begin();
+
+	while (it != m_map_pkStmt.end())
+		mysql_stmt_close((it++)->second);
+
+	m_map_pkStmt.clear();
+}
+
 DWORD CAsyncSQL::CountQuery()
 {
 	return m_queue_query.size();
@@ -552,19 +778,25 @@ void CAsyncSQL::ChildLoop()
 			if (!PeekQueryFromCopyQueue(&p))
 				continue;
 
+			if (PassFence(p))
+			{
+				PopQueryFromCopyQueue();
+				delete p;
+				continue;
+			}
+
 			if (m_ulThreadID != mysql_thread_id(&m_hDB))
 			{
 				sys_err("MySQL connection was reconnected. querying locale set");
 				while (!QueryLocaleSet());
 				m_ulThreadID = mysql_thread_id(&m_hDB);
+				ClearStmt();
 			}
 
-			if (mysql_real_query(&m_hDB, p->stQuery.c_str(), p->stQuery.length()))
+			if (!Execute(p))
 			{
-				p->uiSQLErrno = mysql_errno(&m_hDB);
-
 				sys_err("AsyncSQL: query failed: %s (query: %s errno: %d)", 
-						mysql_error(&m_hDB), p->stQuery.c_str(), p->uiSQLErrno);
+						m_stError.c_str(), p->stQuery.c_str(), p->uiSQLErrno);
 
 				switch (p->uiSQLErrno)
 				{
@@ -614,19 +846,25 @@ void CAsyncSQL::ChildLoop()
 
 	while (PeekQuery(&p))
 	{
+		if (PassFence(p))
+		{
+			PopQuery(p->iID);
+			delete p;
+			continue;
+		}
+
 		if (m_ulThreadID != mysql_thread_id(&m_hDB))
 		{
 			sys_err("MySQL connection was reconnected. querying locale set");
 			while (!QueryLocaleSet());
 			m_ulThreadID = mysql_thread_id(&m_hDB);
+			ClearStmt();
 		}
 
-		if (mysql_real_query(&m_hDB, p->stQuery.c_str(), p->stQuery.length()))
+		if (!Execute(p))
 		{
-			p->uiSQLErrno = mysql_errno(&m_hDB);
-
 			sys_err("AsyncSQL::ChildLoop : mysql_query error: %s:\nquery: %s",
-					mysql_error(&m_hDB), p->stQuery.c_str());
+					m_stError.c_str(), p->stQuery.c_str());
 
 			switch (p->uiSQLErrno)
 			{
@@ -708,9 +946,240 @@ size_t CAsyncSQL::EscapeString(char* dst, size_t dstSize, const char *src, size_
 	return mysql_real_escape_string(GetSQLHandle(), dst, src, srcSize);
 }
 
+void CStmtQuery::BindSigned(long long llValue)
+{
+	SQLStmtParam param;
+
+	param.type = MYSQL_TYPE_LONGLONG;
+	param.bUnsigned = false;
+	param.llValue = llValue;
+
+	m_vec_param.push_back(param);
+}
+
+void CStmtQuery::BindUnsigned(unsigned long long ullValue)
+{
+	SQLStmtParam param;
+
+	param.type = MYSQL_TYPE_LONGLONG;
+	param.bUnsigned = true;
+	param.llValue = (long long) ullValue;
+
+	m_vec_param.push_back(param);
+}
+
+void CStmtQuery::BindString(const char * c_pszValue)
+{
+	SQLStmtParam param;
+
+	param.type = MYSQL_TYPE_STRING;
+	param.bUnsigned = false;
+	param.llValue = 0;
+	param.stData = c_pszValue ? c_pszValue : "";
+
+	m_vec_param.push_back(param);
+}
+
+void CStmtQuery::BindBlob(const void * c_pvData, size_t size)
+{
+	SQLStmtParam param;
+
+	param.type = MYSQL_TYPE_BLOB;
+	param.bUnsigned = false;
+	param.llValue = 0;
+	param.stData.assign((const char *) c_pvData, size);
+
+	m_vec_param.push_back(param);
+}
+
 void CAsyncSQL2::SetLocale(const std::string & stLocale)
 {
 	m_stLocale = stLocale;
 	QueryLocaleSet();
 }
 
+CAsyncSQLPool::CAsyncSQLPool() : m_uiNextSQL(0), m_uiNextResult(0)
+{
+}
+
+CAsyncSQLPool::~CAsyncSQLPool()
+{
+	Quit();
+	Destroy();
+}
+
+void CAsyncSQLPool::Destroy()
+{
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		delete m_vec_pkSQL[i];
+
+	m_vec_pkSQL.clear();
+}
+
+bool CAsyncSQLPool::Setup(const char * c_pszHost, const char * c_pszUser, const char * c_pszPassword, const char * c_pszDB, const char * c_pszLocale, int iPoolSize, int iPort)
+{
+	if (iPoolSize < 1)
+		iPoolSize = 1;
+
+	for (int i = 0; i < iPoolSize; ++i)
+	{
+		CAsyncSQL2 * pkSQL = new CAsyncSQL2;
+
+		if (!pkSQL->Setup(c_pszHost, c_pszUser, c_pszPassword, c_pszDB, c_pszLocale, false, iPort))
+		{
+			delete pkSQL;
+			Quit();
+			Destroy();
+			return false;
+		}
+
+		m_vec_pkSQL.push_back(pkSQL);
+	}
+
+	if (iPoolSize > 1)
+		sys_log(0, "AsyncSQLPool: %d connections to %s", iPoolSize, c_pszHost);
+
+	return true;
+}
+
+void CAsyncSQLPool::Quit()
+{
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		m_vec_pkSQL[i]->Quit();
+}
+
+CAsyncSQL2 * CAsyncSQLPool::Select(DWORD dwKey)
+{
+	if (m_vec_pkSQL.size() == 1)
+		return m_vec_pkSQL[0];
+
+	if (dwKey)
+		return m_vec_pkSQL[dwKey % m_vec_pkSQL.size()];
+
+	if (++m_uiNextSQL >= m_vec_pkSQL.size())
+		m_uiNextSQL = 0;
+
+	return m_vec_pkSQL[m_uiNextSQL];
+}
+
+// ٸ Ḷ Ÿ ְ    Ÿ   ڿ  Ǹ Ѵ.
+// ִ    ϳ̶      Ƿ  ٸ  ʴ´.
+CAsyncSQL2 * CAsyncSQLPool::SelectAfterAll(DWORD dwKey)
+{
+	CAsyncSQL2 * pkSQL = Select(dwKey);
+
+	if (m_vec_pkSQL.size() == 1)
+		return pkSQL;
+
+	SQLFence * pkFence = new SQLFence(m_vec_pkSQL.size() - 1);
+
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		if (m_vec_pkSQL[i] != pkSQL)
+			m_vec_pkSQL[i]->PushFence(pkFence, true);
+
+	pkSQL->PushFence(pkFence, false);
+	return pkSQL;
+}
+
+void CAsyncSQLPool::AsyncQuery(const char * c_pszQuery, DWORD dwKey)
+{
+	Select(dwKey)->AsyncQuery(c_pszQuery);
+}
+
+void CAsyncSQLPool::ReturnQuery(const char * c_pszQuery, void * pvUserData, DWORD dwKey, bool bAfterAll)
+{
+	(bAfterAll ? SelectAfterAll(dwKey) : Select(dwKey))->ReturnQuery(c_pszQuery, pvUserData);
+}
+
+void CAsyncSQLPool::AsyncStmt(const CStmtQuery & c_rkQuery, DWORD dwKey)
+{
+	Select(dwKey)->AsyncStmt(c_rkQuery);
+}
+
+void CAsyncSQLPool::ReturnStmt(const CStmtQuery & c_rkQuery, void * pvUserData, DWORD dwKey)
+{
+	Select(dwKey)->ReturnStmt(c_rkQuery, pvUserData);
+}
+
+bool CAsyncSQLPool::PopResult(SQLMsg ** pp)
+{
+	size_t size = m_vec_pkSQL.size();
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		unsigned int uiIndex = m_uiNextResult;
+
+		if (++m_uiNextResult >= size)
+			m_uiNextResult = 0;
+
+		if (m_vec_pkSQL[uiIndex]->PopResult(pp))
+			return true;
+	}
+
+	return false;
+}
+
+DWORD CAsyncSQLPool::CountQuery()
+{
+	DWORD dwCount = 0;
+
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		dwCount += m_vec_pkSQL[i]->CountQuery();
+
+	return dwCount;
+}
+
+DWORD CAsyncSQLPool::CountResult()
+{
+	DWORD dwCount = 0;
+
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		dwCount += m_vec_pkSQL[i]->CountResult();
+
+	return dwCount;
+}
+
+int CAsyncSQLPool::CountQueryFinished()
+{
+	int iCount = 0;
+
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		iCount += m_vec_pkSQL[i]->CountQueryFinished();
+
+	return iCount;
+}
+
+void CAsyncSQLPool::ResetQueryFinished()
+{
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		m_vec_pkSQL[i]->ResetQueryFinished();
+}
+
+int CAsyncSQLPool::GetCopiedQueryCount()
+{
+	int iCount = 0;
+
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		iCount += m_vec_pkSQL[i]->GetCopiedQueryCount();
+
+	return iCount;
+}
+
+void CAsyncSQLPool::ResetCopiedQueryCount()
+{
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		m_vec_pkSQL[i]->ResetCopiedQueryCount();
+}
+
+void CAsyncSQLPool::SetLocale(const std::string & stLocale)
+{
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		m_vec_pkSQL[i]->SetLocale(stLocale);
+}
+
+void CAsyncSQLPool::QueryLocaleSet()
+{
+	for (size_t i = 0; i < m_vec_pkSQL.size(); ++i)
+		m_vec_pkSQL[i]->QueryLocaleSet();
+}
+
@@ -38,9 +38,31 @@ typedef struct _SQLResult
 	uint32_t		uiInsertID;
 } SQLResult;
 
+// prepared statement Ķ ϳ.  ؼ  ִ´.
+typedef struct _SQLStmtParam
+{
+	enum_field_types	type;
+	bool			bUnsigned;
+	long long		llValue;	// MYSQL_TYPE_LONGLONG
+	std::string		stData;		// MYSQL_TYPE_STRING, MYSQL_TYPE_BLOB
+} SQLStmtParam;
+
+// CAsyncSQLPool::ReturnQuery(..., bAfterAll)   ῡ  ִ Ÿ.
+// ٸ  Ÿ  Release ϰ, ٸ  iWait  Wait   .
+typedef struct _SQLFence
+{
+	_SQLFence(int iCount) : iWait(iCount)
+	{
+	}
+
+	CSemaphore	sem;
+	int			iWait;
+} SQLFence;
+
 typedef struct _SQLMsg
 {
-	_SQLMsg() : m_pkSQL(NULL), iID(0), uiResultPos(0), pvUserData(NULL), bReturn(false), uiSQLErrno(0)
+	_SQLMsg() : m_pkSQL(NULL), iID(0), uiResultPos(0), pvUserData(NULL), bReturn(false), uiSQLErrno(0),
+		bStmt(false), uiStmtAffectedRows(0), uiStmtInsertID(0), pkFence(NULL), bFenceMark(false)
 	{
 	}
 
@@ -57,6 +79,18 @@ typedef struct _SQLMsg
 
 	void Store()
 	{
+		// prepared statement     ʰ    insert id  .
+		if (bStmt)
+		{
+			SQLResult * pRes = new SQLResult;
+
+			pRes->uiInsertID = uiStmtInsertID;
+			pRes->uiAffectedRows = uiStmtAffectedRows;
+
+			vec_pkResult.push_back(pRes);
+			return;
+		}
+
 		do
 		{
 			SQLResult * pRes = new SQLResult;
@@ -106,8 +140,37 @@ typedef struct _SQLMsg
 	bool			bReturn;
 
 	unsigned int		uiSQLErrno;
+
+	bool			bStmt;		// stQuery  prepared statement  Ѵ.
+	std::vector<SQLStmtParam>	vec_stmtParam;
+	uint32_t		uiStmtAffectedRows;
+	uint32_t		uiStmtInsertID;
+
+	SQLFence *		pkFence;	//   Ÿ  ޽
+	bool			bFenceMark;	// true  Release ϴ , false  ٸ 
 } SQLMsg;
 
+// AsyncStmt/ReturnStmt   prepared statement.  '?'  Bind Ѵ.
+//   Ḷ ѹ prepare صΰ ٽ .     .
+class CStmtQuery
+{
+	public:
+		CStmtQuery(const char * c_pszQuery = "") : m_stQuery(c_pszQuery) {}
+
+		void		SetQuery(const char * c_pszQuery)	{ m_stQuery = c_pszQuery; m_vec_param.clear(); }
+		const std::string &	GetQuery() const	{ return m_stQuery; }
+		const std::vector<SQLStmtParam> &	GetParams() const	{ return m_vec_param; }
+
+		void		BindSigned(long long llValue);
+		void		BindUnsigned(unsigned long long ullValue);
+		void		BindString(const char * c_pszValue);
+		void		BindBlob(const void * c_pvData, size_t size);
+
+	protected:
+		std::string			m_stQuery;
+		std::vector<SQLStmtParam>	m_vec_param;
+};
+
 class CAsyncSQL
 {
 	public:
@@ -128,6 +191,29 @@ class CAsyncSQL
 		void		ReturnQuery(const char * c_pszQuery, void * pvUserData);
 		SQLMsg *	DirectQuery(const char * c_pszQuery);
 
+		//  ° ޾  ʰ mysql_use_result   ྿ fn(row) ѱ.
+		// fn  false  ָ   . fn ȿ   ٸ  ϸ  ȴ.
+		template <typename F> bool DirectQueryEach(const char * c_pszQuery, F & fn)
+		{
+			MYSQL_RES * pRes = DirectUseResult(c_pszQuery);
+
+			if (!pRes)
+				return false;
+
+			MYSQL_ROW row;
+
+			while ((row = mysql_fetch_row(pRes)))
+				if (!fn(row))
+					break;
+
+			return EndUseResult(pRes, c_pszQuery);
+		}
+
+		void		AsyncStmt(const CStmtQuery & c_rkQuery);
+		void		ReturnStmt(const CStmtQuery & c_rkQuery, void * pvUserData);
+
+		void		PushFence(SQLFence * pkFence, bool bMark);
+
 		DWORD		CountQuery();
 		DWORD		CountResult();
 
@@ -146,6 +232,9 @@ class CAsyncSQL
 	protected:
 		void		Destroy();
 
+		MYSQL_RES *	DirectUseResult(const char * c_pszQuery);
+		bool		EndUseResult(MYSQL_RES * pRes, const char * c_pszQuery);
+
 		void		PushQuery(SQLMsg * p);
 
 		bool		PeekQuery(SQLMsg ** pp);
@@ -155,6 +244,16 @@ class CAsyncSQL
 		INT			CopyQuery();
 		bool		PopQueryFromCopyQueue();
 
+		// Ÿ ޽   true. ٸ ̸ ٸ    ڿ ƿ´.
+		bool		PassFence(SQLMsg * p);
+
+		// ChildLoop 忡 θ. ϸ p->uiSQLErrno  m_stError  ä.
+		bool		Execute(SQLMsg * p);
+		bool		ExecuteStmt(SQLMsg * p);
+		MYSQL_STMT *	GetStmt(SQLMsg * p);
+		void		CloseStmt(const std::string & c_rstQuery);
+		void		ClearStmt();
+
 	public:
 		int			GetCopiedQueryCount();
 		void		ResetCopiedQueryCount();
@@ -196,6 +295,9 @@ class CAsyncSQL
 
 		int	m_iQueryFinished;
 
+		std::map<std::string, MYSQL_STMT *>	m_map_pkStmt;	// prepare ص .  ῡ   ִ.
+		std::string	m_stError;
+
 		unsigned long m_ulThreadID;
 		bool m_bConnected;
 		int	m_iCopiedQuery;
@@ -207,4 +309,49 @@ class CAsyncSQL2 : public CAsyncSQL
 		void SetLocale ( const std::string & stLocale );
 };
 
+//    /带  ΰ   Ѵ.
+// dwKey    ׻   Ƿ   ǰ,    ´.
+// dwKey  0 ̸   ʰ ư . ũⰡ 1 ̸ CAsyncSQL ϳ .
+class CAsyncSQLPool
+{
+	public:
+		CAsyncSQLPool();
+		virtual ~CAsyncSQLPool();
+
+		bool		Setup(const char * c_pszHost, const char * c_pszUser, const char * c_pszPassword, const char * c_pszDB, const char * c_pszLocale,
+			int iPoolSize = 1, int iPort = 0);
+		void		Quit();
+
+		void		AsyncQuery(const char * c_pszQuery, DWORD dwKey = 0);
+		// bAfterAll ̸ ݱ  ῡ  ǰ  ڿ ȴ.
+		void		ReturnQuery(const char * c_pszQuery, void * pvUserData, DWORD dwKey = 0, bool bAfterAll = false);
+		void		AsyncStmt(const CStmtQuery & c_rkQuery, DWORD dwKey = 0);
+		void		ReturnStmt(const CStmtQuery & c_rkQuery, void * pvUserData, DWORD dwKey = 0);
+
+		//    ư .   ȿ   ״δ.
+		bool		PopResult(SQLMsg ** pp);
+
+		DWORD		CountQuery();
+		DWORD		CountResult();
+		int			CountQueryFinished();
+		void		ResetQueryFinished();
+		int			GetCopiedQueryCount();
+		void		ResetCopiedQueryCount();
+
+		void		SetLocale(const std::string & stLocale);
+		void		QueryLocaleSet();
+
+		int			GetPoolSize() const { return m_vec_pkSQL.size(); }
+
+	protected:
+		void		Destroy();
+		CAsyncSQL2 *	Select(DWORD dwKey);
+		CAsyncSQL2 *	SelectAfterAll(DWORD dwKey);
+
+	protected:
+		std::vector<CAsyncSQL2 *>	m_vec_pkSQL;
+		unsigned int			m_uiNextSQL;	// dwKey  0     
+		unsigned int			m_uiNextResult;	// PopResult    
+};
+
 #endif
@@ -54,4 +54,9 @@
     extern void		buffer_write_proceed(LPBUFFER buffer, int length);		// length  Ų.
 
     extern void		buffer_adjust_size(LPBUFFER & buffer, int add_size);		// add_sizeŭ ߰ ũ⸦ Ȯ
+    extern void		buffer_compact(LPBUFFER buffer);				//  ͸   .
+
+    extern int		buffer_pool_trim();						// returns number of buffers freed
+    extern void		buffer_pool_dump();
+    extern void		buffer_pool_get_bytes(size_t * used, size_t * pooled);	//   Ʈ, pool  ܵ Ʈ
 #endif
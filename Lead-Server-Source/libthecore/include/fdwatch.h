@@ -1,7 +1,48 @@
 #ifndef __INC_LIBTHECORE_FDWATCH_H__
 #define __INC_LIBTHECORE_FDWATCH_H__
 
-#ifndef __WIN32__
+#if defined(__USE_EPOLL__)
+
+    typedef struct fdwatch	FDWATCH;
+    typedef struct fdwatch *	LPFDWATCH;
+
+    enum EFdwatch
+    {
+	FDW_NONE		= 0,
+	FDW_READ		= 1,
+	FDW_WRITE		= 2,
+	FDW_WRITE_ONESHOT	= 4,
+	FDW_EOF			= 8,
+    };
+
+    typedef struct epoll_event	EPOLLEVENT;
+    typedef struct epoll_event *	LPEPOLLEVENT;
+
+    // epoll reports read and write readiness of a descriptor in a single event.
+    // fdwatch() splits them into one entry per direction so that an event index
+    // keeps meaning "one filter of one descriptor", exactly like kqueue.
+    typedef struct fdwatch_revent
+    {
+	socket_t	fd;
+	int		event;	// FDW_READ, FDW_WRITE or FDW_EOF
+    } FDWATCH_REVENT, * LPFDWATCH_REVENT;
+
+    struct fdwatch
+    {
+	int		epfd;
+
+	int		nfiles;
+
+	LPEPOLLEVENT	epevents;
+
+	LPFDWATCH_REVENT	revents;
+	int		nrevents;
+
+	void **		fd_data;
+	int *		fd_rw;
+    };
+
+#elif !defined(__WIN32__)
 
     typedef struct fdwatch	FDWATCH;
     typedef struct fdwatch *	LPFDWATCH;
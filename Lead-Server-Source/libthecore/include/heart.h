@@ -5,10 +5,12 @@ typedef struct heart	HEART;
 typedef struct heart *	LPHEART;
 
 typedef void (*HEARTFUNC) (LPHEART heart, int pulse);
+typedef void (*HEARTWAITFUNC) (struct timeval * timeout);	//  ð ȿ ƿ; Ѵ.  ƿ ٽ θ.
 
 struct heart
 {
     HEARTFUNC		func;
+    HEARTWAITFUNC	wait;	//   pulse  ܴ
 
     struct timeval	before_sleep;
     struct timeval	opt_time;
@@ -20,6 +22,7 @@ struct heart
 
 extern LPHEART	heart_new(int opt_usec, HEARTFUNC func);
 extern void	heart_delete(LPHEART ht);
+extern void	heart_set_wait(LPHEART ht, HEARTWAITFUNC func);
 extern int	heart_idle(LPHEART ht);	//  pulse  Ѵ.
 extern void	heart_beat(LPHEART ht, int pulses);
 
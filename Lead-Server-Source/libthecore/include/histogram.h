@@ -0,0 +1,46 @@
+#ifndef __INC_LIBTHECORE_HISTOGRAM_H__
+#define __INC_LIBTHECORE_HISTOGRAM_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+	// HDR   ð ׷.
+	// 32 ̸  ϳ ĭ ϳ̰,  δ 2  ŵ  16 ĭ .
+	//   ̵  1/16 (6.25%) ̳̰ ĭ  ̴.
+	enum
+	{
+		HISTOGRAM_LINEAR_COUNT		= 32,
+		HISTOGRAM_SUB_BUCKET_BITS	= 4,
+		HISTOGRAM_SUB_BUCKET_COUNT	= (1 << HISTOGRAM_SUB_BUCKET_BITS),
+		HISTOGRAM_BUCKET_COUNT		= HISTOGRAM_LINEAR_COUNT + 27 * HISTOGRAM_SUB_BUCKET_COUNT,
+	};
+
+	typedef struct histogram_s
+	{
+		unsigned int	counts[HISTOGRAM_BUCKET_COUNT];
+		unsigned int	total_count;
+		unsigned int	min_value;
+		unsigned int	max_value;
+		double		sum;
+	} HISTOGRAM;
+
+	typedef HISTOGRAM * LPHISTOGRAM;
+
+	extern void		histogram_reset(LPHISTOGRAM h);
+	extern void		histogram_record(LPHISTOGRAM h, unsigned int value);
+	extern void		histogram_merge(LPHISTOGRAM dst, const HISTOGRAM * src);
+
+	// percentile  0 ~ 100. ش ĭ  踦 ֵ max   ʴ´.
+	extern unsigned int	histogram_percentile(const HISTOGRAM * h, double percentile);
+	extern unsigned int	histogram_mean(const HISTOGRAM * h);
+
+	// value   ĭ   (Prometheus le )
+	extern unsigned int	histogram_count_le(const HISTOGRAM * h, unsigned int value);
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+#endif	// __INC_LIBTHECORE_HISTOGRAM_H__
@@ -17,6 +17,18 @@ extern "C"
 	extern void log_set_expiration_days(unsigned int days);
 	extern int log_get_expiration_days(void);
 
+	// 񵿱 α: ť ũ(ڵ ) 0  ƴϸ log_init   带 .
+	// ť  á  (DROP) ڸ   ٸ(BLOCK) Ѵ.
+	enum
+	{
+		LOG_ASYNC_OVERFLOW_DROP,
+		LOG_ASYNC_OVERFLOW_BLOCK,
+	};
+
+	extern void log_set_async_queue_size(unsigned int records);
+	extern void log_set_async_overflow(int policy);
+	extern unsigned int log_get_dropped_count(void);
+
 #ifndef __WIN32__
     extern void _sys_err(const char *func, int line, const char *format, ...);
 #else
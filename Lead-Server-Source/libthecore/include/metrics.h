@@ -0,0 +1,45 @@
+#ifndef __INC_LIBTHECORE_METRICS_H__
+#define __INC_LIBTHECORE_METRICS_H__
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+	// ġ Ϻ. ī, , ׷ ̸  θ
+	// metrics_update()  Ҹ  Prometheus ؽƮ   ΰ,
+	//  Ʈ  û  尡   ش.
+	// ϰ metrics_update   忡 Ѵ.
+	//
+	// ̸    ִ. ) "game_sql_queue{db=\"player\"}"
+	//  ̸( ձ) ̾ ؾ HELP/TYPE    .
+	enum
+	{
+		METRIC_COUNTER,
+		METRIC_GAUGE,
+		METRIC_HISTOGRAM,
+	};
+
+	typedef double (*METRIC_FUNC)(void);
+	typedef struct metric_s METRIC;
+	typedef METRIC * LPMETRIC;
+
+	extern LPMETRIC	metrics_counter(const char * name, const char * help);
+	extern LPMETRIC	metrics_gauge(const char * name, const char * help);
+	extern LPMETRIC	metrics_func(int type, const char * name, const char * help, METRIC_FUNC func);	//  update  func  д´
+	extern LPMETRIC	metrics_histogram(const char * name, const char * help, const HISTOGRAM * h);	//  us, ̾ Ѵ
+
+	extern void	metrics_add(LPMETRIC m, double value);
+	extern void	metrics_set(LPMETRIC m, double value);
+
+	//  Ʈ. allow  ϳ  127.0.0.1  ޴´.
+	extern void	metrics_allow_ip(const char * ip);
+	extern int	metrics_listen(const char * ip, int port);
+	extern void	metrics_update(void);
+	extern void	metrics_destroy(void);
+
+#ifdef __cplusplus
+}
+#endif	// __cplusplus
+
+#endif	// __INC_LIBTHECORE_METRICS_H__
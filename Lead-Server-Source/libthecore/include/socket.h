@@ -20,13 +20,19 @@ typedef int socklen_t;
 
     extern int		socket_read(socket_t desc, char* read_point, size_t space_left);
     extern int		socket_write(socket_t desc, const char *data, size_t length);
+    extern int		socket_write_tcp(socket_t desc, const char *txt, int length);	// one send, returns bytes written, 0 if it would block, -1 on error
 
     extern int		socket_tcp_bind(const char * ip, int port);
+    extern int		socket_tcp_bind_ex(const char * ip, int port, int backlog, int reuse_port);	// backlog 0 is SOMAXCONN
 
     extern socket_t	socket_accept(socket_t s, struct sockaddr_in *peer);
     extern void		socket_close(socket_t s);
     extern socket_t	socket_connect(const char* host, WORD port);
 
+    extern int		socket_resolve(const char * host, WORD port, struct sockaddr_in * addr);	// 1 on success
+    extern socket_t	socket_connect_async(const struct sockaddr_in * addr);	// non-blocking, INVALID_SOCKET on immediate failure
+    extern int		socket_connect_check(socket_t s);	// 1 connected, 0 still connecting, -1 failed
+
     extern void		socket_nonblock(socket_t s);
     extern void		socket_block(socket_t s);
     extern void		socket_dontroute(socket_t s);
@@ -72,7 +72,12 @@ inline double rint(double x)
 #else
 
 #ifndef __FreeBSD__
+#if defined(__linux__)
+// Build with -D__USE_EPOLL_ET__ to register descriptors edge-triggered.
+#define __USE_EPOLL__
+#else
 #define __USE_SELECT__
+#endif
 #ifdef __CYGWIN__
 #define _POSIX_SOURCE 1
 #endif
@@ -116,6 +121,12 @@ struct timespec
 #include <sys/event.h>
 #endif
 
+#ifdef __USE_EPOLL__
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <linux/sockios.h>
+#endif
+
 #endif
 
 #ifndef false
@@ -141,5 +152,7 @@ struct timespec
 #include "utils.h"
 #include "crypt.h"
 #include "memcpy.h"
+#include "histogram.h"
+#include "metrics.h"
 
 #endif // __INC_LIBTHECORE_STDAFX_H__
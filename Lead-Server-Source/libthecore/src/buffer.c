@@ -9,6 +9,13 @@
 
 static LPBUFFER normalized_buffer_pool[32] = { NULL, };
 
+// size class   . peak  buffer_pool_trim  ִ 뷮.
+static int buffer_pool_used[32] = { 0, };
+static int buffer_pool_free_count[32] = { 0, };
+static int buffer_pool_peak[32] = { 0, };
+// pool ũ⸦ Ѿ ٷ Ҵ buffer  Ʈ
+static size_t buffer_unpooled_bytes = 0;
+
 #define DEFAULT_POOL_SIZE 8192
 
 // internal function forward
@@ -47,6 +54,7 @@ static void buffer_pool_free ()
 				free(p);
 			}
 			normalized_buffer_pool[i] = NULL;
+			buffer_pool_free_count[i] = 0;
 		}
 	}
 }
@@ -62,6 +70,7 @@ static bool buffer_larger_pool_free (int n)
 			free(buffer->mem_data);
 			free(buffer);
 			normalized_buffer_pool[i] = next;
+			--buffer_pool_free_count[i];
 			return true;
 		}
 	}
@@ -95,13 +104,20 @@ LPBUFFER buffer_new(int size)
 		if (*buffer_pool) {
 			buffer = *buffer_pool;
 			*buffer_pool = buffer->next;
+			--buffer_pool_free_count[pool_index];
 		}
+
+		if (++buffer_pool_used[pool_index] > buffer_pool_peak[pool_index])
+			buffer_pool_peak[pool_index] = buffer_pool_used[pool_index];
 	}
 
 	if (buffer == NULL) 
 	{
 		CREATE(buffer, BUFFER, 1);
 		buffer->mem_size = size;
+
+		if (pool_index < 0)
+			buffer_unpooled_bytes += size;
 		// buffer_new calloc failed  ߻Ͽ(Ű  ӽſ ַ ߻),
 		// calloc ϸ, buffer pool  ٽ õѴ.
 		if (!safe_create(&buffer->mem_data, size))
@@ -137,13 +153,73 @@ void buffer_delete(LPBUFFER buffer)
 		BUFFER** buffer_pool = normalized_buffer_pool + pool_index;
 		buffer->next = *buffer_pool;
 		*buffer_pool = buffer;
+		--buffer_pool_used[pool_index];
+		++buffer_pool_free_count[pool_index];
 	}
 	else {
+		buffer_unpooled_bytes -= size;
 		free(buffer->mem_data);
 		free(buffer);
 	}
 }
 
+void buffer_pool_get_bytes(size_t * used, size_t * pooled)
+{
+	*used = buffer_unpooled_bytes;
+	*pooled = 0;
+
+	for (int i = 0; i < 32; ++i)
+	{
+		*used += (size_t) buffer_pool_used[i] << i;
+		*pooled += (size_t) buffer_pool_free_count[i] << i;
+	}
+}
+
+//  trim  ִ 뷮 Ѵ  buffer Ѵ.
+//  ְ   ֱ ҷ ָ pool Ѿ Ŀ ʴ´.
+int buffer_pool_trim()
+{
+	int count = 0;
+	int bytes = 0;
+
+	for (int i = 0; i < 32; ++i)
+	{
+		int keep = buffer_pool_peak[i] - buffer_pool_used[i];
+
+		while (buffer_pool_free_count[i] > keep && normalized_buffer_pool[i])
+		{
+			LPBUFFER buffer = normalized_buffer_pool[i];
+			normalized_buffer_pool[i] = buffer->next;
+			--buffer_pool_free_count[i];
+
+			bytes += buffer->mem_size;
+			++count;
+
+			free(buffer->mem_data);
+			free(buffer);
+		}
+
+		buffer_pool_peak[i] = buffer_pool_used[i];
+	}
+
+	if (count)
+		sys_log(0, "BUFFER_POOL: trimmed %d buffers (%d bytes)", count, bytes);
+
+	return count;
+}
+
+void buffer_pool_dump()
+{
+	for (int i = 0; i < 32; ++i)
+	{
+		if (!buffer_pool_used[i] && !buffer_pool_free_count[i])
+			continue;
+
+		sys_log(0, "BUFFER_POOL: size %8d used %5d free %5d peak %5d",
+				1 << i, buffer_pool_used[i], buffer_pool_free_count[i], buffer_pool_peak[i]);
+	}
+}
+
 DWORD buffer_size(LPBUFFER buffer)
 {
 	return (buffer->length);
@@ -258,6 +334,19 @@ void buffer_adjust_size(LPBUFFER& buffer, int add_size)
 	buffer_realloc(buffer, buffer->mem_size + add_size);
 }
 
+void buffer_compact(LPBUFFER buffer)
+{
+	if (buffer->read_point == buffer->mem_data)
+		return;
+
+	if (buffer->length > 0)
+		memmove(buffer->mem_data, buffer->read_point, buffer->length);
+
+	buffer->read_point = buffer->mem_data;
+	buffer->write_point = buffer->mem_data + buffer->length;
+	buffer->write_point_pos = buffer->length;
+}
+
 void buffer_realloc(LPBUFFER& buffer, int length)
 {
 	int	i, read_point_pos;
@@ -1,7 +1,277 @@
 #define __LIBTHECORE__
 #include "stdafx.h"
 
-#ifndef __USE_SELECT__
+#if defined(__USE_EPOLL__)
+
+// Level-triggered by default. Edge-triggered mode only reports a descriptor
+// again once new data arrives, so every reader must drain its socket until
+// EAGAIN when built with __USE_EPOLL_ET__.
+#ifdef __USE_EPOLL_ET__
+#define FDWATCH_EPOLL_TRIGGER	EPOLLET
+#else
+#define FDWATCH_EPOLL_TRIGGER	0
+#endif
+
+LPFDWATCH fdwatch_new(int nfiles)
+{
+    LPFDWATCH fdw;
+    int epfd;
+
+    epfd = epoll_create(nfiles);
+
+    if (epfd == -1)
+    {
+	sys_err("%s", strerror(errno));
+	return NULL;
+    }
+
+    CREATE(fdw, FDWATCH, 1);
+
+    fdw->epfd = epfd;
+    fdw->nfiles = nfiles;
+    fdw->nrevents = 0;
+
+    CREATE(fdw->epevents, EPOLLEVENT, nfiles);
+    CREATE(fdw->revents, FDWATCH_REVENT, nfiles * 2);
+    CREATE(fdw->fd_rw, int, nfiles);
+    CREATE(fdw->fd_data, void*, nfiles);
+
+    return (fdw);
+}
+
+void fdwatch_delete(LPFDWATCH fdw)
+{
+    close(fdw->epfd);
+
+    free(fdw->fd_data);
+    free(fdw->fd_rw);
+    free(fdw->epevents);
+    free(fdw->revents);
+    free(fdw);
+}
+
+// Bring the kernel interest set of fd in line with fdw->fd_rw[fd].
+static void fdwatch_register(LPFDWATCH fdw, socket_t fd, int old_rw)
+{
+    struct epoll_event ev;
+    int rw = fdw->fd_rw[fd] & (FDW_READ | FDW_WRITE);
+    int op;
+
+    old_rw &= (FDW_READ | FDW_WRITE);
+
+    if (rw == old_rw)
+	return;
+
+    if (!old_rw)
+	op = EPOLL_CTL_ADD;
+    else if (!rw)
+	op = EPOLL_CTL_DEL;
+    else
+	op = EPOLL_CTL_MOD;
+
+    memset(&ev, 0, sizeof(ev));
+    ev.data.fd = fd;
+    ev.events = FDWATCH_EPOLL_TRIGGER;
+
+    if (rw & FDW_READ)
+	ev.events |= EPOLLIN;
+
+    if (rw & FDW_WRITE)
+	ev.events |= EPOLLOUT;
+
+    if (epoll_ctl(fdw->epfd, op, fd, &ev) == -1)
+	sys_err("epoll_ctl: op %d fd %d: %s", op, fd, strerror(errno));
+}
+
+int fdwatch(LPFDWATCH fdw, struct timeval *timeout)
+{
+    int i, r, msec;
+
+    if (!timeout)
+	msec = 0;
+    else
+	msec = timeout->tv_sec * 1000 + (timeout->tv_usec + 999) / 1000;	// 1ms    0  ߷ 굹 ʰ ø
+
+    r = epoll_wait(fdw->epfd, fdw->epevents, fdw->nfiles, msec);
+
+    fdw->nrevents = 0;
+
+    if (r == -1)
+    {
+	if (errno == EINTR)
+	    return 0;
+
+	return -1;
+    }
+
+    for (i = 0; i < r; i++)
+    {
+	int fd = fdw->epevents[i].data.fd;
+	unsigned int events = fdw->epevents[i].events;
+
+	if (fd >= fdw->nfiles)
+	{
+	    sys_err("ident overflow %d nfiles: %d", fd, fdw->nfiles);
+	    continue;
+	}
+
+	if (events & (EPOLLERR | EPOLLHUP))
+	{
+	    fdw->revents[fdw->nrevents].fd = fd;
+	    fdw->revents[fdw->nrevents].event = FDW_EOF;
+	    ++fdw->nrevents;
+	    continue;
+	}
+
+	if (events & EPOLLIN)
+	{
+	    fdw->revents[fdw->nrevents].fd = fd;
+	    fdw->revents[fdw->nrevents].event = FDW_READ;
+	    ++fdw->nrevents;
+	}
+
+	if (events & EPOLLOUT)
+	{
+	    fdw->revents[fdw->nrevents].fd = fd;
+	    fdw->revents[fdw->nrevents].event = FDW_WRITE;
+	    ++fdw->nrevents;
+	}
+    }
+
+    return (fdw->nrevents);
+}
+
+void fdwatch_clear_fd(LPFDWATCH fdw, socket_t fd)
+{
+    fdw->fd_data[fd] = NULL;
+    fdw->fd_rw[fd] = 0;
+}
+
+void fdwatch_add_fd(LPFDWATCH fdw, socket_t fd, void * client_data, int rw, int oneshot)
+{
+	int old_rw;
+
+	if (fd >= fdw->nfiles)
+	{
+		sys_err("fd overflow %d", fd);
+		return;
+	}
+
+	if (fdw->fd_rw[fd] & rw)
+		return;
+
+	old_rw = fdw->fd_rw[fd];
+	fdw->fd_rw[fd] |= rw;
+	sys_log(2, "FDWATCH_REGISTER fdw %p fd %d rw %d data %p", fdw, fd, rw, client_data);
+
+	if (oneshot)
+	{
+		sys_log(2, "ADD ONESHOT fd_rw %d", fdw->fd_rw[fd]);
+		fdw->fd_rw[fd] |= FDW_WRITE_ONESHOT;
+	}
+
+	fdw->fd_data[fd] = client_data;
+	fdwatch_register(fdw, fd, old_rw);
+}
+
+void fdwatch_del_fd(LPFDWATCH fdw, socket_t fd)
+{
+    if (fd >= fdw->nfiles)
+	return;
+
+    if (fdw->fd_rw[fd] & (FDW_READ | FDW_WRITE))
+    {
+	if (epoll_ctl(fdw->epfd, EPOLL_CTL_DEL, fd, NULL) == -1 && errno != ENOENT && errno != EBADF)
+	    sys_err("epoll_ctl: del fd %d: %s", fd, strerror(errno));
+    }
+
+    fdwatch_clear_fd(fdw, fd);
+}
+
+void fdwatch_clear_event(LPFDWATCH fdw, socket_t fd, unsigned int event_idx)
+{
+    assert(event_idx < fdw->nfiles * 2);
+
+    if (fdw->revents[event_idx].fd != fd)
+	return;
+
+    fdw->revents[event_idx].fd = -1;
+}
+
+int fdwatch_check_event(LPFDWATCH fdw, socket_t fd, unsigned int event_idx)
+{
+    assert(event_idx < fdw->nfiles * 2);
+
+    if (fdw->revents[event_idx].fd != fd)
+	return 0;
+
+    switch (fdw->revents[event_idx].event)
+    {
+	case FDW_EOF:
+	    return FDW_EOF;
+
+	case FDW_READ:
+	    if (fdw->fd_rw[fd] & FDW_READ)
+		return FDW_READ;
+	    break;
+
+	case FDW_WRITE:
+	    if (fdw->fd_rw[fd] & FDW_WRITE)
+	    {
+		// epoll has no per-direction oneshot flag, so drop EPOLLOUT ourselves
+		if (fdw->fd_rw[fd] & FDW_WRITE_ONESHOT)
+		{
+		    int old_rw = fdw->fd_rw[fd];
+
+		    fdw->fd_rw[fd] &= ~FDW_WRITE;
+		    fdwatch_register(fdw, fd, old_rw);
+		}
+
+		return FDW_WRITE;
+	    }
+	    break;
+    }
+
+    return 0;
+}
+
+int fdwatch_get_ident(LPFDWATCH fdw, unsigned int event_idx)
+{
+    assert(event_idx < fdw->nfiles * 2);
+    return fdw->revents[event_idx].fd;
+}
+
+// Free space in the kernel send buffer, the value kqueue hands out as the
+// EVFILT_WRITE data field.
+int fdwatch_get_buffer_size(LPFDWATCH fdw, socket_t fd)
+{
+    int sndbuf, outq;
+    socklen_t len = sizeof(sndbuf);
+
+    if (getsockopt(fd, SOL_SOCKET, SO_SNDBUF, &sndbuf, &len) == -1)
+	return 0;
+
+    if (ioctl(fd, SIOCOUTQ, &outq) == -1)
+	return 0;
+
+    return MAX(sndbuf - outq, 0);
+}
+
+void * fdwatch_get_client_data(LPFDWATCH fdw, unsigned int event_idx)
+{
+    int fd;
+
+    assert(event_idx < fdw->nfiles * 2);
+
+    fd = fdw->revents[event_idx].fd;
+
+    if (fd < 0 || fd >= fdw->nfiles)
+	return NULL;
+
+    return (fdw->fd_data[fd]);
+}
+
+#elif !defined(__USE_SELECT__)
 
 LPFDWATCH fdwatch_new(int nfiles)
 {
@@ -59,7 +329,7 @@ int fdwatch(LPFDWATCH fdw, struct timeval *timeout)
     else
     {
 	ts.tv_sec = timeout->tv_sec;
-	ts.tv_nsec = timeout->tv_usec;
+	ts.tv_nsec = timeout->tv_usec * 1000;
 
 	r = kevent(fdw->kq, fdw->kqevents, fdw->nkqevents, fdw->kqrevents, fdw->nfiles, &ts);
     }
@@ -67,7 +337,12 @@ int fdwatch(LPFDWATCH fdw, struct timeval *timeout)
     fdw->nkqevents = 0;
 
     if (r == -1)
+    {
+	if (errno == EINTR)
+	    return 0;
+
 	return -1;
+    }
 
     memset(fdw->fd_event_idx, 0, sizeof(int) * fdw->nfiles);
 
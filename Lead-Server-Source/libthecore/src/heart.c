@@ -35,6 +35,11 @@ void heart_delete(LPHEART ht)
     free(ht);
 }
 
+void heart_set_wait(LPHEART ht, HEARTWAITFUNC func)
+{
+    ht->wait = func;
+}
+
 int heart_idle(LPHEART ht)
 {
     struct timeval now, process_time, timeout, temp_time;
@@ -73,7 +78,19 @@ int heart_idle(LPHEART ht)
 		gettimeofday(&now, (struct timezone *) 0);
 		timeout = *timediff(&ht->last_time, &now);
 
-		thecore_sleep(&timeout);
+		if (!ht->wait)
+			thecore_sleep(&timeout);
+		else
+		{
+			// ٸ   Է ٷ óϰ, ð  ٽ ٸ.
+			while (timeout.tv_sec || timeout.tv_usec)
+			{
+				ht->wait(&timeout);
+
+				gettimeofday(&now, (struct timezone *) 0);
+				timeout = *timediff(&ht->last_time, &now);
+			}
+		}
 	}
 
     ++missed_pulse;
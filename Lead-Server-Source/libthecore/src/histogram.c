@@ -0,0 +1,137 @@
+/*
+ *    Filename: histogram.c
+ * Description:  ð ׷ (HDR  α- ĭ)
+ */
+#define __LIBTHECORE__
+#include "stdafx.h"
+
+static int histogram_bucket_index(unsigned int value)
+{
+	int msb;
+	int shift;
+
+	if (value < HISTOGRAM_LINEAR_COUNT)
+		return value;
+
+#ifdef __GNUC__
+	msb = 31 - __builtin_clz(value);
+#else
+	{
+		unsigned int v = value;
+
+		msb = 0;
+
+		while (v >>= 1)
+			++msb;
+	}
+#endif
+	shift = msb - HISTOGRAM_SUB_BUCKET_BITS;
+
+	return HISTOGRAM_LINEAR_COUNT + (shift - 1) * HISTOGRAM_SUB_BUCKET_COUNT
+		+ (int) ((value >> shift) - HISTOGRAM_SUB_BUCKET_COUNT);
+}
+
+static unsigned int histogram_bucket_upper(int idx)
+{
+	int shift;
+	unsigned int top;
+
+	if (idx < HISTOGRAM_LINEAR_COUNT)
+		return idx;
+
+	shift = (idx - HISTOGRAM_LINEAR_COUNT) / HISTOGRAM_SUB_BUCKET_COUNT + 1;
+	top = (idx - HISTOGRAM_LINEAR_COUNT) % HISTOGRAM_SUB_BUCKET_COUNT + HISTOGRAM_SUB_BUCKET_COUNT;
+
+	//  ĭ (32 << 27) - 1  unsigned   0xffffffff  ȴ.
+	return ((top + 1) << shift) - 1;
+}
+
+void histogram_reset(LPHISTOGRAM h)
+{
+	memset(h, 0, sizeof(HISTOGRAM));
+}
+
+void histogram_record(LPHISTOGRAM h, unsigned int value)
+{
+	++h->counts[histogram_bucket_index(value)];
+
+	if (!h->total_count || value < h->min_value)
+		h->min_value = value;
+
+	if (value > h->max_value)
+		h->max_value = value;
+
+	++h->total_count;
+	h->sum += value;
+}
+
+void histogram_merge(LPHISTOGRAM dst, const HISTOGRAM * src)
+{
+	int i;
+
+	if (!src->total_count)
+		return;
+
+	for (i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i)
+		dst->counts[i] += src->counts[i];
+
+	if (!dst->total_count || src->min_value < dst->min_value)
+		dst->min_value = src->min_value;
+
+	if (src->max_value > dst->max_value)
+		dst->max_value = src->max_value;
+
+	dst->total_count += src->total_count;
+	dst->sum += src->sum;
+}
+
+unsigned int histogram_percentile(const HISTOGRAM * h, double percentile)
+{
+	double target;
+	unsigned int seen = 0;
+	int i;
+
+	if (!h->total_count)
+		return 0;
+
+	if (percentile >= 100.0)
+		return h->max_value;
+
+	target = h->total_count * (percentile / 100.0);
+
+	for (i = 0; i < HISTOGRAM_BUCKET_COUNT; ++i)
+	{
+		seen += h->counts[i];
+
+		if (seen > 0 && seen >= target)
+		{
+			unsigned int upper = histogram_bucket_upper(i);
+			return upper < h->max_value ? upper : h->max_value;
+		}
+	}
+
+	return h->max_value;
+}
+
+unsigned int histogram_count_le(const HISTOGRAM * h, unsigned int value)
+{
+	unsigned int count = 0;
+	int last = histogram_bucket_index(value);
+	int i;
+
+	if (value >= h->max_value)
+		return h->total_count;
+
+	for (i = 0; i <= last; ++i)
+		count += h->counts[i];
+
+	return count;
+}
+
+unsigned int histogram_mean(const HISTOGRAM * h)
+{
+	if (!h->total_count)
+		return 0;
+
+	return (unsigned int) (h->sum / h->total_count);
+}
@@ -44,6 +44,336 @@ void log_file_set_dir(const char *dir);
 
 static unsigned int log_level_bits = 0;
 
+//   ĳ ð ڿ ("%-15.15s" , asctime  )
+static time_t	log_cached_time = 0;
+static char	log_cached_time_string[16];
+
+static void log_format_time(time_t ct, char * out)
+{
+	char time_s[32];
+#ifndef __WIN32__
+	struct tm tm_s;
+
+	localtime_r(&ct, &tm_s);
+	asctime_r(&tm_s, time_s);
+#else
+	strncpy(time_s, asctime(localtime(&ct)), sizeof(time_s) - 1);
+	time_s[sizeof(time_s) - 1] = '\0';
+#endif
+	snprintf(out, 16, "%-15.15s", time_s + 4);
+}
+
+#ifndef __WIN32__
+static volatile int	log_cached_time_lock = 0;
+
+static void log_get_time_string(char * out)
+{
+	time_t ct = time(0);
+
+	// ٸ 尡  ̸ ĳø  ʰ  .
+	if (__sync_lock_test_and_set(&log_cached_time_lock, 1))
+	{
+		log_format_time(ct, out);
+		return;
+	}
+
+	if (ct != log_cached_time)
+	{
+		log_format_time(ct, log_cached_time_string);
+		log_cached_time = ct;
+	}
+
+	memcpy(out, log_cached_time_string, sizeof(log_cached_time_string));
+	__sync_lock_release(&log_cached_time_lock);
+}
+
+// 񵿱 α
+//
+//  ( ٸ ) ̸  ڵ带  ֱ⸸ ϰ,
+//   fflush   尡 Ƽ Ѵ.  Ը  δ
+//   /  Һ ť ڳ   ʴ´.
+enum
+{
+	LOG_TARGET_SYS		= (1 << 0),
+	LOG_TARGET_ERR		= (1 << 1),
+	LOG_TARGET_STDOUT	= (1 << 2),
+
+	LOG_RECORD_TEXT_MAX	= 1536,
+	LOG_WRITER_BATCH	= 256,
+};
+
+typedef struct log_record_s
+{
+	volatile unsigned int	seq;
+	unsigned int		pos;	//   ġ
+	unsigned char		targets;
+	unsigned short		len;
+	unsigned short		stdout_skip_begin;	// stdout  ð κ  
+	unsigned short		stdout_skip_end;
+	char			text[LOG_RECORD_TEXT_MAX];
+} LOG_RECORD;
+
+static unsigned int	log_async_queue_size = 0;
+static int		log_async_overflow = LOG_ASYNC_OVERFLOW_DROP;
+
+static LOG_RECORD *	log_ring = NULL;
+static unsigned int	log_ring_mask = 0;
+static volatile unsigned int	log_ring_head = 0;	// ڰ   ġ
+static unsigned int	log_ring_tail = 0;		//  常 
+
+static volatile int	log_async_running = 0;
+static volatile int	log_rotating = 0;
+static volatile unsigned int	log_dropped_count = 0;
+static unsigned int	log_dropped_reported = 0;
+
+static pthread_t	log_writer;
+static pthread_mutex_t	log_write_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static LOG_RECORD * log_ring_claim(void)
+{
+	unsigned int pos = log_ring_head;
+
+	for (;;)
+	{
+		LOG_RECORD * rec = &log_ring[pos & log_ring_mask];
+		int diff = (int) (rec->seq - pos);
+
+		if (diff == 0)
+		{
+			if (__sync_bool_compare_and_swap(&log_ring_head, pos, pos + 1))
+			{
+				rec->pos = pos;
+				return rec;
+			}
+		}
+		else if (diff < 0)
+		{
+			//  . ȸ ߿  尡  Ƿ ٸ ʴ´.
+			if (log_async_overflow != LOG_ASYNC_OVERFLOW_BLOCK || log_rotating)
+			{
+				__sync_fetch_and_add(&log_dropped_count, 1);
+				return NULL;
+			}
+
+			usleep(100);
+		}
+
+		pos = log_ring_head;
+	}
+}
+
+static void log_ring_publish(LOG_RECORD * rec, unsigned int pos_seq)
+{
+	__sync_synchronize();
+	rec->seq = pos_seq;
+}
+
+static void log_record_write(LOG_RECORD * rec, int * written)
+{
+	if ((rec->targets & LOG_TARGET_ERR) && log_file_err && log_file_err->fp)
+	{
+		fwrite(rec->text, 1, rec->len, log_file_err->fp);
+		*written |= LOG_TARGET_ERR;
+	}
+
+	if ((rec->targets & LOG_TARGET_SYS) && log_file_sys && log_file_sys->fp)
+	{
+		fwrite(rec->text, 1, rec->len, log_file_sys->fp);
+		*written |= LOG_TARGET_SYS;
+	}
+
+	if (rec->targets & LOG_TARGET_STDOUT)
+	{
+		fwrite(rec->text, 1, rec->stdout_skip_begin, stdout);
+		fwrite(rec->text + rec->stdout_skip_end, 1, rec->len - rec->stdout_skip_end, stdout);
+		*written |= LOG_TARGET_STDOUT;
+	}
+}
+
+static unsigned int log_writer_flush_batch(void)
+{
+	unsigned int count = 0;
+	unsigned int dropped;
+	int written = 0;
+
+	pthread_mutex_lock(&log_write_mutex);
+
+	while (count < LOG_WRITER_BATCH)
+	{
+		LOG_RECORD * rec = &log_ring[log_ring_tail & log_ring_mask];
+
+		if ((int) (rec->seq - (log_ring_tail + 1)) < 0)
+			break;
+
+		__sync_synchronize();
+		log_record_write(rec, &written);
+
+		log_ring_publish(rec, log_ring_tail + log_ring_mask + 1);
+		++log_ring_tail;
+		++count;
+	}
+
+	dropped = log_dropped_count;
+
+	if (dropped != log_dropped_reported && log_file_sys && log_file_sys->fp)
+	{
+		char time_s[16];
+
+		log_get_time_string(time_s);
+		fprintf(log_file_sys->fp, "%s :: SYSTEM: LOG DROPPED %u records (total %u)\n", time_s, dropped - log_dropped_reported, dropped);
+		log_dropped_reported = dropped;
+		written |= LOG_TARGET_SYS;
+	}
+
+	if ((written & LOG_TARGET_ERR) && log_file_err->fp)
+		fflush(log_file_err->fp);
+
+	if ((written & LOG_TARGET_SYS) && log_file_sys->fp)
+		fflush(log_file_sys->fp);
+
+	if (written & LOG_TARGET_STDOUT)
+		fflush(stdout);
+
+	pthread_mutex_unlock(&log_write_mutex);
+	return count;
+}
+
+static void * log_writer_thread(void * arg)
+{
+	for (;;)
+	{
+		int running = log_async_running;
+
+		if (log_writer_flush_batch())
+			continue;
+
+		if (!running)
+			break;
+
+		usleep(1000);
+	}
+
+	return NULL;
+}
+
+static void log_async_start(void)
+{
+	unsigned int size = 256;
+	unsigned int i;
+
+	if (!log_async_queue_size || log_async_running)
+		return;
+
+	while (size < log_async_queue_size && size < 65536)
+		size <<= 1;
+
+	log_ring = (LOG_RECORD *) malloc(sizeof(LOG_RECORD) * size);
+
+	if (!log_ring)
+		return;
+
+	for (i = 0; i < size; ++i)
+		log_ring[i].seq = i;
+
+	log_ring_mask = size - 1;
+	log_ring_head = 0;
+	log_ring_tail = 0;
+	log_async_running = 1;
+
+	if (pthread_create(&log_writer, NULL, log_writer_thread, NULL) != 0)
+	{
+		log_async_running = 0;
+		free(log_ring);
+		log_ring = NULL;
+		return;
+	}
+
+	sys_log(0, "SYSTEM: ASYNC LOG queue %u records overflow %s", size,
+			log_async_overflow == LOG_ASYNC_OVERFLOW_BLOCK ? "block" : "drop");
+}
+
+static void log_async_stop(void)
+{
+	if (!log_async_running)
+		return;
+
+	log_async_running = 0;
+	pthread_join(log_writer, NULL);
+
+	free(log_ring);
+	log_ring = NULL;
+}
+
+// ڵ ϳ  ð/Ӹ ä. ť    NULL
+static LOG_RECORD * log_async_begin(const char * prefix, const char * time_s, const char * suffix, int * len)
+{
+	LOG_RECORD * rec = log_ring_claim();
+
+	if (!rec)
+		return NULL;
+
+	*len = snprintf(rec->text, LOG_RECORD_TEXT_MAX, "%s%s%s", prefix, time_s, suffix);
+
+	if (*len < 0 || *len >= LOG_RECORD_TEXT_MAX)
+		*len = LOG_RECORD_TEXT_MAX - 1;
+
+	return rec;
+}
+
+static void log_async_end(LOG_RECORD * rec, int len, int targets)
+{
+	//  ڸ  ڸ ߶󼭶  ٲ .
+	if (len >= LOG_RECORD_TEXT_MAX - 1)
+		len = LOG_RECORD_TEXT_MAX - 2;
+
+	rec->text[len++] = '\n';
+	rec->len = len;
+	rec->targets = targets;
+
+	log_ring_publish(rec, rec->pos + 1);
+}
+#else
+static void log_get_time_string(char * out)
+{
+	time_t ct = time(0);
+
+	if (ct != log_cached_time)
+	{
+		log_format_time(ct, log_cached_time_string);
+		log_cached_time = ct;
+	}
+
+	memcpy(out, log_cached_time_string, sizeof(log_cached_time_string));
+}
+#endif
+
+void log_set_async_queue_size(unsigned int records)
+{
+#ifndef __WIN32__
+	log_async_queue_size = records;
+
+	// ̹ α    ٷ Ѵ.
+	if (log_file_sys)
+		log_async_start();
+#endif
+}
+
+void log_set_async_overflow(int policy)
+{
+#ifndef __WIN32__
+	log_async_overflow = policy;
+#endif
+}
+
+unsigned int log_get_dropped_count(void)
+{
+#ifndef __WIN32__
+	return log_dropped_count;
+#else
+	return 0;
+#endif
+}
+
 void log_set_level(unsigned int bit)
 {
 	log_level_bits |= bit;
@@ -79,6 +409,9 @@ int log_init(void)
 		log_file_pt = log_file_init(PTS_FILENAME, "w");
 		if( NULL == log_file_pt ) break;
 
+#ifndef __WIN32__
+		log_async_start();
+#endif
 		return true;
 	}
 	while( false );
@@ -88,6 +421,10 @@ int log_init(void)
 
 void log_destroy(void)
 {
+#ifndef __WIN32__
+	// ť  ڵ带     ݴ´.
+	log_async_stop();
+#endif
 	log_file_destroy(log_file_sys);
 	log_file_destroy(log_file_err);
 	log_file_destroy(log_file_pt);
@@ -99,19 +436,33 @@ void log_destroy(void)
 
 void log_rotate(void)
 {
+#ifndef __WIN32__
+	//  尡  ͸   ݰ ٽ  ʵ Ѵ.
+	if (log_async_running)
+	{
+		pthread_mutex_lock(&log_write_mutex);
+		log_rotating = 1;
+	}
+#endif
 	log_file_check(log_file_sys);
 	log_file_check(log_file_err);
 	log_file_check(log_file_pt);
 
 	log_file_rotate(log_file_sys);
+#ifndef __WIN32__
+	if (log_rotating)
+	{
+		log_rotating = 0;
+		pthread_mutex_unlock(&log_write_mutex);
+	}
+#endif
 }
 
 #ifndef __WIN32__
 void _sys_err(const char *func, int line, const char *format, ...)
 {
 	va_list args;
-	time_t ct = time(0);  
-	char *time_s = asctime(localtime(&ct));
+	char time_s[16];
 
 	char buf[1024 + 2]; // \n ̱ ..
 	int len;
@@ -119,8 +470,30 @@ void _sys_err(const char *func, int line, const char *format, ...)
 	if (!log_file_err)
 		return;
 
-	time_s[strlen(time_s) - 1] = '\0';
-	len = snprintf(buf, 1024, "SYSERR: %-15.15s :: %s: ", time_s + 4, func);
+	log_get_time_string(time_s);
+
+	if (log_async_running)
+	{
+		LOG_RECORD * rec = log_async_begin("SYSERR: ", time_s, " :: ", &len);
+
+		if (!rec)
+			return;
+
+		if (len < LOG_RECORD_TEXT_MAX - 1)
+			len += snprintf(rec->text + len, LOG_RECORD_TEXT_MAX - len, "%s: ", func);
+
+		if (len < LOG_RECORD_TEXT_MAX - 1)
+		{
+			va_start(args, format);
+			len += vsnprintf(rec->text + len, LOG_RECORD_TEXT_MAX - len, format, args);
+			va_end(args);
+		}
+
+		log_async_end(rec, len, LOG_TARGET_ERR | LOG_TARGET_SYS);
+		return;
+	}
+
+	len = snprintf(buf, 1024, "SYSERR: %s :: %s: ", time_s, func);
 	buf[1025] = '\0';
 
 	if (len < 1024)
@@ -193,15 +566,49 @@ void sys_log(unsigned int bit, const char *format, ...)
 	if (bit != 0 && !(log_level_bits & bit))
 		return;
 
+#ifndef __WIN32__
+	if (log_async_running && log_file_sys)
+	{
+		char time_s[16];
+		int len;
+		int targets = LOG_TARGET_SYS;
+		LOG_RECORD * rec;
+
+		log_get_time_string(time_s);
+
+		if (!(rec = log_async_begin(sys_log_header_string, time_s, " :: ", &len)))
+			return;
+
+		// stdout  Ӹ  "ð :: "   .
+		rec->stdout_skip_begin = strlen(sys_log_header_string);
+		rec->stdout_skip_end = len;
+
+		if (rec->stdout_skip_begin > len)
+			rec->stdout_skip_begin = len;
+
+		if (log_level_bits > 1)
+			targets |= LOG_TARGET_STDOUT;
+
+		if (len < LOG_RECORD_TEXT_MAX - 1)
+		{
+			va_start(args, format);
+			len += vsnprintf(rec->text + len, LOG_RECORD_TEXT_MAX - len, format, args);
+			va_end(args);
+		}
+
+		log_async_end(rec, len, targets);
+		return;
+	}
+#endif
+
 	if (log_file_sys)
 	{
-		time_t ct = time(0);  
-		char *time_s = asctime(localtime(&ct));
+		char time_s[16];
 
 		fprintf(log_file_sys->fp, sys_log_header_string);
 
-		time_s[strlen(time_s) - 1] = '\0';
-		fprintf(log_file_sys->fp, "%-15.15s :: ", time_s + 4);
+		log_get_time_string(time_s);
+		fprintf(log_file_sys->fp, "%s :: ", time_s);
 
 		va_start(args, format);
 		vfprintf(log_file_sys->fp, format, args);
@@ -0,0 +1,427 @@
+/*
+ *    Filename: metrics.c
+ * Description: ġ Ϻο Prometheus ؽƮ   Ʈ
+ */
+#define __LIBTHECORE__
+#include "stdafx.h"
+
+enum
+{
+	METRICS_MAX_NUM		= 256,
+	METRICS_NAME_LEN	= 128,
+	METRICS_HELP_LEN	= 128,
+	METRICS_ALLOW_MAX_NUM	= 16,
+	METRICS_REQUEST_MAX	= 2048,
+};
+
+struct metric_s
+{
+	char			name[METRICS_NAME_LEN];
+	char			help[METRICS_HELP_LEN];
+	int			type;
+	double			value;
+	METRIC_FUNC		func;
+	const HISTOGRAM *	histogram;
+};
+
+static METRIC	metrics_table[METRICS_MAX_NUM];
+static int	metrics_count = 0;
+
+// ׷    le  (us)
+static const unsigned int metrics_histogram_bounds[] =
+{
+	100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000,
+};
+
+typedef struct metrics_text_s
+{
+	char *	buf;
+	int	len;
+	int	size;
+} METRICS_TEXT;
+
+static void metrics_text_append(METRICS_TEXT * t, const char * format, ...)
+{
+	va_list args;
+	int n;
+
+	for (;;)
+	{
+		if (t->size - t->len > 0)
+		{
+			va_start(args, format);
+			n = vsnprintf(t->buf + t->len, t->size - t->len, format, args);
+			va_end(args);
+
+			if (n >= 0 && n < t->size - t->len)
+			{
+				t->len += n;
+				return;
+			}
+		}
+
+		t->size = t->size ? t->size * 2 : 16384;
+		t->buf = (char *) realloc(t->buf, t->size);
+	}
+}
+
+static LPMETRIC metrics_register(int type, const char * name, const char * help)
+{
+	LPMETRIC m;
+
+	if (metrics_count >= METRICS_MAX_NUM)
+	{
+		sys_err("too many metrics, %s ignored", name);
+		return NULL;
+	}
+
+	m = &metrics_table[metrics_count++];
+	memset(m, 0, sizeof(METRIC));
+	strncpy(m->name, name, METRICS_NAME_LEN - 1);
+	strncpy(m->help, help, METRICS_HELP_LEN - 1);
+	m->type = type;
+	return m;
+}
+
+LPMETRIC metrics_counter(const char * name, const char * help)
+{
+	return metrics_register(METRIC_COUNTER, name, help);
+}
+
+LPMETRIC metrics_gauge(const char * name, const char * help)
+{
+	return metrics_register(METRIC_GAUGE, name, help);
+}
+
+LPMETRIC metrics_func(int type, const char * name, const char * help, METRIC_FUNC func)
+{
+	LPMETRIC m = metrics_register(type, name, help);
+
+	if (m)
+		m->func = func;
+
+	return m;
+}
+
+LPMETRIC metrics_histogram(const char * name, const char * help, const HISTOGRAM * h)
+{
+	LPMETRIC m = metrics_register(METRIC_HISTOGRAM, name, help);
+
+	if (m)
+		m->histogram = h;
+
+	return m;
+}
+
+void metrics_add(LPMETRIC m, double value)
+{
+	if (m)
+		m->value += value;
+}
+
+void metrics_set(LPMETRIC m, double value)
+{
+	if (m)
+		m->value = value;
+}
+
+// "name{a=\"b\"}"  ̸  κ . labels  ߰ȣ 
+static void metrics_split_name(const char * full, char * family, const char ** labels, int * labels_len)
+{
+	const char * brace = strchr(full, '{');
+	int len = brace ? (int) (brace - full) : (int) strlen(full);
+
+	memcpy(family, full, len);
+	family[len] = '\0';
+
+	if (brace)
+	{
+		*labels = brace + 1;
+		*labels_len = (int) strlen(brace + 1) - 1;
+
+		if (*labels_len < 0)
+			*labels_len = 0;
+	}
+	else
+	{
+		*labels = "";
+		*labels_len = 0;
+	}
+}
+
+static void metrics_render_histogram(METRICS_TEXT * t, const char * family, const char * labels, int labels_len, const HISTOGRAM * h)
+{
+	const char * sep = labels_len ? "," : "";
+	unsigned int i;
+
+	for (i = 0; i < sizeof(metrics_histogram_bounds) / sizeof(metrics_histogram_bounds[0]); ++i)
+	{
+		metrics_text_append(t, "%s_bucket{%.*s%sle=\"%u\"} %u\n", family, labels_len, labels, sep,
+				metrics_histogram_bounds[i], histogram_count_le(h, metrics_histogram_bounds[i]));
+	}
+
+	metrics_text_append(t, "%s_bucket{%.*s%sle=\"+Inf\"} %u\n", family, labels_len, labels, sep, h->total_count);
+
+	if (labels_len)
+	{
+		metrics_text_append(t, "%s_sum{%.*s} %.0f\n", family, labels_len, labels, h->sum);
+		metrics_text_append(t, "%s_count{%.*s} %u\n", family, labels_len, labels, h->total_count);
+	}
+	else
+	{
+		metrics_text_append(t, "%s_sum %.0f\n", family, h->sum);
+		metrics_text_append(t, "%s_count %u\n", family, h->total_count);
+	}
+}
+
+static void metrics_render(METRICS_TEXT * t)
+{
+	static const char * type_names[] = { "counter", "gauge", "histogram" };
+	char family[METRICS_NAME_LEN];
+	char last_family[METRICS_NAME_LEN] = { 0, };
+	const char * labels;
+	int labels_len;
+	int i;
+
+	for (i = 0; i < metrics_count; ++i)
+	{
+		LPMETRIC m = &metrics_table[i];
+
+		metrics_split_name(m->name, family, &labels, &labels_len);
+
+		if (strcmp(family, last_family))
+		{
+			metrics_text_append(t, "# HELP %s %s\n", family, m->help);
+			metrics_text_append(t, "# TYPE %s %s\n", family, type_names[m->type]);
+			strcpy(last_family, family);
+		}
+
+		if (m->type == METRIC_HISTOGRAM)
+		{
+			if (m->histogram)
+				metrics_render_histogram(t, family, labels, labels_len, m->histogram);
+
+			continue;
+		}
+
+		if (m->func)
+			m->value = m->func();
+
+		metrics_text_append(t, "%s %.15g\n", m->name, m->value);
+	}
+}
+
+#ifndef __WIN32__
+static socket_t		metrics_socket = INVALID_SOCKET;
+static pthread_t	metrics_thread;
+static volatile int	metrics_running = 0;
+static pthread_mutex_t	metrics_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+//  尡  ֽ .    װ 縸  .
+static METRICS_TEXT	metrics_snapshot = { NULL, 0, 0 };
+static METRICS_TEXT	metrics_work = { NULL, 0, 0 };
+
+static in_addr_t	metrics_allow[METRICS_ALLOW_MAX_NUM];
+static int		metrics_allow_count = 0;
+
+static int metrics_is_allowed(struct sockaddr_in * peer)
+{
+	int i;
+
+	if (!metrics_allow_count)
+		return peer->sin_addr.s_addr == htonl(INADDR_LOOPBACK);
+
+	for (i = 0; i < metrics_allow_count; ++i)
+		if (metrics_allow[i] == peer->sin_addr.s_addr)
+			return 1;
+
+	return 0;
+}
+
+static void metrics_send_all(socket_t s, const char * data, int len)
+{
+	while (len > 0)
+	{
+		int n = send(s, data, len, 0);
+
+		if (n <= 0)
+			return;
+
+		data += n;
+		len -= n;
+	}
+}
+
+static void metrics_serve(socket_t s)
+{
+	char request[METRICS_REQUEST_MAX];
+	char header[128];
+	char * body;
+	int body_len;
+	int header_len;
+	struct timeval tv;
+
+	socket_block(s);
+
+	tv.tv_sec = 1;
+	tv.tv_usec = 0;
+	setsockopt(s, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+	setsockopt(s, SOL_SOCKET, SO_SNDTIMEO, &tv, sizeof(tv));
+
+	// û   ʴ´.   (Ǵ ۸ŭ) а .
+	{
+		int got = 0;
+
+		while (got < METRICS_REQUEST_MAX - 1)
+		{
+			int n = recv(s, request + got, METRICS_REQUEST_MAX - 1 - got, 0);
+
+			if (n <= 0)
+				break;
+
+			got += n;
+			request[got] = '\0';
+
+			if (strstr(request, "\r\n\r\n") || strstr(request, "\n\n"))
+				break;
+		}
+	}
+
+	pthread_mutex_lock(&metrics_mutex);
+	body_len = metrics_snapshot.len;
+	body = (char *) malloc(body_len + 1);
+
+	if (body && body_len)
+		memcpy(body, metrics_snapshot.buf, body_len);
+
+	pthread_mutex_unlock(&metrics_mutex);
+
+	if (!body)
+		return;
+
+	header_len = snprintf(header, sizeof(header),
+			"HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: %d\r\n\r\n", body_len);
+
+	metrics_send_all(s, header, header_len);
+	metrics_send_all(s, body, body_len);
+	free(body);
+}
+
+static void * metrics_thread_func(void * arg)
+{
+	while (metrics_running)
+	{
+		fd_set rfds;
+		struct timeval tv;
+		struct sockaddr_in peer;
+		socket_t s;
+
+		FD_ZERO(&rfds);
+		FD_SET(metrics_socket, &rfds);
+		tv.tv_sec = 0;
+		tv.tv_usec = 500000;
+
+		if (select(metrics_socket + 1, &rfds, NULL, NULL, &tv) <= 0)
+			continue;
+
+		if ((s = socket_accept(metrics_socket, &peer)) == INVALID_SOCKET)
+			continue;
+
+		if (metrics_is_allowed(&peer))
+			metrics_serve(s);
+		else
+			sys_err("metrics: refused %s", inet_ntoa(peer.sin_addr));
+
+		socket_close(s);
+	}
+
+	return NULL;
+}
+
+void metrics_allow_ip(const char * ip)
+{
+	if (metrics_allow_count >= METRICS_ALLOW_MAX_NUM)
+		return;
+
+	metrics_allow[metrics_allow_count++] = inet_addr(ip);
+}
+
+int metrics_listen(const char * ip, int port)
+{
+	if (metrics_running || port <= 0)
+		return false;
+
+	if ((metrics_socket = socket_tcp_bind(ip, port)) == INVALID_SOCKET)
+	{
+		sys_err("metrics: cannot bind %s:%d", ip, port);
+		return false;
+	}
+
+	metrics_running = 1;
+
+	if (pthread_create(&metrics_thread, NULL, metrics_thread_func, NULL) != 0)
+	{
+		metrics_running = 0;
+		socket_close(metrics_socket);
+		metrics_socket = INVALID_SOCKET;
+		return false;
+	}
+
+	sys_log(0, "SYSTEM: METRICS listening on %s:%d", ip, port);
+	return true;
+}
+
+void metrics_update(void)
+{
+	METRICS_TEXT tmp;
+
+	if (!metrics_running)
+		return;
+
+	metrics_work.len = 0;
+	metrics_render(&metrics_work);
+
+	//   ۸ ٲ .    ̿ ٸ.
+	pthread_mutex_lock(&metrics_mutex);
+	tmp = metrics_snapshot;
+	metrics_snapshot = metrics_work;
+	metrics_work = tmp;
+	pthread_mutex_unlock(&metrics_mutex);
+}
+
+void metrics_destroy(void)
+{
+	if (metrics_running)
+	{
+		metrics_running = 0;
+		pthread_join(metrics_thread, NULL);
+		socket_close(metrics_socket);
+		metrics_socket = INVALID_SOCKET;
+	}
+
+	free(metrics_snapshot.buf);
+	free(metrics_work.buf);
+	memset(&metrics_snapshot, 0, sizeof(metrics_snapshot));
+	memset(&metrics_work, 0, sizeof(metrics_work));
+	metrics_count = 0;
+}
+#else
+void metrics_allow_ip(const char * ip)
+{
+}
+
+int metrics_listen(const char * ip, int port)
+{
+	//   ߿̹Ƿ  Ʈ  ʴ´.
+	return false;
+}
+
+void metrics_update(void)
+{
+}
+
+void metrics_destroy(void)
+{
+	metrics_count = 0;
+}
+#endif
@@ -12,6 +12,7 @@ void socket_lingeron(socket_t s);
 void socket_lingeroff(socket_t s);
 void socket_timeout(socket_t s, long sec, long usec);
 void socket_reuse(socket_t s);
+void socket_reuse_port(socket_t s);
 void socket_keepalive(socket_t s);
 
 
@@ -133,7 +134,7 @@ int socket_write(socket_t desc, const char *data, size_t length)
     return 0;
 }
 
-int socket_bind(const char * ip, int port, int protocol)
+int socket_bind(const char * ip, int port, int protocol, int backlog, int reuse_port)
 {
     int                 s;
 #ifdef __WIN32
@@ -149,6 +150,9 @@ int socket_bind(const char * ip, int port, int protocol)
     }
 
     socket_reuse(s);
+
+    if (reuse_port)
+	socket_reuse_port(s);
 #ifndef __WIN32__
     socket_lingeroff(s);
 #else
@@ -180,8 +184,11 @@ int socket_bind(const char * ip, int port, int protocol)
 
     if (protocol == SOCK_STREAM)
     {
-	sys_log(0, "SYSTEM: BINDING TCP PORT ON [%d] (fd %d)", port, s);
-	listen(s, SOMAXCONN);
+	if (backlog <= 0)
+	    backlog = SOMAXCONN;
+
+	sys_log(0, "SYSTEM: BINDING TCP PORT ON [%d] (fd %d backlog %d)", port, s, backlog);
+	listen(s, backlog);
     }
 
     return s;
@@ -189,7 +196,12 @@ int socket_bind(const char * ip, int port, int protocol)
 
 int socket_tcp_bind(const char * ip, int port)
 {
-    return socket_bind(ip, port, SOCK_STREAM);
+    return socket_bind(ip, port, SOCK_STREAM, 0, 0);
+}
+
+int socket_tcp_bind_ex(const char * ip, int port, int backlog, int reuse_port)
+{
+    return socket_bind(ip, port, SOCK_STREAM, backlog, reuse_port);
 }
 
 
@@ -228,32 +240,109 @@ socket_t socket_accept(socket_t s, struct sockaddr_in *peer)
     return (desc);
 }
 
-socket_t socket_connect(const char* host, WORD port)
+int socket_resolve(const char * host, WORD port, struct sockaddr_in * addr)
 {
-    socket_t            s = 0;
-    struct sockaddr_in  server_addr;
-    int                 rslt;
+    memset(addr, 0, sizeof(*addr));
 
-    /* ּ ü ʱȭ */
-    memset(&server_addr, 0, sizeof(server_addr));
+    addr->sin_family = AF_INET;
+    addr->sin_port = htons(port);
 
     if (isdigit(*host))
-	server_addr.sin_addr.s_addr = inet_addr(host);
+    {
+	addr->sin_addr.s_addr = inet_addr(host);
+	return 1;
+    }
     else
     {
 	struct hostent *hp;
 
 	if ((hp = gethostbyname(host)) == NULL)
 	{
-	    sys_err("socket_connect(): can not connect to %s:%d", host, port);
-	    return -1;
+	    sys_err("socket_resolve(): can not resolve %s", host);
+	    return 0;
 	}
 
-	thecore_memcpy((char* ) &server_addr.sin_addr, hp->h_addr, sizeof(server_addr.sin_addr));
+	thecore_memcpy((char* ) &addr->sin_addr, hp->h_addr, sizeof(addr->sin_addr));
     }
 
-    server_addr.sin_family = AF_INET;
-    server_addr.sin_port = htons(port);
+    return 1;
+}
+
+socket_t socket_connect_async(const struct sockaddr_in * addr)
+{
+    socket_t	s;
+
+    if ((s = socket(AF_INET, SOCK_STREAM, 0)) < 0)
+    {
+	perror("socket");
+	return INVALID_SOCKET;
+    }
+
+    socket_keepalive(s);
+    socket_sndbuf(s, 233016);
+    socket_rcvbuf(s, 233016);
+    socket_lingeron(s);
+    socket_nonblock(s);
+
+    if (connect(s, (const struct sockaddr *) addr, sizeof(*addr)) < 0)
+    {
+#ifdef __WIN32__
+	if (WSAGetLastError() != WSAEWOULDBLOCK)
+#else
+	if (errno != EINPROGRESS && errno != EINTR)
+#endif
+	{
+	    socket_close(s);
+	    return INVALID_SOCKET;
+	}
+    }
+
+    return (s);
+}
+
+int socket_connect_check(socket_t s)
+{
+    fd_set		wset, eset;
+    struct timeval	tv;
+    int			err = 0;
+    socklen_t		len = sizeof(err);
+
+    FD_ZERO(&wset);
+    FD_ZERO(&eset);
+    FD_SET(s, &wset);
+    FD_SET(s, &eset);
+
+    tv.tv_sec = 0;
+    tv.tv_usec = 0;
+
+    //  и except  ˷ ش.
+    if (select(s + 1, NULL, &wset, &eset, &tv) <= 0)
+	return 0;
+
+    if (!FD_ISSET(s, &wset) && !FD_ISSET(s, &eset))
+	return 0;
+
+    if (getsockopt(s, SOL_SOCKET, SO_ERROR, (char *) &err, &len) < 0 || err != 0 || FD_ISSET(s, &eset))
+	return -1;
+
+    //   ڿ socket_connect   ŷ   ´.
+    socket_block(s);
+    socket_timeout(s, 10, 0);
+    return 1;
+}
+
+socket_t socket_connect(const char* host, WORD port)
+{
+    socket_t            s = 0;
+    struct sockaddr_in  server_addr;
+    int                 rslt;
+
+    /* ּ ü ʱȭ */
+    if (!socket_resolve(host, port, &server_addr))
+    {
+	sys_err("socket_connect(): can not connect to %s:%d", host, port);
+	return -1;
+    }
 
     if ((s = socket(AF_INET, SOCK_STREAM, 0)) < 0)
     {
@@ -521,6 +610,19 @@ void socket_reuse(socket_t s)
     }
 }
 
+//  Ʈ  μ    ְ Ѵ.  ʴ OS  Ѵ.
+void socket_reuse_port(socket_t s)
+{
+#ifdef SO_REUSEPORT
+    int opt = 1;
+
+    if (setsockopt(s, SOL_SOCKET, SO_REUSEPORT, (const char*) &opt, sizeof(opt)) < 0)
+	sys_err("setsockopt: reuse port: %s", strerror(errno));
+#else
+    sys_err("socket_reuse_port: SO_REUSEPORT is not supported");
+#endif
+}
+
 void socket_keepalive(socket_t s)
 {
     int opt = 1;
@@ -301,9 +301,202 @@ INLINE void tea_decode(const DWORD sz, const DWORD sy, const DWORD *key, DWORD *
     *dest	= z;
 }
 
-int TEA_Encrypt(DWORD *dest, const DWORD *src, const DWORD * key, int size)
+/*
+ *   SIMD  lane  ϳ  Ѳ óѴ.
+ * ϳ   Ƿ (ECB)  tea_code/tea_decode  .
+ * 4 (SSE2) Ǵ 8 (AVX2)  óϰ   Լ óѴ.
+ *   ó ȣ  CPUID  .
+ */
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__)) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define TEA_USE_SIMD
+#include <immintrin.h>
+#endif
+
+typedef int (*TEA_BLOCK_FUNC)(DWORD *dest, const DWORD *src, const DWORD *key, int blocks);
+
+// ó   Ѵ.
+static int tea_code_blocks_c(DWORD *dest, const DWORD *src, const DWORD *key, int blocks)
 {
     int		i;
+
+    for (i = 0; i < blocks; i++, dest += 2, src += 2)
+	tea_code(*(src + 1), *src, key, dest);
+
+    return (blocks);
+}
+
+static int tea_decode_blocks_c(DWORD *dest, const DWORD *src, const DWORD *key, int blocks)
+{
+    int		i;
+
+    for (i = 0; i < blocks; i++, dest += 2, src += 2)
+	tea_decode(*(src + 1), *src, key, dest);
+
+    return (blocks);
+}
+
+#ifdef TEA_USE_SIMD
+// lane  y, z   [y0 z0 y1 z1] [y2 z2 y3 z3]  [y0 y1 y2 y3] [z0 z1 z2 z3]  .
+#define TEA_SSE_SPLIT(a, b, y, z) \
+    y = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(2, 0, 2, 0))); \
+    z = _mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b), _MM_SHUFFLE(3, 1, 3, 1)))
+
+#define TEA_SSE_F(v) \
+    _mm_add_epi32(_mm_xor_si128(_mm_slli_epi32(v, 4), _mm_srli_epi32(v, 5)), v)
+
+__attribute__((target("sse2")))
+static int tea_code_blocks_sse2(DWORD *dest, const DWORD *src, const DWORD *key, int blocks)
+{
+    int		done = 0;
+
+    for (; blocks - done >= 4; done += 4, dest += 8, src += 8)
+    {
+	__m128i	a = _mm_loadu_si128((const __m128i *) src);
+	__m128i	b = _mm_loadu_si128((const __m128i *) (src + 4));
+	__m128i	y, z;
+	DWORD	sum = 0;
+	int	r;
+
+	TEA_SSE_SPLIT(a, b, y, z);
+
+	for (r = 0; r < TEA_ROUND; ++r)
+	{
+	    y	= _mm_add_epi32(y, _mm_xor_si128(TEA_SSE_F(z), _mm_set1_epi32(sum + key[sum & 3])));
+	    sum	+= DELTA;
+	    z	= _mm_add_epi32(z, _mm_xor_si128(TEA_SSE_F(y), _mm_set1_epi32(sum + key[sum >> 11 & 3])));
+	}
+
+	_mm_storeu_si128((__m128i *) dest, _mm_unpacklo_epi32(y, z));
+	_mm_storeu_si128((__m128i *) (dest + 4), _mm_unpackhi_epi32(y, z));
+    }
+
+    return (done);
+}
+
+__attribute__((target("sse2")))
+static int tea_decode_blocks_sse2(DWORD *dest, const DWORD *src, const DWORD *key, int blocks)
+{
+    int		done = 0;
+
+    for (; blocks - done >= 4; done += 4, dest += 8, src += 8)
+    {
+	__m128i	a = _mm_loadu_si128((const __m128i *) src);
+	__m128i	b = _mm_loadu_si128((const __m128i *) (src + 4));
+	__m128i	y, z;
+	DWORD	sum = DELTA * TEA_ROUND;
+	int	r;
+
+	TEA_SSE_SPLIT(a, b, y, z);
+
+	for (r = 0; r < TEA_ROUND; ++r)
+	{
+	    z	= _mm_sub_epi32(z, _mm_xor_si128(TEA_SSE_F(y), _mm_set1_epi32(sum + key[sum >> 11 & 3])));
+	    sum	-= DELTA;
+	    y	= _mm_sub_epi32(y, _mm_xor_si128(TEA_SSE_F(z), _mm_set1_epi32(sum + key[sum & 3])));
+	}
+
+	_mm_storeu_si128((__m128i *) dest, _mm_unpacklo_epi32(y, z));
+	_mm_storeu_si128((__m128i *) (dest + 4), _mm_unpackhi_epi32(y, z));
+    }
+
+    return (done);
+}
+
+// 128Ʈ lane ȿ Ƿ   ٲ     ǵ.
+#define TEA_AVX_SPLIT(a, b, y, z) \
+    y = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(2, 0, 2, 0))); \
+    z = _mm256_castps_si256(_mm256_shuffle_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b), _MM_SHUFFLE(3, 1, 3, 1)))
+
+#define TEA_AVX_F(v) \
+    _mm256_add_epi32(_mm256_xor_si256(_mm256_slli_epi32(v, 4), _mm256_srli_epi32(v, 5)), v)
+
+__attribute__((target("avx2")))
+static int tea_code_blocks_avx2(DWORD *dest, const DWORD *src, const DWORD *key, int blocks)
+{
+    int		done = 0;
+
+    for (; blocks - done >= 8; done += 8, dest += 16, src += 16)
+    {
+	__m256i	a = _mm256_loadu_si256((const __m256i *) src);
+	__m256i	b = _mm256_loadu_si256((const __m256i *) (src + 8));
+	__m256i	y, z;
+	DWORD	sum = 0;
+	int	r;
+
+	TEA_AVX_SPLIT(a, b, y, z);
+
+	for (r = 0; r < TEA_ROUND; ++r)
+	{
+	    y	= _mm256_add_epi32(y, _mm256_xor_si256(TEA_AVX_F(z), _mm256_set1_epi32(sum + key[sum & 3])));
+	    sum	+= DELTA;
+	    z	= _mm256_add_epi32(z, _mm256_xor_si256(TEA_AVX_F(y), _mm256_set1_epi32(sum + key[sum >> 11 & 3])));
+	}
+
+	_mm256_storeu_si256((__m256i *) dest, _mm256_unpacklo_epi32(y, z));
+	_mm256_storeu_si256((__m256i *) (dest + 8), _mm256_unpackhi_epi32(y, z));
+    }
+
+    return (done + tea_code_blocks_sse2(dest, src, key, blocks - done));
+}
+
+__attribute__((target("avx2")))
+static int tea_decode_blocks_avx2(DWORD *dest, const DWORD *src, const DWORD *key, int blocks)
+{
+    int		done = 0;
+
+    for (; blocks - done >= 8; done += 8, dest += 16, src += 16)
+    {
+	__m256i	a = _mm256_loadu_si256((const __m256i *) src);
+	__m256i	b = _mm256_loadu_si256((const __m256i *) (src + 8));
+	__m256i	y, z;
+	DWORD	sum = DELTA * TEA_ROUND;
+	int	r;
+
+	TEA_AVX_SPLIT(a, b, y, z);
+
+	for (r = 0; r < TEA_ROUND; ++r)
+	{
+	    z	= _mm256_sub_epi32(z, _mm256_xor_si256(TEA_AVX_F(y), _mm256_set1_epi32(sum + key[sum >> 11 & 3])));
+	    sum	-= DELTA;
+	    y	= _mm256_sub_epi32(y, _mm256_xor_si256(TEA_AVX_F(z), _mm256_set1_epi32(sum + key[sum & 3])));
+	}
+
+	_mm256_storeu_si256((__m256i *) dest, _mm256_unpacklo_epi32(y, z));
+	_mm256_storeu_si256((__m256i *) (dest + 8), _mm256_unpackhi_epi32(y, z));
+    }
+
+    return (done + tea_decode_blocks_sse2(dest, src, key, blocks - done));
+}
+#endif
+
+static TEA_BLOCK_FUNC tea_code_blocks = NULL;
+static TEA_BLOCK_FUNC tea_decode_blocks = NULL;
+
+static void tea_select_blocks_func()
+{
+    tea_code_blocks = tea_code_blocks_c;
+    tea_decode_blocks = tea_decode_blocks_c;
+
+#ifdef TEA_USE_SIMD
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+	tea_code_blocks = tea_code_blocks_avx2;
+	tea_decode_blocks = tea_decode_blocks_avx2;
+    }
+    else if (__builtin_cpu_supports("sse2"))
+    {
+	tea_code_blocks = tea_code_blocks_sse2;
+	tea_decode_blocks = tea_decode_blocks_sse2;
+    }
+#endif
+}
+
+int TEA_Encrypt(DWORD *dest, const DWORD *src, const DWORD * key, int size)
+{
+    int		blocks;
+    int		done;
     int		resize;
 
     if (size % 8 != 0)
@@ -314,15 +507,20 @@ int TEA_Encrypt(DWORD *dest, const DWORD *src, const DWORD * key, int size)
     else
 	resize = size;
 
-    for (i = 0; i < resize >> 3; i++, dest += 2, src += 2)
-	tea_code(*(src + 1), *src, key, dest);
+    if (!tea_code_blocks)
+	tea_select_blocks_func();
+
+    blocks = resize >> 3;
+    done = tea_code_blocks(dest, src, key, blocks);
+    tea_code_blocks_c(dest + done * 2, src + done * 2, key, blocks - done);
 
     return (resize);
 }
 
 int TEA_Decrypt(DWORD *dest, const DWORD *src, const DWORD * key, int size)
 {
-    int		i;
+    int		blocks;
+    int		done;
     int		resize;
 
     if (size % 8 != 0)
@@ -330,9 +528,100 @@ int TEA_Decrypt(DWORD *dest, const DWORD *src, const DWORD * key, int size)
     else
 	resize = size;
 
-    for (i = 0; i < resize >> 3; i++, dest += 2, src += 2)
-	tea_decode(*(src + 1), *src, key, dest);
+    if (!tea_decode_blocks)
+	tea_select_blocks_func();
+
+    blocks = resize >> 3;
+    done = tea_decode_blocks(dest, src, key, blocks);
+    tea_decode_blocks_c(dest + done * 2, src + done * 2, key, blocks - done);
 
     return (resize);
 }
 
+#ifdef __MAIN__
+/*
+ * ġũ: make tea_bench && ./tea_bench [bytes] [loop]
+ * C  õ    Ȯϰ ӵ Ѵ.
+ */
+static void tea_bench(const char * name, TEA_BLOCK_FUNC code, TEA_BLOCK_FUNC decode, DWORD * buf, const DWORD * key, int size, int loop)
+{
+    DWORD	start;
+    DWORD	elapsed;
+    int		blocks = size >> 3;
+    int		i;
+
+    start = get_dword_time();
+
+    for (i = 0; i < loop; ++i)
+    {
+	int done = code(buf, buf, key, blocks);
+	tea_code_blocks_c(buf + done * 2, buf + done * 2, key, blocks - done);
+
+	done = decode(buf, buf, key, blocks);
+	tea_decode_blocks_c(buf + done * 2, buf + done * 2, key, blocks - done);
+    }
+
+    elapsed = MAX(1, get_dword_time() - start);
+
+    printf("%-8s %10d bytes x %d: %6u ms, %8.1f MB/s\n",
+	    name, size, loop, elapsed, (double) size * loop * 2 / (1024.0 * 1024.0) / (elapsed / 1000.0));
+}
+
+int main(int argc, char ** argv)
+{
+    int		size = argc > 1 ? atoi(argv[1]) : 64 * 1024;
+    int		loop = argc > 2 ? atoi(argv[2]) : 1000;
+    DWORD	key[4] = { 0x12345678, 0x9abcdef0, 0x0fedcba9, 0x87654321 };
+    DWORD *	src;
+    DWORD *	c_out;
+    DWORD *	simd_out;
+    int		i;
+
+    size -= size % 8;
+
+    if (size <= 0)
+	size = 8;
+
+    src = (DWORD *) malloc(size);
+    c_out = (DWORD *) malloc(size);
+    simd_out = (DWORD *) malloc(size);
+
+    for (i = 0; i < size >> 2; ++i)
+	src[i] = (DWORD) rand() * 2654435761U;
+
+    tea_select_blocks_func();
+
+    tea_code_blocks_c(c_out, src, key, size >> 3);
+    TEA_Encrypt(simd_out, src, key, size);
+
+    if (memcmp(c_out, simd_out, size))
+    {
+	printf("encrypt mismatch\n");
+	return 1;
+    }
+
+    TEA_Decrypt(simd_out, c_out, key, size);
+
+    if (memcmp(src, simd_out, size))
+    {
+	printf("decrypt mismatch\n");
+	return 1;
+    }
+
+    tea_bench("c", tea_code_blocks_c, tea_decode_blocks_c, c_out, key, size, loop);
+
+#ifdef TEA_USE_SIMD
+    if (__builtin_cpu_supports("sse2"))
+	tea_bench("sse2", tea_code_blocks_sse2, tea_decode_blocks_sse2, c_out, key, size, loop);
+
+    if (__builtin_cpu_supports("avx2"))
+	tea_bench("avx2", tea_code_blocks_avx2, tea_decode_blocks_avx2, c_out, key, size, loop);
+#endif
+
+    free(src);
+    free(c_out);
+    free(simd_out);
+    return 0;
+}
+#endif
+
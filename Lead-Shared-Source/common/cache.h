@@ -5,7 +5,7 @@ template <typename T> class cache
 {
 	public:
 		cache()
-			: m_bNeedQuery(false), m_expireTime(600), m_lastUpdateTime(0)
+			: m_bNeedQuery(false), m_expireTime(600), m_lastUpdateTime(0), m_queuedTime(0)
 		{
 			m_lastFlushTime = time(0);
 
@@ -45,6 +45,21 @@ template <typename T> class cache
 			return false;
 		}
 
+		// CheckFlushTimeout   Ǵ ð.    0
+		time_t GetFlushTime()
+		{
+			return m_bNeedQuery ? m_lastFlushTime + m_expireTime + 1 : 0;
+		}
+
+		// CheckTimeout   Ǵ ð
+		time_t GetTimeoutTime()
+		{
+			return m_lastUpdateTime + m_expireTime + 1;
+		}
+
+		time_t GetQueuedTime() const		{ return m_queuedTime; }
+		void SetQueuedTime(time_t tQueued)	{ m_queuedTime = tQueued; }
+
 		void Flush()
 		{
 			if (!m_bNeedQuery)
@@ -64,6 +79,7 @@ template <typename T> class cache
 		time_t  m_expireTime;
 		time_t	m_lastUpdateTime;
 		time_t	m_lastFlushTime;
+		time_t	m_queuedTime;	//  ť  ִ ð. 0̸ ť .
 };
 
 #endif
@@ -0,0 +1,535 @@
+#ifndef __INC_METIN_II_COMMON_CHUNK_POOL_H__
+#define __INC_METIN_II_COMMON_CHUNK_POOL_H__
+
+#include <assert.h>
+#include <string.h>
+#include <new>
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#include <pthread.h>
+#endif
+
+// Objects are carved out of cache-line aligned chunks and kept on an
+// intrusive free list, so Alloc/Free never touch the heap once warm.
+//
+// Like CDynamicPool, an object is constructed the first time its slot is
+// handed out and is NOT destroyed by Free; the next Alloc returns it as it
+// was left.  Destructors run only in Destroy().
+//
+// Without a thread cache the pool belongs to one thread, exactly like
+// CDynamicPool.  With Create(..., true) every thread keeps a small private
+// free list and overflow is handed back through a lock-free global list,
+// so loader and I/O threads can share the pool with the main thread.
+// The global list only ever pushes nodes or takes the whole list at once,
+// which keeps it free of the ABA problem with a plain pointer CAS.
+// A thread that exits leaves its cached slots parked until FreeAll or
+// Destroy, so the cache size also bounds what can be stranded that way.
+
+#ifdef _MSC_VER
+#define POOL_ALIGNOF(T) __alignof(T)
+#else
+#define POOL_ALIGNOF(T) __alignof__(T)
+#endif
+
+enum
+{
+	POOL_CACHE_LINE_SIZE = 64,
+};
+
+class CPoolAtomic
+{
+	public:
+		static void * CompareExchangePointer(void * volatile * ppvDest, void * pvExchange, void * pvComparand)
+		{
+#ifdef _WIN32
+			return InterlockedCompareExchangePointer((PVOID volatile *) ppvDest, pvExchange, pvComparand);
+#else
+			return __sync_val_compare_and_swap(ppvDest, pvComparand, pvExchange);
+#endif
+		}
+
+		static void * ExchangePointer(void * volatile * ppvDest, void * pvValue)
+		{
+#ifdef _WIN32
+			return InterlockedExchangePointer((PVOID volatile *) ppvDest, pvValue);
+#else
+			__sync_synchronize();
+			return __sync_lock_test_and_set(ppvDest, pvValue);
+#endif
+		}
+
+		static long Add(volatile long * plDest, long lValue)
+		{
+#ifdef _WIN32
+			return InterlockedExchangeAdd(plDest, lValue) + lValue;
+#else
+			return __sync_add_and_fetch(plDest, lValue);
+#endif
+		}
+
+		// Pushes an already linked chain onto a lock-free list.  ppvTailLink
+		// is the address of the last node's next pointer.
+		static void PushChain(void * volatile * ppvHead, void * pvHead, void * ppvTailLink)
+		{
+			void * pvOld;
+
+			do
+			{
+				pvOld = *ppvHead;
+				*(void **) ppvTailLink = pvOld;
+			}
+			while (CompareExchangePointer(ppvHead, pvHead, pvOld) != pvOld);
+		}
+
+		static void * AlignedAlloc(size_t size, size_t align)
+		{
+#ifdef _WIN32
+			return _aligned_malloc(size, align);
+#else
+			void * p;
+			return posix_memalign(&p, align, size) == 0 ? p : NULL;
+#endif
+		}
+
+		static void AlignedFree(void * p)
+		{
+#ifdef _WIN32
+			_aligned_free(p);
+#else
+			free(p);
+#endif
+		}
+};
+
+class CPoolThreadKey
+{
+	public:
+		CPoolThreadKey() : m_bCreated(false)
+		{
+		}
+
+		~CPoolThreadKey()
+		{
+			Destroy();
+		}
+
+		bool Create()
+		{
+			if (m_bCreated)
+				return true;
+#ifdef _WIN32
+			m_dwKey = TlsAlloc();
+			m_bCreated = (m_dwKey != TLS_OUT_OF_INDEXES);
+#else
+			m_bCreated = (pthread_key_create(&m_kKey, NULL) == 0);
+#endif
+			return m_bCreated;
+		}
+
+		void Destroy()
+		{
+			if (!m_bCreated)
+				return;
+#ifdef _WIN32
+			TlsFree(m_dwKey);
+#else
+			pthread_key_delete(m_kKey);
+#endif
+			m_bCreated = false;
+		}
+
+		void * Get() const
+		{
+#ifdef _WIN32
+			return TlsGetValue(m_dwKey);
+#else
+			return pthread_getspecific(m_kKey);
+#endif
+		}
+
+		void Set(void * pvValue)
+		{
+#ifdef _WIN32
+			TlsSetValue(m_dwKey, pvValue);
+#else
+			pthread_setspecific(m_kKey, pvValue);
+#endif
+		}
+
+	private:
+#ifdef _WIN32
+		DWORD			m_dwKey;
+#else
+		pthread_key_t	m_kKey;
+#endif
+		bool			m_bCreated;
+};
+
+template<typename T>
+class CChunkPool
+{
+	public:
+		enum
+		{
+			DEFAULT_CHUNK_SLOT_NUM	= 64,
+			DEFAULT_CACHE_SLOT_NUM	= 64,
+		};
+
+	protected:
+		enum
+		{
+			SLOT_CONSTRUCTED	= (1 << 0),
+			SLOT_USED			= (1 << 1),
+		};
+
+		struct TSlot
+		{
+			TSlot *	pNext;
+			DWORD	dwFlags;
+		};
+
+		struct TChunk
+		{
+			TChunk *	pNext;
+			UINT		uSlotNum;
+		};
+
+		struct TCache
+		{
+			TSlot *		pHead;
+			TSlot *		pTail;
+			UINT		uCount;
+			TCache *	pNext;
+		};
+
+	public:
+		CChunkPool()
+		{
+			m_pGlobalFree = NULL;
+			m_pChunks = NULL;
+			m_pCaches = NULL;
+			m_lCapacity = 0;
+
+			memset(&m_kLocal, 0, sizeof(m_kLocal));
+
+			m_bThreadCache = false;
+			m_uCacheSlotNum = DEFAULT_CACHE_SLOT_NUM;
+
+			__SetChunkSlotNum(DEFAULT_CHUNK_SLOT_NUM);
+		}
+
+		virtual ~CChunkPool()
+		{
+			Destroy();
+
+			while (m_pCaches)
+			{
+				TCache * pNext = m_pCaches->pNext;
+				delete m_pCaches;
+				m_pCaches = pNext;
+			}
+		}
+
+		// Must be called before the first Alloc, or after Destroy.
+		bool Create(UINT uChunkSlotNum = DEFAULT_CHUNK_SLOT_NUM, bool bThreadCache = false, UINT uCacheSlotNum = DEFAULT_CACHE_SLOT_NUM)
+		{
+			assert(m_pChunks == NULL && "CChunkPool::Create() - already in use");
+
+			__SetChunkSlotNum(uChunkSlotNum);
+
+			m_uCacheSlotNum = uCacheSlotNum > 0 ? uCacheSlotNum : 1;
+			m_bThreadCache = bThreadCache && m_kThreadKey.Create();
+
+			return m_bThreadCache == bThreadCache;
+		}
+
+		void SetName(const char * c_szName)
+		{
+			m_stName = c_szName;
+		}
+
+		DWORD GetCapacity()
+		{
+			return (DWORD) m_lCapacity;
+		}
+
+		T * Alloc()
+		{
+			TCache & rCache = __GetCache();
+
+			if (!rCache.pHead && !__RefillCache(rCache))
+				return NULL;
+
+			TSlot * pSlot = rCache.pHead;
+
+			if (NULL == (rCache.pHead = pSlot->pNext))
+				rCache.pTail = NULL;
+
+			--rCache.uCount;
+
+			T * pData = __GetData(pSlot);
+
+			if (!(pSlot->dwFlags & SLOT_CONSTRUCTED))
+			{
+				new (pData) T;
+				pSlot->dwFlags |= SLOT_CONSTRUCTED;
+			}
+
+			pSlot->dwFlags |= SLOT_USED;
+			return pData;
+		}
+
+		void Free(T * pData)
+		{
+			if (!pData)
+				return;
+
+			TSlot * pSlot = __GetSlot(pData);
+
+			assert((pSlot->dwFlags & SLOT_USED) && "CChunkPool::Free() - not allocated or freed twice");
+			pSlot->dwFlags &= ~SLOT_USED;
+
+			TCache & rCache = __GetCache();
+
+			pSlot->pNext = rCache.pHead;
+			rCache.pHead = pSlot;
+
+			if (!rCache.pTail)
+				rCache.pTail = pSlot;
+
+			if (++rCache.uCount > m_uCacheSlotNum && m_bThreadCache)
+				__FlushCache(rCache);
+		}
+
+		// Neither FreeAll nor Destroy is thread safe; no other thread may be
+		// using the pool while they run.
+		void FreeAll()
+		{
+			__ResetCaches();
+
+			TCache & rCache = m_kLocal;
+
+			for (TChunk * pChunk = m_pChunks; pChunk; pChunk = pChunk->pNext)
+			{
+				for (UINT i = 0; i < pChunk->uSlotNum; ++i)
+				{
+					TSlot * pSlot = __GetChunkSlot(pChunk, i);
+
+					pSlot->dwFlags &= ~SLOT_USED;
+					pSlot->pNext = rCache.pHead;
+					rCache.pHead = pSlot;
+
+					if (!rCache.pTail)
+						rCache.pTail = pSlot;
+				}
+			}
+
+			if (m_bThreadCache)
+			{
+				m_pGlobalFree = rCache.pHead;
+				rCache.pHead = rCache.pTail = NULL;
+			}
+			else
+			{
+				rCache.uCount = m_lCapacity;
+			}
+		}
+
+		void Destroy()
+		{
+			__ResetCaches();
+
+			TChunk * pChunk = m_pChunks;
+
+			while (pChunk)
+			{
+				TChunk * pNext = pChunk->pNext;
+
+				for (UINT i = 0; i < pChunk->uSlotNum; ++i)
+				{
+					TSlot * pSlot = __GetChunkSlot(pChunk, i);
+
+					if (pSlot->dwFlags & SLOT_CONSTRUCTED)
+						__GetData(pSlot)->~T();
+				}
+
+				CPoolAtomic::AlignedFree(pChunk);
+				pChunk = pNext;
+			}
+
+			m_pChunks = NULL;
+			m_lCapacity = 0;
+		}
+
+		void Clear()
+		{
+			Destroy();
+		}
+
+	protected:
+		void __SetChunkSlotNum(UINT uChunkSlotNum)
+		{
+			m_uChunkSlotNum = uChunkSlotNum > 0 ? uChunkSlotNum : 1;
+
+			// The header keeps the object at its natural alignment, and
+			// objects large enough to matter start on their own cache line
+			// when that costs at most a quarter of the slot.
+			size_t align = POOL_ALIGNOF(T) > sizeof(void *) ? POOL_ALIGNOF(T) : sizeof(void *);
+
+			m_uSlotOffset = (UINT) __RoundUp(sizeof(TSlot), align);
+
+			size_t stride = __RoundUp(m_uSlotOffset + sizeof(T), align);
+			size_t lineStride = __RoundUp(stride, POOL_CACHE_LINE_SIZE);
+
+			if (stride >= POOL_CACHE_LINE_SIZE && (lineStride - stride) * 4 <= lineStride)
+				stride = lineStride;
+
+			m_uSlotStride = (UINT) stride;
+			m_uChunkOffset = (UINT) __RoundUp(sizeof(TChunk), POOL_CACHE_LINE_SIZE);
+		}
+
+		static size_t __RoundUp(size_t size, size_t align)
+		{
+			return (size + align - 1) / align * align;
+		}
+
+		T * __GetData(TSlot * pSlot)
+		{
+			return (T *) ((char *) pSlot + m_uSlotOffset);
+		}
+
+		TSlot * __GetSlot(T * pData)
+		{
+			return (TSlot *) ((char *) pData - m_uSlotOffset);
+		}
+
+		TSlot * __GetChunkSlot(TChunk * pChunk, UINT uIndex)
+		{
+			return (TSlot *) ((char *) pChunk + m_uChunkOffset + m_uSlotStride * uIndex);
+		}
+
+		TCache & __GetCache()
+		{
+			if (!m_bThreadCache)
+				return m_kLocal;
+
+			TCache * pCache = (TCache *) m_kThreadKey.Get();
+
+			if (!pCache)
+			{
+				pCache = new TCache;
+				memset(pCache, 0, sizeof(TCache));
+
+				CPoolAtomic::PushChain((void * volatile *) &m_pCaches, pCache, &pCache->pNext);
+				m_kThreadKey.Set(pCache);
+			}
+
+			return *pCache;
+		}
+
+		bool __RefillCache(TCache & rCache)
+		{
+			TSlot * pHead = NULL;
+
+			if (m_bThreadCache)
+				pHead = (TSlot *) CPoolAtomic::ExchangePointer((void * volatile *) &m_pGlobalFree, NULL);
+
+			if (pHead)
+			{
+				TSlot * pTail = pHead;
+				UINT uCount = 1;
+
+				while (pTail->pNext)
+				{
+					pTail = pTail->pNext;
+					++uCount;
+				}
+
+				rCache.pHead = pHead;
+				rCache.pTail = pTail;
+				rCache.uCount = uCount;
+				return true;
+			}
+
+			return __AllocChunk(rCache);
+		}
+
+		bool __AllocChunk(TCache & rCache)
+		{
+			TChunk * pChunk = (TChunk *) CPoolAtomic::AlignedAlloc(m_uChunkOffset + m_uSlotStride * m_uChunkSlotNum, POOL_CACHE_LINE_SIZE);
+
+			if (!pChunk)
+				return false;
+
+			pChunk->uSlotNum = m_uChunkSlotNum;
+
+			TSlot * pNext = NULL;
+
+			for (UINT i = m_uChunkSlotNum; i > 0; --i)
+			{
+				TSlot * pSlot = __GetChunkSlot(pChunk, i - 1);
+
+				pSlot->pNext = pNext;
+				pSlot->dwFlags = 0;
+				pNext = pSlot;
+			}
+
+			rCache.pHead = pNext;
+			rCache.pTail = __GetChunkSlot(pChunk, m_uChunkSlotNum - 1);
+			rCache.uCount = m_uChunkSlotNum;
+
+			CPoolAtomic::PushChain((void * volatile *) &m_pChunks, pChunk, &pChunk->pNext);
+			CPoolAtomic::Add(&m_lCapacity, m_uChunkSlotNum);
+			return true;
+		}
+
+		void __FlushCache(TCache & rCache)
+		{
+			CPoolAtomic::PushChain((void * volatile *) &m_pGlobalFree, rCache.pHead, &rCache.pTail->pNext);
+
+			rCache.pHead = rCache.pTail = NULL;
+			rCache.uCount = 0;
+		}
+
+		void __ResetCaches()
+		{
+			for (TCache * pCache = m_pCaches; pCache; pCache = pCache->pNext)
+			{
+				pCache->pHead = pCache->pTail = NULL;
+				pCache->uCount = 0;
+			}
+
+			m_kLocal.pHead = m_kLocal.pTail = NULL;
+			m_kLocal.uCount = 0;
+			m_pGlobalFree = NULL;
+		}
+
+	protected:
+		// Each field written by other threads sits on its own cache line.
+		TSlot * volatile	m_pGlobalFree;
+		char				m_acPad0[POOL_CACHE_LINE_SIZE - sizeof(TSlot *)];
+
+		TChunk * volatile	m_pChunks;
+		TCache * volatile	m_pCaches;
+		volatile long		m_lCapacity;
+		char				m_acPad1[POOL_CACHE_LINE_SIZE - sizeof(TChunk *) - sizeof(TCache *) - sizeof(long)];
+
+		TCache				m_kLocal;
+		CPoolThreadKey		m_kThreadKey;
+		bool				m_bThreadCache;
+
+		UINT				m_uChunkSlotNum;
+		UINT				m_uCacheSlotNum;
+		UINT				m_uSlotOffset;
+		UINT				m_uSlotStride;
+		UINT				m_uChunkOffset;
+
+		std::string			m_stName;
+};
+
+#endif
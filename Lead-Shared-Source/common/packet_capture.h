@@ -0,0 +1,44 @@
+#ifndef __METIN_II_COMMON_PACKET_CAPTURE_H__
+#define __METIN_II_COMMON_PACKET_CAPTURE_H__
+
+//
+// game  CInputProcessor::Process   Ŭ̾Ʈ Ŷ (DESC)
+// ð Բ   . Lead-Tools/LoadBot  -p  ٽ .
+//
+//  = TPacketCaptureHeader,  TPacketCaptureRecord + wSize Ʈ  ݺ.
+// Ŷ ȣȭ  ̰ sequence Ʈ  ִ (   δ).
+//
+enum
+{
+	PACKET_CAPTURE_MAGIC	= 0x5043504d,	// "MPCP"
+	PACKET_CAPTURE_VERSION	= 1,
+};
+
+enum EPacketCaptureRecord
+{
+	PACKET_CAPTURE_CONNECT,		//  handle  ù Ŷ ,  
+	PACKET_CAPTURE_PACKET,		// Ŷ ϳ ( +  +  )
+	PACKET_CAPTURE_CLOSE,		// DESC  ,  
+};
+
+#pragma pack(1)
+typedef struct SPacketCaptureHeader
+{
+	DWORD	dwMagic;
+	WORD	wVersion;
+	WORD	wPort;		// ĸ  Ŭ̾Ʈ Ʈ
+	DWORD	dwStartTime;	// ĸĸ  time()
+} TPacketCaptureHeader;
+
+typedef struct SPacketCaptureRecord
+{
+	DWORD	dwTime;			// ĸ ۺ ms
+	DWORD	dwHandle;		// DESC::GetHandle
+	BYTE	bType;			// EPacketCaptureRecord
+	BYTE	bPhase;		// ޾  DESC  PHASE_*
+	BYTE	bSequence;	// 1 ̸   sequence Ʈ ٿ ϴ Ŷ
+	WORD	wSize;
+} TPacketCaptureRecord;
+#pragma pack()
+
+#endif
@@ -234,6 +234,7 @@ enum
 	HEADER_DG_RESULT_CHARGE_CASH	= 179,
 	HEADER_DG_ITEMAWARD_INFORMER	= 180,	//gift notify
 	HEADER_DG_RESPOND_CHANNELSTATUS		= 181,
+	HEADER_DG_CLUSTER_STATE		= 182,	// äκ/  
 
 	HEADER_DG_MAP_LOCATIONS		= 0xfe,
 	HEADER_DG_P2P			= 0xff,
@@ -629,6 +630,7 @@ typedef struct SPlayerLoadPacket
 	DWORD	account_id;
 	DWORD	player_id;
 	BYTE	account_index;	/* account  ġ */
+	BYTE	bHandoff;	/*   ھ , Ʈ, Ʈ ޾ ξ */
 } TPlayerLoadPacket;
 
 typedef struct SPlayerCreatePacket
@@ -658,8 +660,24 @@ typedef struct SLogoutPacket
 typedef struct SPlayerCountPacket
 {
 	DWORD	dwCount;
+	DWORD	adwEmpireCount[EMPIRE_MAX_NUM];
 } TPlayerCountPacket;
 
+// db   ھ TPlayerCountPacket   ֱ  Ŷ .
+typedef struct SClusterChannelState
+{
+	BYTE	bChannel;
+	DWORD	dwCount;
+	DWORD	adwEmpireCount[EMPIRE_MAX_NUM];
+} TClusterChannelState;
+
+typedef struct SPacketDGClusterState
+{
+	DWORD	dwTotal;		//  ä 
+	BYTE	bChannelCount;
+	// TClusterChannelState * bChannelCount
+} TPacketDGClusterState;
+
 #define SAFEBOX_MAX_NUM			135
 #define SAFEBOX_PASSWORD_MAX_LEN	6
 
@@ -0,0 +1,57 @@
+#ifndef __INC_METIN_II_COMMON_VARINT_H__
+#define __INC_METIN_II_COMMON_VARINT_H__
+
+// Variable length integers for the packed packets (HEADER_GC_*_PACKED).
+// Seven bits per byte, low bits first; the high bit says another byte follows.
+// Signed values are zigzag mapped first so small negatives stay short.
+
+enum
+{
+	VARINT_MAX_LEN = 5,	// a DWORD never needs more
+};
+
+inline DWORD varint_zigzag(long lValue)
+{
+	return ((DWORD) lValue << 1) ^ (DWORD) (lValue >> 31);
+}
+
+inline long varint_unzigzag(DWORD dwValue)
+{
+	return (long) (dwValue >> 1) ^ -(long) (dwValue & 1);
+}
+
+// Returns the number of bytes written to pbOut, which must hold VARINT_MAX_LEN.
+inline int varint_encode(BYTE * pbOut, DWORD dwValue)
+{
+	int iLen = 0;
+
+	while (dwValue >= 0x80)
+	{
+		pbOut[iLen++] = (BYTE) (dwValue | 0x80);
+		dwValue >>= 7;
+	}
+
+	pbOut[iLen++] = (BYTE) dwValue;
+	return iLen;
+}
+
+// Returns the number of bytes read, or 0 if the input ends early or is too long.
+inline int varint_decode(const BYTE * c_pbIn, int iInLen, DWORD * pdwValue)
+{
+	DWORD dwValue = 0;
+
+	for (int i = 0; i < iInLen && i < VARINT_MAX_LEN; ++i)
+	{
+		dwValue |= (DWORD) (c_pbIn[i] & 0x7f) << (7 * i);
+
+		if (!(c_pbIn[i] & 0x80))
+		{
+			*pdwValue = dwValue;
+			return i + 1;
+		}
+	}
+
+	return 0;
+}
+
+#endif
@@ -99,8 +99,11 @@ enum
 
 	HEADER_CG_CLIENT_VERSION			= 0xfd,
 	HEADER_CG_CLIENT_VERSION2			= 0xf1,
+	HEADER_CG_PACKET_COMPRESSION		= 0xf0,
+	HEADER_CG_PROTOCOL_VERSION			= 0xef,
 
 	/********************************************************/
+	HEADER_GC_COMPRESSED_PACKET		= 0xfa,
 	HEADER_GC_TIME_SYNC				= 0xfc,
 	HEADER_GC_PHASE					= 0xfd,
 	HEADER_GC_HANDSHAKE				= 0xff,
@@ -247,6 +250,14 @@ enum
 	HEADER_GC_MAIN_CHARACTER4_BGM_VOL	= 138,
 	// END_OF_SUPPORT_BGM
 
+	HEADER_GC_MOVE_BULK				= 139,
+	HEADER_GC_CHARACTER_POINT_CHANGE_BULK	= 140,
+	HEADER_GC_DAMAGE_INFO_BULK		= 141,
+	HEADER_GC_CHARACTER_ADD_BULK		= 142,
+	HEADER_GC_PARTY_UPDATE_BULK		= 143,
+	HEADER_GC_MOVE_BULK_PACKED		= 144,
+	HEADER_GC_CHARACTER_POINT_CHANGE_BULK_PACKED	= 145,
+
 	HEADER_GC_AUTH_SUCCESS			= 150,
 
 	//HYBRID CRYPT
@@ -284,6 +295,8 @@ enum
 	HEADER_GG_CHECK_CLIENT_VERSION		= 21,
 	HEADER_GG_BLOCK_CHAT			= 22,
 	HEADER_GG_CHECK_AWAKENESS		= 29,
+	HEADER_GG_BATCH				= 30,
+	HEADER_GG_CHARACTER_HANDOFF		= 31,	// 워프할 때 도착 코어에 캐릭터 상태를 미리 넘긴다
 };
 
 #pragma pack(1)
@@ -292,6 +305,8 @@ typedef struct SPacketGGSetup
 	BYTE	bHeader;
 	WORD	wPort;
 	BYTE	bChannel;
+	long	lListenAddr;	// 클라이언트가 접속하는 주소와 포트. 워프 대상 코어를 찾을 때 쓴다.
+	WORD	wListenPort;
 } TPacketGGSetup;
 
 typedef struct SPacketGGLogin
@@ -317,6 +332,30 @@ typedef struct SPacketGGRelay
 	long	lSize;
 } TPacketGGRelay;
 
+// 한 pulse 동안 P2P_MANAGER::Send 로 보낸 패킷들을 묶은 것. 뒤에 lSize 만큼 데이터가 붙는다.
+typedef struct SPacketGGBatch
+{
+	BYTE	bHeader;
+	WORD	wCount;
+	long	lSize;
+	long	lRealSize;	// LZO 로 압축했으면 원래 크기, 아니면 0
+} TPacketGGBatch;
+
+// 워프하는 캐릭터의 아이템, 퀘스트, 어펙트. 도착 코어는 로그인 키로 찾아서 DB 대신 쓴다.
+// 뒤에 lSize 만큼 데이터가 붙고 풀면 TPlayerItem[dwItemCount], TQuestTable[dwQuestCount],
+// TPacketAffectElement[dwAffectCount] 순서다.
+typedef struct SPacketGGCharacterHandoff
+{
+	BYTE	bHeader;
+	long	lSize;
+	long	lRealSize;	// LZO 로 압축했으면 원래 크기, 아니면 0
+	DWORD	dwLoginKey;
+	DWORD	dwPID;
+	DWORD	dwItemCount;
+	DWORD	dwQuestCount;
+	DWORD	dwAffectCount;
+} TPacketGGCharacterHandoff;
+
 typedef struct SPacketGGNotice
 {
 	BYTE	bHeader;
@@ -672,7 +711,8 @@ enum
 {
 	SHOP_SUBHEADER_CG_END,
 	SHOP_SUBHEADER_CG_BUY,
-	SHOP_SUBHEADER_CG_SELL
+	SHOP_SUBHEADER_CG_SELL,
+	SHOP_SUBHEADER_CG_SEARCH,
 };
 
 typedef struct command_shop_buy
@@ -686,6 +726,13 @@ typedef struct command_shop_sell
 	BYTE	count;
 } TPacketCGShopSell;
 
+typedef struct command_shop_search
+{
+	DWORD	vnum;
+	DWORD	max_price;	// 0 이면 가격 제한 없음
+	WORD	page;
+} TPacketCGShopSearch;
+
 typedef struct command_shop
 {
 	BYTE	header;
@@ -881,6 +928,32 @@ typedef struct packet_add_char
 	DWORD	dwAffectFlag[2];	// 효과
 } TPacketGCCharacterAdd;
 
+// 캐릭터 추가 묶음 패킷의 개수 만큼 붙는 단위. header 가 없는 TPacketGCCharacterAdd 이다.
+typedef struct packet_add_char_bulk_element
+{
+	DWORD	dwVID;
+
+	float	angle;
+	long	x;
+	long	y;
+	long	z;
+
+	BYTE	bType;
+	WORD	wRaceNum;
+	BYTE	bMovingSpeed;
+	BYTE	bAttackSpeed;
+
+	BYTE	bStateFlag;
+	DWORD	dwAffectFlag[2];
+} TPacketGCCharacterAddBulkElement;
+
+// 몬스터 무리가 한꺼번에 나타날 때처럼 이어서 가는 HEADER_GC_CHARACTER_ADD 를 모아서 보낸다.
+typedef struct packet_add_char_bulk	// 가변 패킷
+{
+	BYTE	bHeader;
+	WORD	wSize;	// 개수 = (wSize - sizeof(TPacketGCCharacterAddBulk)) / sizeof(TPacketGCCharacterAddBulkElement)
+} TPacketGCCharacterAddBulk;
+
 typedef struct packet_char_additional_info
 {
 	BYTE    header;
@@ -1026,6 +1099,34 @@ typedef struct packet_point_change
 	long	value;
 } TPacketGCPointChange;
 
+// 점수 변경 묶음 패킷의 개수 만큼 붙는 단위. 같은 VID 와 type 의 연속된 변경은 하나로 합쳐진다.
+typedef struct packet_point_change_bulk_element
+{
+	DWORD	dwVID;
+	BYTE	type;
+	long	amount;	// 합쳐진 변경량의 합
+	long	value;	// 마지막 값
+} TPacketGCPointChangeBulkElement;
+
+// 한 pulse 동안 한 클라이언트에게 가는 점수 변경 패킷을 모아서 보낸다.
+typedef struct packet_point_change_bulk	// 가변 패킷
+{
+	BYTE	bHeader;
+	WORD	wSize;	// 개수 = (wSize - sizeof(TPacketGCPointChangeBulk)) / sizeof(TPacketGCPointChangeBulkElement)
+} TPacketGCPointChangeBulk;
+
+// PROTOCOL_VERSION_PACKED 이상인 클라이언트에게 TPacketGCPointChangeBulk 대신 보낸다.
+// 뒤에 원소마다 varint 로 인코딩한 값이 이어진다. (common/varint.h)
+//   VID    : 앞 원소 VID 와의 차이 (zigzag). 첫 원소는 0 과의 차이
+//   type   : BYTE
+//   amount : zigzag
+//   value  : zigzag
+typedef struct packet_point_change_bulk_packed	// 가변 패킷
+{
+	BYTE	bHeader;
+	WORD	wSize;	// 헤더를 포함한 전체 크기
+} TPacketGCPointChangeBulkPacked;
+
 typedef struct packet_stun
 {
 	BYTE	header;
@@ -1155,6 +1256,12 @@ enum EPacketShopSubHeaders
 	SHOP_SUBHEADER_GC_SOLD_OUT,
 	SHOP_SUBHEADER_GC_START_EX,
 	SHOP_SUBHEADER_GC_NOT_ENOUGH_MONEY_EX,
+	SHOP_SUBHEADER_GC_SEARCH_RESULT,
+};
+
+enum
+{
+	SHOP_SEARCH_PAGE_SIZE = 10,
 };
 
 typedef struct packet_shop_item
@@ -1191,6 +1298,24 @@ typedef struct packet_shop_update_item
 	struct packet_shop_item	item;
 } TPacketGCShopUpdateItem;
 
+typedef struct packet_shop_search_item
+{
+	DWORD			owner_vid;
+	char			owner_name[CHARACTER_NAME_MAX_LEN + 1];
+	long			x;
+	long			y;
+	BYTE			pos;
+	struct packet_shop_item	item;
+} TPacketGCShopSearchItem;
+
+typedef struct packet_shop_search_result // 뒤에 TPacketGCShopSearchItem * count 가 따라옴.
+{
+	DWORD			vnum;
+	WORD			page;
+	WORD			total_count;	// 조건에 맞는 전체 개수
+	BYTE			count;
+} TPacketGCShopSearchResult;
+
 typedef struct packet_shop_update_price
 {
 	int				iPrice;
@@ -1239,6 +1364,36 @@ typedef struct packet_ping
 	BYTE	header;
 } TPacketGCPing;
 
+// 클라이언트가 압축 패킷을 받을 수 있음을 알린다.
+typedef struct packet_packet_compression
+{
+	BYTE	header;
+	BYTE	bEnable;
+} TPacketCGPacketCompression;
+
+// 클라이언트가 받을 수 있는 프로토콜 버전. 로그인 전에 보내고, 서버는 자신이 아는
+// 버전과 비교해서 작은 쪽을 쓴다. 보내지 않는 예전 클라이언트는 PROTOCOL_VERSION_LEGACY 다.
+enum EProtocolVersion
+{
+	PROTOCOL_VERSION_LEGACY		= 0,
+	PROTOCOL_VERSION_PACKED		= 1,	// HEADER_GC_*_PACKED 묶음 패킷
+	PROTOCOL_VERSION_CURRENT	= PROTOCOL_VERSION_PACKED,
+};
+
+typedef struct packet_protocol_version
+{
+	BYTE	header;
+	WORD	wVersion;
+} TPacketCGProtocolVersion;
+
+// size 는 헤더를 포함한 전체 크기. 뒤에 LZO 로 압축된 원래 패킷이 붙는다.
+typedef struct packet_compressed_packet
+{
+	BYTE	header;
+	WORD	size;
+	DWORD	dwRealSize;
+} TPacketGCCompressedPacket;
+
 typedef struct packet_pong
 {
 	BYTE		bHeader;
@@ -1281,6 +1436,44 @@ typedef struct packet_move
 	DWORD		dwDuration;
 } TPacketGCMove;
 
+// 이동 묶음 패킷의 개수 만큼 붙는 단위. 좌표와 시간은 TPacketGCMoveBulk 의 기준값과의 차이다.
+typedef struct packet_move_bulk_element
+{
+	DWORD		dwVID;
+	BYTE		bFunc;
+	BYTE		bArg;
+	BYTE		bRot;
+	short		sDeltaX;
+	short		sDeltaY;
+	short		sDeltaTime;
+	WORD		wDuration;
+} TPacketGCMoveBulkElement;
+
+// 한 pulse 동안 한 클라이언트에게 가는 이동 패킷을 모아서 보낸다.
+typedef struct packet_move_bulk	// 가변 패킷
+{
+	BYTE		bHeader;
+	WORD		wSize;	// 개수 = (wSize - sizeof(TPacketGCMoveBulk)) / sizeof(TPacketGCMoveBulkElement)
+	long		lBaseX;
+	long		lBaseY;
+	DWORD		dwBaseTime;
+} TPacketGCMoveBulk;
+
+// PROTOCOL_VERSION_PACKED 이상인 클라이언트에게 TPacketGCMoveBulk 대신 보낸다.
+// 기준값은 TPacketGCMoveBulk 와 같고, 뒤에 원소마다 다음 값이 이어진다. (common/varint.h)
+//   VID                 : varint
+//   bFunc, bArg, bRot   : BYTE
+//   X, Y, Time 차이     : zigzag
+//   Duration            : varint
+typedef struct packet_move_bulk_packed	// 가변 패킷
+{
+	BYTE		bHeader;
+	WORD		wSize;	// 헤더를 포함한 전체 크기
+	long		lBaseX;
+	long		lBaseY;
+	DWORD		dwBaseTime;
+} TPacketGCMoveBulkPacked;
+
 // 소유권
 typedef struct packet_ownership
 {
@@ -1539,6 +1732,22 @@ typedef struct packet_party_update
 	short	affects[7];
 } TPacketGCPartyUpdate;
 
+// 파티 정보 묶음 패킷의 개수 만큼 붙는 단위. header 가 없는 TPacketGCPartyUpdate 이다.
+typedef struct packet_party_update_bulk_element
+{
+	DWORD	pid;
+	BYTE	role;
+	BYTE	percent_hp;
+	short	affects[7];
+} TPacketGCPartyUpdateBulkElement;
+
+// 주기적인 파티 갱신에서 지난번과 달라진 파티원만 모아서 받는 사람마다 하나로 보낸다.
+typedef struct packet_party_update_bulk	// 가변 패킷
+{
+	BYTE	bHeader;
+	WORD	wSize;	// 개수 = (wSize - sizeof(TPacketGCPartyUpdateBulk)) / sizeof(TPacketGCPartyUpdateBulkElement)
+} TPacketGCPartyUpdateBulk;
+
 typedef struct packet_party_remove
 {
 	BYTE header;
@@ -2103,6 +2312,21 @@ typedef struct packet_damage_info
 	int damage;
 } TPacketGCDamageInfo;
 
+// 데미지 정보 묶음 패킷의 개수 만큼 붙는 단위. 받은 순서대로 하나씩 처리한다.
+typedef struct packet_damage_info_bulk_element
+{
+	DWORD	dwVID;
+	BYTE	flag;
+	int		damage;
+} TPacketGCDamageInfoBulkElement;
+
+// 범위 스킬처럼 한 번에 여러 대상을 때렸을 때 한 클라이언트에게 가는 데미지 정보를 모아서 보낸다.
+typedef struct packet_damage_info_bulk	// 가변 패킷
+{
+	BYTE	bHeader;
+	WORD	wSize;	// 개수 = (wSize - sizeof(TPacketGCDamageInfoBulk)) / sizeof(TPacketGCDamageInfoBulkElement)
+} TPacketGCDamageInfoBulk;
+
 typedef struct SPacketGGCheckAwakeness
 {
 	BYTE bHeader;
@@ -2285,5 +2509,23 @@ typedef struct SPacketGCStateCheck
 	unsigned char state;
 } TPacketGCStateCheck;
 
+// 그대로 복사해서 주고받는 패킷의 크기가 바뀌면 예전 클라이언트와 어긋나므로 컴파일 할 때 검사한다.
+// (long 은 서버와 클라이언트 모두 32비트다)
+#define PACKET_SIZE_CHECK(type, size)	typedef char __packet_size_check_##type[(sizeof(type) == (size)) ? 1 : -1]
+
+PACKET_SIZE_CHECK(TPacketCGMove, 16);
+PACKET_SIZE_CHECK(TPacketCGAttack, 8);
+PACKET_SIZE_CHECK(TPacketCGProtocolVersion, 3);
+PACKET_SIZE_CHECK(TPacketGCMove, 24);
+PACKET_SIZE_CHECK(TPacketGCMoveBulk, 15);
+PACKET_SIZE_CHECK(TPacketGCMoveBulkElement, 15);
+PACKET_SIZE_CHECK(TPacketGCMoveBulkPacked, 15);
+PACKET_SIZE_CHECK(TPacketGCPointChange, 17);
+PACKET_SIZE_CHECK(TPacketGCPointChangeBulk, 3);
+PACKET_SIZE_CHECK(TPacketGCPointChangeBulkElement, 13);
+PACKET_SIZE_CHECK(TPacketGCPointChangeBulkPacked, 3);
+PACKET_SIZE_CHECK(TPacketGCCharacterAdd, 35);
+PACKET_SIZE_CHECK(TPacketGCCharacterUpdate, 35);
+
 #pragma pack()
 #endif
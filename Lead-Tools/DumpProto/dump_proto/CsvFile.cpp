@@ -1,6 +1,13 @@
 #include "CsvFile.h"
 #include <fstream>
 #include <algorithm>
+#include <string.h>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <stdio.h>
+#endif
 
 #ifndef Assert
     #include <assert.h>
@@ -17,13 +24,134 @@ namespace
         STATE_QUOTE       ///< ǥ  
     };
 
-    /// ڿ ¿  ؼ ȯѴ.
-    std::string Trim(std::string str)
+    /// Trim ϴ   ˻Ѵ.
+    inline bool IsSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    /// \brief  ü б  ޸𸮿 ÷δ ü.
+    ///
+    /// 쿡      ۸ Ҵϰų 
+    ///  ʴ´.   ÷   оδ.
+    class cCsvMappedFile
+    {
+    private:
+#ifdef _WIN32
+        HANDLE            m_File;    ///<  ڵ
+        HANDLE            m_Mapping; ///<   ڵ
+#else
+        std::vector<char> m_Buffer;  ///<  
+#endif
+        const char*       m_Data;    ///<    ġ
+        size_t            m_Size;    ///<  ũ
+
+
+    public:
+        cCsvMappedFile();
+        ~cCsvMappedFile() { Close(); }
+
+        /// \brief  .
+        bool Open(const char* fileName);
+
+        /// \brief  ݴ´.
+        void Close();
+
+        const char* GetData() const { return m_Data; }
+        size_t GetSize() const { return m_Size; }
+    };
+
+#ifdef _WIN32
+    cCsvMappedFile::cCsvMappedFile()
+    : m_File(INVALID_HANDLE_VALUE), m_Mapping(NULL), m_Data(NULL), m_Size(0)
+    {
+    }
+
+    bool cCsvMappedFile::Open(const char* fileName)
+    {
+        Close();
+
+        m_File = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, 
+            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (m_File == INVALID_HANDLE_VALUE) return false;
+
+        m_Size = GetFileSize(m_File, NULL);
+
+        // ũⰡ 0    .
+        if (m_Size == 0 || m_Size == INVALID_FILE_SIZE)
+        {
+            bool empty = (m_Size == 0);
+            m_Size = 0;
+            m_Data = "";
+            return empty;
+        }
+
+        m_Mapping = CreateFileMapping(m_File, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (m_Mapping == NULL) { Close(); return false; }
+
+        m_Data = static_cast<const char*>(MapViewOfFile(m_Mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_Data == NULL) { Close(); return false; }
+
+        return true;
+    }
+
+    void cCsvMappedFile::Close()
+    {
+        if (m_Mapping)
+        {
+            if (m_Data) UnmapViewOfFile(m_Data);
+            CloseHandle(m_Mapping);
+            m_Mapping = NULL;
+        }
+
+        if (m_File != INVALID_HANDLE_VALUE)
+        {
+            CloseHandle(m_File);
+            m_File = INVALID_HANDLE_VALUE;
+        }
+
+        m_Data = NULL;
+        m_Size = 0;
+    }
+#else
+    cCsvMappedFile::cCsvMappedFile()
+    : m_Data(NULL), m_Size(0)
+    {
+    }
+
+    bool cCsvMappedFile::Open(const char* fileName)
+    {
+        Close();
+
+        FILE* fp = fopen(fileName, "rb");
+        if (!fp) return false;
+
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+
+        if (size > 0)
+        {
+            m_Buffer.resize(size);
+            m_Size = fread(&m_Buffer[0], 1, size, fp);
+            m_Data = &m_Buffer[0];
+        }
+        else
+        {
+            m_Data = "";
+        }
+
+        fclose(fp);
+        return true;
+    }
+
+    void cCsvMappedFile::Close()
     {
-        str = str.erase(str.find_last_not_of(" \t\r\n") + 1);
-        str = str.erase(0, str.find_first_not_of(" \t\r\n"));
-        return str;
+        m_Buffer.clear();
+        m_Data = NULL;
+        m_Size = 0;
     }
+#endif
 
     /// \brief ־ 忡 ִ ĺ  ҹڷ ٲ۴.
     std::string Lower(std::string original)
@@ -105,105 +233,116 @@ bool cCsvFile::Load(const char* fileName, const char seperator, const char quote
 {
     Assert(seperator != quote);
 
-    std::ifstream file(fileName, std::ios::in);
-    if (!file) return false;
+    cCsvMappedFile file;
+    if (!file.Open(fileName)) return false;
 
     Destroy(); //  ͸ 
 
+    const char* cur = file.GetData();
+    const char* end = cur + file.GetSize();
+
     cCsvRow* row = NULL;
     ParseState state = STATE_NORMAL;
-    std::string token = "";
-    char buf[2048+1] = {0,};
+    std::string token;
+    size_t colCount = 0; //    .   reserve .
 
-    while (file.good())
+    token.reserve(256);
+
+    while (cur < end)
     {
-        file.getline(buf, 2048);
-        buf[sizeof(buf)-1] = 0;
+        //   ߶󳻰, ¿  Ѵ. 
+        //   std::string  ʰ  θ ٷ.
+        const char* lineEnd  = static_cast<const char*>(memchr(cur, '\n', end - cur));
+        const char* nextLine = lineEnd ? lineEnd + 1 : end;
+        if (!lineEnd) lineEnd = end;
+
+        const char* begin = cur;
+        while (begin < lineEnd && IsSpace(*begin)) ++begin;
+        while (lineEnd > begin && IsSpace(*(lineEnd-1))) --lineEnd;
+
+        cur = nextLine;
 
-        std::string line(Trim(buf));
-        if (line.empty() || (state == STATE_NORMAL && line[0] == '#')) continue;
-        
-        std::string text  = std::string(line) + "  "; // Ľ lookahead  ٿش.
-        size_t cur = 0;
+        if (begin == lineEnd || (state == STATE_NORMAL && *begin == '#')) continue;
 
-        while (cur < text.size())
+        if (row == NULL)
+        {
+            row = new cCsvRow();
+            row->reserve(colCount);
+        }
+
+        const char* pos = begin;
+
+        while (pos < lineEnd)
         {
             //  尡 QUOTE  ,
             if (state == STATE_QUOTE)
             {
-                // '"'    ̴.
-                // 1.  ο Ư ڰ   ̸ ˸  ¿ 
-                // 2.   '"' ڰ '"' 2 ġȯ 
-                //   ù°   ִ  CSV  ̶, 
-                //  STATE_NORMAL ɸ Ǿִ.
-                // ׷Ƿ ⼭ ɸ  1  쳪, 2  ̴.
-                // 2 쿡  '"' ڰ 2 Ÿ.  1
-                //  쿡 ƴϴ. ̸  ؼ ڵ带 ¥...
-                if (text[cur] == quote)
+                // '"' ڰ   Ѳ δ.
+                const char* stop = pos;
+                while (stop < lineEnd && *stop != quote) ++stop;
+                token.append(pos, stop);
+                pos = stop;
+
+                if (pos == lineEnd) break;
+
+                // ӵ '"' ڶ ̴   '"' ڰ ġȯ ̰,
+                // ׷ ʴٸ   ˸ ̴.
+                if (pos + 1 < lineEnd && *(pos+1) == quote)
                 {
-                    //  ڰ '"' ڶ,  ӵ '"' ڶ 
-                    // ̴   '"' ڰ ġȯ ̴.
-                    if (text[cur+1] == quote)
-                    {
-                        token += quote;
-                        ++cur;
-                    }
-                    //  ڰ '"' ڰ ƴ϶ 
-                    //  '"'ڴ   ˸ ڶ   ִ.
-                    else
-                    {
-                        state = STATE_NORMAL;
-                    }
+                    token += quote;
+                    pos += 2;
                 }
                 else
                 {
-                    token += text[cur];
+                    state = STATE_NORMAL;
+                    ++pos;
                 }
             }
             //  尡 NORMAL  ,
-            else if (state == STATE_NORMAL)
+            else
             {
-                if (row == NULL)
-                    row = new cCsvRow();
+                const char* stop = pos;
+                while (stop < lineEnd && *stop != seperator && *stop != quote) ++stop;
+                token.append(pos, stop);
+                pos = stop;
+
+                if (pos == lineEnd) break;
 
                 // ',' ڸ ٸ   ǹѴ.
                 // ūμ  Ʈٰ ְ, ū ʱȭѴ.
-                if (text[cur] == seperator)
+                if (*pos == seperator)
                 {
                     row->push_back(token);
                     token.clear();
                 }
                 // '"' ڸ ٸ, QUOTE  ȯѴ.
-                else if (text[cur] == quote)
-                {
-                    state = STATE_QUOTE;
-                }
-                // ٸ Ϲ ڶ  ūٰ δ.
                 else
                 {
-                    token += text[cur];
+                    state = STATE_QUOTE;
                 }
-            }
 
-            ++cur;
+                ++pos;
+            }
         }
 
         //    ',' ڰ   ⼭ ߰Ѵ.
-        // , ó Ľ lookahead   ̽    .
         if (state == STATE_NORMAL)
         {
-            Assert(row != NULL);
-            row->push_back(token.substr(0, token.size()-2));
+            row->push_back(token);
+            colCount = row->size();
             m_Rows.push_back(row);
             token.clear();
             row = NULL;
         }
         else
         {
-            token = token.substr(0, token.size()-2) + "\r\n";
+            token += "\r\n";
         }
     }
 
+    // ǥ   ä    .
+    delete row;
+
     return true;
 }
 
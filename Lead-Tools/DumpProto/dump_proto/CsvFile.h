@@ -283,6 +283,9 @@ public:
     /// \brief   Ѿ.
     bool Next();
 
+    /// \brief  ٽ  ʰ ù   ǵ.
+    void Rewind() { m_CurRow = -1; }
+
     /// \brief    ڸ ȯѴ.
     size_t ColCount() const;
 
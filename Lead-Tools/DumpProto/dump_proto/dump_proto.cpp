@@ -1,6 +1,8 @@
 //#include "../../libthecore/include/stdafx.h"
 //#include ""
 //#define __WIN32__
+#include <windows.h>
+#include <process.h>
 #include <stdio.h>
 #include <string>
 #include <map>
@@ -17,9 +19,11 @@
 #pragma comment(lib, "lzo.lib")
 
 
+#ifndef MAKEFOURCC
 #define MAKEFOURCC(ch0, ch1, ch2, ch3)                              \
                 ((DWORD)(BYTE)(ch0) | ((DWORD)(BYTE)(ch1) << 8) |   \
                 ((DWORD)(BYTE)(ch2) << 16) | ((DWORD)(BYTE)(ch3) << 24 ))
+#endif
 
 typedef unsigned char BYTE;
 typedef unsigned short WORD;
@@ -356,9 +360,11 @@ bool BuildMobTable()
 
 	//1.  о.
 	cCsvTable test_data;
+	bool isTestFile = true;
 	if(!test_data.Load("mob_proto_test.txt",'\t'))
 	{
 		fprintf(stderr, "mob_proto_test.txt  о ߽ϴ\n");
+		isTestFile = false;
 		//return false;
 	} else {
 		test_data.Next();	// ο Ѿ.
@@ -424,13 +430,8 @@ bool BuildMobTable()
 	TMobTable * mob_table = m_pMobTable;
 
 
-	//data ٽ ùٷ ű.(ٽ о´;;)
-	data.Destroy();
-	if(!data.Load("mob_proto.txt",'\t'))
-	{
-		fprintf(stderr, "mob_proto.txt  о ߽ϴ\n");
-		return false;
-	}
+	//data ٽ ùٷ ű.
+	data.Rewind();
 	data.Next(); //   ( Į ϴ κ)
 
 	while (data.Next())
@@ -507,12 +508,9 @@ bool BuildMobTable()
 	//%% -> ο  ߰  //
 	//ߺǴ   ߰ //
 	//============================//
-	test_data.Destroy();
-	if(!test_data.Load("mob_proto_test.txt",'\t'))
+	if (isTestFile)
 	{
-		fprintf(stderr, "mob_proto_test.txt  о ߽ϴ\n");
-		//return false;
-	} else {
+		test_data.Rewind();
 		test_data.Next();	// ο Ѿ.
 
 		while (test_data.Next())	//׽Ʈ   Ⱦ,ο  ߰Ѵ.
@@ -557,7 +555,7 @@ DWORD g_adwMobProtoKey[4] =
 };
 
 
-void SaveMobProto()
+bool SaveMobProto()
 {   
 	FILE * fp;          
 
@@ -566,7 +564,7 @@ void SaveMobProto()
 	if (!fp)
 	{ 
 		printf("cannot open %s for writing\n", "mob_proto");
-		return;
+		return false;
 	}
 
 	DWORD fourcc = MAKEFOURCC('M', 'M', 'P', 'T');
@@ -583,7 +581,7 @@ void SaveMobProto()
 	{
 		printf("cannot compress\n");
 		fclose(fp);
-		return;
+		return false;
 	}
 
 	const CLZObject::THeader & r = zObj.GetHeader();
@@ -596,6 +594,7 @@ void SaveMobProto()
 	fwrite(zObj.GetBuffer(), dwDataSize, 1, fp);
 
 	fclose(fp);
+	return true;
 }
 
 void LoadMobProto()
@@ -778,9 +777,11 @@ bool BuildItemTable()
 
 	//1.  о.
 	cCsvTable test_data;
+	bool isTestFile = true;
 	if(!test_data.Load("item_proto_test.txt",'\t'))
 	{
 		fprintf(stderr, "item_proto_test.txt  о ߽ϴ\n");
+		isTestFile = false;
 		//return false;
 	} else {
 		test_data.Next();	// ο Ѿ.
@@ -842,13 +843,8 @@ bool BuildItemTable()
 			addNumber++;
 		}
 	}
-	//data ٽ ùٷ ű.(ٽ о´;;)
-	data.Destroy();
-	if(!data.Load("item_proto.txt",'\t'))
-	{
-		fprintf(stderr, "item_proto.txt  о ߽ϴ\n");
-		return false;
-	}
+	//data ٽ ùٷ ű.
+	data.Rewind();
 	data.Next(); //   ( Į ϴ κ)
 
 	m_iItemTableSize = data.m_File.GetRowCount()-1+addNumber;
@@ -937,12 +933,9 @@ bool BuildItemTable()
 	//==========================================================================//
 	//	4)test_item_table ߿, m_pItemTable   ͸ ߰Ѵ.
 	//==========================================================================//
-	test_data.Destroy();
-	if(!test_data.Load("item_proto_test.txt",'\t'))
+	if (isTestFile)
 	{
-		fprintf(stderr, "item_proto_test.txt  о ߽ϴ\n");
-		//return false;
-	} else {
+		test_data.Rewind();
 		test_data.Next();	// ο Ѿ.
 
 		while (test_data.Next())	//׽Ʈ   Ⱦ,ο  ߰Ѵ.
@@ -994,7 +987,7 @@ DWORD g_adwItemProtoKey[4] =
 	27973291
 };  
 
-void SaveItemProto()
+bool SaveItemProto()
 {
 	FILE * fp;
 
@@ -1003,7 +996,7 @@ void SaveItemProto()
 	if (!fp)
 	{
 		printf("cannot open %s for writing\n", "item_proto");
-		return;
+		return false;
 	}   
 
 	DWORD fourcc = MAKEFOURCC('M', 'I', 'P', 'X');
@@ -1025,7 +1018,7 @@ void SaveItemProto()
 	{
 		printf("cannot compress\n");
 		fclose(fp);
-		return;
+		return false;
 	}   
 
 	const CLZObject::THeader & r = zObj.GetHeader();
@@ -1048,7 +1041,7 @@ void SaveItemProto()
 	if (!fp)
 	{
 		printf("Error!!\n");
-		return;
+		return false;
 	}
 
 	fread(&fourcc, sizeof(DWORD), 1, fp);
@@ -1056,31 +1049,218 @@ void SaveItemProto()
 
 	printf("Elements Check %u fourcc match %d\n", dwElements, fourcc == MAKEFOURCC('M', 'I', 'P', 'T'));
 	fclose(fp);
+	return true;
+}
+
+
+
+//=====================================================================//
+//	  :  txt ϵ ũ CRC32, ׸ ü ũ⸦
+//	<proto>.stamp Ͽ  ΰ,  ට ״ζ ٽ  ʴ´.
+//	-f ɼ ָ ׻ ٽ .
+//=====================================================================//
+enum
+{
+	PROTO_SOURCE_MAX_NUM	= 3,
+	PROTO_JOB_MOB			= 0,
+	PROTO_JOB_ITEM,
+	PROTO_JOB_MAX_NUM
+};
+
+typedef struct SProtoJob
+{
+	const char *	szProtoName;
+	const char *	aszSourceNames[PROTO_SOURCE_MAX_NUM];
+	DWORD			dwStride;
+	bool			(*pfnBuild)();
+
+	std::string		strStamp;
+	bool			bBuilt;
+} TProtoJob;
+
+DWORD s_adwCRC32Table[256];
+
+void InitCRC32Table()
+{
+	for (DWORD i = 0; i < 256; ++i)
+	{
+		DWORD c = i;
+
+		for (int k = 0; k < 8; ++k)
+			c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+
+		s_adwCRC32Table[i] = c;
+	}
+}
+
+DWORD GetFileCRC32(const char * c_szFileName, long * plSize)
+{
+	FILE * fp = fopen(c_szFileName, "rb");
+
+	if (!fp)
+	{
+		*plSize = -1;
+		return 0;
+	}
+
+	static BYTE s_abBuf[64 * 1024];
+	DWORD dwCRC = 0xffffffff;
+	long lSize = 0;
+	size_t uRead;
+
+	while ((uRead = fread(s_abBuf, 1, sizeof(s_abBuf), fp)) > 0)
+	{
+		for (size_t i = 0; i < uRead; ++i)
+			dwCRC = s_adwCRC32Table[(dwCRC ^ s_abBuf[i]) & 0xff] ^ (dwCRC >> 8);
+
+		lSize += uRead;
+	}
+
+	fclose(fp);
+
+	*plSize = lSize;
+	return dwCRC ^ 0xffffffff;
+}
+
+std::string MakeProtoStamp(const TProtoJob & rJob)
+{
+	char szLine[256];
+	std::string strStamp;
+
+	_snprintf(szLine, sizeof(szLine), "stride %u\n", rJob.dwStride);
+	szLine[sizeof(szLine) - 1] = '\0';
+	strStamp += szLine;
+
+	for (int i = 0; i < PROTO_SOURCE_MAX_NUM; ++i)
+	{
+		long lSize;
+		DWORD dwCRC = GetFileCRC32(rJob.aszSourceNames[i], &lSize);
+
+		_snprintf(szLine, sizeof(szLine), "%s %ld %08x\n", rJob.aszSourceNames[i], lSize, dwCRC);
+		szLine[sizeof(szLine) - 1] = '\0';
+		strStamp += szLine;
+	}
+
+	return strStamp;
+}
+
+bool IsProtoUpToDate(const TProtoJob & rJob)
+{
+	//    ٽ .
+	FILE * fp = fopen(rJob.szProtoName, "rb");
+
+	if (!fp)
+		return false;
+
+	fclose(fp);
+
+	std::string strStampName(rJob.szProtoName);
+	strStampName += ".stamp";
+
+	fp = fopen(strStampName.c_str(), "rb");
+
+	if (!fp)
+		return false;
+
+	char szBuf[1024];
+	size_t uRead = fread(szBuf, 1, sizeof(szBuf), fp);
+	fclose(fp);
+
+	return rJob.strStamp.size() == uRead && 0 == memcmp(rJob.strStamp.c_str(), szBuf, uRead);
 }
 
+void SaveProtoStamp(const TProtoJob & rJob)
+{
+	std::string strStampName(rJob.szProtoName);
+	strStampName += ".stamp";
+
+	FILE * fp = fopen(strStampName.c_str(), "wb");
+
+	if (!fp)
+	{
+		printf("cannot open %s for writing\n", strStampName.c_str());
+		return;
+	}
+
+	fwrite(rJob.strStamp.c_str(), rJob.strStamp.size(), 1, fp);
+	fclose(fp);
+}
 
+//   ̺  ϴ Ͱ Ƿ  忡 .
+// (CLZO) ۾ ޸𸮸 ϱ  尡    Ѵ.
+unsigned __stdcall BuildProtoThread(void * pvArg)
+{
+	TProtoJob * pJob = (TProtoJob *) pvArg;
+	pJob->bBuilt = pJob->pfnBuild();
+	return 0;
+}
 
 int main(int argc, char ** argv)
 {
+	bool bForce = false;
 
-	
-	if (BuildMobTable())
+	for (int i = 1; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "-f"))
+			bForce = true;
+	}
+
+	TProtoJob aJobs[PROTO_JOB_MAX_NUM] =
+	{
+		{ "mob_proto",	{ "mob_proto.txt", "mob_names.txt", "mob_proto_test.txt" },		sizeof(TMobTable),			BuildMobTable },
+		{ "item_proto",	{ "item_proto.txt", "item_names.txt", "item_proto_test.txt" },	sizeof(TClientItemTable),	BuildItemTable },
+	};
+
+	InitCRC32Table();
+
+	HANDLE ahThreads[PROTO_JOB_MAX_NUM];
+	int iThreadCount = 0;
+
+	for (int i = 0; i < PROTO_JOB_MAX_NUM; ++i)
+	{
+		TProtoJob & rJob = aJobs[i];
+
+		rJob.bBuilt = false;
+		rJob.strStamp = MakeProtoStamp(rJob);
+
+		if (!bForce && IsProtoUpToDate(rJob))
+		{
+			printf("%s is up to date, skipped\n", rJob.szProtoName);
+			continue;
+		}
+
+		HANDLE hThread = (HANDLE) _beginthreadex(NULL, 0, BuildProtoThread, &rJob, 0, NULL);
+
+		if (hThread)
+			ahThreads[iThreadCount++] = hThread;
+		else
+			BuildProtoThread(&rJob);
+	}
+
+	if (iThreadCount > 0)
+	{
+		WaitForMultipleObjects(iThreadCount, ahThreads, TRUE, INFINITE);
+
+		for (int i = 0; i < iThreadCount; ++i)
+			CloseHandle(ahThreads[i]);
+	}
+
+	if (aJobs[PROTO_JOB_MOB].bBuilt)
 	{
-		SaveMobProto();
+		if (SaveMobProto())
+			SaveProtoStamp(aJobs[PROTO_JOB_MOB]);
+
 		LoadMobProto();
 		cout << "BuildMobTable working normal" << endl;
 	}
-	
 
-	
-	if (BuildItemTable())
+	if (aJobs[PROTO_JOB_ITEM].bBuilt)
 	{
-		SaveItemProto();
+		if (SaveItemProto())
+			SaveProtoStamp(aJobs[PROTO_JOB_ITEM]);
+
 		cout << "BuildItemTable working normal" << endl;
 	}
-	
-	
 
 	return 0;
 }
-
@@ -0,0 +1,1044 @@
+#include "stdafx.h"
+#include "bot.h"
+#include "bot_manager.h"
+#include "bot_packet.h"
+#include "bot_script.h"
+#include "sequence.h"
+
+enum
+{
+	BOT_INPUT_BUFFER_SIZE	= 65536,
+	BOT_OUTPUT_BUFFER_SIZE	= 16384,
+	BOT_PENDING_MAX_NUM	= 64,		//   ٸ û  
+	BOT_HOME_RANGE		= 5000,		// ó ڸ  ̻ ־ ǵ ȴ´
+	BOT_ATTACK_RANGE	= 250,
+	BOT_RESTART_DELAY	= 11000,	//   ̸ŭ  ڸ Ȱ ûѴ
+};
+
+//  desc.cpp  GetKey_20050304Myevan  ƾ Ѵ.
+static const BYTE * GetSecurityKeyTable()
+{
+	static bool bGenerated = false;
+	static DWORD s_adwKey[1938];
+
+	if (!bGenerated)
+	{
+		bGenerated = true;
+		DWORD seed = 1491971513;
+
+		for (UINT i = 0; i < BYTE(seed); ++i)
+		{
+			seed ^= 2148941891ul;
+			seed += 3592385981ul;
+
+			s_adwKey[i] = seed;
+		}
+	}
+
+	return (const BYTE *) s_adwKey;
+}
+
+static int GetDistance(long dx, long dy)
+{
+	return (int) sqrt((double) dx * dx + (double) dy * dy);
+}
+
+CBot::CBot(int iIndex) : m_iIndex(iIndex), m_iState(BOT_STATE_IDLE), m_iPhase(PHASE_CLOSE), m_sock(INVALID_SOCKET),
+	m_iDecryptedInputLen(0), m_bEncrypted(false), m_iSequence(0), m_dwLoginKey(0),
+	m_dwServerTimeBase(0), m_dwLocalTimeBase(0), m_dwConnectTime(0), m_dwNextActionTime(0), m_iScriptPos(0),
+	m_bHasCharacter(false), m_dwVID(0), m_lX(0), m_lY(0), m_lHomeX(0), m_lHomeY(0), m_dwTargetVID(0), m_wItemCell(0), m_dwRestartTime(0),
+	m_pkReplay(NULL), m_iReplayPos(0), m_dwReplayStartTime(0)
+{
+	const TBotConfig & c_rkConfig = CBotManager::instance().GetConfig();
+
+	char szLogin[LOGIN_MAX_LEN + 1];
+	snprintf(szLogin, sizeof(szLogin), "%s%d", c_rkConfig.stAccountPrefix.c_str(), c_rkConfig.iAccountStart + iIndex);
+	m_stLogin = szLogin;
+
+	m_lpInputBuffer = buffer_new(BOT_INPUT_BUFFER_SIZE);
+	m_lpOutputBuffer = buffer_new(BOT_OUTPUT_BUFFER_SIZE);
+
+	memset(m_adwEncryptKey, 0, sizeof(m_adwEncryptKey));
+	memset(m_adwDecryptKey, 0, sizeof(m_adwDecryptKey));
+	memset(m_adwClientKey, 0, sizeof(m_adwClientKey));
+}
+
+CBot::~CBot()
+{
+	Disconnect();
+
+	buffer_delete(m_lpInputBuffer);
+	buffer_delete(m_lpOutputBuffer);
+}
+
+const char * CBot::GetStateName(int iState)
+{
+	static const char * s_apszName[BOT_STATE_MAX_NUM] =
+	{
+		"idle",
+		"auth_connecting",
+		"auth",
+		"game_connecting",
+		"login",
+		"game",
+		"closed",
+	};
+
+	if (iState < 0 || iState >= BOT_STATE_MAX_NUM)
+		return "unknown";
+
+	return s_apszName[iState];
+}
+
+void CBot::SetReplay(const TBotReplaySession * c_pkSession)
+{
+	m_pkReplay = c_pkSession;
+	m_stLogin = c_pkSession->stLogin;
+}
+
+int CBot::GetCharacterIndex() const
+{
+	return m_pkReplay ? m_pkReplay->iCharacterIndex : CBotManager::instance().GetConfig().iCharacterIndex;
+}
+
+void CBot::Start(DWORD dwNow)
+{
+	const TBotConfig & c_rkConfig = CBotManager::instance().GetConfig();
+
+	//    ʿ  Ű  DB  α Ű ޾ ش.
+	for (int i = 0; i < 4; ++i)
+		m_adwClientKey[i] = thecore_random();
+
+	m_dwLoginKey = 0;
+	m_bHasCharacter = false;
+
+	Connect(c_rkConfig.kAuthAddr, BOT_STATE_AUTH_CONNECTING);
+}
+
+bool CBot::Connect(const struct sockaddr_in & c_rkAddr, int iState)
+{
+	Disconnect();
+
+	m_iState = iState;
+	m_sock = socket(AF_INET, SOCK_STREAM, 0);
+
+	if (m_sock == INVALID_SOCKET)
+	{
+		sys_err("%s: socket: %s", m_stLogin.c_str(), strerror(errno));
+		CBotManager::instance().GetStat().Count(BOT_COUNTER_CONNECT_FAIL);
+		Close(true);
+		return false;
+	}
+
+	LPFDWATCH fdw = CBotManager::instance().GetFdwatch();
+
+	if (m_sock >= fdw->nfiles)
+	{
+		sys_err("%s: fd %d exceeds fdwatch size, raise the bot fd limit", m_stLogin.c_str(), m_sock);
+		socket_close(m_sock);
+		m_sock = INVALID_SOCKET;
+		CBotManager::instance().GetStat().Count(BOT_COUNTER_CONNECT_FAIL);
+		Close(false);
+		return false;
+	}
+
+	socket_nonblock(m_sock);
+
+	if (connect(m_sock, (const struct sockaddr *) &c_rkAddr, sizeof(c_rkAddr)) < 0 && errno != EINPROGRESS)
+	{
+		sys_log(0, "%s: connect to %s:%d: %s", m_stLogin.c_str(), inet_ntoa(c_rkAddr.sin_addr), ntohs(c_rkAddr.sin_port), strerror(errno));
+		CBotManager::instance().GetStat().Count(BOT_COUNTER_CONNECT_FAIL);
+		Close(true);
+		return false;
+	}
+
+	buffer_reset(m_lpInputBuffer);
+	buffer_reset(m_lpOutputBuffer);
+
+	m_iPhase = PHASE_CLOSE;
+	m_iDecryptedInputLen = 0;
+	m_bEncrypted = false;
+	m_iSequence = 0;
+
+	thecore_memcpy(m_adwEncryptKey, "1234abcd5678efgh", sizeof(DWORD) * 4);
+	thecore_memcpy(m_adwDecryptKey, "1234abcd5678efgh", sizeof(DWORD) * 4);
+
+	for (int i = 0; i < BOT_LATENCY_MAX_NUM; ++i)
+		m_adeq_dwPending[i].clear();
+
+	m_map_kActor.clear();
+	m_dwTargetVID = 0;
+	m_dwRestartTime = 0;
+
+	//     ˷´.
+	fdwatch_add_fd(fdw, m_sock, this, FDW_WRITE, true);
+	BeginWait(BOT_LATENCY_CONNECT);
+	return true;
+}
+
+void CBot::Disconnect()
+{
+	if (m_sock == INVALID_SOCKET)
+		return;
+
+	fdwatch_del_fd(CBotManager::instance().GetFdwatch(), m_sock);
+	socket_close(m_sock);
+	m_sock = INVALID_SOCKET;
+}
+
+void CBot::Close(bool bReconnect)
+{
+	if (m_iState == BOT_STATE_GAME || m_iState == BOT_STATE_LOGIN || m_iState == BOT_STATE_AUTH)
+		CBotManager::instance().GetStat().Count(BOT_COUNTER_DISCONNECT);
+
+	Disconnect();
+
+	for (int i = 0; i < BOT_LATENCY_MAX_NUM; ++i)
+		m_adeq_dwPending[i].clear();
+
+	if (bReconnect && CBotManager::instance().GetConfig().bReconnect)
+	{
+		m_iState = BOT_STATE_IDLE;
+		m_dwNextActionTime = get_dword_time() + number(1000, 3000);
+	}
+	else
+		m_iState = BOT_STATE_CLOSED;
+}
+
+DWORD CBot::GetServerTime() const
+{
+	return m_dwServerTimeBase + (get_dword_time() - m_dwLocalTimeBase);
+}
+
+void CBot::BeginWait(int iLatency)
+{
+	std::deque<DWORD> & rdeq = m_adeq_dwPending[iLatency];
+
+	if (rdeq.size() >= BOT_PENDING_MAX_NUM)
+		return;
+
+	rdeq.push_back(get_dword_time());
+}
+
+void CBot::EndWait(int iLatency)
+{
+	std::deque<DWORD> & rdeq = m_adeq_dwPending[iLatency];
+
+	if (rdeq.empty())
+		return;
+
+	CBotManager::instance().GetStat().Record(iLatency, get_dword_time() - rdeq.front());
+	rdeq.pop_front();
+}
+
+void CBot::CheckTimeout(DWORD dwNow)
+{
+	for (int i = 0; i < BOT_LATENCY_MAX_NUM; ++i)
+	{
+		std::deque<DWORD> & rdeq = m_adeq_dwPending[i];
+
+		while (!rdeq.empty() && (int) (dwNow - rdeq.front()) >= BOT_RESPONSE_TIMEOUT)
+		{
+			CBotManager::instance().GetStat().Timeout(i);
+			rdeq.pop_front();
+		}
+	}
+}
+
+void CBot::Update(DWORD dwNow)
+{
+	switch (m_iState)
+	{
+		case BOT_STATE_IDLE:
+			if ((int) (dwNow - m_dwNextActionTime) >= 0)
+				Start(dwNow);
+			return;
+
+		case BOT_STATE_CLOSED:
+			return;
+
+		case BOT_STATE_AUTH_CONNECTING:
+		case BOT_STATE_GAME_CONNECTING:
+			if (!m_adeq_dwPending[BOT_LATENCY_CONNECT].empty() && (int) (dwNow - m_adeq_dwPending[BOT_LATENCY_CONNECT].front()) >= BOT_RESPONSE_TIMEOUT)
+			{
+				CBotManager::instance().GetStat().Timeout(BOT_LATENCY_CONNECT);
+				CBotManager::instance().GetStat().Count(BOT_COUNTER_CONNECT_FAIL);
+				Close(true);
+			}
+			return;
+	}
+
+	CheckTimeout(dwNow);
+
+	//   α  ʰ  ɸ ٽ ٴ´.
+	if (m_iState != BOT_STATE_GAME && (int) (dwNow - m_dwConnectTime) >= BOT_RESPONSE_TIMEOUT * 3)
+	{
+		sys_log(0, "%s: stuck in %s phase %d", m_stLogin.c_str(), GetStateName(m_iState), m_iPhase);
+		Close(true);
+		return;
+	}
+
+	if (m_iState == BOT_STATE_GAME)
+	{
+		if (m_dwRestartTime && (int) (dwNow - m_dwRestartTime) >= 0)
+		{
+			m_dwRestartTime = 0;
+			SendChat("/restart_here");
+		}
+		else if (m_pkReplay)
+			RunReplay(dwNow);
+		else if (!m_dwRestartTime)
+			RunScript(dwNow);
+	}
+
+	Flush();
+}
+
+void CBot::OnWritable()
+{
+	if (m_iState == BOT_STATE_AUTH_CONNECTING || m_iState == BOT_STATE_GAME_CONNECTING)
+	{
+		int iError = 0;
+		socklen_t len = sizeof(iError);
+
+		if (getsockopt(m_sock, SOL_SOCKET, SO_ERROR, (char *) &iError, &len) < 0 || iError)
+		{
+			sys_log(0, "%s: connect: %s", m_stLogin.c_str(), strerror(iError ? iError : errno));
+			CBotManager::instance().GetStat().Count(BOT_COUNTER_CONNECT_FAIL);
+			Close(true);
+			return;
+		}
+
+		EndWait(BOT_LATENCY_CONNECT);
+
+		m_dwConnectTime = get_dword_time();
+		m_iState = (m_iState == BOT_STATE_AUTH_CONNECTING) ? BOT_STATE_AUTH : BOT_STATE_LOGIN;
+		BeginWait(BOT_LATENCY_HANDSHAKE);
+
+		fdwatch_add_fd(CBotManager::instance().GetFdwatch(), m_sock, this, FDW_READ, false);
+	}
+
+	Flush();
+}
+
+void CBot::OnReadable()
+{
+	ProcessInput();
+	Flush();
+}
+
+void CBot::OnEOF()
+{
+	sys_log(0, "%s: connection closed by server (%s)", m_stLogin.c_str(), GetStateName(m_iState));
+	Close(true);
+}
+
+void CBot::Flush()
+{
+	if (m_sock == INVALID_SOCKET || buffer_size(m_lpOutputBuffer) <= 0)
+		return;
+
+	if (m_iState == BOT_STATE_AUTH_CONNECTING || m_iState == BOT_STATE_GAME_CONNECTING)
+		return;
+
+	int iBytes = socket_write_tcp(m_sock, (const char *) buffer_read_peek(m_lpOutputBuffer), buffer_size(m_lpOutputBuffer));
+
+	if (iBytes < 0)
+	{
+		sys_log(0, "%s: write error", m_stLogin.c_str());
+		Close(true);
+		return;
+	}
+
+	CBotManager::instance().GetStat().Count(BOT_COUNTER_BYTES_OUT, iBytes);
+	buffer_read_proceed(m_lpOutputBuffer, iBytes);
+
+	//       .
+	if (buffer_size(m_lpOutputBuffer) > 0)
+		fdwatch_add_fd(CBotManager::instance().GetFdwatch(), m_sock, this, FDW_WRITE, true);
+}
+
+void CBot::Packet(const void * c_pvData, int iSize, bool bSequence)
+{
+	if (m_sock == INVALID_SOCKET)
+		return;
+
+	int iTotal = iSize + (bSequence ? sizeof(BYTE) : 0);
+
+	// ȣȭ 8 Ʈ ̹Ƿ  д.
+	if (buffer_has_space(m_lpOutputBuffer) < iTotal + 8)
+		buffer_compact(m_lpOutputBuffer);
+
+	buffer_adjust_size(m_lpOutputBuffer, iTotal + 8);
+
+	BYTE * pbWrite = (BYTE *) buffer_write_peek(m_lpOutputBuffer);
+	thecore_memcpy(pbWrite, c_pvData, iSize);
+
+	if (bSequence)
+	{
+		pbWrite[iSize] = gc_abSequence[m_iSequence];
+
+		if (++m_iSequence == SEQUENCE_MAX_NUM)
+			m_iSequence = 0;
+	}
+
+	if (m_bEncrypted)
+		iTotal = TEA_Encrypt((DWORD *) pbWrite, (const DWORD *) pbWrite, m_adwEncryptKey, iTotal);
+
+	buffer_write_proceed(m_lpOutputBuffer, iTotal);
+	CBotManager::instance().GetStat().Count(BOT_COUNTER_PACKET_OUT);
+}
+
+void CBot::ProcessInput()
+{
+	if (buffer_has_space(m_lpInputBuffer) < BOT_INPUT_BUFFER_SIZE / 2)
+		buffer_compact(m_lpInputBuffer);
+
+	buffer_adjust_size(m_lpInputBuffer, BOT_INPUT_BUFFER_SIZE / 2);
+
+	int iBytes = socket_read(m_sock, (char *) buffer_write_peek(m_lpInputBuffer), buffer_has_space(m_lpInputBuffer));
+
+	if (iBytes < 0)
+	{
+		sys_log(0, "%s: connection lost (%s)", m_stLogin.c_str(), GetStateName(m_iState));
+		Close(true);
+		return;
+	}
+
+	if (iBytes == 0)
+		return;
+
+	buffer_write_proceed(m_lpInputBuffer, iBytes);
+	CBotManager::instance().GetStat().Count(BOT_COUNTER_BYTES_IN, iBytes);
+
+	while (true)
+	{
+		if (m_bEncrypted)
+		{
+			int iSizeCrypted = buffer_size(m_lpInputBuffer) - m_iDecryptedInputLen;
+
+			iSizeCrypted -= iSizeCrypted & 7;
+
+			if (iSizeCrypted > 0)
+			{
+				DWORD * pdwCrypted = (DWORD *) ((char *) buffer_read_peek(m_lpInputBuffer) + m_iDecryptedInputLen);
+				m_iDecryptedInputLen += TEA_Decrypt(pdwCrypted, pdwCrypted, m_adwDecryptKey, iSizeCrypted);
+			}
+		}
+		else
+			m_iDecryptedInputLen = buffer_size(m_lpInputBuffer);
+
+		// óϴ ȣȭ   κ ȣȭؼ ٽ óѴ.
+		if (!ProcessPackets())
+			break;
+	}
+}
+
+bool CBot::ProcessPackets()
+{
+	while (m_iDecryptedInputLen > 0)
+	{
+		const BYTE * c_pbData = (const BYTE *) buffer_read_peek(m_lpInputBuffer);
+		int iSize = bot_packet_get_size(c_pbData, m_iDecryptedInputLen);
+
+		if (iSize < 0)
+		{
+			sys_err("%s: unknown header %u in %s phase %d", m_stLogin.c_str(), *c_pbData, GetStateName(m_iState), m_iPhase);
+			Close(true);
+			return false;
+		}
+
+		if (iSize == 0)
+			break;
+
+		bool bEncrypted = m_bEncrypted;
+
+		//  ų ٸ  Ű پ ۰ Ƿ .
+		if (!Analyze(c_pbData, iSize))
+			return false;
+
+		buffer_read_proceed(m_lpInputBuffer, iSize);
+		m_iDecryptedInputLen -= iSize;
+
+		if (bEncrypted != m_bEncrypted)
+		{
+			m_iDecryptedInputLen = 0;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool CBot::Analyze(const BYTE * c_pbData, int iSize)
+{
+	if (*c_pbData == 0)
+		return true;
+
+	CBotManager::instance().GetStat().Count(BOT_COUNTER_PACKET_IN);
+
+	switch (*c_pbData)
+	{
+		case HEADER_GC_HANDSHAKE:
+			RecvHandshake((const TPacketGCHandshake *) c_pbData);
+			break;
+
+		case HEADER_GC_PHASE:
+			RecvPhase((const TPacketGCPhase *) c_pbData);
+			break;
+
+		case HEADER_GC_PING:
+			{
+				TPacketCGPong pack;
+				pack.bHeader = HEADER_CG_PONG;
+				Packet(&pack, sizeof(pack), m_iPhase != PHASE_HANDSHAKE);
+			}
+			break;
+
+		case HEADER_GC_AUTH_SUCCESS:
+			{
+				const TPacketGCAuthSuccess * p = (const TPacketGCAuthSuccess *) c_pbData;
+
+				if (!p->bResult)
+				{
+					sys_log(0, "%s: auth failed", m_stLogin.c_str());
+					CBotManager::instance().GetStat().Count(BOT_COUNTER_LOGIN_FAIL);
+					Close(true);
+					return false;
+				}
+
+				EndWait(BOT_LATENCY_AUTH);
+				m_dwLoginKey = p->dwLoginKey;
+
+				Connect(CBotManager::instance().GetConfig().kGameAddr, BOT_STATE_GAME_CONNECTING);
+				return false;
+			}
+
+		case HEADER_GC_LOGIN_FAILURE:
+			{
+				const TPacketGCLoginFailure * p = (const TPacketGCLoginFailure *) c_pbData;
+				char szStatus[ACCOUNT_STATUS_MAX_LEN + 1];
+
+				strlcpy(szStatus, p->szStatus, sizeof(szStatus));
+				sys_log(0, "%s: login failure %s", m_stLogin.c_str(), szStatus);
+
+				CBotManager::instance().GetStat().Count(BOT_COUNTER_LOGIN_FAIL);
+				Close(true);
+				return false;
+			}
+
+		case HEADER_GC_LOGIN_SUCCESS:
+			RecvLoginSuccess((const TPacketGCLoginSuccess *) c_pbData);
+			break;
+
+		case HEADER_GC_MAIN_CHARACTER:
+			{
+				const TPacketGCMainCharacter * p = (const TPacketGCMainCharacter *) c_pbData;
+				RecvMainCharacter(p->dwVID, p->lx, p->ly);
+			}
+			break;
+
+		case HEADER_GC_MAIN_CHARACTER3_BGM:
+			{
+				const TPacketGCMainCharacter3_BGM * p = (const TPacketGCMainCharacter3_BGM *) c_pbData;
+				RecvMainCharacter(p->dwVID, p->lx, p->ly);
+			}
+			break;
+
+		case HEADER_GC_MAIN_CHARACTER4_BGM_VOL:
+			{
+				const TPacketGCMainCharacter4_BGM_VOL * p = (const TPacketGCMainCharacter4_BGM_VOL *) c_pbData;
+				RecvMainCharacter(p->dwVID, p->lx, p->ly);
+			}
+			break;
+
+		case HEADER_GC_CHARACTER_ADD:
+			{
+				const TPacketGCCharacterAdd * p = (const TPacketGCCharacterAdd *) c_pbData;
+				RecvCharacterAdd(p->dwVID, p->x, p->y, p->bType);
+			}
+			break;
+
+		case HEADER_GC_CHARACTER_ADD_BULK:
+			{
+				const TPacketGCCharacterAddBulkElement * p = (const TPacketGCCharacterAddBulkElement *) (c_pbData + sizeof(TPacketGCCharacterAddBulk));
+				int iCount = (iSize - sizeof(TPacketGCCharacterAddBulk)) / sizeof(TPacketGCCharacterAddBulkElement);
+
+				for (int i = 0; i < iCount; ++i)
+					RecvCharacterAdd(p[i].dwVID, p[i].x, p[i].y, p[i].bType);
+			}
+			break;
+
+		case HEADER_GC_CHARACTER_DEL:
+			{
+				const TPacketGCCharacterDelete * p = (const TPacketGCCharacterDelete *) c_pbData;
+
+				m_map_kActor.erase(p->id);
+
+				if (p->id == m_dwTargetVID)
+					m_dwTargetVID = 0;
+			}
+			break;
+
+		case HEADER_GC_MOVE:
+			{
+				const TPacketGCMove * p = (const TPacketGCMove *) c_pbData;
+
+				if (p->dwVID == m_dwVID)
+				{
+					m_lX = p->lX;
+					m_lY = p->lY;
+				}
+				else
+				{
+					itertype(m_map_kActor) it = m_map_kActor.find(p->dwVID);
+
+					if (it != m_map_kActor.end())
+					{
+						it->second.x = p->lX;
+						it->second.y = p->lY;
+					}
+				}
+			}
+			break;
+
+		case HEADER_GC_CHAT:
+			{
+				const TPacketGCChat * p = (const TPacketGCChat *) c_pbData;
+
+				if (p->type == CHAT_TYPE_TALKING && p->id == m_dwVID)
+					EndWait(BOT_LATENCY_CHAT);
+			}
+			break;
+
+		case HEADER_GC_DAMAGE_INFO:
+			RecvDamageInfo(((const TPacketGCDamageInfo *) c_pbData)->dwVID);
+			break;
+
+		case HEADER_GC_DAMAGE_INFO_BULK:
+			{
+				const TPacketGCDamageInfoBulkElement * p = (const TPacketGCDamageInfoBulkElement *) (c_pbData + sizeof(TPacketGCDamageInfoBulk));
+				int iCount = (iSize - sizeof(TPacketGCDamageInfoBulk)) / sizeof(TPacketGCDamageInfoBulkElement);
+
+				for (int i = 0; i < iCount; ++i)
+					RecvDamageInfo(p[i].dwVID);
+			}
+			break;
+
+		case HEADER_GC_ITEM_SET:
+			RecvItemCell(((const TPacketGCItemSet *) c_pbData)->Cell);
+			break;
+
+		case HEADER_GC_ITEM_UPDATE:
+			RecvItemCell(((const TPacketGCItemUpdate *) c_pbData)->Cell);
+			break;
+
+		case HEADER_GC_ITEM_DEL:
+			RecvItemCell(((const TPacketGCItemDelDeprecated *) c_pbData)->Cell);
+			break;
+
+		case HEADER_GC_DEAD:
+			if (((const TPacketGCDead *) c_pbData)->vid == m_dwVID)
+			{
+				sys_log(1, "%s: dead", m_stLogin.c_str());
+
+				//  ̸ ĸĿ ִ Ȱ û ״ .
+				if (!m_pkReplay)
+					m_dwRestartTime = get_dword_time() + BOT_RESTART_DELAY;
+			}
+			break;
+	}
+
+	return m_sock != INVALID_SOCKET;
+}
+
+void CBot::RecvHandshake(const TPacketGCHandshake * p)
+{
+	//   ð   ̵ Ŷ ð  ռ ʰ Ѵ.
+	m_dwServerTimeBase = p->dwTime;
+	m_dwLocalTimeBase = get_dword_time();
+
+	// Ŭ̾Ʈ   պ ð ؼ ش.
+	TPacketCGHandshake pack;
+
+	pack.bHeader = (m_iPhase == PHASE_CLOSE || m_iPhase == PHASE_HANDSHAKE) ? HEADER_CG_HANDSHAKE : HEADER_CG_TIME_SYNC;
+	pack.dwHandshake = p->dwHandshake;
+	pack.dwTime = p->dwTime + p->lDelta + p->lDelta;
+	pack.lDelta = 0;
+
+	Packet(&pack, sizeof(pack), pack.bHeader == HEADER_CG_TIME_SYNC);
+}
+
+void CBot::RecvPhase(const TPacketGCPhase * p)
+{
+	m_iPhase = p->phase;
+
+	switch (m_iPhase)
+	{
+		case PHASE_AUTH:
+			m_bEncrypted = true;
+			EndWait(BOT_LATENCY_HANDSHAKE);
+			SendLogin3();
+			break;
+
+		case PHASE_LOGIN:
+			m_bEncrypted = true;
+			EndWait(BOT_LATENCY_HANDSHAKE);
+			SendLogin2();
+			break;
+
+		case PHASE_SELECT:
+			{
+				int iIndex = GetCharacterIndex();
+
+				if (!m_bHasCharacter)
+				{
+					sys_err("%s: no character in slot %d", m_stLogin.c_str(), iIndex);
+					CBotManager::instance().GetStat().Count(BOT_COUNTER_LOGIN_FAIL);
+					Close(false);
+					return;
+				}
+
+				TPacketCGCharacterSelect pack;
+				pack.header = HEADER_CG_CHARACTER_SELECT;
+				pack.index = iIndex;
+
+				BeginWait(BOT_LATENCY_SELECT);
+				Packet(&pack, sizeof(pack), true);
+			}
+			break;
+
+		case PHASE_GAME:
+			EndWait(BOT_LATENCY_ENTER);
+
+			m_iState = BOT_STATE_GAME;
+			m_iScriptPos = 0;
+			m_iReplayPos = 0;
+			m_dwReplayStartTime = get_dword_time();
+			//        ʵ  ´.
+			m_dwNextActionTime = get_dword_time() + number(0, 2000);
+			sys_log(1, "%s: entered game vid %u (%ld, %ld)", m_stLogin.c_str(), m_dwVID, m_lX, m_lY);
+			break;
+
+		case PHASE_CLOSE:
+			Close(true);
+			break;
+	}
+}
+
+void CBot::RecvLoginSuccess(const TPacketGCLoginSuccess * p)
+{
+	EndWait(BOT_LATENCY_LOGIN);
+
+	m_bHasCharacter = p->players[GetCharacterIndex()].dwID != 0;
+}
+
+void CBot::RecvMainCharacter(DWORD dwVID, long x, long y)
+{
+	EndWait(BOT_LATENCY_SELECT);
+
+	m_dwVID = dwVID;
+	m_lX = m_lHomeX = x;
+	m_lY = m_lHomeY = y;
+
+	TPacketCGEnterGame pack;
+	pack.header = HEADER_CG_ENTERGAME;
+
+	BeginWait(BOT_LATENCY_ENTER);
+	Packet(&pack, sizeof(pack), true);
+}
+
+void CBot::RecvCharacterAdd(DWORD dwVID, long x, long y, BYTE bType)
+{
+	if (dwVID == m_dwVID)
+	{
+		m_lX = x;
+		m_lY = y;
+		return;
+	}
+
+	TBotActor & rkActor = m_map_kActor[dwVID];
+
+	rkActor.x = x;
+	rkActor.y = y;
+	rkActor.bType = bType;
+}
+
+void CBot::RecvDamageInfo(DWORD dwVID)
+{
+	if (m_dwTargetVID && dwVID == m_dwTargetVID)
+		EndWait(BOT_LATENCY_ATTACK);
+}
+
+void CBot::RecvItemCell(const TItemPos & c_rkCell)
+{
+	if (c_rkCell.window_type == INVENTORY && c_rkCell.cell == m_wItemCell)
+		EndWait(BOT_LATENCY_ITEM_USE);
+}
+
+void CBot::SendLogin3()
+{
+	const TBotConfig & c_rkConfig = CBotManager::instance().GetConfig();
+	TPacketCGLogin3 pack;
+
+	memset(&pack, 0, sizeof(pack));
+	pack.header = HEADER_CG_LOGIN3;
+	strlcpy(pack.login, m_stLogin.c_str(), sizeof(pack.login));
+	strlcpy(pack.passwd, c_rkConfig.stPassword.c_str(), sizeof(pack.passwd));
+	thecore_memcpy(pack.adwClientKey, m_adwClientKey, sizeof(pack.adwClientKey));
+
+	BeginWait(BOT_LATENCY_AUTH);
+	Packet(&pack, sizeof(pack), true);
+}
+
+void CBot::SendLogin2()
+{
+	TPacketCGLogin2 pack;
+
+	memset(&pack, 0, sizeof(pack));
+	pack.header = HEADER_CG_LOGIN2;
+	strlcpy(pack.login, m_stLogin.c_str(), sizeof(pack.login));
+	pack.dwLoginKey = m_dwLoginKey;
+	thecore_memcpy(pack.adwClientKey, m_adwClientKey, sizeof(pack.adwClientKey));
+
+	BeginWait(BOT_LATENCY_LOGIN);
+	Packet(&pack, sizeof(pack), true);
+
+	//   Ŷ ڸ Ű ٲٹǷ   Ŷ  Ű .
+	SetSecurityKey();
+}
+
+void CBot::SetSecurityKey()
+{
+	//  DESC::SetSecurityKey  ⸸ ݴ̴.
+	thecore_memcpy(m_adwEncryptKey, m_adwClientKey, sizeof(m_adwEncryptKey));
+	TEA_Encrypt(m_adwDecryptKey, m_adwClientKey, (const DWORD *) (GetSecurityKeyTable() + 37), sizeof(m_adwDecryptKey));
+}
+
+void CBot::RunScript(DWORD dwNow)
+{
+	const CBotScript & c_rkScript = CBotManager::instance().GetScript();
+
+	if (c_rkScript.IsEmpty())
+		return;
+
+	// wait   ũƮ     .
+	for (int i = 0; i < c_rkScript.GetActionCount(); ++i)
+	{
+		if ((int) (dwNow - m_dwNextActionTime) < 0)
+			return;
+
+		const TBotAction & c_rkAction = c_rkScript.GetAction(m_iScriptPos);
+
+		if (++m_iScriptPos >= c_rkScript.GetActionCount())
+			m_iScriptPos = 0;
+
+		switch (c_rkAction.iType)
+		{
+			case BOT_ACTION_MOVE:
+				ActionMove(c_rkAction.iArg);
+				break;
+
+			case BOT_ACTION_ATTACK:
+				ActionAttack();
+				break;
+
+			case BOT_ACTION_CHAT:
+				ActionChat(c_rkAction.stText);
+				break;
+
+			case BOT_ACTION_USE:
+				ActionUse(c_rkAction.iArg);
+				break;
+
+			case BOT_ACTION_WAIT:
+				m_dwNextActionTime = dwNow + c_rkAction.iArg + (c_rkAction.iJitter ? number(0, c_rkAction.iJitter) : 0);
+				break;
+		}
+	}
+}
+
+void CBot::RunReplay(DWORD dwNow)
+{
+	int iCount = m_pkReplay->vec_kPacket.size();
+
+	//    m_iReplayPos  iCount + 1 ̴.
+	if (m_iReplayPos > iCount)
+		return;
+
+	const CBotReplay & c_rkReplay = CBotManager::instance().GetReplay();
+	DWORD dwElapsed = (DWORD) ((dwNow - m_dwReplayStartTime) * CBotManager::instance().GetConfig().dReplaySpeed);
+
+	while (m_iReplayPos < iCount)
+	{
+		const TBotReplayPacket & c_rkPacket = m_pkReplay->vec_kPacket[m_iReplayPos];
+
+		if (c_rkPacket.dwTime > dwElapsed)
+			return;
+
+		++m_iReplayPos;
+
+		const BYTE * c_pbData = c_rkReplay.GetData(c_rkPacket);
+
+		// ̵ ð  ð ռ ǵ Ƿ  ð ٲ۴.
+		if (c_pbData[0] == HEADER_CG_MOVE && c_rkPacket.wSize == sizeof(TPacketCGMove))
+		{
+			TPacketCGMove pack;
+
+			thecore_memcpy(&pack, c_pbData, sizeof(pack));
+			pack.dwTime = GetServerTime();
+
+			m_lX = pack.lX;
+			m_lY = pack.lY;
+			Packet(&pack, sizeof(pack), c_rkPacket.bSequence);
+		}
+		else
+			Packet(c_pbData, c_rkPacket.wSize, c_rkPacket.bSequence);
+
+		CBotManager::instance().GetStat().Count(BOT_COUNTER_REPLAY_PACKET);
+	}
+
+	m_iReplayPos = iCount + 1;
+	CBotManager::instance().GetStat().Count(BOT_COUNTER_REPLAY_END);
+	sys_log(1, "%s: replay finished, %d packets", m_stLogin.c_str(), iCount);
+
+	// ĸĿ  ̸    ´.
+	if (m_pkReplay->bClosed)
+	{
+		Flush();
+		Disconnect();
+		m_iState = BOT_STATE_CLOSED;
+	}
+}
+
+void CBot::SendMove(BYTE bFunc, long x, long y)
+{
+	TPacketCGMove pack;
+
+	// bRot  5   ̴.
+	double dRot = atan2((double) (x - m_lX), (double) (m_lY - y)) * 180.0 / M_PI;
+
+	if (dRot < 0.0)
+		dRot += 360.0;
+
+	pack.bHeader = HEADER_CG_MOVE;
+	pack.bFunc = bFunc;
+	pack.bArg = 0;
+	pack.bRot = ((int) dRot % 360) / 5;
+	pack.lX = x;
+	pack.lY = y;
+	pack.dwTime = GetServerTime();
+
+	Packet(&pack, sizeof(pack), true);
+
+	m_lX = x;
+	m_lY = y;
+}
+
+void CBot::ActionMove(int iDistance)
+{
+	double dAngle;
+
+	if (GetDistance(m_lX - m_lHomeX, m_lY - m_lHomeY) > BOT_HOME_RANGE)
+		dAngle = atan2((double) (m_lHomeY - m_lY), (double) (m_lHomeX - m_lX));
+	else
+		dAngle = number(0, 359) * M_PI / 180.0;
+
+	SendMove(FUNC_MOVE, m_lX + (long) (iDistance * cos(dAngle)), m_lY + (long) (iDistance * sin(dAngle)));
+}
+
+void CBot::ActionAttack()
+{
+	DWORD dwVID = 0;
+	int iMinDist = INT_MAX;
+	long lTargetX = 0, lTargetY = 0;
+
+	for (itertype(m_map_kActor) it = m_map_kActor.begin(); it != m_map_kActor.end(); ++it)
+	{
+		if (it->second.bType != CHAR_TYPE_MONSTER)
+			continue;
+
+		int iDist = GetDistance(it->second.x - m_lX, it->second.y - m_lY);
+
+		if (iDist < iMinDist)
+		{
+			iMinDist = iDist;
+			dwVID = it->first;
+			lTargetX = it->second.x;
+			lTargetY = it->second.y;
+		}
+	}
+
+	if (!dwVID)
+	{
+		CBotManager::instance().GetStat().Count(BOT_COUNTER_NO_TARGET);
+		return;
+	}
+
+	if (iMinDist > BOT_ATTACK_RANGE)
+	{
+		//     ִ ŭ ٰ.    attack   .
+		double dAngle = atan2((double) (lTargetY - m_lY), (double) (lTargetX - m_lX));
+		int iStep = MIN(iMinDist - BOT_ATTACK_RANGE / 2, 2400);
+
+		SendMove(FUNC_MOVE, m_lX + (long) (iStep * cos(dAngle)), m_lY + (long) (iStep * sin(dAngle)));
+
+		if (iStep < iMinDist - BOT_ATTACK_RANGE)
+			return;
+	}
+
+	SendMove(FUNC_ATTACK, m_lX, m_lY);
+
+	TPacketCGAttack pack;
+	pack.bHeader = HEADER_CG_ATTACK;
+	pack.bType = 0;
+	pack.dwVID = dwVID;
+	pack.bCRCMagicCubeProcPiece = 0;
+	pack.bCRCMagicCubeFilePiece = 0;
+
+	m_dwTargetVID = dwVID;
+	BeginWait(BOT_LATENCY_ATTACK);
+	Packet(&pack, sizeof(pack), true);
+}
+
+void CBot::ActionChat(const std::string & c_rstText)
+{
+	char szText[CHAT_MAX_LEN - (CHARACTER_NAME_MAX_LEN + 3) + 1];
+	std::string::size_type pos = c_rstText.find("%d");
+
+	if (pos != std::string::npos)
+		snprintf(szText, sizeof(szText), "%s%d%s", c_rstText.substr(0, pos).c_str(), m_iIndex, c_rstText.substr(pos + 2).c_str());
+	else
+		strlcpy(szText, c_rstText.c_str(), sizeof(szText));
+
+	BeginWait(BOT_LATENCY_CHAT);
+	SendChat(szText);
+}
+
+void CBot::SendChat(const char * c_pszText)
+{
+	char szText[CHAT_MAX_LEN - (CHARACTER_NAME_MAX_LEN + 3) + 1];
+	strlcpy(szText, c_pszText, sizeof(szText));
+
+	int iLen = strlen(szText) + 1;
+	char buf[sizeof(TPacketCGChat) + sizeof(szText)];
+
+	TPacketCGChat * pack = (TPacketCGChat *) buf;
+	pack->header = HEADER_CG_CHAT;
+	pack->size = sizeof(TPacketCGChat) + iLen;
+	pack->type = CHAT_TYPE_TALKING;
+	thecore_memcpy(buf + sizeof(TPacketCGChat), szText, iLen);
+
+	Packet(buf, pack->size, true);
+}
+
+void CBot::ActionUse(int iCell)
+{
+	TPacketCGItemUse pack;
+	pack.header = HEADER_CG_ITEM_USE;
+	pack.Cell = TItemPos(INVENTORY, iCell);
+
+	m_wItemCell = iCell;
+	BeginWait(BOT_LATENCY_ITEM_USE);
+	Packet(&pack, sizeof(pack), true);
+}
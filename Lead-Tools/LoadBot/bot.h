@@ -0,0 +1,127 @@
+#ifndef __INC_LOADBOT_BOT_H__
+#define __INC_LOADBOT_BOT_H__
+
+#include "bot_stat.h"
+#include "bot_replay.h"
+
+enum EBotState
+{
+	BOT_STATE_IDLE,			//  Ǵ  ٸ
+	BOT_STATE_AUTH_CONNECTING,
+	BOT_STATE_AUTH,			//   handshake ~ AUTH_SUCCESS
+	BOT_STATE_GAME_CONNECTING,
+	BOT_STATE_LOGIN,		//   handshake ~ ε
+	BOT_STATE_GAME,
+	BOT_STATE_CLOSED,		//  ٽ  
+	BOT_STATE_MAX_NUM
+};
+
+typedef struct SBotActor
+{
+	long	x;
+	long	y;
+	BYTE	bType;
+} TBotActor;
+
+class CBot
+{
+	public:
+		CBot(int iIndex);
+		~CBot();
+
+		int		GetIndex() const	{ return m_iIndex; }
+		int		GetState() const	{ return m_iState; }
+		socket_t	GetSocket() const	{ return m_sock; }
+
+		void		SetReplay(const TBotReplaySession * c_pkSession);	// ũƮ  ĸ  
+		void		Start(DWORD dwNow);	//    Ѵ
+		void		Update(DWORD dwNow);	// ,  ð ʰ, ũƮ 
+
+		void		OnWritable();
+		void		OnReadable();
+		void		OnEOF();
+
+		void		Flush();
+
+		static const char *	GetStateName(int iState);
+
+	private:
+		bool		Connect(const struct sockaddr_in & c_rkAddr, int iState);
+		void		Disconnect();
+		void		Close(bool bReconnect);
+
+		void		Packet(const void * c_pvData, int iSize, bool bSequence);
+		void		ProcessInput();
+		bool		ProcessPackets();	// ȣȭ ° ٲ true
+		bool		Analyze(const BYTE * c_pbData, int iSize);
+
+		void		SetPhase(int iPhase);
+		void		SetSecurityKey();
+		int		GetCharacterIndex() const;
+		DWORD		GetServerTime() const;
+
+		void		BeginWait(int iLatency);
+		void		EndWait(int iLatency);
+		void		CheckTimeout(DWORD dwNow);
+
+		void		RecvHandshake(const TPacketGCHandshake * p);
+		void		RecvPhase(const TPacketGCPhase * p);
+		void		RecvLoginSuccess(const TPacketGCLoginSuccess * p);
+		void		RecvMainCharacter(DWORD dwVID, long x, long y);
+		void		RecvCharacterAdd(DWORD dwVID, long x, long y, BYTE bType);
+		void		RecvDamageInfo(DWORD dwVID);
+		void		RecvItemCell(const TItemPos & c_rkCell);
+
+		void		SendLogin3();
+		void		SendLogin2();
+
+		void		RunScript(DWORD dwNow);
+		void		RunReplay(DWORD dwNow);
+		void		ActionMove(int iDistance);
+		void		ActionAttack();
+		void		ActionChat(const std::string & c_rstText);
+		void		SendChat(const char * c_pszText);
+		void		ActionUse(int iCell);
+		void		SendMove(BYTE bFunc, long x, long y);
+
+		int		m_iIndex;
+		std::string	m_stLogin;
+		int		m_iState;
+		int		m_iPhase;
+
+		socket_t	m_sock;
+		LPBUFFER	m_lpInputBuffer;
+		LPBUFFER	m_lpOutputBuffer;
+		int		m_iDecryptedInputLen;
+		bool		m_bEncrypted;
+		DWORD		m_adwEncryptKey[4];
+		DWORD		m_adwDecryptKey[4];
+		DWORD		m_adwClientKey[4];
+		int		m_iSequence;
+
+		DWORD		m_dwLoginKey;
+		DWORD		m_dwServerTimeBase;	// handshake    ð
+		DWORD		m_dwLocalTimeBase;	// ׶  ð
+		DWORD		m_dwConnectTime;
+		DWORD		m_dwNextActionTime;	// IDLE ̸ , GAME ̸  ũƮ  ð
+		int		m_iScriptPos;
+
+		bool		m_bHasCharacter;
+		DWORD		m_dwVID;
+		long		m_lX;
+		long		m_lY;
+		long		m_lHomeX;
+		long		m_lHomeY;
+		DWORD		m_dwTargetVID;
+		WORD		m_wItemCell;
+		DWORD		m_dwRestartTime;	// ׾ ڸ Ȱ û ð
+
+		const TBotReplaySession *	m_pkReplay;
+		int		m_iReplayPos;
+		DWORD		m_dwReplayStartTime;	//   ӿ  ð
+
+		std::map<DWORD, TBotActor>	m_map_kActor;
+		std::deque<DWORD>		m_adeq_dwPending[BOT_LATENCY_MAX_NUM];
+};
+
+#endif
@@ -0,0 +1,234 @@
+#include "stdafx.h"
+#include "bot.h"
+#include "bot_manager.h"
+#include "bot_packet.h"
+
+CBotManager::CBotManager() : m_fdw(NULL), m_iSpawned(0), m_dwStartTime(0), m_dwLastReportTime(0), m_bShutdown(false)
+{
+	m_kConfig.wAuthPort = 0;
+	m_kConfig.wGamePort = 0;
+	memset(&m_kConfig.kAuthAddr, 0, sizeof(m_kConfig.kAuthAddr));
+	memset(&m_kConfig.kGameAddr, 0, sizeof(m_kConfig.kGameAddr));
+
+	m_kConfig.iBotCount = 100;
+	m_kConfig.iConnectPerSec = 50;
+	m_kConfig.stAccountPrefix = "bot";
+	m_kConfig.iAccountStart = 0;
+	m_kConfig.stPassword = "1234";
+	m_kConfig.iCharacterIndex = 0;
+	m_kConfig.iReportSec = 10;
+	m_kConfig.iDurationSec = 0;
+	m_kConfig.bReconnect = false;
+	m_kConfig.dReplaySpeed = 1.0;
+}
+
+CBotManager::~CBotManager()
+{
+	Destroy();
+}
+
+static bool ResolveAddress(const std::string & c_rstHost, WORD wPort, struct sockaddr_in * pkAddr)
+{
+	memset(pkAddr, 0, sizeof(*pkAddr));
+	pkAddr->sin_family = AF_INET;
+	pkAddr->sin_port = htons(wPort);
+
+	if (isdigit((unsigned char) c_rstHost[0]))
+	{
+		pkAddr->sin_addr.s_addr = inet_addr(c_rstHost.c_str());
+		return pkAddr->sin_addr.s_addr != INADDR_NONE;
+	}
+
+	struct hostent * hp = gethostbyname(c_rstHost.c_str());
+
+	if (!hp)
+		return false;
+
+	thecore_memcpy(&pkAddr->sin_addr, hp->h_addr, sizeof(pkAddr->sin_addr));
+	return true;
+}
+
+bool CBotManager::Initialize()
+{
+	if (!ResolveAddress(m_kConfig.stAuthHost, m_kConfig.wAuthPort, &m_kConfig.kAuthAddr))
+	{
+		fprintf(stderr, "cannot resolve auth server %s\n", m_kConfig.stAuthHost.c_str());
+		return false;
+	}
+
+	if (!ResolveAddress(m_kConfig.stGameHost, m_kConfig.wGamePort, &m_kConfig.kGameAddr))
+	{
+		fprintf(stderr, "cannot resolve game server %s\n", m_kConfig.stGameHost.c_str());
+		return false;
+	}
+
+	if (!m_kConfig.stReplayFile.empty())
+	{
+		if (!m_kReplay.Load(m_kConfig.stReplayFile.c_str()))
+			return false;
+
+		m_kConfig.iBotCount = m_kReplay.GetSessionCount();
+	}
+	else if (!m_kConfig.stScriptFile.empty() && !m_kScript.Load(m_kConfig.stScriptFile.c_str()))
+		return false;
+
+	bot_packet_init();
+
+	//  ϳ  ϳ  fd ȣ 0 Ͱ ƴϹǷ  д.
+	if (!(m_fdw = fdwatch_new(m_kConfig.iBotCount + 256)))
+		return false;
+
+	m_vec_pkBot.reserve(m_kConfig.iBotCount);
+
+	for (int i = 0; i < m_kConfig.iBotCount; ++i)
+	{
+		m_vec_pkBot.push_back(new CBot(i));
+
+		if (!m_kConfig.stReplayFile.empty())
+			m_vec_pkBot.back()->SetReplay(&m_kReplay.GetSession(i));
+	}
+
+	return true;
+}
+
+void CBotManager::Destroy()
+{
+	for (size_t i = 0; i < m_vec_pkBot.size(); ++i)
+		delete m_vec_pkBot[i];
+
+	m_vec_pkBot.clear();
+
+	if (m_fdw)
+	{
+		fdwatch_delete(m_fdw);
+		m_fdw = NULL;
+	}
+}
+
+void CBotManager::Spawn(DWORD dwNow)
+{
+	if (m_iSpawned >= (int) m_vec_pkBot.size())
+		return;
+
+	// ̸ ĸ     ٿ ٴ´.
+	if (!m_kConfig.stReplayFile.empty())
+	{
+		DWORD dwFirst = m_kReplay.GetSession(0).dwConnectTime;
+		DWORD dwElapsed = (DWORD) ((dwNow - m_dwStartTime) * m_kConfig.dReplaySpeed);
+
+		while (m_iSpawned < (int) m_vec_pkBot.size() && m_kReplay.GetSession(m_iSpawned).dwConnectTime - dwFirst <= dwElapsed)
+			m_vec_pkBot[m_iSpawned++]->Start(dwNow);
+
+		return;
+	}
+
+	int iTarget = (int) ((double) (dwNow - m_dwStartTime) * m_kConfig.iConnectPerSec / 1000.0) + 1;
+
+	if (iTarget > (int) m_vec_pkBot.size())
+		iTarget = m_vec_pkBot.size();
+
+	while (m_iSpawned < iTarget)
+		m_vec_pkBot[m_iSpawned++]->Start(dwNow);
+}
+
+void CBotManager::Poll()
+{
+	struct timeval tv;
+
+	tv.tv_sec = 0;
+	tv.tv_usec = 10000;
+
+	int iEvents = fdwatch(m_fdw, &tv);
+
+	if (iEvents < 0)
+	{
+		sys_err("fdwatch: %s", strerror(errno));
+		return;
+	}
+
+	for (int iEvent = 0; iEvent < iEvents; ++iEvent)
+	{
+		CBot * pkBot = (CBot *) fdwatch_get_client_data(m_fdw, iEvent);
+
+		//      ̺Ʈ
+		if (!pkBot || pkBot->GetSocket() == INVALID_SOCKET)
+			continue;
+
+		switch (fdwatch_check_event(m_fdw, pkBot->GetSocket(), iEvent))
+		{
+			case FDW_READ:
+				pkBot->OnReadable();
+				break;
+
+			case FDW_WRITE:
+				pkBot->OnWritable();
+				break;
+
+			case FDW_EOF:
+				pkBot->OnEOF();
+				break;
+		}
+	}
+}
+
+void CBotManager::Report(DWORD dwNow)
+{
+	int aiStateCount[BOT_STATE_MAX_NUM];
+	memset(aiStateCount, 0, sizeof(aiStateCount));
+
+	for (size_t i = 0; i < m_vec_pkBot.size(); ++i)
+		++aiStateCount[m_vec_pkBot[i]->GetState()];
+
+	printf("[%6us]", (dwNow - m_dwStartTime) / 1000);
+
+	for (int i = 0; i < BOT_STATE_MAX_NUM; ++i)
+		printf(" %s %d", CBot::GetStateName(i), aiStateCount[i]);
+
+	printf("\n");
+
+	m_kStat.PrintInterval(stdout, dwNow - m_dwLastReportTime);
+	m_dwLastReportTime = dwNow;
+}
+
+void CBotManager::Run()
+{
+	m_dwStartTime = m_dwLastReportTime = get_dword_time();
+
+	if (!m_kConfig.stReplayFile.empty())
+		printf("%d sessions from %s at %.1fx to auth %s:%u game %s:%u\n",
+				m_kConfig.iBotCount, m_kConfig.stReplayFile.c_str(), m_kConfig.dReplaySpeed,
+				m_kConfig.stAuthHost.c_str(), m_kConfig.wAuthPort,
+				m_kConfig.stGameHost.c_str(), m_kConfig.wGamePort);
+	else
+		printf("%d bots, %d/s to auth %s:%u game %s:%u, account %s%d~, script %s\n",
+				m_kConfig.iBotCount, m_kConfig.iConnectPerSec,
+				m_kConfig.stAuthHost.c_str(), m_kConfig.wAuthPort,
+				m_kConfig.stGameHost.c_str(), m_kConfig.wGamePort,
+				m_kConfig.stAccountPrefix.c_str(), m_kConfig.iAccountStart,
+				m_kConfig.stScriptFile.empty() ? "(none)" : m_kConfig.stScriptFile.c_str());
+	fflush(stdout);
+
+	while (!m_bShutdown)
+	{
+		DWORD dwNow = get_dword_time();
+
+		if (m_kConfig.iDurationSec > 0 && dwNow - m_dwStartTime >= (DWORD) m_kConfig.iDurationSec * 1000)
+			break;
+
+		Spawn(dwNow);
+
+		//      ʴ´.
+		for (int i = 0; i < m_iSpawned; ++i)
+			m_vec_pkBot[i]->Update(dwNow);
+
+		Poll();
+
+		if (m_kConfig.iReportSec > 0 && dwNow - m_dwLastReportTime >= (DWORD) m_kConfig.iReportSec * 1000)
+			Report(dwNow);
+	}
+
+	DWORD dwNow = get_dword_time();
+
+	printf("[ total %us]\n", (dwNow - m_dwStartTime) / 1000);
+	m_kStat.PrintTotal(stdout, dwNow - m_dwStartTime);
+}
@@ -0,0 +1,69 @@
+#ifndef __INC_LOADBOT_BOT_MANAGER_H__
+#define __INC_LOADBOT_BOT_MANAGER_H__
+
+#include "bot_script.h"
+#include "bot_replay.h"
+#include "bot_stat.h"
+
+class CBot;
+
+typedef struct SBotConfig
+{
+	std::string		stAuthHost;
+	WORD			wAuthPort;
+	std::string		stGameHost;
+	WORD			wGamePort;
+	struct sockaddr_in	kAuthAddr;
+	struct sockaddr_in	kGameAddr;
+
+	int			iBotCount;
+	int			iConnectPerSec;		// ʴ   ϴ  
+	std::string		stAccountPrefix;	//  = prefix + ȣ
+	int			iAccountStart;
+	std::string		stPassword;
+	int			iCharacterIndex;	//   ° ĳͷ 
+	std::string		stScriptFile;
+	int			iReportSec;
+	int			iDurationSec;		// 0 ̸  
+	bool			bReconnect;		//  ٽ 
+	std::string		stReplayFile;		//  ũƮ  ĸĸ Ѵ
+	double			dReplaySpeed;		//  
+} TBotConfig;
+
+class CBotManager : public singleton<CBotManager>
+{
+	public:
+		CBotManager();
+		virtual ~CBotManager();
+
+		TBotConfig &		GetConfig()		{ return m_kConfig; }
+		CBotStat &		GetStat()		{ return m_kStat; }
+		const CBotScript &	GetScript() const	{ return m_kScript; }
+		const CBotReplay &	GetReplay() const	{ return m_kReplay; }
+		LPFDWATCH		GetFdwatch()		{ return m_fdw; }
+
+		bool			Initialize();
+		void			Destroy();
+
+		void			Run();
+		void			Shutdown()		{ m_bShutdown = true; }
+
+	private:
+		void			Spawn(DWORD dwNow);
+		void			Poll();
+		void			Report(DWORD dwNow);
+
+		TBotConfig		m_kConfig;
+		CBotStat		m_kStat;
+		CBotScript		m_kScript;
+		CBotReplay		m_kReplay;
+		LPFDWATCH		m_fdw;
+
+		std::vector<CBot *>	m_vec_pkBot;
+		int			m_iSpawned;
+		DWORD			m_dwStartTime;
+		DWORD			m_dwLastReportTime;
+		volatile bool		m_bShutdown;
+};
+
+#endif
@@ -0,0 +1,153 @@
+#include "stdafx.h"
+#include "bot_packet.h"
+
+static int	s_aiPacketSize[256];
+static bool	s_abDynamicPacket[256];
+
+static void Set(int iHeader, int iSize, bool bDynamic)
+{
+	s_aiPacketSize[iHeader] = iSize;
+	s_abDynamicPacket[iHeader] = bDynamic;
+}
+
+void bot_packet_init()
+{
+	memset(s_aiPacketSize, 0,sizeof(s_aiPacketSize));
+	memset(s_abDynamicPacket, 0,sizeof(s_abDynamicPacket));
+
+	Set(HEADER_GC_EMPIRE,		sizeof(TPacketGCEmpire), false);
+	Set(HEADER_GC_WARP,		sizeof(TPacketGCWarp), false);
+	Set(HEADER_GC_QUEST_INFO,	sizeof(TPacketGCQuestInfo), true);
+	Set(HEADER_GC_REQUEST_MAKE_GUILD,	sizeof(TPacketGCBlank), false);
+	Set(HEADER_GC_PVP,		sizeof(TPacketGCPVP), false);
+	Set(HEADER_GC_DUEL_START,	sizeof(TPacketGCDuelStart), true);
+	Set(HEADER_GC_CHARACTER_ADD,	sizeof(TPacketGCCharacterAdd), false);
+	Set(HEADER_GC_CHARACTER_ADD_BULK,	sizeof(TPacketGCCharacterAddBulk), true);
+	Set(HEADER_GC_CHAR_ADDITIONAL_INFO,	sizeof(TPacketGCCharacterAdditionalInfo), false);
+	Set(HEADER_GC_CHARACTER_UPDATE,	sizeof(TPacketGCCharacterUpdate), false);
+	Set(HEADER_GC_CHARACTER_DEL,	sizeof(TPacketGCCharacterDelete), false);
+	Set(HEADER_GC_MOVE,		sizeof(TPacketGCMove), false);
+	Set(HEADER_GC_MOVE_BULK,	sizeof(TPacketGCMoveBulk), true);
+	Set(HEADER_GC_CHARACTER_POINT_CHANGE_BULK,	sizeof(TPacketGCPointChangeBulk), true);
+	Set(HEADER_GC_CHAT,		sizeof(TPacketGCChat), true);
+	Set(HEADER_GC_SYNC_POSITION,	sizeof(TPacketGCSyncPosition), true);
+	Set(HEADER_GC_LOGIN_SUCCESS,	sizeof(TPacketGCLoginSuccess), false);
+	Set(HEADER_GC_LOGIN_FAILURE,	sizeof(TPacketGCLoginFailure), false);
+	Set(HEADER_GC_CHARACTER_CREATE_SUCCESS,	sizeof(TPacketGCCharacterCreateSuccess), false);
+	Set(HEADER_GC_CHARACTER_CREATE_FAILURE,	sizeof(TPacketGCCreateFailure), false);
+	Set(HEADER_GC_CHARACTER_DELETE_SUCCESS,	sizeof(TPacketGCBlank), false);
+	Set(HEADER_GC_CHARACTER_DELETE_WRONG_SOCIAL_ID,	sizeof(TPacketGCBlank), false);
+	Set(HEADER_GC_STUN,		sizeof(TPacketGCStun), false);
+	Set(HEADER_GC_DEAD,		sizeof(TPacketGCDead), false);
+	Set(HEADER_GC_MAIN_CHARACTER,	sizeof(TPacketGCMainCharacter), false);
+	Set(HEADER_GC_MAIN_CHARACTER3_BGM,	sizeof(TPacketGCMainCharacter3_BGM), false);
+	Set(HEADER_GC_MAIN_CHARACTER4_BGM_VOL,	sizeof(TPacketGCMainCharacter4_BGM_VOL), false);
+	Set(HEADER_GC_CHARACTER_POINTS,	sizeof(TPacketGCPoints), false);
+	Set(HEADER_GC_CHARACTER_POINT_CHANGE,	sizeof(TPacketGCPointChange), false);
+	Set(HEADER_GC_ITEM_DEL,		sizeof(TPacketGCItemDelDeprecated), false);
+	Set(HEADER_GC_ITEM_SET,		sizeof(TPacketGCItemSet), false);
+	Set(HEADER_GC_ITEM_UPDATE,	sizeof(TPacketGCItemUpdate), false);
+	Set(HEADER_GC_ITEM_GROUND_ADD,	sizeof(TPacketGCItemGroundAdd), false);
+	Set(HEADER_GC_ITEM_GROUND_DEL,	sizeof(TPacketGCItemGroundDel), false);
+	Set(HEADER_GC_ITEM_OWNERSHIP,	sizeof(TPacketGCItemOwnership), false);
+	Set(HEADER_GC_QUICKSLOT_ADD,	sizeof(TPacketGCQuickslotAdd), false);
+	Set(HEADER_GC_QUICKSLOT_DEL,	sizeof(TPacketGCQuickslotDel), false);
+	Set(HEADER_GC_QUICKSLOT_SWAP,	sizeof(TPacketGCQuickSlotSwap), false);
+	Set(HEADER_GC_WHISPER,		sizeof(TPacketGCWhisper), true);
+	Set(HEADER_GC_CHARACTER_POSITION,	sizeof(TPacketGCPosition), false);
+	Set(HEADER_GC_MOTION,		sizeof(TPacketGCMotion), false);
+	Set(HEADER_GC_SHOP,		sizeof(TPacketGCShop), true);
+	Set(HEADER_GC_SHOP_SIGN,	sizeof(TPacketGCShopSign), false);
+	Set(HEADER_GC_EXCHANGE,		sizeof(TPacketGCExchange), false);
+	Set(HEADER_GC_PING,		sizeof(TPacketGCPing), false);
+	Set(HEADER_GC_COMPRESSED_PACKET,	sizeof(TPacketGCCompressedPacket), true);
+	Set(HEADER_GC_SCRIPT,		sizeof(TPacketGCScript), true);
+	Set(HEADER_GC_QUEST_CONFIRM,	sizeof(TPacketGCQuestConfirm), false);
+	Set(HEADER_GC_TARGET,		sizeof(TPacketGCTarget), false);
+	Set(HEADER_GC_CHANGE_SPEED,	sizeof(TPacketGCChangeSpeed), false);
+	Set(HEADER_GC_HANDSHAKE,	sizeof(TPacketGCHandshake), false);
+	Set(HEADER_GC_TIME_SYNC,	sizeof(TPacketGCBlank), false);
+	Set(HEADER_GC_OWNERSHIP,	sizeof(TPacketGCOwnership), false);
+	Set(HEADER_GC_CREATE_FLY,	sizeof(TPacketGCCreateFly), false);
+	Set(HEADER_GC_ADD_FLY_TARGETING,	sizeof(TPacketGCFlyTargeting), false);
+	Set(HEADER_GC_FLY_TARGETING,	sizeof(TPacketGCFlyTargeting), false);
+	Set(HEADER_GC_PHASE,		sizeof(TPacketGCPhase), false);
+	Set(HEADER_GC_SKILL_LEVEL,	sizeof(TPacketGCSkillLevel), false);
+	Set(HEADER_GC_MESSENGER,	sizeof(TPacketGCMessenger), true);
+	Set(HEADER_GC_GUILD,		sizeof(TPacketGCGuild), true);
+	Set(HEADER_GC_PARTY_INVITE,	sizeof(TPacketGCPartyInvite), false);
+	Set(HEADER_GC_PARTY_ADD,	sizeof(TPacketGCPartyAdd), false);
+	Set(HEADER_GC_PARTY_UPDATE,	sizeof(TPacketGCPartyUpdate), false);
+	Set(HEADER_GC_PARTY_UPDATE_BULK,	sizeof(TPacketGCPartyUpdateBulk), true);
+	Set(HEADER_GC_PARTY_REMOVE,	sizeof(TPacketGCPartyRemove), false);
+	Set(HEADER_GC_PARTY_LINK,	sizeof(TPacketGCPartyLink), false);
+	Set(HEADER_GC_PARTY_UNLINK,	sizeof(TPacketGCPartyUnlink), false);
+	Set(HEADER_GC_PARTY_PARAMETER,	sizeof(TPacketGCPartyParameter), false);
+	Set(HEADER_GC_SAFEBOX_SET,	sizeof(TPacketGCItemSet), false);
+	Set(HEADER_GC_SAFEBOX_DEL,	sizeof(TPacketGCItemDel), false);
+	Set(HEADER_GC_SAFEBOX_WRONG_PASSWORD,	sizeof(TPacketGCSafeboxWrongPassword), false);
+	Set(HEADER_GC_SAFEBOX_SIZE,	sizeof(TPacketGCSafeboxSize), false);
+	Set(HEADER_GC_FISHING,		sizeof(TPacketGCFishing), false);
+	Set(HEADER_GC_DUNGEON,		sizeof(TPacketGCDungeon), true);
+	Set(HEADER_GC_TIME,		sizeof(TPacketGCTime), false);
+	Set(HEADER_GC_WALK_MODE,	sizeof(TPacketGCWalkMode), false);
+	Set(HEADER_GC_SKILL_GROUP,	sizeof(TPacketGCChangeSkillGroup), false);
+	Set(HEADER_GC_REFINE_INFORMATION,	sizeof(TPacketGCRefineInformation), false);
+	Set(HEADER_GC_SPECIAL_EFFECT,	sizeof(TPacketGCSpecialEffect), false);
+	Set(HEADER_GC_NPC_POSITION,	sizeof(TPacketGCNPCPosition), true);
+	Set(HEADER_GC_CHANGE_NAME,	sizeof(TPacketGCChangeName), false);
+	Set(HEADER_GC_LOGIN_KEY,	sizeof(TPacketGCLoginKey), false);
+	Set(HEADER_GC_AUTH_SUCCESS,	sizeof(TPacketGCAuthSuccess), false);
+	Set(HEADER_GC_CHANNEL,		sizeof(TPacketGCChannel), false);
+	Set(HEADER_GC_VIEW_EQUIP,	sizeof(TPacketGCViewEquip), false);
+	Set(HEADER_GC_LAND_LIST,	sizeof(TPacketGCLandList), true);
+	Set(HEADER_GC_TARGET_UPDATE,	sizeof(TPacketGCTargetUpdate), false);
+	Set(HEADER_GC_TARGET_DELETE,	sizeof(TPacketGCTargetDelete), false);
+	Set(HEADER_GC_TARGET_CREATE,	sizeof(TPacketGCTargetCreate), false);
+	Set(HEADER_GC_AFFECT_ADD,	sizeof(TPacketGCAffectAdd), false);
+	Set(HEADER_GC_AFFECT_REMOVE,	sizeof(TPacketGCAffectRemove), false);
+	Set(HEADER_GC_MALL_OPEN,	sizeof(TPacketGCSafeboxSize), false);
+	Set(HEADER_GC_MALL_SET,		sizeof(TPacketGCItemSet), false);
+	Set(HEADER_GC_MALL_DEL,		sizeof(TPacketGCItemDel), false);
+	Set(HEADER_GC_LOVER_INFO,	sizeof(TPacketGCLoverInfo), false);
+	Set(HEADER_GC_LOVE_POINT_UPDATE,	sizeof(TPacketGCLovePointUpdate), false);
+	Set(HEADER_GC_DIG_MOTION,	sizeof(TPacketGCDigMotion), false);
+	Set(HEADER_GC_DAMAGE_INFO,	sizeof(TPacketGCDamageInfo), false);
+	Set(HEADER_GC_DAMAGE_INFO_BULK,	sizeof(TPacketGCDamageInfoBulk), true);
+	Set(HEADER_GC_HYBRIDCRYPT_KEYS,	sizeof(TDynamicSizePacketHeader), true);
+	Set(HEADER_GC_HYBRIDCRYPT_SDB,	sizeof(TDynamicSizePacketHeader), true);
+	Set(HEADER_GC_SPECIFIC_EFFECT,	sizeof(TPacketGCSpecificEffect), false);
+	Set(HEADER_GC_DRAGON_SOUL_REFINE,	sizeof(TPacketGCDragonSoulRefine), false);
+}
+
+int bot_packet_get_size(const BYTE * c_pbData, int iBytes)
+{
+	BYTE bHeader = c_pbData[0];
+
+	// ȣȭ  8 Ʈ ߴ ä 0
+	if (bHeader == 0)
+		return 1;
+
+	int iSize = s_aiPacketSize[bHeader];
+
+	if (!iSize)
+		return -1;
+
+	if (s_abDynamicPacket[bHeader])
+	{
+		if (iBytes < (int) sizeof(TDynamicSizePacketHeader))
+			return 0;
+
+		WORD wSize = ((const TDynamicSizePacketHeader *) c_pbData)->size;
+
+		if (wSize < sizeof(TDynamicSizePacketHeader))
+			return -1;
+
+		iSize = wSize;
+	}
+
+	if (iBytes < iSize)
+		return 0;
+
+	return iSize;
+}
@@ -0,0 +1,11 @@
+#ifndef __INC_LOADBOT_BOT_PACKET_H__
+#define __INC_LOADBOT_BOT_PACKET_H__
+
+//   Ŷ(GC) ǥ. Ŭ̾Ʈ CMainPacketHeaderMap   ̴.
+//  Ŷ   WORD    ü ̴.
+extern void	bot_packet_init();
+
+// ϼ Ŷ ̸ ش.    0, 𸣴  -1.
+extern int	bot_packet_get_size(const BYTE * c_pbData, int iBytes);
+
+#endif
@@ -0,0 +1,178 @@
+#include "stdafx.h"
+#include "bot_replay.h"
+#include "common/packet_capture.h"
+
+typedef struct SBotReplayBuild
+{
+	TBotReplaySession	kSession;
+	bool			bLogin;		// LOGIN2  
+} TBotReplayBuild;
+
+CBotReplay::CBotReplay()
+{
+}
+
+bool CBotReplay::Load(const char * c_pszFileName)
+{
+	FILE * fp = fopen(c_pszFileName, "rb");
+
+	if (!fp)
+	{
+		fprintf(stderr, "cannot open capture %s\n", c_pszFileName);
+		return false;
+	}
+
+	TPacketCaptureHeader header;
+
+	if (fread(&header, sizeof(header), 1, fp) != 1 || header.dwMagic != PACKET_CAPTURE_MAGIC)
+	{
+		fprintf(stderr, "%s: not a packet capture file\n", c_pszFileName);
+		fclose(fp);
+		return false;
+	}
+
+	if (header.wVersion != PACKET_CAPTURE_VERSION)
+	{
+		fprintf(stderr, "%s: capture version %u, expected %u\n", c_pszFileName, header.wVersion, PACKET_CAPTURE_VERSION);
+		fclose(fp);
+		return false;
+	}
+
+	std::vector<TBotReplayBuild> vec_kBuild;
+	std::map<DWORD, size_t> map_kOpen;	// handle -> vec_kBuild ġ,  handle  ٽ   ִ
+
+	TPacketCaptureRecord rec;
+	std::vector<BYTE> vec_bPacket;
+	DWORD dwRecords = 0;
+	DWORD dwSkippedPackets = 0;
+
+	m_vec_bData.clear();
+	m_vec_kSession.clear();
+
+	while (fread(&rec, sizeof(rec), 1, fp) == 1)
+	{
+		vec_bPacket.resize(rec.wSize);
+
+		if (rec.wSize && fread(&vec_bPacket[0], rec.wSize, 1, fp) != 1)
+		{
+			fprintf(stderr, "%s: truncated at record %u, using what was read\n", c_pszFileName, dwRecords);
+			break;
+		}
+
+		++dwRecords;
+
+		std::map<DWORD, size_t>::iterator it = map_kOpen.find(rec.dwHandle);
+
+		if (rec.bType == PACKET_CAPTURE_CONNECT)
+		{
+			TBotReplayBuild kBuild;
+
+			kBuild.kSession.dwHandle = rec.dwHandle;
+			kBuild.kSession.dwConnectTime = rec.dwTime;
+			kBuild.kSession.dwEnterTime = 0;
+			kBuild.kSession.bClosed = false;
+			kBuild.kSession.iCharacterIndex = 0;
+			kBuild.bLogin = false;
+
+			// ĸĸ ѱ  ִ  ù Ŷ handshake  ƴϹǷ   .
+			map_kOpen[rec.dwHandle] = vec_kBuild.size();
+			vec_kBuild.push_back(kBuild);
+			continue;
+		}
+
+		if (it == map_kOpen.end())
+			continue;
+
+		TBotReplayBuild & rkBuild = vec_kBuild[it->second];
+		TBotReplaySession & rkSession = rkBuild.kSession;
+
+		if (rec.bType == PACKET_CAPTURE_CLOSE)
+		{
+			rkSession.bClosed = true;
+			map_kOpen.erase(it);
+			continue;
+		}
+
+		if (rec.bType != PACKET_CAPTURE_PACKET || !rec.wSize)
+			continue;
+
+		BYTE bHeader = vec_bPacket[0];
+
+		switch (rec.bPhase)
+		{
+			case PHASE_LOGIN:
+				if (bHeader == HEADER_CG_LOGIN2 && rec.wSize >= sizeof(TPacketCGLogin2))
+				{
+					const TPacketCGLogin2 * p = (const TPacketCGLogin2 *) &vec_bPacket[0];
+					char szLogin[LOGIN_MAX_LEN + 1];
+
+					strlcpy(szLogin, p->login, sizeof(szLogin));
+					rkSession.stLogin = szLogin;
+					rkBuild.bLogin = true;
+				}
+				break;
+
+			case PHASE_SELECT:
+				if (bHeader == HEADER_CG_CHARACTER_SELECT && rec.wSize >= sizeof(TPacketCGCharacterSelect))
+					rkSession.iCharacterIndex = ((const TPacketCGCharacterSelect *) &vec_bPacket[0])->index;
+				break;
+
+			case PHASE_LOADING:
+				if (bHeader == HEADER_CG_ENTERGAME)
+					rkSession.dwEnterTime = rec.dwTime;
+				break;
+
+			case PHASE_GAME:
+			case PHASE_DEAD:
+				// ð  ping    ְ޴´.
+				if (bHeader == HEADER_CG_PONG || bHeader == HEADER_CG_TIME_SYNC || bHeader == HEADER_CG_HANDSHAKE)
+					break;
+
+				if (!rkSession.dwEnterTime)
+				{
+					++dwSkippedPackets;
+					break;
+				}
+
+				{
+					TBotReplayPacket kPacket;
+
+					kPacket.dwTime = rec.dwTime - rkSession.dwEnterTime;
+					kPacket.dwOffset = m_vec_bData.size();
+					kPacket.wSize = rec.wSize;
+					kPacket.bSequence = rec.bSequence != 0;
+
+					m_vec_bData.insert(m_vec_bData.end(), vec_bPacket.begin(), vec_bPacket.end());
+					rkSession.vec_kPacket.push_back(kPacket);
+				}
+				break;
+		}
+	}
+
+	fclose(fp);
+
+	DWORD dwNoLogin = 0;
+
+	for (size_t i = 0; i < vec_kBuild.size(); ++i)
+	{
+		//    ̳ α      .
+		if (!vec_kBuild[i].bLogin || !vec_kBuild[i].kSession.dwEnterTime || vec_kBuild[i].kSession.iCharacterIndex >= PLAYER_PER_ACCOUNT)
+		{
+			++dwNoLogin;
+			continue;
+		}
+
+		m_vec_kSession.push_back(vec_kBuild[i].kSession);
+	}
+
+	printf("%s: %u records, %d sessions to replay, %u without game login, %u packets before enter skipped\n",
+			c_pszFileName, dwRecords, GetSessionCount(), dwNoLogin, dwSkippedPackets);
+
+	if (m_vec_kSession.empty())
+	{
+		fprintf(stderr, "%s: nothing to replay\n", c_pszFileName);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,50 @@
+#ifndef __INC_LOADBOT_BOT_REPLAY_H__
+#define __INC_LOADBOT_BOT_REPLAY_H__
+
+//
+// game  packet_capture  Ӻ  д´.
+//
+//  ϳ  ϳ þ ĸ   ð ٴ´. handshake, , α
+//    ϰ ( ĸ LOGIN2, йȣ -w), ĸ ĳ 
+//   GAME/DEAD phase  ޾Ҵ Ŷ ENTERGAME  ð  .
+// sequence Ʈ MOVE  ð  ä PONG, TIME_SYNC    Ѵ.
+//
+// VID  ø ޶Ƿ VID  Ű Ŷ(  ) ״ 
+//   ִ.   ,  DB    ؾ ġ ´´.
+//
+typedef struct SBotReplayPacket
+{
+	DWORD	dwTime;		// ENTERGAME  ms
+	DWORD	dwOffset;	// CBotReplay    ġ
+	WORD	wSize;
+	bool	bSequence;
+} TBotReplayPacket;
+
+typedef struct SBotReplaySession
+{
+	DWORD				dwHandle;
+	DWORD				dwConnectTime;	// ĸ ۺ ms
+	DWORD				dwEnterTime;	// ENTERGAME   ð, 0 ̸  
+	bool				bClosed;	// ĸ ȿ 
+	std::string			stLogin;
+	int				iCharacterIndex;
+	std::vector<TBotReplayPacket>	vec_kPacket;
+} TBotReplaySession;
+
+class CBotReplay
+{
+	public:
+		CBotReplay();
+
+		bool				Load(const char * c_pszFileName);
+
+		int				GetSessionCount() const		{ return m_vec_kSession.size(); }
+		const TBotReplaySession &	GetSession(int iIndex) const	{ return m_vec_kSession[iIndex]; }
+		const BYTE *			GetData(const TBotReplayPacket & c_rkPacket) const	{ return &m_vec_bData[c_rkPacket.dwOffset]; }
+
+	private:
+		std::vector<TBotReplaySession>	m_vec_kSession;
+		std::vector<BYTE>		m_vec_bData;
+};
+
+#endif
@@ -0,0 +1,137 @@
+#include "stdafx.h"
+#include "bot_script.h"
+
+CBotScript::CBotScript()
+{
+}
+
+bool CBotScript::Load(const char * c_pszFileName)
+{
+	FILE * fp = fopen(c_pszFileName, "r");
+
+	if (!fp)
+	{
+		fprintf(stderr, "cannot open script %s\n", c_pszFileName);
+		return false;
+	}
+
+	m_vec_kAction.clear();
+
+	char szLine[1024];
+	int iLine = 0;
+	bool bRet = true;
+
+	while (fgets(szLine, sizeof(szLine), fp))
+	{
+		++iLine;
+
+		if (!ParseLine(szLine, iLine, c_pszFileName))
+		{
+			bRet = false;
+			break;
+		}
+	}
+
+	fclose(fp);
+
+	if (bRet && m_vec_kAction.empty())
+	{
+		fprintf(stderr, "%s: no action\n", c_pszFileName);
+		bRet = false;
+	}
+
+	return bRet;
+}
+
+bool CBotScript::ParseLine(char * pszLine, int iLine, const char * c_pszFileName)
+{
+	char * p = pszLine;
+
+	while (*p && isspace((unsigned char) *p))
+		++p;
+
+	char * pszEnd = p + strlen(p);
+
+	while (pszEnd > p && isspace((unsigned char) *(pszEnd - 1)))
+		*(--pszEnd) = '\0';
+
+	if (!*p || *p == '#')
+		return true;
+
+	char * pszArg = p;
+
+	while (*pszArg && !isspace((unsigned char) *pszArg))
+		++pszArg;
+
+	if (*pszArg)
+	{
+		*(pszArg++) = '\0';
+
+		while (*pszArg && isspace((unsigned char) *pszArg))
+			++pszArg;
+	}
+
+	TBotAction kAction;
+	kAction.iArg = 0;
+	kAction.iJitter = 0;
+
+	if (!strcasecmp(p, "move"))
+	{
+		kAction.iType = BOT_ACTION_MOVE;
+		kAction.iArg = atoi(pszArg);
+
+		if (kAction.iArg <= 0)
+		{
+			fprintf(stderr, "%s:%d: move needs a distance\n", c_pszFileName, iLine);
+			return false;
+		}
+
+		//    25m Ѱ ̸ ǵ.
+		if (kAction.iArg > 2400)
+			kAction.iArg = 2400;
+	}
+	else if (!strcasecmp(p, "attack"))
+	{
+		kAction.iType = BOT_ACTION_ATTACK;
+	}
+	else if (!strcasecmp(p, "chat"))
+	{
+		kAction.iType = BOT_ACTION_CHAT;
+		kAction.stText = pszArg;
+
+		if (kAction.stText.empty())
+		{
+			fprintf(stderr, "%s:%d: chat needs a text\n", c_pszFileName, iLine);
+			return false;
+		}
+	}
+	else if (!strcasecmp(p, "use"))
+	{
+		kAction.iType = BOT_ACTION_USE;
+		kAction.iArg = atoi(pszArg);
+
+		if (kAction.iArg < 0 || kAction.iArg >= INVENTORY_MAX_NUM)
+		{
+			fprintf(stderr, "%s:%d: invalid inventory cell %d\n", c_pszFileName, iLine, kAction.iArg);
+			return false;
+		}
+	}
+	else if (!strcasecmp(p, "wait"))
+	{
+		kAction.iType = BOT_ACTION_WAIT;
+
+		if (sscanf(pszArg, "%d %d", &kAction.iArg, &kAction.iJitter) < 1 || kAction.iArg < 0 || kAction.iJitter < 0)
+		{
+			fprintf(stderr, "%s:%d: wait needs milliseconds\n", c_pszFileName, iLine);
+			return false;
+		}
+	}
+	else
+	{
+		fprintf(stderr, "%s:%d: unknown action %s\n", c_pszFileName, iLine, p);
+		return false;
+	}
+
+	m_vec_kAction.push_back(kAction);
+	return true;
+}
@@ -0,0 +1,50 @@
+#ifndef __INC_LOADBOT_BOT_SCRIPT_H__
+#define __INC_LOADBOT_BOT_SCRIPT_H__
+
+//
+//  ൿ ũƮ.  ٿ  ϳ̰   ó ٽ Ѵ.
+//
+//	move <Ÿ>		  Ÿŭ ȴ´ (ִ 2400)
+//	attack			  Ϳ ٰ   ģ
+//	chat <>		Ϲ ä.   %d   ȣ ٲ
+//	use <ĭ>		κ丮 ĭ  Ѵ
+//	wait <ms> [鸲]	ms  0 ~ 鸲 ms   ŭ 
+//
+// #  ϴ ٰ   Ѵ.
+//
+enum EBotAction
+{
+	BOT_ACTION_MOVE,
+	BOT_ACTION_ATTACK,
+	BOT_ACTION_CHAT,
+	BOT_ACTION_USE,
+	BOT_ACTION_WAIT,
+	BOT_ACTION_MAX_NUM
+};
+
+typedef struct SBotAction
+{
+	int		iType;
+	int		iArg;
+	int		iJitter;
+	std::string	stText;
+} TBotAction;
+
+class CBotScript
+{
+	public:
+		CBotScript();
+
+		bool			Load(const char * c_pszFileName);
+
+		bool			IsEmpty() const		{ return m_vec_kAction.empty(); }
+		int			GetActionCount() const	{ return m_vec_kAction.size(); }
+		const TBotAction &	GetAction(int iIndex) const	{ return m_vec_kAction[iIndex]; }
+
+	private:
+		bool			ParseLine(char * pszLine, int iLine, const char * c_pszFileName);
+
+		std::vector<TBotAction>	m_vec_kAction;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "stdafx.h"
+#include "bot_stat.h"
+
+CBotStat::CBotStat()
+{
+	for (int i = 0; i < BOT_LATENCY_MAX_NUM; ++i)
+	{
+		histogram_reset(&m_akHistogram[i]);
+		histogram_reset(&m_akTotalHistogram[i]);
+	}
+
+	memset(m_adwTimeout, 0, sizeof(m_adwTimeout));
+	memset(m_adwTotalTimeout, 0, sizeof(m_adwTotalTimeout));
+	memset(m_adwCounter, 0, sizeof(m_adwCounter));
+	memset(m_adwTotalCounter, 0, sizeof(m_adwTotalCounter));
+}
+
+const char * CBotStat::GetLatencyName(int iLatency)
+{
+	static const char * s_apszName[BOT_LATENCY_MAX_NUM] =
+	{
+		"connect",
+		"handshake",
+		"auth",
+		"login",
+		"select",
+		"enter",
+		"chat",
+		"attack",
+		"item_use",
+	};
+
+	if (iLatency < 0 || iLatency >= BOT_LATENCY_MAX_NUM)
+		return "unknown";
+
+	return s_apszName[iLatency];
+}
+
+void CBotStat::Record(int iLatency, DWORD dwMSec)
+{
+	histogram_record(&m_akHistogram[iLatency], dwMSec);
+	histogram_record(&m_akTotalHistogram[iLatency], dwMSec);
+}
+
+void CBotStat::PrintTable(FILE * fp, const HISTOGRAM * c_pkHistogram, const DWORD * c_pdwTimeout, const DWORD * c_pdwCounter, DWORD dwElapsedMSec)
+{
+	double dSec = dwElapsedMSec > 0 ? dwElapsedMSec / 1000.0 : 1.0;
+
+	fprintf(fp, "  packets in %.0f/s out %.0f/s  bytes in %.1fKB/s out %.1fKB/s  connect_fail %u login_fail %u disconnect %u no_target %u\n",
+			c_pdwCounter[BOT_COUNTER_PACKET_IN] / dSec,
+			c_pdwCounter[BOT_COUNTER_PACKET_OUT] / dSec,
+			c_pdwCounter[BOT_COUNTER_BYTES_IN] / dSec / 1024.0,
+			c_pdwCounter[BOT_COUNTER_BYTES_OUT] / dSec / 1024.0,
+			c_pdwCounter[BOT_COUNTER_CONNECT_FAIL],
+			c_pdwCounter[BOT_COUNTER_LOGIN_FAIL],
+			c_pdwCounter[BOT_COUNTER_DISCONNECT],
+			c_pdwCounter[BOT_COUNTER_NO_TARGET]);
+
+	if (c_pdwCounter[BOT_COUNTER_REPLAY_PACKET] || c_pdwCounter[BOT_COUNTER_REPLAY_END])
+		fprintf(fp, "  replayed %.0f/s  sessions finished %u\n",
+				c_pdwCounter[BOT_COUNTER_REPLAY_PACKET] / dSec,
+				c_pdwCounter[BOT_COUNTER_REPLAY_END]);
+
+	fprintf(fp, "  %-10s %8s %7s %7s %7s %7s %7s %8s\n", "ms", "count", "mean", "p50", "p90", "p99", "max", "timeout");
+
+	for (int i = 0; i < BOT_LATENCY_MAX_NUM; ++i)
+	{
+		const HISTOGRAM * h = &c_pkHistogram[i];
+
+		if (!h->total_count && !c_pdwTimeout[i])
+			continue;
+
+		fprintf(fp, "  %-10s %8u %7u %7u %7u %7u %7u %8u\n",
+				GetLatencyName(i),
+				h->total_count,
+				histogram_mean(h),
+				histogram_percentile(h, 50.0),
+				histogram_percentile(h, 90.0),
+				histogram_percentile(h, 99.0),
+				h->total_count ? h->max_value : 0,
+				c_pdwTimeout[i]);
+	}
+}
+
+void CBotStat::PrintInterval(FILE * fp, DWORD dwElapsedMSec)
+{
+	PrintTable(fp, m_akHistogram, m_adwTimeout, m_adwCounter, dwElapsedMSec);
+	fflush(fp);
+
+	for (int i = 0; i < BOT_LATENCY_MAX_NUM; ++i)
+		histogram_reset(&m_akHistogram[i]);
+
+	memset(m_adwTimeout, 0, sizeof(m_adwTimeout));
+	memset(m_adwCounter, 0, sizeof(m_adwCounter));
+}
+
+void CBotStat::PrintTotal(FILE * fp, DWORD dwElapsedMSec)
+{
+	PrintTable(fp, m_akTotalHistogram, m_adwTotalTimeout, m_adwTotalCounter, dwElapsedMSec);
+	fflush(fp);
+}
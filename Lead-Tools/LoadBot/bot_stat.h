@@ -0,0 +1,68 @@
+#ifndef __INC_LOADBOT_BOT_STAT_H__
+#define __INC_LOADBOT_BOT_STAT_H__
+
+//
+//   ð(ms)  ׷ .
+//  ֱ⸶    ,   ü   ´.
+//
+enum EBotLatency
+{
+	BOT_LATENCY_CONNECT,	// connect û ->  Ϸ
+	BOT_LATENCY_HANDSHAKE,	//  Ϸ -> ù phase Ŷ
+	BOT_LATENCY_AUTH,	// LOGIN3 -> AUTH_SUCCESS
+	BOT_LATENCY_LOGIN,	// LOGIN2 -> LOGIN_SUCCESS
+	BOT_LATENCY_SELECT,	// CHARACTER_SELECT -> MAIN_CHARACTER
+	BOT_LATENCY_ENTER,	// ENTERGAME -> PHASE_GAME
+	BOT_LATENCY_CHAT,	// CHAT -> ڱ ä ǵƿ
+	BOT_LATENCY_ATTACK,	// ATTACK ->  DAMAGE_INFO
+	BOT_LATENCY_ITEM_USE,	// ITEM_USE ->  ĭ ITEM_SET/UPDATE/DEL
+	BOT_LATENCY_MAX_NUM
+};
+
+enum EBotCounter
+{
+	BOT_COUNTER_CONNECT_FAIL,
+	BOT_COUNTER_LOGIN_FAIL,
+	BOT_COUNTER_DISCONNECT,
+	BOT_COUNTER_PACKET_IN,
+	BOT_COUNTER_PACKET_OUT,
+	BOT_COUNTER_BYTES_IN,
+	BOT_COUNTER_BYTES_OUT,
+	BOT_COUNTER_NO_TARGET,
+	BOT_COUNTER_REPLAY_PACKET,
+	BOT_COUNTER_REPLAY_END,		// ĸ Ŷ   
+	BOT_COUNTER_MAX_NUM
+};
+
+enum
+{
+	BOT_RESPONSE_TIMEOUT	= 10000,	// ̺    Ҿ  
+};
+
+class CBotStat
+{
+	public:
+		CBotStat();
+
+		void		Record(int iLatency, DWORD dwMSec);
+		void		Timeout(int iLatency)		{ ++m_adwTimeout[iLatency]; ++m_adwTotalTimeout[iLatency]; }
+		void		Count(int iCounter, DWORD dwValue = 1)	{ m_adwCounter[iCounter] += dwValue; m_adwTotalCounter[iCounter] += dwValue; }
+
+		//  ֱ    .    θ  տ ´.
+		void		PrintInterval(FILE * fp, DWORD dwElapsedMSec);
+		void		PrintTotal(FILE * fp, DWORD dwElapsedMSec);
+
+		static const char *	GetLatencyName(int iLatency);
+
+	private:
+		void		PrintTable(FILE * fp, const HISTOGRAM * c_pkHistogram, const DWORD * c_pdwTimeout, const DWORD * c_pdwCounter, DWORD dwElapsedMSec);
+
+		HISTOGRAM	m_akHistogram[BOT_LATENCY_MAX_NUM];
+		HISTOGRAM	m_akTotalHistogram[BOT_LATENCY_MAX_NUM];
+		DWORD		m_adwTimeout[BOT_LATENCY_MAX_NUM];
+		DWORD		m_adwTotalTimeout[BOT_LATENCY_MAX_NUM];
+		DWORD		m_adwCounter[BOT_COUNTER_MAX_NUM];
+		DWORD		m_adwTotalCounter[BOT_COUNTER_MAX_NUM];
+};
+
+#endif
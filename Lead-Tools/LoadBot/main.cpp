@@ -0,0 +1,165 @@
+#include "stdafx.h"
+#include "bot_manager.h"
+
+static void usage()
+{
+	printf("usage: loadbot -a <auth host:port> -g <game host:port> [options]\n"
+			"-n <count>      : number of bots (default 100)\n"
+			"-r <per sec>    : bots to start connecting per second (default 50)\n"
+			"-u <prefix>     : account name prefix, account = prefix + number (default bot)\n"
+			"-i <start>      : first account number (default 0)\n"
+			"-w <password>   : password of every account (default 1234)\n"
+			"-c <slot>       : character slot to play (default 0)\n"
+			"-s <script>     : behaviour script, see bot_script.h (default none, bots idle in game)\n"
+			"-t <sec>        : report interval (default 10, 0 to report only at exit)\n"
+			"-d <sec>        : run for sec seconds (default 0, until interrupted)\n"
+			"-x              : reconnect bots that lost the connection\n"
+			"-p <capture>    : replay a game packet_capture file, one bot per captured session\n"
+			"                  (accounts from the capture, password from -w, -n -r -u -i -c -s ignored)\n"
+			"-S <speed>      : replay speed, 2 plays twice as fast (default 1)\n"
+			"-l <level>      : sets log level\n");
+}
+
+static bool ParseAddress(const char * c_pszArg, std::string & rstHost, WORD & rwPort)
+{
+	const char * c_pszColon = strrchr(c_pszArg, ':');
+
+	if (!c_pszColon || c_pszColon == c_pszArg)
+		return false;
+
+	int iPort = atoi(c_pszColon + 1);
+
+	if (iPort <= 0 || iPort > 65535)
+		return false;
+
+	rstHost.assign(c_pszArg, c_pszColon - c_pszArg);
+	rwPort = iPort;
+	return true;
+}
+
+static void sig_shutdown(int)
+{
+	CBotManager::instance().Shutdown();
+}
+
+int main(int argc, char ** argv)
+{
+	CBotManager bot_manager;
+	TBotConfig & rkConfig = bot_manager.GetConfig();
+	int ch;
+
+	while ((ch = getopt(argc, argv, "a:g:n:r:u:i:w:c:s:t:d:xp:S:l:")) != -1)
+	{
+		switch (ch)
+		{
+			case 'a':
+				if (!ParseAddress(optarg, rkConfig.stAuthHost, rkConfig.wAuthPort))
+				{
+					fprintf(stderr, "invalid auth address %s\n", optarg);
+					return 1;
+				}
+				break;
+
+			case 'g':
+				if (!ParseAddress(optarg, rkConfig.stGameHost, rkConfig.wGamePort))
+				{
+					fprintf(stderr, "invalid game address %s\n", optarg);
+					return 1;
+				}
+				break;
+
+			case 'n':
+				rkConfig.iBotCount = atoi(optarg);
+				break;
+
+			case 'r':
+				rkConfig.iConnectPerSec = atoi(optarg);
+				break;
+
+			case 'u':
+				rkConfig.stAccountPrefix = optarg;
+				break;
+
+			case 'i':
+				rkConfig.iAccountStart = atoi(optarg);
+				break;
+
+			case 'w':
+				rkConfig.stPassword = optarg;
+				break;
+
+			case 'c':
+				rkConfig.iCharacterIndex = atoi(optarg);
+				break;
+
+			case 's':
+				rkConfig.stScriptFile = optarg;
+				break;
+
+			case 't':
+				rkConfig.iReportSec = atoi(optarg);
+				break;
+
+			case 'd':
+				rkConfig.iDurationSec = atoi(optarg);
+				break;
+
+			case 'x':
+				rkConfig.bReconnect = true;
+				break;
+
+			case 'p':
+				rkConfig.stReplayFile = optarg;
+				break;
+
+			case 'S':
+				rkConfig.dReplaySpeed = atof(optarg);
+				break;
+
+			case 'l':
+				log_set_level(atoi(optarg));
+				break;
+
+			default:
+				usage();
+				return 1;
+		}
+	}
+
+	if (!rkConfig.wAuthPort || !rkConfig.wGamePort || rkConfig.iBotCount <= 0 || rkConfig.iConnectPerSec <= 0)
+	{
+		usage();
+		return 1;
+	}
+
+	if (rkConfig.dReplaySpeed <= 0.0)
+	{
+		fprintf(stderr, "replay speed must be positive\n");
+		return 1;
+	}
+
+	if (rkConfig.iCharacterIndex < 0 || rkConfig.iCharacterIndex >= PLAYER_PER_ACCOUNT)
+	{
+		fprintf(stderr, "character slot must be 0 ~ %d\n", PLAYER_PER_ACCOUNT - 1);
+		return 1;
+	}
+
+	if (!log_init())
+	{
+		fprintf(stderr, "log_init failed\n");
+		return 1;
+	}
+
+	srandom(time(0) ^ getpid());
+
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, sig_shutdown);
+	signal(SIGTERM, sig_shutdown);
+
+	if (bot_manager.Initialize())
+		bot_manager.Run();
+
+	bot_manager.Destroy();
+	log_destroy();
+	return 0;
+}
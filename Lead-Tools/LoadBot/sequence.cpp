@@ -0,0 +1,6 @@
+#include "stdafx.h"
+#include "sequence.h"
+
+//   ǥ  ϹǷ Makefile  game/src/sequence.cpp  ̾ ´.
+const BYTE gc_abSequence[SEQUENCE_MAX_NUM] =
+#include "sequence_table.h"
@@ -0,0 +1,8 @@
+#ifndef __INC_LOADBOT_SEQUENCE_H__
+#define __INC_LOADBOT_SEQUENCE_H__
+
+#define SEQUENCE_MAX_NUM	32768
+
+extern const BYTE gc_abSequence[SEQUENCE_MAX_NUM];
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef __INC_LOADBOT_STDAFX_H__
+#define __INC_LOADBOT_STDAFX_H__
+
+#include "../../Lead-Server-Source/libthecore/include/stdafx.h"
+
+#include "common/singleton.h"
+#include "common/stl.h"
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <tr1/unordered_map>
+
+#include "packet.h"
+
+#endif
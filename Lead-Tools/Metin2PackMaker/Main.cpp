@@ -1,6 +1,7 @@
 #include <direct.h>
 #include <sys/stat.h>
 #include <io.h>
+#include <process.h>
 #include <boost/shared_ptr.hpp>
 #include <boost/algorithm/string.hpp> 
 #include <fstream>
@@ -24,6 +25,7 @@
 
 #include <EterBase/Utils.h>
 #include <EterBase/Filename.h>
+#include <EterBase/CRC32.h>
 #include <EterLib/TextFileLoader.h>
 #include <EterPack/EterPackManager.h>
 #include <Reducio/Reducio.h>
@@ -52,6 +54,7 @@ typedef unordered_map<string, string, stringhash> MapNameToSDBFile;
 
 MapNameToSDBFile g_map_SDBFileList;
 int				 iCompressTexQuality = 0;
+int				 g_iPackThreadCount = 0;
 
 bool IsSDBSupportRequired( const std::string& strFile, std::string& strMapName )
 {
@@ -183,7 +186,364 @@ void RegisterPackTypeByExtName(const char * c_pszExt, BYTE packType, bool isOver
 		g_PackTypeByExtNameMap.insert(TStrMap::value_type(c_pszExt, packType));
 }
 
-void RecursivePack(CEterPack & pack, const char * filename, std::vector<std::string>& vecCompressedTextures, std::vector<int>& vecCompressedTexMipMaps )
+// ѿ   ϳ.      б//ȣȭ ۾  ϰ
+// ѿ    尡   ϹǷ      ´.
+enum EPackJobState
+{
+	PACK_JOB_WAIT,
+	PACK_JOB_ENCODED,	// /ȣȭ ƴ
+	PACK_JOB_KEEP,		//      
+	PACK_JOB_SERIAL,	//  忡 Put  ִ´ (̺긮 ȣ)
+	PACK_JOB_FAILED,
+};
+
+enum
+{
+	PACK_JOB_WINDOW = 64,	//  ѿ    ̸ŭ  ִ´
+	PACK_THREAD_MAX_NUM = 32,
+};
+
+typedef struct SPackJob
+{
+	SPackJob(const std::string & c_rstFileName, BYTE packType, const std::string & c_rstRelatedMapName)
+		: stFileName(c_rstFileName), stRelatedMapName(c_rstRelatedMapName), bPackType(packType),
+		  lState(PACK_JOB_WAIT), pMappedFile(NULL), pZObj(NULL), pvData(NULL), lSize(0), dwSourceSize(0), dwSourceCRC(0)
+	{
+	}
+
+	std::string		stFileName;
+	std::string		stRelatedMapName;
+	BYTE			bPackType;
+
+	volatile LONG	lState;
+	CMappedFile *	pMappedFile;
+	CLZObject *		pZObj;
+	LPCVOID			pvData;
+	long			lSize;
+	DWORD			dwSourceSize;
+	DWORD			dwSourceCRC;
+} TPackJob;
+
+typedef std::vector<TPackJob> TPackJobVector;
+
+//       ũ CRC  <>.eih   ΰ
+//   Ÿ   ʰ ѿ ִ ׸ ״ .
+typedef struct SSourceHash
+{
+	DWORD	dwSize;
+	DWORD	dwCRC;
+	BYTE	bPackType;
+} TSourceHash;
+
+typedef unordered_map<string, TSourceHash, stringhash> TSourceHashMap;
+
+const DWORD c_dwSourceHashCC = MAKEFOURCC('E', 'I', 'H', 'D');
+const DWORD c_dwSourceHashVersion = 1;
+
+void LoadSourceHash(const std::string & c_rstPackFilePath, TSourceHashMap * pkMap)
+{
+	pkMap->clear();
+
+	std::string stFileName = c_rstPackFilePath + ".eih";
+	FILE * fp;
+
+	if (0 != fopen_s(&fp, stFileName.c_str(), "rb"))
+		return;
+
+	// FourCC, , IV  CRC, . IV  ٲ Panama  ޶Ƿ  .
+	DWORD adwHeader[4];
+
+	if (1 != fread(adwHeader, sizeof(adwHeader), 1, fp) ||
+		c_dwSourceHashCC != adwHeader[0] ||
+		c_dwSourceHashVersion != adwHeader[1] ||
+		GetCRC32((const char *) s_IV, sizeof(s_IV)) != adwHeader[2])
+	{
+		fclose(fp);
+		return;
+	}
+
+	for (DWORD i = 0; i < adwHeader[3]; ++i)
+	{
+		WORD wNameLen;
+		char szName[MAX_PATH + 1];
+		TSourceHash kHash;
+
+		if (1 != fread(&wNameLen, sizeof(wNameLen), 1, fp) || 0 == wNameLen || wNameLen > MAX_PATH ||
+			1 != fread(szName, wNameLen, 1, fp) ||
+			1 != fread(&kHash.dwSize, sizeof(kHash.dwSize), 1, fp) ||
+			1 != fread(&kHash.dwCRC, sizeof(kHash.dwCRC), 1, fp) ||
+			1 != fread(&kHash.bPackType, sizeof(kHash.bPackType), 1, fp))
+		{
+			CMakePackLog::GetSingleton().Writef("%s is broken, repacking all files\n", stFileName.c_str());
+			pkMap->clear();
+			break;
+		}
+
+		szName[wNameLen] = '\0';
+		pkMap->insert(TSourceHashMap::value_type(szName, kHash));
+	}
+
+	fclose(fp);
+}
+
+void SaveSourceHash(const std::string & c_rstPackFilePath, const TSourceHashMap & c_rkMap)
+{
+	std::string stFileName = c_rstPackFilePath + ".eih";
+	FILE * fp;
+
+	if (0 != fopen_s(&fp, stFileName.c_str(), "wb"))
+	{
+		CMakePackLog::GetSingleton().WriteErrorf("cannot write %s\n", stFileName.c_str());
+		return;
+	}
+
+	DWORD adwHeader[4];
+	adwHeader[0] = c_dwSourceHashCC;
+	adwHeader[1] = c_dwSourceHashVersion;
+	adwHeader[2] = GetCRC32((const char *) s_IV, sizeof(s_IV));
+	adwHeader[3] = c_rkMap.size();
+	fwrite(adwHeader, sizeof(adwHeader), 1, fp);
+
+	for (TSourceHashMap::const_iterator it = c_rkMap.begin(); it != c_rkMap.end(); ++it)
+	{
+		WORD wNameLen = (WORD) it->first.length();
+
+		fwrite(&wNameLen, sizeof(wNameLen), 1, fp);
+		fwrite(it->first.c_str(), wNameLen, 1, fp);
+		fwrite(&it->second.dwSize, sizeof(it->second.dwSize), 1, fp);
+		fwrite(&it->second.dwCRC, sizeof(it->second.dwCRC), 1, fp);
+		fwrite(&it->second.bPackType, sizeof(it->second.bPackType), 1, fp);
+	}
+
+	fclose(fp);
+}
+
+typedef struct SPackWorkerContext
+{
+	CEterPack *				pPack;
+	TPackJobVector *		pJobs;
+	const TSourceHashMap *	pSourceHash;
+
+	volatile LONG			lNextJob;
+	HANDLE					hSlot;
+	HANDLE					hDone;
+} TPackWorkerContext;
+
+typedef struct SPackWorker
+{
+	TPackWorkerContext *	pContext;
+	BYTE *					pbWorkMem;	// LZO ۾ ޸𸮴 帶  
+	HANDLE					hThread;
+} TPackWorker;
+
+//  о CRC  ,    /ȣȭ Ѵ. ѿ  ʴ´.
+void EncodePackJob(const TPackWorkerContext & c_rkContext, TPackJob & rkJob, BYTE * pbWorkMem)
+{
+	if (!CEterPack::IsParallelEncodable(rkJob.bPackType))
+	{
+		InterlockedExchange(&rkJob.lState, PACK_JOB_SERIAL);
+		return;
+	}
+
+	CMappedFile * pMappedFile = new CMappedFile;
+	LPCVOID pvSource;
+
+	if (!pMappedFile->Create(rkJob.stFileName.c_str(), &pvSource, 0, 0))
+	{
+		delete pMappedFile;
+		InterlockedExchange(&rkJob.lState, PACK_JOB_FAILED);
+		return;
+	}
+
+	rkJob.pMappedFile = pMappedFile;
+	rkJob.dwSourceSize = pMappedFile->Size();
+	rkJob.dwSourceCRC = GetCRC32((const char *) pvSource, rkJob.dwSourceSize);
+
+	TSourceHashMap::const_iterator it = c_rkContext.pSourceHash->find(rkJob.stFileName);
+
+	if (c_rkContext.pSourceHash->end() != it &&
+		it->second.dwSize == rkJob.dwSourceSize &&
+		it->second.dwCRC == rkJob.dwSourceCRC &&
+		it->second.bPackType == rkJob.bPackType)
+	{
+		// ѿ ׸   尡   ٽ 
+		rkJob.pvData = pvSource;
+		rkJob.lSize = rkJob.dwSourceSize;
+		InterlockedExchange(&rkJob.lState, PACK_JOB_KEEP);
+		return;
+	}
+
+	rkJob.pZObj = new CLZObject;
+
+	if (!c_rkContext.pPack->Encode(rkJob.stFileName.c_str(), pvSource, rkJob.dwSourceSize, rkJob.bPackType, *rkJob.pZObj, &rkJob.pvData, &rkJob.lSize, pbWorkMem))
+	{
+		InterlockedExchange(&rkJob.lState, PACK_JOB_FAILED);
+		return;
+	}
+
+	InterlockedExchange(&rkJob.lState, PACK_JOB_ENCODED);
+}
+
+unsigned __stdcall PackWorkerThread(void * pvArg)
+{
+	TPackWorker & rkWorker = *(TPackWorker *) pvArg;
+	TPackWorkerContext & rkContext = *rkWorker.pContext;
+
+	while (1)
+	{
+		WaitForSingleObject(rkContext.hSlot, INFINITE);
+
+		LONG lJob = InterlockedIncrement(&rkContext.lNextJob) - 1;
+
+		if (lJob >= (LONG) rkContext.pJobs->size())
+		{
+			//  ⸦ ٸ ٸ 带  ڸ  ´
+			ReleaseSemaphore(rkContext.hSlot, 1, NULL);
+			break;
+		}
+
+		EncodePackJob(rkContext, (*rkContext.pJobs)[lJob], rkWorker.pbWorkMem);
+		SetEvent(rkContext.hDone);
+	}
+
+	return 0;
+}
+
+bool WritePackJob(CEterPack & rkPack, TPackJob & rkJob)
+{
+	switch (rkJob.lState)
+	{
+		case PACK_JOB_KEEP:
+			if (rkPack.Keep(rkJob.stFileName.c_str()))
+				return true;
+
+			return rkPack.Put(rkJob.stFileName.c_str(), rkJob.pvData, rkJob.lSize, rkJob.bPackType);
+
+		case PACK_JOB_ENCODED:
+			return rkPack.PutEncoded(rkJob.stFileName.c_str(), rkJob.pvData, rkJob.lSize, rkJob.bPackType);
+
+		case PACK_JOB_SERIAL:
+			return rkPack.Put(rkJob.stFileName.c_str(), NULL, rkJob.bPackType, rkJob.stRelatedMapName);
+	}
+
+	return false;
+}
+
+bool PutPackJobs(CEterPack & rkPack, const std::string & c_rstPackFilePath, TPackJobVector & rkJobs)
+{
+	TSourceHashMap kOldHash;
+	TSourceHashMap kNewHash;
+
+	LoadSourceHash(c_rstPackFilePath, &kOldHash);
+
+	TPackWorkerContext kContext;
+	kContext.pPack = &rkPack;
+	kContext.pJobs = &rkJobs;
+	kContext.pSourceHash = &kOldHash;
+	kContext.lNextJob = 0;
+	kContext.hSlot = CreateSemaphore(NULL, PACK_JOB_WINDOW, PACK_JOB_WINDOW, NULL);
+	kContext.hDone = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+	// 带 ϳ    尡   Ѵ
+	std::vector<TPackWorker> vecWorker;
+	vecWorker.reserve(g_iPackThreadCount);
+
+	for (int i = 0; i < g_iPackThreadCount && kContext.hSlot && kContext.hDone && rkJobs.size() > 1; ++i)
+	{
+		TPackWorker kWorker;
+		kWorker.pContext = &kContext;
+		kWorker.pbWorkMem = (BYTE *) malloc(CLZO::GetWorkMemorySize());
+		kWorker.hThread = NULL;
+
+		if (!kWorker.pbWorkMem)
+			break;
+
+		vecWorker.push_back(kWorker);
+	}
+
+	size_t uThreadCount = 0;
+
+	for (; uThreadCount < vecWorker.size(); ++uThreadCount)
+	{
+		TPackWorker & rkWorker = vecWorker[uThreadCount];
+
+		if (!(rkWorker.hThread = (HANDLE) _beginthreadex(NULL, 0, PackWorkerThread, &rkWorker, 0, NULL)))
+			break;
+	}
+
+	bool bSuccess = true;
+	DWORD dwKeepCount = 0;
+
+	for (size_t i = 0; i < rkJobs.size(); ++i)
+	{
+		TPackJob & rkJob = rkJobs[i];
+
+		if (!uThreadCount)
+			EncodePackJob(kContext, rkJob, NULL);
+		else
+		{
+			while (PACK_JOB_WAIT == rkJob.lState)
+				WaitForSingleObject(kContext.hDone, INFINITE);
+		}
+
+		if (WritePackJob(rkPack, rkJob))
+		{
+			CMakePackLog::GetSingleton().Writef("pack: %s\n", rkJob.stFileName.c_str());
+
+			if (PACK_JOB_KEEP == rkJob.lState)
+				++dwKeepCount;
+
+			if (CEterPack::IsParallelEncodable(rkJob.bPackType))
+			{
+				TSourceHash kHash;
+				kHash.dwSize = rkJob.dwSourceSize;
+				kHash.dwCRC = rkJob.dwSourceCRC;
+				kHash.bPackType = rkJob.bPackType;
+				kNewHash[rkJob.stFileName] = kHash;
+			}
+		}
+		else
+		{
+			CMakePackLog::GetSingleton().Writef("pack failed: %s\n", rkJob.stFileName.c_str());
+			CMakePackLog::GetSingleton().WriteErrorf("pack failed: %s\n", rkJob.stFileName.c_str());
+			bSuccess = false;
+		}
+
+		delete rkJob.pZObj;
+		rkJob.pZObj = NULL;
+
+		delete rkJob.pMappedFile;
+		rkJob.pMappedFile = NULL;
+		rkJob.pvData = NULL;
+
+		if (uThreadCount)
+			ReleaseSemaphore(kContext.hSlot, 1, NULL);
+	}
+
+	for (size_t i = 0; i < vecWorker.size(); ++i)
+	{
+		if (vecWorker[i].hThread)
+		{
+			WaitForSingleObject(vecWorker[i].hThread, INFINITE);
+			CloseHandle(vecWorker[i].hThread);
+		}
+
+		free(vecWorker[i].pbWorkMem);
+	}
+
+	if (kContext.hSlot)
+		CloseHandle(kContext.hSlot);
+
+	if (kContext.hDone)
+		CloseHandle(kContext.hDone);
+
+	CMakePackLog::GetSingleton().Writef("%u files, %u unchanged, %u threads\n", rkJobs.size(), dwKeepCount, uThreadCount);
+
+	SaveSourceHash(c_rstPackFilePath, kNewHash);
+	return bSuccess;
+}
+
+void RecursivePack(TPackJobVector & rkJobs, const char * filename, std::vector<std::string>& vecCompressedTextures, std::vector<int>& vecCompressedTexMipMaps )
 {
     WIN32_FIND_DATA	fdata;
     HANDLE			hFind;
@@ -221,7 +581,7 @@ void RecursivePack(CEterPack & pack, const char * filename, std::vector<std::str
 
 				sprintf_s(p, sizeof(temp) - (p - temp), "%s/*", fdata.cFileName);
 
-				RecursivePack(pack, temp, vecCompressedTextures, vecCompressedTexMipMaps);
+				RecursivePack(rkJobs, temp, vecCompressedTextures, vecCompressedTexMipMaps);
 				continue;
 			}
 
@@ -307,16 +667,7 @@ void RecursivePack(CEterPack & pack, const char * filename, std::vector<std::str
 				if( packType == COMPRESSED_TYPE_HYBRIDCRYPT && IsSDBSupportRequired(temp, strRelatedMapName) )
 					packType = COMPRESSED_TYPE_HYBRIDCRYPT_WITHSDB;
 
-				if (pack.Put(temp, NULL, packType, strRelatedMapName))
-				{
-					CMakePackLog::GetSingleton().Writef("pack: %s\n", temp);
-				}
-				else
-				{
-					CMakePackLog::GetSingleton().Writef("pack failed: %s\n", temp);
-					CMakePackLog::GetSingleton().WriteErrorf("pack failed: %s\n", temp);
-				}
-
+				rkJobs.push_back(TPackJob(temp, packType, strRelatedMapName));
 			}
 		}
 		while (FindNextFile(hFind, &fdata));
@@ -396,6 +747,9 @@ bool MakePackFiles(const std::vector<std::string>& filePaths, CEterPackManager*
 	std::vector<std::string> vecCompressedTextures;
 	std::vector<int>		 vecCompressedTexMipMaps;
 
+	TPackJobVector vecJobs;
+	vecJobs.reserve(filePaths.size());
+
 	bool bSuccess = true;
 	while (i != e)
 	{
@@ -471,18 +825,12 @@ bool MakePackFiles(const std::vector<std::string>& filePaths, CEterPackManager*
 			}
 		}
 
-		if (pPack->Put(temp, NULL, packType, strRelatedMap))
-		{
-			CMakePackLog::GetSingleton().Writef("pack: %s\n", temp);
-		}
-		else
-		{
-			CMakePackLog::GetSingleton().Writef("pack failed: %s\n", temp);
-			CMakePackLog::GetSingleton().WriteErrorf("pack failed: %s\n", temp);
-			bSuccess = false;
-		}
+		vecJobs.push_back(TPackJob(temp, packType, strRelatedMap));
 		i++;
 	}
+
+	if (!PutPackJobs(*pPack, st_packFilePath, vecJobs))
+		bSuccess = false;
 	
 	pPackManager->RegisterPackWhenPackMaking(st_packFilePath.c_str(), g_strFolderName.c_str(), pPack );
 
@@ -525,7 +873,10 @@ void MakePack(const char * c_szPackName, const char * c_szDirectory, CEterPackMa
 	std::vector<std::string> vecCompressedTextures;
 	std::vector<int>		 vecCompressedTexMipMaps;
 
-	RecursivePack(*pPack, stFolder.c_str(), vecCompressedTextures, vecCompressedTexMipMaps);
+	TPackJobVector vecJobs;
+
+	RecursivePack(vecJobs, stFolder.c_str(), vecCompressedTextures, vecCompressedTexMipMaps);
+	PutPackJobs(*pPack, st_packFilePath, vecJobs);
 	AddIndex(st_packName.c_str(), stFolder.c_str());
 
 	pPack->DeleteUnreferencedData();
@@ -557,6 +908,8 @@ bool MakeRecursivePack(const char * c_szPackName, CTextFileLoader & rTextFileLoa
 	std::vector<std::string> vecCompressedTextures;
 	std::vector<int>		 vecCompressedTexMipMaps;
 
+	TPackJobVector vecJobs;
+
 	if (!pPack->Create(fileDict, st_packFilePath.c_str(), g_strFolderName.c_str(), false, s_IV))
 		return false;
 
@@ -574,7 +927,7 @@ bool MakeRecursivePack(const char * c_szPackName, CTextFileLoader & rTextFileLoa
 			if (!rTextFileLoader.GetTokenString("filename", &strFileName))
 				continue;
 
-			RecursivePack(*pPack, strFileName.c_str(), vecCompressedTextures, vecCompressedTexMipMaps);
+			RecursivePack(vecJobs, strFileName.c_str(), vecCompressedTextures, vecCompressedTexMipMaps);
 
 			if (bAddIndex)
 			{
@@ -585,6 +938,8 @@ bool MakeRecursivePack(const char * c_szPackName, CTextFileLoader & rTextFileLoa
 		}
 	}
 
+	PutPackJobs(*pPack, st_packFilePath, vecJobs);
+
 	pPack->DeleteUnreferencedData();
 	pPack->EncryptIndexFile();
 
@@ -705,6 +1060,84 @@ int main(int argc, char **argv)
 		printf("Cannot extract pack %s\n", argv[2]);
 		return 1;
 	}
+	else if (!strcmp(argv[1], "--convert2"))
+	{
+		// .exe --convert2 <packname> [<IV filename>] [--all]
+		//   <packname>.epk2  ٲ۴. ȣȭ  --all    ѿ .
+		if (argc < 3)
+		{
+			printf("Usage: %s --convert2 <packname> [<IV filename>] [--all]\n", argv[0]);
+			return 1;
+		}
+
+		CMappedFile file;
+		const BYTE* iv = NULL;
+		bool bAll = false;
+
+		for (int i = 3; i < argc; ++i)
+		{
+			if (!strcmp(argv[i], "--all"))
+			{
+				bAll = true;
+				continue;
+			}
+
+			if (!file.Create(argv[i], (const void**) &iv, 0, 32))
+			{
+				printf("Cannot load IV file %s\n", argv[i]);
+				return 1;
+			}
+		}
+
+		CEterPack pack;
+		CEterFileDict dict;
+
+		if (!pack.Create(dict, argv[2], "", true, iv))
+		{
+			printf("Cannot open pack %s\n", argv[2]);
+			return 1;
+		}
+
+		CEterPack2Builder builder;
+		int iKeptCount = 0;
+
+		TDataPositionMap & rIndexMap = pack.GetIndexMap();
+
+		for (TDataPositionMap::iterator i = rIndexMap.begin(); i != rIndexMap.end(); ++i)
+		{
+			TEterPackIndex* pIndex = i->second;
+
+			if (!bAll && COMPRESSED_TYPE_NONE != pIndex->compressed_type && COMPRESSED_TYPE_COMPRESS != pIndex->compressed_type)
+			{
+				printf("keep %s (type %d)\n", pIndex->filename, pIndex->compressed_type);
+				++iKeptCount;
+				continue;
+			}
+
+			CMappedFile dataFile;
+			LPCVOID pvData;
+
+			if (!pack.Get2(dataFile, pIndex->filename, pIndex, &pvData))
+			{
+				printf("Cannot read %s\n", pIndex->filename);
+				return 1;
+			}
+
+			builder.Add(pIndex->filename, pvData, dataFile.Size());
+		}
+
+		std::string stPack2Name(argv[2]);
+		stPack2Name += ".epk2";
+
+		if (!builder.Write(stPack2Name.c_str()))
+		{
+			printf("Cannot write %s\n", stPack2Name.c_str());
+			return 1;
+		}
+
+		printf("%s: %u files converted, %d files kept in the old pack\n", stPack2Name.c_str(), builder.GetCount(), iKeptCount);
+		return 0;
+	}
 
 	HANDLE hThread = GetCurrentThread();
 	SetThreadPriority(hThread, THREAD_PRIORITY_HIGHEST);
@@ -744,6 +1177,16 @@ int main(int argc, char **argv)
 	}
 
 	TextFileLoader.GetTokenInteger("compresstexture", &iCompressTexQuality);
+
+	// /ȣȭ  .  CPU ŭ .
+	if (!TextFileLoader.GetTokenInteger("threadcount", &g_iPackThreadCount))
+	{
+		SYSTEM_INFO kSystemInfo;
+		GetSystemInfo(&kSystemInfo);
+		g_iPackThreadCount = kSystemInfo.dwNumberOfProcessors;
+	}
+
+	g_iPackThreadCount = MINMAX(0, g_iPackThreadCount, PACK_THREAD_MAX_NUM);
 	////////////////////////////////////////////////////////////
 	IgnoreDirList_Load("ignore_dir_list.txt");
 	IgnoreFileList_Load("ignore_file_list.txt");
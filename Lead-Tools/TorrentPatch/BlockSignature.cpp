@@ -0,0 +1,275 @@
+#include "Metin2TorrentConsole.h"
+#include "BlockSignature.h"
+
+#include <YmirBase/CRC32.h>
+
+#include <algorithm>
+
+static const DWORD	s_dwHeaderSize	= sizeof(DWORD) * 4 + sizeof(MA_U64);
+static const DWORD	s_dwFilterSize	= 65536;
+
+static inline DWORD __FilterIndex(DWORD weak)
+{
+	return (weak ^ (weak >> 16)) & (s_dwFilterSize - 1);
+}
+
+struct FWeakLess
+{
+	bool operator () (const std::pair<DWORD, DWORD>& lhs, const std::pair<DWORD, DWORD>& rhs) const
+	{
+		return lhs.first < rhs.first;
+	}
+};
+
+EL_CBlockSignature::EL_CBlockSignature()
+: m_dwBlockSize(0), m_ullFileSize(0ULL)
+{
+}
+
+EL_CBlockSignature::~EL_CBlockSignature()
+{
+}
+
+DWORD EL_CBlockSignature::sWeakSum(const EL_BYTE* data, DWORD size)
+{
+	DWORD a = 0;
+	DWORD b = 0;
+
+	for (DWORD i = 0; i < size; ++i)
+	{
+		a += data[i];
+		b += (size - i) * data[i];
+	}
+
+	return (a & 0xffff) | ((b & 0xffff) << 16);
+}
+
+void EL_CBlockSignature::sBuild(const EL_BYTE* data, MA_U64 size, DWORD blockSize, std::string* outData)
+{
+	const DWORD blockCount = (DWORD) ((size + blockSize - 1) / blockSize);
+
+	outData->clear();
+	outData->reserve(s_dwHeaderSize + blockCount * sizeof(SBlock));
+
+	const DWORD header[4] = { FOURCC, VERSION, blockSize, blockCount };
+	outData->append((const char*) header, sizeof(header));
+	outData->append((const char*) &size, sizeof(size));
+
+	for (DWORD i = 0; i < blockCount; ++i)
+	{
+		const MA_U64 offset = MA_U64(i) * blockSize;
+		const DWORD length = (DWORD) EL_MIN<MA_U64>(blockSize, size - offset);
+
+		SBlock block;
+		block.weak	= sWeakSum(data + offset, length);
+		block.crc32	= EL_CRC32_Make(data + offset, length);
+		outData->append((const char*) &block, sizeof(block));
+	}
+}
+
+bool EL_CBlockSignature::Load(const std::string& data)
+{
+	m_vecBlock.clear();
+	m_dwBlockSize = 0;
+	m_ullFileSize = 0;
+
+	if (data.size() < s_dwHeaderSize)
+		return false;
+
+	const DWORD* header = (const DWORD*) data.c_str();
+
+	if (header[0] != FOURCC || header[1] != VERSION || header[2] == 0)
+		return false;
+
+	const DWORD blockSize = header[2];
+	const DWORD blockCount = header[3];
+	MA_U64 fileSize;
+	memcpy(&fileSize, data.c_str() + sizeof(DWORD) * 4, sizeof(fileSize));
+
+	if (data.size() != s_dwHeaderSize + MA_U64(blockCount) * sizeof(SBlock))
+		return false;
+
+	if ((fileSize + blockSize - 1) / blockSize != blockCount)
+		return false;
+
+	m_dwBlockSize = blockSize;
+	m_ullFileSize = fileSize;
+	m_vecBlock.resize(blockCount);
+
+	if (blockCount)
+		memcpy(&m_vecBlock[0], data.c_str() + s_dwHeaderSize, blockCount * sizeof(SBlock));
+
+	__BuildLookup();
+	return true;
+}
+
+void EL_CBlockSignature::__BuildLookup()
+{
+	m_vecSortedWeak.clear();
+	m_vecSortedWeak.reserve(m_vecBlock.size());
+	m_vecFilter.assign(s_dwFilterSize, 0);
+
+	for (DWORD i = 0; i < m_vecBlock.size(); ++i)
+	{
+		m_vecSortedWeak.push_back(std::make_pair(m_vecBlock[i].weak, i));
+		m_vecFilter[__FilterIndex(m_vecBlock[i].weak)] = 1;
+	}
+
+	std::sort(m_vecSortedWeak.begin(), m_vecSortedWeak.end());
+}
+
+MA_U64 EL_CBlockSignature::GetBlockOffset(DWORD index) const
+{
+	return MA_U64(index) * m_dwBlockSize;
+}
+
+DWORD EL_CBlockSignature::GetBlockLength(DWORD index) const
+{
+	return (DWORD) EL_MIN<MA_U64>(m_dwBlockSize, m_ullFileSize - GetBlockOffset(index));
+}
+
+// data  ϴ  ũ⸸ŭ   ϰ  .    ̸  ä.
+bool EL_CBlockSignature::__MatchAt(const EL_BYTE* data, DWORD weak, MA_S64 localOffset, std::vector<MA_S64>* outSource) const
+{
+	if (!m_vecFilter[__FilterIndex(weak)])
+		return false;
+
+	typedef std::vector< std::pair<DWORD, DWORD> >::const_iterator TItr;
+	std::pair<TItr, TItr> range = std::equal_range(m_vecSortedWeak.begin(), m_vecSortedWeak.end(), std::make_pair(weak, DWORD(0)), FWeakLess());
+
+	if (range.first == range.second)
+		return false;
+
+	bool bMatched = false;
+	bool bCRCReady = false;
+	DWORD crc32 = 0;
+
+	for (TItr it = range.first; it != range.second; ++it)
+	{
+		const DWORD index = it->second;
+
+		if (GetBlockLength(index) != m_dwBlockSize)
+			continue;
+
+		if (!bCRCReady)
+		{
+			crc32 = EL_CRC32_Make(data, m_dwBlockSize);
+			bCRCReady = true;
+		}
+
+		if (m_vecBlock[index].crc32 != crc32)
+			continue;
+
+		if (-1 == (*outSource)[index])
+			(*outSource)[index] = localOffset;
+
+		bMatched = true;
+	}
+
+	return bMatched;
+}
+
+void EL_CBlockSignature::Match(const EL_BYTE* localData, MA_U64 localSize, std::vector<MA_S64>* outSource) const
+{
+	outSource->assign(m_vecBlock.size(), -1);
+
+	if (m_vecBlock.empty() || NULL == localData)
+		return;
+
+	const DWORD L = m_dwBlockSize;
+
+	if (localSize >= L)
+	{
+		MA_U64 pos = 0;
+		DWORD weak = sWeakSum(localData, L);
+		DWORD a = weak & 0xffff;
+		DWORD b = weak >> 16;
+
+		for (;;)
+		{
+			if (__MatchAt(localData + pos, (a & 0xffff) | ((b & 0xffff) << 16), (MA_S64) pos, outSource))
+			{
+				// ã  ں ٽ Ѵ
+				pos += L;
+
+				if (pos + L > localSize)
+					break;
+
+				weak = sWeakSum(localData + pos, L);
+				a = weak & 0xffff;
+				b = weak >> 16;
+				continue;
+			}
+
+			if (pos + L >= localSize)
+				break;
+
+			const DWORD out = localData[pos];
+			const DWORD in = localData[pos + L];
+
+			a = (a - out + in) & 0xffff;
+			b = (b - L * out + a) & 0xffff;
+			++pos;
+		}
+	}
+
+	//   ª  Ƿ    ġ  Ѵ
+	const DWORD lastIndex = m_vecBlock.size() - 1;
+	const DWORD lastLength = GetBlockLength(lastIndex);
+
+	if (-1 != (*outSource)[lastIndex] || lastLength == L || localSize < lastLength)
+		return;
+
+	const MA_U64 candidates[2] = { GetBlockOffset(lastIndex), localSize - lastLength };
+
+	for (int i = 0; i < 2; ++i)
+	{
+		const MA_U64 offset = candidates[i];
+
+		if (offset + lastLength > localSize)
+			continue;
+
+		if (sWeakSum(localData + offset, lastLength) == m_vecBlock[lastIndex].weak &&
+			EL_CRC32_Make(localData + offset, lastLength) == m_vecBlock[lastIndex].crc32)
+		{
+			(*outSource)[lastIndex] = (MA_S64) offset;
+			return;
+		}
+	}
+}
+
+MA_U64 EL_CBlockSignature::BuildMissingRanges(const std::vector<MA_S64>& source, MA_U64 maxRangeSize, std::vector<EL_BlockRange>* outRanges) const
+{
+	outRanges->clear();
+
+	MA_U64 missingSize = 0;
+
+	for (DWORD i = 0; i < m_vecBlock.size(); ++i)
+	{
+		if (-1 != source[i])
+			continue;
+
+		const MA_U64 offset = GetBlockOffset(i);
+		const DWORD length = GetBlockLength(i);
+
+		if (!outRanges->empty())
+		{
+			EL_BlockRange& last = outRanges->back();
+
+			if (last.offset + last.size == offset && last.size + length <= maxRangeSize)
+			{
+				last.size += length;
+				missingSize += length;
+				continue;
+			}
+		}
+
+		EL_BlockRange range;
+		range.offset = offset;
+		range.size = length;
+		outRanges->push_back(range);
+		missingSize += length;
+	}
+
+	return missingSize;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+// ġ  <>.blk  ÷ δ  .
+//  Ͽ    ã ״ ,  ϸ  Ͽ Range û ޴´.
+//
+//  (little endian)
+//	DWORD	fourcc ('EBLK')
+//	DWORD	version
+//	DWORD	block size
+//	DWORD	block count
+//	MA_U64	file size
+//	{ DWORD weak; DWORD crc32; } * block count
+//
+// weak  rsync  rolling checksum ̶  Ʈ и ΰ ٽ   ְ,
+// ´    crc32  ȮѴ.   block size  ª  ִ.
+struct EL_BlockRange
+{
+	MA_U64	offset;		//  Ͽ ġ
+	MA_U64	size;
+};
+
+class EL_CBlockSignature
+{
+public:
+	enum
+	{
+		FOURCC				= MAKEFOURCC('E', 'B', 'L', 'K'),
+		VERSION				= 1,
+		DEFAULT_BLOCK_SIZE	= 16 * 1024,
+	};
+
+	EL_CBlockSignature();
+	~EL_CBlockSignature();
+
+	bool	Load(const std::string& data);
+
+	//  Ͽ ϸ   ִ ġ ã´.  ã  -1
+	void	Match(const EL_BYTE* localData, MA_U64 localSize, std::vector<MA_S64>* outSource) const;
+
+	//  ã  ̾ ٿ maxRangeSize   ʴ Range  . ޾ƾ  ü ũ⸦ ش.
+	MA_U64	BuildMissingRanges(const std::vector<MA_S64>& source, MA_U64 maxRangeSize, std::vector<EL_BlockRange>* outRanges) const;
+
+	DWORD	GetBlockSize() const	{ return m_dwBlockSize; }
+	DWORD	GetBlockCount() const	{ return m_vecBlock.size(); }
+	MA_U64	GetFileSize() const		{ return m_ullFileSize; }
+	MA_U64	GetBlockOffset(DWORD index) const;
+	DWORD	GetBlockLength(DWORD index) const;
+
+	// ġ  ø  
+	static void		sBuild(const EL_BYTE* data, MA_U64 size, DWORD blockSize, std::string* outData);
+	static DWORD	sWeakSum(const EL_BYTE* data, DWORD size);
+
+protected:
+	struct SBlock
+	{
+		DWORD	weak;
+		DWORD	crc32;
+	};
+
+	void	__BuildLookup();
+	bool	__MatchAt(const EL_BYTE* data, DWORD weak, MA_S64 localOffset, std::vector<MA_S64>* outSource) const;
+
+protected:
+	DWORD								m_dwBlockSize;
+	MA_U64								m_ullFileSize;
+	std::vector<SBlock>					m_vecBlock;
+
+	// weak   (weak,  ȣ). Ʈ ãǷ  m_vecFilter  Ÿ.
+	std::vector< std::pair<DWORD, DWORD> >	m_vecSortedWeak;
+	std::vector<EL_BYTE>				m_vecFilter;
+};
@@ -12,14 +12,134 @@
 #include <Wininet.h>
 
 #include "CCrcTable.h"
+#include "BlockSignature.h"
 #include "Helper.h"
 #include "StringFromHttp.h"
 #include "StringFromFile.h"
 
 #include <EterBase/FileName.h>
 
+#include <YmirBase/MappedFile.h>
+#include <YmirBase/CRC32.h>
+
 #define HTTP_PREFIX		_T("http://")
 
+enum
+{
+	BLOCK_RANGE_THREAD_NUM	= 4,
+	BLOCK_RANGE_MAX_SIZE	= 1024 * 1024,	// Range û ϳ ִ ũ
+	BLOCK_RANGE_RETRY		= 3,
+	BLOCK_PATCH_MAX_PERCENT	= 75,			// ̺  ޾ƾ ϸ   ° ޴  
+};
+
+//   Range û     ޴´.  Ȳ  尡 о UI  ݿѴ.
+struct EL_RangeDownloadContext
+{
+	std::wstring						urlAddr;
+	std::wstring						urlPath;
+	const std::vector<EL_BlockRange>*	pRanges;
+	EL_BYTE*							pbyOutput;
+
+	volatile LONG						lNextRange;
+	volatile LONG						lDownloadedBytes;
+	volatile LONG						lFailed;
+	volatile LONG						lAbort;
+};
+
+static bool __ReadRangeFromHttp(HINTERNET hConnection, EL_RangeDownloadContext& rContext, const EL_BlockRange& range)
+{
+	HINTERNET hRequest = HttpOpenRequestW(hConnection,
+		L"GET",
+		rContext.urlPath.c_str(),
+		_T("HTTP/1.1"),
+		NULL,
+		NULL,
+		INTERNET_FLAG_RELOAD | INTERNET_FLAG_DONT_CACHE | INTERNET_FLAG_PRAGMA_NOCACHE | INTERNET_FLAG_KEEP_CONNECTION,
+		0);
+
+	if (!hRequest)
+		return false;
+
+	bool bRet = false;
+	MA_U64 ullReceived = 0;
+
+	MA_WCHAR wszExtraHeader[256];
+	DWORD dwExtraHeaderSize = MA_StringFormatW(wszExtraHeader, MA_ARRAYCOUNT(wszExtraHeader), _T("Range: bytes=%I64u-%I64u\r\n"), range.offset, range.offset + range.size - 1);
+
+	if (HttpSendRequestW(hRequest, wszExtraHeader, dwExtraHeaderSize, NULL, 0))
+	{
+		DWORD dwStatus = 0;
+		DWORD dwStatusSize = sizeof(dwStatus);
+
+		// 200 ̸  Range  ϰ  °  ̹Ƿ   
+		if (HttpQueryInfo(hRequest, HTTP_QUERY_STATUS_CODE | HTTP_QUERY_FLAG_NUMBER, &dwStatus, &dwStatusSize, NULL) &&
+			HTTP_STATUS_PARTIAL_CONTENT == dwStatus)
+		{
+			while (ullReceived < range.size && !rContext.lAbort)
+			{
+				DWORD dwReadSize = 0;
+				const DWORD dwToRead = (DWORD) EL_MIN<MA_U64>(range.size - ullReceived, 64 * 1024);
+
+				if (!InternetReadFile(hRequest, rContext.pbyOutput + range.offset + ullReceived, dwToRead, &dwReadSize) || 0 == dwReadSize)
+					break;
+
+				ullReceived += dwReadSize;
+				InterlockedExchangeAdd(&rContext.lDownloadedBytes, dwReadSize);
+			}
+
+			bRet = (ullReceived == range.size);
+		}
+	}
+
+	// ؼ ٽ   Ʈ    ʰ ǵ
+	if (!bRet && ullReceived)
+		InterlockedExchangeAdd(&rContext.lDownloadedBytes, -(LONG) ullReceived);
+
+	EL_SAFE_INTERNETCLOSEHANDLE(hRequest);
+	return bRet;
+}
+
+class EL_RangeDownloadThread : public wxThread
+{
+public:
+	EL_RangeDownloadThread(EL_RangeDownloadContext& rContext)
+	: wxThread(wxTHREAD_JOINABLE), m_rContext(rContext)
+	{
+	}
+
+	virtual void* Entry()
+	{
+		HINTERNET hSession = InternetOpenW(TAPP_FULLNAME, INTERNET_OPEN_TYPE_DIRECT, NULL, NULL, NULL);
+		HINTERNET hConnection = hSession ? InternetConnect(hSession, m_rContext.urlAddr.c_str(), INTERNET_DEFAULT_HTTP_PORT, NULL, NULL, INTERNET_SERVICE_HTTP, 0, 0) : NULL;
+
+		if (!hConnection)
+			InterlockedExchange(&m_rContext.lFailed, 1);
+
+		while (hConnection && !m_rContext.lFailed && !m_rContext.lAbort)
+		{
+			const LONG lIndex = InterlockedIncrement(&m_rContext.lNextRange) - 1;
+
+			if (lIndex >= (LONG) m_rContext.pRanges->size())
+				break;
+
+			bool bRead = false;
+
+			for (int i = 0; i < BLOCK_RANGE_RETRY && !bRead && !m_rContext.lAbort; ++i)
+				bRead = __ReadRangeFromHttp(hConnection, m_rContext, m_rContext.pRanges->at(lIndex));
+
+			if (!bRead)
+				InterlockedExchange(&m_rContext.lFailed, 1);
+		}
+
+		EL_SAFE_INTERNETCLOSEHANDLE(hConnection);
+		EL_SAFE_INTERNETCLOSEHANDLE(hSession);
+		return NULL;
+	}
+
+protected:
+	EL_RangeDownloadContext&	m_rContext;
+};
+
 EL_CrcPatcher::EL_CrcPatcher()
 : m_pcPatchThread(NULL)
 , m_nCurrentFileIndex(0), m_nFileCount(0)
@@ -167,7 +287,8 @@ MA_BOOL EL_CrcPatcher::Patch(const EL_CCrcTable& rcTable, const std::wstring& ba
 		m_ullCurrentDownloadedBytes	= 0;
 		UpdateProgress();
 
-		if (false == _DownloadFileFromHttp(downloadURL.c_str(), saveFilePath.c_str(), info.path, pcStatus))
+		if (false == _PatchFileByBlocks(info, baseUrl + info.path, basePath + info.path, saveFilePath) &&
+			false == _DownloadFileFromHttp(downloadURL.c_str(), saveFilePath.c_str(), info.path, pcStatus))
 		{
 			if (pcStatus && _IsAlive())
 				pcStatus->AddNRf( Earth::EA_STATUS_ERROR, _T("%s - %s"), EL_LTEXT("FAILED_DOWNLOAD_FILE"), downloadURL.c_str() );
@@ -423,6 +544,171 @@ Cleanup:
 	return bRet;
 }
 
+bool EL_CrcPatcher::_PatchFileByBlocks(const EL_FileInfo& info, const std::wstring& fileUrl, const std::wstring& localPath, const std::wstring& savePath)
+{
+	if (false == _IsAlive())
+		return false;
+
+	//    κ̹Ƿ  ޾Ƶ   ʴ´
+	std::string signatureData;
+	if (false == EL_StringFromHttpW(signatureData, fileUrl + L".blk", NULL))
+		return false;
+
+	EL_CBlockSignature cSignature;
+	if (false == cSignature.Load(signatureData) || cSignature.GetFileSize() != info.size)
+		return false;
+
+	EL_MappedFile localFile;
+	if (!localFile.Open(localPath.c_str(), EL_File::FILEMODE_READ))
+		return false;
+
+	std::vector<MA_S64> vecSource;
+	cSignature.Match((const EL_BYTE*) localFile.GetDataPtr(), localFile.GetSize(), &vecSource);
+
+	std::vector<EL_BlockRange> vecRange;
+	const MA_U64 ullMissingSize = cSignature.BuildMissingRanges(vecSource, BLOCK_RANGE_MAX_SIZE, &vecRange);
+
+	if (ullMissingSize * 100 > info.size * BLOCK_PATCH_MAX_PERCENT || ullMissingSize > 0x7fffffff)
+	{
+		localFile.Close();
+		return false;
+	}
+
+	std::vector<EL_BYTE> vecOutput((EL_SIZE) info.size);
+	EL_BYTE* pbyOutput = vecOutput.empty() ? NULL : &vecOutput[0];
+
+	for (DWORD i = 0; i < cSignature.GetBlockCount(); ++i)
+	{
+		if (-1 != vecSource[i])
+			memcpy(pbyOutput + cSignature.GetBlockOffset(i), (const EL_BYTE*) localFile.GetDataPtr() + vecSource[i], cSignature.GetBlockLength(i));
+	}
+
+	localFile.Close();
+
+	const MA_U64 ullReusedSize = info.size - ullMissingSize;
+	MA_U64 ullBackupCurrentDownloadedBytes	= m_ullCurrentDownloadedBytes;
+	MA_U64 ullBackupTotalDownloadedBytes	= m_ullTotalDownloadedBytes;
+
+	if (!vecRange.empty())
+	{
+		EL_RangeDownloadContext kContext;
+		kContext.pRanges			= &vecRange;
+		kContext.pbyOutput			= pbyOutput;
+		kContext.lNextRange			= 0;
+		kContext.lDownloadedBytes	= 0;
+		kContext.lFailed			= 0;
+		kContext.lAbort				= 0;
+
+		const EL_INT protocolSepPos = fileUrl.find(L"://");
+		const EL_INT protocolLen = (protocolSepPos >= 0) ? protocolSepPos + 3 : 0;
+		const EL_INT firstSepPos = fileUrl.find(L'/', protocolLen);
+
+		if (firstSepPos <= 0)
+			return false;
+
+		kContext.urlAddr.assign(fileUrl.substr(protocolLen, firstSepPos-protocolLen));
+
+		{
+			Mantle::MA_CURLEncode cURLEncoder;
+			Mantle::MA_CW2E eszFileUrlPath( fileUrl.substr(firstSepPos).c_str() );
+
+			MA_SIZE sizeRequestPath = cURLEncoder.CalculateEncodeLength( MA_StringLengthE( eszFileUrlPath ) );
+			MA_LPTSTR tszRequestPath = MA_StringAlloc( sizeRequestPath );
+			cURLEncoder.Encode( tszRequestPath, sizeRequestPath, (MA_LPCESTR) eszFileUrlPath, MA_StringLengthE( eszFileUrlPath ) );
+			kContext.urlPath = tszRequestPath;
+			MA_StringFree(tszRequestPath);
+		}
+
+		std::vector<EL_RangeDownloadThread*> vecThread;
+		const EL_SIZE threadCount = EL_MIN<EL_SIZE>(BLOCK_RANGE_THREAD_NUM, vecRange.size());
+
+		for (EL_SIZE i = 0; i < threadCount; ++i)
+		{
+			EL_RangeDownloadThread* pcThread = new EL_RangeDownloadThread(kContext);
+
+			if (wxTHREAD_NO_ERROR != pcThread->Create() || wxTHREAD_NO_ERROR != pcThread->Run())
+			{
+				delete pcThread;
+				break;
+			}
+
+			vecThread.push_back(pcThread);
+		}
+
+		if (vecThread.empty())
+			return false;
+
+		//     Ȳ UI  ݿѴ.  ʴ ϸŭ ̹   ģ.
+		for (;;)
+		{
+			bool bRunning = false;
+
+			for (EL_SIZE i = 0; i < vecThread.size(); ++i)
+			{
+				if (vecThread[i]->IsRunning())
+					bRunning = true;
+			}
+
+			if (false == _IsAlive())
+				InterlockedExchange(&kContext.lAbort, 1);
+
+			const MA_U64 ullDownloaded = ullReusedSize + (MA_U64) kContext.lDownloadedBytes;
+			m_ullCurrentDownloadedBytes	= ullBackupCurrentDownloadedBytes + ullDownloaded;
+			m_ullTotalDownloadedBytes	= ullBackupTotalDownloadedBytes + ullDownloaded;
+			CalculateSpeed( ullDownloaded, info.size );
+
+			if (!bRunning)
+				break;
+
+			::Sleep( 100 );
+		}
+
+		for (EL_SIZE i = 0; i < vecThread.size(); ++i)
+		{
+			vecThread[i]->Wait();
+			delete vecThread[i];
+		}
+
+		if (kContext.lFailed || kContext.lAbort)
+		{
+			m_ullCurrentDownloadedBytes	= ullBackupCurrentDownloadedBytes;
+			m_ullTotalDownloadedBytes	= ullBackupTotalDownloadedBytes;
+			return false;
+		}
+	}
+	else
+	{
+		m_ullCurrentDownloadedBytes	= ullBackupCurrentDownloadedBytes + info.size;
+		m_ullTotalDownloadedBytes	= ullBackupTotalDownloadedBytes + info.size;
+	}
+
+	//  crclist  ٸ ̸ ⼭ ɷ
+	if (EL_CRC32_Make(pbyOutput, vecOutput.size()) != info.CRC32)
+	{
+		m_ullCurrentDownloadedBytes	= ullBackupCurrentDownloadedBytes;
+		m_ullTotalDownloadedBytes	= ullBackupTotalDownloadedBytes;
+		return false;
+	}
+
+	HANDLE hHandle = ::CreateFile(savePath.c_str(), GENERIC_WRITE, FILE_SHARE_WRITE, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE == hHandle)
+		return false;
+
+	DWORD writtenBytes = 0;
+	BOOL bWritten = vecOutput.empty() || ::WriteFile(hHandle, pbyOutput, vecOutput.size(), &writtenBytes, NULL);
+	::CloseHandle(hHandle);
+
+	//  ϸ   Ƿ ° ް Ѵ
+	if (!bWritten || writtenBytes != vecOutput.size())
+	{
+		m_ullCurrentDownloadedBytes	= ullBackupCurrentDownloadedBytes;
+		m_ullTotalDownloadedBytes	= ullBackupTotalDownloadedBytes;
+		return false;
+	}
+
+	return true;
+}
+
 #define MAX_HTTP_RETRY	3
 
 bool EL_CrcPatcher::_DownloadFileFromHttp(MA_LPCWSTR wszURL, MA_LPCWSTR wszLocalPath, const std::wstring& /*fileName*/, Earth::EA_CStatus *pcStatus)
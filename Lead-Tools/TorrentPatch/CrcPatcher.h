@@ -20,6 +20,10 @@ public:
 
 	bool _DownloadFileFromHttp(MA_LPCWSTR wszURL, MA_LPCWSTR wszLocalPath, const std::wstring& fileName, Earth::EA_CStatus *pcStatus);
 
+	//   (<>.blk)   Ͽ   ״   Range û ޴´.
+	//  ų ޴  ų  CRC  Ʋ false  ְ, ׶ ° ޴´.
+	bool _PatchFileByBlocks(const EL_FileInfo& info, const std::wstring& fileUrl, const std::wstring& localPath, const std::wstring& savePath);
+
 protected:
 	virtual void CalculateSpeed(const MA_U64 ullDownloadedBytes, const MA_U64 ullFileSize);
 	virtual void _OnCompletedDownload(const std::wstring& fileName, const EL_SIZE fileSize);